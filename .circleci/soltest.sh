@@ -13,6 +13,7 @@
 #     OPTIMIZE=1              Enables backend optimizer
 #     ABI_ENCODER_V1=1        Forcibly enables ABI coder version 1
 #     SOLTEST_FLAGS=<flags>   Appends <flags> to default SOLTEST_ARGS
+#     SOLTEST_SHARDS=N        Runs the tests in N concurrent soltest processes (shards)
 #
 # ------------------------------------------------------------------------------
 # This file is part of solidity.
@@ -56,12 +57,34 @@ get_logfile_basename() {
     echo -ne "${filename}"
 }
 
-BOOST_TEST_ARGS=("--color_output=no" "--show_progress=yes" "--logger=JUNIT,error,test_results/`get_logfile_basename`.xml" "${BOOST_TEST_ARGS[@]}")
+SHARDS=${SOLTEST_SHARDS:-1}
 SOLTEST_ARGS=("--evm-version=$EVM" "${SOLTEST_FLAGS[@]}")
 
 test "${OPTIMIZE}" = "1" && SOLTEST_ARGS+=(--optimize)
 test "${ABI_ENCODER_V1}" = "1" && SOLTEST_ARGS+=(--abiencoderv1)
 
-echo "Running ${REPODIR}/build/test/soltest ${BOOST_TEST_ARGS[*]} -- ${SOLTEST_ARGS[*]}"
+if [ "$SHARDS" -le 1 ]
+then
+    BOOST_TEST_ARGS=("--color_output=no" "--show_progress=yes" "--logger=JUNIT,error,test_results/`get_logfile_basename`.xml" "${BOOST_TEST_ARGS[@]}")
 
-"${REPODIR}/build/test/soltest" "${BOOST_TEST_ARGS[@]}" -- "${SOLTEST_ARGS[@]}"
+    echo "Running ${REPODIR}/build/test/soltest ${BOOST_TEST_ARGS[*]} -- ${SOLTEST_ARGS[*]}"
+
+    "${REPODIR}/build/test/soltest" "${BOOST_TEST_ARGS[@]}" -- "${SOLTEST_ARGS[@]}"
+else
+    # Every shard writes its own JUnit report, CircleCI collects all reports in test_results.
+    PIDS=()
+    for (( SHARD=0; SHARD < SHARDS; SHARD++ ))
+    do
+        SHARD_BOOST_TEST_ARGS=("--color_output=no" "--logger=JUNIT,error,test_results/`get_logfile_basename`_shard${SHARD}.xml" "${BOOST_TEST_ARGS[@]}")
+        echo "Running ${REPODIR}/build/test/soltest ${SHARD_BOOST_TEST_ARGS[*]} -- ${SOLTEST_ARGS[*]} --shard ${SHARD}/${SHARDS}"
+        "${REPODIR}/build/test/soltest" "${SHARD_BOOST_TEST_ARGS[@]}" -- "${SOLTEST_ARGS[@]}" --shard "${SHARD}/${SHARDS}" &
+        PIDS+=($!)
+    done
+
+    FAILED=0
+    for PID in "${PIDS[@]}"
+    do
+        wait "$PID" || FAILED=1
+    done
+    exit $FAILED
+fi
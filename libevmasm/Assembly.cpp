@@ -33,7 +33,14 @@
 
 #include <liblangutil/Exceptions.h>
 
+#include <libsolutil/CompilationStatistics.h>
+#include <libsolutil/Tracer.h>
+#include <libsolutil/JSON.h>
+#include <libsolutil/ThreadPool.h>
+
+#include <algorithm>
 #include <fstream>
+#include <variant>
 #include <json/json.h>
 
 using namespace std;
@@ -46,7 +53,10 @@ AssemblyItem const& Assembly::append(AssemblyItem const& _i)
 {
 	assertThrow(m_deposit >= 0, AssemblyException, "Stack underflow.");
 	m_deposit += static_cast<int>(_i.deposit());
+	size_t const capacity = m_items.capacity();
 	m_items.emplace_back(_i);
+	if (m_items.capacity() != capacity)
+		m_itemsMemory.set(m_items.capacity() * sizeof(AssemblyItem));
 	if (!m_items.back().location().isValid() && m_currentSourceLocation.isValid())
 		m_items.back().setLocation(m_currentSourceLocation);
 	m_items.back().m_modifierDepth = m_currentModifierDepth;
@@ -76,7 +86,7 @@ string locationFromSources(StringMap const& _sourceCodes, SourceLocation const&
 	if (!_location.hasText() || _sourceCodes.empty())
 		return "";
 
-	auto it = _sourceCodes.find(_location.source->name());
+	auto it = _sourceCodes.find(*_location.sourceName);
 	if (it == _sourceCodes.end())
 		return "";
 
@@ -150,8 +160,8 @@ public:
 		if (!m_location.isValid())
 			return;
 		m_out << m_prefix << "    /*";
-		if (m_location.source)
-			m_out << " \"" + m_location.source->name() + "\"";
+		if (m_location.sourceName)
+			m_out << " \"" + *m_location.sourceName + "\"";
 		if (m_location.hasText())
 			m_out << ":" << to_string(m_location.start) + ":" + to_string(m_location.end);
 		m_out << "  " << locationFromSources(m_sourceCodes, m_location);
@@ -225,17 +235,15 @@ string Assembly::toStringInHex(u256 _value)
 	return hexStr.str();
 }
 
-Json::Value Assembly::assemblyJSON(map<string, unsigned> const& _sourceIndices) const
+template <typename Append>
+void Assembly::codeJSON(map<string, unsigned> const& _sourceIndices, Append&& _append) const
 {
-	Json::Value root;
-
-	Json::Value& collection = root[".code"] = Json::arrayValue;
 	for (AssemblyItem const& i: m_items)
 	{
 		int sourceIndex = -1;
-		if (i.location().source)
+		if (i.location().sourceName)
 		{
-			auto iter = _sourceIndices.find(i.location().source->name());
+			auto iter = _sourceIndices.find(*i.location().sourceName);
 			if (iter != _sourceIndices.end())
 				sourceIndex = static_cast<int>(iter->second);
 		}
@@ -243,7 +251,7 @@ Json::Value Assembly::assemblyJSON(map<string, unsigned> const& _sourceIndices)
 		switch (i.type())
 		{
 		case Operation:
-			collection.append(
+			_append(
 				createJsonValue(
 					instructionInfo(i.instruction()).name,
 					sourceIndex,
@@ -253,45 +261,45 @@ Json::Value Assembly::assemblyJSON(map<string, unsigned> const& _sourceIndices)
 				);
 			break;
 		case Push:
-			collection.append(
+			_append(
 				createJsonValue("PUSH", sourceIndex, i.location().start, i.location().end, toStringInHex(i.data()), i.getJumpTypeAsString()));
 			break;
 		case PushString:
-			collection.append(
+			_append(
 				createJsonValue("PUSH tag", sourceIndex, i.location().start, i.location().end, m_strings.at(h256(i.data()))));
 			break;
 		case PushTag:
 			if (i.data() == 0)
-				collection.append(
+				_append(
 					createJsonValue("PUSH [ErrorTag]", sourceIndex, i.location().start, i.location().end, ""));
 			else
-				collection.append(
+				_append(
 					createJsonValue("PUSH [tag]", sourceIndex, i.location().start, i.location().end, toString(i.data())));
 			break;
 		case PushSub:
-			collection.append(
+			_append(
 				createJsonValue("PUSH [$]", sourceIndex, i.location().start, i.location().end, toString(h256(i.data()))));
 			break;
 		case PushSubSize:
-			collection.append(
+			_append(
 				createJsonValue("PUSH #[$]", sourceIndex, i.location().start, i.location().end, toString(h256(i.data()))));
 			break;
 		case PushProgramSize:
-			collection.append(
+			_append(
 				createJsonValue("PUSHSIZE", sourceIndex, i.location().start, i.location().end));
 			break;
 		case PushLibraryAddress:
-			collection.append(
+			_append(
 				createJsonValue("PUSHLIB", sourceIndex, i.location().start, i.location().end, m_libraries.at(h256(i.data())))
 			);
 			break;
 		case PushDeployTimeAddress:
-			collection.append(
+			_append(
 				createJsonValue("PUSHDEPLOYADDRESS", sourceIndex, i.location().start, i.location().end)
 			);
 			break;
 		case PushImmutable:
-			collection.append(createJsonValue(
+			_append(createJsonValue(
 				"PUSHIMMUTABLE",
 				sourceIndex,
 				i.location().start,
@@ -300,7 +308,7 @@ Json::Value Assembly::assemblyJSON(map<string, unsigned> const& _sourceIndices)
 			));
 			break;
 		case AssignImmutable:
-			collection.append(createJsonValue(
+			_append(createJsonValue(
 				"ASSIGNIMMUTABLE",
 				sourceIndex,
 				i.location().start,
@@ -309,38 +317,79 @@ Json::Value Assembly::assemblyJSON(map<string, unsigned> const& _sourceIndices)
 			));
 			break;
 		case Tag:
-			collection.append(
+			_append(
 				createJsonValue("tag", sourceIndex, i.location().start, i.location().end, toString(i.data())));
-			collection.append(
+			_append(
 				createJsonValue("JUMPDEST", sourceIndex, i.location().start, i.location().end));
 			break;
 		case PushData:
-			collection.append(createJsonValue("PUSH data", sourceIndex, i.location().start, i.location().end, toStringInHex(i.data())));
+			_append(createJsonValue("PUSH data", sourceIndex, i.location().start, i.location().end, toStringInHex(i.data())));
 			break;
 		default:
 			assertThrow(false, InvalidOpcode, "");
 		}
 	}
+}
+
+Json::Value Assembly::assemblyJSON(map<string, unsigned> const& _sourceIndices) const
+{
+	util::JsonTreeWriter writer;
+	assemblyJSON(writer, _sourceIndices);
+	return move(writer.result());
+}
+
+void Assembly::assemblyJSON(util::JsonWriter& _writer, map<string, unsigned> const& _sourceIndices) const
+{
+	// The members are added in the order of their keys, as required by the writer.
+	if (m_auxiliaryData.size() > 0)
+		_writer.addMember(".auxdata", toHex(m_auxiliaryData));
+
+	_writer.addMember(
+		".code",
+		[&](ostream& _stream) {
+			_stream << "[";
+			bool first = true;
+			codeJSON(_sourceIndices, [&](Json::Value const& _item) {
+				if (!first)
+					_stream << ",";
+				first = false;
+				_stream << util::jsonCompactPrint(_item);
+			});
+			_stream << "]";
+		},
+		[&]() {
+			Json::Value code(Json::arrayValue);
+			codeJSON(_sourceIndices, [&](Json::Value _item) { code.append(move(_item)); });
+			return code;
+		}
+	);
 
 	if (!m_data.empty() || !m_subs.empty())
 	{
-		Json::Value& data = root[".data"] = Json::objectValue;
+		// Data and sub-assemblies by their keys in the ".data" object.
+		map<string, variant<bytes const*, Assembly const*>> data;
 		for (auto const& i: m_data)
 			if (u256(i.first) >= m_subs.size())
-				data[toStringInHex((u256)i.first)] = toHex(i.second);
-
+				data[toStringInHex((u256)i.first)] = &i.second;
 		for (size_t i = 0; i < m_subs.size(); ++i)
 		{
 			std::stringstream hexStr;
 			hexStr << hex << i;
-			data[hexStr.str()] = m_subs[i]->assemblyJSON(_sourceIndices);
+			data[hexStr.str()] = m_subs[i].get();
 		}
-	}
 
-	if (m_auxiliaryData.size() > 0)
-		root[".auxdata"] = toHex(m_auxiliaryData);
-
-	return root;
+		_writer.beginObject(".data");
+		for (auto const& [key, value]: data)
+			if (auto const* sub = get_if<Assembly const*>(&value))
+			{
+				_writer.beginObject(key);
+				(*sub)->assemblyJSON(_writer, _sourceIndices);
+				_writer.endObject();
+			}
+			else
+				_writer.addMember(key, toHex(*get<bytes const*>(value)));
+		_writer.endObject();
+	}
 }
 
 AssemblyItem Assembly::namedTag(string const& _name)
@@ -394,28 +443,77 @@ Assembly& Assembly::optimise(bool _enable, EVMVersion _evmVersion, bool _isCreat
 
 Assembly& Assembly::optimise(OptimiserSettings const& _settings)
 {
+	util::CompilationStatistics::PhaseTimer timer("evmAssemblyOptimiser");
 	optimiseInternal(_settings, {});
 	return *this;
 }
 
+bool Assembly::subAssembliesDisjoint() const
+{
+	set<Assembly const*> seen;
+	for (auto const& sub: m_subs)
+	{
+		set<Assembly const*> reachable;
+		sub->collectAssemblies(reachable);
+		for (Assembly const* assembly: reachable)
+			if (!seen.insert(assembly).second)
+				return false;
+	}
+	return true;
+}
+
+void Assembly::collectAssemblies(set<Assembly const*>& _assemblies) const
+{
+	if (!m_optimised && _assemblies.insert(this).second)
+		for (auto const& sub: m_subs)
+			sub->collectAssemblies(_assemblies);
+}
+
 map<u256, u256> Assembly::optimiseInternal(
 	OptimiserSettings const& _settings,
 	std::set<size_t> _tagsReferencedFromOutside
 )
 {
 	// Run optimisation for sub-assemblies.
+	// All referenced tags are determined first, since the tag replacements below only modify
+	// the tags pushed for the respective sub-assembly.
+	// Sub-assemblies that are shared with other assemblies and have already been optimised,
+	// like the code of a contract created by several contracts, are not optimised again.
+	vector<set<size_t>> referencedTags;
 	for (size_t subId = 0; subId < m_subs.size(); ++subId)
+		referencedTags.emplace_back(JumpdestRemover::referencedTags(m_items, subId));
+
+	OptimiserSettings subSettings = _settings;
+	// Disable creation mode for sub-assemblies.
+	subSettings.isCreation = false;
+	vector<map<u256, u256>> subTagReplacements(m_subs.size());
+	size_t const threads = min(util::ThreadPool::effectiveThreads(_settings.parallelism), m_subs.size());
+	if (threads > 1 && subAssembliesDisjoint())
 	{
-		OptimiserSettings settings = _settings;
-		// Disable creation mode for sub-assemblies.
-		settings.isCreation = false;
-		map<u256, u256> subTagReplacements = m_subs[subId]->optimiseInternal(
-			settings,
-			JumpdestRemover::referencedTags(m_items, subId)
-		);
-		// Apply the replacements (can be empty).
-		BlockDeduplicator::applyTagReplacement(m_items, subTagReplacements, subId);
+		// The threads are only used at this level to avoid oversubscription.
+		subSettings.parallelism = 1;
+		util::CompilationStatistics* statistics = util::CompilationStatistics::current();
+		// Statistics are collected per thread, so each sub records into its own object.
+		vector<util::CompilationStatistics> subStatistics(statistics ? m_subs.size() : 0);
+		util::ThreadPool pool(threads);
+		for (size_t subId = 0; subId < m_subs.size(); ++subId)
+			pool.submit([&, subId]() {
+				util::CompilationStatistics::Scope scope(statistics ? &subStatistics[subId] : nullptr);
+				if (!m_subs[subId]->m_optimised)
+					subTagReplacements[subId] = m_subs[subId]->optimiseInternal(subSettings, referencedTags[subId]);
+			});
+		pool.wait();
+		for (util::CompilationStatistics const& subStatistic: subStatistics)
+			statistics->merge(subStatistic);
 	}
+	else
+		for (size_t subId = 0; subId < m_subs.size(); ++subId)
+			if (!m_subs[subId]->m_optimised)
+				subTagReplacements[subId] = m_subs[subId]->optimiseInternal(subSettings, referencedTags[subId]);
+
+	// Apply the replacements (can be empty).
+	for (size_t subId = 0; subId < m_subs.size(); ++subId)
+		BlockDeduplicator::applyTagReplacement(m_items, subTagReplacements[subId], subId);
 
 	map<u256, u256> tagReplacements;
 	// Iterate until no new optimisation possibilities are found.
@@ -424,6 +522,8 @@ map<u256, u256> Assembly::optimiseInternal(
 		count = 0;
 
 		if (_settings.runInliner)
+		{
+			util::Tracer::Span span("evmAssemblyOptimiserStep", "Inliner");
 			Inliner{
 				m_items,
 				_tagsReferencedFromOutside,
@@ -431,9 +531,11 @@ map<u256, u256> Assembly::optimiseInternal(
 				_settings.isCreation,
 				_settings.evmVersion
 			}.optimise();
+		}
 
 		if (_settings.runJumpdestRemover)
 		{
+			util::Tracer::Span span("evmAssemblyOptimiserStep", "JumpdestRemover");
 			JumpdestRemover jumpdestOpt{m_items};
 			if (jumpdestOpt.optimise(_tagsReferencedFromOutside))
 				count++;
@@ -441,6 +543,7 @@ map<u256, u256> Assembly::optimiseInternal(
 
 		if (_settings.runPeephole)
 		{
+			util::Tracer::Span span("evmAssemblyOptimiserStep", "PeepholeOptimiser");
 			PeepholeOptimiser peepOpt{m_items};
 			while (peepOpt.optimise())
 			{
@@ -452,6 +555,7 @@ map<u256, u256> Assembly::optimiseInternal(
 		// This only modifies PushTags, we have to run again to actually remove code.
 		if (_settings.runDeduplicate)
 		{
+			util::Tracer::Span span("evmAssemblyOptimiserStep", "BlockDeduplicator");
 			BlockDeduplicator deduplicator{m_items};
 			if (deduplicator.deduplicate())
 			{
@@ -480,6 +584,7 @@ map<u256, u256> Assembly::optimiseInternal(
 			// Control flow graph optimization has been here before but is disabled because it
 			// assumes we only jump to tags that are pushed. This is not the case anymore with
 			// function types that can be stored in storage.
+			util::Tracer::Span span("evmAssemblyOptimiserStep", "CommonSubexpressionEliminator");
 			AssemblyItems optimisedItems;
 
 			bool usesMSize = (find(m_items.begin(), m_items.end(), AssemblyItem{Instruction::MSIZE}) != m_items.end());
@@ -520,19 +625,25 @@ map<u256, u256> Assembly::optimiseInternal(
 			if (optimisedItems.size() < m_items.size())
 			{
 				m_items = move(optimisedItems);
+				m_itemsMemory.set(m_items.capacity() * sizeof(AssemblyItem));
 				count++;
 			}
 		}
 	}
 
 	if (_settings.runConstantOptimiser)
+	{
+		util::Tracer::Span span("evmAssemblyOptimiserStep", "ConstantOptimiser");
 		ConstantOptimisationMethod::optimiseConstants(
 			_settings.isCreation,
 			_settings.isCreation ? 1 : _settings.expectedExecutionsPerDeployment,
 			_settings.evmVersion,
-			*this
+			*this,
+			_settings.constantCache.get()
 		);
+	}
 
+	m_optimised = true;
 	return tagReplacements;
 }
 
@@ -540,11 +651,12 @@ LinkerObject const& Assembly::assemble() const
 {
 	assertThrow(!m_invalid, AssemblyException, "Attempted to assemble invalid Assembly object.");
 	// Return the already assembled object, if present.
-	if (!m_assembledObject.bytecode.empty())
+	if (m_assembled)
 		return m_assembledObject;
 	// Otherwise ensure the object is actually clear.
 	assertThrow(m_assembledObject.linkReferences.empty(), AssemblyException, "Unexpected link references.");
 
+	util::CompilationStatistics::PhaseTimer timer("assembly");
 	LinkerObject& ret = m_assembledObject;
 
 	size_t subTagSize = 1;
@@ -586,9 +698,12 @@ LinkerObject const& Assembly::assemble() const
 
 	unsigned bytesRequiredForCode = bytesRequired(static_cast<unsigned>(subTagSize));
 	m_tagPositionsInBytecode = vector<size_t>(m_usedTags, numeric_limits<size_t>::max());
-	map<size_t, pair<size_t, size_t>> tagRef;
+	/// Code locations of tag references, in increasing order, together with the referenced
+	/// sub id and tag id (see AssemblyItem::splitForeignPushTag).
+	vector<pair<size_t, pair<size_t, size_t>>> tagRef;
 	multimap<h256, unsigned> dataRef;
-	multimap<size_t, size_t> subRef;
+	/// Pairs of sub id and the code location where the offset of that sub is inserted.
+	vector<pair<size_t, size_t>> subRef;
 	vector<unsigned> sizeRef; ///< Pointers to code locations where the size of the program is inserted
 	unsigned bytesPerTag = util::bytesRequired(bytesRequiredForCode);
 	uint8_t tagPush = static_cast<uint8_t>(pushInstruction(bytesPerTag));
@@ -615,14 +730,10 @@ LinkerObject const& Assembly::assemble() const
 		case PushString:
 		{
 			ret.bytecode.push_back(static_cast<uint8_t>(Instruction::PUSH32));
-			unsigned ii = 0;
-			for (auto j: m_strings.at(h256(i.data())))
-				if (++ii > 32)
-					break;
-				else
-					ret.bytecode.push_back(uint8_t(j));
-			while (ii++ < 32)
-				ret.bytecode.push_back(0);
+			string const& str = m_strings.at(h256(i.data()));
+			size_t const start = ret.bytecode.size();
+			ret.bytecode.resize(start + 32, 0);
+			copy_n(str.begin(), min<size_t>(str.size(), 32), ret.bytecode.begin() + static_cast<ptrdiff_t>(start));
 			break;
 		}
 		case Push:
@@ -637,7 +748,7 @@ LinkerObject const& Assembly::assemble() const
 		case PushTag:
 		{
 			ret.bytecode.push_back(tagPush);
-			tagRef[ret.bytecode.size()] = i.splitForeignPushTag();
+			tagRef.emplace_back(ret.bytecode.size(), i.splitForeignPushTag());
 			ret.bytecode.resize(ret.bytecode.size() + bytesPerTag);
 			break;
 		}
@@ -649,14 +760,14 @@ LinkerObject const& Assembly::assemble() const
 		case PushSub:
 			assertThrow(i.data() <= numeric_limits<size_t>::max(), AssemblyException, "");
 			ret.bytecode.push_back(dataRefPush);
-			subRef.insert(make_pair(static_cast<size_t>(i.data()), ret.bytecode.size()));
+			subRef.emplace_back(static_cast<size_t>(i.data()), ret.bytecode.size());
 			ret.bytecode.resize(ret.bytecode.size() + bytesPerDataRef);
 			break;
 		case PushSubSize:
 		{
 			assertThrow(i.data() <= numeric_limits<size_t>::max(), AssemblyException, "");
 			auto s = subAssemblyById(static_cast<size_t>(i.data()))->assemble().bytecode.size();
-			i.setPushedValue(u256(s));
+			i.setPushedValue(s);
 			unsigned b = max<unsigned>(1, util::bytesRequired(s));
 			ret.bytecode.push_back(static_cast<uint8_t>(pushInstruction(b)));
 			ret.bytecode.resize(ret.bytecode.size() + b);
@@ -736,6 +847,8 @@ LinkerObject const& Assembly::assemble() const
 		// Append an INVALID here to help tests find miscompilation.
 		ret.bytecode.push_back(static_cast<uint8_t>(Instruction::INVALID));
 
+	// Sub-assemblies are appended in the order of their ids and then of their references.
+	stable_sort(subRef.begin(), subRef.end(), [](auto const& _a, auto const& _b) { return _a.first < _b.first; });
 	for (auto const& [subIdPath, bytecodeOffset]: subRef)
 	{
 		bytesRef r(ret.bytecode.data() + bytecodeOffset, bytesPerDataRef);
@@ -780,6 +893,7 @@ LinkerObject const& Assembly::assemble() const
 		bytesRef r(ret.bytecode.data() + pos, bytesPerDataRef);
 		toBigEndian(ret.bytecode.size(), r);
 	}
+	m_assembled = true;
 	return ret;
 }
 
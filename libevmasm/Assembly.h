@@ -28,7 +28,9 @@
 
 #include <libsolutil/Common.h>
 #include <libsolutil/Assertions.h>
+#include <libsolutil/JsonWriter.h>
 #include <libsolutil/Keccak256.h>
+#include <libsolutil/MemoryAccounting.h>
 
 #include <json/json.h>
 
@@ -39,6 +41,7 @@
 namespace solidity::evmasm
 {
 
+class ConstantOptimisationCache;
 using AssemblyPointer = std::shared_ptr<Assembly>;
 
 class Assembly
@@ -119,6 +122,11 @@ public:
 		/// This specifies an estimate on how often each opcode in this assembly will be executed,
 		/// i.e. use a small value to optimise for size and a large value to optimise for runtime gas usage.
 		size_t expectedExecutionsPerDeployment = 200;
+		/// Number of threads used to optimise the sub-assemblies concurrently, zero meaning one
+		/// thread per hardware thread. The result does not depend on this value.
+		size_t parallelism = 1;
+		/// Representations of constants shared with the other assemblies of the compilation, if any.
+		std::shared_ptr<ConstantOptimisationCache> constantCache;
 	};
 
 	/// Modify and return the current assembly such that creation and execution gas usage
@@ -146,6 +154,10 @@ public:
 	Json::Value assemblyJSON(
 		std::map<std::string, unsigned> const& _sourceIndices = std::map<std::string, unsigned>()
 	) const;
+	/// Adds the members of the JSON representation of the assembly to the current object of @a _writer.
+	/// Writers that print the object print the items and the sub-assemblies one by one
+	/// without building their JSON representation as a whole.
+	void assemblyJSON(util::JsonWriter& _writer, std::map<std::string, unsigned> const& _sourceIndices) const;
 
 	/// Mark this assembly as invalid. Calling ``assemble`` on it will throw.
 	void markAsInvalid() { m_invalid = true; }
@@ -158,6 +170,12 @@ protected:
 	/// returns the replaced tags. Also takes an argument containing the tags of this assembly
 	/// that are referenced in a super-assembly.
 	std::map<u256, u256> optimiseInternal(OptimiserSettings const& _settings, std::set<size_t> _tagsReferencedFromOutside);
+	/// @returns true if no assembly is reachable from more than one of the sub-assemblies,
+	/// i.e. if the sub-assemblies can be optimised independently.
+	bool subAssembliesDisjoint() const;
+	/// Adds this assembly and all assemblies reachable from it to @a _assemblies, skipping
+	/// the ones that have already been optimised.
+	void collectAssemblies(std::set<Assembly const*>& _assemblies) const;
 
 	unsigned bytesRequired(unsigned subTagSize) const;
 
@@ -171,6 +189,9 @@ private:
 		std::string _jumpType = std::string()
 	);
 	static std::string toStringInHex(u256 _value);
+	/// Calls @a _append with each entry of the ".code" array of the JSON representation.
+	template <typename Append>
+	void codeJSON(std::map<std::string, unsigned> const& _sourceIndices, Append&& _append) const;
 
 	bool m_invalid = false;
 
@@ -181,6 +202,8 @@ protected:
 	unsigned m_usedTags = 1;
 	std::map<std::string, size_t> m_namedTags;
 	AssemblyItems m_items;
+	/// Memory reserved for the items.
+	util::MemoryAccount m_itemsMemory{util::MemorySubsystem::EVMAssembly};
 	std::map<util::h256, bytes> m_data;
 	/// Data that is appended to the very end of the contract.
 	bytes m_auxiliaryData;
@@ -194,7 +217,12 @@ protected:
 	std::map<std::vector<size_t>, size_t> m_subPaths;
 
 	mutable LinkerObject m_assembledObject;
+	/// Whether m_assembledObject is set, after which the assembly is only read.
+	mutable bool m_assembled = false;
 	mutable std::vector<size_t> m_tagPositionsInBytecode;
+	/// Whether the assembly has been optimised. It is then only read when optimising
+	/// the assemblies that contain it.
+	bool m_optimised = false;
 
 	int m_deposit = 0;
 	/// Internal name of the assembly object, only used with the Yul backend
@@ -26,6 +26,8 @@
 #include <liblangutil/SourceLocation.h>
 
 #include <fstream>
+#include <mutex>
+#include <set>
 
 using namespace std;
 using namespace solidity;
@@ -34,6 +36,33 @@ using namespace solidity::langutil;
 
 static_assert(sizeof(size_t) <= 8, "size_t must be at most 64-bits wide");
 
+namespace
+{
+
+/// @returns a value equal to @a _value that stays valid until the end of the program.
+/// Every value is stored only once, so that interned values can be compared by their address.
+u256 const* internLargeValue(u256 const& _value)
+{
+	// The values are never freed. Only values that do not fit into 64 bits end up here, i.e.
+	// mostly hashes of data, immutables and library names, tags of sub-assemblies and large
+	// literals, and there are few of them compared to the items referring to them.
+	static mutex poolMutex;
+	static set<u256> pool;
+	lock_guard<mutex> lock(poolMutex);
+	return &*pool.insert(_value).first;
+}
+
+}
+
+void AssemblyItem::storeData(u256 const& _data)
+{
+	m_hasLargeData = _data > numeric_limits<uint64_t>::max();
+	if (m_hasLargeData)
+		m_largeData = internLargeValue(_data);
+	else
+		m_smallData = static_cast<uint64_t>(_data);
+}
+
 AssemblyItem AssemblyItem::toSubAssemblyTag(size_t _subId) const
 {
 	assertThrow(data() < (u256(1) << 64), util::Exception, "Tag already has subassembly set.");
@@ -87,8 +116,8 @@ size_t AssemblyItem::bytesRequired(size_t _addressLength) const
 	case PushImmutable:
 		return 1 + 32;
 	case AssignImmutable:
-		if (m_immutableOccurrences)
-			return 1 + (3 + 32) * *m_immutableOccurrences;
+		if (m_immutableOccurrences != NoValue)
+			return 1 + (3 + 32) * m_immutableOccurrences;
 		else
 			return 1 + (3 + 32) * 1024; // 1024 occurrences are beyond the maximum code size anyways.
 	default:
@@ -324,12 +353,17 @@ std::string AssemblyItem::computeSourceMapping(
 )
 {
 	string ret;
+	// Most items repeat the location of their predecessor.
+	ret.reserve(_items.size() * 2);
 
 	int prevStart = -1;
 	int prevLength = -1;
 	int prevSourceIndex = -1;
 	int prevModifierDepth = -1;
 	char prevJump = 0;
+	// Consecutive items mostly share the name of their source, so the index is only looked up
+	// if the name differs from that of the previous item.
+	string const* prevSourceName = nullptr;
 	for (auto const& item: _items)
 	{
 		if (!ret.empty())
@@ -337,10 +371,13 @@ std::string AssemblyItem::computeSourceMapping(
 
 		SourceLocation const& location = item.location();
 		int length = location.start != -1 && location.end != -1 ? location.end - location.start : -1;
-		int sourceIndex =
-			location.source && _sourceIndicesMap.count(location.source->name()) ?
-			static_cast<int>(_sourceIndicesMap.at(location.source->name())) :
-			-1;
+		int sourceIndex = prevSourceIndex;
+		if (location.sourceName != prevSourceName)
+		{
+			prevSourceName = location.sourceName;
+			auto index = prevSourceName ? _sourceIndicesMap.find(*prevSourceName) : _sourceIndicesMap.end();
+			sourceIndex = index != _sourceIndicesMap.end() ? static_cast<int>(index->second) : -1;
+		}
 		char jump = '-';
 		if (item.getJumpType() == evmasm::AssemblyItem::JumpType::IntoFunction)
 			jump = 'i';
@@ -28,7 +28,9 @@
 #include <libsolutil/Common.h>
 #include <libsolutil/Assertions.h>
 #include <iostream>
+#include <optional>
 #include <sstream>
+#include <type_traits>
 
 namespace solidity::evmasm
 {
@@ -54,10 +56,17 @@ class Assembly;
 class AssemblyItem;
 using AssemblyItems = std::vector<AssemblyItem>;
 
+/**
+ * A single item of an assembly: an instruction, a tag or a push of some (possibly symbolic) value.
+ *
+ * Items are copied a lot by the optimiser, so they are kept trivially copyable. Data that fits
+ * into 64 bits (instructions, tags, sub-assembly ids, most pushed constants) is stored inline
+ * and larger values are interned in a constant pool shared by all assemblies.
+ */
 class AssemblyItem
 {
 public:
-	enum class JumpType { Ordinary, IntoFunction, OutOfFunction };
+	enum class JumpType: uint8_t { Ordinary, IntoFunction, OutOfFunction };
 
 	AssemblyItem(u256 _push, langutil::SourceLocation _location = langutil::SourceLocation()):
 		AssemblyItem(Push, std::move(_push), std::move(_location)) { }
@@ -66,14 +75,14 @@ public:
 		m_instruction(_i),
 		m_location(std::move(_location))
 	{}
-	AssemblyItem(AssemblyItemType _type, u256 _data = 0, langutil::SourceLocation _location = langutil::SourceLocation()):
+	AssemblyItem(AssemblyItemType _type, u256 const& _data = 0, langutil::SourceLocation _location = langutil::SourceLocation()):
 		m_type(_type),
 		m_location(std::move(_location))
 	{
 		if (m_type == Operation)
 			m_instruction = Instruction(uint8_t(_data));
 		else
-			m_data = std::make_shared<u256>(std::move(_data));
+			storeData(_data);
 	}
 	AssemblyItem(AssemblyItem const&) = default;
 	AssemblyItem(AssemblyItem&&) = default;
@@ -92,8 +101,12 @@ public:
 	void setPushTagSubIdAndTag(size_t _subId, size_t _tag);
 
 	AssemblyItemType type() const { return m_type; }
-	u256 const& data() const { assertThrow(m_type != Operation, util::Exception, ""); return *m_data; }
-	void setData(u256 const& _data) { assertThrow(m_type != Operation, util::Exception, ""); m_data = std::make_shared<u256>(_data); }
+	u256 data() const
+	{
+		assertThrow(m_type != Operation, util::Exception, "");
+		return m_hasLargeData ? *m_largeData : u256(m_smallData);
+	}
+	void setData(u256 const& _data) { assertThrow(m_type != Operation, util::Exception, ""); storeData(_data); }
 
 	/// @returns the instruction of this item (only valid if type() == Operation)
 	Instruction instruction() const { assertThrow(m_type == Operation, util::Exception, ""); return m_instruction; }
@@ -105,8 +118,13 @@ public:
 			return false;
 		if (type() == Operation)
 			return instruction() == _other.instruction();
+		// The representation of a value is unique and large values are interned.
+		else if (m_hasLargeData != _other.m_hasLargeData)
+			return false;
+		else if (m_hasLargeData)
+			return m_largeData == _other.m_largeData;
 		else
-			return data() == _other.data();
+			return m_smallData == _other.m_smallData;
 	}
 	bool operator!=(AssemblyItem const& _other) const { return !operator==(_other); }
 	/// Less-than operator compatible with operator==.
@@ -116,8 +134,12 @@ public:
 			return type() < _other.type();
 		else if (type() == Operation)
 			return instruction() < _other.instruction();
+		else if (!m_hasLargeData && !_other.m_hasLargeData)
+			return m_smallData < _other.m_smallData;
+		else if (m_hasLargeData != _other.m_hasLargeData)
+			return _other.m_hasLargeData;
 		else
-			return data() < _other.data();
+			return *m_largeData < *_other.m_largeData;
 	}
 
 	/// Shortcut that avoids constructing an AssemblyItem just to perform the comparison.
@@ -149,28 +171,46 @@ public:
 	JumpType getJumpType() const { return m_jumpType; }
 	std::string getJumpTypeAsString() const;
 
-	void setPushedValue(u256 const& _value) const { m_pushedValue = std::make_shared<u256>(_value); }
-	u256 const* pushedValue() const { return m_pushedValue.get(); }
+	void setPushedValue(size_t _value) const { m_pushedValue = _value; }
+	std::optional<u256> pushedValue() const
+	{
+		return m_pushedValue != NoValue ? std::make_optional<u256>(m_pushedValue) : std::nullopt;
+	}
 
 	std::string toAssemblyText(Assembly const& _assembly) const;
 
 	size_t m_modifierDepth = 0;
 
-	void setImmutableOccurrences(size_t _n) const { m_immutableOccurrences = std::make_shared<size_t>(_n); }
+	void setImmutableOccurrences(size_t _n) const { m_immutableOccurrences = _n; }
 
 private:
+	/// Marks unset values of @a m_pushedValue and @a m_immutableOccurrences.
+	static constexpr size_t NoValue = std::numeric_limits<size_t>::max();
+
+	/// Stores @a _data inline if it fits into 64 bits and in the constant pool otherwise.
+	void storeData(u256 const& _data);
+
 	AssemblyItemType m_type;
 	Instruction m_instruction; ///< Only valid if m_type == Operation
-	std::shared_ptr<u256> m_data; ///< Only valid if m_type != Operation
-	langutil::SourceLocation m_location;
 	JumpType m_jumpType = JumpType::Ordinary;
+	/// True if the data does not fit into 64 bits and @a m_largeData is the active member.
+	bool m_hasLargeData = false;
+	/// Only valid if m_type != Operation.
+	union
+	{
+		uint64_t m_smallData = 0;
+		u256 const* m_largeData;
+	};
+	langutil::SourceLocation m_location;
 	/// Pushed value for operations with data to be determined during assembly stage,
 	/// e.g. PushSubSize, PushTag, PushSub, etc.
-	mutable std::shared_ptr<u256> m_pushedValue;
+	mutable size_t m_pushedValue = NoValue;
 	/// Number of PushImmutable's with the same hash. Only used for AssignImmutable.
-	mutable std::shared_ptr<size_t> m_immutableOccurrences;
+	mutable size_t m_immutableOccurrences = NoValue;
 };
 
+static_assert(std::is_trivially_copyable_v<AssemblyItem>, "Assembly items are copied a lot and must stay cheap to copy.");
+
 inline size_t bytesRequired(AssemblyItems const& _items, size_t _addressLength)
 {
 	size_t size = 0;
@@ -27,8 +27,12 @@
 #include <libevmasm/AssemblyItem.h>
 #include <libevmasm/SemanticInformation.h>
 
+#include <boost/functional/hash.hpp>
+
+#include <algorithm>
 #include <functional>
-#include <set>
+#include <limits>
+#include <unordered_map>
 
 using namespace std;
 using namespace solidity;
@@ -49,52 +53,94 @@ bool BlockDeduplicator::deduplicate()
 	)
 		return false;
 
-	function<bool(size_t, size_t)> comparator = [&](size_t _i, size_t _j)
+	auto blockBegin = [&](size_t _i, AssemblyItem const& _pushTag)
 	{
-		if (_i == _j)
-			return false;
-
-		// To compare recursive loops, we have to already unify PushTag opcodes of the
-		// block's own tag.
-		AssemblyItem pushFirstTag{pushSelf};
-		AssemblyItem pushSecondTag{pushSelf};
-
-		if (_i < m_items.size() && m_items.at(_i).type() == Tag)
-			pushFirstTag = m_items.at(_i).pushTag();
-		if (_j < m_items.size() && m_items.at(_j).type() == Tag)
-			pushSecondTag = m_items.at(_j).pushTag();
-
 		using diff_type = BlockIterator::difference_type;
-		BlockIterator first{m_items.begin() + diff_type(_i), m_items.end(), &pushFirstTag, &pushSelf};
-		BlockIterator second{m_items.begin() + diff_type(_j), m_items.end(), &pushSecondTag, &pushSelf};
-		BlockIterator end{m_items.end(), m_items.end()};
-
-		if (first != end && (*first).type() == Tag)
-			++first;
-		if (second != end && (*second).type() == Tag)
-			++second;
+		BlockIterator it{m_items.begin() + diff_type(_i), m_items.end(), &_pushTag, &pushSelf};
+		if (it != BlockIterator{m_items.end(), m_items.end()} && (*it).type() == Tag)
+			++it;
+		return it;
+	};
+	BlockIterator end{m_items.end(), m_items.end()};
+
+	// Positions of the tags, the self-reference of the respective block and the position
+	// behind its last item. The blocks do not change their structure during deduplication,
+	// only the PushTags inside them.
+	vector<size_t> blockStarts;
+	vector<AssemblyItem> pushSelfTags;
+	vector<size_t> blockEnds;
+	for (size_t i = 0; i < m_items.size(); ++i)
+		if (m_items[i].type() == Tag)
+		{
+			blockStarts.push_back(i);
+			pushSelfTags.push_back(m_items[i].pushTag());
+			BlockIterator it = blockBegin(i, pushSelfTags.back());
+			AssemblyItems::const_iterator last = m_items.begin() + BlockIterator::difference_type(i);
+			for (; it != end; ++it)
+				last = it.it;
+			blockEnds.push_back(static_cast<size_t>(last - m_items.begin()) + 1);
+		}
 
-		return std::lexicographical_compare(first, end, second, end);
+	// Hash of the contents of a block with the PushTags of its own tag normalized, so that
+	// the full comparison below is only needed for blocks in the same bucket.
+	auto blockHash = [&](size_t _block)
+	{
+		size_t hash = 0;
+		for (BlockIterator it = blockBegin(blockStarts[_block], pushSelfTags[_block]); it != end; ++it)
+		{
+			AssemblyItem const& item = *it;
+			boost::hash_combine(hash, static_cast<int>(item.type()));
+			if (item.type() == Operation)
+				boost::hash_combine(hash, static_cast<int>(item.instruction()));
+			else
+				boost::hash_combine(hash, static_cast<size_t>(item.data() & numeric_limits<size_t>::max()));
+		}
+		return hash;
+	};
+	auto equalBlocks = [&](size_t _first, size_t _second)
+	{
+		return std::equal(
+			blockBegin(blockStarts[_first], pushSelfTags[_first]),
+			end,
+			blockBegin(blockStarts[_second], pushSelfTags[_second]),
+			end
+		);
 	};
 
+	vector<size_t> hashes(blockStarts.size());
+	for (size_t block = 0; block < blockStarts.size(); ++block)
+		hashes[block] = blockHash(block);
+
 	size_t iterations = 0;
 	for (; ; ++iterations)
 	{
-		//@todo this should probably be optimized.
-		set<size_t, function<bool(size_t, size_t)>> blocksSeen(comparator);
-		for (size_t i = 0; i < m_items.size(); ++i)
+		// Maps the hashes of the blocks to the first blocks with that hash and different contents.
+		unordered_map<size_t, vector<size_t>> blocksSeen;
+		for (size_t block = 0; block < blockStarts.size(); ++block)
 		{
-			if (m_items.at(i).type() != Tag)
-				continue;
-			auto it = blocksSeen.find(i);
-			if (it == blocksSeen.end())
-				blocksSeen.insert(i);
+			vector<size_t>& bucket = blocksSeen[hashes[block]];
+			auto it = find_if(bucket.begin(), bucket.end(), [&](size_t _other) { return equalBlocks(_other, block); });
+			if (it == bucket.end())
+				bucket.push_back(block);
 			else
-				m_replacedTags[m_items.at(i).data()] = m_items.at(*it).data();
+				m_replacedTags[m_items.at(blockStarts[block]).data()] = m_items.at(blockStarts[*it]).data();
 		}
 
+		// Only the blocks containing a PushTag that is replaced have to be hashed again.
+		vector<size_t> changedPositions;
+		for (size_t i = 0; i < m_items.size(); ++i)
+			if (m_items[i].type() == PushTag && m_replacedTags.count(m_items[i].data()))
+				changedPositions.push_back(i);
+
 		if (!applyTagReplacement(m_items, m_replacedTags))
 			break;
+
+		for (size_t block = 0; block < blockStarts.size(); ++block)
+		{
+			auto changed = lower_bound(changedPositions.begin(), changedPositions.end(), blockStarts[block]);
+			if (changed != changedPositions.end() && *changed < blockEnds[block])
+				hashes[block] = blockHash(block);
+		}
 	}
 	return iterations > 0;
 }
@@ -40,14 +40,13 @@ vector<AssemblyItem> CommonSubexpressionEliminator::getOptimizedItems()
 	KnownState nextInitialState = m_state;
 	if (m_breakingItem)
 		nextInitialState.feedItem(*m_breakingItem);
-	KnownState nextState = nextInitialState;
 
 	ScopeGuard reset([&]()
 	{
 		m_breakingItem = nullptr;
 		m_storeOperations.clear();
-		m_initialState = move(nextInitialState);
-		m_state = move(nextState);
+		m_initialState = nextInitialState;
+		m_state = move(nextInitialState);
 	});
 
 	map<int, Id> initialStackContents;
@@ -32,7 +32,8 @@ unsigned ConstantOptimisationMethod::optimiseConstants(
 	bool _isCreation,
 	size_t _runs,
 	langutil::EVMVersion _evmVersion,
-	Assembly& _assembly
+	Assembly& _assembly,
+	ConstantOptimisationCache* _cache
 )
 {
 	// TODO: design the optimiser in a way this is not needed
@@ -54,21 +55,38 @@ unsigned ConstantOptimisationMethod::optimiseConstants(
 		params.isCreation = _isCreation;
 		params.runs = _runs;
 		params.evmVersion = _evmVersion;
-		LiteralMethod lit(params, item.data());
-		bigint literalGas = lit.gasNeeded();
-		CodeCopyMethod copy(params, item.data());
-		bigint copyGas = copy.gasNeeded();
-		ComputeMethod compute(params, item.data());
-		bigint computeGas = compute.gasNeeded();
+
+		ConstantOptimisationCache::Key key{item.data(), params.multiplicity, params.isCreation, params.runs, params.evmVersion};
+		optional<ConstantOptimisationCache::Entry> choice = _cache ? _cache->find(key) : nullopt;
+		if (!choice)
+		{
+			choice.emplace();
+			LiteralMethod lit(params, item.data());
+			bigint literalGas = lit.gasNeeded();
+			CodeCopyMethod copy(params, item.data());
+			bigint copyGas = copy.gasNeeded();
+			ComputeMethod compute(params, item.data());
+			bigint computeGas = compute.gasNeeded();
+			if (copyGas < literalGas && copyGas < computeGas)
+				choice->method = ConstantOptimisationCache::Method::CodeCopy;
+			else if (computeGas < literalGas && computeGas <= copyGas)
+			{
+				choice->method = ConstantOptimisationCache::Method::Compute;
+				choice->routine = compute.execute(_assembly);
+			}
+			if (_cache)
+				_cache->insert(move(key), *choice);
+		}
+
 		AssemblyItems replacement;
-		if (copyGas < literalGas && copyGas < computeGas)
+		if (choice->method == ConstantOptimisationCache::Method::CodeCopy)
 		{
-			replacement = copy.execute(_assembly);
+			replacement = CodeCopyMethod(params, item.data()).execute(_assembly);
 			optimisations++;
 		}
-		else if (computeGas < literalGas && computeGas <= copyGas)
+		else if (choice->method == ConstantOptimisationCache::Method::Compute)
 		{
-			replacement = compute.execute(_assembly);
+			replacement = move(choice->routine);
 			optimisations++;
 		}
 		if (!replacement.empty())
@@ -79,6 +97,21 @@ unsigned ConstantOptimisationMethod::optimiseConstants(
 	return optimisations;
 }
 
+optional<ConstantOptimisationCache::Entry> ConstantOptimisationCache::find(Key const& _key) const
+{
+	lock_guard<mutex> lock(m_mutex);
+	auto it = m_entries.find(_key);
+	if (it == m_entries.end())
+		return nullopt;
+	return it->second;
+}
+
+void ConstantOptimisationCache::insert(Key _key, Entry _entry)
+{
+	lock_guard<mutex> lock(m_mutex);
+	m_entries.emplace(move(_key), move(_entry));
+}
+
 bigint ConstantOptimisationMethod::simpleRunGas(AssemblyItems const& _items)
 {
 	bigint gas = 0;
@@ -22,20 +22,24 @@
 
 #pragma once
 
+#include <libevmasm/AssemblyItem.h>
 #include <libevmasm/Exceptions.h>
 
 #include <liblangutil/EVMVersion.h>
 
 #include <libsolutil/Assertions.h>
 
+#include <map>
+#include <mutex>
+#include <optional>
+#include <tuple>
 #include <vector>
 
 namespace solidity::evmasm
 {
 
-class AssemblyItem;
-using AssemblyItems = std::vector<AssemblyItem>;
 class Assembly;
+class ConstantOptimisationCache;
 
 /**
  * Abstract base class for one way to change how constants are represented in the code.
@@ -46,11 +50,14 @@ public:
 	/// Tries to optimised how constants are represented in the source code and modifies
 	/// @a _assembly.
 	/// @returns zero if no optimisations could be performed.
+	/// If @a _cache is given, the choice of the method for each constant is looked up there
+	/// and stored there.
 	static unsigned optimiseConstants(
 		bool _isCreation,
 		size_t _runs,
 		langutil::EVMVersion _evmVersion,
-		Assembly& _assembly
+		Assembly& _assembly,
+		ConstantOptimisationCache* _cache = nullptr
 	);
 
 protected:
@@ -160,4 +167,31 @@ protected:
 	AssemblyItems m_routine;
 };
 
+/**
+ * Cheapest representations of constants found by the constant optimiser during one compilation,
+ * keyed by the constant and all parameters that influence the choice. Constants like masks
+ * and selectors appear in many assemblies, and finding a computation for them is expensive.
+ * Safe to use concurrently.
+ */
+class ConstantOptimisationCache
+{
+public:
+	enum class Method { Literal, CodeCopy, Compute };
+	struct Entry
+	{
+		Method method = Method::Literal;
+		/// The routine computing the constant if @a method is Compute.
+		AssemblyItems routine;
+	};
+	/// Value, multiplicity, creation mode, runs and EVM version.
+	using Key = std::tuple<u256, size_t, bool, size_t, langutil::EVMVersion>;
+
+	std::optional<Entry> find(Key const& _key) const;
+	void insert(Key _key, Entry _entry);
+
+private:
+	mutable std::mutex m_mutex;
+	std::map<Key, Entry> m_entries;
+};
+
 }
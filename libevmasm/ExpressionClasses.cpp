@@ -27,7 +27,10 @@
 #include <libevmasm/CommonSubexpressionEliminator.h>
 #include <libevmasm/SimplificationRules.h>
 
+#include <boost/functional/hash.hpp>
+
 #include <functional>
+#include <limits>
 #include <tuple>
 #include <utility>
 
@@ -36,23 +39,34 @@ using namespace solidity;
 using namespace solidity::evmasm;
 using namespace solidity::langutil;
 
-bool ExpressionClasses::Expression::operator<(ExpressionClasses::Expression const& _other) const
+bool ExpressionClasses::Expression::operator==(ExpressionClasses::Expression const& _other) const
 {
 	assertThrow(!!item && !!_other.item, OptimizerException, "");
 	auto type = item->type();
 	auto otherType = _other.item->type();
 	if (type != otherType)
-		return type < otherType;
+		return false;
 	else if (type == Operation)
-	{
-		auto instr = item->instruction();
-		auto otherInstr = _other.item->instruction();
-		return std::tie(instr, arguments, sequenceNumber) <
-			std::tie(otherInstr, _other.arguments, _other.sequenceNumber);
-	}
+		return
+			item->instruction() == _other.item->instruction() &&
+			std::tie(arguments, sequenceNumber) == std::tie(_other.arguments, _other.sequenceNumber);
+	else
+		return
+			item->data() == _other.item->data() &&
+			std::tie(arguments, sequenceNumber) == std::tie(_other.arguments, _other.sequenceNumber);
+}
+
+size_t ExpressionClasses::ExpressionHash::operator()(ExpressionClasses::Expression const& _expression) const
+{
+	assertThrow(!!_expression.item, OptimizerException, "");
+	size_t hash = static_cast<size_t>(_expression.item->type());
+	if (_expression.item->type() == Operation)
+		boost::hash_combine(hash, static_cast<size_t>(_expression.item->instruction()));
 	else
-		return std::tie(item->data(), arguments, sequenceNumber) <
-			std::tie(_other.item->data(), _other.arguments, _other.sequenceNumber);
+		boost::hash_combine(hash, static_cast<size_t>(_expression.item->data() & numeric_limits<size_t>::max()));
+	boost::hash_range(hash, _expression.arguments.begin(), _expression.arguments.end());
+	boost::hash_combine(hash, _expression.sequenceNumber);
+	return hash;
 }
 
 ExpressionClasses::Id ExpressionClasses::find(
@@ -183,7 +197,8 @@ string ExpressionClasses::fullDAGToString(ExpressionClasses::Id _id) const
 
 ExpressionClasses::Id ExpressionClasses::tryToSimplify(Expression const& _expr)
 {
-	static Rules rules;
+	// The rules store the state of the current match, so every thread needs its own copy.
+	static thread_local Rules rules;
 	assertThrow(rules.isInitialized(), OptimizerException, "Rule list not properly initialized.");
 
 	if (
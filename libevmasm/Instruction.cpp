@@ -25,6 +25,7 @@
 #include <libsolutil/Common.h>
 #include <libsolutil/CommonIO.h>
 #include <algorithm>
+#include <array>
 #include <functional>
 
 using namespace std;
@@ -178,7 +179,21 @@ std::map<std::string, Instruction> const solidity::evmasm::c_instructions =
 	{ "SELFDESTRUCT", Instruction::SELFDESTRUCT }
 };
 
-static std::map<Instruction, InstructionInfo> const c_instructionInfo =
+namespace
+{
+
+/// Like InstructionInfo, but can be used in constant expressions.
+struct InstructionData
+{
+	char const* name = nullptr;
+	int additional = 0;
+	int args = 0;
+	int ret = 0;
+	bool sideEffects = false;
+	Tier gasPriceTier = Tier::Invalid;
+};
+
+constexpr pair<Instruction, InstructionData> c_instructionList[] =
 { //												Add, Args, Ret, SideEffects, GasPriceTier
 	{ Instruction::STOP,		{ "STOP",			0, 0, 0, true,  Tier::Zero } },
 	{ Instruction::ADD,			{ "ADD",			0, 2, 1, false, Tier::VeryLow } },
@@ -324,6 +339,20 @@ static std::map<Instruction, InstructionInfo> const c_instructionInfo =
 	{ Instruction::SELFDESTRUCT,	{ "SELFDESTRUCT",		0, 1, 0, true, Tier::Special } }
 };
 
+/// The data of all valid instructions, indexed by their opcode. The table is a constant, so that
+/// it does not have to be built when the program starts.
+constexpr array<InstructionData, 256> makeInstructionTable()
+{
+	array<InstructionData, 256> table{};
+	for (auto const& instruction: c_instructionList)
+		table[static_cast<uint8_t>(instruction.first)] = instruction.second;
+	return table;
+}
+
+constexpr array<InstructionData, 256> c_instructionTable = makeInstructionTable();
+
+}
+
 void solidity::evmasm::eachInstruction(
 	bytes const& _mem,
 	function<void(Instruction,u256 const&)> const& _onInstruction
@@ -356,33 +385,36 @@ void solidity::evmasm::eachInstruction(
 string solidity::evmasm::disassemble(bytes const& _mem)
 {
 	stringstream ret;
+	disassemble(_mem, ret);
+	return ret.str();
+}
+
+void solidity::evmasm::disassemble(bytes const& _mem, ostream& _out)
+{
+	ios::fmtflags const flags = _out.flags();
 	eachInstruction(_mem, [&](Instruction _instr, u256 const& _data) {
 		if (!isValidInstruction(_instr))
-			ret << "0x" << std::uppercase << std::hex << static_cast<int>(_instr) << " ";
+			_out << "0x" << std::uppercase << std::hex << static_cast<int>(_instr) << " ";
 		else
 		{
-			InstructionInfo info = instructionInfo(_instr);
-			ret << info.name << " ";
-			if (info.additional)
-				ret << "0x" << std::uppercase << std::hex << _data << " ";
+			InstructionData const& data = c_instructionTable[static_cast<uint8_t>(_instr)];
+			_out << data.name << " ";
+			if (data.additional)
+				_out << "0x" << std::uppercase << std::hex << _data << " ";
 		}
 	});
-	return ret.str();
+	_out.flags(flags);
 }
 
 InstructionInfo solidity::evmasm::instructionInfo(Instruction _inst)
 {
-	try
-	{
-		return c_instructionInfo.at(_inst);
-	}
-	catch (...)
-	{
+	InstructionData const& data = c_instructionTable[static_cast<uint8_t>(_inst)];
+	if (!data.name)
 		return InstructionInfo({"<INVALID_INSTRUCTION: " + toString((unsigned)_inst) + ">", 0, 0, 0, false, Tier::Invalid});
-	}
+	return InstructionInfo({data.name, data.additional, data.args, data.ret, data.sideEffects, data.gasPriceTier});
 }
 
 bool solidity::evmasm::isValidInstruction(Instruction _inst)
 {
-	return !!c_instructionInfo.count(_inst);
+	return c_instructionTable[static_cast<uint8_t>(_inst)].name != nullptr;
 }
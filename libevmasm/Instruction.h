@@ -26,6 +26,7 @@
 #include <libsolutil/Common.h>
 #include <libsolutil/Assertions.h>
 #include <functional>
+#include <ostream>
 
 namespace solidity::evmasm
 {
@@ -315,5 +316,7 @@ void eachInstruction(bytes const& _mem, std::function<void(Instruction,u256 cons
 
 /// Convert from EVM code to simple EVM assembly language.
 std::string disassemble(bytes const& _mem);
+/// Prints the result of @a disassemble to @a _out without building it as a string first.
+void disassemble(bytes const& _mem, std::ostream& _out);
 
 }
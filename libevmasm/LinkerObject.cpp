@@ -24,6 +24,9 @@
 #include <libsolutil/CommonData.h>
 #include <libsolutil/Keccak256.h>
 
+#include <ostream>
+#include <unordered_map>
+
 using namespace std;
 using namespace solidity;
 using namespace solidity::util;
@@ -38,13 +41,28 @@ void LinkerObject::append(LinkerObject const& _other)
 
 void LinkerObject::link(map<string, h160> const& _libraryAddresses)
 {
-	std::map<size_t, std::string> remainingRefs;
-	for (auto const& linkRef: linkReferences)
-		if (h160 const* address = matchLibrary(linkRef.second, _libraryAddresses))
-			copy(address->data(), address->data() + 20, bytecode.begin() + vector<uint8_t>::difference_type(linkRef.first));
-		else
-			remainingRefs.insert(linkRef);
-	linkReferences.swap(remainingRefs);
+	link({this}, _libraryAddresses);
+}
+
+void LinkerObject::link(vector<LinkerObject*> const& _objects, map<string, h160> const& _libraryAddresses)
+{
+	if (_libraryAddresses.empty())
+		return;
+	unordered_map<string, h160 const*> matches;
+	for (LinkerObject* object: _objects)
+		for (auto it = object->linkReferences.begin(); it != object->linkReferences.end();)
+		{
+			auto [match, inserted] = matches.emplace(it->second, nullptr);
+			if (inserted)
+				match->second = matchLibrary(it->second, _libraryAddresses);
+			if (h160 const* address = match->second)
+			{
+				copy(address->data(), address->data() + 20, object->bytecode.begin() + vector<uint8_t>::difference_type(it->first));
+				it = object->linkReferences.erase(it);
+			}
+			else
+				++it;
+		}
 }
 
 string LinkerObject::toHex() const
@@ -61,6 +79,18 @@ string LinkerObject::toHex() const
 	return hex;
 }
 
+void LinkerObject::toHex(ostream& _out) const
+{
+	size_t position = 0;
+	for (auto const& ref: linkReferences)
+	{
+		util::toHex(_out, bytesConstRef(&bytecode).cropped(position, ref.first - position));
+		_out << "__" << libraryPlaceholder(ref.second) << "__";
+		position = ref.first + 20;
+	}
+	util::toHex(_out, bytesConstRef(&bytecode).cropped(position));
+}
+
 string LinkerObject::libraryPlaceholder(string const& _libraryName)
 {
 	return "$" + keccak256(_libraryName).hex().substr(0, 34) + "$";
@@ -25,6 +25,8 @@
 #include <libsolutil/Common.h>
 #include <libsolutil/FixedHash.h>
 
+#include <iosfwd>
+
 namespace solidity::evmasm
 {
 
@@ -51,9 +53,19 @@ struct LinkerObject
 	/// Links the given libraries by replacing their uses in the code and removes them from the references.
 	void link(std::map<std::string, util::h160> const& _libraryAddresses);
 
+	/// Links the given libraries into all of @a _objects. Each library name referenced by the
+	/// objects is matched against @a _libraryAddresses only once and the addresses are written
+	/// directly at the offsets recorded in the link references of the objects.
+	static void link(
+		std::vector<LinkerObject*> const& _objects,
+		std::map<std::string, util::h160> const& _libraryAddresses
+	);
+
 	/// @returns a hex representation of the bytecode of the given object, replacing unlinked
 	/// addresses by placeholders. This output is lowercase.
 	std::string toHex() const;
+	/// Prints the hex representation returned by toHex() to @a _out without building the string first.
+	void toHex(std::ostream& _out) const;
 
 	/// @returns a 36 character string that is used as a placeholder for the library
 	/// address (enclosed by `__` on both sides). The placeholder is the hex representation
@@ -54,12 +54,13 @@ GasMeter::GasConsumption PathGasMeter::estimateMax(
 
 void PathGasMeter::queue(std::unique_ptr<GasPath>&& _newPath)
 {
-	if (
-		m_highestGasUsagePerJumpdest.count(_newPath->index) &&
-		_newPath->gas < m_highestGasUsagePerJumpdest.at(_newPath->index)
-	)
-		return;
-	m_highestGasUsagePerJumpdest[_newPath->index] = _newPath->gas;
+	auto [highest, inserted] = m_highestGasUsagePerJumpdest.emplace(_newPath->index, _newPath->gas);
+	if (!inserted)
+	{
+		if (_newPath->gas < highest->second)
+			return;
+		highest->second = _newPath->gas;
+	}
 	m_queue[_newPath->index] = move(_newPath);
 }
 
@@ -122,9 +123,8 @@ GasMeter::GasConsumption PathGasMeter::handleQueueItem()
 		for (u256 const& tag: jumpTags)
 		{
 			auto newPath = make_unique<GasPath>();
-			newPath->index = m_items.size();
-			if (m_tagPositions.count(tag))
-				newPath->index = m_tagPositions.at(tag);
+			auto position = m_tagPositions.find(tag);
+			newPath->index = position == m_tagPositions.end() ? m_items.size() : position->second;
 			newPath->gas = gas;
 			newPath->largestMemoryAccess = meter.largestMemoryAccess();
 			newPath->state = state->copy();
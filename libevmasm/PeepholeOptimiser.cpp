@@ -25,6 +25,11 @@
 #include <libevmasm/AssemblyItem.h>
 #include <libevmasm/SemanticInformation.h>
 
+#include <libsolutil/CompilationStatistics.h>
+
+#include <array>
+#include <type_traits>
+
 using namespace std;
 using namespace solidity;
 using namespace solidity::evmasm;
@@ -39,6 +44,10 @@ struct OptimiserState
 	AssemblyItems const& items;
 	size_t i;
 	std::back_insert_iterator<AssemblyItems> out;
+	/// Number of applications of each method other than the identity, in the order of the methods.
+	std::vector<size_t> hits;
+	/// True if a method other than the identity was applied.
+	bool changed = false;
 };
 
 template <class Method, size_t Arguments>
@@ -98,6 +107,8 @@ struct SimplePeepholeOptimizerMethod
 
 struct Identity: SimplePeepholeOptimizerMethod<Identity, 1>
 {
+	static constexpr char const* name = "Identity";
+
 	static bool applySimple(AssemblyItem const& _item, std::back_insert_iterator<AssemblyItems> _out)
 	{
 		*_out = _item;
@@ -107,6 +118,8 @@ struct Identity: SimplePeepholeOptimizerMethod<Identity, 1>
 
 struct PushPop: SimplePeepholeOptimizerMethod<PushPop, 2>
 {
+	static constexpr char const* name = "PushPop";
+
 	static bool applySimple(AssemblyItem const& _push, AssemblyItem const& _pop, std::back_insert_iterator<AssemblyItems>)
 	{
 		auto t = _push.type();
@@ -120,6 +133,8 @@ struct PushPop: SimplePeepholeOptimizerMethod<PushPop, 2>
 
 struct OpPop: SimplePeepholeOptimizerMethod<OpPop, 2>
 {
+	static constexpr char const* name = "OpPop";
+
 	static bool applySimple(
 		AssemblyItem const& _op,
 		AssemblyItem const& _pop,
@@ -142,6 +157,8 @@ struct OpPop: SimplePeepholeOptimizerMethod<OpPop, 2>
 
 struct DoubleSwap: SimplePeepholeOptimizerMethod<DoubleSwap, 2>
 {
+	static constexpr char const* name = "DoubleSwap";
+
 	static size_t applySimple(AssemblyItem const& _s1, AssemblyItem const& _s2, std::back_insert_iterator<AssemblyItems>)
 	{
 		return _s1 == _s2 && SemanticInformation::isSwapInstruction(_s1);
@@ -150,6 +167,8 @@ struct DoubleSwap: SimplePeepholeOptimizerMethod<DoubleSwap, 2>
 
 struct DoublePush: SimplePeepholeOptimizerMethod<DoublePush, 2>
 {
+	static constexpr char const* name = "DoublePush";
+
 	static bool applySimple(AssemblyItem const& _push1, AssemblyItem const& _push2, std::back_insert_iterator<AssemblyItems> _out)
 	{
 		if (_push1.type() == Push && _push2.type() == Push && _push1.data() == _push2.data())
@@ -165,6 +184,8 @@ struct DoublePush: SimplePeepholeOptimizerMethod<DoublePush, 2>
 
 struct CommutativeSwap: SimplePeepholeOptimizerMethod<CommutativeSwap, 2>
 {
+	static constexpr char const* name = "CommutativeSwap";
+
 	static bool applySimple(AssemblyItem const& _swap, AssemblyItem const& _op, std::back_insert_iterator<AssemblyItems> _out)
 	{
 		// Remove SWAP1 if following instruction is commutative
@@ -183,6 +204,8 @@ struct CommutativeSwap: SimplePeepholeOptimizerMethod<CommutativeSwap, 2>
 
 struct SwapComparison: SimplePeepholeOptimizerMethod<SwapComparison, 2>
 {
+	static constexpr char const* name = "SwapComparison";
+
 	static bool applySimple(AssemblyItem const& _swap, AssemblyItem const& _op, std::back_insert_iterator<AssemblyItems> _out)
 	{
 		static map<Instruction, Instruction> const swappableOps{
@@ -209,6 +232,8 @@ struct SwapComparison: SimplePeepholeOptimizerMethod<SwapComparison, 2>
 /// Remove swapN after dupN
 struct DupSwap: SimplePeepholeOptimizerMethod<DupSwap, 2>
 {
+	static constexpr char const* name = "DupSwap";
+
 	static size_t applySimple(
 		AssemblyItem const& _dupN,
 		AssemblyItem const& _swapN,
@@ -232,6 +257,8 @@ struct DupSwap: SimplePeepholeOptimizerMethod<DupSwap, 2>
 
 struct IsZeroIsZeroJumpI: SimplePeepholeOptimizerMethod<IsZeroIsZeroJumpI, 4>
 {
+	static constexpr char const* name = "IsZeroIsZeroJumpI";
+
 	static size_t applySimple(
 		AssemblyItem const& _iszero1,
 		AssemblyItem const& _iszero2,
@@ -258,6 +285,8 @@ struct IsZeroIsZeroJumpI: SimplePeepholeOptimizerMethod<IsZeroIsZeroJumpI, 4>
 
 struct JumpToNext: SimplePeepholeOptimizerMethod<JumpToNext, 3>
 {
+	static constexpr char const* name = "JumpToNext";
+
 	static size_t applySimple(
 		AssemblyItem const& _pushTag,
 		AssemblyItem const& _jump,
@@ -284,6 +313,8 @@ struct JumpToNext: SimplePeepholeOptimizerMethod<JumpToNext, 3>
 
 struct TagConjunctions: SimplePeepholeOptimizerMethod<TagConjunctions, 3>
 {
+	static constexpr char const* name = "TagConjunctions";
+
 	static bool applySimple(
 		AssemblyItem const& _pushTag,
 		AssemblyItem const& _pushConstant,
@@ -319,6 +350,8 @@ struct TagConjunctions: SimplePeepholeOptimizerMethod<TagConjunctions, 3>
 
 struct TruthyAnd: SimplePeepholeOptimizerMethod<TruthyAnd, 3>
 {
+	static constexpr char const* name = "TruthyAnd";
+
 	static bool applySimple(
 		AssemblyItem const& _push,
 		AssemblyItem const& _not,
@@ -337,6 +370,8 @@ struct TruthyAnd: SimplePeepholeOptimizerMethod<TruthyAnd, 3>
 /// Removes everything after a JUMP (or similar) until the next JUMPDEST.
 struct UnreachableCode
 {
+	static constexpr char const* name = "UnreachableCode";
+
 	static bool apply(OptimiserState& _state)
 	{
 		auto it = _state.items.begin() + static_cast<ptrdiff_t>(_state.i);
@@ -367,18 +402,42 @@ struct UnreachableCode
 	}
 };
 
+template <size_t Index>
 void applyMethods(OptimiserState&)
 {
 	assertThrow(false, OptimizerException, "Peephole optimizer failed to apply identity.");
 }
 
-template <typename Method, typename... OtherMethods>
-void applyMethods(OptimiserState& _state, Method, OtherMethods... _other)
+template <size_t Index, typename Method, typename... OtherMethods>
+void applyMethods(OptimiserState& _state)
 {
-	if (!Method::apply(_state))
-		applyMethods(_state, _other...);
+	if (Method::apply(_state))
+	{
+		if (!is_same_v<Method, Identity>)
+		{
+			++_state.hits[Index];
+			_state.changed = true;
+		}
+	}
+	else
+		applyMethods<Index + 1, OtherMethods...>(_state);
 }
 
+/// The methods in the order in which they are tried at each position.
+template <typename... Methods>
+struct PeepholeMethods
+{
+	static size_t constexpr count = sizeof...(Methods);
+	static void apply(OptimiserState& _state) { applyMethods<0, Methods...>(_state); }
+	static array<char const*, count> names() { return {Methods::name...}; }
+};
+
+using AllMethods = PeepholeMethods<
+	PushPop, OpPop, DoublePush, DoubleSwap, CommutativeSwap, SwapComparison,
+	DupSwap, IsZeroIsZeroJumpI, JumpToNext, UnreachableCode,
+	TagConjunctions, TruthyAnd, Identity
+>;
+
 size_t numberOfPops(AssemblyItems const& _items)
 {
 	return static_cast<size_t>(std::count(_items.begin(), _items.end(), Instruction::POP));
@@ -388,14 +447,13 @@ size_t numberOfPops(AssemblyItems const& _items)
 
 bool PeepholeOptimiser::optimise()
 {
-	OptimiserState state {m_items, 0, std::back_inserter(m_optimisedItems)};
+	m_optimisedItems.reserve(m_items.size());
+	OptimiserState state{m_items, 0, std::back_inserter(m_optimisedItems), vector<size_t>(AllMethods::count, 0)};
 	while (state.i < m_items.size())
-		applyMethods(
-			state,
-			PushPop(), OpPop(), DoublePush(), DoubleSwap(), CommutativeSwap(), SwapComparison(),
-			DupSwap(), IsZeroIsZeroJumpI(), JumpToNext(), UnreachableCode(),
-			TagConjunctions(), TruthyAnd(), Identity()
-		);
+		AllMethods::apply(state);
+	// Only the identity was applied, so the items did not change.
+	if (!state.changed)
+		return false;
 	if (m_optimisedItems.size() < m_items.size() || (
 		m_optimisedItems.size() == m_items.size() && (
 			evmasm::bytesRequired(m_optimisedItems, 3) < evmasm::bytesRequired(m_items, 3) ||
@@ -403,6 +461,13 @@ bool PeepholeOptimiser::optimise()
 		)
 	))
 	{
+		if (util::CompilationStatistics* statistics = util::CompilationStatistics::current())
+		{
+			auto names = AllMethods::names();
+			for (size_t method = 0; method < AllMethods::count; ++method)
+				if (state.hits[method])
+					statistics->recordCount(string("peephole/") + names[method], state.hits[method]);
+		}
 		m_items = std::move(m_optimisedItems);
 		return true;
 	}
@@ -40,23 +40,6 @@
 namespace solidity::evmasm
 {
 
-template <class S> S divWorkaround(S const& _a, S const& _b)
-{
-	return (S)(bigint(_a) / bigint(_b));
-}
-
-template <class S> S modWorkaround(S const& _a, S const& _b)
-{
-	return (S)(bigint(_a) % bigint(_b));
-}
-
-// This works around a bug fixed with Boost 1.64.
-// https://www.boost.org/doc/libs/1_68_0/libs/multiprecision/doc/html/boost_multiprecision/map/hist.html#boost_multiprecision.map.hist.multiprecision_2_3_1_boost_1_64
-template <class S> S shlWorkaround(S const& _x, unsigned _amount)
-{
-	return u256((bigint(_x) << _amount) & u256(-1));
-}
-
 // simplificationRuleList below was split up into parts to prevent
 // stack overflows in the JavaScript optimizer for emscripten builds
 // that affected certain browser versions.
@@ -76,11 +59,11 @@ std::vector<SimplificationRule<Pattern>> simplificationRuleListPart1(
 		{Builtins::ADD(A, B), [=]{ return A.d() + B.d(); }},
 		{Builtins::MUL(A, B), [=]{ return A.d() * B.d(); }},
 		{Builtins::SUB(A, B), [=]{ return A.d() - B.d(); }},
-		{Builtins::DIV(A, B), [=]{ return B.d() == 0 ? 0 : divWorkaround(A.d(), B.d()); }},
-		{Builtins::SDIV(A, B), [=]{ return B.d() == 0 ? 0 : s2u(divWorkaround(u2s(A.d()), u2s(B.d()))); }},
-		{Builtins::MOD(A, B), [=]{ return B.d() == 0 ? 0 : modWorkaround(A.d(), B.d()); }},
-		{Builtins::SMOD(A, B), [=]{ return B.d() == 0 ? 0 : s2u(modWorkaround(u2s(A.d()), u2s(B.d()))); }},
-		{Builtins::EXP(A, B), [=]{ return Word(boost::multiprecision::powm(bigint(A.d()), bigint(B.d()), bigint(1) << Pattern::WordSize)); }},
+		{Builtins::DIV(A, B), [=]{ return B.d() == 0 ? 0 : A.d() / B.d(); }},
+		{Builtins::SDIV(A, B), [=]{ return B.d() == 0 ? 0 : s2u(u2s(A.d()) / u2s(B.d())); }},
+		{Builtins::MOD(A, B), [=]{ return B.d() == 0 ? 0 : A.d() % B.d(); }},
+		{Builtins::SMOD(A, B), [=]{ return B.d() == 0 ? 0 : s2u(u2s(A.d()) % u2s(B.d())); }},
+		{Builtins::EXP(A, B), [=]{ return exp256(A.d(), B.d()); }},
 		{Builtins::NOT(A), [=]{ return ~A.d(); }},
 		{Builtins::LT(A, B), [=]() -> Word { return A.d() < B.d() ? 1 : 0; }},
 		{Builtins::GT(A, B), [=]() -> Word { return A.d() > B.d() ? 1 : 0; }},
@@ -109,7 +92,7 @@ std::vector<SimplificationRule<Pattern>> simplificationRuleListPart1(
 		{Builtins::SHL(A, B), [=]{
 			if (A.d() >= Pattern::WordSize)
 				return Word(0);
-			return shlWorkaround(B.d(), unsigned(A.d()));
+			return B.d() << unsigned(A.d());
 		}},
 		{Builtins::SHR(A, B), [=]{
 			if (A.d() >= Pattern::WordSize)
@@ -453,7 +436,7 @@ std::vector<SimplificationRule<Pattern>> simplificationRuleListPart7(
 		// SHR(B, SHL(A, X)) -> AND(SH[L/R]([B - A / A - B], X), Mask)
 		Builtins::SHR(B, Builtins::SHL(A, X)),
 		[=]() -> Pattern {
-			Word mask = shlWorkaround(~Word(0), unsigned(A.d())) >> unsigned(B.d());
+			Word mask = (~Word(0) << unsigned(A.d())) >> unsigned(B.d());
 
 			if (A.d() > B.d())
 				return Builtins::AND(Builtins::SHL(A.d() - B.d(), X), mask);
@@ -470,7 +453,7 @@ std::vector<SimplificationRule<Pattern>> simplificationRuleListPart7(
 		// SHL(B, SHR(A, X)) -> AND(SH[L/R]([B - A / A - B], X), Mask)
 		Builtins::SHL(B, Builtins::SHR(A, X)),
 		[=]() -> Pattern {
-			Word mask = shlWorkaround((~Word(0)) >> unsigned(A.d()), unsigned(B.d()));
+			Word mask = ((~Word(0)) >> unsigned(A.d())) << unsigned(B.d());
 
 			if (A.d() > B.d())
 				return Builtins::AND(Builtins::SHR(A.d() - B.d(), X), mask);
@@ -489,7 +472,7 @@ std::vector<SimplificationRule<Pattern>> simplificationRuleListPart7(
 		auto replacement = [=]() -> Pattern {
 			Word mask =
 				instr == Instruction::SHL ?
-				shlWorkaround(A.d(), unsigned(B.d())) :
+				A.d() << unsigned(B.d()) :
 				A.d() >> unsigned(B.d());
 			return Builtins::AND(shiftOp(B.d(), X), std::move(mask));
 		};
@@ -24,6 +24,8 @@
 #include <libevmasm/Instruction.h>
 #include <libsolutil/CommonData.h>
 #include <functional>
+#include <map>
+#include <vector>
 
 namespace solidity::evmasm
 {
@@ -51,6 +53,89 @@ struct SimplificationRule
 	std::function<bool()> feasible;
 };
 
+/// Shape of an expression or of a pattern, used to quickly discard rules that cannot match:
+/// the instruction of an operation, a constant or anything else.
+using ExpressionShape = uint16_t;
+constexpr ExpressionShape ConstantShape = 0x100;
+constexpr ExpressionShape AnyShape = 0x101;
+inline ExpressionShape operationShape(Instruction _instruction) { return uint8_t(_instruction); }
+
+/**
+ * Simplification rules grouped by the instruction of their pattern. Inside each group,
+ * the rules are indexed by the shape of the first argument of their pattern and the shapes
+ * of the other arguments are compared before a pattern is matched, so that most rules
+ * that cannot match an expression are never tried.
+ * The rules for an expression are still tried in the order in which they were added.
+ */
+template <class Pattern>
+class SimplificationRuleIndex
+{
+public:
+	using Rule = SimplificationRule<Pattern>;
+
+	void add(Rule _rule)
+	{
+		Group& group = m_groups[uint8_t(_rule.pattern.instruction())];
+		size_t index = group.rules.size();
+		std::vector<ExpressionShape> shapes;
+		for (Pattern const& argument: _rule.pattern.arguments())
+			shapes.push_back(argument.shape());
+		ExpressionShape first = shapes.empty() ? AnyShape : shapes.front();
+		if (first == AnyShape)
+		{
+			group.anyFirstArgument.push_back(index);
+			for (auto& candidates: group.byFirstArgument)
+				candidates.second.push_back(index);
+		}
+		else
+			group.byFirstArgument.emplace(first, group.anyFirstArgument).first->second.push_back(index);
+		group.argumentShapes.emplace_back(std::move(shapes));
+		group.rules.emplace_back(std::move(_rule));
+	}
+
+	bool empty(Instruction _instruction) const { return m_groups[uint8_t(_instruction)].rules.empty(); }
+
+	/// @returns the first rule for @a _instruction that admits the shapes @a _argumentShapes
+	/// of the arguments of the expression and for which @a _matches returns true.
+	template <class Matches>
+	Rule const* findFirst(
+		Instruction _instruction,
+		std::vector<ExpressionShape> const& _argumentShapes,
+		Matches const& _matches
+	) const
+	{
+		Group const& group = m_groups[uint8_t(_instruction)];
+		std::vector<size_t> const* candidates = &group.anyFirstArgument;
+		if (!_argumentShapes.empty())
+			if (auto it = group.byFirstArgument.find(_argumentShapes.front()); it != group.byFirstArgument.end())
+				candidates = &it->second;
+		for (size_t index: *candidates)
+		{
+			std::vector<ExpressionShape> const& shapes = group.argumentShapes[index];
+			bool admitted = true;
+			for (size_t i = 1; i < shapes.size() && i < _argumentShapes.size() && admitted; ++i)
+				admitted = shapes[i] == AnyShape || shapes[i] == _argumentShapes[i];
+			if (admitted && _matches(group.rules[index]))
+				return &group.rules[index];
+		}
+		return nullptr;
+	}
+
+private:
+	struct Group
+	{
+		std::vector<Rule> rules;
+		/// Shapes of the arguments of the pattern of each rule.
+		std::vector<std::vector<ExpressionShape>> argumentShapes;
+		/// Indices of the rules whose pattern admits the given shape of the first argument.
+		std::map<ExpressionShape, std::vector<size_t>> byFirstArgument;
+		/// Indices of the rules whose pattern admits any first argument.
+		std::vector<size_t> anyFirstArgument;
+	};
+
+	Group m_groups[256];
+};
+
 template <typename Pattern>
 struct EVMBuiltins
 {
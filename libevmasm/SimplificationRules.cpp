@@ -43,23 +43,28 @@ SimplificationRule<Pattern> const* Rules::findFirstMatch(
 	ExpressionClasses const& _classes
 )
 {
-	resetMatchGroups();
-
 	assertThrow(_expr.item, OptimizerException, "");
-	for (auto const& rule: m_rules[uint8_t(_expr.item->instruction())])
+	m_argumentShapes.clear();
+	for (ExpressionClasses::Id argument: _expr.arguments)
 	{
-		if (rule.pattern.matches(_expr, _classes))
-			if (!rule.feasible || rule.feasible())
-				return &rule;
+		AssemblyItem const* item = _classes.representative(argument).item;
+		if (item && item->type() == Operation)
+			m_argumentShapes.push_back(operationShape(item->instruction()));
+		else if (item && item->type() == Push)
+			m_argumentShapes.push_back(ConstantShape);
+		else
+			m_argumentShapes.push_back(AnyShape);
+	}
 
+	return m_rules.findFirst(_expr.item->instruction(), m_argumentShapes, [&](SimplificationRule<Pattern> const& _rule) {
 		resetMatchGroups();
-	}
-	return nullptr;
+		return _rule.pattern.matches(_expr, _classes) && (!_rule.feasible || _rule.feasible());
+	});
 }
 
 bool Rules::isInitialized() const
 {
-	return !m_rules[uint8_t(Instruction::ADD)].empty();
+	return !m_rules.empty(Instruction::ADD);
 }
 
 void Rules::addRules(std::vector<SimplificationRule<Pattern>> const& _rules)
@@ -70,7 +75,7 @@ void Rules::addRules(std::vector<SimplificationRule<Pattern>> const& _rules)
 
 void Rules::addRule(SimplificationRule<Pattern> const& _rule)
 {
-	m_rules[uint8_t(_rule.pattern.instruction())].push_back(_rule);
+	m_rules.add(_rule);
 }
 
 Rules::Rules()
@@ -171,6 +176,16 @@ string Pattern::toString() const
 	return s.str();
 }
 
+ExpressionShape Pattern::shape() const
+{
+	if (m_type == Operation)
+		return operationShape(m_instruction);
+	else if (m_type == Push)
+		return ConstantShape;
+	else
+		return AnyShape;
+}
+
 bool Pattern::matchesBaseItem(AssemblyItem const* _item) const
 {
 	if (m_type == UndefinedItem)
@@ -74,7 +74,9 @@ private:
 	std::map<unsigned, Expression const*> m_matchGroups;
 	/// Pattern to match, replacement to be applied and flag indicating whether
 	/// the replacement might remove some elements (except constants).
-	std::vector<SimplificationRule<Pattern>> m_rules[256];
+	SimplificationRuleIndex<Pattern> m_rules;
+	/// Shapes of the arguments of the expression that is currently matched.
+	std::vector<ExpressionShape> m_argumentShapes;
 };
 
 /**
@@ -115,10 +117,13 @@ public:
 	/// @returns the id of the matched expression if this pattern is part of a match group.
 	Id id() const { return matchGroupValue().id; }
 	/// @returns the data of the matched expression if this pattern is part of a match group.
-	u256 const& d() const { return matchGroupValue().item->data(); }
+	u256 d() const { return matchGroupValue().item->data(); }
 
 	std::string toString() const;
 
+	/// @returns the shape of the expressions matched by this pattern.
+	ExpressionShape shape() const;
+
 	AssemblyItemType type() const { return m_type; }
 	Instruction instruction() const
 	{
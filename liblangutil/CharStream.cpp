@@ -53,6 +53,8 @@
 #include <liblangutil/CharStream.h>
 #include <liblangutil/Exceptions.h>
 
+#include <algorithm>
+
 using namespace std;
 using namespace solidity;
 using namespace solidity::langutil;
@@ -64,7 +66,7 @@ char CharStream::advanceAndGet(size_t _chars)
 	m_position += _chars;
 	if (isPastEndOfInput())
 		return 0;
-	return m_source[m_position];
+	return m_source.data()[m_position];
 }
 
 char CharStream::rollback(size_t _amount)
@@ -84,37 +86,81 @@ char CharStream::setPosition(size_t _location)
 string CharStream::lineAtPosition(int _position) const
 {
 	// if _position points to \n, it returns the line before the \n
-	using size_type = string::size_type;
-	size_type searchStart = min<size_type>(m_source.size(), size_type(_position));
-	if (searchStart > 0)
-		searchStart--;
-	size_type lineStart = m_source.rfind('\n', searchStart);
-	if (lineStart == string::npos)
-		lineStart = 0;
-	else
-		lineStart++;
-	string line = m_source.substr(
-		lineStart,
-		min(m_source.find('\n', lineStart), m_source.size()) - lineStart
-	);
+	vector<size_t> const& starts = lineStarts();
+	size_t lineNumber = lineIndex(clampPosition(_position));
+	size_t lineStart = starts[lineNumber];
+	size_t lineEnd = lineNumber + 1 < starts.size() ? starts[lineNumber + 1] - 1 : m_source.size();
+	string line(source().substr(lineStart, lineEnd - lineStart));
 	if (!line.empty() && line.back() == '\r')
 		line.pop_back();
 	return line;
 }
 
+string CharStream::text(SourceLocation const& _location) const
+{
+	assertThrow(_location.sourceName == m_name, SourceLocationError, "Location refers to a different source.");
+	assertThrow(_location.hasText(), SourceLocationError, "Invalid source location.");
+	assertThrow(static_cast<size_t>(_location.end) <= m_source.size(), SourceLocationError, "Invalid source location.");
+	return string(source().substr(static_cast<size_t>(_location.start), static_cast<size_t>(_location.end - _location.start)));
+}
+
 tuple<int, int> CharStream::translatePositionToLineColumn(int _position) const
 {
-	using size_type = string::size_type;
-	using diff_type = string::difference_type;
-	size_type searchPosition = min<size_type>(m_source.size(), size_type(_position));
-	int lineNumber = static_cast<int>(count(m_source.begin(), m_source.begin() + diff_type(searchPosition), '\n'));
-	size_type lineStart;
-	if (searchPosition == 0)
-		lineStart = 0;
-	else
+	size_t position = clampPosition(_position);
+	size_t line = lineIndex(position);
+	return tuple<int, int>(static_cast<int>(line), static_cast<int>(position - lineStarts()[line]));
+}
+
+optional<int> CharStream::translateLineColumnToPosition(int _line, int _column) const
+{
+	vector<size_t> const& starts = lineStarts();
+	if (_line < 0 || static_cast<size_t>(_line) >= starts.size() || _column < 0)
+		return nullopt;
+	size_t const line = static_cast<size_t>(_line);
+	size_t const lineEnd = line + 1 < starts.size() ? starts[line + 1] - 1 : m_source.size();
+	size_t const position = starts[line] + static_cast<size_t>(_column);
+	if (position > lineEnd)
+		return nullopt;
+	return static_cast<int>(position);
+}
+
+vector<tuple<int, int>> CharStream::translatePositionsToLineColumns(vector<int> const& _positions) const
+{
+	vector<tuple<int, int>> lineColumns;
+	lineColumns.reserve(_positions.size());
+	for (int position: _positions)
+		lineColumns.emplace_back(translatePositionToLineColumn(position));
+	return lineColumns;
+}
+
+size_t CharStream::clampPosition(int _position) const
+{
+	// Negative positions wrap around and are clamped to the end as well.
+	return min<size_t>(m_source.size(), static_cast<size_t>(_position));
+}
+
+size_t CharStream::lineIndex(size_t _position) const
+{
+	vector<size_t> const& starts = lineStarts();
+	return static_cast<size_t>(upper_bound(starts.begin(), starts.end(), _position) - starts.begin()) - 1;
+}
+
+vector<size_t> const& CharStream::lineStarts() const
+{
+	shared_ptr<vector<size_t> const> lineStarts = atomic_load(&m_lineStarts);
+	if (!lineStarts)
 	{
-		lineStart = m_source.rfind('\n', searchPosition - 1);
-		lineStart = lineStart == string::npos ? 0 : lineStart + 1;
+		auto starts = make_shared<vector<size_t>>(1, 0);
+		string_view source = m_source.view();
+		for (size_t pos = source.find('\n'); pos != string_view::npos; pos = source.find('\n', pos + 1))
+			starts->push_back(pos + 1);
+
+		// Another thread might have built the table in the meantime, in which case its
+		// table is used so that references returned earlier stay valid.
+		shared_ptr<vector<size_t> const> expected;
+		lineStarts = move(starts);
+		if (!atomic_compare_exchange_strong(&m_lineStarts, &expected, lineStarts))
+			lineStarts = move(expected);
 	}
-	return tuple<int, int>(lineNumber, searchPosition - lineStart);
+	return *lineStarts;
 }
@@ -52,10 +52,18 @@
 
 #pragma once
 
+#include <liblangutil/SourceLocation.h>
+
+#include <libsolutil/SourceBuffer.h>
+
 #include <cstdint>
+#include <memory>
+#include <optional>
 #include <string>
+#include <string_view>
 #include <tuple>
 #include <utility>
+#include <vector>
 
 namespace solidity::langutil
 {
@@ -69,13 +77,20 @@ class CharStream
 {
 public:
 	CharStream() = default;
-	explicit CharStream(std::string  _source, std::string  name):
-		m_source(std::move(_source)), m_name(std::move(name)) {}
+	explicit CharStream(std::string  _source, std::string const& name):
+		m_source(std::move(_source)), m_name(internSourceName(name)) {}
+	/// Creates a stream that shares the contents of @a _source instead of copying them.
+	explicit CharStream(util::SourceBuffer _source, std::string const& _name):
+		m_source(std::move(_source)), m_name(internSourceName(_name)) {}
 
 	size_t position() const { return m_position; }
 	bool isPastEndOfInput(size_t _charsForward = 0) const { return (m_position + _charsForward) >= m_source.size(); }
 
-	char get(size_t _charsForward = 0) const { return m_source[m_position + _charsForward]; }
+	/// @returns the character @a _charsForward characters ahead or zero at the end of input.
+	char get(size_t _charsForward = 0) const
+	{
+		return isPastEndOfInput(_charsForward) ? 0 : m_source.data()[m_position + _charsForward];
+	}
 	char advanceAndGet(size_t _chars = 1);
 	/// Sets scanner position to @ _amount characters backwards in source text.
 	/// @returns The character of the current location after update is returned.
@@ -87,15 +102,27 @@ public:
 
 	void reset() { m_position = 0; }
 
-	std::string const& source() const noexcept { return m_source; }
-	std::string const& name() const noexcept { return m_name; }
+	std::string_view source() const noexcept { return m_source.view(); }
+	util::SourceBuffer const& buffer() const noexcept { return m_source; }
+	std::string const& name() const noexcept { return *m_name; }
+	/// @returns the name as stored in the locations referring to this stream.
+	std::string const* internedName() const noexcept { return m_name; }
+
+	/// @returns the text at @a _location, which has to refer to this stream.
+	std::string text(SourceLocation const& _location) const;
 
 	///@{
 	///@name Error printing helper functions
-	/// Functions that help pretty-printing parse errors
-	/// Do only use in error cases, they are quite expensive.
+	/// Functions that help pretty-printing parse errors.
+	/// The first call builds a table of the line start offsets, which is then used
+	/// to answer each query by binary search.
 	std::string lineAtPosition(int _position) const;
 	std::tuple<int, int> translatePositionToLineColumn(int _position) const;
+	/// @returns the zero-based line and column for each of @a _positions.
+	std::vector<std::tuple<int, int>> translatePositionsToLineColumns(std::vector<int> const& _positions) const;
+	/// @returns the offset of the zero-based @a _line and @a _column or nullopt if the source
+	/// has no such position. The end of a line is a valid position.
+	std::optional<int> translateLineColumnToPosition(int _line, int _column) const;
 	///@}
 
 	/// Tests whether or not given octet sequence is present at the current position in stream.
@@ -113,9 +140,18 @@ public:
 	}
 
 private:
-	std::string m_source;
-	std::string m_name;
+	/// @returns @a _position as an offset into the source, clamped to its size.
+	size_t clampPosition(int _position) const;
+	/// @returns the zero-based line the offset @a _position is in.
+	size_t lineIndex(size_t _position) const;
+	/// @returns the offsets at which the lines of the source start, computing them on first use.
+	std::vector<size_t> const& lineStarts() const;
+
+	util::SourceBuffer m_source;
+	std::string const* m_name = internSourceName("");
 	size_t m_position{0};
+	/// Line start offsets, shared by copies of this stream. Set at most once.
+	mutable std::shared_ptr<std::vector<size_t> const> m_lineStarts;
 };
 
 }
@@ -0,0 +1,80 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Lookup of the source code a location refers to.
+ */
+
+#pragma once
+
+#include <liblangutil/CharStream.h>
+
+#include <string>
+
+namespace solidity::langutil
+{
+
+/**
+ * Interface to look up sources by the name stored in source locations.
+ */
+class CharStreamProvider
+{
+public:
+	virtual ~CharStreamProvider() = default;
+
+	/// @returns the source called @a _sourceName or nullptr if it is not known.
+	virtual CharStream const* charStream(std::string const& _sourceName) const = 0;
+
+	/// @returns the source code @a _location refers to.
+	/// Throws if the source is not known or the location is invalid.
+	std::string text(SourceLocation const& _location) const
+	{
+		assertThrow(_location.sourceName, SourceLocationError, "Requested text from null source.");
+		CharStream const* stream = charStream(*_location.sourceName);
+		assertThrow(stream, SourceLocationError, "Requested text from unknown source.");
+		return stream->text(_location);
+	}
+};
+
+/**
+ * Provides a single source, e.g. the one of an assembly snippet that is being parsed.
+ */
+class SingletonCharStreamProvider: public CharStreamProvider
+{
+public:
+	explicit SingletonCharStreamProvider(CharStream const& _charStream):
+		m_charStream(_charStream) {}
+
+	CharStream const* charStream(std::string const& _sourceName) const override
+	{
+		return _sourceName == m_charStream.name() ? &m_charStream : nullptr;
+	}
+
+private:
+	CharStream const& m_charStream;
+};
+
+/**
+ * Provides no source at all, so that only the names of sources are available.
+ */
+class EmptyCharStreamProvider: public CharStreamProvider
+{
+public:
+	CharStream const* charStream(std::string const&) const override { return nullptr; }
+};
+
+}
@@ -78,11 +78,29 @@ void ErrorReporter::error(ErrorId _errorId, Error::Type _type, SourceLocation co
 	m_errorList.push_back(make_shared<Error>(_errorId, _type, _description, _location, _secondaryLocation));
 }
 
+void ErrorReporter::merge(ErrorList const& _errorList)
+{
+	for (shared_ptr<Error const> const& error: _errorList)
+	{
+		// The markers for excessive errors are added again according to the counts of this reporter.
+		if (error->errorId() == 4591_error || error->errorId() == 4013_error)
+			continue;
+		if (checkForExcessiveErrors(error->type()))
+			continue;
+		m_errorList.push_back(error);
+	}
+}
+
 bool ErrorReporter::hasExcessiveErrors() const
 {
 	return m_errorCount > c_maxErrorsAllowed;
 }
 
+bool ErrorReporter::hasExcessiveWarnings() const
+{
+	return m_warningCount >= c_maxWarningsAllowed;
+}
+
 bool ErrorReporter::checkForExcessiveErrors(Error::Type _type)
 {
 	if (_type == Error::Type::Warning)
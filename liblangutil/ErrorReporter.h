@@ -45,6 +45,15 @@ public:
 	ErrorReporter(ErrorReporter const& _errorReporter) noexcept:
 		m_errorList(_errorReporter.m_errorList) { }
 
+	/// Creates a reporter that collects errors in @a _errors, but starts with the error and warning
+	/// counts of @a _parent, so that the limits on their number apply as if they were reported
+	/// to @a _parent. Use @a merge to add them to @a _parent afterwards.
+	ErrorReporter(ErrorList& _errors, ErrorReporter const& _parent):
+		m_errorList(_errors),
+		m_errorCount(_parent.m_errorCount),
+		m_warningCount(_parent.m_warningCount)
+	{ }
+
 	ErrorReporter& operator=(ErrorReporter const& _errorReporter);
 
 	void append(ErrorList const& _errorList)
@@ -52,6 +61,10 @@ public:
 		m_errorList += _errorList;
 	}
 
+	/// Adds the errors that were collected by a reporter created from this one, as if they
+	/// were reported here, i.e. counting them towards the limits.
+	void merge(ErrorList const& _errorList);
+
 	void warning(ErrorId _error, std::string const& _description);
 
 	void warning(ErrorId _error, SourceLocation const& _location, std::string const& _description);
@@ -134,6 +147,9 @@ public:
 	// @returns true if the maximum error count has been reached.
 	bool hasExcessiveErrors() const;
 
+	// @returns true if the maximum warning count has been reached, i.e. further warnings are ignored.
+	bool hasExcessiveWarnings() const;
+
 	class ErrorWatcher
 	{
 	public:
@@ -56,6 +56,8 @@
 
 #include <boost/algorithm/string/classification.hpp>
 
+#include <array>
+#include <cstring>
 #include <optional>
 #include <string_view>
 #include <tuple>
@@ -94,6 +96,97 @@ ostream& operator<<(ostream& os, ScannerError _errorCode)
 	return os << to_string(_errorCode);
 }
 
+namespace
+{
+
+/// Classes of characters the fast paths of the scanner can skip or copy in bulk.
+enum CharClass: uint8_t
+{
+	Blank = 1 << 0, ///< Whitespace that is not a line break.
+	Whitespace = 1 << 1, ///< @see isWhiteSpace
+	IdentifierPart = 1 << 2, ///< @see isIdentifierPart
+	LinebreakStart = 1 << 3, ///< First byte of a character for which isUnicodeLinebreak() might be true.
+	PlainStringChar = 1 << 4, ///< Copied verbatim into a string literal.
+	PlainUnicodeStringChar = 1 << 5, ///< Copied verbatim into a unicode string literal.
+	PlainDocCommentChar = 1 << 6 ///< Copied verbatim into a multi-line documentation comment.
+};
+
+constexpr array<uint8_t, 256> charClasses = []() {
+	array<uint8_t, 256> classes{};
+	for (size_t i = 0; i < classes.size(); ++i)
+	{
+		char const c = static_cast<char>(i);
+		uint8_t charClass = 0;
+		if (c == ' ' || c == '\t')
+			charClass |= Blank;
+		if (c == ' ' || c == '\n' || c == '\t' || c == '\r')
+			charClass |= Whitespace;
+		if (c == '_' || c == '$' || ('a' <= c && c <= 'z') || ('A' <= c && c <= 'Z') || ('0' <= c && c <= '9'))
+			charClass |= IdentifierPart;
+		bool const linebreakStart = (0x0a <= i && i <= 0x0d) || i == 0xc2 || i == 0xe2;
+		if (linebreakStart)
+			charClass |= LinebreakStart;
+		bool const special = c == '"' || c == '\'' || c == '\\' || linebreakStart;
+		if (!special && 0x20 <= i && i < 0x7f)
+			charClass |= PlainStringChar;
+		if (!special)
+			charClass |= PlainUnicodeStringChar;
+		if (c != '\n' && c != '\r' && c != '*')
+			charClass |= PlainDocCommentChar;
+		classes[i] = charClass;
+	}
+	return classes;
+}();
+
+inline bool hasClass(char _c, uint8_t _classes)
+{
+	return charClasses[static_cast<uint8_t>(_c)] & _classes;
+}
+
+/// @returns the first position at or after @a _position whose character is not in any of
+/// @a _classes, or the size of @a _source.
+size_t skipClasses(string_view _source, size_t _position, uint8_t _classes)
+{
+	while (_position < _source.size() && hasClass(_source[_position], _classes))
+		++_position;
+	return _position;
+}
+
+/// @returns the first position at or after @a _position whose character might start a line
+/// break, or the size of @a _source.
+/// Printable ASCII text is skipped eight characters at a time.
+size_t findLinebreakStart(string_view _source, size_t _position)
+{
+	uint64_t constexpr ones = 0x0101010101010101;
+	while (_position < _source.size())
+	{
+		if (_position + 8 <= _source.size())
+		{
+			uint64_t word;
+			memcpy(&word, _source.data() + _position, 8);
+			// The high bit of a byte is set if the byte is below 0x20 or above 0x7f.
+			if (!(((word - ones * 0x20) | word) & (ones * 0x80)))
+			{
+				_position += 8;
+				continue;
+			}
+		}
+		if (hasClass(_source[_position], LinebreakStart))
+			return _position;
+		++_position;
+	}
+	return _source.size();
+}
+
+/// @returns false if the given range of @a _source certainly does not contain
+/// directional markup, i.e. no character starting with 0xE2.
+bool mayContainBiDiMarkup(string_view _source, size_t _start, size_t _end)
+{
+	return _source.substr(_start, _end - _start).find('\xE2') != string_view::npos;
+}
+
+}
+
 /// Scoped helper for literal recording. Automatically drops the literal
 /// if aborting the scanning before it's complete.
 enum LiteralType
@@ -237,10 +330,12 @@ BOOST_STATIC_ASSERT(TokenTraits::count() <= 0x100);
 
 Token Scanner::next()
 {
-	m_tokens[Current] = std::move(m_tokens[Next]);
-	m_tokens[Next] = std::move(m_tokens[NextNext]);
-	m_skippedComments[Current] = std::move(m_skippedComments[Next]);
-	m_skippedComments[Next] = std::move(m_skippedComments[NextNext]);
+	// Rotate the tokens instead of overwriting them, so that the literal buffer of the old
+	// current token is reused for the next scanned one.
+	std::swap(m_tokens[Current], m_tokens[Next]);
+	std::swap(m_tokens[Next], m_tokens[NextNext]);
+	std::swap(m_skippedComments[Current], m_skippedComments[Next]);
+	std::swap(m_skippedComments[Next], m_skippedComments[NextNext]);
 
 	scanToken();
 
@@ -259,8 +354,13 @@ Token Scanner::selectToken(char _next, Token _then, Token _else)
 bool Scanner::skipWhitespace()
 {
 	size_t const startPosition = sourcePos();
-	while (isWhiteSpace(m_char))
+	// The current character is checked separately because it does not always
+	// match the source, e.g. at the end of a multi-line comment.
+	if (isWhiteSpace(m_char))
+	{
 		advance();
+		m_char = m_source->setPosition(skipClasses(m_source->source(), sourcePos(), Whitespace));
+	}
 	// Return whether or not we skipped any characters.
 	return sourcePos() != startPosition;
 }
@@ -268,8 +368,11 @@ bool Scanner::skipWhitespace()
 bool Scanner::skipWhitespaceExceptUnicodeLinebreak()
 {
 	size_t const startPosition = sourcePos();
-	while (isWhiteSpace(m_char) && !isUnicodeLinebreak())
+	if (isWhiteSpace(m_char) && !isUnicodeLinebreak())
+	{
 		advance();
+		m_char = m_source->setPosition(skipClasses(m_source->source(), sourcePos(), Blank));
+	}
 	// Return whether or not we skipped any characters.
 	return sourcePos() != startPosition;
 }
@@ -322,13 +425,21 @@ Token Scanner::skipSingleLineComment()
 	// Line terminator is not part of the comment. If it is a
 	// non-ascii line terminator, it will result in a parser error.
 	size_t startPosition = m_source->position();
-	while (!isUnicodeLinebreak())
-		if (!advance())
+	string_view const source = m_source->source();
+	for (size_t position = startPosition; ; ++position)
+	{
+		position = findLinebreakStart(source, position);
+		m_char = m_source->setPosition(position);
+		if (isSourcePastEndOfInput() || isUnicodeLinebreak())
 			break;
+	}
 
-	ScannerError unicodeDirectionError = validateBiDiMarkup(*m_source, startPosition);
-	if (unicodeDirectionError != ScannerError::NoError)
-		return setError(unicodeDirectionError);
+	if (mayContainBiDiMarkup(source, startPosition, sourcePos()))
+	{
+		ScannerError unicodeDirectionError = validateBiDiMarkup(*m_source, startPosition);
+		if (unicodeDirectionError != ScannerError::NoError)
+			return setError(unicodeDirectionError);
+	}
 
 	return Token::Whitespace;
 }
@@ -366,6 +477,14 @@ size_t Scanner::scanSingleLineDocComment()
 	while (!isSourcePastEndOfInput())
 	{
 		endPosition = m_source->position();
+		if (size_t runEnd = findLinebreakStart(m_source->source(), endPosition); runEnd > endPosition)
+		{
+			// Copy everything up to the next potential line break at once.
+			m_skippedComments[NextNext].literal.append(m_source->source().substr(endPosition, runEnd - endPosition));
+			m_char = m_source->setPosition(runEnd);
+			endPosition = runEnd - 1;
+			continue;
+		}
 		if (tryScanEndOfLine())
 		{
 			// Check if next line is also a single-line comment.
@@ -402,26 +521,28 @@ size_t Scanner::scanSingleLineDocComment()
 Token Scanner::skipMultiLineComment()
 {
 	size_t startPosition = m_source->position();
-	while (!isSourcePastEndOfInput())
+	string_view const source = m_source->source();
+	size_t const terminator = source.find("*/", startPosition);
+	if (terminator == string_view::npos)
 	{
-		char prevChar = m_char;
-		advance();
-
-		// If we have reached the end of the multi-line comment, we
-		// consume the '/' and insert a whitespace. This way all
-		// multi-line comments are treated as whitespace.
-		if (prevChar == '*' && m_char == '/')
-		{
-			ScannerError unicodeDirectionError = validateBiDiMarkup(*m_source, startPosition);
-			if (unicodeDirectionError != ScannerError::NoError)
-				return setError(unicodeDirectionError);
+		m_char = m_source->setPosition(source.size());
+		// Unterminated multi-line comment.
+		return setError(ScannerError::IllegalCommentTerminator);
+	}
 
-			m_char = ' ';
-			return Token::Whitespace;
-		}
+	// We have reached the end of the multi-line comment, so we
+	// consume the '/' and insert a whitespace. This way all
+	// multi-line comments are treated as whitespace.
+	m_char = m_source->setPosition(terminator + 1);
+	if (mayContainBiDiMarkup(source, startPosition, terminator + 1))
+	{
+		ScannerError unicodeDirectionError = validateBiDiMarkup(*m_source, startPosition);
+		if (unicodeDirectionError != ScannerError::NoError)
+			return setError(unicodeDirectionError);
 	}
-	// Unterminated multi-line comment.
-	return setError(ScannerError::IllegalCommentTerminator);
+
+	m_char = ' ';
+	return Token::Whitespace;
 }
 
 Token Scanner::scanMultiLineDocComment()
@@ -471,6 +592,11 @@ Token Scanner::scanMultiLineDocComment()
 		addCommentLiteralChar(m_char);
 		charsAdded = true;
 		advance();
+		// Copy everything up to the next line break or '*' at once.
+		size_t const runStart = sourcePos();
+		size_t const runEnd = skipClasses(m_source->source(), runStart, PlainDocCommentChar);
+		m_skippedComments[NextNext].literal.append(m_source->source().substr(runStart, runEnd - runStart));
+		m_char = m_source->setPosition(runEnd);
 	}
 	literal.complete();
 	if (!endFound)
@@ -496,7 +622,7 @@ Token Scanner::scanSlash()
 				return skipSingleLineComment();
 			// doxygen style /// comment
 			m_skippedComments[NextNext].location.start = firstSlashPosition;
-			m_skippedComments[NextNext].location.source = m_source;
+			m_skippedComments[NextNext].location.sourceName = m_source->internedName();
 			m_skippedComments[NextNext].token = Token::CommentLiteral;
 			m_skippedComments[NextNext].location.end = static_cast<int>(scanSingleLineDocComment());
 			return Token::Whitespace;
@@ -525,7 +651,7 @@ Token Scanner::scanSlash()
 				return skipMultiLineComment();
 			// we actually have a multiline documentation comment
 			m_skippedComments[NextNext].location.start = firstSlashPosition;
-			m_skippedComments[NextNext].location.source = m_source;
+			m_skippedComments[NextNext].location.sourceName = m_source->internedName();
 			Token comment = scanMultiLineDocComment();
 			m_skippedComments[NextNext].location.end = static_cast<int>(sourcePos());
 			m_skippedComments[NextNext].token = comment;
@@ -543,10 +669,18 @@ Token Scanner::scanSlash()
 		return Token::Div;
 }
 
+void Scanner::clearTokenDesc(TokenDesc& _token)
+{
+	std::string literal = std::move(_token.literal);
+	literal.clear();
+	_token = {};
+	_token.literal = std::move(literal);
+}
+
 void Scanner::scanToken()
 {
-	m_tokens[NextNext] = {};
-	m_skippedComments[NextNext] = {};
+	clearTokenDesc(m_tokens[NextNext]);
+	clearTokenDesc(m_skippedComments[NextNext]);
 
 	Token token;
 	// M and N are for the purposes of grabbing different type sizes
@@ -765,7 +899,7 @@ void Scanner::scanToken()
 	}
 	while (token == Token::Whitespace);
 	m_tokens[NextNext].location.end = static_cast<int>(sourcePos());
-	m_tokens[NextNext].location.source = m_source;
+	m_tokens[NextNext].location.sourceName = m_source->internedName();
 	m_tokens[NextNext].token = token;
 	m_tokens[NextNext].extendedTokenInfo = make_tuple(m, n);
 }
@@ -837,8 +971,18 @@ Token Scanner::scanString(bool const _isUnicode)
 	char const quote = m_char;
 	advance();  // consume quote
 	LiteralScope literal(this, LITERAL_TYPE_STRING);
+	uint8_t const plainChars = _isUnicode ? PlainUnicodeStringChar : PlainStringChar;
 	while (m_char != quote && !isSourcePastEndOfInput() && !isUnicodeLinebreak())
 	{
+		if (hasClass(m_char, plainChars))
+		{
+			// Copy all characters that do not need to be checked at once.
+			size_t const runStart = sourcePos();
+			size_t const runEnd = skipClasses(m_source->source(), runStart, plainChars);
+			m_tokens[NextNext].literal.append(m_source->source().substr(runStart, runEnd - runStart));
+			m_char = m_source->setPosition(runEnd);
+			continue;
+		}
 		char c = m_char;
 		advance();
 		if (c == '\\')
@@ -862,7 +1006,7 @@ Token Scanner::scanString(bool const _isUnicode)
 	if (m_char != quote)
 		return setError(ScannerError::IllegalStringEndQuote);
 
-	if (_isUnicode)
+	if (_isUnicode && mayContainBiDiMarkup(m_source->source(), startPosition, sourcePos()))
 	{
 		ScannerError unicodeDirectionError = validateBiDiMarkup(*m_source, startPosition);
 		if (unicodeDirectionError != ScannerError::NoError)
@@ -1021,10 +1165,15 @@ tuple<Token, unsigned, unsigned> Scanner::scanIdentifierOrKeyword()
 {
 	solAssert(isIdentifierStart(m_char), "");
 	LiteralScope literal(this, LITERAL_TYPE_STRING);
-	addLiteralCharAndAdvance();
+	size_t const start = sourcePos();
 	// Scan the rest of the identifier characters.
-	while (isIdentifierPart(m_char) || (m_char == '.' && m_kind == ScannerKind::Yul))
-		addLiteralCharAndAdvance();
+	string_view const source = m_source->source();
+	size_t end = skipClasses(source, start + 1, IdentifierPart);
+	if (m_kind == ScannerKind::Yul)
+		while (end < source.size() && source[end] == '.')
+			end = skipClasses(source, end + 1, IdentifierPart);
+	m_tokens[NextNext].literal.assign(source.substr(start, end - start));
+	m_char = m_source->setPosition(end);
 	literal.complete();
 	auto const token = TokenTraits::fromIdentifierOrKeyword(m_tokens[NextNext].literal);
 	if (m_kind == ScannerKind::Yul)
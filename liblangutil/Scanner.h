@@ -105,7 +105,7 @@ public:
 	explicit Scanner(std::shared_ptr<CharStream> _source) { reset(std::move(_source)); }
 	explicit Scanner(CharStream _source = CharStream()) { reset(std::move(_source)); }
 
-	std::string const& source() const noexcept { return m_source->source(); }
+	std::string_view source() const noexcept { return m_source->source(); }
 
 	std::shared_ptr<CharStream> charStream() noexcept { return m_source; }
 	std::shared_ptr<CharStream const> charStream() const noexcept { return m_source; }
@@ -203,6 +203,10 @@ private:
 		std::tuple<unsigned, unsigned> extendedTokenInfo;
 	};
 
+	/// Resets @a _token to its initial state but keeps the memory of its literal, so that
+	/// scanning does not allocate a new literal for every token.
+	static void clearTokenDesc(TokenDesc& _token);
+
 	///@{
 	///@name Literal buffer support
 	inline void addLiteralChar(char c) { m_tokens[NextNext].literal.push_back(c); }
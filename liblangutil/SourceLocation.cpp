@@ -16,15 +16,29 @@
 */
 // SPDX-License-Identifier: GPL-3.0
 
+#include <liblangutil/SourceLocation.h>
 #include <liblangutil/Exceptions.h>
 
 #include <boost/algorithm/string/split.hpp>
 #include <boost/algorithm/string.hpp>
 
+#include <mutex>
+#include <set>
+
 using namespace solidity;
 namespace solidity::langutil
 {
 
+std::string const* internSourceName(std::string const& _name)
+{
+	// The names are never freed. There are few distinct names (files, "--CODEGEN--",
+	// "#utility.yul", ...) and they are small compared to the sources.
+	static std::mutex mutex;
+	static std::set<std::string, std::less<>> names;
+	std::lock_guard<std::mutex> lock(mutex);
+	return &*names.insert(_name).first;
+}
+
 SourceLocation const parseSourceLocation(std::string const& _input, std::string const& _sourceName, size_t _maxIndex)
 {
 	// Expected input: "start:length:sourceindex"
@@ -45,12 +59,7 @@ SourceLocation const parseSourceLocation(std::string const& _input, std::string
 	int start = stoi(pos[Start]);
 	int end = start + stoi(pos[Length]);
 
-	// ASSUMPTION: only the name of source is used from here on, the m_source of the CharStream-Object can be empty
-	std::shared_ptr<langutil::CharStream> source;
-	if (sourceIndex != -1)
-		source = std::make_shared<langutil::CharStream>("", _sourceName);
-
-	return SourceLocation{start, end, source};
+	return SourceLocation{start, end, sourceIndex != -1 ? internSourceName(_sourceName) : nullptr};
 }
 
 }
@@ -26,68 +26,62 @@
 #include <libsolutil/Assertions.h>
 #include <libsolutil/Exceptions.h>
 
-#include <liblangutil/CharStream.h>
-
-#include <memory>
+#include <limits>
+#include <ostream>
 #include <string>
+#include <tuple>
 
 namespace solidity::langutil
 {
 struct SourceLocationError: virtual util::Exception {};
 
+/// @returns a string equal to @a _name that stays valid until the end of the program.
+/// Every name is stored only once, so that interned names can be compared by their address.
+std::string const* internSourceName(std::string const& _name);
+
 /**
  * Representation of an interval of source positions.
  * The interval includes start and excludes end.
+ *
+ * Only the name of the source is stored, so that locations are small and can be copied
+ * without touching a reference count. The source code itself is looked up by name through
+ * a CharStreamProvider, usually the compilation the location belongs to.
  */
 struct SourceLocation
 {
 	bool operator==(SourceLocation const& _other) const
 	{
-		return source.get() == _other.source.get() && start == _other.start && end == _other.end;
+		return sourceName == _other.sourceName && start == _other.start && end == _other.end;
 	}
 	bool operator!=(SourceLocation const& _other) const { return !operator==(_other); }
 
 	inline bool operator<(SourceLocation const& _other) const
 	{
-		if (!source|| !_other.source)
-			return std::make_tuple(int(!!source), start, end) < std::make_tuple(int(!!_other.source), _other.start, _other.end);
+		if (!sourceName || !_other.sourceName)
+			return std::make_tuple(int(!!sourceName), start, end) < std::make_tuple(int(!!_other.sourceName), _other.start, _other.end);
 		else
-			return std::make_tuple(source->name(), start, end) < std::make_tuple(_other.source->name(), _other.start, _other.end);
+			return std::make_tuple(*sourceName, start, end) < std::make_tuple(*_other.sourceName, _other.start, _other.end);
 	}
 
 	inline bool contains(SourceLocation const& _other) const
 	{
-		if (!hasText() || !_other.hasText() || source.get() != _other.source.get())
+		if (!hasText() || !_other.hasText() || sourceName != _other.sourceName)
 			return false;
 		return start <= _other.start && _other.end <= end;
 	}
 
 	inline bool intersects(SourceLocation const& _other) const
 	{
-		if (!hasText() || !_other.hasText() || source.get() != _other.source.get())
+		if (!hasText() || !_other.hasText() || sourceName != _other.sourceName)
 			return false;
 		return _other.start < end && start < _other.end;
 	}
 
-	bool isValid() const { return source || start != -1 || end != -1; }
+	bool isValid() const { return sourceName || start != -1 || end != -1; }
 
-	bool hasText() const
-	{
-		return
-			source &&
-			0 <= start &&
-			start <= end &&
-			end <= int(source->source().length());
-	}
-
-	std::string text() const
-	{
-		assertThrow(source, SourceLocationError, "Requested text from null source.");
-		assertThrow(0 <= start, SourceLocationError, "Invalid source location.");
-		assertThrow(start <= end, SourceLocationError, "Invalid source location.");
-		assertThrow(end <= int(source->source().length()), SourceLocationError, "Invalid source location.");
-		return source->source().substr(size_t(start), size_t(end - start));
-	}
+	/// @returns true if the location refers to a range in a named source. Whether the range
+	/// is inside the source can only be checked with the source code.
+	bool hasText() const { return sourceName && 0 <= start && start <= end; }
 
 	/// @returns the smallest SourceLocation that contains both @param _a and @param _b.
 	/// Assumes that @param _a and @param _b refer to the same source (exception: if the source of either one
@@ -96,8 +90,8 @@ struct SourceLocation
 	/// @param _b, then start resp. end of the result will be -1 as well).
 	static SourceLocation smallestCovering(SourceLocation _a, SourceLocation const& _b)
 	{
-		if (!_a.source)
-			_a.source = _b.source;
+		if (!_a.sourceName)
+			_a.sourceName = _b.sourceName;
 
 		if (_a.start < 0)
 			_a.start = _b.start;
@@ -111,7 +105,8 @@ struct SourceLocation
 
 	int start = -1;
 	int end = -1;
-	std::shared_ptr<CharStream> source;
+	/// Interned name of the source, see @a internSourceName.
+	std::string const* sourceName = nullptr;
 };
 
 SourceLocation const parseSourceLocation(
@@ -126,8 +121,8 @@ inline std::ostream& operator<<(std::ostream& _out, SourceLocation const& _locat
 	if (!_location.isValid())
 		return _out << "NO_LOCATION_SPECIFIED";
 
-	if (_location.source)
-		_out << _location.source->name();
+	if (_location.sourceName)
+		_out << *_location.sourceName;
 
 	_out << "[" << _location.start << "," << _location.end << "]";
 
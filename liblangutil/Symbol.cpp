@@ -0,0 +1,149 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Interned names of the Solidity frontend.
+ */
+
+#include <liblangutil/Symbol.h>
+
+#include <array>
+#include <atomic>
+#include <deque>
+#include <mutex>
+#include <unordered_map>
+
+using namespace std;
+using namespace solidity::langutil;
+
+namespace
+{
+
+/// Texts of all symbols. Lookups only lock one of several shards, so that concurrently
+/// running parsers rarely wait for each other.
+class SymbolTable
+{
+public:
+	static SymbolTable& instance()
+	{
+		// Never destroyed, so that symbols can be used during static destruction.
+		static SymbolTable* table = new SymbolTable();
+		return *table;
+	}
+
+	string const* intern(string_view _text)
+	{
+		Shard& shard = m_shards[hash<string_view>{}(_text) % ShardCount];
+		lock_guard<mutex> lock(shard.mutex);
+		auto it = shard.index.find(_text);
+		if (it != shard.index.end())
+			return it->second;
+		// Elements of a deque are not moved when appending, so views into them stay valid.
+		string const& text = shard.texts.emplace_back(_text);
+		shard.index.emplace(text, &text);
+		return &text;
+	}
+
+	size_t size()
+	{
+		size_t size = 0;
+		for (Shard& shard: m_shards)
+		{
+			lock_guard<mutex> lock(shard.mutex);
+			size += shard.texts.size();
+		}
+		return size;
+	}
+
+	void clear()
+	{
+		for (Shard& shard: m_shards)
+		{
+			lock_guard<mutex> lock(shard.mutex);
+			shard.index.clear();
+			shard.texts.clear();
+		}
+		// Pointers returned by Symbol::shared before are not recognized as interned any more.
+		m_owner = make_shared<char>();
+		++m_generation;
+	}
+
+	size_t generation() const { return m_generation.load(memory_order_acquire); }
+
+	string const* empty() const { return &m_empty; }
+
+	/// Owner of all pointers returned by Symbol::shared, which only serves to recognize them.
+	shared_ptr<void> const& owner() const { return m_owner; }
+
+private:
+	struct Shard
+	{
+		std::mutex mutex;
+		deque<string> texts;
+		unordered_map<string_view, string const*> index;
+	};
+
+	static size_t constexpr ShardCount = 16;
+
+	array<Shard, ShardCount> m_shards;
+	string m_empty;
+	shared_ptr<void> m_owner = make_shared<char>();
+	atomic<size_t> m_generation{0};
+};
+
+}
+
+Symbol::Symbol():
+	m_text(SymbolTable::instance().empty())
+{
+}
+
+Symbol::Symbol(string_view _text):
+	m_text(_text.empty() ? SymbolTable::instance().empty() : SymbolTable::instance().intern(_text))
+{
+}
+
+Symbol::Symbol(shared_ptr<string const> const& _text)
+{
+	SymbolTable& table = SymbolTable::instance();
+	if (!_text || _text->empty())
+		m_text = table.empty();
+	else if (!_text.owner_before(table.owner()) && !table.owner().owner_before(_text))
+		m_text = _text.get();
+	else
+		m_text = table.intern(*_text);
+}
+
+shared_ptr<string const> Symbol::shared() const
+{
+	return shared_ptr<string const>(SymbolTable::instance().owner(), m_text);
+}
+
+size_t Symbol::size()
+{
+	return SymbolTable::instance().size();
+}
+
+void Symbol::reset()
+{
+	SymbolTable::instance().clear();
+}
+
+size_t Symbol::generation()
+{
+	return SymbolTable::instance().generation();
+}
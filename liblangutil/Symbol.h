@@ -0,0 +1,88 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Interned names of the Solidity frontend.
+ */
+
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+
+namespace solidity::langutil
+{
+
+/**
+ * A name whose text is stored only once per process. Symbols with the same text refer to
+ * the same copy of it, so they are compared and hashed by address.
+ *
+ * Interned texts are kept until the table is reset, which long-running users of the compiler
+ * do between compilations, like for YulString. Symbols can be created concurrently from multiple
+ * threads. They are not affected by resetting the YulString repository.
+ */
+class Symbol
+{
+public:
+	/// Creates the empty symbol.
+	Symbol();
+	explicit Symbol(std::string_view _text);
+	/// Creates the symbol of the text @a _text points to. Does not look up the text if it was
+	/// returned by @a shared.
+	explicit Symbol(std::shared_ptr<std::string const> const& _text);
+
+	std::string const& str() const { return *m_text; }
+	bool empty() const { return m_text->empty(); }
+
+	/// @returns a pointer to the interned text, e.g. for use as the name of an AST node.
+	/// Copies of it share the text with all other symbols of the same name.
+	std::shared_ptr<std::string const> shared() const;
+
+	bool operator==(Symbol const& _other) const { return m_text == _other.m_text; }
+	bool operator!=(Symbol const& _other) const { return m_text != _other.m_text; }
+	/// Orders symbols consistently with their texts.
+	bool operator<(Symbol const& _other) const { return m_text != _other.m_text && *m_text < *_other.m_text; }
+
+	size_t hash() const { return std::hash<std::string const*>{}(m_text); }
+
+	/// @returns the number of interned texts.
+	static size_t size();
+	/// Frees all interned texts. Invalidates all symbols except the empty one and all pointers
+	/// returned by @a shared, so it must only be called while none are in use, e.g. in an AST.
+	static void reset();
+	/// @returns the number of resets so far, so that ASTs kept across compilations can
+	/// tell whether their symbols are still valid.
+	static size_t generation();
+
+private:
+	std::string const* m_text;
+};
+
+}
+
+namespace std
+{
+template<> struct hash<solidity::langutil::Symbol>
+{
+	size_t operator()(solidity::langutil::Symbol const& _symbol) const
+	{
+		return _symbol.hash();
+	}
+};
+}
@@ -41,7 +41,12 @@
 // along with solidity.  If not, see <http://www.gnu.org/licenses/>.
 
 #include <liblangutil/Token.h>
-#include <map>
+
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <string_view>
+#include <utility>
 
 using namespace std;
 
@@ -115,98 +120,163 @@ std::string friendlyName(Token tok)
 }
 
 
-static Token keywordByName(string const& _name)
+namespace
 {
-	// The following macros are used inside TOKEN_LIST and cause non-keyword tokens to be ignored
-	// and keywords to be put inside the keywords variable.
-#define KEYWORD(name, string, precedence) {string, Token::name},
+
+// The following macros are used inside TOKEN_LIST and cause non-keyword tokens to be ignored
+// and keywords to be put inside the keywords variable.
+#define KEYWORD(name, string, precedence) pair<string_view, Token>{string, Token::name},
 #define TOKEN(name, string, precedence)
-	static map<string, Token> const keywords({TOKEN_LIST(TOKEN, KEYWORD)});
+constexpr pair<string_view, Token> keywords[] = {TOKEN_LIST(TOKEN, KEYWORD)};
 #undef KEYWORD
 #undef TOKEN
-	auto it = keywords.find(_name);
-	return it == keywords.end() ? Token::Identifier : it->second;
+
+/// FNV-1a hash of @a _name, varied by @a _seed.
+constexpr uint32_t keywordHash(string_view _name, uint32_t _seed)
+{
+	uint32_t hash = 2166136261u ^ (_seed * 0x9e3779b9u);
+	for (char c: _name)
+		hash = (hash ^ static_cast<uint8_t>(c)) * 16777619u;
+	return hash;
 }
 
-bool isYulKeyword(string const& _literal)
+/// Open-addressed table without collisions that maps the hash of a keyword to its
+/// index in @a keywords plus one. Zero marks an empty slot.
+struct KeywordTable
 {
-	return _literal == "leave" || isYulKeyword(keywordByName(_literal));
+	static constexpr size_t size = 2048;
+	uint32_t seed = 0;
+	uint8_t slots[size] = {};
+};
+
+static_assert(size(keywords) < 255, "Keyword indices have to fit into a table slot.");
+
+/// Searches for the first seed for which the hash is perfect on the keywords.
+constexpr KeywordTable buildKeywordTable()
+{
+	for (uint32_t seed = 0; seed < 1000; ++seed)
+	{
+		KeywordTable table;
+		table.seed = seed;
+		bool collision = false;
+		for (size_t i = 0; i < size(keywords) && !collision; ++i)
+		{
+			uint8_t& slot = table.slots[keywordHash(keywords[i].first, seed) % KeywordTable::size];
+			collision = slot != 0;
+			slot = static_cast<uint8_t>(i + 1);
+		}
+		if (!collision)
+			return table;
+	}
+	return {};
+}
+
+constexpr KeywordTable keywordTable = buildKeywordTable();
+
+constexpr bool containsAllKeywords(KeywordTable const& _table)
+{
+	for (size_t i = 0; i < size(keywords); ++i)
+		if (_table.slots[keywordHash(keywords[i].first, _table.seed) % KeywordTable::size] != i + 1)
+			return false;
+	return true;
 }
 
-tuple<Token, unsigned int, unsigned int> fromIdentifierOrKeyword(string const& _literal)
+static_assert(containsAllKeywords(keywordTable), "No perfect hash found for the keywords.");
+
+Token keywordByName(string_view _name)
 {
-	// Used for `bytesM`, `uintM`, `intM`, `fixedMxN`, `ufixedMxN`.
-	// M/N must be shortest representation. M can never be 0. N can be zero.
-	auto parseSize = [](string::const_iterator _begin, string::const_iterator _end) -> int
+	uint8_t slot = keywordTable.slots[keywordHash(_name, keywordTable.seed) % KeywordTable::size];
+	if (slot != 0 && keywords[slot - 1].first == _name)
+		return keywords[slot - 1].second;
+	return Token::Identifier;
+}
+
+constexpr bool isDigit(char _c)
+{
+	return '0' <= _c && _c <= '9';
+}
+
+/// @returns the number at the start of @a _digits (which only contains digits) or -1 if
+/// it is empty, has a leading zero or is larger than 256 in a way that could overflow.
+int parseSize(string_view _digits)
+{
+	// No number.
+	if (_digits.empty())
+		return -1;
+
+	// Disallow leading zero.
+	if (_digits.size() > 1 && _digits.front() == '0')
+		return -1;
+
+	int ret = 0;
+	for (char c: _digits)
 	{
-		// No number.
-		if (distance(_begin, _end) == 0)
+		//  Overflow check. The largest acceptable value is 256 in the callers.
+		if (ret >= 256)
 			return -1;
+		ret = ret * 10 + (c - '0');
+	}
+	return ret;
+}
 
-		// Disallow leading zero.
-		if (distance(_begin, _end) > 1 && *_begin == '0')
-			return -1;
+}
 
-		int ret = 0;
-		for (auto it = _begin; it != _end; it++)
-		{
-			if (*it < '0' || *it > '9')
-				return -1;
-			//  Overflow check. The largest acceptable value is 256 in the callers.
-			if (ret >= 256)
-				return -1;
-			ret *= 10;
-			ret += *it - '0';
-		}
-		return ret;
-	};
+bool isYulKeyword(string_view _literal)
+{
+	return _literal == "leave" || isYulKeyword(keywordByName(_literal));
+}
 
-	auto positionM = find_if(_literal.begin(), _literal.end(), ::isdigit);
-	if (positionM != _literal.end())
+tuple<Token, unsigned int, unsigned int> fromIdentifierOrKeyword(string_view _literal)
+{
+	// Used for `bytesM`, `uintM`, `intM`, `fixedMxN`, `ufixedMxN`.
+	// M/N must be shortest representation. M can never be 0. N can be zero.
+	size_t positionM = 0;
+	while (positionM < _literal.size() && !isDigit(_literal[positionM]))
+		++positionM;
+	if (positionM == _literal.size())
+		return make_tuple(keywordByName(_literal), 0, 0);
+
+	size_t positionX = positionM;
+	while (positionX < _literal.size() && isDigit(_literal[positionX]))
+		++positionX;
+	int m = parseSize(_literal.substr(positionM, positionX - positionM));
+	Token keyword = keywordByName(_literal.substr(0, positionM));
+	if (keyword == Token::Bytes)
 	{
-		string baseType(_literal.begin(), positionM);
-		auto positionX = find_if_not(positionM, _literal.end(), ::isdigit);
-		int m = parseSize(positionM, positionX);
-		Token keyword = keywordByName(baseType);
-		if (keyword == Token::Bytes)
-		{
-			if (0 < m && m <= 32 && positionX == _literal.end())
-				return make_tuple(Token::BytesM, m, 0);
-		}
-		else if (keyword == Token::UInt || keyword == Token::Int)
+		if (0 < m && m <= 32 && positionX == _literal.size())
+			return make_tuple(Token::BytesM, m, 0);
+	}
+	else if (keyword == Token::UInt || keyword == Token::Int)
+	{
+		if (0 < m && m <= 256 && m % 8 == 0 && positionX == _literal.size())
 		{
-			if (0 < m && m <= 256 && m % 8 == 0 && positionX == _literal.end())
-			{
-				if (keyword == Token::UInt)
-					return make_tuple(Token::UIntM, m, 0);
-				else
-					return make_tuple(Token::IntM, m, 0);
-			}
+			if (keyword == Token::UInt)
+				return make_tuple(Token::UIntM, m, 0);
+			else
+				return make_tuple(Token::IntM, m, 0);
 		}
-		else if (keyword == Token::UFixed || keyword == Token::Fixed)
-		{
+	}
+	else if (keyword == Token::UFixed || keyword == Token::Fixed)
+	{
+		string_view fractional = positionX < _literal.size() ? _literal.substr(positionX + 1) : string_view{};
+		if (
+			positionX < _literal.size() &&
+			_literal[positionX] == 'x' &&
+			all_of(fractional.begin(), fractional.end(), isDigit)
+		) {
+			int n = parseSize(fractional);
 			if (
-				positionM < positionX &&
-				positionX < _literal.end() &&
-				*positionX == 'x' &&
-				all_of(positionX + 1, _literal.end(), ::isdigit)
+				8 <= m && m <= 256 && m % 8 == 0 &&
+				0 <= n && n <= 80
 			) {
-				int n = parseSize(positionX + 1, _literal.end());
-				if (
-					8 <= m && m <= 256 && m % 8 == 0 &&
-					0 <= n && n <= 80
-				) {
-					if (keyword == Token::UFixed)
-						return make_tuple(Token::UFixedMxN, m, n);
-					else
-						return make_tuple(Token::FixedMxN, m, n);
-				}
+				if (keyword == Token::UFixed)
+					return make_tuple(Token::UFixedMxN, m, n);
+				else
+					return make_tuple(Token::FixedMxN, m, n);
 			}
 		}
-		return make_tuple(Token::Identifier, 0, 0);
 	}
-
-	return make_tuple(keywordByName(_literal), 0, 0);
+	return make_tuple(Token::Identifier, 0, 0);
 }
 
 }
@@ -19,6 +19,7 @@
 #include <libsmtutil/CHCSmtLib2Interface.h>
 
 #include <libsolutil/Keccak256.h>
+#include <libsolutil/Tracer.h>
 
 #include <boost/algorithm/string/join.hpp>
 #include <boost/algorithm/string/predicate.hpp>
@@ -52,6 +53,11 @@ void CHCSmtLib2Interface::reset()
 {
 	m_accumulatedOutput.clear();
 	m_variables.clear();
+	m_relationDeclarations.clear();
+	m_relations.clear();
+	m_rules.clear();
+	m_rulesByHead.clear();
+	m_unslicedRules.clear();
 	m_unhandledQueries.clear();
 	if (m_queryTimeout)
 		write("(set-option :timeout " + to_string(*m_queryTimeout) + ")");
@@ -67,7 +73,9 @@ void CHCSmtLib2Interface::registerRelation(Expression const& _expr)
 		string domain = m_smtlib2->toSmtLibSort(fSort->domain);
 		// Relations are predicates which have implicit codomain Bool.
 		m_variables.insert(_expr.name);
-		write(
+		m_relations.insert(_expr.name);
+		m_relationDeclarations.emplace_back(
+			_expr.name,
 			"(declare-rel |" +
 			_expr.name +
 			"| " +
@@ -79,27 +87,31 @@ void CHCSmtLib2Interface::registerRelation(Expression const& _expr)
 
 void CHCSmtLib2Interface::addRule(Expression const& _expr, std::string const& _name)
 {
-	write(
+	Rule rule;
+	if (_expr.name == "implies" && _expr.arguments.size() == 2 && m_relations.count(_expr.arguments[1].name))
+	{
+		rule.head = _expr.arguments[1].name;
+		collectRelations(_expr.arguments[0], rule.body);
+	}
+	else
+		collectRelations(_expr, rule.body);
+	rule.text =
 		"(rule (! " +
 		m_smtlib2->toSExpr(_expr) +
 		" :named " +
 		_name +
-		"))"
-	);
+		"))";
+
+	if (rule.head.empty())
+		m_unslicedRules.push_back(m_rules.size());
+	else
+		m_rulesByHead[rule.head].push_back(m_rules.size());
+	m_rules.emplace_back(move(rule));
 }
 
 pair<CheckResult, CHCSolverInterface::CexGraph> CHCSmtLib2Interface::query(Expression const& _block)
 {
-	string accumulated{};
-	swap(m_accumulatedOutput, accumulated);
-	for (auto const& var: m_smtlib2->variables())
-		declareVariable(var.first, var.second);
-	m_accumulatedOutput += accumulated;
-
-	string response = querySolver(
-		m_accumulatedOutput +
-		"\n(query " + _block.name + " :print-certificate true)"
-	);
+	string response = querySolver(dumpQuery(_block));
 
 	CheckResult result;
 	// TODO proper parsing
@@ -116,6 +128,45 @@ pair<CheckResult, CHCSolverInterface::CexGraph> CHCSmtLib2Interface::query(Expre
 	return {result, {}};
 }
 
+string CHCSmtLib2Interface::dumpQuery(Expression const& _block)
+{
+	string accumulated{};
+	swap(m_accumulatedOutput, accumulated);
+	for (auto const& var: m_smtlib2->variables())
+		declareVariable(var.first, var.second);
+	m_accumulatedOutput += accumulated;
+
+	// Only the rules in the cone of influence of the queried relation are relevant.
+	set<string> relations{_block.name};
+	vector<string> toVisit{_block.name};
+	vector<bool> includedRules(m_rules.size(), false);
+	auto includeRule = [&](size_t _rule) {
+		includedRules[_rule] = true;
+		for (string const& relation: m_rules[_rule].body)
+			if (relations.insert(relation).second)
+				toVisit.push_back(relation);
+	};
+	for (size_t rule: m_unslicedRules)
+		includeRule(rule);
+	while (!toVisit.empty())
+	{
+		string relation = move(toVisit.back());
+		toVisit.pop_back();
+		if (m_rulesByHead.count(relation))
+			for (size_t rule: m_rulesByHead.at(relation))
+				includeRule(rule);
+	}
+
+	string query = m_accumulatedOutput;
+	for (auto const& [relation, declaration]: m_relationDeclarations)
+		if (relations.count(relation))
+			query += declaration + "\n";
+	for (size_t rule = 0; rule < m_rules.size(); ++rule)
+		if (includedRules[rule])
+			query += m_rules[rule].text + "\n";
+	return query + "\n(query " + _block.name + " :print-certificate true)";
+}
+
 void CHCSmtLib2Interface::declareVariable(string const& _name, SortPointer const& _sort)
 {
 	smtAssert(_sort, "");
@@ -157,13 +208,24 @@ void CHCSmtLib2Interface::write(string _data)
 	m_accumulatedOutput += move(_data) + "\n";
 }
 
+void CHCSmtLib2Interface::collectRelations(Expression const& _expr, set<string>& _relations) const
+{
+	if (m_relations.count(_expr.name))
+		_relations.insert(_expr.name);
+	for (Expression const& argument: _expr.arguments)
+		collectRelations(argument, _relations);
+}
+
 string CHCSmtLib2Interface::querySolver(string const& _input)
 {
 	util::h256 inputHash = util::keccak256(_input);
 	if (m_queryResponses.count(inputHash))
 		return m_queryResponses.at(inputHash);
+	if (m_batchResponses.count(inputHash))
+		return m_batchResponses.at(inputHash);
 	if (m_smtCallback)
 	{
+		util::Tracer::Span span("readCallback", "smtQuery");
 		auto result = m_smtCallback(ReadCallback::kindString(ReadCallback::Kind::SMTQuery), _input);
 		if (result.success)
 			return result.responseOrErrorMessage;
@@ -171,3 +233,16 @@ string CHCSmtLib2Interface::querySolver(string const& _input)
 	m_unhandledQueries.push_back(_input);
 	return "unknown\n";
 }
+
+void CHCSmtLib2Interface::queryBatch(vector<string> const& _queries)
+{
+	vector<string> queries;
+	for (string const& query: _queries)
+	{
+		h256 hash = keccak256(query);
+		if (!m_queryResponses.count(hash) && !m_batchResponses.count(hash))
+			queries.push_back(query);
+	}
+	for (auto& [hash, response]: SMTLib2Interface::querySolverBatch(m_smtCallback, queries))
+		m_batchResponses.emplace(hash, move(response));
+}
@@ -46,6 +46,15 @@ public:
 
 	std::pair<CheckResult, CexGraph> query(Expression const& _expr) override;
 
+	/// @returns the Horn system and the query @a _expr in SMT-LIB2 format. Only the rules
+	/// that can derive the queried relation and the declarations of the relations they
+	/// contain are part of the system.
+	std::string dumpQuery(Expression const& _expr) override;
+
+	/// Sends the @a _queries without a response yet to the callback in a single batch,
+	/// as SMTLib2Interface::queryBatch.
+	void queryBatch(std::vector<std::string> const& _queries);
+
 	void declareVariable(std::string const& _name, SortPointer const& _sort) override;
 
 	std::vector<std::string> unhandledQueries() const { return m_unhandledQueries; }
@@ -57,16 +66,38 @@ private:
 
 	void write(std::string _data);
 
+	/// Adds the relations applied in @a _expr to @a _relations.
+	void collectRelations(Expression const& _expr, std::set<std::string>& _relations) const;
+
 	/// Communicates with the solver via the callback. Throws SMTSolverError on error.
 	std::string querySolver(std::string const& _input);
 
 	/// Used to access toSmtLibSort, SExpr, and handle variables.
 	std::unique_ptr<SMTLib2Interface> m_smtlib2;
 
+	struct Rule
+	{
+		/// The relation derived by the rule, empty if it is not known.
+		std::string head;
+		/// The relations in the premises of the rule.
+		std::set<std::string> body;
+		std::string text;
+	};
+
 	std::string m_accumulatedOutput;
 	std::set<std::string> m_variables;
+	/// Declarations of the relations in the order of registration, by name.
+	std::vector<std::pair<std::string, std::string>> m_relationDeclarations;
+	std::set<std::string> m_relations;
+	std::vector<Rule> m_rules;
+	/// Indices of the rules deriving each relation.
+	std::map<std::string, std::vector<size_t>> m_rulesByHead;
+	/// Indices of the rules whose head is not known, which are always part of the system.
+	std::vector<size_t> m_unslicedRules;
 
 	std::map<util::h256, std::string> const& m_queryResponses;
+	/// Responses received by queryBatch.
+	std::map<util::h256, std::string> m_batchResponses;
 	std::vector<std::string> m_unhandledQueries;
 
 	frontend::ReadCallback::Callback m_smtCallback;
@@ -59,6 +59,13 @@ public:
 		Expression const& _expr
 	) = 0;
 
+	/// @returns the Horn system and the query @a _expr in SMT-LIB2 format.
+	virtual std::string dumpQuery(Expression const& _expr) = 0;
+
+	/// Asks a query that is running on another thread to return as soon as possible,
+	/// in which case its result is UNKNOWN. Can be called from any thread.
+	virtual void interrupt() {}
+
 protected:
 	std::optional<unsigned> m_queryTimeout;
 };
@@ -20,6 +20,7 @@
 
 #include <libsolutil/CommonIO.h>
 
+#include <cvc4/base/configuration.h>
 #include <cvc4/util/bitvector.h>
 
 using namespace std;
@@ -34,9 +35,15 @@ CVC4Interface::CVC4Interface(optional<unsigned> _queryTimeout):
 	reset();
 }
 
+string CVC4Interface::version()
+{
+	return CVC4::Configuration::getVersionString();
+}
+
 void CVC4Interface::reset()
 {
 	m_variables.clear();
+	m_translations.clear();
 	m_solver.reset();
 	m_solver.setOption("produce-models", true);
 	if (m_queryTimeout)
@@ -58,6 +65,9 @@ void CVC4Interface::pop()
 void CVC4Interface::declareVariable(string const& _name, SortPointer const& _sort)
 {
 	smtAssert(_sort, "");
+	// Translations may refer to the previous declaration.
+	if (m_variables.count(_name))
+		m_translations.clear();
 	m_variables[_name] = m_context.mkVar(_name.c_str(), cvc4Sort(*_sort));
 }
 
@@ -122,6 +132,20 @@ pair<CheckResult, vector<string>> CVC4Interface::check(vector<Expression> const&
 }
 
 CVC4::Expr CVC4Interface::toCVC4Expr(Expression const& _expr)
+{
+	// Copies of an expression share their arguments, so shared subexpressions are only translated once.
+	if (_expr.arguments.empty())
+		return translate(_expr);
+	auto it = m_translations.find(_expr.arguments.id());
+	if (it == m_translations.end())
+	{
+		CVC4::Expr translation = translate(_expr);
+		it = m_translations.emplace(_expr.arguments.id(), make_pair(_expr.arguments, translation)).first;
+	}
+	return it->second.second;
+}
+
+CVC4::Expr CVC4Interface::translate(Expression const& _expr)
 {
 	// Variable
 	if (_expr.arguments.empty() && m_variables.count(_expr.name))
@@ -34,6 +34,8 @@
 #undef _GLIBCXX_PERMIT_BACKWARD_HASH
 #endif
 
+#include <unordered_map>
+
 namespace solidity::smtutil
 {
 
@@ -42,6 +44,9 @@ class CVC4Interface: public SolverInterface, public boost::noncopyable
 public:
 	CVC4Interface(std::optional<unsigned> _queryTimeout = {});
 
+	/// @returns the version of the linked CVC4 library.
+	static std::string version();
+
 	void reset() override;
 
 	void push() override;
@@ -51,15 +56,22 @@ public:
 
 	void addAssertion(Expression const& _expr) override;
 	std::pair<CheckResult, std::vector<std::string>> check(std::vector<Expression> const& _expressionsToEvaluate) override;
+	void interrupt() override { m_solver.interrupt(); }
+	void clearTranslations() override { m_translations.clear(); }
 
 private:
 	CVC4::Expr toCVC4Expr(Expression const& _expr);
+	/// Translates @a _expr without looking up its translation.
+	CVC4::Expr translate(Expression const& _expr);
 	CVC4::Type cvc4Sort(Sort const& _sort);
 	std::vector<CVC4::Type> cvc4Sort(std::vector<SortPointer> const& _sorts);
 
 	CVC4::ExprManager m_context;
 	CVC4::SmtEngine m_solver;
 	std::map<std::string, CVC4::Expr> m_variables;
+	/// The translations of the expressions with arguments since the last reset, by the
+	/// identifier of their arguments, which are kept alive so that the identifiers stay unique.
+	std::unordered_map<void const*, std::pair<Expression::Arguments, CVC4::Expr>> m_translations;
 
 	// CVC4 "basic resources" limit.
 	// This is used to make the runs more deterministic and platform/machine independent.
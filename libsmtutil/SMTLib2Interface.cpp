@@ -18,7 +18,9 @@
 
 #include <libsmtutil/SMTLib2Interface.h>
 
+#include <libsolutil/JSON.h>
 #include <libsolutil/Keccak256.h>
+#include <libsolutil/Tracer.h>
 
 #include <boost/algorithm/string/join.hpp>
 #include <boost/algorithm/string/predicate.hpp>
@@ -114,10 +116,7 @@ void SMTLib2Interface::addAssertion(Expression const& _expr)
 
 pair<CheckResult, vector<string>> SMTLib2Interface::check(vector<Expression> const& _expressionsToEvaluate)
 {
-	string response = querySolver(
-		boost::algorithm::join(m_accumulatedOutput, "\n") +
-		checkSatAndGetValuesCommand(_expressionsToEvaluate)
-	);
+	string response = querySolver(dumpQuery(_expressionsToEvaluate));
 
 	CheckResult result;
 	// TODO proper parsing
@@ -136,6 +135,11 @@ pair<CheckResult, vector<string>> SMTLib2Interface::check(vector<Expression> con
 	return make_pair(result, values);
 }
 
+string SMTLib2Interface::dumpQuery(vector<Expression> const& _expressionsToEvaluate)
+{
+	return boost::algorithm::join(m_accumulatedOutput, "\n") + checkSatAndGetValuesCommand(_expressionsToEvaluate);
+}
+
 string SMTLib2Interface::toSExpr(Expression const& _expr)
 {
 	if (_expr.arguments.empty())
@@ -312,6 +316,7 @@ string SMTLib2Interface::querySolver(string const& _input)
 		return m_queryResponses.at(inputHash);
 	if (m_smtCallback)
 	{
+		util::Tracer::Span span("readCallback", "smtQuery");
 		auto result = m_smtCallback(ReadCallback::kindString(ReadCallback::Kind::SMTQuery), _input);
 		if (result.success)
 			return result.responseOrErrorMessage;
@@ -319,3 +324,49 @@ string SMTLib2Interface::querySolver(string const& _input)
 	m_unhandledQueries.push_back(_input);
 	return "unknown\n";
 }
+
+void SMTLib2Interface::queryBatch(vector<string> const& _queries)
+{
+	vector<string> queries;
+	for (string const& query: _queries)
+		if (!m_queryResponses.count(keccak256(query)))
+			queries.push_back(query);
+	for (auto& [hash, response]: querySolverBatch(m_smtCallback, queries))
+		m_queryResponses.emplace(hash, move(response));
+}
+
+map<h256, string> SMTLib2Interface::querySolverBatch(
+	ReadCallback::Callback const& _smtCallback,
+	vector<string> const& _queries
+)
+{
+	// A single query is not worth a batch and is sent as usual.
+	if (!_smtCallback || _queries.size() < 2)
+		return {};
+
+	Json::Value batch(Json::arrayValue);
+	for (string const& query: _queries)
+		batch.append(query);
+	ReadCallback::Result result{false, {}};
+	{
+		util::Tracer::Span span("readCallback", "smtQueryBatch", to_string(_queries.size()) + " queries");
+		result = _smtCallback(ReadCallback::kindString(ReadCallback::Kind::SMTQueryBatch), jsonCompactPrint(batch));
+	}
+	if (!result.success)
+		return {};
+
+	Json::Value responses;
+	if (
+		!jsonParseStrict(result.responseOrErrorMessage, responses) ||
+		!responses.isArray() ||
+		responses.size() != batch.size()
+	)
+		return {};
+
+	map<h256, string> answered;
+	for (Json::ArrayIndex i = 0; i < responses.size(); ++i)
+		// The callback can leave some queries unanswered, e.g. with null.
+		if (responses[i].isString())
+			answered.emplace(keccak256(_queries[i]), responses[i].asString());
+	return answered;
+}
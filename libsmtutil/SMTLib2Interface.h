@@ -56,6 +56,21 @@ public:
 
 	std::vector<std::string> unhandledQueries() override { return m_unhandledQueries; }
 
+	/// @returns the query that is sent to the solver by check(@a _expressionsToEvaluate).
+	std::string dumpQuery(std::vector<Expression> const& _expressionsToEvaluate);
+
+	/// Sends the @a _queries without a response yet to the callback in a single batch and
+	/// stores the responses, so that checking these queries later does not invoke the callback.
+	/// Queries not answered by the batch are sent one by one when they are checked.
+	void queryBatch(std::vector<std::string> const& _queries);
+
+	/// Sends @a _queries to @a _smtCallback as a batch and @returns the responses by the hash
+	/// of their queries. @returns an empty map if the callback does not answer batches.
+	static std::map<util::h256, std::string> querySolverBatch(
+		frontend::ReadCallback::Callback const& _smtCallback,
+		std::vector<std::string> const& _queries
+	);
+
 	// Used by CHCSmtLib2Interface
 	std::string toSExpr(Expression const& _expr);
 	std::string toSmtLibSort(Sort const& _sort);
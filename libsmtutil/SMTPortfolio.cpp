@@ -26,6 +26,10 @@
 #endif
 #include <libsmtutil/SMTLib2Interface.h>
 
+#include <libsolutil/ThreadPool.h>
+
+#include <mutex>
+
 using namespace std;
 using namespace solidity;
 using namespace solidity::util;
@@ -36,18 +40,34 @@ SMTPortfolio::SMTPortfolio(
 	map<h256, string> _smtlib2Responses,
 	frontend::ReadCallback::Callback _smtCallback,
 	[[maybe_unused]] SMTSolverChoice _enabledSolvers,
-	optional<unsigned> _queryTimeout
+	optional<unsigned> _queryTimeout,
+	bool _race,
+	shared_ptr<SMTQueryCache> _queryCache
 ):
-	SolverInterface(_queryTimeout)
+	SolverInterface(_queryTimeout),
+	m_race(_race),
+	m_queryCache(move(_queryCache))
 {
+	// Without responses or a callback, the SMT-LIB2 interface never answers.
+	if (!_smtlib2Responses.empty() || _smtCallback)
+		m_solverIDs = "smtlib2";
 	m_solvers.emplace_back(make_unique<SMTLib2Interface>(move(_smtlib2Responses), move(_smtCallback), m_queryTimeout));
+	m_solverNames.emplace_back("smtlib2");
 #ifdef HAVE_Z3
 	if (_enabledSolvers.z3 && Z3Interface::available())
+	{
 		m_solvers.emplace_back(make_unique<Z3Interface>(m_queryTimeout));
+		m_solverNames.emplace_back("z3");
+		m_solverIDs += ",z3 " + Z3Interface::version();
+	}
 #endif
 #ifdef HAVE_CVC4
 	if (_enabledSolvers.cvc4)
+	{
 		m_solvers.emplace_back(make_unique<CVC4Interface>(m_queryTimeout));
+		m_solverNames.emplace_back("cvc4");
+		m_solverIDs += ",cvc4 " + CVC4Interface::version();
+	}
 #endif
 }
 
@@ -72,6 +92,8 @@ void SMTPortfolio::pop()
 void SMTPortfolio::declareVariable(string const& _name, SortPointer const& _sort)
 {
 	smtAssert(_sort, "");
+	if (m_declarationLog)
+		m_declarationLog->emplace_back(_name, _sort);
 	for (auto const& s: m_solvers)
 		s->declareVariable(_name, _sort);
 }
@@ -111,18 +133,62 @@ void SMTPortfolio::addAssertion(Expression const& _expr)
  *   when it is told that this is a hard query to solve.
  *
  *   If all solvers return ERROR, the result is ERROR.
+ *
+ * If the solvers race, they are queried concurrently and the first answer is the result.
+ * Answers of other solvers are not awaited and thus conflicts are not detected.
+ *
+ * Answers found in the query cache are used without asking the solvers.
 */
 pair<CheckResult, vector<string>> SMTPortfolio::check(vector<Expression> const& _expressionsToEvaluate)
+{
+	string query;
+	if (m_queryCache || m_queryBatch)
+	{
+		// The SMT-LIB2 interface contains the same assertions as the other solvers.
+		auto* smtlib2 = dynamic_cast<SMTLib2Interface*>(m_solvers.front().get());
+		smtAssert(smtlib2, "");
+		query = smtlib2->dumpQuery(_expressionsToEvaluate);
+		optional<pair<CheckResult, vector<string>>> answer;
+		if (m_queryCache)
+			answer = m_queryCache->load(m_solverIDs, query);
+		if (m_queryBatch)
+		{
+			if (!answer)
+				m_queryBatch->push_back(move(query));
+			m_answeringSolvers.clear();
+			return {CheckResult::UNKNOWN, {}};
+		}
+		if (answer)
+		{
+			m_answeringSolvers = "cache";
+			return move(*answer);
+		}
+	}
+
+	pair<CheckResult, vector<string>> result;
+	if (m_race && m_solvers.size() > 1)
+		result = race(_expressionsToEvaluate);
+	else
+		result = checkAll(_expressionsToEvaluate);
+
+	if (m_queryCache)
+		m_queryCache->store(m_solverIDs, query, result);
+	return result;
+}
+
+pair<CheckResult, vector<string>> SMTPortfolio::checkAll(vector<Expression> const& _expressionsToEvaluate)
 {
 	CheckResult lastResult = CheckResult::ERROR;
 	vector<string> finalValues;
-	for (auto const& s: m_solvers)
+	m_answeringSolvers.clear();
+	for (size_t i = 0; i < m_solvers.size(); ++i)
 	{
 		CheckResult result;
 		vector<string> values;
-		tie(result, values) = s->check(_expressionsToEvaluate);
+		tie(result, values) = m_solvers[i]->check(_expressionsToEvaluate);
 		if (solverAnswered(result))
 		{
+			m_answeringSolvers += (m_answeringSolvers.empty() ? "" : ",") + m_solverNames[i];
 			if (!solverAnswered(lastResult))
 			{
 				lastResult = result;
@@ -140,6 +206,74 @@ pair<CheckResult, vector<string>> SMTPortfolio::check(vector<Expression> const&
 	return make_pair(lastResult, finalValues);
 }
 
+pair<CheckResult, vector<string>> SMTPortfolio::race(vector<Expression> const& _expressionsToEvaluate)
+{
+	vector<pair<CheckResult, vector<string>>> results(m_solvers.size(), {CheckResult::ERROR, {}});
+	optional<size_t> winner;
+	mutex resultMutex;
+	ThreadPool pool(m_solvers.size());
+	for (size_t i = 0; i < m_solvers.size(); ++i)
+		pool.submit([&, i]() {
+			{
+				// Without threads, the solvers run one after another and the remaining ones are skipped.
+				lock_guard<mutex> lock(resultMutex);
+				if (winner)
+					return;
+			}
+			auto result = m_solvers[i]->check(_expressionsToEvaluate);
+			lock_guard<mutex> lock(resultMutex);
+			results[i] = move(result);
+			if (!winner && solverAnswered(results[i].first))
+			{
+				winner = i;
+				// Solvers that have not started yet are not started any more.
+				pool.cancel();
+				for (size_t j = 0; j < m_solvers.size(); ++j)
+					if (j != i)
+						m_solvers[j]->interrupt();
+			}
+		});
+	pool.wait();
+
+	if (winner)
+	{
+		m_answeringSolvers = m_solverNames[*winner];
+		return move(results[*winner]);
+	}
+	m_answeringSolvers.clear();
+	for (auto const& result: results)
+		if (result.first == CheckResult::UNKNOWN)
+			return {CheckResult::UNKNOWN, {}};
+	return {CheckResult::ERROR, {}};
+}
+
+string SMTPortfolio::dumpQuery(vector<Expression> const& _expressionsToEvaluate)
+{
+	auto* smtlib2 = dynamic_cast<SMTLib2Interface*>(m_solvers.front().get());
+	smtAssert(smtlib2, "");
+	return smtlib2->dumpQuery(_expressionsToEvaluate);
+}
+
+void SMTPortfolio::startQueryBatch()
+{
+	m_queryBatch = vector<string>{};
+}
+
+void SMTPortfolio::sendQueryBatch()
+{
+	smtAssert(m_queryBatch, "");
+	auto* smtlib2 = dynamic_cast<SMTLib2Interface*>(m_solvers.front().get());
+	smtAssert(smtlib2, "");
+	smtlib2->queryBatch(*m_queryBatch);
+	m_queryBatch.reset();
+}
+
+void SMTPortfolio::clearTranslations()
+{
+	for (auto const& s: m_solvers)
+		s->clearTranslations();
+}
+
 vector<string> SMTPortfolio::unhandledQueries()
 {
 	// This code assumes that the constructor guarantees that
@@ -19,12 +19,15 @@
 #pragma once
 
 
+#include <libsmtutil/SMTQueryCache.h>
 #include <libsmtutil/SolverInterface.h>
 #include <libsolidity/interface/ReadFile.h>
 #include <libsolutil/FixedHash.h>
 
 #include <boost/noncopyable.hpp>
 #include <map>
+#include <memory>
+#include <optional>
 #include <vector>
 
 namespace solidity::smtutil
@@ -34,7 +37,8 @@ namespace solidity::smtutil
  * The SMTPortfolio wraps all available solvers within a single interface,
  * propagating the functionalities to all solvers.
  * It also checks whether different solvers give conflicting answers
- * to SMT queries.
+ * to SMT queries, unless the solvers race for the first answer.
+ * If a query cache is given, answers are looked up there before asking the solvers.
  */
 class SMTPortfolio: public SolverInterface, public boost::noncopyable
 {
@@ -43,7 +47,9 @@ public:
 		std::map<util::h256, std::string> _smtlib2Responses = {},
 		frontend::ReadCallback::Callback _smtCallback = {},
 		SMTSolverChoice _enabledSolvers = SMTSolverChoice::All(),
-		std::optional<unsigned> _queryTimeout = {}
+		std::optional<unsigned> _queryTimeout = {},
+		bool _race = false,
+		std::shared_ptr<SMTQueryCache> _queryCache = nullptr
 	);
 
 	void reset() override;
@@ -57,14 +63,53 @@ public:
 
 	std::pair<CheckResult, std::vector<std::string>> check(std::vector<Expression> const& _expressionsToEvaluate) override;
 
+	void clearTranslations() override;
+
 	std::vector<std::string> unhandledQueries() override;
 	size_t solvers() override { return m_solvers.size(); }
+
+	/// @returns the query check(@a _expressionsToEvaluate) sends to the SMT-LIB2 interface.
+	std::string dumpQuery(std::vector<Expression> const& _expressionsToEvaluate);
+	/// @returns the names of the solvers whose answer was used by the last call to check(),
+	/// separated by commas, or "cache" if the answer was found in the query cache.
+	std::string const& answeringSolvers() const { return m_answeringSolvers; }
+
+	/// Starts collecting a batch of queries: Until sendQueryBatch() is called, check() only
+	/// records the query of the SMT-LIB2 interface and returns UNKNOWN without asking the solvers.
+	void startQueryBatch();
+	/// Sends the collected queries to the SMT callback at once, see SMTLib2Interface::queryBatch.
+	void sendQueryBatch();
+
+	/// Appends the names and sorts of all variables declared from now on to @a _log,
+	/// so that they can be declared in the same order on another portfolio.
+	void recordDeclarations(std::vector<std::pair<std::string, SortPointer>>* _log) { m_declarationLog = _log; }
 private:
 	static bool solverAnswered(CheckResult result);
 
+	/// Asks all solvers one after another and combines their results as explained in @a check.
+	std::pair<CheckResult, std::vector<std::string>> checkAll(std::vector<Expression> const& _expressionsToEvaluate);
+
+	/// Runs all solvers concurrently and @returns the first answer, interrupting the
+	/// other solvers. If no solver answers, the result is UNKNOWN or ERROR as in @a check.
+	std::pair<CheckResult, std::vector<std::string>> race(std::vector<Expression> const& _expressionsToEvaluate);
+
 	std::vector<std::unique_ptr<SolverInterface>> m_solvers;
+	/// The names of the solvers, in the same order.
+	std::vector<std::string> m_solverNames;
+	std::string m_answeringSolvers;
+	/// If true, the first answer is used without checking whether the other solvers agree.
+	bool m_race = false;
+
+	std::shared_ptr<SMTQueryCache> m_queryCache;
+	/// The enabled solvers and their versions, as part of the keys of the query cache.
+	std::string m_solverIDs;
 
 	std::vector<Expression> m_assertions;
+
+	/// The queries collected since startQueryBatch(), if a batch is being collected.
+	std::optional<std::vector<std::string>> m_queryBatch;
+
+	std::vector<std::pair<std::string, SortPointer>>* m_declarationLog = nullptr;
 };
 
 }
@@ -0,0 +1,110 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Persistent cache of the answers of SMT solvers.
+ */
+
+#include <libsmtutil/SMTQueryCache.h>
+
+#include <libsolutil/CommonIO.h>
+#include <libsolutil/JSON.h>
+#include <libsolutil/Keccak256.h>
+
+#include <boost/filesystem.hpp>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::util;
+using namespace solidity::smtutil;
+
+optional<SMTQueryCache::Answer> SMTQueryCache::load(string const& _solvers, string const& _query)
+{
+	h256 const key = this->key(_solvers, _query);
+	{
+		lock_guard<mutex> lock(m_mutex);
+		if (auto it = m_answers.find(key); it != m_answers.end())
+			return it->second;
+	}
+
+	try
+	{
+		boost::filesystem::path const path = entryPath(key);
+		if (!boost::filesystem::is_regular_file(path))
+			return nullopt;
+
+		Json::Value entry;
+		if (!jsonParseStrict(readFileAsString(path.string()), entry) || !entry.isObject())
+			return nullopt;
+
+		Answer answer;
+		if (entry["result"] == "sat")
+			answer.first = CheckResult::SATISFIABLE;
+		else if (entry["result"] == "unsat")
+			answer.first = CheckResult::UNSATISFIABLE;
+		else
+			return nullopt;
+		if (!entry["values"].isArray())
+			return nullopt;
+		for (auto const& value: entry["values"])
+		{
+			if (!value.isString())
+				return nullopt;
+			answer.second.push_back(value.asString());
+		}
+
+		lock_guard<mutex> lock(m_mutex);
+		m_answers.emplace(key, answer);
+		return answer;
+	}
+	catch (...)
+	{
+		// Treat corrupted entries as missing, they are replaced after asking the solvers.
+		return nullopt;
+	}
+}
+
+void SMTQueryCache::store(string const& _solvers, string const& _query, Answer const& _answer)
+{
+	if (_answer.first != CheckResult::SATISFIABLE && _answer.first != CheckResult::UNSATISFIABLE)
+		return;
+
+	h256 const key = this->key(_solvers, _query);
+	{
+		lock_guard<mutex> lock(m_mutex);
+		m_answers[key] = _answer;
+	}
+
+	Json::Value entry(Json::objectValue);
+	entry["result"] = _answer.first == CheckResult::SATISFIABLE ? "sat" : "unsat";
+	entry["values"] = Json::arrayValue;
+	for (string const& value: _answer.second)
+		entry["values"].append(value);
+
+	// The cache is only an optimization, failing to fill it is not an error.
+	writeFileAtomically(entryPath(key).string(), jsonCompactPrint(entry));
+}
+
+h256 SMTQueryCache::key(string const& _solvers, string const& _query) const
+{
+	return keccak256(m_salt + "\n" + _solvers + "\n" + _query);
+}
+
+boost::filesystem::path SMTQueryCache::entryPath(h256 const& _key) const
+{
+	return m_directory / (_key.hex() + ".json");
+}
@@ -0,0 +1,79 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Persistent cache of the answers of SMT solvers.
+ */
+
+#pragma once
+
+#include <libsmtutil/SolverInterface.h>
+
+#include <libsolutil/FixedHash.h>
+
+#include <boost/filesystem/path.hpp>
+#include <boost/noncopyable.hpp>
+
+#include <map>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace solidity::smtutil
+{
+
+/**
+ * Maps SMT queries, given as SMT-LIB2 text, to the answers of the solvers that were asked.
+ *
+ * Only answers (SAT or UNSAT) are cached, since UNKNOWN and ERROR depend on the resources
+ * given to the solvers. Entries are keyed by the compiler, the solvers with their versions
+ * and the query. They are kept in memory and stored in a directory, so that they are reused
+ * between compiler runs. Unreadable entries are treated as missing and failures to write
+ * entries are ignored. The cache can be used concurrently.
+ */
+class SMTQueryCache: boost::noncopyable
+{
+public:
+	using Answer = std::pair<CheckResult, std::vector<std::string>>;
+
+	/// @param _salt is part of all keys and has to identify the compiler.
+	SMTQueryCache(std::string _salt, boost::filesystem::path _directory):
+		m_salt(std::move(_salt)),
+		m_directory(std::move(_directory))
+	{}
+
+	/// @returns the answer and the values of the evaluated expressions stored for @a _query
+	/// sent to @a _solvers, or nullopt if there is no such entry.
+	std::optional<Answer> load(std::string const& _solvers, std::string const& _query);
+
+	/// Stores @a _answer for @a _query sent to @a _solvers, replacing an existing entry.
+	/// Results that are not answers are ignored.
+	void store(std::string const& _solvers, std::string const& _query, Answer const& _answer);
+
+private:
+	util::h256 key(std::string const& _solvers, std::string const& _query) const;
+	boost::filesystem::path entryPath(util::h256 const& _key) const;
+
+	std::string const m_salt;
+	boost::filesystem::path const m_directory;
+	std::mutex m_mutex;
+	std::map<util::h256, Answer> m_answers;
+};
+
+}
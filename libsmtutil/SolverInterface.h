@@ -22,6 +22,7 @@
 #include <libsmtutil/Sorts.h>
 
 #include <libsolutil/Common.h>
+#include <libsolutil/MemoryAccounting.h>
 
 #include <boost/noncopyable.hpp>
 #include <cstdio>
@@ -55,10 +56,59 @@ enum class CheckResult
 };
 
 /// C++ representation of an SMTLIB2 expression.
+/// Copies of an expression share its arguments, so that an expression built from copies
+/// of the same subexpression is a DAG rather than a tree.
 class Expression
 {
 	friend class SolverInterface;
 public:
+	/// The immutable arguments of an expression, shared by its copies.
+	class Arguments
+	{
+	public:
+		Arguments() = default;
+		Arguments(std::vector<Expression> _arguments):
+			m_arguments(_arguments.empty() ? nullptr : share(std::move(_arguments)))
+		{}
+
+		bool empty() const { return !m_arguments; }
+		size_t size() const { return m_arguments ? m_arguments->size() : 0; }
+		Expression const& operator[](size_t _index) const { return (*m_arguments)[_index]; }
+		Expression const& at(size_t _index) const
+		{
+			smtAssert(_index < size(), "");
+			return (*m_arguments)[_index];
+		}
+		Expression const& front() const { return at(0); }
+		Expression const& back() const { return at(size() - 1); }
+		Expression const* begin() const { return m_arguments ? m_arguments->data() : nullptr; }
+		Expression const* end() const { return m_arguments ? m_arguments->data() + m_arguments->size() : nullptr; }
+
+		/// @returns an identifier of the arguments that is the same for all copies of
+		/// the expression and unique as long as these copies exist.
+		void const* id() const { return m_arguments.get(); }
+
+	private:
+		/// @returns a shared copy of @a _arguments, whose memory is accounted to the SMT
+		/// encoding while memory accounting is enabled.
+		static std::shared_ptr<std::vector<Expression> const> share(std::vector<Expression> _arguments)
+		{
+			if (!util::MemoryAccounting::enabled())
+				return std::make_shared<std::vector<Expression> const>(std::move(_arguments));
+			size_t const bytes = sizeof(std::vector<Expression>) + _arguments.capacity() * sizeof(Expression);
+			util::MemoryAccounting::allocated(util::MemorySubsystem::SMTEncoding, bytes);
+			return std::shared_ptr<std::vector<Expression> const>(
+				new std::vector<Expression>(std::move(_arguments)),
+				[bytes](std::vector<Expression> const* _shared) {
+					util::MemoryAccounting::released(util::MemorySubsystem::SMTEncoding, bytes);
+					delete _shared;
+				}
+			);
+		}
+
+		std::shared_ptr<std::vector<Expression> const> m_arguments;
+	};
+
 	explicit Expression(bool _v): Expression(_v ? "true" : "false", Kind::Bool) {}
 	explicit Expression(std::shared_ptr<SortSort> _sort, std::string _name = ""): Expression(std::move(_name), {}, _sort) {}
 	explicit Expression(std::string _name, std::vector<Expression> _arguments, SortPointer _sort):
@@ -354,7 +404,7 @@ public:
 	}
 
 	std::string name;
-	std::vector<Expression> arguments;
+	Arguments arguments;
 	SortPointer sort;
 
 private:
@@ -399,6 +449,14 @@ public:
 	virtual std::pair<CheckResult, std::vector<std::string>>
 	check(std::vector<Expression> const& _expressionsToEvaluate) = 0;
 
+	/// Asks a check that is running on another thread to return as soon as possible,
+	/// in which case its result is UNKNOWN. Can be called from any thread.
+	virtual void interrupt() {}
+
+	/// Releases the cached translations of the expressions seen so far, which keep
+	/// those expressions alive. Declarations are kept.
+	virtual void clearTranslations() {}
+
 	/// @returns a list of queries that the system was not able to respond to.
 	virtual std::vector<std::string> unhandledQueries() { return {}; }
 
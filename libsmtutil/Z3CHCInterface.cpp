@@ -20,19 +20,27 @@
 
 #include <libsolutil/CommonIO.h>
 
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
 #include <set>
 #include <stack>
+#include <thread>
 
 using namespace std;
 using namespace solidity;
 using namespace solidity::smtutil;
 
-Z3CHCInterface::Z3CHCInterface(optional<unsigned> _queryTimeout):
+Z3CHCInterface::Z3CHCInterface(optional<unsigned> _queryTimeout, bool _cloneable):
 	CHCSolverInterface(_queryTimeout),
 	m_z3Interface(make_unique<Z3Interface>(m_queryTimeout)),
 	m_context(m_z3Interface->context()),
-	m_solver(*m_context)
+	m_solver(*m_context),
+	m_cloneable(_cloneable)
 {
+	if (m_cloneable)
+		m_z3Interface->recordDeclarations(&m_declarations);
+
 	Z3_get_version(
 		&get<0>(m_version),
 		&get<1>(m_version),
@@ -59,11 +67,15 @@ void Z3CHCInterface::declareVariable(string const& _name, SortPointer const& _so
 
 void Z3CHCInterface::registerRelation(Expression const& _expr)
 {
+	if (m_cloneable)
+		m_steps.push_back({m_declarations.size(), false, _expr, {}});
 	m_solver.register_relation(m_z3Interface->functions().at(_expr.name));
 }
 
 void Z3CHCInterface::addRule(Expression const& _expr, string const& _name)
 {
+	if (m_cloneable)
+		m_steps.push_back({m_declarations.size(), true, _expr, _name});
 	z3::expr rule = m_z3Interface->toZ3Expr(_expr);
 	if (m_z3Interface->constants().empty())
 		m_solver.add_rule(rule, m_context->str_symbol(_name.c_str()));
@@ -77,7 +89,97 @@ void Z3CHCInterface::addRule(Expression const& _expr, string const& _name)
 	}
 }
 
+unique_ptr<Z3CHCInterface> Z3CHCInterface::clone() const
+{
+	smtAssert(m_cloneable, "Solver does not record its rules.");
+	unique_ptr<Z3CHCInterface> clone;
+	{
+		// The constructor sets global parameters of Z3.
+		static mutex constructionMutex;
+		lock_guard<mutex> lock(constructionMutex);
+		clone = make_unique<Z3CHCInterface>(m_queryTimeout);
+	}
+	clone->m_counterexamples = m_counterexamples;
+
+	// Rules quantify over all variables declared before them, so the declarations
+	// are repeated in the same order relative to the rules.
+	size_t declared = 0;
+	auto declareUpTo = [&](size_t _count) {
+		for (; declared < _count; ++declared)
+			clone->m_z3Interface->declareVariable(m_declarations[declared].first, m_declarations[declared].second);
+	};
+	for (RecordedStep const& step: m_steps)
+	{
+		declareUpTo(step.declarations);
+		if (step.isRule)
+			clone->addRule(step.expression, step.name);
+		else
+			clone->registerRelation(step.expression);
+	}
+	declareUpTo(m_declarations.size());
+	return clone;
+}
+
+string Z3CHCInterface::dumpQuery(Expression const& _expr)
+{
+	smtAssert(m_cloneable, "Solver does not record its rules.");
+	if (!m_printer)
+		m_printer = make_unique<CHCSmtLib2Interface>();
+
+	// Only the steps recorded since the last query are added.
+	auto declareUpTo = [&](size_t _count) {
+		for (; m_printedDeclarations < _count; ++m_printedDeclarations)
+			m_printer->declareVariable(m_declarations[m_printedDeclarations].first, m_declarations[m_printedDeclarations].second);
+	};
+	for (; m_printedSteps < m_steps.size(); ++m_printedSteps)
+	{
+		RecordedStep const& step = m_steps[m_printedSteps];
+		declareUpTo(step.declarations);
+		if (step.isRule)
+			m_printer->addRule(step.expression, step.name);
+		else
+			m_printer->registerRelation(step.expression);
+	}
+	declareUpTo(m_declarations.size());
+	return m_printer->dumpQuery(_expr);
+}
+
+void Z3CHCInterface::setInterruptTimeout(optional<unsigned> _timeout)
+{
+	if (_timeout && !m_interruptTimeout)
+		m_context->set("rlimit", 0);
+	m_interruptTimeout = _timeout;
+}
+
 pair<CheckResult, CHCSolverInterface::CexGraph> Z3CHCInterface::query(Expression const& _expr)
+{
+	m_timedOut = false;
+	if (!m_interruptTimeout)
+		return solve(_expr);
+
+	mutex watchdogMutex;
+	condition_variable watchdogCondition;
+	bool finished = false;
+	thread watchdog([&, timeout = chrono::milliseconds(*m_interruptTimeout)]() {
+		unique_lock<mutex> lock(watchdogMutex);
+		if (!watchdogCondition.wait_for(lock, timeout, [&]() { return finished; }))
+		{
+			m_timedOut = true;
+			m_context->interrupt();
+		}
+	});
+
+	auto result = solve(_expr);
+	{
+		lock_guard<mutex> lock(watchdogMutex);
+		finished = true;
+	}
+	watchdogCondition.notify_one();
+	watchdog.join();
+	return result;
+}
+
+pair<CheckResult, CHCSolverInterface::CexGraph> Z3CHCInterface::solve(Expression const& _expr)
 {
 	CheckResult result;
 	try
@@ -90,7 +192,7 @@ pair<CheckResult, CHCSolverInterface::CexGraph> Z3CHCInterface::query(Expression
 			result = CheckResult::SATISFIABLE;
 			// z3 version 4.8.8 modified Spacer to also return
 			// proofs containing nonlinear clauses.
-			if (m_version >= tuple(4, 8, 8, 0))
+			if (m_counterexamples && m_version >= tuple(4, 8, 8, 0))
 			{
 				auto proof = m_solver.get_answer();
 				return {result, cexGraph(proof)};
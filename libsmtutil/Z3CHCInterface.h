@@ -22,9 +22,12 @@
 
 #pragma once
 
+#include <libsmtutil/CHCSmtLib2Interface.h>
 #include <libsmtutil/CHCSolverInterface.h>
 #include <libsmtutil/Z3Interface.h>
 
+#include <atomic>
+#include <memory>
 #include <tuple>
 #include <vector>
 
@@ -34,7 +37,9 @@ namespace solidity::smtutil
 class Z3CHCInterface: public CHCSolverInterface
 {
 public:
-	Z3CHCInterface(std::optional<unsigned> _queryTimeout = {});
+	/// @param _cloneable if true, the solver records everything that is added to it,
+	/// so that it can be cloned and its queries can be dumped.
+	Z3CHCInterface(std::optional<unsigned> _queryTimeout = {}, bool _cloneable = false);
 
 	/// Forwards variable declaration to Z3Interface.
 	void declareVariable(std::string const& _name, SortPointer const& _sort) override;
@@ -45,11 +50,34 @@ public:
 
 	std::pair<CheckResult, CexGraph> query(Expression const& _expr) override;
 
+	/// Requires the solver to be cloneable.
+	std::string dumpQuery(Expression const& _expr) override;
+
+	void interrupt() override { m_context->interrupt(); }
+
+	/// @returns a solver in a new context with the same declarations, relations and rules,
+	/// which can be used on another thread than this solver. Requires the solver to be cloneable.
+	/// Cloning can happen concurrently, but no rules may be added to this solver meanwhile.
+	std::unique_ptr<Z3CHCInterface> clone() const;
+
 	Z3Interface* z3Interface() const { return m_z3Interface.get(); }
 
 	void setSpacerOptions(bool _preProcessing = true);
 
+	/// Sets whether the counterexample graph is extracted from the proof of satisfiable queries.
+	void setCounterexamples(bool _enabled) { m_counterexamples = _enabled; }
+
+	/// Interrupts each of the following queries after @a _timeout milliseconds of wall-clock time,
+	/// if given. This also lifts the deterministic resource limit of the solver for the rest of
+	/// its lifetime, since it would end the queries before the timeout.
+	void setInterruptTimeout(std::optional<unsigned> _timeout);
+	/// @returns true if the last query was interrupted because of the timeout set by setInterruptTimeout.
+	bool lastQueryTimedOut() const { return m_timedOut; }
+
 private:
+	/// Runs the query without the interrupt timeout.
+	std::pair<CheckResult, CexGraph> solve(Expression const& _expr);
+
 	/// Constructs a nonlinear counterexample graph from the refutation.
 	CHCSolverInterface::CexGraph cexGraph(z3::expr const& _proof);
 	/// @returns the fact from a proof node.
@@ -67,6 +95,29 @@ private:
 	z3::fixedpoint m_solver;
 
 	std::tuple<unsigned, unsigned, unsigned, unsigned> m_version = std::tuple(0, 0, 0, 0);
+
+	bool m_counterexamples = true;
+
+	std::optional<unsigned> m_interruptTimeout;
+	std::atomic<bool> m_timedOut{false};
+
+	/// A relation or a rule added to a cloneable solver, together with the number of
+	/// declarations made before it.
+	struct RecordedStep
+	{
+		std::size_t declarations;
+		bool isRule;
+		Expression expression;
+		std::string name;
+	};
+	bool m_cloneable = false;
+	std::vector<std::pair<std::string, SortPointer>> m_declarations;
+	std::vector<RecordedStep> m_steps;
+
+	/// Receives the recorded declarations, relations and rules to dump queries.
+	std::unique_ptr<CHCSmtLib2Interface> m_printer;
+	std::size_t m_printedDeclarations = 0;
+	std::size_t m_printedSteps = 0;
 };
 
 }
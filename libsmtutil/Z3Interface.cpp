@@ -38,6 +38,16 @@ bool Z3Interface::available()
 #endif
 }
 
+string Z3Interface::version()
+{
+	unsigned major = 0;
+	unsigned minor = 0;
+	unsigned build = 0;
+	unsigned revision = 0;
+	Z3_get_version(&major, &minor, &build, &revision);
+	return to_string(major) + "." + to_string(minor) + "." + to_string(build) + "." + to_string(revision);
+}
+
 Z3Interface::Z3Interface(std::optional<unsigned> _queryTimeout):
 	SolverInterface(_queryTimeout),
 	m_solver(m_context)
@@ -55,6 +65,7 @@ void Z3Interface::reset()
 {
 	m_constants.clear();
 	m_functions.clear();
+	m_translations.clear();
 	m_solver.reset();
 }
 
@@ -71,10 +82,16 @@ void Z3Interface::pop()
 void Z3Interface::declareVariable(string const& _name, SortPointer const& _sort)
 {
 	smtAssert(_sort, "");
+	if (m_declarationLog)
+		m_declarationLog->emplace_back(_name, _sort);
 	if (_sort->kind == Kind::Function)
 		declareFunction(_name, *_sort);
 	else if (m_constants.count(_name))
+	{
 		m_constants.at(_name) = m_context.constant(_name.c_str(), z3Sort(*_sort));
+		// Translations may refer to the previous declaration.
+		m_translations.clear();
+	}
 	else
 		m_constants.emplace(_name, m_context.constant(_name.c_str(), z3Sort(*_sort)));
 }
@@ -84,7 +101,10 @@ void Z3Interface::declareFunction(string const& _name, Sort const& _sort)
 	smtAssert(_sort.kind == Kind::Function, "");
 	FunctionSort fSort = dynamic_cast<FunctionSort const&>(_sort);
 	if (m_functions.count(_name))
+	{
 		m_functions.at(_name) = m_context.function(_name.c_str(), z3Sort(fSort.domain), z3Sort(*fSort.codomain));
+		m_translations.clear();
+	}
 	else
 		m_functions.emplace(_name, m_context.function(_name.c_str(), z3Sort(fSort.domain), z3Sort(*fSort.codomain)));
 }
@@ -140,6 +160,20 @@ pair<CheckResult, vector<string>> Z3Interface::check(vector<Expression> const& _
 }
 
 z3::expr Z3Interface::toZ3Expr(Expression const& _expr)
+{
+	// Copies of an expression share their arguments, so shared subexpressions are only translated once.
+	if (_expr.arguments.empty())
+		return translate(_expr);
+	auto it = m_translations.find(_expr.arguments.id());
+	if (it == m_translations.end())
+	{
+		z3::expr translation = translate(_expr);
+		it = m_translations.emplace(_expr.arguments.id(), make_pair(_expr.arguments, translation)).first;
+	}
+	return it->second.second;
+}
+
+z3::expr Z3Interface::translate(Expression const& _expr)
 {
 	if (_expr.arguments.empty() && m_constants.count(_expr.name))
 		return m_constants.at(_expr.name);
@@ -22,6 +22,8 @@
 #include <boost/noncopyable.hpp>
 #include <z3++.h>
 
+#include <unordered_map>
+
 namespace solidity::smtutil
 {
 
@@ -31,6 +33,8 @@ public:
 	Z3Interface(std::optional<unsigned> _queryTimeout = {});
 
 	static bool available();
+	/// @returns the version of the loaded Z3 library.
+	static std::string version();
 
 	void reset() override;
 
@@ -41,6 +45,8 @@ public:
 
 	void addAssertion(Expression const& _expr) override;
 	std::pair<CheckResult, std::vector<std::string>> check(std::vector<Expression> const& _expressionsToEvaluate) override;
+	void interrupt() override { m_context.interrupt(); }
+	void clearTranslations() override { m_translations.clear(); }
 
 	z3::expr toZ3Expr(Expression const& _expr);
 	smtutil::Expression fromZ3Expr(z3::expr const& _expr);
@@ -50,6 +56,10 @@ public:
 
 	z3::context* context() { return &m_context; }
 
+	/// Appends all following declarations to @a _log, so that they can be repeated
+	/// in another context. Recording stops if @a _log is nullptr.
+	void recordDeclarations(std::vector<std::pair<std::string, SortPointer>>* _log) { m_declarationLog = _log; }
+
 	// Z3 "basic resources" limit.
 	// This is used to make the runs more deterministic and platform/machine independent.
 	static int const resourceLimit = 1000000;
@@ -57,6 +67,9 @@ public:
 private:
 	void declareFunction(std::string const& _name, Sort const& _sort);
 
+	/// Translates @a _expr without looking up its translation.
+	z3::expr translate(Expression const& _expr);
+
 	z3::sort z3Sort(Sort const& _sort);
 	z3::sort_vector z3Sort(std::vector<SortPointer> const& _sorts);
 	smtutil::SortPointer fromZ3Sort(z3::sort const& _sort);
@@ -67,6 +80,11 @@ private:
 
 	std::map<std::string, z3::expr> m_constants;
 	std::map<std::string, z3::func_decl> m_functions;
+	/// The translations of the expressions with arguments since the last reset, by the
+	/// identifier of their arguments, which are kept alive so that the identifiers stay unique.
+	std::unordered_map<void const*, std::pair<Expression::Arguments, z3::expr>> m_translations;
+
+	std::vector<std::pair<std::string, SortPointer>>* m_declarationLog = nullptr;
 };
 
 }
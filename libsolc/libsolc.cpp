@@ -25,11 +25,13 @@
 #include <libsolidity/interface/StandardCompiler.h>
 #include <libsolidity/interface/Version.h>
 #include <libyul/YulString.h>
+#include <liblangutil/Symbol.h>
 #include <libsolutil/Common.h>
 #include <libsolutil/JSON.h>
 
 #include <cstdlib>
 #include <list>
+#include <mutex>
 #include <string>
 
 #include "license.h"
@@ -47,6 +49,16 @@ namespace
 // The strings in this list must not be resized after they have been added here (via solidity_alloc()), because
 // this may potentially change the pointer that was passed to the caller from solidity_alloc().
 static list<string> solidityAllocations;
+/// Guards solidityAllocations, which is also used by read callbacks.
+static mutex allocationsMutex;
+/// Compilations run one at a time, because the Yul string repository is shared by all of them.
+static mutex compilationMutex;
+
+char* storeAllocation(string _data)
+{
+	lock_guard<mutex> lock(allocationsMutex);
+	return solidityAllocations.emplace_back(move(_data)).data();
+}
 
 /// Find the equivalent to @p _data in the list of allocations of solidity_alloc(),
 /// removes it from the list and returns its value.
@@ -55,6 +67,7 @@ static list<string> solidityAllocations;
 /// on the caller-side and hence, will call abort() then.
 string takeOverAllocation(char const* _data)
 {
+	lock_guard<mutex> lock(allocationsMutex);
 	for (auto iter = begin(solidityAllocations); iter != end(solidityAllocations); ++iter)
 		if (iter->data() == _data)
 		{
@@ -110,12 +123,22 @@ ReadCallback::Callback wrapReadCallback(CStyleReadFileCallback _readCallback, vo
 
 string compile(string _input, CStyleReadFileCallback _readCallback, void* _readContext)
 {
+	lock_guard<mutex> lock(compilationMutex);
 	StandardCompiler compiler(wrapReadCallback(_readCallback, _readContext));
 	return compiler.compile(move(_input));
 }
 
 }
 
+struct SolidityCompiler
+{
+	SolidityCompiler(CStyleReadFileCallback _readCallback, void* _readContext):
+		compiler(wrapReadCallback(_readCallback, _readContext), /* _keepState */ true)
+	{}
+
+	StandardCompiler compiler;
+};
+
 extern "C"
 {
 extern char const* solidity_license() noexcept
@@ -131,14 +154,14 @@ extern char const* solidity_version() noexcept
 
 extern char* solidity_compile(char const* _input, CStyleReadFileCallback _readCallback, void* _readContext) noexcept
 {
-	return solidityAllocations.emplace_back(compile(_input, _readCallback, _readContext)).data();
+	return storeAllocation(compile(_input, _readCallback, _readContext));
 }
 
 extern char* solidity_alloc(size_t _size) noexcept
 {
 	try
 	{
-		return solidityAllocations.emplace_back(_size, '\0').data();
+		return storeAllocation(string(_size, '\0'));
 	}
 	catch (...)
 	{
@@ -156,7 +179,37 @@ extern void solidity_reset() noexcept
 {
 	// This is called right before each compilation, but not at the end, so additional memory
 	// can be freed here.
-	yul::YulStringRepository::reset();
+	{
+		lock_guard<mutex> lock(compilationMutex);
+		yul::YulStringRepository::reset();
+		langutil::Symbol::reset();
+	}
+	lock_guard<mutex> lock(allocationsMutex);
 	solidityAllocations.clear();
 }
+
+extern SolidityCompiler* solidity_compiler_create(CStyleReadFileCallback _readCallback, void* _readContext) noexcept
+{
+	try
+	{
+		return new SolidityCompiler(_readCallback, _readContext);
+	}
+	catch (...)
+	{
+		return nullptr;
+	}
+}
+
+extern char* solidity_compiler_compile(SolidityCompiler* _compiler, char const* _input) noexcept
+{
+	lock_guard<mutex> lock(compilationMutex);
+	return storeAllocation(_compiler->compiler.compile(string(_input)));
+}
+
+extern void solidity_compiler_destroy(SolidityCompiler* _compiler) noexcept
+{
+	// Destroying the compiler stack resets the Yul string repository.
+	lock_guard<mutex> lock(compilationMutex);
+	delete _compiler;
+}
 }
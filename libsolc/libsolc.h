@@ -96,6 +96,32 @@ char* solidity_compile(char const* _input, CStyleReadFileCallback _readCallback,
 /// is invalid after calling this!
 void solidity_reset() SOLC_NOEXCEPT;
 
+/// A compiler that keeps state across compilations, most notably the parsed sources,
+/// which are reused by later compilations if their content did not change.
+typedef struct SolidityCompiler SolidityCompiler;
+
+/// Creates a compiler that keeps state across calls to solidity_compiler_compile().
+///
+/// @param _readCallback The optional callback pointer used by all compilations of this compiler. Can be NULL.
+/// @param _readContext An optional context pointer passed to _readCallback. Can be NULL.
+///
+/// @returns A pointer to the compiler, which must be released using solidity_compiler_destroy(),
+///          or NULL if it could not be allocated.
+SolidityCompiler* solidity_compiler_create(CStyleReadFileCallback _readCallback, void* _readContext) SOLC_NOEXCEPT;
+
+/// Takes a "Standard Input JSON" and returns a "Standard Output JSON" like solidity_compile(),
+/// but uses and updates the state of @p _compiler.
+///
+/// Compilers can be used from different threads. Compilations currently run one at a time,
+/// because parts of the compiler state are still shared by all compilers.
+/// Calling solidity_reset() drops the kept state of all compilers.
+///
+/// @returns A pointer to the result. The pointer returned must be freed by the caller using solidity_free() or solidity_reset().
+char* solidity_compiler_compile(SolidityCompiler* _compiler, char const* _input) SOLC_NOEXCEPT;
+
+/// Releases @p _compiler and all the state it keeps. Passing NULL has no effect.
+void solidity_compiler_destroy(SolidityCompiler* _compiler) SOLC_NOEXCEPT;
+
 #ifdef __cplusplus
 }
 #endif
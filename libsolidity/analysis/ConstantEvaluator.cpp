@@ -64,10 +64,66 @@ bool fitsPrecisionBase2(bigint const& _mantissa, uint32_t _expBase2)
 	return fitsPrecisionBaseX(_mantissa, 1.0, _expBase2);
 }
 
+/// Limit of the absolute value of small integers. Sums and differences of small integers
+/// cannot overflow int64_t.
+int64_t constexpr smallIntegerLimit = int64_t(1) << 62;
+
+/// @returns the value of @a _value if it is a small integer.
+optional<int64_t> smallInteger(rational const& _value)
+{
+	static bigint const limit{smallIntegerLimit};
+	if (_value.denominator() != 1 || _value.numerator() >= limit || _value.numerator() <= -limit)
+		return nullopt;
+	return _value.numerator().convert_to<int64_t>();
+}
+
+/// Evaluates the binary operators that are common in literal arithmetic without rational
+/// arithmetic, if both operands are small integers.
+/// @returns nullopt if the result has to be computed on rationals.
+optional<rational> evaluateSmallIntegerOperator(Token _operator, int64_t _left, int64_t _right)
+{
+	switch (_operator)
+	{
+	case Token::Add: return rational(bigint(_left + _right));
+	case Token::Sub: return rational(bigint(_left - _right));
+	case Token::Mul:
+		if (_left > -(int64_t(1) << 31) && _left < (int64_t(1) << 31) && _right > -(int64_t(1) << 31) && _right < (int64_t(1) << 31))
+			return rational(bigint(_left * _right));
+		return nullopt;
+	case Token::Div:
+		// Inexact quotients are fractional.
+		if (_right != 0 && _left % _right == 0)
+			return rational(bigint(_left / _right));
+		return nullopt;
+	case Token::Mod:
+		if (_right != 0)
+			return rational(bigint(_left % _right));
+		return nullopt;
+	case Token::BitOr:
+	case Token::BitXor:
+	case Token::BitAnd:
+		if (_left < 0 || _right < 0)
+			return nullopt;
+		if (_operator == Token::BitOr)
+			return rational(bigint(_left | _right));
+		else if (_operator == Token::BitXor)
+			return rational(bigint(_left ^ _right));
+		else
+			return rational(bigint(_left & _right));
+	default:
+		return nullopt;
+	}
+}
+
 }
 
 optional<rational> ConstantEvaluator::evaluateBinaryOperator(Token _operator, rational const& _left, rational const& _right)
 {
+	if (optional<int64_t> left = smallInteger(_left))
+		if (optional<int64_t> right = smallInteger(_right))
+			if (optional<rational> result = evaluateSmallIntegerOperator(_operator, *left, *right))
+				return result;
+
 	bool fractional = _left.denominator() != 1 || _right.denominator() != 1;
 	switch (_operator)
 	{
@@ -20,6 +20,7 @@
 
 #include <liblangutil/SourceLocation.h>
 #include <libsolutil/Algorithms.h>
+#include <boost/dynamic_bitset.hpp>
 #include <boost/range/algorithm/sort.hpp>
 
 using namespace std;
@@ -37,55 +38,91 @@ bool ControlFlowAnalyzer::visit(FunctionDefinition const& _function)
 	if (_function.isImplemented())
 	{
 		auto const& functionFlow = m_cfg.functionFlow(_function);
-		checkUninitializedAccess(functionFlow.entry, functionFlow.exit, _function.body().statements().empty());
-		checkUnreachable(functionFlow.entry, functionFlow.exit, functionFlow.revert, functionFlow.transactionReturn);
+		ReachableNodes reachable{functionFlow.entry};
+		checkUninitializedAccess(reachable, functionFlow.exit, _function.body().statements().empty());
+		checkUnreachable(reachable, functionFlow.exit, functionFlow.revert, functionFlow.transactionReturn);
 	}
 	return false;
 }
 
-void ControlFlowAnalyzer::checkUninitializedAccess(CFGNode const* _entry, CFGNode const* _exit, bool _emptyBody) const
+ControlFlowAnalyzer::ReachableNodes::ReachableNodes(CFGNode const* _entry)
 {
+	indices[_entry] = 0;
+	nodes.push_back(_entry);
+	for (size_t i = 0; i < nodes.size(); ++i)
+		for (CFGNode const* exit: nodes[i]->exits)
+			if (indices.emplace(exit, nodes.size()).second)
+				nodes.push_back(exit);
+}
+
+void ControlFlowAnalyzer::checkUninitializedAccess(ReachableNodes const& _reachable, CFGNode const* _exit, bool _emptyBody) const
+{
+	// Number the declared variables and the occurrences that read them, in the order of the nodes.
+	unordered_map<VariableDeclaration const*, size_t> variableIndices;
+	vector<VariableOccurrence const*> accesses;
+	vector<size_t> firstAccesses;
+	for (CFGNode const* node: _reachable.nodes)
+	{
+		firstAccesses.push_back(accesses.size());
+		for (auto const& variableOccurrence: node->variableOccurrences)
+		{
+			variableIndices.emplace(&variableOccurrence.declaration(), variableIndices.size());
+			if (
+				variableOccurrence.kind() != VariableOccurrence::Kind::Assignment &&
+				variableOccurrence.kind() != VariableOccurrence::Kind::Declaration
+			)
+				accesses.push_back(&variableOccurrence);
+		}
+	}
+
 	struct NodeInfo
 	{
-		set<VariableDeclaration const*> unassignedVariablesAtEntry;
-		set<VariableDeclaration const*> unassignedVariablesAtExit;
-		set<VariableOccurrence const*> uninitializedVariableAccesses;
+		boost::dynamic_bitset<> unassignedVariablesAtEntry;
+		boost::dynamic_bitset<> uninitializedVariableAccesses;
 		/// Propagate the information from another node to this node.
 		/// To be used to propagate information from a node to its exit nodes.
 		/// Returns true, if new variables were added and thus the current node has
 		/// to be traversed again.
-		bool propagateFrom(NodeInfo const& _entryNode)
+		bool propagateFrom(boost::dynamic_bitset<> const& _unassignedVariables, NodeInfo const& _entryNode)
 		{
-			size_t previousUnassignedVariablesAtEntry = unassignedVariablesAtEntry.size();
-			size_t previousUninitializedVariableAccessess = uninitializedVariableAccesses.size();
-			unassignedVariablesAtEntry += _entryNode.unassignedVariablesAtExit;
-			uninitializedVariableAccesses += _entryNode.uninitializedVariableAccesses;
-			return
-				unassignedVariablesAtEntry.size() > previousUnassignedVariablesAtEntry ||
-				uninitializedVariableAccesses.size() > previousUninitializedVariableAccessess
-			;
+			bool changed =
+				!_unassignedVariables.is_subset_of(unassignedVariablesAtEntry) ||
+				!_entryNode.uninitializedVariableAccesses.is_subset_of(uninitializedVariableAccesses);
+			unassignedVariablesAtEntry |= _unassignedVariables;
+			uninitializedVariableAccesses |= _entryNode.uninitializedVariableAccesses;
+			return changed;
 		}
 	};
-	map<CFGNode const*, NodeInfo> nodeInfos;
-	set<CFGNode const*> nodesToTraverse;
-	nodesToTraverse.insert(_entry);
+	vector<NodeInfo> nodeInfos(
+		_reachable.nodes.size(),
+		NodeInfo{boost::dynamic_bitset<>(variableIndices.size()), boost::dynamic_bitset<>(accesses.size())}
+	);
+	vector<bool> visited(_reachable.nodes.size(), false);
+	vector<bool> queued(_reachable.nodes.size(), false);
+	vector<size_t> nodesToTraverse{0};
+	queued[0] = true;
+	visited[0] = true;
 
 	// Walk all paths starting from the nodes in ``nodesToTraverse`` until ``NodeInfo::propagateFrom``
 	// returns false for all exits, i.e. until all paths have been walked with maximal sets of unassigned
 	// variables and accesses.
 	while (!nodesToTraverse.empty())
 	{
-		CFGNode const* currentNode = *nodesToTraverse.begin();
-		nodesToTraverse.erase(nodesToTraverse.begin());
+		size_t currentIndex = nodesToTraverse.back();
+		nodesToTraverse.pop_back();
+		queued[currentIndex] = false;
+		CFGNode const* currentNode = _reachable.nodes[currentIndex];
 
-		auto& nodeInfo = nodeInfos[currentNode];
+		auto& nodeInfo = nodeInfos[currentIndex];
 		auto unassignedVariables = nodeInfo.unassignedVariablesAtEntry;
+		size_t accessIndex = firstAccesses[currentIndex];
 		for (auto const& variableOccurrence: currentNode->variableOccurrences)
 		{
+			size_t variableIndex = variableIndices.at(&variableOccurrence.declaration());
 			switch (variableOccurrence.kind())
 			{
 				case VariableOccurrence::Kind::Assignment:
-					unassignedVariables.erase(&variableOccurrence.declaration());
+					unassignedVariables.reset(variableIndex);
 					break;
 				case VariableOccurrence::Kind::InlineAssembly:
 					// We consider all variables referenced in inline assembly as accessed.
@@ -93,37 +130,50 @@ void ControlFlowAnalyzer::checkUninitializedAccess(CFGNode const* _entry, CFGNod
 					// the control flow in the assembly at some point.
 				case VariableOccurrence::Kind::Access:
 				case VariableOccurrence::Kind::Return:
-					if (unassignedVariables.count(&variableOccurrence.declaration()))
+					solAssert(accesses[accessIndex] == &variableOccurrence, "");
+					if (unassignedVariables.test(variableIndex))
 					{
 						// Merely store the unassigned access. We do not generate an error right away, since this
 						// path might still always revert. It is only an error if this is propagated to the exit
 						// node of the function (i.e. there is a path with an uninitialized access).
-						nodeInfo.uninitializedVariableAccesses.insert(&variableOccurrence);
+						nodeInfo.uninitializedVariableAccesses.set(accessIndex);
 					}
+					++accessIndex;
 					break;
 				case VariableOccurrence::Kind::Declaration:
-					unassignedVariables.insert(&variableOccurrence.declaration());
+					unassignedVariables.set(variableIndex);
 					break;
 			}
 		}
-		nodeInfo.unassignedVariablesAtExit = std::move(unassignedVariables);
 
 		// Propagate changes to all exits and queue them for traversal, if needed.
-		for (auto const& exit: currentNode->exits)
-			if (
-				auto exists = valueOrNullptr(nodeInfos, exit);
-				nodeInfos[exit].propagateFrom(nodeInfo) || !exists
-			)
-				nodesToTraverse.insert(exit);
+		for (CFGNode const* exit: currentNode->exits)
+		{
+			size_t exitIndex = _reachable.indices.at(exit);
+			if (nodeInfos[exitIndex].propagateFrom(unassignedVariables, nodeInfo) || !visited[exitIndex])
+			{
+				visited[exitIndex] = true;
+				if (!queued[exitIndex])
+				{
+					queued[exitIndex] = true;
+					nodesToTraverse.push_back(exitIndex);
+				}
+			}
+		}
 	}
 
-	auto const& exitInfo = nodeInfos[_exit];
-	if (!exitInfo.uninitializedVariableAccesses.empty())
+	if (!_reachable.contains(_exit))
+		return;
+	auto const& exitInfo = nodeInfos[_reachable.indices.at(_exit)];
+	if (exitInfo.uninitializedVariableAccesses.any())
 	{
-		vector<VariableOccurrence const*> uninitializedAccessesOrdered(
-			exitInfo.uninitializedVariableAccesses.begin(),
-			exitInfo.uninitializedVariableAccesses.end()
-		);
+		vector<VariableOccurrence const*> uninitializedAccessesOrdered;
+		for (
+			size_t i = exitInfo.uninitializedVariableAccesses.find_first();
+			i != boost::dynamic_bitset<>::npos;
+			i = exitInfo.uninitializedVariableAccesses.find_next(i)
+		)
+			uninitializedAccessesOrdered.push_back(accesses[i]);
 		boost::range::sort(
 			uninitializedAccessesOrdered,
 			[](VariableOccurrence const* lhs, VariableOccurrence const* rhs) -> bool
@@ -163,22 +213,14 @@ void ControlFlowAnalyzer::checkUninitializedAccess(CFGNode const* _entry, CFGNod
 	}
 }
 
-void ControlFlowAnalyzer::checkUnreachable(CFGNode const* _entry, CFGNode const* _exit, CFGNode const* _revert, CFGNode const* _transactionReturn) const
+void ControlFlowAnalyzer::checkUnreachable(ReachableNodes const& _reachable, CFGNode const* _exit, CFGNode const* _revert, CFGNode const* _transactionReturn) const
 {
-	// collect all nodes reachable from the entry point
-	std::set<CFGNode const*> reachable = util::BreadthFirstSearch<CFGNode const*>{{_entry}}.run(
-		[](CFGNode const* _node, auto&& _addChild) {
-			for (CFGNode const* exit: _node->exits)
-				_addChild(exit);
-		}
-	).visited;
-
 	// traverse all paths backwards from exit, revert and transaction return
 	// and extract (valid) source locations of unreachable nodes into sorted set
 	std::set<SourceLocation> unreachable;
 	util::BreadthFirstSearch<CFGNode const*>{{_exit, _revert, _transactionReturn}}.run(
 		[&](CFGNode const* _node, auto&& _addChild) {
-			if (!reachable.count(_node) && _node->location.isValid())
+			if (!_reachable.contains(_node) && _node->location.isValid())
 				unreachable.insert(_node->location);
 			for (CFGNode const* entry: _node->entries)
 				_addChild(entry);
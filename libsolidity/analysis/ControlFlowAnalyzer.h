@@ -20,6 +20,8 @@
 
 #include <libsolidity/analysis/ControlFlowGraph.h>
 #include <set>
+#include <unordered_map>
+#include <vector>
 
 namespace solidity::frontend
 {
@@ -35,11 +37,23 @@ public:
 	bool visit(FunctionDefinition const& _function) override;
 
 private:
-	/// Checks for uninitialized variable accesses in the control flow between @param _entry and @param _exit.
-	void checkUninitializedAccess(CFGNode const* _entry, CFGNode const* _exit, bool _emptyBody) const;
+	/// The nodes reachable from the entry of a function, numbered densely in breadth-first order,
+	/// so that sets of nodes and the data flow of the checks can be represented as bitsets.
+	struct ReachableNodes
+	{
+		explicit ReachableNodes(CFGNode const* _entry);
+		bool contains(CFGNode const* _node) const { return indices.count(_node); }
+
+		std::vector<CFGNode const*> nodes;
+		std::unordered_map<CFGNode const*, size_t> indices;
+	};
+
+	/// Checks for uninitialized variable accesses in the control flow between the entry of
+	/// @param _reachable and @param _exit.
+	void checkUninitializedAccess(ReachableNodes const& _reachable, CFGNode const* _exit, bool _emptyBody) const;
 	/// Checks for unreachable code, i.e. code ending in @param _exit, @param _revert or @param _transactionReturn
-	/// that can not be reached from @param _entry.
-	void checkUnreachable(CFGNode const* _entry, CFGNode const* _exit, CFGNode const* _revert, CFGNode const* _transactionReturn) const;
+	/// that is not part of @param _reachable.
+	void checkUnreachable(ReachableNodes const& _reachable, CFGNode const* _exit, CFGNode const* _revert, CFGNode const* _transactionReturn) const;
 
 	CFG const& m_cfg;
 	langutil::ErrorReporter& m_errorReporter;
@@ -27,23 +27,25 @@
 #include <libsolidity/ast/Types.h>
 #include <libsolutil/StringUtils.h>
 
+#include <algorithm>
+
 using namespace std;
 using namespace solidity;
 using namespace solidity::frontend;
+using namespace solidity::langutil;
 
 Declaration const* DeclarationContainer::conflictingDeclaration(
 	Declaration const& _declaration,
 	ASTString const* _name
 ) const
 {
-	if (!_name)
-		_name = &_declaration.name();
-	solAssert(!_name->empty(), "");
+	Symbol const name = _name ? Symbol(*_name) : _declaration.symbol();
+	solAssert(!name.empty(), "");
 	vector<Declaration const*> declarations;
-	if (m_declarations.count(*_name))
-		declarations += m_declarations.at(*_name);
-	if (m_invisibleDeclarations.count(*_name))
-		declarations += m_invisibleDeclarations.at(*_name);
+	if (auto it = m_declarations.find(name); it != m_declarations.end())
+		declarations += it->second;
+	if (auto it = m_invisibleDeclarations.find(name); it != m_invisibleDeclarations.end())
+		declarations += it->second;
 
 	if (
 		dynamic_cast<FunctionDefinition const*>(&_declaration) ||
@@ -81,7 +83,7 @@ Declaration const* DeclarationContainer::conflictingDeclaration(
 	return nullptr;
 }
 
-void DeclarationContainer::activateVariable(ASTString const& _name)
+void DeclarationContainer::activateVariable(Symbol _name)
 {
 	solAssert(
 		m_invisibleDeclarations.count(_name) && m_invisibleDeclarations.at(_name).size() == 1,
@@ -92,7 +94,7 @@ void DeclarationContainer::activateVariable(ASTString const& _name)
 	m_invisibleDeclarations.erase(_name);
 }
 
-bool DeclarationContainer::isInvisible(ASTString const& _name) const
+bool DeclarationContainer::isInvisible(Symbol _name) const
 {
 	return m_invisibleDeclarations.count(_name);
 }
@@ -105,16 +107,15 @@ bool DeclarationContainer::registerDeclaration(
 	bool _update
 )
 {
-	if (!_name)
-		_name = &_declaration.name();
-	if (_name->empty())
+	Symbol const name = _name ? Symbol(*_name) : _declaration.symbol();
+	if (name.empty())
 		return true;
 
 	if (_update)
 	{
 		solAssert(!dynamic_cast<FunctionDefinition const*>(&_declaration), "Attempt to update function definition.");
-		m_declarations.erase(*_name);
-		m_invisibleDeclarations.erase(*_name);
+		m_declarations.erase(name);
+		m_invisibleDeclarations.erase(name);
 	}
 	else
 	{
@@ -126,12 +127,14 @@ bool DeclarationContainer::registerDeclaration(
 		// because they do not participate in any proper scope.
 		bool special = _declaration.scope() && (_declaration.isStructMember() || _declaration.isEnumValue() || _declaration.isEventParameter());
 		if (m_enclosingContainer && !special)
-			m_homonymCandidates.emplace_back(*_name, _location ? _location : &_declaration.location());
+			m_homonymCandidates.emplace_back(name, _location ? _location : &_declaration.location());
 	}
 
-	vector<Declaration const*>& decls = _invisible ? m_invisibleDeclarations[*_name] : m_declarations[*_name];
+	vector<Declaration const*>& decls = _invisible ? m_invisibleDeclarations[name] : m_declarations[name];
 	if (!util::contains(decls, &_declaration))
 		decls.push_back(&_declaration);
+	if (m_similarNames)
+		m_similarNames->insert(name.str());
 	return true;
 }
 
@@ -144,14 +147,25 @@ bool DeclarationContainer::registerDeclaration(
 	return registerDeclaration(_declaration, nullptr, nullptr, _invisible, _update);
 }
 
-vector<Declaration const*> DeclarationContainer::resolveName(ASTString const& _name, bool _recursive, bool _alsoInvisible) const
+vector<DeclarationContainer::DeclarationMap::value_type const*> DeclarationContainer::declarationsByName() const
+{
+	vector<DeclarationMap::value_type const*> result;
+	result.reserve(m_declarations.size());
+	for (auto const& entry: m_declarations)
+		result.emplace_back(&entry);
+	sort(result.begin(), result.end(), [](auto const* _a, auto const* _b) { return _a->first < _b->first; });
+	return result;
+}
+
+vector<Declaration const*> DeclarationContainer::resolveName(Symbol _name, bool _recursive, bool _alsoInvisible) const
 {
 	solAssert(!_name.empty(), "Attempt to resolve empty name.");
 	vector<Declaration const*> result;
-	if (m_declarations.count(_name))
-		result = m_declarations.at(_name);
-	if (_alsoInvisible && m_invisibleDeclarations.count(_name))
-		result += m_invisibleDeclarations.at(_name);
+	if (auto it = m_declarations.find(_name); it != m_declarations.end())
+		result = it->second;
+	if (_alsoInvisible)
+		if (auto it = m_invisibleDeclarations.find(_name); it != m_invisibleDeclarations.end())
+			result += it->second;
 	if (result.empty() && _recursive && m_enclosingContainer)
 		result = m_enclosingContainer->resolveName(_name, true, _alsoInvisible);
 	return result;
@@ -164,21 +178,23 @@ vector<ASTString> DeclarationContainer::similarNames(ASTString const& _name) con
 	// since 80 is the suggested line length limit, we use 80^2 as length threshold
 	static size_t const MAXIMUM_LENGTH_THRESHOLD = 80 * 80;
 
-	vector<ASTString> similar;
-	size_t maximumEditDistance = _name.size() > 3 ? 2 : _name.size() / 2;
-	for (auto const& declaration: m_declarations)
-	{
-		string const& declarationName = declaration.first;
-		if (util::stringWithinDistance(_name, declarationName, maximumEditDistance, MAXIMUM_LENGTH_THRESHOLD))
-			similar.push_back(declarationName);
-	}
-	for (auto const& declaration: m_invisibleDeclarations)
+	if (!m_similarNames)
 	{
-		string const& declarationName = declaration.first;
-		if (util::stringWithinDistance(_name, declarationName, maximumEditDistance, MAXIMUM_LENGTH_THRESHOLD))
-			similar.push_back(declarationName);
+		m_similarNames = make_unique<util::SimilarStrings>(2);
+		for (auto const* declarations: {&m_declarations, &m_invisibleDeclarations})
+			for (auto const& declaration: *declarations)
+				m_similarNames->insert(declaration.first.str());
 	}
 
+	vector<ASTString> similar;
+	size_t maximumEditDistance = _name.size() > 3 ? 2 : _name.size() / 2;
+	vector<ASTString> const candidates = m_similarNames->similar(_name, maximumEditDistance, MAXIMUM_LENGTH_THRESHOLD);
+	// The candidates are sorted, so the suggestions are deterministic.
+	for (auto const* declarations: {&m_declarations, &m_invisibleDeclarations})
+		for (ASTString const& candidate: candidates)
+			if (declarations->count(Symbol(candidate)))
+				similar.push_back(candidate);
+
 	if (m_enclosingContainer)
 		similar += m_enclosingContainer->similarNames(_name);
 
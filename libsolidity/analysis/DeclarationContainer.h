@@ -26,8 +26,13 @@
 #include <libsolidity/ast/ASTForward.h>
 #include <liblangutil/Exceptions.h>
 #include <liblangutil/SourceLocation.h>
+#include <liblangutil/Symbol.h>
+#include <libsolutil/StringUtils.h>
 #include <boost/noncopyable.hpp>
 
+#include <memory>
+#include <unordered_map>
+
 namespace solidity::frontend
 {
 
@@ -39,6 +44,7 @@ class DeclarationContainer
 {
 public:
 	using Homonyms = std::vector<std::pair<langutil::SourceLocation const*, std::vector<Declaration const*>>>;
+	using DeclarationMap = std::unordered_map<langutil::Symbol, std::vector<Declaration const*>>;
 
 	explicit DeclarationContainer(
 		ASTNode const* _enclosingNode = nullptr,
@@ -58,19 +64,26 @@ public:
 	bool registerDeclaration(Declaration const& _declaration, ASTString const* _name, langutil::SourceLocation const* _location, bool _invisible, bool _update);
 	bool registerDeclaration(Declaration const& _declaration, bool _invisible, bool _update);
 
-	std::vector<Declaration const*> resolveName(ASTString const& _name, bool _recursive = false, bool _alsoInvisible = false) const;
+	std::vector<Declaration const*> resolveName(langutil::Symbol _name, bool _recursive = false, bool _alsoInvisible = false) const;
+	std::vector<Declaration const*> resolveName(ASTString const& _name, bool _recursive = false, bool _alsoInvisible = false) const
+	{
+		return resolveName(langutil::Symbol(_name), _recursive, _alsoInvisible);
+	}
 	ASTNode const* enclosingNode() const { return m_enclosingNode; }
 	DeclarationContainer const* enclosingContainer() const { return m_enclosingContainer; }
-	std::map<ASTString, std::vector<Declaration const*>> const& declarations() const { return m_declarations; }
+	/// @returns the visible declarations in no particular order.
+	DeclarationMap const& declarations() const { return m_declarations; }
+	/// @returns the visible declarations ordered by name, e.g. to report errors in a deterministic order.
+	std::vector<DeclarationMap::value_type const*> declarationsByName() const;
 	/// @returns whether declaration is valid, and if not also returns previous declaration.
 	Declaration const* conflictingDeclaration(Declaration const& _declaration, ASTString const* _name = nullptr) const;
 
 	/// Activates a previously inactive (invisible) variable. To be used in C99 scoping for
 	/// VariableDeclarationStatements.
-	void activateVariable(ASTString const& _name);
+	void activateVariable(langutil::Symbol _name);
 
 	/// @returns true if declaration is currently invisible.
-	bool isInvisible(ASTString const& _name) const;
+	bool isInvisible(langutil::Symbol _name) const;
 
 	/// @returns existing declaration names similar to @a _name.
 	/// Searches this and all parent containers.
@@ -84,10 +97,12 @@ private:
 	ASTNode const* m_enclosingNode;
 	DeclarationContainer const* m_enclosingContainer;
 	std::vector<DeclarationContainer const*> m_innerContainers;
-	std::map<ASTString, std::vector<Declaration const*>> m_declarations;
-	std::map<ASTString, std::vector<Declaration const*>> m_invisibleDeclarations;
+	DeclarationMap m_declarations;
+	DeclarationMap m_invisibleDeclarations;
 	/// List of declarations (name and location) to check later for homonymity.
-	std::vector<std::pair<std::string, langutil::SourceLocation const*>> m_homonymCandidates;
+	std::vector<std::pair<langutil::Symbol, langutil::SourceLocation const*>> m_homonymCandidates;
+	/// Index of the names of all declarations for @a similarNames, created on its first use.
+	mutable std::unique_ptr<util::SimilarStrings> m_similarNames;
 };
 
 }
@@ -31,11 +31,16 @@ namespace solidity::frontend
 /**
  * Analyses and validates the doc strings.
  * Stores the parsing results in the AST annotations and reports errors.
+ * With @a _onlyChecks, only the @inheritdoc tags are validated and the documentation of
+ * base functions is not copied.
  */
 class DocStringAnalyser: private ASTConstVisitor
 {
 public:
-	DocStringAnalyser(langutil::ErrorReporter& _errorReporter): m_errorReporter(_errorReporter) {}
+	DocStringAnalyser(langutil::ErrorReporter& _errorReporter, bool _onlyChecks = false):
+		m_errorReporter(_errorReporter),
+		m_onlyChecks(_onlyChecks)
+	{}
 	bool analyseDocStrings(SourceUnit const& _sourceUnit);
 
 private:
@@ -57,6 +62,7 @@ private:
 	);
 
 	langutil::ErrorReporter& m_errorReporter;
+	bool m_onlyChecks = false;
 };
 
 }
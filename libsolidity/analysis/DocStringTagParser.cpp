@@ -28,6 +28,8 @@
 #include <libsolidity/analysis/NameAndTypeResolver.h>
 #include <liblangutil/ErrorReporter.h>
 
+#include <boost/algorithm/string/trim.hpp>
+
 using namespace std;
 using namespace solidity;
 using namespace solidity::langutil;
@@ -128,18 +130,44 @@ void DocStringTagParser::handleCallable(
 {
 	static set<string> const validEventTags = set<string>{"dev", "notice", "return", "param"};
 	static set<string> const validModifierTags = set<string>{"dev", "notice", "param", "inheritdoc"};
-	static set<string> const validTags = set<string>{"dev", "notice", "return", "param", "inheritdoc"};
+	static set<string> const validTags = set<string>{"dev", "notice", "return", "param", "inheritdoc", "optimizer"};
 
 	if (dynamic_cast<EventDefinition const*>(&_callable))
 		parseDocStrings(_node, _annotation, validEventTags, "events");
 	else if (dynamic_cast<ModifierDefinition const*>(&_callable))
 		parseDocStrings(_node, _annotation, validModifierTags, "modifiers");
 	else
+	{
 		parseDocStrings(_node, _annotation, validTags, "functions");
+		if (auto const* function = dynamic_cast<FunctionDefinition const*>(&_callable))
+			handleOptimizerTags(*function);
+	}
 
 	checkParameters(_callable, _node, _annotation);
 }
 
+void DocStringTagParser::handleOptimizerTags(FunctionDefinition const& _function)
+{
+	bool noInline = false;
+	auto optimizerRange = _function.annotation().docTags.equal_range("optimizer");
+	for (auto i = optimizerRange.first; i != optimizerRange.second; ++i)
+	{
+		string content = boost::trim_copy(i->second.content);
+		if (content == "noinline")
+			noInline = true;
+		else
+			m_errorReporter.docstringParsingError(
+				7183_error,
+				_function.documentation()->location(),
+				"Documentation tag \"@optimizer " + content + "\" is invalid. The only valid setting is \"noinline\"."
+			);
+	}
+	// The annotation is only written by the checks during analysis, because the documentation
+	// is parsed again while the code generators read it.
+	if (m_onlyChecks)
+		_function.annotation().noInline = noInline;
+}
+
 void DocStringTagParser::parseDocStrings(
 	StructurallyDocumented const& _node,
 	StructurallyDocumentedAnnotation& _annotation,
@@ -147,7 +175,7 @@ void DocStringTagParser::parseDocStrings(
 	string const& _nodeName
 )
 {
-	DocStringParser parser;
+	DocStringParser parser(m_onlyChecks);
 	if (_node.documentation() && !_node.documentation()->text()->empty())
 	{
 		parser.parse(*_node.documentation()->text(), m_errorReporter);
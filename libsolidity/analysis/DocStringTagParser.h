@@ -31,13 +31,22 @@ namespace solidity::frontend
 /**
  * Parses the doc tags and does basic validity checks.
  * Stores the parsing results in the AST annotations and reports errors.
+ * With @a _onlyChecks, only the contents needed for the checks are stored, and the doc strings
+ * have to be parsed again before the documentation is generated.
  */
 class DocStringTagParser: private ASTConstVisitor
 {
 public:
-	explicit DocStringTagParser(langutil::ErrorReporter& _errorReporter): m_errorReporter(_errorReporter) {}
+	explicit DocStringTagParser(langutil::ErrorReporter& _errorReporter, bool _onlyChecks = false):
+		m_errorReporter(_errorReporter),
+		m_onlyChecks(_onlyChecks)
+	{}
 	bool parseDocStrings(SourceUnit const& _sourceUnit);
 
+	/// @returns the visitor performing the checks, e.g. to run them together with other passes
+	/// in a FusedASTConstVisitor. They succeed iff no errors are reported.
+	ASTConstVisitor& visitor() { return *this; }
+
 private:
 	bool visit(ContractDefinition const& _contract) override;
 	bool visit(FunctionDefinition const& _function) override;
@@ -63,6 +72,9 @@ private:
 		StructurallyDocumentedAnnotation& _annotation
 	);
 
+	/// Checks the ``@optimizer`` tags of @a _function and stores their settings in its annotation.
+	void handleOptimizerTags(FunctionDefinition const& _function);
+
 	void parseDocStrings(
 		StructurallyDocumented const& _node,
 		StructurallyDocumentedAnnotation& _annotation,
@@ -71,6 +83,7 @@ private:
 	);
 
 	langutil::ErrorReporter& m_errorReporter;
+	bool m_onlyChecks = false;
 };
 
 }
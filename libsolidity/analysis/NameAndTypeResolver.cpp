@@ -28,6 +28,7 @@
 #include <liblangutil/ErrorReporter.h>
 #include <libsolutil/StringUtils.h>
 #include <boost/algorithm/string.hpp>
+#include <unordered_map>
 #include <unordered_set>
 
 using namespace std;
@@ -83,7 +84,7 @@ bool NameAndTypeResolver::performImports(SourceUnit& _sourceUnit, map<string, So
 			if (!imp->symbolAliases().empty())
 				for (auto const& alias: imp->symbolAliases())
 				{
-					auto declarations = scope->second->resolveName(alias.symbol->name(), false);
+					auto declarations = scope->second->resolveName(alias.symbol->symbol(), false);
 					if (declarations.empty())
 					{
 						m_errorReporter.declarationError(
@@ -107,14 +108,17 @@ bool NameAndTypeResolver::performImports(SourceUnit& _sourceUnit, map<string, So
 								error = true;
 				}
 			else if (imp->name().empty())
-				for (auto const& nameAndDeclaration: scope->second->declarations())
-					for (auto const& declaration: nameAndDeclaration.second)
+				for (auto const* nameAndDeclaration: scope->second->declarationsByName())
+					for (auto const& declaration: nameAndDeclaration->second)
 						if (!DeclarationRegistrationHelper::registerDeclaration(
-							target, *declaration, &nameAndDeclaration.first, &imp->location(), false, m_errorReporter
+							target, *declaration, &nameAndDeclaration->first.str(), &imp->location(), false, m_errorReporter
 						))
 							error =  true;
 		}
-	_sourceUnit.annotation().exportedSymbols = m_scopes[&_sourceUnit]->declarations();
+	map<ASTString, vector<Declaration const*>> exportedSymbols;
+	for (auto const& [name, declarations]: m_scopes[&_sourceUnit]->declarations())
+		exportedSymbols.emplace(name.str(), declarations);
+	_sourceUnit.annotation().exportedSymbols = move(exportedSymbols);
 	return !error;
 }
 
@@ -154,7 +158,7 @@ bool NameAndTypeResolver::updateDeclaration(Declaration const& _declaration)
 	return true;
 }
 
-void NameAndTypeResolver::activateVariable(string const& _name)
+void NameAndTypeResolver::activateVariable(Symbol _name)
 {
 	solAssert(m_currentScope, "");
 	// Scoped local variables are invisible before activation.
@@ -174,7 +178,7 @@ vector<Declaration const*> NameAndTypeResolver::resolveName(ASTString const& _na
 	return iterator->second->resolveName(_name, false);
 }
 
-vector<Declaration const*> NameAndTypeResolver::nameFromCurrentScope(ASTString const& _name, bool _includeInvisibles) const
+vector<Declaration const*> NameAndTypeResolver::nameFromCurrentScope(Symbol _name, bool _includeInvisibles) const
 {
 	return m_currentScope->resolveName(_name, true, _includeInvisibles);
 }
@@ -318,8 +322,8 @@ void NameAndTypeResolver::importInheritedScope(ContractDefinition const& _base)
 {
 	auto iterator = m_scopes.find(&_base);
 	solAssert(iterator != end(m_scopes), "");
-	for (auto const& nameAndDeclaration: iterator->second->declarations())
-		for (auto const& declaration: nameAndDeclaration.second)
+	for (auto const* nameAndDeclaration: iterator->second->declarationsByName())
+		for (auto const& declaration: nameAndDeclaration->second)
 			// Import if it was declared in the base, is not the constructor and is visible in derived classes
 			if (declaration->scope() == &_base && declaration->isVisibleInDerivedContracts())
 				if (!m_currentScope->registerDeclaration(*declaration, false, false))
@@ -369,22 +373,27 @@ void NameAndTypeResolver::linearizeBaseContracts(ContractDefinition& _contract)
 {
 	// order in the lists is from derived to base
 	// list of lists to linearize, the last element is the list of direct bases
-	list<list<ContractDefinition const*>> input(1, list<ContractDefinition const*>{});
+	vector<vector<ContractDefinition const*>> input;
+	vector<ContractDefinition const*> directBases;
 	for (ASTPointer<InheritanceSpecifier> const& baseSpecifier: _contract.baseContracts())
 	{
 		IdentifierPath const& baseName = baseSpecifier->name();
 		auto base = dynamic_cast<ContractDefinition const*>(baseName.annotation().referencedDeclaration);
 		if (!base)
 			m_errorReporter.fatalTypeError(8758_error, baseName.location(), "Contract expected.");
-		// "push_front" has the effect that bases mentioned later can overwrite members of bases
-		// mentioned earlier
-		input.back().push_front(base);
+		directBases.push_back(base);
+		// The linearizations of the bases are final, so they are reused instead of being recomputed.
 		vector<ContractDefinition const*> const& basesBases = base->annotation().linearizedBaseContracts;
 		if (basesBases.empty())
 			m_errorReporter.fatalTypeError(2449_error, baseName.location(), "Definition of base has to precede definition of derived contract");
-		input.push_front(list<ContractDefinition const*>(basesBases.begin(), basesBases.end()));
+		input.push_back(basesBases);
 	}
-	input.back().push_front(&_contract);
+	// Reversing the order has the effect that bases mentioned later can overwrite members of bases
+	// mentioned earlier
+	reverse(input.begin(), input.end());
+	directBases.push_back(&_contract);
+	reverse(directBases.begin(), directBases.end());
+	input.push_back(move(directBases));
 	vector<ContractDefinition const*> result = cThreeMerge(input);
 	if (result.empty())
 		m_errorReporter.fatalTypeError(5005_error, _contract.location(), "Linearization of inheritance graph impossible");
@@ -393,52 +402,41 @@ void NameAndTypeResolver::linearizeBaseContracts(ContractDefinition& _contract)
 }
 
 template <class T>
-vector<T const*> NameAndTypeResolver::cThreeMerge(list<list<T const*>>& _toMerge)
+vector<T const*> NameAndTypeResolver::cThreeMerge(vector<vector<T const*>> const& _toMerge)
 {
-	// returns true iff _candidate appears only as last element of the lists
-	auto appearsOnlyAtHead = [&](T const* _candidate) -> bool
+	// Position of the head of each list. The elements before it have already been merged.
+	vector<size_t> heads(_toMerge.size(), 0);
+	// Number of occurrences of each element in the lists after their heads.
+	unordered_map<T const*, size_t> tailOccurrences;
+	size_t remaining = 0;
+	for (vector<T const*> const& bases: _toMerge)
 	{
-		for (list<T const*> const& bases: _toMerge)
-		{
-			solAssert(!bases.empty(), "");
-			if (find(++bases.begin(), bases.end(), _candidate) != bases.end())
-				return false;
-		}
-		return true;
-	};
-	// returns the next candidate to append to the linearized list or nullptr on failure
-	auto nextCandidate = [&]() -> T const*
-	{
-		for (list<T const*> const& bases: _toMerge)
-		{
-			solAssert(!bases.empty(), "");
-			if (appearsOnlyAtHead(bases.front()))
-				return bases.front();
-		}
-		return nullptr;
-	};
-	// removes the given contract from all lists
-	auto removeCandidate = [&](T const* _candidate)
-	{
-		for (auto it = _toMerge.begin(); it != _toMerge.end();)
-		{
-			it->remove(_candidate);
-			if (it->empty())
-				it = _toMerge.erase(it);
-			else
-				++it;
-		}
-	};
+		for (size_t i = 1; i < bases.size(); ++i)
+			++tailOccurrences[bases[i]];
+		remaining += bases.size();
+	}
 
-	_toMerge.remove_if([](list<T const*> const& _bases) { return _bases.empty(); });
 	vector<T const*> result;
-	while (!_toMerge.empty())
+	while (remaining > 0)
 	{
-		T const* candidate = nextCandidate();
+		// The next candidate to append to the linearized list is the first head
+		// that does not appear in the tail of any list.
+		T const* candidate = nullptr;
+		for (size_t i = 0; i < _toMerge.size() && !candidate; ++i)
+			if (heads[i] < _toMerge[i].size() && tailOccurrences[_toMerge[i][heads[i]]] == 0)
+				candidate = _toMerge[i][heads[i]];
 		if (!candidate)
 			return vector<T const*>();
 		result.push_back(candidate);
-		removeCandidate(candidate);
+		// The candidate only appears at the heads of the lists, so it is removed by advancing them.
+		for (size_t i = 0; i < _toMerge.size(); ++i)
+			if (heads[i] < _toMerge[i].size() && _toMerge[i][heads[i]] == candidate)
+			{
+				++heads[i];
+				--remaining;
+				if (heads[i] < _toMerge[i].size())
+					--tailOccurrences[_toMerge[i][heads[i]]];
+			}
 	}
 	return result;
 }
@@ -515,9 +513,8 @@ bool DeclarationRegistrationHelper::registerDeclaration(
 		Declaration const* conflictingDeclaration = _container.conflictingDeclaration(_declaration, _name);
 		solAssert(conflictingDeclaration, "");
 		bool const comparable =
-			_errorLocation->source &&
-			conflictingDeclaration->location().source &&
-			_errorLocation->source->name() == conflictingDeclaration->location().source->name();
+			_errorLocation->sourceName &&
+			_errorLocation->sourceName == conflictingDeclaration->location().sourceName;
 		if (comparable && _errorLocation->start < conflictingDeclaration->location().start)
 		{
 			firstDeclarationLocation = *_errorLocation;
@@ -33,8 +33,8 @@
 
 #include <boost/noncopyable.hpp>
 
-#include <list>
 #include <map>
+#include <vector>
 
 namespace solidity::langutil
 {
@@ -75,7 +75,7 @@ public:
 	bool updateDeclaration(Declaration const& _declaration);
 	/// Activates a previously inactive (invisible) variable. To be used in C99 scoping for
 	/// VariableDeclarationStatements.
-	void activateVariable(std::string const& _name);
+	void activateVariable(langutil::Symbol _name);
 
 	/// Resolves the given @a _name inside the scope @a _scope. If @a _scope is omitted,
 	/// the global scope is used (i.e. the one containing only the pre-defined global variables).
@@ -85,7 +85,11 @@ public:
 
 	/// Resolves a name in the "current" scope, but also searches parent scopes.
 	/// Should only be called during the initial resolving phase.
-	std::vector<Declaration const*> nameFromCurrentScope(ASTString const& _name, bool _includeInvisibles = false) const;
+	std::vector<Declaration const*> nameFromCurrentScope(langutil::Symbol _name, bool _includeInvisibles = false) const;
+	std::vector<Declaration const*> nameFromCurrentScope(ASTString const& _name, bool _includeInvisibles = false) const
+	{
+		return nameFromCurrentScope(langutil::Symbol(_name), _includeInvisibles);
+	}
 
 	/// Resolves a path starting from the "current" scope, but also searches parent scopes.
 	/// Should only be called during the initial resolving phase.
@@ -111,10 +115,11 @@ private:
 
 	/// Computes "C3-Linearization" of base contracts and stores it inside the contract. Reports errors if any
 	void linearizeBaseContracts(ContractDefinition& _contract);
-	/// Computes the C3-merge of the given list of lists of bases.
+	/// Computes the C3-merge of the given list of lists of bases in time linear in their total length
+	/// for a fixed number of lists.
 	/// @returns the linearized vector or an empty vector if linearization is not possible.
 	template <class T>
-	static std::vector<T const*> cThreeMerge(std::list<std::list<T const*>>& _toMerge);
+	static std::vector<T const*> cThreeMerge(std::vector<std::vector<T const*>> const& _toMerge);
 
 	/// Maps nodes declaring a scope to scopes, i.e. ContractDefinition and FunctionDeclaration,
 	/// where nullptr denotes the global scope. Note that structs are not scope since they do
@@ -37,22 +37,11 @@ using namespace solidity::frontend;
 using namespace solidity::langutil;
 
 using solidity::util::GenericVisitor;
-using solidity::util::contains_if;
 using solidity::util::joinHumanReadable;
 
 namespace
 {
 
-// Helper struct to do a search by name
-struct MatchByName
-{
-	string const& m_name;
-	bool operator()(OverrideProxy const& _item)
-	{
-		return _item.name() == m_name;
-	}
-};
-
 /**
  * Construct the override graph for this signature.
  * Reserve node 0 for the current contract and node
@@ -461,12 +450,13 @@ void OverrideChecker::check(ContractDefinition const& _contract)
 
 void OverrideChecker::checkIllegalOverrides(ContractDefinition const& _contract)
 {
-	OverrideProxyBySignatureMultiSet const& inheritedFuncs = inheritedFunctions(_contract);
-	OverrideProxyBySignatureMultiSet const& inheritedMods = inheritedModifiers(_contract);
+	InheritedMembers const& inherited = inheritedMembers(_contract);
+	OverrideProxyBySignatureMultiSet const& inheritedFuncs = inherited.functions;
+	OverrideProxyBySignatureMultiSet const& inheritedMods = inherited.modifiers;
 
 	for (ModifierDefinition const* modifier: _contract.functionModifiers())
 	{
-		if (contains_if(inheritedFuncs, MatchByName{modifier->name()}))
+		if (inherited.functionNames.count(modifier->name()))
 			m_errorReporter.typeError(
 				5631_error,
 				modifier->location(),
@@ -481,7 +471,7 @@ void OverrideChecker::checkIllegalOverrides(ContractDefinition const& _contract)
 		if (function->isConstructor())
 			continue;
 
-		if (contains_if(inheritedMods, MatchByName{function->name()}))
+		if (inherited.modifierNames.count(function->name()))
 			m_errorReporter.typeError(1469_error, function->location(), "Override changes modifier to function.");
 
 		checkOverrideList(OverrideProxy{function}, inheritedFuncs);
@@ -496,7 +486,7 @@ void OverrideChecker::checkIllegalOverrides(ContractDefinition const& _contract)
 			continue;
 		}
 
-		if (contains_if(inheritedMods, MatchByName{stateVar->name()}))
+		if (inherited.modifierNames.count(stateVar->name()))
 			m_errorReporter.typeError(1456_error, stateVar->location(), "Override changes modifier to public state variable.");
 
 		checkOverrideList(OverrideProxy{stateVar}, inheritedFuncs);
@@ -877,54 +867,37 @@ void OverrideChecker::checkOverrideList(OverrideProxy _item, OverrideProxyBySign
 		);
 }
 
-OverrideChecker::OverrideProxyBySignatureMultiSet const& OverrideChecker::inheritedFunctions(ContractDefinition const& _contract) const
+OverrideChecker::InheritedMembers const& OverrideChecker::inheritedMembers(ContractDefinition const& _contract) const
 {
-	if (!m_inheritedFunctions.count(&_contract))
-	{
-		OverrideProxyBySignatureMultiSet result;
-
-		for (auto const* base: resolveDirectBaseContracts(_contract))
-		{
-			set<OverrideProxy, OverrideProxy::CompareBySignature> functionsInBase;
-			for (FunctionDefinition const* fun: base->definedFunctions())
-				if (!fun->isConstructor())
-					functionsInBase.emplace(OverrideProxy{fun});
-			for (VariableDeclaration const* var: base->stateVariables())
-				if (var->isPublic())
-					functionsInBase.emplace(OverrideProxy{var});
-
-			for (OverrideProxy const& func: inheritedFunctions(*base))
-				functionsInBase.insert(func);
-
-			result += functionsInBase;
-		}
-
-		m_inheritedFunctions[&_contract] = result;
-	}
-
-	return m_inheritedFunctions[&_contract];
-}
+	if (auto it = m_inheritedMembers.find(&_contract); it != m_inheritedMembers.end())
+		return it->second;
 
-OverrideChecker::OverrideProxyBySignatureMultiSet const& OverrideChecker::inheritedModifiers(ContractDefinition const& _contract) const
-{
-	if (!m_inheritedModifiers.count(&_contract))
+	InheritedMembers result;
+	for (auto const* base: resolveDirectBaseContracts(_contract))
 	{
-		OverrideProxyBySignatureMultiSet result;
-
-		for (auto const* base: resolveDirectBaseContracts(_contract))
-		{
-			set<OverrideProxy, OverrideProxy::CompareBySignature> modifiersInBase;
-			for (ModifierDefinition const* mod: base->functionModifiers())
-				modifiersInBase.emplace(OverrideProxy{mod});
-
-			for (OverrideProxy const& mod: inheritedModifiers(*base))
-				modifiersInBase.insert(mod);
-
-			result += modifiersInBase;
-		}
-
-		m_inheritedModifiers[&_contract] = result;
+		InheritedMembers const& inheritedByBase = inheritedMembers(*base);
+
+		set<OverrideProxy, OverrideProxy::CompareBySignature> functionsInBase;
+		for (FunctionDefinition const* fun: base->definedFunctions())
+			if (!fun->isConstructor())
+				functionsInBase.emplace(OverrideProxy{fun});
+		for (VariableDeclaration const* var: base->stateVariables())
+			if (var->isPublic())
+				functionsInBase.emplace(OverrideProxy{var});
+		functionsInBase.insert(inheritedByBase.functions.begin(), inheritedByBase.functions.end());
+
+		set<OverrideProxy, OverrideProxy::CompareBySignature> modifiersInBase;
+		for (ModifierDefinition const* mod: base->functionModifiers())
+			modifiersInBase.emplace(OverrideProxy{mod});
+		modifiersInBase.insert(inheritedByBase.modifiers.begin(), inheritedByBase.modifiers.end());
+
+		for (OverrideProxy const& function: functionsInBase)
+			result.functionNames.insert(function.name());
+		for (OverrideProxy const& modifier: modifiersInBase)
+			result.modifierNames.insert(modifier.name());
+		result.functions += functionsInBase;
+		result.modifiers += modifiersInBase;
 	}
 
-	return m_inheritedModifiers[&_contract];
+	return m_inheritedMembers[&_contract] = move(result);
 }
@@ -27,6 +27,7 @@
 #include <map>
 #include <functional>
 #include <set>
+#include <unordered_map>
 #include <variant>
 #include <optional>
 
@@ -147,10 +148,28 @@ public:
 		bool operator()(ContractDefinition const* _a, ContractDefinition const* _b) const;
 	};
 
-	/// Returns all functions of bases (including public state variables) that have not yet been overwritten.
+	/// Functions (including public state variables) and modifiers of the bases of a contract that
+	/// have not yet been overwritten, together with their names.
 	/// May contain the same function multiple times when used with shared bases.
-	OverrideProxyBySignatureMultiSet const& inheritedFunctions(ContractDefinition const& _contract) const;
-	OverrideProxyBySignatureMultiSet const& inheritedModifiers(ContractDefinition const& _contract) const;
+	struct InheritedMembers
+	{
+		OverrideProxyBySignatureMultiSet functions;
+		OverrideProxyBySignatureMultiSet modifiers;
+		std::set<std::string> functionNames;
+		std::set<std::string> modifierNames;
+	};
+
+	/// @returns the inherited members of @a _contract. They are computed only once per contract
+	/// from those of its direct bases.
+	InheritedMembers const& inheritedMembers(ContractDefinition const& _contract) const;
+	OverrideProxyBySignatureMultiSet const& inheritedFunctions(ContractDefinition const& _contract) const
+	{
+		return inheritedMembers(_contract).functions;
+	}
+	OverrideProxyBySignatureMultiSet const& inheritedModifiers(ContractDefinition const& _contract) const
+	{
+		return inheritedMembers(_contract).modifiers;
+	}
 
 private:
 	void checkIllegalOverrides(ContractDefinition const& _contract);
@@ -191,9 +210,8 @@ private:
 
 	langutil::ErrorReporter& m_errorReporter;
 
-	/// Cache for inheritedFunctions().
-	std::map<ContractDefinition const*, OverrideProxyBySignatureMultiSet> mutable m_inheritedFunctions;
-	std::map<ContractDefinition const*, OverrideProxyBySignatureMultiSet> mutable m_inheritedModifiers;
+	/// Cache for inheritedMembers().
+	std::unordered_map<ContractDefinition const*, InheritedMembers> mutable m_inheritedMembers;
 };
 
 }
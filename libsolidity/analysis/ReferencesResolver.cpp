@@ -105,7 +105,7 @@ void ReferencesResolver::endVisit(VariableDeclarationStatement const& _varDeclSt
 		return;
 	for (auto const& var: _varDeclStatement.declarations())
 		if (var)
-			m_resolver.activateVariable(var->name());
+			m_resolver.activateVariable(var->symbol());
 }
 
 bool ReferencesResolver::visit(VariableDeclaration const& _varDecl)
@@ -118,7 +118,7 @@ bool ReferencesResolver::visit(VariableDeclaration const& _varDecl)
 
 bool ReferencesResolver::visit(Identifier const& _identifier)
 {
-	auto declarations = m_resolver.nameFromCurrentScope(_identifier.name());
+	auto declarations = m_resolver.nameFromCurrentScope(_identifier.symbol());
 	if (declarations.empty())
 	{
 		string suggestions = m_resolver.similarNameSuggestions(_identifier.name());
@@ -57,6 +57,10 @@ public:
 	/// @returns true iff all checks passed. Note even if all checks passed, errors() can still contain warnings
 	bool analyze(SourceUnit const& _sourceUnit);
 
+	/// @returns the visitor performing the checks, e.g. to run them together with other passes
+	/// in a FusedASTConstVisitor. They succeed iff no errors are reported.
+	ASTConstVisitor& visitor() { return *this; }
+
 private:
 
 	bool visit(ContractDefinition const& _contract) override;
@@ -52,6 +52,10 @@ public:
 
 	bool checkSyntax(ASTNode const& _astRoot);
 
+	/// @returns the visitor performing the checks, e.g. to run them together with other passes
+	/// in a FusedASTConstVisitor. They succeed iff no errors are reported.
+	ASTConstVisitor& visitor() { return *this; }
+
 private:
 
 	bool visit(SourceUnit const& _sourceUnit) override;
@@ -2689,7 +2689,7 @@ bool TypeChecker::visit(MemberAccess const& _memberAccess)
 
 	// Retrieve the types of the arguments if this is used to call a function.
 	auto const& arguments = annotation.arguments;
-	MemberList::MemberMap possibleMembers = exprType->members(currentDefinitionScope()).membersByName(memberName);
+	MemberList::MemberMap possibleMembers = exprType->members(currentDefinitionScope()).membersByName(_memberAccess.memberSymbol());
 	size_t const initialMemberCount = possibleMembers.size();
 	if (initialMemberCount > 1 && arguments)
 	{
@@ -2715,7 +2715,7 @@ bool TypeChecker::visit(MemberAccess const& _memberAccess)
 				DataLocation::Storage,
 				exprType
 			);
-			if (!storageType->members(currentDefinitionScope()).membersByName(memberName).empty())
+			if (!storageType->members(currentDefinitionScope()).membersByName(_memberAccess.memberSymbol()).empty())
 				m_errorReporter.fatalTypeError(
 					4994_error,
 					_memberAccess.location(),
@@ -43,6 +43,10 @@ public:
 
 	bool check();
 
+	/// @returns the visitor performing the checks, e.g. to run them together with other passes
+	/// in a FusedASTConstVisitor. They succeed iff no errors are reported.
+	ASTConstVisitor& visitor() { return *this; }
+
 private:
 	struct MutabilityAndLocation
 	{
@@ -38,6 +38,19 @@ using namespace std;
 using namespace solidity;
 using namespace solidity::frontend;
 
+namespace
+{
+
+void moveLocation(langutil::SourceLocation& _location, int _position, int _offset)
+{
+	if (_location.start >= _position)
+		_location.start += _offset;
+	if (_location.end >= _position)
+		_location.end += _offset;
+}
+
+}
+
 ASTNode::ASTNode(int64_t _id, SourceLocation _location):
 	m_id(static_cast<size_t>(_id)),
 	m_location(std::move(_location))
@@ -46,9 +59,12 @@ ASTNode::ASTNode(int64_t _id, SourceLocation _location):
 
 ASTAnnotation& ASTNode::annotation() const
 {
-	if (!m_annotation)
-		m_annotation = make_unique<ASTAnnotation>();
-	return *m_annotation;
+	return initAnnotation<ASTAnnotation>();
+}
+
+void ASTNode::moveLocation(int _position, int _offset)
+{
+	::moveLocation(m_location, _position, _offset);
 }
 
 SourceUnitAnnotation& SourceUnit::annotation() const
@@ -84,6 +100,17 @@ TypePointer ImportDirective::type() const
 	return TypeProvider::module(*annotation().sourceUnit);
 }
 
+void ImportDirective::moveLocation(int _position, int _offset)
+{
+	Declaration::moveLocation(_position, _offset);
+	// The identifiers of the aliases are not visited.
+	for (SymbolAlias& alias: m_symbolAliases)
+	{
+		alias.symbol->moveLocation(_position, _offset);
+		::moveLocation(alias.location, _position, _offset);
+	}
+}
+
 bool ContractDefinition::derivesFrom(ContractDefinition const& _base) const
 {
 	return util::contains(annotation().linearizedBaseContracts, &_base);
@@ -166,7 +193,7 @@ vector<pair<util::FixedHash<4>, FunctionTypePointer>> const& ContractDefinition:
 {
 	return m_interfaceFunctionList[_includeInheritedFunctions].init([&]{
 		set<string> signaturesSeen;
-		vector<pair<util::FixedHash<4>, FunctionTypePointer>> interfaceFunctionList;
+		vector<FunctionTypePointer> interfaceFunctions;
 
 		for (ContractDefinition const* contract: annotation().linearizedBaseContracts)
 		{
@@ -187,13 +214,16 @@ vector<pair<util::FixedHash<4>, FunctionTypePointer>> const& ContractDefinition:
 				string functionSignature = fun->externalSignature();
 				if (signaturesSeen.count(functionSignature) == 0)
 				{
-					signaturesSeen.insert(functionSignature);
-					util::FixedHash<4> hash(util::keccak256(functionSignature));
-					interfaceFunctionList.emplace_back(hash, fun);
+					signaturesSeen.insert(move(functionSignature));
+					interfaceFunctions.push_back(fun);
 				}
 			}
 		}
 
+		FunctionType::cacheExternalSignatureHashes(interfaceFunctions);
+		vector<pair<util::FixedHash<4>, FunctionTypePointer>> interfaceFunctionList;
+		for (FunctionTypePointer const& fun: interfaceFunctions)
+			interfaceFunctionList.emplace_back(util::FixedHash<4>(fun->externalSignatureHash()), fun);
 		return interfaceFunctionList;
 	});
 }
@@ -216,6 +246,15 @@ ContractDefinitionAnnotation& ContractDefinition::annotation() const
 	return initAnnotation<ContractDefinitionAnnotation>();
 }
 
+void ContractDefinition::clearAnnotation()
+{
+	ASTNode::clearAnnotation();
+	// The cached interface refers to types and to declarations of base contracts.
+	for (auto& interfaceFunctionList: m_interfaceFunctionList)
+		interfaceFunctionList.reset();
+	m_interfaceEvents.reset();
+}
+
 ContractDefinition const* ContractDefinition::superContract(ContractDefinition const& _mostDerivedContract) const
 {
 	auto const& hierarchy = _mostDerivedContract.annotation().linearizedBaseContracts;
@@ -503,6 +542,12 @@ DeclarationAnnotation& Declaration::annotation() const
 	return initAnnotation<DeclarationAnnotation>();
 }
 
+void Declaration::moveLocation(int _position, int _offset)
+{
+	ASTNode::moveLocation(_position, _offset);
+	::moveLocation(m_nameLocation, _position, _offset);
+}
+
 bool VariableDeclaration::isLValue() const
 {
 	// Constant declared variables are Read-Only
@@ -26,10 +26,12 @@
 #include <libsolidity/ast/ASTForward.h>
 #include <libsolidity/ast/Types.h>
 #include <libsolidity/ast/ASTAnnotations.h>
+#include <libsolidity/ast/ASTAnnotationTable.h>
 #include <libsolidity/ast/ASTEnums.h>
 #include <libsolidity/parsing/Token.h>
 
 #include <liblangutil/SourceLocation.h>
+#include <liblangutil/Symbol.h>
 #include <libevmasm/Instruction.h>
 #include <libsolutil/FixedHash.h>
 #include <libsolutil/LazyInit.h>
@@ -90,6 +92,13 @@ public:
 
 	/// @returns an identifier of this AST node that is unique for a single compilation run.
 	int64_t id() const { return int64_t(m_id); }
+	/// Adds @a _offset to the identifier. Only to be used to combine nodes of sources that
+	/// were parsed independently of each other.
+	void shiftID(int64_t _offset) { m_id = static_cast<size_t>(id() + _offset); }
+	/// Moves the start and end of the source locations of this node that are at or after
+	/// @a _position by @a _offset. Only to be used to adjust the nodes after an edit of the
+	/// source that was parsed incrementally.
+	virtual void moveLocation(int _position, int _offset);
 
 	virtual void accept(ASTVisitor& _visitor) = 0;
 	virtual void accept(ASTConstVisitor& _visitor) const = 0;
@@ -118,6 +127,24 @@ public:
 	///@todo make this const-safe by providing a different way to access the annotation
 	virtual ASTAnnotation& annotation() const;
 
+	/// Removes the annotation and all other results of analysing the node,
+	/// so that it can be analysed again.
+	virtual void clearAnnotation()
+	{
+		if (m_annotationTable)
+			m_annotationTable->clear(m_annotationSlot);
+		else
+			m_annotation.reset();
+	}
+
+	/// Adds the node to @a _table, which holds its annotation from then on. The table has to
+	/// outlive the node, e.g. by being owned by the arena the node is allocated in.
+	void setAnnotationTable(ASTAnnotationTable& _table)
+	{
+		m_annotationTable = &_table;
+		m_annotationSlot = _table.addNode();
+	}
+
 	///@{
 	///@name equality operators
 	/// Equality relies on the fact that nodes cannot be copied.
@@ -126,11 +153,13 @@ public:
 	///@}
 
 protected:
-	size_t const m_id = 0;
+	size_t m_id = 0;
 
 	template <class T>
 	T& initAnnotation() const
 	{
+		if (m_annotationTable)
+			return m_annotationTable->annotation<T>(m_annotationSlot);
 		if (!m_annotation)
 			m_annotation = std::make_unique<T>();
 		return dynamic_cast<T&>(*m_annotation);
@@ -138,7 +167,10 @@ protected:
 
 private:
 	/// Annotation - is specialised in derived classes, is created upon request (because of polymorphism).
+	/// Only used if the node is not part of an annotation table, e.g. if it was imported from JSON.
 	mutable std::unique_ptr<ASTAnnotation> m_annotation;
+	ASTAnnotationTable* m_annotationTable = nullptr;
+	uint32_t m_annotationSlot = 0;
 	SourceLocation m_location;
 };
 
@@ -243,14 +275,16 @@ public:
 	Declaration(
 		int64_t _id,
 		SourceLocation const& _location,
-		ASTPointer<ASTString> _name,
+		ASTPointer<ASTString const> const& _name,
 		SourceLocation _nameLocation,
 		Visibility _visibility = Visibility::Default
 	):
-		ASTNode(_id, _location), m_name(std::move(_name)), m_nameLocation(std::move(_nameLocation)), m_visibility(_visibility) {}
+		ASTNode(_id, _location), m_name(_name), m_nameLocation(std::move(_nameLocation)), m_visibility(_visibility) {}
 
 	/// @returns the declared name.
-	ASTString const& name() const { return *m_name; }
+	ASTString const& name() const { return m_name.str(); }
+	/// @returns the declared name as a symbol, which is cheaper to compare.
+	langutil::Symbol symbol() const { return m_name; }
 	SourceLocation const& nameLocation() const noexcept { return m_nameLocation; }
 	bool noVisibilitySpecified() const { return m_visibility == Visibility::Default; }
 	Visibility visibility() const { return m_visibility == Visibility::Default ? defaultVisibility() : m_visibility; }
@@ -284,11 +318,13 @@ public:
 
 	DeclarationAnnotation& annotation() const override;
 
+	void moveLocation(int _position, int _offset) override;
+
 protected:
 	virtual Visibility defaultVisibility() const { return Visibility::Public; }
 
 private:
-	ASTPointer<ASTString> m_name;
+	langutil::Symbol m_name;
 	SourceLocation m_nameLocation;
 	Visibility m_visibility;
 };
@@ -347,7 +383,7 @@ public:
 		int64_t _id,
 		SourceLocation const& _location,
 		ASTPointer<ASTString> _path,
-		ASTPointer<ASTString> const& _unitAlias,
+		ASTPointer<ASTString const> const& _unitAlias,
 		SourceLocation _unitAliasLocation,
 		SymbolAliasList _symbolAliases
 	):
@@ -368,6 +404,8 @@ public:
 
 	TypePointer type() const override;
 
+	void moveLocation(int _position, int _offset) override;
+
 private:
 	ASTPointer<ASTString> m_path;
 	/// The aliases for the specific symbols to import. If non-empty import the specific symbols.
@@ -480,7 +518,7 @@ public:
 	ContractDefinition(
 		int64_t _id,
 		SourceLocation const& _location,
-		ASTPointer<ASTString> const& _name,
+		ASTPointer<ASTString const> const& _name,
 		SourceLocation _nameLocation,
 		ASTPointer<StructuredDocumentation> const& _documentation,
 		std::vector<ASTPointer<InheritanceSpecifier>> _baseContracts,
@@ -542,6 +580,7 @@ public:
 	TypePointer type() const override;
 
 	ContractDefinitionAnnotation& annotation() const override;
+	void clearAnnotation() override;
 
 	ContractKind contractKind() const { return m_contractKind; }
 
@@ -647,7 +686,7 @@ public:
 	StructDefinition(
 		int64_t _id,
 		SourceLocation const& _location,
-		ASTPointer<ASTString> const& _name,
+		ASTPointer<ASTString const> const& _name,
 		SourceLocation _nameLocation,
 		std::vector<ASTPointer<VariableDeclaration>> _members
 	):
@@ -675,7 +714,7 @@ public:
 	EnumDefinition(
 		int64_t _id,
 		SourceLocation const& _location,
-		ASTPointer<ASTString> const& _name,
+		ASTPointer<ASTString const> const& _name,
 		SourceLocation _nameLocation,
 		std::vector<ASTPointer<EnumValue>> _members
 	):
@@ -702,7 +741,7 @@ private:
 class EnumValue: public Declaration
 {
 public:
-	EnumValue(int64_t _id, SourceLocation const& _location, ASTPointer<ASTString> const& _name):
+	EnumValue(int64_t _id, SourceLocation const& _location, ASTPointer<ASTString const> const& _name):
 		Declaration(_id, _location, _name, _location) {}
 
 	void accept(ASTVisitor& _visitor) override;
@@ -744,7 +783,7 @@ public:
 	CallableDeclaration(
 		int64_t _id,
 		SourceLocation const& _location,
-		ASTPointer<ASTString> const& _name,
+		ASTPointer<ASTString const> const& _name,
 		SourceLocation _nameLocation,
 		Visibility _visibility,
 		ASTPointer<ParameterList> _parameters,
@@ -822,7 +861,7 @@ public:
 	FunctionDefinition(
 		int64_t _id,
 		SourceLocation const& _location,
-		ASTPointer<ASTString> const& _name,
+		ASTPointer<ASTString const> const& _name,
 		SourceLocation const& _nameLocation,
 		Visibility _visibility,
 		StateMutability _stateMutability,
@@ -863,6 +902,8 @@ public:
 	bool isPayable() const { return m_stateMutability == StateMutability::Payable; }
 	std::vector<ASTPointer<ModifierInvocation>> const& modifiers() const { return m_functionModifiers; }
 	Block const& body() const { solAssert(m_body, ""); return *m_body; }
+	/// Replaces the body by @a _body, which was parsed again after an edit inside the body.
+	void replaceBody(ASTPointer<Block> _body) { solAssert(m_body && _body, ""); m_body = std::move(_body); }
 	Visibility defaultVisibility() const override;
 	bool isVisibleInContract() const override
 	{
@@ -936,7 +977,7 @@ public:
 		int64_t _id,
 		SourceLocation const& _location,
 		ASTPointer<TypeName> _type,
-		ASTPointer<ASTString> const& _name,
+		ASTPointer<ASTString const> const& _name,
 		SourceLocation _nameLocation,
 		ASTPointer<Expression> _value,
 		Visibility _visibility,
@@ -1042,7 +1083,7 @@ public:
 	ModifierDefinition(
 		int64_t _id,
 		SourceLocation const& _location,
-		ASTPointer<ASTString> const& _name,
+		ASTPointer<ASTString const> const& _name,
 		SourceLocation _nameLocation,
 		ASTPointer<StructuredDocumentation> const& _documentation,
 		ASTPointer<ParameterList> const& _parameters,
@@ -1061,6 +1102,8 @@ public:
 	void accept(ASTConstVisitor& _visitor) const override;
 
 	Block const& body() const { solAssert(m_body, ""); return *m_body; }
+	/// Replaces the body by @a _body, which was parsed again after an edit inside the body.
+	void replaceBody(ASTPointer<Block> _body) { solAssert(m_body && _body, ""); m_body = std::move(_body); }
 
 	TypePointer type() const override;
 
@@ -1118,7 +1161,7 @@ public:
 	EventDefinition(
 		int64_t _id,
 		SourceLocation const& _location,
-		ASTPointer<ASTString> const& _name,
+		ASTPointer<ASTString const> const& _name,
 		SourceLocation _nameLocation,
 		ASTPointer<StructuredDocumentation> const& _documentation,
 		ASTPointer<ParameterList> const& _parameters,
@@ -2029,19 +2072,20 @@ public:
 		int64_t _id,
 		SourceLocation const& _location,
 		ASTPointer<Expression> _expression,
-		ASTPointer<ASTString> _memberName
+		ASTPointer<ASTString const> const& _memberName
 	):
-		Expression(_id, _location), m_expression(std::move(_expression)), m_memberName(std::move(_memberName)) {}
+		Expression(_id, _location), m_expression(std::move(_expression)), m_memberName(_memberName) {}
 	void accept(ASTVisitor& _visitor) override;
 	void accept(ASTConstVisitor& _visitor) const override;
 	Expression const& expression() const { return *m_expression; }
-	ASTString const& memberName() const { return *m_memberName; }
+	ASTString const& memberName() const { return m_memberName.str(); }
+	langutil::Symbol memberSymbol() const { return m_memberName; }
 
 	MemberAccessAnnotation& annotation() const override;
 
 private:
 	ASTPointer<Expression> m_expression;
-	ASTPointer<ASTString> m_memberName;
+	langutil::Symbol m_memberName;
 };
 
 /**
@@ -2114,18 +2158,19 @@ public:
 	Identifier(
 		int64_t _id,
 		SourceLocation const& _location,
-		ASTPointer<ASTString> _name
+		ASTPointer<ASTString const> const& _name
 	):
-		PrimaryExpression(_id, _location), m_name(std::move(_name)) {}
+		PrimaryExpression(_id, _location), m_name(_name) {}
 	void accept(ASTVisitor& _visitor) override;
 	void accept(ASTConstVisitor& _visitor) const override;
 
-	ASTString const& name() const { return *m_name; }
+	ASTString const& name() const { return m_name.str(); }
+	langutil::Symbol symbol() const { return m_name; }
 
 	IdentifierAnnotation& annotation() const override;
 
 private:
-	ASTPointer<ASTString> m_name;
+	langutil::Symbol m_name;
 };
 
 /**
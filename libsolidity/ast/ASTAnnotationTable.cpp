@@ -0,0 +1,112 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Storage of the annotations of the nodes of a source unit.
+ */
+
+#include <libsolidity/ast/ASTAnnotationTable.h>
+
+#include <liblangutil/Exceptions.h>
+
+#include <atomic>
+#include <limits>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::frontend;
+
+ASTAnnotationTable::~ASTAnnotationTable()
+{
+	for (atomic<ASTAnnotation*> const& slot: m_annotations)
+		if (ASTAnnotation* annotation = slot.load(memory_order_relaxed))
+			annotation->~ASTAnnotation();
+	// The chunks stay reserved until the arena is destroyed.
+	util::MemoryAccount::transfer(m_memory, m_arena.memoryAccount(), m_memory.bytes());
+}
+
+uint32_t ASTAnnotationTable::addNode()
+{
+	solAssert(m_annotations.size() < numeric_limits<uint32_t>::max(), "Too many AST nodes.");
+	m_annotations.emplace_back(nullptr);
+	m_kinds.push_back(0);
+	return static_cast<uint32_t>(m_annotations.size() - 1);
+}
+
+void ASTAnnotationTable::clear(uint32_t _slot)
+{
+	lock_guard<mutex> lock(m_mutex);
+	ASTAnnotation* annotation = m_annotations[_slot].load(memory_order_relaxed);
+	if (!annotation)
+		return;
+	// The annotation types use multiple inheritance, so the object can start before its ASTAnnotation part.
+	void* storage = dynamic_cast<void*>(annotation);
+	annotation->~ASTAnnotation();
+	m_pools[m_kinds[_slot]].freeObjects.push_back(storage);
+	m_annotations[_slot].store(nullptr, memory_order_release);
+}
+
+uint8_t ASTAnnotationTable::nextKind()
+{
+	static atomic<unsigned> kinds{0};
+	unsigned kind = kinds++;
+	solAssert(kind <= numeric_limits<uint8_t>::max(), "Too many annotation types.");
+	return static_cast<uint8_t>(kind);
+}
+
+ASTAnnotation* ASTAnnotationTable::create(
+	uint32_t _slot,
+	uint8_t _kind,
+	size_t _size,
+	size_t _alignment,
+	ASTAnnotation* (*_construct)(void*)
+)
+{
+	lock_guard<mutex> lock(m_mutex);
+	// Another thread may have created the annotation in the meantime.
+	if (ASTAnnotation* annotation = m_annotations[_slot].load(memory_order_relaxed))
+		return annotation;
+
+	if (m_pools.size() <= _kind)
+		m_pools.resize(size_t(_kind) + 1);
+	Pool& pool = m_pools[_kind];
+	void* storage = nullptr;
+	if (!pool.freeObjects.empty())
+	{
+		storage = pool.freeObjects.back();
+		pool.freeObjects.pop_back();
+	}
+	else
+	{
+		size_t const objectSize = (_size + _alignment - 1) / _alignment * _alignment;
+		if (pool.current == pool.end)
+		{
+			size_t const chunkSize = objectSize * pool.nextChunkObjects;
+			pool.current = static_cast<byte*>(m_arena.allocateSynchronized(chunkSize, _alignment));
+			util::MemoryAccount::transfer(m_arena.memoryAccount(), m_memory, chunkSize);
+			pool.end = pool.current + chunkSize;
+			pool.nextChunkObjects = min<size_t>(pool.nextChunkObjects * 2, 1024);
+		}
+		storage = pool.current;
+		pool.current += objectSize;
+	}
+
+	ASTAnnotation* annotation = _construct(storage);
+	m_kinds[_slot] = _kind;
+	m_annotations[_slot].store(annotation, memory_order_release);
+	return annotation;
+}
@@ -0,0 +1,113 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Storage of the annotations of the nodes of a source unit.
+ */
+
+#pragma once
+
+#include <libsolidity/ast/ASTAnnotations.h>
+
+#include <libsolutil/Arena.h>
+
+#include <boost/noncopyable.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <deque>
+#include <cstdint>
+#include <mutex>
+#include <new>
+#include <vector>
+
+namespace solidity::frontend
+{
+
+/**
+ * Holds the annotations of the nodes of a source unit in a table indexed by the position of
+ * the node in the source unit, i.e. by its ID relative to the first node of the source unit.
+ *
+ * Annotations of the same type are placed next to each other in the arena of the source
+ * unit. The memory of cleared annotations is reused for the next annotation of the same type,
+ * and all remaining annotations are destroyed together with the table.
+ */
+class ASTAnnotationTable: boost::noncopyable
+{
+public:
+	explicit ASTAnnotationTable(util::Arena& _arena): m_arena(_arena) {}
+	~ASTAnnotationTable();
+
+	/// Adds the slot of a new node and @returns its index. Not synchronized, i.e. all nodes have
+	/// to be added before the first annotation is created.
+	uint32_t addNode();
+
+	/// @returns the annotation in slot @a _slot, which is created if it does not exist yet.
+	/// Annotations can be created concurrently.
+	template <class T>
+	T& annotation(uint32_t _slot)
+	{
+		ASTAnnotation* annotation = m_annotations[_slot].load(std::memory_order_acquire);
+		if (!annotation)
+			annotation = create(_slot, kind<T>(), sizeof(T), alignof(T), [](void* _storage) -> ASTAnnotation* {
+				return new (_storage) T();
+			});
+		return dynamic_cast<T&>(*annotation);
+	}
+
+	/// Destroys the annotation in slot @a _slot, if any.
+	void clear(uint32_t _slot);
+
+private:
+	/// Memory for the annotations of one type.
+	struct Pool
+	{
+		std::vector<void*> freeObjects;
+		std::byte* current = nullptr;
+		std::byte* end = nullptr;
+		size_t nextChunkObjects = 16;
+	};
+
+	/// @returns the index of the pool of annotations of type @a T.
+	template <class T>
+	static uint8_t kind()
+	{
+		static uint8_t const kind = nextKind();
+		return kind;
+	}
+	static uint8_t nextKind();
+
+	ASTAnnotation* create(
+		uint32_t _slot,
+		uint8_t _kind,
+		size_t _size,
+		size_t _alignment,
+		ASTAnnotation* (*_construct)(void*)
+	);
+
+	util::Arena& m_arena;
+	/// Memory of the chunks of the pools, which is transferred from the account of the arena.
+	util::MemoryAccount m_memory{util::MemorySubsystem::Annotations};
+	std::mutex m_mutex;
+	/// Read without the mutex, so the slots are atomic and annotations are published with release
+	/// semantics once they are constructed. A deque, because atomics cannot be moved.
+	std::deque<std::atomic<ASTAnnotation*>> m_annotations;
+	std::vector<uint8_t> m_kinds;
+	std::vector<Pool> m_pools;
+};
+
+}
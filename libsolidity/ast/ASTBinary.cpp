@@ -0,0 +1,394 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Compact binary format of the JSON AST.
+ */
+
+#include <libsolidity/ast/ASTBinary.h>
+
+#include <liblangutil/Exceptions.h>
+
+#include <cstring>
+#include <unordered_map>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::frontend;
+
+namespace
+{
+
+string_view const signature{"\0SOLAST\0", 8};
+
+/// Size of the header: signature, version, number of sources, number of strings and
+/// offset of the string table.
+size_t constexpr headerSize = 8 + 4 + 4 + 8 + 8;
+/// Size of an index entry: index of the name in the string table, offset and length.
+size_t constexpr entrySize = 3 * 8;
+/// Maximum nesting of arrays and objects, the same as the default limit of the JSON parser.
+size_t constexpr maxDepth = 1000;
+
+enum class Tag: uint8_t
+{
+	Null,
+	False,
+	True,
+	Int,
+	UInt,
+	Real,
+	String,
+	Array,
+	Object
+};
+
+void writeFixed(string& _out, uint64_t _value, size_t _size)
+{
+	for (size_t i = 0; i < _size; ++i)
+		_out.push_back(static_cast<char>((_value >> (8 * i)) & 0xff));
+}
+
+void writeVarint(string& _out, uint64_t _value)
+{
+	while (_value >= 0x80)
+	{
+		_out.push_back(static_cast<char>((_value & 0x7f) | 0x80));
+		_value >>= 7;
+	}
+	_out.push_back(static_cast<char>(_value));
+}
+
+class Encoder
+{
+public:
+	uint64_t stringIndex(string const& _string)
+	{
+		auto [it, inserted] = m_stringIndices.emplace(_string, m_strings.size());
+		if (inserted)
+			m_strings.push_back(&it->first);
+		return it->second;
+	}
+
+	void encode(string& _out, Json::Value const& _value)
+	{
+		switch (_value.type())
+		{
+		case Json::nullValue:
+			_out.push_back(static_cast<char>(Tag::Null));
+			break;
+		case Json::booleanValue:
+			_out.push_back(static_cast<char>(_value.asBool() ? Tag::True : Tag::False));
+			break;
+		case Json::intValue:
+		{
+			int64_t value = _value.asInt64();
+			_out.push_back(static_cast<char>(Tag::Int));
+			writeVarint(_out, (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63));
+			break;
+		}
+		case Json::uintValue:
+			_out.push_back(static_cast<char>(Tag::UInt));
+			writeVarint(_out, _value.asUInt64());
+			break;
+		case Json::realValue:
+		{
+			double value = _value.asDouble();
+			uint64_t bits = 0;
+			memcpy(&bits, &value, sizeof(bits));
+			_out.push_back(static_cast<char>(Tag::Real));
+			writeFixed(_out, bits, 8);
+			break;
+		}
+		case Json::stringValue:
+			_out.push_back(static_cast<char>(Tag::String));
+			writeVarint(_out, stringIndex(_value.asString()));
+			break;
+		case Json::arrayValue:
+			_out.push_back(static_cast<char>(Tag::Array));
+			writeVarint(_out, _value.size());
+			for (Json::Value const& element: _value)
+				encode(_out, element);
+			break;
+		case Json::objectValue:
+			_out.push_back(static_cast<char>(Tag::Object));
+			writeVarint(_out, _value.size());
+			for (auto it = _value.begin(); it != _value.end(); ++it)
+			{
+				writeVarint(_out, stringIndex(it.name()));
+				encode(_out, *it);
+			}
+			break;
+		}
+	}
+
+	vector<string const*> const& strings() const { return m_strings; }
+
+private:
+	unordered_map<string, uint64_t> m_stringIndices;
+	vector<string const*> m_strings;
+};
+
+/// Reads from a bounded part of the data and throws InvalidAstError instead of reading past it.
+class Reader
+{
+public:
+	Reader(string_view _data, uint64_t _offset, uint64_t _length):
+		m_data(_data)
+	{
+		astAssert(_offset <= _data.size() && _length <= _data.size() - _offset, "Binary AST truncated.");
+		m_position = _offset;
+		m_end = _offset + _length;
+	}
+
+	uint8_t byte()
+	{
+		astAssert(m_position < m_end, "Binary AST truncated.");
+		return static_cast<uint8_t>(m_data[m_position++]);
+	}
+
+	uint64_t fixed(size_t _size)
+	{
+		astAssert(_size <= m_end - m_position, "Binary AST truncated.");
+		uint64_t value = 0;
+		for (size_t i = 0; i < _size; ++i)
+			value |= uint64_t(static_cast<uint8_t>(m_data[m_position++])) << (8 * i);
+		return value;
+	}
+
+	uint64_t varint()
+	{
+		uint64_t value = 0;
+		for (unsigned shift = 0; ; shift += 7)
+		{
+			astAssert(shift < 64, "Invalid integer in binary AST.");
+			uint8_t next = byte();
+			value |= uint64_t(next & 0x7f) << shift;
+			if (!(next & 0x80))
+				return value;
+		}
+	}
+
+	bool atEnd() const { return m_position == m_end; }
+
+private:
+	string_view m_data;
+	uint64_t m_position = 0;
+	uint64_t m_end = 0;
+};
+
+}
+
+bool ASTBinary::isBinary(string_view _data)
+{
+	return _data.substr(0, signature.size()) == signature;
+}
+
+string ASTBinary::encode(map<string, Json::Value> const& _sources)
+{
+	Encoder encoder;
+	vector<uint64_t> names;
+	vector<string> bodies;
+	for (auto const& [name, ast]: _sources)
+	{
+		names.push_back(encoder.stringIndex(name));
+		encoder.encode(bodies.emplace_back(), ast);
+	}
+
+	vector<string const*> const& strings = encoder.strings();
+	uint64_t offset = headerSize + entrySize * _sources.size();
+	string out{signature};
+	writeFixed(out, formatVersion, 4);
+	writeFixed(out, _sources.size(), 4);
+	writeFixed(out, strings.size(), 8);
+	size_t stringTableField = out.size();
+	writeFixed(out, 0, 8);
+	for (size_t i = 0; i < bodies.size(); ++i)
+	{
+		writeFixed(out, names[i], 8);
+		writeFixed(out, offset, 8);
+		writeFixed(out, bodies[i].size(), 8);
+		offset += bodies[i].size();
+	}
+	for (string const& body: bodies)
+		out += body;
+
+	string stringTableOffset;
+	writeFixed(stringTableOffset, out.size(), 8);
+	out.replace(stringTableField, 8, stringTableOffset);
+
+	uint64_t stringOffset = 0;
+	writeFixed(out, stringOffset, 8);
+	for (string const* str: strings)
+	{
+		stringOffset += str->size();
+		writeFixed(out, stringOffset, 8);
+	}
+	for (string const* str: strings)
+		out += *str;
+	return out;
+}
+
+ASTBinary::ASTBinary(string_view _data):
+	m_data(_data)
+{
+	astAssert(isBinary(_data), "Data is not a binary AST.");
+	Reader header(_data, signature.size(), headerSize - signature.size());
+	uint64_t version = header.fixed(4);
+	astAssert(
+		version == formatVersion,
+		"Unsupported version " + to_string(version) + " of binary AST, expected " + to_string(formatVersion) + "."
+	);
+	uint64_t sourceCount = header.fixed(4);
+	m_stringCount = header.fixed(8);
+	m_stringOffsets = header.fixed(8);
+	astAssert(
+		m_stringOffsets <= _data.size() && m_stringCount < (_data.size() - m_stringOffsets) / 8,
+		"Binary AST truncated."
+	);
+	m_stringData = m_stringOffsets + (m_stringCount + 1) * 8;
+	astAssert(
+		Reader(_data, m_stringOffsets + m_stringCount * 8, 8).fixed(8) <= _data.size() - m_stringData,
+		"Binary AST truncated."
+	);
+
+	astAssert(sourceCount <= (_data.size() - headerSize) / entrySize, "Binary AST truncated.");
+	Reader index(_data, headerSize, sourceCount * entrySize);
+	for (uint64_t i = 0; i < sourceCount; ++i)
+	{
+		std::string name{text(index.fixed(8))};
+		Entry entry;
+		entry.offset = index.fixed(8);
+		entry.length = index.fixed(8);
+		astAssert(
+			entry.offset <= m_stringOffsets && entry.length <= m_stringOffsets - entry.offset,
+			"Invalid source offset in binary AST."
+		);
+		astAssert(m_sources.emplace(move(name), entry).second, "Duplicate source in binary AST.");
+	}
+}
+
+vector<string> ASTBinary::sourceNames() const
+{
+	vector<string> names;
+	for (auto const& source: m_sources)
+		names.push_back(source.first);
+	return names;
+}
+
+Json::Value ASTBinary::source(string const& _sourceName) const
+{
+	auto it = m_sources.find(_sourceName);
+	astAssert(it != m_sources.end(), "Source \"" + _sourceName + "\" not found in binary AST.");
+	return decode(it->second);
+}
+
+map<string, Json::Value> ASTBinary::sources() const
+{
+	map<string, Json::Value> sources;
+	for (auto const& [name, entry]: m_sources)
+		sources[name] = decode(entry);
+	return sources;
+}
+
+Json::Value ASTBinary::decode(Entry const& _entry) const
+{
+	Reader reader(m_data, _entry.offset, _entry.length);
+	vector<string> keys(m_stringCount);
+	vector<bool> keyDecoded(m_stringCount, false);
+
+	auto decodeValue = [&](auto&& _self, Json::Value& _value, size_t _depth) -> void
+	{
+		astAssert(_depth <= maxDepth, "Binary AST nested too deeply.");
+		switch (Tag(reader.byte()))
+		{
+		case Tag::Null:
+			_value = Json::nullValue;
+			break;
+		case Tag::False:
+			_value = false;
+			break;
+		case Tag::True:
+			_value = true;
+			break;
+		case Tag::Int:
+		{
+			uint64_t zigzag = reader.varint();
+			_value = Json::Int64(static_cast<int64_t>(zigzag >> 1) ^ -static_cast<int64_t>(zigzag & 1));
+			break;
+		}
+		case Tag::UInt:
+			_value = Json::UInt64(reader.varint());
+			break;
+		case Tag::Real:
+		{
+			uint64_t bits = reader.fixed(8);
+			double value = 0;
+			memcpy(&value, &bits, sizeof(value));
+			_value = value;
+			break;
+		}
+		case Tag::String:
+		{
+			string_view str = text(reader.varint());
+			_value = Json::Value(str.data(), str.data() + str.size());
+			break;
+		}
+		case Tag::Array:
+		{
+			uint64_t size = reader.varint();
+			_value = Json::arrayValue;
+			for (uint64_t i = 0; i < size; ++i)
+				_self(_self, _value.append(Json::nullValue), _depth + 1);
+			break;
+		}
+		case Tag::Object:
+		{
+			uint64_t size = reader.varint();
+			_value = Json::objectValue;
+			for (uint64_t i = 0; i < size; ++i)
+			{
+				uint64_t key = reader.varint();
+				string_view keyText = text(key);
+				if (!keyDecoded[key])
+				{
+					keys[key] = std::string(keyText);
+					keyDecoded[key] = true;
+				}
+				_self(_self, _value[keys[key]], _depth + 1);
+			}
+			break;
+		}
+		default:
+			astAssert(false, "Invalid value in binary AST.");
+		}
+	};
+
+	Json::Value ast;
+	decodeValue(decodeValue, ast, 0);
+	astAssert(reader.atEnd(), "Trailing data after source in binary AST.");
+	return ast;
+}
+
+string_view ASTBinary::text(uint64_t _index) const
+{
+	astAssert(_index < m_stringCount, "Invalid string in binary AST.");
+	Reader offsets(m_data, m_stringOffsets + _index * 8, 16);
+	uint64_t begin = offsets.fixed(8);
+	uint64_t end = offsets.fixed(8);
+	astAssert(begin <= end && end <= m_data.size() - m_stringData, "Invalid string in binary AST.");
+	return m_data.substr(m_stringData + begin, end - begin);
+}
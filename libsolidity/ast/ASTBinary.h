@@ -0,0 +1,85 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Compact binary format of the JSON AST.
+ */
+
+#pragma once
+
+#include <json/json.h>
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace solidity::frontend
+{
+
+/**
+ * Binary encoding of the ASTs of several sources in the JSON format of ASTJsonConverter,
+ * which can be read back without parsing JSON text.
+ *
+ * The data starts with a header and an index holding the name, offset and length of the
+ * encoded AST of each source, followed by the ASTs and a table of all strings (keys and
+ * values), which is shared by the sources and indexed by offsets as well. All fixed-size
+ * integers are little endian, so the data can be read in place, e.g. from a file mapped
+ * into memory, and single sources can be decoded without decoding the others.
+ */
+class ASTBinary
+{
+public:
+	/// Version of the format, increased with every incompatible change.
+	static uint32_t constexpr formatVersion = 1;
+
+	/// @returns true if @a _data starts with the signature of the binary format.
+	static bool isBinary(std::string_view _data);
+
+	/// @returns the binary encoding of the JSON ASTs @a _sources, keyed by source name.
+	static std::string encode(std::map<std::string, Json::Value> const& _sources);
+
+	/// Reads the header and index of @a _data, which has to outlive this object.
+	/// Throws InvalidAstError if the data is not in the binary format of this version.
+	explicit ASTBinary(std::string_view _data);
+
+	std::vector<std::string> sourceNames() const;
+	/// @returns the decoded JSON AST of the source @a _sourceName.
+	Json::Value source(std::string const& _sourceName) const;
+	/// @returns the decoded JSON ASTs of all sources.
+	std::map<std::string, Json::Value> sources() const;
+
+private:
+	struct Entry
+	{
+		uint64_t offset = 0;
+		uint64_t length = 0;
+	};
+
+	Json::Value decode(Entry const& _entry) const;
+	/// @returns the string @a _index of the string table.
+	std::string_view text(uint64_t _index) const;
+
+	std::string_view m_data;
+	std::map<std::string, Entry> m_sources;
+	uint64_t m_stringCount = 0;
+	uint64_t m_stringOffsets = 0;
+	uint64_t m_stringData = 0;
+};
+
+}
@@ -36,6 +36,7 @@
 #include <boost/algorithm/string/join.hpp>
 #include <boost/range/algorithm/sort.hpp>
 
+#include <string_view>
 #include <utility>
 #include <vector>
 #include <algorithm>
@@ -48,6 +49,20 @@ using namespace solidity::langutil;
 namespace
 {
 
+/// Key of the placeholders for definitions that are printed separately. It cannot clash with
+/// the keys of other members, which are names of attributes or identifiers.
+string const placeholderKey = "@";
+
+/// Writes @a _text to @a _stream and @a _indentation after each line break.
+void writeIndented(ostream& _stream, string_view _text, string const& _indentation)
+{
+	size_t position = 0;
+	if (!_indentation.empty())
+		for (size_t lineBreak; (lineBreak = _text.find('\n', position)) != string_view::npos; position = lineBreak + 1)
+			_stream << _text.substr(position, lineBreak + 1 - position) << _indentation;
+	_stream << _text.substr(position);
+}
+
 template<typename V, template<typename> typename C>
 void addIfSet(std::vector<pair<string, Json::Value>>& _attributes, string const& _name, C<V> const& _value)
 {
@@ -109,8 +124,8 @@ void ASTJsonConverter::setJsonNode(
 
 optional<size_t> ASTJsonConverter::sourceIndexFromLocation(SourceLocation const& _location) const
 {
-	if (_location.source && m_sourceIndices.count(_location.source->name()))
-		return m_sourceIndices.at(_location.source->name());
+	if (_location.sourceName && m_sourceIndices.count(*_location.sourceName))
+		return m_sourceIndices.at(*_location.sourceName);
 	else
 		return nullopt;
 }
@@ -183,9 +198,59 @@ Json::Value ASTJsonConverter::inlineAssemblyIdentifierToJson(pair<yul::Identifie
 	return tuple;
 }
 
-void ASTJsonConverter::print(ostream& _stream, ASTNode const& _node)
+void ASTJsonConverter::print(ostream& _stream, ASTNode const& _node, bool _compact)
+{
+	print(_stream, _node, _compact, "");
+}
+
+void ASTJsonConverter::print(ostream& _stream, ASTNode const& _node, bool _compact, string const& _indentation)
+{
+	vector<ASTPointer<ASTNode>> definitions;
+	if (auto const* sourceUnit = dynamic_cast<SourceUnit const*>(&_node))
+		definitions = sourceUnit->nodes();
+	else if (auto const* contract = dynamic_cast<ContractDefinition const*>(&_node))
+		definitions = contract->subNodes();
+
+	// The definitions are replaced by placeholders, which are non-empty objects like the
+	// definitions themselves and thus are laid out the same way. Each placeholder in the
+	// printed text is then replaced by the printed definition.
+	m_definitionPlaceholders = !definitions.empty();
+	Json::Value json = toJson(_node);
+	m_definitionPlaceholders = false;
+	string const text = _compact ? util::jsonCompactPrint(json) : util::jsonPrettyPrint(json);
+	json = Json::Value();
+
+	string const marker = "\"" + placeholderKey + "\":";
+	size_t position = 0;
+	for (ASTPointer<ASTNode> const& definition: definitions)
+	{
+		solAssert(definition, "");
+		size_t const markerPosition = text.find(marker, position);
+		solAssert(markerPosition != string::npos, "Placeholder not found.");
+		size_t const begin = text.rfind('{', markerPosition);
+		size_t const end = text.find('}', markerPosition) + 1;
+		solAssert(begin != string::npos && begin >= position && end != 0, "");
+
+		string definitionIndentation = _indentation;
+		size_t const lineStart = text.rfind('\n', begin);
+		if (lineStart != string::npos && lineStart >= position)
+			definitionIndentation += text.substr(lineStart + 1, begin - lineStart - 1);
+
+		writeIndented(_stream, string_view(text).substr(position, begin - position), _indentation);
+		print(_stream, *definition, _compact, definitionIndentation);
+		position = end;
+	}
+	writeIndented(_stream, string_view(text).substr(position), _indentation);
+}
+
+Json::Value ASTJsonConverter::definitionPlaceholders(size_t _count)
 {
-	_stream << util::jsonPrettyPrint(toJson(_node));
+	Json::Value placeholder(Json::objectValue);
+	placeholder[placeholderKey] = 0;
+	Json::Value placeholders(Json::arrayValue);
+	for (size_t i = 0; i < _count; ++i)
+		placeholders.append(placeholder);
+	return placeholders;
 }
 
 Json::Value ASTJsonConverter::toJson(ASTNode const& _node)
@@ -196,9 +261,10 @@ Json::Value ASTJsonConverter::toJson(ASTNode const& _node)
 
 bool ASTJsonConverter::visit(SourceUnit const& _node)
 {
+	bool const placeholders = std::exchange(m_definitionPlaceholders, false);
 	std::vector<pair<string, Json::Value>> attributes = {
 		make_pair("license", _node.licenseString() ? Json::Value(*_node.licenseString()) : Json::nullValue),
-		make_pair("nodes", toJson(_node.nodes()))
+		make_pair("nodes", placeholders ? definitionPlaceholders(_node.nodes().size()) : toJson(_node.nodes()))
 	};
 
 	if (_node.annotation().exportedSymbols.set())
@@ -262,6 +328,7 @@ bool ASTJsonConverter::visit(ImportDirective const& _node)
 
 bool ASTJsonConverter::visit(ContractDefinition const& _node)
 {
+	bool const placeholders = std::exchange(m_definitionPlaceholders, false);
 	std::vector<pair<string, Json::Value>> attributes = {
 		make_pair("name", _node.name()),
 		make_pair("nameLocation", sourceLocationToString(_node.nameLocation())),
@@ -270,7 +337,7 @@ bool ASTJsonConverter::visit(ContractDefinition const& _node)
 		make_pair("abstract", _node.abstract()),
 		make_pair("baseContracts", toJson(_node.baseContracts())),
 		make_pair("contractDependencies", getContainerIds(_node.annotation().contractDependencies, true)),
-		make_pair("nodes", toJson(_node.subNodes())),
+		make_pair("nodes", placeholders ? definitionPlaceholders(_node.subNodes().size()) : toJson(_node.subNodes())),
 		make_pair("scope", idOrNull(_node.scope()))
 	};
 
@@ -57,8 +57,11 @@ public:
 		CompilerStack::State _stackState,
 		std::map<std::string, unsigned> _sourceIndices = std::map<std::string, unsigned>()
 	);
-	/// Output the json representation of the AST to _stream.
-	void print(std::ostream& _stream, ASTNode const& _node);
+	/// Output the json representation of the AST to _stream, formatted like jsonPrettyPrint or,
+	/// if @a _compact is true, like jsonCompactPrint.
+	/// The definitions inside source units and contracts are converted and printed one at a time,
+	/// so that the JSON tree of the whole AST is never built.
+	void print(std::ostream& _stream, ASTNode const& _node, bool _compact = false);
 	Json::Value toJson(ASTNode const& _node);
 	template <class T>
 	Json::Value toJson(std::vector<ASTPointer<T>> const& _nodes)
@@ -127,6 +130,10 @@ public:
 	void endVisit(EventDefinition const&) override;
 
 private:
+	/// Prints @a _node and adds @a _indentation after each line break.
+	void print(std::ostream& _stream, ASTNode const& _node, bool _compact, std::string const& _indentation);
+	/// @returns @a _count placeholders for definitions that are printed separately.
+	static Json::Value definitionPlaceholders(size_t _count);
 	void setJsonNode(
 		ASTNode const& _node,
 		std::string const& _nodeName,
@@ -193,6 +200,8 @@ private:
 
 	CompilerStack::State m_stackState = CompilerStack::State::Empty; ///< Used to only access information that already exists
 	bool m_inEvent = false; ///< whether we are currently inside an event or not
+	/// Whether the definitions of the next source unit or contract are printed separately.
+	bool m_definitionPlaceholders = false;
 	Json::Value m_currentValue;
 	std::map<std::string, unsigned> m_sourceIndices;
 };
@@ -0,0 +1,100 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Lookup of AST nodes by their IDs.
+ */
+
+#include <libsolidity/ast/ASTNodeIndex.h>
+
+#include <libsolidity/ast/AST.h>
+#include <libsolidity/ast/ASTVisitor.h>
+
+#include <liblangutil/Exceptions.h>
+
+#include <limits>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::frontend;
+
+namespace
+{
+
+class NodeCollector: private ASTConstVisitor
+{
+public:
+	explicit NodeCollector(vector<ASTNode const*>& _nodes): m_nodes(_nodes) {}
+	void collect(ASTNode const& _root) { _root.accept(*this); }
+
+private:
+	bool visitNode(ASTNode const& _node) override
+	{
+		m_nodes.push_back(&_node);
+		return true;
+	}
+
+	vector<ASTNode const*>& m_nodes;
+};
+
+}
+
+ASTNodeIndex::ASTNodeIndex(vector<SourceUnit const*> const& _sourceUnits)
+{
+	vector<ASTNode const*> nodes;
+	NodeCollector collector{nodes};
+	for (SourceUnit const* sourceUnit: _sourceUnits)
+		collector.collect(*sourceUnit);
+	if (nodes.empty())
+		return;
+
+	int64_t firstID = numeric_limits<int64_t>::max();
+	int64_t lastID = numeric_limits<int64_t>::min();
+	for (ASTNode const* node: nodes)
+	{
+		firstID = min(firstID, node->id());
+		lastID = max(lastID, node->id());
+	}
+
+	// Allow for the gaps left by sources that are not part of the index.
+	m_sparse = static_cast<uint64_t>(lastID) - static_cast<uint64_t>(firstID) >= 4 * nodes.size() + 1024;
+	if (m_sparse)
+		for (ASTNode const* node: nodes)
+			solAssert(m_sparseNodes.emplace(node->id(), node).second, "Duplicate AST node ID.");
+	else
+	{
+		m_firstID = firstID;
+		m_nodes.resize(static_cast<size_t>(lastID - firstID) + 1, nullptr);
+		for (ASTNode const* node: nodes)
+		{
+			ASTNode const*& slot = m_nodes[static_cast<size_t>(node->id() - firstID)];
+			solAssert(!slot, "Duplicate AST node ID.");
+			slot = node;
+		}
+	}
+}
+
+void ASTNodeIndex::remove(SourceUnit const& _sourceUnit)
+{
+	vector<ASTNode const*> nodes;
+	NodeCollector{nodes}.collect(_sourceUnit);
+	for (ASTNode const* node: nodes)
+		if (m_sparse)
+			m_sparseNodes.erase(node->id());
+		else if (this->node(node->id()) == node)
+			m_nodes[static_cast<size_t>(node->id() - m_firstID)] = nullptr;
+}
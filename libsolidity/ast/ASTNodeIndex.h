@@ -0,0 +1,73 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Lookup of AST nodes by their IDs.
+ */
+
+#pragma once
+
+#include <libsolidity/ast/ASTForward.h>
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace solidity::frontend
+{
+
+/**
+ * Maps the IDs of all nodes of a set of ASTs to the nodes.
+ *
+ * The parser assigns consecutive IDs, so the nodes are stored in a vector indexed by
+ * their IDs. Only if the IDs are spread out too far, e.g. in ASTs imported from JSON,
+ * a hash map is used instead.
+ */
+class ASTNodeIndex
+{
+public:
+	ASTNodeIndex() = default;
+	/// Indexes all nodes of @a _sourceUnits. Their IDs have to be unique.
+	explicit ASTNodeIndex(std::vector<SourceUnit const*> const& _sourceUnits);
+
+	/// @returns the node with ID @a _id or nullptr if there is none.
+	ASTNode const* node(int64_t _id) const
+	{
+		if (!m_sparse)
+		{
+			if (_id < m_firstID || _id - m_firstID >= static_cast<int64_t>(m_nodes.size()))
+				return nullptr;
+			return m_nodes[static_cast<size_t>(_id - m_firstID)];
+		}
+		auto it = m_sparseNodes.find(_id);
+		return it == m_sparseNodes.end() ? nullptr : it->second;
+	}
+	/// @returns the node with ID @a _id if it is of type @a T, otherwise nullptr.
+	template <class T>
+	T const* node(int64_t _id) const { return dynamic_cast<T const*>(node(_id)); }
+
+	/// Removes all nodes of @a _sourceUnit, e.g. before it is freed.
+	void remove(SourceUnit const& _sourceUnit);
+
+private:
+	bool m_sparse = false;
+	int64_t m_firstID = 0;
+	std::vector<ASTNode const*> m_nodes;
+	std::unordered_map<int64_t, ASTNode const*> m_sparseNodes;
+};
+
+}
@@ -0,0 +1,182 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * AST visitor that runs several visitors in a single traversal.
+ */
+
+#include <libsolidity/ast/FusedASTConstVisitor.h>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::frontend;
+
+FusedASTConstVisitor::FusedASTConstVisitor(vector<ASTConstVisitor*> const& _visitors)
+{
+	for (ASTConstVisitor* visitor: _visitors)
+		m_visitors.push_back(Visitor{visitor, nullptr, nullptr});
+}
+
+template <class T>
+bool FusedASTConstVisitor::fusedVisit(T const& _node)
+{
+	bool visitChildren = false;
+	for (Visitor& visitor: m_visitors)
+		if (visitor.active())
+		{
+			try
+			{
+				if (visitor.visitor->visit(_node))
+					visitChildren = true;
+				else
+					visitor.skippedNode = &_node;
+			}
+			catch (...)
+			{
+				visitor.exception = current_exception();
+			}
+		}
+	return visitChildren;
+}
+
+template <class T>
+void FusedASTConstVisitor::fusedEndVisit(T const& _node)
+{
+	for (Visitor& visitor: m_visitors)
+	{
+		// endVisit is called even if visit returned false.
+		if (visitor.skippedNode == &_node)
+			visitor.skippedNode = nullptr;
+		if (visitor.active())
+		{
+			try
+			{
+				visitor.visitor->endVisit(_node);
+			}
+			catch (...)
+			{
+				visitor.exception = current_exception();
+			}
+		}
+	}
+}
+
+bool FusedASTConstVisitor::visit(SourceUnit const& _node) { return fusedVisit(_node); }
+bool FusedASTConstVisitor::visit(PragmaDirective const& _node) { return fusedVisit(_node); }
+bool FusedASTConstVisitor::visit(ImportDirective const& _node) { return fusedVisit(_node); }
+bool FusedASTConstVisitor::visit(ContractDefinition const& _node) { return fusedVisit(_node); }
+bool FusedASTConstVisitor::visit(IdentifierPath const& _node) { return fusedVisit(_node); }
+bool FusedASTConstVisitor::visit(InheritanceSpecifier const& _node) { return fusedVisit(_node); }
+bool FusedASTConstVisitor::visit(StructDefinition const& _node) { return fusedVisit(_node); }
+bool FusedASTConstVisitor::visit(UsingForDirective const& _node) { return fusedVisit(_node); }
+bool FusedASTConstVisitor::visit(EnumDefinition const& _node) { return fusedVisit(_node); }
+bool FusedASTConstVisitor::visit(EnumValue const& _node) { return fusedVisit(_node); }
+bool FusedASTConstVisitor::visit(ParameterList const& _node) { return fusedVisit(_node); }
+bool FusedASTConstVisitor::visit(OverrideSpecifier const& _node) { return fusedVisit(_node); }
+bool FusedASTConstVisitor::visit(FunctionDefinition const& _node) { return fusedVisit(_node); }
+bool FusedASTConstVisitor::visit(VariableDeclaration const& _node) { return fusedVisit(_node); }
+bool FusedASTConstVisitor::visit(ModifierDefinition const& _node) { return fusedVisit(_node); }
+bool FusedASTConstVisitor::visit(ModifierInvocation const& _node) { return fusedVisit(_node); }
+bool FusedASTConstVisitor::visit(EventDefinition const& _node) { return fusedVisit(_node); }
+bool FusedASTConstVisitor::visit(ElementaryTypeName const& _node) { return fusedVisit(_node); }
+bool FusedASTConstVisitor::visit(UserDefinedTypeName const& _node) { return fusedVisit(_node); }
+bool FusedASTConstVisitor::visit(FunctionTypeName const& _node) { return fusedVisit(_node); }
+bool FusedASTConstVisitor::visit(Mapping const& _node) { return fusedVisit(_node); }
+bool FusedASTConstVisitor::visit(ArrayTypeName const& _node) { return fusedVisit(_node); }
+bool FusedASTConstVisitor::visit(Block const& _node) { return fusedVisit(_node); }
+bool FusedASTConstVisitor::visit(PlaceholderStatement const& _node) { return fusedVisit(_node); }
+bool FusedASTConstVisitor::visit(IfStatement const& _node) { return fusedVisit(_node); }
+bool FusedASTConstVisitor::visit(TryCatchClause const& _node) { return fusedVisit(_node); }
+bool FusedASTConstVisitor::visit(TryStatement const& _node) { return fusedVisit(_node); }
+bool FusedASTConstVisitor::visit(WhileStatement const& _node) { return fusedVisit(_node); }
+bool FusedASTConstVisitor::visit(ForStatement const& _node) { return fusedVisit(_node); }
+bool FusedASTConstVisitor::visit(Continue const& _node) { return fusedVisit(_node); }
+bool FusedASTConstVisitor::visit(InlineAssembly const& _node) { return fusedVisit(_node); }
+bool FusedASTConstVisitor::visit(Break const& _node) { return fusedVisit(_node); }
+bool FusedASTConstVisitor::visit(Return const& _node) { return fusedVisit(_node); }
+bool FusedASTConstVisitor::visit(Throw const& _node) { return fusedVisit(_node); }
+bool FusedASTConstVisitor::visit(EmitStatement const& _node) { return fusedVisit(_node); }
+bool FusedASTConstVisitor::visit(VariableDeclarationStatement const& _node) { return fusedVisit(_node); }
+bool FusedASTConstVisitor::visit(ExpressionStatement const& _node) { return fusedVisit(_node); }
+bool FusedASTConstVisitor::visit(Conditional const& _node) { return fusedVisit(_node); }
+bool FusedASTConstVisitor::visit(Assignment const& _node) { return fusedVisit(_node); }
+bool FusedASTConstVisitor::visit(TupleExpression const& _node) { return fusedVisit(_node); }
+bool FusedASTConstVisitor::visit(UnaryOperation const& _node) { return fusedVisit(_node); }
+bool FusedASTConstVisitor::visit(BinaryOperation const& _node) { return fusedVisit(_node); }
+bool FusedASTConstVisitor::visit(FunctionCall const& _node) { return fusedVisit(_node); }
+bool FusedASTConstVisitor::visit(FunctionCallOptions const& _node) { return fusedVisit(_node); }
+bool FusedASTConstVisitor::visit(NewExpression const& _node) { return fusedVisit(_node); }
+bool FusedASTConstVisitor::visit(MemberAccess const& _node) { return fusedVisit(_node); }
+bool FusedASTConstVisitor::visit(IndexAccess const& _node) { return fusedVisit(_node); }
+bool FusedASTConstVisitor::visit(IndexRangeAccess const& _node) { return fusedVisit(_node); }
+bool FusedASTConstVisitor::visit(Identifier const& _node) { return fusedVisit(_node); }
+bool FusedASTConstVisitor::visit(ElementaryTypeNameExpression const& _node) { return fusedVisit(_node); }
+bool FusedASTConstVisitor::visit(Literal const& _node) { return fusedVisit(_node); }
+bool FusedASTConstVisitor::visit(StructuredDocumentation const& _node) { return fusedVisit(_node); }
+
+void FusedASTConstVisitor::endVisit(SourceUnit const& _node) { fusedEndVisit(_node); }
+void FusedASTConstVisitor::endVisit(PragmaDirective const& _node) { fusedEndVisit(_node); }
+void FusedASTConstVisitor::endVisit(ImportDirective const& _node) { fusedEndVisit(_node); }
+void FusedASTConstVisitor::endVisit(ContractDefinition const& _node) { fusedEndVisit(_node); }
+void FusedASTConstVisitor::endVisit(IdentifierPath const& _node) { fusedEndVisit(_node); }
+void FusedASTConstVisitor::endVisit(InheritanceSpecifier const& _node) { fusedEndVisit(_node); }
+void FusedASTConstVisitor::endVisit(StructDefinition const& _node) { fusedEndVisit(_node); }
+void FusedASTConstVisitor::endVisit(UsingForDirective const& _node) { fusedEndVisit(_node); }
+void FusedASTConstVisitor::endVisit(EnumDefinition const& _node) { fusedEndVisit(_node); }
+void FusedASTConstVisitor::endVisit(EnumValue const& _node) { fusedEndVisit(_node); }
+void FusedASTConstVisitor::endVisit(ParameterList const& _node) { fusedEndVisit(_node); }
+void FusedASTConstVisitor::endVisit(OverrideSpecifier const& _node) { fusedEndVisit(_node); }
+void FusedASTConstVisitor::endVisit(FunctionDefinition const& _node) { fusedEndVisit(_node); }
+void FusedASTConstVisitor::endVisit(VariableDeclaration const& _node) { fusedEndVisit(_node); }
+void FusedASTConstVisitor::endVisit(ModifierDefinition const& _node) { fusedEndVisit(_node); }
+void FusedASTConstVisitor::endVisit(ModifierInvocation const& _node) { fusedEndVisit(_node); }
+void FusedASTConstVisitor::endVisit(EventDefinition const& _node) { fusedEndVisit(_node); }
+void FusedASTConstVisitor::endVisit(ElementaryTypeName const& _node) { fusedEndVisit(_node); }
+void FusedASTConstVisitor::endVisit(UserDefinedTypeName const& _node) { fusedEndVisit(_node); }
+void FusedASTConstVisitor::endVisit(FunctionTypeName const& _node) { fusedEndVisit(_node); }
+void FusedASTConstVisitor::endVisit(Mapping const& _node) { fusedEndVisit(_node); }
+void FusedASTConstVisitor::endVisit(ArrayTypeName const& _node) { fusedEndVisit(_node); }
+void FusedASTConstVisitor::endVisit(Block const& _node) { fusedEndVisit(_node); }
+void FusedASTConstVisitor::endVisit(PlaceholderStatement const& _node) { fusedEndVisit(_node); }
+void FusedASTConstVisitor::endVisit(IfStatement const& _node) { fusedEndVisit(_node); }
+void FusedASTConstVisitor::endVisit(TryCatchClause const& _node) { fusedEndVisit(_node); }
+void FusedASTConstVisitor::endVisit(TryStatement const& _node) { fusedEndVisit(_node); }
+void FusedASTConstVisitor::endVisit(WhileStatement const& _node) { fusedEndVisit(_node); }
+void FusedASTConstVisitor::endVisit(ForStatement const& _node) { fusedEndVisit(_node); }
+void FusedASTConstVisitor::endVisit(Continue const& _node) { fusedEndVisit(_node); }
+void FusedASTConstVisitor::endVisit(InlineAssembly const& _node) { fusedEndVisit(_node); }
+void FusedASTConstVisitor::endVisit(Break const& _node) { fusedEndVisit(_node); }
+void FusedASTConstVisitor::endVisit(Return const& _node) { fusedEndVisit(_node); }
+void FusedASTConstVisitor::endVisit(Throw const& _node) { fusedEndVisit(_node); }
+void FusedASTConstVisitor::endVisit(EmitStatement const& _node) { fusedEndVisit(_node); }
+void FusedASTConstVisitor::endVisit(VariableDeclarationStatement const& _node) { fusedEndVisit(_node); }
+void FusedASTConstVisitor::endVisit(ExpressionStatement const& _node) { fusedEndVisit(_node); }
+void FusedASTConstVisitor::endVisit(Conditional const& _node) { fusedEndVisit(_node); }
+void FusedASTConstVisitor::endVisit(Assignment const& _node) { fusedEndVisit(_node); }
+void FusedASTConstVisitor::endVisit(TupleExpression const& _node) { fusedEndVisit(_node); }
+void FusedASTConstVisitor::endVisit(UnaryOperation const& _node) { fusedEndVisit(_node); }
+void FusedASTConstVisitor::endVisit(BinaryOperation const& _node) { fusedEndVisit(_node); }
+void FusedASTConstVisitor::endVisit(FunctionCall const& _node) { fusedEndVisit(_node); }
+void FusedASTConstVisitor::endVisit(FunctionCallOptions const& _node) { fusedEndVisit(_node); }
+void FusedASTConstVisitor::endVisit(NewExpression const& _node) { fusedEndVisit(_node); }
+void FusedASTConstVisitor::endVisit(MemberAccess const& _node) { fusedEndVisit(_node); }
+void FusedASTConstVisitor::endVisit(IndexAccess const& _node) { fusedEndVisit(_node); }
+void FusedASTConstVisitor::endVisit(IndexRangeAccess const& _node) { fusedEndVisit(_node); }
+void FusedASTConstVisitor::endVisit(Identifier const& _node) { fusedEndVisit(_node); }
+void FusedASTConstVisitor::endVisit(ElementaryTypeNameExpression const& _node) { fusedEndVisit(_node); }
+void FusedASTConstVisitor::endVisit(Literal const& _node) { fusedEndVisit(_node); }
+void FusedASTConstVisitor::endVisit(StructuredDocumentation const& _node) { fusedEndVisit(_node); }
@@ -0,0 +1,177 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * AST visitor that runs several visitors in a single traversal.
+ */
+
+#pragma once
+
+#include <libsolidity/ast/ASTVisitor.h>
+
+#include <exception>
+#include <vector>
+
+namespace solidity::frontend
+{
+
+/**
+ * Runs several independent visitors in a single traversal of the AST. Every visitor sees
+ * exactly the calls to visit and endVisit it would see if it traversed the AST on its own:
+ * The children of a node are skipped for the visitors whose visit function returned false
+ * for it, and they are only skipped entirely if all visitors returned false.
+ *
+ * A visitor that throws is not called anymore for the rest of the traversal, while the others
+ * continue. The exception is stored and can be queried via @a exception.
+ */
+class FusedASTConstVisitor: public ASTConstVisitor
+{
+public:
+	explicit FusedASTConstVisitor(std::vector<ASTConstVisitor*> const& _visitors);
+
+	/// Visits the subtree rooted at @a _node with all visitors that did not throw so far.
+	void run(ASTNode const& _node) { _node.accept(*this); }
+
+	/// @returns the exception thrown by the visitor at position @a _index, if any.
+	std::exception_ptr exception(size_t _index) const { return m_visitors.at(_index).exception; }
+
+	bool visit(SourceUnit const& _node) override;
+	bool visit(PragmaDirective const& _node) override;
+	bool visit(ImportDirective const& _node) override;
+	bool visit(ContractDefinition const& _node) override;
+	bool visit(IdentifierPath const& _node) override;
+	bool visit(InheritanceSpecifier const& _node) override;
+	bool visit(StructDefinition const& _node) override;
+	bool visit(UsingForDirective const& _node) override;
+	bool visit(EnumDefinition const& _node) override;
+	bool visit(EnumValue const& _node) override;
+	bool visit(ParameterList const& _node) override;
+	bool visit(OverrideSpecifier const& _node) override;
+	bool visit(FunctionDefinition const& _node) override;
+	bool visit(VariableDeclaration const& _node) override;
+	bool visit(ModifierDefinition const& _node) override;
+	bool visit(ModifierInvocation const& _node) override;
+	bool visit(EventDefinition const& _node) override;
+	bool visit(ElementaryTypeName const& _node) override;
+	bool visit(UserDefinedTypeName const& _node) override;
+	bool visit(FunctionTypeName const& _node) override;
+	bool visit(Mapping const& _node) override;
+	bool visit(ArrayTypeName const& _node) override;
+	bool visit(Block const& _node) override;
+	bool visit(PlaceholderStatement const& _node) override;
+	bool visit(IfStatement const& _node) override;
+	bool visit(TryCatchClause const& _node) override;
+	bool visit(TryStatement const& _node) override;
+	bool visit(WhileStatement const& _node) override;
+	bool visit(ForStatement const& _node) override;
+	bool visit(Continue const& _node) override;
+	bool visit(InlineAssembly const& _node) override;
+	bool visit(Break const& _node) override;
+	bool visit(Return const& _node) override;
+	bool visit(Throw const& _node) override;
+	bool visit(EmitStatement const& _node) override;
+	bool visit(VariableDeclarationStatement const& _node) override;
+	bool visit(ExpressionStatement const& _node) override;
+	bool visit(Conditional const& _node) override;
+	bool visit(Assignment const& _node) override;
+	bool visit(TupleExpression const& _node) override;
+	bool visit(UnaryOperation const& _node) override;
+	bool visit(BinaryOperation const& _node) override;
+	bool visit(FunctionCall const& _node) override;
+	bool visit(FunctionCallOptions const& _node) override;
+	bool visit(NewExpression const& _node) override;
+	bool visit(MemberAccess const& _node) override;
+	bool visit(IndexAccess const& _node) override;
+	bool visit(IndexRangeAccess const& _node) override;
+	bool visit(Identifier const& _node) override;
+	bool visit(ElementaryTypeNameExpression const& _node) override;
+	bool visit(Literal const& _node) override;
+	bool visit(StructuredDocumentation const& _node) override;
+
+	void endVisit(SourceUnit const& _node) override;
+	void endVisit(PragmaDirective const& _node) override;
+	void endVisit(ImportDirective const& _node) override;
+	void endVisit(ContractDefinition const& _node) override;
+	void endVisit(IdentifierPath const& _node) override;
+	void endVisit(InheritanceSpecifier const& _node) override;
+	void endVisit(StructDefinition const& _node) override;
+	void endVisit(UsingForDirective const& _node) override;
+	void endVisit(EnumDefinition const& _node) override;
+	void endVisit(EnumValue const& _node) override;
+	void endVisit(ParameterList const& _node) override;
+	void endVisit(OverrideSpecifier const& _node) override;
+	void endVisit(FunctionDefinition const& _node) override;
+	void endVisit(VariableDeclaration const& _node) override;
+	void endVisit(ModifierDefinition const& _node) override;
+	void endVisit(ModifierInvocation const& _node) override;
+	void endVisit(EventDefinition const& _node) override;
+	void endVisit(ElementaryTypeName const& _node) override;
+	void endVisit(UserDefinedTypeName const& _node) override;
+	void endVisit(FunctionTypeName const& _node) override;
+	void endVisit(Mapping const& _node) override;
+	void endVisit(ArrayTypeName const& _node) override;
+	void endVisit(Block const& _node) override;
+	void endVisit(PlaceholderStatement const& _node) override;
+	void endVisit(IfStatement const& _node) override;
+	void endVisit(TryCatchClause const& _node) override;
+	void endVisit(TryStatement const& _node) override;
+	void endVisit(WhileStatement const& _node) override;
+	void endVisit(ForStatement const& _node) override;
+	void endVisit(Continue const& _node) override;
+	void endVisit(InlineAssembly const& _node) override;
+	void endVisit(Break const& _node) override;
+	void endVisit(Return const& _node) override;
+	void endVisit(Throw const& _node) override;
+	void endVisit(EmitStatement const& _node) override;
+	void endVisit(VariableDeclarationStatement const& _node) override;
+	void endVisit(ExpressionStatement const& _node) override;
+	void endVisit(Conditional const& _node) override;
+	void endVisit(Assignment const& _node) override;
+	void endVisit(TupleExpression const& _node) override;
+	void endVisit(UnaryOperation const& _node) override;
+	void endVisit(BinaryOperation const& _node) override;
+	void endVisit(FunctionCall const& _node) override;
+	void endVisit(FunctionCallOptions const& _node) override;
+	void endVisit(NewExpression const& _node) override;
+	void endVisit(MemberAccess const& _node) override;
+	void endVisit(IndexAccess const& _node) override;
+	void endVisit(IndexRangeAccess const& _node) override;
+	void endVisit(Identifier const& _node) override;
+	void endVisit(ElementaryTypeNameExpression const& _node) override;
+	void endVisit(Literal const& _node) override;
+	void endVisit(StructuredDocumentation const& _node) override;
+
+private:
+	struct Visitor
+	{
+		ASTConstVisitor* visitor = nullptr;
+		/// The node whose children the visitor does not want to visit, if we are inside of it.
+		ASTNode const* skippedNode = nullptr;
+		std::exception_ptr exception;
+
+		bool active() const { return !skippedNode && !exception; }
+	};
+
+	template <class T>
+	bool fusedVisit(T const& _node);
+	template <class T>
+	void fusedEndVisit(T const& _node);
+
+	std::vector<Visitor> m_visitors;
+};
+
+}
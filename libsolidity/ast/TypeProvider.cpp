@@ -18,7 +18,10 @@
 
 #include <libsolidity/ast/AST.h>
 #include <libsolidity/ast/TypeProvider.h>
+#include <libsolutil/CompilationStatistics.h>
+
 #include <boost/algorithm/string.hpp>
+#include <boost/functional/hash.hpp>
 #include <boost/algorithm/string/split.hpp>
 
 using namespace std;
@@ -26,182 +29,211 @@ using namespace solidity;
 using namespace solidity::frontend;
 using namespace solidity::util;
 
-BoolType const TypeProvider::m_boolean{};
-InaccessibleDynamicType const TypeProvider::m_inaccessibleDynamic{};
-
-/// The string and bytes unique_ptrs are initialized when they are first used because
-/// they rely on `byte` being available which we cannot guarantee in the static init context.
-unique_ptr<ArrayType> TypeProvider::m_bytesStorage;
-unique_ptr<ArrayType> TypeProvider::m_bytesMemory;
-unique_ptr<ArrayType> TypeProvider::m_bytesCalldata;
-unique_ptr<ArrayType> TypeProvider::m_stringStorage;
-unique_ptr<ArrayType> TypeProvider::m_stringMemory;
-
-TupleType const TypeProvider::m_emptyTuple{};
-AddressType const TypeProvider::m_payableAddress{StateMutability::Payable};
-AddressType const TypeProvider::m_address{StateMutability::NonPayable};
-
-array<unique_ptr<IntegerType>, 32> const TypeProvider::m_intM{{
-	{make_unique<IntegerType>(8 * 1, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(8 * 2, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(8 * 3, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(8 * 4, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(8 * 5, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(8 * 6, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(8 * 7, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(8 * 8, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(8 * 9, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(8 * 10, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(8 * 11, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(8 * 12, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(8 * 13, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(8 * 14, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(8 * 15, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(8 * 16, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(8 * 17, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(8 * 18, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(8 * 19, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(8 * 20, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(8 * 21, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(8 * 22, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(8 * 23, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(8 * 24, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(8 * 25, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(8 * 26, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(8 * 27, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(8 * 28, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(8 * 29, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(8 * 30, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(8 * 31, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(8 * 32, IntegerType::Modifier::Signed)}
-}};
-
-array<unique_ptr<IntegerType>, 32> const TypeProvider::m_uintM{{
-	{make_unique<IntegerType>(8 * 1, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(8 * 2, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(8 * 3, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(8 * 4, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(8 * 5, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(8 * 6, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(8 * 7, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(8 * 8, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(8 * 9, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(8 * 10, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(8 * 11, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(8 * 12, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(8 * 13, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(8 * 14, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(8 * 15, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(8 * 16, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(8 * 17, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(8 * 18, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(8 * 19, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(8 * 20, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(8 * 21, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(8 * 22, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(8 * 23, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(8 * 24, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(8 * 25, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(8 * 26, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(8 * 27, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(8 * 28, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(8 * 29, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(8 * 30, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(8 * 31, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(8 * 32, IntegerType::Modifier::Unsigned)}
-}};
-
-array<unique_ptr<FixedBytesType>, 32> const TypeProvider::m_bytesM{{
-	{make_unique<FixedBytesType>(1)},
-	{make_unique<FixedBytesType>(2)},
-	{make_unique<FixedBytesType>(3)},
-	{make_unique<FixedBytesType>(4)},
-	{make_unique<FixedBytesType>(5)},
-	{make_unique<FixedBytesType>(6)},
-	{make_unique<FixedBytesType>(7)},
-	{make_unique<FixedBytesType>(8)},
-	{make_unique<FixedBytesType>(9)},
-	{make_unique<FixedBytesType>(10)},
-	{make_unique<FixedBytesType>(11)},
-	{make_unique<FixedBytesType>(12)},
-	{make_unique<FixedBytesType>(13)},
-	{make_unique<FixedBytesType>(14)},
-	{make_unique<FixedBytesType>(15)},
-	{make_unique<FixedBytesType>(16)},
-	{make_unique<FixedBytesType>(17)},
-	{make_unique<FixedBytesType>(18)},
-	{make_unique<FixedBytesType>(19)},
-	{make_unique<FixedBytesType>(20)},
-	{make_unique<FixedBytesType>(21)},
-	{make_unique<FixedBytesType>(22)},
-	{make_unique<FixedBytesType>(23)},
-	{make_unique<FixedBytesType>(24)},
-	{make_unique<FixedBytesType>(25)},
-	{make_unique<FixedBytesType>(26)},
-	{make_unique<FixedBytesType>(27)},
-	{make_unique<FixedBytesType>(28)},
-	{make_unique<FixedBytesType>(29)},
-	{make_unique<FixedBytesType>(30)},
-	{make_unique<FixedBytesType>(31)},
-	{make_unique<FixedBytesType>(32)}
-}};
-
-array<unique_ptr<MagicType>, 4> const TypeProvider::m_magics{{
-	{make_unique<MagicType>(MagicType::Kind::Block)},
-	{make_unique<MagicType>(MagicType::Kind::Message)},
-	{make_unique<MagicType>(MagicType::Kind::Transaction)},
-	{make_unique<MagicType>(MagicType::Kind::ABI)}
-	// MetaType is stored separately
-}};
+namespace
+{
 
-inline void clearCache(Type const& type)
+thread_local TypeProvider* currentProvider = nullptr;
+
+/// Builds the key under which a type is stored from the values that determine it.
+class TypeKey
 {
-	type.clearCache();
+public:
+	/// @param _variant distinguishes the different ways of creating types of the same category.
+	explicit TypeKey(Type::Category _category, char _variant = 0)
+	{
+		*this << _category;
+		m_key.push_back(_variant);
+	}
+
+	template <typename T>
+	TypeKey& operator<<(T const& _value)
+	{
+		if constexpr (is_pointer_v<T>)
+			append(reinterpret_cast<uintptr_t>(_value));
+		else if constexpr (is_enum_v<T> || is_integral_v<T>)
+			append(static_cast<uint64_t>(_value));
+		else if constexpr (is_same_v<T, string>)
+		{
+			append(_value.size());
+			m_key += _value;
+		}
+		else if constexpr (is_same_v<T, u256>)
+			*this << _value.str();
+		else if constexpr (is_same_v<T, rational>)
+			*this << _value.numerator().str() << _value.denominator().str();
+		else
+		{
+			append(_value.size());
+			for (auto const& element: _value)
+				*this << element;
+		}
+		return *this;
+	}
+
+	string const& str() const { return m_key; }
+
+private:
+	template <typename T>
+	void append(T _value)
+	{
+		m_key.append(reinterpret_cast<char const*>(&_value), sizeof(_value));
+	}
+
+	string m_key;
+};
+
+/// @returns the key of an array or struct type, which only depends on the type itself
+/// and not on how it was created.
+string referenceTypeKey(ReferenceType const& _type)
+{
+	TypeKey key(_type.category());
+	key << _type.location() << _type.isPointer();
+	if (auto const* arrayType = dynamic_cast<ArrayType const*>(&_type))
+		key <<
+			arrayType->isByteArray() <<
+			arrayType->isString() <<
+			arrayType->baseType() <<
+			arrayType->isDynamicallySized() <<
+			arrayType->length();
+	else if (auto const* structType = dynamic_cast<StructType const*>(&_type))
+		key << &structType->structDefinition();
+	else
+		solAssert(false, "Unexpected reference type.");
+	return key.str();
 }
 
-template <typename T>
-inline void clearCache(unique_ptr<T> const& type)
+template <size_t... I>
+array<IntegerType, 32> integerTypes(IntegerType::Modifier _modifier, index_sequence<I...>)
 {
-	// Some lazy-initialized types might not exist yet.
-	if (type)
-		type->clearCache();
+	return {{IntegerType(8 * (I + 1), _modifier)...}};
 }
 
-template <typename Container>
-inline void clearCaches(Container& container)
+template <size_t... I>
+array<FixedBytesType, 32> fixedBytesTypes(index_sequence<I...>)
 {
-	for (auto const& e: container)
-		clearCache(e);
+	return {{FixedBytesType(I + 1)...}};
+}
+
+unique_ptr<TypeProvider>& globalProvider()
+{
+	static unique_ptr<TypeProvider> provider = make_unique<TypeProvider>();
+	return provider;
+}
+
+}
+
+TypeProvider::TypeProvider():
+	// The elementary types are stored in place, so that creating a provider allocates as little as possible.
+	m_intM{integerTypes(IntegerType::Modifier::Signed, make_index_sequence<32>{})},
+	m_uintM{integerTypes(IntegerType::Modifier::Unsigned, make_index_sequence<32>{})},
+	m_bytesM{fixedBytesTypes(make_index_sequence<32>{})},
+	// MetaType is stored separately
+	m_magics{{
+		MagicType(MagicType::Kind::Block),
+		MagicType(MagicType::Kind::Message),
+		MagicType(MagicType::Kind::Transaction),
+		MagicType(MagicType::Kind::ABI)
+	}}
+{
+	for (Type* type: {
+		static_cast<Type*>(&m_boolean),
+		static_cast<Type*>(&m_inaccessibleDynamic),
+		static_cast<Type*>(&m_emptyTuple),
+		static_cast<Type*>(&m_payableAddress),
+		static_cast<Type*>(&m_address)
+	})
+		type->m_provider = this;
+	for (unsigned i = 0; i < 32; ++i)
+	{
+		m_intM[i].m_provider = this;
+		m_uintM[i].m_provider = this;
+		m_bytesM[i].m_provider = this;
+	}
+	for (auto& magic: m_magics)
+		magic.m_provider = this;
+
+	// The byte arrays have to refer to `byte` of this provider.
+	Scope scope(*this);
+	m_bytesStorage = createReferenceType<ArrayType>(DataLocation::Storage, false);
+	m_bytesMemory = createReferenceType<ArrayType>(DataLocation::Memory, false);
+	m_bytesCalldata = createReferenceType<ArrayType>(DataLocation::CallData, false);
+	m_stringStorage = createReferenceType<ArrayType>(DataLocation::Storage, true);
+	m_stringMemory = createReferenceType<ArrayType>(DataLocation::Memory, true);
+}
+
+TypeProvider::~TypeProvider() = default;
+
+TypeProvider::Scope::Scope(TypeProvider& _provider):
+	m_previous(currentProvider)
+{
+	currentProvider = &_provider;
+}
+
+TypeProvider::Scope::~Scope()
+{
+	currentProvider = m_previous;
 }
 
 void TypeProvider::reset()
 {
-	clearCache(m_boolean);
-	clearCache(m_inaccessibleDynamic);
-	clearCache(m_bytesStorage);
-	clearCache(m_bytesMemory);
-	clearCache(m_bytesCalldata);
-	clearCache(m_stringStorage);
-	clearCache(m_stringMemory);
-	clearCache(m_emptyTuple);
-	clearCache(m_payableAddress);
-	clearCache(m_address);
-	clearCaches(instance().m_intM);
-	clearCaches(instance().m_uintM);
-	clearCaches(instance().m_bytesM);
-	clearCaches(instance().m_magics);
-
-	instance().m_generalTypes.clear();
-	instance().m_stringLiteralTypes.clear();
-	instance().m_ufixedMxN.clear();
-	instance().m_fixedMxN.clear();
+	globalProvider() = make_unique<TypeProvider>();
+}
+
+TypeProvider& TypeProvider::instance()
+{
+	if (currentProvider)
+		return *currentProvider;
+	return *globalProvider();
+}
+
+Type const* TypeProvider::find(string const& _key)
+{
+	lock_guard<mutex> lock(m_mutex);
+	auto type = m_types.find(_key);
+	return type == m_types.end() ? nullptr : type->second;
+}
+
+Type const* TypeProvider::insert(string _key, unique_ptr<Type> _type, size_t _size)
+{
+	_type->m_provider = this;
+	size_t const entrySize = sizeof(decltype(m_types)::value_type) + _key.capacity();
+	lock_guard<mutex> lock(m_mutex);
+	auto [type, inserted] = m_types.emplace(move(_key), _type.get());
+	// Otherwise, the type was created concurrently and the new copy is dropped.
+	if (inserted)
+	{
+		m_generalTypes.emplace_back(move(_type));
+		m_memory.add(_size + entrySize);
+	}
+	return type->second;
+}
+
+Type const* TypeProvider::insert(string _key, Type const* _type)
+{
+	size_t const entrySize = sizeof(decltype(m_types)::value_type) + _key.capacity();
+	lock_guard<mutex> lock(m_mutex);
+	auto [type, inserted] = m_types.emplace(move(_key), _type);
+	if (inserted)
+		m_memory.add(entrySize);
+	return type->second;
 }
 
 template <typename T, typename... Args>
-inline T const* TypeProvider::createAndGet(Args&& ... _args)
+inline T const* TypeProvider::createAndGet(string _key, Args&& ... _args)
 {
-	instance().m_generalTypes.emplace_back(make_unique<T>(std::forward<Args>(_args)...));
-	return static_cast<T const*>(instance().m_generalTypes.back().get());
+	TypeProvider& provider = instance();
+	if (Type const* type = provider.find(_key))
+		return static_cast<T const*>(type);
+	// The lock is not held while creating the type, because its constructor can request other types.
+	return static_cast<T const*>(provider.insert(move(_key), make_unique<T>(std::forward<Args>(_args)...), sizeof(T)));
+}
+
+template <typename T, typename... Args>
+inline T const* TypeProvider::createReferenceType(Args&& ... _args)
+{
+	auto type = make_unique<T>(std::forward<Args>(_args)...);
+	string key = referenceTypeKey(*type);
+	return static_cast<T const*>(instance().insert(move(key), move(type), sizeof(T)));
 }
 
 Type const* TypeProvider::fromElementaryTypeName(ElementaryTypeNameToken const& _type, std::optional<StateMutability> _stateMutability)
@@ -306,37 +338,27 @@ TypePointer TypeProvider::fromElementaryTypeName(string const& _name)
 
 ArrayType const* TypeProvider::bytesStorage()
 {
-	if (!m_bytesStorage)
-		m_bytesStorage = make_unique<ArrayType>(DataLocation::Storage, false);
-	return m_bytesStorage.get();
+	return instance().m_bytesStorage;
 }
 
 ArrayType const* TypeProvider::bytesMemory()
 {
-	if (!m_bytesMemory)
-		m_bytesMemory = make_unique<ArrayType>(DataLocation::Memory, false);
-	return m_bytesMemory.get();
+	return instance().m_bytesMemory;
 }
 
 ArrayType const* TypeProvider::bytesCalldata()
 {
-	if (!m_bytesCalldata)
-		m_bytesCalldata = make_unique<ArrayType>(DataLocation::CallData, false);
-	return m_bytesCalldata.get();
+	return instance().m_bytesCalldata;
 }
 
 ArrayType const* TypeProvider::stringStorage()
 {
-	if (!m_stringStorage)
-		m_stringStorage = make_unique<ArrayType>(DataLocation::Storage, true);
-	return m_stringStorage.get();
+	return instance().m_stringStorage;
 }
 
 ArrayType const* TypeProvider::stringMemory()
 {
-	if (!m_stringMemory)
-		m_stringMemory = make_unique<ArrayType>(DataLocation::Memory, true);
-	return m_stringMemory.get();
+	return instance().m_stringMemory;
 }
 
 TypePointer TypeProvider::forLiteral(Literal const& _literal)
@@ -378,33 +400,26 @@ RationalNumberType const* TypeProvider::rationalNumber(Literal const& _literal)
 
 StringLiteralType const* TypeProvider::stringLiteral(string const& literal)
 {
-	auto i = instance().m_stringLiteralTypes.find(literal);
-	if (i != instance().m_stringLiteralTypes.end())
-		return i->second.get();
-	else
-		return instance().m_stringLiteralTypes.emplace(literal, make_unique<StringLiteralType>(literal)).first->second.get();
+	return createAndGet<StringLiteralType>((TypeKey(Type::Category::StringLiteral) << literal).str(), literal);
 }
 
 FixedPointType const* TypeProvider::fixedPoint(unsigned m, unsigned n, FixedPointType::Modifier _modifier)
 {
-	auto& map = _modifier == FixedPointType::Modifier::Unsigned ? instance().m_ufixedMxN : instance().m_fixedMxN;
-
-	auto i = map.find(make_pair(m, n));
-	if (i != map.end())
-		return i->second.get();
-
-	return map.emplace(
-		make_pair(m, n),
-		make_unique<FixedPointType>(m, n, _modifier)
-	).first->second.get();
+	return createAndGet<FixedPointType>(
+		(TypeKey(Type::Category::FixedPoint) << m << n << _modifier).str(),
+		m,
+		n,
+		_modifier
+	);
 }
 
 TupleType const* TypeProvider::tuple(vector<Type const*> members)
 {
 	if (members.empty())
-		return &m_emptyTuple;
+		return emptyTuple();
 
-	return createAndGet<TupleType>(move(members));
+	string key = (TypeKey(Type::Category::Tuple) << members).str();
+	return createAndGet<TupleType>(move(key), move(members));
 }
 
 ReferenceType const* TypeProvider::withLocation(ReferenceType const* _type, DataLocation _location, bool _isPointer)
@@ -412,28 +427,38 @@ ReferenceType const* TypeProvider::withLocation(ReferenceType const* _type, Data
 	if (_type->location() == _location && _type->isPointer() == _isPointer)
 		return _type;
 
-	instance().m_generalTypes.emplace_back(_type->copyForLocation(_location, _isPointer));
-	return static_cast<ReferenceType const*>(instance().m_generalTypes.back().get());
+	// Remember the result for the type it was derived from in addition to the type itself,
+	// so that the copy is only made once.
+	string key = (TypeKey(_type->category(), 'l') << _type << _location << _isPointer).str();
+	TypeProvider& provider = instance();
+	if (Type const* type = provider.find(key))
+		return static_cast<ReferenceType const*>(type);
+
+	unique_ptr<ReferenceType> copy = _type->copyForLocation(_location, _isPointer);
+	string copyKey = referenceTypeKey(*copy);
+	size_t const size = copy->category() == Type::Category::Struct ? sizeof(StructType) : sizeof(ArrayType);
+	Type const* type = provider.insert(move(copyKey), move(copy), size);
+	return static_cast<ReferenceType const*>(provider.insert(move(key), type));
 }
 
 FunctionType const* TypeProvider::function(FunctionDefinition const& _function, FunctionType::Kind _kind)
 {
-	return createAndGet<FunctionType>(_function, _kind);
+	return createAndGet<FunctionType>((TypeKey(Type::Category::Function, 'd') << &_function << _kind).str(), _function, _kind);
 }
 
 FunctionType const* TypeProvider::function(VariableDeclaration const& _varDecl)
 {
-	return createAndGet<FunctionType>(_varDecl);
+	return createAndGet<FunctionType>((TypeKey(Type::Category::Function, 'v') << &_varDecl).str(), _varDecl);
 }
 
 FunctionType const* TypeProvider::function(EventDefinition const& _def)
 {
-	return createAndGet<FunctionType>(_def);
+	return createAndGet<FunctionType>((TypeKey(Type::Category::Function, 'e') << &_def).str(), _def);
 }
 
 FunctionType const* TypeProvider::function(FunctionTypeName const& _typeName)
 {
-	return createAndGet<FunctionType>(_typeName);
+	return createAndGet<FunctionType>((TypeKey(Type::Category::Function, 'n') << &_typeName).str(), _typeName);
 }
 
 FunctionType const* TypeProvider::function(
@@ -444,7 +469,10 @@ FunctionType const* TypeProvider::function(
 	StateMutability _stateMutability
 )
 {
+	TypeKey key(Type::Category::Function, 's');
+	key << _parameterTypes << _returnParameterTypes << _kind << _arbitraryParameters << _stateMutability;
 	return createAndGet<FunctionType>(
+		key.str(),
 		_parameterTypes, _returnParameterTypes,
 		_kind, _arbitraryParameters, _stateMutability
 	);
@@ -465,7 +493,22 @@ FunctionType const* TypeProvider::function(
 	bool _saltSet
 )
 {
+	TypeKey key(Type::Category::Function, 'c');
+	key <<
+		_parameterTypes <<
+		_returnParameterTypes <<
+		_parameterNames <<
+		_returnParameterNames <<
+		_kind <<
+		_arbitraryParameters <<
+		_stateMutability <<
+		_declaration <<
+		_gasSet <<
+		_valueSet <<
+		_bound <<
+		_saltSet;
 	return createAndGet<FunctionType>(
+		key.str(),
 		_parameterTypes,
 		_returnParameterTypes,
 		_parameterNames,
@@ -483,7 +526,8 @@ FunctionType const* TypeProvider::function(
 
 RationalNumberType const* TypeProvider::rationalNumber(rational const& _value, Type const* _compatibleBytesType)
 {
-	return createAndGet<RationalNumberType>(_value, _compatibleBytesType);
+	string key = (TypeKey(Type::Category::RationalNumber) << _value << _compatibleBytesType).str();
+	return createAndGet<RationalNumberType>(move(key), _value, _compatibleBytesType);
 }
 
 ArrayType const* TypeProvider::array(DataLocation _location, bool _isString)
@@ -502,58 +546,58 @@ ArrayType const* TypeProvider::array(DataLocation _location, bool _isString)
 		if (_location == DataLocation::Memory)
 			return bytesMemory();
 	}
-	return createAndGet<ArrayType>(_location, _isString);
+	return createReferenceType<ArrayType>(_location, _isString);
 }
 
 ArrayType const* TypeProvider::array(DataLocation _location, Type const* _baseType)
 {
-	return createAndGet<ArrayType>(_location, _baseType);
+	return createReferenceType<ArrayType>(_location, _baseType);
 }
 
 ArrayType const* TypeProvider::array(DataLocation _location, Type const* _baseType, u256 const& _length)
 {
-	return createAndGet<ArrayType>(_location, _baseType, _length);
+	return createReferenceType<ArrayType>(_location, _baseType, _length);
 }
 
 ArraySliceType const* TypeProvider::arraySlice(ArrayType const& _arrayType)
 {
-	return createAndGet<ArraySliceType>(_arrayType);
+	return createAndGet<ArraySliceType>((TypeKey(Type::Category::ArraySlice) << &_arrayType).str(), _arrayType);
 }
 
 ContractType const* TypeProvider::contract(ContractDefinition const& _contractDef, bool _isSuper)
 {
-	return createAndGet<ContractType>(_contractDef, _isSuper);
+	return createAndGet<ContractType>((TypeKey(Type::Category::Contract) << &_contractDef << _isSuper).str(), _contractDef, _isSuper);
 }
 
 EnumType const* TypeProvider::enumType(EnumDefinition const& _enumDef)
 {
-	return createAndGet<EnumType>(_enumDef);
+	return createAndGet<EnumType>((TypeKey(Type::Category::Enum) << &_enumDef).str(), _enumDef);
 }
 
 ModuleType const* TypeProvider::module(SourceUnit const& _source)
 {
-	return createAndGet<ModuleType>(_source);
+	return createAndGet<ModuleType>((TypeKey(Type::Category::Module) << &_source).str(), _source);
 }
 
 TypeType const* TypeProvider::typeType(Type const* _actualType)
 {
-	return createAndGet<TypeType>(_actualType);
+	return createAndGet<TypeType>((TypeKey(Type::Category::TypeType) << _actualType).str(), _actualType);
 }
 
 StructType const* TypeProvider::structType(StructDefinition const& _struct, DataLocation _location)
 {
-	return createAndGet<StructType>(_struct, _location);
+	return createReferenceType<StructType>(_struct, _location);
 }
 
 ModifierType const* TypeProvider::modifier(ModifierDefinition const& _def)
 {
-	return createAndGet<ModifierType>(_def);
+	return createAndGet<ModifierType>((TypeKey(Type::Category::Modifier) << &_def).str(), _def);
 }
 
 MagicType const* TypeProvider::magic(MagicType::Kind _kind)
 {
 	solAssert(_kind != MagicType::Kind::MetaType, "MetaType is handled separately");
-	return m_magics.at(static_cast<size_t>(_kind)).get();
+	return &instance().m_magics.at(static_cast<size_t>(_kind));
 }
 
 MagicType const* TypeProvider::meta(Type const* _type)
@@ -565,10 +609,90 @@ MagicType const* TypeProvider::meta(Type const* _type)
 		),
 		"Only contracts or integer types supported for now."
 	);
-	return createAndGet<MagicType>(_type);
+	return createAndGet<MagicType>((TypeKey(Type::Category::Magic) << _type).str(), _type);
 }
 
 MappingType const* TypeProvider::mapping(Type const* _keyType, Type const* _valueType)
 {
-	return createAndGet<MappingType>(_keyType, _valueType);
+	return createAndGet<MappingType>((TypeKey(Type::Category::Mapping) << _keyType << _valueType).str(), _keyType, _valueType);
+}
+
+size_t TypeProvider::QueryKeyHash::operator()(QueryKey const& _key) const
+{
+	size_t seed = 0;
+	boost::hash_combine(seed, _key.type);
+	boost::hash_combine(seed, _key.other);
+	boost::hash_combine(seed, static_cast<unsigned>(_key.query));
+	boost::hash_combine(seed, static_cast<unsigned>(_key.operation));
+	return seed;
+}
+
+template <typename Result>
+Result TypeProvider::memoized(
+	QueryResults<Result> TypeProvider::* _results,
+	Query _query,
+	Type const* _type,
+	Type const* _other,
+	Token _operator,
+	std::function<Result()> const& _compute
+)
+{
+	// Types that do not belong to the provider can be destroyed before it and their addresses reused.
+	TypeProvider& provider = instance();
+	if (_type->m_provider != &provider || (_other && _other->m_provider != &provider))
+		return _compute();
+
+	QueryKey key{_type, _other, _query, _operator};
+	QueryResults<Result>& results = provider.*_results;
+	size_t const index = static_cast<size_t>(_query);
+	{
+		lock_guard<mutex> lock(provider.m_queryMutex);
+		auto result = results.find(key);
+		if (result != results.end())
+		{
+			++provider.m_queryHits[index];
+			return result->second;
+		}
+	}
+	// The lock is not held during the computation, because it can run other queries.
+	Result result = _compute();
+	lock_guard<mutex> lock(provider.m_queryMutex);
+	if (results.emplace(key, result).second)
+		++provider.m_queryMisses[index];
+	return result;
+}
+
+BoolResult TypeProvider::memoizedBoolResult(
+	Query _query,
+	Type const* _type,
+	Type const* _other,
+	Token _operator,
+	std::function<BoolResult()> const& _compute
+)
+{
+	return memoized(&TypeProvider::m_boolResults, _query, _type, _other, _operator, _compute);
+}
+
+TypeResult TypeProvider::memoizedTypeResult(
+	Query _query,
+	Type const* _type,
+	Type const* _other,
+	Token _operator,
+	std::function<TypeResult()> const& _compute
+)
+{
+	return memoized(&TypeProvider::m_typeResults, _query, _type, _other, _operator, _compute);
+}
+
+void TypeProvider::recordStatistics(util::CompilationStatistics& _statistics) const
+{
+	static std::array<char const*, 4> const names{{
+		"types/implicitConversion",
+		"types/explicitConversion",
+		"types/commonType",
+		"types/binaryOperator"
+	}};
+	lock_guard<mutex> lock(m_queryMutex);
+	for (size_t i = 0; i < names.size(); ++i)
+		_statistics.recordCache(names[i], m_queryHits[i], m_queryMisses[i]);
 }
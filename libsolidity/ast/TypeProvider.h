@@ -20,11 +20,24 @@
 
 #include <libsolidity/ast/Types.h>
 
+#include <libsolutil/MemoryAccounting.h>
+
+#include <boost/noncopyable.hpp>
+
 #include <array>
-#include <map>
+#include <functional>
 #include <memory>
+#include <mutex>
 #include <optional>
+#include <string>
+#include <unordered_map>
 #include <utility>
+#include <vector>
+
+namespace solidity::util
+{
+class CompilationStatistics;
+}
 
 namespace solidity::frontend
 {
@@ -37,19 +50,32 @@ namespace solidity::frontend
  *
  * It is not recommended to explicitly instantiate types unless you really know what and why
  * you are doing it.
+ *
+ * Every type is only created once per provider, i.e. requesting the same type again returns the
+ * same object. Types can be requested from several threads at the same time.
  */
 class TypeProvider
 {
 public:
-	TypeProvider() = default;
-	TypeProvider(TypeProvider&&) = default;
+	TypeProvider();
 	TypeProvider(TypeProvider const&) = delete;
-	TypeProvider& operator=(TypeProvider&&) = default;
 	TypeProvider& operator=(TypeProvider const&) = delete;
-	~TypeProvider() = default;
+	~TypeProvider();
 
-	/// Resets state of this TypeProvider to initial state, wiping all mutable types.
-	/// This invalidates all dangling pointers to types provided by this TypeProvider.
+	/// Makes the static functions of TypeProvider use @a _provider on the current thread while alive.
+	/// Without an active scope, a global provider is used.
+	class Scope: boost::noncopyable
+	{
+	public:
+		explicit Scope(TypeProvider& _provider);
+		~Scope();
+
+	private:
+		TypeProvider* m_previous = nullptr;
+	};
+
+	/// Resets the global provider, which is used on threads without an active scope,
+	/// to its initial state. This invalidates all pointers to types provided by it.
 	static void reset();
 
 	/// @name Factory functions
@@ -61,10 +87,10 @@ public:
 	static TypePointer fromElementaryTypeName(std::string const& _name);
 
 	/// @returns boolean type.
-	static BoolType const* boolean() noexcept { return &m_boolean; }
+	static BoolType const* boolean() { return &instance().m_boolean; }
 
 	static FixedBytesType const* byte() { return fixedBytes(1); }
-	static FixedBytesType const* fixedBytes(unsigned m) { return m_bytesM.at(m - 1).get(); }
+	static FixedBytesType const* fixedBytes(unsigned m) { return &instance().m_bytesM.at(m - 1); }
 
 	static ArrayType const* bytesStorage();
 	static ArrayType const* bytesMemory();
@@ -83,16 +109,16 @@ public:
 
 	static ArraySliceType const* arraySlice(ArrayType const& _arrayType);
 
-	static AddressType const* payableAddress() noexcept { return &m_payableAddress; }
-	static AddressType const* address() noexcept { return &m_address; }
+	static AddressType const* payableAddress() { return &instance().m_payableAddress; }
+	static AddressType const* address() { return &instance().m_address; }
 
 	static IntegerType const* integer(unsigned _bits, IntegerType::Modifier _modifier)
 	{
 		solAssert((_bits % 8) == 0, "");
 		if (_modifier == IntegerType::Modifier::Unsigned)
-			return m_uintM.at(_bits / 8 - 1).get();
+			return &instance().m_uintM.at(_bits / 8 - 1);
 		else
-			return m_intM.at(_bits / 8 - 1).get();
+			return &instance().m_intM.at(_bits / 8 - 1);
 	}
 	static IntegerType const* uint(unsigned _bits) { return integer(_bits, IntegerType::Modifier::Unsigned); }
 
@@ -107,7 +133,7 @@ public:
 	/// @returns a tuple type with the given members.
 	static TupleType const* tuple(std::vector<Type const*> members);
 
-	static TupleType const* emptyTuple() noexcept { return &m_emptyTuple; }
+	static TupleType const* emptyTuple() { return &instance().m_emptyTuple; }
 
 	static ReferenceType const* withLocation(ReferenceType const* _type, DataLocation _location, bool _isPointer);
 
@@ -179,7 +205,7 @@ public:
 
 	static ContractType const* contract(ContractDefinition const& _contract, bool _isSuper = false);
 
-	static InaccessibleDynamicType const* inaccessibleDynamic() noexcept { return &m_inaccessibleDynamic; }
+	static InaccessibleDynamicType const* inaccessibleDynamic() { return &instance().m_inaccessibleDynamic; }
 
 	/// @returns the type of an enum instance for given definition, there is one distinct type per enum definition.
 	static EnumType const* enumType(EnumDefinition const& _enum);
@@ -199,39 +225,110 @@ public:
 
 	static MappingType const* mapping(Type const* _keyType, Type const* _valueType);
 
+	/// Queries about pairs of types whose results are memoized.
+	enum class Query: uint8_t { ImplicitConversion, ExplicitConversion, CommonType, BinaryOperator };
+
+	/// @returns the result of @a _query for @a _type, @a _other and @a _operator, which is computed
+	/// by @a _compute unless it was computed before. Results are only memoized if both types belong
+	/// to the current provider.
+	static BoolResult memoizedBoolResult(
+		Query _query,
+		Type const* _type,
+		Type const* _other,
+		langutil::Token _operator,
+		std::function<BoolResult()> const& _compute
+	);
+	static TypeResult memoizedTypeResult(
+		Query _query,
+		Type const* _type,
+		Type const* _other,
+		langutil::Token _operator,
+		std::function<TypeResult()> const& _compute
+	);
+
+	/// Adds how often memoized results were reused and how often they had to be computed
+	/// to @a _statistics.
+	void recordStatistics(util::CompilationStatistics& _statistics) const;
+
+	/// @returns the provider of the current thread, e.g. to use it on other threads with a Scope.
+	static TypeProvider& instance();
+
 private:
-	/// Global TypeProvider instance.
-	static TypeProvider& instance()
+	/// @returns the type stored under @a _key, which is created from @a _args if it does not exist yet.
+	template <typename T, typename... Args>
+	static inline T const* createAndGet(std::string _key, Args&& ... _args);
+	/// @returns the array or struct type constructed from @a _args, which is the same object for
+	/// all equal types, independent of how they were created.
+	template <typename T, typename... Args>
+	static inline T const* createReferenceType(Args&& ... _args);
+
+	/// @returns the type stored under @a _key or a null pointer if there is none.
+	Type const* find(std::string const& _key);
+	/// Stores @a _type, whose object is @a _size bytes large, under @a _key unless a type was
+	/// already stored under it in the meantime. @returns the stored type.
+	Type const* insert(std::string _key, std::unique_ptr<Type> _type, size_t _size);
+	/// Stores a type owned elsewhere under the additional key @a _key. @returns the stored type.
+	Type const* insert(std::string _key, Type const* _type);
+
+	struct QueryKey
 	{
-		static TypeProvider _provider;
-		return _provider;
-	}
+		Type const* type;
+		Type const* other;
+		Query query;
+		langutil::Token operation;
+
+		bool operator==(QueryKey const& _other) const
+		{
+			return type == _other.type && other == _other.other && query == _other.query && operation == _other.operation;
+		}
+	};
+	struct QueryKeyHash
+	{
+		size_t operator()(QueryKey const& _key) const;
+	};
+	template <typename Result>
+	using QueryResults = std::unordered_map<QueryKey, Result, QueryKeyHash>;
+
+	template <typename Result>
+	static Result memoized(
+		QueryResults<Result> TypeProvider::* _results,
+		Query _query,
+		Type const* _type,
+		Type const* _other,
+		langutil::Token _operator,
+		std::function<Result()> const& _compute
+	);
 
-	template <typename T, typename... Args>
-	static inline T const* createAndGet(Args&& ... _args);
-
-	static BoolType const m_boolean;
-	static InaccessibleDynamicType const m_inaccessibleDynamic;
-
-	/// These are lazy-initialized because they depend on `byte` being available.
-	static std::unique_ptr<ArrayType> m_bytesStorage;
-	static std::unique_ptr<ArrayType> m_bytesMemory;
-	static std::unique_ptr<ArrayType> m_bytesCalldata;
-	static std::unique_ptr<ArrayType> m_stringStorage;
-	static std::unique_ptr<ArrayType> m_stringMemory;
-
-	static TupleType const m_emptyTuple;
-	static AddressType const m_payableAddress;
-	static AddressType const m_address;
-	static std::array<std::unique_ptr<IntegerType>, 32> const m_intM;
-	static std::array<std::unique_ptr<IntegerType>, 32> const m_uintM;
-	static std::array<std::unique_ptr<FixedBytesType>, 32> const m_bytesM;
-	static std::array<std::unique_ptr<MagicType>, 4> const m_magics;        ///< MagicType's except MetaType
-
-	std::map<std::pair<unsigned, unsigned>, std::unique_ptr<FixedPointType>> m_ufixedMxN{};
-	std::map<std::pair<unsigned, unsigned>, std::unique_ptr<FixedPointType>> m_fixedMxN{};
-	std::map<std::string, std::unique_ptr<StringLiteralType>> m_stringLiteralTypes{};
-	std::vector<std::unique_ptr<Type>> m_generalTypes{};
+	BoolType m_boolean;
+	InaccessibleDynamicType m_inaccessibleDynamic;
+	TupleType m_emptyTuple;
+	AddressType m_payableAddress{StateMutability::Payable};
+	AddressType m_address{StateMutability::NonPayable};
+	std::array<IntegerType, 32> m_intM;
+	std::array<IntegerType, 32> m_uintM;
+	std::array<FixedBytesType, 32> m_bytesM;
+	std::array<MagicType, 4> m_magics;        ///< MagicType's except MetaType
+
+	ArrayType const* m_bytesStorage = nullptr;
+	ArrayType const* m_bytesMemory = nullptr;
+	ArrayType const* m_bytesCalldata = nullptr;
+	ArrayType const* m_stringStorage = nullptr;
+	ArrayType const* m_stringMemory = nullptr;
+
+	/// Protects the types below, which can be requested concurrently.
+	std::mutex m_mutex;
+	/// All types created by this provider, keyed by the values that determine them.
+	std::unordered_map<std::string, Type const*> m_types;
+	std::vector<std::unique_ptr<Type>> m_generalTypes;
+	/// Memory of the types and keys above.
+	util::MemoryAccount m_memory{util::MemorySubsystem::Types};
+
+	/// Protects the memoized results of queries, which can be made concurrently.
+	mutable std::mutex m_queryMutex;
+	QueryResults<BoolResult> m_boolResults;
+	QueryResults<TypeResult> m_typeResults;
+	std::array<size_t, 4> m_queryHits{};
+	std::array<size_t, 4> m_queryMisses{};
 };
 
 }
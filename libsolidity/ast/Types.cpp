@@ -49,6 +49,7 @@
 #include <range/v3/view/enumerate.hpp>
 
 #include <limits>
+#include <mutex>
 #include <unordered_set>
 #include <utility>
 
@@ -60,6 +61,33 @@ using namespace solidity::frontend;
 namespace
 {
 
+/// @returns the mutex guarding the lazily initialized values of all types.
+mutex& typeCacheMutex()
+{
+	static mutex cacheMutex;
+	return cacheMutex;
+}
+
+/// @returns a copy of the lazily initialized value @a _cache.
+template <class T>
+optional<T> cachedValue(optional<T> const& _cache)
+{
+	lock_guard<mutex> lock(typeCacheMutex());
+	return _cache;
+}
+
+/// Stores @a _value in @a _cache unless another thread already did so and @returns the stored value.
+/// Values are computed without holding the lock, so that computing them can use other lazily
+/// initialized values.
+template <class T>
+T storeCachedValue(optional<T>& _cache, T _value)
+{
+	lock_guard<mutex> lock(typeCacheMutex());
+	if (!_cache)
+		_cache = move(_value);
+	return *_cache;
+}
+
 /// Checks whether _mantissa * (10 ** _expBase10) fits into 4096 bits.
 bool fitsPrecisionBase10(bigint const& _mantissa, uint32_t _expBase10)
 {
@@ -67,6 +95,29 @@ bool fitsPrecisionBase10(bigint const& _mantissa, uint32_t _expBase10)
 	return fitsPrecisionBaseX(_mantissa, log2Of10AwayFromZero, _expBase10);
 }
 
+/// @returns the value of the decimal or hexadecimal integer literal @a _literal if it has at most
+/// 18 decimal or 15 hexadecimal digits, without parsing it as a bigint.
+optional<int64_t> parseSmallInteger(string const& _literal)
+{
+	bool const hex = boost::starts_with(_literal, "0x");
+	size_t const digits = _literal.size() - (hex ? 2 : 0);
+	if (digits == 0 || digits > (hex ? 15u : 18u))
+		return nullopt;
+	// Leave it to the bigint parser to interpret leading zeros.
+	if (!hex && digits > 1 && _literal.front() == '0')
+		return nullopt;
+
+	int64_t value = 0;
+	for (char digit: _literal.substr(hex ? 2 : 0))
+		if (hex && ::isxdigit(digit))
+			value = value * 16 + (::isdigit(digit) ? digit - '0' : ::tolower(digit) - 'a' + 10);
+		else if (!hex && ::isdigit(digit))
+			value = value * 10 + (digit - '0');
+		else
+			return nullopt;
+	return value;
+}
+
 /// Checks whether _value fits into IntegerType _type.
 BoolResult fitsIntegerType(bigint const& _value, IntegerType const& _type)
 {
@@ -112,11 +163,16 @@ util::Result<TypePointers> transformParametersToExternal(TypePointers const& _pa
 }
 
 MemberList::Member::Member(Declaration const* _declaration, Type const* _type):
-	Member(_declaration, _type, _declaration->name())
-{}
+	name(_declaration->name()),
+	symbol(_declaration->symbol()),
+	type(_type),
+	declaration(_declaration)
+{
+}
 
 MemberList::Member::Member(Declaration const* _declaration, Type const* _type, string _name):
 	name(move(_name)),
+	symbol(name),
 	type(_type),
 	declaration(_declaration)
 {
@@ -124,9 +180,22 @@ MemberList::Member::Member(Declaration const* _declaration, Type const* _type, s
 
 void Type::clearCache() const
 {
+	lock_guard<mutex> lock(typeCacheMutex());
 	m_members.clear();
 	m_stackItems.reset();
-	m_stackSize.reset();
+	m_hasStackItems = false;
+	m_stackSize = unknownStackSize;
+}
+
+void Type::initStackItems() const
+{
+	auto stackItems = makeStackItems();
+	lock_guard<mutex> lock(typeCacheMutex());
+	if (!m_stackItems)
+	{
+		m_stackItems = move(stackItems);
+		m_hasStackItems.store(true, memory_order_release);
+	}
 }
 
 void StorageOffsets::computeOffsets(TypePointers const& _types)
@@ -179,9 +248,10 @@ void MemberList::combine(MemberList const & _other)
 pair<u256, unsigned> const* MemberList::memberStorageOffset(string const& _name) const
 {
 	StorageOffsets const& offsets = storageOffsets();
+	Symbol const name(_name);
 
 	for (auto&& [index, member]: m_memberTypes | ranges::views::enumerate)
-		if (member.name == _name)
+		if (member.symbol == name)
 			return offsets.offset(index);
 	return nullptr;
 }
@@ -276,29 +346,60 @@ TypePointer Type::commonType(Type const* _a, Type const* _b)
 {
 	if (!_a || !_b)
 		return nullptr;
-	else if (_a->mobileType() && _b->isImplicitlyConvertibleTo(*_a->mobileType()))
-		return _a->mobileType();
-	else if (_b->mobileType() && _a->isImplicitlyConvertibleTo(*_b->mobileType()))
-		return _b->mobileType();
-	else
-		return nullptr;
+	return TypeProvider::memoizedTypeResult(TypeProvider::Query::CommonType, _a, _b, Token::Illegal, [&]() -> TypeResult {
+		if (_a->mobileType() && _b->isImplicitlyConvertibleTo(*_a->mobileType()))
+			return _a->mobileType();
+		else if (_b->mobileType() && _a->isImplicitlyConvertibleTo(*_b->mobileType()))
+			return _b->mobileType();
+		else
+			return nullptr;
+	}).get();
+}
+
+BoolResult Type::isImplicitlyConvertibleTo(Type const& _other) const
+{
+	return TypeProvider::memoizedBoolResult(TypeProvider::Query::ImplicitConversion, this, &_other, Token::Illegal, [&]() {
+		return checkImplicitConversionTo(_other);
+	});
+}
+
+BoolResult Type::isExplicitlyConvertibleTo(Type const& _convertTo) const
+{
+	return TypeProvider::memoizedBoolResult(TypeProvider::Query::ExplicitConversion, this, &_convertTo, Token::Illegal, [&]() {
+		return checkExplicitConversionTo(_convertTo);
+	});
+}
+
+TypeResult Type::binaryOperatorResult(Token _operator, Type const* _other) const
+{
+	return TypeProvider::memoizedTypeResult(TypeProvider::Query::BinaryOperator, this, _other, _operator, [&]() {
+		return makeBinaryOperatorResult(_operator, _other);
+	});
 }
 
 MemberList const& Type::members(ASTNode const* _currentScope) const
 {
-	if (!m_members[_currentScope])
 	{
-		solAssert(
-			_currentScope == nullptr ||
-			dynamic_cast<SourceUnit const*>(_currentScope) ||
-			dynamic_cast<ContractDefinition const*>(_currentScope),
-		"");
-		MemberList::MemberMap members = nativeMembers(_currentScope);
-		if (_currentScope)
-			members += boundFunctions(*this, *_currentScope);
-		m_members[_currentScope] = make_unique<MemberList>(move(members));
+		lock_guard<mutex> lock(typeCacheMutex());
+		auto it = m_members.find(_currentScope);
+		if (it != m_members.end())
+			return *it->second;
 	}
-	return *m_members[_currentScope];
+
+	solAssert(
+		_currentScope == nullptr ||
+		dynamic_cast<SourceUnit const*>(_currentScope) ||
+		dynamic_cast<ContractDefinition const*>(_currentScope),
+	"");
+	MemberList::MemberMap members = nativeMembers(_currentScope);
+	if (_currentScope)
+		members += boundFunctions(*this, *_currentScope);
+
+	lock_guard<mutex> lock(typeCacheMutex());
+	unique_ptr<MemberList>& memberList = m_members[_currentScope];
+	if (!memberList)
+		memberList = make_unique<MemberList>(move(members));
+	return *memberList;
 }
 
 TypePointer Type::fullEncodingType(bool _inLibraryCall, bool _encoderV2, bool) const
@@ -397,7 +498,7 @@ string AddressType::richIdentifier() const
 		return "t_address";
 }
 
-BoolResult AddressType::isImplicitlyConvertibleTo(Type const& _other) const
+BoolResult AddressType::checkImplicitConversionTo(Type const& _other) const
 {
 	if (_other.category() != category())
 		return false;
@@ -406,7 +507,7 @@ BoolResult AddressType::isImplicitlyConvertibleTo(Type const& _other) const
 	return other.m_stateMutability <= m_stateMutability;
 }
 
-BoolResult AddressType::isExplicitlyConvertibleTo(Type const& _convertTo) const
+BoolResult AddressType::checkExplicitConversionTo(Type const& _convertTo) const
 {
 	if ((_convertTo.category() == category()) || isImplicitlyConvertibleTo(_convertTo))
 		return true;
@@ -449,7 +550,7 @@ TypeResult AddressType::unaryOperatorResult(Token _operator) const
 }
 
 
-TypeResult AddressType::binaryOperatorResult(Token _operator, Type const* _other) const
+TypeResult AddressType::makeBinaryOperatorResult(Token _operator, Type const* _other) const
 {
 	if (!TokenTraits::isCompareOp(_operator))
 		return TypeResult::err("Arithmetic operations on addresses are not supported. Convert to integer first before using them.");
@@ -516,7 +617,7 @@ string IntegerType::richIdentifier() const
 	return "t_" + string(isSigned() ? "" : "u") + "int" + to_string(numBits());
 }
 
-BoolResult IntegerType::isImplicitlyConvertibleTo(Type const& _convertTo) const
+BoolResult IntegerType::checkImplicitConversionTo(Type const& _convertTo) const
 {
 	if (_convertTo.category() == category())
 	{
@@ -538,7 +639,7 @@ BoolResult IntegerType::isImplicitlyConvertibleTo(Type const& _convertTo) const
 		return false;
 }
 
-BoolResult IntegerType::isExplicitlyConvertibleTo(Type const& _convertTo) const
+BoolResult IntegerType::checkExplicitConversionTo(Type const& _convertTo) const
 {
 	if (isImplicitlyConvertibleTo(_convertTo))
 		return true;
@@ -619,7 +720,7 @@ bigint IntegerType::maxValue() const
 		return (bigint(1) << m_bits) - 1;
 }
 
-TypeResult IntegerType::binaryOperatorResult(Token _operator, Type const* _other) const
+TypeResult IntegerType::makeBinaryOperatorResult(Token _operator, Type const* _other) const
 {
 	if (
 		_other->category() != Category::RationalNumber &&
@@ -683,7 +784,7 @@ string FixedPointType::richIdentifier() const
 	return "t_" + string(isSigned() ? "" : "u") + "fixed" + to_string(m_totalBits) + "x" + to_string(m_fractionalDigits);
 }
 
-BoolResult FixedPointType::isImplicitlyConvertibleTo(Type const& _convertTo) const
+BoolResult FixedPointType::checkImplicitConversionTo(Type const& _convertTo) const
 {
 	if (_convertTo.category() == category())
 	{
@@ -698,7 +799,7 @@ BoolResult FixedPointType::isImplicitlyConvertibleTo(Type const& _convertTo) con
 	return false;
 }
 
-BoolResult FixedPointType::isExplicitlyConvertibleTo(Type const& _convertTo) const
+BoolResult FixedPointType::checkExplicitConversionTo(Type const& _convertTo) const
 {
 	return _convertTo.category() == category() || _convertTo.category() == Category::Integer;
 }
@@ -752,7 +853,7 @@ bigint FixedPointType::minIntegerValue() const
 		return bigint(0);
 }
 
-TypeResult FixedPointType::binaryOperatorResult(Token _operator, Type const* _other) const
+TypeResult FixedPointType::makeBinaryOperatorResult(Token _operator, Type const* _other) const
 {
 	auto commonType = Type::commonType(this, _other);
 
@@ -826,7 +927,9 @@ tuple<bool, rational> RationalNumberType::isValidLiteral(Literal const& _literal
 		if (expPoint == valueString.end())
 			expPoint = find(valueString.begin(), valueString.end(), 'E');
 
-		if (boost::starts_with(valueString, "0x"))
+		if (optional<int64_t> smallValue = parseSmallInteger(valueString))
+			value = bigint(*smallValue);
+		else if (boost::starts_with(valueString, "0x"))
 		{
 			// process as hex
 			value = bigint(valueString);
@@ -916,7 +1019,7 @@ tuple<bool, rational> RationalNumberType::isValidLiteral(Literal const& _literal
 	return make_tuple(true, value);
 }
 
-BoolResult RationalNumberType::isImplicitlyConvertibleTo(Type const& _convertTo) const
+BoolResult RationalNumberType::checkImplicitConversionTo(Type const& _convertTo) const
 {
 	switch (_convertTo.category())
 	{
@@ -948,7 +1051,7 @@ BoolResult RationalNumberType::isImplicitlyConvertibleTo(Type const& _convertTo)
 	}
 }
 
-BoolResult RationalNumberType::isExplicitlyConvertibleTo(Type const& _convertTo) const
+BoolResult RationalNumberType::checkExplicitConversionTo(Type const& _convertTo) const
 {
 	if (isImplicitlyConvertibleTo(_convertTo))
 		return true;
@@ -982,7 +1085,7 @@ TypeResult RationalNumberType::unaryOperatorResult(Token _operator) const
 		return nullptr;
 }
 
-TypeResult RationalNumberType::binaryOperatorResult(Token _operator, Type const* _other) const
+TypeResult RationalNumberType::makeBinaryOperatorResult(Token _operator, Type const* _other) const
 {
 	if (_other->category() == Category::Integer || _other->category() == Category::FixedPoint)
 	{
@@ -1188,7 +1291,7 @@ StringLiteralType::StringLiteralType(string _value):
 {
 }
 
-BoolResult StringLiteralType::isImplicitlyConvertibleTo(Type const& _convertTo) const
+BoolResult StringLiteralType::checkImplicitConversionTo(Type const& _convertTo) const
 {
 	if (auto fixedBytes = dynamic_cast<FixedBytesType const*>(&_convertTo))
 	{
@@ -1258,7 +1361,7 @@ FixedBytesType::FixedBytesType(unsigned _bytes): m_bytes(_bytes)
 	);
 }
 
-BoolResult FixedBytesType::isImplicitlyConvertibleTo(Type const& _convertTo) const
+BoolResult FixedBytesType::checkImplicitConversionTo(Type const& _convertTo) const
 {
 	if (_convertTo.category() != category())
 		return false;
@@ -1266,7 +1369,7 @@ BoolResult FixedBytesType::isImplicitlyConvertibleTo(Type const& _convertTo) con
 	return convertTo.m_bytes >= m_bytes;
 }
 
-BoolResult FixedBytesType::isExplicitlyConvertibleTo(Type const& _convertTo) const
+BoolResult FixedBytesType::checkExplicitConversionTo(Type const& _convertTo) const
 {
 	if (_convertTo.category() == category())
 		return true;
@@ -1293,7 +1396,7 @@ TypeResult FixedBytesType::unaryOperatorResult(Token _operator) const
 	return nullptr;
 }
 
-TypeResult FixedBytesType::binaryOperatorResult(Token _operator, Type const* _other) const
+TypeResult FixedBytesType::makeBinaryOperatorResult(Token _operator, Type const* _other) const
 {
 	if (TokenTraits::isShiftOp(_operator))
 	{
@@ -1353,7 +1456,7 @@ TypeResult BoolType::unaryOperatorResult(Token _operator) const
 		return nullptr;
 }
 
-TypeResult BoolType::binaryOperatorResult(Token _operator, Type const* _other) const
+TypeResult BoolType::makeBinaryOperatorResult(Token _operator, Type const* _other) const
 {
 	if (category() != _other->category())
 		return nullptr;
@@ -1374,7 +1477,7 @@ Type const* ContractType::encodingType() const
 		return TypeProvider::address();
 }
 
-BoolResult ContractType::isImplicitlyConvertibleTo(Type const& _convertTo) const
+BoolResult ContractType::checkImplicitConversionTo(Type const& _convertTo) const
 {
 	if (m_super)
 		return false;
@@ -1397,7 +1500,7 @@ BoolResult ContractType::isImplicitlyConvertibleTo(Type const& _convertTo) const
 	return false;
 }
 
-BoolResult ContractType::isExplicitlyConvertibleTo(Type const& _convertTo) const
+BoolResult ContractType::checkExplicitConversionTo(Type const& _convertTo) const
 {
 	if (m_super)
 		return false;
@@ -1522,11 +1625,12 @@ void ArrayType::clearCache() const
 {
 	Type::clearCache();
 
+	lock_guard<mutex> lock(typeCacheMutex());
 	m_interfaceType.reset();
 	m_interfaceType_library.reset();
 }
 
-BoolResult ArrayType::isImplicitlyConvertibleTo(Type const& _convertTo) const
+BoolResult ArrayType::checkImplicitConversionTo(Type const& _convertTo) const
 {
 	if (_convertTo.category() != category())
 		return false;
@@ -1566,7 +1670,7 @@ BoolResult ArrayType::isImplicitlyConvertibleTo(Type const& _convertTo) const
 	}
 }
 
-BoolResult ArrayType::isExplicitlyConvertibleTo(Type const& _convertTo) const
+BoolResult ArrayType::checkExplicitConversionTo(Type const& _convertTo) const
 {
 	if (isImplicitlyConvertibleTo(_convertTo))
 		return true;
@@ -1850,11 +1954,9 @@ TypePointer ArrayType::decodingType() const
 
 TypeResult ArrayType::interfaceType(bool _inLibrary) const
 {
-	if (_inLibrary && m_interfaceType_library.has_value())
-		return *m_interfaceType_library;
-
-	if (!_inLibrary && m_interfaceType.has_value())
-		return *m_interfaceType;
+	optional<TypeResult>& cache = _inLibrary ? m_interfaceType_library : m_interfaceType;
+	if (optional<TypeResult> cached = cachedValue(cache))
+		return *cached;
 
 	TypeResult result{TypePointer{}};
 	TypeResult baseInterfaceType = m_baseType->interfaceType(_inLibrary);
@@ -1873,12 +1975,7 @@ TypeResult ArrayType::interfaceType(bool _inLibrary) const
 	else
 		result = TypeProvider::array(DataLocation::Memory, baseInterfaceType, m_length);
 
-	if (_inLibrary)
-		m_interfaceType_library = result;
-	else
-		m_interfaceType = result;
-
-	return result;
+	return storeCachedValue(cache, move(result));
 }
 
 Type const* ArrayType::finalBaseType(bool _breakIfDynamicArrayType) const
@@ -1917,7 +2014,7 @@ std::unique_ptr<ReferenceType> ArrayType::copyForLocation(DataLocation _location
 	return copy;
 }
 
-BoolResult ArraySliceType::isImplicitlyConvertibleTo(Type const& _other) const
+BoolResult ArraySliceType::checkImplicitConversionTo(Type const& _other) const
 {
 	return
 		(*this) == _other ||
@@ -2005,9 +2102,9 @@ MemberList::MemberMap ContractType::nativeMembers(ASTNode const*) const
 
 FunctionType const* ContractType::newExpressionType() const
 {
-	if (!m_constructorType)
-		m_constructorType = FunctionType::newExpressionType(m_contract);
-	return m_constructorType;
+	if (optional<FunctionType const*> cached = cachedValue(m_constructorType))
+		return *cached;
+	return storeCachedValue(m_constructorType, FunctionType::newExpressionType(m_contract));
 }
 
 vector<tuple<VariableDeclaration const*, u256, unsigned>> ContractType::stateVariables() const
@@ -2052,6 +2149,7 @@ void StructType::clearCache() const
 {
 	Type::clearCache();
 
+	lock_guard<mutex> lock(typeCacheMutex());
 	m_interfaceType.reset();
 	m_interfaceType_library.reset();
 }
@@ -2064,7 +2162,7 @@ Type const* StructType::encodingType() const
 	return TypeProvider::uint256();
 }
 
-BoolResult StructType::isImplicitlyConvertibleTo(Type const& _convertTo) const
+BoolResult StructType::checkImplicitConversionTo(Type const& _convertTo) const
 {
 	if (_convertTo.category() != category())
 		return false;
@@ -2082,6 +2180,22 @@ string StructType::richIdentifier() const
 	return "t_struct" + parenthesizeUserIdentifier(m_struct.name()) + to_string(m_struct.id()) + identifierLocationSuffix();
 }
 
+string StructType::layoutIdentifier() const
+{
+	return escapeIdentifier(richLayoutIdentifier());
+}
+
+string StructType::richLayoutIdentifier() const
+{
+	vector<string> memberIdentifiers;
+	for (auto const& member: members(nullptr))
+		if (auto const* structType = dynamic_cast<StructType const*>(member.type))
+			memberIdentifiers.emplace_back(structType->richLayoutIdentifier());
+		else
+			memberIdentifiers.emplace_back(member.type->richIdentifier());
+	return "t_struct_layout" + identifierList(move(memberIdentifiers)) + identifierLocationSuffix();
+}
+
 bool StructType::operator==(Type const& _other) const
 {
 	if (_other.category() != category())
@@ -2234,38 +2348,36 @@ TypeResult StructType::interfaceType(bool _inLibrary) const
 {
 	if (!_inLibrary)
 	{
-		if (!m_interfaceType.has_value())
+		if (optional<TypeResult> cached = cachedValue(m_interfaceType))
+			return *cached;
+
+		if (recursive())
+			return storeCachedValue(
+				m_interfaceType,
+				TypeResult::err("Recursive type not allowed for public or external contract functions.")
+			);
+		TypeResult result{TypePointer{}};
+		for (ASTPointer<VariableDeclaration> const& member: m_struct.members())
 		{
-			if (recursive())
-				m_interfaceType = TypeResult::err("Recursive type not allowed for public or external contract functions.");
-			else
+			if (!member->annotation().type)
 			{
-				TypeResult result{TypePointer{}};
-				for (ASTPointer<VariableDeclaration> const& member: m_struct.members())
-				{
-					if (!member->annotation().type)
-					{
-						result = TypeResult::err("Invalid type!");
-						break;
-					}
-					auto interfaceType = member->annotation().type->interfaceType(false);
-					if (!interfaceType.get())
-					{
-						solAssert(!interfaceType.message().empty(), "Expected detailed error message!");
-						result = interfaceType;
-						break;
-					}
-				}
-				if (result.message().empty())
-					m_interfaceType = TypeProvider::withLocation(this, DataLocation::Memory, true);
-				else
-					m_interfaceType = result;
+				result = TypeResult::err("Invalid type!");
+				break;
+			}
+			auto interfaceType = member->annotation().type->interfaceType(false);
+			if (!interfaceType.get())
+			{
+				solAssert(!interfaceType.message().empty(), "Expected detailed error message!");
+				result = interfaceType;
+				break;
 			}
 		}
-		return *m_interfaceType;
+		if (result.message().empty())
+			result = TypeProvider::withLocation(this, DataLocation::Memory, true);
+		return storeCachedValue(m_interfaceType, move(result));
 	}
-	else if (m_interfaceType_library.has_value())
-		return *m_interfaceType_library;
+	else if (optional<TypeResult> cached = cachedValue(m_interfaceType_library))
+		return *cached;
 
 	TypeResult result{TypePointer{}};
 
@@ -2327,10 +2439,12 @@ TypeResult StructType::interfaceType(bool _inLibrary) const
 		return result;
 
 	if (location() == DataLocation::Storage)
-		m_interfaceType_library = this;
+		return storeCachedValue(m_interfaceType_library, TypeResult{this});
 	else
-		m_interfaceType_library = TypeProvider::withLocation(this, DataLocation::Memory, true);
-	return *m_interfaceType_library;
+		return storeCachedValue(
+			m_interfaceType_library,
+			TypeResult{TypeProvider::withLocation(this, DataLocation::Memory, true)}
+		);
 }
 
 BoolResult StructType::validForLocation(DataLocation _loc) const
@@ -2504,7 +2618,7 @@ size_t EnumType::numberOfMembers() const
 	return m_enum.members().size();
 }
 
-BoolResult EnumType::isExplicitlyConvertibleTo(Type const& _convertTo) const
+BoolResult EnumType::checkExplicitConversionTo(Type const& _convertTo) const
 {
 	if (_convertTo == *this)
 		return true;
@@ -2525,7 +2639,7 @@ unsigned EnumType::memberValue(ASTString const& _member) const
 	solAssert(false, "Requested unknown enum value " + _member);
 }
 
-BoolResult TupleType::isImplicitlyConvertibleTo(Type const& _other) const
+BoolResult TupleType::checkImplicitConversionTo(Type const& _other) const
 {
 	if (auto tupleType = dynamic_cast<TupleType const*>(&_other))
 	{
@@ -2912,7 +3026,7 @@ bool FunctionType::operator==(Type const& _other) const
 	return true;
 }
 
-BoolResult FunctionType::isExplicitlyConvertibleTo(Type const& _convertTo) const
+BoolResult FunctionType::checkExplicitConversionTo(Type const& _convertTo) const
 {
 	if (_convertTo.category() == category())
 	{
@@ -2922,7 +3036,7 @@ BoolResult FunctionType::isExplicitlyConvertibleTo(Type const& _convertTo) const
 	return false;
 }
 
-BoolResult FunctionType::isImplicitlyConvertibleTo(Type const& _convertTo) const
+BoolResult FunctionType::checkImplicitConversionTo(Type const& _convertTo) const
 {
 	if (_convertTo.category() != category())
 		return false;
@@ -2961,7 +3075,7 @@ TypeResult FunctionType::unaryOperatorResult(Token _operator) const
 	return nullptr;
 }
 
-TypeResult FunctionType::binaryOperatorResult(Token _operator, Type const* _other) const
+TypeResult FunctionType::makeBinaryOperatorResult(Token _operator, Type const* _other) const
 {
 	if (_other->category() != category() || !(_operator == Token::Equal || _operator == Token::NotEqual))
 		return nullptr;
@@ -3387,6 +3501,9 @@ bool FunctionType::isBareCall() const
 
 string FunctionType::externalSignature() const
 {
+	if (optional<string> cached = cachedValue(m_externalSignature))
+		return *cached;
+
 	solAssert(m_declaration != nullptr, "External signature of function needs declaration");
 	solAssert(!m_declaration->name().empty(), "Fallback function has no signature.");
 	switch (kind())
@@ -3419,17 +3536,42 @@ string FunctionType::externalSignature() const
 			typeName += " storage";
 		return typeName;
 	});
-	return m_declaration->name() + "(" + boost::algorithm::join(typeStrings, ",") + ")";
+	return storeCachedValue(
+		m_externalSignature,
+		m_declaration->name() + "(" + boost::algorithm::join(typeStrings, ",") + ")"
+	);
+}
+
+util::h256 FunctionType::externalSignatureHash() const
+{
+	if (optional<util::h256> cached = cachedValue(m_externalSignatureHash))
+		return *cached;
+	return storeCachedValue(m_externalSignatureHash, util::keccak256(externalSignature()));
+}
+
+void FunctionType::cacheExternalSignatureHashes(vector<FunctionType const*> const& _functions)
+{
+	vector<FunctionType const*> uncached;
+	for (FunctionType const* function: _functions)
+		if (!cachedValue(function->m_externalSignatureHash))
+			uncached.push_back(function);
+
+	vector<string> signatures;
+	for (FunctionType const* function: uncached)
+		signatures.emplace_back(function->externalSignature());
+	vector<util::h256> hashes = util::keccak256Batch(vector<bytesConstRef>(signatures.begin(), signatures.end()));
+	for (size_t i = 0; i < uncached.size(); ++i)
+		storeCachedValue(uncached[i]->m_externalSignatureHash, hashes[i]);
 }
 
 u256 FunctionType::externalIdentifier() const
 {
-	return util::selectorFromSignature32(externalSignature());
+	return u256(util::FixedHash<4>::Arith(util::FixedHash<4>(externalSignatureHash())));
 }
 
 string FunctionType::externalIdentifierHex() const
 {
-	return util::FixedHash<4>(util::keccak256(externalSignature())).hex();
+	return util::FixedHash<4>(externalSignatureHash()).hex();
 }
 
 bool FunctionType::isPure() const
@@ -3741,7 +3883,7 @@ MemberList::MemberMap TypeType::nativeMembers(ASTNode const* _currentScope) cons
 	return members;
 }
 
-BoolResult TypeType::isExplicitlyConvertibleTo(Type const& _convertTo) const
+BoolResult TypeType::checkExplicitConversionTo(Type const& _convertTo) const
 {
 	if (auto const* address = dynamic_cast<AddressType const*>(&_convertTo))
 		if (address->stateMutability() == StateMutability::NonPayable)
@@ -27,14 +27,18 @@
 #include <libsolidity/ast/ASTForward.h>
 #include <libsolidity/parsing/Token.h>
 #include <liblangutil/Exceptions.h>
+#include <liblangutil/Symbol.h>
 
 #include <libsolutil/Common.h>
 #include <libsolutil/CommonIO.h>
+#include <libsolutil/FixedHash.h>
 #include <libsolutil/LazyInit.h>
 #include <libsolutil/Result.h>
 
 #include <boost/rational.hpp>
 
+#include <atomic>
+#include <limits>
 #include <map>
 #include <memory>
 #include <optional>
@@ -103,6 +107,7 @@ public:
 		/// Manual constructor for members that are not taken from a declaration.
 		Member(char const* _name, Type const* _type):
 			name(_name),
+			symbol(name),
 			type(_type),
 			declaration(nullptr)
 		{
@@ -113,6 +118,8 @@ public:
 		Member(Declaration const* _declaration, Type const* _type, std::string _name);
 
 		std::string name;
+		/// Interned @a name, used to look up members.
+		langutil::Symbol symbol;
 		Type const* type = nullptr;
 		Declaration const* declaration = nullptr;
 	};
@@ -122,25 +129,27 @@ public:
 	explicit MemberList(MemberMap _members): m_memberTypes(std::move(_members)) {}
 
 	void combine(MemberList const& _other);
-	TypePointer memberType(std::string const& _name) const
+	TypePointer memberType(langutil::Symbol _name) const
 	{
 		TypePointer type = nullptr;
 		for (auto const& it: m_memberTypes)
-			if (it.name == _name)
+			if (it.symbol == _name)
 			{
 				solAssert(!type, "Requested member type by non-unique name.");
 				type = it.type;
 			}
 		return type;
 	}
-	MemberMap membersByName(std::string const& _name) const
+	TypePointer memberType(std::string const& _name) const { return memberType(langutil::Symbol(_name)); }
+	MemberMap membersByName(langutil::Symbol _name) const
 	{
 		MemberMap members;
 		for (auto const& it: m_memberTypes)
-			if (it.name == _name)
+			if (it.symbol == _name)
 				members.push_back(it);
 		return members;
 	}
+	MemberMap membersByName(std::string const& _name) const { return membersByName(langutil::Symbol(_name)); }
 	/// @returns the offset of the given member in storage slots and bytes inside a slot or
 	/// a nullptr if the member is not part of storage.
 	std::pair<u256, unsigned> const* memberStorageOffset(std::string const& _name) const;
@@ -180,7 +189,8 @@ public:
 		InaccessibleDynamic
 	};
 
-	/// @returns a pointer to _a or _b if the other is implicitly convertible to it or nullptr otherwise
+	/// @returns a pointer to _a or _b if the other is implicitly convertible to it or nullptr otherwise.
+	/// The results for types of the current type provider are memoized.
 	static TypePointer commonType(Type const* _a, Type const* _b);
 
 	virtual Category category() const = 0;
@@ -201,8 +211,15 @@ public:
 	/// @returns an escaped identifier (will not contain any parenthesis or commas)
 	static std::string escapeIdentifier(std::string const& _identifier);
 
-	virtual BoolResult isImplicitlyConvertibleTo(Type const& _other) const { return *this == _other; }
-	virtual BoolResult isExplicitlyConvertibleTo(Type const& _convertTo) const
+	/// @returns whether this type is implicitly convertible to @a _other.
+	/// The results for types of the current type provider are memoized.
+	BoolResult isImplicitlyConvertibleTo(Type const& _other) const;
+	/// @returns whether this type is explicitly convertible to @a _convertTo.
+	/// The results for types of the current type provider are memoized.
+	BoolResult isExplicitlyConvertibleTo(Type const& _convertTo) const;
+	/// Implementations of isImplicitlyConvertibleTo and isExplicitlyConvertibleTo.
+	virtual BoolResult checkImplicitConversionTo(Type const& _other) const { return *this == _other; }
+	virtual BoolResult checkExplicitConversionTo(Type const& _convertTo) const
 	{
 		return isImplicitlyConvertibleTo(_convertTo);
 	}
@@ -212,8 +229,11 @@ public:
 	virtual TypeResult unaryOperatorResult(Token) const { return nullptr; }
 	/// @returns the resulting type of applying the given binary operator or an empty pointer if
 	/// this is not possible.
+	/// The results for types of the current type provider are memoized.
+	TypeResult binaryOperatorResult(Token _operator, Type const* _other) const;
+	/// Implementation of binaryOperatorResult.
 	/// The default implementation allows comparison operators if a common type exists
-	virtual TypeResult binaryOperatorResult(Token _operator, Type const* _other) const
+	virtual TypeResult makeBinaryOperatorResult(Token _operator, Type const* _other) const
 	{
 		return TokenTraits::isCompareOp(_operator) ? commonType(this, _other) : nullptr;
 	}
@@ -294,25 +314,26 @@ public:
 	/// - Each named stack item is typed and contributes the stack slots given by the stack items of its type.
 	std::vector<std::tuple<std::string, TypePointer>> const& stackItems() const
 	{
-		if (!m_stackItems)
-			m_stackItems = makeStackItems();
+		if (!m_hasStackItems.load(std::memory_order_acquire))
+			initStackItems();
 		return *m_stackItems;
 	}
 	/// Total number of stack slots occupied by this type. This is the sum of ``sizeOnStack`` of all ``stackItems()``.
 	// TODO: consider changing the return type to be size_t
 	unsigned sizeOnStack() const
 	{
-		if (!m_stackSize)
+		size_t sizeOnStack = m_stackSize.load(std::memory_order_relaxed);
+		if (sizeOnStack == unknownStackSize)
 		{
-			size_t sizeOnStack = 0;
+			sizeOnStack = 0;
 			for (auto const& slot: stackItems())
 				if (std::get<1>(slot))
 					sizeOnStack += std::get<1>(slot)->sizeOnStack();
 				else
 					++sizeOnStack;
-			m_stackSize = sizeOnStack;
+			m_stackSize.store(sizeOnStack, std::memory_order_relaxed);
 		}
-		return static_cast<unsigned>(*m_stackSize);
+		return static_cast<unsigned>(sizeOnStack);
 	}
 	/// If it is possible to initialize such a value in memory by just writing zeros
 	/// of the size memoryHeadSize().
@@ -380,9 +401,19 @@ public:
 	virtual void clearCache() const;
 
 private:
+	friend class TypeProvider;
+
 	/// @returns a member list containing all members added to this type by `using for` directives.
 	static MemberList::MemberMap boundFunctions(Type const& _type, ASTNode const& _scope);
 
+	/// Computes and stores the stack items, unless another thread did so in the meantime.
+	void initStackItems() const;
+
+	static size_t constexpr unknownStackSize = std::numeric_limits<size_t>::max();
+
+	/// The type provider that owns this type, if any.
+	TypeProvider const* m_provider = nullptr;
+
 protected:
 	/// @returns the members native to this type depending on the given context. This function
 	/// is used (in conjunction with boundFunctions to fill m_members below.
@@ -399,9 +430,13 @@ protected:
 
 
 	/// List of member types (parameterised by scape), will be lazy-initialized.
+	/// The lazily initialized values of all types are guarded by a common mutex, because code
+	/// can be generated for different functions concurrently.
 	mutable std::map<ASTNode const*, std::unique_ptr<MemberList>> m_members;
 	mutable std::optional<std::vector<std::tuple<std::string, TypePointer>>> m_stackItems;
-	mutable std::optional<size_t> m_stackSize;
+	/// Whether m_stackItems is set. Allows reading it without locking.
+	mutable std::atomic<bool> m_hasStackItems{false};
+	mutable std::atomic<size_t> m_stackSize{unknownStackSize};
 };
 
 /**
@@ -415,10 +450,10 @@ public:
 	Category category() const override { return Category::Address; }
 
 	std::string richIdentifier() const override;
-	BoolResult isImplicitlyConvertibleTo(Type const& _other) const override;
-	BoolResult isExplicitlyConvertibleTo(Type const& _convertTo) const override;
+	BoolResult checkImplicitConversionTo(Type const& _other) const override;
+	BoolResult checkExplicitConversionTo(Type const& _convertTo) const override;
 	TypeResult unaryOperatorResult(Token _operator) const override;
-	TypeResult binaryOperatorResult(Token _operator, Type const* _other) const override;
+	TypeResult makeBinaryOperatorResult(Token _operator, Type const* _other) const override;
 
 	bool operator==(Type const& _other) const override;
 
@@ -460,10 +495,10 @@ public:
 	Category category() const override { return Category::Integer; }
 
 	std::string richIdentifier() const override;
-	BoolResult isImplicitlyConvertibleTo(Type const& _convertTo) const override;
-	BoolResult isExplicitlyConvertibleTo(Type const& _convertTo) const override;
+	BoolResult checkImplicitConversionTo(Type const& _convertTo) const override;
+	BoolResult checkExplicitConversionTo(Type const& _convertTo) const override;
 	TypeResult unaryOperatorResult(Token _operator) const override;
-	TypeResult binaryOperatorResult(Token _operator, Type const* _other) const override;
+	TypeResult makeBinaryOperatorResult(Token _operator, Type const* _other) const override;
 
 	bool operator==(Type const& _other) const override;
 
@@ -507,10 +542,10 @@ public:
 	Category category() const override { return Category::FixedPoint; }
 
 	std::string richIdentifier() const override;
-	BoolResult isImplicitlyConvertibleTo(Type const& _convertTo) const override;
-	BoolResult isExplicitlyConvertibleTo(Type const& _convertTo) const override;
+	BoolResult checkImplicitConversionTo(Type const& _convertTo) const override;
+	BoolResult checkExplicitConversionTo(Type const& _convertTo) const override;
 	TypeResult unaryOperatorResult(Token _operator) const override;
-	TypeResult binaryOperatorResult(Token _operator, Type const* _other) const override;
+	TypeResult makeBinaryOperatorResult(Token _operator, Type const* _other) const override;
 
 	bool operator==(Type const& _other) const override;
 
@@ -560,10 +595,10 @@ public:
 
 	Category category() const override { return Category::RationalNumber; }
 
-	BoolResult isImplicitlyConvertibleTo(Type const& _convertTo) const override;
-	BoolResult isExplicitlyConvertibleTo(Type const& _convertTo) const override;
+	BoolResult checkImplicitConversionTo(Type const& _convertTo) const override;
+	BoolResult checkExplicitConversionTo(Type const& _convertTo) const override;
 	TypeResult unaryOperatorResult(Token _operator) const override;
-	TypeResult binaryOperatorResult(Token _operator, Type const* _other) const override;
+	TypeResult makeBinaryOperatorResult(Token _operator, Type const* _other) const override;
 
 	std::string richIdentifier() const override;
 	bool operator==(Type const& _other) const override;
@@ -624,8 +659,8 @@ public:
 
 	Category category() const override { return Category::StringLiteral; }
 
-	BoolResult isImplicitlyConvertibleTo(Type const& _convertTo) const override;
-	TypeResult binaryOperatorResult(Token, Type const*) const override
+	BoolResult checkImplicitConversionTo(Type const& _convertTo) const override;
+	TypeResult makeBinaryOperatorResult(Token, Type const*) const override
 	{
 		return nullptr;
 	}
@@ -656,12 +691,12 @@ public:
 
 	Category category() const override { return Category::FixedBytes; }
 
-	BoolResult isImplicitlyConvertibleTo(Type const& _convertTo) const override;
-	BoolResult isExplicitlyConvertibleTo(Type const& _convertTo) const override;
+	BoolResult checkImplicitConversionTo(Type const& _convertTo) const override;
+	BoolResult checkExplicitConversionTo(Type const& _convertTo) const override;
 	std::string richIdentifier() const override;
 	bool operator==(Type const& _other) const override;
 	TypeResult unaryOperatorResult(Token _operator) const override;
-	TypeResult binaryOperatorResult(Token _operator, Type const* _other) const override;
+	TypeResult makeBinaryOperatorResult(Token _operator, Type const* _other) const override;
 
 	unsigned calldataEncodedSize(bool _padded) const override { return _padded && m_bytes > 0 ? 32 : m_bytes; }
 	unsigned storageBytes() const override { return m_bytes; }
@@ -689,7 +724,7 @@ public:
 	Category category() const override { return Category::Bool; }
 	std::string richIdentifier() const override { return "t_bool"; }
 	TypeResult unaryOperatorResult(Token _operator) const override;
-	TypeResult binaryOperatorResult(Token _operator, Type const* _other) const override;
+	TypeResult makeBinaryOperatorResult(Token _operator, Type const* _other) const override;
 
 	unsigned calldataEncodedSize(bool _padded) const override{ return _padded ? 32 : 1; }
 	unsigned storageBytes() const override { return 1; }
@@ -742,7 +777,7 @@ public:
 	DataLocation location() const { return m_location; }
 
 	TypeResult unaryOperatorResult(Token _operator) const override;
-	TypeResult binaryOperatorResult(Token, Type const*) const override
+	TypeResult makeBinaryOperatorResult(Token, Type const*) const override
 	{
 		return nullptr;
 	}
@@ -819,8 +854,8 @@ public:
 
 	Category category() const override { return Category::Array; }
 
-	BoolResult isImplicitlyConvertibleTo(Type const& _convertTo) const override;
-	BoolResult isExplicitlyConvertibleTo(Type const& _convertTo) const override;
+	BoolResult checkImplicitConversionTo(Type const& _convertTo) const override;
+	BoolResult checkExplicitConversionTo(Type const& _convertTo) const override;
 	std::string richIdentifier() const override;
 	bool operator==(Type const& _other) const override;
 	unsigned calldataEncodedSize(bool) const override;
@@ -887,7 +922,7 @@ public:
 	explicit ArraySliceType(ArrayType const& _arrayType): ReferenceType(_arrayType.location()), m_arrayType(_arrayType) {}
 	Category category() const override { return Category::ArraySlice; }
 
-	BoolResult isImplicitlyConvertibleTo(Type const& _other) const override;
+	BoolResult checkImplicitConversionTo(Type const& _other) const override;
 	std::string richIdentifier() const override;
 	bool operator==(Type const& _other) const override;
 	unsigned calldataEncodedSize(bool) const override { solAssert(false, ""); }
@@ -923,9 +958,9 @@ public:
 
 	Category category() const override { return Category::Contract; }
 	/// Contracts can be implicitly converted only to base contracts.
-	BoolResult isImplicitlyConvertibleTo(Type const& _convertTo) const override;
+	BoolResult checkImplicitConversionTo(Type const& _convertTo) const override;
 	/// Contracts can only be explicitly converted to address types and base contracts.
-	BoolResult isExplicitlyConvertibleTo(Type const& _convertTo) const override;
+	BoolResult checkExplicitConversionTo(Type const& _convertTo) const override;
 	TypeResult unaryOperatorResult(Token _operator) const override;
 	std::string richIdentifier() const override;
 	bool operator==(Type const& _other) const override;
@@ -976,7 +1011,7 @@ private:
 	/// If true, this is a special "super" type of m_contract containing only members that m_contract inherited
 	bool m_super = false;
 	/// Type of the constructor, @see constructorType. Lazily initialized.
-	mutable FunctionType const* m_constructorType = nullptr;
+	mutable std::optional<FunctionType const*> m_constructorType;
 };
 
 /**
@@ -989,7 +1024,7 @@ public:
 		ReferenceType(_location), m_struct(_struct) {}
 
 	Category category() const override { return Category::Struct; }
-	BoolResult isImplicitlyConvertibleTo(Type const& _convertTo) const override;
+	BoolResult checkImplicitConversionTo(Type const& _convertTo) const override;
 	std::string richIdentifier() const override;
 	bool operator==(Type const& _other) const override;
 	unsigned calldataEncodedSize(bool) const override;
@@ -1016,6 +1051,10 @@ public:
 	std::string canonicalName() const override;
 	std::string signatureInExternalFunction(bool _structsByName) const override;
 
+	/// @returns an identifier like identifier() that only depends on the location and the member
+	/// types, i.e. that is the same for all structs with the same layout.
+	std::string layoutIdentifier() const;
+
 	/// @returns a function that performs the type conversion between a list of struct members
 	/// and a memory struct of this type.
 	FunctionType const* constructorType() const;
@@ -1036,6 +1075,9 @@ protected:
 	std::vector<Type const*> decomposition() const override;
 
 private:
+	/// @returns the layout identifier before escaping.
+	std::string richLayoutIdentifier() const;
+
 	StructDefinition const& m_struct;
 	// Caches for interfaceType(bool)
 	mutable std::optional<TypeResult> m_interfaceType;
@@ -1065,7 +1107,7 @@ public:
 	bool isValueType() const override { return true; }
 	bool nameable() const override { return true; }
 
-	BoolResult isExplicitlyConvertibleTo(Type const& _convertTo) const override;
+	BoolResult checkExplicitConversionTo(Type const& _convertTo) const override;
 	TypePointer encodingType() const override;
 	TypeResult interfaceType(bool _inLibrary) const override
 	{
@@ -1092,10 +1134,10 @@ public:
 
 	Category category() const override { return Category::Tuple; }
 
-	BoolResult isImplicitlyConvertibleTo(Type const& _other) const override;
+	BoolResult checkImplicitConversionTo(Type const& _other) const override;
 	std::string richIdentifier() const override;
 	bool operator==(Type const& _other) const override;
-	TypeResult binaryOperatorResult(Token, Type const*) const override { return nullptr; }
+	TypeResult makeBinaryOperatorResult(Token, Type const*) const override { return nullptr; }
 	std::string toString(bool) const override;
 	bool canBeStored() const override { return false; }
 	u256 storageSize() const override;
@@ -1262,10 +1304,10 @@ public:
 
 	std::string richIdentifier() const override;
 	bool operator==(Type const& _other) const override;
-	BoolResult isImplicitlyConvertibleTo(Type const& _convertTo) const override;
-	BoolResult isExplicitlyConvertibleTo(Type const& _convertTo) const override;
+	BoolResult checkImplicitConversionTo(Type const& _convertTo) const override;
+	BoolResult checkExplicitConversionTo(Type const& _convertTo) const override;
 	TypeResult unaryOperatorResult(Token _operator) const override;
-	TypeResult binaryOperatorResult(Token, Type const*) const override;
+	TypeResult makeBinaryOperatorResult(Token, Type const*) const override;
 	std::string canonicalName() const override;
 	std::string toString(bool _short) const override;
 	unsigned calldataEncodedSize(bool _padded) const override;
@@ -1310,6 +1352,10 @@ public:
 	StateMutability stateMutability() const { return m_stateMutability; }
 	/// @returns the external signature of this function type given the function name
 	std::string externalSignature() const;
+	/// @returns the Keccak-256 hash of the external signature, which is the topic of events.
+	util::h256 externalSignatureHash() const;
+	/// Computes the hashes of the external signatures of all @a _functions that are not cached yet at once.
+	static void cacheExternalSignatureHashes(std::vector<FunctionType const*> const& _functions);
 	/// @returns the external identifier of this function (the hash of the signature).
 	u256 externalIdentifier() const;
 	/// @returns the external identifier of this function (the hash of the signature) as a hex string.
@@ -1392,6 +1438,10 @@ private:
 	bool const m_bound = false;
 	Declaration const* m_declaration = nullptr;
 	bool m_saltSet = false; ///< true iff the salt value to be used is on the stack
+	/// The external signature and its hash, which are lazily initialized, because they are
+	/// requested for the same function by the analysis, the ABI and the code generators.
+	mutable std::optional<std::string> m_externalSignature;
+	mutable std::optional<util::h256> m_externalSignatureHash;
 };
 
 /**
@@ -1411,7 +1461,7 @@ public:
 	std::string toString(bool _short) const override;
 	std::string canonicalName() const override;
 	bool containsNestedMapping() const override { return true; }
-	TypeResult binaryOperatorResult(Token, Type const*) const override { return nullptr; }
+	TypeResult makeBinaryOperatorResult(Token, Type const*) const override { return nullptr; }
 	Type const* encodingType() const override;
 	TypeResult interfaceType(bool _inLibrary) const override;
 	bool dataStoredIn(DataLocation _location) const override { return _location == DataLocation::Storage; }
@@ -1443,7 +1493,7 @@ public:
 	Category category() const override { return Category::TypeType; }
 	Type const* actualType() const { return m_actualType; }
 
-	TypeResult binaryOperatorResult(Token, Type const*) const override { return nullptr; }
+	TypeResult makeBinaryOperatorResult(Token, Type const*) const override { return nullptr; }
 	std::string richIdentifier() const override;
 	bool operator==(Type const& _other) const override;
 	bool canBeStored() const override { return false; }
@@ -1452,7 +1502,7 @@ public:
 	std::string toString(bool _short) const override { return "type(" + m_actualType->toString(_short) + ")"; }
 	MemberList::MemberMap nativeMembers(ASTNode const* _currentScope) const override;
 
-	BoolResult isExplicitlyConvertibleTo(Type const& _convertTo) const override;
+	BoolResult checkExplicitConversionTo(Type const& _convertTo) const override;
 protected:
 	std::vector<std::tuple<std::string, TypePointer>> makeStackItems() const override;
 private:
@@ -1470,7 +1520,7 @@ public:
 
 	Category category() const override { return Category::Modifier; }
 
-	TypeResult binaryOperatorResult(Token, Type const*) const override { return nullptr; }
+	TypeResult makeBinaryOperatorResult(Token, Type const*) const override { return nullptr; }
 	bool canBeStored() const override { return false; }
 	u256 storageSize() const override;
 	bool hasSimpleZeroValueInMemory() const override { solAssert(false, ""); }
@@ -1495,7 +1545,7 @@ public:
 
 	Category category() const override { return Category::Module; }
 
-	TypeResult binaryOperatorResult(Token, Type const*) const override { return nullptr; }
+	TypeResult makeBinaryOperatorResult(Token, Type const*) const override { return nullptr; }
 	std::string richIdentifier() const override;
 	bool operator==(Type const& _other) const override;
 	bool canBeStored() const override { return false; }
@@ -1530,7 +1580,7 @@ public:
 
 	Category category() const override { return Category::Magic; }
 
-	TypeResult binaryOperatorResult(Token, Type const*) const override
+	TypeResult makeBinaryOperatorResult(Token, Type const*) const override
 	{
 		return nullptr;
 	}
@@ -1565,9 +1615,9 @@ public:
 	Category category() const override { return Category::InaccessibleDynamic; }
 
 	std::string richIdentifier() const override { return "t_inaccessible"; }
-	BoolResult isImplicitlyConvertibleTo(Type const&) const override { return false; }
-	BoolResult isExplicitlyConvertibleTo(Type const&) const override { return false; }
-	TypeResult binaryOperatorResult(Token, Type const*) const override { return nullptr; }
+	BoolResult checkImplicitConversionTo(Type const&) const override { return false; }
+	BoolResult checkExplicitConversionTo(Type const&) const override { return false; }
+	TypeResult makeBinaryOperatorResult(Token, Type const*) const override { return nullptr; }
 	unsigned calldataEncodedSize(bool) const override { return 32; }
 	bool canBeStored() const override { return false; }
 	bool isValueType() const override { return true; }
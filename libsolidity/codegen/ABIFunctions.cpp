@@ -58,10 +58,10 @@ string ABIFunctions::tupleEncoder(
 
 	string functionName = string("abi_encode_tuple_");
 	for (auto const& t: _givenTypes)
-		functionName += t->identifier() + "_";
+		functionName += coderIdentifier(*t) + "_";
 	functionName += "_to_";
 	for (auto const& t: _targetTypes)
-		functionName += t->identifier() + "_";
+		functionName += coderIdentifier(*t) + "_";
 	functionName += options.toFunctionNameSuffix();
 	if (_reversed)
 		functionName += "_reversed";
@@ -137,10 +137,10 @@ string ABIFunctions::tupleEncoderPacked(
 
 	string functionName = string("abi_encode_tuple_packed_");
 	for (auto const& t: _givenTypes)
-		functionName += t->identifier() + "_";
+		functionName += coderIdentifier(*t) + "_";
 	functionName += "_to_";
 	for (auto const& t: _targetTypes)
-		functionName += t->identifier() + "_";
+		functionName += coderIdentifier(*t) + "_";
 	functionName += options.toFunctionNameSuffix();
 	if (_reversed)
 		functionName += "_reversed";
@@ -194,7 +194,7 @@ string ABIFunctions::tupleDecoder(TypePointers const& _types, bool _fromMemory)
 {
 	string functionName = string("abi_decode_tuple_");
 	for (auto const& t: _types)
-		functionName += t->identifier();
+		functionName += coderIdentifier(*t);
 	if (_fromMemory)
 		functionName += "_fromMemory";
 
@@ -351,9 +351,9 @@ string ABIFunctions::abiEncodingFunction(
 	solAssert(to.calldataEncodedSize() == 32, "");
 	string functionName =
 		"abi_encode_" +
-		_from.identifier() +
+		coderIdentifier(_from) +
 		"_to_" +
-		to.identifier() +
+		coderIdentifier(to) +
 		_options.toFunctionNameSuffix();
 	return createFunction(functionName, [&]() {
 		solAssert(!to.isDynamicallyEncoded(), "");
@@ -397,9 +397,9 @@ string ABIFunctions::abiEncodeAndReturnUpdatedPosFunction(
 {
 	string functionName =
 		"abi_encodeUpdatedPos_" +
-		_givenType.identifier() +
+		coderIdentifier(_givenType) +
 		"_to_" +
-		_targetType.identifier() +
+		coderIdentifier(_targetType) +
 		_options.toFunctionNameSuffix();
 	return createFunction(functionName, [&]() {
 		string values = suffixedVariableNameList("value", 0, numVariablesForType(_givenType, _options));
@@ -463,9 +463,9 @@ string ABIFunctions::abiEncodingFunctionCalldataArrayWithoutCleanup(
 
 	string functionName =
 		"abi_encode_" +
-		_from.identifier() +
+		coderIdentifier(_from) +
 		"_to_" +
-		_to.identifier() +
+		coderIdentifier(_to) +
 		_options.toFunctionNameSuffix();
 	return createFunction(functionName, [&]() {
 		bool needsPadding = _options.padded && fromArrayType.isByteArray();
@@ -496,8 +496,8 @@ string ABIFunctions::abiEncodingFunctionCalldataArrayWithoutCleanup(
 					.render()
 					// TODO add revert test
 				);
-			templ("readableTypeNameFrom", _from.toString(true));
-			templ("readableTypeNameTo", _to.toString(true));
+			templ("readableTypeNameFrom", readableTypeName(_from));
+			templ("readableTypeNameTo", readableTypeName(_to));
 			templ("copyFun", m_utils.copyToMemoryFunction(true));
 			templ("lengthPadded", needsPadding ? m_utils.roundUpFunction() + "(length)" : "length");
 			return templ.render();
@@ -512,8 +512,8 @@ string ABIFunctions::abiEncodingFunctionCalldataArrayWithoutCleanup(
 				}
 			)");
 			templ("functionName", functionName);
-			templ("readableTypeNameFrom", _from.toString(true));
-			templ("readableTypeNameTo", _to.toString(true));
+			templ("readableTypeNameFrom", readableTypeName(_from));
+			templ("readableTypeNameTo", readableTypeName(_to));
 			templ("copyFun", m_utils.copyToMemoryFunction(true));
 			templ("byteLength", toCompactHexWithPrefix(fromArrayType.length() * fromArrayType.calldataStride()));
 			return templ.render();
@@ -529,9 +529,9 @@ string ABIFunctions::abiEncodingFunctionSimpleArray(
 {
 	string functionName =
 		"abi_encode_" +
-		_from.identifier() +
+		coderIdentifier(_from) +
 		"_to_" +
-		_to.identifier() +
+		coderIdentifier(_to) +
 		_options.toFunctionNameSuffix();
 
 	solAssert(_from.isDynamicallySized() == _to.isDynamicallySized(), "");
@@ -601,8 +601,8 @@ string ABIFunctions::abiEncodingFunctionSimpleArray(
 			templ("maybeLength", "");
 			templ("declareLength", "let length := " + m_utils.arrayLengthFunction(_from) + "(value)");
 		}
-		templ("readableTypeNameFrom", _from.toString(true));
-		templ("readableTypeNameTo", _to.toString(true));
+		templ("readableTypeNameFrom", readableTypeName(_from));
+		templ("readableTypeNameTo", readableTypeName(_to));
 		templ("return", dynamic ? " -> end " : "");
 		templ("assignEnd", dynamic ? "end := pos" : "");
 		templ("storeLength", arrayStoreLengthForEncodingFunction(_to, _options));
@@ -639,9 +639,9 @@ string ABIFunctions::abiEncodingFunctionMemoryByteArray(
 {
 	string functionName =
 		"abi_encode_" +
-		_from.identifier() +
+		coderIdentifier(_from) +
 		"_to_" +
-		_to.identifier() +
+		coderIdentifier(_to) +
 		_options.toFunctionNameSuffix();
 
 	solAssert(_from.isDynamicallySized() == _to.isDynamicallySized(), "");
@@ -676,9 +676,9 @@ string ABIFunctions::abiEncodingFunctionCompactStorageArray(
 {
 	string functionName =
 		"abi_encode_" +
-		_from.identifier() +
+		coderIdentifier(_from) +
 		"_to_" +
-		_to.identifier() +
+		coderIdentifier(_to) +
 		_options.toFunctionNameSuffix();
 
 	solAssert(_from.isDynamicallySized() == _to.isDynamicallySized(), "");
@@ -714,8 +714,8 @@ string ABIFunctions::abiEncodingFunctionCompactStorageArray(
 				}
 			)");
 			templ("functionName", functionName);
-			templ("readableTypeNameFrom", _from.toString(true));
-			templ("readableTypeNameTo", _to.toString(true));
+			templ("readableTypeNameFrom", readableTypeName(_from));
+			templ("readableTypeNameTo", readableTypeName(_to));
 			templ("byteArrayLengthFunction", m_utils.extractByteArrayLengthFunction());
 			templ("storeLength", arrayStoreLengthForEncodingFunction(_to, _options));
 			templ("lengthPaddedShort", _options.padded ? "0x20" : "length");
@@ -774,8 +774,8 @@ string ABIFunctions::abiEncodingFunctionCompactStorageArray(
 				)"
 			);
 			templ("functionName", functionName);
-			templ("readableTypeNameFrom", _from.toString(true));
-			templ("readableTypeNameTo", _to.toString(true));
+			templ("readableTypeNameFrom", readableTypeName(_from));
+			templ("readableTypeNameTo", readableTypeName(_to));
 			templ("return", dynamic ? " -> end " : "");
 			templ("assignEnd", dynamic ? "end := pos" : "");
 			templ("lengthFun", m_utils.arrayLengthFunction(_from));
@@ -827,9 +827,9 @@ string ABIFunctions::abiEncodingFunctionStruct(
 {
 	string functionName =
 		"abi_encode_" +
-		_from.identifier() +
+		coderIdentifier(_from) +
 		"_to_" +
-		_to.identifier() +
+		coderIdentifier(_to) +
 		_options.toFunctionNameSuffix();
 
 	solAssert(&_from.structDefinition() == &_to.structDefinition(), "");
@@ -843,7 +843,7 @@ string ABIFunctions::abiEncodingFunctionStruct(
 				<init>
 				<#members>
 				{
-					// <memberName>
+					// <memberType>
 					<preprocess>
 					let <memberValues> := <retrieveValue>
 					<encode>
@@ -853,8 +853,8 @@ string ABIFunctions::abiEncodingFunctionStruct(
 			}
 		)");
 		templ("functionName", functionName);
-		templ("readableTypeNameFrom", _from.toString(true));
-		templ("readableTypeNameTo", _to.toString(true));
+		templ("readableTypeNameFrom", readableTypeName(_from));
+		templ("readableTypeNameTo", readableTypeName(_to));
 		templ("return", dynamic ? " -> end " : "");
 		if (dynamic && _options.dynamicInplace)
 			templ("assignEnd", "end := pos");
@@ -955,7 +955,7 @@ string ABIFunctions::abiEncodingFunctionStruct(
 			}
 			members.back()["encode"] = encode;
 
-			members.back()["memberName"] = member.name;
+			members.back()["memberType"] = readableTypeName(*member.type);
 		}
 		templ("members", members);
 		if (_options.dynamicInplace)
@@ -975,9 +975,9 @@ string ABIFunctions::abiEncodingFunctionStringLiteral(
 
 	string functionName =
 		"abi_encode_" +
-		_from.identifier() +
+		coderIdentifier(_from) +
 		"_to_" +
-		_to.identifier() +
+		coderIdentifier(_to) +
 		_options.toFunctionNameSuffix();
 	return createFunction(functionName, [&]() {
 		auto const& strType = dynamic_cast<StringLiteralType const&>(_from);
@@ -1037,9 +1037,9 @@ string ABIFunctions::abiEncodingFunctionFunctionType(
 
 	string functionName =
 		"abi_encode_" +
-		_from.identifier() +
+		coderIdentifier(_from) +
 		"_to_" +
-		_to.identifier() +
+		coderIdentifier(_to) +
 		_options.toFunctionNameSuffix();
 
 	if (_options.encodeFunctionFromStack)
@@ -1114,7 +1114,7 @@ string ABIFunctions::abiDecodingFunctionValueType(Type const& _type, bool _fromM
 
 	string functionName =
 		"abi_decode_" +
-		_type.identifier() +
+		coderIdentifier(_type) +
 		(_fromMemory ? "_fromMemory" : "");
 	return createFunction(functionName, [&]() {
 		Whiskers templ(R"(
@@ -1139,7 +1139,7 @@ string ABIFunctions::abiDecodingFunctionArray(ArrayType const& _type, bool _from
 
 	string functionName =
 		"abi_decode_" +
-		_type.identifier() +
+		coderIdentifier(_type) +
 		(_fromMemory ? "_fromMemory" : "");
 
 	return createFunction(functionName, [&]() {
@@ -1157,7 +1157,7 @@ string ABIFunctions::abiDecodingFunctionArray(ArrayType const& _type, bool _from
 		// TODO add test
 		templ("revertString", revertReasonIfDebug("ABI decoding: invalid calldata array offset"));
 		templ("functionName", functionName);
-		templ("readableTypeName", _type.toString(true));
+		templ("readableTypeName", readableTypeName(_type));
 		templ("retrieveLength", _type.isDynamicallySized() ? (load + "(offset)") : toCompactHexWithPrefix(_type.length()));
 		templ("offset", _type.isDynamicallySized() ? "add(offset, 0x20)" : "offset");
 		templ("abiDecodeAvailableLen", abiDecodingFunctionArrayAvailableLength(_type, _fromMemory));
@@ -1173,7 +1173,7 @@ string ABIFunctions::abiDecodingFunctionArrayAvailableLength(ArrayType const& _t
 
 	string functionName =
 		"abi_decode_available_length_" +
-		_type.identifier() +
+		coderIdentifier(_type) +
 		(_fromMemory ? "_fromMemory" : "");
 
 	return createFunction(functionName, [&]() {
@@ -1185,17 +1185,21 @@ string ABIFunctions::abiDecodingFunctionArrayAvailableLength(ArrayType const& _t
 				<storeLength>
 				let src := offset
 				<staticBoundsCheck>
-				for { let i := 0 } lt(i, length) { i := add(i, 1) }
-				{
-					let elementPos := <retrieveElementPos>
-					mstore(dst, <decodingFun>(elementPos, end))
-					dst := add(dst, 0x20)
-					src := add(src, <stride>)
-				}
+				<?copy>
+					calldatacopy(dst, src, mul(length, <stride>))
+				<!copy>
+					for { let i := 0 } lt(i, length) { i := add(i, 1) }
+					{
+						let elementPos := <retrieveElementPos>
+						mstore(dst, <decodingFun>(elementPos, end))
+						dst := add(dst, 0x20)
+						src := add(src, <stride>)
+					}
+				</copy>
 			}
 		)");
 		templ("functionName", functionName);
-		templ("readableTypeName", _type.toString(true));
+		templ("readableTypeName", readableTypeName(_type));
 		templ("allocate", m_utils.allocationFunction());
 		templ("allocationSize", m_utils.arrayAllocationSizeFunction(_type));
 		string calldataStride = toCompactHexWithPrefix(_type.calldataStride());
@@ -1220,7 +1224,11 @@ string ABIFunctions::abiDecodingFunctionArrayAvailableLength(ArrayType const& _t
 			);
 			templ("retrieveElementPos", "src");
 		}
-		templ("decodingFun", abiDecodingFunction(*_type.baseType(), _fromMemory, false));
+		// The memory layout of the array is the same as its encoding, so it can be copied
+		// if the elements do not need validation.
+		bool copy = !_fromMemory && decodedByCopy(*_type.baseType());
+		templ("copy", copy);
+		templ("decodingFun", copy ? "" : abiDecodingFunction(*_type.baseType(), _fromMemory, false));
 		return templ.render();
 	});
 }
@@ -1235,7 +1243,7 @@ string ABIFunctions::abiDecodingFunctionCalldataArray(ArrayType const& _type)
 
 	string functionName =
 		"abi_decode_" +
-		_type.identifier();
+		coderIdentifier(_type);
 	return createFunction(functionName, [&]() {
 		Whiskers w;
 		if (_type.isDynamicallySized())
@@ -1266,7 +1274,7 @@ string ABIFunctions::abiDecodingFunctionCalldataArray(ArrayType const& _type)
 		}
 		w("revertStringPos", revertReasonIfDebug("ABI decoding: invalid calldata array stride"));
 		w("functionName", functionName);
-		w("readableTypeName", _type.toString(true));
+		w("readableTypeName", readableTypeName(_type));
 		w("stride", toCompactHexWithPrefix(_type.calldataStride()));
 
 		// TODO add test
@@ -1281,7 +1289,7 @@ string ABIFunctions::abiDecodingFunctionByteArrayAvailableLength(ArrayType const
 
 	string functionName =
 		"abi_decode_available_length_" +
-		_type.identifier() +
+		coderIdentifier(_type) +
 		(_fromMemory ? "_fromMemory" : "");
 
 	return createFunction(functionName, [&]() {
@@ -1308,7 +1316,7 @@ string ABIFunctions::abiDecodingFunctionCalldataStruct(StructType const& _type)
 	solAssert(_type.dataStoredIn(DataLocation::CallData), "");
 	string functionName =
 		"abi_decode_" +
-		_type.identifier();
+		coderIdentifier(_type);
 
 	return createFunction(functionName, [&]() {
 		Whiskers w{R"(
@@ -1321,7 +1329,7 @@ string ABIFunctions::abiDecodingFunctionCalldataStruct(StructType const& _type)
 		// TODO add test
 		w("revertString", revertReasonIfDebug("ABI decoding: struct calldata too short"));
 		w("functionName", functionName);
-		w("readableTypeName", _type.toString(true));
+		w("readableTypeName", readableTypeName(_type));
 		w("minimumSize", to_string(_type.isDynamicallyEncoded() ? _type.calldataEncodedTailSize() : _type.calldataEncodedSize(true)));
 		return w.render();
 	});
@@ -1332,7 +1340,7 @@ string ABIFunctions::abiDecodingFunctionStruct(StructType const& _type, bool _fr
 	solAssert(!_type.dataStoredIn(DataLocation::CallData), "");
 	string functionName =
 		"abi_decode_" +
-		_type.identifier() +
+		coderIdentifier(_type) +
 		(_fromMemory ? "_fromMemory" : "");
 
 	return createFunction(functionName, [&]() {
@@ -1341,22 +1349,33 @@ string ABIFunctions::abiDecodingFunctionStruct(StructType const& _type, bool _fr
 			function <functionName>(headStart, end) -> value {
 				if slt(sub(end, headStart), <minimumSize>) { <revertString> }
 				value := <allocate>(<memorySize>)
-				<#members>
-				{
-					// <memberName>
-					<decode>
-				}
-				</members>
+				<?copy>
+					calldatacopy(value, headStart, <memorySize>)
+				<!copy>
+					<#members>
+					{
+						// <memberType>
+						<decode>
+					}
+					</members>
+				</copy>
 			}
 		)");
 		// TODO add test
 		templ("revertString", revertReasonIfDebug("ABI decoding: struct data too short"));
 		templ("functionName", functionName);
-		templ("readableTypeName", _type.toString(true));
+		templ("readableTypeName", readableTypeName(_type));
 		templ("allocate", m_utils.allocationFunction());
 		solAssert(_type.memoryDataSize() < u256("0xffffffffffffffff"), "");
 		templ("memorySize", toCompactHexWithPrefix(_type.memoryDataSize()));
 		size_t headPos = 0;
+		// If all members are words that do not need validation, the memory layout of the struct
+		// is the same as its encoding.
+		bool copy = !_fromMemory;
+		for (auto const& member: _type.members(nullptr))
+			if (!member.type->decodingType() || !decodedByCopy(*member.type->decodingType()))
+				copy = false;
+		templ("copy", copy);
 		vector<map<string, string>> members;
 		for (auto const& member: _type.members(nullptr))
 		{
@@ -1379,12 +1398,14 @@ string ABIFunctions::abiDecodingFunctionStruct(StructType const& _type, bool _fr
 			memberTempl("load", _fromMemory ? "mload" : "calldataload");
 			memberTempl("pos", to_string(headPos));
 			memberTempl("memoryOffset", toCompactHexWithPrefix(_type.memoryOffsetOfMember(member.name)));
+			headPos += decodingType->calldataHeadSize();
+			if (copy)
+				continue;
 			memberTempl("abiDecode", abiDecodingFunction(*member.type, _fromMemory, false));
 
 			members.emplace_back();
 			members.back()["decode"] = memberTempl.render();
-			members.back()["memberName"] = member.name;
-			headPos += decodingType->calldataHeadSize();
+			members.back()["memberType"] = readableTypeName(*member.type);
 		}
 		templ("members", members);
 		templ("minimumSize", toCompactHexWithPrefix(headPos));
@@ -1398,7 +1419,7 @@ string ABIFunctions::abiDecodingFunctionFunctionType(FunctionType const& _type,
 
 	string functionName =
 		"abi_decode_" +
-		_type.identifier() +
+		coderIdentifier(_type) +
 		(_fromMemory ? "_fromMemory" : "") +
 		(_forUseOnStack ? "_onStack" : "");
 
@@ -1434,7 +1455,7 @@ string ABIFunctions::abiDecodingFunctionFunctionType(FunctionType const& _type,
 string ABIFunctions::calldataAccessFunction(Type const& _type)
 {
 	solAssert(_type.isValueType() || _type.dataStoredIn(DataLocation::CallData), "");
-	string functionName = "calldata_access_" + _type.identifier();
+	string functionName = "calldata_access_" + coderIdentifier(_type);
 	return createFunction(functionName, [&]() {
 		if (_type.isDynamicallyEncoded())
 		{
@@ -1513,7 +1534,7 @@ string ABIFunctions::calldataAccessFunction(Type const& _type)
 
 string ABIFunctions::arrayStoreLengthForEncodingFunction(ArrayType const& _type, EncodingOptions const& _options)
 {
-	string functionName = "array_storeLengthForEncoding_" + _type.identifier() + _options.toFunctionNameSuffix();
+	string functionName = "array_storeLengthForEncoding_" + coderIdentifier(_type) + _options.toFunctionNameSuffix();
 	return createFunction(functionName, [&]() {
 		if (_type.isDynamicallySized() && !_options.dynamicInplace)
 			return Whiskers(R"(
@@ -1537,7 +1558,7 @@ string ABIFunctions::arrayStoreLengthForEncodingFunction(ArrayType const& _type,
 
 string ABIFunctions::createFunction(string const& _name, function<string ()> const& _creator)
 {
-	return m_functionCollector.createFunction(_name, _creator);
+	return m_utils.createFunction(_name, _creator);
 }
 
 size_t ABIFunctions::headSize(TypePointers const& _targetTypes)
@@ -1549,6 +1570,35 @@ size_t ABIFunctions::headSize(TypePointers const& _targetTypes)
 	return headSize;
 }
 
+string ABIFunctions::coderIdentifier(Type const& _type)
+{
+	if (auto const* structType = dynamic_cast<StructType const*>(&_type))
+		return structType->layoutIdentifier();
+	return _type.identifier();
+}
+
+bool ABIFunctions::decodedByCopy(Type const& _type)
+{
+	if (auto const* integerType = dynamic_cast<IntegerType const*>(&_type))
+		return integerType->numBits() == 256;
+	else if (auto const* fixedBytesType = dynamic_cast<FixedBytesType const*>(&_type))
+		return fixedBytesType->numBytes() == 32;
+	else
+		return false;
+}
+
+string ABIFunctions::readableTypeName(Type const& _type)
+{
+	auto const* structType = dynamic_cast<StructType const*>(&_type);
+	if (!structType)
+		return _type.toString(true);
+
+	vector<string> memberTypes;
+	for (auto const& member: structType->members(nullptr))
+		memberTypes.emplace_back(readableTypeName(*member.type));
+	return "struct(" + joinHumanReadable(memberTypes, ",") + ")";
+}
+
 size_t ABIFunctions::numVariablesForType(Type const& _type, EncodingOptions const& _options)
 {
 	if (_type.category() == Type::Category::Function && !_options.encodeFunctionFromStack)
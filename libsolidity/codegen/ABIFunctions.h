@@ -265,6 +265,17 @@ private:
 	/// cases.
 	std::string createFunction(std::string const& _name, std::function<std::string()> const& _creator);
 
+	/// @returns the identifier of @a _type to use in the names of coder functions. Structs
+	/// with the same layout share the identifier, so that their coders are only generated once.
+	static std::string coderIdentifier(Type const& _type);
+	/// @returns the human-readable name of @a _type to use in the comments of coder functions,
+	/// which is, like coderIdentifier, the same for structs with the same layout.
+	static std::string readableTypeName(Type const& _type);
+
+	/// @returns true if every 32 byte word is a valid encoding of a value of @a _type, which is
+	/// the same as the value, i.e. decoding it from calldata to memory can copy it.
+	static bool decodedByCopy(Type const& _type);
+
 	/// @returns the size of the static part of the encoding of the given types.
 	static size_t headSize(TypePointers const& _targetTypes);
 
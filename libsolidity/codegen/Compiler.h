@@ -36,10 +36,20 @@ namespace solidity::frontend {
 class Compiler
 {
 public:
-	Compiler(langutil::EVMVersion _evmVersion, RevertStrings _revertStrings, OptimiserSettings _optimiserSettings):
+	Compiler(
+		langutil::EVMVersion _evmVersion,
+		RevertStrings _revertStrings,
+		OptimiserSettings _optimiserSettings,
+		std::shared_ptr<SharedYulFunctionCache> const& _sharedYulFunctions = {},
+		std::shared_ptr<InlineAssemblyCache> const& _inlineAssemblyCache = {},
+		size_t _parallelism = 1,
+		std::shared_ptr<evmasm::ConstantOptimisationCache> _constantCache = {}
+	):
 		m_optimiserSettings(std::move(_optimiserSettings)),
-		m_runtimeContext(_evmVersion, _revertStrings),
-		m_context(_evmVersion, _revertStrings, &m_runtimeContext)
+		m_parallelism(_parallelism),
+		m_constantCache(std::move(_constantCache)),
+		m_runtimeContext(_evmVersion, _revertStrings, nullptr, _sharedYulFunctions, _inlineAssemblyCache),
+		m_context(_evmVersion, _revertStrings, &m_runtimeContext, _sharedYulFunctions, _inlineAssemblyCache)
 	{ }
 
 	/// Compiles a contract.
@@ -67,6 +77,10 @@ public:
 
 private:
 	OptimiserSettings const m_optimiserSettings;
+	/// Number of threads used to optimise the sub-assemblies, zero meaning one per hardware thread.
+	size_t const m_parallelism = 1;
+	/// Representations of constants shared with the other contracts of the compilation, if any.
+	std::shared_ptr<evmasm::ConstantOptimisationCache> const m_constantCache;
 	CompilerContext m_runtimeContext;
 	size_t m_runtimeSub = size_t(-1); ///< Identifier of the runtime sub-assembly, if present.
 	CompilerContext m_context;
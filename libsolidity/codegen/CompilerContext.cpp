@@ -26,6 +26,7 @@
 #include <libsolidity/ast/AST.h>
 #include <libsolidity/codegen/Compiler.h>
 #include <libsolidity/codegen/CompilerUtils.h>
+#include <libsolidity/codegen/InlineAssemblyCache.h>
 #include <libsolidity/interface/Version.h>
 
 #include <libyul/AsmParser.h>
@@ -438,89 +439,121 @@ void CompilerContext::appendInlineAssembly(
 		}
 	};
 
-	ErrorList errors;
-	ErrorReporter errorReporter(errors);
-	auto scanner = make_shared<langutil::Scanner>(langutil::CharStream(_assembly, _sourceName));
 	yul::EVMDialect const& dialect = yul::EVMDialect::strictAssemblyForEVM(m_evmVersion);
 	optional<langutil::SourceLocation> locationOverride;
 	if (!_system)
 		locationOverride = m_asm->currentSourceLocation();
-	shared_ptr<yul::Block> parserResult =
-		yul::Parser(errorReporter, dialect, std::move(locationOverride))
-		.parse(scanner, false);
-#ifdef SOL_OUTPUT_ASM
-	cout << yul::AsmPrinter(&dialect)(*parserResult) << endl;
-#endif
-
-	auto reportError = [&](string const& _context)
-	{
-		string message =
-			"Error parsing/analyzing inline assembly block:\n" +
-			_context + "\n"
-			"------------------ Input: -----------------\n" +
-			_assembly + "\n"
-			"------------------ Errors: ----------------\n";
-		for (auto const& error: errorReporter.errors())
-			message += SourceReferenceFormatter::formatErrorInformation(*error);
-		message += "-------------------------------------------\n";
-
-		solAssert(false, message);
-	};
-
-	yul::AsmAnalysisInfo analysisInfo;
-	bool analyzerResult = false;
-	if (parserResult)
-		analyzerResult = yul::AsmAnalyzer(
-			analysisInfo,
-			errorReporter,
-			dialect,
-			identifierAccess.resolve
-		).analyze(*parserResult);
-	if (!parserResult || !errorReporter.errors().empty() || !analyzerResult)
-		reportError("Invalid assembly generated by code generator.");
-
 	// Several optimizer steps cannot handle externally supplied stack variables,
 	// so we essentially only optimize the ABI functions.
-	if (_optimiserSettings.runYulOptimiser && _localVariables.empty())
-	{
-		yul::Object obj;
-		obj.code = parserResult;
-		obj.analysisInfo = make_shared<yul::AsmAnalysisInfo>(analysisInfo);
+	bool const optimize = _optimiserSettings.runYulOptimiser && _localVariables.empty();
 
-		optimizeYul(obj, dialect, _optimiserSettings, externallyUsedIdentifiers);
+	// The results of a time-limited optimizer cannot be reused.
+	bool const useCache = m_inlineAssemblyCache && !(optimize && _optimiserSettings.yulOptimiserTimeBudget);
+	string cacheKey;
+	shared_ptr<InlineAssemblyCache::Entry const> cached;
+	if (useCache)
+	{
+		cacheKey = inlineAssemblyCacheKey(
+			_assembly,
+			_localVariables,
+			_externallyUsedFunctions,
+			_system,
+			optimize ? &_optimiserSettings : nullptr,
+			_sourceName,
+			locationOverride
+		);
+		cached = m_inlineAssemblyCache->find(cacheKey);
+	}
+	if (!cached)
+	{
+		ErrorList errors;
+		ErrorReporter errorReporter(errors);
+		auto scanner = make_shared<langutil::Scanner>(langutil::CharStream(_assembly, _sourceName));
+		shared_ptr<yul::Block> parserResult =
+			yul::Parser(errorReporter, dialect, std::move(locationOverride))
+			.parse(scanner, false);
+#ifdef SOL_OUTPUT_ASM
+		cout << yul::AsmPrinter(&dialect)(*parserResult) << endl;
+#endif
 
-		if (_system)
+		auto reportError = [&](string const& _context)
 		{
-			// Store as generated sources, but first re-parse to update the source references.
-			solAssert(m_generatedYulUtilityCode.empty(), "");
-			m_generatedYulUtilityCode = yul::AsmPrinter(dialect)(*obj.code);
-			string code = yul::AsmPrinter{dialect}(*obj.code);
-			scanner = make_shared<langutil::Scanner>(langutil::CharStream(m_generatedYulUtilityCode, _sourceName));
-			obj.code = yul::Parser(errorReporter, dialect).parse(scanner, false);
-			*obj.analysisInfo = yul::AsmAnalyzer::analyzeStrictAssertCorrect(dialect, obj);
-		}
+			string message =
+				"Error parsing/analyzing inline assembly block:\n" +
+				_context + "\n"
+				"------------------ Input: -----------------\n" +
+				_assembly + "\n"
+				"------------------ Errors: ----------------\n";
+			for (auto const& error: errorReporter.errors())
+				message += SourceReferenceFormatter::formatErrorInformation(*error, *scanner->charStream());
+			message += "-------------------------------------------\n";
+
+			solAssert(false, message);
+		};
+
+		auto analysisInfo = make_shared<yul::AsmAnalysisInfo>();
+		bool analyzerResult = false;
+		if (parserResult)
+			analyzerResult = yul::AsmAnalyzer(
+				*analysisInfo,
+				errorReporter,
+				dialect,
+				identifierAccess.resolve
+			).analyze(*parserResult);
+		if (!parserResult || !errorReporter.errors().empty() || !analyzerResult)
+			reportError("Invalid assembly generated by code generator.");
+
+		string generatedSource;
+		if (optimize)
+		{
+			yul::Object obj;
+			obj.code = parserResult;
+			obj.analysisInfo = analysisInfo;
+
+			optimizeYul(obj, dialect, _optimiserSettings, externallyUsedIdentifiers);
+
+			if (_system)
+			{
+				// Store as generated sources, but first re-parse to update the source references.
+				generatedSource = yul::AsmPrinter(dialect)(*obj.code);
+				scanner = make_shared<langutil::Scanner>(langutil::CharStream(generatedSource, _sourceName));
+				obj.code = yul::Parser(errorReporter, dialect).parse(scanner, false);
+				*obj.analysisInfo = yul::AsmAnalyzer::analyzeStrictAssertCorrect(dialect, obj);
+			}
 
-		analysisInfo = std::move(*obj.analysisInfo);
-		parserResult = std::move(obj.code);
+			parserResult = std::move(obj.code);
 
 #ifdef SOL_OUTPUT_ASM
-		cout << "After optimizer:" << endl;
-		cout << yul::AsmPrinter(&dialect)(*parserResult) << endl;
+			cout << "After optimizer:" << endl;
+			cout << yul::AsmPrinter(&dialect)(*parserResult) << endl;
 #endif
+		}
+		else if (_system)
+			// Store as generated source.
+			generatedSource = _assembly;
+
+		if (!errorReporter.errors().empty())
+			reportError("Failed to analyze inline assembly block.");
+
+		solAssert(errorReporter.errors().empty(), "Failed to analyze inline assembly block.");
+		cached = make_shared<InlineAssemblyCache::Entry const>(InlineAssemblyCache::Entry{
+			move(parserResult),
+			move(analysisInfo),
+			move(generatedSource)
+		});
+		if (useCache)
+			m_inlineAssemblyCache->insert(move(cacheKey), cached);
 	}
-	else if (_system)
+
+	if (_system)
 	{
-		// Store as generated source.
 		solAssert(m_generatedYulUtilityCode.empty(), "");
-		m_generatedYulUtilityCode = _assembly;
+		m_generatedYulUtilityCode = cached->generatedSource;
 	}
-
-	if (!errorReporter.errors().empty())
-		reportError("Failed to analyze inline assembly block.");
-
-	solAssert(errorReporter.errors().empty(), "Failed to analyze inline assembly block.");
+	// The code generator does not modify the analysis information, but expects it to be mutable.
+	yul::AsmAnalysisInfo analysisInfo = *cached->analysisInfo;
 	yul::CodeGenerator::assemble(
-		*parserResult,
+		*cached->code,
 		analysisInfo,
 		*m_asm,
 		m_evmVersion,
@@ -534,6 +567,48 @@ void CompilerContext::appendInlineAssembly(
 }
 
 
+string CompilerContext::inlineAssemblyCacheKey(
+	string const& _assembly,
+	vector<string> const& _localVariables,
+	set<string> const& _externallyUsedFunctions,
+	bool _system,
+	OptimiserSettings const* _optimiserSettings,
+	string const& _sourceName,
+	optional<SourceLocation> const& _locationOverride
+) const
+{
+	string key;
+	auto add = [&](string const& _value) { key += to_string(_value.size()) + ":" + _value; };
+	add(m_evmVersion.name());
+	add(_system ? "system" : "");
+	add(_sourceName);
+	if (_locationOverride)
+		add(
+			(_locationOverride->sourceName ? *_locationOverride->sourceName : "") + ":" +
+			to_string(_locationOverride->start) + ":" +
+			to_string(_locationOverride->end)
+		);
+	else
+		add("");
+	key += to_string(_localVariables.size()) + ":";
+	for (string const& variable: _localVariables)
+		add(variable);
+	if (_optimiserSettings)
+	{
+		add(_optimiserSettings->optimizeStackAllocation ? "stackOpt" : "");
+		add(_optimiserSettings->yulOptimiserSteps);
+		add(to_string(_optimiserSettings->expectedExecutionsPerDeployment));
+		add(runtimeContext() ? "creation" : "runtime");
+		key += to_string(_externallyUsedFunctions.size()) + ":";
+		for (string const& function: _externallyUsedFunctions)
+			add(function);
+	}
+	else
+		add("");
+	add(_assembly);
+	return key;
+}
+
 void CompilerContext::optimizeYul(yul::Object& _object, yul::EVMDialect const& _dialect, OptimiserSettings const& _optimiserSettings, std::set<yul::YulString> const& _externalIdentifiers)
 {
 #ifdef SOL_OUTPUT_ASM
@@ -548,7 +623,9 @@ void CompilerContext::optimizeYul(yul::Object& _object, yul::EVMDialect const& _
 		_object,
 		_optimiserSettings.optimizeStackAllocation,
 		_optimiserSettings.yulOptimiserSteps,
-		_externalIdentifiers
+		_externalIdentifiers,
+		1,
+		_optimiserSettings.yulOptimiserTimeBudget
 	);
 
 #ifdef SOL_OUTPUT_ASM
@@ -570,7 +647,7 @@ void CompilerContext::updateSourceLocation()
 evmasm::Assembly::OptimiserSettings CompilerContext::translateOptimiserSettings(OptimiserSettings const& _settings)
 {
 	// Constructing it this way so that we notice changes in the fields.
-	evmasm::Assembly::OptimiserSettings asmSettings{false, false,  false, false, false, false, false, m_evmVersion, 0};
+	evmasm::Assembly::OptimiserSettings asmSettings{false, false,  false, false, false, false, false, m_evmVersion, 0, 1, nullptr};
 	asmSettings.isCreation = true;
 	asmSettings.runInliner = _settings.runInliner;
 	asmSettings.runJumpdestRemover = _settings.runJumpdestRemover;
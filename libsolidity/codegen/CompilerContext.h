@@ -45,11 +45,13 @@
 #include <ostream>
 #include <stack>
 #include <queue>
+#include <set>
 #include <utility>
 
 namespace solidity::frontend {
 
 class Compiler;
+class InlineAssemblyCache;
 
 /**
  * Context to be shared by all units that compile the same contract.
@@ -61,13 +63,17 @@ public:
 	explicit CompilerContext(
 		langutil::EVMVersion _evmVersion,
 		RevertStrings _revertStrings,
-		CompilerContext* _runtimeContext = nullptr
+		CompilerContext* _runtimeContext = nullptr,
+		std::shared_ptr<SharedYulFunctionCache> _sharedYulFunctions = {},
+		std::shared_ptr<InlineAssemblyCache> _inlineAssemblyCache = {}
 	):
 		m_asm(std::make_shared<evmasm::Assembly>()),
 		m_evmVersion(_evmVersion),
 		m_revertStrings(_revertStrings),
 		m_reservedMemory{0},
 		m_runtimeContext(_runtimeContext),
+		m_yulFunctionCollector(std::move(_sharedYulFunctions)),
+		m_inlineAssemblyCache(std::move(_inlineAssemblyCache)),
 		m_abiFunctions(m_evmVersion, m_revertStrings, m_yulFunctionCollector),
 		m_yulUtilFunctions(m_evmVersion, m_revertStrings, m_yulFunctionCollector)
 	{
@@ -163,6 +169,10 @@ public:
 	);
 	/// Generates the code for missing low-level functions, i.e. calls the generators passed above.
 	void appendMissingLowLevelFunctions();
+	/// Sets the identifiers of the string literal types whose reverts jump to a shared low-level
+	/// function instead of encoding the reason in place.
+	void setSharedRevertReasons(std::set<std::string> _reasons) { m_sharedRevertReasons = std::move(_reasons); }
+	bool sharesRevertReason(std::string const& _identifier) const { return m_sharedRevertReasons.count(_identifier); }
 	ABIFunctions& abiFunctions() { return m_abiFunctions; }
 	YulUtilFunctions& utilFunctions() { return m_yulUtilFunctions; }
 
@@ -277,8 +287,19 @@ public:
 	/// Appends arbitrary data to the end of the bytecode.
 	void appendAuxiliaryData(bytes const& _data) { m_asm->appendAuxiliaryDataToEnd(_data); }
 
-	/// Run optimisation step.
-	void optimise(OptimiserSettings const& _settings) { m_asm->optimise(translateOptimiserSettings(_settings)); }
+	/// Run optimisation step, optimising independent sub-assemblies on up to @a _parallelism threads
+	/// and sharing the representations of constants via @a _constantCache, if given.
+	void optimise(
+		OptimiserSettings const& _settings,
+		size_t _parallelism = 1,
+		std::shared_ptr<evmasm::ConstantOptimisationCache> _constantCache = {}
+	)
+	{
+		evmasm::Assembly::OptimiserSettings settings = translateOptimiserSettings(_settings);
+		settings.parallelism = _parallelism;
+		settings.constantCache = std::move(_constantCache);
+		m_asm->optimise(settings);
+	}
 
 	/// @returns the runtime context if in creation mode and runtime context is set, nullptr otherwise.
 	CompilerContext* runtimeContext() const { return m_runtimeContext; }
@@ -311,6 +332,18 @@ private:
 
 	evmasm::Assembly::OptimiserSettings translateOptimiserSettings(OptimiserSettings const& _settings);
 
+	/// @returns the key of an inline assembly block in the inline assembly cache. The optimiser
+	/// settings are only part of the key if @a _optimiserSettings is not null.
+	std::string inlineAssemblyCacheKey(
+		std::string const& _assembly,
+		std::vector<std::string> const& _localVariables,
+		std::set<std::string> const& _externallyUsedFunctions,
+		bool _system,
+		OptimiserSettings const* _optimiserSettings,
+		std::string const& _sourceName,
+		std::optional<langutil::SourceLocation> const& _locationOverride
+	) const;
+
 	/**
 	 * Helper class that manages function labels and ensures that referenced functions are
 	 * compiled in a specific order.
@@ -367,6 +400,8 @@ private:
 	ContractDefinition const* m_mostDerivedContract = nullptr;
 	/// Whether to use checked arithmetic.
 	Arithmetic m_arithmetic = Arithmetic::Checked;
+	/// Identifiers of the string literal types whose reverts share a low-level function.
+	std::set<std::string> m_sharedRevertReasons;
 	/// Stack of current visited AST nodes, used for location attachment
 	std::stack<ASTNode const*> m_visitedNodes;
 	/// The runtime context if in Creation mode, this is used for generating tags that would be stored into the storage and then used at runtime.
@@ -377,6 +412,8 @@ private:
 	std::map<std::string, evmasm::AssemblyItem> m_lowLevelFunctions;
 	/// Collector for yul functions.
 	MultiUseYulFunctionCollector m_yulFunctionCollector;
+	/// Inline assembly blocks already parsed and analysed during this compilation.
+	std::shared_ptr<InlineAssemblyCache> m_inlineAssemblyCache;
 	/// Set of externally used yul functions.
 	std::set<std::string> m_externallyUsedYulFunctions;
 	/// Generated Yul code used as utility. Source references from the bytecode can point here.
@@ -29,6 +29,7 @@
 #include <libsolidity/codegen/ArrayUtils.h>
 #include <libsolidity/codegen/LValue.h>
 #include <libsolutil/FunctionSelector.h>
+#include <libevmasm/GasMeter.h>
 #include <libevmasm/Instruction.h>
 #include <libsolutil/Whiskers.h>
 
@@ -39,6 +40,7 @@ using namespace solidity::frontend;
 using namespace solidity::langutil;
 
 using solidity::util::Whiskers;
+using solidity::util::FixedHash;
 using solidity::util::h256;
 using solidity::util::toCompactHexWithPrefix;
 
@@ -1413,6 +1415,102 @@ unsigned CompilerUtils::sizeOnStack(vector<Type const*> const& _variableTypes)
 	return size;
 }
 
+bool CompilerUtils::splitFunctionSelector(size_t _functions, size_t _runs)
+{
+	// Code for selecting from n functions without split:
+	//   n times: dup1, push4 <id_i>, eq, push2/3 <tag_i>, jumpi
+	//   push2/3 <notfound> jump
+	// (called SELECT[n])
+	// Code for selecting from n functions with split:
+	//   dup1, push4 <pivot>, gt, push2/3<tag_less>, jumpi
+	//     SELECT[n/2]
+	//   tag_less:
+	//     SELECT[n/2]
+	//
+	// This means each split adds 16-18 bytes of additional code (note the additional jump out!)
+	// The average execution cost if we do not split at all are:
+	//   (3 + 3 + 3 + 3 + 10) * n/2 = 24 * n/2 = 12 * n
+	// If we split once:
+	//    (3 + 3 + 3 + 3 + 10) + 24 * n/4 = 24 * (n/4 + 1) = 6 * n + 24;
+	//
+	// We should split if
+	//     _runs * 12 * n > _runs * (6 * n + 24) + 17 * createDataGas
+	// <=> _runs * 6 * (n - 4) > 17 * createDataGas
+	//
+	// Which also means that the execution itself is not profitable
+	// unless we have at least 5 functions.
+
+	// Start with some comparisons to avoid overflow, then do the actual comparison.
+	if (_functions <= 4)
+		return false;
+	else if (_runs > (17 * evmasm::GasCosts::createDataGas) / 6)
+		return true;
+	else
+		return _runs * 6 * (_functions - 4) > 17 * evmasm::GasCosts::createDataGas;
+}
+
+bool CompilerUtils::shareRevertRoutine(size_t _runs)
+{
+	// Code for reverting with a string literal in place:
+	//   push1 0x40 mload, push32 <selector>, dup2 mstore, push1 4 add,
+	//   call of the ABI encoder (push2 <ret>, swap1, push2 <encoder>, jump, ret: jumpdest),
+	//   push1 0x40 mload, swap1, dup2, swap1, sub, swap1, revert
+	// takes about 56 bytes. Jumping to a shared routine instead:
+	//   push2 <routine> jump
+	// takes 4 bytes, but costs 3 + 8 + 1 = 12 gas more per revert including the jumpdest
+	// of the routine.
+	//
+	// Assuming in the worst case that the revert is executed on every run, we should share if
+	//     _runs * 12 < (56 - 4) * createDataGas
+	return _runs < (52 * evmasm::GasCosts::createDataGas) / 12;
+}
+
+namespace
+{
+
+uint64_t functionWeight(FixedHash<4> const& _selector, map<string, uint64_t> const& _weights)
+{
+	auto it = _weights.find("0x" + _selector.hex());
+	return it == _weights.end() ? 0 : it->second;
+}
+
+}
+
+vector<FixedHash<4>> CompilerUtils::extractFrequentFunctions(
+	vector<FixedHash<4>>& _selectors,
+	map<string, uint64_t> const& _weights,
+	size_t _runs
+)
+{
+	// Checking for a function before splitting costs every other call one comparison, but saves at
+	// least two comparisons for the function itself, which pays off if it is called more often
+	// than all others together.
+	vector<FixedHash<4>> frequent;
+	while (!_weights.empty() && splitFunctionSelector(_selectors.size(), _runs))
+	{
+		bigint total = 0;
+		auto hottest = _selectors.begin();
+		for (auto it = _selectors.begin(); it != _selectors.end(); ++it)
+		{
+			total += functionWeight(*it, _weights);
+			if (functionWeight(*it, _weights) > functionWeight(*hottest, _weights))
+				hottest = it;
+		}
+		if (bigint(functionWeight(*hottest, _weights)) * 2 <= total)
+			break;
+		frequent.push_back(*hottest);
+		_selectors.erase(hottest);
+	}
+	return frequent;
+}
+
+void CompilerUtils::sortByFunctionWeight(vector<FixedHash<4>>& _selectors, map<string, uint64_t> const& _weights)
+{
+	stable_sort(_selectors.begin(), _selectors.end(), [&](FixedHash<4> const& _a, FixedHash<4> const& _b) {
+		return functionWeight(_a, _weights) > functionWeight(_b, _weights);
+	});
+}
+
 void CompilerUtils::computeHashStatic()
 {
 	storeInMemory(0);
@@ -276,6 +276,31 @@ public:
 	static unsigned sizeOnStack(std::vector<T> const& _variables);
 	static unsigned sizeOnStack(std::vector<Type const*> const& _variableTypes);
 
+	/// @returns true if the function selector should select from @a _functions functions by first
+	/// comparing with the selector in the middle instead of comparing with every selector, for
+	/// @a _runs expected executions of the code.
+	static bool splitFunctionSelector(size_t _functions, size_t _runs);
+
+	/// @returns true if reverts with the same string literal as reason should jump to a shared routine
+	/// instead of encoding the reason in place, for @a _runs expected executions of the code.
+	static bool shareRevertRoutine(size_t _runs);
+
+	/// Removes the functions from @a _selectors that the function selector should check for before
+	/// splitting, because each of them is called more often than all remaining functions together
+	/// according to @a _weights (see OptimiserSettings::functionWeights).
+	/// @returns the removed selectors, most frequently called first.
+	static std::vector<util::FixedHash<4>> extractFrequentFunctions(
+		std::vector<util::FixedHash<4>>& _selectors,
+		std::map<std::string, uint64_t> const& _weights,
+		size_t _runs
+	);
+
+	/// Sorts @a _selectors by descending weight in @a _weights, keeping the order of functions of the same weight.
+	static void sortByFunctionWeight(
+		std::vector<util::FixedHash<4>>& _selectors,
+		std::map<std::string, uint64_t> const& _weights
+	);
+
 	/// Helper function to shift top value on the stack to the left.
 	/// Stack pre: <value> <shift_by_bits>
 	/// Stack post: <shifted_value>
@@ -42,7 +42,6 @@
 
 #include <libevmasm/Instruction.h>
 #include <libevmasm/Assembly.h>
-#include <libevmasm/GasMeter.h>
 
 #include <liblangutil/ErrorReporter.h>
 
@@ -86,6 +85,39 @@ private:
 	unsigned stackHeight;
 };
 
+/**
+ * Counts the reverts and failing requires with a string literal as reason, per literal.
+ */
+class RevertReasonCounter: private ASTConstVisitor
+{
+public:
+	explicit RevertReasonCounter(ContractDefinition const& _contract)
+	{
+		for (ContractDefinition const* base: _contract.annotation().linearizedBaseContracts)
+			base->accept(*this);
+	}
+
+	std::map<std::string, size_t> const& uses() const { return m_uses; }
+
+private:
+	void endVisit(FunctionCall const& _functionCall) override
+	{
+		auto const* functionType = dynamic_cast<FunctionType const*>(_functionCall.expression().annotation().type);
+		if (!functionType)
+			return;
+		auto const& arguments = _functionCall.arguments();
+		Expression const* reason = nullptr;
+		if (functionType->kind() == FunctionType::Kind::Revert && arguments.size() == 1)
+			reason = arguments.front().get();
+		else if (functionType->kind() == FunctionType::Kind::Require && arguments.size() == 2)
+			reason = arguments.at(1).get();
+		if (reason && reason->annotation().type->category() == Type::Category::StringLiteral)
+			++m_uses[reason->annotation().type->identifier()];
+	}
+
+	std::map<std::string, size_t> m_uses;
+};
+
 }
 
 void ContractCompiler::compileContract(
@@ -135,6 +167,17 @@ void ContractCompiler::initializeContext(
 	CompilerUtils(m_context).initialiseFreeMemoryPointer();
 	registerStateVariables(_contract);
 	m_context.resetVisitedNodes(&_contract);
+
+	// Sharing the code of a revert only pays off for reasons used at more than one place.
+	// It is only done if the optimizer runs, so that unoptimized bytecode does not change.
+	if (m_optimiserSettings.runConstantOptimiser && CompilerUtils::shareRevertRoutine(m_optimiserSettings.expectedExecutionsPerDeployment))
+	{
+		set<string> sharedRevertReasons;
+		for (auto const& [reason, uses]: RevertReasonCounter(_contract).uses())
+			if (uses > 1)
+				sharedRevertReasons.insert(reason);
+		m_context.setSharedRevertReasons(move(sharedRevertReasons));
+	}
 }
 
 void ContractCompiler::appendCallValueCheck()
@@ -322,39 +365,7 @@ void ContractCompiler::appendInternalSelector(
 	size_t _runs
 )
 {
-	// Code for selecting from n functions without split:
-	//   n times: dup1, push4 <id_i>, eq, push2/3 <tag_i>, jumpi
-	//   push2/3 <notfound> jump
-	// (called SELECT[n])
-	// Code for selecting from n functions with split:
-	//   dup1, push4 <pivot>, gt, push2/3<tag_less>, jumpi
-	//     SELECT[n/2]
-	//   tag_less:
-	//     SELECT[n/2]
-	//
-	// This means each split adds 16-18 bytes of additional code (note the additional jump out!)
-	// The average execution cost if we do not split at all are:
-	//   (3 + 3 + 3 + 3 + 10) * n/2 = 24 * n/2 = 12 * n
-	// If we split once:
-	//    (3 + 3 + 3 + 3 + 10) + 24 * n/4 = 24 * (n/4 + 1) = 6 * n + 24;
-	//
-	// We should split if
-	//     _runs * 12 * n > _runs * (6 * n + 24) + 17 * createDataGas
-	// <=> _runs * 6 * (n - 4) > 17 * createDataGas
-	//
-	// Which also means that the execution itself is not profitable
-	// unless we have at least 5 functions.
-
-	// Start with some comparisons to avoid overflow, then do the actual comparison.
-	bool split = false;
-	if (_ids.size() <= 4)
-		split = false;
-	else if (_runs > (17 * evmasm::GasCosts::createDataGas) / 6)
-		split = true;
-	else
-		split = (_runs * 6 * (_ids.size() - 4) > 17 * evmasm::GasCosts::createDataGas);
-
-	if (split)
+	if (CompilerUtils::splitFunctionSelector(_ids.size(), _runs))
 	{
 		size_t pivotIndex = _ids.size() / 2;
 		FixedHash<4> pivot{_ids.at(pivotIndex)};
@@ -370,7 +381,9 @@ void ContractCompiler::appendInternalSelector(
 	}
 	else
 	{
-		for (auto const& id: _ids)
+		vector<FixedHash<4>> ids = _ids;
+		CompilerUtils::sortByFunctionWeight(ids, m_optimiserSettings.functionWeights);
+		for (auto const& id: ids)
 		{
 			m_context << dupInstruction(1) << u256(FixedHash<4>::Arith(id)) << Instruction::EQ;
 			m_context.appendConditionalJumpTo(_entryPoints.at(id));
@@ -447,7 +460,13 @@ void ContractCompiler::appendFunctionSelector(ContractDefinition const& _contrac
 			sortedIDs.emplace_back(it.first);
 		}
 		std::sort(sortedIDs.begin(), sortedIDs.end());
-		appendInternalSelector(callDataUnpackerEntryPoints, sortedIDs, notFound, m_optimiserSettings.expectedExecutionsPerDeployment);
+		size_t runs = m_optimiserSettings.expectedExecutionsPerDeployment;
+		for (auto const& id: CompilerUtils::extractFrequentFunctions(sortedIDs, m_optimiserSettings.functionWeights, runs))
+		{
+			m_context << dupInstruction(1) << u256(FixedHash<4>::Arith(id)) << Instruction::EQ;
+			m_context.appendConditionalJumpTo(callDataUnpackerEntryPoints.at(id));
+		}
+		appendInternalSelector(callDataUnpackerEntryPoints, sortedIDs, notFound, runs);
 	}
 
 	m_context << notFoundOrReceiveEther;
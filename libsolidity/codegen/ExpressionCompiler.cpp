@@ -805,7 +805,7 @@ bool ExpressionCompiler::visit(FunctionCall const& _functionCall)
 				else
 				{
 					arguments.front()->accept(*this);
-					utils().revertWithStringData(*arguments.front()->annotation().type);
+					appendRevertWithStringData(*arguments.front()->annotation().type);
 				}
 			}
 			break;
@@ -886,7 +886,7 @@ bool ExpressionCompiler::visit(FunctionCall const& _functionCall)
 				}
 			if (!event.isAnonymous())
 			{
-				m_context << u256(h256::Arith(keccak256(function.externalSignature())));
+				m_context << u256(h256::Arith(function.externalSignatureHash()));
 				++numIndexed;
 			}
 			solAssert(numIndexed <= 4, "Too many indexed arguments.");
@@ -1110,7 +1110,7 @@ bool ExpressionCompiler::visit(FunctionCall const& _functionCall)
 				m_context.appendPanic(util::PanicCode::Assert);
 			else if (haveReasonString)
 			{
-				utils().revertWithStringData(*arguments.at(1)->annotation().type);
+				appendRevertWithStringData(*arguments.at(1)->annotation().type);
 				// Here, the argument is consumed, but in the other branch, it is still there.
 				m_context.adjustStackOffset(static_cast<int>(arguments.at(1)->annotation().type->sizeOnStack()));
 			}
@@ -1439,9 +1439,9 @@ bool ExpressionCompiler::visit(MemberAccess const& _memberAccess)
 					{
 						u256 identifier;
 						if (auto const* variable = dynamic_cast<VariableDeclaration const*>(declaration))
-							identifier = FunctionType(*variable).externalIdentifier();
+							identifier = TypeProvider::function(*variable)->externalIdentifier();
 						else if (auto const* function = dynamic_cast<FunctionDefinition const*>(declaration))
-							identifier = FunctionType(*function).externalIdentifier();
+							identifier = TypeProvider::function(*function)->externalIdentifier();
 						else
 							solAssert(false, "Contract member is neither variable nor function.");
 						m_context << identifier;
@@ -1507,9 +1507,9 @@ bool ExpressionCompiler::visit(MemberAccess const& _memberAccess)
 		{
 			u256 identifier;
 			if (auto const* variable = dynamic_cast<VariableDeclaration const*>(declaration))
-				identifier = FunctionType(*variable).externalIdentifier();
+				identifier = TypeProvider::function(*variable)->externalIdentifier();
 			else if (auto const* function = dynamic_cast<FunctionDefinition const*>(declaration))
-				identifier = FunctionType(*function).externalIdentifier();
+				identifier = TypeProvider::function(*function)->externalIdentifier();
 			else
 				solAssert(false, "Contract member is neither variable nor function.");
 			utils().convertType(type, type.isPayable() ? *TypeProvider::payableAddress() : *TypeProvider::address(), true);
@@ -2657,6 +2657,28 @@ void ExpressionCompiler::setLValueToStorageItem(Expression const& _expression)
 	setLValue<StorageItem>(_expression, *_expression.annotation().type);
 }
 
+void ExpressionCompiler::appendRevertWithStringData(Type const& _messageType)
+{
+	if (
+		_messageType.category() == Type::Category::StringLiteral &&
+		m_context.sharesRevertReason(_messageType.identifier())
+	)
+	{
+		// The message is part of the code, so nothing is passed to the routine and it does not return.
+		m_context << m_context.lowLevelFunctionTag(
+			"$revertWithReason_" + _messageType.identifier(),
+			0,
+			0,
+			[messageType = &_messageType](CompilerContext& _context) {
+				CompilerUtils(_context).revertWithStringData(*messageType);
+			}
+		);
+		m_context.appendJump();
+	}
+	else
+		utils().revertWithStringData(_messageType);
+}
+
 bool ExpressionCompiler::cleanupNeededForOp(Type::Category _type, Token _op, Arithmetic _arithmetic)
 {
 	if (TokenTraits::isCompareOp(_op) || TokenTraits::isShiftOp(_op))
@@ -112,6 +112,12 @@ private:
 		std::vector<ASTPointer<Expression const>> const& _arguments,
 		bool _tryCall
 	);
+	/// Appends code that reverts with the Error(string) error and the message on the stack.
+	/// Reverts with a string literal share a routine if the context says so for the literal,
+	/// see CompilerContext::sharesRevertReason.
+	/// Stack pre: <message>
+	/// Stack post:
+	void appendRevertWithStringData(Type const& _messageType);
 	/// Appends code that evaluates a single expression and moves the result to memory. The memory offset is
 	/// expected to be on the stack and is updated by this call.
 	void appendExpressionCopyToMemory(Type const& _expectedType, Expression const& _expression);
@@ -0,0 +1,39 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Cache of the inline assembly blocks of the legacy code generator.
+ */
+
+#include <libsolidity/codegen/InlineAssemblyCache.h>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::frontend;
+
+shared_ptr<InlineAssemblyCache::Entry const> InlineAssemblyCache::find(string const& _key) const
+{
+	lock_guard<mutex> lock(m_mutex);
+	auto it = m_entries.find(_key);
+	return it == m_entries.end() ? nullptr : it->second;
+}
+
+void InlineAssemblyCache::insert(string _key, shared_ptr<Entry const> _entry)
+{
+	lock_guard<mutex> lock(m_mutex);
+	m_entries.emplace(move(_key), move(_entry));
+}
@@ -0,0 +1,66 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Cache of the inline assembly blocks of the legacy code generator.
+ */
+
+#pragma once
+
+#include <libyul/AsmAnalysisInfo.h>
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace solidity::yul
+{
+struct Block;
+}
+
+namespace solidity::frontend
+{
+
+/**
+ * Inline assembly blocks parsed, analysed and optimised by the legacy code generator during
+ * one compilation, keyed by everything that influences the result, i.e. the text, the
+ * local variables, the settings and the source location assigned to the code.
+ * Safe to use concurrently.
+ */
+class InlineAssemblyCache
+{
+public:
+	struct Entry
+	{
+		std::shared_ptr<yul::Block const> code;
+		std::shared_ptr<yul::AsmAnalysisInfo const> analysisInfo;
+		/// Source of the code for "system-level" assembly, empty otherwise.
+		std::string generatedSource;
+	};
+
+	/// @returns the entry stored under @a _key or nullptr if there is none.
+	std::shared_ptr<Entry const> find(std::string const& _key) const;
+	/// Stores @a _entry under @a _key unless there already is an entry with that key.
+	void insert(std::string _key, std::shared_ptr<Entry const> _entry);
+
+private:
+	mutable std::mutex m_mutex;
+	std::map<std::string, std::shared_ptr<Entry const>> m_entries;
+};
+
+}
@@ -357,7 +357,12 @@ void StorageItem::storeValue(Type const& _sourceType, SourceLocation const& _loc
 				"Struct assignment with conversion."
 			);
 			solAssert(!structType.containsNestedMapping(), "");
-			if (sourceType.location() == DataLocation::CallData)
+			// The Yul function stores members that share a slot with a single read-modify-write.
+			bool valueTypeMembers = true;
+			for (auto const& member: structType.members(nullptr))
+				if (!member.type->isValueType() || member.type->category() == Type::Category::Function)
+					valueTypeMembers = false;
+			if (sourceType.location() == DataLocation::CallData || valueTypeMembers)
 			{
 				solAssert(sourceType.sizeOnStack() == 1, "");
 				solAssert(structType.sizeOnStack() == 1, "");
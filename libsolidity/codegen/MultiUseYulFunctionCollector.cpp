@@ -24,6 +24,8 @@
 
 #include <liblangutil/Exceptions.h>
 
+#include <libsolutil/Common.h>
+#include <libsolutil/CommonData.h>
 
 using namespace std;
 using namespace solidity;
@@ -42,15 +44,90 @@ string MultiUseYulFunctionCollector::requestedFunctions()
 	return result;
 }
 
+void MultiUseYulFunctionCollector::addFunction(string const& _name, string _code)
+{
+	solAssert(_code != "<<STUB<<", "");
+	if (!contains(_name))
+		m_requestedFunctions.emplace(_name, move(_code));
+}
+
+optional<SharedYulFunctionCache::Function> SharedYulFunctionCache::find(string const& _key) const
+{
+	lock_guard<mutex> lock(m_mutex);
+	auto it = m_functions.find(_key);
+	if (it == m_functions.end())
+		return nullopt;
+	return it->second;
+}
+
+void SharedYulFunctionCache::insert(string const& _key, Function _function)
+{
+	lock_guard<mutex> lock(m_mutex);
+	m_functions.emplace(_key, move(_function));
+}
+
 string MultiUseYulFunctionCollector::createFunction(string const& _name, function<string ()> const& _creator)
 {
-	if (!m_requestedFunctions.count(_name))
+	if (!m_dependencyStack.empty())
+		m_dependencyStack.back().push_back(_name);
+	if (!contains(_name))
 	{
-		m_requestedFunctions[_name] = "<<STUB<<";
-		string fun = _creator();
-		solAssert(!fun.empty(), "");
-		solAssert(fun.find("function " + _name + "(") != string::npos, "Function not properly named.");
-		m_requestedFunctions[_name] = std::move(fun);
+		if (m_creationObserver)
+			m_creationObserver(_name, true);
+		generateFunction(_name, _creator);
+		if (m_creationObserver)
+			m_creationObserver(_name, false);
 	}
 	return _name;
 }
+
+string MultiUseYulFunctionCollector::createSharedFunction(
+	string const& _name,
+	string const& _settings,
+	function<string ()> const& _creator
+)
+{
+	if (!m_sharedFunctions)
+		return createFunction(_name, _creator);
+
+	if (!m_dependencyStack.empty())
+		m_dependencyStack.back().push_back(_name);
+	if (contains(_name) || addSharedFunction(_name, _settings))
+		return _name;
+
+	vector<string> dependencies = generateFunction(_name, _creator);
+	m_sharedFunctions->insert(_settings + _name, {m_requestedFunctions.at(_name), move(dependencies)});
+	return _name;
+}
+
+vector<string> MultiUseYulFunctionCollector::generateFunction(string const& _name, function<string ()> const& _creator)
+{
+	m_requestedFunctions[_name] = "<<STUB<<";
+	m_dependencyStack.emplace_back();
+	ScopeGuard popDependencies([&]() { m_dependencyStack.pop_back(); });
+	string fun = _creator();
+	solAssert(!fun.empty(), "");
+	solAssert(fun.find("function " + _name + "(") != string::npos, "Function not properly named.");
+	m_requestedFunctions[_name] = std::move(fun);
+	return std::move(m_dependencyStack.back());
+}
+
+bool MultiUseYulFunctionCollector::addSharedFunction(string const& _name, string const& _settings)
+{
+	map<string, string> functions;
+	vector<string> pending{_name};
+	while (!pending.empty())
+	{
+		string name = move(pending.back());
+		pending.pop_back();
+		if (contains(name) || functions.count(name))
+			continue;
+		optional<SharedYulFunctionCache::Function> cached = m_sharedFunctions->find(_settings + name);
+		if (!cached)
+			return false;
+		functions.emplace(name, move(cached->code));
+		pending += cached->dependencies;
+	}
+	m_requestedFunctions.merge(functions);
+	return true;
+}
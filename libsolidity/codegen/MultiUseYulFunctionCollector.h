@@ -24,11 +24,40 @@
 
 #include <functional>
 #include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
 #include <string>
+#include <vector>
 
 namespace solidity::frontend
 {
 
+/**
+ * Yul functions generated during one compilation that only depend on their name and the
+ * settings encoded in their key, i.e. that can be reused by the code generators of all
+ * contracts. Safe to use concurrently.
+ */
+class SharedYulFunctionCache
+{
+public:
+	struct Function
+	{
+		std::string code;
+		/// Names of the functions requested while generating the function.
+		std::vector<std::string> dependencies;
+	};
+
+	/// @returns the function stored under @a _key, if any.
+	std::optional<Function> find(std::string const& _key) const;
+	/// Stores @a _function under @a _key unless there already is a function with that key.
+	void insert(std::string const& _key, Function _function);
+
+private:
+	mutable std::mutex m_mutex;
+	std::map<std::string, Function> m_functions;
+};
+
 /**
  * Container of (unparsed) Yul functions identified by name which are meant to be generated
  * only once.
@@ -36,11 +65,30 @@ namespace solidity::frontend
 class MultiUseYulFunctionCollector
 {
 public:
+	/// @param _base collector whose functions are treated as already created by this one.
+	/// It is only read and has to outlive this collector.
+	explicit MultiUseYulFunctionCollector(
+		std::shared_ptr<SharedYulFunctionCache> _sharedFunctions = {},
+		MultiUseYulFunctionCollector const* _base = nullptr
+	):
+		m_sharedFunctions(std::move(_sharedFunctions)),
+		m_base(_base)
+	{}
+
 	/// Helper function that uses @a _creator to create a function and add it to
 	/// @a m_requestedFunctions if it has not been created yet and returns @a _name in both
 	/// cases.
 	std::string createFunction(std::string const& _name, std::function<std::string()> const& _creator);
 
+	/// Like createFunction, but for functions that only depend on their name and @a _settings.
+	/// Such functions are taken from the shared cache, together with the functions they request,
+	/// instead of being generated again.
+	std::string createSharedFunction(
+		std::string const& _name,
+		std::string const& _settings,
+		std::function<std::string()> const& _creator
+	);
+
 	/// @returns concatenation of all generated functions.
 	/// Guarantees that the order of functions in the generated code is deterministic and
 	/// platform-independent.
@@ -49,11 +97,39 @@ public:
 	std::string requestedFunctions();
 
 	/// @returns true IFF a function with the specified name has already been collected.
-	bool contains(std::string const& _name) const { return m_requestedFunctions.count(_name) > 0; }
+	bool contains(std::string const& _name) const
+	{
+		return m_requestedFunctions.count(_name) > 0 || (m_base && m_base->contains(_name));
+	}
+
+	/// Sets a function that is called with @a _begin set to true before and with @a _begin set to
+	/// false after a function is generated by createFunction.
+	void setCreationObserver(std::function<void(std::string const& _name, bool _begin)> _observer)
+	{
+		m_creationObserver = std::move(_observer);
+	}
+
+	/// @returns the code of all generated functions by name.
+	std::map<std::string, std::string> const& functions() const { return m_requestedFunctions; }
+	/// Adds the function @a _name with code @a _code unless it has already been collected.
+	void addFunction(std::string const& _name, std::string _code);
 
 private:
+	/// Generates the function @a _name using @a _creator and @returns the names of the functions
+	/// requested during its generation.
+	std::vector<std::string> generateFunction(std::string const& _name, std::function<std::string()> const& _creator);
+	/// Adds the function @a _name stored in the shared cache for @a _settings and, recursively, the
+	/// functions it requests. @returns false without adding anything if one of them is not
+	/// in the cache.
+	bool addSharedFunction(std::string const& _name, std::string const& _settings);
+
 	/// Map from function name to code for a multi-use function.
 	std::map<std::string, std::string> m_requestedFunctions;
+	std::shared_ptr<SharedYulFunctionCache> m_sharedFunctions;
+	MultiUseYulFunctionCollector const* m_base = nullptr;
+	std::function<void(std::string const&, bool)> m_creationObserver;
+	/// For each function currently being generated, the names of the functions it requested so far.
+	std::vector<std::vector<std::string>> m_dependencyStack;
 };
 
 }
@@ -30,6 +30,7 @@
 
 #include <libsolutil/ErrorCodes.h>
 
+#include <functional>
 #include <memory>
 #include <string>
 #include <vector>
@@ -59,6 +60,11 @@ public:
 		m_functionCollector(_functionCollector)
 	{}
 
+	/// Uses @a _creator to create the function @a _name through the function collector, which
+	/// can reuse it from other contracts because it only depends on its name and the settings
+	/// of this object. @returns @a _name.
+	std::string createFunction(std::string const& _name, std::function<std::string()> const& _creator);
+
 	/// @returns a function that combines the address and selector to a single value
 	/// for use in the ABI.
 	std::string combineExternalFunctionIdFunction();
@@ -85,6 +91,11 @@ public:
 	// `assert` or `require` call.
 	std::string requireOrAssertFunction(bool _assert, Type const* _messageType = nullptr);
 
+	/// @returns the name of a function that reverts with the Error(string) error and the given
+	/// message. For string literals, there is one function per distinct message.
+	/// signature: (message) ->
+	std::string revertWithStringFunction(Type const& _messageType);
+
 	/// @returns the name of a function that takes a (cleaned) value of the given value type and
 	/// left-aligns it, usually for use in non-padded encoding.
 	std::string leftAlignFunction(Type const& _type);
@@ -61,6 +61,14 @@ string IRNames::functionWithModifierInner(FunctionDefinition const& _function)
 	return "fun_" + _function.name() + "_" + to_string(_function.id()) + "_inner";
 }
 
+string IRNames::calldataViewFunction(FunctionDefinition const& _function, vector<size_t> const& _parameters)
+{
+	string name = function(_function) + "_calldata";
+	for (size_t parameter: _parameters)
+		name += "_" + to_string(parameter);
+	return name;
+}
+
 string IRNames::creationObject(ContractDefinition const& _contract)
 {
 	return _contract.name() + "_" + toString(_contract.id());
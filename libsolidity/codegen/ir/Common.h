@@ -25,6 +25,7 @@
 
 #include <algorithm>
 #include <string>
+#include <vector>
 
 namespace solidity::frontend
 {
@@ -51,6 +52,9 @@ struct IRNames
 	static std::string function(VariableDeclaration const& _varDecl);
 	static std::string modifierInvocation(ModifierInvocation const& _modifierInvocation);
 	static std::string functionWithModifierInner(FunctionDefinition const& _function);
+	/// @returns the name of the variant of @a _function that takes calldata references instead
+	/// of memory copies for the parameters with the indices @a _parameters.
+	static std::string calldataViewFunction(FunctionDefinition const& _function, std::vector<size_t> const& _parameters);
 	static std::string creationObject(ContractDefinition const& _contract);
 	static std::string deployedObject(ContractDefinition const& _contract);
 	static std::string internalDispatch(YulArity const& _arity);
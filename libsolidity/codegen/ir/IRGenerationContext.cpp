@@ -37,11 +37,44 @@ using namespace solidity;
 using namespace solidity::util;
 using namespace solidity::frontend;
 
+namespace
+{
+
+/// Replaces the placeholders of the variables of a forked context by the variable numbers
+/// @a _numbers assigned to them.
+string substituteVariables(string const& _code, vector<size_t> const& _numbers)
+{
+	string result;
+	size_t position = 0;
+	for (
+		size_t begin = _code.find('\x01');
+		begin != string::npos;
+		begin = _code.find('\x01', position)
+	)
+	{
+		size_t end = _code.find('\x02', begin);
+		solAssert(end != string::npos, "");
+		size_t index = stoul(_code.substr(begin + 1, end - begin - 1));
+		solAssert(index < _numbers.size() && _numbers[index] != 0, "Variable of a function that was not merged.");
+		result.append(_code, position, begin - position);
+		result += to_string(_numbers[index]);
+		position = end + 1;
+	}
+	if (position == 0)
+		return _code;
+	result.append(_code, position, string::npos);
+	return result;
+}
+
+}
+
 string IRGenerationContext::enqueueFunctionForCodeGeneration(FunctionDefinition const& _function)
 {
 	string name = IRNames::function(_function);
 
-	if (!m_functions.contains(name))
+	if (m_generationEvents)
+		m_generationEvents->push_back({GenerationEvent::Kind::Enqueue, &_function, {}});
+	else if (!m_functions.contains(name))
 		m_functionGenerationQueue.insert(&_function);
 
 	return name;
@@ -56,6 +89,151 @@ FunctionDefinition const* IRGenerationContext::dequeueFunctionForCodeGeneration(
 	return result;
 }
 
+IRGenerationContext IRGenerationContext::forkForFunctionGeneration(bool _standalone) const
+{
+	IRGenerationContext fork(m_evmVersion, m_revertStrings, m_optimiserSettings, m_sharedFunctions);
+	fork.m_mostDerivedContract = m_mostDerivedContract;
+	fork.m_immutableVariables = m_immutableVariables;
+	fork.m_reservedMemory = m_reservedMemory;
+	fork.m_stateVariables = m_stateVariables;
+	fork.m_arithmetic = m_arithmetic;
+	fork.m_functions = MultiUseYulFunctionCollector(m_sharedFunctions, _standalone ? nullptr : &m_functions);
+	fork.m_generationEvents = make_shared<vector<GenerationEvent>>();
+	fork.m_functions.setCreationObserver([events = fork.m_generationEvents](string const& _name, bool _begin) {
+		events->push_back({
+			_begin ? GenerationEvent::Kind::BeginFunction : GenerationEvent::Kind::EndFunction,
+			nullptr,
+			_name
+		});
+	});
+	return fork;
+}
+
+vector<FunctionDefinition const*> IRGenerationContext::forkEnqueuedFunctions() const
+{
+	solAssert(m_generationEvents, "");
+	vector<FunctionDefinition const*> functions;
+	for (GenerationEvent const& event: *m_generationEvents)
+		if (event.kind == GenerationEvent::Kind::Enqueue)
+			functions.push_back(event.function);
+	return functions;
+}
+
+set<FunctionDefinition const*> IRGenerationContext::mergeForkedFunctions(
+	map<FunctionDefinition const*, IRGenerationContext const*, AscendingFunctionIDCompare> const& _forks
+)
+{
+	solAssert(!m_generationEvents, "");
+
+	// Functions created so far in replay order and the fork they are taken from.
+	map<string, IRGenerationContext const*> sources;
+	// Variable numbers assigned to the variables of each fork, zero for skipped ones.
+	map<IRGenerationContext const*, vector<size_t>> variableNumbers;
+	// Forks whose queued function is generated by them and not taken from elsewhere.
+	vector<IRGenerationContext const*> mergedForks;
+
+	set<FunctionDefinition const*> functions;
+	while (!functionGenerationQueueEmpty())
+	{
+		FunctionDefinition const* function = dequeueFunctionForCodeGeneration();
+		functions.emplace(function);
+		IRGenerationContext const* fork = _forks.at(function);
+		vector<size_t>& numbers = variableNumbers[fork];
+		solAssert(numbers.empty(), "Function generated twice.");
+		if (replayFork(*function, *fork, sources, numbers))
+			mergedForks.push_back(fork);
+	}
+
+	// Names of all functions generated by createFunction in any fork. The others only depend
+	// on their name and are the same in all forks.
+	set<string> tracedFunctions;
+	for (IRGenerationContext const* fork: _forks | boost::adaptors::map_values)
+		for (GenerationEvent const& event: *fork->m_generationEvents)
+			if (event.kind == GenerationEvent::Kind::BeginFunction)
+				tracedFunctions.insert(event.name);
+
+	for (IRGenerationContext const* fork: mergedForks)
+		addForkedFunctions(*fork, variableNumbers.at(fork), sources, tracedFunctions);
+
+	return functions;
+}
+
+void IRGenerationContext::mergeForkedFunction(FunctionDefinition const& _function, IRGenerationContext const& _fork)
+{
+	solAssert(!m_generationEvents, "");
+
+	map<string, IRGenerationContext const*> sources;
+	vector<size_t> numbers;
+	if (!replayFork(_function, _fork, sources, numbers))
+		return;
+
+	set<string> tracedFunctions;
+	for (GenerationEvent const& event: *_fork.m_generationEvents)
+		if (event.kind == GenerationEvent::Kind::BeginFunction)
+			tracedFunctions.insert(event.name);
+	addForkedFunctions(_fork, numbers, sources, tracedFunctions);
+}
+
+bool IRGenerationContext::replayFork(
+	FunctionDefinition const& _function,
+	IRGenerationContext const& _fork,
+	map<string, IRGenerationContext const*>& _sources,
+	vector<size_t>& _numbers
+)
+{
+	auto created = [&](string const& _name) { return _sources.count(_name) || m_functions.contains(_name); };
+
+	// Depth of nested function generations inside a skipped one, i.e. of a function that
+	// has already been created.
+	size_t skipped = 0;
+	for (GenerationEvent const& event: *_fork.m_generationEvents)
+		switch (event.kind)
+		{
+		case GenerationEvent::Kind::NewVariable:
+			_numbers.push_back(skipped ? 0 : ++m_varCounter);
+			break;
+		case GenerationEvent::Kind::Enqueue:
+			if (!skipped && !created(IRNames::function(*event.function)))
+				m_functionGenerationQueue.insert(event.function);
+			break;
+		case GenerationEvent::Kind::BeginFunction:
+			if (skipped || created(event.name))
+				++skipped;
+			else
+				_sources[event.name] = &_fork;
+			break;
+		case GenerationEvent::Kind::EndFunction:
+			if (skipped)
+				--skipped;
+			break;
+		}
+	solAssert(skipped == 0, "");
+
+	auto source = _sources.find(IRNames::function(_function));
+	return source != _sources.end() && source->second == &_fork;
+}
+
+void IRGenerationContext::addForkedFunctions(
+	IRGenerationContext const& _fork,
+	vector<size_t> const& _numbers,
+	map<string, IRGenerationContext const*> const& _sources,
+	set<string> const& _tracedFunctions
+)
+{
+	for (auto const& [name, code]: _fork.m_functions.functions())
+	{
+		auto source = _sources.find(name);
+		if (!_tracedFunctions.count(name) || (source != _sources.end() && source->second == &_fork))
+			m_functions.addFunction(name, substituteVariables(code, _numbers));
+	}
+
+	for (auto&& [arity, dispatchFunctions]: _fork.m_internalDispatchMap)
+		m_internalDispatchMap[arity].insert(dispatchFunctions.begin(), dispatchFunctions.end());
+	m_subObjects.insert(_fork.m_subObjects.begin(), _fork.m_subObjects.end());
+	if (_fork.m_inlineAssemblySeen)
+		m_inlineAssemblySeen = true;
+}
+
 ContractDefinition const& IRGenerationContext::mostDerivedContract() const
 {
 	solAssert(m_mostDerivedContract, "Most derived contract requested but not set.");
@@ -71,6 +249,15 @@ IRVariable const& IRGenerationContext::addLocalVariable(VariableDeclaration cons
 	return it->second;
 }
 
+IRVariable const& IRGenerationContext::addLocalVariable(VariableDeclaration const& _varDecl, Type const& _type)
+{
+	auto const& [it, didInsert] = m_localVariables.emplace(
+		std::make_pair(&_varDecl, IRVariable{IRNames::localVariable(_varDecl), _type})
+	);
+	solAssert(didInsert, "Local variable added multiple times.");
+	return it->second;
+}
+
 IRVariable const& IRGenerationContext::localVariable(VariableDeclaration const& _varDecl)
 {
 	solAssert(
@@ -85,6 +272,14 @@ void IRGenerationContext::resetLocalVariables()
 	m_localVariables.clear();
 }
 
+map<VariableDeclaration const*, IRVariable> IRGenerationContext::swapLocalVariables(
+	map<VariableDeclaration const*, IRVariable> _localVariables
+)
+{
+	swap(m_localVariables, _localVariables);
+	return _localVariables;
+}
+
 void IRGenerationContext::registerImmutableVariable(VariableDeclaration const& _variable)
 {
 	solAssert(_variable.immutable(), "Attempted to register a non-immutable variable as immutable.");
@@ -126,6 +321,12 @@ void IRGenerationContext::addStateVariable(
 
 string IRGenerationContext::newYulVariable()
 {
+	// Forked contexts use placeholders that are replaced by the numbers when merging.
+	if (m_generationEvents)
+	{
+		m_generationEvents->push_back({GenerationEvent::Kind::NewVariable, nullptr, {}});
+		return "_\x01" + to_string(m_varCounter++) + "\x02";
+	}
 	return "_" + to_string(++m_varCounter);
 }
 
@@ -182,3 +383,25 @@ std::string IRGenerationContext::revertReasonIfDebug(std::string const& _message
 {
 	return YulUtilFunctions::revertReasonIfDebug(m_revertStrings, _message);
 }
+
+shared_ptr<IRGenerationContext const> SharedIRFunctionCache::find(
+	string const& _settings,
+	FunctionDefinition const& _function
+) const
+{
+	lock_guard<mutex> lock(m_mutex);
+	auto it = m_contexts.find({_settings, _function.id()});
+	if (it == m_contexts.end())
+		return nullptr;
+	return it->second;
+}
+
+void SharedIRFunctionCache::insert(
+	string const& _settings,
+	FunctionDefinition const& _function,
+	shared_ptr<IRGenerationContext const> _context
+)
+{
+	lock_guard<mutex> lock(m_mutex);
+	m_contexts.emplace(make_pair(_settings, _function.id()), move(_context));
+}
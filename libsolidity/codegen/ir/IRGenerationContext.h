@@ -33,6 +33,8 @@
 
 #include <libsolutil/Common.h>
 
+#include <map>
+#include <mutex>
 #include <set>
 #include <string>
 #include <memory>
@@ -65,17 +67,32 @@ using InternalDispatchMap = std::map<YulArity, DispatchSet>;
 class IRGenerationContext
 {
 public:
+	/// Event recorded while generating functions in a context returned by forkForFunctionGeneration().
+	struct GenerationEvent
+	{
+		enum class Kind { NewVariable, Enqueue, BeginFunction, EndFunction };
+		Kind kind;
+		/// The enqueued function.
+		FunctionDefinition const* function = nullptr;
+		/// The name of the Yul function whose generation begins or ends.
+		std::string name;
+	};
+
 	IRGenerationContext(
 		langutil::EVMVersion _evmVersion,
 		RevertStrings _revertStrings,
-		OptimiserSettings _optimiserSettings
+		OptimiserSettings _optimiserSettings,
+		std::shared_ptr<SharedYulFunctionCache> _sharedFunctions = {}
 	):
 		m_evmVersion(_evmVersion),
 		m_revertStrings(_revertStrings),
-		m_optimiserSettings(std::move(_optimiserSettings))
+		m_optimiserSettings(std::move(_optimiserSettings)),
+		m_sharedFunctions(_sharedFunctions),
+		m_functions(std::move(_sharedFunctions))
 	{}
 
 	MultiUseYulFunctionCollector& functionCollector() { return m_functions; }
+	std::shared_ptr<SharedYulFunctionCache> const& sharedFunctions() const { return m_sharedFunctions; }
 
 	/// Adds a Solidity function to the function generation queue and returns the name of the
 	/// corresponding Yul function.
@@ -85,6 +102,30 @@ public:
 	FunctionDefinition const* dequeueFunctionForCodeGeneration();
 
 	bool functionGenerationQueueEmpty() { return m_functionGenerationQueue.empty(); }
+	DispatchSet const& functionGenerationQueue() const { return m_functionGenerationQueue; }
+
+	/// @returns a context for generating functions on another thread while this context is not
+	/// modified. It shares the settings and the contract-level state of this context and treats
+	/// the functions collected here as already created. Instead of numbering new variables and
+	/// queueing functions, it records them together with the functions it generates, so that
+	/// mergeForkedFunctions can replay the generation.
+	/// If @a _standalone is true, the fork does not use the functions collected here, so that it
+	/// can also be merged into the contexts of other contracts.
+	IRGenerationContext forkForFunctionGeneration(bool _standalone = false) const;
+	/// @returns the functions enqueued in a context returned by forkForFunctionGeneration().
+	std::vector<FunctionDefinition const*> forkEnqueuedFunctions() const;
+	/// Empties the function generation queue the same way as generating the functions in this
+	/// context would, but takes the generated code from @a _forks, the forked contexts that
+	/// generated each function taken from the queue. Variables are numbered and functions are
+	/// added exactly as if the functions had been generated here.
+	/// @returns the functions taken from the queue.
+	std::set<FunctionDefinition const*> mergeForkedFunctions(
+		std::map<FunctionDefinition const*, IRGenerationContext const*, AscendingFunctionIDCompare> const& _forks
+	);
+	/// Adds the function @a _function taken from the queue, which is generated by the standalone
+	/// fork @a _fork, exactly as if it had been generated here. The functions it enqueues are
+	/// added to the queue.
+	void mergeForkedFunction(FunctionDefinition const& _function, IRGenerationContext const& _fork);
 
 	/// Sets the most derived contract (the one currently being compiled)>
 	void setMostDerivedContract(ContractDefinition const& _mostDerivedContract)
@@ -95,9 +136,16 @@ public:
 
 
 	IRVariable const& addLocalVariable(VariableDeclaration const& _varDecl);
+	/// Adds the local variable @a _varDecl with the type @a _type instead of its declared type.
+	IRVariable const& addLocalVariable(VariableDeclaration const& _varDecl, Type const& _type);
 	bool isLocalVariable(VariableDeclaration const& _varDecl) const { return m_localVariables.count(&_varDecl); }
 	IRVariable const& localVariable(VariableDeclaration const& _varDecl);
 	void resetLocalVariables();
+	/// Replaces the local variables by @a _localVariables and @returns the previous ones, so
+	/// that a function can be generated while generating another one.
+	std::map<VariableDeclaration const*, IRVariable> swapLocalVariables(
+		std::map<VariableDeclaration const*, IRVariable> _localVariables = {}
+	);
 
 	/// Registers an immutable variable of the contract.
 	/// Should only be called at construction time.
@@ -155,9 +203,29 @@ public:
 	void setInlineAssemblySeen() { m_inlineAssemblySeen = true; }
 
 private:
+	/// Replays the events of @a _fork, which generated @a _function, numbering its variables in
+	/// @a _numbers and recording the functions it creates first in @a _sources.
+	/// @returns true if @a _fork is the source of @a _function.
+	bool replayFork(
+		FunctionDefinition const& _function,
+		IRGenerationContext const& _fork,
+		std::map<std::string, IRGenerationContext const*>& _sources,
+		std::vector<size_t>& _numbers
+	);
+	/// Adds the functions that the replayed fork @a _fork is the source of, as well as the ones
+	/// that are not in @a _tracedFunctions, and the dispatch and sub-objects it requires.
+	void addForkedFunctions(
+		IRGenerationContext const& _fork,
+		std::vector<size_t> const& _numbers,
+		std::map<std::string, IRGenerationContext const*> const& _sources,
+		std::set<std::string> const& _tracedFunctions
+	);
+
 	langutil::EVMVersion m_evmVersion;
 	RevertStrings m_revertStrings;
 	OptimiserSettings m_optimiserSettings;
+	/// Utility functions shared with the code generators of other contracts.
+	std::shared_ptr<SharedYulFunctionCache> m_sharedFunctions;
 	ContractDefinition const* m_mostDerivedContract = nullptr;
 	std::map<VariableDeclaration const*, IRVariable> m_localVariables;
 	/// Memory offsets reserved for the values of immutable variables during contract creation.
@@ -192,6 +260,39 @@ private:
 	InternalDispatchMap m_internalDispatchMap;
 
 	std::set<ContractDefinition const*, ASTNode::CompareByID> m_subObjects;
+
+	/// Events recorded by a forked context, null in all other contexts.
+	std::shared_ptr<std::vector<GenerationEvent>> m_generationEvents;
+};
+
+/**
+ * Standalone forked contexts that generated internal library functions and free functions,
+ * whose code does not depend on the contract they are used in. They are shared by the IR
+ * generators of all contracts of a compilation, so that these functions are only generated
+ * once per setting. Safe to use concurrently.
+ */
+class SharedIRFunctionCache
+{
+public:
+	/// @returns true if the code generated for @a _function does not depend on the contract
+	/// it is generated for.
+	static bool shareable(FunctionDefinition const& _function)
+	{
+		return _function.isFree() || (_function.libraryFunction() && !_function.isConstructor());
+	}
+
+	/// @returns the context that generated @a _function with the settings @a _settings, if any.
+	std::shared_ptr<IRGenerationContext const> find(std::string const& _settings, FunctionDefinition const& _function) const;
+	/// Stores @a _context for @a _function and @a _settings unless there already is one.
+	void insert(
+		std::string const& _settings,
+		FunctionDefinition const& _function,
+		std::shared_ptr<IRGenerationContext const> _context
+	);
+
+private:
+	mutable std::mutex m_mutex;
+	std::map<std::pair<std::string, int64_t>, std::shared_ptr<IRGenerationContext const>> m_contexts;
 };
 
 }
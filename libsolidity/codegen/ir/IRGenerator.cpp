@@ -27,6 +27,7 @@
 
 #include <libsolidity/ast/AST.h>
 #include <libsolidity/ast/ASTVisitor.h>
+#include <libsolidity/ast/TypeProvider.h>
 #include <libsolidity/codegen/ABIFunctions.h>
 #include <libsolidity/codegen/CompilerUtils.h>
 
@@ -37,6 +38,7 @@
 #include <libsolutil/Whiskers.h>
 #include <libsolutil/StringUtils.h>
 #include <libsolutil/Algorithms.h>
+#include <libsolutil/ThreadPool.h>
 
 #include <liblangutil/SourceReferenceFormatter.h>
 
@@ -89,11 +91,146 @@ set<CallableDeclaration const*, ASTNode::CompareByID> collectReachableCallables(
 	return reachableCallables;
 }
 
+/// Maximum number of functions an internal dispatch function compares the function pointer with
+/// one after the other. Larger sets are split in halves by comparing it with the ID in the middle,
+/// so that the number of comparisons only grows logarithmically with the number of functions.
+size_t constexpr maxLinearDispatchCases = 4;
+
+/// @returns the body of an internal dispatch function that calls the function with the ID in
+/// ``fun`` among the functions from @a _begin to @a _end in @a _functions, which are pairs of
+/// function ID and Yul function name sorted by ID.
+string internalDispatchSwitch(
+	vector<pair<int64_t, string>> const& _functions,
+	size_t _begin,
+	size_t _end,
+	string const& _in,
+	string const& _out,
+	string const& _panic
+)
+{
+	if (_end - _begin > maxLinearDispatchCases)
+	{
+		size_t middle = _begin + (_end - _begin) / 2;
+		return Whiskers(R"(
+			switch lt(fun, <pivot>)
+			case 0 {
+				<upper>
+			}
+			default {
+				<lower>
+			}
+		)")
+		("pivot", to_string(_functions[middle].first))
+		("lower", internalDispatchSwitch(_functions, _begin, middle, _in, _out, _panic))
+		("upper", internalDispatchSwitch(_functions, middle, _end, _in, _out, _panic))
+		.render();
+	}
+
+	vector<map<string, string>> cases;
+	for (size_t i = _begin; i < _end; ++i)
+		cases.emplace_back(map<string, string>{
+			{"funID", to_string(_functions[i].first)},
+			{"name", _functions[i].second}
+		});
+	return Whiskers(R"(
+		switch fun
+		<#cases>
+		case <funID>
+		{
+			<?+out> <out> :=</+out> <name>(<in>)
+		}
+		</cases>
+		default { <panic>() }
+	)")
+	("cases", move(cases))
+	("in", _in)
+	("out", _out)
+	("panic", _panic)
+	.render();
+}
+
+/// @returns code that executes the case among @a _cases that matches the selector in ``selector``
+/// by comparing with the selectors in the given order, or executes @a _default if none matches.
+string linearSelectorSwitch(vector<map<string, string>> _cases, string const& _default)
+{
+	return Whiskers(R"(
+		switch selector
+		<#cases>
+		case <functionSelector>
+		{
+			// <functionName>
+			<delegatecallCheck>
+			<callValueCheck>
+			<?+params>let <params> := </+params> <abiDecode>(4, calldatasize())
+			<?+retParams>let <retParams> := </+retParams> <function>(<params>)
+			let memPos := <allocate>(0)
+			let memEnd := <abiEncode>(memPos <?+retParams>,</+retParams> <retParams>)
+			return(memPos, sub(memEnd, memPos))
+		}
+		</cases>
+		default {<default>}
+	)")
+	("cases", move(_cases))
+	("default", _default)
+	.render();
 }
 
-pair<string, string> IRGenerator::run(
+/// @returns code that executes the case among @a _cases from @a _begin to @a _end, which are sorted by
+/// function selector, that matches the selector in ``selector``, or nothing if none matches.
+/// Splits the cases by comparing with the selector in the middle like the legacy code generator
+/// and compares with the selectors of more frequently called functions first, according to @a _weights.
+string selectorSwitch(
+	vector<map<string, string>> const& _cases,
+	size_t _begin,
+	size_t _end,
+	size_t _runs,
+	map<string, uint64_t> const& _weights
+)
+{
+	if (CompilerUtils::splitFunctionSelector(_end - _begin, _runs))
+	{
+		size_t middle = _begin + (_end - _begin) / 2;
+		return Whiskers(R"(
+			switch lt(selector, <pivot>)
+			case 0 {
+				<larger>
+			}
+			default {
+				<smaller>
+			}
+		)")
+		("pivot", _cases[middle].at("functionSelector"))
+		("smaller", selectorSwitch(_cases, _begin, middle, _runs, _weights))
+		("larger", selectorSwitch(_cases, middle, _end, _runs, _weights))
+		.render();
+	}
+
+	vector<map<string, string>> cases(
+		_cases.begin() + static_cast<ptrdiff_t>(_begin),
+		_cases.begin() + static_cast<ptrdiff_t>(_end)
+	);
+	auto weight = [&](map<string, string> const& _case) -> uint64_t {
+		auto it = _weights.find(_case.at("functionSelector"));
+		return it == _weights.end() ? 0 : it->second;
+	};
+	stable_sort(cases.begin(), cases.end(), [&](auto const& _a, auto const& _b) { return weight(_a) > weight(_b); });
+	return linearSelectorSwitch(move(cases), "");
+}
+
+string const irWarning =
+	"/*******************************************************\n"
+	" *                       WARNING                       *\n"
+	" *  Solidity to Yul compilation is still EXPERIMENTAL  *\n"
+	" *       It can result in LOSS OF FUNDS or worse       *\n"
+	" *                !USE AT YOUR OWN RISK!               *\n"
+	" *******************************************************/\n\n";
+
+}
+
+tuple<string, string, shared_ptr<yul::Object>> IRGenerator::run(
 	ContractDefinition const& _contract,
-	map<ContractDefinition const*, string_view const> const& _otherYulSources
+	map<ContractDefinition const*, string_view const> const& _otherYulSources,
+	bool _printOptimized
 )
 {
 	string const ir = yul::reindent(generate(_contract, _otherYulSources));
@@ -103,20 +240,26 @@ pair<string, string> IRGenerator::run(
 	{
 		string errorMessage;
 		for (auto const& error: asmStack.errors())
-			errorMessage += langutil::SourceReferenceFormatter::formatErrorInformation(*error);
+			errorMessage += langutil::SourceReferenceFormatter::formatErrorInformation(*error, asmStack);
 		solAssert(false, ir + "\n\nInvalid IR generated:\n" + errorMessage + "\n");
 	}
+	asmStack.setOptimisedCodeCache(m_optimisedCodeCache);
+	asmStack.setParallelism(m_parallelism);
 	asmStack.optimize();
 
-	string warning =
-		"/*******************************************************\n"
-		" *                       WARNING                       *\n"
-		" *  Solidity to Yul compilation is still EXPERIMENTAL  *\n"
-		" *       It can result in LOSS OF FUNDS or worse       *\n"
-		" *                !USE AT YOUR OWN RISK!               *\n"
-		" *******************************************************/\n\n";
+	return {
+		irWarning + ir,
+		_printOptimized ? irWarning + asmStack.print() : string{},
+		asmStack.parserResult()
+	};
+}
 
-	return {warning + ir, warning + asmStack.print()};
+string IRGenerator::runWithoutOptimization(
+	ContractDefinition const& _contract,
+	map<ContractDefinition const*, string_view const> const& _otherYulSources
+)
+{
+	return irWarning + yul::reindent(generate(_contract, _otherYulSources));
 }
 
 string IRGenerator::generate(
@@ -232,6 +375,10 @@ string IRGenerator::generate(Block const& _block)
 
 set<FunctionDefinition const*> IRGenerator::generateQueuedFunctions()
 {
+	if (ThreadPool::effectiveThreads(m_parallelism) > 1)
+		if (auto functions = generateQueuedFunctionsConcurrently())
+			return move(*functions);
+
 	set<FunctionDefinition const*> functions;
 
 	while (!m_context.functionGenerationQueueEmpty())
@@ -239,13 +386,109 @@ set<FunctionDefinition const*> IRGenerator::generateQueuedFunctions()
 		FunctionDefinition const& functionDefinition = *m_context.dequeueFunctionForCodeGeneration();
 
 		functions.emplace(&functionDefinition);
-		// NOTE: generateFunction() may modify function generation queue
-		generateFunction(functionDefinition);
+		// NOTE: generateFunction() and mergeForkedFunction() may modify function generation queue
+		if (m_sharedIRFunctions && SharedIRFunctionCache::shareable(functionDefinition))
+		{
+			shared_ptr<IRGenerationContext const> fork =
+				m_sharedIRFunctions->find(sharedFunctionSettings(), functionDefinition);
+			if (!fork)
+			{
+				shared_ptr<IRGenerator> generator = sharedFunctionGenerator();
+				generator->generateFunction(functionDefinition);
+				fork = shared_ptr<IRGenerationContext const>(generator, &generator->m_context);
+				m_sharedIRFunctions->insert(sharedFunctionSettings(), functionDefinition, fork);
+			}
+			m_context.mergeForkedFunction(functionDefinition, *fork);
+		}
+		else
+			generateFunction(functionDefinition);
 	}
 
 	return functions;
 }
 
+optional<set<FunctionDefinition const*>> IRGenerator::generateQueuedFunctionsConcurrently()
+{
+	DispatchSet const& queue = m_context.functionGenerationQueue();
+	if (queue.size() < 2)
+		return nullopt;
+
+	// Every function is generated by its own generator. Functions enqueued while generating
+	// one are generated in the next round unless they already exist. The forked contexts
+	// only read m_context, which is not modified until all of them are done.
+	// Functions that are shared with other contracts are taken from m_sharedIRFunctions or
+	// generated by a standalone fork that is stored there afterwards.
+	map<FunctionDefinition const*, shared_ptr<IRGenerationContext const>, AscendingFunctionIDCompare> forks;
+	map<FunctionDefinition const*, shared_ptr<IRGenerator>, AscendingFunctionIDCompare> generators;
+	TypeProvider& typeProvider = TypeProvider::instance();
+	ThreadPool threadPool(m_parallelism);
+	vector<FunctionDefinition const*> round(queue.begin(), queue.end());
+	try
+	{
+		while (!round.empty())
+		{
+			for (FunctionDefinition const* function: round)
+			{
+				bool const shared = m_sharedIRFunctions && SharedIRFunctionCache::shareable(*function);
+				if (shared)
+					if (auto fork = m_sharedIRFunctions->find(sharedFunctionSettings(), *function))
+					{
+						forks[function] = move(fork);
+						continue;
+					}
+				shared_ptr<IRGenerator> generator = shared ?
+					sharedFunctionGenerator() :
+					shared_ptr<IRGenerator>(new IRGenerator(m_evmVersion, m_optimiserSettings, m_context.forkForFunctionGeneration()));
+				generators[function] = generator;
+				forks[function] = shared_ptr<IRGenerationContext const>(generator, &generator->m_context);
+				threadPool.submit([generator, &typeProvider, function]() {
+					TypeProvider::Scope typeScope(typeProvider);
+					generator->generateFunction(*function);
+				});
+			}
+			threadPool.wait();
+
+			vector<FunctionDefinition const*> nextRound;
+			for (FunctionDefinition const* function: round)
+				for (FunctionDefinition const* enqueued: forks.at(function)->forkEnqueuedFunctions())
+					if (
+						!forks.count(enqueued) &&
+						!m_context.functionCollector().contains(IRNames::function(*enqueued)) &&
+						!util::contains(nextRound, enqueued)
+					)
+						nextRound.push_back(enqueued);
+			round = move(nextRound);
+		}
+	}
+	catch (...)
+	{
+		// Generate the functions one after the other so that the error is the same.
+		return nullopt;
+	}
+
+	if (m_sharedIRFunctions)
+		for (auto const& [function, generator]: generators)
+			if (SharedIRFunctionCache::shareable(*function))
+				m_sharedIRFunctions->insert(sharedFunctionSettings(), *function, forks.at(function));
+
+	map<FunctionDefinition const*, IRGenerationContext const*, AscendingFunctionIDCompare> forkContexts;
+	for (auto const& [function, fork]: forks)
+		forkContexts[function] = fork.get();
+	return m_context.mergeForkedFunctions(forkContexts);
+}
+
+shared_ptr<IRGenerator> IRGenerator::sharedFunctionGenerator() const
+{
+	return shared_ptr<IRGenerator>(
+		new IRGenerator(m_evmVersion, m_optimiserSettings, m_context.forkForFunctionGeneration(true))
+	);
+}
+
+string IRGenerator::sharedFunctionSettings() const
+{
+	return m_evmVersion.name() + "/" + revertStringsToString(m_context.revertStrings());
+}
+
 InternalDispatchMap IRGenerator::generateInternalDispatchFunctions()
 {
 	solAssert(
@@ -261,22 +504,16 @@ InternalDispatchMap IRGenerator::generateInternalDispatchFunctions()
 		m_context.functionCollector().createFunction(funName, [&]() {
 			Whiskers templ(R"(
 				function <functionName>(fun<?+in>, <in></+in>) <?+out>-> <out></+out> {
-					switch fun
-					<#cases>
-					case <funID>
-					{
-						<?+out> <out> :=</+out> <name>(<in>)
-					}
-					</cases>
-					default { <panic>() }
+					<body>
 				}
 			)");
 			templ("functionName", funName);
-			templ("panic", m_utils.panicFunction(PanicCode::InvalidInternalFunction));
-			templ("in", suffixedVariableNameList("in_", 0, arity.in));
-			templ("out", suffixedVariableNameList("out_", 0, arity.out));
+			string in = suffixedVariableNameList("in_", 0, arity.in);
+			string out = suffixedVariableNameList("out_", 0, arity.out);
+			templ("in", in);
+			templ("out", out);
 
-			vector<map<string, string>> cases;
+			vector<pair<int64_t, string>> functions;
 			for (FunctionDefinition const* function: internalDispatchMap.at(arity))
 			{
 				solAssert(function, "");
@@ -289,13 +526,17 @@ InternalDispatchMap IRGenerator::generateInternalDispatchFunctions()
 				solAssert(function->id() != 0, "Unexpected function ID: 0");
 				solAssert(m_context.functionCollector().contains(IRNames::function(*function)), "");
 
-				cases.emplace_back(map<string, string>{
-					{"funID", to_string(function->id())},
-					{"name", IRNames::function(*function)}
-				});
+				functions.emplace_back(function->id(), IRNames::function(*function));
 			}
 
-			templ("cases", move(cases));
+			templ("body", internalDispatchSwitch(
+				functions,
+				0,
+				functions.size(),
+				in,
+				out,
+				m_utils.panicFunction(PanicCode::InvalidInternalFunction)
+			));
 			return templ.render();
 		});
 	}
@@ -863,21 +1104,7 @@ string IRGenerator::dispatchRoutine(ContractDefinition const& _contract)
 		if iszero(lt(calldatasize(), 4))
 		{
 			let selector := <shr224>(calldataload(0))
-			switch selector
-			<#cases>
-			case <functionSelector>
-			{
-				// <functionName>
-				<delegatecallCheck>
-				<callValueCheck>
-				<?+params>let <params> := </+params> <abiDecode>(4, calldatasize())
-				<?+retParams>let <retParams> := </+retParams> <function>(<params>)
-				let memPos := <allocate>(0)
-				let memEnd := <abiEncode>(memPos <?+retParams>,</+retParams> <retParams>)
-				return(memPos, sub(memEnd, memPos))
-			}
-			</cases>
-			default {}
+			<selectorSwitch>
 		}
 		if iszero(calldatasize()) { <receiveEther> }
 		<fallback>
@@ -924,7 +1151,25 @@ string IRGenerator::dispatchRoutine(ContractDefinition const& _contract)
 		templ["allocate"] = m_utils.allocationFunction();
 		templ["abiEncode"] = abiFunctions.tupleEncoder(type->returnParameterTypes(), type->returnParameterTypes(), _contract.isLibrary());
 	}
-	t("cases", functions);
+	size_t runs = m_optimiserSettings.expectedExecutionsPerDeployment;
+	map<string, uint64_t> const& weights = m_optimiserSettings.functionWeights;
+	vector<util::FixedHash<4>> selectors;
+	for (auto const& function: _contract.interfaceFunctions())
+		selectors.emplace_back(function.first);
+	vector<map<string, string>> frequentFunctions;
+	for (auto const& selector: CompilerUtils::extractFrequentFunctions(selectors, weights, runs))
+	{
+		auto it = find_if(functions.begin(), functions.end(), [&](map<string, string> const& _function) {
+			return _function.at("functionSelector") == "0x" + selector.hex();
+		});
+		solAssert(it != functions.end(), "");
+		frequentFunctions.emplace_back(move(*it));
+		functions.erase(it);
+	}
+	string dispatch = selectorSwitch(functions, 0, functions.size(), runs, weights);
+	if (!frequentFunctions.empty())
+		dispatch = linearSelectorSwitch(move(frequentFunctions), dispatch);
+	t("selectorSwitch", dispatch);
 	FunctionDefinition const* etherReceiver = _contract.receiveFunction();
 	if (etherReceiver)
 	{
@@ -996,7 +1241,12 @@ void IRGenerator::resetContext(ContractDefinition const& _contract)
 		m_context.internalDispatchClean(),
 		"Reset internal dispatch map without consuming it."
 	);
-	m_context = IRGenerationContext(m_evmVersion, m_context.revertStrings(), m_optimiserSettings);
+	m_context = IRGenerationContext(
+		m_evmVersion,
+		m_context.revertStrings(),
+		m_optimiserSettings,
+		m_context.sharedFunctions()
+	);
 
 	m_context.setMostDerivedContract(_contract);
 	for (auto const& var: ContractType(_contract).stateVariables())
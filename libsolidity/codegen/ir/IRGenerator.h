@@ -29,7 +29,16 @@
 #include <libsolidity/codegen/ir/IRGenerationContext.h>
 #include <libsolidity/codegen/YulUtilFunctions.h>
 #include <liblangutil/EVMVersion.h>
+#include <memory>
+#include <optional>
 #include <string>
+#include <tuple>
+
+namespace solidity::yul
+{
+struct Object;
+class OptimisedCodeCache;
+}
 
 namespace solidity::frontend
 {
@@ -42,22 +51,48 @@ public:
 	IRGenerator(
 		langutil::EVMVersion _evmVersion,
 		RevertStrings _revertStrings,
-		OptimiserSettings _optimiserSettings
+		OptimiserSettings _optimiserSettings,
+		std::shared_ptr<SharedYulFunctionCache> _sharedFunctions = {},
+		std::shared_ptr<SharedIRFunctionCache> _sharedIRFunctions = {},
+		std::shared_ptr<yul::OptimisedCodeCache> _optimisedCodeCache = {},
+		size_t _parallelism = 1
 	):
 		m_evmVersion(_evmVersion),
 		m_optimiserSettings(_optimiserSettings),
-		m_context(_evmVersion, _revertStrings, std::move(_optimiserSettings)),
-		m_utils(_evmVersion, m_context.revertStrings(), m_context.functionCollector())
+		m_context(_evmVersion, _revertStrings, std::move(_optimiserSettings), std::move(_sharedFunctions)),
+		m_utils(_evmVersion, m_context.revertStrings(), m_context.functionCollector()),
+		m_sharedIRFunctions(std::move(_sharedIRFunctions)),
+		m_optimisedCodeCache(std::move(_optimisedCodeCache)),
+		m_parallelism(_parallelism)
 	{}
 
-	/// Generates and returns the IR code, in unoptimized and optimized form
-	/// (or just pretty-printed, depending on the optimizer settings).
-	std::pair<std::string, std::string> run(
+	/// Generates the IR code and optimizes it (or just analyzes it, depending on the optimizer settings).
+	/// @returns the IR code, the optimized IR code and the optimized IR as analyzed Yul object.
+	/// The optimized IR code is only pretty-printed if @a _printOptimized is true and empty otherwise.
+	std::tuple<std::string, std::string, std::shared_ptr<yul::Object>> run(
+		ContractDefinition const& _contract,
+		std::map<ContractDefinition const*, std::string_view const> const& _otherYulSources,
+		bool _printOptimized = true
+	);
+
+	/// Generates the IR code without analysing or optimizing it. This is enough for contracts
+	/// that are only needed as sub-objects of other contracts, because their IR is embedded
+	/// unoptimized and optimized as part of the object it is embedded in.
+	std::string runWithoutOptimization(
 		ContractDefinition const& _contract,
 		std::map<ContractDefinition const*, std::string_view const> const& _otherYulSources
 	);
 
 private:
+	/// Creates a generator for functions of the current contract of another generator, using the
+	/// forked context @a _context.
+	IRGenerator(langutil::EVMVersion _evmVersion, OptimiserSettings _optimiserSettings, IRGenerationContext _context):
+		m_evmVersion(_evmVersion),
+		m_optimiserSettings(std::move(_optimiserSettings)),
+		m_context(std::move(_context)),
+		m_utils(_evmVersion, m_context.revertStrings(), m_context.functionCollector())
+	{}
+
 	std::string generate(
 		ContractDefinition const& _contract,
 		std::map<ContractDefinition const*, std::string_view const> const& _otherYulSources
@@ -68,6 +103,16 @@ private:
 	/// The resulting code is stored in the function collector in IRGenerationContext.
 	/// @returns A set of ast nodes of the generated functions.
 	std::set<FunctionDefinition const*> generateQueuedFunctions();
+	/// Generates the functions from the function generation queue on up to m_parallelism threads
+	/// and merges the code so that it is the same as if generated one after the other.
+	/// @returns the generated functions or nullopt, without changing the context, if there are
+	/// too few functions or one of them could not be generated.
+	std::optional<std::set<FunctionDefinition const*>> generateQueuedFunctionsConcurrently();
+	/// @returns a generator using a standalone fork of the context, for generating a function
+	/// whose context is stored in m_sharedIRFunctions.
+	std::shared_ptr<IRGenerator> sharedFunctionGenerator() const;
+	/// @returns the key of the settings of the functions in m_sharedIRFunctions.
+	std::string sharedFunctionSettings() const;
 	/// Generates  all the internal dispatch functions necessary to handle any function that could
 	/// possibly be called via a pointer.
 	/// @return The content of the dispatch for reuse in runtime code. Reuse is necessary because
@@ -119,6 +164,11 @@ private:
 
 	IRGenerationContext m_context;
 	YulUtilFunctions m_utils;
+	/// Forked contexts of the functions that are generated only once for all contracts.
+	std::shared_ptr<SharedIRFunctionCache> m_sharedIRFunctions;
+	std::shared_ptr<yul::OptimisedCodeCache> m_optimisedCodeCache;
+	/// Maximum number of threads to generate functions on, zero meaning one per hardware thread.
+	size_t const m_parallelism = 1;
 };
 
 }
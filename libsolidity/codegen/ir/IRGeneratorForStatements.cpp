@@ -47,6 +47,7 @@
 #include <libsolutil/FunctionSelector.h>
 #include <libsolutil/Visitor.h>
 
+#include <boost/range/adaptor/map.hpp>
 #include <boost/range/adaptor/transformed.hpp>
 
 using namespace std;
@@ -203,6 +204,89 @@ private:
 	ExternalRefsMap const& m_references;
 };
 
+/// @returns the identifier at the start of @a _expression if it is an identifier or a chain of
+/// struct member, array length and array index accesses, and nullptr otherwise.
+Identifier const* accessChainRoot(Expression const& _expression)
+{
+	if (auto identifier = dynamic_cast<Identifier const*>(&_expression))
+		return identifier;
+	else if (auto memberAccess = dynamic_cast<MemberAccess const*>(&_expression))
+	{
+		Type const& baseType = *memberAccess->expression().annotation().type;
+		if (
+			(
+				baseType.category() == Type::Category::Struct &&
+				dynamic_cast<VariableDeclaration const*>(memberAccess->annotation().referencedDeclaration)
+			) ||
+			(baseType.category() == Type::Category::Array && memberAccess->memberName() == "length")
+		)
+			return accessChainRoot(memberAccess->expression());
+	}
+	else if (auto indexAccess = dynamic_cast<IndexAccess const*>(&_expression))
+		if (
+			indexAccess->indexExpression() &&
+			indexAccess->baseExpression().annotation().type->category() == Type::Category::Array
+		)
+			return accessChainRoot(indexAccess->baseExpression());
+	return nullptr;
+}
+
+/**
+ * Checks that a parameter of a function is only used to read values of value type through
+ * member and index accesses, so that it can refer to calldata instead of a copy in memory.
+ */
+class ParameterReadChecker: public ASTConstVisitor
+{
+public:
+	static bool onlyRead(FunctionDefinition const& _function, VariableDeclaration const& _parameter)
+	{
+		ParameterReadChecker checker{_parameter};
+		_function.body().accept(checker);
+		return checker.m_onlyRead;
+	}
+
+private:
+	explicit ParameterReadChecker(VariableDeclaration const& _parameter): m_parameter(_parameter) {}
+
+	bool visit(Identifier const& _identifier) override { return visitAccess(_identifier); }
+	bool visit(MemberAccess const& _memberAccess) override { return visitAccess(_memberAccess); }
+	bool visit(IndexAccess const& _indexAccess) override { return visitAccess(_indexAccess); }
+	bool visit(InlineAssembly const& _inlineAssembly) override
+	{
+		for (auto const& reference: _inlineAssembly.annotation().externalReferences | boost::adaptors::map_values)
+			if (reference.declaration == &m_parameter)
+				m_onlyRead = false;
+		return false;
+	}
+
+	bool visitAccess(Expression const& _expression)
+	{
+		Identifier const* root = accessChainRoot(_expression);
+		if (!root || root->annotation().referencedDeclaration != &m_parameter)
+			return true;
+
+		if (!_expression.annotation().type->isValueType() || _expression.annotation().willBeWrittenTo)
+			m_onlyRead = false;
+		else
+			visitIndices(_expression);
+		return false;
+	}
+
+	void visitIndices(Expression const& _expression)
+	{
+		if (auto memberAccess = dynamic_cast<MemberAccess const*>(&_expression))
+			visitIndices(memberAccess->expression());
+		else if (auto indexAccess = dynamic_cast<IndexAccess const*>(&_expression))
+		{
+			visitIndices(indexAccess->baseExpression());
+			indexAccess->indexExpression()->accept(*this);
+		}
+	}
+
+	VariableDeclaration const& m_parameter;
+	bool m_onlyRead = true;
+};
+
 }
 
 string IRGeneratorForStatements::code() const
@@ -936,19 +1020,32 @@ void IRGeneratorForStatements::endVisit(FunctionCall const& _functionCall)
 
 		solAssert(!functionType->takesArbitraryParameters(), "");
 
+		// Calldata arguments are passed by reference instead of being copied to memory
+		// to parameters that the function only reads from.
+		map<size_t, Type const*> calldataViews;
+		if (functionDef && !functionType->bound())
+			calldataViews = calldataViewParameters(*functionDef, arguments);
+
 		vector<string> args;
 		if (functionType->bound())
 			args += IRVariable(_functionCall.expression()).part("self").stackSlots();
 
 		for (size_t i = 0; i < arguments.size(); ++i)
-			args += convert(*arguments[i], *parameterTypes[i]).stackSlots();
+			args += convert(*arguments[i], calldataViews.count(i) ? *calldataViews.at(i) : *parameterTypes[i]).stackSlots();
 
 		if (functionDef)
+		{
+			// The function itself is generated in any case, so that the generated functions
+			// match the call graph. The optimiser removes it if it is not called.
+			string function = m_context.enqueueFunctionForCodeGeneration(*functionDef);
+			if (!calldataViews.empty())
+				function = calldataViewFunction(*functionDef, calldataViews);
 			define(_functionCall) <<
-				m_context.enqueueFunctionForCodeGeneration(*functionDef) <<
+				function <<
 				"(" <<
 				joinHumanReadable(args) <<
 				")\n";
+		}
 		else
 		{
 			YulArity arity = YulArity::fromType(*functionType);
@@ -986,7 +1083,7 @@ void IRGeneratorForStatements::endVisit(FunctionCall const& _functionCall)
 		TypePointers nonIndexedParamTypes;
 		if (!event.isAnonymous())
 			define(indexedArgs.emplace_back(m_context.newYulVariable(), *TypeProvider::uint256())) <<
-				formatNumber(u256(h256::Arith(keccak256(functionType->externalSignature())))) << "\n";
+				formatNumber(u256(h256::Arith(functionType->externalSignatureHash()))) << "\n";
 		for (size_t i = 0; i < event.parameters().size(); ++i)
 		{
 			Expression const& arg = *arguments[i];
@@ -1205,26 +1302,11 @@ void IRGeneratorForStatements::endVisit(FunctionCall const& _functionCall)
 			{
 				solAssert(type(*arguments.front()).isImplicitlyConvertibleTo(*TypeProvider::stringMemory()),"");
 
-				Whiskers templ(R"({
-					let <pos> := <allocateUnbounded>()
-					mstore(<pos>, <hash>)
-					let <end> := <encode>(add(<pos>, 4) <argumentVars>)
-					revert(<pos>, sub(<end>, <pos>))
-				})");
-				templ("pos", m_context.newYulVariable());
-				templ("end", m_context.newYulVariable());
-				templ("hash", util::selectorFromSignature("Error(string)").str());
-				templ("allocateUnbounded", m_utils.allocateUnboundedFunction());
-				templ(
-					"argumentVars",
-					joinHumanReadablePrefixed(IRVariable{*arguments.front()}.stackSlots())
-				);
-				templ("encode", m_context.abiFunctions().tupleEncoder(
-					{&type(*arguments.front())},
-					{TypeProvider::stringMemory()}
-				));
-
-				m_code << templ.render();
+				m_code <<
+					m_utils.revertWithStringFunction(type(*arguments.front())) <<
+					"(" <<
+					IRVariable{*arguments.front()}.commaSeparatedList() <<
+					")\n";
 			}
 		}
 
@@ -1271,6 +1353,10 @@ void IRGeneratorForStatements::endVisit(FunctionCall const& _functionCall)
 				"(" <<
 				array.commaSeparatedList() <<
 				"))\n";
+
+			if (isUnreferencedMemoryTemporary(*arguments.front()))
+				// The hashed data cannot be accessed anymore, so its memory can be reused.
+				m_code << m_utils.finalizeAllocationFunction() << "(" << array.part("mpos").name() << ", 0)\n";
 		}
 		break;
 	}
@@ -1329,7 +1415,7 @@ void IRGeneratorForStatements::endVisit(FunctionCall const& _functionCall)
 	case FunctionType::Kind::AddMod:
 	case FunctionType::Kind::MulMod:
 	{
-		static map<FunctionType::Kind, string> functions = {
+		static map<FunctionType::Kind, string> const functions = {
 			{FunctionType::Kind::AddMod, "addmod"},
 			{FunctionType::Kind::MulMod, "mulmod"},
 		};
@@ -1347,14 +1433,14 @@ void IRGeneratorForStatements::endVisit(FunctionCall const& _functionCall)
 		for (size_t i = 0; i < 2; ++i)
 			args += expressionAsType(*arguments[i], *(parameterTypes[i])) + ", ";
 		args += modulus.name();
-		define(_functionCall) << functions[functionType->kind()] << "(" << args << ")\n";
+		define(_functionCall) << functions.at(functionType->kind()) << "(" << args << ")\n";
 		break;
 	}
 	case FunctionType::Kind::GasLeft:
 	case FunctionType::Kind::Selfdestruct:
 	case FunctionType::Kind::BlockHash:
 	{
-		static map<FunctionType::Kind, string> functions = {
+		static map<FunctionType::Kind, string> const functions = {
 			{FunctionType::Kind::GasLeft, "gas"},
 			{FunctionType::Kind::Selfdestruct, "selfdestruct"},
 			{FunctionType::Kind::BlockHash, "blockhash"},
@@ -1364,7 +1450,7 @@ void IRGeneratorForStatements::endVisit(FunctionCall const& _functionCall)
 		string args;
 		for (size_t i = 0; i < arguments.size(); ++i)
 			args += (args.empty() ? "" : ", ") + expressionAsType(*arguments[i], *(parameterTypes[i]));
-		define(_functionCall) << functions[functionType->kind()] << "(" << args << ")\n";
+		define(_functionCall) << functions.at(functionType->kind()) << "(" << args << ")\n";
 		break;
 	}
 	case FunctionType::Kind::Creation:
@@ -1465,12 +1551,12 @@ void IRGeneratorForStatements::endVisit(FunctionCall const& _functionCall)
 		solAssert(!functionType->gasSet(), "");
 		solAssert(!functionType->bound(), "");
 
-		static map<FunctionType::Kind, std::tuple<unsigned, size_t>> precompiles = {
+		static map<FunctionType::Kind, std::tuple<unsigned, size_t>> const precompiles = {
 			{FunctionType::Kind::ECRecover, std::make_tuple(1, 0)},
 			{FunctionType::Kind::SHA256, std::make_tuple(2, 0)},
 			{FunctionType::Kind::RIPEMD160, std::make_tuple(3, 12)},
 		};
-		auto [ address, offset ] = precompiles[functionType->kind()];
+		auto [ address, offset ] = precompiles.at(functionType->kind());
 		TypePointers argumentTypes;
 		vector<string> argumentStrings;
 		for (auto const& arg: arguments)
@@ -1517,6 +1603,13 @@ void IRGeneratorForStatements::endVisit(FunctionCall const& _functionCall)
 
 		m_code << templ.render();
 
+		if (
+			FunctionType::Kind::ECRecover != functionType->kind() &&
+			isUnreferencedMemoryTemporary(*arguments.front())
+		)
+			// The hashed data cannot be accessed anymore, so its memory can be reused.
+			m_code << m_utils.finalizeAllocationFunction() << "(" << IRVariable(*arguments.front()).part("mpos").name() << ", 0)\n";
+
 		break;
 	}
 	default:
@@ -1563,6 +1656,12 @@ bool IRGeneratorForStatements::visit(MemberAccess const& _memberAccess)
 		return false;
 	}
 
+	if (readsFromCalldataView(_memberAccess))
+	{
+		define(_memberAccess, calldataViewAccess(_memberAccess));
+		return false;
+	}
+
 	return true;
 }
 
@@ -1622,9 +1721,9 @@ void IRGeneratorForStatements::endVisit(MemberAccess const& _memberAccess)
 		{
 			u256 identifier;
 			if (auto const* variable = dynamic_cast<VariableDeclaration const*>(declaration))
-				identifier = FunctionType(*variable).externalIdentifier();
+				identifier = TypeProvider::function(*variable)->externalIdentifier();
 			else if (auto const* function = dynamic_cast<FunctionDefinition const*>(declaration))
-				identifier = FunctionType(*function).externalIdentifier();
+				identifier = TypeProvider::function(*function)->externalIdentifier();
 			else
 				solAssert(false, "Contract member is neither variable nor function.");
 
@@ -1819,31 +1918,8 @@ void IRGeneratorForStatements::endVisit(MemberAccess const& _memberAccess)
 			break;
 		}
 		case DataLocation::CallData:
-		{
-			string baseRef = expression.part("offset").name();
-			string offset = m_context.newYulVariable();
-			m_code << "let " << offset << " := " << "add(" << baseRef << ", " << to_string(structType.calldataOffsetOfMember(member)) << ")\n";
-			if (_memberAccess.annotation().type->isDynamicallyEncoded())
-				define(_memberAccess) <<
-					m_utils.accessCalldataTailFunction(*_memberAccess.annotation().type) <<
-					"(" <<
-					baseRef <<
-					", " <<
-					offset <<
-					")\n";
-			else if (
-				dynamic_cast<ArrayType const*>(_memberAccess.annotation().type) ||
-				dynamic_cast<StructType const*>(_memberAccess.annotation().type)
-			)
-				define(_memberAccess) << offset << "\n";
-			else
-				define(_memberAccess) <<
-					m_utils.readFromCalldata(*_memberAccess.annotation().type) <<
-					"(" <<
-					offset <<
-					")\n";
+			defineCalldataStructMember(_memberAccess, expression, member);
 			break;
-		}
 		default:
 			solAssert(false, "Illegal data location for struct.");
 		}
@@ -2042,6 +2118,17 @@ bool IRGeneratorForStatements::visit(InlineAssembly const& _inlineAsm)
 }
 
 
+bool IRGeneratorForStatements::visit(IndexAccess const& _indexAccess)
+{
+	if (readsFromCalldataView(_indexAccess))
+	{
+		define(_indexAccess, calldataViewAccess(_indexAccess));
+		return false;
+	}
+
+	return true;
+}
+
 void IRGeneratorForStatements::endVisit(IndexAccess const& _indexAccess)
 {
 	setLocation(_indexAccess);
@@ -2123,30 +2210,13 @@ void IRGeneratorForStatements::endVisit(IndexAccess const& _indexAccess)
 				break;
 			}
 			case DataLocation::CallData:
-			{
-				string const indexAccessFunctionCall =
-					m_utils.calldataArrayIndexAccessFunction(arrayType) +
-					"(" +
-					IRVariable(_indexAccess.baseExpression()).commaSeparatedList() +
-					", " +
-					expressionAsType(*_indexAccess.indexExpression(), *TypeProvider::uint256()) +
-					")";
-				if (arrayType.isByteArray())
-					define(_indexAccess) <<
-						m_utils.cleanupFunction(*arrayType.baseType()) <<
-						"(calldataload(" <<
-						indexAccessFunctionCall <<
-						"))\n";
-				else if (arrayType.baseType()->isValueType())
-					define(_indexAccess) <<
-						m_utils.readFromCalldata(*arrayType.baseType()) <<
-						"(" <<
-						indexAccessFunctionCall <<
-						")\n";
-				else
-					define(_indexAccess) << indexAccessFunctionCall << "\n";
+				defineCalldataArrayElement(
+					_indexAccess,
+					arrayType,
+					_indexAccess.baseExpression(),
+					expressionAsType(*_indexAccess.indexExpression(), *TypeProvider::uint256())
+				);
 				break;
-			}
 		}
 	}
 	else if (baseType.category() == Type::Category::FixedBytes)
@@ -2967,6 +3037,225 @@ Type const& IRGeneratorForStatements::type(Expression const& _expression)
 	return *_expression.annotation().type;
 }
 
+bool IRGeneratorForStatements::isUnreferencedMemoryTemporary(Expression const& _expression)
+{
+	auto const* functionCall = dynamic_cast<FunctionCall const*>(&_expression);
+	if (!functionCall || *functionCall->annotation().kind != FunctionCallKind::FunctionCall)
+		return false;
+
+	auto const* functionType = dynamic_cast<FunctionType const*>(functionCall->expression().annotation().type);
+	if (!functionType)
+		return false;
+
+	// The encoding functions copy their arguments into a fresh memory area
+	// and the result is not stored anywhere before being passed on.
+	switch (functionType->kind())
+	{
+	case FunctionType::Kind::ABIEncode:
+	case FunctionType::Kind::ABIEncodePacked:
+	case FunctionType::Kind::ABIEncodeWithSelector:
+	case FunctionType::Kind::ABIEncodeWithSignature:
+		return true;
+	default:
+		return false;
+	}
+}
+
+map<size_t, Type const*> IRGeneratorForStatements::calldataViewParameters(
+	FunctionDefinition const& _function,
+	vector<ASTPointer<Expression const>> const& _arguments
+)
+{
+	map<size_t, Type const*> calldataViews;
+	if (!_function.modifiers().empty() || _function.isConstructor())
+		return calldataViews;
+
+	solAssert(_function.parameters().size() == _arguments.size(), "");
+	for (size_t i = 0; i < _arguments.size(); ++i)
+	{
+		VariableDeclaration const& parameter = *_function.parameters()[i];
+		auto const* parameterType = dynamic_cast<ReferenceType const*>(parameter.annotation().type);
+		Type const& argumentType = type(*_arguments[i]);
+		if (
+			parameterType &&
+			parameterType->dataStoredIn(DataLocation::Memory) &&
+			(parameterType->category() == Type::Category::Array || parameterType->category() == Type::Category::Struct) &&
+			argumentType == *TypeProvider::withLocation(parameterType, DataLocation::CallData, true) &&
+			ParameterReadChecker::onlyRead(_function, parameter)
+		)
+			calldataViews[i] = &argumentType;
+	}
+	return calldataViews;
+}
+
+string IRGeneratorForStatements::calldataViewFunction(
+	FunctionDefinition const& _function,
+	map<size_t, Type const*> const& _calldataViews
+)
+{
+	vector<size_t> viewParameters;
+	for (size_t parameter: _calldataViews | boost::adaptors::map_keys)
+		viewParameters.push_back(parameter);
+
+	string functionName = IRNames::calldataViewFunction(_function, viewParameters);
+	return m_context.functionCollector().createFunction(functionName, [&]() {
+		// The function is generated in the middle of the function that calls it.
+		map<VariableDeclaration const*, IRVariable> callerVariables = m_context.swapLocalVariables();
+		Arithmetic callerArithmetic = m_context.arithmetic();
+		m_context.setArithmetic(Arithmetic::Checked);
+		ScopeGuard restoreCaller([&]() {
+			m_context.swapLocalVariables(std::move(callerVariables));
+			m_context.setArithmetic(callerArithmetic);
+		});
+
+		Whiskers t(R"(
+			function <functionName>(<params>)<?+retParams> -> <retParams></+retParams> {
+				<retInit>
+				<body>
+			}
+		)");
+		t("functionName", functionName);
+		vector<string> params;
+		for (size_t i = 0; i < _function.parameters().size(); ++i)
+		{
+			VariableDeclaration const& parameter = *_function.parameters()[i];
+			params += (
+				_calldataViews.count(i) ?
+				m_context.addLocalVariable(parameter, *_calldataViews.at(i)) :
+				m_context.addLocalVariable(parameter)
+			).stackSlots();
+		}
+		t("params", joinHumanReadable(params));
+		vector<string> retParams;
+		IRGeneratorForStatements retInit(m_context, m_utils);
+		for (auto const& varDecl: _function.returnParameters())
+		{
+			retParams += m_context.addLocalVariable(*varDecl).stackSlots();
+			retInit.initializeLocalVar(*varDecl);
+		}
+		t("retParams", joinHumanReadable(retParams));
+		t("retInit", retInit.code());
+
+		IRGeneratorForStatements body(m_context, m_utils);
+		body.generate(_function.body());
+		t("body", body.code());
+		return t.render();
+	});
+}
+
+bool IRGeneratorForStatements::readsFromCalldataView(Expression const& _expression)
+{
+	Identifier const* root = accessChainRoot(_expression);
+	auto const* variable = root ? dynamic_cast<VariableDeclaration const*>(root->annotation().referencedDeclaration) : nullptr;
+	return
+		variable &&
+		m_context.isLocalVariable(*variable) &&
+		m_context.localVariable(*variable).type() != *variable->annotation().type &&
+		type(_expression).isValueType() &&
+		!_expression.annotation().willBeWrittenTo;
+}
+
+IRVariable IRGeneratorForStatements::calldataViewAccess(Expression const& _expression)
+{
+	if (auto identifier = dynamic_cast<Identifier const*>(&_expression))
+		return m_context.localVariable(
+			dynamic_cast<VariableDeclaration const&>(*identifier->annotation().referencedDeclaration)
+		);
+	else if (auto memberAccess = dynamic_cast<MemberAccess const*>(&_expression))
+	{
+		IRVariable base = calldataViewAccess(memberAccess->expression());
+		setLocation(*memberAccess);
+		if (auto arrayType = dynamic_cast<ArrayType const*>(&base.type()))
+		{
+			solAssert(memberAccess->memberName() == "length", "");
+			IRVariable length{m_context.newYulVariable(), *TypeProvider::uint256()};
+			define(length) << m_utils.arrayLengthFunction(*arrayType) << "(" << base.commaSeparatedList() << ")\n";
+			return length;
+		}
+
+		auto const& structType = dynamic_cast<StructType const&>(base.type());
+		IRVariable member{m_context.newYulVariable(), *structType.memberType(memberAccess->memberName())};
+		defineCalldataStructMember(member, base, memberAccess->memberName());
+		return member;
+	}
+	else
+	{
+		auto const& indexAccess = dynamic_cast<IndexAccess const&>(_expression);
+		IRVariable base = calldataViewAccess(indexAccess.baseExpression());
+		indexAccess.indexExpression()->accept(*this);
+		setLocation(indexAccess);
+
+		auto const& arrayType = dynamic_cast<ArrayType const&>(base.type());
+		IRVariable element{m_context.newYulVariable(), *arrayType.baseType()};
+		defineCalldataArrayElement(
+			element,
+			arrayType,
+			base,
+			expressionAsType(*indexAccess.indexExpression(), *TypeProvider::uint256())
+		);
+		return element;
+	}
+}
+
+void IRGeneratorForStatements::defineCalldataStructMember(
+	IRVariable const& _result,
+	IRVariable const& _struct,
+	string const& _member
+)
+{
+	auto const& structType = dynamic_cast<StructType const&>(_struct.type());
+	Type const& memberType = _result.type();
+	string baseRef = _struct.part("offset").name();
+	string offset = m_context.newYulVariable();
+	m_code << "let " << offset << " := " << "add(" << baseRef << ", " << to_string(structType.calldataOffsetOfMember(_member)) << ")\n";
+	if (memberType.isDynamicallyEncoded())
+		define(_result) <<
+			m_utils.accessCalldataTailFunction(memberType) <<
+			"(" <<
+			baseRef <<
+			", " <<
+			offset <<
+			")\n";
+	else if (dynamic_cast<ArrayType const*>(&memberType) || dynamic_cast<StructType const*>(&memberType))
+		define(_result) << offset << "\n";
+	else
+		define(_result) <<
+			m_utils.readFromCalldata(memberType) <<
+			"(" <<
+			offset <<
+			")\n";
+}
+
+void IRGeneratorForStatements::defineCalldataArrayElement(
+	IRVariable const& _result,
+	ArrayType const& _arrayType,
+	IRVariable const& _array,
+	string const& _index
+)
+{
+	string const indexAccessFunctionCall =
+		m_utils.calldataArrayIndexAccessFunction(_arrayType) +
+		"(" +
+		_array.commaSeparatedList() +
+		", " +
+		_index +
+		")";
+	if (_arrayType.isByteArray())
+		define(_result) <<
+			m_utils.cleanupFunction(*_arrayType.baseType()) <<
+			"(calldataload(" <<
+			indexAccessFunctionCall <<
+			"))\n";
+	else if (_arrayType.baseType()->isValueType())
+		define(_result) <<
+			m_utils.readFromCalldata(*_arrayType.baseType()) <<
+			"(" <<
+			indexAccessFunctionCall <<
+			")\n";
+	else
+		define(_result) << indexAccessFunctionCall << "\n";
+}
+
 bool IRGeneratorForStatements::visit(TryStatement const& _tryStatement)
 {
 	Expression const& externalCall = _tryStatement.externalCall();
@@ -26,6 +26,7 @@
 #include <libsolidity/codegen/ir/IRVariable.h>
 
 #include <functional>
+#include <map>
 
 namespace solidity::frontend
 {
@@ -90,6 +91,7 @@ public:
 	bool visit(MemberAccess const& _memberAccess) override;
 	void endVisit(MemberAccess const& _memberAccess) override;
 	bool visit(InlineAssembly const& _inlineAsm) override;
+	bool visit(IndexAccess const& _indexAccess) override;
 	void endVisit(IndexAccess const& _indexAccess) override;
 	void endVisit(IndexRangeAccess const& _indexRangeAccess) override;
 	void endVisit(Identifier const& _identifier) override;
@@ -125,6 +127,37 @@ private:
 		std::vector<ASTPointer<Expression const>> const& _arguments
 	);
 
+	/// @returns the types of the calldata arguments among @a _arguments that can be passed to
+	/// @a _function by reference instead of being copied to memory, by parameter index.
+	/// These are the arguments for memory parameters that the function only reads values of
+	/// value type from.
+	static std::map<size_t, Type const*> calldataViewParameters(
+		FunctionDefinition const& _function,
+		std::vector<ASTPointer<Expression const>> const& _arguments
+	);
+	/// Generates the variant of @a _function whose parameters with the indices in @a _calldataViews
+	/// refer to calldata of the given types instead of memory and @returns its name.
+	std::string calldataViewFunction(
+		FunctionDefinition const& _function,
+		std::map<size_t, Type const*> const& _calldataViews
+	);
+	/// @returns true if @a _expression reads a value of value type through member and index accesses
+	/// from a parameter that refers to calldata instead of memory.
+	bool readsFromCalldataView(Expression const& _expression);
+	/// Generates code for the accesses of @a _expression, which is a parameter that refers to
+	/// calldata or an access to it, on the calldata and @returns the variable holding the result.
+	IRVariable calldataViewAccess(Expression const& _expression);
+	/// Defines @a _result as the member @a _member of the calldata struct @a _struct.
+	void defineCalldataStructMember(IRVariable const& _result, IRVariable const& _struct, std::string const& _member);
+	/// Defines @a _result as the element at index @a _index of the calldata array @a _array of type @a _arrayType,
+	/// which may also be a slice of an array of that type.
+	void defineCalldataArrayElement(
+		IRVariable const& _result,
+		ArrayType const& _arrayType,
+		IRVariable const& _array,
+		std::string const& _index
+	);
+
 	/// Generates the required conversion code and @returns an IRVariable referring to the value of @a _variable
 	/// converted to type @a _to.
 	IRVariable convert(IRVariable const& _variable, Type const& _to);
@@ -184,6 +217,11 @@ private:
 
 	static Type const& type(Expression const& _expression);
 
+	/// @returns true if @a _expression evaluates to a newly allocated memory object which is not
+	/// reachable from anywhere else, so that its memory can be released by the code consuming it
+	/// as soon as it is no longer needed. The object must be the last allocation at that point.
+	static bool isUnreferencedMemoryTemporary(Expression const& _expression);
+
 	void setLocation(ASTNode const& _node);
 
 	std::string linkerSymbol(ContractDefinition const& _library) const;
@@ -19,10 +19,13 @@
 #include <libsolidity/formal/BMC.h>
 
 #include <libsolidity/formal/SymbolicState.h>
+#include <libsolidity/formal/ProvenTargets.h>
 #include <libsolidity/formal/SymbolicTypes.h>
 
 #include <libsmtutil/SMTPortfolio.h>
 
+#include <libsolutil/Tracer.h>
+
 #ifdef HAVE_Z3_DLOPEN
 #include <z3_version.h>
 #endif
@@ -36,16 +39,40 @@ using namespace solidity::frontend;
 BMC::BMC(
 	smt::EncodingContext& _context,
 	ErrorReporter& _errorReporter,
+	CharStreamProvider const& _charStreamProvider,
 	map<h256, string> const& _smtlib2Responses,
 	ReadCallback::Callback const& _smtCallback,
 	smtutil::SMTSolverChoice _enabledSolvers,
-	ModelCheckerSettings const& _settings
+	ModelCheckerSettings const& _settings,
+	size_t _parallelism,
+	shared_ptr<smtutil::SMTQueryCache> _queryCache,
+	shared_ptr<ProvenTargets> _provenTargets,
+	shared_ptr<ModelCheckerStatistics> _statistics
 ):
 	SMTEncoder(_context),
-	m_interface(make_unique<smtutil::SMTPortfolio>(_smtlib2Responses, _smtCallback, _enabledSolvers, _settings.timeout)),
+	m_interface(make_unique<smtutil::SMTPortfolio>(
+		_smtlib2Responses,
+		_smtCallback,
+		_enabledSolvers,
+		_settings.timeout,
+		_settings.raceSolvers,
+		_queryCache
+	)),
 	m_outerErrorReporter(_errorReporter),
-	m_settings(_settings)
+	m_charStreamProvider(_charStreamProvider),
+	m_settings(_settings),
+	m_provenTargets(move(_provenTargets)),
+	m_statistics(move(_statistics)),
+	m_smtlib2Responses(_smtlib2Responses),
+	m_smtCallback(_smtCallback),
+	m_enabledSolvers(_enabledSolvers),
+	m_queryCache(move(_queryCache)),
+	m_parallelism(_parallelism)
 {
+	// The workers declare the variables of the queries in the same order, so that
+	// their SMT-LIB2 queries are the same as in the sequential mode.
+	if (ThreadPool::effectiveThreads(m_parallelism) > 1)
+		dynamic_cast<smtutil::SMTPortfolio&>(*m_interface).recordDeclarations(&m_declarations);
 #if defined (HAVE_Z3) || defined (HAVE_CVC4)
 	if (_enabledSolvers.some())
 		if (!_smtlib2Responses.empty())
@@ -59,7 +86,7 @@ BMC::BMC(
 #endif
 }
 
-void BMC::analyze(SourceUnit const& _source, map<ASTNode const*, set<VerificationTargetType>> _solvedTargets)
+void BMC::analyze(SourceUnit const& _source, SolvedTargets const& _solvedTargets)
 {
 	solAssert(_source.annotation().experimentalFeatures.count(ExperimentalFeature::SMTChecker), "");
 
@@ -67,13 +94,39 @@ void BMC::analyze(SourceUnit const& _source, map<ASTNode const*, set<Verificatio
 	/// containing file level functions or constants.
 	if (SMTEncoder::analyze(_source))
 	{
-		m_solvedTargets = move(_solvedTargets);
+		m_solvedTargets = &_solvedTargets;
 		m_context.setSolver(m_interface.get());
 		m_context.clear();
 		m_context.setAssertionAccumulation(true);
 		m_variableUsage.setFunctionInlining(shouldInlineFunctionCall);
 
+		// Without a linked solver, the queries are answered by the SMT callback, which is not
+		// parallelized. Batches of queries are sent from the main thread.
+		m_workers.reset();
+		m_pendingChecks.clear();
+		if (
+			ThreadPool::effectiveThreads(m_parallelism) > 1 &&
+			m_interface->solvers() > 1 &&
+			!m_settings.batchQueries
+		)
+			m_workers = make_unique<ThreadPool>(m_parallelism);
+
 		_source.accept(*this);
+
+		if (m_workers)
+			mergeTargetChecks();
+
+		if (m_provenTargets)
+			for (auto const& [target, proven]: m_targetProofs)
+				if (proven)
+					m_provenTargets->markProven(
+						ProvenTargets::Engine::BMC,
+						{get<0>(target)},
+						*get<1>(target),
+						get<2>(target)
+					);
+		m_targetProofs.clear();
+		m_solvedTargets = nullptr;
 	}
 
 	solAssert(m_interface->solvers() > 0, "");
@@ -137,13 +190,16 @@ void BMC::endVisit(ContractDefinition const& _contract)
 		constructor->accept(*this);
 	else
 	{
+		m_encodingStart = chrono::steady_clock::now();
 		/// Visiting implicit constructor - we need a dummy callstack frame
 		pushCallStack({nullptr, nullptr});
 		inlineConstructorHierarchy(_contract);
 		popCallStack();
+		m_encodingTime = chrono::steady_clock::now() - m_encodingStart;
 		/// Check targets created by state variable initialization.
 		checkVerificationTargets();
 		m_verificationTargets.clear();
+		releaseFunctionState();
 	}
 
 	SMTEncoder::endVisit(_contract);
@@ -160,6 +216,7 @@ bool BMC::visit(FunctionDefinition const& _function)
 
 	if (m_callStack.empty())
 	{
+		m_encodingStart = chrono::steady_clock::now();
 		reset();
 		initFunction(_function);
 		m_context.addAssertion(state().txTypeConstraints() && state().txFunctionConstraints(_function));
@@ -179,9 +236,11 @@ void BMC::endVisit(FunctionDefinition const& _function)
 {
 	if (isRootFunction())
 	{
+		m_encodingTime = chrono::steady_clock::now() - m_encodingStart;
 		checkVerificationTargets();
 		m_verificationTargets.clear();
 		m_pathConditions.clear();
+		releaseFunctionState();
 	}
 
 	SMTEncoder::endVisit(_function);
@@ -629,6 +688,14 @@ void BMC::reset()
 	m_loopExecutionHappened = false;
 }
 
+void BMC::releaseFunctionState()
+{
+	// Root functions are encoded independently, so nothing local to this one is needed
+	// by the next one. Functions it inlines create their variables again.
+	m_context.releaseFunctionState();
+	m_interface->clearTranslations();
+}
+
 pair<vector<smtutil::Expression>, vector<string>> BMC::modelExpressions()
 {
 	vector<smtutil::Expression> expressionsToEvaluate;
@@ -655,7 +722,7 @@ pair<vector<smtutil::Expression>, vector<string>> BMC::modelExpressions()
 		if (uf->annotation().type->isValueType())
 		{
 			expressionsToEvaluate.emplace_back(expr(*uf));
-			expressionNames.push_back(uf->location().text());
+			expressionNames.push_back(m_charStreamProvider.text(uf->location()));
 		}
 
 	return {expressionsToEvaluate, expressionNames};
@@ -665,44 +732,210 @@ pair<vector<smtutil::Expression>, vector<string>> BMC::modelExpressions()
 
 void BMC::checkVerificationTargets()
 {
-	for (auto& target: m_verificationTargets)
-		checkVerificationTarget(target);
+	unique_ptr<TargetChecks> checks = targetChecks(m_verificationTargets);
+	if (m_workers)
+	{
+		// The constant conditions of the function were deferred, so that they are checked
+		// together with the other targets, before them.
+		for (size_t position: m_constantConditionPositions)
+			checks->errorPositions.push_back(position);
+		checks->errorPositions.resize(
+			m_constantConditions.size() + checks->targets.size(),
+			m_errorReporter.errors().size()
+		);
+		checks->targets = move(m_constantConditions) + move(checks->targets);
+		m_constantConditions.clear();
+		m_constantConditionPositions.clear();
+		if (checks->targets.empty())
+			return;
+
+		if (!m_declarations.empty())
+			m_declarationChunks.emplace_back(make_shared<Declarations const>(move(m_declarations)));
+		m_declarations.clear();
+		checks->declarations = m_declarationChunks;
+
+		TargetChecks* pending = m_pendingChecks.emplace_back(move(checks)).get();
+		TypeProvider* typeProvider = &TypeProvider::instance();
+		m_workers->submit([this, pending, typeProvider]() { checkOnWorker(*pending, *typeProvider); });
+		return;
+	}
+
+	checks->solver = m_interface.get();
+	checks->errorReporter = &m_errorReporter;
+	if (m_settings.batchQueries && !checks->targets.empty())
+	{
+		// The targets are independent, so their queries are collected first and sent to
+		// the SMT callback in one batch. The checks below then use the responses.
+		auto* portfolio = dynamic_cast<smtutil::SMTPortfolio*>(m_interface.get());
+		solAssert(portfolio, "");
+		portfolio->startQueryBatch();
+		m_collectingQueries = true;
+		for (auto& target: checks->targets)
+			checkVerificationTarget(*checks, target);
+		m_collectingQueries = false;
+		portfolio->sendQueryBatch();
+	}
+
+	for (auto& target: checks->targets)
+		checkVerificationTarget(*checks, target);
+	recordResults(*checks);
+}
+
+unique_ptr<BMC::TargetChecks> BMC::targetChecks(vector<BMCVerificationTarget> _targets)
+{
+	auto checks = make_unique<TargetChecks>();
+	checks->targets = move(_targets);
+	checks->contract = m_currentContract;
+	checks->encodingTime = m_encodingTime;
+
+	checks->extraComment = SMTEncoder::extraComment();
+	if (m_loopExecutionHappened)
+		checks->extraComment +=
+			"\nNote that some information is erased after the execution of loops.\n"
+			"You can re-introduce information using require().";
+	if (m_externalFunctionCallHappened)
+		checks->extraComment +=
+			"\nNote that external function calls are not inlined,"
+			" even if the source code of the function is available."
+			" This is due to the possibility that the actual called contract"
+			" has the same ABI but implements the function differently.";
+
+	// Earlier proofs are looked up once here instead of in the checks on the workers.
+	if (m_provenTargets && m_currentContract)
+		for (auto const& target: checks->targets)
+		{
+			vector<VerificationTargetType> types{target.type};
+			if (target.type == VerificationTargetType::UnderOverflow)
+				types = {VerificationTargetType::Underflow, VerificationTargetType::Overflow};
+			for (VerificationTargetType type: types)
+				if (m_provenTargets->proven(ProvenTargets::Engine::BMC, {m_currentContract}, *target.expression, type))
+					checks->provenBefore.emplace(target.expression, type);
+		}
+	return checks;
+}
+
+void BMC::checkOnWorker(TargetChecks& _checks, TypeProvider& _typeProvider)
+{
+	TypeProvider::Scope typeScope(_typeProvider);
+
+	ReadCallback::Callback callback;
+	if (m_smtCallback)
+		callback = [this](string const& _kind, string const& _query) {
+			lock_guard<mutex> lock(m_smtCallbackMutex);
+			return m_smtCallback(_kind, _query);
+		};
+	smtutil::SMTPortfolio solver(
+		m_smtlib2Responses,
+		callback,
+		m_enabledSolvers,
+		m_settings.timeout,
+		m_settings.raceSolvers,
+		m_queryCache
+	);
+	for (auto const& chunk: _checks.declarations)
+		for (auto const& [name, sort]: *chunk)
+			solver.declareVariable(name, sort);
+
+	ErrorReporter errorReporter(_checks.errors);
+	_checks.solver = &solver;
+	_checks.errorReporter = &errorReporter;
+	for (auto& target: _checks.targets)
+	{
+		checkVerificationTarget(_checks, target);
+		_checks.errorEnds.push_back(_checks.errors.size());
+	}
+	_checks.unhandledQueries = solver.unhandledQueries();
+
+	_checks.solver = nullptr;
+	_checks.errorReporter = nullptr;
+	_checks.targets.clear();
+	_checks.declarations.clear();
+}
+
+void BMC::mergeTargetChecks()
+{
+	m_workers->wait();
+
+	// The reports about each target are placed where they would have been reported
+	// in the sequential mode, so that the output does not depend on the parallelism.
+	ErrorList const& encodingErrors = m_errorReporter.errors();
+	ErrorList errors;
+	size_t next = 0;
+	for (auto const& checks: m_pendingChecks)
+	{
+		solAssert(checks->errorPositions.size() == checks->errorEnds.size(), "");
+		size_t begin = 0;
+		for (size_t i = 0; i < checks->errorEnds.size(); ++i)
+		{
+			size_t position = checks->errorPositions[i];
+			solAssert(next <= position && position <= encodingErrors.size(), "");
+			errors.insert(errors.end(), encodingErrors.begin() + long(next), encodingErrors.begin() + long(position));
+			next = position;
+			errors.insert(
+				errors.end(),
+				checks->errors.begin() + long(begin),
+				checks->errors.begin() + long(checks->errorEnds[i])
+			);
+			begin = checks->errorEnds[i];
+		}
+		recordResults(*checks);
+		m_unhandledQueries += checks->unhandledQueries;
+	}
+	errors.insert(errors.end(), encodingErrors.begin() + long(next), encodingErrors.end());
+
+	m_errorReporter.clear();
+	m_errorReporter.append(errors);
+	m_pendingChecks.clear();
+	m_workers.reset();
+}
+
+void BMC::recordResults(TargetChecks const& _checks)
+{
+	// A target is only proven if it cannot be violated in any of the contexts it is checked in.
+	for (auto const& [expression, type, result]: _checks.results)
+	{
+		auto [it, inserted] = m_targetProofs.emplace(make_tuple(_checks.contract, expression, type), true);
+		it->second = it->second && result == smtutil::CheckResult::UNSATISFIABLE;
+	}
+	if (m_statistics)
+		*m_statistics += _checks.statistics;
 }
 
-void BMC::checkVerificationTarget(BMCVerificationTarget& _target)
+void BMC::checkVerificationTarget(TargetChecks& _checks, BMCVerificationTarget& _target)
 {
 	switch (_target.type)
 	{
 		case VerificationTargetType::ConstantCondition:
-			checkConstantCondition(_target);
+			checkConstantCondition(_checks, _target);
 			break;
 		case VerificationTargetType::Underflow:
-			checkUnderflow(_target);
+			checkUnderflow(_checks, _target);
 			break;
 		case VerificationTargetType::Overflow:
-			checkOverflow(_target);
+			checkOverflow(_checks, _target);
 			break;
 		case VerificationTargetType::UnderOverflow:
-			checkUnderflow(_target);
-			checkOverflow(_target);
+			checkUnderflow(_checks, _target);
+			checkOverflow(_checks, _target);
 			break;
 		case VerificationTargetType::DivByZero:
-			checkDivByZero(_target);
+			checkDivByZero(_checks, _target);
 			break;
 		case VerificationTargetType::Balance:
-			checkBalance(_target);
+			checkBalance(_checks, _target);
 			break;
 		case VerificationTargetType::Assert:
-			checkAssert(_target);
+			checkAssert(_checks, _target);
 			break;
 		default:
 			solAssert(false, "");
 	}
 }
 
-void BMC::checkConstantCondition(BMCVerificationTarget& _target)
+void BMC::checkConstantCondition(TargetChecks& _checks, BMCVerificationTarget& _target)
 {
 	checkBooleanNotConstant(
+		_checks,
 		*_target.expression,
 		_target.constraints,
 		_target.value,
@@ -710,7 +943,7 @@ void BMC::checkConstantCondition(BMCVerificationTarget& _target)
 	);
 }
 
-void BMC::checkUnderflow(BMCVerificationTarget& _target)
+void BMC::checkUnderflow(TargetChecks& _checks, BMCVerificationTarget& _target)
 {
 	solAssert(
 		_target.type == VerificationTargetType::Underflow ||
@@ -718,20 +951,20 @@ void BMC::checkUnderflow(BMCVerificationTarget& _target)
 		""
 	);
 
-	if (
-		m_solvedTargets.count(_target.expression) && (
-			m_solvedTargets.at(_target.expression).count(VerificationTargetType::Underflow) ||
-			m_solvedTargets.at(_target.expression).count(VerificationTargetType::UnderOverflow)
-		)
-	)
+	if (m_solvedTargets->contains(_target.expression, VerificationTargetType::Underflow))
+		return;
+
+	if (provenBefore(_checks, _target, VerificationTargetType::Underflow))
 		return;
 
 	auto const* intType = dynamic_cast<IntegerType const*>(_target.expression->annotation().type);
 	if (!intType)
 		intType = TypeProvider::uint256();
 
-	checkCondition(
+	smtutil::CheckResult result = checkCondition(
+		_checks,
 		_target.constraints && _target.value < smt::minValue(*intType),
+		VerificationTargetType::Underflow,
 		_target.callStack,
 		_target.modelExpressions,
 		_target.expression->location(),
@@ -741,9 +974,10 @@ void BMC::checkUnderflow(BMCVerificationTarget& _target)
 		"<result>",
 		&_target.value
 	);
+	recordResult(_checks, _target, VerificationTargetType::Underflow, result);
 }
 
-void BMC::checkOverflow(BMCVerificationTarget& _target)
+void BMC::checkOverflow(TargetChecks& _checks, BMCVerificationTarget& _target)
 {
 	solAssert(
 		_target.type == VerificationTargetType::Overflow ||
@@ -751,20 +985,20 @@ void BMC::checkOverflow(BMCVerificationTarget& _target)
 		""
 	);
 
-	if (
-		m_solvedTargets.count(_target.expression) && (
-			m_solvedTargets.at(_target.expression).count(VerificationTargetType::Overflow) ||
-			m_solvedTargets.at(_target.expression).count(VerificationTargetType::UnderOverflow)
-		)
-	)
+	if (m_solvedTargets->contains(_target.expression, VerificationTargetType::Overflow))
+		return;
+
+	if (provenBefore(_checks, _target, VerificationTargetType::Overflow))
 		return;
 
 	auto const* intType = dynamic_cast<IntegerType const*>(_target.expression->annotation().type);
 	if (!intType)
 		intType = TypeProvider::uint256();
 
-	checkCondition(
+	smtutil::CheckResult result = checkCondition(
+		_checks,
 		_target.constraints && _target.value > smt::maxValue(*intType),
+		VerificationTargetType::Overflow,
 		_target.callStack,
 		_target.modelExpressions,
 		_target.expression->location(),
@@ -774,20 +1008,23 @@ void BMC::checkOverflow(BMCVerificationTarget& _target)
 		"<result>",
 		&_target.value
 	);
+	recordResult(_checks, _target, VerificationTargetType::Overflow, result);
 }
 
-void BMC::checkDivByZero(BMCVerificationTarget& _target)
+void BMC::checkDivByZero(TargetChecks& _checks, BMCVerificationTarget& _target)
 {
 	solAssert(_target.type == VerificationTargetType::DivByZero, "");
 
-	if (
-		m_solvedTargets.count(_target.expression) &&
-		m_solvedTargets.at(_target.expression).count(VerificationTargetType::DivByZero)
-	)
+	if (m_solvedTargets->contains(_target.expression, VerificationTargetType::DivByZero))
+		return;
+
+	if (provenBefore(_checks, _target, VerificationTargetType::DivByZero))
 		return;
 
-	checkCondition(
+	smtutil::CheckResult result = checkCondition(
+		_checks,
 		_target.constraints && (_target.value == 0),
+		VerificationTargetType::DivByZero,
 		_target.callStack,
 		_target.modelExpressions,
 		_target.expression->location(),
@@ -797,13 +1034,20 @@ void BMC::checkDivByZero(BMCVerificationTarget& _target)
 		"<result>",
 		&_target.value
 	);
+	recordResult(_checks, _target, VerificationTargetType::DivByZero, result);
 }
 
-void BMC::checkBalance(BMCVerificationTarget& _target)
+void BMC::checkBalance(TargetChecks& _checks, BMCVerificationTarget& _target)
 {
 	solAssert(_target.type == VerificationTargetType::Balance, "");
-	checkCondition(
+
+	if (provenBefore(_checks, _target, VerificationTargetType::Balance))
+		return;
+
+	smtutil::CheckResult result = checkCondition(
+		_checks,
 		_target.constraints && _target.value,
+		VerificationTargetType::Balance,
 		_target.callStack,
 		_target.modelExpressions,
 		_target.expression->location(),
@@ -812,20 +1056,23 @@ void BMC::checkBalance(BMCVerificationTarget& _target)
 		"Insufficient funds",
 		"address(this).balance"
 	);
+	recordResult(_checks, _target, VerificationTargetType::Balance, result);
 }
 
-void BMC::checkAssert(BMCVerificationTarget& _target)
+void BMC::checkAssert(TargetChecks& _checks, BMCVerificationTarget& _target)
 {
 	solAssert(_target.type == VerificationTargetType::Assert, "");
 
-	if (
-		m_solvedTargets.count(_target.expression) &&
-		m_solvedTargets.at(_target.expression).count(_target.type)
-	)
+	if (m_solvedTargets->contains(_target.expression, _target.type))
 		return;
 
-	checkCondition(
+	if (provenBefore(_checks, _target, VerificationTargetType::Assert))
+		return;
+
+	smtutil::CheckResult result = checkCondition(
+		_checks,
 		_target.constraints && !_target.value,
+		VerificationTargetType::Assert,
 		_target.callStack,
 		_target.modelExpressions,
 		_target.expression->location(),
@@ -833,6 +1080,7 @@ void BMC::checkAssert(BMCVerificationTarget& _target)
 		7812_error,
 		"Assertion violation"
 	);
+	recordResult(_checks, _target, VerificationTargetType::Assert, result);
 }
 
 void BMC::addVerificationTarget(
@@ -854,16 +1102,45 @@ void BMC::addVerificationTarget(
 		m_callStack,
 		modelExpressions()
 	};
-	if (_type == VerificationTargetType::ConstantCondition)
-		checkVerificationTarget(target);
+	if (_type == VerificationTargetType::ConstantCondition && m_workers)
+	{
+		m_constantConditionPositions.push_back(m_errorReporter.errors().size());
+		m_constantConditions.emplace_back(move(target));
+	}
+	else if (_type == VerificationTargetType::ConstantCondition)
+	{
+		unique_ptr<TargetChecks> checks = targetChecks({});
+		checks->solver = m_interface.get();
+		checks->errorReporter = &m_errorReporter;
+		checkVerificationTarget(*checks, target);
+	}
 	else
 		m_verificationTargets.emplace_back(move(target));
 }
 
+bool BMC::provenBefore(TargetChecks const& _checks, BMCVerificationTarget const& _target, VerificationTargetType _type)
+{
+	return _checks.provenBefore.count({_target.expression, _type});
+}
+
+void BMC::recordResult(
+	TargetChecks& _checks,
+	BMCVerificationTarget const& _target,
+	VerificationTargetType _type,
+	smtutil::CheckResult _result
+)
+{
+	if (!m_provenTargets || !_checks.contract || m_collectingQueries)
+		return;
+	_checks.results.emplace_back(_target.expression, _type, _result);
+}
+
 /// Solving.
 
-void BMC::checkCondition(
+smtutil::CheckResult BMC::checkCondition(
+	TargetChecks& _checks,
 	smtutil::Expression _condition,
+	VerificationTargetType _type,
 	vector<SMTEncoder::CallStackEntry> const& _callStack,
 	pair<vector<smtutil::Expression>, vector<string>> const& _modelExpressions,
 	SourceLocation const& _location,
@@ -874,36 +1151,49 @@ void BMC::checkCondition(
 	smtutil::Expression const* _additionalValue
 )
 {
-	m_interface->push();
-	m_interface->addAssertion(_condition);
+	_checks.solver->push();
+	_checks.solver->addAssertion(_condition);
 
 	vector<smtutil::Expression> expressionsToEvaluate;
 	vector<string> expressionNames;
-	tie(expressionsToEvaluate, expressionNames) = _modelExpressions;
-	if (_callStack.size())
+	if (m_settings.counterexamples)
+		tie(expressionsToEvaluate, expressionNames) = _modelExpressions;
+	if (_callStack.size() && m_settings.counterexamples)
 		if (_additionalValue)
 		{
 			expressionsToEvaluate.emplace_back(*_additionalValue);
 			expressionNames.push_back(_additionalValueName);
 		}
+	if (m_collectingQueries)
+	{
+		// Only records the query, see checkVerificationTargets.
+		_checks.solver->check(expressionsToEvaluate);
+		_checks.solver->pop();
+		return smtutil::CheckResult::UNKNOWN;
+	}
+
 	smtutil::CheckResult result;
 	vector<string> values;
-	tie(result, values) = checkSatisfiableAndGenerateModel(expressionsToEvaluate);
-
-	string extraComment = SMTEncoder::extraComment();
-	if (m_loopExecutionHappened)
-		extraComment +=
-			"\nNote that some information is erased after the execution of loops.\n"
-			"You can re-introduce information using require().";
-	if (m_externalFunctionCallHappened)
-		extraComment +=
-			"\nNote that external function calls are not inlined,"
-			" even if the source code of the function is available."
-			" This is due to the possibility that the actual called contract"
-			" has the same ABI but implements the function differently.";
+	auto solvingStart = chrono::steady_clock::now();
+	tie(result, values) = checkSatisfiableAndGenerateModel(_checks, expressionsToEvaluate);
+	if (m_statistics)
+	{
+		auto* portfolio = dynamic_cast<smtutil::SMTPortfolio*>(_checks.solver);
+		solAssert(portfolio, "");
+		_checks.statistics.push_back({
+			_location,
+			_type,
+			"bmc",
+			_checks.encodingTime,
+			chrono::steady_clock::now() - solvingStart,
+			portfolio->answeringSolvers(),
+			result,
+			portfolio->dumpQuery(expressionsToEvaluate).size()
+		});
+	}
 
 	SecondarySourceLocation secondaryLocation{};
-	secondaryLocation.append(extraComment, SourceLocation{});
+	secondaryLocation.append(_checks.extraComment, SourceLocation{});
 
 	switch (result)
 	{
@@ -912,22 +1202,27 @@ void BMC::checkCondition(
 		solAssert(!_callStack.empty(), "");
 		std::ostringstream message;
 		message << "BMC: " << _description << " happens here.";
-		std::ostringstream modelMessage;
-		modelMessage << "Counterexample:\n";
-		solAssert(values.size() == expressionNames.size(), "");
-		map<string, string> sortedModel;
-		for (size_t i = 0; i < values.size(); ++i)
-			if (expressionsToEvaluate.at(i).name != values.at(i))
-				sortedModel[expressionNames.at(i)] = values.at(i);
-
-		for (auto const& eval: sortedModel)
-			modelMessage << "  " << eval.first << " = " << eval.second << "\n";
+		SecondarySourceLocation counterexample;
+		if (m_settings.counterexamples)
+		{
+			std::ostringstream modelMessage;
+			modelMessage << "Counterexample:\n";
+			solAssert(values.size() == expressionNames.size(), "");
+			map<string, string> sortedModel;
+			for (size_t i = 0; i < values.size(); ++i)
+				if (expressionsToEvaluate.at(i).name != values.at(i))
+					sortedModel[expressionNames.at(i)] = values.at(i);
+
+			for (auto const& eval: sortedModel)
+				modelMessage << "  " << eval.first << " = " << eval.second << "\n";
+			counterexample.append(modelMessage.str(), SourceLocation{});
+		}
 
-		m_errorReporter.warning(
+		_checks.errorReporter->warning(
 			_errorHappens,
 			_location,
 			message.str(),
-			SecondarySourceLocation().append(modelMessage.str(), SourceLocation{})
+			counterexample
 			.append(SMTEncoder::callStackMessage(_callStack))
 			.append(move(secondaryLocation))
 		);
@@ -936,20 +1231,22 @@ void BMC::checkCondition(
 	case smtutil::CheckResult::UNSATISFIABLE:
 		break;
 	case smtutil::CheckResult::UNKNOWN:
-		m_errorReporter.warning(_errorMightHappen, _location, "BMC: " + _description + " might happen here.", secondaryLocation);
+		_checks.errorReporter->warning(_errorMightHappen, _location, "BMC: " + _description + " might happen here.", secondaryLocation);
 		break;
 	case smtutil::CheckResult::CONFLICTING:
-		m_errorReporter.warning(1584_error, _location, "BMC: At least two SMT solvers provided conflicting answers. Results might not be sound.");
+		_checks.errorReporter->warning(1584_error, _location, "BMC: At least two SMT solvers provided conflicting answers. Results might not be sound.");
 		break;
 	case smtutil::CheckResult::ERROR:
-		m_errorReporter.warning(1823_error, _location, "BMC: Error trying to invoke SMT solver.");
+		_checks.errorReporter->warning(1823_error, _location, "BMC: Error trying to invoke SMT solver.");
 		break;
 	}
 
-	m_interface->pop();
+	_checks.solver->pop();
+	return result;
 }
 
 void BMC::checkBooleanNotConstant(
+	TargetChecks& _checks,
 	Expression const& _condition,
 	smtutil::Expression const& _constraints,
 	smtutil::Expression const& _value,
@@ -960,20 +1257,20 @@ void BMC::checkBooleanNotConstant(
 	if (dynamic_cast<Literal const*>(&_condition))
 		return;
 
-	m_interface->push();
-	m_interface->addAssertion(_constraints && _value);
-	auto positiveResult = checkSatisfiable();
-	m_interface->pop();
+	_checks.solver->push();
+	_checks.solver->addAssertion(_constraints && _value);
+	auto positiveResult = checkSatisfiable(_checks);
+	_checks.solver->pop();
 
-	m_interface->push();
-	m_interface->addAssertion(_constraints && !_value);
-	auto negatedResult = checkSatisfiable();
-	m_interface->pop();
+	_checks.solver->push();
+	_checks.solver->addAssertion(_constraints && !_value);
+	auto negatedResult = checkSatisfiable(_checks);
+	_checks.solver->pop();
 
 	if (positiveResult == smtutil::CheckResult::ERROR || negatedResult == smtutil::CheckResult::ERROR)
-		m_errorReporter.warning(8592_error, _condition.location(), "BMC: Error trying to invoke SMT solver.");
+		_checks.errorReporter->warning(8592_error, _condition.location(), "BMC: Error trying to invoke SMT solver.");
 	else if (positiveResult == smtutil::CheckResult::CONFLICTING || negatedResult == smtutil::CheckResult::CONFLICTING)
-		m_errorReporter.warning(3356_error, _condition.location(), "BMC: At least two SMT solvers provided conflicting answers. Results might not be sound.");
+		_checks.errorReporter->warning(3356_error, _condition.location(), "BMC: At least two SMT solvers provided conflicting answers. Results might not be sound.");
 	else if (positiveResult == smtutil::CheckResult::SATISFIABLE && negatedResult == smtutil::CheckResult::SATISFIABLE)
 	{
 		// everything fine.
@@ -983,7 +1280,7 @@ void BMC::checkBooleanNotConstant(
 		// can't do anything.
 	}
 	else if (positiveResult == smtutil::CheckResult::UNSATISFIABLE && negatedResult == smtutil::CheckResult::UNSATISFIABLE)
-		m_errorReporter.warning(2512_error, _condition.location(), "BMC: Condition unreachable.", SMTEncoder::callStackMessage(_callStack));
+		_checks.errorReporter->warning(2512_error, _condition.location(), "BMC: Condition unreachable.", SMTEncoder::callStackMessage(_callStack));
 	else
 	{
 		string description;
@@ -998,7 +1295,7 @@ void BMC::checkBooleanNotConstant(
 			solAssert(negatedResult == smtutil::CheckResult::SATISFIABLE, "");
 			description = "BMC: Condition is always false.";
 		}
-		m_errorReporter.warning(
+		_checks.errorReporter->warning(
 			6838_error,
 			_condition.location(),
 			description,
@@ -1008,20 +1305,21 @@ void BMC::checkBooleanNotConstant(
 }
 
 pair<smtutil::CheckResult, vector<string>>
-BMC::checkSatisfiableAndGenerateModel(vector<smtutil::Expression> const& _expressionsToEvaluate)
+BMC::checkSatisfiableAndGenerateModel(TargetChecks& _checks, vector<smtutil::Expression> const& _expressionsToEvaluate)
 {
 	smtutil::CheckResult result;
 	vector<string> values;
 	try
 	{
-		tie(result, values) = m_interface->check(_expressionsToEvaluate);
+		util::Tracer::Span span("modelChecker", "bmcQuery");
+		tie(result, values) = _checks.solver->check(_expressionsToEvaluate);
 	}
 	catch (smtutil::SolverError const& _e)
 	{
 		string description("BMC: Error querying SMT solver");
 		if (_e.comment())
 			description += ": " + *_e.comment();
-		m_errorReporter.warning(8140_error, description);
+		_checks.errorReporter->warning(8140_error, description);
 		result = smtutil::CheckResult::ERROR;
 	}
 
@@ -1038,9 +1336,9 @@ BMC::checkSatisfiableAndGenerateModel(vector<smtutil::Expression> const& _expres
 	return make_pair(result, values);
 }
 
-smtutil::CheckResult BMC::checkSatisfiable()
+smtutil::CheckResult BMC::checkSatisfiable(TargetChecks& _checks)
 {
-	return checkSatisfiableAndGenerateModel({}).first;
+	return checkSatisfiableAndGenerateModel(_checks, {}).first;
 }
 
 void BMC::assignment(smt::SymbolicVariable& _symVar, smtutil::Expression const& _value)
@@ -24,6 +24,8 @@
  * - Underflow/Overflow
  * - Constant conditions
  * - Assertions
+ * If the parallelism allows it, the targets of each root function are checked on a worker thread
+ * with their own solvers while the next functions are encoded.
  */
 
 #pragma once
@@ -31,15 +33,26 @@
 
 #include <libsolidity/formal/EncodingContext.h>
 #include <libsolidity/formal/ModelCheckerSettings.h>
+#include <libsolidity/formal/ModelCheckerStatistics.h>
 #include <libsolidity/formal/SMTEncoder.h>
+#include <libsolidity/formal/SolvedTargets.h>
 
 #include <libsolidity/interface/ReadFile.h>
 
+#include <libsmtutil/SMTQueryCache.h>
 #include <libsmtutil/SolverInterface.h>
+#include <liblangutil/CharStreamProvider.h>
 #include <liblangutil/ErrorReporter.h>
 
+#include <libsolutil/ThreadPool.h>
+
+#include <chrono>
+#include <memory>
+#include <mutex>
 #include <set>
 #include <string>
+#include <tuple>
+#include <utility>
 #include <vector>
 
 using solidity::util::h256;
@@ -54,24 +67,33 @@ struct SourceLocation;
 namespace solidity::frontend
 {
 
+class ProvenTargets;
+
 class BMC: public SMTEncoder
 {
 public:
 	BMC(
 		smt::EncodingContext& _context,
 		langutil::ErrorReporter& _errorReporter,
+		langutil::CharStreamProvider const& _charStreamProvider,
 		std::map<h256, std::string> const& _smtlib2Responses,
 		ReadCallback::Callback const& _smtCallback,
 		smtutil::SMTSolverChoice _enabledSolvers,
-		ModelCheckerSettings const& _settings
+		ModelCheckerSettings const& _settings,
+		size_t _parallelism = 1,
+		std::shared_ptr<smtutil::SMTQueryCache> _queryCache = nullptr,
+		std::shared_ptr<ProvenTargets> _provenTargets = nullptr,
+		std::shared_ptr<ModelCheckerStatistics> _statistics = nullptr
 	);
 
-	void analyze(SourceUnit const& _sources, std::map<ASTNode const*, std::set<VerificationTargetType>> _solvedTargets);
+	/// Analyses @a _sources, skipping the targets in @a _solvedTargets. The CHC engine can still
+	/// be adding to them while the source is encoded, the checks wait until they are complete.
+	void analyze(SourceUnit const& _sources, SolvedTargets const& _solvedTargets);
 
 	/// This is used if the SMT solver is not directly linked into this binary.
 	/// @returns a list of inputs to the SMT solver that were not part of the argument to
 	/// the constructor.
-	std::vector<std::string> unhandledQueries() { return m_interface->unhandledQueries(); }
+	std::vector<std::string> unhandledQueries() { return m_interface->unhandledQueries() + m_unhandledQueries; }
 
 	/// @returns true if _funCall should be inlined, otherwise false.
 	/// @param _scopeContract The contract that contains the current function being analyzed.
@@ -124,6 +146,9 @@ private:
 	) override;
 
 	void reset();
+	/// Releases the symbolic state and the solver translations of the root function
+	/// whose verification targets were checked.
+	void releaseFunctionState();
 
 	std::pair<std::vector<smtutil::Expression>, std::vector<std::string>> modelExpressions();
 	//@}
@@ -137,26 +162,75 @@ private:
 		std::pair<std::vector<smtutil::Expression>, std::vector<std::string>> modelExpressions;
 	};
 
+	using Declarations = std::vector<std::pair<std::string, smtutil::SortPointer>>;
+
+	/// Verification targets that are checked together and the results of the checks.
+	/// In the parallel mode, the checks of a root function use their own solvers on a
+	/// worker thread and their results are merged in source order, see mergeTargetChecks.
+	struct TargetChecks
+	{
+		std::vector<BMCVerificationTarget> targets;
+		/// The number of errors reported by the encoding before each target would have been
+		/// checked sequentially. Only used in the parallel mode.
+		std::vector<size_t> errorPositions;
+		ContractDefinition const* contract = nullptr;
+		std::chrono::nanoseconds encodingTime{0};
+		/// The notes added to the warnings about the targets.
+		std::string extraComment;
+		/// The targets that were proven by earlier runs, by expression and type.
+		std::set<std::pair<ASTNode const*, VerificationTargetType>> provenBefore;
+		/// The declarations the targets refer to, which a worker repeats on its solvers.
+		std::vector<std::shared_ptr<Declarations const>> declarations;
+
+		smtutil::SolverInterface* solver = nullptr;
+		langutil::ErrorReporter* errorReporter = nullptr;
+
+		/// The errors reported by a worker and their number after checking each target.
+		langutil::ErrorList errors;
+		std::vector<size_t> errorEnds;
+		/// The results of the checks, by expression and type, see recordResult.
+		std::vector<std::tuple<ASTNode const*, VerificationTargetType, smtutil::CheckResult>> results;
+		ModelCheckerStatistics statistics;
+		std::vector<std::string> unhandledQueries;
+	};
+
+	/// Checks the collected verification targets of the current root function, or submits
+	/// them to a worker in the parallel mode.
 	void checkVerificationTargets();
-	void checkVerificationTarget(BMCVerificationTarget& _target);
-	void checkConstantCondition(BMCVerificationTarget& _target);
-	void checkUnderflow(BMCVerificationTarget& _target);
-	void checkOverflow(BMCVerificationTarget& _target);
-	void checkDivByZero(BMCVerificationTarget& _target);
-	void checkBalance(BMCVerificationTarget& _target);
-	void checkAssert(BMCVerificationTarget& _target);
+	/// @returns the checks of @a _targets in the state of the current root function.
+	std::unique_ptr<TargetChecks> targetChecks(std::vector<BMCVerificationTarget> _targets);
+	/// Checks the targets of @a _checks on a new solver, which is done on a worker thread.
+	void checkOnWorker(TargetChecks& _checks, TypeProvider& _typeProvider);
+	/// Waits for the workers and adds the results of their checks in source order.
+	void mergeTargetChecks();
+	/// Adds the proofs and statistics of @a _checks.
+	void recordResults(TargetChecks const& _checks);
+	void checkVerificationTarget(TargetChecks& _checks, BMCVerificationTarget& _target);
+	void checkConstantCondition(TargetChecks& _checks, BMCVerificationTarget& _target);
+	void checkUnderflow(TargetChecks& _checks, BMCVerificationTarget& _target);
+	void checkOverflow(TargetChecks& _checks, BMCVerificationTarget& _target);
+	void checkDivByZero(TargetChecks& _checks, BMCVerificationTarget& _target);
+	void checkBalance(TargetChecks& _checks, BMCVerificationTarget& _target);
+	void checkAssert(TargetChecks& _checks, BMCVerificationTarget& _target);
 	void addVerificationTarget(
 		VerificationTargetType _type,
 		smtutil::Expression const& _value,
 		Expression const* _expression
 	);
+	/// @returns true if an earlier run proved that the target of type @a _type cannot be violated.
+	bool provenBefore(TargetChecks const& _checks, BMCVerificationTarget const& _target, VerificationTargetType _type);
+	/// Records the result of checking the target of type @a _type in the context of @a _checks.
+	void recordResult(TargetChecks& _checks, BMCVerificationTarget const& _target, VerificationTargetType _type, smtutil::CheckResult _result);
 	//@}
 
 	/// Solver related.
 	//@{
 	/// Check that a condition can be satisfied.
-	void checkCondition(
+	/// @returns the answer of the solvers.
+	smtutil::CheckResult checkCondition(
+		TargetChecks& _checks,
 		smtutil::Expression _condition,
+		VerificationTargetType _type,
 		std::vector<CallStackEntry> const& _callStack,
 		std::pair<std::vector<smtutil::Expression>, std::vector<std::string>> const& _modelExpressions,
 		langutil::SourceLocation const& _location,
@@ -169,15 +243,16 @@ private:
 	/// Checks that a boolean condition is not constant. Do not warn if the expression
 	/// is a literal constant.
 	void checkBooleanNotConstant(
+		TargetChecks& _checks,
 		Expression const& _condition,
 		smtutil::Expression const& _constraints,
 		smtutil::Expression const& _value,
 		std::vector<CallStackEntry> const& _callStack
 	);
 	std::pair<smtutil::CheckResult, std::vector<std::string>>
-	checkSatisfiableAndGenerateModel(std::vector<smtutil::Expression> const& _expressionsToEvaluate);
+	checkSatisfiableAndGenerateModel(TargetChecks& _checks, std::vector<smtutil::Expression> const& _expressionsToEvaluate);
 
-	smtutil::CheckResult checkSatisfiable();
+	smtutil::CheckResult checkSatisfiable(TargetChecks& _checks);
 	//@}
 
 	std::unique_ptr<smtutil::SolverInterface> m_interface;
@@ -189,12 +264,55 @@ private:
 	/// ErrorReporter that comes from CompilerStack.
 	langutil::ErrorReporter& m_outerErrorReporter;
 
+	/// Sources of the locations used in counterexamples.
+	langutil::CharStreamProvider const& m_charStreamProvider;
+
 	std::vector<BMCVerificationTarget> m_verificationTargets;
+	/// Constant conditions of the current root function whose check is deferred to the
+	/// worker of the function in the parallel mode, and the number of errors before each.
+	std::vector<BMCVerificationTarget> m_constantConditions;
+	std::vector<size_t> m_constantConditionPositions;
+	/// If true, checkCondition only collects the queries of a batch, see checkVerificationTargets.
+	bool m_collectingQueries = false;
 
-	/// Targets that were already proven.
-	std::map<ASTNode const*, std::set<VerificationTargetType>> m_solvedTargets;
+	/// Targets that were already proven, which are not checked.
+	SolvedTargets const* m_solvedTargets = nullptr;
 
 	ModelCheckerSettings const& m_settings;
+
+	std::shared_ptr<ProvenTargets> m_provenTargets;
+	/// Whether the targets of the current source were proven in all contexts they were checked in,
+	/// by contract, expression and type.
+	std::map<std::tuple<ContractDefinition const*, ASTNode const*, VerificationTargetType>, bool> m_targetProofs;
+
+	/// Statistics of the checked targets, if requested.
+	std::shared_ptr<ModelCheckerStatistics> m_statistics;
+	std::chrono::steady_clock::time_point m_encodingStart;
+	/// Time spent encoding the current root function.
+	std::chrono::nanoseconds m_encodingTime{0};
+
+	/// Used to create the solvers of the workers.
+	//@{
+	std::map<h256, std::string> m_smtlib2Responses;
+	ReadCallback::Callback m_smtCallback;
+	/// Serializes the calls of the SMT callback by the workers.
+	std::mutex m_smtCallbackMutex;
+	smtutil::SMTSolverChoice m_enabledSolvers;
+	std::shared_ptr<smtutil::SMTQueryCache> m_queryCache;
+	//@}
+
+	/// The requested number of worker threads, zero meaning one per hardware thread.
+	size_t m_parallelism = 1;
+	/// The declarations of m_interface since the last root function that was checked on a worker,
+	/// and the ones before, which the workers share.
+	Declarations m_declarations;
+	std::vector<std::shared_ptr<Declarations const>> m_declarationChunks;
+	/// The checks submitted to the workers for the current source, in source order.
+	std::vector<std::unique_ptr<TargetChecks>> m_pendingChecks;
+	/// The queries the SMT-LIB2 interfaces of the workers could not answer.
+	std::vector<std::string> m_unhandledQueries;
+	/// The workers, if the targets are checked in parallel.
+	std::unique_ptr<util::ThreadPool> m_workers;
 };
 
 }
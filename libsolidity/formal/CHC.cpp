@@ -25,12 +25,15 @@
 #include <libsolidity/formal/ArraySlicePredicate.h>
 #include <libsolidity/formal/PredicateInstance.h>
 #include <libsolidity/formal/PredicateSort.h>
+#include <libsolidity/formal/ProvenTargets.h>
 #include <libsolidity/formal/SymbolicTypes.h>
 
 #include <libsolidity/ast/TypeProvider.h>
 
 #include <libsmtutil/CHCSmtLib2Interface.h>
 #include <libsolutil/Algorithms.h>
+#include <libsolutil/ThreadPool.h>
+#include <libsolutil/Tracer.h>
 
 #include <boost/range/adaptor/reversed.hpp>
 
@@ -38,6 +41,9 @@
 #include <z3_version.h>
 #endif
 
+#include <atomic>
+#include <limits>
+#include <numeric>
 #include <queue>
 
 using namespace std;
@@ -51,24 +57,43 @@ using namespace solidity::frontend::smt;
 CHC::CHC(
 	EncodingContext& _context,
 	ErrorReporter& _errorReporter,
+	CharStreamProvider const& _charStreamProvider,
 	[[maybe_unused]] map<util::h256, string> const& _smtlib2Responses,
 	[[maybe_unused]] ReadCallback::Callback const& _smtCallback,
 	SMTSolverChoice _enabledSolvers,
-	ModelCheckerSettings const& _settings
+	ModelCheckerSettings const& _settings,
+	size_t _parallelism,
+	shared_ptr<smtutil::SMTQueryCache> _queryCache,
+	shared_ptr<ProvenTargets> _provenTargets,
+	shared_ptr<ModelCheckerStatistics> _statistics
 ):
 	SMTEncoder(_context),
 	m_outerErrorReporter(_errorReporter),
+	m_charStreamProvider(_charStreamProvider),
 	m_enabledSolvers(_enabledSolvers),
-	m_settings(_settings)
+	m_settings(_settings),
+	m_parallelism(_parallelism),
+	m_queryCache(move(_queryCache)),
+	m_provenTargets(move(_provenTargets)),
+	m_statistics(move(_statistics))
 {
 	bool usesZ3 = _enabledSolvers.z3;
 #ifdef HAVE_Z3
 	usesZ3 = usesZ3 && Z3Interface::available();
+	if (usesZ3)
+		m_solverIDs = "z3 " + Z3Interface::version();
 #else
 	usesZ3 = false;
 #endif
 	if (!usesZ3)
+	{
 		m_interface = make_unique<CHCSmtLib2Interface>(_smtlib2Responses, _smtCallback, m_settings.timeout);
+		// Without responses or a callback, the SMT-LIB2 interface never answers.
+		if (!_smtlib2Responses.empty() || _smtCallback)
+			m_solverIDs = "smtlib2";
+		else
+			m_queryCache = nullptr;
+	}
 }
 
 void CHC::analyze(SourceUnit const& _source)
@@ -79,16 +104,22 @@ void CHC::analyze(SourceUnit const& _source)
 	/// containing file level functions or constants.
 	if (SMTEncoder::analyze(_source))
 	{
+		auto encodingStart = chrono::steady_clock::now();
 		resetSourceAnalysis();
 
 		set<SourceUnit const*, EncodingContext::IdCompare> sources;
 		sources.insert(&_source);
 		for (auto const& source: _source.referencedSourceUnits(true))
 			sources.insert(source);
+		m_analysedContracts.clear();
+		for (auto const* source: sources)
+			for (auto const* contract: ASTNode::filteredNodes<ContractDefinition>(source->nodes()))
+				m_analysedContracts.push_back(contract);
 		for (auto const* source: sources)
 			defineInterfacesAndSummaries(*source);
 		for (auto const* source: sources)
 			source->accept(*this);
+		m_encodingTime = chrono::steady_clock::now() - encodingStart;
 
 		checkVerificationTargets();
 	}
@@ -218,6 +249,14 @@ bool CHC::visit(FunctionDefinition const& _function)
 	solAssert(!m_currentFunction, "Function inlining should not happen in CHC.");
 	m_currentFunction = &_function;
 
+	if (reusesBaseSummary(_function))
+	{
+		linkBaseSummary(_function);
+		connectToInterface(_function);
+		m_currentFunction = nullptr;
+		return false;
+	}
+
 	initFunction(_function);
 
 	auto functionEntryBlock = createBlock(m_currentFunction, PredicateType::FunctionBlock);
@@ -245,7 +284,7 @@ bool CHC::visit(FunctionDefinition const& _function)
 
 void CHC::endVisit(FunctionDefinition const& _function)
 {
-	if (!_function.isImplemented())
+	if (!_function.isImplemented() || reusesBaseSummary(_function))
 		return;
 
 	solAssert(m_currentFunction && m_currentContract, "");
@@ -254,22 +293,7 @@ void CHC::endVisit(FunctionDefinition const& _function)
 
 	connectBlocks(m_currentBlock, summary(_function));
 	setCurrentBlock(*m_summaries.at(m_currentContract).at(&_function));
-
-	// Query placeholders for constructors are not created here because
-	// of contracts without constructors.
-	// Instead, those are created in endVisit(ContractDefinition).
-	if (
-		!_function.isConstructor() &&
-		_function.isPublic() &&
-		contractFunctions(*m_currentContract).count(&_function)
-	)
-	{
-		auto sum = summary(_function);
-		auto ifacePre = smt::interfacePre(*m_interfaces.at(m_currentContract), *m_currentContract, m_context);
-		auto txConstraints = state().txTypeConstraints() && state().txFunctionConstraints(_function);
-		m_queryPlaceholders[&_function].push_back({txConstraints && sum, errorFlag().currentValue(), ifacePre});
-		connectBlocks(ifacePre, interface(), txConstraints && sum && errorFlag().currentValue() == 0);
-	}
+	connectToInterface(_function);
 
 	m_currentFunction = nullptr;
 
@@ -849,7 +873,9 @@ void CHC::resetSourceAnalysis()
 	if (usesZ3)
 	{
 		/// z3::fixedpoint does not have a reset mechanism, so we need to create another.
-		m_interface.reset(new Z3CHCInterface(m_settings.timeout));
+		// Racing solvers check the targets on copies of the solver,
+		// and the query cache and the statistics need the queries in SMT-LIB2 format.
+		m_interface.reset(new Z3CHCInterface(m_settings.timeout, m_settings.raceSolvers || m_queryCache || m_statistics));
 		auto z3Interface = dynamic_cast<Z3CHCInterface const*>(m_interface.get());
 		solAssert(z3Interface, "");
 		m_context.setSolver(z3Interface->z3Interface());
@@ -1000,6 +1026,147 @@ void CHC::defineInterfacesAndSummaries(SourceUnit const& _source)
 		}
 }
 
+namespace
+{
+
+/// Detects the constructs whose encoding depends on the contract a function is encoded in:
+/// calls to user-defined functions and modifiers, which are resolved in the contract,
+/// calls to unknown code, which can change all state variables, inline assembly and
+/// storage pointers, which can refer to state variables of derived contracts.
+class ContractDependencyChecker: private ASTConstVisitor
+{
+public:
+	static bool contractIndependent(FunctionDefinition const& _function)
+	{
+		if (!_function.modifiers().empty())
+			return false;
+		ContractDependencyChecker checker;
+		_function.accept(checker);
+		return checker.m_independent;
+	}
+
+private:
+	bool visit(InlineAssembly const&) override
+	{
+		m_independent = false;
+		return false;
+	}
+
+	bool visit(VariableDeclaration const& _variable) override
+	{
+		if (_variable.referenceLocation() == VariableDeclaration::Location::Storage)
+			m_independent = false;
+		return m_independent;
+	}
+
+	bool visit(Identifier const& _identifier) override
+	{
+		auto const* declaration = _identifier.annotation().referencedDeclaration;
+		if (dynamic_cast<FunctionDefinition const*>(declaration) || dynamic_cast<ModifierDefinition const*>(declaration))
+			m_independent = false;
+		return false;
+	}
+
+	bool visit(FunctionCall const& _funCall) override
+	{
+		if (*_funCall.annotation().kind != FunctionCallKind::FunctionCall)
+			return m_independent;
+
+		auto const& funType = dynamic_cast<FunctionType const&>(*_funCall.expression().annotation().type);
+		switch (funType.kind())
+		{
+		case FunctionType::Kind::Assert:
+		case FunctionType::Kind::Require:
+		case FunctionType::Kind::Revert:
+		case FunctionType::Kind::GasLeft:
+		case FunctionType::Kind::ABIDecode:
+		case FunctionType::Kind::ABIEncode:
+		case FunctionType::Kind::ABIEncodePacked:
+		case FunctionType::Kind::ABIEncodeWithSelector:
+		case FunctionType::Kind::ABIEncodeWithSignature:
+		case FunctionType::Kind::KECCAK256:
+		case FunctionType::Kind::ECRecover:
+		case FunctionType::Kind::SHA256:
+		case FunctionType::Kind::RIPEMD160:
+		case FunctionType::Kind::BlockHash:
+		case FunctionType::Kind::AddMod:
+		case FunctionType::Kind::MulMod:
+		case FunctionType::Kind::ArrayPush:
+		case FunctionType::Kind::ByteArrayPush:
+		case FunctionType::Kind::ArrayPop:
+		case FunctionType::Kind::Event:
+		case FunctionType::Kind::ObjectCreation:
+			break;
+		default:
+			m_independent = false;
+		}
+		return m_independent;
+	}
+
+	bool m_independent = true;
+};
+
+}
+
+bool CHC::reusesBaseSummary(FunctionDefinition const& _function)
+{
+	solAssert(m_currentContract, "");
+	ContractDefinition const* base = _function.annotation().contract;
+	if (!base || base == m_currentContract || _function.isConstructor() || !m_summaries.count(base))
+		return false;
+
+	// The verification targets of the function are only created if the source of the contract it is
+	// encoded in has the pragma.
+	auto hasPragma = [](ContractDefinition const& _contract) {
+		return sourceUnitContaining(_contract)->annotation().experimentalFeatures.count(ExperimentalFeature::SMTChecker) > 0;
+	};
+	if (hasPragma(*m_currentContract) && !hasPragma(*base))
+		return false;
+
+	auto [it, inserted] = m_contractIndependentFunctions.emplace(&_function, false);
+	if (inserted)
+		it->second = ContractDependencyChecker::contractIndependent(_function);
+	return it->second;
+}
+
+void CHC::linkBaseSummary(FunctionDefinition const& _function)
+{
+	ContractDefinition const* base = _function.annotation().contract;
+	solAssert(base && m_currentContract, "");
+
+	// The values at index 0 are the ones before the call, the current values the ones after it.
+	setCurrentBlock(*m_summaries.at(m_currentContract).at(&_function));
+	auto baseSummary = smt::function(*m_summaries.at(base).at(&_function), base, m_context);
+
+	auto const& baseVariables = stateVariablesIncludingInheritedAndPrivate(*base);
+	smtutil::Expression unchanged(true);
+	for (auto const* var: m_stateVariables)
+		if (!contains(baseVariables, var))
+			unchanged = unchanged && valueAtIndex(*var, 0) == currentValue(*var);
+
+	addRule(smtutil::Expression::implies(baseSummary && unchanged, m_currentBlock), m_currentBlock.name + "_from_base");
+}
+
+void CHC::connectToInterface(FunctionDefinition const& _function)
+{
+	solAssert(m_currentContract, "");
+	// Query placeholders for constructors are not created here because
+	// of contracts without constructors.
+	// Instead, those are created in endVisit(ContractDefinition).
+	if (
+		!_function.isConstructor() &&
+		_function.isPublic() &&
+		contractFunctions(*m_currentContract).count(&_function)
+	)
+	{
+		auto sum = summary(_function);
+		auto ifacePre = smt::interfacePre(*m_interfaces.at(m_currentContract), *m_currentContract, m_context);
+		auto txConstraints = state().txTypeConstraints() && state().txFunctionConstraints(_function);
+		m_queryPlaceholders[&_function].push_back({txConstraints && sum, errorFlag().currentValue(), ifacePre});
+		connectBlocks(ifacePre, interface(), txConstraints && sum && errorFlag().currentValue() == 0);
+	}
+}
+
 void CHC::defineContractInitializer(ContractDefinition const& _contract)
 {
 	auto const& implicitConstructorPredicate = *createConstructorBlock(_contract, "contract_initializer_entry");
@@ -1291,14 +1458,34 @@ void CHC::addRule(smtutil::Expression const& _rule, string const& _ruleName)
 	m_interface->addRule(_rule, _ruleName);
 }
 
-pair<CheckResult, CHCSolverInterface::CexGraph> CHC::query(smtutil::Expression const& _query, langutil::SourceLocation const& _location)
+pair<CheckResult, CHCSolverInterface::CexGraph> CHC::query(
+	smtutil::Expression const& _query,
+	langutil::SourceLocation const& _location,
+	VerificationTargetType _type
+)
 {
+	auto solvingStart = chrono::steady_clock::now();
+	string cacheQuery;
+	if (m_queryCache || m_statistics)
+		cacheQuery = m_interface->dumpQuery(_query);
+	if (m_queryCache && cachedSafe(cacheQuery))
+	{
+		recordStatistics(_location, _type, CheckResult::UNSATISFIABLE, chrono::steady_clock::now() - solvingStart, true, cacheQuery);
+		return {CheckResult::UNSATISFIABLE, {}};
+	}
+
+	bool const counterexamples = counterexamplesNeeded();
+#ifdef HAVE_Z3
+	if (auto* spacer = dynamic_cast<Z3CHCInterface*>(m_interface.get()))
+		spacer->setCounterexamples(counterexamples);
+#endif
+	util::Tracer::Span span("modelChecker", "chcQuery");
 	CheckResult result;
 	CHCSolverInterface::CexGraph cex;
 	tie(result, cex) = m_interface->query(_query);
-	switch (result)
-	{
-	case CheckResult::SATISFIABLE:
+	if (m_queryCache && result == CheckResult::UNSATISFIABLE)
+		m_queryCache->store(m_solverIDs, cacheQuery, {result, {}});
+	if (result == CheckResult::SATISFIABLE && counterexamples)
 	{
 #ifdef HAVE_Z3
 		// Even though the problem is SAT, Spacer's pre processing makes counterexamples incomplete.
@@ -1316,20 +1503,48 @@ pair<CheckResult, CHCSolverInterface::CexGraph> CHC::query(smtutil::Expression c
 
 		spacer->setSpacerOptions(true);
 #endif
-		break;
 	}
-	case CheckResult::UNSATISFIABLE:
-		break;
-	case CheckResult::UNKNOWN:
-		break;
-	case CheckResult::CONFLICTING:
+	recordStatistics(_location, _type, result, chrono::steady_clock::now() - solvingStart, false, cacheQuery);
+	reportSolverFailure(result, _location);
+	return {result, cex};
+}
+
+void CHC::recordStatistics(
+	langutil::SourceLocation const& _location,
+	VerificationTargetType _type,
+	CheckResult _result,
+	chrono::nanoseconds _solvingTime,
+	bool _cached,
+	string const& _query
+)
+{
+	if (!m_statistics)
+		return;
+	string solver = "z3";
+	if (_cached)
+		solver = "cache";
+	else if (dynamic_cast<CHCSmtLib2Interface const*>(m_interface.get()))
+		solver = "smtlib2";
+	m_statistics->push_back({_location, _type, "chc", m_encodingTime, _solvingTime, solver, _result, _query.size()});
+}
+
+bool CHC::counterexamplesNeeded() const
+{
+	return m_settings.counterexamples && !m_errorReporter.hasExcessiveWarnings();
+}
+
+bool CHC::cachedSafe(string const& _query)
+{
+	auto answer = m_queryCache->load(m_solverIDs, _query);
+	return answer && answer->first == CheckResult::UNSATISFIABLE;
+}
+
+void CHC::reportSolverFailure(CheckResult _result, langutil::SourceLocation const& _location)
+{
+	if (_result == CheckResult::CONFLICTING)
 		m_errorReporter.warning(1988_error, _location, "CHC: At least two SMT solvers provided conflicting answers. Results might not be sound.");
-		break;
-	case CheckResult::ERROR:
+	else if (_result == CheckResult::ERROR)
 		m_errorReporter.warning(1218_error, _location, "CHC: Error trying to invoke SMT solver.");
-		break;
-	}
-	return {result, cex};
 }
 
 void CHC::verificationTargetEncountered(
@@ -1377,6 +1592,8 @@ void CHC::checkVerificationTargets()
 	// Here we combine every context in which an external function can be called with all possible verification conditions
 	// in its call graph. Each such combination forms a unique verification target.
 	vector<CHCVerificationTarget> verificationTargets;
+	set<unsigned> checkedErrorIds;
+	m_targetProofs.clear();
 	for (auto const& [function, placeholders]: m_queryPlaceholders)
 	{
 		auto functionTargets = transactionVerificationTargetsIds(function);
@@ -1384,6 +1601,16 @@ void CHC::checkVerificationTargets()
 			for (unsigned id: functionTargets)
 			{
 				auto const& target = m_verificationTargets.at(id);
+				// Targets proven by earlier runs are safe without asking the solver.
+				if (
+					m_provenTargets &&
+					m_provenTargets->proven(ProvenTargets::Engine::CHC, m_analysedContracts, *target.errorNode, target.type)
+				)
+				{
+					m_safeTargets[target.errorNode].insert(target.type);
+					checkedErrorIds.insert(target.errorId);
+					continue;
+				}
 				verificationTargets.push_back(CHCVerificationTarget{
 					{target.type, placeholder.fromPredicate, placeholder.constraints && placeholder.errorExpression == target.errorId},
 					target.errorId,
@@ -1392,9 +1619,48 @@ void CHC::checkVerificationTargets()
 			}
 	}
 
-	set<unsigned> checkedErrorIds;
-	for (auto const& target: verificationTargets)
+	// If the solvers race, the error rules of all targets are added before the first query,
+	// so that the targets can be checked on copies of the solver.
+	// The same holds if the queries are sent to the SMT callback in a batch.
+	// The same holds for checking the targets within a time budget, which retries the targets.
+	bool concurrent = false;
+	bool budgeted = false;
+#ifdef HAVE_Z3
+	concurrent = m_settings.raceSolvers && dynamic_cast<Z3CHCInterface const*>(m_interface.get());
+	budgeted = !concurrent && m_settings.timeBudget && dynamic_cast<Z3CHCInterface const*>(m_interface.get());
+#endif
+	auto* smtlib2 = dynamic_cast<CHCSmtLib2Interface*>(m_interface.get());
+	bool batched = m_settings.batchQueries && smtlib2;
+	vector<smtutil::Expression> errorPredicates;
+	vector<optional<pair<CheckResult, CHCSolverInterface::CexGraph>>> results;
+	if (concurrent || budgeted || batched)
 	{
+		for (auto const& target: verificationTargets)
+		{
+			createErrorBlock();
+			connectBlocks(target.value, error(), target.constraints);
+			errorPredicates.push_back(error());
+		}
+		if (concurrent)
+			results = queryConcurrently(verificationTargets, errorPredicates);
+		else if (budgeted)
+			results = queryWithinBudget(verificationTargets, errorPredicates);
+		else
+		{
+			vector<string> queries;
+			for (auto const& errorPredicate: errorPredicates)
+			{
+				string query = smtlib2->dumpQuery(errorPredicate);
+				if (!m_queryCache || !cachedSafe(query))
+					queries.push_back(move(query));
+			}
+			smtlib2->queryBatch(queries);
+		}
+	}
+
+	for (size_t i = 0; i < verificationTargets.size(); ++i)
+	{
+		auto const& target = verificationTargets[i];
 		string errorType;
 		ErrorId errorReporterId;
 
@@ -1439,7 +1705,34 @@ void CHC::checkVerificationTargets()
 		else
 			solAssert(false, "");
 
-		checkAndReportTarget(target, errorReporterId, errorType + " happens here.", errorType + " might happen here.");
+		if (batched)
+		{
+			if (!m_unsafeTargets.count(target.errorNode) || !m_unsafeTargets.at(target.errorNode).count(target.type))
+				reportTarget(
+					target,
+					query(errorPredicates[i], target.errorNode->location(), target.type),
+					errorPredicates[i].name,
+					errorReporterId,
+					errorType + " happens here.",
+					errorType + " might happen here."
+				);
+		}
+		else if (!concurrent && !budgeted)
+			checkAndReportTarget(target, errorReporterId, errorType + " happens here.", errorType + " might happen here.");
+		else if (results[i])
+		{
+			// CHC::query already reported the failures of the queries within the budget.
+			if (concurrent)
+				reportSolverFailure(results[i]->first, target.errorNode->location());
+			reportTarget(
+				target,
+				*results[i],
+				errorPredicates[i].name,
+				errorReporterId,
+				errorType + " happens here.",
+				errorType + " might happen here."
+			);
+		}
 		checkedErrorIds.insert(target.errorId);
 	}
 
@@ -1461,6 +1754,209 @@ void CHC::checkVerificationTargets()
 	);
 	for (auto id: unreachableErrorIds)
 		m_safeTargets[m_verificationTargets.at(id).errorNode].insert(m_verificationTargets.at(id).type);
+
+	if (m_provenTargets)
+		for (auto const& [target, proven]: m_targetProofs)
+			if (proven)
+				m_provenTargets->markProven(ProvenTargets::Engine::CHC, m_analysedContracts, *target.first, target.second);
+}
+
+#ifdef HAVE_Z3
+namespace
+{
+
+/// Answers @a _query like CHC::query on two solvers with the same rules, where the first one
+/// uses Spacer's preprocessing and the second one does not. Both queries run concurrently,
+/// and the second one is interrupted if its counterexample is not needed.
+pair<CheckResult, CHCSolverInterface::CexGraph> raceQuery(
+	Z3CHCInterface& _optimized,
+	Z3CHCInterface& _unoptimized,
+	smtutil::Expression const& _query
+)
+{
+	pair<CheckResult, CHCSolverInterface::CexGraph> result;
+	pair<CheckResult, CHCSolverInterface::CexGraph> unoptimizedResult{CheckResult::UNKNOWN, {}};
+	atomic<bool> unoptimizedNeeded{true};
+	ThreadPool pool(2);
+	pool.submit([&]() {
+		result = _optimized.query(_query);
+		if (result.first != CheckResult::SATISFIABLE)
+		{
+			unoptimizedNeeded = false;
+			_unoptimized.interrupt();
+		}
+	});
+	pool.submit([&]() {
+		// Without threads, the queries run one after another as in CHC::query.
+		if (unoptimizedNeeded)
+			unoptimizedResult = _unoptimized.query(_query);
+	});
+	pool.wait();
+
+	if (result.first == CheckResult::SATISFIABLE && unoptimizedResult.first == CheckResult::SATISFIABLE)
+		result.second = move(unoptimizedResult.second);
+	return result;
+}
+
+}
+#endif
+
+vector<optional<pair<CheckResult, CHCSolverInterface::CexGraph>>> CHC::queryConcurrently(
+	vector<CHCVerificationTarget> const& _targets,
+	vector<smtutil::Expression> const& _queries
+)
+{
+	solAssert(_targets.size() == _queries.size(), "");
+	vector<optional<pair<CheckResult, CHCSolverInterface::CexGraph>>> results(_targets.size());
+#ifdef HAVE_Z3
+	auto const* solver = dynamic_cast<Z3CHCInterface const*>(m_interface.get());
+	solAssert(solver, "");
+
+	// Targets with the same node and type are checked in order, different groups are independent.
+	vector<vector<size_t>> groups;
+	map<pair<ASTNode const*, VerificationTargetType>, size_t> groupIndices;
+	for (size_t i = 0; i < _targets.size(); ++i)
+	{
+		auto [it, inserted] = groupIndices.emplace(make_pair(_targets[i].errorNode, _targets[i].type), groups.size());
+		if (inserted)
+			groups.emplace_back();
+		groups[it->second].push_back(i);
+	}
+	if (groups.empty())
+		return results;
+
+	// Targets proven safe by earlier runs are not checked again.
+	vector<string> cacheQueries(_queries.size());
+	vector<bool> cached(_queries.size(), false);
+	if (m_queryCache || m_statistics)
+		for (size_t i = 0; i < _queries.size(); ++i)
+		{
+			cacheQueries[i] = m_interface->dumpQuery(_queries[i]);
+			if (m_queryCache && cachedSafe(cacheQueries[i]))
+			{
+				results[i] = {CheckResult::UNSATISFIABLE, {}};
+				cached[i] = true;
+			}
+		}
+	vector<chrono::nanoseconds> solvingTimes(_queries.size(), chrono::nanoseconds{0});
+	bool const counterexamples = counterexamplesNeeded();
+
+	ThreadPool pool(min(ThreadPool::effectiveThreads(m_parallelism), groups.size()));
+	for (auto const& group: groups)
+		pool.submit([&, group]() {
+			// Every group uses its own copies of the solver, so that its results do not depend
+			// on which groups were checked on the same thread before.
+			// The solver without preprocessing is only needed for counterexamples.
+			unique_ptr<Z3CHCInterface> optimized = solver->clone();
+			optimized->setCounterexamples(counterexamples);
+			unique_ptr<Z3CHCInterface> unoptimized;
+			if (counterexamples)
+			{
+				unoptimized = solver->clone();
+				unoptimized->setSpacerOptions(false);
+			}
+			for (size_t i: group)
+			{
+				if (cached[i])
+					continue;
+				util::Tracer::Span span("modelChecker", "chcQuery");
+				auto solvingStart = chrono::steady_clock::now();
+				if (unoptimized)
+					results[i] = raceQuery(*optimized, *unoptimized, _queries[i]);
+				else
+					results[i] = optimized->query(_queries[i]);
+				solvingTimes[i] = chrono::steady_clock::now() - solvingStart;
+				if (results[i]->first == CheckResult::SATISFIABLE)
+					break;
+			}
+		});
+	pool.wait();
+
+	if (m_queryCache)
+		for (size_t i = 0; i < _queries.size(); ++i)
+			if (!cached[i] && results[i] && results[i]->first == CheckResult::UNSATISFIABLE)
+				m_queryCache->store(m_solverIDs, cacheQueries[i], {CheckResult::UNSATISFIABLE, {}});
+	for (size_t i = 0; i < _queries.size(); ++i)
+		if (results[i])
+			recordStatistics(
+				_targets[i].errorNode->location(),
+				_targets[i].type,
+				results[i]->first,
+				solvingTimes[i],
+				cached[i],
+				cacheQueries[i]
+			);
+#else
+	solAssert(false, "Concurrent queries require Z3.");
+#endif
+	return results;
+}
+
+vector<optional<pair<CheckResult, CHCSolverInterface::CexGraph>>> CHC::queryWithinBudget(
+	vector<CHCVerificationTarget> const& _targets,
+	vector<smtutil::Expression> const& _queries
+)
+{
+	solAssert(_targets.size() == _queries.size(), "");
+	solAssert(m_settings.timeBudget, "");
+	vector<optional<pair<CheckResult, CHCSolverInterface::CexGraph>>> results(
+		_targets.size(),
+		pair<CheckResult, CHCSolverInterface::CexGraph>{CheckResult::UNKNOWN, {}}
+	);
+	if (_targets.empty())
+		return results;
+#ifdef HAVE_Z3
+	auto* solver = dynamic_cast<Z3CHCInterface*>(m_interface.get());
+	solAssert(solver, "");
+
+	auto const deadline = chrono::steady_clock::now() + chrono::milliseconds(*m_settings.timeBudget);
+	// The first round uses at most half of the budget, the rest is left for the retries.
+	unsigned timeout = max(1u, static_cast<unsigned>(*m_settings.timeBudget / (2 * _targets.size())));
+	if (m_settings.timeout && *m_settings.timeout > 0)
+		timeout = min(timeout, *m_settings.timeout);
+
+	set<pair<ASTNode const*, VerificationTargetType>> violated;
+	vector<size_t> pending(_targets.size());
+	iota(pending.begin(), pending.end(), 0);
+	bool budgetLeft = true;
+	while (!pending.empty() && budgetLeft)
+	{
+		vector<size_t> timedOut;
+		for (size_t i: pending)
+		{
+			if (violated.count({_targets[i].errorNode, _targets[i].type}))
+				continue;
+			auto remaining = chrono::duration_cast<chrono::milliseconds>(deadline - chrono::steady_clock::now()).count();
+			if (remaining <= 0)
+			{
+				budgetLeft = false;
+				break;
+			}
+			solver->setInterruptTimeout(static_cast<unsigned>(min<long long>(timeout, remaining)));
+			results[i] = query(_queries[i], _targets[i].errorNode->location(), _targets[i].type);
+			if (results[i]->first == CheckResult::SATISFIABLE)
+				violated.insert({_targets[i].errorNode, _targets[i].type});
+			else if (results[i]->first == CheckResult::UNKNOWN && solver->lastQueryTimedOut())
+				timedOut.push_back(i);
+		}
+		pending = move(timedOut);
+		// A timeout given in the settings bounds every attempt, so there is no point in retrying.
+		if (m_settings.timeout && *m_settings.timeout > 0 && timeout >= *m_settings.timeout)
+			break;
+		timeout = timeout > numeric_limits<unsigned>::max() / 2 ? numeric_limits<unsigned>::max() : 2 * timeout;
+	}
+	solver->setInterruptTimeout({});
+
+	for (size_t i = 0; i < _targets.size(); ++i)
+		if (
+			violated.count({_targets[i].errorNode, _targets[i].type}) &&
+			results[i]->first != CheckResult::SATISFIABLE
+		)
+			results[i].reset();
+#else
+	solAssert(false, "Checking targets within a time budget requires Z3.");
+#endif
+	return results;
 }
 
 void CHC::checkAndReportTarget(
@@ -1476,14 +1972,35 @@ void CHC::checkAndReportTarget(
 	createErrorBlock();
 	connectBlocks(_target.value, error(), _target.constraints);
 	auto const& location = _target.errorNode->location();
-	auto const& [result, model] = query(error(), location);
+	reportTarget(_target, query(error(), location, _target.type), error().name, _errorReporterId, _satMsg, _unknownMsg);
+}
+
+void CHC::reportTarget(
+	CHCVerificationTarget const& _target,
+	pair<CheckResult, CHCSolverInterface::CexGraph> const& _result,
+	string const& _errorName,
+	ErrorId _errorReporterId,
+	string const& _satMsg,
+	string const& _unknownMsg
+)
+{
+	auto const& location = _target.errorNode->location();
+	auto const& [result, model] = _result;
+	if (m_provenTargets)
+	{
+		// A target is only proven if it cannot be violated in any of the contexts it is checked in.
+		auto [it, inserted] = m_targetProofs.emplace(make_pair(_target.errorNode, _target.type), true);
+		it->second = it->second && result == CheckResult::UNSATISFIABLE;
+	}
 	if (result == CheckResult::UNSATISFIABLE)
 		m_safeTargets[_target.errorNode].insert(_target.type);
 	else if (result == CheckResult::SATISFIABLE)
 	{
 		solAssert(!_satMsg.empty(), "");
 		m_unsafeTargets[_target.errorNode].insert(_target.type);
-		auto cex = generateCounterexample(model, error().name);
+		optional<string> cex;
+		if (counterexamplesNeeded())
+			cex = generateCounterexample(model, _errorName);
 		if (cex)
 			m_errorReporter.warning(
 				_errorReporterId,
@@ -1544,14 +2061,17 @@ optional<string> CHC::generateCounterexample(CHCSolverInterface::CexGraph const&
 	auto callGraph = summaryCalls(_graph, *rootId);
 
 	auto nodePred = [&](auto _node) { return Predicate::predicate(_graph.nodes.at(_node).name); };
-	auto nodeArgs = [&](auto _node) { return _graph.nodes.at(_node).arguments; };
+	auto nodeArgs = [&](auto _node) {
+		auto const& arguments = _graph.nodes.at(_node).arguments;
+		return vector<smtutil::Expression>(arguments.begin(), arguments.end());
+	};
 
 	bool first = true;
 	for (auto summaryId: callGraph.at(*rootId))
 	{
 		CHCSolverInterface::CexNode const& summaryNode = _graph.nodes.at(summaryId);
 		Predicate const* summaryPredicate = Predicate::predicate(summaryNode.name);
-		auto const& summaryArgs = summaryNode.arguments;
+		vector<smtutil::Expression> summaryArgs(summaryNode.arguments.begin(), summaryNode.arguments.end());
 
 		auto stateVars = summaryPredicate->stateVariables();
 		solAssert(stateVars.has_value(), "");
@@ -1584,7 +2104,7 @@ optional<string> CHC::generateCounterexample(CHCSolverInterface::CexGraph const&
 				path.emplace_back("State: " + modelMsg);
 		}
 
-		string txCex = summaryPredicate->formatSummaryCall(summaryArgs);
+		string txCex = summaryPredicate->formatSummaryCall(summaryArgs, m_charStreamProvider);
 
 		list<string> calls;
 		auto dfs = [&](unsigned parent, unsigned node, unsigned depth, auto&& _dfs) -> void {
@@ -1596,7 +2116,7 @@ optional<string> CHC::generateCounterexample(CHCSolverInterface::CexGraph const&
 			if (!pred->isConstructorSummary())
 				for (unsigned v: callGraph[node])
 					_dfs(node, v, depth + 1, _dfs);
-			calls.push_front(string(depth * 4, ' ') + pred->formatSummaryCall(nodeArgs(node)));
+			calls.push_front(string(depth * 4, ' ') + pred->formatSummaryCall(nodeArgs(node), m_charStreamProvider));
 			if (pred->isInternalCall())
 				calls.front() += " -- internal call";
 			else if (pred->isExternalCallTrusted())
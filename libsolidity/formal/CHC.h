@@ -32,32 +32,45 @@
 #pragma once
 
 #include <libsolidity/formal/ModelCheckerSettings.h>
+#include <libsolidity/formal/ModelCheckerStatistics.h>
 #include <libsolidity/formal/Predicate.h>
 #include <libsolidity/formal/SMTEncoder.h>
 
 #include <libsolidity/interface/ReadFile.h>
 
 #include <libsmtutil/CHCSolverInterface.h>
+#include <libsmtutil/SMTQueryCache.h>
+
+#include <liblangutil/CharStreamProvider.h>
 
 #include <boost/algorithm/string/join.hpp>
 
+#include <chrono>
 #include <map>
+#include <memory>
 #include <optional>
 #include <set>
 
 namespace solidity::frontend
 {
 
+class ProvenTargets;
+
 class CHC: public SMTEncoder
 {
 public:
 	CHC(
 		smt::EncodingContext& _context,
 		langutil::ErrorReporter& _errorReporter,
+		langutil::CharStreamProvider const& _charStreamProvider,
 		std::map<util::h256, std::string> const& _smtlib2Responses,
 		ReadCallback::Callback const& _smtCallback,
 		smtutil::SMTSolverChoice _enabledSolvers,
-		ModelCheckerSettings const& _settings
+		ModelCheckerSettings const& _settings,
+		size_t _parallelism = 1,
+		std::shared_ptr<smtutil::SMTQueryCache> _queryCache = nullptr,
+		std::shared_ptr<ProvenTargets> _provenTargets = nullptr,
+		std::shared_ptr<ModelCheckerStatistics> _statistics = nullptr
 	);
 
 	void analyze(SourceUnit const& _sources);
@@ -132,6 +145,21 @@ private:
 	/// in a given _source.
 	void defineInterfacesAndSummaries(SourceUnit const& _source);
 
+	/// @returns true if the summary of @a _function in the current contract is defined by its
+	/// summary in the contract that defines it instead of encoding the function again.
+	/// This is the case if @a _function is inherited and its encoding does not depend on
+	/// the derived contract, i.e. it only accesses the state variables of its own contract and
+	/// calls neither user-defined functions nor unknown code.
+	bool reusesBaseSummary(FunctionDefinition const& _function);
+	/// Connects the summary of the inherited function @a _function in the current contract
+	/// to its summary in the contract that defines it, which leaves the other state variables
+	/// unchanged.
+	void linkBaseSummary(FunctionDefinition const& _function);
+
+	/// Adds the transition of the interface of the current contract via the public function
+	/// @a _function and its query placeholder, if @a _function is part of the interface.
+	void connectToInterface(FunctionDefinition const& _function);
+
 	/// Creates a CHC system that, for a given contract,
 	/// - initializes its state variables (as 0 or given value, if any).
 	/// - "calls" the explicit constructor function of the contract, if any.
@@ -198,7 +226,28 @@ private:
 	void addRule(smtutil::Expression const& _rule, std::string const& _ruleName);
 	/// @returns <true, empty> if query is unsatisfiable (safe).
 	/// @returns <false, model> otherwise.
-	std::pair<smtutil::CheckResult, smtutil::CHCSolverInterface::CexGraph> query(smtutil::Expression const& _query, langutil::SourceLocation const& _location);
+	/// @a _location and @a _type describe the target the query is about.
+	std::pair<smtutil::CheckResult, smtutil::CHCSolverInterface::CexGraph> query(
+		smtutil::Expression const& _query,
+		langutil::SourceLocation const& _location,
+		VerificationTargetType _type
+	);
+	/// Records the statistics of a query if requested. @a _query is the query in SMT-LIB2 format, if known.
+	void recordStatistics(
+		langutil::SourceLocation const& _location,
+		VerificationTargetType _type,
+		smtutil::CheckResult _result,
+		std::chrono::nanoseconds _solvingTime,
+		bool _cached,
+		std::string const& _query
+	);
+	/// @returns true if the query cache contains an UNSAT answer for @a _query.
+	bool cachedSafe(std::string const& _query);
+	/// Warns if the solvers gave conflicting answers or failed.
+	void reportSolverFailure(smtutil::CheckResult _result, langutil::SourceLocation const& _location);
+	/// @returns true if counterexamples are requested and the warnings reporting them
+	/// are not dropped because there are too many warnings.
+	bool counterexamplesNeeded() const;
 
 	void verificationTargetEncountered(ASTNode const* const _errorNode, VerificationTargetType _type, smtutil::Expression const& _errorCondition);
 
@@ -212,6 +261,33 @@ private:
 		std::string _satMsg,
 		std::string _unknownMsg = ""
 	);
+	/// Records and reports the answer @a _result to the query whether @a _target is violated,
+	/// where @a _errorName is the name of the error predicate of the query.
+	void reportTarget(
+		CHCVerificationTarget const& _target,
+		std::pair<smtutil::CheckResult, smtutil::CHCSolverInterface::CexGraph> const& _result,
+		std::string const& _errorName,
+		langutil::ErrorId _errorReporterId,
+		std::string const& _satMsg,
+		std::string const& _unknownMsg
+	);
+	/// Answers the queries whether @a _targets are violated on independent copies of the solver
+	/// concurrently, where @a _queries are the error predicates of the targets.
+	/// Like in the sequential check, once a target is violated, the following targets with the
+	/// same node and type are not checked and their results are empty.
+	std::vector<std::optional<std::pair<smtutil::CheckResult, smtutil::CHCSolverInterface::CexGraph>>> queryConcurrently(
+		std::vector<CHCVerificationTarget> const& _targets,
+		std::vector<smtutil::Expression> const& _queries
+	);
+	/// Answers the queries whether @a _targets are violated within the time budget of the settings,
+	/// where @a _queries are the error predicates of the targets. All targets are first checked with
+	/// a short timeout, and the targets that timed out are retried with doubled timeouts while there
+	/// is budget left. Targets that were not checked at all are unknown. The results of the other
+	/// targets with the same node and type as a violated target are empty.
+	std::vector<std::optional<std::pair<smtutil::CheckResult, smtutil::CHCSolverInterface::CexGraph>>> queryWithinBudget(
+		std::vector<CHCVerificationTarget> const& _targets,
+		std::vector<smtutil::Expression> const& _queries
+	);
 
 	std::optional<std::string> generateCounterexample(smtutil::CHCSolverInterface::CexGraph const& _graph, std::string const& _root);
 
@@ -282,6 +358,10 @@ private:
 
 	/// Function predicates.
 	std::map<ContractDefinition const*, std::map<FunctionDefinition const*, Predicate const*>> m_summaries;
+
+	/// Whether the encoding of a function does not depend on the contract it is encoded in.
+	/// This only depends on the AST, so it is kept across sources.
+	std::map<FunctionDefinition const*, bool, ASTNode::CompareByID> m_contractIndependentFunctions;
 	//@}
 
 	/// Variables.
@@ -366,10 +446,33 @@ private:
 	/// ErrorReporter that comes from CompilerStack.
 	langutil::ErrorReporter& m_outerErrorReporter;
 
+	/// Sources of the locations used in counterexamples.
+	langutil::CharStreamProvider const& m_charStreamProvider;
+
 	/// SMT solvers that are chosen at runtime.
 	smtutil::SMTSolverChoice m_enabledSolvers;
 
 	ModelCheckerSettings const& m_settings;
+
+	/// Number of threads used to check the verification targets if the solvers race.
+	size_t m_parallelism = 1;
+
+	/// Safe targets found by earlier runs. Only UNSAT answers are cached,
+	/// since reporting a violation requires the counterexample.
+	std::shared_ptr<smtutil::SMTQueryCache> m_queryCache;
+	/// The solver and its version, as part of the keys of the query cache.
+	std::string m_solverIDs;
+
+	std::shared_ptr<ProvenTargets> m_provenTargets;
+	/// The contracts of the analysed sources, which are encoded into one system.
+	std::vector<ContractDefinition const*> m_analysedContracts;
+	/// Whether the targets were proven in all contexts they were checked in, by node and type.
+	std::map<std::pair<ASTNode const*, VerificationTargetType>, bool> m_targetProofs;
+
+	/// Statistics of the checked targets, if requested.
+	std::shared_ptr<ModelCheckerStatistics> m_statistics;
+	/// Time spent encoding the current source.
+	std::chrono::nanoseconds m_encodingTime{0};
 };
 
 }
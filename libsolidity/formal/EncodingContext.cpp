@@ -39,6 +39,20 @@ void EncodingContext::reset()
 	m_assertions.clear();
 }
 
+void EncodingContext::releaseFunctionState()
+{
+	for (auto it = m_variables.begin(); it != m_variables.end();)
+		if (it->first->isLocalVariable())
+		{
+			it->second->setIndexSlot({});
+			it = m_variables.erase(it);
+		}
+		else
+			++it;
+	assignIndexSlots();
+	m_expressions.clear();
+}
+
 void EncodingContext::resetUniqueId()
 {
 	m_nextUniqueId = 0;
@@ -51,7 +65,10 @@ unsigned EncodingContext::newUniqueId()
 
 void EncodingContext::clear()
 {
+	for (auto const& variable: m_variables)
+		variable.second->setIndexSlot({});
 	m_variables.clear();
+	assignIndexSlots();
 	reset();
 }
 
@@ -69,6 +86,10 @@ bool EncodingContext::createVariable(frontend::VariableDeclaration const& _varDe
 	auto const& type = _varDecl.type();
 	auto result = newSymbolicVariable(*type, _varDecl.name() + "_" + to_string(_varDecl.id()), *this);
 	m_variables.emplace(&_varDecl, result.second);
+	unsigned slot = static_cast<unsigned>(m_indexSlots.size());
+	m_indexSlots.emplace_back(&_varDecl, result.second.get());
+	result.second->setIndexSlot(slot);
+	indexChanged(slot);
 	return result.first;
 }
 
@@ -131,6 +152,113 @@ void EncodingContext::setUnknownValue(SymbolicVariable& _variable)
 	setSymbolicUnknownValue(_variable, *this);
 }
 
+VariableIndices EncodingContext::copyVariableIndices()
+{
+	updateVariableIndices();
+	return m_indices;
+}
+
+void EncodingContext::resetVariableIndices(VariableIndices const& _indices)
+{
+	updateVariableIndices();
+	solAssert(_indices.m_generation == m_indexGeneration, "");
+	solAssert(_indices.m_size <= m_indices.m_size, "");
+	for (size_t chunk = 0; chunk < _indices.m_chunks.size(); ++chunk)
+		if (_indices.m_chunks[chunk] != m_indices.m_chunks[chunk])
+		{
+			size_t end = min(_indices.m_size, (chunk + 1) * VariableIndices::ChunkSize);
+			for (size_t slot = chunk * VariableIndices::ChunkSize; slot < end; ++slot)
+			{
+				unsigned index = (*_indices.m_chunks[chunk])[slot % VariableIndices::ChunkSize];
+				if (m_indexSlots[slot].second->index() != index)
+					m_indexSlots[slot].second->setIndex(index);
+			}
+		}
+	// Unless variables were created since the snapshot, the current indices are the snapshot.
+	if (_indices.m_size == m_indices.m_size)
+	{
+		m_indices = _indices;
+		for (size_t chunk: m_changedChunks)
+			m_chunkChanged[chunk] = false;
+		m_changedChunks.clear();
+	}
+}
+
+unsigned EncodingContext::variableIndex(VariableIndices const& _indices, frontend::VariableDeclaration const& _decl)
+{
+	solAssert(_indices.m_generation == m_indexGeneration, "");
+	optional<unsigned> slot = variable(_decl)->indexSlot();
+	solAssert(slot && *slot < _indices.m_size, "");
+	return (*_indices.m_chunks[*slot / VariableIndices::ChunkSize])[*slot % VariableIndices::ChunkSize];
+}
+
+vector<frontend::VariableDeclaration const*> EncodingContext::changedVariables(
+	VariableIndices const& _indices,
+	VariableIndices const& _otherIndices
+) const
+{
+	solAssert(_indices.m_generation == m_indexGeneration && _otherIndices.m_generation == m_indexGeneration, "");
+	solAssert(_indices.m_size <= _otherIndices.m_size, "");
+	vector<frontend::VariableDeclaration const*> variables;
+	for (size_t chunk = 0; chunk < _indices.m_chunks.size(); ++chunk)
+		if (_indices.m_chunks[chunk] != _otherIndices.m_chunks[chunk])
+		{
+			size_t end = min(_indices.m_size, (chunk + 1) * VariableIndices::ChunkSize);
+			for (size_t slot = chunk * VariableIndices::ChunkSize; slot < end; ++slot)
+				if (
+					(*_indices.m_chunks[chunk])[slot % VariableIndices::ChunkSize] !=
+					(*_otherIndices.m_chunks[chunk])[slot % VariableIndices::ChunkSize]
+				)
+					variables.push_back(m_indexSlots[slot].first);
+		}
+	return variables;
+}
+
+void EncodingContext::indexChanged(unsigned _slot)
+{
+	size_t chunk = _slot / VariableIndices::ChunkSize;
+	if (chunk >= m_chunkChanged.size())
+		m_chunkChanged.resize(chunk + 1, false);
+	if (!m_chunkChanged[chunk])
+	{
+		m_chunkChanged[chunk] = true;
+		m_changedChunks.push_back(chunk);
+	}
+}
+
+void EncodingContext::assignIndexSlots()
+{
+	m_indexSlots.clear();
+	m_indices = VariableIndices{};
+	m_indices.m_generation = ++m_indexGeneration;
+	m_changedChunks.clear();
+	m_chunkChanged.clear();
+	for (auto const& [decl, variable]: m_variables)
+	{
+		unsigned slot = static_cast<unsigned>(m_indexSlots.size());
+		m_indexSlots.emplace_back(decl, variable.get());
+		variable->setIndexSlot(slot);
+		indexChanged(slot);
+	}
+}
+
+void EncodingContext::updateVariableIndices()
+{
+	m_indices.m_size = m_indexSlots.size();
+	m_indices.m_chunks.resize((m_indices.m_size + VariableIndices::ChunkSize - 1) / VariableIndices::ChunkSize);
+	for (size_t chunk: m_changedChunks)
+	{
+		auto indices = make_shared<VariableIndices::Chunk>();
+		indices->fill(0);
+		size_t end = min(m_indices.m_size, (chunk + 1) * VariableIndices::ChunkSize);
+		for (size_t slot = chunk * VariableIndices::ChunkSize; slot < end; ++slot)
+			(*indices)[slot % VariableIndices::ChunkSize] = m_indexSlots[slot].second->index();
+		m_indices.m_chunks[chunk] = move(indices);
+		m_chunkChanged[chunk] = false;
+	}
+	m_changedChunks.clear();
+}
+
 /// Expressions
 
 shared_ptr<SymbolicVariable> EncodingContext::expression(frontend::Expression const& _e)
@@ -23,11 +23,39 @@
 
 #include <libsmtutil/SolverInterface.h>
 
+#include <array>
 #include <map>
+#include <memory>
+#include <vector>
 
 namespace solidity::frontend::smt
 {
 
+/**
+ * Snapshot of the SSA indices of the program variables of an encoding context.
+ * The indices are stored in chunks which are shared between snapshots, so that
+ * taking a snapshot only copies the chunks with an index that changed since the
+ * previous one.
+ */
+class VariableIndices
+{
+public:
+	/// @returns the number of variables in the snapshot.
+	size_t size() const { return m_size; }
+
+private:
+	friend class EncodingContext;
+
+	static size_t constexpr ChunkSize = 64;
+	using Chunk = std::array<unsigned, ChunkSize>;
+
+	std::vector<std::shared_ptr<Chunk const>> m_chunks;
+	size_t m_size = 0;
+	/// The generation of the slots of the context when the snapshot was taken,
+	/// used to detect snapshots taken before variables were released.
+	unsigned m_generation = 0;
+};
+
 /**
  * Stores the context of the SMT encoding.
  */
@@ -40,6 +68,10 @@ public:
 	/// alive because of state variables and inlined function calls.
 	/// To be used in the beginning of a root function visit.
 	void reset();
+	/// Erases the symbolic local variables and expressions, which are created
+	/// again if a later function needs them.
+	/// To be used once the verification targets of a root function are checked.
+	void releaseFunctionState();
 	/// Resets the fresh id for slack variables.
 	void resetUniqueId();
 	/// Returns the current fresh slack id and increments it.
@@ -105,6 +137,21 @@ public:
 	/// Resets the variable to an unknown value (in its range).
 	void setUnknownValue(frontend::VariableDeclaration const& decl);
 	void setUnknownValue(SymbolicVariable& _variable);
+
+	/// @returns a snapshot of the current SSA indices of all variables.
+	VariableIndices copyVariableIndices();
+	/// Sets the SSA indices of the variables in @a _indices to their values in the snapshot.
+	void resetVariableIndices(VariableIndices const& _indices);
+	/// @returns the SSA index of @a _decl in @a _indices.
+	unsigned variableIndex(VariableIndices const& _indices, frontend::VariableDeclaration const& _decl);
+	/// @returns the variables of @a _indices whose SSA index differs in @a _otherIndices,
+	/// which has to contain at least the same variables.
+	std::vector<frontend::VariableDeclaration const*> changedVariables(
+		VariableIndices const& _indices,
+		VariableIndices const& _otherIndices
+	) const;
+	/// Marks the SSA index of the variable in slot @a _slot as changed.
+	void indexChanged(unsigned _slot);
 	//@}
 
 	/// Expressions.
@@ -158,6 +205,21 @@ private:
 	/// Symbolic variables.
 	std::map<frontend::VariableDeclaration const*, std::shared_ptr<SymbolicVariable>, IdCompare> m_variables;
 
+	/// Assigns consecutive slots for the SSA index snapshots to all symbolic variables.
+	void assignIndexSlots();
+	/// Takes a snapshot of the current SSA indices, reusing the unchanged chunks of @a m_indices.
+	void updateVariableIndices();
+
+	/// The symbolic variables by their slot in the SSA index snapshots.
+	std::vector<std::pair<frontend::VariableDeclaration const*, SymbolicVariable*>> m_indexSlots;
+	/// The latest snapshot of the SSA indices.
+	VariableIndices m_indices;
+	/// The chunks of @a m_indices that contain an SSA index that changed since the snapshot.
+	std::vector<size_t> m_changedChunks;
+	std::vector<bool> m_chunkChanged;
+	/// Incremented whenever the slots are reassigned, which invalidates older snapshots.
+	unsigned m_indexGeneration = 0;
+
 	/// Symbolic expressions.
 	std::map<frontend::Expression const*, std::shared_ptr<SymbolicVariable>, IdCompare> m_expressions;
 
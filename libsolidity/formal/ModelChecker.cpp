@@ -17,6 +17,15 @@
 // SPDX-License-Identifier: GPL-3.0
 
 #include <libsolidity/formal/ModelChecker.h>
+
+#include <libsolidity/interface/Version.h>
+
+#include <libsolidity/ast/TypeProvider.h>
+
+#include <libsolutil/CommonData.h>
+#include <libsolutil/CompilationStatistics.h>
+#include <libsolutil/ThreadPool.h>
+
 #ifdef HAVE_Z3
 #include <libsmtutil/Z3Interface.h>
 #endif
@@ -29,15 +38,39 @@ using namespace solidity::frontend;
 
 ModelChecker::ModelChecker(
 	ErrorReporter& _errorReporter,
+	CharStreamProvider const& _charStreamProvider,
 	map<h256, string> const& _smtlib2Responses,
 	ModelCheckerSettings _settings,
 	ReadCallback::Callback const& _smtCallback,
-	smtutil::SMTSolverChoice _enabledSolvers
+	smtutil::SMTSolverChoice _enabledSolvers,
+	size_t _parallelism
 ):
+	m_errorReporter(_errorReporter),
 	m_settings(_settings),
-	m_context(),
-	m_bmc(m_context, _errorReporter, _smtlib2Responses, _smtCallback, _enabledSolvers, m_settings),
-	m_chc(m_context, _errorReporter, _smtlib2Responses, _smtCallback, _enabledSolvers, m_settings)
+	m_smtCallback(
+		_smtCallback ?
+		ReadCallback::Callback([this, _smtCallback](string const& _kind, string const& _query) {
+			lock_guard<mutex> lock(m_smtCallbackMutex);
+			return _smtCallback(_kind, _query);
+		}) :
+		ReadCallback::Callback()
+	),
+	m_queryCache(
+		m_settings.cacheDirectory ?
+		make_shared<smtutil::SMTQueryCache>(string(VersionString), *m_settings.cacheDirectory) :
+		nullptr
+	),
+	m_provenTargets(
+		m_settings.incremental && m_queryCache ?
+		make_shared<ProvenTargets>(_charStreamProvider, m_queryCache) :
+		nullptr
+	),
+	m_statistics(util::CompilationStatistics::current() ? make_shared<ModelCheckerStatistics>() : nullptr),
+	m_bmcStatistics(m_statistics ? make_shared<ModelCheckerStatistics>() : nullptr),
+	m_chcStatistics(m_statistics ? make_shared<ModelCheckerStatistics>() : nullptr),
+	m_parallelism(_parallelism),
+	m_bmc(m_bmcContext, m_bmcErrorReporter, _charStreamProvider, _smtlib2Responses, m_smtCallback, _enabledSolvers, m_settings, _parallelism, m_queryCache, m_provenTargets, m_bmcStatistics),
+	m_chc(m_chcContext, m_chcErrorReporter, _charStreamProvider, _smtlib2Responses, m_smtCallback, _enabledSolvers, m_settings, _parallelism, m_queryCache, m_provenTargets, m_chcStatistics)
 {
 }
 
@@ -46,15 +79,51 @@ void ModelChecker::analyze(SourceUnit const& _source)
 	if (!_source.annotation().experimentalFeatures.count(ExperimentalFeature::SMTChecker))
 		return;
 
-	if (m_settings.engine.chc)
-		m_chc.analyze(_source);
-
-	auto solvedTargets = m_chc.safeTargets();
-	for (auto const& target: m_chc.unsafeTargets())
-		solvedTargets[target.first] += target.second;
+	// The BMC engine skips the targets the CHC engine proved safe or unsafe. It waits for them
+	// before checking the first target, so the reports do not depend on whether the engines
+	// run concurrently.
+	SolvedTargets solvedTargets;
+	auto analyzeWithCHC = [&]() {
+		ScopeGuard complete([&]() { solvedTargets.markComplete(); });
+		if (m_settings.engine.chc)
+			m_chc.analyze(_source);
+		for (auto const* targets: {&m_chc.safeTargets(), &m_chc.unsafeTargets()})
+			for (auto const& [node, types]: *targets)
+				for (VerificationTargetType type: types)
+					solvedTargets.insert(node, type);
+	};
+	if (m_settings.engine.chc && m_settings.engine.bmc && ThreadPool::effectiveThreads(m_parallelism) > 1)
+	{
+		TypeProvider& typeProvider = TypeProvider::instance();
+		ThreadPool pool(2);
+		pool.submit([&]() {
+			TypeProvider::Scope typeScope(typeProvider);
+			analyzeWithCHC();
+		});
+		pool.submit([&]() {
+			TypeProvider::Scope typeScope(typeProvider);
+			m_bmc.analyze(_source, solvedTargets);
+		});
+		pool.wait();
+	}
+	else
+	{
+		analyzeWithCHC();
+		if (m_settings.engine.bmc)
+			m_bmc.analyze(_source, solvedTargets);
+	}
 
-	if (m_settings.engine.bmc)
-		m_bmc.analyze(_source, solvedTargets);
+	m_errorReporter.append(m_chcErrors);
+	m_errorReporter.append(m_bmcErrors);
+	m_chcErrorReporter.clear();
+	m_bmcErrorReporter.clear();
+	if (m_statistics)
+	{
+		*m_statistics += move(*m_chcStatistics);
+		*m_statistics += move(*m_bmcStatistics);
+		m_chcStatistics->clear();
+		m_bmcStatistics->clear();
+	}
 }
 
 vector<string> ModelChecker::unhandledQueries()
@@ -19,6 +19,7 @@
  * Entry point to the model checking engines.
  * The goal of this class is to make different
  * engines share knowledge to boost their proving power.
+ * If the parallelism allows it, both engines analyse each source concurrently.
  */
 
 #pragma once
@@ -27,12 +28,18 @@
 #include <libsolidity/formal/CHC.h>
 #include <libsolidity/formal/EncodingContext.h>
 #include <libsolidity/formal/ModelCheckerSettings.h>
+#include <libsolidity/formal/ModelCheckerStatistics.h>
+#include <libsolidity/formal/ProvenTargets.h>
 
 #include <libsolidity/interface/ReadFile.h>
 
+#include <libsmtutil/SMTQueryCache.h>
 #include <libsmtutil/SolverInterface.h>
 #include <liblangutil/ErrorReporter.h>
 
+#include <memory>
+#include <mutex>
+
 namespace solidity::langutil
 {
 class ErrorReporter;
@@ -49,12 +56,18 @@ public:
 	/// should be used, even if all are available. The default choice is to use all.
 	ModelChecker(
 		langutil::ErrorReporter& _errorReporter,
+		langutil::CharStreamProvider const& _charStreamProvider,
 		std::map<solidity::util::h256, std::string> const& _smtlib2Responses,
 		ModelCheckerSettings _settings = ModelCheckerSettings{},
 		ReadCallback::Callback const& _smtCallback = ReadCallback::Callback(),
-		smtutil::SMTSolverChoice _enabledSolvers = smtutil::SMTSolverChoice::All()
+		smtutil::SMTSolverChoice _enabledSolvers = smtutil::SMTSolverChoice::All(),
+		size_t _parallelism = 1
 	);
 
+	/// Analyses @a _sources with the enabled engines. The BMC engine skips the targets the CHC
+	/// engine proved safe or unsafe. If both engines run concurrently, the BMC engine encodes
+	/// the source while the CHC engine analyses it, but only checks its targets afterwards,
+	/// so that the reports are the same as if the engines ran one after the other.
 	void analyze(SourceUnit const& _sources);
 
 	/// This is used if the SMT solver is not directly linked into this binary.
@@ -65,11 +78,38 @@ public:
 	/// @returns SMT solvers that are available via the C++ API.
 	static smtutil::SMTSolverChoice availableSolvers();
 
+	/// @returns the statistics of the checked targets, which are only collected
+	/// if compilation statistics were collected when the model checker was created.
+	ModelCheckerStatistics const* statistics() const { return m_statistics.get(); }
+
 private:
+	langutil::ErrorReporter& m_errorReporter;
 	ModelCheckerSettings m_settings;
 
-	/// Stores the context of the encoding.
-	smt::EncodingContext m_context;
+	/// The engines report to their own lists, which are added to m_errorReporter in the same
+	/// order after each source, independent of which engine finished first.
+	langutil::ErrorList m_bmcErrors;
+	langutil::ErrorList m_chcErrors;
+	langutil::ErrorReporter m_bmcErrorReporter{m_bmcErrors};
+	langutil::ErrorReporter m_chcErrorReporter{m_chcErrors};
+
+	/// Serializes the calls of the SMT callback by the engines.
+	std::mutex m_smtCallbackMutex;
+	ReadCallback::Callback m_smtCallback;
+
+	/// Store the contexts of the encodings, one per engine, so that the engines can run concurrently.
+	smt::EncodingContext m_bmcContext;
+	smt::EncodingContext m_chcContext;
+
+	/// Answers of the solvers shared by both engines, if a cache directory is set.
+	std::shared_ptr<smtutil::SMTQueryCache> m_queryCache;
+	/// Targets proven by earlier runs, if the analysis is incremental.
+	std::shared_ptr<ProvenTargets> m_provenTargets;
+	std::shared_ptr<ModelCheckerStatistics> m_statistics;
+	/// Statistics of the engines for the current source, which are added to m_statistics after it.
+	std::shared_ptr<ModelCheckerStatistics> m_bmcStatistics;
+	std::shared_ptr<ModelCheckerStatistics> m_chcStatistics;
+	size_t m_parallelism = 1;
 
 	/// Bounded Model Checker engine.
 	BMC m_bmc;
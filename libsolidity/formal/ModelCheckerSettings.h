@@ -22,6 +22,7 @@
 
 #include <optional>
 #include <set>
+#include <string>
 
 namespace solidity::frontend
 {
@@ -72,6 +73,26 @@ struct ModelCheckerSettings
 	ModelCheckerEngine engine = ModelCheckerEngine::All();
 	ModelCheckerTargets targets = ModelCheckerTargets::All();
 	std::optional<unsigned> timeout;
+	/// If set, the CHC engine checks the verification targets of a source within this many
+	/// milliseconds: first every target with a short timeout, then the targets that timed out
+	/// with twice the timeout of the previous round, until the budget is used up.
+	std::optional<unsigned> timeBudget;
+	/// If true, the BMC solvers are queried concurrently and the first answer is used,
+	/// without checking whether the solvers agree. The CHC engine checks the targets
+	/// concurrently on copies of its solver, with and without Spacer's preprocessing.
+	bool raceSolvers = false;
+	/// If set, the answers of the solvers are stored in this directory and reused
+	/// by later runs that ask the same queries.
+	std::optional<std::string> cacheDirectory;
+	/// If true, targets proven by earlier runs are not checked again unless the code
+	/// they depend on changed. Requires a cache directory.
+	bool incremental = false;
+	/// If true, the independent queries of a contract or function are sent to the SMT callback
+	/// in a single batch, so that the host can solve them concurrently.
+	bool batchQueries = false;
+	/// If false, violated targets are reported without a counterexample, which saves
+	/// extracting and formatting the models and, for CHC, a second query without preprocessing.
+	bool counterexamples = true;
 };
 
 }
@@ -0,0 +1,54 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libsolidity/formal/ModelCheckerStatistics.h>
+
+#include <liblangutil/Exceptions.h>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::frontend;
+
+string solidity::frontend::targetTypeName(VerificationTargetType _type)
+{
+	switch (_type)
+	{
+	case VerificationTargetType::ConstantCondition: return "constantCondition";
+	case VerificationTargetType::Underflow: return "underflow";
+	case VerificationTargetType::Overflow: return "overflow";
+	case VerificationTargetType::UnderOverflow: return "underflow,overflow";
+	case VerificationTargetType::DivByZero: return "divByZero";
+	case VerificationTargetType::Balance: return "balance";
+	case VerificationTargetType::Assert: return "assert";
+	case VerificationTargetType::PopEmptyArray: return "popEmptyArray";
+	}
+	solAssert(false, "");
+}
+
+string solidity::frontend::checkResultName(smtutil::CheckResult _result)
+{
+	switch (_result)
+	{
+	case smtutil::CheckResult::SATISFIABLE: return "sat";
+	case smtutil::CheckResult::UNSATISFIABLE: return "unsat";
+	case smtutil::CheckResult::UNKNOWN: return "unknown";
+	case smtutil::CheckResult::CONFLICTING: return "conflicting";
+	case smtutil::CheckResult::ERROR: return "error";
+	}
+	solAssert(false, "");
+}
@@ -0,0 +1,65 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Time spent by the model checker on the verification targets.
+ */
+
+#pragma once
+
+#include <libsolidity/formal/ModelCheckerSettings.h>
+
+#include <libsmtutil/SolverInterface.h>
+
+#include <liblangutil/SourceLocation.h>
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+namespace solidity::frontend
+{
+
+/**
+ * Statistics about a query of the model checker for one verification target.
+ * Targets that are checked in several contexts have one entry per context.
+ */
+struct ModelCheckerTargetStatistics
+{
+	langutil::SourceLocation location;
+	VerificationTargetType type;
+	/// "bmc" or "chc".
+	std::string engine;
+	/// Time spent encoding the function (BMC) or source unit (CHC) the target was checked in.
+	std::chrono::nanoseconds encodingTime{0};
+	/// Time spent in the solvers, including repeated queries for counterexamples.
+	std::chrono::nanoseconds solvingTime{0};
+	/// The solvers whose answers were used, or "cache".
+	std::string solvers;
+	smtutil::CheckResult result = smtutil::CheckResult::UNKNOWN;
+	/// Size of the query in SMT-LIB2 format, in bytes.
+	size_t querySize = 0;
+};
+
+using ModelCheckerStatistics = std::vector<ModelCheckerTargetStatistics>;
+
+/// @returns the name of @a _type as used in the model checker targets setting.
+std::string targetTypeName(VerificationTargetType _type);
+/// @returns "sat", "unsat", "unknown", "conflicting" or "error".
+std::string checkResultName(smtutil::CheckResult _result);
+
+}
@@ -23,6 +23,8 @@
 
 #include <libsmtutil/Sorts.h>
 
+#include <liblangutil/CharStreamProvider.h>
+
 #include <map>
 #include <optional>
 #include <vector>
@@ -128,8 +130,11 @@ public:
 	PredicateType type() const { return m_type; }
 
 	/// @returns a formatted string representing a call to this predicate
-	/// with _args.
-	std::string formatSummaryCall(std::vector<smtutil::Expression> const& _args) const;
+	/// with _args. Calls that appear in the program are printed as in @a _charStreamProvider.
+	std::string formatSummaryCall(
+		std::vector<smtutil::Expression> const& _args,
+		langutil::CharStreamProvider const& _charStreamProvider
+	) const;
 
 	/// @returns the values of the state variables from _args at the point
 	/// where this summary was reached.
@@ -0,0 +1,293 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Verification targets proven by earlier runs of the model checker.
+ */
+
+#include <libsolidity/formal/ProvenTargets.h>
+
+#include <libsolidity/ast/AST.h>
+#include <libsolidity/ast/ASTVisitor.h>
+#include <libsolidity/ast/Types.h>
+
+#include <libsolutil/Keccak256.h>
+
+#include <boost/algorithm/string/join.hpp>
+
+#include <algorithm>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::util;
+using namespace solidity::langutil;
+using namespace solidity::frontend;
+
+namespace
+{
+
+/// Collects the declarations referenced inside an AST subtree and whether it calls other contracts.
+class ReferenceCollector: public ASTConstVisitor
+{
+public:
+	set<Declaration const*> references;
+	bool externalCall = false;
+
+	void endVisit(Identifier const& _identifier) override { add(_identifier.annotation().referencedDeclaration); }
+	void endVisit(IdentifierPath const& _path) override { add(_path.annotation().referencedDeclaration); }
+	void endVisit(MemberAccess const& _memberAccess) override { add(_memberAccess.annotation().referencedDeclaration); }
+	void endVisit(FunctionCall const& _functionCall) override
+	{
+		auto const* type = dynamic_cast<FunctionType const*>(_functionCall.expression().annotation().type);
+		if (!type)
+			return;
+		switch (type->kind())
+		{
+		case FunctionType::Kind::External:
+		case FunctionType::Kind::DelegateCall:
+		case FunctionType::Kind::BareCall:
+		case FunctionType::Kind::BareCallCode:
+		case FunctionType::Kind::BareDelegateCall:
+		case FunctionType::Kind::BareStaticCall:
+		case FunctionType::Kind::Creation:
+			externalCall = true;
+			break;
+		default:
+			break;
+		}
+	}
+
+private:
+	void add(Declaration const* _declaration)
+	{
+		if (_declaration)
+			references.insert(_declaration);
+	}
+};
+
+bool isCallable(Declaration const* _declaration)
+{
+	return dynamic_cast<FunctionDefinition const*>(_declaration) || dynamic_cast<ModifierDefinition const*>(_declaration);
+}
+
+/// @returns true if the declarations referenced by @a _declaration have to be collected as well.
+bool followReferences(Declaration const* _declaration)
+{
+	if (auto const* variable = dynamic_cast<VariableDeclaration const*>(_declaration))
+		return !variable->isLocalVariable();
+	return
+		isCallable(_declaration) ||
+		dynamic_cast<StructDefinition const*>(_declaration) ||
+		dynamic_cast<EnumDefinition const*>(_declaration) ||
+		dynamic_cast<EventDefinition const*>(_declaration);
+}
+
+string engineName(ProvenTargets::Engine _engine)
+{
+	return _engine == ProvenTargets::Engine::BMC ? "proven bmc" : "proven chc";
+}
+
+}
+
+bool ProvenTargets::proven(
+	Engine _engine,
+	vector<ContractDefinition const*> const& _contracts,
+	ASTNode const& _node,
+	VerificationTargetType _type
+)
+{
+	lock_guard<mutex> lock(m_mutex);
+	optional<string> key = this->key(_engine, _contracts, _node, _type);
+	if (!key)
+		return false;
+	auto answer = m_cache->load(engineName(_engine), *key);
+	return answer && answer->first == smtutil::CheckResult::UNSATISFIABLE;
+}
+
+void ProvenTargets::markProven(
+	Engine _engine,
+	vector<ContractDefinition const*> const& _contracts,
+	ASTNode const& _node,
+	VerificationTargetType _type
+)
+{
+	lock_guard<mutex> lock(m_mutex);
+	if (optional<string> key = this->key(_engine, _contracts, _node, _type))
+		m_cache->store(engineName(_engine), *key, {smtutil::CheckResult::UNSATISFIABLE, {}});
+}
+
+ProvenTargets::Context& ProvenTargets::context(vector<ContractDefinition const*> const& _contracts)
+{
+	auto [it, inserted] = m_contexts.try_emplace(_contracts);
+	Context& context = it->second;
+	if (!inserted)
+		return context;
+
+	set<ContractDefinition const*> contracts;
+	vector<Declaration const*> work;
+	for (auto const* contract: _contracts)
+		for (auto const* base: contract->annotation().linearizedBaseContracts)
+			if (contracts.insert(base).second)
+			{
+				context.contracts.push_back(base);
+				for (auto const* declaration: ASTNode::filteredNodes<Declaration>(base->subNodes()))
+					work.push_back(declaration);
+			}
+
+	set<Declaration const*> visited;
+	while (!work.empty())
+	{
+		Declaration const* declaration = work.back();
+		work.pop_back();
+		if (!visited.insert(declaration).second)
+			continue;
+
+		ReferenceCollector collector;
+		declaration->accept(collector);
+		if (collector.externalCall)
+			context.externalCalls.insert(declaration);
+		if (isCallable(declaration))
+		{
+			context.callables.push_back(declaration);
+			if (contracts.count(dynamic_cast<ContractDefinition const*>(declaration->scope())))
+				context.callablesByName.emplace(declaration->name(), declaration);
+		}
+		for (auto const* reference: collector.references)
+		{
+			context.referencedBy[reference].insert(declaration);
+			if (followReferences(reference))
+				work.push_back(reference);
+		}
+		context.references[declaration] = move(collector.references);
+	}
+	return context;
+}
+
+optional<string> ProvenTargets::key(
+	Engine _engine,
+	vector<ContractDefinition const*> const& _contracts,
+	ASTNode const& _node,
+	VerificationTargetType _type
+)
+{
+	Context& context = this->context(_contracts);
+	SourceLocation const& location = _node.location();
+	Declaration const* callable = nullptr;
+	for (auto const* candidate: context.callables)
+		if (
+			candidate->location().contains(location) &&
+			(!callable || callable->location().contains(candidate->location()))
+		)
+			callable = candidate;
+	if (!callable)
+		return nullopt;
+
+	// The position relative to the function or modifier identifies the target within its source code.
+	return
+		fingerprint(_engine, context, *callable).hex() + ":" +
+		to_string(static_cast<int>(_type)) + ":" +
+		to_string(location.start - callable->location().start) + ":" +
+		to_string(location.end - callable->location().start);
+}
+
+h256 ProvenTargets::fingerprint(Engine _engine, Context& _context, Declaration const& _callable)
+{
+	if (auto it = _context.fingerprints.find({_engine, &_callable}); it != _context.fingerprints.end())
+		return it->second;
+
+	set<Declaration const*> dependencies;
+	vector<Declaration const*> work;
+	auto add = [&](Declaration const* _declaration) {
+		if (dependencies.insert(_declaration).second)
+			work.push_back(_declaration);
+	};
+	bool constructorsAdded = false;
+	bool externalFunctionsAdded = false;
+	add(&_callable);
+	while (!work.empty())
+	{
+		Declaration const* declaration = work.back();
+		work.pop_back();
+		auto const* function = dynamic_cast<FunctionDefinition const*>(declaration);
+		auto const* variable = dynamic_cast<VariableDeclaration const*>(declaration);
+
+		// Targets are checked in the context of every function that calls the function containing
+		// them, and the CHC engine also considers all effects on the state variables they use.
+		if (isCallable(declaration) || (_engine == Engine::CHC && variable && variable->isStateVariable()))
+			for (auto const* user: _context.referencedBy[declaration])
+				if (isCallable(user) || dynamic_cast<VariableDeclaration const*>(user))
+					add(user);
+
+		for (auto const* reference: _context.references[declaration])
+		{
+			add(reference);
+			if (isCallable(reference))
+			{
+				// Virtual calls can reach any override.
+				auto [begin, end] = _context.callablesByName.equal_range(reference->name());
+				for (auto it = begin; it != end; ++it)
+					add(it->second);
+			}
+		}
+
+		if (function && function->isConstructor() && !constructorsAdded)
+		{
+			constructorsAdded = true;
+			for (auto const* contract: _context.contracts)
+			{
+				if (auto const* constructor = contract->constructor())
+					add(constructor);
+				for (auto const* stateVariable: contract->stateVariables())
+					add(stateVariable);
+			}
+		}
+
+		// Calls to other contracts can re-enter through any function of the external interface.
+		if (_engine == Engine::CHC && _context.externalCalls.count(declaration) && !externalFunctionsAdded)
+		{
+			externalFunctionsAdded = true;
+			for (auto const* callable: _context.callables)
+				if (auto const* externalFunction = dynamic_cast<FunctionDefinition const*>(callable))
+					if (
+						externalFunction->isPartOfExternalInterface() ||
+						externalFunction->isReceive() ||
+						externalFunction->isFallback()
+					)
+						add(externalFunction);
+		}
+	}
+
+	vector<string> parts;
+	for (auto const* declaration: dependencies)
+		if (declaration->location().hasText())
+			parts.push_back(*declaration->location().sourceName + ":" + m_charStreamProvider.text(declaration->location()));
+	sort(parts.begin(), parts.end());
+
+	// The inheritance specifiers determine the order of the constructors and their arguments.
+	string contracts;
+	for (auto const* contract: _context.contracts)
+	{
+		contracts += contract->name();
+		for (auto const& base: contract->baseContracts())
+			contracts += " " + m_charStreamProvider.text(base->location());
+		contracts += "\n";
+	}
+
+	h256 fingerprint = keccak256(engineName(_engine) + "\n" + contracts + boost::algorithm::join(parts, "\n"));
+	_context.fingerprints[{_engine, &_callable}] = fingerprint;
+	return fingerprint;
+}
@@ -0,0 +1,124 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Verification targets proven by earlier runs of the model checker.
+ */
+
+#pragma once
+
+#include <libsolidity/ast/ASTForward.h>
+#include <libsolidity/formal/ModelCheckerSettings.h>
+
+#include <libsmtutil/SMTQueryCache.h>
+
+#include <liblangutil/CharStreamProvider.h>
+
+#include <libsolutil/FixedHash.h>
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace solidity::frontend
+{
+
+/**
+ * Remembers the verification targets that were proven safe by earlier runs, so that the
+ * targets that do not depend on changed code are not checked again.
+ *
+ * Proofs are stored in the query cache under a fingerprint of the source code of everything
+ * the verification of the target depends on: the function or modifier containing the target,
+ * all functions that call it in the analysed contracts and everything these reference, i.e.
+ * called functions together with their overrides, modifiers, state variables and types.
+ * Targets in constructors also depend on the constructors, the state variables and the
+ * inheritance specifiers of the whole hierarchy.
+ * The CHC engine reasons about all transactions, so its fingerprints additionally include
+ * the functions accessing the referenced state variables and, if external calls are made,
+ * all functions that can be called from outside.
+ *
+ * Targets outside of functions and modifiers are never considered proven.
+ * Can be used from any thread.
+ */
+class ProvenTargets
+{
+public:
+	enum class Engine { BMC, CHC };
+
+	ProvenTargets(
+		langutil::CharStreamProvider const& _charStreamProvider,
+		std::shared_ptr<smtutil::SMTQueryCache> _cache
+	):
+		m_charStreamProvider(_charStreamProvider),
+		m_cache(std::move(_cache))
+	{}
+
+	/// @returns true if @a _engine proved the target of type @a _type at @a _node in an earlier
+	/// run that analysed the contracts @a _contracts and none of its dependencies changed since.
+	bool proven(
+		Engine _engine,
+		std::vector<ContractDefinition const*> const& _contracts,
+		ASTNode const& _node,
+		VerificationTargetType _type
+	);
+
+	/// Records that @a _engine proved the target of type @a _type at @a _node.
+	void markProven(
+		Engine _engine,
+		std::vector<ContractDefinition const*> const& _contracts,
+		ASTNode const& _node,
+		VerificationTargetType _type
+	);
+
+private:
+	/// The declarations of a set of analysed contracts and their base contracts,
+	/// together with the declarations they reference.
+	struct Context
+	{
+		std::vector<ContractDefinition const*> contracts;
+		std::map<Declaration const*, std::set<Declaration const*>> references;
+		std::map<Declaration const*, std::set<Declaration const*>> referencedBy;
+		/// Functions and modifiers that call other contracts.
+		std::set<Declaration const*> externalCalls;
+		/// Functions and modifiers by name, to include every override of a called function.
+		std::multimap<std::string, Declaration const*> callablesByName;
+		std::vector<Declaration const*> callables;
+		std::map<std::pair<Engine, Declaration const*>, util::h256> fingerprints;
+	};
+
+	Context& context(std::vector<ContractDefinition const*> const& _contracts);
+	/// @returns the key of the proof of the target, or nullopt if it is not inside a function or modifier.
+	std::optional<std::string> key(
+		Engine _engine,
+		std::vector<ContractDefinition const*> const& _contracts,
+		ASTNode const& _node,
+		VerificationTargetType _type
+	);
+	util::h256 fingerprint(Engine _engine, Context& _context, Declaration const& _callable);
+
+	langutil::CharStreamProvider const& m_charStreamProvider;
+	std::shared_ptr<smtutil::SMTQueryCache> m_cache;
+	std::map<std::vector<ContractDefinition const*>, Context> m_contexts;
+	/// Serializes the engines, which use the proofs concurrently.
+	std::mutex m_mutex;
+};
+
+}
@@ -2377,21 +2377,13 @@ void SMTEncoder::mergeVariables(set<VariableDeclaration const*> const& _variable
 	/// so those also need their SSA's merged.
 	/// This does not cause scope harm since the symbolic variables
 	/// are kept alive.
-	for (auto const& var: _indicesEndTrue)
-	{
-		solAssert(_indicesEndFalse.count(var.first), "");
-		if (
-			_indicesEndFalse.at(var.first) != var.second &&
-			!sortedVars.count(var.first)
-		)
-			sortedVars.insert(var.first);
-	}
+	for (auto const* var: m_context.changedVariables(_indicesEndTrue, _indicesEndFalse))
+		sortedVars.insert(var);
 
 	for (auto const* decl: sortedVars)
 	{
-		solAssert(_indicesEndTrue.count(decl) && _indicesEndFalse.count(decl), "");
-		auto trueIndex = static_cast<unsigned>(_indicesEndTrue.at(decl));
-		auto falseIndex = static_cast<unsigned>(_indicesEndFalse.at(decl));
+		auto trueIndex = m_context.variableIndex(_indicesEndTrue, *decl);
+		auto falseIndex = m_context.variableIndex(_indicesEndFalse, *decl);
 		solAssert(trueIndex != falseIndex, "");
 		m_context.addAssertion(m_context.newValue(*decl) == smtutil::Expression::ite(
 			_condition,
@@ -2547,16 +2539,12 @@ ContractDefinition const* SMTEncoder::currentScopeContract()
 
 SMTEncoder::VariableIndices SMTEncoder::copyVariableIndices()
 {
-	VariableIndices indices;
-	for (auto const& var: m_context.variables())
-		indices.emplace(var.first, var.second->index());
-	return indices;
+	return m_context.copyVariableIndices();
 }
 
 void SMTEncoder::resetVariableIndices(VariableIndices const& _indices)
 {
-	for (auto const& var: _indices)
-		m_context.variable(*var.first)->setIndex(static_cast<unsigned>(var.second));
+	m_context.resetVariableIndices(_indices);
 }
 
 void SMTEncoder::clearIndices(ContractDefinition const* _contract, FunctionDefinition const* _function)
@@ -0,0 +1,52 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libsolidity/formal/SolvedTargets.h>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::frontend;
+
+void SolvedTargets::insert(ASTNode const* _node, VerificationTargetType _type)
+{
+	lock_guard<mutex> lock(m_mutex);
+	m_targets[_node].insert(_type);
+}
+
+void SolvedTargets::markComplete()
+{
+	{
+		lock_guard<mutex> lock(m_mutex);
+		m_complete = true;
+	}
+	m_completed.notify_all();
+}
+
+bool SolvedTargets::contains(ASTNode const* _node, VerificationTargetType _type) const
+{
+	unique_lock<mutex> lock(m_mutex);
+	m_completed.wait(lock, [&]() { return m_complete; });
+	auto targets = m_targets.find(_node);
+	if (targets == m_targets.end())
+		return false;
+	if (targets->second.count(_type))
+		return true;
+	return
+		(_type == VerificationTargetType::Underflow || _type == VerificationTargetType::Overflow) &&
+		targets->second.count(VerificationTargetType::UnderOverflow);
+}
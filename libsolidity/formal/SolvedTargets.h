@@ -0,0 +1,60 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Verification targets settled by the CHC engine, which the BMC engine skips.
+ */
+
+#pragma once
+
+#include <libsolidity/ast/ASTForward.h>
+#include <libsolidity/formal/ModelCheckerSettings.h>
+
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <set>
+
+namespace solidity::frontend
+{
+
+/**
+ * Set of verification targets, by node and type, that the CHC engine proved safe or unsafe
+ * and the BMC engine does not have to check any more. Lookups wait until the set is complete,
+ * so that the BMC engine can encode a source while the CHC engine still analyses it and
+ * skips the same targets as if it ran afterwards.
+ */
+class SolvedTargets
+{
+public:
+	void insert(ASTNode const* _node, VerificationTargetType _type);
+	/// Marks the set as complete, which wakes up the threads waiting in contains.
+	void markComplete();
+
+	/// @returns true if the target of type @a _type at @a _node was inserted. Underflow and
+	/// overflow targets are also contained if a combined target was inserted for the node.
+	/// Waits until the set is complete.
+	bool contains(ASTNode const* _node, VerificationTargetType _type) const;
+
+private:
+	mutable std::mutex m_mutex;
+	mutable std::condition_variable m_completed;
+	bool m_complete = false;
+	std::map<ASTNode const*, std::set<VerificationTargetType>> m_targets;
+};
+
+}
@@ -89,21 +89,30 @@ string SymbolicVariable::uniqueSymbol(unsigned _index) const
 smtutil::Expression SymbolicVariable::resetIndex()
 {
 	m_ssa->resetIndex();
+	indexChanged();
 	return currentValue();
 }
 
 smtutil::Expression SymbolicVariable::setIndex(unsigned _index)
 {
 	m_ssa->setIndex(_index);
+	indexChanged();
 	return currentValue();
 }
 
 smtutil::Expression SymbolicVariable::increaseIndex()
 {
 	++(*m_ssa);
+	indexChanged();
 	return currentValue();
 }
 
+void SymbolicVariable::indexChanged()
+{
+	if (m_indexSlot)
+		m_context.indexChanged(*m_indexSlot);
+}
+
 SymbolicBoolVariable::SymbolicBoolVariable(
 	frontend::TypePointer _type,
 	string _uniqueName,
@@ -200,6 +209,7 @@ smtutil::Expression SymbolicFunctionVariable::setIndex(unsigned _index)
 smtutil::Expression SymbolicFunctionVariable::increaseIndex()
 {
 	++(*m_ssa);
+	indexChanged();
 	resetDeclaration();
 	m_abstract.increaseIndex();
 	return m_abstract.currentValue();
@@ -26,6 +26,7 @@
 
 #include <map>
 #include <memory>
+#include <optional>
 
 namespace solidity::frontend::smt
 {
@@ -68,7 +69,11 @@ public:
 	}
 
 	unsigned index() const { return m_ssa->index(); }
-	unsigned& index() { return m_ssa->index(); }
+
+	/// Sets the slot of this variable in the SSA index snapshots of the encoding context,
+	/// which is then notified whenever the index changes.
+	void setIndexSlot(std::optional<unsigned> _slot) { m_indexSlot = _slot; }
+	std::optional<unsigned> indexSlot() const { return m_indexSlot; }
 
 	smtutil::SortPointer const& sort() const { return m_sort; }
 	frontend::TypePointer const& type() const { return m_type; }
@@ -76,6 +81,8 @@ public:
 
 protected:
 	std::string uniqueSymbol(unsigned _index) const;
+	/// Notifies the encoding context that the SSA index changed.
+	void indexChanged();
 
 	/// SMT sort.
 	smtutil::SortPointer m_sort;
@@ -86,6 +93,7 @@ protected:
 	std::string m_uniqueName;
 	EncodingContext& m_context;
 	std::unique_ptr<SSAVariable> m_ssa;
+	std::optional<unsigned> m_indexSlot;
 };
 
 /**
@@ -0,0 +1,402 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Compact binary format of the bytecode and the related outputs of compiled contracts.
+ */
+
+#include <libsolidity/interface/ArtifactBinary.h>
+
+#include <libsolidity/interface/CompilerStack.h>
+
+#include <libevmasm/LinkerObject.h>
+
+#include <liblangutil/Exceptions.h>
+
+#include <algorithm>
+#include <limits>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::frontend;
+
+namespace
+{
+
+string_view const signature{"\0SOLBIN\0", 8};
+
+/// Size of a source map record: start, length and source index (4 bytes each), modifier
+/// depth (2 bytes), jump type (1 byte) and one unused byte.
+size_t constexpr sourceMapRecordSize = 16;
+
+void writeFixed(string& _out, uint64_t _value, size_t _size)
+{
+	for (size_t i = 0; i < _size; ++i)
+		_out.push_back(static_cast<char>((_value >> (8 * i)) & 0xff));
+}
+
+string encodeSourceMap(vector<ArtifactBinary::SourceMapEntry> const& _sourceMap)
+{
+	string out;
+	out.reserve(_sourceMap.size() * sourceMapRecordSize);
+	for (ArtifactBinary::SourceMapEntry const& entry: _sourceMap)
+	{
+		writeFixed(out, static_cast<uint32_t>(entry.start), 4);
+		writeFixed(out, static_cast<uint32_t>(entry.length), 4);
+		writeFixed(out, static_cast<uint32_t>(entry.sourceIndex), 4);
+		writeFixed(out, entry.modifierDepth, 2);
+		writeFixed(out, static_cast<uint8_t>(entry.jumpType), 1);
+		writeFixed(out, 0, 1);
+	}
+	return out;
+}
+
+/// Each reference is the offset (4 bytes) followed by the length (4 bytes) and the name of the library.
+string encodeLinkReferences(map<size_t, string> const& _linkReferences)
+{
+	string out;
+	for (auto const& [offset, library]: _linkReferences)
+	{
+		writeFixed(out, offset, 4);
+		writeFixed(out, library.size(), 4);
+		out += library;
+	}
+	return out;
+}
+
+/// Each immutable is the length (4 bytes) and the identifier, followed by the number of
+/// references (4 bytes) and their offsets (4 bytes each).
+string encodeImmutableReferences(map<string, vector<size_t>> const& _immutableReferences)
+{
+	string out;
+	for (auto const& [identifier, offsets]: _immutableReferences)
+	{
+		writeFixed(out, identifier.size(), 4);
+		out += identifier;
+		writeFixed(out, offsets.size(), 4);
+		for (size_t offset: offsets)
+			writeFixed(out, offset, 4);
+	}
+	return out;
+}
+
+/// Reads from a part of the data and throws InvalidArtifactError instead of reading past it.
+class Reader
+{
+public:
+	explicit Reader(string_view _data): m_data(_data) {}
+
+	uint64_t fixed(size_t _size)
+	{
+		assertThrow(_size <= m_data.size() - m_position, InvalidArtifactError, "Binary artifact truncated.");
+		uint64_t value = 0;
+		for (size_t i = 0; i < _size; ++i)
+			value |= uint64_t(static_cast<uint8_t>(m_data[m_position++])) << (8 * i);
+		return value;
+	}
+
+	string_view bytes(uint64_t _length)
+	{
+		assertThrow(_length <= m_data.size() - m_position, InvalidArtifactError, "Binary artifact truncated.");
+		string_view result = m_data.substr(m_position, _length);
+		m_position += _length;
+		return result;
+	}
+
+	bool atEnd() const { return m_position == m_data.size(); }
+
+private:
+	string_view m_data;
+	size_t m_position = 0;
+};
+
+int32_t parseSourceMapInteger(string_view _value, bool _allowNegative)
+{
+	bool negative = _allowNegative && !_value.empty() && _value.front() == '-';
+	string_view digits = _value.substr(negative ? 1 : 0);
+	assertThrow(
+		!digits.empty() && digits.size() <= 10 && all_of(digits.begin(), digits.end(), [](char c) { return '0' <= c && c <= '9'; }),
+		InvalidArtifactError,
+		"Invalid number \"" + string(_value) + "\" in source map."
+	);
+	int64_t value = stoll(string(digits));
+	assertThrow(value <= numeric_limits<int32_t>::max(), InvalidArtifactError, "Number out of range in source map.");
+	return static_cast<int32_t>(negative ? -value : value);
+}
+
+}
+
+bool ArtifactBinary::isBinary(string_view _data)
+{
+	return _data.substr(0, signature.size()) == signature;
+}
+
+vector<ArtifactBinary::SourceMapEntry> ArtifactBinary::expandSourceMap(string_view _sourceMap)
+{
+	vector<SourceMapEntry> entries;
+	if (_sourceMap.empty())
+		return entries;
+
+	// Empty fields repeat the value of the previous entry.
+	SourceMapEntry entry;
+	for (size_t itemStart = 0; itemStart <= _sourceMap.size();)
+	{
+		size_t itemEnd = min(_sourceMap.find(';', itemStart), _sourceMap.size());
+		string_view item = _sourceMap.substr(itemStart, itemEnd - itemStart);
+		size_t field = 0;
+		for (size_t fieldStart = 0; fieldStart <= item.size(); ++field)
+		{
+			size_t fieldEnd = min(item.find(':', fieldStart), item.size());
+			string_view value = item.substr(fieldStart, fieldEnd - fieldStart);
+			fieldStart = fieldEnd + 1;
+			if (value.empty())
+				continue;
+			switch (field)
+			{
+			case 0:
+				entry.start = parseSourceMapInteger(value, true);
+				break;
+			case 1:
+				entry.length = parseSourceMapInteger(value, true);
+				break;
+			case 2:
+				entry.sourceIndex = parseSourceMapInteger(value, true);
+				break;
+			case 3:
+				assertThrow(
+					value == "i" || value == "o" || value == "-",
+					InvalidArtifactError,
+					"Invalid jump type \"" + string(value) + "\" in source map."
+				);
+				entry.jumpType = value.front();
+				break;
+			case 4:
+			{
+				int32_t modifierDepth = parseSourceMapInteger(value, false);
+				assertThrow(
+					modifierDepth <= numeric_limits<uint16_t>::max(),
+					InvalidArtifactError,
+					"Modifier depth out of range in source map."
+				);
+				entry.modifierDepth = static_cast<uint16_t>(modifierDepth);
+				break;
+			}
+			default:
+				assertThrow(false, InvalidArtifactError, "Too many fields in source map.");
+			}
+		}
+		entries.push_back(entry);
+		itemStart = itemEnd + 1;
+	}
+	return entries;
+}
+
+string ArtifactBinary::encode(vector<string> const& _sourceNames, map<string, Contract> const& _contracts)
+{
+	string out{signature};
+	writeFixed(out, formatVersion, 4);
+	writeFixed(out, _contracts.size(), 4);
+
+	// The index consists of the offset and length of the source list, followed by those of the
+	// name and the sections of each contract.
+	size_t indexField = out.size();
+	out.resize(out.size() + 16 * (1 + (1 + SectionCount) * _contracts.size()), '\0');
+	auto addSection = [&](string_view _data) {
+		out.resize((out.size() + 7) / 8 * 8, '\0');
+		string entry;
+		writeFixed(entry, out.size(), 8);
+		writeFixed(entry, _data.size(), 8);
+		out.replace(indexField, entry.size(), entry);
+		indexField += entry.size();
+		out += _data;
+	};
+
+	string sourceList;
+	for (string const& sourceName: _sourceNames)
+	{
+		writeFixed(sourceList, sourceName.size(), 4);
+		sourceList += sourceName;
+	}
+	addSection(sourceList);
+
+	for (auto const& [name, contract]: _contracts)
+	{
+		addSection(name);
+		addSection(util::asString(contract.bytecode));
+		addSection(util::asString(contract.deployedBytecode));
+		addSection(encodeSourceMap(contract.sourceMap));
+		addSection(encodeSourceMap(contract.deployedSourceMap));
+		addSection(encodeLinkReferences(contract.linkReferences));
+		addSection(encodeLinkReferences(contract.deployedLinkReferences));
+		addSection(encodeImmutableReferences(contract.immutableReferences));
+	}
+	return out;
+}
+
+string ArtifactBinary::encode(CompilerStack const& _compiler)
+{
+	solAssert(_compiler.compilationSuccessful(), "");
+
+	vector<string> sourceNames(_compiler.sourceIndices().size());
+	for (auto const& [sourceName, index]: _compiler.sourceIndices())
+		sourceNames.at(index) = sourceName;
+
+	map<string, Contract> contracts;
+	for (string const& contractName: _compiler.contractNames())
+	{
+		Contract& contract = contracts[contractName];
+		evmasm::LinkerObject const& object = _compiler.object(contractName);
+		evmasm::LinkerObject const& runtimeObject = _compiler.runtimeObject(contractName);
+		contract.bytecode = object.bytecode;
+		contract.deployedBytecode = runtimeObject.bytecode;
+		if (string const* sourceMap = _compiler.sourceMapping(contractName))
+			contract.sourceMap = expandSourceMap(*sourceMap);
+		if (string const* sourceMap = _compiler.runtimeSourceMapping(contractName))
+			contract.deployedSourceMap = expandSourceMap(*sourceMap);
+		contract.linkReferences = object.linkReferences;
+		contract.deployedLinkReferences = runtimeObject.linkReferences;
+		for (auto const& reference: runtimeObject.immutableReferences)
+			contract.immutableReferences[reference.second.first] = reference.second.second;
+	}
+	return encode(sourceNames, contracts);
+}
+
+ArtifactBinary::ArtifactBinary(string_view _data):
+	m_data(_data)
+{
+	assertThrow(isBinary(_data), InvalidArtifactError, "Data is not a binary artifact.");
+	Reader index(_data.substr(signature.size()));
+	uint64_t version = index.fixed(4);
+	assertThrow(
+		version == formatVersion,
+		InvalidArtifactError,
+		"Unsupported version " + to_string(version) + " of binary artifact, expected " + to_string(formatVersion) + "."
+	);
+	uint64_t contractCount = index.fixed(4);
+	auto readEntry = [&]() {
+		Entry entry;
+		entry.offset = index.fixed(8);
+		entry.length = index.fixed(8);
+		assertThrow(
+			entry.offset <= _data.size() && entry.length <= _data.size() - entry.offset,
+			InvalidArtifactError,
+			"Binary artifact truncated."
+		);
+		return entry;
+	};
+
+	Entry sourceList = readEntry();
+	Reader sources(_data.substr(sourceList.offset, sourceList.length));
+	while (!sources.atEnd())
+		m_sourceNames.emplace_back(sources.bytes(sources.fixed(4)));
+
+	for (uint64_t i = 0; i < contractCount; ++i)
+	{
+		Entry name = readEntry();
+		array<Entry, SectionCount> sections;
+		for (Entry& section: sections)
+			section = readEntry();
+		assertThrow(
+			sections[SourceMap].length % sourceMapRecordSize == 0 &&
+			sections[DeployedSourceMap].length % sourceMapRecordSize == 0,
+			InvalidArtifactError,
+			"Invalid source map in binary artifact."
+		);
+		assertThrow(
+			m_contracts.emplace(string(_data.substr(name.offset, name.length)), sections).second,
+			InvalidArtifactError,
+			"Duplicate contract in binary artifact."
+		);
+	}
+}
+
+vector<string> ArtifactBinary::contractNames() const
+{
+	vector<string> names;
+	for (auto const& contract: m_contracts)
+		names.push_back(contract.first);
+	return names;
+}
+
+string_view ArtifactBinary::bytecode(string const& _contractName) const
+{
+	return section(_contractName, Bytecode);
+}
+
+string_view ArtifactBinary::deployedBytecode(string const& _contractName) const
+{
+	return section(_contractName, DeployedBytecode);
+}
+
+ArtifactBinary::Contract ArtifactBinary::contract(string const& _contractName) const
+{
+	auto readSourceMap = [&](Section _section) {
+		Reader reader(section(_contractName, _section));
+		vector<SourceMapEntry> sourceMap;
+		while (!reader.atEnd())
+		{
+			SourceMapEntry& entry = sourceMap.emplace_back();
+			entry.start = static_cast<int32_t>(static_cast<uint32_t>(reader.fixed(4)));
+			entry.length = static_cast<int32_t>(static_cast<uint32_t>(reader.fixed(4)));
+			entry.sourceIndex = static_cast<int32_t>(static_cast<uint32_t>(reader.fixed(4)));
+			entry.modifierDepth = static_cast<uint16_t>(reader.fixed(2));
+			entry.jumpType = static_cast<char>(reader.fixed(1));
+			reader.fixed(1);
+		}
+		return sourceMap;
+	};
+	auto readLinkReferences = [&](Section _section) {
+		Reader reader(section(_contractName, _section));
+		map<size_t, string> linkReferences;
+		while (!reader.atEnd())
+		{
+			size_t offset = reader.fixed(4);
+			linkReferences[offset] = string(reader.bytes(reader.fixed(4)));
+		}
+		return linkReferences;
+	};
+
+	Contract contract;
+	string_view code = bytecode(_contractName);
+	contract.bytecode = bytes(code.begin(), code.end());
+	code = deployedBytecode(_contractName);
+	contract.deployedBytecode = bytes(code.begin(), code.end());
+	contract.sourceMap = readSourceMap(SourceMap);
+	contract.deployedSourceMap = readSourceMap(DeployedSourceMap);
+	contract.linkReferences = readLinkReferences(LinkReferences);
+	contract.deployedLinkReferences = readLinkReferences(DeployedLinkReferences);
+
+	Reader immutables(section(_contractName, ImmutableReferences));
+	while (!immutables.atEnd())
+	{
+		vector<size_t>& offsets = contract.immutableReferences[string(immutables.bytes(immutables.fixed(4)))];
+		for (uint64_t count = immutables.fixed(4); count > 0; --count)
+			offsets.push_back(immutables.fixed(4));
+	}
+	return contract;
+}
+
+string_view ArtifactBinary::section(string const& _contractName, Section _section) const
+{
+	auto it = m_contracts.find(_contractName);
+	assertThrow(
+		it != m_contracts.end(),
+		InvalidArtifactError,
+		"Contract \"" + _contractName + "\" not found in binary artifact."
+	);
+	return m_data.substr(it->second[_section].offset, it->second[_section].length);
+}
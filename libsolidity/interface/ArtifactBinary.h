@@ -0,0 +1,146 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Compact binary format of the bytecode and the related outputs of compiled contracts.
+ */
+
+#pragma once
+
+#include <libsolutil/Common.h>
+#include <libsolutil/Exceptions.h>
+
+#include <array>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <vector>
+
+namespace solidity::frontend
+{
+
+class CompilerStack;
+
+struct InvalidArtifactError: virtual util::Exception {};
+
+/**
+ * Binary encoding of the bytecode, deployed bytecode, source maps, link references and
+ * immutable references of compiled contracts, which can be read without decoding JSON or hex.
+ *
+ * The data starts with a header and an index holding the name and the offset and length of
+ * each section of each contract, followed by the list of source names the source maps refer
+ * to and the sections, each starting at a multiple of 8 bytes. The bytecode is stored as raw
+ * bytes and the source maps as one record of 16 bytes per assembly item, so the location of
+ * an item is found without expanding the map. All integers are little endian, so the data
+ * can be read in place, e.g. from a file mapped into memory.
+ */
+class ArtifactBinary
+{
+public:
+	/// Version of the format, increased with every incompatible change.
+	static uint32_t constexpr formatVersion = 1;
+
+	/// Entry of a source map, with the fields of the compressed format of the compiler output.
+	struct SourceMapEntry
+	{
+		int32_t start = -1;
+		int32_t length = -1;
+		int32_t sourceIndex = -1;
+		/// 'i', 'o' or '-'.
+		char jumpType = '-';
+		uint16_t modifierDepth = 0;
+
+		bool operator==(SourceMapEntry const& _other) const
+		{
+			return
+				std::make_tuple(start, length, sourceIndex, jumpType, modifierDepth) ==
+				std::make_tuple(_other.start, _other.length, _other.sourceIndex, _other.jumpType, _other.modifierDepth);
+		}
+	};
+
+	struct Contract
+	{
+		bytes bytecode;
+		bytes deployedBytecode;
+		std::vector<SourceMapEntry> sourceMap;
+		std::vector<SourceMapEntry> deployedSourceMap;
+		/// Fully qualified names of the libraries by offset of their address in the bytecode.
+		std::map<size_t, std::string> linkReferences;
+		std::map<size_t, std::string> deployedLinkReferences;
+		/// Offsets of the values of the immutable variables in the deployed bytecode by
+		/// identifier of the variable. Each value is 32 bytes long.
+		std::map<std::string, std::vector<size_t>> immutableReferences;
+	};
+
+	/// @returns true if @a _data starts with the signature of the binary format.
+	static bool isBinary(std::string_view _data);
+
+	/// @returns the entries of the compressed source map @a _sourceMap.
+	/// Throws InvalidArtifactError if it is not a valid source map.
+	static std::vector<SourceMapEntry> expandSourceMap(std::string_view _sourceMap);
+
+	/// @returns the binary encoding of @a _contracts, keyed by fully qualified name, whose
+	/// source maps refer to the sources @a _sourceNames by index.
+	static std::string encode(
+		std::vector<std::string> const& _sourceNames,
+		std::map<std::string, Contract> const& _contracts
+	);
+	/// @returns the binary encoding of all contracts of @a _compiler, which has to have compiled
+	/// successfully.
+	static std::string encode(CompilerStack const& _compiler);
+
+	/// Reads the header and index of @a _data, which has to outlive this object.
+	/// Throws InvalidArtifactError if the data is not in the binary format of this version.
+	explicit ArtifactBinary(std::string_view _data);
+
+	std::vector<std::string> const& sourceNames() const { return m_sourceNames; }
+	std::vector<std::string> contractNames() const;
+	/// @returns the bytecode of the contract @a _contractName as part of the data.
+	std::string_view bytecode(std::string const& _contractName) const;
+	std::string_view deployedBytecode(std::string const& _contractName) const;
+	/// @returns all decoded sections of the contract @a _contractName.
+	Contract contract(std::string const& _contractName) const;
+
+private:
+	enum Section
+	{
+		Bytecode,
+		DeployedBytecode,
+		SourceMap,
+		DeployedSourceMap,
+		LinkReferences,
+		DeployedLinkReferences,
+		ImmutableReferences,
+		SectionCount
+	};
+
+	struct Entry
+	{
+		uint64_t offset = 0;
+		uint64_t length = 0;
+	};
+
+	std::string_view section(std::string const& _contractName, Section _section) const;
+
+	std::string_view m_data;
+	std::vector<std::string> m_sourceNames;
+	std::map<std::string, std::array<Entry, SectionCount>> m_contracts;
+};
+
+}
@@ -0,0 +1,155 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * On-disk cache of the code generation outputs of contracts.
+ */
+
+#include <libsolidity/interface/CompilationCache.h>
+
+#include <libsolutil/CommonData.h>
+#include <libsolutil/CommonIO.h>
+#include <libsolutil/JSON.h>
+
+#include <boost/filesystem.hpp>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::evmasm;
+using namespace solidity::frontend;
+using namespace solidity::util;
+
+namespace
+{
+
+Json::Value linkerObjectToJson(LinkerObject const& _object)
+{
+	Json::Value ret{Json::objectValue};
+	ret["object"] = toHex(_object.bytecode);
+
+	ret["linkReferences"] = Json::objectValue;
+	for (auto const& [offset, library]: _object.linkReferences)
+		ret["linkReferences"][to_string(offset)] = library;
+
+	ret["immutableReferences"] = Json::arrayValue;
+	for (auto const& [hash, reference]: _object.immutableReferences)
+	{
+		Json::Value immutable{Json::objectValue};
+		immutable["hash"] = toString(hash);
+		immutable["name"] = reference.first;
+		immutable["offsets"] = Json::arrayValue;
+		for (size_t offset: reference.second)
+			immutable["offsets"].append(Json::UInt64(offset));
+		ret["immutableReferences"].append(move(immutable));
+	}
+	return ret;
+}
+
+/// @returns the object stored in @a _json or nullopt if it is malformed.
+optional<LinkerObject> linkerObjectFromJson(Json::Value const& _json)
+{
+	if (
+		!_json.isObject() ||
+		!_json["object"].isString() ||
+		!_json["linkReferences"].isObject() ||
+		!_json["immutableReferences"].isArray()
+	)
+		return nullopt;
+
+	LinkerObject object;
+	object.bytecode = fromHex(_json["object"].asString(), WhenError::Throw);
+
+	for (auto const& offset: _json["linkReferences"].getMemberNames())
+	{
+		if (!_json["linkReferences"][offset].isString())
+			return nullopt;
+		object.linkReferences[stoul(offset)] = _json["linkReferences"][offset].asString();
+	}
+
+	for (auto const& immutable: _json["immutableReferences"])
+	{
+		if (!immutable["hash"].isString() || !immutable["name"].isString() || !immutable["offsets"].isArray())
+			return nullopt;
+		auto& reference = object.immutableReferences[u256(immutable["hash"].asString())];
+		reference.first = immutable["name"].asString();
+		for (auto const& offset: immutable["offsets"])
+		{
+			if (!offset.isUInt64())
+				return nullopt;
+			reference.second.push_back(static_cast<size_t>(offset.asUInt64()));
+		}
+	}
+	return object;
+}
+
+}
+
+optional<CompilationCache::Artifacts> CompilationCache::load(h256 const& _key) const
+{
+	try
+	{
+		boost::filesystem::path const path = entryPath(_key);
+		if (!boost::filesystem::is_regular_file(path))
+			return nullopt;
+
+		Json::Value entry;
+		if (!jsonParseStrict(readFileAsString(path.string()), entry) || !entry.isObject())
+			return nullopt;
+
+		optional<LinkerObject> object = linkerObjectFromJson(entry["bytecode"]);
+		optional<LinkerObject> runtimeObject = linkerObjectFromJson(entry["deployedBytecode"]);
+		if (!object || !runtimeObject || !entry["ir"].isString() || !entry["irOptimized"].isString())
+			return nullopt;
+
+		Artifacts artifacts;
+		artifacts.object = move(*object);
+		artifacts.runtimeObject = move(*runtimeObject);
+		if (entry["sourceMap"].isString())
+			artifacts.sourceMapping = entry["sourceMap"].asString();
+		if (entry["deployedSourceMap"].isString())
+			artifacts.runtimeSourceMapping = entry["deployedSourceMap"].asString();
+		artifacts.yulIR = entry["ir"].asString();
+		artifacts.yulIROptimized = entry["irOptimized"].asString();
+		return artifacts;
+	}
+	catch (...)
+	{
+		// Treat corrupted entries as missing, they are replaced after compiling.
+		return nullopt;
+	}
+}
+
+void CompilationCache::store(h256 const& _key, Artifacts const& _artifacts) const
+{
+	Json::Value entry{Json::objectValue};
+	entry["bytecode"] = linkerObjectToJson(_artifacts.object);
+	entry["deployedBytecode"] = linkerObjectToJson(_artifacts.runtimeObject);
+	if (_artifacts.sourceMapping)
+		entry["sourceMap"] = *_artifacts.sourceMapping;
+	if (_artifacts.runtimeSourceMapping)
+		entry["deployedSourceMap"] = *_artifacts.runtimeSourceMapping;
+	entry["ir"] = _artifacts.yulIR;
+	entry["irOptimized"] = _artifacts.yulIROptimized;
+
+	// The cache is only an optimization, failing to fill it is not an error.
+	writeFileAtomically(entryPath(_key).string(), jsonCompactPrint(entry));
+}
+
+boost::filesystem::path CompilationCache::entryPath(h256 const& _key) const
+{
+	return m_directory / (_key.hex() + ".json");
+}
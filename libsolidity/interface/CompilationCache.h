@@ -0,0 +1,75 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * On-disk cache of the code generation outputs of contracts.
+ */
+
+#pragma once
+
+#include <libevmasm/LinkerObject.h>
+
+#include <libsolutil/FixedHash.h>
+
+#include <boost/filesystem/path.hpp>
+
+#include <optional>
+#include <string>
+
+namespace solidity::frontend
+{
+
+/**
+ * Content-addressed store for the code generation outputs of single contracts.
+ *
+ * Entries are files in a directory, named after the key they are stored under.
+ * The key has to be a hash of everything the outputs depend on, see CompilerStack.
+ * Unreadable or malformed entries are treated as missing and failures to write entries
+ * are ignored, so that the cache never causes a compilation to fail.
+ */
+class CompilationCache
+{
+public:
+	/// Code generation outputs of a contract.
+	struct Artifacts
+	{
+		evmasm::LinkerObject object;
+		evmasm::LinkerObject runtimeObject;
+		std::optional<std::string> sourceMapping;
+		std::optional<std::string> runtimeSourceMapping;
+		std::string yulIR;
+		std::string yulIROptimized;
+	};
+
+	explicit CompilationCache(boost::filesystem::path _directory): m_directory(std::move(_directory)) {}
+
+	boost::filesystem::path const& directory() const { return m_directory; }
+
+	/// @returns the artifacts stored under @a _key or nullopt if there is no valid entry.
+	std::optional<Artifacts> load(util::h256 const& _key) const;
+
+	/// Stores @a _artifacts under @a _key, replacing an existing entry.
+	/// Creates the cache directory if it does not exist.
+	void store(util::h256 const& _key, Artifacts const& _artifacts) const;
+
+private:
+	boost::filesystem::path entryPath(util::h256 const& _key) const;
+
+	boost::filesystem::path m_directory;
+};
+
+}
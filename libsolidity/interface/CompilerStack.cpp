@@ -42,38 +42,57 @@
 #include <libsolidity/analysis/ImmutableValidator.h>
 
 #include <libsolidity/ast/AST.h>
+#include <libsolidity/ast/ASTVisitor.h>
+#include <libsolidity/ast/FusedASTConstVisitor.h>
 #include <libsolidity/ast/TypeProvider.h>
+#include <libsolidity/ast/ASTBinary.h>
 #include <libsolidity/ast/ASTJsonImporter.h>
 #include <libsolidity/codegen/Compiler.h>
+#include <libsolidity/codegen/CompilerUtils.h>
+#include <libsolidity/codegen/InlineAssemblyCache.h>
 #include <libsolidity/formal/ModelChecker.h>
 #include <libsolidity/interface/ABI.h>
+#include <libsolidity/interface/CompilationCache.h>
 #include <libsolidity/interface/Natspec.h>
 #include <libsolidity/interface/GasEstimator.h>
 #include <libsolidity/interface/StorageLayout.h>
 #include <libsolidity/interface/Version.h>
 #include <libsolidity/parsing/Parser.h>
 
+#include <libsolidity/codegen/ir/Common.h>
 #include <libsolidity/codegen/ir/IRGenerator.h>
 
 #include <libyul/YulString.h>
 #include <libyul/AsmPrinter.h>
 #include <libyul/AsmJsonConverter.h>
 #include <libyul/AssemblyStack.h>
+#include <libyul/optimiser/OptimisedCodeCache.h>
+#include <libyul/backends/evm/EVMObjectCache.h>
 #include <libyul/AsmParser.h>
 #include <libyul/AST.h>
 
 #include <liblangutil/Scanner.h>
 #include <liblangutil/SemVerHandler.h>
+#include <liblangutil/Symbol.h>
 
+#include <libevmasm/ConstantOptimiser.h>
 #include <libevmasm/Exceptions.h>
 
 #include <libsolutil/SwarmHash.h>
 #include <libsolutil/IpfsHash.h>
 #include <libsolutil/JSON.h>
+#include <libsolutil/ThreadPool.h>
+#include <libsolutil/Tracer.h>
 
 #include <json/json.h>
 
+#include <boost/algorithm/string/predicate.hpp>
 #include <boost/algorithm/string/replace.hpp>
+
+#include <deque>
+#include <future>
+#include <list>
+#include <mutex>
 #include <utility>
 
 using namespace std;
@@ -84,23 +103,123 @@ using namespace solidity::frontend;
 using solidity::util::errinfo_comment;
 using solidity::util::toHex;
 
-static int g_compilerStackCounts = 0;
+namespace
+{
+
+/// @returns the mutex guarding the lazily computed hashes and metadata entries of the sources,
+/// which are requested concurrently if the metadata of several contracts is generated at the same time.
+mutex& sourceHashMutex()
+{
+	static mutex hashMutex;
+	return hashMutex;
+}
+
+/// Removes the results of a previous analysis from an AST.
+class AnnotationRemover: private ASTVisitor
+{
+public:
+	explicit AnnotationRemover(ASTNode& _root) { _root.accept(*this); }
+
+private:
+	bool visit(ImportDirective& _import) override
+	{
+		// ImportDirective::accept does not visit the aliased symbols.
+		for (ImportDirective::SymbolAlias const& alias: _import.symbolAliases())
+			alias.symbol->clearAnnotation();
+		return visitNode(_import);
+	}
+
+	bool visitNode(ASTNode& _node) override
+	{
+		_node.clearAnnotation();
+		return true;
+	}
+};
+
+/// Adds a constant to the IDs of all nodes of an AST.
+class IDShifter: private ASTVisitor
+{
+public:
+	IDShifter(ASTNode& _root, int64_t _offset): m_offset(_offset) { _root.accept(*this); }
+
+private:
+	bool visit(ImportDirective& _import) override
+	{
+		// ImportDirective::accept does not visit the aliased symbols.
+		for (ImportDirective::SymbolAlias const& alias: _import.symbolAliases())
+			alias.symbol->shiftID(m_offset);
+		return visitNode(_import);
+	}
+
+	bool visitNode(ASTNode& _node) override
+	{
+		_node.shiftID(m_offset);
+		return true;
+	}
+
+	int64_t m_offset = 0;
+};
+
+/// Runs the analysis passes @a _passes, given as visitors together with the lists their errors are
+/// collected in, in a single traversal of @a _sources. Their errors are merged into @a _errorReporter
+/// in the order of the passes afterwards, such that the result is the same as if each pass had traversed
+/// the sources on its own. If @a _stopOnErrors is set, the errors of the remaining passes are dropped
+/// as soon as there are errors, as if these passes had not been run.
+/// @returns true iff there are no errors afterwards.
+bool runFusedPasses(
+	vector<pair<ASTConstVisitor*, ErrorList const*>> const& _passes,
+	vector<ASTNode const*> const& _sources,
+	ErrorReporter& _errorReporter,
+	bool _stopOnErrors
+)
+{
+	vector<ASTConstVisitor*> visitors;
+	for (auto const& pass: _passes)
+		visitors.push_back(pass.first);
+	FusedASTConstVisitor fusedVisitor(visitors);
+	for (ASTNode const* source: _sources)
+		fusedVisitor.run(*source);
+
+	for (size_t i = 0; i < _passes.size(); ++i)
+	{
+		_errorReporter.merge(*_passes[i].second);
+		if (exception_ptr exception = fusedVisitor.exception(i))
+			rethrow_exception(exception);
+		if (_stopOnErrors && !Error::containsOnlyWarnings(_errorReporter.errors()))
+			break;
+	}
+	return Error::containsOnlyWarnings(_errorReporter.errors());
+}
+
+/// @returns the paths of the sources whose ASTs @a _contract can refer to,
+/// i.e. its own source and all sources imported by it, directly or indirectly.
+set<string> referableSources(ContractDefinition const& _contract)
+{
+	set<string> sources;
+	sources.insert(*_contract.sourceUnit().annotation().path);
+	for (auto const sourceUnit: _contract.sourceUnit().referencedSourceUnits(true))
+		sources.insert(*sourceUnit->annotation().path);
+	return sources;
+}
+
+}
 
 CompilerStack::CompilerStack(ReadCallback::Callback _readFile):
 	m_readFile{std::move(_readFile)},
 	m_enabledSMTSolvers{smtutil::SMTSolverChoice::All()},
+	m_typeProvider{make_shared<TypeProvider>()},
+	m_sharedYulFunctions{make_shared<SharedYulFunctionCache>()},
+	m_sharedIRFunctions{make_shared<SharedIRFunctionCache>()},
+	m_optimisedCodeCache{make_shared<yul::OptimisedCodeCache>(string(VersionString))},
 	m_errorReporter{m_errorList}
 {
-	// Because TypeProvider is currently a singleton API, we must ensure that
-	// no more than one entity is actually using it at a time.
-	solAssert(g_compilerStackCounts == 0, "You shall not have another CompilerStack aside me.");
-	++g_compilerStackCounts;
 }
 
 CompilerStack::~CompilerStack()
 {
-	--g_compilerStackCounts;
-	TypeProvider::reset();
+	// The Yul string repository is not reset here: it is shared by all compiler stacks of the
+	// process. Long-running users reset it between compilations instead, e.g. StandardCompiler
+	// and solidity_reset().
 }
 
 std::optional<CompilerStack::Remapping> CompilerStack::parseRemapping(string const& _remapping)
@@ -130,6 +249,13 @@ void CompilerStack::setRemappings(vector<Remapping> const& _remappings)
 	for (auto const& remapping: _remappings)
 		solAssert(!remapping.prefix.empty(), "");
 	m_remappings = _remappings;
+	m_remappingIndex.clear();
+	for (auto const& remapping: m_remappings)
+		m_remappingIndex.add(
+			util::sanitizePath(remapping.context),
+			util::sanitizePath(remapping.prefix),
+			util::sanitizePath(remapping.target)
+		);
 }
 
 void CompilerStack::setViaIR(bool _viaIR)
@@ -139,6 +265,19 @@ void CompilerStack::setViaIR(bool _viaIR)
 	m_viaIR = _viaIR;
 }
 
+void CompilerStack::setOptimisationProfiles(map<string, OptimisationProfile> _profiles)
+{
+	if (m_stackState >= ParsedAndImported)
+		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Must set optimisation profiles before parsing."));
+	m_optimisationProfiles = move(_profiles);
+}
+
+void CompilerStack::setCompilationCache(shared_ptr<CompilationCache const> _cache)
+{
+	m_compilationCache = move(_cache);
+	resetOptimisedCodeCache();
+}
+
 void CompilerStack::setEVMVersion(langutil::EVMVersion _version)
 {
 	if (m_stackState >= ParsedAndImported)
@@ -214,19 +353,37 @@ void CompilerStack::reset(bool _keepSettings)
 {
 	m_stackState = Empty;
 	m_hasError = false;
+	m_documentationComplete = false;
+	m_analysis = nullptr;
+	m_previousSources.clear();
+	if (m_incrementalParsing && !m_importedSources)
+	{
+		for (auto& [path, source]: m_sources)
+			if (source.ast && Error::containsOnlyWarnings(source.parserErrors))
+				m_previousSources.emplace(path, move(source));
+		m_previousSourcesEVMVersion = m_evmVersion;
+		m_previousSourcesYulStringGeneration = m_sourcesYulStringGeneration;
+		m_previousSourcesSymbolGeneration = m_sourcesSymbolGeneration;
+	}
 	m_sources.clear();
+	m_metadataSourceEntries.clear();
 	m_smtlib2Responses.clear();
 	m_unhandledSMTLib2Queries.clear();
 	if (!_keepSettings)
 	{
 		m_remappings.clear();
+		m_remappingIndex.clear();
 		m_libraries.clear();
 		m_viaIR = false;
+		m_optimisationProfiles.clear();
 		m_evmVersion = langutil::EVMVersion();
 		m_modelCheckerSettings = ModelCheckerSettings{};
 		m_enabledSMTSolvers = smtutil::SMTSolverChoice::All();
+		m_skipUnrequestedSources = false;
 		m_generateIR = false;
 		m_generateEwasm = false;
+		m_compilationCache.reset();
+		m_collectStatistics = false;
 		m_revertStrings = RevertStrings::Default;
 		m_optimiserSettings = OptimiserSettings::minimal();
 		m_metadataLiteralSources = false;
@@ -236,17 +393,34 @@ void CompilerStack::reset(bool _keepSettings)
 	m_globalContext.reset();
 	m_sourceOrder.clear();
 	m_contracts.clear();
+	m_keptASTs.clear();
+	m_astReferences.reset();
+	m_astNodeIndex = {};
+	m_sourceIndices.clear();
+	m_statistics = {};
+	m_modelCheckerStatistics.clear();
 	m_errorReporter.clear();
-	TypeProvider::reset();
+	m_typeProvider = make_shared<TypeProvider>();
+	m_sharedYulFunctions = make_shared<SharedYulFunctionCache>();
+	m_sharedIRFunctions = make_shared<SharedIRFunctionCache>();
+	resetOptimisedCodeCache();
 }
 
 void CompilerStack::setSources(StringMap _sources)
+{
+	map<string, util::SourceBuffer> sources;
+	for (auto& source: _sources)
+		sources.emplace(source.first, util::SourceBuffer(std::move(source.second)));
+	setSourceBuffers(std::move(sources));
+}
+
+void CompilerStack::setSourceBuffers(map<string, util::SourceBuffer> _sources)
 {
 	if (m_stackState == SourcesSet)
 		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Cannot change sources once set."));
 	if (m_stackState != Empty)
 		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Must set sources before parsing."));
-	for (auto source: _sources)
+	for (auto& source: _sources)
 		m_sources[source.first].scanner = make_shared<Scanner>(CharStream(/*content*/std::move(source.second), /*name*/source.first));
 	m_stackState = SourcesSet;
 }
@@ -257,37 +431,123 @@ bool CompilerStack::parse()
 		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Must call parse only after the SourcesSet state."));
 	m_errorReporter.clear();
 
+	util::CompilationStatistics::Scope statisticsScope(m_collectStatistics ? &m_statistics : nullptr);
+	util::CompilationStatistics::PhaseTimer timer("parsing");
+
 	if (SemVerVersion{string(VersionString)}.isPrerelease())
 		m_errorReporter.warning(3805_error, "This is a pre-release compiler version, please do not use it in production.");
 
-	Parser parser{m_errorReporter, m_evmVersion, m_parserErrorRecovery};
+	m_sourcesYulStringGeneration = yul::YulStringRepository::generation();
+	m_sourcesSymbolGeneration = Symbol::generation();
 
+	// The sources are parsed concurrently, each by a parser of its own. Everything else,
+	// including the calls to the read callback, happens on this thread in the order of
+	// serial parsing: The imports of a source are loaded as soon as it is parsed, while
+	// other sources are still being parsed. The node IDs of each source are shifted to follow
+	// those of the sources before it and its errors are reported in that order, so that the
+	// result does not depend on the number of threads.
+	struct ParseJob
+	{
+		bool reused = false;
+		/// The body parsed again if only the body of a function or modifier of a reused source changed.
+		ASTPointer<Block> reparsedBody;
+		shared_ptr<Scanner> scanner;
+		ASTPointer<SourceUnit> ast;
+		ErrorList errors;
+		int64_t maxID = 0;
+		future<void> finished;
+	};
+	deque<ParseJob> jobs;
+	util::ThreadPool threadPool(m_parallelism);
 	vector<string> sourcesToParse;
+	set<string> sourcesStarted;
+	auto startParsing = [&](string const& _path) {
+		if (!sourcesStarted.insert(_path).second)
+			return;
+		sourcesToParse.push_back(_path);
+		ParseJob& job = jobs.emplace_back();
+		Source& source = m_sources[_path];
+		job.reused = reuseParsedSource(_path, source, job.reparsedBody, job.maxID);
+		if (job.reused)
+			return;
+		job.scanner = source.scanner;
+		auto finished = make_shared<promise<void>>();
+		job.finished = finished->get_future();
+		threadPool.submit([this, &job, finished, _path]() {
+			try
+			{
+				util::Tracer::Span span("parsing", "parse", _path);
+				ErrorReporter errorReporter(job.errors);
+				Parser parser{errorReporter, m_evmVersion, m_parserErrorRecovery};
+				job.scanner->reset();
+				job.ast = parser.parse(job.scanner);
+				job.maxID = parser.maxID();
+				finished->set_value();
+			}
+			catch (...)
+			{
+				finished->set_exception(current_exception());
+			}
+		});
+	};
+
+	// Without the imports, the import closure of the requested sources is unknown.
+	bool const importClosureOnly = m_skipUnrequestedSources && m_stopAfter >= ParsedAndImported;
 	for (auto const& s: m_sources)
-		sourcesToParse.push_back(s.first);
+		if (!importClosureOnly || isRequestedSource(s.first))
+			startParsing(s.first);
 
+	int64_t maxID = m_incrementalParsing ? m_maxASTNodeID : 0;
 	for (size_t i = 0; i < sourcesToParse.size(); ++i)
 	{
-		string const& path = sourcesToParse[i];
+		string const path = sourcesToParse[i];
 		Source& source = m_sources[path];
-		source.scanner->reset();
-		source.ast = parser.parse(source.scanner);
+		ParseJob& job = jobs[i];
+		if (job.reused)
+		{
+			m_errorReporter.append(source.parserErrors);
+			if (job.reparsedBody && maxID > 0)
+				IDShifter{*job.reparsedBody, maxID};
+			maxID += job.maxID;
+		}
+		else
+		{
+			job.finished.get();
+			m_errorReporter.append(job.errors);
+			source.ast = move(job.ast);
+			if (source.ast && maxID > 0)
+				IDShifter{*source.ast, maxID};
+			maxID += job.maxID;
+			if (m_incrementalParsing)
+				source.parserErrors = std::move(job.errors);
+		}
 		if (!source.ast)
 			solAssert(!Error::containsOnlyWarnings(m_errorReporter.errors()), "Parser returned null but did not report error.");
 		else
 		{
 			source.ast->annotation().path = path;
 			if (m_stopAfter >= ParsedAndImported)
-				for (auto const& newSource: loadMissingSources(*source.ast, path))
+			{
+				for (auto& newSource: loadMissingSources(*source.ast, path))
 				{
 					string const& newPath = newSource.first;
-					string const& newContents = newSource.second;
-					m_sources[newPath].scanner = make_shared<Scanner>(CharStream(newContents, newPath));
-					sourcesToParse.push_back(newPath);
+					m_sources[newPath].scanner = make_shared<Scanner>(CharStream(std::move(newSource.second), newPath));
+					startParsing(newPath);
 				}
+				// Given sources are only parsed once a parsed source imports them.
+				if (importClosureOnly)
+					for (ASTPointer<ASTNode> const& node: source.ast->nodes())
+						if (auto const* import = dynamic_cast<ImportDirective const*>(node.get()))
+							if (import->annotation().absolutePath.set() && m_sources.count(*import->annotation().absolutePath))
+								startParsing(*import->annotation().absolutePath);
+			}
 		}
 	}
 
+	if (m_incrementalParsing)
+		m_maxASTNodeID = maxID;
+	m_previousSources.clear();
+
 	if (m_stopAfter <= Parsed)
 		m_stackState = Parsed;
 	else
@@ -296,6 +556,8 @@ bool CompilerStack::parse()
 		m_hasError = true;
 
 	storeContractDefinitions();
+	indexASTNodes();
+	storeSourceIndices();
 
 	return !m_hasError;
 }
@@ -320,12 +582,74 @@ void CompilerStack::importASTs(map<string, Json::Value> const& _sources)
 	m_importedSources = true;
 
 	storeContractDefinitions();
+	indexASTNodes();
+	storeSourceIndices();
+}
+
+void CompilerStack::importASTs(string_view _binaryASTs)
+{
+	importASTs(ASTBinary(_binaryASTs).sources());
+}
+
+void CompilerStack::useAnalysis(CompilerStack const& _analysis)
+{
+	if (m_stackState != Empty)
+		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Must use the analysis of another compiler stack only before setting sources."));
+	if (_analysis.m_stackState < Parsed)
+		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("The sources of the other compiler stack were not parsed."));
+
+	m_analysis = &_analysis;
+	m_evmVersion = _analysis.m_evmVersion;
+	m_remappings = _analysis.m_remappings;
+	m_remappingIndex = _analysis.m_remappingIndex;
+	m_parserErrorRecovery = _analysis.m_parserErrorRecovery;
+	m_modelCheckerSettings = _analysis.m_modelCheckerSettings;
+	m_enabledSMTSolvers = _analysis.m_enabledSMTSolvers;
+	m_smtlib2Responses = _analysis.m_smtlib2Responses;
+	m_unhandledSMTLib2Queries = _analysis.m_unhandledSMTLib2Queries;
+	m_modelCheckerStatistics = _analysis.m_modelCheckerStatistics;
+	m_statistics = _analysis.m_statistics;
+
+	// The ASTs, their annotations and the types they refer to are shared, everything
+	// the code generation produces belongs to this compiler stack.
+	m_sources = _analysis.m_sources;
+	m_sourceJsons = _analysis.m_sourceJsons;
+	m_importedSources = _analysis.m_importedSources;
+	m_sourceOrder.clear();
+	for (Source const* source: _analysis.m_sourceOrder)
+		for (auto const& [path, analysedSource]: _analysis.m_sources)
+			if (&analysedSource == source)
+				m_sourceOrder.push_back(&m_sources.at(path));
+	m_sourceIndices = _analysis.m_sourceIndices;
+	m_astNodeIndex = _analysis.m_astNodeIndex;
+	m_globalContext = _analysis.m_globalContext;
+	m_typeProvider = _analysis.m_typeProvider;
+	for (auto const& [name, contract]: _analysis.m_contracts)
+		m_contracts[name].contract = contract.contract;
+
+	m_errorReporter.clear();
+	m_errorReporter.append(_analysis.errors());
+	m_hasError = _analysis.m_hasError;
+	m_stackState = min(_analysis.m_stackState, AnalysisPerformed);
+
+	// The call graphs are stored in the shared annotations, so they are built here instead of
+	// by the IR generation of the compiler stacks that use the analysis concurrently.
+	if (m_stackState >= AnalysisPerformed && !m_hasError)
+		for (auto const& [name, contract]: m_contracts)
+			if (contract.contract->canBeDeployed())
+				buildCallGraphs(*contract.contract);
 }
 
 bool CompilerStack::analyze()
 {
 	if (m_stackState != ParsedAndImported || m_stackState >= AnalysisPerformed)
 		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Must call analyze only after parsing was performed."));
+
+	util::CompilationStatistics::Scope statisticsScope(m_collectStatistics ? &m_statistics : nullptr);
+	TypeProvider::Scope typeScope(*m_typeProvider);
+	util::CompilationStatistics::PhaseTimer timer("analysis");
+	util::CompilationStatistics::PhaseTimer passTimer("analysis/importResolution");
+
 	resolveImports();
 
 	for (Source const* source: m_sourceOrder)
@@ -336,16 +660,31 @@ bool CompilerStack::analyze()
 
 	try
 	{
-		SyntaxChecker syntaxChecker(m_errorReporter, m_optimiserSettings.runYulOptimiser);
-		for (Source const* source: m_sourceOrder)
-			if (source->ast && !syntaxChecker.checkSyntax(*source->ast))
-				noErrors = false;
-
-		DocStringTagParser docStringTagParser(m_errorReporter);
+		vector<ASTNode const*> sourceUnits;
 		for (Source const* source: m_sourceOrder)
-			if (source->ast && !docStringTagParser.parseDocStrings(*source->ast))
-				noErrors = false;
-
+			if (source->ast)
+				sourceUnits.push_back(source->ast.get());
+
+		// The syntax checker and the doc string tag parser are independent of each other,
+		// so they share a single traversal. The doc strings are only checked here, their
+		// contents are only parsed once documentation is requested.
+		passTimer.switchTo("analysis/syntaxCheckerAndDocStringTagParser");
+		m_documentationComplete = false;
+		ErrorList syntaxErrors;
+		ErrorList docStringErrors;
+		ErrorReporter syntaxErrorReporter(syntaxErrors, m_errorReporter);
+		ErrorReporter docStringErrorReporter(docStringErrors, m_errorReporter);
+		SyntaxChecker syntaxChecker(syntaxErrorReporter, m_optimiserSettings.runYulOptimiser);
+		DocStringTagParser docStringTagParser(docStringErrorReporter, true);
+		if (!runFusedPasses(
+			{{&syntaxChecker.visitor(), &syntaxErrors}, {&docStringTagParser.visitor(), &docStringErrors}},
+			sourceUnits,
+			m_errorReporter,
+			false
+		))
+			noErrors = false;
+
+		passTimer.switchTo("analysis/nameAndTypeResolution");
 		m_globalContext = make_shared<GlobalContext>();
 		// We need to keep the same resolver during the whole process.
 		NameAndTypeResolver resolver(*m_globalContext, m_evmVersion, m_errorReporter);
@@ -366,6 +705,7 @@ bool CompilerStack::analyze()
 			if (source->ast && !resolver.resolveNamesAndTypes(*source->ast))
 				return false;
 
+		passTimer.switchTo("analysis/declarationTypeChecker");
 		DeclarationTypeChecker declarationTypeChecker(m_errorReporter, m_evmVersion);
 		for (Source const* source: m_sourceOrder)
 			if (source->ast && !declarationTypeChecker.check(*source->ast))
@@ -375,6 +715,7 @@ bool CompilerStack::analyze()
 		// contract or function level.
 		// This also calculates whether a contract is abstract, which is needed by the
 		// type checker.
+		passTimer.switchTo("analysis/contractLevelChecker");
 		ContractLevelChecker contractLevelChecker(m_errorReporter);
 
 		for (Source const* source: m_sourceOrder)
@@ -382,7 +723,8 @@ bool CompilerStack::analyze()
 				noErrors = contractLevelChecker.check(*sourceAst);
 
 		// Requires ContractLevelChecker
-		DocStringAnalyser docStringAnalyser(m_errorReporter);
+		passTimer.switchTo("analysis/docStringAnalyser");
+		DocStringAnalyser docStringAnalyser(m_errorReporter, true);
 		for (Source const* source: m_sourceOrder)
 			if (source->ast && !docStringAnalyser.analyseDocStrings(*source->ast))
 				noErrors = false;
@@ -394,37 +736,16 @@ bool CompilerStack::analyze()
 		//
 		// Note: this does not resolve overloaded functions. In order to do that, types of arguments are needed,
 		// which is only done one step later.
+		passTimer.switchTo("analysis/typeChecker");
 		TypeChecker typeChecker(m_evmVersion, m_errorReporter);
 		for (Source const* source: m_sourceOrder)
 			if (source->ast && !typeChecker.checkTypeRequirements(*source->ast))
 				noErrors = false;
 
-		if (noErrors)
-		{
-			for (Source const* source: m_sourceOrder)
-				if (source->ast)
-					for (ASTPointer<ASTNode> const& node: source->ast->nodes())
-						if (auto const* contractDefinition = dynamic_cast<ContractDefinition*>(node.get()))
-						{
-							Contract& contractState = m_contracts.at(contractDefinition->fullyQualifiedName());
-
-							contractState.contract->annotation().creationCallGraph = make_unique<CallGraph>(
-								FunctionCallGraphBuilder::buildCreationGraph(
-									*contractDefinition
-								)
-							);
-							contractState.contract->annotation().deployedCallGraph = make_unique<CallGraph>(
-								FunctionCallGraphBuilder::buildDeployedGraph(
-									*contractDefinition,
-									**contractState.contract->annotation().creationCallGraph
-								)
-							);
-						}
-		}
-
 		if (noErrors)
 		{
 			// Checks that can only be done when all types of all AST nodes are known.
+			passTimer.switchTo("analysis/postTypeChecker");
 			PostTypeChecker postTypeChecker(m_errorReporter);
 			for (Source const* source: m_sourceOrder)
 				if (source->ast && !postTypeChecker.check(*source->ast))
@@ -436,16 +757,20 @@ bool CompilerStack::analyze()
 		// Check that immutable variables are never read in c'tors and assigned
 		// exactly once
 		if (noErrors)
+		{
+			passTimer.switchTo("analysis/immutableValidator");
 			for (Source const* source: m_sourceOrder)
 				if (source->ast)
 					for (ASTPointer<ASTNode> const& node: source->ast->nodes())
 						if (ContractDefinition* contract = dynamic_cast<ContractDefinition*>(node.get()))
 							ImmutableValidator(m_errorReporter, *contract).analyze();
+		}
 
 		if (noErrors)
 		{
 			// Control flow graph generator and analyzer. It can check for issues such as
 			// variable is used before it is assigned to.
+			passTimer.switchTo("analysis/controlFlowAnalyzer");
 			CFG cfg(m_errorReporter);
 			for (Source const* source: m_sourceOrder)
 				if (source->ast && !cfg.constructFlow(*source->ast))
@@ -462,32 +787,48 @@ bool CompilerStack::analyze()
 
 		if (noErrors)
 		{
-			// Checks for common mistakes. Only generates warnings.
-			StaticAnalyzer staticAnalyzer(m_errorReporter);
-			for (Source const* source: m_sourceOrder)
-				if (source->ast && !staticAnalyzer.analyze(*source->ast))
-					noErrors = false;
-		}
-
-		if (noErrors)
-		{
-			// Check for state mutability in every function.
+			// Checks for common mistakes and for the state mutability of every function.
+			// The state mutability is only checked if there are no errors in the first part,
+			// but both run in a single traversal.
+			passTimer.switchTo("analysis/staticAnalyzerAndViewPureChecker");
 			vector<ASTPointer<ASTNode>> ast;
 			for (Source const* source: m_sourceOrder)
 				if (source->ast)
 					ast.push_back(source->ast);
 
-			if (!ViewPureChecker(ast, m_errorReporter).check())
+			ErrorList staticAnalyzerErrors;
+			ErrorList viewPureErrors;
+			ErrorReporter staticAnalyzerErrorReporter(staticAnalyzerErrors, m_errorReporter);
+			ErrorReporter viewPureErrorReporter(viewPureErrors, m_errorReporter);
+			StaticAnalyzer staticAnalyzer(staticAnalyzerErrorReporter);
+			ViewPureChecker viewPureChecker(ast, viewPureErrorReporter);
+			if (!runFusedPasses(
+				{{&staticAnalyzer.visitor(), &staticAnalyzerErrors}, {&viewPureChecker.visitor(), &viewPureErrors}},
+				sourceUnits,
+				m_errorReporter,
+				true
+			))
 				noErrors = false;
 		}
 
 		if (noErrors)
 		{
-			ModelChecker modelChecker(m_errorReporter, m_smtlib2Responses, m_modelCheckerSettings, m_readFile, m_enabledSMTSolvers);
+			passTimer.switchTo("analysis/modelChecker");
+			ModelChecker modelChecker(
+				m_errorReporter,
+				*this,
+				m_smtlib2Responses,
+				m_modelCheckerSettings,
+				m_readFile,
+				m_enabledSMTSolvers,
+				m_parallelism
+			);
 			for (Source const* source: m_sourceOrder)
 				if (source->ast)
 					modelChecker.analyze(*source->ast);
 			m_unhandledSMTLib2Queries += modelChecker.unhandledQueries();
+			if (modelChecker.statistics())
+				m_modelCheckerStatistics = *modelChecker.statistics();
 		}
 	}
 	catch (FatalError const&)
@@ -554,71 +895,303 @@ bool CompilerStack::compile(State _stopAfter)
 	if (m_hasError)
 		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Called compile with errors."));
 
+	util::CompilationStatistics::Scope statisticsScope(m_collectStatistics ? &m_statistics : nullptr);
+	TypeProvider::Scope typeScope(*m_typeProvider);
+	util::CompilationStatistics::PhaseTimer timer("compilation");
+	m_inlineAssemblyCache = make_shared<InlineAssemblyCache>();
+	ScopeGuard releaseInlineAssemblyCache([&]() { m_inlineAssemblyCache.reset(); });
+	m_constantOptimisationCache = make_shared<evmasm::ConstantOptimisationCache>();
+	ScopeGuard releaseConstantOptimisationCache([&]() { m_constantOptimisationCache.reset(); });
+	m_evmObjectCache = make_shared<yul::EVMObjectCache>();
+	ScopeGuard releaseEVMObjectCache([&]() { m_evmObjectCache.reset(); });
+
+	if (!checkOptimisationProfiles())
+		return false;
 	// Only compile contracts individually which have been requested.
 	map<ContractDefinition const*, shared_ptr<Compiler const>> otherCompilers;
 
-	for (Source const* source: m_sourceOrder)
-		for (ASTPointer<ASTNode> const& node: source->ast->nodes())
-			if (auto contract = dynamic_cast<ContractDefinition const*>(node.get()))
-				if (isRequestedContract(*contract))
-				{
-					try
+	// The legacy code generator needs the compilers of the contracts a contract creates, but the
+	// cache only stores their bytecode. These contracts are therefore compiled instead of loaded
+	// from the cache, because they would be compiled again for the contract creating them.
+	set<ContractDefinition const*> legacyDependencies;
+	if (m_compilationCache && m_generateEvmBytecode)
+	{
+		vector<ContractDefinition const*> pending;
+		for (Source const* source: m_sourceOrder)
+			for (ASTPointer<ASTNode> const& node: source->ast->nodes())
+				if (auto contract = dynamic_cast<ContractDefinition const*>(node.get()))
+					if (isRequestedContract(*contract) && !viaIR(*contract))
+						pending.push_back(contract);
+		while (!pending.empty())
+		{
+			ContractDefinition const* contract = pending.back();
+			pending.pop_back();
+			for (ContractDefinition const* dependency: contract->annotation().contractDependencies)
+				if (legacyDependencies.insert(dependency).second)
+					pending.push_back(dependency);
+		}
+	}
+
+	// Generating code from the optimized IR only requires the IR of the contract itself,
+	// which already contains the IR of all contracts it creates. It is therefore run as
+	// a separate job, concurrently with the jobs of other contracts and with the remaining
+	// code generation on this thread. The errors of a job are inserted where they would
+	// have been reported when compiling serially.
+	struct CodeGenerationJob
+	{
+		ContractDefinition const* contract = nullptr;
+		size_t errorPosition = 0;
+		ErrorList errors;
+		exception_ptr exception;
+	};
+	list<CodeGenerationJob> jobs;
+	util::ThreadPool threadPool(m_parallelism);
+	// Compiling serially stops at the first job that fails, so neither the errors of the jobs
+	// submitted after it nor those reported on this thread after it was submitted are kept.
+	// @returns the exception of the first failed job.
+	auto mergeJobErrors = [&]() -> exception_ptr {
+		auto failed = find_if(jobs.begin(), jobs.end(), [](CodeGenerationJob const& _job) { return !!_job.exception; });
+		if (failed != jobs.end())
+		{
+			m_errorList.erase(m_errorList.begin() + static_cast<ptrdiff_t>(failed->errorPosition), m_errorList.end());
+			jobs.erase(next(failed), jobs.end());
+		}
+		for (auto job = jobs.rbegin(); job != jobs.rend(); ++job)
+			m_errorList.insert(
+				m_errorList.begin() + static_cast<ptrdiff_t>(job->errorPosition),
+				job->errors.begin(),
+				job->errors.end()
+			);
+		return failed != jobs.end() ? failed->exception : nullptr;
+	};
+
+	try
+	{
+		for (Source const* source: m_sourceOrder)
+			for (ASTPointer<ASTNode> const& node: source->ast->nodes())
+				if (auto contract = dynamic_cast<ContractDefinition const*>(node.get()))
+					if (isRequestedContract(*contract))
 					{
-						if (m_viaIR || m_generateIR || m_generateEwasm)
+						if (!legacyDependencies.count(contract) && loadFromCache(*contract))
+							continue;
+						bool const compileViaIR = viaIR(*contract);
+						if (compileViaIR || m_generateIR || m_generateEwasm)
 							generateIR(*contract);
-						if (m_generateEvmBytecode)
-						{
-							if (m_viaIR)
-								generateEVMFromIR(*contract);
-							else
-								compileContract(*contract, otherCompilers);
-						}
-						if (m_generateEwasm)
-							generateEwasm(*contract);
-					}
-					catch (Error const& _error)
-					{
-						if (_error.type() != Error::Type::CodeGenerationError)
-							throw;
-						m_errorReporter.error(_error.errorId(), _error.type(), SourceLocation(), _error.what());
-						return false;
-					}
-					catch (UnimplementedFeatureError const& _unimplementedError)
-					{
-						if (
-							SourceLocation const* sourceLocation =
-							boost::get_error_info<langutil::errinfo_sourceLocation>(_unimplementedError)
-						)
+						if (m_generateEvmBytecode && !compileViaIR)
+							compileContract(*contract, otherCompilers);
+
+						bool const evmFromIR = m_generateEvmBytecode && compileViaIR;
+						if (evmFromIR || m_generateEwasm)
 						{
-							string const* comment = _unimplementedError.comment();
-							m_errorReporter.error(
-								1834_error,
-								Error::Type::CodeGenerationError,
-								*sourceLocation,
-								"Unimplemented feature error" +
-								((comment && !comment->empty()) ? ": " + *comment : string{}) +
-								" in " +
-								_unimplementedError.lineInfo()
-							);
-							return false;
+							CodeGenerationJob& job = jobs.emplace_back();
+							job.contract = contract;
+							job.errorPosition = m_errorList.size();
+							threadPool.submit([this, &job, evmFromIR]() {
+								TypeProvider::Scope typeScope(*m_typeProvider);
+								ErrorReporter errorReporter(job.errors);
+								try
+								{
+									if (evmFromIR)
+										generateEVMFromIR(*job.contract, errorReporter);
+									if (m_generateEwasm)
+										generateEwasm(*job.contract);
+								}
+								catch (...)
+								{
+									job.exception = current_exception();
+								}
+							});
 						}
-						else
-							throw;
 					}
-				}
+	}
+	catch (...)
+	{
+		exception_ptr exception = current_exception();
+		threadPool.wait();
+		// Jobs submitted earlier would have failed first when compiling serially.
+		if (exception_ptr jobException = mergeJobErrors())
+			exception = jobException;
+		reportCodeGenerationError(exception);
+		return false;
+	}
+
+	threadPool.wait();
+	if (exception_ptr exception = mergeJobErrors())
+	{
+		reportCodeGenerationError(exception);
+		return false;
+	}
+	storeInCache();
+
 	m_stackState = CompilationSuccessful;
 	this->link();
 	return true;
 }
 
+h256 CompilerStack::cacheKey(Contract const& _contract) const
+{
+	Json::Value key{Json::objectValue};
+	key["metadata"] = metadata(_contract);
+	// Source mappings refer to sources by index.
+	key["sourceIndices"] = Json::objectValue;
+	for (auto const& [name, index]: sourceIndices())
+		key["sourceIndices"][name] = index;
+	key["evmBytecode"] = m_generateEvmBytecode;
+	key["ir"] = m_generateIR;
+	return util::keccak256(util::jsonCompactPrint(key));
+}
+
+bool CompilerStack::loadFromCache(ContractDefinition const& _contract)
+{
+	if (
+		!m_compilationCache ||
+		m_generateEwasm ||
+		!_contract.canBeDeployed() ||
+		optimiserSettings(_contract).yulOptimiserTimeBudget
+	)
+		return false;
+
+	Contract& compiledContract = m_contracts.at(_contract.fullyQualifiedName());
+	optional<CompilationCache::Artifacts> artifacts = m_compilationCache->load(cacheKey(compiledContract));
+	if (!artifacts)
+		return false;
+
+	compiledContract.object = move(artifacts->object);
+	compiledContract.runtimeObject = move(artifacts->runtimeObject);
+	if (artifacts->sourceMapping)
+		compiledContract.sourceMapping.emplace(move(*artifacts->sourceMapping));
+	if (artifacts->runtimeSourceMapping)
+		compiledContract.runtimeSourceMapping.emplace(move(*artifacts->runtimeSourceMapping));
+	compiledContract.yulIR = move(artifacts->yulIR);
+	compiledContract.yulIROptimized = move(artifacts->yulIROptimized);
+	compiledContract.loadedFromCache = true;
+
+	if (viaIR(_contract) || m_generateIR)
+		checkABICoderForIR(_contract);
+	checkCodeSize(compiledContract, viaIR(_contract) ? 9609_error : 5574_error, m_errorReporter);
+	return true;
+}
+
+void CompilerStack::storeInCache()
+{
+	if (!m_compilationCache || m_generateEwasm)
+		return;
+
+	for (auto& [name, compiledContract]: m_contracts)
+	{
+		if (
+			compiledContract.loadedFromCache ||
+			!isRequestedContract(*compiledContract.contract) ||
+			!compiledContract.contract->canBeDeployed() ||
+			optimiserSettings(*compiledContract.contract).yulOptimiserTimeBudget
+		)
+			continue;
+
+		CompilationCache::Artifacts artifacts;
+		artifacts.object = compiledContract.object;
+		artifacts.runtimeObject = compiledContract.runtimeObject;
+		if (compiledContract.evmAssembly && compiledContract.evmRuntimeAssembly)
+		{
+			if (!compiledContract.sourceMapping)
+				compiledContract.sourceMapping.emplace(
+					evmasm::AssemblyItem::computeSourceMapping(compiledContract.evmAssembly->items(), sourceIndices())
+				);
+			if (!compiledContract.runtimeSourceMapping)
+				compiledContract.runtimeSourceMapping.emplace(
+					evmasm::AssemblyItem::computeSourceMapping(compiledContract.evmRuntimeAssembly->items(), sourceIndices())
+				);
+			artifacts.sourceMapping = *compiledContract.sourceMapping;
+			artifacts.runtimeSourceMapping = *compiledContract.runtimeSourceMapping;
+		}
+		artifacts.yulIR = compiledContract.yulIR;
+		artifacts.yulIROptimized = compiledContract.yulIROptimized;
+		m_compilationCache->store(cacheKey(compiledContract), artifacts);
+	}
+}
+
+void CompilerStack::resetOptimisedCodeCache()
+{
+	optional<boost::filesystem::path> directory;
+	if (m_compilationCache)
+		directory = m_compilationCache->directory() / "yul";
+	m_optimisedCodeCache = make_shared<yul::OptimisedCodeCache>(string(VersionString), move(directory));
+}
+
+void CompilerStack::checkABICoderForIR(ContractDefinition const& _contract)
+{
+	if (!*_contract.sourceUnit().annotation().useABICoderV2)
+		m_errorReporter.warning(
+			2066_error,
+			_contract.location(),
+			"Contract requests the ABI coder v1, which is incompatible with the IR. "
+			"Using ABI coder v2 instead."
+		);
+}
+
+void CompilerStack::checkCodeSize(Contract const& _contract, ErrorId _error, ErrorReporter& _errorReporter) const
+{
+	// Throw a warning if EIP-170 limits are exceeded:
+	//   If contract creation returns data with length greater than 0x6000 (214 + 213) bytes,
+	//   contract creation fails with an out of gas error.
+	if (
+		m_evmVersion >= langutil::EVMVersion::spuriousDragon() &&
+		_contract.runtimeObject.bytecode.size() > 0x6000
+	)
+		_errorReporter.warning(
+			_error,
+			_contract.contract->location(),
+			"Contract code size exceeds 24576 bytes (a limit introduced in Spurious Dragon). "
+			"This contract may not be deployable on mainnet. "
+			"Consider enabling the optimizer (with a low \"runs\" value!), "
+			"turning off revert strings, or using libraries."
+		);
+}
+
+void CompilerStack::reportCodeGenerationError(exception_ptr const& _exception)
+{
+	try
+	{
+		rethrow_exception(_exception);
+	}
+	catch (Error const& _error)
+	{
+		if (_error.type() != Error::Type::CodeGenerationError)
+			throw;
+		m_errorReporter.error(_error.errorId(), _error.type(), SourceLocation(), _error.what());
+	}
+	catch (UnimplementedFeatureError const& _unimplementedError)
+	{
+		if (
+			SourceLocation const* sourceLocation =
+			boost::get_error_info<langutil::errinfo_sourceLocation>(_unimplementedError)
+		)
+		{
+			string const* comment = _unimplementedError.comment();
+			m_errorReporter.error(
+				1834_error,
+				Error::Type::CodeGenerationError,
+				*sourceLocation,
+				"Unimplemented feature error" +
+				((comment && !comment->empty()) ? ": " + *comment : string{}) +
+				" in " +
+				_unimplementedError.lineInfo()
+			);
+		}
+		else
+			throw;
+	}
+}
+
 void CompilerStack::link()
 {
 	solAssert(m_stackState >= CompilationSuccessful, "");
+	vector<evmasm::LinkerObject*> objects;
 	for (auto& contract: m_contracts)
 	{
-		contract.second.object.link(m_libraries);
-		contract.second.runtimeObject.link(m_libraries);
+		objects.push_back(&contract.second.object);
+		objects.push_back(&contract.second.runtimeObject);
 	}
+	evmasm::LinkerObject::link(objects, m_libraries);
 }
 
 vector<string> CompilerStack::contractNames() const
@@ -638,12 +1211,21 @@ string const CompilerStack::lastContractName() const
 	// try to find some user-supplied contract
 	string contractName;
 	for (auto const& it: m_sources)
-		for (ASTPointer<ASTNode> const& node: it.second.ast->nodes())
-			if (auto contract = dynamic_cast<ContractDefinition const*>(node.get()))
-				contractName = contract->fullyQualifiedName();
+		if (it.second.ast)
+			for (ASTPointer<ASTNode> const& node: it.second.ast->nodes())
+				if (auto contract = dynamic_cast<ContractDefinition const*>(node.get()))
+					contractName = contract->fullyQualifiedName();
 	return contractName;
 }
 
+shared_ptr<evmasm::Assembly const> CompilerStack::evmAssembly(string const& _contractName) const
+{
+	if (m_stackState != CompilationSuccessful)
+		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Compilation was not successful."));
+
+	return contract(_contractName).evmAssembly;
+}
+
 evmasm::AssemblyItems const* CompilerStack::assemblyItems(string const& _contractName) const
 {
 	if (m_stackState != CompilationSuccessful)
@@ -685,7 +1267,7 @@ Json::Value CompilerStack::generatedSources(string const& _contractName, bool _r
 			if (!source.empty())
 			{
 				string sourceName = CompilerContext::yulUtilityFileName();
-				unsigned sourceIndex = sourceIndices()[sourceName];
+				unsigned sourceIndex = sourceIndices().at(sourceName);
 				ErrorList errors;
 				ErrorReporter errorReporter(errors);
 				auto scanner = make_shared<langutil::Scanner>(langutil::CharStream(source, sourceName));
@@ -740,12 +1322,15 @@ std::string const CompilerStack::filesystemFriendlyName(string const& _contractN
 		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("No compiled contracts found."));
 
 	// Look up the contract (by its fully-qualified name)
-	Contract const& matchContract = m_contracts.at(_contractName);
+	Contract const& matchContract = contract(_contractName);
 	// Check to see if it could collide on name
 	for (auto const& contract: m_contracts)
 	{
-		if (contract.second.contract->name() == matchContract.contract->name() &&
-				contract.second.contract != matchContract.contract)
+		if (
+			!contract.second.released &&
+			contract.second.contract->name() == matchContract.contract->name() &&
+			contract.second.contract != matchContract.contract
+		)
 		{
 			// If it does, then return its fully-qualified name, made fs-friendly
 			std::string friendlyName = boost::algorithm::replace_all_copy(_contractName, "/", "_");
@@ -819,6 +1404,16 @@ string CompilerStack::assemblyString(string const& _contractName, StringMap _sou
 		return string();
 }
 
+void CompilerStack::assemblyStream(ostream& _out, string const& _contractName, StringMap const& _sourceCodes) const
+{
+	if (m_stackState != CompilationSuccessful)
+		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Compilation was not successful."));
+
+	Contract const& currentContract = contract(_contractName);
+	if (currentContract.evmAssembly)
+		currentContract.evmAssembly->assemblyStream(_out, "", _sourceCodes);
+}
+
 /// TODO: cache the JSON
 Json::Value CompilerStack::assemblyJSON(string const& _contractName) const
 {
@@ -832,6 +1427,16 @@ Json::Value CompilerStack::assemblyJSON(string const& _contractName) const
 		return Json::Value();
 }
 
+void CompilerStack::assemblyJSON(string const& _contractName, util::JsonWriter& _writer) const
+{
+	if (m_stackState != CompilationSuccessful)
+		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Compilation was not successful."));
+
+	Contract const& currentContract = contract(_contractName);
+	if (currentContract.evmAssembly)
+		currentContract.evmAssembly->assemblyJSON(_writer, sourceIndices());
+}
+
 vector<string> CompilerStack::sourceNames() const
 {
 	vector<string> names;
@@ -840,15 +1445,12 @@ vector<string> CompilerStack::sourceNames() const
 	return names;
 }
 
-map<string, unsigned> CompilerStack::sourceIndices() const
+map<string, unsigned> const& CompilerStack::sourceIndices() const
 {
-	map<string, unsigned> indices;
-	unsigned index = 0;
-	for (auto const& s: m_sources)
-		indices[s.first] = index++;
-	solAssert(!indices.count(CompilerContext::yulUtilityFileName()), "");
-	indices[CompilerContext::yulUtilityFileName()] = index++;
-	return indices;
+	if (m_stackState < Parsed)
+		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Parsing was not successful."));
+
+	return m_sourceIndices;
 }
 
 Json::Value const& CompilerStack::contractABI(string const& _contractName) const
@@ -866,6 +1468,7 @@ Json::Value const& CompilerStack::contractABI(Contract const& _contract) const
 
 	solAssert(_contract.contract, "");
 
+	TypeProvider::Scope typeScope(*m_typeProvider);
 	return _contract.abi.init([&]{ return ABI::generate(*_contract.contract); });
 }
 
@@ -884,6 +1487,7 @@ Json::Value const& CompilerStack::storageLayout(Contract const& _contract) const
 
 	solAssert(_contract.contract, "");
 
+	TypeProvider::Scope typeScope(*m_typeProvider);
 	return _contract.storageLayout.init([&]{ return StorageLayout().generate(*_contract.contract); });
 }
 
@@ -902,6 +1506,8 @@ Json::Value const& CompilerStack::natspecUser(Contract const& _contract) const
 
 	solAssert(_contract.contract, "");
 
+	completeDocumentation();
+	TypeProvider::Scope typeScope(*m_typeProvider);
 	return _contract.userDocumentation.init([&]{ return Natspec::userDocumentation(*_contract.contract); });
 }
 
@@ -920,14 +1526,44 @@ Json::Value const& CompilerStack::natspecDev(Contract const& _contract) const
 
 	solAssert(_contract.contract, "");
 
+	completeDocumentation();
+	TypeProvider::Scope typeScope(*m_typeProvider);
 	return _contract.devDocumentation.init([&]{ return Natspec::devDocumentation(*_contract.contract); });
 }
 
+void CompilerStack::completeDocumentation() const
+{
+	// The documentation is stored in the shared ASTs.
+	if (m_analysis)
+	{
+		m_analysis->completeDocumentation();
+		return;
+	}
+
+	lock_guard<mutex> lock(m_documentationMutex);
+	if (m_documentationComplete)
+		return;
+
+	// The errors have already been reported by the analysis.
+	ErrorList errors;
+	ErrorReporter errorReporter(errors);
+	DocStringTagParser docStringTagParser(errorReporter);
+	DocStringAnalyser docStringAnalyser(errorReporter);
+	for (Source const* source: m_sourceOrder)
+		if (source->ast)
+			docStringTagParser.parseDocStrings(*source->ast);
+	for (Source const* source: m_sourceOrder)
+		if (source->ast)
+			docStringAnalyser.analyseDocStrings(*source->ast);
+	m_documentationComplete = true;
+}
+
 Json::Value CompilerStack::methodIdentifiers(string const& _contractName) const
 {
 	if (m_stackState < AnalysisPerformed)
 		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Analysis was not successful."));
 
+	TypeProvider::Scope typeScope(*m_typeProvider);
 	Json::Value methodIdentifiers(Json::objectValue);
 	for (auto const& it: contractDefinition(_contractName).interfaceFunctions())
 		methodIdentifiers[it.second->externalSignature()] = it.first.hex();
@@ -950,6 +1586,62 @@ bytes CompilerStack::cborMetadata(string const& _contractName) const
 	return createCBORMetadata(contract(_contractName));
 }
 
+string CompilerStack::metadataWithSourceNames(string const& _contractName) const
+{
+	if (m_stackState < AnalysisPerformed)
+		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Analysis was not successful."));
+
+	Contract const& c = contract(_contractName);
+	solAssert(c.contract, "");
+	TypeProvider::Scope typeScope(*m_typeProvider);
+	return createMetadata(c, true);
+}
+
+set<string> CompilerStack::metadataSourceNames(string const& _contractName) const
+{
+	if (m_stackState < AnalysisPerformed)
+		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Analysis was not successful."));
+
+	Contract const& c = contract(_contractName);
+	solAssert(c.contract, "");
+	return referableSources(*c.contract);
+}
+
+string const& CompilerStack::metadataSourceEntry(string const& _sourceName) const
+{
+	if (m_stackState < AnalysisPerformed)
+		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Analysis was not successful."));
+
+	{
+		lock_guard<mutex> lock(sourceHashMutex());
+		auto entry = m_metadataSourceEntries.find(_sourceName);
+		if (entry != m_metadataSourceEntries.end())
+			return entry->second;
+	}
+
+	Source const& s = source(_sourceName);
+	solAssert(s.scanner, "Scanner not available");
+	Json::Value entry;
+	entry["keccak256"] = "0x" + toHex(s.keccak256().asBytes());
+	if (optional<string> licenseString = s.ast->licenseString())
+		entry["license"] = *licenseString;
+	if (m_metadataLiteralSources)
+	{
+		string_view content = s.scanner->source();
+		entry["content"] = Json::Value(content.data(), content.data() + content.size());
+	}
+	else
+	{
+		entry["urls"] = Json::arrayValue;
+		entry["urls"].append("bzz-raw://" + toHex(s.swarmHash().asBytes()));
+		entry["urls"].append(s.ipfsUrl());
+	}
+	string serialized = util::jsonCompactPrint(entry);
+
+	lock_guard<mutex> lock(sourceHashMutex());
+	return m_metadataSourceEntries.emplace(_sourceName, move(serialized)).first->second;
+}
+
 string const& CompilerStack::metadata(Contract const& _contract) const
 {
 	if (m_stackState < AnalysisPerformed)
@@ -957,6 +1649,7 @@ string const& CompilerStack::metadata(Contract const& _contract) const
 
 	solAssert(_contract.contract, "");
 
+	TypeProvider::Scope typeScope(*m_typeProvider);
 	return _contract.metadata.init([&]{ return createMetadata(_contract); });
 }
 
@@ -968,16 +1661,35 @@ Scanner const& CompilerStack::scanner(string const& _sourceName) const
 	return *source(_sourceName).scanner;
 }
 
+CharStream const* CompilerStack::charStream(string const& _sourceName) const
+{
+	if (m_importedSources)
+		return nullptr;
+	auto source = m_sources.find(_sourceName);
+	if (source == m_sources.end() || !source->second.scanner)
+		return nullptr;
+	return source->second.scanner->charStream().get();
+}
+
 SourceUnit const& CompilerStack::ast(string const& _sourceName) const
 {
 	if (m_stackState < Parsed)
 		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Parsing not yet performed."));
-	if (!source(_sourceName).ast && !m_parserErrorRecovery)
+	if (source(_sourceName).astReleased)
+		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("AST of \"" + _sourceName + "\" has been released."));
+	if (!source(_sourceName).ast)
 		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Parsing was not successful."));
 
 	return *source(_sourceName).ast;
 }
 
+ASTNodeIndex const& CompilerStack::astNodeIndex() const
+{
+	if (m_stackState < Parsed)
+		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Parsing not yet performed."));
+	return m_astNodeIndex;
+}
+
 ContractDefinition const& CompilerStack::contractDefinition(string const& _contractName) const
 {
 	if (m_stackState < AnalysisPerformed)
@@ -986,6 +1698,22 @@ ContractDefinition const& CompilerStack::contractDefinition(string const& _contr
 	return *contract(_contractName).contract;
 }
 
+CallGraph const& CompilerStack::creationCallGraph(string const& _contractName) const
+{
+	ContractDefinition const& contract = contractDefinition(_contractName);
+	TypeProvider::Scope typeScope(*m_typeProvider);
+	buildCallGraphs(contract);
+	return **contract.annotation().creationCallGraph;
+}
+
+CallGraph const& CompilerStack::deployedCallGraph(string const& _contractName) const
+{
+	ContractDefinition const& contract = contractDefinition(_contractName);
+	TypeProvider::Scope typeScope(*m_typeProvider);
+	buildCallGraphs(contract);
+	return **contract.annotation().deployedCallGraph;
+}
+
 size_t CompilerStack::functionEntryPoint(
 	std::string const& _contractName,
 	FunctionDefinition const& _function
@@ -997,6 +1725,7 @@ size_t CompilerStack::functionEntryPoint(
 	shared_ptr<Compiler> const& compiler = contract(_contractName).compiler;
 	if (!compiler)
 		return 0;
+	TypeProvider::Scope typeScope(*m_typeProvider);
 	evmasm::AssemblyItem tag = compiler->functionEntryLabel(_function);
 	if (tag.type() == evmasm::UndefinedItem)
 		return 0;
@@ -1009,35 +1738,57 @@ size_t CompilerStack::functionEntryPoint(
 
 tuple<int, int, int, int> CompilerStack::positionFromSourceLocation(SourceLocation const& _sourceLocation) const
 {
-	int startLine;
-	int startColumn;
-	int endLine;
-	int endColumn;
-	tie(startLine, startColumn) = scanner(_sourceLocation.source->name()).translatePositionToLineColumn(_sourceLocation.start);
-	tie(endLine, endColumn) = scanner(_sourceLocation.source->name()).translatePositionToLineColumn(_sourceLocation.end);
+	auto lineColumns = scanner(*_sourceLocation.sourceName).charStream()->translatePositionsToLineColumns(
+		{_sourceLocation.start, _sourceLocation.end}
+	);
+	auto [startLine, startColumn] = lineColumns[0];
+	auto [endLine, endColumn] = lineColumns[1];
 
 	return make_tuple(++startLine, ++startColumn, ++endLine, ++endColumn);
 }
 
 
+// The hashes are computed without holding the lock, so that different sources can be hashed
+// concurrently. Once stored, a hash is not modified anymore and can be read without the lock.
 h256 const& CompilerStack::Source::keccak256() const
 {
+	{
+		lock_guard<mutex> lock(sourceHashMutex());
+		if (keccak256HashCached != h256{})
+			return keccak256HashCached;
+	}
+	h256 hash = util::keccak256(scanner->charStream()->buffer().ref());
+	lock_guard<mutex> lock(sourceHashMutex());
 	if (keccak256HashCached == h256{})
-		keccak256HashCached = util::keccak256(scanner->source());
+		keccak256HashCached = hash;
 	return keccak256HashCached;
 }
 
 h256 const& CompilerStack::Source::swarmHash() const
 {
+	{
+		lock_guard<mutex> lock(sourceHashMutex());
+		if (swarmHashCached != h256{})
+			return swarmHashCached;
+	}
+	h256 hash = util::bzzr1Hash(scanner->charStream()->buffer().ref());
+	lock_guard<mutex> lock(sourceHashMutex());
 	if (swarmHashCached == h256{})
-		swarmHashCached = util::bzzr1Hash(scanner->source());
+		swarmHashCached = hash;
 	return swarmHashCached;
 }
 
 string const& CompilerStack::Source::ipfsUrl() const
 {
+	{
+		lock_guard<mutex> lock(sourceHashMutex());
+		if (!ipfsUrlCached.empty())
+			return ipfsUrlCached;
+	}
+	string url = "dweb:/ipfs/" + util::ipfsHashBase58(scanner->source());
+	lock_guard<mutex> lock(sourceHashMutex());
 	if (ipfsUrlCached.empty())
-		ipfsUrlCached = "dweb:/ipfs/" + util::ipfsHashBase58(scanner->source());
+		ipfsUrlCached = move(url);
 	return ipfsUrlCached;
 }
 
@@ -1063,10 +1814,13 @@ StringMap CompilerStack::loadMissingSources(SourceUnit const& _ast, std::string
 
 				ReadCallback::Result result{false, string("File not supplied initially.")};
 				if (m_readFile)
+				{
+					util::Tracer::Span span("readCallback", "readFile", importPath);
 					result = m_readFile(ReadCallback::kindString(ReadCallback::Kind::ReadFile), importPath);
+				}
 
 				if (result.success)
-					newSources[importPath] = result.responseOrErrorMessage;
+					newSources[importPath] = std::move(result.responseOrErrorMessage);
 				else
 				{
 					m_errorReporter.parserError(
@@ -1085,46 +1839,77 @@ StringMap CompilerStack::loadMissingSources(SourceUnit const& _ast, std::string
 	return newSources;
 }
 
+bool CompilerStack::reuseParsedSource(string const& _path, Source& _source, ASTPointer<Block>& _reparsedBody, int64_t& _maxID)
+{
+	auto previous = m_previousSources.find(_path);
+	if (previous == m_previousSources.end())
+		return false;
+	// Inline assembly is parsed differently for different EVM versions.
+	if (m_evmVersion != m_previousSourcesEVMVersion)
+		return false;
+	// The identifiers in inline assembly blocks are invalid after the Yul string repository was reset.
+	if (yul::YulStringRepository::generation() != m_previousSourcesYulStringGeneration)
+		return false;
+	// The names in the AST are invalid after the symbol table was reset.
+	if (Symbol::generation() != m_previousSourcesSymbolGeneration)
+		return false;
+
+	string_view const oldText = previous->second.scanner->source();
+	string_view const newText = _source.scanner->source();
+	bool reused = oldText == newText;
+	if (reused)
+		_source = move(previous->second);
+	else
+	{
+		// Find the changed part as the text between the common prefix and the common suffix.
+		size_t const commonLength = min(oldText.size(), newText.size());
+		size_t prefix = 0;
+		while (prefix < commonLength && oldText[prefix] == newText[prefix])
+			++prefix;
+		size_t suffix = 0;
+		while (suffix < commonLength - prefix && oldText[oldText.size() - 1 - suffix] == newText[newText.size() - 1 - suffix])
+			++suffix;
+		int const editStart = static_cast<int>(prefix);
+
+		// The locations of the warnings after the edit would be outdated.
+		ErrorList& warnings = previous->second.parserErrors;
+		bool const warningsBeforeEdit = all_of(warnings.begin(), warnings.end(), [&](shared_ptr<Error const> const& _warning) {
+			SourceLocation const* location = boost::get_error_info<errinfo_sourceLocation>(*_warning);
+			return !location || location->start < 0 || location->end <= editStart;
+		});
+		if (warningsBeforeEdit)
+		{
+			util::Tracer::Span span("parsing", "reparse body", _path);
+			ErrorList errors;
+			ErrorReporter errorReporter(errors);
+			Parser parser{errorReporter, m_evmVersion};
+			_reparsedBody = parser.reparseBody(
+				*previous->second.ast,
+				_source.scanner,
+				editStart,
+				static_cast<int>(oldText.size() - suffix),
+				static_cast<int>(newText.size() - suffix)
+			);
+			if (_reparsedBody)
+			{
+				_source.ast = move(previous->second.ast);
+				_source.parserErrors = std::move(warnings);
+				_source.parserErrors += std::move(errors);
+				_maxID = parser.maxID();
+				reused = true;
+			}
+		}
+	}
+	if (reused)
+		AnnotationRemover{*_source.ast};
+	m_previousSources.erase(previous);
+	return reused;
+}
+
 string CompilerStack::applyRemapping(string const& _path, string const& _context)
 {
 	solAssert(m_stackState < ParsedAndImported, "");
-	// Try to find the longest prefix match in all remappings that are active in the current context.
-	auto isPrefixOf = [](string const& _a, string const& _b)
-	{
-		if (_a.length() > _b.length())
-			return false;
-		return std::equal(_a.begin(), _a.end(), _b.begin());
-	};
-
-	size_t longestPrefix = 0;
-	size_t longestContext = 0;
-	string bestMatchTarget;
-
-	for (auto const& redir: m_remappings)
-	{
-		string context = util::sanitizePath(redir.context);
-		string prefix = util::sanitizePath(redir.prefix);
-
-		// Skip if current context is closer
-		if (context.length() < longestContext)
-			continue;
-		// Skip if redir.context is not a prefix of _context
-		if (!isPrefixOf(context, _context))
-			continue;
-		// Skip if we already have a closer prefix match.
-		if (prefix.length() < longestPrefix && context.length() == longestContext)
-			continue;
-		// Skip if the prefix does not match.
-		if (!isPrefixOf(prefix, _path))
-			continue;
-
-		longestContext = context.length();
-		longestPrefix = prefix.length();
-		bestMatchTarget = util::sanitizePath(redir.target);
-	}
-	string path = bestMatchTarget;
-	path.append(_path.begin() + static_cast<string::difference_type>(longestPrefix), _path.end());
-	return path;
+	return m_remappingIndex.apply(_path, _context);
 }
 
 void CompilerStack::resolveImports()
@@ -1177,6 +1962,25 @@ void CompilerStack::storeContractDefinitions()
 			}
 }
 
+void CompilerStack::indexASTNodes()
+{
+	vector<SourceUnit const*> sourceUnits;
+	for (auto const& source: m_sources)
+		if (source.second.ast)
+			sourceUnits.push_back(source.second.ast.get());
+	m_astNodeIndex = ASTNodeIndex(sourceUnits);
+}
+
+void CompilerStack::storeSourceIndices()
+{
+	m_sourceIndices.clear();
+	unsigned index = 0;
+	for (auto const& s: m_sources)
+		m_sourceIndices[s.first] = index++;
+	solAssert(!m_sourceIndices.count(CompilerContext::yulUtilityFileName()), "");
+	m_sourceIndices[CompilerContext::yulUtilityFileName()] = index++;
+}
+
 namespace
 {
 bool onlySafeExperimentalFeaturesActivated(set<ExperimentalFeature> const& features)
@@ -1188,6 +1992,92 @@ bool onlySafeExperimentalFeaturesActivated(set<ExperimentalFeature> const& featu
 }
 }
 
+OptimiserSettings const& CompilerStack::optimiserSettings(ContractDefinition const& _contract) const
+{
+	auto profile = m_optimisationProfiles.find(_contract.fullyQualifiedName());
+	if (profile != m_optimisationProfiles.end() && profile->second.optimiserSettings)
+		return *profile->second.optimiserSettings;
+	return m_optimiserSettings;
+}
+
+OptimiserSettings CompilerStack::irOptimiserSettings(ContractDefinition const& _contract) const
+{
+	OptimiserSettings settings = optimiserSettings(_contract);
+	// The IR of a contract contains the functions in its call graphs and the code of the contracts it creates.
+	set<ContractDefinition const*, ASTNode::CompareByID> visited;
+	vector<ContractDefinition const*> contracts{&_contract};
+	while (!contracts.empty())
+	{
+		ContractDefinition const* contract = contracts.back();
+		contracts.pop_back();
+		if (!visited.insert(contract).second || !contract->annotation().creationCallGraph.set())
+			continue;
+		for (CallGraph const* graph: {
+			contract->annotation().creationCallGraph->get(),
+			contract->annotation().deployedCallGraph->get()
+		})
+		{
+			auto addFunction = [&](CallGraph::Node const& _node) {
+				if (auto const* callable = get_if<CallableDeclaration const*>(&_node))
+					if (auto const* function = dynamic_cast<FunctionDefinition const*>(*callable))
+						if (function->annotation().noInline)
+						{
+							settings.yulNoInlineFunctions.insert(IRNames::function(*function));
+							settings.yulNoInlineFunctions.insert(IRNames::functionWithModifierInner(*function));
+						}
+			};
+			for (auto const& [caller, callees]: graph->edges)
+			{
+				addFunction(caller);
+				for (CallGraph::Node const& callee: callees)
+					addFunction(callee);
+			}
+			contracts.insert(contracts.end(), graph->createdContracts.begin(), graph->createdContracts.end());
+		}
+	}
+	return settings;
+}
+
+bool CompilerStack::viaIR(ContractDefinition const& _contract) const
+{
+	auto profile = m_optimisationProfiles.find(_contract.fullyQualifiedName());
+	if (profile != m_optimisationProfiles.end() && profile->second.viaIR)
+		return *profile->second.viaIR;
+	return m_viaIR;
+}
+
+bool CompilerStack::checkOptimisationProfiles()
+{
+	for (auto const& [name, profile]: m_optimisationProfiles)
+		if (!m_contracts.count(name))
+			m_errorReporter.warning(
+				4812_error,
+				"Optimisation profile of unknown contract \"" + name + "\" is ignored."
+			);
+
+	// The code of a created contract is part of the code of the creating contract, which
+	// could otherwise not be reproduced from the settings in its metadata.
+	bool success = true;
+	for (auto const& [name, contract]: m_contracts)
+		if (isRequestedContract(*contract.contract))
+			for (ContractDefinition const* dependency: contract.contract->annotation().contractDependencies)
+				if (
+					viaIR(*contract.contract) != viaIR(*dependency) ||
+					!(optimiserSettings(*contract.contract) == optimiserSettings(*dependency))
+				)
+				{
+					m_errorReporter.error(
+						7264_error,
+						Error::Type::CodeGenerationError,
+						contract.contract->location(),
+						"Contract \"" + name + "\" creates contract \"" + dependency->fullyQualifiedName() +
+						"\", which has a different optimisation profile."
+					);
+					success = false;
+				}
+	return success;
+}
+
 void CompilerStack::compileContract(
 	ContractDefinition const& _contract,
 	map<ContractDefinition const*, shared_ptr<Compiler const>>& _otherCompilers
@@ -1208,7 +2098,19 @@ void CompilerStack::compileContract(
 
 	Contract& compiledContract = m_contracts.at(_contract.fullyQualifiedName());
 
-	shared_ptr<Compiler> compiler = make_shared<Compiler>(m_evmVersion, m_revertStrings, m_optimiserSettings);
+	util::CompilationStatistics::Scope statisticsScope(m_collectStatistics ? &compiledContract.statistics : nullptr);
+	util::Tracer::Span span("contract", "compileContract", _contract.fullyQualifiedName());
+	util::CompilationStatistics::PhaseTimer timer("evmCodeGeneration");
+
+	shared_ptr<Compiler> compiler = make_shared<Compiler>(
+		m_evmVersion,
+		m_revertStrings,
+		optimiserSettings(_contract),
+		m_sharedYulFunctions,
+		m_inlineAssemblyCache,
+		m_parallelism,
+		m_constantOptimisationCache
+	);
 	compiledContract.compiler = compiler;
 
 	bytes cborEncodedMetadata = createCBORMetadata(compiledContract);
@@ -1248,25 +2150,24 @@ void CompilerStack::compileContract(
 		solAssert(false, "Assembly exception for deployed bytecode");
 	}
 
-	// Throw a warning if EIP-170 limits are exceeded:
-	//   If contract creation returns data with length greater than 0x6000 (214 + 213) bytes,
-	//   contract creation fails with an out of gas error.
-	if (
-		m_evmVersion >= langutil::EVMVersion::spuriousDragon() &&
-		compiledContract.runtimeObject.bytecode.size() > 0x6000
-	)
-		m_errorReporter.warning(
-			5574_error,
-			_contract.location(),
-			"Contract code size exceeds 24576 bytes (a limit introduced in Spurious Dragon). "
-			"This contract may not be deployable on mainnet. "
-			"Consider enabling the optimizer (with a low \"runs\" value!), "
-			"turning off revert strings, or using libraries."
-		);
+	// Contracts loaded from the cache already reported this warning.
+	if (!compiledContract.loadedFromCache)
+		checkCodeSize(compiledContract, 5574_error, m_errorReporter);
 
 	_otherCompilers[compiledContract.contract] = compiler;
 }
 
+void CompilerStack::buildCallGraphs(ContractDefinition const& _contract)
+{
+	ContractDefinitionAnnotation& annotation = _contract.annotation();
+	if (annotation.creationCallGraph.set())
+		return;
+	annotation.creationCallGraph = make_unique<CallGraph>(FunctionCallGraphBuilder::buildCreationGraph(_contract));
+	annotation.deployedCallGraph = make_unique<CallGraph>(
+		FunctionCallGraphBuilder::buildDeployedGraph(_contract, **annotation.creationCallGraph)
+	);
+}
+
 void CompilerStack::generateIR(ContractDefinition const& _contract)
 {
 	solAssert(m_stackState >= AnalysisPerformed, "");
@@ -1277,13 +2178,7 @@ void CompilerStack::generateIR(ContractDefinition const& _contract)
 	if (!compiledContract.yulIR.empty())
 		return;
 
-	if (!*_contract.sourceUnit().annotation().useABICoderV2)
-		m_errorReporter.warning(
-			2066_error,
-			_contract.location(),
-			"Contract requests the ABI coder v1, which is incompatible with the IR. "
-			"Using ABI coder v2 instead."
-		);
+	checkABICoderForIR(_contract);
 
 	string dependenciesSource;
 	for (auto const* dependency: _contract.annotation().contractDependencies)
@@ -1292,15 +2187,40 @@ void CompilerStack::generateIR(ContractDefinition const& _contract)
 	if (!_contract.canBeDeployed())
 		return;
 
+	util::CompilationStatistics::Scope statisticsScope(m_collectStatistics ? &compiledContract.statistics : nullptr);
+	util::Tracer::Span span("contract", "generateIR", _contract.fullyQualifiedName());
+	util::CompilationStatistics::PhaseTimer timer("callGraphs");
+	buildCallGraphs(_contract);
+	timer.switchTo("irGeneration");
+
 	map<ContractDefinition const*, string_view const> otherYulSources;
 	for (auto const& pair: m_contracts)
 		otherYulSources.emplace(pair.second.contract, pair.second.yulIR);
 
-	IRGenerator generator(m_evmVersion, m_revertStrings, m_optimiserSettings);
-	tie(compiledContract.yulIR, compiledContract.yulIROptimized) = generator.run(_contract, otherYulSources);
+	IRGenerator generator(
+		m_evmVersion,
+		m_revertStrings,
+		irOptimiserSettings(_contract),
+		m_sharedYulFunctions,
+		m_sharedIRFunctions,
+		m_optimisedCodeCache,
+		m_parallelism
+	);
+	// Dependencies that were not requested are only used through the unoptimized IR
+	// embedded into the contracts that create them.
+	if (!isRequestedContract(_contract))
+	{
+		compiledContract.yulIR = generator.runWithoutOptimization(_contract, otherYulSources);
+		return;
+	}
+	tie(compiledContract.yulIR, compiledContract.yulIROptimized, compiledContract.yulIROptimizedObject) =
+		generator.run(_contract, otherYulSources, m_generateIR || m_generateEwasm);
+	// The analyzed IR is only kept for generating code from it.
+	if (!(viaIR(_contract) && m_generateEvmBytecode) && !m_generateEwasm)
+		compiledContract.yulIROptimizedObject.reset();
 }
 
-void CompilerStack::generateEVMFromIR(ContractDefinition const& _contract)
+void CompilerStack::generateEVMFromIR(ContractDefinition const& _contract, ErrorReporter& _errorReporter)
 {
 	solAssert(m_stackState >= AnalysisPerformed, "");
 	if (m_hasError)
@@ -1310,13 +2230,18 @@ void CompilerStack::generateEVMFromIR(ContractDefinition const& _contract)
 		return;
 
 	Contract& compiledContract = m_contracts.at(_contract.fullyQualifiedName());
-	solAssert(!compiledContract.yulIROptimized.empty(), "");
 	if (!compiledContract.object.bytecode.empty())
 		return;
 
-	// Re-parse the Yul IR in EVM dialect
-	yul::AssemblyStack stack(m_evmVersion, yul::AssemblyStack::Language::StrictAssembly, m_optimiserSettings);
-	stack.parseAndAnalyze("", compiledContract.yulIROptimized);
+	util::CompilationStatistics::Scope statisticsScope(m_collectStatistics ? &compiledContract.statistics : nullptr);
+	util::Tracer::Span span("contract", "generateEVMFromIR", _contract.fullyQualifiedName());
+	util::CompilationStatistics::PhaseTimer timer("evmCodeGenerationFromIR");
+
+	yul::AssemblyStack stack(m_evmVersion, yul::AssemblyStack::Language::StrictAssembly, irOptimiserSettings(_contract));
+	loadOptimizedIR(compiledContract, stack);
+	stack.setOptimisedCodeCache(m_optimisedCodeCache);
+	stack.setEVMObjectCache(m_evmObjectCache);
+	stack.setParallelism(m_parallelism);
 	stack.optimize();
 
 	//cout << yul::AsmPrinter{}(*stack.parserResult()->code) << endl;
@@ -1331,21 +2256,7 @@ void CompilerStack::generateEVMFromIR(ContractDefinition const& _contract)
 	// TODO: refactor assemblyItems, runtimeAssemblyItems, generatedSources,
 	//       assemblyString, assemblyJSON, and functionEntryPoints to work with this code path
 
-	// Throw a warning if EIP-170 limits are exceeded:
-	//   If contract creation returns data with length greater than 0x6000 (214 + 213) bytes,
-	//   contract creation fails with an out of gas error.
-	if (
-		m_evmVersion >= langutil::EVMVersion::spuriousDragon() &&
-		compiledContract.runtimeObject.bytecode.size() > 0x6000
-	)
-		m_errorReporter.warning(
-			9609_error,
-			_contract.location(),
-			"Contract code size exceeds 24576 bytes (a limit introduced in Spurious Dragon). "
-			"This contract may not be deployable on mainnet. "
-			"Consider enabling the optimizer (with a low \"runs\" value!), "
-			"turning off revert strings, or using libraries."
-		);
+	checkCodeSize(compiledContract, 9609_error, _errorReporter);
 }
 
 void CompilerStack::generateEwasm(ContractDefinition const& _contract)
@@ -1358,13 +2269,15 @@ void CompilerStack::generateEwasm(ContractDefinition const& _contract)
 		return;
 
 	Contract& compiledContract = m_contracts.at(_contract.fullyQualifiedName());
-	solAssert(!compiledContract.yulIROptimized.empty(), "");
 	if (!compiledContract.ewasm.empty())
 		return;
 
-	// Re-parse the Yul IR in EVM dialect
-	yul::AssemblyStack stack(m_evmVersion, yul::AssemblyStack::Language::StrictAssembly, m_optimiserSettings);
-	stack.parseAndAnalyze("", compiledContract.yulIROptimized);
+	util::CompilationStatistics::Scope statisticsScope(m_collectStatistics ? &compiledContract.statistics : nullptr);
+	util::Tracer::Span span("contract", "generateEwasm", _contract.fullyQualifiedName());
+	util::CompilationStatistics::PhaseTimer timer("ewasmCodeGeneration");
+
+	yul::AssemblyStack stack(m_evmVersion, yul::AssemblyStack::Language::StrictAssembly, irOptimiserSettings(_contract));
+	loadOptimizedIR(compiledContract, stack);
 
 	stack.optimize();
 	stack.translate(yul::AssemblyStack::Language::Ewasm);
@@ -1378,13 +2291,31 @@ void CompilerStack::generateEwasm(ContractDefinition const& _contract)
 	compiledContract.ewasmObject = std::move(*result.bytecode);
 }
 
+void CompilerStack::loadOptimizedIR(Contract& _contract, yul::AssemblyStack& _stack)
+{
+	if (_contract.yulIROptimizedObject)
+		_stack.setAnalyzedObject(move(_contract.yulIROptimizedObject));
+	else
+	{
+		// Re-parse the Yul IR in EVM dialect
+		solAssert(!_contract.yulIROptimized.empty(), "");
+		_stack.parseAndAnalyze("", _contract.yulIROptimized);
+	}
+}
+
 CompilerStack::Contract const& CompilerStack::contract(string const& _contractName) const
 {
 	solAssert(m_stackState >= AnalysisPerformed, "");
 
+	auto checkReleased = [&](Contract const& _contract) -> Contract const& {
+		if (_contract.released)
+			BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Contract \"" + _contractName + "\" has been released."));
+		return _contract;
+	};
+
 	auto it = m_contracts.find(_contractName);
 	if (it != m_contracts.end())
-		return it->second;
+		return checkReleased(it->second);
 
 	// To provide a measure of backward-compatibility, if a contract is not located by its
 	// fully-qualified name, a lookup will be attempted purely on the contract's name to see
@@ -1401,7 +2332,7 @@ CompilerStack::Contract const& CompilerStack::contract(string const& _contractNa
 			getline(ss, source, ':');
 			getline(ss, foundName, ':');
 			if (foundName == _contractName)
-				return contractEntry.second;
+				return checkReleased(contractEntry.second);
 		}
 	}
 
@@ -1418,7 +2349,7 @@ CompilerStack::Source const& CompilerStack::source(string const& _sourceName) co
 	return it->second;
 }
 
-string CompilerStack::createMetadata(Contract const& _contract) const
+string CompilerStack::createMetadata(Contract const& _contract, bool _sourceNames) const
 {
 	Json::Value meta;
 	meta["version"] = 1;
@@ -1426,39 +2357,51 @@ string CompilerStack::createMetadata(Contract const& _contract) const
 	meta["compiler"]["version"] = VersionStringStrict;
 
 	/// All the source files (including self), which should be included in the metadata.
-	set<string> referencedSources;
-	referencedSources.insert(*_contract.contract->sourceUnit().annotation().path);
-	for (auto const sourceUnit: _contract.contract->sourceUnit().referencedSourceUnits(true))
-		referencedSources.insert(*sourceUnit->annotation().path);
+	set<string> referencedSources = referableSources(*_contract.contract);
 
-	meta["sources"] = Json::objectValue;
-	for (auto const& s: m_sources)
+	// The hashes of the sources are computed concurrently the first time they are requested.
+	vector<Source const*> unhashedSources;
 	{
-		if (!referencedSources.count(s.first))
-			continue;
-
-		solAssert(s.second.scanner, "Scanner not available");
-		meta["sources"][s.first]["keccak256"] = "0x" + toHex(s.second.keccak256().asBytes());
-		if (optional<string> licenseString = s.second.ast->licenseString())
-			meta["sources"][s.first]["license"] = *licenseString;
-		if (m_metadataLiteralSources)
-			meta["sources"][s.first]["content"] = s.second.scanner->source();
-		else
-		{
-			meta["sources"][s.first]["urls"] = Json::arrayValue;
-			meta["sources"][s.first]["urls"].append("bzz-raw://" + toHex(s.second.swarmHash().asBytes()));
-			meta["sources"][s.first]["urls"].append(s.second.ipfsUrl());
-		}
+		lock_guard<mutex> lock(sourceHashMutex());
+		for (auto const& s: m_sources)
+			if (
+				referencedSources.count(s.first) &&
+				s.second.scanner &&
+				(s.second.keccak256HashCached == h256{} || (!m_metadataLiteralSources && s.second.ipfsUrlCached.empty()))
+			)
+				unhashedSources.push_back(&s.second);
+	}
+	if (!unhashedSources.empty())
+	{
+		util::ThreadPool threadPool(min(util::ThreadPool::effectiveThreads(m_parallelism), unhashedSources.size()));
+		for (Source const* source: unhashedSources)
+			threadPool.submit([this, source]() {
+				source->keccak256();
+				if (!m_metadataLiteralSources)
+				{
+					source->swarmHash();
+					source->ipfsUrl();
+				}
+			});
+		threadPool.wait();
 	}
 
-	static_assert(sizeof(m_optimiserSettings.expectedExecutionsPerDeployment) <= sizeof(Json::LargestUInt), "Invalid word size.");
-	solAssert(static_cast<Json::LargestUInt>(m_optimiserSettings.expectedExecutionsPerDeployment) < std::numeric_limits<Json::LargestUInt>::max(), "");
-	meta["settings"]["optimizer"]["runs"] = Json::Value(Json::LargestUInt(m_optimiserSettings.expectedExecutionsPerDeployment));
+	OptimiserSettings const& settings = optimiserSettings(*_contract.contract);
+	static_assert(sizeof(settings.expectedExecutionsPerDeployment) <= sizeof(Json::LargestUInt), "Invalid word size.");
+	solAssert(static_cast<Json::LargestUInt>(settings.expectedExecutionsPerDeployment) < std::numeric_limits<Json::LargestUInt>::max(), "");
+	meta["settings"]["optimizer"]["runs"] = Json::Value(Json::LargestUInt(settings.expectedExecutionsPerDeployment));
+	if (!settings.functionWeights.empty())
+	{
+		meta["settings"]["optimizer"]["functionWeights"] = Json::objectValue;
+		for (auto const& [selector, weight]: settings.functionWeights)
+			meta["settings"]["optimizer"]["functionWeights"][selector] = Json::Value(Json::UInt64(weight));
+	}
 
 	/// Backwards compatibility: If set to one of the default settings, do not provide details.
-	OptimiserSettings settingsWithoutRuns = m_optimiserSettings;
+	OptimiserSettings settingsWithoutRuns = settings;
 	// reset to default
 	settingsWithoutRuns.expectedExecutionsPerDeployment = OptimiserSettings::minimal().expectedExecutionsPerDeployment;
+	settingsWithoutRuns.functionWeights.clear();
 	if (settingsWithoutRuns == OptimiserSettings::minimal())
 		meta["settings"]["optimizer"]["enabled"] = false;
 	else if (settingsWithoutRuns == OptimiserSettings::standard())
@@ -1467,19 +2410,23 @@ string CompilerStack::createMetadata(Contract const& _contract) const
 	{
 		Json::Value details{Json::objectValue};
 
-		details["orderLiterals"] = m_optimiserSettings.runOrderLiterals;
-		details["inliner"] = m_optimiserSettings.runInliner;
-		details["jumpdestRemover"] = m_optimiserSettings.runJumpdestRemover;
-		details["peephole"] = m_optimiserSettings.runPeephole;
-		details["deduplicate"] = m_optimiserSettings.runDeduplicate;
-		details["cse"] = m_optimiserSettings.runCSE;
-		details["constantOptimizer"] = m_optimiserSettings.runConstantOptimiser;
-		details["yul"] = m_optimiserSettings.runYulOptimiser;
-		if (m_optimiserSettings.runYulOptimiser)
+		details["orderLiterals"] = settings.runOrderLiterals;
+		details["inliner"] = settings.runInliner;
+		details["jumpdestRemover"] = settings.runJumpdestRemover;
+		details["peephole"] = settings.runPeephole;
+		details["deduplicate"] = settings.runDeduplicate;
+		details["cse"] = settings.runCSE;
+		details["constantOptimizer"] = settings.runConstantOptimiser;
+		details["yul"] = settings.runYulOptimiser;
+		if (settings.runYulOptimiser)
 		{
 			details["yulDetails"] = Json::objectValue;
-			details["yulDetails"]["stackAllocation"] = m_optimiserSettings.optimizeStackAllocation;
-			details["yulDetails"]["optimizerSteps"] = m_optimiserSettings.yulOptimiserSteps;
+			details["yulDetails"]["stackAllocation"] = settings.optimizeStackAllocation;
+			details["yulDetails"]["optimizerSteps"] = settings.yulOptimiserSteps;
+			if (settings.optimizeStackLayout)
+				details["yulDetails"]["stackLayout"] = true;
+			if (settings.yulReuseAcrossObjects)
+				details["yulDetails"]["reuseAcrossObjects"] = true;
 		}
 
 		meta["settings"]["optimizer"]["details"] = std::move(details);
@@ -1494,8 +2441,8 @@ string CompilerStack::createMetadata(Contract const& _contract) const
 	static vector<string> hashes{"ipfs", "bzzr1", "none"};
 	meta["settings"]["metadata"]["bytecodeHash"] = hashes.at(unsigned(m_metadataHash));
 
-	if (m_viaIR)
-		meta["settings"]["viaIR"] = m_viaIR;
+	if (viaIR(*_contract.contract))
+		meta["settings"]["viaIR"] = true;
 	meta["settings"]["evmVersion"] = m_evmVersion.name();
 	meta["settings"]["compilationTarget"][_contract.contract->sourceUnitName()] =
 		*_contract.contract->annotation().canonicalName;
@@ -1515,7 +2462,27 @@ string CompilerStack::createMetadata(Contract const& _contract) const
 	meta["output"]["userdoc"] = natspecUser(_contract);
 	meta["output"]["devdoc"] = natspecDev(_contract);
 
-	return util::jsonCompactPrint(meta);
+	// The sources are inserted in serialized form, so that the entry of each source is only
+	// serialized once for all contracts. The member "sources" is placed between "settings" and
+	// "version", which is the last member.
+	string metadata = util::jsonCompactPrint(meta);
+	string const versionMember = ",\"version\":1}";
+	solAssert(boost::ends_with(metadata, versionMember), "");
+	string sources;
+	for (auto const& s: m_sources)
+	{
+		if (!referencedSources.count(s.first))
+			continue;
+
+		if (!sources.empty())
+			sources += ",";
+		sources += util::jsonCompactPrint(Json::Value(s.first));
+		if (!_sourceNames)
+			sources += ":" + metadataSourceEntry(s.first);
+	}
+	sources = _sourceNames ? "[" + sources + "]" : "{" + sources + "}";
+	metadata.insert(metadata.size() - versionMember.size(), ",\"sources\":" + sources);
+	return metadata;
 }
 
 class MetadataCBOREncoder
@@ -1621,7 +2588,7 @@ bytes CompilerStack::createCBORMetadata(Contract const& _contract) const
 	else
 		solAssert(m_metadataHash == MetadataHash::None, "Invalid metadata hash");
 
-	if (experimentalMode || m_viaIR)
+	if (experimentalMode || viaIR(*_contract.contract))
 		encoder.pushBool("experimental", true);
 	if (m_metadataFormat == MetadataFormat::WithReleaseVersionTag)
 		encoder.pushBytes("solc", VersionCompactBytes);
@@ -1649,79 +2616,213 @@ Json::Value gasToJson(GasEstimator::GasConsumption const& _gas)
 
 }
 
-Json::Value CompilerStack::gasEstimates(string const& _contractName) const
+Json::Value const& CompilerStack::gasEstimates(string const& _contractName) const
 {
 	if (m_stackState != CompilationSuccessful)
 		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Compilation was not successful."));
 
-	if (!assemblyItems(_contractName) && !runtimeAssemblyItems(_contractName))
-		return Json::Value();
+	return contract(_contractName).gasEstimates.init([&]() { return move(estimateGas({_contractName}).front()); });
+}
+
+void CompilerStack::computeGasEstimates(vector<string> const& _contractNames) const
+{
+	if (m_stackState != CompilationSuccessful)
+		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Compilation was not successful."));
+
+	vector<string> contractNames;
+	for (string const& contractName: _contractNames)
+		if (!contract(contractName).gasEstimates.initialized())
+			contractNames.push_back(contractName);
+	vector<Json::Value> estimates = estimateGas(contractNames);
+	for (size_t i = 0; i < contractNames.size(); ++i)
+		contract(contractNames[i]).gasEstimates.init([&]() { return move(estimates[i]); });
+}
 
+vector<Json::Value> CompilerStack::estimateGas(vector<string> const& _contractNames) const
+{
+	TypeProvider::Scope typeScope(*m_typeProvider);
 	using Gas = GasEstimator::GasConsumption;
 	GasEstimator gasEstimator(m_evmVersion);
-	Json::Value output(Json::objectValue);
 
-	if (evmasm::AssemblyItems const* items = assemblyItems(_contractName))
+	struct Estimation
+	{
+		evmasm::AssemblyItems const* creationItems = nullptr;
+		evmasm::AssemblyItems const* runtimeItems = nullptr;
+		Gas executionGas;
+		vector<pair<string, Gas>> externalGas;
+		vector<pair<string, Gas>> internalGas;
+	};
+
+	// The estimations of all functions of all contracts are independent of each other and run
+	// concurrently, everything that needs the types is prepared on this thread. The results are
+	// collected in a fixed order.
+	vector<Estimation> estimations(_contractNames.size());
+	vector<function<void()>> tasks;
+	for (size_t contractIndex = 0; contractIndex < _contractNames.size(); ++contractIndex)
 	{
-		Gas executionGas = gasEstimator.functionalEstimation(*items);
-		Gas codeDepositGas{evmasm::GasMeter::dataGas(runtimeObject(_contractName).bytecode, false, m_evmVersion)};
+		string const& contractName = _contractNames[contractIndex];
+		Estimation& estimation = estimations[contractIndex];
+		estimation.creationItems = assemblyItems(contractName);
+		estimation.runtimeItems = runtimeAssemblyItems(contractName);
+		if (estimation.creationItems)
+			tasks.emplace_back([&]() { estimation.executionGas = gasEstimator.functionalEstimation(*estimation.creationItems); });
+		if (estimation.runtimeItems)
+		{
+			ContractDefinition const& contract = contractDefinition(contractName);
+			for (auto it: contract.interfaceFunctions())
+				estimation.externalGas.emplace_back(it.second->externalSignature(), Gas{});
+			if (contract.fallbackFunction())
+				estimation.externalGas.emplace_back("", Gas{});
+			for (size_t i = 0; i < estimation.externalGas.size(); ++i)
+				/// The fallback is estimated with an invalid signature in order to trigger it
+				/// without the shortcut (of CALLDATSIZE == 0), and therefore to receive the upper bound.
+				/// An empty string ("") would work to trigger the shortcut only.
+				tasks.emplace_back([&, i]() {
+					string const& signature = estimation.externalGas[i].first;
+					estimation.externalGas[i].second = gasEstimator.functionalEstimation(
+						*estimation.runtimeItems,
+						signature.empty() ? "INVALID" : signature
+					);
+				});
+
+			for (auto const& it: contract.definedFunctions())
+			{
+				/// Exclude externally visible functions, constructor, fallback and receive ether function
+				if (it->isPartOfExternalInterface() || !it->isOrdinary())
+					continue;
+
+				/// TODO: This could move into a method shared with externalSignature()
+				FunctionType type(*it);
+				string sig = it->name() + "(";
+				auto paramTypes = type.parameterTypes();
+				for (auto it = paramTypes.begin(); it != paramTypes.end(); ++it)
+					sig += (*it)->toString() + (it + 1 == paramTypes.end() ? "" : ",");
+				sig += ")";
+
+				size_t const index = estimation.internalGas.size();
+				estimation.internalGas.emplace_back(move(sig), GasEstimator::GasConsumption::infinite());
+				size_t entry = functionEntryPoint(contractName, *it);
+				if (entry > 0)
+				{
+					unsigned parametersSize = CompilerUtils::sizeOnStack(it->parameters());
+					tasks.emplace_back([&, index, entry, parametersSize]() {
+						estimation.internalGas[index].second = gasEstimator.functionalEstimation(
+							*estimation.runtimeItems,
+							entry,
+							parametersSize
+						);
+					});
+				}
+			}
+		}
+	}
 
-		Json::Value creation(Json::objectValue);
-		creation["codeDepositCost"] = gasToJson(codeDepositGas);
-		creation["executionCost"] = gasToJson(executionGas);
-		/// TODO: implement + overload to avoid the need of +=
-		executionGas += codeDepositGas;
-		creation["totalCost"] = gasToJson(executionGas);
-		output["creation"] = creation;
+	{
+		util::ThreadPool threadPool(min(util::ThreadPool::effectiveThreads(m_parallelism), max<size_t>(tasks.size(), 1)));
+		for (auto& task: tasks)
+			threadPool.submit(move(task));
+		threadPool.wait();
 	}
 
-	if (evmasm::AssemblyItems const* items = runtimeAssemblyItems(_contractName))
+	vector<Json::Value> outputs;
+	for (size_t contractIndex = 0; contractIndex < _contractNames.size(); ++contractIndex)
 	{
-		/// External functions
-		ContractDefinition const& contract = contractDefinition(_contractName);
-		Json::Value externalFunctions(Json::objectValue);
-		for (auto it: contract.interfaceFunctions())
+		Estimation& estimation = estimations[contractIndex];
+		if (!estimation.creationItems && !estimation.runtimeItems)
+		{
+			outputs.emplace_back();
+			continue;
+		}
+
+		Json::Value& output = outputs.emplace_back(Json::objectValue);
+		if (estimation.creationItems)
 		{
-			string sig = it.second->externalSignature();
-			externalFunctions[sig] = gasToJson(gasEstimator.functionalEstimation(*items, sig));
+			Gas codeDepositGas{evmasm::GasMeter::dataGas(runtimeObject(_contractNames[contractIndex]).bytecode, false, m_evmVersion)};
+
+			Json::Value creation(Json::objectValue);
+			creation["codeDepositCost"] = gasToJson(codeDepositGas);
+			creation["executionCost"] = gasToJson(estimation.executionGas);
+			/// TODO: implement + overload to avoid the need of +=
+			estimation.executionGas += codeDepositGas;
+			creation["totalCost"] = gasToJson(estimation.executionGas);
+			output["creation"] = creation;
 		}
 
-		if (contract.fallbackFunction())
-			/// This needs to be set to an invalid signature in order to trigger the fallback,
-			/// without the shortcut (of CALLDATSIZE == 0), and therefore to receive the upper bound.
-			/// An empty string ("") would work to trigger the shortcut only.
-			externalFunctions[""] = gasToJson(gasEstimator.functionalEstimation(*items, "INVALID"));
+		if (estimation.runtimeItems)
+		{
+			/// External functions
+			Json::Value externalFunctions(Json::objectValue);
+			for (auto const& [sig, gas]: estimation.externalGas)
+				externalFunctions[sig] = gasToJson(gas);
+
+			if (!externalFunctions.empty())
+				output["external"] = externalFunctions;
+
+			/// Internal functions
+			Json::Value internalFunctions(Json::objectValue);
+			for (auto const& [sig, gas]: estimation.internalGas)
+				internalFunctions[sig] = gasToJson(gas);
+
+			if (!internalFunctions.empty())
+				output["internal"] = internalFunctions;
+		}
+	}
+	return outputs;
+}
+
+util::CompilationStatistics CompilerStack::compilationStatistics() const
+{
+	util::CompilationStatistics statistics = m_statistics;
+	for (auto const& contract: m_contracts)
+		statistics.merge(contract.second.statistics);
+	if (m_collectStatistics)
+		m_typeProvider->recordStatistics(statistics);
+	return statistics;
+}
+
+util::CompilationStatistics const& CompilerStack::compilationStatistics(string const& _contractName) const
+{
+	if (m_stackState < AnalysisPerformed)
+		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Analysis was not successful."));
 
-		if (!externalFunctions.empty())
-			output["external"] = externalFunctions;
+	return contract(_contractName).statistics;
+}
 
-		/// Internal functions
-		Json::Value internalFunctions(Json::objectValue);
-		for (auto const& it: contract.definedFunctions())
+void CompilerStack::releaseContract(string const& _contractName)
+{
+	if (m_stackState < AnalysisPerformed)
+		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Analysis was not successful."));
+
+	ContractDefinition const& releasedContract = *contract(_contractName).contract;
+
+	auto releaseAST = [&](string const& _path) {
+		Source& source = m_sources.at(_path);
+		if (!m_keptASTs.count(_path) && !source.astReleased)
 		{
-			/// Exclude externally visible functions, constructor, fallback and receive ether function
-			if (it->isPartOfExternalInterface() || !it->isOrdinary())
-				continue;
-
-			size_t entry = functionEntryPoint(_contractName, *it);
-			GasEstimator::GasConsumption gas = GasEstimator::GasConsumption::infinite();
-			if (entry > 0)
-				gas = gasEstimator.functionalEstimation(*items, entry, *it);
-
-			/// TODO: This could move into a method shared with externalSignature()
-			FunctionType type(*it);
-			string sig = it->name() + "(";
-			auto paramTypes = type.parameterTypes();
-			for (auto it = paramTypes.begin(); it != paramTypes.end(); ++it)
-				sig += (*it)->toString() + (it + 1 == paramTypes.end() ? "" : ",");
-			sig += ")";
-
-			internalFunctions[sig] = gasToJson(gas);
+			if (source.ast)
+				m_astNodeIndex.remove(*source.ast);
+			source.ast.reset();
+			source.astReleased = true;
 		}
+	};
 
-		if (!internalFunctions.empty())
-			output["internal"] = internalFunctions;
+	if (!m_astReferences)
+	{
+		m_astReferences.emplace();
+		for (auto const& [name, compiledContract]: m_contracts)
+			for (string const& path: referableSources(*compiledContract.contract))
+				++(*m_astReferences)[path];
+		// No contract can refer to the remaining sources.
+		for (auto const& [path, source]: m_sources)
+			if (!m_astReferences->count(path))
+				releaseAST(path);
 	}
 
-	return output;
+	set<string> const sources = referableSources(releasedContract);
+	string const name = releasedContract.fullyQualifiedName();
+	m_contracts.erase(name);
+	m_contracts[name].released = true;
+	for (string const& path: sources)
+		if (--m_astReferences->at(path) == 0)
+			releaseAST(path);
 }
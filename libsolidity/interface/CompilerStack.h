@@ -25,15 +25,19 @@
 #pragma once
 
 #include <libsolidity/analysis/FunctionCallGraph.h>
+#include <libsolidity/ast/ASTNodeIndex.h>
 #include <libsolidity/interface/ReadFile.h>
+#include <libsolidity/interface/RemappingIndex.h>
 #include <libsolidity/interface/OptimiserSettings.h>
 #include <libsolidity/interface/Version.h>
 #include <libsolidity/interface/DebugSettings.h>
 
 #include <libsolidity/formal/ModelCheckerSettings.h>
+#include <libsolidity/formal/ModelCheckerStatistics.h>
 
 #include <libsmtutil/SolverInterface.h>
 
+#include <liblangutil/CharStreamProvider.h>
 #include <liblangutil/ErrorReporter.h>
 #include <liblangutil/EVMVersion.h>
 #include <liblangutil/SourceLocation.h>
@@ -41,17 +45,25 @@
 #include <libevmasm/LinkerObject.h>
 
 #include <libsolutil/Common.h>
+#include <libsolutil/CompilationStatistics.h>
 #include <libsolutil/FixedHash.h>
+#include <libsolutil/JsonWriter.h>
 #include <libsolutil/LazyInit.h>
+#include <libsolutil/SourceBuffer.h>
 
 #include <boost/noncopyable.hpp>
 #include <json/json.h>
 
+#include <exception>
 #include <functional>
+#include <map>
 #include <memory>
+#include <mutex>
+#include <optional>
 #include <ostream>
 #include <set>
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace solidity::langutil
@@ -64,9 +76,18 @@ namespace solidity::evmasm
 {
 class Assembly;
 class AssemblyItem;
+class ConstantOptimisationCache;
 using AssemblyItems = std::vector<AssemblyItem>;
 }
 
+namespace solidity::yul
+{
+class AssemblyStack;
+class EVMObjectCache;
+struct Object;
+class OptimisedCodeCache;
+}
+
 namespace solidity::frontend
 {
 
@@ -76,9 +97,14 @@ class ContractDefinition;
 class FunctionDefinition;
 class SourceUnit;
 class Compiler;
+class CompilationCache;
 class GlobalContext;
+class TypeProvider;
 class Natspec;
 class DeclarationContainer;
+class SharedYulFunctionCache;
+class SharedIRFunctionCache;
+class InlineAssemblyCache;
 
 /**
  * Easy to use and self-contained Solidity compiler with as few header dependencies as possible.
@@ -87,7 +113,7 @@ class DeclarationContainer;
  * If error recovery is active, it is possible to progress through the stages even when
  * there are errors. In any case, producing code is only possible without errors.
  */
-class CompilerStack: boost::noncopyable
+class CompilerStack: public langutil::CharStreamProvider, boost::noncopyable
 {
 public:
 	enum State {
@@ -118,9 +144,19 @@ public:
 		std::string target;
 	};
 
+	/// Settings of the code generation of a single contract that replace the global ones.
+	struct OptimisationProfile
+	{
+		std::optional<OptimiserSettings> optimiserSettings;
+		std::optional<bool> viaIR;
+	};
+
 	/// Creates a new compiler stack.
 	/// @param _readFile callback used to read files for import statements. Must return
 	/// and must not emit exceptions.
+	/// Several compiler stacks can exist at the same time, but they share the Yul string
+	/// repository, which is reset when a stack is destroyed. Because of that, a stack must
+	/// not be destroyed while another one is compiling.
 	explicit CompilerStack(ReadCallback::Callback _readFile = ReadCallback::Callback());
 
 	~CompilerStack();
@@ -173,6 +209,25 @@ public:
 	/// Must be set before parsing.
 	void setViaIR(bool _viaIR);
 
+	/// Sets the optimisation profiles of contracts, keyed by fully qualified contract name.
+	/// A contract has to use the same profile as the contracts it creates.
+	/// Must be set before parsing.
+	void setOptimisationProfiles(std::map<std::string, OptimisationProfile> _profiles);
+
+	/// Sets the number of threads used to parse sources and to generate code for different contracts
+	/// concurrently. Zero means one thread per hardware thread. The output does not depend on this setting.
+	/// Only code generation from the IR (for the IR pipeline and Ewasm) is done concurrently;
+	/// the legacy code generator shares state between contracts and always runs on the
+	/// calling thread.
+	void setParallelism(size_t _threads) { m_parallelism = _threads; }
+
+	/// Sets the cache that the code generation outputs of requested contracts are looked up in
+	/// and stored to. Contracts whose inputs did not change are not compiled again; for them,
+	/// only the bytecode, the source mappings, the IR and the outputs derived from the AST
+	/// are available. The cache is not used if Ewasm generation is enabled.
+	/// The results of the Yul optimizer are also stored in a sub-directory of the cache.
+	void setCompilationCache(std::shared_ptr<CompilationCache const> _cache);
+
 	/// Set the EVM version used before running compile.
 	/// When called without an argument it will revert to the default version.
 	/// Must be set before parsing.
@@ -192,6 +247,12 @@ public:
 		m_requestedContractNames = _contractNames;
 	}
 
+	/// Parse only the requested sources (see setRequestedContractNames) and the sources they
+	/// import, directly or indirectly. The other sources are neither parsed nor analysed, so
+	/// errors in them are not reported and they have no AST. Has no effect if compilation
+	/// stops after parsing, because the imports are not resolved then.
+	void setSkipUnrequestedSources(bool _skip = true) { m_skipUnrequestedSources = _skip; }
+
 	/// Enable EVM Bytecode generation. This is enabled by default.
 	void enableEvmBytecodeGeneration(bool _enable = true) { m_generateEvmBytecode = _enable; }
 
@@ -201,6 +262,21 @@ public:
 	/// Enable experimental generation of Ewasm code. If enabled, IR is also generated.
 	void enableEwasmGeneration(bool _enable = true) { m_generateEwasm = _enable; }
 
+	/// Enable keeping the ASTs of the sources across calls to reset, so that sources whose
+	/// content did not change are not scanned and parsed again. Of sources that only changed inside
+	/// the body of one function or modifier, only that body is parsed again, and the other nodes
+	/// keep their IDs. Unlike other settings, this one
+	/// is kept by reset(false). Sources with parser errors are always parsed again. Analysis
+	/// is repeated for all sources, because its results refer to types, which do not survive a reset.
+	/// Node IDs keep increasing across resets, so the output can differ from a fresh compilation
+	/// in the AST IDs and in everything that depends on them (e.g. names in the IR).
+	void enableIncrementalParsing(bool _enable = true) { m_incrementalParsing = _enable; }
+
+	/// Enable measuring the wall time and memory usage of the compilation phases and of the
+	/// Yul optimiser steps. Detecting whether optimiser steps changed the code makes
+	/// optimisation noticeably slower.
+	void enableCompilationStatistics(bool _enable = true) { m_collectStatistics = _enable; }
+
 	/// @arg _metadataLiteralSources When true, store sources as literals in the contract metadata.
 	/// Must be set before parsing.
 	void useMetadataLiteralSources(bool _metadataLiteralSources);
@@ -212,6 +288,8 @@ public:
 
 	/// Sets the sources. Must be set before parsing.
 	void setSources(StringMap _sources);
+	/// Sets the sources, sharing their contents instead of copying them. Must be set before parsing.
+	void setSourceBuffers(std::map<std::string, util::SourceBuffer> _sources);
 
 	/// Adds a response to an SMTLib2 query (identified by the hash of the query input).
 	/// Must be set before parsing.
@@ -224,6 +302,15 @@ public:
 	/// Imports given SourceUnits so they can be analyzed. Leads to the same internal state as parse().
 	/// Will throw errors if the import fails
 	void importASTs(std::map<std::string, Json::Value> const& _sources);
+	/// Imports all SourceUnits contained in @a _binaryASTs, which is in the format of ASTBinary.
+	void importASTs(std::string_view _binaryASTs);
+
+	/// Takes over the parsed and analysed sources of @a _analysis, which leads to the same
+	/// internal state as analyze() without parsing and analysing the sources again. Several
+	/// compiler stacks can share the sources of one analysis and compile them concurrently with
+	/// different code generation settings, which must be set before. The settings that affect
+	/// parsing and analysis are taken over from @a _analysis, which has to outlive this compiler stack.
+	void useAnalysis(CompilerStack const& _analysis);
 
 	/// Performs the analysis steps (imports, scopesetting, syntaxCheck, referenceResolving,
 	///  typechecking, staticAnalysis) on previously parsed sources.
@@ -242,19 +329,39 @@ public:
 	std::vector<std::string> sourceNames() const;
 
 	/// @returns a mapping assigning each source name its index inside the vector returned
-	/// by sourceNames().
-	std::map<std::string, unsigned> sourceIndices() const;
+	/// by sourceNames(). The mapping is computed once the sources are parsed.
+	std::map<std::string, unsigned> const& sourceIndices() const;
+
+	/// @returns the provider of the types of this compilation. Code outside of the compiler stack
+	/// that can request types referring to its ASTs, e.g. the AST export, has to hold a
+	/// TypeProvider::Scope of it. The provider is replaced on reset().
+	TypeProvider& typeProvider() const { return *m_typeProvider; }
 
 	/// @returns the previously used scanner, useful for counting lines during error reporting.
 	langutil::Scanner const& scanner(std::string const& _sourceName) const;
 
+	/// @returns the source called @a _sourceName, so that the locations in errors can be
+	/// printed together with the source code. Returns nullptr for unknown sources and
+	/// for sources imported as ASTs.
+	langutil::CharStream const* charStream(std::string const& _sourceName) const override;
+
 	/// @returns the parsed source unit with the supplied name.
 	SourceUnit const& ast(std::string const& _sourceName) const;
 
+	/// @returns the index of the nodes of all ASTs by ID. Nodes of ASTs freed by
+	/// @a releaseContract are removed from it.
+	ASTNodeIndex const& astNodeIndex() const;
+
 	/// @returns the parsed contract with the supplied name. Throws an exception if the contract
 	/// does not exist.
 	ContractDefinition const& contractDefinition(std::string const& _contractName) const;
 
+	/// @returns the graph of the calls that may happen during the construction of the contract
+	/// with the supplied name. The call graphs of a contract are built on first use.
+	CallGraph const& creationCallGraph(std::string const& _contractName) const;
+	/// @returns the graph of the calls that may happen in the deployed contract with the supplied name.
+	CallGraph const& deployedCallGraph(std::string const& _contractName) const;
+
 	/// Helper function for logs printing. Do only use in error cases, it's quite expensive.
 	/// line and columns are numbered starting from 1 with following order:
 	/// start line, start column, end line, end column
@@ -277,6 +384,7 @@ public:
 	std::string const& yulIR(std::string const& _contractName) const;
 
 	/// @returns the optimized IR representation of a contract.
+	/// Only available if IR generation was enabled, see @a enableIRGeneration.
 	std::string const& yulIROptimized(std::string const& _contractName) const;
 
 	/// @returns the Ewasm text representation of a contract.
@@ -291,6 +399,10 @@ public:
 	/// @returns the runtime object for the contract.
 	evmasm::LinkerObject const& runtimeObject(std::string const& _contractName) const;
 
+	/// @returns the assembly of a contract or null if it was not compiled to EVM code.
+	/// The sub-assemblies are shared with the compiler stack.
+	std::shared_ptr<evmasm::Assembly const> evmAssembly(std::string const& _contractName) const;
+
 	/// @returns normal contract assembly items
 	evmasm::AssemblyItems const* assemblyItems(std::string const& _contractName) const;
 
@@ -313,11 +425,17 @@ public:
 	/// @arg _sourceCodes is the map of input files to source code strings
 	/// Prerequisite: Successful compilation.
 	std::string assemblyString(std::string const& _contractName, StringMap _sourceCodes = StringMap()) const;
+	/// Prints the result of @a assemblyString to @a _out without building it as a string first.
+	void assemblyStream(std::ostream& _out, std::string const& _contractName, StringMap const& _sourceCodes = StringMap()) const;
 
 	/// @returns a JSON representation of the assembly.
 	/// @arg _sourceCodes is the map of input files to source code strings
 	/// Prerequisite: Successful compilation.
 	Json::Value assemblyJSON(std::string const& _contractName) const;
+	/// Adds the members of the result of @a assemblyJSON to the current object of @a _writer,
+	/// which prints them one by one if it prints the object. Adds nothing if there is no assembly.
+	/// Prerequisite: Successful compilation.
+	void assemblyJSON(std::string const& _contractName, util::JsonWriter& _writer) const;
 
 	/// @returns a JSON representing the contract ABI.
 	/// Prerequisite: Successful call to parse or compile.
@@ -341,11 +459,47 @@ public:
 	/// @returns the Contract Metadata
 	std::string const& metadata(std::string const& _contractName) const;
 
+	/// @returns the metadata of the contract with the names of its sources in place of their entries,
+	/// i.e. with ``"sources"`` being an array of the names. Inserting the entries returned by
+	/// @a metadataSourceEntry yields the metadata returned by @a metadata.
+	std::string metadataWithSourceNames(std::string const& _contractName) const;
+
+	/// @returns the names of the sources included in the metadata of the contract.
+	std::set<std::string> metadataSourceNames(std::string const& _contractName) const;
+
+	/// @returns the entry of the source in the ``"sources"`` section of the metadata as a compact JSON string.
+	/// The entry is shared by the metadata of all contracts that include the source.
+	std::string const& metadataSourceEntry(std::string const& _sourceName) const;
+
 	/// @returns the cbor-encoded metadata.
 	bytes cborMetadata(std::string const& _contractName) const;
 
 	/// @returns a JSON representing the estimated gas usage for contract creation, internal and external functions
-	Json::Value gasEstimates(std::string const& _contractName) const;
+	Json::Value const& gasEstimates(std::string const& _contractName) const;
+
+	/// Estimates the gas usage of all functions of the given contracts concurrently and stores
+	/// the results, so that @a gasEstimates returns them without estimating again.
+	void computeGasEstimates(std::vector<std::string> const& _contractNames) const;
+
+	/// @returns the statistics of the last compilation, including those of all contracts.
+	/// Empty unless enabled via enableCompilationStatistics.
+	util::CompilationStatistics compilationStatistics() const;
+
+	/// @returns the statistics of the code generation for the given contract.
+	util::CompilationStatistics const& compilationStatistics(std::string const& _contractName) const;
+
+	/// @returns the statistics of the verification targets checked by the model checker.
+	/// Empty unless enabled via enableCompilationStatistics.
+	ModelCheckerStatistics const& modelCheckerStatistics() const { return m_modelCheckerStatistics; }
+
+	/// Frees everything kept for the given contract once its outputs are not needed anymore.
+	/// Afterwards, all accessors for the contract fail. The AST of a source is freed as well
+	/// once all contracts that can refer to it are released, unless it is kept via @a keepAST.
+	/// Accessing the AST fails afterwards.
+	void releaseContract(std::string const& _contractName);
+
+	/// Prevents @a releaseContract from freeing the AST of the given source.
+	void keepAST(std::string const& _sourceName) { m_keptASTs.insert(_sourceName); }
 
 	/// Changes the format of the metadata appended at the end of the bytecode.
 	/// This is mostly a workaround to avoid bytecode and gas differences between compiler builds
@@ -360,6 +514,9 @@ private:
 		util::h256 mutable keccak256HashCached;
 		util::h256 mutable swarmHashCached;
 		std::string mutable ipfsUrlCached;
+		/// Errors and warnings reported while parsing, reported again if the AST is reused.
+		langutil::ErrorList parserErrors;
+		bool astReleased = false; ///< Whether the AST was freed by releaseContract.
 		void reset() { *this = Source(); }
 		util::h256 const& keccak256() const;
 		util::h256 const& swarmHash() const;
@@ -376,7 +533,9 @@ private:
 		evmasm::LinkerObject object; ///< Deployment object (includes the runtime sub-object).
 		evmasm::LinkerObject runtimeObject; ///< Runtime object.
 		std::string yulIR; ///< Experimental Yul IR code.
-		std::string yulIROptimized; ///< Optimized experimental Yul IR code.
+		std::string yulIROptimized; ///< Optimized experimental Yul IR code, only printed if requested.
+		/// Analyzed optimized Yul IR, handed over to the first code generation step that uses it.
+		std::shared_ptr<yul::Object> yulIROptimizedObject;
 		std::string ewasm; ///< Experimental Ewasm text representation
 		evmasm::LinkerObject ewasmObject; ///< Experimental Ewasm code
 		util::LazyInit<std::string const> metadata; ///< The metadata json that will be hashed into the chain.
@@ -386,19 +545,34 @@ private:
 		util::LazyInit<Json::Value const> devDocumentation;
 		util::LazyInit<Json::Value const> generatedSources;
 		util::LazyInit<Json::Value const> runtimeGeneratedSources;
+		util::LazyInit<Json::Value const> gasEstimates;
 		mutable std::optional<std::string const> sourceMapping;
 		mutable std::optional<std::string const> runtimeSourceMapping;
+		bool loadedFromCache = false; ///< Whether the code generation outputs were loaded from the cache.
+		util::CompilationStatistics statistics; ///< Statistics of the code generation for this contract.
+		bool released = false; ///< Whether everything above was freed by releaseContract.
 	};
 
 	/// Loads the missing sources from @a _ast (named @a _path) using the callback
 	/// @a m_readFile and stores the absolute paths of all imports in the AST annotations.
 	/// @returns the newly loaded sources.
 	StringMap loadMissingSources(SourceUnit const& _ast, std::string const& _path);
+
+	/// Replaces @a _source by the source kept from before the last reset, if incremental parsing is
+	/// enabled and the content did not change, and removes the results of analysing its AST.
+	/// If the content only changed inside the body of a function or modifier, only that body is
+	/// parsed again and stored in @a _reparsedBody, with IDs up to @a _maxID as in a new source.
+	/// @returns false if the source has to be parsed.
+	bool reuseParsedSource(std::string const& _path, Source& _source, ASTPointer<Block>& _reparsedBody, int64_t& _maxID);
 	std::string applyRemapping(std::string const& _path, std::string const& _context);
 	void resolveImports();
 
 	/// Store the contract definitions in m_contracts.
 	void storeContractDefinitions();
+	/// Builds m_astNodeIndex from the ASTs of all sources.
+	void indexASTNodes();
+	/// Assigns the indices returned by sourceIndices() to the sources.
+	void storeSourceIndices();
 
 	/// @returns true if the source is requested to be compiled.
 	bool isRequestedSource(std::string const& _sourceName) const;
@@ -406,6 +580,17 @@ private:
 	/// @returns true if the contract is requested to be compiled.
 	bool isRequestedContract(ContractDefinition const& _contract) const;
 
+	/// @returns the optimiser settings of @a _contract, taking its profile into account.
+	OptimiserSettings const& optimiserSettings(ContractDefinition const& _contract) const;
+	/// @returns the optimiser settings to generate and optimise the IR of @a _contract with,
+	/// which also contain the functions of its IR that are not inlined. Needs the call graphs.
+	OptimiserSettings irOptimiserSettings(ContractDefinition const& _contract) const;
+	/// @returns whether @a _contract is compiled via the IR, taking its profile into account.
+	bool viaIR(ContractDefinition const& _contract) const;
+	/// Reports an error and @returns false if a requested contract does not use the same
+	/// profile as a contract it creates. Warns about profiles of unknown contracts.
+	bool checkOptimisationProfiles();
+
 	/// Compile a single contract.
 	/// @param _otherCompilers provides access to compilers of other contracts, to get
 	///                        their bytecode if needed. Only filled after they have been compiled.
@@ -414,18 +599,59 @@ private:
 		std::map<ContractDefinition const*, std::shared_ptr<Compiler const>>& _otherCompilers
 	);
 
+	/// Builds the call graphs of @a _contract and stores them in its annotation,
+	/// unless that was done before.
+	static void buildCallGraphs(ContractDefinition const& _contract);
+
 	/// Generate Yul IR for a single contract.
 	/// The IR is stored but otherwise unused.
 	void generateIR(ContractDefinition const& _contract);
 
 	/// Generate EVM representation for a single contract.
 	/// Depends on output generated by generateIR.
-	void generateEVMFromIR(ContractDefinition const& _contract);
+	/// Only modifies the state of @a _contract and reports to @a _errorReporter, so it can
+	/// run concurrently for different contracts.
+	void generateEVMFromIR(ContractDefinition const& _contract, langutil::ErrorReporter& _errorReporter);
 
 	/// Generate Ewasm representation for a single contract.
 	/// Depends on output generated by generateIR.
+	/// Only modifies the state of @a _contract, so it can run concurrently for different contracts.
 	void generateEwasm(ContractDefinition const& _contract);
 
+	/// Loads the optimized IR of @a _contract into @a _stack. Uses the analyzed object generated
+	/// by generateIR if it has not been handed over yet and re-parses the printed IR otherwise.
+	static void loadOptimizedIR(Contract& _contract, yul::AssemblyStack& _stack);
+
+	/// @returns the key the code generation outputs of @a _contract are cached under.
+	/// It is a hash of the metadata (which contains the compiler version, the settings and
+	/// the hashes of all sources the contract depends on), the source indices and the
+	/// requested kinds of output.
+	util::h256 cacheKey(Contract const& _contract) const;
+
+	/// Loads the code generation outputs of @a _contract from the compilation cache and
+	/// reports the warnings code generation would have reported.
+	/// @returns false if the cache is not used or has no entry for the contract.
+	bool loadFromCache(ContractDefinition const& _contract);
+
+	/// Stores the code generation outputs of all compiled requested contracts
+	/// in the compilation cache. Has to be called before linking.
+	void storeInCache();
+
+	/// Empties the cache of the Yul optimizer results, which is placed into the "yul"
+	/// sub-directory of the compilation cache, if there is one.
+	void resetOptimisedCodeCache();
+
+	/// Warns if the contract requests the ABI coder v1, which the IR does not support.
+	void checkABICoderForIR(ContractDefinition const& _contract);
+
+	/// Warns if the runtime code of @a _contract exceeds the limit introduced in Spurious Dragon.
+	void checkCodeSize(Contract const& _contract, langutil::ErrorId _error, langutil::ErrorReporter& _errorReporter) const;
+
+	/// Reports the exception @a _exception thrown during code generation as an error,
+	/// if it is a code generation error or an unimplemented feature error with a
+	/// source location. Rethrows it otherwise.
+	void reportCodeGenerationError(std::exception_ptr const& _exception);
+
 	/// Links all the known library addresses in the available objects. Any unknown
 	/// library will still be kept as an unlinked placeholder in the objects.
 	void link();
@@ -439,11 +665,15 @@ private:
 	Source const& source(std::string const& _sourceName) const;
 
 	/// @returns the metadata JSON as a compact string for the given contract.
-	std::string createMetadata(Contract const& _contract) const;
+	/// If @a _sourceNames is true, the entries of the sources are replaced by their names.
+	std::string createMetadata(Contract const& _contract, bool _sourceNames = false) const;
 
 	/// @returns the metadata CBOR for the given serialised metadata JSON.
 	bytes createCBORMetadata(Contract const& _contract) const;
 
+	/// @returns the gas estimates of the given contracts, which are computed concurrently.
+	std::vector<Json::Value> estimateGas(std::vector<std::string> const& _contractNames) const;
+
 	/// @returns the contract ABI as a JSON object.
 	/// This will generate the JSON object and store it in the Contract object if it is not present yet.
 	Json::Value const& contractABI(Contract const&) const;
@@ -460,6 +690,10 @@ private:
 	/// This will generate the JSON object and store it in the Contract object if it is not present yet.
 	Json::Value const& natspecDev(Contract const&) const;
 
+	/// Parses the full contents of the doc strings and copies the inherited documentation,
+	/// which the analysis skips. Does nothing if this has already been done since the analysis.
+	void completeDocumentation() const;
+
 	/// @returns the Contract Metadata
 	/// This will generate the metadata and store it in the Contract object if it is not present yet.
 	std::string const& metadata(Contract const&) const;
@@ -476,30 +710,84 @@ private:
 	RevertStrings m_revertStrings = RevertStrings::Default;
 	State m_stopAfter = State::CompilationSuccessful;
 	bool m_viaIR = false;
+	std::map<std::string, OptimisationProfile> m_optimisationProfiles;
+	size_t m_parallelism = 1;
+	std::shared_ptr<CompilationCache const> m_compilationCache;
 	langutil::EVMVersion m_evmVersion;
 	ModelCheckerSettings m_modelCheckerSettings;
 	smtutil::SMTSolverChoice m_enabledSMTSolvers;
 	std::map<std::string, std::set<std::string>> m_requestedContractNames;
+	bool m_skipUnrequestedSources = false;
 	bool m_generateEvmBytecode = true;
 	bool m_generateIR = false;
 	bool m_generateEwasm = false;
+	bool m_incrementalParsing = false;
+	bool m_collectStatistics = false;
+	/// Statistics of the phases that are not specific to a contract.
+	util::CompilationStatistics m_statistics;
+	ModelCheckerStatistics m_modelCheckerStatistics;
+	/// Sources kept across the last reset for incremental parsing.
+	std::map<std::string, Source> m_previousSources;
+	langutil::EVMVersion m_previousSourcesEVMVersion;
+	/// Generation of the Yul string repository when the current sources were parsed.
+	size_t m_sourcesYulStringGeneration = 0;
+	size_t m_previousSourcesYulStringGeneration = 0;
+	/// Generation of the symbol table when the current sources were parsed, see langutil::Symbol.
+	size_t m_sourcesSymbolGeneration = 0;
+	size_t m_previousSourcesSymbolGeneration = 0;
+	/// Largest ID of any AST node created so far with incremental parsing enabled.
+	int64_t m_maxASTNodeID = 0;
+	ASTNodeIndex m_astNodeIndex;
+	/// Indices of the sources, assigned once they are parsed.
+	std::map<std::string, unsigned> m_sourceIndices;
 	std::map<std::string, util::h160> m_libraries;
 	/// list of path prefix remappings, e.g. mylibrary: github.com/ethereum = /usr/local/ethereum
 	/// "context:prefix=target"
 	std::vector<Remapping> m_remappings;
+	/// Index of the sanitized remappings, used to apply them to imports.
+	RemappingIndex m_remappingIndex;
 	std::map<std::string const, Source> m_sources;
 	// if imported, store AST-JSONS for each filename
 	std::map<std::string, Json::Value> m_sourceJsons;
 	std::vector<std::string> m_unhandledSMTLib2Queries;
 	std::map<util::h256, std::string> m_smtlib2Responses;
 	std::shared_ptr<GlobalContext> m_globalContext;
+	/// Provider of the types of this compilation.
+	std::shared_ptr<TypeProvider> m_typeProvider;
+	/// Yul utility and ABI coder functions generated for one contract that are reused for the others.
+	std::shared_ptr<SharedYulFunctionCache> m_sharedYulFunctions;
+	/// Library and free functions generated by the IR generator of one contract that are reused for the others.
+	std::shared_ptr<SharedIRFunctionCache> m_sharedIRFunctions;
+	/// Results of the Yul optimizer for objects that are part of several contracts,
+	/// stored on disk next to the compilation cache if there is one.
+	std::shared_ptr<yul::OptimisedCodeCache> m_optimisedCodeCache;
+	/// Inline assembly blocks of the legacy code generator, only kept during compile().
+	std::shared_ptr<InlineAssemblyCache> m_inlineAssemblyCache;
+	/// Representations of constants found by the legacy constant optimiser, only kept during compile().
+	std::shared_ptr<evmasm::ConstantOptimisationCache> m_constantOptimisationCache;
+	/// Assemblies of the objects that are part of the IR of several contracts, compiled from
+	/// the optimized IR only once, only kept during compile().
+	std::shared_ptr<yul::EVMObjectCache> m_evmObjectCache;
 	std::vector<Source const*> m_sourceOrder;
 	std::map<std::string const, Contract> m_contracts;
+	/// Sources whose ASTs are not freed by releaseContract.
+	std::set<std::string> m_keptASTs;
+	/// Number of unreleased contracts that can refer to the AST of each source.
+	/// Computed by the first call to releaseContract.
+	std::optional<std::map<std::string, size_t>> m_astReferences;
 	langutil::ErrorList m_errorList;
 	langutil::ErrorReporter m_errorReporter;
 	bool m_metadataLiteralSources = false;
 	MetadataHash m_metadataHash = MetadataHash::IPFS;
+	/// Serialized entries of the sources in the metadata by source name, guarded by the same mutex as
+	/// the hashes of the sources.
+	mutable std::map<std::string, std::string> m_metadataSourceEntries;
 	bool m_parserErrorRecovery = false;
+	/// Whether completeDocumentation has been run since the analysis, guarded by m_documentationMutex.
+	mutable bool m_documentationComplete = false;
+	mutable std::mutex m_documentationMutex;
+	/// Compiler stack whose analysis is used by this one, which also completes the documentation.
+	CompilerStack const* m_analysis = nullptr;
 	State m_stackState = Empty;
 	bool m_importedSources = false;
 	/// Whether or not there has been an error during processing.
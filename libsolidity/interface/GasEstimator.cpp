@@ -86,19 +86,27 @@ GasEstimator::GasConsumption GasEstimator::functionalEstimation(
 	size_t const& _offset,
 	FunctionDefinition const& _function
 ) const
+{
+	return functionalEstimation(_items, _offset, CompilerUtils::sizeOnStack(_function.parameters()));
+}
+
+GasEstimator::GasConsumption GasEstimator::functionalEstimation(
+	AssemblyItems const& _items,
+	size_t const& _offset,
+	unsigned _parametersSize
+) const
 {
 	auto state = make_shared<KnownState>();
 
-	unsigned parametersSize = CompilerUtils::sizeOnStack(_function.parameters());
-	if (parametersSize > 16)
+	if (_parametersSize > 16)
 		return GasConsumption::infinite();
 
 	// Store an invalid return value on the stack, so that the path estimator breaks upon reaching
 	// the return jump.
 	AssemblyItem invalidTag(PushTag, u256(-0x10));
 	state->feedItem(invalidTag, true);
-	if (parametersSize > 0)
-		state->feedItem(swapInstruction(parametersSize));
+	if (_parametersSize > 0)
+		state->feedItem(swapInstruction(_parametersSize));
 
 	return PathGasMeter::estimateMax(_items, m_evmVersion, _offset, state);
 }
@@ -64,6 +64,15 @@ public:
 		FunctionDefinition const& _function
 	) const;
 
+	/// @returns the estimated gas consumption by a function with parameters of @a _parametersSize
+	/// stack slots, which starts at the given offset into the list of assembly items.
+	/// Does not access the types, so it can be called concurrently.
+	GasConsumption functionalEstimation(
+		evmasm::AssemblyItems const& _items,
+		size_t const& _offset,
+		unsigned _parametersSize
+	) const;
+
 private:
 	/// @returns the set of AST nodes which are the finest nodes at their location.
 	static std::set<ASTNode const*> finestNodesAtLocation(std::vector<ASTNode const*> const& _roots);
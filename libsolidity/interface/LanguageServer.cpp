@@ -0,0 +1,527 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Language server that provides diagnostics and navigation to editors.
+ */
+
+#include <libsolidity/interface/LanguageServer.h>
+
+#include <libsolidity/ast/AST.h>
+#include <libsolidity/ast/ASTVisitor.h>
+#include <libsolidity/interface/Version.h>
+
+#include <liblangutil/CharStream.h>
+#include <liblangutil/Exceptions.h>
+#include <liblangutil/Symbol.h>
+
+#include <libsolutil/JSON.h>
+
+#include <libyul/YulString.h>
+
+#include <boost/algorithm/string.hpp>
+
+#include <istream>
+#include <ostream>
+#include <thread>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::langutil;
+using namespace solidity::frontend;
+
+namespace
+{
+
+/// Number of interned symbols after which the symbol table is reset before an analysis,
+/// so that all documents are parsed again.
+constexpr size_t maxKeptSymbols = 1 << 20;
+/// Number of Yul strings after which the Yul string repository is reset before an analysis,
+/// so that all documents are parsed again.
+constexpr size_t maxKeptYulStrings = 1 << 20;
+
+/// Error codes of JSON-RPC and of the language server protocol.
+enum class ErrorCode
+{
+	ParseError = -32700,
+	InvalidRequest = -32600,
+	MethodNotFound = -32601,
+	InvalidParams = -32602,
+	ServerNotInitialized = -32002,
+	RequestCancelled = -32800
+};
+
+struct RequestError
+{
+	ErrorCode code;
+	string message;
+};
+
+enum class DiagnosticSeverity
+{
+	Error = 1,
+	Warning = 2
+};
+
+/// Methods of the notifications that change the documents.
+set<string> const documentNotifications{
+	"textDocument/didOpen",
+	"textDocument/didChange",
+	"textDocument/didClose"
+};
+
+string requireString(Json::Value const& _object, string const& _member)
+{
+	if (!_object.isObject() || !_object[_member].isString())
+		throw RequestError{ErrorCode::InvalidParams, "\"" + _member + "\" must be a string."};
+	return _object[_member].asString();
+}
+
+int requireInt(Json::Value const& _object, string const& _member)
+{
+	if (!_object.isObject() || !_object[_member].isInt())
+		throw RequestError{ErrorCode::InvalidParams, "\"" + _member + "\" must be an integer."};
+	return _object[_member].asInt();
+}
+
+class NodeIDCollector: private ASTConstVisitor
+{
+public:
+	explicit NodeIDCollector(vector<int64_t>& _ids): m_ids(_ids) {}
+	void collect(ASTNode const& _root) { _root.accept(*this); }
+
+private:
+	bool visitNode(ASTNode const& _node) override
+	{
+		m_ids.push_back(_node.id());
+		return true;
+	}
+
+	vector<int64_t>& m_ids;
+};
+
+}
+
+optional<Json::Value> LSPStreamTransport::receive()
+{
+	optional<size_t> length;
+	string line;
+	while (getline(m_input, line))
+	{
+		boost::trim(line);
+		if (line.empty())
+			break;
+		string const lengthHeader = "content-length:";
+		if (boost::istarts_with(line, lengthHeader))
+		{
+			string value = boost::trim_copy(line.substr(lengthHeader.size()));
+			if (!value.empty() && value.size() <= 9 && boost::all(value, boost::is_digit()))
+				length = stoul(value);
+		}
+	}
+	if (!m_input)
+		return nullopt;
+	if (!length)
+		return Json::Value{};
+
+	string content(*length, '\0');
+	if (!m_input.read(content.data(), static_cast<streamsize>(content.size())))
+		return nullopt;
+	Json::Value message;
+	if (!util::jsonParseStrict(content, message))
+		return Json::Value{};
+	return message;
+}
+
+void LSPStreamTransport::send(Json::Value const& _message)
+{
+	string const content = util::jsonCompactPrint(_message);
+	m_output << "Content-Length: " << content.size() << "\r\n\r\n" << content << flush;
+}
+
+LanguageServer::LanguageServer(LSPTransport& _transport, ReadCallback::Callback _readFile):
+	m_transport(_transport),
+	m_compiler(move(_readFile))
+{
+	m_compiler.setParserErrorRecovery(true);
+	m_compiler.enableIncrementalParsing();
+}
+
+bool LanguageServer::run()
+{
+	thread reader([this]() { readMessages(); });
+	while (!m_exited)
+	{
+		Json::Value message;
+		{
+			unique_lock<mutex> lock(m_mutex);
+			if (m_messages.empty() && m_outdated)
+			{
+				lock.unlock();
+				analyze();
+				continue;
+			}
+			m_messageAvailable.wait(lock, [&]() { return !m_messages.empty() || m_inputEnded; });
+			if (m_messages.empty())
+				break;
+			message = move(m_messages.front());
+			m_messages.pop_front();
+		}
+		handleMessage(message);
+	}
+	reader.join();
+	return m_exited && m_shutdown;
+}
+
+void LanguageServer::readMessages()
+{
+	while (optional<Json::Value> message = m_transport.receive())
+	{
+		bool const exit = message->isObject() && (*message)["method"] == "exit";
+		lock_guard<mutex> lock(m_mutex);
+		// Cancellations are noted right away so that they overtake the pending requests.
+		if (message->isObject() && (*message)["method"] == "$/cancelRequest")
+			m_cancelledRequests.insert(util::jsonCompactPrint((*message)["params"]["id"]));
+		else
+			m_messages.emplace_back(move(*message));
+		m_messageAvailable.notify_one();
+		if (exit)
+			return;
+	}
+	lock_guard<mutex> lock(m_mutex);
+	m_inputEnded = true;
+	m_messageAvailable.notify_one();
+}
+
+void LanguageServer::handleMessage(Json::Value const& _message)
+{
+	Json::Value response;
+	response["jsonrpc"] = "2.0";
+	if (!_message.isObject())
+	{
+		response["id"] = Json::nullValue;
+		response["error"]["code"] = static_cast<int>(ErrorCode::ParseError);
+		response["error"]["message"] = "Invalid message.";
+		send(response);
+		return;
+	}
+	// Responses to requests of the server are not needed.
+	if (!_message.isMember("method"))
+		return;
+
+	bool const isRequest = _message.isMember("id");
+	response["id"] = _message["id"];
+	try
+	{
+		if (!_message["method"].isString())
+			throw RequestError{ErrorCode::InvalidRequest, "\"method\" must be a string."};
+		string const method = _message["method"].asString();
+		if (!m_initialized && method != "initialize" && method != "exit")
+			throw RequestError{ErrorCode::ServerNotInitialized, "The server is not initialized."};
+		if (m_shutdown && method != "exit")
+			throw RequestError{ErrorCode::InvalidRequest, "The server is shut down."};
+
+		if (isRequest)
+		{
+			bool cancelled = false;
+			{
+				lock_guard<mutex> lock(m_mutex);
+				cancelled = m_cancelledRequests.erase(util::jsonCompactPrint(_message["id"])) > 0;
+			}
+			if (cancelled)
+				throw RequestError{ErrorCode::RequestCancelled, "The request was cancelled."};
+			response["result"] = handleRequest(method, _message["params"]);
+		}
+		else
+			handleNotification(method, _message["params"]);
+	}
+	catch (RequestError const& _error)
+	{
+		response["error"]["code"] = static_cast<int>(_error.code);
+		response["error"]["message"] = _error.message;
+	}
+	catch (Json::Exception const&)
+	{
+		response["error"]["code"] = static_cast<int>(ErrorCode::InvalidParams);
+		response["error"]["message"] = "Invalid parameters.";
+	}
+
+	if (isRequest)
+		send(response);
+}
+
+Json::Value LanguageServer::handleRequest(string const& _method, Json::Value const& _params)
+{
+	if (_method == "initialize")
+	{
+		m_initialized = true;
+		Json::Value result;
+		// Incremental synchronization of the documents.
+		result["capabilities"]["textDocumentSync"]["openClose"] = true;
+		result["capabilities"]["textDocumentSync"]["change"] = 2;
+		result["capabilities"]["definitionProvider"] = true;
+		result["serverInfo"]["name"] = "solc";
+		result["serverInfo"]["version"] = VersionString;
+		return result;
+	}
+	else if (_method == "shutdown")
+	{
+		m_shutdown = true;
+		return Json::nullValue;
+	}
+	else if (_method == "textDocument/definition")
+		return definition(_params);
+	throw RequestError{ErrorCode::MethodNotFound, "Unknown method \"" + _method + "\"."};
+}
+
+void LanguageServer::handleNotification(string const& _method, Json::Value const& _params)
+{
+	if (_method == "exit")
+		m_exited = true;
+	else if (_method == "textDocument/didOpen")
+	{
+		Json::Value const& textDocument = _params["textDocument"];
+		string const uri = requireString(textDocument, "uri");
+		m_documents[sourceName(uri)] = Document{uri, requireString(textDocument, "text")};
+		m_outdated = true;
+	}
+	else if (_method == "textDocument/didChange")
+		changeDocument(_params);
+	else if (_method == "textDocument/didClose")
+	{
+		auto document = m_documents.find(sourceName(requireString(_params["textDocument"], "uri")));
+		if (document != m_documents.end())
+		{
+			publishDiagnostics(document->second, Json::arrayValue);
+			m_documents.erase(document);
+			m_outdated = true;
+		}
+	}
+}
+
+void LanguageServer::changeDocument(Json::Value const& _params)
+{
+	string const name = sourceName(requireString(_params["textDocument"], "uri"));
+	auto document = m_documents.find(name);
+	if (document == m_documents.end())
+		throw RequestError{ErrorCode::InvalidParams, "Document \"" + name + "\" is not open."};
+	if (!_params["contentChanges"].isArray())
+		throw RequestError{ErrorCode::InvalidParams, "\"contentChanges\" must be an array."};
+
+	string& text = document->second.text;
+	for (Json::Value const& change: _params["contentChanges"])
+	{
+		string const newText = requireString(change, "text");
+		if (!change.isMember("range"))
+		{
+			text = newText;
+			continue;
+		}
+		CharStream const stream(text, name);
+		optional<int> start = stream.translateLineColumnToPosition(
+			requireInt(change["range"]["start"], "line"),
+			requireInt(change["range"]["start"], "character")
+		);
+		optional<int> end = stream.translateLineColumnToPosition(
+			requireInt(change["range"]["end"], "line"),
+			requireInt(change["range"]["end"], "character")
+		);
+		if (!start || !end || *end < *start)
+			throw RequestError{ErrorCode::InvalidParams, "Invalid range."};
+		text.replace(static_cast<size_t>(*start), static_cast<size_t>(*end - *start), newText);
+	}
+	m_outdated = true;
+}
+
+Json::Value LanguageServer::definition(Json::Value const& _params)
+{
+	string const name = sourceName(requireString(_params["textDocument"], "uri"));
+	if (!m_documents.count(name))
+		throw RequestError{ErrorCode::InvalidParams, "Document \"" + name + "\" is not open."};
+	// The edits before the request have to be taken into account.
+	if (m_outdated)
+		analyze();
+
+	CharStream const* stream = m_compiler.charStream(name);
+	if (!stream)
+		return Json::nullValue;
+	optional<int> position = stream->translateLineColumnToPosition(
+		requireInt(_params["position"], "line"),
+		requireInt(_params["position"], "character")
+	);
+	ASTNode const* node = position ? nodeAt(name, *position) : nullptr;
+
+	SourceLocation location;
+	if (auto const* identifier = dynamic_cast<Identifier const*>(node))
+		node = identifier->annotation().referencedDeclaration;
+	else if (auto const* path = dynamic_cast<IdentifierPath const*>(node))
+		node = path->annotation().referencedDeclaration;
+	else if (auto const* memberAccess = dynamic_cast<MemberAccess const*>(node))
+		node = memberAccess->annotation().referencedDeclaration;
+	else if (auto const* import = dynamic_cast<ImportDirective const*>(node))
+		node = import->annotation().sourceUnit;
+	else if (!dynamic_cast<Declaration const*>(node))
+		node = nullptr;
+
+	if (!node)
+		return Json::nullValue;
+	if (auto const* declaration = dynamic_cast<Declaration const*>(node); declaration && declaration->nameLocation().hasText())
+		location = declaration->nameLocation();
+	else
+		location = node->location();
+	// Built-in declarations have no location.
+	if (!location.hasText())
+		return Json::nullValue;
+
+	Json::Value result;
+	auto document = m_documents.find(*location.sourceName);
+	result["uri"] = document != m_documents.end() ? document->second.uri : "file://" + *location.sourceName;
+	result["range"] = toRange(location);
+	return result;
+}
+
+void LanguageServer::analyze()
+{
+	m_outdated = false;
+	m_nodeIDs.clear();
+
+	StringMap sources;
+	for (auto const& [name, document]: m_documents)
+		sources[name] = document.text;
+	// The names of the kept ASTs are not used before the compiler stack notices the resets.
+	if (yul::YulStringRepository::instance().size() > maxKeptYulStrings)
+		yul::YulStringRepository::reset();
+	if (Symbol::size() > maxKeptSymbols)
+		Symbol::reset();
+	m_compiler.reset(true);
+	m_compiler.setSources(move(sources));
+	try
+	{
+		m_compiler.parseAndAnalyze(CompilerStack::State::AnalysisPerformed);
+	}
+	catch (util::Exception const& _exception)
+	{
+		Json::Value message;
+		message["jsonrpc"] = "2.0";
+		message["method"] = "window/logMessage";
+		message["params"]["type"] = static_cast<int>(DiagnosticSeverity::Error);
+		message["params"]["message"] = "Analysis failed: " + boost::diagnostic_information(_exception);
+		send(message);
+	}
+
+	{
+		lock_guard<mutex> lock(m_mutex);
+		for (Json::Value const& message: m_messages)
+			if (message.isObject() && documentNotifications.count(message["method"].asString()))
+				return;
+	}
+
+	map<string, Json::Value> diagnostics;
+	for (auto const& [name, document]: m_documents)
+		diagnostics[name] = Json::arrayValue;
+	for (shared_ptr<Error const> const& error: m_compiler.errors())
+	{
+		SourceLocation const* location = boost::get_error_info<errinfo_sourceLocation>(*error);
+		if (!location || !location->hasText() || !diagnostics.count(*location->sourceName))
+			continue;
+
+		Json::Value diagnostic;
+		diagnostic["range"] = toRange(*location);
+		diagnostic["severity"] = static_cast<int>(
+			error->type() == Error::Type::Warning ? DiagnosticSeverity::Warning : DiagnosticSeverity::Error
+		);
+		diagnostic["code"] = Json::UInt64(error->errorId().error);
+		diagnostic["source"] = "solc";
+		diagnostic["message"] = error->typeName() + ": " + (error->comment() ? *error->comment() : string{});
+		if (auto const* secondary = boost::get_error_info<errinfo_secondarySourceLocation>(*error))
+			for (auto const& [message, secondaryLocation]: secondary->infos)
+			{
+				if (!secondaryLocation.hasText())
+					continue;
+				auto document = m_documents.find(*secondaryLocation.sourceName);
+				Json::Value information;
+				information["location"]["uri"] =
+					document != m_documents.end() ? document->second.uri : "file://" + *secondaryLocation.sourceName;
+				information["location"]["range"] = toRange(secondaryLocation);
+				information["message"] = message;
+				diagnostic["relatedInformation"].append(information);
+			}
+		diagnostics[*location->sourceName].append(diagnostic);
+	}
+	for (auto& [name, documentDiagnostics]: diagnostics)
+		publishDiagnostics(m_documents.at(name), move(documentDiagnostics));
+}
+
+void LanguageServer::publishDiagnostics(Document const& _document, Json::Value _diagnostics)
+{
+	Json::Value notification;
+	notification["jsonrpc"] = "2.0";
+	notification["method"] = "textDocument/publishDiagnostics";
+	notification["params"]["uri"] = _document.uri;
+	notification["params"]["diagnostics"] = move(_diagnostics);
+	send(notification);
+}
+
+ASTNode const* LanguageServer::nodeAt(string const& _sourceName, int _position)
+{
+	auto nodeIDs = m_nodeIDs.find(_sourceName);
+	if (nodeIDs == m_nodeIDs.end())
+	{
+		nodeIDs = m_nodeIDs.emplace(_sourceName, vector<int64_t>{}).first;
+		try
+		{
+			NodeIDCollector{nodeIDs->second}.collect(m_compiler.ast(_sourceName));
+		}
+		catch (CompilerError const&)
+		{
+			// The source could not be parsed at all.
+		}
+	}
+
+	// The nodes that contain the position are visited from the outermost to the innermost.
+	ASTNode const* innermost = nullptr;
+	for (int64_t id: nodeIDs->second)
+		if (ASTNode const* node = m_compiler.astNodeIndex().node(id))
+			if (node->location().start <= _position && _position <= node->location().end)
+				innermost = node;
+	return innermost;
+}
+
+Json::Value LanguageServer::toRange(SourceLocation const& _location) const
+{
+	CharStream const* stream = m_compiler.charStream(*_location.sourceName);
+	solAssert(stream, "");
+	auto [startLine, startColumn] = stream->translatePositionToLineColumn(_location.start);
+	auto [endLine, endColumn] = stream->translatePositionToLineColumn(_location.end);
+	Json::Value range;
+	range["start"]["line"] = startLine;
+	range["start"]["character"] = startColumn;
+	range["end"]["line"] = endLine;
+	range["end"]["character"] = endColumn;
+	return range;
+}
+
+string LanguageServer::sourceName(string const& _uri)
+{
+	string const scheme = "file://";
+	return boost::starts_with(_uri, scheme) ? _uri.substr(scheme.size()) : _uri;
+}
+
+void LanguageServer::send(Json::Value const& _message)
+{
+	m_transport.send(_message);
+}
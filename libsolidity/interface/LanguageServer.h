@@ -0,0 +1,150 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Language server that provides diagnostics and navigation to editors.
+ */
+
+#pragma once
+
+#include <libsolidity/interface/CompilerStack.h>
+#include <libsolidity/interface/ReadFile.h>
+
+#include <json/json.h>
+
+#include <condition_variable>
+#include <deque>
+#include <iosfwd>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace solidity::frontend
+{
+
+/**
+ * Transport of the JSON-RPC messages of the language server protocol.
+ */
+class LSPTransport
+{
+public:
+	virtual ~LSPTransport() = default;
+
+	/// @returns the next message or nullopt at the end of the input. Messages that are not
+	/// valid JSON are returned as null values.
+	virtual std::optional<Json::Value> receive() = 0;
+	virtual void send(Json::Value const& _message) = 0;
+};
+
+/**
+ * Transport over a pair of streams, where every message is preceded by a header
+ * containing its length, as defined by the language server protocol.
+ */
+class LSPStreamTransport: public LSPTransport
+{
+public:
+	LSPStreamTransport(std::istream& _input, std::ostream& _output): m_input(_input), m_output(_output) {}
+
+	std::optional<Json::Value> receive() override;
+	void send(Json::Value const& _message) override;
+
+private:
+	std::istream& m_input;
+	std::ostream& m_output;
+};
+
+/**
+ * Server of the language server protocol. Analyses the documents open in the editor whenever
+ * they change and publishes the errors and warnings, and answers requests for the definition
+ * of the name at a position.
+ *
+ * Documents are parsed incrementally, i.e. only the documents that changed are parsed again,
+ * and no code is generated. Messages are read on a separate thread, so that edits arriving
+ * while the documents are analysed are seen right afterwards: The documents are only analysed
+ * once no more messages are pending and the diagnostics of an analysis are dropped if newer
+ * edits have already arrived.
+ *
+ * Positions are given in bytes rather than in UTF-16 code units, i.e. columns are only
+ * correct for lines that consist of ASCII characters.
+ */
+class LanguageServer
+{
+public:
+	/// @param _readFile callback used to read the imported files that are not open in the editor.
+	explicit LanguageServer(LSPTransport& _transport, ReadCallback::Callback _readFile = ReadCallback::Callback());
+
+	/// Handles messages until the exit notification or the end of the input.
+	/// @returns true if the server was shut down before it exited.
+	bool run();
+
+private:
+	struct Document
+	{
+		std::string uri;
+		std::string text;
+	};
+
+	/// Reads messages from the transport into the queue until the end of the input
+	/// or the exit notification. Runs on its own thread.
+	void readMessages();
+
+	void handleMessage(Json::Value const& _message);
+	Json::Value handleRequest(std::string const& _method, Json::Value const& _params);
+	void handleNotification(std::string const& _method, Json::Value const& _params);
+
+	void changeDocument(Json::Value const& _params);
+	Json::Value definition(Json::Value const& _params);
+
+	/// Analyses the open documents and publishes the diagnostics unless edits are pending.
+	void analyze();
+	void publishDiagnostics(Document const& _document, Json::Value _diagnostics);
+	/// @returns the innermost node that contains @a _position in the source @a _sourceName.
+	ASTNode const* nodeAt(std::string const& _sourceName, int _position);
+	/// @returns the range of @a _location in the format of the language server protocol.
+	Json::Value toRange(langutil::SourceLocation const& _location) const;
+	/// @returns the source name of @a _uri, i.e. its path for file URIs.
+	static std::string sourceName(std::string const& _uri);
+
+	void send(Json::Value const& _message);
+
+	LSPTransport& m_transport;
+	CompilerStack m_compiler;
+
+	std::mutex m_mutex;
+	std::condition_variable m_messageAvailable;
+	std::deque<Json::Value> m_messages;
+	bool m_inputEnded = false;
+	/// IDs of the requests cancelled by the client before they were handled.
+	std::set<std::string> m_cancelledRequests;
+
+	/// Documents open in the editor by source name.
+	std::map<std::string, Document> m_documents;
+	/// Whether the documents changed since the last analysis.
+	bool m_outdated = false;
+	/// IDs of the nodes of each analysed source in the order of a depth-first traversal,
+	/// computed when the source is first queried.
+	std::map<std::string, std::vector<int64_t>> m_nodeIDs;
+
+	bool m_initialized = false;
+	bool m_shutdown = false;
+	bool m_exited = false;
+};
+
+}
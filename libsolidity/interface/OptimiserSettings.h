@@ -23,7 +23,12 @@
 
 #pragma once
 
+#include <chrono>
 #include <cstddef>
+#include <cstdint>
+#include <map>
+#include <optional>
+#include <set>
 #include <string>
 
 namespace solidity::frontend
@@ -97,7 +102,10 @@ struct OptimiserSettings
 			optimizeStackAllocation == _other.optimizeStackAllocation &&
 			runYulOptimiser == _other.runYulOptimiser &&
 			yulOptimiserSteps == _other.yulOptimiserSteps &&
-			expectedExecutionsPerDeployment == _other.expectedExecutionsPerDeployment;
+			optimizeStackLayout == _other.optimizeStackLayout &&
+			yulReuseAcrossObjects == _other.yulReuseAcrossObjects &&
+			expectedExecutionsPerDeployment == _other.expectedExecutionsPerDeployment &&
+			functionWeights == _other.functionWeights;
 	}
 
 	/// Move literals to the right of commutative binary operators during code generation.
@@ -125,9 +133,32 @@ struct OptimiserSettings
 	/// them just by setting this to an empty string. Set @a runYulOptimiser to false if you want
 	/// no optimisations.
 	std::string yulOptimiserSteps = DefaultYulOptimiserSteps;
+	/// Wall-clock time after which the Yul optimiser skips the rest of the sequence
+	/// of optimisation steps and only runs its hard-coded final steps. The output then depends on
+	/// the speed of the machine, so this is only meant for development builds.
+	/// Since the output cannot be reproduced from it, the budget is not compared, not part of the
+	/// metadata and no caches are used while it is set.
+	std::optional<std::chrono::milliseconds> yulOptimiserTimeBudget;
+	/// Re-generate the stack operations of each basic block of the EVM code generated from Yul
+	/// from the data flow of the block, using the common subexpression eliminator and peephole
+	/// optimiser of the EVM assembly.
+	bool optimizeStackLayout = false;
+	/// Reuse the results of function-local Yul optimiser steps on the functions of sub-objects
+	/// for the functions of the containing object that only differ in the names of their variables,
+	/// e.g. for the helper functions shared by the creation and the runtime code.
+	bool yulReuseAcrossObjects = false;
 	/// This specifies an estimate on how often each opcode in this assembly will be executed,
 	/// i.e. use a small value to optimise for size and a large value to optimise for runtime gas usage.
 	size_t expectedExecutionsPerDeployment = 200;
+	/// Relative execution frequencies of external functions, e.g. taken from recorded call traces,
+	/// keyed by function selector in the form "0x12345678". Functions that are not listed have weight zero.
+	/// The function dispatcher checks for frequently called functions first.
+	std::map<std::string, uint64_t> functionWeights;
+	/// Names of Yul functions that the Yul optimiser does not inline into their callers, e.g. the
+	/// functions generated for Solidity functions marked with ``@optimizer noinline``.
+	/// They are determined by the sources and not by the settings, which is why they do not take
+	/// part in the comparison and are not part of the metadata.
+	std::set<std::string> yulNoInlineFunctions;
 };
 
 }
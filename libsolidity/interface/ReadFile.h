@@ -40,7 +40,9 @@ public:
 	enum class Kind
 	{
 		ReadFile,
-		SMTQuery
+		SMTQuery,
+		/// A JSON array of SMT queries, answered by a JSON array of responses in the same order.
+		SMTQueryBatch
 	};
 
 	static std::string kindString(Kind _kind)
@@ -51,6 +53,8 @@ public:
 			return "source";
 		case Kind::SMTQuery:
 			return "smt-query";
+		case Kind::SMTQueryBatch:
+			return "smt-query-batch";
 		default:
 			solAssert(false, "");
 		}
@@ -0,0 +1,85 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Index of the import remappings.
+ */
+
+#include <libsolidity/interface/RemappingIndex.h>
+
+using namespace std;
+using namespace solidity::frontend;
+
+template <typename T>
+T& RemappingIndex::Trie<T>::operator[](string_view _key)
+{
+	size_t node = 0;
+	for (char c: _key)
+	{
+		auto const [child, inserted] = nodes[node].children.emplace(c, nodes.size());
+		node = child->second;
+		if (inserted)
+			nodes.emplace_back();
+	}
+	if (!nodes[node].value)
+		nodes[node].value.emplace();
+	return *nodes[node].value;
+}
+
+template <typename T>
+template <typename Visitor>
+void RemappingIndex::Trie<T>::visitPrefixes(string_view _text, Visitor&& _visit) const
+{
+	size_t node = 0;
+	for (size_t length = 0; ; ++length)
+	{
+		if (nodes[node].value)
+			_visit(length, *nodes[node].value);
+		if (length == _text.size())
+			break;
+		auto child = nodes[node].children.find(_text[length]);
+		if (child == nodes[node].children.end())
+			break;
+		node = child->second;
+	}
+}
+
+void RemappingIndex::add(string const& _context, string const& _prefix, string const& _target)
+{
+	// Remappings added later take precedence over earlier ones with the same context and prefix.
+	m_contexts[_context][_prefix] = _target;
+}
+
+string RemappingIndex::apply(string const& _path, string const& _context) const
+{
+	vector<Trie<string> const*> contexts;
+	m_contexts.visitPrefixes(_context, [&](size_t, Trie<string> const& _prefixes) {
+		contexts.push_back(&_prefixes);
+	});
+
+	// The remappings of the longest context that has a matching prefix take precedence.
+	for (auto prefixes = contexts.rbegin(); prefixes != contexts.rend(); ++prefixes)
+	{
+		optional<pair<size_t, string const*>> longestPrefix;
+		(*prefixes)->visitPrefixes(_path, [&](size_t _length, string const& _target) {
+			longestPrefix = {_length, &_target};
+		});
+		if (longestPrefix)
+			return *longestPrefix->second + _path.substr(longestPrefix->first);
+	}
+	return _path;
+}
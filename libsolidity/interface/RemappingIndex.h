@@ -0,0 +1,76 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Index of the import remappings.
+ */
+
+#pragma once
+
+#include <map>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace solidity::frontend
+{
+
+/**
+ * Finds the remapping to apply to an import with one walk over the path of the importing
+ * source and one walk over the import path per matching context, instead of comparing
+ * against every remapping.
+ *
+ * A remapping applies to an import if its context is a prefix of the path of the importing
+ * source and its prefix is a prefix of the import path. Of these, the one with the longest
+ * context is applied, then the one with the longest prefix and then the one added last.
+ */
+class RemappingIndex
+{
+public:
+	/// Adds a remapping. The paths have to be sanitized already.
+	void add(std::string const& _context, std::string const& _prefix, std::string const& _target);
+	void clear() { m_contexts = {}; }
+
+	/// @returns @a _path imported from the source @a _context after applying the remapping to it.
+	std::string apply(std::string const& _path, std::string const& _context) const;
+
+private:
+	/// Character trie, whose nodes store values for the keys ending at them.
+	template <typename T>
+	struct Trie
+	{
+		struct Node
+		{
+			std::map<char, size_t> children;
+			std::optional<T> value;
+		};
+		std::vector<Node> nodes{1};
+
+		/// @returns the value stored for @a _key, inserting an empty one if there is none.
+		T& operator[](std::string_view _key);
+		/// Calls @a _visit with the length and the value of every key that is a prefix of @a _text,
+		/// in order of increasing length.
+		template <typename Visitor>
+		void visitPrefixes(std::string_view _text, Visitor&& _visit) const;
+	};
+
+	/// Targets keyed by prefix, trie of these keyed by context.
+	Trie<Trie<std::string>> m_contexts;
+};
+
+}
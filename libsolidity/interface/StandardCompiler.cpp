@@ -24,20 +24,27 @@
 #include <libsolidity/interface/StandardCompiler.h>
 
 #include <libsolidity/ast/ASTJsonConverter.h>
+#include <libsolidity/ast/TypeProvider.h>
 #include <libyul/AssemblyStack.h>
 #include <libyul/Exceptions.h>
 #include <libyul/optimiser/Suite.h>
 #include <liblangutil/SourceReferenceFormatter.h>
+#include <liblangutil/Symbol.h>
 #include <libevmasm/Instruction.h>
 #include <libsmtutil/Exceptions.h>
 #include <libsolutil/JSON.h>
+#include <libsolutil/JsonWriter.h>
 #include <libsolutil/Keccak256.h>
+#include <libsolutil/MemoryAccounting.h>
 #include <libsolutil/CommonData.h>
+#include <libsolutil/ThreadPool.h>
 
+#include <boost/algorithm/string/case_conv.hpp>
 #include <boost/algorithm/string/predicate.hpp>
 
 #include <algorithm>
 #include <optional>
+#include <sstream>
 
 using namespace std;
 using namespace solidity;
@@ -82,9 +89,9 @@ Json::Value formatFatalError(string const& _type, string const& _message)
 Json::Value formatSourceLocation(SourceLocation const* location)
 {
 	Json::Value sourceLocation;
-	if (location && location->source && !location->source->name().empty())
+	if (location && location->sourceName && !location->sourceName->empty())
 	{
-		sourceLocation["file"] = location->source->name();
+		sourceLocation["file"] = *location->sourceName;
 		sourceLocation["start"] = location->start;
 		sourceLocation["end"] = location->end;
 	}
@@ -108,6 +115,7 @@ Json::Value formatSecondarySourceLocation(SecondarySourceLocation const* _second
 }
 
 Json::Value formatErrorWithException(
+	CharStreamProvider const& _charStreamProvider,
 	util::Exception const& _exception,
 	bool const& _warning,
 	string const& _type,
@@ -118,7 +126,11 @@ Json::Value formatErrorWithException(
 {
 	string message;
 	// TODO: consider enabling color
-	string formattedMessage = SourceReferenceFormatter::formatExceptionInformation(_exception, _type);
+	string formattedMessage = SourceReferenceFormatter::formatExceptionInformation(
+		_exception,
+		_type,
+		_charStreamProvider
+	);
 
 	if (string const* description = boost::get_error_info<util::errinfo_comment>(_exception))
 		message = ((_message.length() > 0) ? (_message + ":") : "") + *description;
@@ -156,8 +168,29 @@ map<string, set<string>> requestedContractNames(Json::Value const& _outputSelect
 	return contracts;
 }
 
+/// @returns a key that is equal for jobs whose @a _settings lead to the same result
+/// of parsing and analysis, whatever code generation settings they use.
+string analysisKey(
+	Json::Value const& _settings,
+	OptimiserSettings const& _optimiserSettings,
+	Json::Value const& _outputSelection
+)
+{
+	Json::Value key(Json::objectValue);
+	for (char const* setting: {"evmVersion", "modelChecker", "parserErrorRecovery", "remappings", "skipUnrequestedSources", "stopAfter"})
+		if (_settings.isMember(setting))
+			key[setting] = _settings[setting];
+	// The syntax checker depends on whether the Yul optimizer runs, the analysed
+	// sources on the sources from which contracts are requested.
+	key["runYulOptimiser"] = _optimiserSettings.runYulOptimiser;
+	key["requestedSources"] = Json::arrayValue;
+	for (auto const& [sourceName, contracts]: requestedContractNames(_outputSelection))
+		key["requestedSources"].append(sourceName);
+	return util::jsonCompactPrint(key);
+}
+
 /// Returns true iff @a _hash (hex with 0x prefix) is the Keccak256 hash of the binary data in @a _content.
-bool hashMatchesContent(string const& _hash, string const& _content)
+bool hashMatchesContent(string const& _hash, bytesConstRef _content)
 {
 	try
 	{
@@ -183,7 +216,8 @@ bool isArtifactRequested(Json::Value const& _outputSelection, string const& _art
 		else if (selectedArtifact == "*")
 		{
 			// "ir", "irOptimized", "wast" and "ewasm.wast" can only be matched by "*" if activated.
-			if (experimental.count(_artifact) == 0 || _wildcardMatchesExperimental)
+			// "compilationStats" differs between runs and is never matched by "*".
+			if (_artifact != "compilationStats" && (experimental.count(_artifact) == 0 || _wildcardMatchesExperimental))
 				return true;
 		}
 	}
@@ -322,6 +356,99 @@ bool isIRRequested(Json::Value const& _outputSelection)
 	return false;
 }
 
+/// @returns true if the compilation statistics were requested for any contract.
+bool isCompilationStatisticsRequested(Json::Value const& _outputSelection)
+{
+	if (!_outputSelection.isObject())
+		return false;
+
+	for (auto const& fileRequests: _outputSelection)
+		for (auto const& requests: fileRequests)
+			for (auto const& request: requests)
+				if (request == "compilationStats")
+					return true;
+
+	return false;
+}
+
+Json::Value formatCompilationStatistics(util::CompilationStatistics const& _statistics)
+{
+	auto microseconds = [](chrono::nanoseconds _time) {
+		return Json::UInt64(chrono::duration_cast<chrono::microseconds>(_time).count());
+	};
+
+	Json::Value ret(Json::objectValue);
+	ret["phases"] = Json::objectValue;
+	for (auto const& [name, phase]: _statistics.phases())
+	{
+		Json::Value& phaseJson = ret["phases"][name];
+		phaseJson["runs"] = Json::UInt64(phase.runs);
+		phaseJson["time"] = microseconds(phase.time);
+		phaseJson["peakMemory"] = Json::UInt64(phase.peakMemory);
+	}
+	ret["optimiserSteps"] = Json::objectValue;
+	for (auto const& [name, step]: _statistics.optimiserSteps())
+	{
+		Json::Value& stepJson = ret["optimiserSteps"][name];
+		stepJson["runs"] = Json::UInt64(step.runs);
+		stepJson["changes"] = Json::UInt64(step.changes);
+		stepJson["time"] = microseconds(step.time);
+	}
+	ret["caches"] = Json::objectValue;
+	for (auto const& [name, cache]: _statistics.caches())
+	{
+		Json::Value& cacheJson = ret["caches"][name];
+		cacheJson["hits"] = Json::UInt64(cache.hits);
+		cacheJson["misses"] = Json::UInt64(cache.misses);
+	}
+	ret["counters"] = Json::objectValue;
+	for (auto const& [name, count]: _statistics.counters())
+		ret["counters"][name] = Json::UInt64(count);
+	return ret;
+}
+
+Json::Value formatMemoryUsage()
+{
+	Json::Value ret(Json::objectValue);
+	ret["subsystems"] = Json::objectValue;
+	for (size_t i = 0; i < util::MemoryAccounting::SubsystemCount; ++i)
+	{
+		auto const subsystem = static_cast<util::MemorySubsystem>(i);
+		util::MemoryAccounting::Usage const usage = util::MemoryAccounting::usage(subsystem);
+		Json::Value& subsystemJson = ret["subsystems"][util::MemoryAccounting::name(subsystem)];
+		subsystemJson["allocations"] = Json::UInt64(usage.allocations);
+		subsystemJson["bytes"] = Json::UInt64(usage.bytes);
+		subsystemJson["peakBytes"] = Json::UInt64(usage.peakBytes);
+	}
+	ret["measurements"] = Json::objectValue;
+	for (auto const& [name, bytes]: util::MemoryAccounting::measurements())
+		ret["measurements"][name] = Json::UInt64(bytes);
+	return ret;
+}
+
+Json::Value formatModelCheckerStatistics(ModelCheckerStatistics const& _statistics)
+{
+	auto microseconds = [](chrono::nanoseconds _time) {
+		return Json::UInt64(chrono::duration_cast<chrono::microseconds>(_time).count());
+	};
+
+	Json::Value ret(Json::arrayValue);
+	for (ModelCheckerTargetStatistics const& target: _statistics)
+	{
+		Json::Value targetJson(Json::objectValue);
+		targetJson["sourceLocation"] = formatSourceLocation(&target.location);
+		targetJson["target"] = targetTypeName(target.type);
+		targetJson["engine"] = target.engine;
+		targetJson["encodingTime"] = microseconds(target.encodingTime);
+		targetJson["solvingTime"] = microseconds(target.solvingTime);
+		targetJson["solvers"] = target.solvers;
+		targetJson["result"] = checkResultName(target.result);
+		targetJson["querySize"] = Json::UInt64(target.querySize);
+		ret.append(move(targetJson));
+	}
+	return ret;
+}
+
 Json::Value formatLinkReferences(std::map<size_t, std::string> const& linkReferences)
 {
 	Json::Value ret(Json::objectValue);
@@ -396,6 +523,20 @@ Json::Value collectEVMObject(
 	return output;
 }
 
+/// Adds the members of @a _object whose keys are greater than @a _after and less than @a _before
+/// (if given) to the current object of @a _output, in the order of their keys.
+void addMembersInRange(
+	util::JsonWriter& _output,
+	Json::Value& _object,
+	string const& _after,
+	optional<string> const& _before
+)
+{
+	for (string const& key: _object.getMemberNames())
+		if (key > _after && (!_before || key < *_before))
+			_output.addMember(key, move(_object[key]));
+}
+
 std::optional<Json::Value> checkKeys(Json::Value const& _input, set<string> const& _keys, string const& _name)
 {
 	if (!!_input && !_input.isObject())
@@ -410,10 +551,16 @@ std::optional<Json::Value> checkKeys(Json::Value const& _input, set<string> cons
 
 std::optional<Json::Value> checkRootKeys(Json::Value const& _input)
 {
-	static set<string> keys{"auxiliaryInput", "language", "settings", "sources"};
+	static set<string> keys{"auxiliaryInput", "jobs", "language", "settings", "sources"};
 	return checkKeys(_input, keys, "root");
 }
 
+std::optional<Json::Value> checkJobKeys(Json::Value const& _input)
+{
+	static set<string> keys{"settings"};
+	return checkKeys(_input, keys, "job");
+}
+
 std::optional<Json::Value> checkSourceKeys(Json::Value const& _input, string const& _name)
 {
 	static set<string> keys{"content", "keccak256", "urls"};
@@ -428,22 +575,28 @@ std::optional<Json::Value> checkAuxiliaryInputKeys(Json::Value const& _input)
 
 std::optional<Json::Value> checkSettingsKeys(Json::Value const& _input)
 {
-	static set<string> keys{"parserErrorRecovery", "debug", "evmVersion", "libraries", "metadata", "modelChecker", "optimizer", "outputSelection", "remappings", "stopAfter", "viaIR"};
+	static set<string> keys{"parserErrorRecovery", "debug", "deduplicateOutput", "evmVersion", "libraries", "lowMemory", "metadata", "modelChecker", "optimizer", "optimizationProfiles", "outputSelection", "parallelism", "remappings", "skipUnrequestedSources", "stopAfter", "viaIR"};
 	return checkKeys(_input, keys, "settings");
 }
 
 std::optional<Json::Value> checkModelCheckerSettingsKeys(Json::Value const& _input)
 {
-	static set<string> keys{"engine", "targets", "timeout"};
+	static set<string> keys{"batchQueries", "counterexamples", "engine", "raceSolvers", "targets", "timeBudget", "timeout"};
 	return checkKeys(_input, keys, "modelChecker");
 }
 
 std::optional<Json::Value> checkOptimizerKeys(Json::Value const& _input)
 {
-	static set<string> keys{"details", "enabled", "runs"};
+	static set<string> keys{"details", "enabled", "functionWeights", "runs"};
 	return checkKeys(_input, keys, "settings.optimizer");
 }
 
+std::optional<Json::Value> checkOptimizationProfileKeys(Json::Value const& _input, string const& _name)
+{
+	static set<string> keys{"optimizer", "viaIR"};
+	return checkKeys(_input, keys, "settings.optimizationProfiles." + _name);
+}
+
 std::optional<Json::Value> checkOptimizerDetailsKeys(Json::Value const& _input)
 {
 	static set<string> keys{"peephole", "jumpdestRemover", "orderLiterals", "deduplicate", "cse", "constantOptimizer", "yul", "yulDetails"};
@@ -572,6 +725,26 @@ std::variant<OptimiserSettings, Json::Value> parseOptimizerSettings(Json::Value
 		settings.expectedExecutionsPerDeployment = _jsonInput["runs"].asUInt();
 	}
 
+	if (_jsonInput.isMember("functionWeights"))
+	{
+		Json::Value const& weights = _jsonInput["functionWeights"];
+		if (!weights.isObject())
+			return formatFatalError("JSONError", "The \"functionWeights\" setting must be an object.");
+		for (auto const& selector: weights.getMemberNames())
+		{
+			string normalized = boost::to_lower_copy(selector);
+			if (
+				normalized.size() != 10 ||
+				!boost::starts_with(normalized, "0x") ||
+				!all_of(normalized.begin() + 2, normalized.end(), [](char _c) { return isxdigit(static_cast<unsigned char>(_c)); })
+			)
+				return formatFatalError("JSONError", "Function weights must be keyed by function selectors of the form \"0x12345678\".");
+			if (!weights[selector].isUInt64())
+				return formatFatalError("JSONError", "Function weights must be unsigned numbers.");
+			settings.functionWeights[normalized] = weights[selector].asUInt64();
+		}
+	}
+
 	if (_jsonInput.isMember("details"))
 	{
 		Json::Value const& details = _jsonInput["details"];
@@ -600,20 +773,350 @@ std::variant<OptimiserSettings, Json::Value> parseOptimizerSettings(Json::Value
 			if (!settings.runYulOptimiser)
 				return formatFatalError("JSONError", "\"Providing yulDetails requires Yul optimizer to be enabled.");
 
-			if (auto result = checkKeys(details["yulDetails"], {"stackAllocation", "optimizerSteps"}, "settings.optimizer.details.yulDetails"))
+			if (auto result = checkKeys(details["yulDetails"], {"stackAllocation", "optimizerSteps", "timeBudget", "stackLayout", "reuseAcrossObjects"}, "settings.optimizer.details.yulDetails"))
 				return *result;
 			if (auto error = checkOptimizerDetail(details["yulDetails"], "stackAllocation", settings.optimizeStackAllocation))
 				return *error;
 			if (auto error = checkOptimizerDetailSteps(details["yulDetails"], "optimizerSteps", settings.yulOptimiserSteps))
 				return *error;
+			if (auto error = checkOptimizerDetail(details["yulDetails"], "stackLayout", settings.optimizeStackLayout))
+				return *error;
+			if (auto error = checkOptimizerDetail(details["yulDetails"], "reuseAcrossObjects", settings.yulReuseAcrossObjects))
+				return *error;
+			if (details["yulDetails"].isMember("timeBudget"))
+			{
+				if (!details["yulDetails"]["timeBudget"].isUInt())
+					return formatFatalError("JSONError", "The \"timeBudget\" setting must be an unsigned number of milliseconds.");
+				settings.yulOptimiserTimeBudget = chrono::milliseconds(details["yulDetails"]["timeBudget"].asUInt());
+			}
 		}
 	}
 	return { std::move(settings) };
 }
 
+/// Runs @a _compile and appends the errors reported by @a _compilerStack or, if an exception
+/// aborted the compilation, the error describing it to @a _errors.
+void compileAndReportErrors(CompilerStack& _compilerStack, function<void()> const& _compile, Json::Value& _errors)
+{
+	try
+	{
+		_compile();
+
+		for (auto const& error: _compilerStack.errors())
+		{
+			Error const& err = dynamic_cast<Error const&>(*error);
+
+			_errors.append(formatErrorWithException(
+				_compilerStack,
+				*error,
+				err.type() == Error::Type::Warning,
+				err.typeName(),
+				"general",
+				"",
+				err.errorId()
+			));
+		}
+	}
+	/// This is only thrown in a very few locations.
+	catch (Error const& _error)
+	{
+		_errors.append(formatErrorWithException(
+			_compilerStack,
+			_error,
+			false,
+			_error.typeName(),
+			"general",
+			"Uncaught error: "
+		));
+	}
+	/// This should not be leaked from compile().
+	catch (FatalError const& _exception)
+	{
+		_errors.append(formatError(
+			false,
+			"FatalError",
+			"general",
+			"Uncaught fatal error: " + boost::diagnostic_information(_exception)
+		));
+	}
+	catch (CompilerError const& _exception)
+	{
+		_errors.append(formatErrorWithException(
+			_compilerStack,
+			_exception,
+			false,
+			"CompilerError",
+			"general",
+			"Compiler error (" + _exception.lineInfo() + ")"
+		));
+	}
+	catch (InternalCompilerError const& _exception)
+	{
+		_errors.append(formatErrorWithException(
+			_compilerStack,
+			_exception,
+			false,
+			"InternalCompilerError",
+			"general",
+			"Internal compiler error (" + _exception.lineInfo() + ")"
+		));
+	}
+	catch (UnimplementedFeatureError const& _exception)
+	{
+		_errors.append(formatErrorWithException(
+			_compilerStack,
+			_exception,
+			false,
+			"UnimplementedFeatureError",
+			"general",
+			"Unimplemented feature (" + _exception.lineInfo() + ")"
+		));
+	}
+	catch (yul::YulException const& _exception)
+	{
+		_errors.append(formatErrorWithException(
+			_compilerStack,
+			_exception,
+			false,
+			"YulException",
+			"general",
+			"Yul exception"
+		));
+	}
+	catch (smtutil::SMTLogicError const& _exception)
+	{
+		_errors.append(formatErrorWithException(
+			_compilerStack,
+			_exception,
+			false,
+			"SMTLogicException",
+			"general",
+			"SMT logic exception"
+		));
+	}
+	catch (util::Exception const& _exception)
+	{
+		_errors.append(formatError(
+			false,
+			"Exception",
+			"general",
+			"Exception during compilation: " + boost::diagnostic_information(_exception)
+		));
+	}
+	catch (std::exception const& _e)
+	{
+		_errors.append(formatError(
+			false,
+			"Exception",
+			"general",
+			"Unknown exception during compilation" + (_e.what() ? ": " + string(_e.what()) : ".")
+		));
+	}
+	catch (...)
+	{
+		_errors.append(formatError(
+			false,
+			"Exception",
+			"general",
+			"Unknown exception during compilation."
+		));
+	}
+}
+
 }
 
-std::variant<StandardCompiler::InputsAndSettings, Json::Value> StandardCompiler::parseInput(Json::Value const& _input)
+/**
+ * Moves the contents of the sources out of a standard JSON input before it is parsed into a
+ * JSON tree, so that large inline sources are decoded only once and are not also kept in the tree.
+ *
+ * Only scans the structure of the input. If anything is unusual, extraction is given up and the
+ * input is parsed as a whole, so that jsoncpp is still the only component that reports errors.
+ */
+class SourceContentExtractor
+{
+public:
+	explicit SourceContentExtractor(string const& _input): m_input(_input) {}
+
+	/// @returns the input with the contents of the sources replaced by empty strings, or nullopt
+	/// if the contents could not be extracted.
+	optional<string> run()
+	{
+		skipWhitespace();
+		if (!extractRoot())
+			return nullopt;
+		m_stripped.append(m_input, m_copiedUntil, string::npos);
+		return move(m_stripped);
+	}
+
+	map<string, util::SourceBuffer>& contents() { return m_contents; }
+
+private:
+	bool extractRoot()
+	{
+		return forEachMember([&](string const& _key) {
+			return _key == "sources" ? extractSources() : skipValue();
+		});
+	}
+
+	bool extractSources()
+	{
+		return forEachMember([&](string const& _sourceName) {
+			return forEachMember([&](string const& _key) {
+				if (_key != "content" || !peek('"'))
+					return skipValue();
+				size_t start = m_position;
+				optional<string> content = parseString();
+				if (!content || m_contents.count(_sourceName))
+					return false;
+				m_stripped.append(m_input, m_copiedUntil, start - m_copiedUntil);
+				m_stripped += "\"\"";
+				m_copiedUntil = m_position;
+				m_contents[_sourceName] = util::SourceBuffer(move(*content));
+				return true;
+			});
+		});
+	}
+
+	/// Calls @a _member for the key of every member of the object at the current position,
+	/// with the position at the value of the member.
+	template <class Callback>
+	bool forEachMember(Callback const& _member)
+	{
+		if (!consume('{'))
+			return false;
+		if (consume('}'))
+			return true;
+		do
+		{
+			optional<string> key = parseString();
+			if (!key || !consume(':') || !_member(*key))
+				return false;
+		}
+		while (consume(','));
+		return consume('}');
+	}
+
+	bool skipValue()
+	{
+		if (peek('{'))
+			return forEachMember([&](string const&) { return skipValue(); });
+		if (consume('['))
+		{
+			if (consume(']'))
+				return true;
+			do
+				if (!skipValue())
+					return false;
+			while (consume(','));
+			return consume(']');
+		}
+		if (peek('"'))
+			return parseString().has_value();
+		// Numbers and literals are checked by jsoncpp.
+		size_t start = m_position;
+		auto isLiteral = [](char _c) { return isalnum(static_cast<unsigned char>(_c)) || _c == '-' || _c == '+' || _c == '.'; };
+		while (m_position < m_input.size() && isLiteral(m_input[m_position]))
+			++m_position;
+		skipWhitespace();
+		return m_position > start;
+	}
+
+	/// Parses the string at the current position. Gives up on unescaped control characters
+	/// and surrogate pairs, whose handling is left to jsoncpp.
+	optional<string> parseString()
+	{
+		if (!peek('"'))
+			return nullopt;
+		++m_position;
+		string result;
+		while (true)
+		{
+			size_t next = m_position;
+			while (next < m_input.size() && m_input[next] != '"' && m_input[next] != '\\' && static_cast<unsigned char>(m_input[next]) >= 0x20)
+				++next;
+			if (next == m_input.size() || static_cast<unsigned char>(m_input[next]) < 0x20)
+				return nullopt;
+			result.append(m_input, m_position, next - m_position);
+			m_position = next + 1;
+			if (m_input[next] == '"')
+				break;
+			if (m_position >= m_input.size())
+				return nullopt;
+			switch (char escaped = m_input[m_position++])
+			{
+			case '"': case '\\': case '/': result += escaped; break;
+			case 'b': result += '\b'; break;
+			case 'f': result += '\f'; break;
+			case 'n': result += '\n'; break;
+			case 'r': result += '\r'; break;
+			case 't': result += '\t'; break;
+			case 'u':
+			{
+				if (m_position + 4 > m_input.size())
+					return nullopt;
+				unsigned codePoint = 0;
+				for (size_t i = 0; i < 4; ++i)
+				{
+					int digit = util::fromHex(m_input[m_position++], util::WhenError::DontThrow);
+					if (digit == -1)
+						return nullopt;
+					codePoint = codePoint * 16 + static_cast<unsigned>(digit);
+				}
+				if (codePoint >= 0xd800 && codePoint <= 0xdfff)
+					return nullopt;
+				if (codePoint < 0x80)
+					result += static_cast<char>(codePoint);
+				else if (codePoint < 0x800)
+				{
+					result += static_cast<char>(0xc0 | (codePoint >> 6));
+					result += static_cast<char>(0x80 | (codePoint & 0x3f));
+				}
+				else
+				{
+					result += static_cast<char>(0xe0 | (codePoint >> 12));
+					result += static_cast<char>(0x80 | ((codePoint >> 6) & 0x3f));
+					result += static_cast<char>(0x80 | (codePoint & 0x3f));
+				}
+				break;
+			}
+			default:
+				return nullopt;
+			}
+		}
+		skipWhitespace();
+		return result;
+	}
+
+	bool peek(char _c) const { return m_position < m_input.size() && m_input[m_position] == _c; }
+
+	bool consume(char _c)
+	{
+		if (!peek(_c))
+			return false;
+		++m_position;
+		skipWhitespace();
+		return true;
+	}
+
+	void skipWhitespace()
+	{
+		while (m_position < m_input.size() && (m_input[m_position] == ' ' || m_input[m_position] == '\t' || m_input[m_position] == '\n' || m_input[m_position] == '\r'))
+			++m_position;
+	}
+
+	string const& m_input;
+	size_t m_position = 0;
+	/// The input up to m_copiedUntil with the extracted contents replaced.
+	string m_stripped;
+	size_t m_copiedUntil = 0;
+	map<string, util::SourceBuffer> m_contents;
+};
+
+
+std::variant<StandardCompiler::InputsAndSettings, Json::Value> StandardCompiler::parseInput(
+	Json::Value const& _input,
+	map<string, util::SourceBuffer> _sourceContents
+)
 {
 	InputsAndSettings ret;
 
@@ -647,8 +1150,12 @@ std::variant<StandardCompiler::InputsAndSettings, Json::Value> StandardCompiler:
 
 		if (sources[sourceName]["content"].isString())
 		{
-			string content = sources[sourceName]["content"].asString();
-			if (!hash.empty() && !hashMatchesContent(hash, content))
+			auto extracted = _sourceContents.find(sourceName);
+			util::SourceBuffer content =
+				extracted != _sourceContents.end() ?
+				move(extracted->second) :
+				util::SourceBuffer(sources[sourceName]["content"].asString());
+			if (!hash.empty() && !hashMatchesContent(hash, content.ref()))
 				ret.errors.append(formatError(
 					false,
 					"IOError",
@@ -656,7 +1163,7 @@ std::variant<StandardCompiler::InputsAndSettings, Json::Value> StandardCompiler:
 					"Mismatch between content and supplied hash for \"" + sourceName + "\""
 				));
 			else
-				ret.sources[sourceName] = content;
+				ret.sources[sourceName] = move(content);
 		}
 		else if (sources[sourceName]["urls"].isArray())
 		{
@@ -682,7 +1189,7 @@ std::variant<StandardCompiler::InputsAndSettings, Json::Value> StandardCompiler:
 						));
 					else
 					{
-						ret.sources[sourceName] = result.responseOrErrorMessage;
+						ret.sources[sourceName] = util::SourceBuffer(move(result.responseOrErrorMessage));
 						found = true;
 						break;
 					}
@@ -742,56 +1249,115 @@ std::variant<StandardCompiler::InputsAndSettings, Json::Value> StandardCompiler:
 		}
 	}
 
-	Json::Value const& settings = _input.get("settings", Json::Value());
+	Json::Value const& jobs = _input["jobs"];
+	if (jobs.isNull())
+	{
+		if (auto result = parseSettings(_input.get("settings", Json::Value()), ret))
+			return *result;
+		return { std::move(ret) };
+	}
+
+	if (_input.isMember("settings"))
+		return formatFatalError("JSONError", "\"settings\" cannot be used together with \"jobs\", every job has its own settings.");
+	if (!jobs.isArray() || jobs.empty())
+		return formatFatalError("JSONError", "\"jobs\" must be a non-empty array.");
+
+	// Every job shares the sources and auxiliary input parsed so far.
+	vector<InputsAndSettings> parsedJobs;
+	for (Json::Value const& job: jobs)
+	{
+		if (!job.isObject())
+			return formatFatalError("JSONError", "Every job must be an object.");
+		if (auto result = checkJobKeys(job))
+			return *result;
+		Json::Value const& settings = job.get("settings", Json::Value());
+		InputsAndSettings& parsedJob = parsedJobs.emplace_back(ret);
+		if (auto result = parseSettings(settings, parsedJob))
+			return *result;
+		parsedJob.analysisKey = analysisKey(settings, parsedJob.optimiserSettings, parsedJob.outputSelection);
+	}
+	ret.jobs = std::move(parsedJobs);
+	return { std::move(ret) };
+}
 
-	if (auto result = checkSettingsKeys(settings))
+std::optional<Json::Value> StandardCompiler::parseSettings(Json::Value const& _settings, InputsAndSettings& _inputsAndSettings)
+{
+	if (auto result = checkSettingsKeys(_settings))
 		return *result;
 
-	if (settings.isMember("stopAfter"))
+	if (_settings.isMember("stopAfter"))
 	{
-		if (!settings["stopAfter"].isString())
+		if (!_settings["stopAfter"].isString())
 			return formatFatalError("JSONError", "\"settings.stopAfter\" must be a string.");
 
-		if (settings["stopAfter"].asString() != "parsing")
+		if (_settings["stopAfter"].asString() != "parsing")
 			return formatFatalError("JSONError", "Invalid value for \"settings.stopAfter\". Only valid value is \"parsing\".");
 
-		ret.stopAfter = CompilerStack::State::Parsed;
+		_inputsAndSettings.stopAfter = CompilerStack::State::Parsed;
 	}
 
-	if (settings.isMember("parserErrorRecovery"))
+	if (_settings.isMember("parserErrorRecovery"))
 	{
-		if (!settings["parserErrorRecovery"].isBool())
+		if (!_settings["parserErrorRecovery"].isBool())
 			return formatFatalError("JSONError", "\"settings.parserErrorRecovery\" must be a Boolean.");
-		ret.parserErrorRecovery = settings["parserErrorRecovery"].asBool();
+		_inputsAndSettings.parserErrorRecovery = _settings["parserErrorRecovery"].asBool();
 	}
 
-	if (settings.isMember("viaIR"))
+	if (_settings.isMember("viaIR"))
 	{
-		if (!settings["viaIR"].isBool())
+		if (!_settings["viaIR"].isBool())
 			return formatFatalError("JSONError", "\"settings.viaIR\" must be a Boolean.");
-		ret.viaIR = settings["viaIR"].asBool();
+		_inputsAndSettings.viaIR = _settings["viaIR"].asBool();
+	}
+
+	if (_settings.isMember("parallelism"))
+	{
+		if (!_settings["parallelism"].isUInt())
+			return formatFatalError("JSONError", "\"settings.parallelism\" must be an unsigned integer.");
+		_inputsAndSettings.parallelism = _settings["parallelism"].asUInt();
 	}
 
-	if (settings.isMember("evmVersion"))
+	if (_settings.isMember("lowMemory"))
 	{
-		if (!settings["evmVersion"].isString())
+		if (!_settings["lowMemory"].isBool())
+			return formatFatalError("JSONError", "\"settings.lowMemory\" must be a Boolean.");
+		_inputsAndSettings.lowMemory = _settings["lowMemory"].asBool();
+	}
+
+	if (_settings.isMember("deduplicateOutput"))
+	{
+		if (!_settings["deduplicateOutput"].isBool())
+			return formatFatalError("JSONError", "\"settings.deduplicateOutput\" must be a Boolean.");
+		_inputsAndSettings.deduplicateOutput = _settings["deduplicateOutput"].asBool();
+	}
+
+	if (_settings.isMember("skipUnrequestedSources"))
+	{
+		if (!_settings["skipUnrequestedSources"].isBool())
+			return formatFatalError("JSONError", "\"settings.skipUnrequestedSources\" must be a Boolean.");
+		_inputsAndSettings.skipUnrequestedSources = _settings["skipUnrequestedSources"].asBool();
+	}
+
+	if (_settings.isMember("evmVersion"))
+	{
+		if (!_settings["evmVersion"].isString())
 			return formatFatalError("JSONError", "evmVersion must be a string.");
-		std::optional<langutil::EVMVersion> version = langutil::EVMVersion::fromString(settings["evmVersion"].asString());
+		std::optional<langutil::EVMVersion> version = langutil::EVMVersion::fromString(_settings["evmVersion"].asString());
 		if (!version)
 			return formatFatalError("JSONError", "Invalid EVM version requested.");
-		ret.evmVersion = *version;
+		_inputsAndSettings.evmVersion = *version;
 	}
 
-	if (settings.isMember("debug"))
+	if (_settings.isMember("debug"))
 	{
-		if (auto result = checkKeys(settings["debug"], {"revertStrings"}, "settings.debug"))
+		if (auto result = checkKeys(_settings["debug"], {"revertStrings"}, "settings.debug"))
 			return *result;
 
-		if (settings["debug"].isMember("revertStrings"))
+		if (_settings["debug"].isMember("revertStrings"))
 		{
-			if (!settings["debug"]["revertStrings"].isString())
+			if (!_settings["debug"]["revertStrings"].isString())
 				return formatFatalError("JSONError", "settings.debug.revertStrings must be a string.");
-			std::optional<RevertStrings> revertStrings = revertStringsFromString(settings["debug"]["revertStrings"].asString());
+			std::optional<RevertStrings> revertStrings = revertStringsFromString(_settings["debug"]["revertStrings"].asString());
 			if (!revertStrings)
 				return formatFatalError("JSONError", "Invalid value for settings.debug.revertStrings.");
 			if (*revertStrings == RevertStrings::VerboseDebug)
@@ -799,33 +1365,60 @@ std::variant<StandardCompiler::InputsAndSettings, Json::Value> StandardCompiler:
 					"UnimplementedFeatureError",
 					"Only \"default\", \"strip\" and \"debug\" are implemented for settings.debug.revertStrings for now."
 				);
-			ret.revertStrings = *revertStrings;
+			_inputsAndSettings.revertStrings = *revertStrings;
 		}
 	}
 
-	if (settings.isMember("remappings") && !settings["remappings"].isArray())
+	if (_settings.isMember("remappings") && !_settings["remappings"].isArray())
 		return formatFatalError("JSONError", "\"settings.remappings\" must be an array of strings.");
 
-	for (auto const& remapping: settings.get("remappings", Json::Value()))
+	for (auto const& remapping: _settings.get("remappings", Json::Value()))
 	{
 		if (!remapping.isString())
 			return formatFatalError("JSONError", "\"settings.remappings\" must be an array of strings");
 		if (auto r = CompilerStack::parseRemapping(remapping.asString()))
-			ret.remappings.emplace_back(std::move(*r));
+			_inputsAndSettings.remappings.emplace_back(std::move(*r));
 		else
 			return formatFatalError("JSONError", "Invalid remapping: \"" + remapping.asString() + "\"");
 	}
 
-	if (settings.isMember("optimizer"))
+	if (_settings.isMember("optimizer"))
 	{
-		auto optimiserSettings = parseOptimizerSettings(settings["optimizer"]);
+		auto optimiserSettings = parseOptimizerSettings(_settings["optimizer"]);
 		if (std::holds_alternative<Json::Value>(optimiserSettings))
 			return std::get<Json::Value>(std::move(optimiserSettings)); // was an error
 		else
-			ret.optimiserSettings = std::get<OptimiserSettings>(std::move(optimiserSettings));
+			_inputsAndSettings.optimiserSettings = std::get<OptimiserSettings>(std::move(optimiserSettings));
 	}
 
-	Json::Value jsonLibraries = settings.get("libraries", Json::Value(Json::objectValue));
+	Json::Value const& jsonProfiles = _settings.get("optimizationProfiles", Json::Value(Json::objectValue));
+	if (!jsonProfiles.isObject())
+		return formatFatalError("JSONError", "\"settings.optimizationProfiles\" must be an object.");
+	for (auto const& contractName: jsonProfiles.getMemberNames())
+	{
+		Json::Value const& jsonProfile = jsonProfiles[contractName];
+		if (!jsonProfile.isObject())
+			return formatFatalError("JSONError", "Optimization profile of \"" + contractName + "\" must be an object.");
+		if (auto result = checkOptimizationProfileKeys(jsonProfile, contractName))
+			return *result;
+
+		CompilerStack::OptimisationProfile& profile = _inputsAndSettings.optimisationProfiles[contractName];
+		if (jsonProfile.isMember("optimizer"))
+		{
+			auto optimiserSettings = parseOptimizerSettings(jsonProfile["optimizer"]);
+			if (std::holds_alternative<Json::Value>(optimiserSettings))
+				return std::get<Json::Value>(std::move(optimiserSettings)); // was an error
+			profile.optimiserSettings = std::get<OptimiserSettings>(std::move(optimiserSettings));
+		}
+		if (jsonProfile.isMember("viaIR"))
+		{
+			if (!jsonProfile["viaIR"].isBool())
+				return formatFatalError("JSONError", "\"viaIR\" of optimization profile \"" + contractName + "\" must be a Boolean.");
+			profile.viaIR = jsonProfile["viaIR"].asBool();
+		}
+	}
+
+	Json::Value jsonLibraries = _settings.get("libraries", Json::Value(Json::objectValue));
 	if (!jsonLibraries.isObject())
 		return formatFatalError("JSONError", "\"libraries\" is not a JSON object.");
 	for (auto const& sourceName: jsonLibraries.getMemberNames())
@@ -853,7 +1446,7 @@ std::variant<StandardCompiler::InputsAndSettings, Json::Value> StandardCompiler:
 
 			try
 			{
-				ret.libraries[sourceName + ":" + library] = util::h160(address);
+				_inputsAndSettings.libraries[sourceName + ":" + library] = util::h160(address);
 			}
 			catch (util::BadHexCharacter const&)
 			{
@@ -865,16 +1458,16 @@ std::variant<StandardCompiler::InputsAndSettings, Json::Value> StandardCompiler:
 		}
 	}
 
-	Json::Value metadataSettings = settings.get("metadata", Json::Value());
+	Json::Value metadataSettings = _settings.get("metadata", Json::Value());
 
 	if (auto result = checkMetadataKeys(metadataSettings))
 		return *result;
 
-	ret.metadataLiteralSources = metadataSettings.get("useLiteralContent", Json::Value(false)).asBool();
+	_inputsAndSettings.metadataLiteralSources = metadataSettings.get("useLiteralContent", Json::Value(false)).asBool();
 	if (metadataSettings.isMember("bytecodeHash"))
 	{
 		auto metadataHash = metadataSettings["bytecodeHash"].asString();
-		ret.metadataHash =
+		_inputsAndSettings.metadataHash =
 			metadataHash == "ipfs" ?
 			CompilerStack::MetadataHash::IPFS :
 				metadataHash == "bzzr1" ?
@@ -882,20 +1475,20 @@ std::variant<StandardCompiler::InputsAndSettings, Json::Value> StandardCompiler:
 				CompilerStack::MetadataHash::None;
 	}
 
-	Json::Value outputSelection = settings.get("outputSelection", Json::Value());
+	Json::Value outputSelection = _settings.get("outputSelection", Json::Value());
 
 	if (auto jsonError = checkOutputSelection(outputSelection))
 		return *jsonError;
 
-	ret.outputSelection = std::move(outputSelection);
+	_inputsAndSettings.outputSelection = std::move(outputSelection);
 
-	if (ret.stopAfter != CompilerStack::State::CompilationSuccessful && isBinaryRequested(ret.outputSelection))
+	if (_inputsAndSettings.stopAfter != CompilerStack::State::CompilationSuccessful && isBinaryRequested(_inputsAndSettings.outputSelection))
 		return formatFatalError(
 			"JSONError",
 			"Requested output selection conflicts with \"settings.stopAfter\"."
 		);
 
-	Json::Value const& modelCheckerSettings = settings.get("modelChecker", Json::Value());
+	Json::Value const& modelCheckerSettings = _settings.get("modelChecker", Json::Value());
 
 	if (auto result = checkModelCheckerSettingsKeys(modelCheckerSettings))
 		return *result;
@@ -907,7 +1500,7 @@ std::variant<StandardCompiler::InputsAndSettings, Json::Value> StandardCompiler:
 		std::optional<ModelCheckerEngine> engine = ModelCheckerEngine::fromString(modelCheckerSettings["engine"].asString());
 		if (!engine)
 			return formatFatalError("JSONError", "Invalid model checker engine requested.");
-		ret.modelCheckerSettings.engine = *engine;
+		_inputsAndSettings.modelCheckerSettings.engine = *engine;
 	}
 
 	if (modelCheckerSettings.isMember("targets"))
@@ -917,303 +1510,450 @@ std::variant<StandardCompiler::InputsAndSettings, Json::Value> StandardCompiler:
 		std::optional<ModelCheckerTargets> targets = ModelCheckerTargets::fromString(modelCheckerSettings["targets"].asString());
 		if (!targets)
 			return formatFatalError("JSONError", "Invalid model checker targets requested.");
-		ret.modelCheckerSettings.targets = *targets;
+		_inputsAndSettings.modelCheckerSettings.targets = *targets;
 	}
 
 	if (modelCheckerSettings.isMember("timeout"))
 	{
 		if (!modelCheckerSettings["timeout"].isUInt())
 			return formatFatalError("JSONError", "settings.modelChecker.timeout must be an unsigned integer.");
-		ret.modelCheckerSettings.timeout = modelCheckerSettings["timeout"].asUInt();
+		_inputsAndSettings.modelCheckerSettings.timeout = modelCheckerSettings["timeout"].asUInt();
 	}
 
-	return { std::move(ret) };
+	if (modelCheckerSettings.isMember("timeBudget"))
+	{
+		if (!modelCheckerSettings["timeBudget"].isUInt())
+			return formatFatalError("JSONError", "settings.modelChecker.timeBudget must be an unsigned integer.");
+		_inputsAndSettings.modelCheckerSettings.timeBudget = modelCheckerSettings["timeBudget"].asUInt();
+	}
+
+	if (modelCheckerSettings.isMember("raceSolvers"))
+	{
+		if (!modelCheckerSettings["raceSolvers"].isBool())
+			return formatFatalError("JSONError", "settings.modelChecker.raceSolvers must be a Boolean.");
+		_inputsAndSettings.modelCheckerSettings.raceSolvers = modelCheckerSettings["raceSolvers"].asBool();
+	}
+
+	if (modelCheckerSettings.isMember("batchQueries"))
+	{
+		if (!modelCheckerSettings["batchQueries"].isBool())
+			return formatFatalError("JSONError", "settings.modelChecker.batchQueries must be a Boolean.");
+		_inputsAndSettings.modelCheckerSettings.batchQueries = modelCheckerSettings["batchQueries"].asBool();
+	}
+
+	if (modelCheckerSettings.isMember("counterexamples"))
+	{
+		if (!modelCheckerSettings["counterexamples"].isBool())
+			return formatFatalError("JSONError", "settings.modelChecker.counterexamples must be a Boolean.");
+		_inputsAndSettings.modelCheckerSettings.counterexamples = modelCheckerSettings["counterexamples"].asBool();
+	}
+
+	return std::nullopt;
 }
 
-Json::Value StandardCompiler::compileSolidity(StandardCompiler::InputsAndSettings _inputsAndSettings)
+void StandardCompiler::configureCompilerStack(CompilerStack& _compilerStack, InputsAndSettings const& _inputsAndSettings)
 {
-	CompilerStack compilerStack(m_readFile);
+	_compilerStack.setViaIR(_inputsAndSettings.viaIR);
+	_compilerStack.setParallelism(_inputsAndSettings.parallelism);
+	_compilerStack.setEVMVersion(_inputsAndSettings.evmVersion);
+	_compilerStack.setParserErrorRecovery(_inputsAndSettings.parserErrorRecovery);
+	_compilerStack.setRemappings(_inputsAndSettings.remappings);
+	_compilerStack.setOptimiserSettings(_inputsAndSettings.optimiserSettings);
+	_compilerStack.setOptimisationProfiles(_inputsAndSettings.optimisationProfiles);
+	_compilerStack.setRevertStringBehaviour(_inputsAndSettings.revertStrings);
+	_compilerStack.setLibraries(_inputsAndSettings.libraries);
+	_compilerStack.useMetadataLiteralSources(_inputsAndSettings.metadataLiteralSources);
+	_compilerStack.setMetadataHash(_inputsAndSettings.metadataHash);
+	_compilerStack.setRequestedContractNames(requestedContractNames(_inputsAndSettings.outputSelection));
+	_compilerStack.setSkipUnrequestedSources(_inputsAndSettings.skipUnrequestedSources);
+	_compilerStack.setModelCheckerSettings(_inputsAndSettings.modelCheckerSettings);
+
+	_compilerStack.enableEvmBytecodeGeneration(isEvmBytecodeRequested(_inputsAndSettings.outputSelection));
+	_compilerStack.enableIRGeneration(isIRRequested(_inputsAndSettings.outputSelection));
+	_compilerStack.enableEwasmGeneration(isEwasmRequested(_inputsAndSettings.outputSelection));
+	_compilerStack.enableCompilationStatistics(isCompilationStatisticsRequested(_inputsAndSettings.outputSelection));
+	if (isCompilationStatisticsRequested(_inputsAndSettings.outputSelection))
+	{
+		util::MemoryAccounting::enable();
+		util::MemoryAccounting::reset();
+	}
+}
 
-	StringMap sourceList = std::move(_inputsAndSettings.sources);
-	compilerStack.setSources(sourceList);
+void StandardCompiler::compileSolidity(StandardCompiler::InputsAndSettings _inputsAndSettings, util::JsonWriter& _output)
+{
+	unique_ptr<CompilerStack> temporaryCompilerStack;
+	if (m_compilerStack)
+		m_compilerStack->reset();
+	else
+		temporaryCompilerStack = make_unique<CompilerStack>(m_readFile);
+	CompilerStack& compilerStack = m_compilerStack ? *m_compilerStack : *temporaryCompilerStack;
+
+	compilerStack.setSourceBuffers(_inputsAndSettings.sources);
 	for (auto const& smtLib2Response: _inputsAndSettings.smtLib2Responses)
 		compilerStack.addSMTLib2Response(smtLib2Response.first, smtLib2Response.second);
-	compilerStack.setViaIR(_inputsAndSettings.viaIR);
-	compilerStack.setEVMVersion(_inputsAndSettings.evmVersion);
-	compilerStack.setParserErrorRecovery(_inputsAndSettings.parserErrorRecovery);
-	compilerStack.setRemappings(_inputsAndSettings.remappings);
-	compilerStack.setOptimiserSettings(std::move(_inputsAndSettings.optimiserSettings));
-	compilerStack.setRevertStringBehaviour(_inputsAndSettings.revertStrings);
-	compilerStack.setLibraries(_inputsAndSettings.libraries);
-	compilerStack.useMetadataLiteralSources(_inputsAndSettings.metadataLiteralSources);
-	compilerStack.setMetadataHash(_inputsAndSettings.metadataHash);
-	compilerStack.setRequestedContractNames(requestedContractNames(_inputsAndSettings.outputSelection));
-	compilerStack.setModelCheckerSettings(_inputsAndSettings.modelCheckerSettings);
-
-	compilerStack.enableEvmBytecodeGeneration(isEvmBytecodeRequested(_inputsAndSettings.outputSelection));
-	compilerStack.enableIRGeneration(isIRRequested(_inputsAndSettings.outputSelection));
-	compilerStack.enableEwasmGeneration(isEwasmRequested(_inputsAndSettings.outputSelection));
+	configureCompilerStack(compilerStack, _inputsAndSettings);
 
 	Json::Value errors = std::move(_inputsAndSettings.errors);
-
-	bool const binariesRequested = isBinaryRequested(_inputsAndSettings.outputSelection);
-
-	try
-	{
-		if (binariesRequested)
+	compileAndReportErrors(compilerStack, [&]() {
+		if (isBinaryRequested(_inputsAndSettings.outputSelection))
 			compilerStack.compile();
 		else
 			compilerStack.parseAndAnalyze(_inputsAndSettings.stopAfter);
+	}, errors);
 
-		for (auto const& error: compilerStack.errors())
-		{
-			Error const& err = dynamic_cast<Error const&>(*error);
+	writeSolidityOutput(compilerStack, _inputsAndSettings, std::move(errors), _output);
+}
 
-			errors.append(formatErrorWithException(
-				*error,
-				err.type() == Error::Type::Warning,
-				err.typeName(),
-				"general",
-				"",
-				err.errorId()
-			));
-		}
-	}
-	/// This is only thrown in a very few locations.
-	catch (Error const& _error)
-	{
-		errors.append(formatErrorWithException(
-			_error,
-			false,
-			_error.typeName(),
-			"general",
-			"Uncaught error: "
-		));
-	}
-	/// This should not be leaked from compile().
-	catch (FatalError const& _exception)
-	{
-		errors.append(formatError(
-			false,
-			"FatalError",
-			"general",
-			"Uncaught fatal error: " + boost::diagnostic_information(_exception)
-		));
-	}
-	catch (CompilerError const& _exception)
-	{
-		errors.append(formatErrorWithException(
-			_exception,
-			false,
-			"CompilerError",
-			"general",
-			"Compiler error (" + _exception.lineInfo() + ")"
-		));
-	}
-	catch (InternalCompilerError const& _exception)
-	{
-		errors.append(formatErrorWithException(
-			_exception,
-			false,
-			"InternalCompilerError",
-			"general",
-			"Internal compiler error (" + _exception.lineInfo() + ")"
-		));
-	}
-	catch (UnimplementedFeatureError const& _exception)
-	{
-		errors.append(formatErrorWithException(
-			_exception,
-			false,
-			"UnimplementedFeatureError",
-			"general",
-			"Unimplemented feature (" + _exception.lineInfo() + ")"
-		));
-	}
-	catch (yul::YulException const& _exception)
+void StandardCompiler::compileJobs(InputsAndSettings _inputsAndSettings, util::JsonWriter& _output)
+{
+	Json::Value outputs(Json::arrayValue);
+	if (_inputsAndSettings.language == "Yul")
 	{
-		errors.append(formatErrorWithException(
-			_exception,
-			false,
-			"YulException",
-			"general",
-			"Yul exception"
-		));
+		for (InputsAndSettings& job: _inputsAndSettings.jobs)
+			outputs.append(compileYul(std::move(job)));
+		_output.addMember("jobs", std::move(outputs));
+		return;
 	}
-	catch (smtutil::SMTLogicError const& _exception)
+
+	// The sources are parsed and analysed once for all jobs whose settings lead to the same
+	// analysis. Every job then generates code on a compiler stack of its own, which uses the
+	// shared analysis, concurrently with the other jobs.
+	struct Analysis
 	{
-		errors.append(formatErrorWithException(
-			_exception,
-			false,
-			"SMTLogicException",
-			"general",
-			"SMT logic exception"
-		));
-	}
-	catch (util::Exception const& _exception)
+		unique_ptr<CompilerStack> compilerStack;
+		/// The error of an exception that aborted parsing or analysis, reported by every job.
+		Json::Value errors{Json::arrayValue};
+		bool aborted = false;
+	};
+	struct Job
 	{
-		errors.append(formatError(
-			false,
-			"Exception",
-			"general",
-			"Exception during compilation: " + boost::diagnostic_information(_exception)
-		));
-	}
-	catch (std::exception const& _e)
+		Analysis const* analysis = nullptr;
+		unique_ptr<CompilerStack> compilerStack;
+		Json::Value errors;
+	};
+	map<string, Analysis> analyses;
+	vector<Job> jobs(_inputsAndSettings.jobs.size());
+	// The analyses run on this thread, since the read callback can be called during them.
+	for (size_t i = 0; i < jobs.size(); ++i)
 	{
-		errors.append(formatError(
-			false,
-			"Exception",
-			"general",
-			"Unknown exception during compilation" + (_e.what() ? ": " + string(_e.what()) : ".")
-		));
+		InputsAndSettings const& settings = _inputsAndSettings.jobs[i];
+		Analysis& analysis = analyses[settings.analysisKey];
+		if (!analysis.compilerStack)
+		{
+			analysis.compilerStack = make_unique<CompilerStack>(m_readFile);
+			analysis.compilerStack->setSourceBuffers(settings.sources);
+			for (auto const& smtLib2Response: settings.smtLib2Responses)
+				analysis.compilerStack->addSMTLib2Response(smtLib2Response.first, smtLib2Response.second);
+			configureCompilerStack(*analysis.compilerStack, settings);
+			compileAndReportErrors(*analysis.compilerStack, [&]() {
+				// Stays set if an exception aborts the analysis.
+				analysis.aborted = true;
+				analysis.compilerStack->parseAndAnalyze(settings.stopAfter);
+				analysis.aborted = false;
+			}, analysis.errors);
+			if (!analysis.aborted)
+				analysis.errors = Json::arrayValue;
+		}
+
+		Job& job = jobs[i];
+		job.analysis = &analysis;
+		job.errors = settings.errors;
+		if (analysis.aborted)
+			continue;
+		job.compilerStack = make_unique<CompilerStack>(m_readFile);
+		configureCompilerStack(*job.compilerStack, settings);
+		job.compilerStack->useAnalysis(*analysis.compilerStack);
 	}
-	catch (...)
+
+	// Every job can configure the parallelism of its compilation, the jobs run with the highest one.
+	size_t parallelism = 1;
+	for (InputsAndSettings const& settings: _inputsAndSettings.jobs)
+		parallelism = max(parallelism, util::ThreadPool::effectiveThreads(settings.parallelism));
+	util::ThreadPool threadPool(parallelism);
+	for (size_t i = 0; i < jobs.size(); ++i)
+		if (jobs[i].compilerStack)
+			threadPool.submit([&job = jobs[i], &settings = _inputsAndSettings.jobs[i]]() {
+				compileAndReportErrors(*job.compilerStack, [&]() {
+					if (isBinaryRequested(settings.outputSelection) && !job.compilerStack->hasError())
+						job.compilerStack->compile();
+				}, job.errors);
+			});
+	threadPool.wait();
+
+	// The output of a job is complete once it is written, so its compiler stack is freed.
+	for (size_t i = 0; i < jobs.size(); ++i)
 	{
-		errors.append(formatError(
-			false,
-			"Exception",
-			"general",
-			"Unknown exception during compilation."
-		));
+		Job& job = jobs[i];
+		util::JsonTreeWriter output;
+		if (job.compilerStack)
+			writeSolidityOutput(*job.compilerStack, _inputsAndSettings.jobs[i], std::move(job.errors), output);
+		else
+		{
+			for (Json::Value const& error: job.analysis->errors)
+				job.errors.append(error);
+			writeSolidityOutput(*job.analysis->compilerStack, _inputsAndSettings.jobs[i], std::move(job.errors), output);
+		}
+		outputs.append(std::move(output.result()));
+		job.compilerStack.reset();
 	}
+	_output.addMember("jobs", std::move(outputs));
+}
+
+void StandardCompiler::writeSolidityOutput(
+	CompilerStack& _compilerStack,
+	InputsAndSettings const& _inputsAndSettings,
+	Json::Value _errors,
+	util::JsonWriter& _output
+)
+{
+	// The AST export and the interface outputs can request types of the compilation.
+	TypeProvider::Scope typeScope(_compilerStack.typeProvider());
+	bool const binariesRequested = isBinaryRequested(_inputsAndSettings.outputSelection);
 
-	bool analysisPerformed = compilerStack.state() >= CompilerStack::State::AnalysisPerformed;
-	bool const compilationSuccess = compilerStack.state() == CompilerStack::State::CompilationSuccessful;
+	bool analysisPerformed = _compilerStack.state() >= CompilerStack::State::AnalysisPerformed;
+	bool const compilationSuccess = _compilerStack.state() == CompilerStack::State::CompilationSuccessful;
 
-	if (compilerStack.hasError() && !_inputsAndSettings.parserErrorRecovery)
+	if (_compilerStack.hasError() && !_inputsAndSettings.parserErrorRecovery)
 		analysisPerformed = false;
 
 	/// Inconsistent state - stop here to receive error reports from users
 	if (
 		((binariesRequested && !compilationSuccess) || !analysisPerformed) &&
-		(errors.empty() && _inputsAndSettings.stopAfter >= CompilerStack::State::AnalysisPerformed)
+		(_errors.empty() && _inputsAndSettings.stopAfter >= CompilerStack::State::AnalysisPerformed)
 	)
-		return formatFatalError("InternalCompilerError", "No error reported, but compilation failed.");
-
-	Json::Value output = Json::objectValue;
+	{
+		_output.addMembers(formatFatalError("InternalCompilerError", "No error reported, but compilation failed."));
+		return;
+	}
 
-	if (errors.size() > 0)
-		output["errors"] = std::move(errors);
+	if (!_compilerStack.unhandledSMTLib2Queries().empty())
+	{
+		Json::Value auxiliaryInputRequested;
+		for (string const& query: _compilerStack.unhandledSMTLib2Queries())
+			auxiliaryInputRequested["smtlib2queries"]["0x" + util::keccak256(query).hex()] = query;
+		_output.addMember("auxiliaryInputRequested", move(auxiliaryInputRequested));
+	}
 
-	if (!compilerStack.unhandledSMTLib2Queries().empty())
-		for (string const& query: compilerStack.unhandledSMTLib2Queries())
-			output["auxiliaryInputRequested"]["smtlib2queries"]["0x" + util::keccak256(query).hex()] = query;
+	if (isCompilationStatisticsRequested(_inputsAndSettings.outputSelection))
+	{
+		Json::Value statistics = formatCompilationStatistics(_compilerStack.compilationStatistics());
+		statistics["modelChecker"] = formatModelCheckerStatistics(_compilerStack.modelCheckerStatistics());
+		statistics["memory"] = formatMemoryUsage();
+		_output.addMember("compilationStats", move(statistics));
+	}
 
 	bool const wildcardMatchesExperimental = false;
 
-	output["sources"] = Json::objectValue;
-	unsigned sourceIndex = 0;
-	if (compilerStack.state() >= CompilerStack::State::Parsed && (!compilerStack.hasError() || _inputsAndSettings.parserErrorRecovery))
-		for (string const& sourceName: compilerStack.sourceNames())
-		{
-			Json::Value sourceResult = Json::objectValue;
-			sourceResult["id"] = sourceIndex++;
-			if (isArtifactRequested(_inputsAndSettings.outputSelection, sourceName, "", "ast", wildcardMatchesExperimental))
-				sourceResult["ast"] = ASTJsonConverter(compilerStack.state(), compilerStack.sourceIndices()).toJson(compilerStack.ast(sourceName));
-			output["sources"][sourceName] = sourceResult;
-		}
+	// The assembly output quotes the sources, which it only accepts as strings.
+	// They are copied only if it is requested.
+	util::LazyInit<StringMap const> sourceCodes;
 
-	Json::Value contractsOutput = Json::objectValue;
-	for (string const& contractName: analysisPerformed ? compilerStack.contractNames() : vector<string>())
+	// The outputs are written in the order of their keys, i.e. grouped by file.
+	map<string, map<string, string>> contractNamesByFile;
+	for (string const& contractName: analysisPerformed ? _compilerStack.contractNames() : vector<string>())
 	{
 		size_t colon = contractName.rfind(':');
 		solAssert(colon != string::npos, "");
-		string file = contractName.substr(0, colon);
-		string name = contractName.substr(colon + 1);
-
-		// ABI, storage layout, documentation and metadata
-		Json::Value contractData(Json::objectValue);
-		if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "abi", wildcardMatchesExperimental))
-			contractData["abi"] = compilerStack.contractABI(contractName);
-		if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "storageLayout", false))
-			contractData["storageLayout"] = compilerStack.storageLayout(contractName);
-		if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "metadata", wildcardMatchesExperimental))
-			contractData["metadata"] = compilerStack.metadata(contractName);
-		if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "userdoc", wildcardMatchesExperimental))
-			contractData["userdoc"] = compilerStack.natspecUser(contractName);
-		if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "devdoc", wildcardMatchesExperimental))
-			contractData["devdoc"] = compilerStack.natspecDev(contractName);
-
-		// IR
-		if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "ir", wildcardMatchesExperimental))
-			contractData["ir"] = compilerStack.yulIR(contractName);
-		if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "irOptimized", wildcardMatchesExperimental))
-			contractData["irOptimized"] = compilerStack.yulIROptimized(contractName);
-
-		// Ewasm
-		if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "ewasm.wast", wildcardMatchesExperimental))
-			contractData["ewasm"]["wast"] = compilerStack.ewasm(contractName);
-		if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "ewasm.wasm", wildcardMatchesExperimental))
-			contractData["ewasm"]["wasm"] = compilerStack.ewasmObject(contractName).toHex();
-
-		// EVM
-		Json::Value evmData(Json::objectValue);
-		if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "evm.assembly", wildcardMatchesExperimental))
-			evmData["assembly"] = compilerStack.assemblyString(contractName, sourceList);
-		if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "evm.legacyAssembly", wildcardMatchesExperimental))
-			evmData["legacyAssembly"] = compilerStack.assemblyJSON(contractName);
-		if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "evm.methodIdentifiers", wildcardMatchesExperimental))
-			evmData["methodIdentifiers"] = compilerStack.methodIdentifiers(contractName);
-		if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "evm.gasEstimates", wildcardMatchesExperimental))
-			evmData["gasEstimates"] = compilerStack.gasEstimates(contractName);
-
-		if (compilationSuccess && isArtifactRequested(
-			_inputsAndSettings.outputSelection,
-			file,
-			name,
-			evmObjectComponents("bytecode"),
-			wildcardMatchesExperimental
-		))
-			evmData["bytecode"] = collectEVMObject(
-				compilerStack.object(contractName),
-				compilerStack.sourceMapping(contractName),
-				compilerStack.generatedSources(contractName),
-				false,
-				[&](string const& _element) { return isArtifactRequested(
-					_inputsAndSettings.outputSelection,
-					file,
-					name,
-					"evm.bytecode." + _element,
-					wildcardMatchesExperimental
-				); }
-			);
+		contractNamesByFile[contractName.substr(0, colon)][contractName.substr(colon + 1)] = contractName;
+	}
 
-		if (compilationSuccess && isArtifactRequested(
-			_inputsAndSettings.outputSelection,
-			file,
-			name,
-			evmObjectComponents("deployedBytecode"),
-			wildcardMatchesExperimental
-		))
-			evmData["deployedBytecode"] = collectEVMObject(
-				compilerStack.runtimeObject(contractName),
-				compilerStack.runtimeSourceMapping(contractName),
-				compilerStack.generatedSources(contractName, true),
-				true,
-				[&](string const& _element) { return isArtifactRequested(
-					_inputsAndSettings.outputSelection,
-					file,
-					name,
-					"evm.deployedBytecode." + _element,
-					wildcardMatchesExperimental
-				); }
-			);
+	// In low memory mode, everything kept for a contract is freed as soon as its output is
+	// complete, and the AST of a source once it is not needed for the remaining contracts.
+	if (_inputsAndSettings.lowMemory)
+		for (string const& sourceName: _compilerStack.sourceNames())
+			if (isArtifactRequested(_inputsAndSettings.outputSelection, sourceName, "", "ast", wildcardMatchesExperimental))
+				_compilerStack.keepAST(sourceName);
+
+	// The functions of all contracts are estimated together, which balances the load better
+	// than estimating the functions of each contract on its own.
+	if (compilationSuccess)
+	{
+		vector<string> gasEstimatesRequested;
+		for (auto const& [file, fileContracts]: contractNamesByFile)
+			for (auto const& [name, contractName]: fileContracts)
+				if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "evm.gasEstimates", wildcardMatchesExperimental))
+					gasEstimatesRequested.push_back(contractName);
+		_compilerStack.computeGasEstimates(gasEstimatesRequested);
+	}
 
-		if (!evmData.empty())
-			contractData["evm"] = evmData;
+	// The entries of the sources in the metadata if the metadata refers to them by name.
+	map<string, string> metadataSources;
 
-		if (!contractData.empty())
+	_output.beginObject("contracts", true);
+	// No structured bindings, because the names are captured by lambdas below.
+	for (auto const& fileContracts: contractNamesByFile)
+	{
+		string const& file = fileContracts.first;
+		_output.beginObject(file, true);
+		for (auto const& fileContract: fileContracts.second)
 		{
-			if (!contractsOutput.isMember(file))
-				contractsOutput[file] = Json::objectValue;
-			contractsOutput[file][name] = contractData;
+			string const& name = fileContract.first;
+			string const& contractName = fileContract.second;
+
+			// ABI, storage layout, documentation and metadata
+			Json::Value contractData(Json::objectValue);
+			if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "abi", wildcardMatchesExperimental))
+				contractData["abi"] = _compilerStack.contractABI(contractName);
+			if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "storageLayout", false))
+				contractData["storageLayout"] = _compilerStack.storageLayout(contractName);
+			if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "compilationStats", false))
+				contractData["compilationStats"] = formatCompilationStatistics(_compilerStack.compilationStatistics(contractName));
+			if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "metadata", wildcardMatchesExperimental))
+			{
+				if (_inputsAndSettings.deduplicateOutput)
+				{
+					contractData["metadata"] = _compilerStack.metadataWithSourceNames(contractName);
+					for (string const& sourceName: _compilerStack.metadataSourceNames(contractName))
+						metadataSources.emplace(sourceName, _compilerStack.metadataSourceEntry(sourceName));
+				}
+				else
+					contractData["metadata"] = _compilerStack.metadata(contractName);
+			}
+			if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "userdoc", wildcardMatchesExperimental))
+				contractData["userdoc"] = _compilerStack.natspecUser(contractName);
+			if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "devdoc", wildcardMatchesExperimental))
+				contractData["devdoc"] = _compilerStack.natspecDev(contractName);
+
+			// IR
+			if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "ir", wildcardMatchesExperimental))
+				contractData["ir"] = _compilerStack.yulIR(contractName);
+			if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "irOptimized", wildcardMatchesExperimental))
+				contractData["irOptimized"] = _compilerStack.yulIROptimized(contractName);
+
+			// Ewasm
+			if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "ewasm.wast", wildcardMatchesExperimental))
+				contractData["ewasm"]["wast"] = _compilerStack.ewasm(contractName);
+			if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "ewasm.wasm", wildcardMatchesExperimental))
+				contractData["ewasm"]["wasm"] = _compilerStack.ewasmObject(contractName).toHex();
+
+			// EVM
+			Json::Value evmData(Json::objectValue);
+			if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "evm.assembly", wildcardMatchesExperimental))
+				evmData["assembly"] = _compilerStack.assemblyString(contractName, sourceCodes.init([&]() {
+					StringMap codes;
+					for (auto const& source: _inputsAndSettings.sources)
+						codes[source.first] = source.second.str();
+					return codes;
+				}));
+			bool const legacyAssemblyRequested =
+				compilationSuccess &&
+				isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "evm.legacyAssembly", wildcardMatchesExperimental);
+			if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "evm.methodIdentifiers", wildcardMatchesExperimental))
+				evmData["methodIdentifiers"] = _compilerStack.methodIdentifiers(contractName);
+			if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "evm.gasEstimates", wildcardMatchesExperimental))
+				evmData["gasEstimates"] = _compilerStack.gasEstimates(contractName);
+
+			if (compilationSuccess && isArtifactRequested(
+				_inputsAndSettings.outputSelection,
+				file,
+				name,
+				evmObjectComponents("bytecode"),
+				wildcardMatchesExperimental
+			))
+				evmData["bytecode"] = collectEVMObject(
+					_compilerStack.object(contractName),
+					_compilerStack.sourceMapping(contractName),
+					_compilerStack.generatedSources(contractName),
+					false,
+					[&](string const& _element) { return isArtifactRequested(
+						_inputsAndSettings.outputSelection,
+						file,
+						name,
+						"evm.bytecode." + _element,
+						wildcardMatchesExperimental
+					); }
+				);
+
+			if (compilationSuccess && isArtifactRequested(
+				_inputsAndSettings.outputSelection,
+				file,
+				name,
+				evmObjectComponents("deployedBytecode"),
+				wildcardMatchesExperimental
+			))
+				evmData["deployedBytecode"] = collectEVMObject(
+					_compilerStack.runtimeObject(contractName),
+					_compilerStack.runtimeSourceMapping(contractName),
+					_compilerStack.generatedSources(contractName, true),
+					true,
+					[&](string const& _element) { return isArtifactRequested(
+						_inputsAndSettings.outputSelection,
+						file,
+						name,
+						"evm.deployedBytecode." + _element,
+						wildcardMatchesExperimental
+					); }
+				);
+
+			// The legacy assembly is added to the output directly, so that it is printed item by item
+			// and sub-assembly by sub-assembly. The other members are added around it in the order of their keys.
+			_output.beginObject(name, true);
+			addMembersInRange(_output, contractData, "", "evm");
+			if (!evmData.empty() || legacyAssemblyRequested)
+			{
+				_output.beginObject("evm");
+				addMembersInRange(_output, evmData, "", "legacyAssembly");
+				if (legacyAssemblyRequested)
+				{
+					if (_compilerStack.assemblyItems(contractName))
+					{
+						_output.beginObject("legacyAssembly");
+						_compilerStack.assemblyJSON(contractName, _output);
+						_output.endObject();
+					}
+					else
+						_output.addMember("legacyAssembly", Json::Value());
+				}
+				addMembersInRange(_output, evmData, "legacyAssembly", nullopt);
+				_output.endObject();
+			}
+			addMembersInRange(_output, contractData, "evm", nullopt);
+			_output.endObject();
+			if (_inputsAndSettings.lowMemory)
+				_compilerStack.releaseContract(contractName);
 		}
+		_output.endObject();
 	}
-	if (!contractsOutput.empty())
-		output["contracts"] = contractsOutput;
+	_output.endObject();
 
-	return output;
+	if (_errors.size() > 0)
+		_output.addMember("errors", std::move(_errors));
+
+	// Every source is listed once instead of in the metadata of each contract.
+	_output.beginObject("metadataSources", true);
+	for (auto const& [sourceName, entry]: metadataSources)
+		_output.addMember(
+			sourceName,
+			[&entry = entry](ostream& _stream) { _stream << entry; },
+			[&entry = entry]() {
+				Json::Value value;
+				solAssert(util::jsonParseStrict(entry, value), "");
+				return value;
+			}
+		);
+	_output.endObject();
+
+	_output.beginObject("sources");
+	unsigned sourceIndex = 0;
+	if (_compilerStack.state() >= CompilerStack::State::Parsed && (!_compilerStack.hasError() || _inputsAndSettings.parserErrorRecovery))
+		for (string const& sourceName: _compilerStack.sourceNames())
+		{
+			_output.beginObject(sourceName);
+			if (isArtifactRequested(_inputsAndSettings.outputSelection, sourceName, "", "ast", wildcardMatchesExperimental))
+			{
+				// The AST is printed while it is converted if the output is printed anyway.
+				ASTJsonConverter converter(_compilerStack.state(), _compilerStack.sourceIndices());
+				SourceUnit const& ast = _compilerStack.ast(sourceName);
+				_output.addMember(
+					"ast",
+					[&](ostream& _stream) { converter.print(_stream, ast, true); },
+					[&]() { return converter.toJson(ast); }
+				);
+			}
+			_output.addMember("id", sourceIndex++);
+			_output.endObject();
+		}
+	_output.endObject();
 }
 
 
@@ -1236,7 +1976,7 @@ Json::Value StandardCompiler::compileYul(InputsAndSettings _inputsAndSettings)
 		_inputsAndSettings.optimiserSettings
 	);
 	string const& sourceName = _inputsAndSettings.sources.begin()->first;
-	string const& sourceContents = _inputsAndSettings.sources.begin()->second;
+	string const sourceContents = _inputsAndSettings.sources.begin()->second.str();
 
 	// Inconsistent state - stop here to receive error reports from users
 	if (!stack.parseAndAnalyze(sourceName, sourceContents) && stack.errors().empty())
@@ -1250,6 +1990,7 @@ Json::Value StandardCompiler::compileYul(InputsAndSettings _inputsAndSettings)
 			auto err = dynamic_pointer_cast<Error const>(error);
 
 			errors.append(formatErrorWithException(
+				stack,
 				*error,
 				err->type() == Error::Type::Warning,
 				err->typeName(),
@@ -1320,63 +2061,105 @@ Json::Value StandardCompiler::compileYul(InputsAndSettings _inputsAndSettings)
 
 Json::Value StandardCompiler::compile(Json::Value const& _input) noexcept
 {
-	YulStringRepository::reset();
+	util::JsonTreeWriter output;
+	if (optional<Json::Value> error = compile(_input, output))
+		return move(*error);
+	return move(output.result());
+}
 
+string StandardCompiler::compile(string const& _input) noexcept
+{
+	Json::Value input;
+	string errors;
+	map<string, util::SourceBuffer> sourceContents;
 	try
 	{
-		auto parsed = parseInput(_input);
-		if (std::holds_alternative<Json::Value>(parsed))
-			return std::get<Json::Value>(std::move(parsed));
-		InputsAndSettings settings = std::get<InputsAndSettings>(std::move(parsed));
-		if (settings.language == "Solidity")
-			return compileSolidity(std::move(settings));
-		else if (settings.language == "Yul")
-			return compileYul(std::move(settings));
+		// The contents of the sources are moved out of the input before it is parsed. If that
+		// fails, the input is parsed as a whole, which reports errors at their original positions.
+		SourceContentExtractor extractor(_input);
+		optional<string> strippedInput = extractor.run();
+		if (strippedInput && util::jsonParseStrict(*strippedInput, input))
+			sourceContents = move(extractor.contents());
 		else
-			return formatFatalError("JSONError", "Only \"Solidity\" or \"Yul\" is supported as a language.");
-	}
-	catch (Json::LogicError const& _exception)
-	{
-		return formatFatalError("InternalCompilerError", string("JSON logic exception: ") + _exception.what());
+		{
+			input = Json::Value();
+			if (!util::jsonParseStrict(_input, input, &errors))
+				return util::jsonCompactPrint(formatFatalError("JSONError", errors));
+		}
 	}
-	catch (Json::RuntimeError const& _exception)
+	catch (...)
 	{
-		return formatFatalError("InternalCompilerError", string("JSON runtime exception: ") + _exception.what());
+		return "{\"errors\":[{\"type\":\"JSONError\",\"component\":\"general\",\"severity\":\"error\",\"message\":\"Error parsing input JSON.\"}]}";
 	}
-	catch (util::Exception const& _exception)
+
+	try
 	{
-		return formatFatalError("InternalCompilerError", "Internal exception in StandardCompiler::compile: " + boost::diagnostic_information(_exception));
+		// The output of each contract and source is printed as soon as it is complete,
+		// so that the output does not have to be kept in memory as JSON tree.
+		ostringstream output;
+		util::JsonStreamWriter writer(output);
+		if (optional<Json::Value> error = compile(input, writer, move(sourceContents)))
+			return util::jsonCompactPrint(*error);
+		writer.finish();
+		return output.str();
 	}
 	catch (...)
 	{
-		return formatFatalError("InternalCompilerError", "Internal exception in StandardCompiler::compile");
+		return "{\"errors\":[{\"type\":\"JSONError\",\"component\":\"general\",\"severity\":\"error\",\"message\":\"Error writing output JSON.\"}]}";
 	}
 }
 
-string StandardCompiler::compile(string const& _input) noexcept
+optional<Json::Value> StandardCompiler::compile(
+	Json::Value const& _input,
+	util::JsonWriter& _output,
+	map<string, util::SourceBuffer> _sourceContents
+) noexcept
 {
-	Json::Value input;
-	string errors;
-	try
+	// The kept compiler stack refers to the strings of the previous compilation.
+	if (!m_compilerStack)
 	{
-		if (!util::jsonParseStrict(_input, input, &errors))
-			return util::jsonCompactPrint(formatFatalError("JSONError", errors));
+		YulStringRepository::reset();
+		Symbol::reset();
 	}
-	catch (...)
+	else
 	{
-		return "{\"errors\":[{\"type\":\"JSONError\",\"component\":\"general\",\"severity\":\"error\",\"message\":\"Error parsing input JSON.\"}]}";
+		// The compiler stack notices the resets and does not reuse its ASTs.
+		if (YulStringRepository::instance().size() > m_maxKeptYulStrings)
+			YulStringRepository::reset();
+		if (Symbol::size() > m_maxKeptSymbols)
+			Symbol::reset();
 	}
 
-	// cout << "Input: " << input.toStyledString() << endl;
-	Json::Value output = compile(input);
-	// cout << "Output: " << output.toStyledString() << endl;
-
 	try
 	{
-		return util::jsonCompactPrint(output);
+		auto parsed = parseInput(_input, move(_sourceContents));
+		if (std::holds_alternative<Json::Value>(parsed))
+			return std::get<Json::Value>(std::move(parsed));
+		InputsAndSettings settings = std::get<InputsAndSettings>(std::move(parsed));
+		if (settings.language != "Solidity" && settings.language != "Yul")
+			return formatFatalError("JSONError", "Only \"Solidity\" or \"Yul\" is supported as a language.");
+		if (!settings.jobs.empty())
+			compileJobs(std::move(settings), _output);
+		else if (settings.language == "Solidity")
+			compileSolidity(std::move(settings), _output);
+		else
+			_output.addMembers(compileYul(std::move(settings)));
+		return nullopt;
+	}
+	catch (Json::LogicError const& _exception)
+	{
+		return formatFatalError("InternalCompilerError", string("JSON logic exception: ") + _exception.what());
+	}
+	catch (Json::RuntimeError const& _exception)
+	{
+		return formatFatalError("InternalCompilerError", string("JSON runtime exception: ") + _exception.what());
+	}
+	catch (util::Exception const& _exception)
+	{
+		return formatFatalError("InternalCompilerError", "Internal exception in StandardCompiler::compile: " + boost::diagnostic_information(_exception));
 	}
 	catch (...)
 	{
-		return "{\"errors\":[{\"type\":\"JSONError\",\"component\":\"general\",\"severity\":\"error\",\"message\":\"Error writing output JSON.\"}]}";
+		return formatFatalError("InternalCompilerError", "Internal exception in StandardCompiler::compile");
 	}
 }
@@ -25,9 +25,16 @@
 
 #include <libsolidity/interface/CompilerStack.h>
 
+#include <memory>
 #include <optional>
 #include <utility>
 #include <variant>
+#include <vector>
+
+namespace solidity::util
+{
+class JsonWriter;
+}
 
 namespace solidity::frontend
 {
@@ -42,9 +49,18 @@ public:
 	/// Creates a new StandardCompiler.
 	/// @param _readFile callback used to read files for import statements. Must return
 	/// and must not emit exceptions.
-	explicit StandardCompiler(ReadCallback::Callback _readFile = ReadCallback::Callback()):
+	/// @param _keepState if true, one compiler stack is used for all calls to @a compile, which
+	/// keeps the parsed sources and reuses them if their content did not change. The Yul
+	/// string repository and the symbol table are then only reset between calls once they
+	/// grew beyond a limit, which makes the next call parse all sources again.
+	explicit StandardCompiler(ReadCallback::Callback _readFile = ReadCallback::Callback(), bool _keepState = false):
 		m_readFile(std::move(_readFile))
 	{
+		if (_keepState)
+		{
+			m_compilerStack = std::make_unique<CompilerStack>(m_readFile);
+			m_compilerStack->enableIncrementalParsing();
+		}
 	}
 
 	/// Sets all input parameters according to @a _input which conforms to the standardized input
@@ -52,8 +68,18 @@ public:
 	Json::Value compile(Json::Value const& _input) noexcept;
 	/// Parses input as JSON and peforms the above processing steps, returning a serialized JSON
 	/// output. Parsing errors are returned as regular errors.
+	/// The output of each contract is serialized as soon as it is complete instead of building
+	/// the whole output as JSON tree first.
 	std::string compile(std::string const& _input) noexcept;
 
+	/// Sets the number of Yul strings and of interned symbols after which they are reset between
+	/// calls to @a compile if the state is kept.
+	void setKeptStringLimits(size_t _maxYulStrings, size_t _maxSymbols)
+	{
+		m_maxKeptYulStrings = _maxYulStrings;
+		m_maxKeptSymbols = _maxSymbols;
+	}
+
 private:
 	struct InputsAndSettings
 	{
@@ -61,28 +87,73 @@ private:
 		Json::Value errors;
 		bool parserErrorRecovery = false;
 		CompilerStack::State stopAfter = CompilerStack::State::CompilationSuccessful;
-		std::map<std::string, std::string> sources;
+		std::map<std::string, util::SourceBuffer> sources;
 		std::map<util::h256, std::string> smtLib2Responses;
 		langutil::EVMVersion evmVersion;
 		std::vector<CompilerStack::Remapping> remappings;
 		RevertStrings revertStrings = RevertStrings::Default;
 		OptimiserSettings optimiserSettings = OptimiserSettings::minimal();
+		std::map<std::string, CompilerStack::OptimisationProfile> optimisationProfiles;
 		std::map<std::string, util::h160> libraries;
 		bool metadataLiteralSources = false;
 		CompilerStack::MetadataHash metadataHash = CompilerStack::MetadataHash::IPFS;
 		Json::Value outputSelection;
 		ModelCheckerSettings modelCheckerSettings = ModelCheckerSettings{};
 		bool viaIR = false;
+		size_t parallelism = 1;
+		bool lowMemory = false;
+		bool deduplicateOutput = false;
+		bool skipUnrequestedSources = false;
+		/// Equal for the jobs of a batch input whose sources are parsed and analysed only once.
+		std::string analysisKey;
+		/// The jobs of a batch input, which share the sources and auxiliary input of this input.
+		std::vector<InputsAndSettings> jobs;
 	};
 
 	/// Parses the input json (and potentially invokes the read callback) and either returns
 	/// it in condensed form or an error as a json object.
-	std::variant<InputsAndSettings, Json::Value> parseInput(Json::Value const& _input);
+	/// The contents of sources contained in @a _sourceContents are taken from there instead of the input.
+	std::variant<InputsAndSettings, Json::Value> parseInput(
+		Json::Value const& _input,
+		std::map<std::string, util::SourceBuffer> _sourceContents = {}
+	);
+
+	/// Performs the processing steps of @a compile and writes the output to @a _output.
+	/// @returns the output to use instead, if an exception was thrown. In that case, the
+	/// output written to @a _output so far is incomplete.
+	std::optional<Json::Value> compile(
+		Json::Value const& _input,
+		util::JsonWriter& _output,
+		std::map<std::string, util::SourceBuffer> _sourceContents = {}
+	) noexcept;
+
+	/// Parses the settings @a _settings into @a _inputsAndSettings.
+	/// @returns an error as a json object if they are invalid.
+	static std::optional<Json::Value> parseSettings(Json::Value const& _settings, InputsAndSettings& _inputsAndSettings);
 
-	Json::Value compileSolidity(InputsAndSettings _inputsAndSettings);
+	/// Applies all settings except for the sources and the SMTLib2 responses to @a _compilerStack.
+	static void configureCompilerStack(CompilerStack& _compilerStack, InputsAndSettings const& _inputsAndSettings);
+	/// Writes the members of the output to @a _output in the order of their keys.
+	void compileSolidity(InputsAndSettings _inputsAndSettings, util::JsonWriter& _output);
+	/// Compiles the jobs of a batch input and writes their outputs to @a _output as the array "jobs".
+	/// The sources are parsed and analysed once for all jobs whose analysis does not depend on their
+	/// different settings, and the code of the jobs is generated concurrently.
+	void compileJobs(InputsAndSettings _inputsAndSettings, util::JsonWriter& _output);
+	/// Writes the output of @a _compilerStack, which has compiled the sources according to
+	/// @a _inputsAndSettings, together with the errors @a _errors to @a _output.
+	static void writeSolidityOutput(
+		CompilerStack& _compilerStack,
+		InputsAndSettings const& _inputsAndSettings,
+		Json::Value _errors,
+		util::JsonWriter& _output
+	);
 	Json::Value compileYul(InputsAndSettings _inputsAndSettings);
 
 	ReadCallback::Callback m_readFile;
+	/// Compiler stack used for all compilations if state is kept between them.
+	std::unique_ptr<CompilerStack> m_compilerStack;
+	size_t m_maxKeptYulStrings = 1 << 20;
+	size_t m_maxKeptSymbols = 1 << 20;
 };
 
 }
@@ -121,6 +121,8 @@ DocStringParser::iter DocStringParser::parseDocTagLine(iter _pos, iter _end, boo
 {
 	solAssert(!!m_lastTag, "");
 	auto nlPos = find(_pos, _end, '\n');
+	if (!m_keepContent)
+		return skipLineOrEOS(nlPos, _end);
 	if (_appending && _pos != _end && *_pos != ' ' && *_pos != '\t')
 		m_lastTag->content += " ";
 	else if (!_appending)
@@ -150,10 +152,10 @@ DocStringParser::iter DocStringParser::parseDocTagParam(iter _pos, iter _end)
 		return _end;
 	}
 
-	auto paramDesc = string(descStartPos, nlPos);
 	newTag("param");
 	m_lastTag->paramName = paramName;
-	m_lastTag->content = paramDesc;
+	if (m_keepContent)
+		m_lastTag->content = string(descStartPos, nlPos);
 
 	return skipLineOrEOS(nlPos, _end);
 }
@@ -179,4 +181,9 @@ DocStringParser::iter DocStringParser::parseDocTag(iter _pos, iter _end, string
 void DocStringParser::newTag(string const& _tagName)
 {
 	m_lastTag = &m_docTags.insert(make_pair(_tagName, DocTag()))->second;
+	m_keepContent =
+		!m_onlyCheckedContent ||
+		_tagName == "return" ||
+		_tagName == "inheritdoc" ||
+		_tagName == "optimizer";
 }
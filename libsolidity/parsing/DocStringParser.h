@@ -37,6 +37,10 @@ namespace solidity::frontend
 class DocStringParser
 {
 public:
+	/// If @a _onlyCheckedContent is set, only the contents of the tags that are needed to check
+	/// the doc string, i.e. of @return and @inheritdoc and the names of parameters, are stored.
+	explicit DocStringParser(bool _onlyCheckedContent = false): m_onlyCheckedContent(_onlyCheckedContent) {}
+
 	/// Parse the given @a _docString and stores the parsed components internally.
 	void parse(std::string const& _docString, langutil::ErrorReporter& _errorReporter);
 
@@ -61,6 +65,9 @@ private:
 	/// Mapping tag name -> content.
 	std::multimap<std::string, DocTag> m_docTags;
 	DocTag* m_lastTag = nullptr;
+	/// Whether the content of m_lastTag is stored.
+	bool m_keepContent = true;
+	bool m_onlyCheckedContent = false;
 	langutil::ErrorReporter* m_errorReporter = nullptr;
 };
 
@@ -23,6 +23,7 @@
 
 #include <libsolidity/parsing/Parser.h>
 
+#include <libsolidity/ast/ASTVisitor.h>
 #include <libsolidity/interface/Version.h>
 #include <libyul/AsmParser.h>
 #include <libyul/AST.h>
@@ -44,13 +45,87 @@ using namespace solidity::langutil;
 namespace solidity::frontend
 {
 
+namespace
+{
+
+/// Finds the function or modifier definition whose body contains a range of the source without
+/// touching the braces of the body, and the start positions of all inline assembly blocks.
+class BodyFinder: private ASTVisitor
+{
+public:
+	BodyFinder(SourceUnit& _sourceUnit, int _start, int _end): m_start(_start), m_end(_end)
+	{
+		_sourceUnit.accept(*this);
+	}
+
+	FunctionDefinition* function = nullptr;
+	ModifierDefinition* modifier = nullptr;
+	Block const* body = nullptr;
+	std::vector<int> assemblyStarts;
+
+private:
+	bool visit(FunctionDefinition& _function) override
+	{
+		if (_function.isImplemented() && contains(_function.body()))
+		{
+			function = &_function;
+			body = &_function.body();
+		}
+		return true;
+	}
+	bool visit(ModifierDefinition& _modifier) override
+	{
+		if (_modifier.isImplemented() && contains(_modifier.body()))
+		{
+			modifier = &_modifier;
+			body = &_modifier.body();
+		}
+		return true;
+	}
+	bool visit(InlineAssembly& _assembly) override
+	{
+		assemblyStarts.push_back(_assembly.location().start);
+		return false;
+	}
+
+	bool contains(Block const& _body) const
+	{
+		return _body.location().start < m_start && m_end < _body.location().end;
+	}
+
+	int m_start = 0;
+	int m_end = 0;
+};
+
+/// Moves the source locations of all nodes of an AST that are at or after a position.
+class LocationMover: private ASTVisitor
+{
+public:
+	LocationMover(ASTNode& _root, int _position, int _offset): m_position(_position), m_offset(_offset)
+	{
+		_root.accept(*this);
+	}
+
+private:
+	bool visitNode(ASTNode& _node) override
+	{
+		_node.moveLocation(m_position, m_offset);
+		return true;
+	}
+
+	int m_position = 0;
+	int m_offset = 0;
+};
+
+}
+
 /// AST node factory that also tracks the begin and end position of an AST node
 /// while it is being parsed
 class Parser::ASTNodeFactory
 {
 public:
 	explicit ASTNodeFactory(Parser& _parser):
-		m_parser(_parser), m_location{_parser.currentLocation().start, -1, _parser.currentLocation().source} {}
+		m_parser(_parser), m_location{_parser.currentLocation().start, -1, _parser.currentLocation().sourceName} {}
 	ASTNodeFactory(Parser& _parser, ASTPointer<ASTNode> const& _childNode):
 		m_parser(_parser), m_location{_childNode->location()} {}
 
@@ -63,10 +138,12 @@ public:
 	template <class NodeType, typename... Args>
 	ASTPointer<NodeType> createNode(Args&& ... _args)
 	{
-		solAssert(m_location.source, "");
+		solAssert(m_location.sourceName, "");
 		if (m_location.end < 0)
 			markEndPosition();
-		return make_shared<NodeType>(m_parser.nextID(), m_location, std::forward<Args>(_args)...);
+		auto node = m_parser.makeShared<NodeType>(m_parser.nextID(), m_location, std::forward<Args>(_args)...);
+		node->setAnnotationTable(*m_parser.m_annotationTable);
+		return node;
 	}
 
 	SourceLocation const& location() const noexcept { return m_location; }
@@ -83,6 +160,13 @@ ASTPointer<SourceUnit> Parser::parse(shared_ptr<Scanner> const& _scanner)
 	{
 		m_recursionDepth = 0;
 		m_scanner = _scanner;
+		// All nodes keep the arena alive, so the parser does not need to hold on to it.
+		m_arena = make_shared<util::Arena>();
+		m_annotationTable = &m_arena->create<ASTAnnotationTable>(*m_arena);
+		ScopeGuard releaseArena([this]() {
+			m_arena.reset();
+			m_annotationTable = nullptr;
+		});
 		ASTNodeFactory nodeFactory(*this);
 
 		vector<ASTPointer<ASTNode>> nodes;
@@ -136,6 +220,58 @@ ASTPointer<SourceUnit> Parser::parse(shared_ptr<Scanner> const& _scanner)
 	}
 }
 
+ASTPointer<Block> Parser::reparseBody(
+	SourceUnit& _sourceUnit,
+	shared_ptr<Scanner> const& _scanner,
+	int _editStart,
+	int _oldEditEnd,
+	int _newEditEnd
+)
+{
+	solAssert(!m_insideModifier, "");
+	BodyFinder finder(_sourceUnit, _editStart, _oldEditEnd);
+	if (!finder.body)
+		return nullptr;
+	int const oldEnd = finder.body->location().end;
+	int const offset = _newEditEnd - _oldEditEnd;
+	for (int assemblyStart: finder.assemblyStarts)
+		if (assemblyStart >= oldEnd)
+			return nullptr;
+
+	ASTPointer<Block> body;
+	try
+	{
+		m_recursionDepth = 0;
+		m_scanner = _scanner;
+		m_arena = make_shared<util::Arena>();
+		m_annotationTable = &m_arena->create<ASTAnnotationTable>(*m_arena);
+		m_insideModifier = finder.modifier != nullptr;
+		ScopeGuard reset([this]() {
+			m_arena.reset();
+			m_annotationTable = nullptr;
+			m_insideModifier = false;
+		});
+		m_scanner->setPosition(static_cast<size_t>(finder.body->location().start));
+		body = parseBlock();
+		solAssert(m_recursionDepth == 0, "");
+	}
+	catch (FatalError const&)
+	{
+		if (m_errorReporter.errors().empty())
+			throw; // Something is weird here, rather throw again.
+		return nullptr;
+	}
+	if (m_errorReporter.hasErrors() || body->location().end != oldEnd + offset)
+		return nullptr;
+
+	LocationMover{_sourceUnit, oldEnd, offset};
+	if (finder.function)
+		finder.function->replaceBody(body);
+	else
+		finder.modifier->replaceBody(body);
+	return body;
+}
+
 void Parser::parsePragmaVersion(SourceLocation const& _location, vector<Token> const& _tokens, vector<string> const& _literals)
 {
 	SemVerMatchExpressionParser parser(_tokens, _literals);
@@ -169,7 +305,7 @@ ASTPointer<StructuredDocumentation> Parser::parseStructuredDocumentation()
 		ASTNodeFactory nodeFactory{*this};
 		nodeFactory.setLocation(m_scanner->currentCommentLocation());
 		return nodeFactory.createNode<StructuredDocumentation>(
-			make_shared<ASTString>(m_scanner->currentCommentLiteral())
+			makeShared<ASTString>(m_scanner->currentCommentLiteral())
 		);
 	}
 	return nullptr;
@@ -225,7 +361,7 @@ ASTPointer<ImportDirective> Parser::parseImportDirective()
 	ASTNodeFactory nodeFactory(*this);
 	expectToken(Token::Import);
 	ASTPointer<ASTString> path;
-	ASTPointer<ASTString> unitAlias = make_shared<string>();
+	ASTPointer<ASTString const> unitAlias = makeShared<ASTString>();
 	SourceLocation unitAliasLocation{};
 	ImportDirective::SymbolAliasList symbolAliases;
 
@@ -251,7 +387,9 @@ ASTPointer<ImportDirective> Parser::parseImportDirective()
 				if (m_scanner->currentToken() == Token::As)
 				{
 					expectToken(Token::As);
-					tie(alias, aliasLocation) = expectIdentifierWithLocation();
+					ASTPointer<ASTString const> aliasName;
+					tie(aliasName, aliasLocation) = expectIdentifierWithLocation();
+					alias = makeShared<ASTString>(*aliasName);
 				}
 				symbolAliases.emplace_back(ImportDirective::SymbolAlias{move(id), move(alias), aliasLocation});
 				if (m_scanner->currentToken() != Token::Comma)
@@ -316,7 +454,7 @@ ASTPointer<ContractDefinition> Parser::parseContractDefinition()
 {
 	RecursionGuard recursionGuard(*this);
 	ASTNodeFactory nodeFactory(*this);
-	ASTPointer<ASTString> name =  nullptr;
+	ASTPointer<ASTString const> name =  nullptr;
 	SourceLocation nameLocation{};
 	ASTPointer<StructuredDocumentation> documentation;
 	vector<ASTPointer<InheritanceSpecifier>> baseContracts;
@@ -573,7 +711,7 @@ ASTPointer<ASTNode> Parser::parseFunctionDefinition(bool _freeFunction)
 	ASTPointer<StructuredDocumentation> documentation = parseStructuredDocumentation();
 
 	Token kind = m_scanner->currentToken();
-	ASTPointer<ASTString> name;
+	ASTPointer<ASTString const> name;
 	SourceLocation nameLocation;
 	if (kind == Token::Function)
 	{
@@ -590,7 +728,7 @@ ASTPointer<ASTNode> Parser::parseFunctionDefinition(bool _freeFunction)
 				{Token::Receive, "receive function"},
 			}.at(m_scanner->currentToken());
 			nameLocation = currentLocation();
-			name = make_shared<ASTString>(TokenTraits::toString(m_scanner->currentToken()));
+			name = Symbol(TokenTraits::toString(m_scanner->currentToken())).shared();
 			string message{
 				"This function is named \"" + *name + "\" but is not the " + expected + " of the contract. "
 				"If you intend this to be a " + expected + ", use \"" + *name + "(...) { ... }\" without "
@@ -609,7 +747,7 @@ ASTPointer<ASTNode> Parser::parseFunctionDefinition(bool _freeFunction)
 	{
 		solAssert(kind == Token::Constructor || kind == Token::Fallback || kind == Token::Receive, "");
 		m_scanner->next();
-		name = make_shared<ASTString>();
+		name = makeShared<ASTString>();
 	}
 
 	FunctionHeaderParserResult header = parseFunctionHeader(false);
@@ -721,7 +859,7 @@ ASTPointer<VariableDeclaration> Parser::parseVariableDeclaration(
 	ASTPointer<OverrideSpecifier> overrides = nullptr;
 	Visibility visibility(Visibility::Default);
 	VariableDeclaration::Location location = VariableDeclaration::Location::Unspecified;
-	ASTPointer<ASTString> identifier;
+	ASTPointer<ASTString const> identifier;
 	SourceLocation nameLocation{};
 
 	while (true)
@@ -797,7 +935,7 @@ ASTPointer<VariableDeclaration> Parser::parseVariableDeclaration(
 	}
 
 	if (_options.allowEmptyName && m_scanner->currentToken() != Token::Identifier)
-		identifier = make_shared<ASTString>("");
+		identifier = makeShared<ASTString>("");
 	else
 	{
 		nodeFactory.markEndPosition();
@@ -885,10 +1023,10 @@ ASTPointer<ModifierDefinition> Parser::parseModifierDefinition()
 	return nodeFactory.createNode<ModifierDefinition>(name, nameLocation, documentation, parameters, isVirtual, overrides, block);
 }
 
-pair<ASTPointer<ASTString>, SourceLocation> Parser::expectIdentifierWithLocation()
+pair<ASTPointer<ASTString const>, SourceLocation> Parser::expectIdentifierWithLocation()
 {
 	SourceLocation nameLocation = currentLocation();
-	ASTPointer<ASTString> name = expectIdentifierToken();
+	ASTPointer<ASTString const> name = expectIdentifierToken();
 
 	return {move(name), move(nameLocation)};
 }
@@ -1163,7 +1301,7 @@ ASTPointer<Statement> Parser::parseStatement(bool _allowUnchecked)
 	try
 	{
 		if (m_scanner->currentCommentLiteral() != "")
-			docString = make_shared<ASTString>(m_scanner->currentCommentLiteral());
+			docString = makeShared<ASTString>(m_scanner->currentCommentLiteral());
 		switch (m_scanner->currentToken())
 		{
 		case Token::If:
@@ -1262,7 +1400,9 @@ ASTPointer<InlineAssembly> Parser::parseInlineAssembly(ASTPointer<ASTString> con
 		BOOST_THROW_EXCEPTION(FatalError());
 
 	location.end = block->location.end;
-	return make_shared<InlineAssembly>(nextID(), location, _docString, dialect, block);
+	ASTNodeFactory nodeFactory(*this);
+	nodeFactory.setLocation(location);
+	return nodeFactory.createNode<InlineAssembly>(_docString, dialect, block);
 }
 
 ASTPointer<IfStatement> Parser::parseIfStatement(ASTPointer<ASTString> const& _docString)
@@ -1307,7 +1447,7 @@ ASTPointer<TryStatement> Parser::parseTryStatement(ASTPointer<ASTString> const&
 	ASTPointer<Block> successBlock = parseBlock();
 	successClauseFactory.setEndPositionFromNode(successBlock);
 	clauses.emplace_back(successClauseFactory.createNode<TryCatchClause>(
-		make_shared<ASTString>(), returnsParameters, successBlock
+		makeShared<ASTString>(), returnsParameters, successBlock
 	));
 
 	do
@@ -1326,12 +1466,12 @@ ASTPointer<TryCatchClause> Parser::parseCatchClause()
 	RecursionGuard recursionGuard(*this);
 	ASTNodeFactory nodeFactory(*this);
 	expectToken(Token::Catch);
-	ASTPointer<ASTString> errorName = make_shared<string>();
+	ASTPointer<ASTString> errorName = makeShared<ASTString>();
 	ASTPointer<ParameterList> errorParameters;
 	if (m_scanner->currentToken() != Token::LBrace)
 	{
 		if (m_scanner->currentToken() == Token::Identifier)
-			errorName = expectIdentifierToken();
+			errorName = makeShared<ASTString>(*expectIdentifierToken());
 		VarDeclParserOptions options;
 		options.allowEmptyName = true;
 		options.allowLocationSpecifier = true;
@@ -1753,7 +1893,7 @@ ASTPointer<Expression> Parser::parseLeftHandSideExpression(
 			nodeFactory.markEndPosition();
 			if (m_scanner->currentToken() == Token::Address)
 			{
-				expression = nodeFactory.createNode<MemberAccess>(expression, make_shared<ASTString>("address"));
+				expression = nodeFactory.createNode<MemberAccess>(expression, Symbol("address").shared());
 				m_scanner->next();
 			}
 			else
@@ -1848,18 +1988,18 @@ ASTPointer<Expression> Parser::parsePrimaryExpression()
 		m_scanner->next();
 		if (m_scanner->currentToken() == Token::Illegal)
 			fatalParserError(5428_error, to_string(m_scanner->currentError()));
-		expression = nodeFactory.createNode<Literal>(token, make_shared<ASTString>(literal));
+		expression = nodeFactory.createNode<Literal>(token, makeShared<ASTString>(literal));
 		break;
 	}
 	case Token::Identifier:
 		nodeFactory.markEndPosition();
-		expression = nodeFactory.createNode<Identifier>(getLiteralAndAdvance());
+		expression = nodeFactory.createNode<Identifier>(getIdentifierAndAdvance());
 		break;
 	case Token::Type:
 		// Inside expressions "type" is the name of a special, globally-available function.
 		nodeFactory.markEndPosition();
 		m_scanner->next();
-		expression = nodeFactory.createNode<Identifier>(make_shared<ASTString>("type"));
+		expression = nodeFactory.createNode<Identifier>(Symbol("type").shared());
 		break;
 	case Token::LParen:
 	case Token::LBrack:
@@ -1958,7 +2098,7 @@ pair<vector<ASTPointer<Expression>>, vector<ASTPointer<ASTString>>> Parser::pars
 		if (!first)
 			expectToken(Token::Comma);
 
-		ret.second.push_back(expectIdentifierToken());
+		ret.second.push_back(makeShared<ASTString>(*expectIdentifierToken()));
 		expectToken(Token::Colon);
 		ret.first.push_back(parseExpression());
 
@@ -1994,7 +2134,7 @@ optional<string> Parser::findLicenseString(std::vector<ASTPointer<ASTNode>> cons
 
 	// Search inside all parts of the source not covered by parsed nodes.
 	// This will leave e.g. "global comments".
-	string const& source = m_scanner->source();
+	string_view source = m_scanner->source();
 	using iter = decltype(source.begin());
 	vector<pair<iter, iter>> sequencesToSearch;
 	sequencesToSearch.emplace_back(source.begin(), source.end());
@@ -2008,7 +2148,7 @@ optional<string> Parser::findLicenseString(std::vector<ASTPointer<ASTNode>> cons
 	vector<string> matches;
 	for (auto const& [start, end]: sequencesToSearch)
 	{
-		smatch match;
+		match_results<iter> match;
 		if (regex_search(start, end, match, licenseRegex))
 		{
 			string license{boost::trim_copy(string(match[1]))};
@@ -2022,7 +2162,7 @@ optional<string> Parser::findLicenseString(std::vector<ASTPointer<ASTNode>> cons
 	else if (matches.empty())
 		parserWarning(
 			1878_error,
-			{-1, -1, m_scanner->charStream()},
+			{-1, -1, m_scanner->charStream()->internedName()},
 			"SPDX license identifier not provided in source file. "
 			"Before publishing, consider adding a comment containing "
 			"\"SPDX-License-Identifier: <SPDX-License>\" to each source file. "
@@ -2032,7 +2172,7 @@ optional<string> Parser::findLicenseString(std::vector<ASTPointer<ASTNode>> cons
 	else
 		parserError(
 			3716_error,
-			{-1, -1, m_scanner->charStream()},
+			{-1, -1, m_scanner->charStream()->internedName()},
 			"Multiple SPDX license identifiers found in source file. "
 			"Use \"AND\" or \"OR\" to combine multiple licenses. "
 			"Please see https://spdx.org for more information."
@@ -2175,7 +2315,7 @@ ASTPointer<Expression> Parser::expressionFromIndexAccessStructure(
 		Identifier const& identifier = dynamic_cast<Identifier const&>(*_iap.path[i]);
 		expression = nodeFactory.createNode<MemberAccess>(
 			expression,
-			make_shared<ASTString>(identifier.name())
+			makeShared<ASTString>(identifier.name())
 		);
 	}
 	for (auto const& index: _iap.indices)
@@ -2197,16 +2337,23 @@ ASTPointer<ParameterList> Parser::createEmptyParameterList()
 	return nodeFactory.createNode<ParameterList>(vector<ASTPointer<VariableDeclaration>>());
 }
 
-ASTPointer<ASTString> Parser::expectIdentifierToken()
+ASTPointer<ASTString const> Parser::expectIdentifierToken()
 {
 	// do not advance on success
 	expectToken(Token::Identifier, false);
-	return getLiteralAndAdvance();
+	return getIdentifierAndAdvance();
+}
+
+ASTPointer<ASTString const> Parser::getIdentifierAndAdvance()
+{
+	ASTPointer<ASTString const> identifier = Symbol(m_scanner->currentLiteral()).shared();
+	m_scanner->next();
+	return identifier;
 }
 
 ASTPointer<ASTString> Parser::getLiteralAndAdvance()
 {
-	ASTPointer<ASTString> identifier = make_shared<ASTString>(m_scanner->currentLiteral());
+	ASTPointer<ASTString> identifier = makeShared<ASTString>(m_scanner->currentLiteral());
 	m_scanner->next();
 	return identifier;
 }
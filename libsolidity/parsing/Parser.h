@@ -24,8 +24,12 @@
 #pragma once
 
 #include <libsolidity/ast/AST.h>
+#include <libsolidity/ast/ASTAnnotationTable.h>
 #include <liblangutil/ParserBase.h>
 #include <liblangutil/EVMVersion.h>
+#include <libsolutil/Arena.h>
+
+#include <algorithm>
 
 namespace solidity::langutil
 {
@@ -49,6 +53,29 @@ public:
 
 	ASTPointer<SourceUnit> parse(std::shared_ptr<langutil::Scanner> const& _scanner);
 
+	/// Makes the parser assign IDs larger than @a _id to new nodes, so that they do not clash
+	/// with the IDs of nodes created by another parser.
+	void continueIDsAfter(int64_t _id) { m_currentNodeID = std::max(m_currentNodeID, _id); }
+	/// @returns the largest ID assigned to a node so far.
+	int64_t maxID() const { return m_currentNodeID; }
+
+	/// Parses the source of @a _scanner, which was created by replacing the text from @a _editStart
+	/// up to @a _oldEditEnd of the source @a _sourceUnit was parsed from, by parsing only the body
+	/// of the function or modifier containing the edit again. The new body replaces the old one in
+	/// @a _sourceUnit and the locations of the nodes after it are moved, while all other nodes keep
+	/// their IDs. The nodes of the new body get IDs as in a new source unit.
+	/// Only succeeds if the edit does not touch the braces of the body, the new body has no errors
+	/// and ends where the edit moved the end of the old one, and there is no inline assembly after
+	/// the body, whose locations cannot be moved. Otherwise, @a _sourceUnit is not changed.
+	/// @returns the new body or nullptr if the source has to be parsed as a whole.
+	ASTPointer<Block> reparseBody(
+		SourceUnit& _sourceUnit,
+		std::shared_ptr<langutil::Scanner> const& _scanner,
+		int _editStart,
+		int _oldEditEnd,
+		int _newEditEnd
+	);
+
 private:
 	class ASTNodeFactory;
 
@@ -151,7 +178,7 @@ private:
 	std::vector<ASTPointer<Expression>> parseFunctionCallListArguments();
 	std::pair<std::vector<ASTPointer<Expression>>, std::vector<ASTPointer<ASTString>>> parseFunctionCallArguments();
 	std::pair<std::vector<ASTPointer<Expression>>, std::vector<ASTPointer<ASTString>>> parseNamedArguments();
-	std::pair<ASTPointer<ASTString>, langutil::SourceLocation> expectIdentifierWithLocation();
+	std::pair<ASTPointer<ASTString const>, langutil::SourceLocation> expectIdentifierWithLocation();
 	///@}
 
 	///@{
@@ -185,6 +212,14 @@ private:
 	/// Returns the next AST node ID
 	int64_t nextID() { return ++m_currentNodeID; }
 
+	/// Creates an object owned by the arena of the source unit being parsed.
+	template <class T, typename... Args>
+	ASTPointer<T> makeShared(Args&& ... _args)
+	{
+		solAssert(m_arena, "");
+		return std::allocate_shared<T>(util::ArenaAllocator<T>(m_arena), std::forward<Args>(_args)...);
+	}
+
 	std::pair<LookAheadInfo, IndexAccessedPath> tryParseIndexAccessedPath();
 	/// Performs limited look-ahead to distinguish between variable declaration and expression statement.
 	/// For source code of the form "a[][8]" ("IndexAccessStructure"), this is not possible to
@@ -200,8 +235,11 @@ private:
 	/// or an empty pointer if an empty @a _pathAndIncides has been supplied.
 	ASTPointer<Expression> expressionFromIndexAccessStructure(IndexAccessedPath const& _pathAndIndices);
 
-	ASTPointer<ASTString> expectIdentifierToken();
+	ASTPointer<ASTString const> expectIdentifierToken();
 	ASTPointer<ASTString> getLiteralAndAdvance();
+	/// Same as getLiteralAndAdvance, but interns the literal, so that all occurrences of a
+	/// name share its text.
+	ASTPointer<ASTString const> getIdentifierAndAdvance();
 	///@}
 
 	/// Creates an empty ParameterList at the current location (used if parameters can be omitted).
@@ -212,6 +250,10 @@ private:
 	langutil::EVMVersion m_evmVersion;
 	/// Counter for the next AST node ID
 	int64_t m_currentNodeID = 0;
+	/// Memory for the nodes, strings and annotations of the source unit being parsed.
+	std::shared_ptr<util::Arena> m_arena;
+	/// Annotations of the nodes of the source unit being parsed, owned by the arena.
+	ASTAnnotationTable* m_annotationTable = nullptr;
 };
 
 }
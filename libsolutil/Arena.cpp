@@ -0,0 +1,75 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Allocation of many small objects that are freed together.
+ */
+
+#include <libsolutil/Arena.h>
+
+#include <libsolutil/Assertions.h>
+
+#include <algorithm>
+
+using namespace std;
+using namespace solidity::util;
+
+Arena::Arena(size_t _initialBlockSize, MemorySubsystem _subsystem):
+	m_nextBlockSize(max<size_t>(_initialBlockSize, 64)),
+	m_memory(_subsystem)
+{
+}
+
+void* Arena::allocate(size_t _size, size_t _alignment)
+{
+	assertThrow(_alignment > 0 && _alignment <= alignof(max_align_t), Exception, "Unsupported alignment.");
+	size_t size = max<size_t>(_size, 1);
+	void* position = m_current;
+	size_t space = static_cast<size_t>(m_end - m_current);
+	if (m_current && align(_alignment, size, position, space))
+	{
+		m_current = static_cast<byte*>(position) + size;
+		return position;
+	}
+
+	// Objects that would waste a large part of a new block get a block of their own,
+	// so that the rest of the current block can still be used.
+	if (size > m_nextBlockSize / 4)
+		return allocateBlock(size);
+
+	m_current = static_cast<byte*>(allocateBlock(m_nextBlockSize));
+	m_end = m_current + m_nextBlockSize;
+	m_nextBlockSize = min(m_nextBlockSize * 2, MaxBlockSize);
+	void* result = m_current;
+	m_current += size;
+	return result;
+}
+
+void* Arena::allocateSynchronized(size_t _size, size_t _alignment)
+{
+	lock_guard<mutex> lock(m_mutex);
+	return allocate(_size, _alignment);
+}
+
+void* Arena::allocateBlock(size_t _size)
+{
+	// Memory returned by new is suitably aligned for any object.
+	m_blocks.emplace_back(new byte[_size]);
+	m_reservedBytes += _size;
+	m_memory.add(_size);
+	return m_blocks.back().get();
+}
@@ -0,0 +1,118 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Allocation of many small objects that are freed together.
+ */
+
+#pragma once
+
+#include <libsolutil/MemoryAccounting.h>
+
+#include <boost/noncopyable.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace solidity::util
+{
+
+/**
+ * Memory that is handed out in pieces by bumping a pointer and only freed as a whole
+ * when the arena is destroyed. Objects placed in the arena have to be destroyed
+ * explicitly; their memory is not reused.
+ */
+class Arena: boost::noncopyable
+{
+public:
+	/// @param _initialBlockSize size of the first block. Each further block is twice as
+	/// large as the previous one, up to @a MaxBlockSize.
+	/// @param _subsystem subsystem the reserved memory is accounted to.
+	explicit Arena(size_t _initialBlockSize = 4096, MemorySubsystem _subsystem = MemorySubsystem::AST);
+
+	/// @returns @a _size bytes aligned to @a _alignment, which can be at most alignof(std::max_align_t).
+	/// Not synchronized, i.e. it must not be called concurrently with any other allocation.
+	void* allocate(size_t _size, size_t _alignment);
+	/// Same as @a allocate, but can be called concurrently with other calls to this function.
+	void* allocateSynchronized(size_t _size, size_t _alignment);
+
+	/// Creates an object of type @a T that is destroyed together with the arena, before
+	/// the memory of the arena is freed. Not synchronized.
+	template <class T, class... Args>
+	T& create(Args&&... _args)
+	{
+		auto object = std::make_shared<T>(std::forward<Args>(_args)...);
+		T& result = *object;
+		m_objects.emplace_back(std::move(object));
+		return result;
+	}
+
+	/// @returns the number of bytes reserved from the system so far.
+	size_t reservedBytes() const { return m_reservedBytes; }
+	/// @returns the account of the reserved memory, from which parts handed out for another
+	/// subsystem can be transferred.
+	MemoryAccount& memoryAccount() { return m_memory; }
+
+	static size_t constexpr MaxBlockSize = 1024 * 1024;
+
+private:
+	void* allocateBlock(size_t _size);
+
+	std::vector<std::unique_ptr<std::byte[]>> m_blocks;
+	std::byte* m_current = nullptr;
+	std::byte* m_end = nullptr;
+	size_t m_nextBlockSize;
+	size_t m_reservedBytes = 0;
+	MemoryAccount m_memory;
+	std::mutex m_mutex;
+	/// Objects created by @a create. Declared after the blocks, so that they are destroyed first.
+	std::vector<std::shared_ptr<void>> m_objects;
+};
+
+/**
+ * Standard allocator placing objects into an arena, e.g. for use with std::allocate_shared.
+ * Every copy keeps the arena alive, so objects allocated with it can outlive their creator.
+ * Deallocation does nothing.
+ */
+template <class T>
+class ArenaAllocator
+{
+public:
+	using value_type = T;
+
+	explicit ArenaAllocator(std::shared_ptr<Arena> _arena): m_arena(std::move(_arena)) {}
+	template <class U>
+	ArenaAllocator(ArenaAllocator<U> const& _other): m_arena(_other.arena()) {}
+
+	T* allocate(size_t _count) { return static_cast<T*>(m_arena->allocate(sizeof(T) * _count, alignof(T))); }
+	void deallocate(T*, size_t) noexcept {}
+
+	std::shared_ptr<Arena> const& arena() const { return m_arena; }
+
+	template <class U>
+	bool operator==(ArenaAllocator<U> const& _other) const { return m_arena == _other.arena(); }
+	template <class U>
+	bool operator!=(ArenaAllocator<U> const& _other) const { return m_arena != _other.arena(); }
+
+private:
+	std::shared_ptr<Arena> m_arena;
+};
+
+}
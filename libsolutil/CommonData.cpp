@@ -28,6 +28,9 @@
 
 #include <boost/algorithm/string.hpp>
 
+#include <array>
+#include <ostream>
+
 using namespace std;
 using namespace solidity;
 using namespace solidity::util;
@@ -38,6 +41,45 @@ namespace
 static char const* upperHexChars = "0123456789ABCDEF";
 static char const* lowerHexChars = "0123456789abcdef";
 
+/// The hex duplets of all byte values, so that every byte is converted with a single copy.
+using HexDuplets = array<char, 512>;
+
+HexDuplets makeHexDuplets(char const* _chars)
+{
+	HexDuplets duplets;
+	for (size_t i = 0; i < 256; ++i)
+	{
+		duplets[2 * i] = _chars[i >> 4];
+		duplets[2 * i + 1] = _chars[i & 0xf];
+	}
+	return duplets;
+}
+
+HexDuplets const& hexDuplets(HexCase _case)
+{
+	static HexDuplets const lower = makeHexDuplets(lowerHexChars);
+	static HexDuplets const upper = makeHexDuplets(upperHexChars);
+	return _case == HexCase::Upper ? upper : lower;
+}
+
+/// The values of the hex characters, -1 for the other characters.
+array<int8_t, 256> const& hexValues()
+{
+	static array<int8_t, 256> const values = []() {
+		array<int8_t, 256> result;
+		result.fill(-1);
+		for (int8_t i = 0; i < 10; ++i)
+			result[static_cast<uint8_t>('0' + i)] = i;
+		for (int8_t i = 0; i < 6; ++i)
+		{
+			result[static_cast<uint8_t>('a' + i)] = static_cast<int8_t>(10 + i);
+			result[static_cast<uint8_t>('A' + i)] = static_cast<int8_t>(10 + i);
+		}
+		return result;
+	}();
+	return values;
+}
+
 }
 
 string solidity::util::toHex(uint8_t _data, HexCase _case)
@@ -62,22 +104,51 @@ string solidity::util::toHex(bytes const& _data, HexPrefix _prefix, HexCase _cas
 		ret[i++] = '0';
 		ret[i++] = 'x';
 	}
+	char* end = toHex(bytesConstRef(&_data), ret.data() + i, _case);
+	assertThrow(end == ret.data() + ret.size(), Exception, "");
 
-	// Mixed case will be handled inside the loop.
-	char const* chars = _case == HexCase::Upper ? upperHexChars : lowerHexChars;
-	size_t rix = _data.size() - 1;
-	for (uint8_t c: _data)
+	return ret;
+}
+
+char* solidity::util::toHex(bytesConstRef _data, char* _out, HexCase _case)
+{
+	if (_case == HexCase::Mixed)
 	{
-		// switch hex case every four hexchars
-		if (_case == HexCase::Mixed)
-			chars = (rix-- & 2) == 0 ? lowerHexChars : upperHexChars;
+		size_t rix = _data.size() - 1;
+		for (uint8_t c: _data)
+		{
+			// switch hex case every four hexchars
+			char const* chars = (rix-- & 2) == 0 ? lowerHexChars : upperHexChars;
+			*_out++ = chars[(static_cast<size_t>(c) >> 4ul) & 0xfu];
+			*_out++ = chars[c & 0xfu];
+		}
+		return _out;
+	}
 
-		ret[i++] = chars[(static_cast<size_t>(c) >> 4ul) & 0xfu];
-		ret[i++] = chars[c & 0xfu];
+	char const* duplets = hexDuplets(_case).data();
+	for (uint8_t c: _data)
+	{
+		memcpy(_out, duplets + 2 * size_t(c), 2);
+		_out += 2;
 	}
-	assertThrow(i == ret.size(), Exception, "");
+	return _out;
+}
 
-	return ret;
+void solidity::util::toHex(ostream& _out, bytesConstRef _data, HexCase _case)
+{
+	size_t const bufferBytes = 2048;
+	char buffer[2 * bufferBytes];
+	// Mixed case depends on the position from the end, so it cannot be printed in parts.
+	if (_case == HexCase::Mixed)
+	{
+		_out << toHex(_data.toBytes(), HexPrefix::DontAdd, _case);
+		return;
+	}
+	for (size_t offset = 0; offset < _data.size(); offset += bufferBytes)
+	{
+		char* end = toHex(_data.cropped(offset, min(bufferBytes, _data.size() - offset)), buffer, _case);
+		_out.write(buffer, end - buffer);
+	}
 }
 
 int solidity::util::fromHex(char _i, WhenError _throw)
@@ -99,24 +170,32 @@ bytes solidity::util::fromHex(std::string const& _s, WhenError _throw)
 	if (_s.empty())
 		return {};
 
-	unsigned s = (_s.size() >= 2 && _s[0] == '0' && _s[1] == 'x') ? 2 : 0;
-	std::vector<uint8_t> ret;
-	ret.reserve((_s.size() - s + 1) / 2);
+	size_t s = (_s.size() >= 2 && _s[0] == '0' && _s[1] == 'x') ? 2 : 0;
+	bytes ret((_s.size() - s + 1) / 2);
+	array<int8_t, 256> const& values = hexValues();
+	auto value = [&](char _c) -> int {
+		int result = values[static_cast<uint8_t>(_c)];
+		if (result == -1)
+			// Reports the invalid character or returns -1.
+			return fromHex(_c, _throw);
+		return result;
+	};
 
-	if (_s.size() % 2)
+	size_t o = 0;
+	if ((_s.size() - s) % 2)
 	{
-		int h = fromHex(_s[s++], _throw);
+		int h = value(_s[s++]);
 		if (h != -1)
-			ret.push_back(static_cast<uint8_t>(h));
+			ret[o++] = static_cast<uint8_t>(h);
 		else
 			return bytes();
 	}
-	for (unsigned i = s; i < _s.size(); i += 2)
+	for (size_t i = s; i < _s.size(); i += 2)
 	{
-		int h = fromHex(_s[i], _throw);
-		int l = fromHex(_s[i + 1], _throw);
+		int h = value(_s[i]);
+		int l = value(_s[i + 1]);
 		if (h != -1 && l != -1)
-			ret.push_back(static_cast<uint8_t>(h * 16 + l));
+			ret[o++] = static_cast<uint8_t>(h * 16 + l);
 		else
 			return bytes();
 	}
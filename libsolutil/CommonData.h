@@ -34,6 +34,7 @@
 #include <string>
 #include <set>
 #include <functional>
+#include <iosfwd>
 #include <utility>
 #include <type_traits>
 
@@ -327,6 +328,13 @@ std::string toHex(uint8_t _data, HexCase _case = HexCase::Lower);
 /// optionally with "0x" prefix and with uppercase hex letters.
 std::string toHex(bytes const& _data, HexPrefix _prefix = HexPrefix::DontAdd, HexCase _case = HexCase::Lower);
 
+/// Writes the hex duplets of @a _data to @a _out, which has to have room for twice as many
+/// characters as there are bytes. @returns the end of the written characters.
+char* toHex(bytesConstRef _data, char* _out, HexCase _case = HexCase::Lower);
+
+/// Prints the hex duplets of @a _data to @a _out without building the string first.
+void toHex(std::ostream& _out, bytesConstRef _data, HexCase _case = HexCase::Lower);
+
 /// Converts a (printable) ASCII hex character into the corresponding integer value.
 /// @example fromHex('A') == 10 && fromHex('f') == 15 && fromHex('5') == 5
 int fromHex(char _i, WhenError _throw);
@@ -68,6 +68,41 @@ string solidity::util::readFileAsString(string const& _file)
 	return readFile<string>(_file);
 }
 
+bool solidity::util::writeFileAtomically(string const& _file, string const& _content)
+{
+	namespace fs = boost::filesystem;
+
+	fs::path const path(_file);
+	boost::system::error_code error;
+	if (path.has_parent_path())
+	{
+		fs::create_directories(path.parent_path(), error);
+		if (error)
+			return false;
+	}
+
+	fs::path const temporaryPath = path.parent_path() / fs::unique_path("%%%%-%%%%-%%%%-%%%%.tmp", error);
+	if (error)
+		return false;
+	{
+		ofstream file(temporaryPath.string(), ios::binary | ios::trunc);
+		file << _content;
+		file.close();
+		if (!file)
+		{
+			fs::remove(temporaryPath, error);
+			return false;
+		}
+	}
+	fs::rename(temporaryPath, path, error);
+	if (error)
+	{
+		fs::remove(temporaryPath, error);
+		return false;
+	}
+	return true;
+}
+
 string solidity::util::readStandardInput()
 {
 	string ret;
@@ -36,6 +36,12 @@ namespace solidity::util
 /// If the file is empty, returns an empty string.
 std::string readFileAsString(std::string const& _file);
 
+/// Writes @a _content to the given file, creating missing parent directories.
+/// The content is written to a temporary file in the same directory first, which is then
+/// renamed, so that concurrent readers never see a partially written file.
+/// @returns false if the file could not be written.
+bool writeFileAtomically(std::string const& _file, std::string const& _content);
+
 /// Retrieve and returns the contents of standard input (until EOF).
 std::string readStandardInput();
 
@@ -0,0 +1,152 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Wall time and memory usage of the phases of a compilation.
+ */
+
+#include <libsolutil/CompilationStatistics.h>
+
+#include <algorithm>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/resource.h>
+#endif
+
+using namespace std;
+using namespace solidity::util;
+
+namespace
+{
+thread_local CompilationStatistics* currentStatistics = nullptr;
+}
+
+CompilationStatistics::Scope::Scope(CompilationStatistics* _statistics):
+	m_previous(currentStatistics)
+{
+	currentStatistics = _statistics;
+}
+
+CompilationStatistics::Scope::~Scope()
+{
+	currentStatistics = m_previous;
+}
+
+void CompilationStatistics::PhaseTimer::switchTo(char const* _phase)
+{
+	stop();
+	start(_phase);
+}
+
+void CompilationStatistics::PhaseTimer::start(char const* _phase)
+{
+	if (Tracer::active())
+		m_span.emplace("phase", _phase);
+
+	m_statistics = currentStatistics;
+	if (m_statistics && m_statistics->m_activePhases.insert(_phase).second)
+	{
+		m_phase = _phase;
+		m_start = chrono::steady_clock::now();
+	}
+	else
+		m_statistics = nullptr;
+}
+
+void CompilationStatistics::PhaseTimer::stop()
+{
+	m_span.reset();
+
+	if (!m_statistics)
+		return;
+	m_statistics->recordPhase(m_phase, chrono::steady_clock::now() - m_start);
+	m_statistics->m_activePhases.erase(m_phase);
+	m_statistics = nullptr;
+}
+
+CompilationStatistics* CompilationStatistics::current()
+{
+	return currentStatistics;
+}
+
+void CompilationStatistics::recordPhase(string const& _phase, chrono::nanoseconds _time)
+{
+	Phase& phase = m_phases[_phase];
+	++phase.runs;
+	phase.time += _time;
+	phase.peakMemory = max(phase.peakMemory, peakMemoryUsage());
+}
+
+void CompilationStatistics::recordOptimiserStep(string const& _step, bool _changed, chrono::nanoseconds _time)
+{
+	OptimiserStep& step = m_optimiserSteps[_step];
+	++step.runs;
+	if (_changed)
+		++step.changes;
+	step.time += _time;
+}
+
+void CompilationStatistics::recordCache(string const& _cache, size_t _hits, size_t _misses)
+{
+	Cache& cache = m_caches[_cache];
+	cache.hits += _hits;
+	cache.misses += _misses;
+}
+
+void CompilationStatistics::recordCount(string const& _counter, size_t _count)
+{
+	m_counters[_counter] += _count;
+}
+
+void CompilationStatistics::merge(CompilationStatistics const& _other)
+{
+	for (auto const& [name, other]: _other.m_phases)
+	{
+		Phase& phase = m_phases[name];
+		phase.runs += other.runs;
+		phase.time += other.time;
+		phase.peakMemory = max(phase.peakMemory, other.peakMemory);
+	}
+	for (auto const& [name, other]: _other.m_optimiserSteps)
+	{
+		OptimiserStep& step = m_optimiserSteps[name];
+		step.runs += other.runs;
+		step.changes += other.changes;
+		step.time += other.time;
+	}
+	for (auto const& [name, other]: _other.m_caches)
+		recordCache(name, other.hits, other.misses);
+	for (auto const& [name, count]: _other.m_counters)
+		recordCount(name, count);
+}
+
+size_t CompilationStatistics::peakMemoryUsage()
+{
+#if defined(__unix__) || defined(__APPLE__)
+	rusage usage{};
+	if (getrusage(RUSAGE_SELF, &usage) != 0 || usage.ru_maxrss <= 0)
+		return 0;
+#if defined(__APPLE__)
+	// Reported in bytes on macOS and in kilobytes elsewhere.
+	return static_cast<size_t>(usage.ru_maxrss);
+#else
+	return static_cast<size_t>(usage.ru_maxrss) * 1024;
+#endif
+#else
+	return 0;
+#endif
+}
@@ -0,0 +1,141 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Wall time and memory usage of the phases of a compilation.
+ */
+
+#pragma once
+
+#include <libsolutil/Tracer.h>
+
+#include <boost/noncopyable.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <map>
+#include <optional>
+#include <set>
+#include <string>
+
+namespace solidity::util
+{
+
+/**
+ * Statistics about the phases of a compilation and the optimiser steps run during them.
+ *
+ * Statistics are collected per thread: While a Scope is alive, PhaseTimer and the optimiser
+ * suite record into the statistics object of the scope. Without a scope, nothing is measured,
+ * so that the instrumentation is cheap when it is not requested.
+ */
+class CompilationStatistics
+{
+public:
+	struct Phase
+	{
+		size_t runs = 0;
+		std::chrono::nanoseconds time{0};
+		/// Highest peak resident set size of the process at the end of a run, in bytes.
+		size_t peakMemory = 0;
+	};
+
+	struct OptimiserStep
+	{
+		size_t runs = 0;
+		/// Number of runs that changed the code.
+		size_t changes = 0;
+		std::chrono::nanoseconds time{0};
+	};
+
+	struct Cache
+	{
+		/// Number of lookups that found a result computed before.
+		size_t hits = 0;
+		/// Number of results that had to be computed.
+		size_t misses = 0;
+	};
+
+	/// Makes the statistics of the current thread go to @a _statistics while alive.
+	/// A null pointer disables collecting statistics.
+	class Scope: boost::noncopyable
+	{
+	public:
+		explicit Scope(CompilationStatistics* _statistics);
+		~Scope();
+
+	private:
+		CompilationStatistics* m_previous = nullptr;
+	};
+
+	/// Measures the time from its construction to its destruction (or to the next call to
+	/// @a switchTo) and records it as a run of the named phase in the current statistics.
+	/// Runs of a phase nested inside a run of the same phase are not counted separately.
+	/// The run is also recorded as a span of the active tracer, if there is one.
+	class PhaseTimer: boost::noncopyable
+	{
+	public:
+		explicit PhaseTimer(char const* _phase) { start(_phase); }
+		~PhaseTimer() { stop(); }
+
+		/// Ends the current phase and starts measuring @a _phase.
+		void switchTo(char const* _phase);
+
+	private:
+		void start(char const* _phase);
+		void stop();
+
+		CompilationStatistics* m_statistics = nullptr;
+		std::string m_phase;
+		std::chrono::steady_clock::time_point m_start;
+		std::optional<Tracer::Span> m_span;
+	};
+
+	/// @returns the statistics measurements on this thread are recorded in, or nullptr.
+	static CompilationStatistics* current();
+
+	void recordPhase(std::string const& _phase, std::chrono::nanoseconds _time);
+	void recordOptimiserStep(std::string const& _step, bool _changed, std::chrono::nanoseconds _time);
+	void recordCache(std::string const& _cache, size_t _hits, size_t _misses);
+	/// Adds @a _count to the named counter, e.g. the number of applications of an optimiser rule.
+	void recordCount(std::string const& _counter, size_t _count);
+
+	/// Adds the runs recorded in @a _other.
+	void merge(CompilationStatistics const& _other);
+
+	bool empty() const
+	{
+		return m_phases.empty() && m_optimiserSteps.empty() && m_caches.empty() && m_counters.empty();
+	}
+	std::map<std::string, Phase> const& phases() const { return m_phases; }
+	std::map<std::string, OptimiserStep> const& optimiserSteps() const { return m_optimiserSteps; }
+	std::map<std::string, Cache> const& caches() const { return m_caches; }
+	std::map<std::string, size_t> const& counters() const { return m_counters; }
+
+	/// @returns the peak resident set size of the process so far in bytes
+	/// or zero if it cannot be determined on this platform.
+	static size_t peakMemoryUsage();
+
+private:
+	std::map<std::string, Phase> m_phases;
+	std::map<std::string, OptimiserStep> m_optimiserSteps;
+	std::map<std::string, Cache> m_caches;
+	std::map<std::string, size_t> m_counters;
+	/// Phases currently measured by a PhaseTimer.
+	std::set<std::string> m_activePhases;
+};
+
+}
@@ -115,89 +115,85 @@ Chunk combineLinks(Chunks& _links)
 	return chunk;
 }
 
-Chunks buildNextLevel(Chunks& _currentLevel)
+/// @returns the data node of the file chunk @a _data, hashing the encoded node without copying the chunk.
+Chunk dataChunk(string_view _data)
 {
-	size_t const maxChildNum = 174;
-
-	Chunks nextLevel;
-	Chunks links;
+	bytes lengthAsVarint = varintEncoding(_data.size());
 
-	for (Chunk& chunk: _currentLevel)
+	// Type: File
+	bytes header{0x08, 0x02};
+	if (!_data.empty())
 	{
-		links.emplace_back(std::move(chunk.hash), chunk.size, chunk.blockSize);
-		if (links.size() == maxChildNum)
-		{
-			nextLevel.emplace_back(combineLinks(links));
-			links = {};
-		}
+		// Data (length delimited bytes)
+		header += bytes{0x12};
+		header += lengthAsVarint;
 	}
-	if (!links.empty())
-		nextLevel.emplace_back(combineLinks(links));
-
-	return nextLevel;
-}
-
-/// Builds a tree starting from the bottom level where nodes are data nodes.
-/// Data nodes should be calculated and passed as the only level in chunk levels
-/// Each next level is calculated as following:
-///   - Pick up to maxChildNum (174) nodes until a whole level is added, group them and pass to the node in the next level
-///   - Do this until the current level has only one node, return the hash in that node
-bytes groupChunksBottomUp(Chunks _currentLevel)
-{
-	// when we reach root it will be the only node in that level
-	while (_currentLevel.size() != 1)
-		_currentLevel = buildNextLevel(_currentLevel);
-
-	// top level's only node stores the hash for file
-	return _currentLevel.front().hash;
+	// filesize: length as varint
+	bytes trailer = bytes{0x18} + lengthAsVarint;
+
+	// PBDag:
+	// Data: (length delimited bytes)
+	bytes prefix = bytes{0x0a} + varintEncoding(header.size() + _data.size() + trailer.size()) + header;
+
+	picosha2::hash256_one_by_one hasher;
+	hasher.process(prefix.begin(), prefix.end());
+	hasher.process(_data.begin(), _data.end());
+	hasher.process(trailer.begin(), trailer.end());
+	hasher.finish();
+
+	// Multihash: sha2-256, 256 bits
+	bytes hash{0x12, 0x20};
+	hash.resize(2 + picosha2::k_digest_size);
+	hasher.get_hash_bytes(hash.begin() + 2, hash.end());
+	return Chunk(move(hash), _data.size(), prefix.size() + _data.size() + trailer.size());
 }
 }
 
-bytes solidity::util::ipfsHash(string _data)
+/// Builds the tree while the data nodes are computed, with as few nodes in memory as possible.
+/// Nodes are combined as in building the tree level by level from the bottom:
+///   - Up to maxChildNum (174) nodes of a level, in order, are grouped into a node of the next level
+///   - This is repeated until a level has only one node, whose hash is the hash of the file
+/// A level can be grouped as soon as it has maxChildNum nodes, because every level with more than
+/// one node is grouped completely.
+bytes solidity::util::ipfsHash(string_view _data)
 {
 	size_t const maxChunkSize = 1024 * 256;
-	size_t chunkCount = _data.length() / maxChunkSize + (_data.length() % maxChunkSize > 0 ? 1 : 0);
-	chunkCount = chunkCount == 0 ? 1 : chunkCount;
+	size_t const maxChildNum = 174;
 
-	Chunks allChunks;
+	vector<Chunks> levels(1);
+	auto addNode = [&](size_t _level, Chunk _chunk) {
+		if (levels.size() == _level)
+			levels.emplace_back();
+		levels[_level].emplace_back(move(_chunk));
+	};
 
-	for (size_t chunkIndex = 0; chunkIndex < chunkCount; chunkIndex++)
+	size_t offset = 0;
+	do
 	{
-		bytes chunkBytes = asBytes(
-			_data.substr(chunkIndex * maxChunkSize, min(maxChunkSize, _data.length() - chunkIndex * maxChunkSize))
-		);
-
-		bytes lengthAsVarint = varintEncoding(chunkBytes.size());
-
-		bytes protobufEncodedData;
-		// Type: File
-		protobufEncodedData += bytes{0x08, 0x02};
-		if (!chunkBytes.empty())
+		addNode(0, dataChunk(_data.substr(offset, maxChunkSize)));
+		offset += maxChunkSize;
+		for (size_t level = 0; levels[level].size() == maxChildNum; ++level)
 		{
-			// Data (length delimited bytes)
-			protobufEncodedData += bytes{0x12};
-			protobufEncodedData += lengthAsVarint;
-			protobufEncodedData += chunkBytes;
+			Chunk combined = combineLinks(levels[level]);
+			levels[level].clear();
+			addNode(level + 1, move(combined));
 		}
-		// filesize: length as varint
-		protobufEncodedData += bytes{0x18} + lengthAsVarint;
-
-		// PBDag:
-		// Data: (length delimited bytes)
-		bytes blockData = encodeByteArray(protobufEncodedData);
-
-		// Multihash: sha2-256, 256 bits
-		allChunks.emplace_back(
-			encodeHash(blockData),
-			chunkBytes.size(),
-			blockData.size()
-		);
 	}
+	while (offset < _data.size());
 
-	return groupChunksBottomUp(std::move(allChunks));
+	for (size_t level = 0; ; ++level)
+		if (level + 1 == levels.size() && levels[level].size() == 1)
+			// top level's only node stores the hash for file
+			return levels[level].front().hash;
+		else if (!levels[level].empty())
+		{
+			Chunk combined = combineLinks(levels[level]);
+			levels[level].clear();
+			addNode(level + 1, move(combined));
+		}
 }
 
-string solidity::util::ipfsHashBase58(string _data)
+string solidity::util::ipfsHashBase58(string_view _data)
 {
-	return base58Encode(ipfsHash(std::move(_data)));
+	return base58Encode(ipfsHash(_data));
 }
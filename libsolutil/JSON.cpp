@@ -135,4 +135,37 @@ bool jsonParseStrict(string const& _input, Json::Value& _json, string* _errs /*
 	return parse(readerBuilder, _input, _json, _errs);
 }
 
+size_t jsonMemoryUsage(Json::Value const& _json)
+{
+	// Members of arrays and objects are stored in a map, whose nodes hold the value next to
+	// the key and the bookkeeping of the tree, about six words in total.
+	size_t constexpr nodeOverhead = 6 * sizeof(void*);
+	size_t usage = sizeof(Json::Value);
+	switch (_json.type())
+	{
+	case Json::stringValue:
+	{
+		char const* begin = nullptr;
+		char const* end = nullptr;
+		_json.getString(&begin, &end);
+		usage += static_cast<size_t>(end - begin) + sizeof(unsigned) + 1;
+		break;
+	}
+	case Json::arrayValue:
+	case Json::objectValue:
+		for (auto it = _json.begin(); it != _json.end(); ++it)
+		{
+			char const* keyEnd = nullptr;
+			char const* key = it.memberName(&keyEnd);
+			usage += nodeOverhead + jsonMemoryUsage(*it);
+			if (key)
+				usage += static_cast<size_t>(keyEnd - key) + sizeof(unsigned) + 1;
+		}
+		break;
+	default:
+		break;
+	}
+	return usage;
+}
+
 } // namespace solidity::util
@@ -45,4 +45,7 @@ std::string jsonCompactPrint(Json::Value const& _input);
 /// \return \c true if the document was successfully parsed, \c false if an error occurred.
 bool jsonParseStrict(std::string const& _input, Json::Value& _json, std::string* _errs = nullptr);
 
+/// @returns an estimate of the memory held by the JSON value @a _json and its children in bytes.
+size_t jsonMemoryUsage(Json::Value const& _json);
+
 }
@@ -0,0 +1,161 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Incremental construction of JSON objects.
+ */
+
+#include <libsolutil/JsonWriter.h>
+
+#include <libsolutil/Assertions.h>
+#include <libsolutil/JSON.h>
+
+using namespace std;
+using namespace solidity::util;
+
+void JsonWriter::addMembers(Json::Value _object)
+{
+	assertThrow(_object.isObject(), JsonWriterError, "Expected an object.");
+	for (string const& key: _object.getMemberNames())
+		addMember(key, move(_object[key]));
+}
+
+JsonStreamWriter::JsonStreamWriter(ostream& _out):
+	m_out(_out),
+	m_objects(1)
+{
+	// Same settings as jsonCompactPrint.
+	Json::StreamWriterBuilder builder;
+	builder["indentation"] = "";
+	m_writer.reset(builder.newStreamWriter());
+}
+
+JsonStreamWriter::~JsonStreamWriter() = default;
+
+void JsonStreamWriter::beginObject(string const& _key, bool _omitIfEmpty)
+{
+	assertThrow(!m_objects.empty(), JsonWriterError, "Writer already finished.");
+	Object& object = m_objects.emplace_back();
+	object.key = _key;
+	object.omitIfEmpty = _omitIfEmpty;
+}
+
+void JsonStreamWriter::endObject()
+{
+	assertThrow(m_objects.size() > 1, JsonWriterError, "No object to end.");
+	Object object = move(m_objects.back());
+	m_objects.pop_back();
+	if (object.printed)
+		m_out << '}';
+	else if (!object.omitIfEmpty)
+	{
+		startMember(object.key);
+		m_out << "{}";
+	}
+}
+
+void JsonStreamWriter::addMember(string const& _key, Json::Value _value)
+{
+	assertThrow(!m_objects.empty(), JsonWriterError, "Writer already finished.");
+	startMember(_key);
+	// Only the value that is being printed is held in memory.
+	MemoryAccount memory(MemorySubsystem::JSONOutput);
+	if (MemoryAccounting::enabled())
+		memory.set(jsonMemoryUsage(_value));
+	m_writer->write(_value, &m_out);
+}
+
+void JsonStreamWriter::addMember(
+	string const& _key,
+	function<void(ostream&)> const& _print,
+	function<Json::Value()> const&
+)
+{
+	assertThrow(!m_objects.empty(), JsonWriterError, "Writer already finished.");
+	startMember(_key);
+	_print(m_out);
+}
+
+void JsonStreamWriter::finish()
+{
+	assertThrow(m_objects.size() == 1, JsonWriterError, "Unfinished objects.");
+	if (!m_objects.front().printed)
+		m_out << '{';
+	m_out << '}';
+	m_objects.clear();
+}
+
+void JsonStreamWriter::startMember(string const& _key)
+{
+	auto printKey = [&](Object& _parent, string const& _memberKey) {
+		assertThrow(!_parent.hasMembers || _parent.lastKey < _memberKey, JsonWriterError, "Keys not in ascending order.");
+		if (_parent.hasMembers)
+			m_out << ',';
+		m_writer->write(Json::Value(_memberKey), &m_out);
+		m_out << ':';
+		_parent.hasMembers = true;
+		_parent.lastKey = _memberKey;
+	};
+
+	for (size_t i = 0; i < m_objects.size(); ++i)
+		if (!m_objects[i].printed)
+		{
+			if (i > 0)
+				printKey(m_objects[i - 1], m_objects[i].key);
+			m_out << '{';
+			m_objects[i].printed = true;
+		}
+	printKey(m_objects.back(), _key);
+}
+
+void JsonTreeWriter::beginObject(string const& _key, bool _omitIfEmpty)
+{
+	Json::Value& object = (current()[_key] = Json::objectValue);
+	m_objects.push_back({&object, _key, _omitIfEmpty});
+}
+
+void JsonTreeWriter::endObject()
+{
+	assertThrow(!m_objects.empty(), JsonWriterError, "No object to end.");
+	Object object = m_objects.back();
+	m_objects.pop_back();
+	if (object.omitIfEmpty && object.value->empty())
+		current().removeMember(object.key);
+}
+
+void JsonTreeWriter::addMember(string const& _key, Json::Value _value)
+{
+	if (MemoryAccounting::enabled())
+		m_memory.add(_key.size() + jsonMemoryUsage(_value));
+	current()[_key] = move(_value);
+}
+
+void JsonTreeWriter::addMember(
+	string const& _key,
+	function<void(ostream&)> const&,
+	function<Json::Value()> const& _build
+)
+{
+	Json::Value& value = (current()[_key] = _build());
+	if (MemoryAccounting::enabled())
+		m_memory.add(_key.size() + jsonMemoryUsage(value));
+}
+
+Json::Value& JsonTreeWriter::current()
+{
+	return m_objects.empty() ? m_root : *m_objects.back().value;
+}
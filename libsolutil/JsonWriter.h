@@ -0,0 +1,144 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Incremental construction of JSON objects.
+ */
+
+#pragma once
+
+#include <libsolutil/Exceptions.h>
+#include <libsolutil/MemoryAccounting.h>
+
+#include <json/json.h>
+
+#include <functional>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace solidity::util
+{
+
+DEV_SIMPLE_EXCEPTION(JsonWriterError);
+
+/**
+ * Receives a JSON object member by member, so that large objects can be processed
+ * without keeping all of them in memory.
+ *
+ * The members of every object have to be added in ascending order of their keys,
+ * which is the order in which jsoncpp stores and prints them.
+ */
+class JsonWriter
+{
+public:
+	virtual ~JsonWriter() = default;
+
+	/// Starts an object as member @a _key of the current object. Subsequent members are added
+	/// to it until the matching call to @a endObject. If @a _omitIfEmpty is true, the object
+	/// is left out if it does not receive any members.
+	virtual void beginObject(std::string const& _key, bool _omitIfEmpty = false) = 0;
+	virtual void endObject() = 0;
+	virtual void addMember(std::string const& _key, Json::Value _value) = 0;
+	/// Adds the member @a _key. Writers that print the object call @a _print to print its value
+	/// in the format of jsonCompactPrint, the others add the value returned by @a _build.
+	virtual void addMember(
+		std::string const& _key,
+		std::function<void(std::ostream&)> const& _print,
+		std::function<Json::Value()> const& _build
+	) = 0;
+
+	/// Adds all members of the object @a _object to the current object.
+	void addMembers(Json::Value _object);
+};
+
+/**
+ * Prints the object in the format of jsonCompactPrint while it is being built.
+ * Only the objects that are not complete yet are kept.
+ */
+class JsonStreamWriter: public JsonWriter
+{
+public:
+	explicit JsonStreamWriter(std::ostream& _out);
+	~JsonStreamWriter() override;
+
+	void beginObject(std::string const& _key, bool _omitIfEmpty = false) override;
+	void endObject() override;
+	void addMember(std::string const& _key, Json::Value _value) override;
+	void addMember(
+		std::string const& _key,
+		std::function<void(std::ostream&)> const& _print,
+		std::function<Json::Value()> const& _build
+	) override;
+
+	/// Ends the top-level object. Nothing can be added afterwards.
+	void finish();
+
+private:
+	struct Object
+	{
+		std::string key;
+		bool omitIfEmpty = false;
+		bool printed = false;
+		std::string lastKey;
+		bool hasMembers = false;
+	};
+
+	/// Prints the start of all objects that have not been printed yet and the key @a _key.
+	void startMember(std::string const& _key);
+
+	std::ostream& m_out;
+	std::unique_ptr<Json::StreamWriter> m_writer;
+	std::vector<Object> m_objects;
+};
+
+/**
+ * Builds the object as a regular Json::Value.
+ */
+class JsonTreeWriter: public JsonWriter
+{
+public:
+	void beginObject(std::string const& _key, bool _omitIfEmpty = false) override;
+	void endObject() override;
+	void addMember(std::string const& _key, Json::Value _value) override;
+	void addMember(
+		std::string const& _key,
+		std::function<void(std::ostream&)> const& _print,
+		std::function<Json::Value()> const& _build
+	) override;
+
+	/// @returns the object built so far.
+	Json::Value& result() { return m_root; }
+
+private:
+	struct Object
+	{
+		Json::Value* value = nullptr;
+		std::string key;
+		bool omitIfEmpty = false;
+	};
+
+	Json::Value& current();
+
+	Json::Value m_root{Json::objectValue};
+	std::vector<Object> m_objects;
+	/// Estimated memory of the members added so far.
+	MemoryAccount m_memory{MemorySubsystem::JSONOutput};
+};
+
+}
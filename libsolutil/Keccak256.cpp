@@ -22,10 +22,10 @@
 
 #include <libsolutil/Keccak256.h>
 
+#include <array>
 #include <cstdint>
-#include <cstdio>
-#include <cstdlib>
 #include <cstring>
+#include <map>
 
 using namespace std;
 
@@ -35,35 +35,102 @@ namespace solidity::util
 namespace
 {
 
-/** libkeccak-tiny
- *
- * A single-file implementation of SHA-3 and SHAKE.
- *
- * Implementor: David Leon Gil
- * License: CC0, attribution kindly requested. Blame taken too,
- * but not liability.
- */
-
 /******** The Keccak-f[1600] permutation ********/
+// Based on libkeccak-tiny by David Leon Gil (CC0).
 
 /*** Constants. ***/
-static uint8_t const rho[24] = \
-	{ 1,  3,   6, 10, 15, 21,
+uint8_t const rho[24] = {
+	1,  3,  6, 10, 15, 21,
 	28, 36, 45, 55,  2, 14,
 	27, 41, 56,  8, 25, 43,
-	62, 18, 39, 61, 20, 44};
-static uint8_t const pi[24] = \
-	{10,  7, 11, 17, 18, 3,
+	62, 18, 39, 61, 20, 44
+};
+uint8_t const pi[24] = {
+	10,  7, 11, 17, 18, 3,
 	5, 16,  8, 21, 24, 4,
 	15, 23, 19, 13, 12, 2,
-	20, 14, 22,  9, 6,  1};
-static uint64_t const RC[24] = \
-	{1ULL, 0x8082ULL, 0x800000000000808aULL, 0x8000000080008000ULL,
+	20, 14, 22,  9, 6,  1
+};
+uint64_t const RC[24] = {
+	1ULL, 0x8082ULL, 0x800000000000808aULL, 0x8000000080008000ULL,
 	0x808bULL, 0x80000001ULL, 0x8000000080008081ULL, 0x8000000000008009ULL,
 	0x8aULL, 0x88ULL, 0x80008009ULL, 0x8000000aULL,
 	0x8000808bULL, 0x800000000000008bULL, 0x8000000000008089ULL, 0x8000000000008003ULL,
 	0x8000000000008002ULL, 0x8000000000000080ULL, 0x800aULL, 0x800000008000000aULL,
-	0x8000000080008081ULL, 0x8000000000008080ULL, 0x80000001ULL, 0x8000000080008008ULL};
+	0x8000000080008081ULL, 0x8000000000008080ULL, 0x80000001ULL, 0x8000000080008008ULL
+};
+
+/// The rate of Keccak-256 in bytes, i.e. 200 - (256 / 4).
+size_t constexpr rate = 136;
+
+#if defined(__GNUC__)
+/// Four independent states, on which all operations are applied lane by lane in vector registers.
+using Word4 = uint64_t __attribute__((vector_size(32)));
+
+inline uint64_t getLane(Word4 const& _word, size_t _lane) { return _word[_lane]; }
+inline void xorLane(Word4& _word, size_t _lane, uint64_t _value) { _word[_lane] ^= _value; }
+#else
+/// Four independent states, on which all operations are applied lane by lane.
+struct Word4
+{
+	uint64_t lanes[4];
+
+	Word4& operator^=(Word4 const& _other)
+	{
+		for (size_t l = 0; l < 4; ++l)
+			lanes[l] ^= _other.lanes[l];
+		return *this;
+	}
+	Word4 operator^(Word4 const& _other) const { Word4 result = *this; return result ^= _other; }
+	Word4 operator&(Word4 const& _other) const
+	{
+		Word4 result;
+		for (size_t l = 0; l < 4; ++l)
+			result.lanes[l] = lanes[l] & _other.lanes[l];
+		return result;
+	}
+	Word4 operator~() const
+	{
+		Word4 result;
+		for (size_t l = 0; l < 4; ++l)
+			result.lanes[l] = ~lanes[l];
+		return result;
+	}
+	Word4 operator|(Word4 const& _other) const
+	{
+		Word4 result;
+		for (size_t l = 0; l < 4; ++l)
+			result.lanes[l] = lanes[l] | _other.lanes[l];
+		return result;
+	}
+	Word4 operator<<(unsigned _shift) const
+	{
+		Word4 result;
+		for (size_t l = 0; l < 4; ++l)
+			result.lanes[l] = lanes[l] << _shift;
+		return result;
+	}
+	Word4 operator>>(unsigned _shift) const
+	{
+		Word4 result;
+		for (size_t l = 0; l < 4; ++l)
+			result.lanes[l] = lanes[l] >> _shift;
+		return result;
+	}
+	Word4& operator^=(uint64_t _value)
+	{
+		for (size_t l = 0; l < 4; ++l)
+			lanes[l] ^= _value;
+		return *this;
+	}
+};
+
+inline uint64_t getLane(Word4 const& _word, size_t _lane) { return _word.lanes[_lane]; }
+inline void xorLane(Word4& _word, size_t _lane, uint64_t _value) { _word.lanes[_lane] ^= _value; }
+#endif
+
+inline uint64_t getLane(uint64_t _word, size_t) { return _word; }
+inline void xorLane(uint64_t& _word, size_t, uint64_t _value) { _word ^= _value; }
 
 /*** Helper macros to unroll the permutation. ***/
 #define rol(x, s) (((x) << s) | ((x) >> (64 - s)))
@@ -75,23 +142,26 @@ static uint64_t const RC[24] = \
 	REPEAT5(e; v = static_cast<type>(v + s);)
 
 /*** Keccak-f[1600] ***/
-static inline void keccakf(void* state) {
-	auto* a = static_cast<uint64_t*>(state);
-	uint64_t b[5] = {0};
+/// Applies the permutation to the state @a a, whose words are either uint64_t or Word4
+/// to permute several states at once.
+template <class W>
+inline void keccakf(W* a)
+{
+	W b[5];
 
 	for (int i = 0; i < 24; i++)
 	{
 		uint8_t x, y;
 		// Theta
 		FOR5(uint8_t, x, 1,
-			b[x] = 0;
+			b[x] = W{};
 			FOR5(uint8_t, y, 5,
 				b[x] ^= a[x + y]; ))
 		FOR5(uint8_t, x, 1,
 			FOR5(uint8_t, y, 5,
 				a[y + x] ^= b[(x + 4) % 5] ^ rol(b[(x + 1) % 5], 1); ))
 		// Rho and pi
-		uint64_t t = a[1];
+		W t = a[1];
 		x = 0;
 		REPEAT24(b[0] = a[pi[x]];
 				a[pi[x]] = rol(t, rho[x]);
@@ -110,65 +180,88 @@ static inline void keccakf(void* state) {
 	}
 }
 
-/******** The FIPS202-defined functions. ********/
+#undef rol
+#undef REPEAT6
+#undef REPEAT24
+#undef REPEAT5
+#undef FOR5
 
-/*** Some helper macros. ***/
+inline uint64_t load64(uint8_t const* _data)
+{
+	uint64_t result = 0;
+	for (size_t i = 0; i < 8; ++i)
+		result |= uint64_t(_data[i]) << (8 * i);
+	return result;
+}
 
-#define _(S) do { S } while (0)
-#define FOR(i, ST, L, S) \
-	_(for (size_t i = 0; i < L; i += ST) { S; })
-#define mkapply_ds(NAME, S)                                          \
-	static inline void NAME(uint8_t* dst,                              \
-							uint8_t const* src,                        \
-							size_t len) {                              \
-		FOR(i, 1, len, S);                                               \
-	}
-#define mkapply_sd(NAME, S)                                          \
-	static inline void NAME(uint8_t const* src,                        \
-							uint8_t* dst,                              \
-							size_t len) {                              \
-		FOR(i, 1, len, S);                                               \
-	}
+inline void store64(uint8_t* _data, uint64_t _value)
+{
+	for (size_t i = 0; i < 8; ++i)
+		_data[i] = uint8_t(_value >> (8 * i));
+}
 
-mkapply_ds(xorin, dst[i] ^= src[i])  // xorin
-mkapply_sd(setout, dst[i] = src[i])  // setout
+/// Xors the block of @a rate bytes at @a _block into lane @a _lane of @a _state.
+template <class W>
+void absorb(W* _state, size_t _lane, uint8_t const* _block)
+{
+	for (size_t i = 0; i < rate / 8; ++i)
+		xorLane(_state[i], _lane, load64(_block + 8 * i));
+}
 
-#define P keccakf
-#define Plen 200
+/// Xors the bytes of @a _input after its last full block and the padding into lane @a _lane of @a _state.
+template <class W>
+void absorbLast(W* _state, size_t _lane, bytesConstRef _input)
+{
+	size_t const remaining = _input.size() % rate;
+	uint8_t const* data = _input.data() + _input.size() - remaining;
+	size_t i = 0;
+	for (; i + 8 <= remaining; i += 8)
+		xorLane(_state[i / 8], _lane, load64(data + i));
+	for (; i < remaining; ++i)
+		xorLane(_state[i / 8], _lane, uint64_t(data[i]) << (8 * (i % 8)));
+	// The 0x01 is the specific padding for keccak (sha3 uses 0x06).
+	xorLane(_state[remaining / 8], _lane, uint64_t(0x01) << (8 * (remaining % 8)));
+	xorLane(_state[rate / 8 - 1], _lane, uint64_t(0x80) << 56);
+}
 
-// Fold P*F over the full blocks of an input.
-#define foldP(I, L, F) \
-	while (L >= rate) {  \
-		F(a, I, rate);     \
-		P(a);              \
-		I += rate;         \
-		L -= rate;         \
+/// Hashes @a _lanes inputs with the same number of full blocks at once, using a state of
+/// words of type @a W.
+template <class W>
+void hash(bytesConstRef const* _inputs, h256* _outputs, size_t _lanes)
+{
+	W state[25] = {};
+	size_t const fullBlocks = _inputs[0].size() / rate;
+	for (size_t block = 0; block < fullBlocks; ++block)
+	{
+		for (size_t l = 0; l < _lanes; ++l)
+			absorb(state, l, _inputs[l].data() + block * rate);
+		keccakf(state);
 	}
+	for (size_t l = 0; l < _lanes; ++l)
+		absorbLast(state, l, _inputs[l]);
+	keccakf(state);
+	for (size_t l = 0; l < _lanes; ++l)
+		for (size_t i = 0; i < 4; ++i)
+			store64(_outputs[l].data() + 8 * i, getLane(state[i], l));
+}
+
+#if defined(__GNUC__) && defined(__x86_64__)
+/// The batch hash compiled for AVX2, which is used if the CPU supports it.
+__attribute__((target("avx2"), flatten))
+void hashBatchAVX2(bytesConstRef const* _inputs, h256* _outputs, size_t _lanes)
+{
+	hash<Word4>(_inputs, _outputs, _lanes);
+}
+#endif
 
-/** The sponge-based hash construction. **/
-inline void hash(
-	uint8_t* out,
-	size_t outlen,
-	uint8_t const* in,
-	size_t inlen,
-	size_t rate,
-	uint8_t delim
-)
+void hashBatch(bytesConstRef const* _inputs, h256* _outputs, size_t _lanes)
 {
-	uint8_t a[Plen] = {0};
-	// Absorb input.
-	foldP(in, inlen, xorin);
-	// Xor in the DS and pad frame.
-	a[inlen] ^= delim;
-	a[rate - 1] ^= 0x80;
-	// Xor in the last block.
-	xorin(a, in, inlen);
-	// Apply P
-	P(a);
-	// Squeeze output.
-	foldP(out, outlen, setout);
-	setout(a, out, outlen);
-	memset(a, 0, 200);
+#if defined(__GNUC__) && defined(__x86_64__)
+	static bool const avx2 = __builtin_cpu_supports("avx2");
+	if (avx2)
+		return hashBatchAVX2(_inputs, _outputs, _lanes);
+#endif
+	hash<Word4>(_inputs, _outputs, _lanes);
 }
 
 }
@@ -176,12 +269,36 @@ inline void hash(
 h256 keccak256(bytesConstRef _input)
 {
 	h256 output;
-	// Parameters used:
-	// The 0x01 is the specific padding for keccak (sha3 uses 0x06) and
-	// the way the round size (or window or whatever it was) is calculated.
-	// 200 - (256 / 4) is the "rate"
-	hash(output.data(), output.size, _input.data(), _input.size(), 200 - (256 / 4), 0x01);
+	hash<uint64_t>(&_input, &output, 1);
 	return output;
 }
 
+vector<h256> keccak256Batch(vector<bytesConstRef> const& _inputs)
+{
+	size_t constexpr lanes = 4;
+	vector<h256> outputs(_inputs.size());
+	// Inputs are hashed together with ones that have the same number of full blocks.
+	map<size_t, vector<size_t>> inputsByBlocks;
+	for (size_t i = 0; i < _inputs.size(); ++i)
+		inputsByBlocks[_inputs[i].size() / rate].push_back(i);
+	for (auto const& group: inputsByBlocks)
+	{
+		vector<size_t> const& indices = group.second;
+		size_t i = 0;
+		for (; i + lanes <= indices.size(); i += lanes)
+		{
+			bytesConstRef inputs[lanes];
+			h256 results[lanes];
+			for (size_t lane = 0; lane < lanes; ++lane)
+				inputs[lane] = _inputs[indices[i + lane]];
+			hashBatch(inputs, results, lanes);
+			for (size_t lane = 0; lane < lanes; ++lane)
+				outputs[indices[i + lane]] = results[lane];
+		}
+		for (; i < indices.size(); ++i)
+			outputs[indices[i]] = keccak256(_inputs[indices[i]]);
+	}
+	return outputs;
+}
+
 }
@@ -22,6 +22,7 @@
 #include <libsolutil/Exceptions.h>
 
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <type_traits>
 #include <utility>
@@ -34,6 +35,8 @@ DEV_SIMPLE_EXCEPTION(BadLazyInitAccess);
 /**
  * A value that is initialized at some point after construction of the LazyInit. The stored value can only be accessed
  * while calling "init", which initializes the stored value (if it has not already been initialized).
+ * "init" can be called from several threads at the same time. The initializer may then run more than once,
+ * but only one of the results is stored.
  *
  * @tparam T the type of the stored value; may not be a function, reference, array, or void type; may be const-qualified.
  */
@@ -65,6 +68,16 @@ public:
 		_other.m_value.reset();
 	}
 
+	/// Removes the stored value, so that the next call to "init" computes it again.
+	void reset() { m_value.reset(); }
+
+	/// @returns true if a value is stored, i.e. if "init" does not compute it anymore.
+	bool initialized() const
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		return m_value.has_value();
+	}
+
 	template<typename F>
 	value_type& init(F&& _fun)
 	{
@@ -85,10 +98,21 @@ private:
 	template<typename F>
 	void doInit(F&& _fun) const
 	{
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			if (m_value.has_value())
+				return;
+		}
+		// The lock is not held while computing the value, so that initializers can use other lazily
+		// initialized values.
+		std::optional<std::remove_const_t<value_type>> value;
+		value.emplace(std::forward<F>(_fun)());
+		std::lock_guard<std::mutex> lock(m_mutex);
 		if (!m_value.has_value())
-			m_value.emplace(std::forward<F>(_fun)());
+			m_value.emplace(std::move(*value));
 	}
 
+	mutable std::mutex m_mutex;
 	mutable std::optional<value_type> m_value;
 };
 
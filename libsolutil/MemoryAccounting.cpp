@@ -0,0 +1,155 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Accounting of the memory held by the subsystems of the compiler.
+ */
+
+#include <libsolutil/MemoryAccounting.h>
+
+#include <libsolutil/Assertions.h>
+
+#include <algorithm>
+#include <array>
+#include <mutex>
+
+using namespace std;
+using namespace solidity::util;
+
+namespace
+{
+
+struct Counters
+{
+	atomic<size_t> allocations{0};
+	atomic<size_t> bytes{0};
+	atomic<size_t> peakBytes{0};
+};
+
+array<Counters, MemoryAccounting::SubsystemCount>& counters()
+{
+	static array<Counters, MemoryAccounting::SubsystemCount> counters;
+	return counters;
+}
+
+Counters& countersOf(MemorySubsystem _subsystem)
+{
+	return counters()[static_cast<size_t>(_subsystem)];
+}
+
+mutex g_measurementsMutex;
+map<string, size_t> g_measurements;
+
+}
+
+void MemoryAccounting::reset()
+{
+	for (Counters& subsystem: counters())
+	{
+		subsystem.allocations = 0;
+		subsystem.peakBytes = subsystem.bytes.load();
+	}
+	lock_guard<mutex> lock(g_measurementsMutex);
+	g_measurements.clear();
+}
+
+void MemoryAccounting::allocated(MemorySubsystem _subsystem, size_t _bytes)
+{
+	Counters& subsystem = countersOf(_subsystem);
+	++subsystem.allocations;
+	size_t bytes = subsystem.bytes += _bytes;
+	size_t peak = subsystem.peakBytes.load(memory_order_relaxed);
+	while (peak < bytes && !subsystem.peakBytes.compare_exchange_weak(peak, bytes, memory_order_relaxed))
+		;
+}
+
+void MemoryAccounting::released(MemorySubsystem _subsystem, size_t _bytes)
+{
+	atomic<size_t>& bytes = countersOf(_subsystem).bytes;
+	size_t held = bytes.load(memory_order_relaxed);
+	while (!bytes.compare_exchange_weak(held, held - min(held, _bytes), memory_order_relaxed))
+		;
+}
+
+void MemoryAccounting::recordMeasurement(string const& _name, size_t _bytes)
+{
+	lock_guard<mutex> lock(g_measurementsMutex);
+	size_t& measurement = g_measurements[_name];
+	measurement = max(measurement, _bytes);
+}
+
+MemoryAccounting::Usage MemoryAccounting::usage(MemorySubsystem _subsystem)
+{
+	Counters const& subsystem = countersOf(_subsystem);
+	return {subsystem.allocations.load(), subsystem.bytes.load(), subsystem.peakBytes.load()};
+}
+
+map<string, size_t> MemoryAccounting::measurements()
+{
+	lock_guard<mutex> lock(g_measurementsMutex);
+	return g_measurements;
+}
+
+char const* MemoryAccounting::name(MemorySubsystem _subsystem)
+{
+	switch (_subsystem)
+	{
+	case MemorySubsystem::AST: return "ast";
+	case MemorySubsystem::Annotations: return "annotations";
+	case MemorySubsystem::Types: return "types";
+	case MemorySubsystem::YulStrings: return "yulStrings";
+	case MemorySubsystem::YulAST: return "yulAST";
+	case MemorySubsystem::EVMAssembly: return "evmAssembly";
+	case MemorySubsystem::SMTEncoding: return "smtEncoding";
+	case MemorySubsystem::JSONOutput: return "jsonOutput";
+	}
+	assertThrow(false, Exception, "Unknown memory subsystem.");
+	return "";
+}
+
+void MemoryAccount::add(size_t _bytes)
+{
+	if (_bytes == 0 || !MemoryAccounting::enabled())
+		return;
+	m_bytes += _bytes;
+	MemoryAccounting::allocated(m_subsystem, _bytes);
+}
+
+void MemoryAccount::set(size_t _bytes)
+{
+	if (_bytes > bytes() && !MemoryAccounting::enabled())
+		return;
+	size_t previous = m_bytes.exchange(_bytes);
+	if (_bytes > previous)
+		MemoryAccounting::allocated(m_subsystem, _bytes - previous);
+	else if (_bytes < previous)
+		MemoryAccounting::released(m_subsystem, previous - _bytes);
+}
+
+void MemoryAccount::transfer(MemoryAccount& _from, MemoryAccount& _to, size_t _bytes)
+{
+	size_t held = _from.bytes();
+	size_t moved = 0;
+	do
+		moved = min(held, _bytes);
+	while (!_from.m_bytes.compare_exchange_weak(held, held - moved));
+	if (moved == 0)
+		return;
+	MemoryAccounting::released(_from.m_subsystem, moved);
+	_to.m_bytes += moved;
+	MemoryAccounting::allocated(_to.m_subsystem, moved);
+}
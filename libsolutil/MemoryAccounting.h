@@ -0,0 +1,127 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Accounting of the memory held by the subsystems of the compiler.
+ */
+
+#pragma once
+
+#include <boost/noncopyable.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+
+namespace solidity::util
+{
+
+enum class MemorySubsystem: uint8_t
+{
+	AST,
+	Annotations,
+	Types,
+	YulStrings,
+	YulAST,
+	EVMAssembly,
+	SMTEncoding,
+	JSONOutput
+};
+
+/**
+ * Process-wide counters of the memory allocated by each subsystem, with the peak of the
+ * memory held at the same time.
+ *
+ * The subsystems report their allocations explicitly, usually through a MemoryAccount, in
+ * the units they manage themselves (arena blocks, segments, nodes), so the numbers are
+ * estimates of the payload and do not include the overhead of the system allocator.
+ * Nothing is recorded until accounting is enabled, so that it is cheap when not requested.
+ * All functions can be called from any thread.
+ */
+class MemoryAccounting
+{
+public:
+	struct Usage
+	{
+		/// Number of allocations recorded since accounting was enabled.
+		size_t allocations = 0;
+		/// Bytes currently held.
+		size_t bytes = 0;
+		/// Highest number of bytes held at the same time.
+		size_t peakBytes = 0;
+	};
+
+	static size_t constexpr SubsystemCount = size_t(MemorySubsystem::JSONOutput) + 1;
+
+	/// Starts recording allocations. Accounting cannot be disabled again, so that memory
+	/// is never released that was not recorded.
+	static void enable() { s_enabled = true; }
+	static bool enabled() { return s_enabled.load(std::memory_order_relaxed); }
+
+	/// Sets the peak of each subsystem to the bytes currently held and resets the number
+	/// of allocations and the recorded measurements, e.g. at the start of a compilation.
+	static void reset();
+
+	static void allocated(MemorySubsystem _subsystem, size_t _bytes);
+	/// Records that @a _bytes are released. Releases beyond the bytes held are ignored.
+	static void released(MemorySubsystem _subsystem, size_t _bytes);
+
+	/// Records @a _bytes as a measurement of the named quantity, e.g. the size of the Yul AST
+	/// after an optimiser step, and keeps the largest one.
+	static void recordMeasurement(std::string const& _name, size_t _bytes);
+
+	static Usage usage(MemorySubsystem _subsystem);
+	static std::map<std::string, size_t> measurements();
+
+	/// @returns the name of @a _subsystem as used in reports, e.g. "yulStrings".
+	static char const* name(MemorySubsystem _subsystem);
+
+private:
+	static inline std::atomic<bool> s_enabled{false};
+};
+
+/**
+ * Bytes of a subsystem held by a single object, which are released when it is destroyed.
+ * Copies start empty, since the copied object accounts for its own memory.
+ */
+class MemoryAccount
+{
+public:
+	explicit MemoryAccount(MemorySubsystem _subsystem): m_subsystem(_subsystem) {}
+	MemoryAccount(MemoryAccount const& _other): m_subsystem(_other.m_subsystem) {}
+	MemoryAccount& operator=(MemoryAccount const&) { return *this; }
+	~MemoryAccount() { set(0); }
+
+	/// Records an allocation of @a _bytes. Does nothing if accounting is disabled.
+	void add(size_t _bytes);
+	/// Sets the bytes held to @a _bytes, recording the difference. Memory is only added
+	/// while accounting is enabled, but can always be released.
+	void set(size_t _bytes);
+	size_t bytes() const { return m_bytes.load(std::memory_order_relaxed); }
+
+	/// Moves up to @a _bytes from @a _from to @a _to, e.g. for memory that is reserved by one
+	/// subsystem and handed out to another one.
+	static void transfer(MemoryAccount& _from, MemoryAccount& _to, size_t _bytes);
+
+private:
+	MemorySubsystem m_subsystem;
+	std::atomic<size_t> m_bytes{0};
+};
+
+}
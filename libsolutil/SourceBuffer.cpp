@@ -0,0 +1,77 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Immutable source text shared without copying.
+ */
+
+#include <libsolutil/SourceBuffer.h>
+
+#include <libsolutil/Assertions.h>
+#include <libsolutil/CommonIO.h>
+#include <libsolutil/Exceptions.h>
+
+#if (defined(__unix__) || defined(__APPLE__)) && !defined(__EMSCRIPTEN__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+using namespace solidity::util;
+
+namespace
+{
+/// Files smaller than this are read instead of mapped, because mapping them
+/// costs more than copying them.
+size_t constexpr c_minimumMappedSize = 64 * 1024;
+}
+
+SourceBuffer::SourceBuffer(string _content)
+{
+	auto content = make_shared<string const>(move(_content));
+	m_view = *content;
+	m_storage = move(content);
+}
+
+SourceBuffer SourceBuffer::fromFile(string const& _file)
+{
+#if (defined(__unix__) || defined(__APPLE__)) && !defined(__EMSCRIPTEN__)
+	int fd = open(_file.c_str(), O_RDONLY);
+	assertThrow(fd >= 0, FileNotFound, _file);
+	struct stat status{};
+	void* address = MAP_FAILED;
+	size_t size = 0;
+	if (fstat(fd, &status) == 0 && S_ISREG(status.st_mode) && static_cast<size_t>(status.st_size) >= c_minimumMappedSize)
+	{
+		size = static_cast<size_t>(status.st_size);
+		address = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+	}
+	close(fd);
+	if (address != MAP_FAILED)
+	{
+		SourceBuffer buffer;
+		buffer.m_view = string_view(static_cast<char const*>(address), size);
+		buffer.m_storage = shared_ptr<void const>(address, [size](void const* _address) {
+			munmap(const_cast<void*>(_address), size);
+		});
+		return buffer;
+	}
+#endif
+	return SourceBuffer(readFileAsString(_file));
+}
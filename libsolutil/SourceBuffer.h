@@ -0,0 +1,69 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Immutable source text shared without copying.
+ */
+
+#pragma once
+
+#include <libsolutil/Common.h>
+
+#include <memory>
+#include <string>
+#include <string_view>
+
+namespace solidity::util
+{
+
+/**
+ * Immutable contents of a source, shared between all copies of the buffer.
+ *
+ * The contents are either a string the buffer took ownership of or a file mapped into memory.
+ * Copying a buffer only copies a reference. Contrary to std::string, the contents are not
+ * guaranteed to be followed by a null character.
+ */
+class SourceBuffer
+{
+public:
+	SourceBuffer() = default;
+	/// Takes ownership of @a _content without copying it.
+	explicit SourceBuffer(std::string _content);
+
+	/// Reads the file @a _file. Large files are mapped into memory instead of being read,
+	/// if the platform supports it.
+	/// If the file doesn't exist, it will throw a FileNotFound exception.
+	static SourceBuffer fromFile(std::string const& _file);
+
+	std::string_view view() const noexcept { return m_view; }
+	char const* data() const noexcept { return m_view.data(); }
+	size_t size() const noexcept { return m_view.size(); }
+	bool empty() const noexcept { return m_view.empty(); }
+	bytesConstRef ref() const noexcept { return bytesConstRef(reinterpret_cast<uint8_t const*>(m_view.data()), m_view.size()); }
+
+	/// @returns a copy of the contents.
+	std::string str() const { return std::string(m_view); }
+
+	bool operator==(SourceBuffer const& _other) const noexcept { return m_view == _other.m_view; }
+	bool operator!=(SourceBuffer const& _other) const noexcept { return m_view != _other.m_view; }
+
+private:
+	std::shared_ptr<void const> m_storage;
+	std::string_view m_view;
+};
+
+}
@@ -23,8 +23,11 @@
  */
 
 #include <libsolutil/StringUtils.h>
+#include <libsolutil/Assertions.h>
 #include <algorithm>
+#include <set>
 #include <string>
+#include <unordered_set>
 #include <vector>
 
 using namespace std;
@@ -87,6 +90,68 @@ size_t solidity::util::stringDistance(string const& _str1, string const& _str2)
 	return dp[(n1 % 3) + n2 * 3];
 }
 
+namespace
+{
+
+/// Adds all strings obtained by deleting up to @a _deletions characters from @a _string to @a _variants.
+void addDeletionVariants(string const& _string, size_t _deletions, unordered_set<string>& _variants)
+{
+	// All variants of the same length are reached with the same number of deletions.
+	if (!_variants.insert(_string).second || _deletions == 0)
+		return;
+	for (size_t i = 0; i < _string.size(); ++i)
+		addDeletionVariants(_string.substr(0, i) + _string.substr(i + 1), _deletions - 1, _variants);
+}
+
+}
+
+void SimilarStrings::insert(string const& _string)
+{
+	if (_string.size() > MaxIndexedLength)
+	{
+		for (size_t index: m_unindexed)
+			if (m_strings[index] == _string)
+				return;
+		m_unindexed.push_back(m_strings.size());
+		m_strings.push_back(_string);
+		return;
+	}
+
+	if (auto it = m_variants.find(_string); it != m_variants.end())
+		for (size_t index: it->second)
+			if (m_strings[index] == _string)
+				return;
+
+	unordered_set<string> variants;
+	addDeletionVariants(_string, m_maxDistance, variants);
+	for (string const& variant: variants)
+		m_variants[variant].push_back(m_strings.size());
+	m_strings.push_back(_string);
+}
+
+vector<string> SimilarStrings::similar(string const& _string, size_t _maxDistance, size_t _lenThreshold) const
+{
+	assertThrow(_maxDistance <= m_maxDistance, Exception, "Distance larger than the one of the index.");
+
+	set<size_t> candidates(m_unindexed.begin(), m_unindexed.end());
+	// Indexed strings are too short to be within the distance of longer strings.
+	if (_string.size() <= MaxIndexedLength + _maxDistance)
+	{
+		unordered_set<string> variants;
+		addDeletionVariants(_string, _maxDistance, variants);
+		for (string const& variant: variants)
+			if (auto it = m_variants.find(variant); it != m_variants.end())
+				candidates.insert(it->second.begin(), it->second.end());
+	}
+
+	vector<string> similar;
+	for (size_t candidate: candidates)
+		if (stringWithinDistance(_string, m_strings[candidate], _maxDistance, _lenThreshold))
+			similar.push_back(m_strings[candidate]);
+	sort(similar.begin(), similar.end());
+	return similar;
+}
+
 string solidity::util::quotedAlternativesList(vector<string> const& suggestions)
 {
 	vector<string> quotedSuggestions;
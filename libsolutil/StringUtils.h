@@ -25,6 +25,7 @@
 #pragma once
 
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include <libsolutil/CommonData.h>
@@ -37,6 +38,40 @@ namespace solidity::util
 bool stringWithinDistance(std::string const& _str1, std::string const& _str2, size_t _maxDistance, size_t _lenThreshold = 0);
 // Calculates the Damerau–Levenshtein distance between _str1 and _str2
 size_t stringDistance(std::string const& _str1, std::string const& _str2);
+
+/**
+ * Set of strings that finds the strings similar to a given one in the sense of stringWithinDistance
+ * without computing the distance to each of them.
+ *
+ * Every string is indexed by all variants obtained by deleting up to the maximum distance characters
+ * from it. Two strings within that distance share at least one of those variants, so only the strings
+ * sharing a variant with the query have to be compared to it. The number of variants grows
+ * quadratically with the length of the string, so long strings are not indexed but always compared.
+ */
+class SimilarStrings
+{
+public:
+	explicit SimilarStrings(size_t _maxDistance = 2): m_maxDistance(_maxDistance) {}
+
+	/// Adds @a _string unless it is already present.
+	void insert(std::string const& _string);
+
+	/// @returns the strings within distance @a _maxDistance of @a _string in lexicographical order,
+	/// with the same length threshold as stringWithinDistance.
+	/// @a _maxDistance must not be larger than the maximum distance of the set.
+	std::vector<std::string> similar(std::string const& _string, size_t _maxDistance, size_t _lenThreshold = 0) const;
+
+private:
+	static size_t constexpr MaxIndexedLength = 64;
+
+	size_t m_maxDistance;
+	std::vector<std::string> m_strings;
+	/// Indices of the strings with the variant as key.
+	std::unordered_map<std::string, std::vector<size_t>> m_variants;
+	/// Indices of the strings longer than MaxIndexedLength.
+	std::vector<size_t> m_unindexed;
+};
+
 // Return a string having elements of suggestions as quoted, alternative suggestions. e.g. "a", "b" or "c"
 std::string quotedAlternativesList(std::vector<std::string> const& suggestions);
 
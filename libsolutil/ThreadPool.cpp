@@ -0,0 +1,240 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libsolutil/ThreadPool.h>
+
+#include <algorithm>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+using namespace std;
+using namespace solidity::util;
+
+/**
+ * Worker threads shared by all pools with more than one thread. A single mutex guards the
+ * queues of all pools: The tasks are coarse (a source, a contract, a group of functions or
+ * a solver query), so the workers rarely compete for it.
+ */
+class ThreadPool::Scheduler
+{
+public:
+	static Scheduler& instance()
+	{
+		static Scheduler scheduler;
+		return scheduler;
+	}
+
+	~Scheduler()
+	{
+		{
+			lock_guard<mutex> lock(m_mutex);
+			m_stopping = true;
+		}
+		m_changed.notify_all();
+		for (auto& worker: m_workers)
+			worker.join();
+	}
+
+	void add(ThreadPool& _pool)
+	{
+		lock_guard<mutex> lock(m_mutex);
+		while (m_workers.size() < _pool.m_threads)
+			m_workers.emplace_back([this]() { work(); });
+		m_pools.push_back(&_pool);
+	}
+
+	void remove(ThreadPool& _pool)
+	{
+		lock_guard<mutex> lock(m_mutex);
+		m_pools.erase(find(m_pools.begin(), m_pools.end(), &_pool));
+	}
+
+	/// Executes the queued tasks of @a _pool on the calling thread as long as there are any
+	/// and then waits until the tasks running on other threads have finished as well.
+	void finish(ThreadPool& _pool)
+	{
+		unique_lock<mutex> lock(m_mutex);
+		while (_pool.m_pending > 0)
+			if (_pool.canStart())
+				execute(lock, _pool);
+			else
+				m_changed.wait(lock);
+	}
+
+	size_t workers()
+	{
+		lock_guard<mutex> lock(m_mutex);
+		return m_workers.size();
+	}
+
+	mutex& guard() { return m_mutex; }
+	void notify() { m_changed.notify_all(); }
+
+private:
+	/// Executes the next queued task of @a _pool with @a _lock released.
+	void execute(unique_lock<mutex>& _lock, ThreadPool& _pool)
+	{
+		Task task = move(_pool.m_queue.front());
+		_pool.m_queue.pop_front();
+		++_pool.m_running;
+		_lock.unlock();
+
+		exception_ptr exception;
+		try
+		{
+			task.function();
+		}
+		catch (...)
+		{
+			exception = current_exception();
+		}
+
+		_lock.lock();
+		if (exception)
+			_pool.recordFailure(task.index, exception);
+		--_pool.m_running;
+		--_pool.m_pending;
+		m_changed.notify_all();
+	}
+
+	void work()
+	{
+		unique_lock<mutex> lock(m_mutex);
+		while (true)
+		{
+			auto pool = find_if(m_pools.rbegin(), m_pools.rend(), [](ThreadPool* _pool) { return _pool->canStart(); });
+			if (pool != m_pools.rend())
+				execute(lock, **pool);
+			else if (m_stopping)
+				return;
+			else
+				m_changed.wait(lock);
+		}
+	}
+
+	mutex m_mutex;
+	/// Notified whenever a task is queued or finished.
+	condition_variable m_changed;
+	vector<thread> m_workers;
+	/// The pools using the workers, in the order of their creation.
+	vector<ThreadPool*> m_pools;
+	bool m_stopping = false;
+};
+
+ThreadPool::ThreadPool(size_t _threads):
+	m_threads(effectiveThreads(_threads))
+{
+	if (m_threads > 1)
+		Scheduler::instance().add(*this);
+}
+
+ThreadPool::~ThreadPool()
+{
+	if (m_threads > 1)
+	{
+		Scheduler::instance().finish(*this);
+		Scheduler::instance().remove(*this);
+	}
+}
+
+void ThreadPool::submit(function<void()> _task)
+{
+	Task task{m_submitted++, move(_task)};
+	if (m_threads == 1)
+	{
+		run(move(task));
+		return;
+	}
+
+	Scheduler& scheduler = Scheduler::instance();
+	{
+		lock_guard<mutex> lock(scheduler.guard());
+		++m_pending;
+		m_queue.emplace_back(move(task));
+	}
+	scheduler.notify();
+}
+
+void ThreadPool::wait()
+{
+	exception_ptr exception;
+	if (m_threads > 1)
+	{
+		Scheduler& scheduler = Scheduler::instance();
+		scheduler.finish(*this);
+		lock_guard<mutex> lock(scheduler.guard());
+		swap(exception, m_exception);
+	}
+	else
+		swap(exception, m_exception);
+	if (exception)
+		rethrow_exception(exception);
+}
+
+void ThreadPool::cancel()
+{
+	if (m_threads == 1)
+		return;
+
+	Scheduler& scheduler = Scheduler::instance();
+	{
+		lock_guard<mutex> lock(scheduler.guard());
+		m_pending -= m_queue.size();
+		m_queue.clear();
+	}
+	scheduler.notify();
+}
+
+size_t ThreadPool::effectiveThreads(size_t _threads)
+{
+#ifdef __EMSCRIPTEN__
+	(void)_threads;
+	return 1;
+#else
+	if (_threads == 0)
+		_threads = thread::hardware_concurrency();
+	return _threads > 0 ? _threads : 1;
+#endif
+}
+
+size_t ThreadPool::workerThreads()
+{
+	return Scheduler::instance().workers();
+}
+
+void ThreadPool::run(Task _task)
+{
+	try
+	{
+		_task.function();
+	}
+	catch (...)
+	{
+		recordFailure(_task.index, current_exception());
+	}
+}
+
+void ThreadPool::recordFailure(size_t _index, exception_ptr _exception)
+{
+	if (!m_exception || _index < m_failedIndex)
+	{
+		m_exception = move(_exception);
+		m_failedIndex = _index;
+	}
+}
@@ -0,0 +1,112 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Group of independent tasks executed by worker threads shared by all pools of the process.
+ */
+
+#pragma once
+
+#include <boost/noncopyable.hpp>
+
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <vector>
+
+namespace solidity::util
+{
+
+/**
+ * Executes submitted tasks with at most a given number of them running at the same time.
+ *
+ * The tasks of all pools are executed by one set of worker threads per process, which grows
+ * to the highest number of threads requested by any pool. Pools created inside tasks, e.g.
+ * for the sub-objects of a contract whose code is generated concurrently with other contracts,
+ * therefore do not start threads of their own. While waiting, a thread executes the queued
+ * tasks of the pool it waits for, so nested pools make progress even if all workers are busy.
+ * Workers prefer the tasks of the pools created last, which finishes nested work first.
+ *
+ * With a single thread (and on platforms without thread support), no workers are used
+ * and every task is executed directly inside @a submit, i.e. in submission order on the
+ * calling thread.
+ *
+ * Tasks have to be submitted and waited for from a single thread.
+ * Exceptions thrown by tasks are captured. @a wait rethrows the exception of the task that
+ * was submitted first among the failed ones, so that error reporting does not depend on
+ * the scheduling.
+ */
+class ThreadPool: boost::noncopyable
+{
+public:
+	/// @param _threads maximum number of tasks running at the same time.
+	/// Zero means one per hardware thread.
+	explicit ThreadPool(size_t _threads);
+	/// Executes the remaining tasks and waits for them.
+	~ThreadPool();
+
+	/// @returns the maximum number of tasks running at the same time.
+	size_t threads() const { return m_threads; }
+
+	/// Schedules @a _task for execution.
+	void submit(std::function<void()> _task);
+
+	/// Blocks until all submitted tasks have finished and rethrows the exception
+	/// of the earliest submitted failed task, if any.
+	void wait();
+
+	/// Drops the submitted tasks that have not started yet, e.g. once one of several
+	/// solvers racing for an answer has found it. Can be called from the tasks of the pool.
+	void cancel();
+
+	/// @returns the number of threads to use for a requested parallelism of @a _threads
+	/// (zero requesting one thread per hardware thread).
+	static size_t effectiveThreads(size_t _threads);
+
+	/// @returns the number of worker threads shared by all pools started so far.
+	static size_t workerThreads();
+
+private:
+	class Scheduler;
+
+	struct Task
+	{
+		size_t index;
+		std::function<void()> function;
+	};
+
+	/// Executes @a _task directly, without workers.
+	void run(Task _task);
+	/// Records that the task with index @a _index failed with @a _exception.
+	void recordFailure(size_t _index, std::exception_ptr _exception);
+	/// @returns true if a queued task can be started without exceeding the number of threads.
+	bool canStart() const { return !m_queue.empty() && m_running < m_threads; }
+
+	size_t m_threads = 1;
+	size_t m_submitted = 0;
+	/// The following members are guarded by the mutex of the scheduler if workers are used.
+	std::deque<Task> m_queue;
+	/// Number of tasks submitted and not finished yet, including the queued ones.
+	size_t m_pending = 0;
+	size_t m_running = 0;
+	/// Index and exception of the earliest submitted task that failed.
+	size_t m_failedIndex = 0;
+	std::exception_ptr m_exception;
+};
+
+}
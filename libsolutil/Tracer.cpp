@@ -0,0 +1,130 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Recording of the spans of a compilation as Chrome trace events.
+ */
+
+#include <libsolutil/Tracer.h>
+
+#include <algorithm>
+#include <atomic>
+#include <tuple>
+
+using namespace std;
+using namespace solidity::util;
+
+namespace
+{
+atomic<Tracer*> activeTracer{nullptr};
+
+size_t currentThread()
+{
+	static atomic<size_t> nextThread{1};
+	thread_local size_t const thread = nextThread++;
+	return thread;
+}
+
+double microseconds(chrono::nanoseconds _time)
+{
+	return static_cast<double>(_time.count()) / 1000.0;
+}
+}
+
+Tracer::Scope::Scope(Tracer& _tracer):
+	m_previous(activeTracer.exchange(&_tracer))
+{
+}
+
+Tracer::Scope::~Scope()
+{
+	activeTracer = m_previous;
+}
+
+Tracer::Span::Span(char const* _category, string _name, string _detail):
+	m_tracer(activeTracer)
+{
+	if (!m_tracer)
+		return;
+	m_event.category = _category;
+	m_event.name = move(_name);
+	m_event.detail = move(_detail);
+	m_event.thread = currentThread();
+	m_start = chrono::steady_clock::now();
+}
+
+Tracer::Span::~Span()
+{
+	if (!m_tracer)
+		return;
+	auto end = chrono::steady_clock::now();
+	m_event.start = m_start - m_tracer->m_start;
+	m_event.duration = end - m_start;
+	m_tracer->record(move(m_event));
+}
+
+Tracer* Tracer::active()
+{
+	return activeTracer;
+}
+
+void Tracer::record(Event _event)
+{
+	lock_guard<mutex> lock(m_mutex);
+	m_events.emplace_back(move(_event));
+}
+
+vector<Tracer::Event> Tracer::events() const
+{
+	vector<Event> events;
+	{
+		lock_guard<mutex> lock(m_mutex);
+		events = m_events;
+	}
+	// Spans are recorded when they end, i.e. inner spans before the ones enclosing them.
+	// Longer spans come first among spans with the same start, so that viewers nest them.
+	stable_sort(events.begin(), events.end(), [](Event const& _a, Event const& _b) {
+		return
+			tie(_a.thread, _a.start, _b.duration) <
+			tie(_b.thread, _b.start, _a.duration);
+	});
+	return events;
+}
+
+Json::Value Tracer::toJson() const
+{
+	Json::Value traceEvents(Json::arrayValue);
+	for (Event const& event: events())
+	{
+		Json::Value entry(Json::objectValue);
+		entry["name"] = event.name;
+		entry["cat"] = event.category;
+		entry["ph"] = "X";
+		entry["ts"] = microseconds(event.start);
+		entry["dur"] = microseconds(event.duration);
+		entry["pid"] = 1;
+		entry["tid"] = Json::UInt64(event.thread);
+		if (!event.detail.empty())
+			entry["args"]["detail"] = event.detail;
+		traceEvents.append(move(entry));
+	}
+
+	Json::Value trace(Json::objectValue);
+	trace["traceEvents"] = move(traceEvents);
+	trace["displayTimeUnit"] = "ms";
+	return trace;
+}
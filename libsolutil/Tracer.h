@@ -0,0 +1,104 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Recording of the spans of a compilation as Chrome trace events.
+ */
+
+#pragma once
+
+#include <json/json.h>
+
+#include <boost/noncopyable.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace solidity::util
+{
+
+/**
+ * Records the spans of a compilation on all threads as complete events in the Chrome trace
+ * event format, which can be viewed in Perfetto or chrome://tracing.
+ *
+ * Only one tracer can be active in a process at a time. While no tracer is active, Spans do
+ * not measure anything, so that the instrumentation is cheap when it is not requested.
+ */
+class Tracer: boost::noncopyable
+{
+public:
+	struct Event
+	{
+		std::string category;
+		std::string name;
+		/// Additional information shown with the event, e.g. the name of a source or contract.
+		std::string detail;
+		/// Small number identifying the thread the span ran on.
+		size_t thread = 0;
+		/// Start of the span, relative to the construction of the tracer.
+		std::chrono::nanoseconds start{0};
+		std::chrono::nanoseconds duration{0};
+	};
+
+	/// Makes @a _tracer the active tracer of the process while alive.
+	class Scope: boost::noncopyable
+	{
+	public:
+		explicit Scope(Tracer& _tracer);
+		~Scope();
+
+	private:
+		Tracer* m_previous = nullptr;
+	};
+
+	/// Measures the time from its construction to its destruction and records it as an
+	/// event of the active tracer, if there is one. Spans on one thread have to end in the
+	/// reverse order of their start, so that the events nest.
+	class Span: boost::noncopyable
+	{
+	public:
+		Span(char const* _category, std::string _name, std::string _detail = {});
+		~Span();
+
+	private:
+		Tracer* m_tracer = nullptr;
+		Event m_event;
+		std::chrono::steady_clock::time_point m_start;
+	};
+
+	Tracer(): m_start(std::chrono::steady_clock::now()) {}
+
+	/// @returns the active tracer or nullptr.
+	static Tracer* active();
+
+	void record(Event _event);
+
+	/// @returns the events recorded so far, ordered by thread and start.
+	std::vector<Event> events() const;
+	/// @returns the events in the JSON object format of Chrome traces.
+	Json::Value toJson() const;
+
+private:
+	std::chrono::steady_clock::time_point const m_start;
+	mutable std::mutex m_mutex;
+	std::vector<Event> m_events;
+};
+
+}
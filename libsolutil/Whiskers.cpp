@@ -26,13 +26,64 @@
 
 #include <libsolutil/Assertions.h>
 
-#include <regex>
+#include <algorithm>
+#include <mutex>
+#include <set>
+#include <string_view>
+#include <unordered_map>
 
 using namespace std;
 using namespace solidity::util;
 
+struct Whiskers::Template
+{
+	struct Segment
+	{
+		enum class Kind { Text, Parameter, List, Condition };
+
+		Kind kind;
+		/// The literal text or the name of the parameter, including the "+" of string conditions.
+		string value;
+		/// The body of a list or the parts of a condition for true and false.
+		vector<Template> bodies;
+	};
+
+	/// The text the template was split from, for error messages.
+	string text;
+	vector<Segment> segments;
+	/// All tags of the form <name>, <?name>, </name> and <#name> occurring in the text.
+	set<string> tags;
+};
+
+namespace
+{
+
+bool isParameterCharacter(char _c)
+{
+	return
+		('a' <= _c && _c <= 'z') ||
+		('A' <= _c && _c <= 'Z') ||
+		('0' <= _c && _c <= '9') ||
+		_c == '_' || _c == '$' || _c == '-';
+}
+
+/// @returns the end of the parameter name starting at @a _pos if it is non-empty and followed by ">",
+/// string_view::npos otherwise.
+size_t parameterEnd(string_view _text, size_t _pos)
+{
+	size_t end = _pos;
+	while (end < _text.size() && isParameterCharacter(_text[end]))
+		++end;
+	if (end == _pos || end == _text.size() || _text[end] != '>')
+		return string_view::npos;
+	return end;
+}
+
+}
+
 Whiskers::Whiskers(string _template):
-	m_template(move(_template))
+	m_template(move(_template)),
+	m_compiled(compile(m_template))
 {
 }
 
@@ -71,14 +122,19 @@ Whiskers& Whiskers::operator()(
 
 string Whiskers::render() const
 {
-	return replace(m_template, m_parameters, m_conditions, m_listParameters);
+	size_t size = m_template.size();
+	for (auto const& parameter: m_parameters)
+		size += parameter.second.size();
+	string result;
+	result.reserve(size);
+	render(*m_compiled, m_parameters, nullptr, m_conditions, &m_listParameters, result);
+	return result;
 }
 
 void Whiskers::checkParameterValid(string const& _parameter) const
 {
-	static regex validParam("^" + paramRegex() + "$");
 	assertThrow(
-		regex_match(_parameter, validParam),
+		!_parameter.empty() && all_of(_parameter.begin(), _parameter.end(), isParameterCharacter),
 		WhiskersError,
 		"Parameter" + _parameter + " contains invalid characters."
 	);
@@ -109,122 +165,212 @@ void Whiskers::checkTemplateContainsTags(string const& _parameter, vector<string
 	{
 		string tag{"<" + prefix + _parameter + ">"};
 		assertThrow(
-			m_template.find(tag) != string::npos,
+			m_compiled->tags.count(tag),
 			WhiskersError,
 			"Tag '" + tag + "' not found in template:\n" + m_template
 		);
 	}
 }
 
-namespace
-{
-template<class ReplaceCallback>
-string regex_replace(
-	string const& _source,
-	regex const& _pattern,
-	ReplaceCallback _replace,
-	regex_constants::match_flag_type _flags = regex_constants::match_default
-)
+Whiskers::Template Whiskers::parse(string _text)
 {
-	sregex_iterator curMatch(_source.begin(), _source.end(), _pattern, _flags);
-	sregex_iterator matchEnd;
-	string::const_iterator lastMatchedPos(_source.cbegin());
-	string result;
-	while (curMatch != matchEnd)
+	Template result;
+	result.text = move(_text);
+	string_view const text = result.text;
+
+	size_t literalStart = 0;
+	auto addSegment = [&](size_t _begin, size_t _end, Template::Segment _segment) {
+		if (literalStart < _begin)
+			result.segments.push_back({Template::Segment::Kind::Text, string(text.substr(literalStart, _begin - literalStart)), {}});
+		result.segments.emplace_back(move(_segment));
+		literalStart = _end;
+	};
+
+	size_t pos = 0;
+	while ((pos = text.find('<', pos)) != string_view::npos)
 	{
-		result.append(curMatch->prefix().first, curMatch->prefix().second);
-		result.append(_replace(*curMatch));
-		lastMatchedPos = (*curMatch)[0].second;
-		++curMatch;
+		size_t const tagStart = pos + 1;
+		if (tagStart == text.size())
+			break;
+		char const kind = text[tagStart];
+		if (isParameterCharacter(kind))
+		{
+			size_t end = parameterEnd(text, tagStart);
+			if (end != string_view::npos)
+			{
+				addSegment(pos, end + 1, {Template::Segment::Kind::Parameter, string(text.substr(tagStart, end - tagStart)), {}});
+				pos = end + 1;
+				continue;
+			}
+		}
+		else if (kind == '#' || kind == '?')
+		{
+			size_t nameStart = tagStart + 1;
+			if (kind == '?' && nameStart < text.size() && text[nameStart] == '+')
+				++nameStart;
+			size_t end = parameterEnd(text, nameStart);
+			if (end != string_view::npos)
+			{
+				string name(text.substr(tagStart + 1, end - tagStart - 1));
+				size_t const bodyStart = end + 1;
+				size_t const close = text.find("</" + name + ">", bodyStart);
+				if (close != string_view::npos)
+				{
+					size_t const closeEnd = close + name.size() + 3;
+					vector<Template> bodies;
+					if (kind == '#')
+						bodies.emplace_back(parse(string(text.substr(bodyStart, close - bodyStart))));
+					else
+					{
+						size_t const elseTag = text.find("<!" + name + ">", bodyStart);
+						if (elseTag != string_view::npos && elseTag < close)
+						{
+							size_t const elseEnd = elseTag + name.size() + 3;
+							bodies.emplace_back(parse(string(text.substr(bodyStart, elseTag - bodyStart))));
+							bodies.emplace_back(parse(string(text.substr(elseEnd, close - elseEnd))));
+						}
+						else
+						{
+							bodies.emplace_back(parse(string(text.substr(bodyStart, close - bodyStart))));
+							bodies.emplace_back(parse(string{}));
+						}
+					}
+					addSegment(pos, closeEnd, {
+						kind == '#' ? Template::Segment::Kind::List : Template::Segment::Kind::Condition,
+						move(name),
+						move(bodies)
+					});
+					pos = closeEnd;
+					continue;
+				}
+			}
+		}
+		// Not a tag, so "<" is literal text.
+		++pos;
+	}
+	if (literalStart < text.size())
+		result.segments.push_back({Template::Segment::Kind::Text, string(text.substr(literalStart)), {}});
+
+	// The tags are collected from the raw text, so that they are found independently of
+	// whether they are part of a complete element.
+	for (pos = 0; (pos = text.find('<', pos)) != string_view::npos; ++pos)
+	{
+		size_t nameStart = pos + 1;
+		if (nameStart < text.size() && (text[nameStart] == '?' || text[nameStart] == '/' || text[nameStart] == '#'))
+			++nameStart;
+		size_t end = parameterEnd(text, nameStart);
+		if (end != string_view::npos)
+			result.tags.emplace(text.substr(pos, end + 1 - pos));
 	}
-	result.append(lastMatchedPos, _source.cend());
 	return result;
 }
+
+shared_ptr<Whiskers::Template const> Whiskers::compile(string const& _template)
+{
+	// Templates are mostly string constants, but some are assembled at runtime,
+	// so the number of cached templates is limited.
+	static size_t constexpr maxCachedTemplates = 4096;
+	static mutex cacheMutex;
+	static unordered_map<string, shared_ptr<Template const>> cache;
+
+	{
+		lock_guard<mutex> lock(cacheMutex);
+		if (auto it = cache.find(_template); it != cache.end())
+			return it->second;
+	}
+	auto compiled = make_shared<Template const>(parse(_template));
+	lock_guard<mutex> lock(cacheMutex);
+	if (cache.size() < maxCachedTemplates)
+		cache.emplace(_template, compiled);
+	return compiled;
 }
 
-string Whiskers::replace(
-	string const& _template,
+void Whiskers::render(
+	Template const& _template,
 	StringMap const& _parameters,
+	StringMap const* _elementParameters,
 	map<string, bool> const& _conditions,
-	map<string, vector<StringMap>> const& _listParameters
+	StringListMap const* _listParameters,
+	string& _result
 )
 {
-	static regex listOrTag(
-		"<(" + paramRegex() + ")>|"
-		"<#(" + paramRegex() + ")>((?:.|\\r|\\n)*?)</\\2>|"
-		"<\\?(\\+?" + paramRegex() + ")>((?:.|\\r|\\n)*?)(<!\\4>((?:.|\\r|\\n)*?))?</\\4>"
-	);
-	return regex_replace(_template, listOrTag, [&](match_results<string::const_iterator> _match) -> string
-	{
-		string tagName(_match[1]);
-		string listName(_match[2]);
-		string conditionName(_match[4]);
-		if (!tagName.empty())
+	auto parameter = [&](string const& _name) -> string const* {
+		if (_elementParameters)
+			if (auto it = _elementParameters->find(_name); it != _elementParameters->end())
+				return &it->second;
+		if (auto it = _parameters.find(_name); it != _parameters.end())
+			return &it->second;
+		return nullptr;
+	};
+
+	for (Template::Segment const& segment: _template.segments)
+		switch (segment.kind)
+		{
+		case Template::Segment::Kind::Text:
+			_result += segment.value;
+			break;
+		case Template::Segment::Kind::Parameter:
 		{
+			string const* value = parameter(segment.value);
 			assertThrow(
-				_parameters.count(tagName),
+				value,
 				WhiskersError,
-				"Value for tag " + tagName + " not provided.\n" +
+				"Value for tag " + segment.value + " not provided.\n" +
 				"Template:\n" +
-				_template
+				_template.text
 			);
-			return _parameters.at(tagName);
+			_result += *value;
+			break;
 		}
-		else if (!listName.empty())
+		case Template::Segment::Kind::List:
 		{
-			string templ(_match[3]);
+			// Lists cannot be nested, so list parameters are not available in list elements.
 			assertThrow(
-				_listParameters.count(listName),
-				WhiskersError, "List parameter " + listName + " not set."
+				_listParameters && _listParameters->count(segment.value),
+				WhiskersError, "List parameter " + segment.value + " not set."
 			);
-			string replacement;
-			for (auto const& parameters: _listParameters.at(listName))
-				replacement += replace(templ, joinMaps(_parameters, parameters), _conditions);
-			return replacement;
+			for (StringMap const& element: _listParameters->at(segment.value))
+			{
+				for (auto const& elementParameter: element)
+					assertThrow(
+						!_parameters.count(elementParameter.first),
+						WhiskersError,
+						"Parameter collision"
+					);
+				render(segment.bodies.front(), _parameters, &element, _conditions, nullptr, _result);
+			}
+			break;
 		}
-		else
+		case Template::Segment::Kind::Condition:
 		{
-			assertThrow(!conditionName.empty(), WhiskersError, "");
 			bool conditionValue = false;
-			if (conditionName[0] == '+')
+			if (segment.value[0] == '+')
 			{
-				string tag = conditionName.substr(1);
+				string tag = segment.value.substr(1);
+				string const* value = parameter(tag);
 				assertThrow(
-					_parameters.count(tag),
+					value,
 					WhiskersError, "Tag " + tag + " used as condition but was not set."
 				);
-				conditionValue = !_parameters.at(tag).empty();
+				conditionValue = !value->empty();
 			}
 			else
 			{
 				assertThrow(
-					_conditions.count(conditionName),
-					WhiskersError, "Condition parameter " + conditionName + " not set."
+					_conditions.count(segment.value),
+					WhiskersError, "Condition parameter " + segment.value + " not set."
 				);
-				conditionValue = _conditions.at(conditionName);
+				conditionValue = _conditions.at(segment.value);
 			}
-			return replace(
-				conditionValue ? _match[5] : _match[7],
+			render(
+				conditionValue ? segment.bodies[0] : segment.bodies[1],
 				_parameters,
+				_elementParameters,
 				_conditions,
-				_listParameters
+				_listParameters,
+				_result
 			);
+			break;
+		}
 		}
-	});
-}
-
-Whiskers::StringMap Whiskers::joinMaps(
-	Whiskers::StringMap const& _a,
-	Whiskers::StringMap const& _b
-)
-{
-	Whiskers::StringMap ret = _a;
-	for (auto const& x: _b)
-		assertThrow(
-			ret.insert(x).second,
-			WhiskersError,
-			"Parameter collision"
-		);
-	return ret;
 }
-
@@ -28,6 +28,7 @@
 
 #include <string>
 #include <map>
+#include <memory>
 #include <vector>
 
 namespace solidity::util
@@ -66,6 +67,9 @@ DEV_SIMPLE_EXCEPTION(WhiskersError);
  *  - List parameter: <#list>...</list>
  *    The part between the tags is repeated as often as values are provided
  *    in the mapping. Each list element can have its own parameter -> value mapping.
+ *
+ * Templates are split into these elements only once per template text, and the split
+ * template is shared by all instances with the same text.
  */
 class Whiskers
 {
@@ -100,19 +104,28 @@ private:
 	///        like `"<" + element + _parameter + ">"`. Each element of _prefixes is used as a prefix of the tag name.
 	void checkTemplateContainsTags(std::string const& _parameter, std::vector<std::string> const& _prefixes) const;
 
-	static std::string replace(
-		std::string const& _template,
+	/// Template text split into literal text, parameters, conditions and lists.
+	struct Template;
+
+	/// @returns the split template for @a _template, which is cached for later instances.
+	static std::shared_ptr<Template const> compile(std::string const& _template);
+	/// Splits @a _text into the elements of a template.
+	static Template parse(std::string _text);
+
+	/// Appends the rendered template @a _template to @a _result. The parameters of a list element
+	/// @a _elementParameters are looked up before @a _parameters and lists are only allowed
+	/// if @a _listParameters is not null.
+	static void render(
+		Template const& _template,
 		StringMap const& _parameters,
+		StringMap const* _elementParameters,
 		std::map<std::string, bool> const& _conditions,
-		StringListMap const& _listParameters = StringListMap()
+		StringListMap const* _listParameters,
+		std::string& _result
 	);
 
-	static std::string paramRegex() { return "[a-zA-Z0-9_$-]+"; }
-
-	/// Joins the two maps throwing an exception if two keys are equal.
-	static StringMap joinMaps(StringMap const& _a, StringMap const& _b);
-
 	std::string m_template;
+	std::shared_ptr<Template const> m_compiled;
 	StringMap m_parameters;
 	std::map<std::string, bool> m_conditions;
 	StringListMap m_listParameters;
@@ -23,6 +23,7 @@
 
 #include <libyul/ASTForward.h>
 
+#include <cstddef>
 #include <map>
 #include <memory>
 #include <vector>
@@ -39,6 +40,10 @@ struct AsmAnalysisInfo
 	Scopes scopes;
 	/// Virtual blocks which will be used for scopes for function arguments and return values.
 	std::map<FunctionDefinition const*, std::shared_ptr<Block const>> virtualBlocks;
+	/// Number of variables and functions registered in the scopes, which are numbered
+	/// in the order of registration.
+	size_t numberOfVariables = 0;
+	size_t numberOfFunctions = 0;
 };
 
 }
@@ -28,12 +28,9 @@
 
 #include <libsolutil/CommonData.h>
 
-#include <boost/algorithm/string.hpp>
-#include <boost/algorithm/string/replace.hpp>
-#include <boost/range/adaptor/transformed.hpp>
-
-#include <memory>
-#include <functional>
+#include <limits>
+#include <optional>
+#include <string_view>
 
 using namespace std;
 using namespace solidity;
@@ -42,177 +39,301 @@ using namespace solidity::yul;
 
 //@TODO source locations
 
-string AsmPrinter::operator()(Literal const& _literal) const
+namespace
+{
+
+/**
+ * Writes the textual form of Yul AST nodes into a single buffer.
+ * Every line after the first is indented by the given number of levels.
+ * If a limit is given, printing stops as soon as the text would be longer than the limit
+ * or would span several lines. This is used to find out whether a block fits on one line.
+ */
+class Printer
+{
+public:
+	Printer(
+		Dialect const* _dialect,
+		string& _out,
+		size_t _indentation,
+		size_t _limit = numeric_limits<size_t>::max()
+	):
+		m_dialect(_dialect),
+		m_out(_out),
+		m_indentation(_indentation),
+		m_start(_out.size()),
+		m_limit(_limit)
+	{}
+
+	/// @returns false if printing was stopped because of the limit.
+	bool withinLimit() const { return !m_exceeded; }
+
+	void operator()(Literal const& _literal);
+	void operator()(Identifier const& _identifier);
+	void operator()(ExpressionStatement const& _statement) { std::visit(*this, _statement.expression); }
+	void operator()(Assignment const& _assignment);
+	void operator()(VariableDeclaration const& _variableDeclaration);
+	void operator()(FunctionDefinition const& _functionDefinition);
+	void operator()(FunctionCall const& _functionCall);
+	void operator()(If const& _if);
+	void operator()(Switch const& _switch);
+	void operator()(ForLoop const& _forLoop);
+	void operator()(Break const&) { write("break"); }
+	void operator()(Continue const&) { write("continue"); }
+	void operator()(Leave const&) { write("leave"); }
+	void operator()(Block const& _block);
+
+private:
+	bool limited() const { return m_limit != numeric_limits<size_t>::max(); }
+	void write(string_view _text);
+	void newline();
+	/// @returns the block in a single line, if it is short enough for that.
+	optional<string> singleLine(Block const& _block) const;
+	void printMultiLine(Block const& _block);
+	void printTypedNames(vector<TypedName> const& _names);
+	void printTypeName(YulString _type, bool _isBoolLiteral = false);
+
+	Dialect const* m_dialect = nullptr;
+	string& m_out;
+	size_t m_indentation = 0;
+	size_t const m_start = 0;
+	size_t const m_limit = 0;
+	bool m_exceeded = false;
+};
+
+void Printer::operator()(Literal const& _literal)
 {
 	switch (_literal.kind)
 	{
 	case LiteralKind::Number:
 		yulAssert(isValidDecimal(_literal.value.str()) || isValidHex(_literal.value.str()), "Invalid number literal");
-		return _literal.value.str() + appendTypeName(_literal.type);
+		write(_literal.value.str());
+		printTypeName(_literal.type);
+		return;
 	case LiteralKind::Boolean:
 		yulAssert(_literal.value == "true"_yulstring || _literal.value == "false"_yulstring, "Invalid bool literal.");
-		return ((_literal.value == "true"_yulstring) ? "true" : "false") + appendTypeName(_literal.type, true);
+		write((_literal.value == "true"_yulstring) ? "true" : "false");
+		printTypeName(_literal.type, true);
+		return;
 	case LiteralKind::String:
 		break;
 	}
 
-	return escapeAndQuoteString(_literal.value.str()) + appendTypeName(_literal.type);
+	write(escapeAndQuoteString(_literal.value.str()));
+	printTypeName(_literal.type);
 }
 
-string AsmPrinter::operator()(Identifier const& _identifier) const
+void Printer::operator()(Identifier const& _identifier)
 {
 	yulAssert(!_identifier.name.empty(), "Invalid identifier.");
-	return _identifier.name.str();
+	write(_identifier.name.str());
 }
 
-string AsmPrinter::operator()(ExpressionStatement const& _statement) const
-{
-	return std::visit(*this, _statement.expression);
-}
-
-string AsmPrinter::operator()(Assignment const& _assignment) const
+void Printer::operator()(Assignment const& _assignment)
 {
 	yulAssert(_assignment.variableNames.size() >= 1, "");
-	string variables = (*this)(_assignment.variableNames.front());
-	for (size_t i = 1; i < _assignment.variableNames.size(); ++i)
-		variables += ", " + (*this)(_assignment.variableNames[i]);
-	return variables + " := " + std::visit(*this, *_assignment.value);
+	for (size_t i = 0; i < _assignment.variableNames.size(); ++i)
+	{
+		if (i > 0)
+			write(", ");
+		(*this)(_assignment.variableNames[i]);
+	}
+	write(" := ");
+	std::visit(*this, *_assignment.value);
 }
 
-string AsmPrinter::operator()(VariableDeclaration const& _variableDeclaration) const
+void Printer::operator()(VariableDeclaration const& _variableDeclaration)
 {
-	string out = "let ";
-	out += boost::algorithm::join(
-		_variableDeclaration.variables | boost::adaptors::transformed(
-			[this](TypedName argument) { return formatTypedName(argument); }
-		),
-		", "
-	);
+	write("let ");
+	printTypedNames(_variableDeclaration.variables);
 	if (_variableDeclaration.value)
 	{
-		out += " := ";
-		out += std::visit(*this, *_variableDeclaration.value);
+		write(" := ");
+		std::visit(*this, *_variableDeclaration.value);
 	}
-	return out;
 }
 
-string AsmPrinter::operator()(FunctionDefinition const& _functionDefinition) const
+void Printer::operator()(FunctionDefinition const& _functionDefinition)
 {
 	yulAssert(!_functionDefinition.name.empty(), "Invalid function name.");
-	string out = "function " + _functionDefinition.name.str() + "(";
-	out += boost::algorithm::join(
-		_functionDefinition.parameters | boost::adaptors::transformed(
-			[this](TypedName argument) { return formatTypedName(argument); }
-		),
-		", "
-	);
-	out += ")";
+	write("function ");
+	write(_functionDefinition.name.str());
+	write("(");
+	printTypedNames(_functionDefinition.parameters);
+	write(")");
 	if (!_functionDefinition.returnVariables.empty())
 	{
-		out += " -> ";
-		out += boost::algorithm::join(
-			_functionDefinition.returnVariables | boost::adaptors::transformed(
-				[this](TypedName argument) { return formatTypedName(argument); }
-			),
-			", "
-		);
+		write(" -> ");
+		printTypedNames(_functionDefinition.returnVariables);
 	}
-
-	return out + "\n" + (*this)(_functionDefinition.body);
+	newline();
+	(*this)(_functionDefinition.body);
 }
 
-string AsmPrinter::operator()(FunctionCall const& _functionCall) const
+void Printer::operator()(FunctionCall const& _functionCall)
 {
-	return
-		(*this)(_functionCall.functionName) + "(" +
-		boost::algorithm::join(
-			_functionCall.arguments | boost::adaptors::transformed([&](auto&& _node) { return std::visit(*this, _node); }),
-			", " ) +
-		")";
+	(*this)(_functionCall.functionName);
+	write("(");
+	for (size_t i = 0; i < _functionCall.arguments.size() && !m_exceeded; ++i)
+	{
+		if (i > 0)
+			write(", ");
+		std::visit(*this, _functionCall.arguments[i]);
+	}
+	write(")");
 }
 
-string AsmPrinter::operator()(If const& _if) const
+void Printer::operator()(If const& _if)
 {
 	yulAssert(_if.condition, "Invalid if condition.");
-	string body = (*this)(_if.body);
-	char delim = '\n';
-	if (body.find('\n') == string::npos)
-		delim = ' ';
-	return "if " + std::visit(*this, *_if.condition) + delim + (*this)(_if.body);
+	write("if ");
+	std::visit(*this, *_if.condition);
+	if (optional<string> body = singleLine(_if.body))
+	{
+		write(" ");
+		write(*body);
+	}
+	else
+	{
+		newline();
+		printMultiLine(_if.body);
+	}
 }
 
-string AsmPrinter::operator()(Switch const& _switch) const
+void Printer::operator()(Switch const& _switch)
 {
 	yulAssert(_switch.expression, "Invalid expression pointer.");
-	string out = "switch " + std::visit(*this, *_switch.expression);
+	write("switch ");
+	std::visit(*this, *_switch.expression);
 	for (auto const& _case: _switch.cases)
 	{
+		if (m_exceeded)
+			return;
+		newline();
 		if (!_case.value)
-			out += "\ndefault ";
+			write("default ");
 		else
-			out += "\ncase " + (*this)(*_case.value) + " ";
-		out += (*this)(_case.body);
+		{
+			write("case ");
+			(*this)(*_case.value);
+			write(" ");
+		}
+		(*this)(_case.body);
 	}
-	return out;
 }
 
-string AsmPrinter::operator()(ForLoop const& _forLoop) const
+void Printer::operator()(ForLoop const& _forLoop)
 {
 	yulAssert(_forLoop.condition, "Invalid for loop condition.");
-	string pre = (*this)(_forLoop.pre);
-	string condition = std::visit(*this, *_forLoop.condition);
-	string post = (*this)(_forLoop.post);
-	char delim = '\n';
-	if (
-		pre.size() + condition.size() + post.size() < 60 &&
-		pre.find('\n') == string::npos &&
-		post.find('\n') == string::npos
-	)
-		delim = ' ';
-	return
-		("for " + move(pre) + delim + move(condition) + delim + move(post) + "\n") +
-		(*this)(_forLoop.body);
+	optional<string> pre = singleLine(_forLoop.pre);
+	optional<string> post = singleLine(_forLoop.post);
+	string condition;
+	Printer conditionPrinter(m_dialect, condition, 0, m_limit);
+	std::visit(conditionPrinter, *_forLoop.condition);
+	if (!conditionPrinter.withinLimit())
+	{
+		m_exceeded = true;
+		return;
+	}
+	bool const oneLine = pre && post && pre->size() + condition.size() + post->size() < 60;
+
+	auto delimiter = [&]() {
+		if (oneLine)
+			write(" ");
+		else
+			newline();
+	};
+
+	write("for ");
+	if (pre)
+		write(*pre);
+	else
+		printMultiLine(_forLoop.pre);
+	delimiter();
+	write(condition);
+	delimiter();
+	if (post)
+		write(*post);
+	else
+		printMultiLine(_forLoop.post);
+	newline();
+	(*this)(_forLoop.body);
 }
 
-string AsmPrinter::operator()(Break const&) const
+void Printer::operator()(Block const& _block)
 {
-	return "break";
+	if (optional<string> line = singleLine(_block))
+		write(*line);
+	else
+		printMultiLine(_block);
 }
 
-string AsmPrinter::operator()(Continue const&) const
+void Printer::write(string_view _text)
 {
-	return "continue";
+	if (m_exceeded)
+		return;
+	if (limited() && m_out.size() - m_start + _text.size() > m_limit)
+		m_exceeded = true;
+	else
+		m_out.append(_text);
 }
 
-string AsmPrinter::operator()(Leave const&) const
+void Printer::newline()
 {
-	return "leave";
+	if (m_exceeded)
+		return;
+	if (limited())
+		m_exceeded = true;
+	else
+	{
+		m_out.push_back('\n');
+		m_out.append(4 * m_indentation, ' ');
+	}
 }
 
-string AsmPrinter::operator()(Block const& _block) const
+optional<string> Printer::singleLine(Block const& _block) const
 {
 	if (_block.statements.empty())
 		return "{ }";
-	string body = boost::algorithm::join(
-		_block.statements | boost::adaptors::transformed([&](auto&& _node) { return std::visit(*this, _node); }),
-		"\n"
-	);
-	if (body.size() < 30 && body.find('\n') == string::npos)
-		return "{ " + body + " }";
-	else
+	// Several statements are always printed on separate lines.
+	if (_block.statements.size() > 1)
+		return nullopt;
+	string body;
+	Printer bodyPrinter(m_dialect, body, 0, 29);
+	std::visit(bodyPrinter, _block.statements.front());
+	if (!bodyPrinter.withinLimit())
+		return nullopt;
+	return "{ " + body + " }";
+}
+
+void Printer::printMultiLine(Block const& _block)
+{
+	write("{");
+	++m_indentation;
+	for (auto const& statement: _block.statements)
 	{
-		boost::replace_all(body, "\n", "\n    ");
-		return "{\n    " + body + "\n}";
+		if (m_exceeded)
+			return;
+		newline();
+		std::visit(*this, statement);
 	}
+	--m_indentation;
+	newline();
+	write("}");
 }
 
-string AsmPrinter::formatTypedName(TypedName _variable) const
+void Printer::printTypedNames(vector<TypedName> const& _names)
 {
-	yulAssert(!_variable.name.empty(), "Invalid variable name.");
-	return _variable.name.str() + appendTypeName(_variable.type);
+	for (size_t i = 0; i < _names.size(); ++i)
+	{
+		if (i > 0)
+			write(", ");
+		yulAssert(!_names[i].name.empty(), "Invalid variable name.");
+		write(_names[i].name.str());
+		printTypeName(_names[i].type);
+	}
 }
 
-string AsmPrinter::appendTypeName(YulString _type, bool _isBoolLiteral) const
+void Printer::printTypeName(YulString _type, bool _isBoolLiteral)
 {
 	if (m_dialect && !_type.empty())
 	{
@@ -222,8 +343,41 @@ string AsmPrinter::appendTypeName(YulString _type, bool _isBoolLiteral) const
 			// Special case: If we have a bool type but empty default type, do not remove the type.
 			_type = {};
 	}
-	if (_type.empty())
-		return {};
-	else
-		return ":" + _type.str();
+	if (!_type.empty())
+	{
+		write(":");
+		write(_type.str());
+	}
+}
+
+template <class T>
+string printNode(Dialect const* _dialect, T const& _node)
+{
+	string out;
+	Printer printer(_dialect, out, 0);
+	printer(_node);
+	return out;
+}
+
+}
+
+string AsmPrinter::operator()(Literal const& _literal) const { return printNode(m_dialect, _literal); }
+string AsmPrinter::operator()(Identifier const& _identifier) const { return printNode(m_dialect, _identifier); }
+string AsmPrinter::operator()(ExpressionStatement const& _statement) const { return printNode(m_dialect, _statement); }
+string AsmPrinter::operator()(Assignment const& _assignment) const { return printNode(m_dialect, _assignment); }
+string AsmPrinter::operator()(VariableDeclaration const& _variableDeclaration) const { return printNode(m_dialect, _variableDeclaration); }
+string AsmPrinter::operator()(FunctionDefinition const& _functionDefinition) const { return printNode(m_dialect, _functionDefinition); }
+string AsmPrinter::operator()(FunctionCall const& _functionCall) const { return printNode(m_dialect, _functionCall); }
+string AsmPrinter::operator()(If const& _if) const { return printNode(m_dialect, _if); }
+string AsmPrinter::operator()(Switch const& _switch) const { return printNode(m_dialect, _switch); }
+string AsmPrinter::operator()(ForLoop const& _forLoop) const { return printNode(m_dialect, _forLoop); }
+string AsmPrinter::operator()(Break const& _break) const { return printNode(m_dialect, _break); }
+string AsmPrinter::operator()(Continue const& _continue) const { return printNode(m_dialect, _continue); }
+string AsmPrinter::operator()(Leave const& _leave) const { return printNode(m_dialect, _leave); }
+string AsmPrinter::operator()(Block const& _block) const { return printNode(m_dialect, _block); }
+
+void AsmPrinter::print(Block const& _block, string& _out, size_t _indentation) const
+{
+	Printer printer(m_dialect, _out, _indentation);
+	printer(_block);
 }
@@ -27,6 +27,8 @@
 
 #include <libyul/YulString.h>
 
+#include <string>
+
 namespace solidity::yul
 {
 struct Dialect;
@@ -57,10 +59,11 @@ public:
 	std::string operator()(Leave const& _continue) const;
 	std::string operator()(Block const& _block) const;
 
-private:
-	std::string formatTypedName(TypedName _variable) const;
-	std::string appendTypeName(YulString _type, bool _isBoolLiteral = false) const;
+	/// Appends the textual form of @a _block to @a _out without building the text of the
+	/// nested nodes separately. Every line after the first is indented by @a _indentation levels.
+	void print(Block const& _block, std::string& _out, size_t _indentation = 0) const;
 
+private:
 	Dialect const* m_dialect = nullptr;
 };
 
@@ -38,6 +38,8 @@
 #include <libyul/backends/wasm/EVMToEwasmTranslator.h>
 #include <libyul/optimiser/Metrics.h>
 #include <libyul/ObjectParser.h>
+#include <libyul/optimiser/FunctionStepCache.h>
+#include <libyul/optimiser/OptimisedCodeCache.h>
 #include <libyul/optimiser/Suite.h>
 
 #include <libsolidity/interface/OptimiserSettings.h>
@@ -45,6 +47,9 @@
 #include <libevmasm/Assembly.h>
 #include <liblangutil/Scanner.h>
 
+#include <libsolutil/CompilationStatistics.h>
+#include <libsolutil/ThreadPool.h>
+
 using namespace std;
 using namespace solidity;
 using namespace solidity::yul;
@@ -77,6 +82,13 @@ Scanner const& AssemblyStack::scanner() const
 	return *m_scanner;
 }
 
+CharStream const* AssemblyStack::charStream(string const& _sourceName) const
+{
+	if (!m_scanner || m_scanner->charStream()->name() != _sourceName)
+		return nullptr;
+	return m_scanner->charStream().get();
+}
+
 bool AssemblyStack::parseAndAnalyze(std::string const& _sourceName, std::string const& _source)
 {
 	m_errors.clear();
@@ -91,6 +103,18 @@ bool AssemblyStack::parseAndAnalyze(std::string const& _sourceName, std::string
 	return analyzeParsed();
 }
 
+void AssemblyStack::setAnalyzedObject(shared_ptr<Object> _object)
+{
+	yulAssert(_object, "");
+	yulAssert(_object->code, "");
+	yulAssert(_object->analysisInfo, "Object has not been analyzed.");
+
+	m_errors.clear();
+	m_scanner.reset();
+	m_parserResult = move(_object);
+	m_analysisSuccessful = true;
+}
+
 void AssemblyStack::optimize()
 {
 	if (!m_optimiserSettings.runYulOptimiser)
@@ -100,8 +124,11 @@ void AssemblyStack::optimize()
 
 	m_analysisSuccessful = false;
 	yulAssert(m_parserResult, "");
-	optimize(*m_parserResult, true);
-	yulAssert(analyzeParsed(), "Invalid source code after optimization.");
+	optimize(*m_parserResult, true, m_parallelism, nullptr);
+	// The optimiser suite and the code cache analyse the code of each object they produce
+	// and only accept valid code, so the object tree does not have to be analysed again.
+	m_analysisSuccessful = analyzed(*m_parserResult);
+	yulAssert(m_analysisSuccessful, "Invalid source code after optimization.");
 }
 
 void AssemblyStack::translate(AssemblyStack::Language _targetLanguage)
@@ -148,7 +175,30 @@ bool AssemblyStack::analyzeParsed(Object& _object)
 	return success;
 }
 
-void AssemblyStack::compileEVM(AbstractAssembly& _assembly, bool _evm15, bool _optimize) const
+bool AssemblyStack::analyzed(Object const& _object)
+{
+	if (!_object.code || !_object.analysisInfo)
+		return false;
+	for (auto const& subNode: _object.subObjects)
+		if (auto subObject = dynamic_cast<Object const*>(subNode.get()))
+			if (!analyzed(*subObject))
+				return false;
+	return true;
+}
+
+string AssemblyStack::sourceName() const
+{
+	if (m_scanner && m_scanner->charStream())
+		return m_scanner->charStream()->name();
+	return "";
+}
+
+vector<pair<string, EVMObjectCache::Entry>> AssemblyStack::compileEVM(
+	AbstractAssembly& _assembly,
+	bool _evm15,
+	bool _optimize,
+	EVMObjectCache* _cache
+) const
 {
 	EVMDialect const* dialect = nullptr;
 	switch (m_language)
@@ -165,18 +215,86 @@ void AssemblyStack::compileEVM(AbstractAssembly& _assembly, bool _evm15, bool _o
 			break;
 	}
 
-	EVMObjectCompiler::compile(*m_parserResult, _assembly, *dialect, _evm15, _optimize);
+	return EVMObjectCompiler::compile(*m_parserResult, _assembly, *dialect, _evm15, _optimize, m_parallelism, _cache);
 }
 
-void AssemblyStack::optimize(Object& _object, bool _isCreation)
+void AssemblyStack::optimize(
+	Object& _object,
+	bool _isCreation,
+	size_t _parallelism,
+	FunctionStepCache* _recordedResults
+)
 {
 	yulAssert(_object.code, "");
 	yulAssert(_object.analysisInfo, "");
+	bool const reuse = m_optimiserSettings.yulReuseAcrossObjects;
+	Dialect const& dialect = languageToDialect(m_language, m_evmVersion);
+	// If results are reused, the result also depends on how the sub-objects are optimised,
+	// so the input contains them before they are optimised. Objects whose results are recorded
+	// for the object containing them have to be optimised in any case. The results of a
+	// time-limited optimiser cannot be reused.
+	string cacheInput;
+	if (m_optimisedCodeCache && !_recordedResults && !m_optimiserSettings.yulOptimiserTimeBudget)
+	{
+		cacheInput = optimiserCacheInput(_object, _isCreation);
+		if (reuse)
+			for (auto const& subNode: _object.subObjects)
+			{
+				cacheInput += "\n";
+				subNode->print(cacheInput, &dialect, 0);
+			}
+	}
+
+	vector<Object*> subObjects;
 	for (auto& subNode: _object.subObjects)
 		if (auto subObject = dynamic_cast<Object*>(subNode.get()))
-			optimize(*subObject, false);
+			subObjects.push_back(subObject);
+	// Each sub-object records its results separately, they are combined in a fixed order.
+	vector<FunctionStepCache> subResults(reuse ? subObjects.size() : 0);
+	size_t const threads = min(util::ThreadPool::effectiveThreads(_parallelism), subObjects.size());
+	if (threads > 1)
+	{
+		// Sub-objects are optimised independently of each other and of this object.
+		// The threads are only used at this level to avoid oversubscription.
+		util::CompilationStatistics* statistics = util::CompilationStatistics::current();
+		vector<util::CompilationStatistics> subStatistics(statistics ? subObjects.size() : 0);
+		util::ThreadPool pool(threads);
+		for (size_t i = 0; i < subObjects.size(); ++i)
+			pool.submit([&, i]() {
+				util::CompilationStatistics::Scope scope(statistics ? &subStatistics[i] : nullptr);
+				optimize(*subObjects[i], false, 1, reuse ? &subResults[i] : nullptr);
+			});
+		pool.wait();
+		for (util::CompilationStatistics const& subStatistic: subStatistics)
+			statistics->merge(subStatistic);
+	}
+	else
+		for (size_t i = 0; i < subObjects.size(); ++i)
+			optimize(*subObjects[i], false, _parallelism, reuse ? &subResults[i] : nullptr);
+	FunctionStepCache reusedResults;
+	for (FunctionStepCache& results: subResults)
+		reusedResults.merge(move(results));
+
+	if (!cacheInput.empty())
+	{
+		if (shared_ptr<Block> code = m_optimisedCodeCache->load(cacheInput, dialect))
+		{
+			// Entries read from disk are not trusted, invalid ones are optimized again.
+			auto analysisInfo = make_shared<AsmAnalysisInfo>();
+			ErrorList errors;
+			ErrorReporter errorReporter(errors);
+			if (AsmAnalyzer(*analysisInfo, errorReporter, dialect, {}, _object.qualifiedDataNames()).analyze(*code))
+			{
+				_object.code = move(code);
+				_object.analysisInfo = move(analysisInfo);
+				return;
+			}
+		}
+	}
 
-	Dialect const& dialect = languageToDialect(m_language, m_evmVersion);
+	set<YulString> noInlineFunctions;
+	for (string const& name: m_optimiserSettings.yulNoInlineFunctions)
+		noInlineFunctions.insert(YulString{name});
 	unique_ptr<GasMeter> meter;
 	if (EVMDialect const* evmDialect = dynamic_cast<EVMDialect const*>(&dialect))
 		meter = make_unique<GasMeter>(*evmDialect, _isCreation, m_optimiserSettings.expectedExecutionsPerDeployment);
@@ -185,8 +303,60 @@ void AssemblyStack::optimize(Object& _object, bool _isCreation)
 		meter.get(),
 		_object,
 		m_optimiserSettings.optimizeStackAllocation,
-		m_optimiserSettings.yulOptimiserSteps
+		m_optimiserSettings.yulOptimiserSteps,
+		{},
+		_parallelism,
+		m_optimiserSettings.yulOptimiserTimeBudget,
+		reusedResults.empty() ? nullptr : &reusedResults,
+		_recordedResults,
+		noInlineFunctions
 	);
+
+	if (!cacheInput.empty())
+		m_optimisedCodeCache->store(cacheInput, dialect, *_object.code);
+	// The results found in the sub-objects are also valid for the object containing this one.
+	if (_recordedResults)
+		_recordedResults->merge(move(reusedResults));
+}
+
+void AssemblyStack::optimizeStackLayout(evmasm::Assembly& _assembly) const
+{
+	// The code transform assigns stack slots in statement order. The eliminator rebuilds
+	// each basic block from its expression graph with as few stack operations as it can find
+	// and only keeps the result if it is shorter.
+	evmasm::Assembly::OptimiserSettings settings;
+	settings.isCreation = true;
+	settings.runJumpdestRemover = true;
+	settings.runPeephole = true;
+	settings.runCSE = true;
+	settings.evmVersion = m_evmVersion;
+	settings.expectedExecutionsPerDeployment = m_optimiserSettings.expectedExecutionsPerDeployment;
+	settings.parallelism = m_parallelism;
+	_assembly.optimise(settings);
+}
+
+string AssemblyStack::optimiserCacheInput(Object const& _object, bool _isCreation) const
+{
+	// The optimizer does not look into sub-objects, it only needs their names.
+	string input =
+		to_string(static_cast<int>(m_language)) + " " +
+		m_evmVersion.name() + " " +
+		(m_optimiserSettings.optimizeStackAllocation ? "stackAllocation " : "") +
+		(_isCreation ? "creation " : "") +
+		to_string(m_optimiserSettings.expectedExecutionsPerDeployment) + " " +
+		m_optimiserSettings.yulOptimiserSteps + "\n";
+	if (!m_optimiserSettings.yulNoInlineFunctions.empty())
+	{
+		input += "noinline ";
+		for (string const& name: m_optimiserSettings.yulNoInlineFunctions)
+			input += name + " ";
+		input += "\n";
+	}
+	for (YulString name: _object.qualifiedDataNames())
+		input += name.str() + " ";
+	input += "\n";
+	AsmPrinter(languageToDialect(m_language, m_evmVersion)).print(*_object.code, input);
+	return input;
 }
 
 MachineAssemblyObject AssemblyStack::assemble(Machine _machine) const
@@ -235,16 +405,27 @@ std::pair<MachineAssemblyObject, MachineAssemblyObject> AssemblyStack::assembleW
 
 	evmasm::Assembly assembly;
 	EthAssemblyAdapter adapter(assembly);
-	compileEVM(adapter, false, m_optimiserSettings.optimizeStackAllocation);
+	auto newCacheEntries = compileEVM(
+		adapter,
+		false,
+		m_optimiserSettings.optimizeStackAllocation,
+		m_evmObjectCache.get()
+	);
+	if (m_optimiserSettings.optimizeStackLayout)
+		optimizeStackLayout(assembly);
 
 	MachineAssemblyObject creationObject;
 	creationObject.bytecode = make_shared<evmasm::LinkerObject>(assembly.assemble());
+	// The sub-assemblies have been optimised and assembled together with this assembly and are
+	// not modified anymore.
+	for (auto& [cacheInput, entry]: newCacheEntries)
+		m_evmObjectCache->store(cacheInput, move(entry));
 	yulAssert(creationObject.bytecode->immutableReferences.empty(), "Leftover immutables.");
 	creationObject.assembly = assembly.assemblyString();
 	creationObject.sourceMappings = make_unique<string>(
 		evmasm::AssemblyItem::computeSourceMapping(
 			assembly.items(),
-			{{scanner().charStream() ? scanner().charStream()->name() : "", 0}}
+			{{sourceName(), 0}}
 		)
 	);
 
@@ -275,7 +456,7 @@ std::pair<MachineAssemblyObject, MachineAssemblyObject> AssemblyStack::assembleW
 		deployedObject.sourceMappings = make_unique<string>(
 			evmasm::AssemblyItem::computeSourceMapping(
 				runtimeAssembly.items(),
-				{{scanner().charStream() ? scanner().charStream()->name() : "", 0}}
+				{{sourceName(), 0}}
 			)
 		);
 	}
@@ -287,7 +468,10 @@ string AssemblyStack::print() const
 {
 	yulAssert(m_parserResult, "");
 	yulAssert(m_parserResult->code, "");
-	return m_parserResult->toString(&languageToDialect(m_language, m_evmVersion)) + "\n";
+	string out;
+	m_parserResult->print(out, &languageToDialect(m_language, m_evmVersion), 0);
+	out += "\n";
+	return out;
 }
 
 shared_ptr<Object> AssemblyStack::parserResult() const
@@ -22,11 +22,13 @@
 
 #pragma once
 
+#include <liblangutil/CharStreamProvider.h>
 #include <liblangutil/ErrorReporter.h>
 #include <liblangutil/EVMVersion.h>
 
 #include <libyul/Object.h>
 #include <libyul/ObjectParser.h>
+#include <libyul/backends/evm/EVMObjectCache.h>
 
 #include <libsolidity/interface/OptimiserSettings.h>
 
@@ -34,15 +36,24 @@
 
 #include <memory>
 #include <string>
+#include <utility>
+#include <vector>
 
 namespace solidity::langutil
 {
 class Scanner;
 }
 
+namespace solidity::evmasm
+{
+class Assembly;
+}
+
 namespace solidity::yul
 {
 class AbstractAssembly;
+class FunctionStepCache;
+class OptimisedCodeCache;
 
 
 struct MachineAssemblyObject
@@ -56,7 +67,7 @@ struct MachineAssemblyObject
  * Full assembly stack that can support EVM-assembly and Yul as input and EVM, EVM1.5 and
  * Ewasm as output.
  */
-class AssemblyStack
+class AssemblyStack: public langutil::CharStreamProvider
 {
 public:
 	enum class Language { Yul, Assembly, StrictAssembly, Ewasm };
@@ -74,11 +85,29 @@ public:
 
 	/// @returns the scanner used during parsing
 	langutil::Scanner const& scanner() const;
+	/// @returns the parsed source if it is called @a _sourceName.
+	langutil::CharStream const* charStream(std::string const& _sourceName) const override;
 
 	/// Runs parsing and analysis steps, returns false if input cannot be assembled.
 	/// Multiple calls overwrite the previous state.
 	bool parseAndAnalyze(std::string const& _sourceName, std::string const& _source);
 
+	/// Uses @a _object as input instead of parsing source code. The object has to be
+	/// analyzed for the language of this stack and is modified by subsequent steps.
+	/// Multiple calls overwrite the previous state.
+	void setAnalyzedObject(std::shared_ptr<Object> _object);
+
+	/// Makes the optimizer reuse and fill @a _cache, which can be shared with other stacks.
+	void setOptimisedCodeCache(std::shared_ptr<OptimisedCodeCache> _cache) { m_optimisedCodeCache = std::move(_cache); }
+
+	/// Makes the EVM code generation reuse and fill @a _cache, which can be shared with other
+	/// stacks using the same settings.
+	void setEVMObjectCache(std::shared_ptr<EVMObjectCache> _cache) { m_evmObjectCache = std::move(_cache); }
+
+	/// Makes the optimizer apply function-local steps to up to @a _threads groups of functions
+	/// concurrently. Zero means one thread per hardware thread. The result does not depend on it.
+	void setParallelism(size_t _threads) { m_parallelism = _threads; }
+
 	/// Run the optimizer suite. Can only be used with Yul or strict assembly.
 	/// If the settings (see constructor) disabled the optimizer, nothing is done here.
 	void optimize();
@@ -113,14 +142,43 @@ public:
 private:
 	bool analyzeParsed();
 	bool analyzeParsed(yul::Object& _object);
-
-	void compileEVM(yul::AbstractAssembly& _assembly, bool _evm15, bool _optimize) const;
-
-	void optimize(yul::Object& _object, bool _isCreation);
+	/// @returns true if @a _object and all its sub-objects carry analysis information.
+	static bool analyzed(yul::Object const& _object);
+
+	/// @returns the name of the parsed source, or an empty string if there is none.
+	std::string sourceName() const;
+
+	/// Compiles the object into @a _assembly, using @a _cache for the sub-objects if given.
+	/// @returns the assemblies to be stored in @a _cache, see EVMObjectCompiler::compile.
+	std::vector<std::pair<std::string, EVMObjectCache::Entry>> compileEVM(
+		yul::AbstractAssembly& _assembly,
+		bool _evm15,
+		bool _optimize,
+		EVMObjectCache* _cache = nullptr
+	) const;
+	/// Reduces the stack operations of the EVM code generated from Yul if requested by the settings.
+	void optimizeStackLayout(evmasm::Assembly& _assembly) const;
+
+	/// Optimizes @a _object after its sub-objects, which are optimized concurrently if
+	/// @a _parallelism allows for more than one thread. If the results of optimiser steps on
+	/// functions are reused across objects, they are recorded in @a _recordedResults for the
+	/// object containing @a _object.
+	void optimize(
+		yul::Object& _object,
+		bool _isCreation,
+		size_t _parallelism,
+		FunctionStepCache* _recordedResults
+	);
+	/// @returns everything the result of optimizing the code of @a _object depends on,
+	/// used to look it up in the optimised code cache.
+	std::string optimiserCacheInput(yul::Object const& _object, bool _isCreation) const;
 
 	Language m_language = Language::Assembly;
 	langutil::EVMVersion m_evmVersion;
 	solidity::frontend::OptimiserSettings m_optimiserSettings;
+	std::shared_ptr<OptimisedCodeCache> m_optimisedCodeCache;
+	std::shared_ptr<EVMObjectCache> m_evmObjectCache;
+	size_t m_parallelism = 1;
 
 	std::shared_ptr<langutil::Scanner> m_scanner;
 
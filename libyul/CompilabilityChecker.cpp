@@ -22,6 +22,8 @@
 
 #include <libyul/AsmAnalysis.h>
 #include <libyul/AsmAnalysisInfo.h>
+#include <libyul/AST.h>
+#include <libyul/optimiser/ASTCopier.h>
 
 #include <libyul/backends/evm/EVMCodeTransform.h>
 #include <libyul/backends/evm/NoOutputAssembly.h>
@@ -33,10 +35,14 @@ using namespace solidity;
 using namespace solidity::yul;
 using namespace solidity::util;
 
-CompilabilityChecker::CompilabilityChecker(
+namespace
+{
+
+void checkCompilability(
 	Dialect const& _dialect,
 	Object const& _object,
-	bool _optimizeStackAllocation
+	bool _optimizeStackAllocation,
+	CompilabilityChecker& _result
 )
 {
 	if (auto const* evmDialect = dynamic_cast<EVMDialect const*>(&_dialect))
@@ -65,9 +71,62 @@ CompilabilityChecker::CompilabilityChecker(
 
 		for (StackTooDeepError const& error: transform.stackErrors())
 		{
-			unreachableVariables[error.functionName].emplace(error.variable);
-			int& deficit = stackDeficit[error.functionName];
+			_result.unreachableVariables[error.functionName].emplace(error.variable);
+			int& deficit = _result.stackDeficit[error.functionName];
 			deficit = std::max(error.depth, deficit);
 		}
 	}
 }
+
+}
+
+CompilabilityChecker::CompilabilityChecker(
+	Dialect const& _dialect,
+	Object const& _object,
+	bool _optimizeStackAllocation
+)
+{
+	checkCompilability(_dialect, _object, _optimizeStackAllocation, *this);
+}
+
+CompilabilityChecker::CompilabilityChecker(
+	Dialect const& _dialect,
+	Object const& _object,
+	bool _optimizeStackAllocation,
+	set<YulString> const& _functionsToCheck
+)
+{
+	// The functions that are not checked are replaced by functions with the same signature
+	// and an empty body, so that the calls to them can still be compiled.
+	Object reducedObject = _object;
+	reducedObject.code = make_shared<Block>(Block{_object.code->location, {}});
+	reducedObject.analysisInfo.reset();
+	set<YulString> uncheckedFunctions;
+	for (Statement const& statement: _object.code->statements)
+		if (auto const* function = get_if<FunctionDefinition>(&statement))
+		{
+			if (_functionsToCheck.count(function->name))
+				reducedObject.code->statements.emplace_back(ASTCopier{}.translate(statement));
+			else
+			{
+				uncheckedFunctions.insert(function->name);
+				reducedObject.code->statements.emplace_back(FunctionDefinition{
+					function->location,
+					function->name,
+					function->parameters,
+					function->returnVariables,
+					Block{function->body.location, {}}
+				});
+			}
+		}
+		else if (_functionsToCheck.count(YulString{}))
+			reducedObject.code->statements.emplace_back(ASTCopier{}.translate(statement));
+
+	checkCompilability(_dialect, reducedObject, _optimizeStackAllocation, *this);
+	// The replacements can still have too many parameters or return variables.
+	for (YulString function: uncheckedFunctions)
+	{
+		unreachableVariables.erase(function);
+		stackDeficit.erase(function);
+	}
+}
@@ -27,6 +27,7 @@
 
 #include <map>
 #include <memory>
+#include <set>
 
 namespace solidity::yul
 {
@@ -45,6 +46,16 @@ namespace solidity::yul
 struct CompilabilityChecker
 {
 	CompilabilityChecker(Dialect const& _dialect, Object const& _object, bool _optimizeStackAllocation);
+	/// Only checks the functions of the outermost block named in @a _functionsToCheck, together
+	/// with the functions nested in them, and the code outside of functions if it contains the
+	/// empty name. Bodies of other functions are not compiled, which is much cheaper if only a
+	/// few functions changed since the last check.
+	CompilabilityChecker(
+		Dialect const& _dialect,
+		Object const& _object,
+		bool _optimizeStackAllocation,
+		std::set<YulString> const& _functionsToCheck
+	);
 	std::map<YulString, std::set<YulString>> unreachableVariables;
 	std::map<YulString, int> stackDeficit;
 };
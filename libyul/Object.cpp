@@ -28,39 +28,43 @@
 
 #include <boost/algorithm/string.hpp>
 #include <boost/algorithm/string/split.hpp>
-#include <boost/algorithm/string/replace.hpp>
 
 using namespace std;
 using namespace solidity;
 using namespace solidity::yul;
 using namespace solidity::util;
 
-namespace
+string ObjectNode::toString(Dialect const* _dialect) const
 {
-
-string indent(std::string const& _input)
-{
-	if (_input.empty())
-		return _input;
-	return boost::replace_all_copy("    " + _input, "\n", "\n    ");
-}
-
+	string out;
+	print(out, _dialect, 0);
+	return out;
 }
 
-string Data::toString(Dialect const*) const
+void Data::print(string& _out, Dialect const*, size_t) const
 {
-	return "data \"" + name.str() + "\" hex\"" + util::toHex(data) + "\"";
+	_out += "data \"" + name.str() + "\" hex\"" + util::toHex(data) + "\"";
 }
 
-string Object::toString(Dialect const* _dialect) const
+void Object::print(string& _out, Dialect const* _dialect, size_t _indentation) const
 {
 	yulAssert(code, "No code");
-	string inner = "code " + (_dialect ? AsmPrinter{*_dialect} : AsmPrinter{})(*code);
-
+	auto newline = [&](size_t _level) {
+		_out.push_back('\n');
+		_out.append(4 * _level, ' ');
+	};
+
+	_out += "object \"" + name.str() + "\" {";
+	newline(_indentation + 1);
+	_out += "code ";
+	(_dialect ? AsmPrinter{*_dialect} : AsmPrinter{}).print(*code, _out, _indentation + 1);
 	for (auto const& obj: subObjects)
-		inner += "\n" + obj->toString(_dialect);
-
-	return "object \"" + name.str() + "\" {\n" + indent(inner) + "\n}";
+	{
+		newline(_indentation + 1);
+		obj->print(_out, _dialect, _indentation + 1);
+	}
+	newline(_indentation);
+	_out += "}";
 }
 
 set<YulString> Object::qualifiedDataNames() const
@@ -41,8 +41,12 @@ struct AsmAnalysisInfo;
 struct ObjectNode
 {
 	virtual ~ObjectNode() = default;
-	virtual std::string toString(Dialect const* _dialect) const = 0;
+	/// @returns a (parseable) string representation. Includes types if @a _dialect is set.
+	std::string toString(Dialect const* _dialect) const;
 	std::string toString() { return toString(nullptr); }
+	/// Appends the string representation to @a _out. Every line after the first is indented
+	/// by @a _indentation levels.
+	virtual void print(std::string& _out, Dialect const* _dialect, size_t _indentation) const = 0;
 
 	/// Name of the object.
 	/// Can be empty since .yul files can also just contain code, without explicitly placing it in an object.
@@ -55,7 +59,7 @@ struct ObjectNode
 struct Data: ObjectNode
 {
 	Data(YulString _name, bytes _data): data(std::move(_data)) { name = _name; }
-	std::string toString(Dialect const* _dialect) const override;
+	void print(std::string& _out, Dialect const* _dialect, size_t _indentation) const override;
 
 	bytes data;
 };
@@ -66,8 +70,7 @@ struct Data: ObjectNode
 struct Object: ObjectNode
 {
 public:
-	/// @returns a (parseable) string representation. Includes types if @a _yul is set.
-	std::string toString(Dialect const* _dialect) const override;
+	void print(std::string& _out, Dialect const* _dialect, size_t _indentation) const override;
 
 	/// @returns the set of names of data objects accessible from within the code of
 	/// this object, including the name of object itself
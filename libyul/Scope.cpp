@@ -26,21 +26,27 @@ using namespace solidity;
 using namespace solidity::yul;
 using namespace solidity::util;
 
-bool Scope::registerVariable(YulString _name, YulType const& _type)
+bool Scope::registerVariable(YulString _name, YulType const& _type, size_t _index)
 {
 	if (exists(_name))
 		return false;
 	Variable variable;
 	variable.type = _type;
+	variable.index = _index;
 	identifiers[_name] = variable;
 	return true;
 }
 
-bool Scope::registerFunction(YulString _name, std::vector<YulType> _arguments, std::vector<YulType> _returns)
+bool Scope::registerFunction(
+	YulString _name,
+	std::vector<YulType> _arguments,
+	std::vector<YulType> _returns,
+	size_t _index
+)
 {
 	if (exists(_name))
 		return false;
-	identifiers[_name] = Function{std::move(_arguments), std::move(_returns)};
+	identifiers[_name] = Function{std::move(_arguments), std::move(_returns), _index};
 	return true;
 }
 
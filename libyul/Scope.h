@@ -39,20 +39,28 @@ struct Scope
 {
 	using YulType = YulString;
 
-	struct Variable { YulType type; };
+	struct Variable
+	{
+		YulType type;
+		/// Number of the variable, counting all variables of the analysed code from zero.
+		size_t index = 0;
+	};
 	struct Function
 	{
 		std::vector<YulType> arguments;
 		std::vector<YulType> returns;
+		/// Number of the function, counting all functions of the analysed code from zero.
+		size_t index = 0;
 	};
 
 	using Identifier = std::variant<Variable, Function>;
 
-	bool registerVariable(YulString _name, YulType const& _type);
+	bool registerVariable(YulString _name, YulType const& _type, size_t _index);
 	bool registerFunction(
 		YulString _name,
 		std::vector<YulType> _arguments,
-		std::vector<YulType> _returns
+		std::vector<YulType> _returns,
+		size_t _index
 	);
 
 	/// Looks up the identifier in this or super scopes and returns a valid pointer if found
@@ -136,7 +136,7 @@ bool ScopeFiller::operator()(Block const& _block)
 
 bool ScopeFiller::registerVariable(TypedName const& _name, SourceLocation const& _location, Scope& _scope)
 {
-	if (!_scope.registerVariable(_name.name, _name.type))
+	if (!_scope.registerVariable(_name.name, _name.type, m_info.numberOfVariables))
 	{
 		//@TODO secondary location
 		m_errorReporter.declarationError(
@@ -146,6 +146,7 @@ bool ScopeFiller::registerVariable(TypedName const& _name, SourceLocation const&
 		);
 		return false;
 	}
+	++m_info.numberOfVariables;
 	return true;
 }
 
@@ -157,7 +158,7 @@ bool ScopeFiller::registerFunction(FunctionDefinition const& _funDef)
 	vector<Scope::YulType> returns;
 	for (auto const& returnVariable: _funDef.returnVariables)
 		returns.emplace_back(returnVariable.type);
-	if (!m_currentScope->registerFunction(_funDef.name, std::move(parameters), std::move(returns)))
+	if (!m_currentScope->registerFunction(_funDef.name, std::move(parameters), std::move(returns), m_info.numberOfFunctions))
 	{
 		//@TODO secondary location
 		m_errorReporter.declarationError(
@@ -167,6 +168,7 @@ bool ScopeFiller::registerFunction(FunctionDefinition const& _funDef)
 		);
 		return false;
 	}
+	++m_info.numberOfFunctions;
 	return true;
 }
 
@@ -27,12 +27,8 @@
 #include <libsolutil/CommonData.h>
 #include <libsolutil/FixedHash.h>
 
-#include <boost/algorithm/string.hpp>
-
 #include <algorithm>
-#include <iterator>
-#include <sstream>
-#include <vector>
+#include <string_view>
 
 using namespace std;
 using namespace solidity;
@@ -43,49 +39,57 @@ string solidity::yul::reindent(string const& _code)
 {
 	int constexpr indentationWidth = 4;
 
-	auto const static countBraces = [](string const& _s) noexcept -> int
+	auto const static countBraces = [](string_view _s) noexcept -> int
 	{
-		auto const i = _s.find("//");
-		auto const e = i == _s.npos ? end(_s) : next(begin(_s), static_cast<ptrdiff_t>(i));
-		auto const opening = count_if(begin(_s), e, [](auto ch) { return ch == '{' || ch == '('; });
-		auto const closing = count_if(begin(_s), e, [](auto ch) { return ch == '}' || ch == ')'; });
+		_s = _s.substr(0, _s.find("//"));
+		auto const opening = count_if(begin(_s), end(_s), [](auto ch) { return ch == '{' || ch == '('; });
+		auto const closing = count_if(begin(_s), end(_s), [](auto ch) { return ch == '}' || ch == ')'; });
 		return int(opening - closing);
 	};
+	auto const static trim = [](string_view _s) noexcept -> string_view
+	{
+		auto const isSpace = [](char ch) { return ch == ' ' || ch == '\t' || ch == '\r' || ch == '\v' || ch == '\f'; };
+		while (!_s.empty() && isSpace(_s.front()))
+			_s.remove_prefix(1);
+		while (!_s.empty() && isSpace(_s.back()))
+			_s.remove_suffix(1);
+		return _s;
+	};
 
-	vector<string> lines;
-	boost::split(lines, _code, boost::is_any_of("\n"));
-	for (string& line: lines)
-		boost::trim(line);
-
-	// Reduce multiple consecutive empty lines.
-	lines = fold(lines, vector<string>{}, [](auto&& _lines, auto&& _line) {
-		if (!(_line.empty() && !_lines.empty() && _lines.back().empty()))
-			_lines.emplace_back(std::move(_line));
-		return std::move(_lines);
-	});
-
-	stringstream out;
+	// The lines are processed one at a time and appended to the result, so that
+	// indenting large sources does not create a string for each of their lines.
+	string out;
+	out.reserve(_code.size());
 	int depth = 0;
-
-	for (string const& line: lines)
+	bool previousLineEmpty = false;
+	for (size_t lineStart = 0; lineStart <= _code.size();)
 	{
+		size_t lineEnd = min(_code.find('\n', lineStart), _code.size());
+		string_view const line = trim(string_view(_code).substr(lineStart, lineEnd - lineStart));
+		lineStart = lineEnd + 1;
+
+		// Reduce multiple consecutive empty lines.
+		if (line.empty() && previousLineEmpty)
+			continue;
+		previousLineEmpty = line.empty();
+
 		int const diff = countBraces(line);
 		if (diff < 0)
 			depth += diff;
 
 		if (!line.empty())
 		{
-			for (int i = 0; i < depth * indentationWidth; ++i)
-				out << ' ';
-			out << line;
+			if (depth > 0)
+				out.append(static_cast<size_t>(depth * indentationWidth), ' ');
+			out += line;
 		}
-		out << '\n';
+		out += '\n';
 
 		if (diff > 0)
 			depth += diff;
 	}
 
-	return out.str();
+	return out;
 }
 
 u256 solidity::yul::valueOfNumberLiteral(Literal const& _literal)
@@ -0,0 +1,171 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * String abstraction that avoids copies.
+ */
+
+#include <libyul/YulString.h>
+
+#include <libyul/Exceptions.h>
+
+#include <cstring>
+
+using namespace std;
+using namespace solidity::yul;
+
+YulStringRepository::YulStringRepository()
+{
+	clear();
+}
+
+YulStringRepository::~YulStringRepository()
+{
+	for (auto& segment: m_segments)
+		delete[] segment.load();
+}
+
+YulStringRepository::Handle YulStringRepository::stringToHandle(string_view _string)
+{
+	if (_string.empty())
+		return { 0, emptyHash() };
+
+	uint64_t const key = lookupHash(_string);
+	Shard& shard = m_shards[key % ShardCount];
+	lock_guard<mutex> lock(shard.mutex);
+
+	if (optional<Handle> handle = findInShard(shard, key, _string))
+		return *handle;
+
+	uint64_t const h = hash(_string);
+	size_t const id = m_nextID.fetch_add(1);
+	store(id, _string, h);
+	shard.ids.emplace(key, id);
+	m_memory.add(sizeof(decltype(shard.ids)::value_type) + 2 * sizeof(void*));
+
+	return Handle{id, h};
+}
+
+optional<YulStringRepository::Handle> YulStringRepository::findHandle(string_view _string)
+{
+	if (_string.empty())
+		return Handle{0, emptyHash()};
+
+	uint64_t const key = lookupHash(_string);
+	Shard& shard = m_shards[key % ShardCount];
+	lock_guard<mutex> lock(shard.mutex);
+	return findInShard(shard, key, _string);
+}
+
+optional<YulStringRepository::Handle> YulStringRepository::findInShard(
+	Shard const& _shard,
+	uint64_t _key,
+	string_view _string
+) const
+{
+	auto range = _shard.ids.equal_range(_key);
+	for (auto it = range.first; it != range.second; ++it)
+	{
+		// IDs in this shard were stored while holding its lock, so they can be read here.
+		Entry const& entry = m_segments[it->second / SegmentSize].load()[it->second % SegmentSize];
+		if (entry.value == _string)
+			return Handle{it->second, entry.hash};
+	}
+	return nullopt;
+}
+
+void YulStringRepository::reset()
+{
+	for (auto const& cb: resetCallbacks())
+		cb();
+	instance().clear();
+	resetCount().fetch_add(1, memory_order_release);
+}
+
+YulStringRepository::ResetCallback::ResetCallback(function<void()> _fun)
+{
+	static mutex callbackMutex;
+	lock_guard<mutex> lock(callbackMutex);
+	YulStringRepository::resetCallbacks().emplace_back(move(_fun));
+}
+
+void YulStringRepository::invalidID(size_t _id)
+{
+	yulAssert(false, "Invalid YulString ID " + to_string(_id) + ".");
+	// Unreachable, yulAssert throws.
+	abort();
+}
+
+uint64_t YulStringRepository::lookupHash(string_view _string)
+{
+	uint64_t constexpr multiplier = 0x9E3779B97F4A7C15u;
+	uint64_t h = _string.size() * multiplier;
+	char const* data = _string.data();
+	size_t remaining = _string.size();
+	for (; remaining >= 8; remaining -= 8, data += 8)
+	{
+		uint64_t word;
+		memcpy(&word, data, 8);
+		h = (h ^ word) * multiplier;
+		h ^= h >> 29;
+	}
+	if (remaining > 0)
+	{
+		uint64_t word = 0;
+		memcpy(&word, data, remaining);
+		h = (h ^ word) * multiplier;
+	}
+	h ^= h >> 32;
+	h *= multiplier;
+	h ^= h >> 29;
+	return h;
+}
+
+void YulStringRepository::store(size_t _id, string_view _string, uint64_t _hash)
+{
+	size_t const segmentIndex = _id / SegmentSize;
+	yulAssert(segmentIndex < MaxSegments, "Too many distinct YulStrings.");
+	Entry* segment = m_segments[segmentIndex].load(memory_order_acquire);
+	if (!segment)
+	{
+		// Threads adding strings in different shards can race for allocating the segment.
+		Entry* newSegment = new Entry[SegmentSize];
+		if (m_segments[segmentIndex].compare_exchange_strong(segment, newSegment, memory_order_acq_rel))
+		{
+			segment = newSegment;
+			m_memory.add(SegmentSize * sizeof(Entry));
+		}
+		else
+			delete[] newSegment;
+	}
+	Entry& entry = segment[_id % SegmentSize];
+	entry = Entry{string(_string), _hash};
+	// Short strings are stored inside the entry.
+	if (entry.value.capacity() > string().capacity())
+		m_memory.add(entry.value.capacity() + 1);
+}
+
+void YulStringRepository::clear()
+{
+	for (auto& segment: m_segments)
+		delete[] segment.exchange(nullptr);
+	for (auto& shard: m_shards)
+		shard.ids.clear();
+	m_memory.set(0);
+	m_nextID = 0;
+	store(m_nextID++, {}, emptyHash());
+}
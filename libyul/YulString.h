@@ -21,13 +21,19 @@
 
 #pragma once
 
-#include <boost/noncopyable.hpp>
+#include <libsolutil/MemoryAccounting.h>
 
-#include <unordered_map>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <functional>
 #include <memory>
-#include <vector>
+#include <mutex>
+#include <optional>
 #include <string>
-#include <functional>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
 
 namespace solidity::yul
 {
@@ -36,6 +42,13 @@ namespace solidity::yul
 /// Owns the string data for all YulStrings, which can be referenced by a Handle.
 /// A Handle consists of an ID (that depends on the insertion order of YulStrings and is potentially
 /// non-deterministic) and a deterministic string hash.
+///
+/// Strings are looked up by @a std::string_view, so that interning a string that is already
+/// stored does not need a @a std::string, e.g. for names taken directly from the source.
+///
+/// Strings can be added and looked up concurrently from multiple threads. Looking up the
+/// string for an ID does not lock, adding a string only locks one of several shards of the
+/// lookup table. The repository must not be reset while other threads use it.
 class YulStringRepository
 {
 public:
@@ -51,26 +64,27 @@ public:
 		return inst;
 	}
 
-	Handle stringToHandle(std::string const& _string)
+	Handle stringToHandle(std::string_view _string);
+	/// @returns the handle of @a _string if it is already stored in the repository,
+	/// without adding it otherwise.
+	std::optional<Handle> findHandle(std::string_view _string);
+	std::string const& idToString(size_t _id) const
 	{
-		if (_string.empty())
-			return { 0, emptyHash() };
-		std::uint64_t h = hash(_string);
-		auto range = m_hashToID.equal_range(h);
-		for (auto it = range.first; it != range.second; ++it)
-			if (*m_strings[it->second] == _string)
-				return Handle{it->second, h};
-		m_strings.emplace_back(std::make_shared<std::string>(_string));
-		size_t id = m_strings.size() - 1;
-		m_hashToID.emplace_hint(range.second, std::make_pair(h, id));
-
-		return Handle{id, h};
+		Entry const* segment = m_segments[_id / SegmentSize].load(std::memory_order_acquire);
+		if (!segment || _id >= m_nextID.load(std::memory_order_relaxed))
+			invalidID(_id);
+		return segment[_id % SegmentSize].value;
 	}
-	std::string const& idToString(size_t _id) const	{ return *m_strings.at(_id); }
 
-	static std::uint64_t hash(std::string const& v)
+	/// @returns the number of strings in the repository, including the empty string.
+	size_t size() const { return m_nextID.load(std::memory_order_relaxed); }
+
+	/// @returns the deterministic hash of @a v that is stored in the handles and determines
+	/// the order of YulStrings. Changing it would change the order of all containers keyed by
+	/// YulStrings and thus the output of the compiler.
+	static std::uint64_t hash(std::string_view v)
 	{
-		// FNV hash - can be replaced by a better one, e.g. xxhash64
+		// FNV hash
 		std::uint64_t hash = emptyHash();
 		for (char c: v)
 		{
@@ -85,37 +99,72 @@ public:
 	/// Use with care - there cannot be any dangling YulString references.
 	/// If references need to be cleared manually, register the callback via
 	/// resetCallback.
-	static void reset()
-	{
-		for (auto const& cb: resetCallbacks())
-			cb();
-		instance() = YulStringRepository{};
-	}
+	static void reset();
+	/// @returns a number that changes whenever the repository is reset. Users that keep
+	/// YulStrings across compilations can compare it to detect that they became invalid.
+	static size_t generation() { return resetCount().load(std::memory_order_acquire); }
 	/// Struct that registers a reset callback as a side-effect of its construction.
 	/// Useful as static local variable to register a reset callback once.
 	struct ResetCallback
 	{
-		ResetCallback(std::function<void()> _fun)
-		{
-			YulStringRepository::resetCallbacks().emplace_back(std::move(_fun));
-		}
+		ResetCallback(std::function<void()> _fun);
 	};
 
 private:
-	YulStringRepository() = default;
+	struct Entry
+	{
+		std::string value;
+		std::uint64_t hash = 0;
+	};
+	/// Part of the lookup table from strings to IDs, guarded by its own mutex.
+	struct Shard
+	{
+		std::mutex mutex;
+		/// Maps the lookup hash of a string to its ID.
+		std::unordered_multimap<std::uint64_t, size_t> ids;
+	};
+
+	/// The entries are stored in segments that are never moved, so that reading an entry
+	/// does not need a lock. Allows for MaxSegments * SegmentSize strings.
+	static constexpr size_t SegmentSize = 4096;
+	static constexpr size_t MaxSegments = 16384;
+	static constexpr size_t ShardCount = 16;
+
+	YulStringRepository();
+	~YulStringRepository();
 	YulStringRepository(YulStringRepository const&) = delete;
-	YulStringRepository(YulStringRepository&&) = default;
 	YulStringRepository& operator=(YulStringRepository const& _rhs) = delete;
-	YulStringRepository& operator=(YulStringRepository&& _rhs) = default;
+
+	[[noreturn]] static void invalidID(size_t _id);
+
+	/// @returns the handle of @a _string stored under @a _key in @a _shard.
+	/// Has to be called while holding the lock of the shard.
+	std::optional<Handle> findInShard(Shard const& _shard, std::uint64_t _key, std::string_view _string) const;
+
+	/// Hash used to find strings in the lookup table. Unlike @a hash, it processes eight
+	/// bytes at a time. It is only used for the lookup and never for ordering.
+	static std::uint64_t lookupHash(std::string_view _string);
+
+	/// Stores @a _string under the new ID @a _id, allocating a segment if needed.
+	void store(size_t _id, std::string_view _string, std::uint64_t _hash);
+	void clear();
 
 	static std::vector<std::function<void()>>& resetCallbacks()
 	{
 		static std::vector<std::function<void()>> callbacks;
 		return callbacks;
 	}
+	static std::atomic<size_t>& resetCount()
+	{
+		static std::atomic<size_t> count{0};
+		return count;
+	}
 
-	std::vector<std::shared_ptr<std::string>> m_strings = {std::make_shared<std::string>()};
-	std::unordered_multimap<std::uint64_t, size_t> m_hashToID = {{emptyHash(), 0}};
+	std::array<std::atomic<Entry*>, MaxSegments> m_segments{};
+	std::atomic<size_t> m_nextID{1};
+	std::array<Shard, ShardCount> m_shards;
+	/// Memory of the segments, the strings and the lookup tables.
+	util::MemoryAccount m_memory{util::MemorySubsystem::YulStrings};
 };
 
 /// Wrapper around handles into the YulString repository.
@@ -126,7 +175,7 @@ class YulString
 {
 public:
 	YulString() = default;
-	explicit YulString(std::string const& _s): m_handle(YulStringRepository::instance().stringToHandle(_s)) {}
+	explicit YulString(std::string_view _s): m_handle(YulStringRepository::instance().stringToHandle(_s)) {}
 	YulString(YulString const&) = default;
 	YulString(YulString&&) = default;
 	YulString& operator=(YulString const&) = default;
@@ -156,15 +205,29 @@ public:
 	}
 
 	uint64_t hash() const { return m_handle.hash; }
+	/// @returns the ID of the string in the repository. IDs are only stable until the
+	/// repository is reset and do not determine any order.
+	size_t id() const { return m_handle.id; }
+
+	/// @returns the YulString for @a _s if it is already stored in the repository.
+	/// Unlike the constructor, this does not add new strings to the repository.
+	static std::optional<YulString> find(std::string_view _s)
+	{
+		if (std::optional<YulStringRepository::Handle> handle = YulStringRepository::instance().findHandle(_s))
+			return YulString(*handle);
+		return std::nullopt;
+	}
 
 private:
+	explicit YulString(YulStringRepository::Handle _handle): m_handle(_handle) {}
+
 	/// Handle of the string. Assumes that the empty string has ID zero.
 	YulStringRepository::Handle m_handle{ 0, YulStringRepository::emptyHash() };
 };
 
 inline YulString operator "" _yulstring(char const* _string, std::size_t _size)
 {
-	return YulString(std::string(_string, _size));
+	return YulString(std::string_view(_string, _size));
 }
 
 }
@@ -101,6 +101,9 @@ public:
 	virtual void appendAssemblySize() = 0;
 	/// Creates a new sub-assembly, which can be referenced using dataSize and dataOffset.
 	virtual std::pair<std::shared_ptr<AbstractAssembly>, SubID> createSubAssembly(std::string _name = "") = 0;
+	/// Adds @a _assembly, which was created as a sub-assembly of another assembly of the same kind
+	/// and is not modified anymore, as a sub-assembly and @returns its ID.
+	virtual SubID appendSubAssembly(std::shared_ptr<AbstractAssembly> const& _assembly) = 0;
 	/// Appends the offset of the given sub-assembly or data.
 	virtual void appendDataOffset(std::vector<SubID> const& _subPath) = 0;
 	/// Appends the size of the given sub-assembly or data.
@@ -49,6 +49,12 @@ EthAssemblyAdapter::EthAssemblyAdapter(evmasm::Assembly& _assembly):
 {
 }
 
+EthAssemblyAdapter::EthAssemblyAdapter(shared_ptr<evmasm::Assembly> _assembly):
+	m_sharedAssembly(move(_assembly)),
+	m_assembly(*m_sharedAssembly)
+{
+}
+
 void EthAssemblyAdapter::setSourceLocation(SourceLocation const& _location)
 {
 	m_assembly.setSourceLocation(_location);
@@ -144,7 +150,14 @@ pair<shared_ptr<AbstractAssembly>, AbstractAssembly::SubID> EthAssemblyAdapter::
 {
 	shared_ptr<evmasm::Assembly> assembly{make_shared<evmasm::Assembly>(std::move(_name))};
 	auto sub = m_assembly.newSub(assembly);
-	return {make_shared<EthAssemblyAdapter>(*assembly), static_cast<size_t>(sub.data())};
+	return {make_shared<EthAssemblyAdapter>(move(assembly)), static_cast<size_t>(sub.data())};
+}
+
+AbstractAssembly::SubID EthAssemblyAdapter::appendSubAssembly(shared_ptr<AbstractAssembly> const& _assembly)
+{
+	auto const* adapter = dynamic_cast<EthAssemblyAdapter const*>(_assembly.get());
+	yulAssert(adapter && adapter->m_sharedAssembly, "Only sub-assemblies can be added to other assemblies.");
+	return static_cast<size_t>(m_assembly.newSub(adapter->m_sharedAssembly).data());
 }
 
 void EthAssemblyAdapter::appendDataOffset(vector<AbstractAssembly::SubID> const& _subPath)
@@ -40,6 +40,8 @@ class EthAssemblyAdapter: public AbstractAssembly
 {
 public:
 	explicit EthAssemblyAdapter(evmasm::Assembly& _assembly);
+	/// Creates an adapter that shares the ownership of @a _assembly.
+	explicit EthAssemblyAdapter(std::shared_ptr<evmasm::Assembly> _assembly);
 	void setSourceLocation(langutil::SourceLocation const& _location) override;
 	int stackHeight() const override;
 	void setStackHeight(int height) override;
@@ -58,6 +60,7 @@ public:
 	void appendReturnsub(int, int) override;
 	void appendAssemblySize() override;
 	std::pair<std::shared_ptr<AbstractAssembly>, SubID> createSubAssembly(std::string _name = {}) override;
+	SubID appendSubAssembly(std::shared_ptr<AbstractAssembly> const& _assembly) override;
 	void appendDataOffset(std::vector<SubID> const& _subPath) override;
 	void appendDataSize(std::vector<SubID> const& _subPath) override;
 	SubID appendData(bytes const& _data) override;
@@ -71,6 +74,9 @@ private:
 	static LabelID assemblyTagToIdentifier(evmasm::AssemblyItem const& _tag);
 	void appendJumpInstruction(evmasm::Instruction _instruction, JumpType _jumpType);
 
+	/// Set if the adapter shares the ownership of the assembly, which is needed to add it
+	/// to other assemblies.
+	std::shared_ptr<evmasm::Assembly> m_sharedAssembly;
 	evmasm::Assembly& m_assembly;
 	std::map<SubID, u256> m_dataHashBySubId;
 	size_t m_nextDataCounter = std::numeric_limits<size_t>::max() / 2;
@@ -202,6 +202,12 @@ pair<shared_ptr<AbstractAssembly>, AbstractAssembly::SubID> EVMAssembly::createS
 	return {};
 }
 
+AbstractAssembly::SubID EVMAssembly::appendSubAssembly(shared_ptr<AbstractAssembly> const&)
+{
+	yulAssert(false, "Sub assemblies not implemented.");
+	return {};
+}
+
 void EVMAssembly::appendDataOffset(vector<AbstractAssembly::SubID> const&)
 {
 	yulAssert(false, "Data not implemented.");
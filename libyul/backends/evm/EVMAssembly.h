@@ -80,6 +80,7 @@ public:
 	/// Append the assembled size as a constant.
 	void appendAssemblySize() override;
 	std::pair<std::shared_ptr<AbstractAssembly>, SubID> createSubAssembly(std::string _name = "") override;
+	SubID appendSubAssembly(std::shared_ptr<AbstractAssembly> const& _assembly) override;
 	void appendDataOffset(std::vector<SubID> const& _subPath) override;
 	void appendDataSize(std::vector<SubID> const& _subPath) override;
 	SubID appendData(bytes const& _data) override;
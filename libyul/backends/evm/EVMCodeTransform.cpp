@@ -88,7 +88,7 @@ void VariableReferenceCounter::increaseRefIfFound(YulString _variableName)
 	m_scope->lookup(_variableName, GenericVisitor{
 		[&](Scope::Variable const& _var)
 		{
-			++m_context.variableReferences[&_var];
+			++m_context.variableReferences.at(_var.index);
 		},
 		[](Scope::Function const&) { }
 	});
@@ -120,6 +120,10 @@ CodeTransform::CodeTransform(
 	{
 		// initialize
 		m_context = make_shared<Context>();
+		m_context->functionEntryIDs.resize(m_info.numberOfFunctions);
+		m_context->variableStackHeights.resize(m_info.numberOfVariables);
+		m_context->variableReferences.resize(m_info.numberOfVariables, 0);
+		m_context->variablesScheduledForDeletion.resize(m_info.numberOfVariables, false);
 		if (m_allowStackOpt)
 			VariableReferenceCounter{*m_context, m_info}(_block);
 	}
@@ -130,16 +134,16 @@ void CodeTransform::decreaseReference(YulString, Scope::Variable const& _var)
 	if (!m_allowStackOpt)
 		return;
 
-	unsigned& ref = m_context->variableReferences.at(&_var);
+	unsigned& ref = m_context->variableReferences.at(_var.index);
 	yulAssert(ref >= 1, "");
 	--ref;
 	if (ref == 0)
-		m_variablesScheduledForDeletion.insert(&_var);
+		m_context->variablesScheduledForDeletion[_var.index] = true;
 }
 
 bool CodeTransform::unreferenced(Scope::Variable const& _var) const
 {
-	return !m_context->variableReferences.count(&_var) || m_context->variableReferences[&_var] == 0;
+	return m_context->variableReferences.at(_var.index) == 0;
 }
 
 void CodeTransform::freeUnusedVariables(bool _popUnusedSlotsAtStackTop)
@@ -151,7 +155,7 @@ void CodeTransform::freeUnusedVariables(bool _popUnusedSlotsAtStackTop)
 		if (holds_alternative<Scope::Variable>(identifier.second))
 		{
 			Scope::Variable const& var = std::get<Scope::Variable>(identifier.second);
-			if (m_variablesScheduledForDeletion.count(&var))
+			if (m_context->variablesScheduledForDeletion.at(var.index))
 				deleteVariable(var);
 		}
 
@@ -166,11 +170,11 @@ void CodeTransform::freeUnusedVariables(bool _popUnusedSlotsAtStackTop)
 void CodeTransform::deleteVariable(Scope::Variable const& _var)
 {
 	yulAssert(m_allowStackOpt, "");
-	yulAssert(m_context->variableStackHeights.count(&_var) > 0, "");
-	m_unusedStackSlots.insert(static_cast<int>(m_context->variableStackHeights[&_var]));
-	m_context->variableStackHeights.erase(&_var);
-	m_context->variableReferences.erase(&_var);
-	m_variablesScheduledForDeletion.erase(&_var);
+	yulAssert(m_context->variableStackHeights.at(_var.index).has_value(), "");
+	m_unusedStackSlots.insert(static_cast<int>(*m_context->variableStackHeights[_var.index]));
+	m_context->variableStackHeights[_var.index].reset();
+	m_context->variableReferences[_var.index] = 0;
+	m_context->variablesScheduledForDeletion[_var.index] = false;
 }
 
 void CodeTransform::operator()(VariableDeclaration const& _varDecl)
@@ -200,7 +204,7 @@ void CodeTransform::operator()(VariableDeclaration const& _varDecl)
 		size_t varIndexReverse = numVariables - 1 - varIndex;
 		YulString varName = _varDecl.variables[varIndexReverse].name;
 		auto& var = std::get<Scope::Variable>(m_scope->identifiers.at(varName));
-		m_context->variableStackHeights[&var] = heightAtStart + varIndexReverse;
+		m_context->variableStackHeights.at(var.index) = heightAtStart + varIndexReverse;
 		if (!m_allowStackOpt)
 			continue;
 
@@ -208,11 +212,11 @@ void CodeTransform::operator()(VariableDeclaration const& _varDecl)
 		{
 			if (atTopOfStack)
 			{
-				m_context->variableStackHeights.erase(&var);
+				m_context->variableStackHeights[var.index].reset();
 				m_assembly.appendInstruction(evmasm::Instruction::POP);
 			}
 			else
-				m_variablesScheduledForDeletion.insert(&var);
+				m_context->variablesScheduledForDeletion[var.index] = true;
 		}
 		else if (m_unusedStackSlots.empty())
 			atTopOfStack = false;
@@ -220,7 +224,7 @@ void CodeTransform::operator()(VariableDeclaration const& _varDecl)
 		{
 			auto slot = static_cast<size_t>(*m_unusedStackSlots.begin());
 			m_unusedStackSlots.erase(m_unusedStackSlots.begin());
-			m_context->variableStackHeights[&var] = slot;
+			m_context->variableStackHeights[var.index] = slot;
 			if (size_t heightDiff = variableHeightDiff(var, varName, true))
 				m_assembly.appendInstruction(evmasm::swapInstruction(static_cast<unsigned>(heightDiff - 1)));
 			m_assembly.appendInstruction(evmasm::Instruction::POP);
@@ -413,7 +417,7 @@ void CodeTransform::operator()(FunctionDefinition const& _function)
 	for (auto const& v: _function.parameters | boost::adaptors::reversed)
 	{
 		auto& var = std::get<Scope::Variable>(varScope->identifiers.at(v.name));
-		m_context->variableStackHeights[&var] = height++;
+		m_context->variableStackHeights.at(var.index) = height++;
 	}
 
 	m_assembly.setSourceLocation(_function.location);
@@ -429,7 +433,7 @@ void CodeTransform::operator()(FunctionDefinition const& _function)
 	for (auto const& v: _function.returnVariables)
 	{
 		auto& var = std::get<Scope::Variable>(varScope->identifiers.at(v.name));
-		m_context->variableStackHeights[&var] = height++;
+		m_context->variableStackHeights.at(var.index) = height++;
 		// Preset stack slots for return variables to zero.
 		m_assembly.appendConstant(u256(0));
 	}
@@ -610,15 +614,13 @@ void CodeTransform::operator()(Block const& _block)
 
 AbstractAssembly::LabelID CodeTransform::functionEntryID(YulString _name, Scope::Function const& _function)
 {
-	if (!m_context->functionEntryIDs.count(&_function))
-	{
-		AbstractAssembly::LabelID id =
+	optional<AbstractAssembly::LabelID>& entryID = m_context->functionEntryIDs.at(_function.index);
+	if (!entryID)
+		entryID =
 			m_useNamedLabelsForFunctions ?
 			m_assembly.namedLabel(_name.str()) :
 			m_assembly.newLabelId();
-		m_context->functionEntryIDs[&_function] = id;
-	}
-	return m_context->functionEntryIDs[&_function];
+	return *entryID;
 }
 
 void CodeTransform::visitExpression(Expression const& _expression)
@@ -671,8 +673,8 @@ void CodeTransform::finalizeBlock(Block const& _block, int blockStartStackHeight
 			Scope::Variable const& var = std::get<Scope::Variable>(id.second);
 			if (m_allowStackOpt)
 			{
-				yulAssert(!m_context->variableStackHeights.count(&var), "");
-				yulAssert(!m_context->variableReferences.count(&var), "");
+				yulAssert(!m_context->variableStackHeights.at(var.index), "");
+				yulAssert(m_context->variableReferences.at(var.index) == 0, "");
 			}
 			else
 				m_assembly.appendInstruction(evmasm::Instruction::POP);
@@ -712,8 +714,8 @@ void CodeTransform::generateAssignment(Identifier const& _variableName)
 
 size_t CodeTransform::variableHeightDiff(Scope::Variable const& _var, YulString _varName, bool _forSwap)
 {
-	yulAssert(m_context->variableStackHeights.count(&_var), "");
-	size_t heightDiff = static_cast<size_t>(m_assembly.stackHeight()) - m_context->variableStackHeights[&_var];
+	yulAssert(m_context->variableStackHeights.at(_var.index), "");
+	size_t heightDiff = static_cast<size_t>(m_assembly.stackHeight()) - *m_context->variableStackHeights[_var.index];
 	yulAssert(heightDiff > (_forSwap ? 1 : 0), "Negative stack difference for variable.");
 	size_t limit = _forSwap ? 17 : 16;
 	if (heightDiff > limit)
@@ -60,9 +60,15 @@ struct StackTooDeepError: virtual YulException
 
 struct CodeTransformContext
 {
-	std::map<Scope::Function const*, AbstractAssembly::LabelID> functionEntryIDs;
-	std::map<Scope::Variable const*, size_t> variableStackHeights;
-	std::map<Scope::Variable const*, unsigned> variableReferences;
+	/// Indexed by Scope::Function::index.
+	std::vector<std::optional<AbstractAssembly::LabelID>> functionEntryIDs;
+	/// Indexed by Scope::Variable::index.
+	std::vector<std::optional<size_t>> variableStackHeights;
+	/// Indexed by Scope::Variable::index.
+	std::vector<unsigned> variableReferences;
+	/// Variables without further references whose stack slots can be reused once their scope
+	/// is visited again, indexed by Scope::Variable::index.
+	std::vector<bool> variablesScheduledForDeletion;
 
 	struct JumpInfo
 	{
@@ -236,7 +242,6 @@ private:
 	/// Set of variables whose reference counter has reached zero,
 	/// and whose stack slot will be marked as unused once we reach
 	/// statement level in the scope where the variable was defined.
-	std::set<Scope::Variable const*> m_variablesScheduledForDeletion;
 	std::set<int> m_unusedStackSlots;
 
 	std::vector<StackTooDeepError> m_stackErrors;
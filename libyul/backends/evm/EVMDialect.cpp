@@ -35,6 +35,9 @@
 
 #include <boost/range/adaptor/reversed.hpp>
 
+#include <limits>
+#include <mutex>
+
 using namespace std;
 using namespace solidity;
 using namespace solidity::yul;
@@ -289,13 +292,15 @@ EVMDialect::EVMDialect(langutil::EVMVersion _evmVersion, bool _objectAccess):
 	m_functions(createBuiltins(_evmVersion, _objectAccess)),
 	m_reserved(createReservedIdentifiers())
 {
+	indexBuiltins();
 }
 
 BuiltinFunctionForEVM const* EVMDialect::builtin(YulString _name) const
 {
-	auto it = m_functions.find(_name);
-	if (it != m_functions.end())
-		return &it->second;
+	// IDs below the first builtin wrap around and are out of range as well.
+	size_t const index = _name.id() - m_firstBuiltinID;
+	if (index < m_builtinsByID.size())
+		return m_builtinsByID[index];
 	else
 		return nullptr;
 }
@@ -309,6 +314,8 @@ EVMDialect const& EVMDialect::strictAssemblyForEVM(langutil::EVMVersion _version
 {
 	static map<langutil::EVMVersion, unique_ptr<EVMDialect const>> dialects;
 	static YulStringRepository::ResetCallback callback{[&] { dialects.clear(); }};
+	static mutex dialectsMutex;
+	lock_guard<mutex> lock(dialectsMutex);
 	if (!dialects[_version])
 		dialects[_version] = make_unique<EVMDialect>(_version, false);
 	return *dialects[_version];
@@ -318,11 +325,40 @@ EVMDialect const& EVMDialect::strictAssemblyForEVMObjects(langutil::EVMVersion _
 {
 	static map<langutil::EVMVersion, unique_ptr<EVMDialect const>> dialects;
 	static YulStringRepository::ResetCallback callback{[&] { dialects.clear(); }};
+	static mutex dialectsMutex;
+	lock_guard<mutex> lock(dialectsMutex);
 	if (!dialects[_version])
 		dialects[_version] = make_unique<EVMDialect>(_version, true);
 	return *dialects[_version];
 }
 
+void EVMDialect::indexBuiltins()
+{
+	m_builtinsByID.clear();
+	m_firstBuiltinID = 0;
+	if (!m_functions.empty())
+	{
+		size_t lastID = 0;
+		m_firstBuiltinID = numeric_limits<size_t>::max();
+		for (auto const& [name, function]: m_functions)
+		{
+			m_firstBuiltinID = min(m_firstBuiltinID, name.id());
+			lastID = max(lastID, name.id());
+		}
+		m_builtinsByID.resize(lastID - m_firstBuiltinID + 1, nullptr);
+		for (auto const& [name, function]: m_functions)
+			m_builtinsByID[name.id() - m_firstBuiltinID] = &function;
+	}
+
+	m_pop = builtin("pop"_yulstring);
+	m_eq = builtin("eq"_yulstring);
+	m_iszero = builtin("iszero"_yulstring);
+	m_mstore = builtin("mstore"_yulstring);
+	m_mload = builtin("mload"_yulstring);
+	m_sstore = builtin("sstore"_yulstring);
+	m_sload = builtin("sload"_yulstring);
+}
+
 SideEffects EVMDialect::sideEffectsOfInstruction(evmasm::Instruction _instruction)
 {
 	auto translate = [](evmasm::SemanticInformation::Effect _e) -> SideEffects::Effect
@@ -417,27 +453,31 @@ EVMDialectTyped::EVMDialectTyped(langutil::EVMVersion _evmVersion, bool _objectA
 	}));
 	m_functions["u256_to_bool"_yulstring].parameters = {"u256"_yulstring};
 	m_functions["u256_to_bool"_yulstring].returns = {"bool"_yulstring};
+
+	indexBuiltins();
+	m_not = builtin("not"_yulstring);
+	m_popbool = builtin("popbool"_yulstring);
 }
 
 BuiltinFunctionForEVM const* EVMDialectTyped::discardFunction(YulString _type) const
 {
-	if (_type == "bool"_yulstring)
-		return builtin("popbool"_yulstring);
+	if (_type == boolType)
+		return m_popbool;
 	else
 	{
 		yulAssert(_type == defaultType, "");
-		return builtin("pop"_yulstring);
+		return m_pop;
 	}
 }
 
 BuiltinFunctionForEVM const* EVMDialectTyped::equalityFunction(YulString _type) const
 {
-	if (_type == "bool"_yulstring)
+	if (_type == boolType)
 		return nullptr;
 	else
 	{
 		yulAssert(_type == defaultType, "");
-		return builtin("eq"_yulstring);
+		return m_eq;
 	}
 }
 
@@ -445,6 +485,8 @@ EVMDialectTyped const& EVMDialectTyped::instance(langutil::EVMVersion _version)
 {
 	static map<langutil::EVMVersion, unique_ptr<EVMDialectTyped const>> dialects;
 	static YulStringRepository::ResetCallback callback{[&] { dialects.clear(); }};
+	static mutex dialectsMutex;
+	lock_guard<mutex> lock(dialectsMutex);
 	if (!dialects[_version])
 		dialects[_version] = make_unique<EVMDialectTyped>(_version, true);
 	return *dialects[_version];
@@ -29,6 +29,7 @@
 
 #include <map>
 #include <set>
+#include <vector>
 
 namespace solidity::yul
 {
@@ -74,13 +75,13 @@ struct EVMDialect: public Dialect
 	/// @returns true if the identifier is reserved. This includes the builtins too.
 	bool reservedIdentifier(YulString _name) const override;
 
-	BuiltinFunctionForEVM const* discardFunction(YulString /*_type*/) const override { return builtin("pop"_yulstring); }
-	BuiltinFunctionForEVM const* equalityFunction(YulString /*_type*/) const override { return builtin("eq"_yulstring); }
-	BuiltinFunctionForEVM const* booleanNegationFunction() const override { return builtin("iszero"_yulstring); }
-	BuiltinFunctionForEVM const* memoryStoreFunction(YulString /*_type*/) const override { return builtin("mstore"_yulstring); }
-	BuiltinFunctionForEVM const* memoryLoadFunction(YulString /*_type*/) const override { return builtin("mload"_yulstring); }
-	BuiltinFunctionForEVM const* storageStoreFunction(YulString /*_type*/) const override { return builtin("sstore"_yulstring); }
-	BuiltinFunctionForEVM const* storageLoadFunction(YulString /*_type*/) const override { return builtin("sload"_yulstring); }
+	BuiltinFunctionForEVM const* discardFunction(YulString /*_type*/) const override { return m_pop; }
+	BuiltinFunctionForEVM const* equalityFunction(YulString /*_type*/) const override { return m_eq; }
+	BuiltinFunctionForEVM const* booleanNegationFunction() const override { return m_iszero; }
+	BuiltinFunctionForEVM const* memoryStoreFunction(YulString /*_type*/) const override { return m_mstore; }
+	BuiltinFunctionForEVM const* memoryLoadFunction(YulString /*_type*/) const override { return m_mload; }
+	BuiltinFunctionForEVM const* storageStoreFunction(YulString /*_type*/) const override { return m_sstore; }
+	BuiltinFunctionForEVM const* storageLoadFunction(YulString /*_type*/) const override { return m_sload; }
 
 	static EVMDialect const& strictAssemblyForEVM(langutil::EVMVersion _version);
 	static EVMDialect const& strictAssemblyForEVMObjects(langutil::EVMVersion _version);
@@ -92,10 +93,25 @@ struct EVMDialect: public Dialect
 	static SideEffects sideEffectsOfInstruction(evmasm::Instruction _instruction);
 
 protected:
+	/// Builds the lookup table of the builtin functions. Has to be called again whenever
+	/// @a m_functions changes.
+	void indexBuiltins();
+
 	bool const m_objectAccess;
 	langutil::EVMVersion const m_evmVersion;
 	std::map<YulString, BuiltinFunctionForEVM> m_functions;
 	std::set<YulString> m_reserved;
+	/// Builtin functions indexed by the ID of their name minus @a m_firstBuiltinID.
+	/// The dialects are discarded when the YulString repository is reset, so the IDs stay valid.
+	std::vector<BuiltinFunctionForEVM const*> m_builtinsByID;
+	size_t m_firstBuiltinID = 0;
+	BuiltinFunctionForEVM const* m_pop = nullptr;
+	BuiltinFunctionForEVM const* m_eq = nullptr;
+	BuiltinFunctionForEVM const* m_iszero = nullptr;
+	BuiltinFunctionForEVM const* m_mstore = nullptr;
+	BuiltinFunctionForEVM const* m_mload = nullptr;
+	BuiltinFunctionForEVM const* m_sstore = nullptr;
+	BuiltinFunctionForEVM const* m_sload = nullptr;
 };
 
 /**
@@ -115,9 +131,13 @@ struct EVMDialectTyped: public EVMDialect
 
 	BuiltinFunctionForEVM const* discardFunction(YulString _type) const override;
 	BuiltinFunctionForEVM const* equalityFunction(YulString _type) const override;
-	BuiltinFunctionForEVM const* booleanNegationFunction() const override { return builtin("not"_yulstring); }
+	BuiltinFunctionForEVM const* booleanNegationFunction() const override { return m_not; }
 
 	static EVMDialectTyped const& instance(langutil::EVMVersion _version);
+
+private:
+	BuiltinFunctionForEVM const* m_not = nullptr;
+	BuiltinFunctionForEVM const* m_popbool = nullptr;
 };
 
 }
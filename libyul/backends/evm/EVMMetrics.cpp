@@ -37,14 +37,16 @@ using namespace solidity;
 using namespace solidity::yul;
 using namespace solidity::util;
 
-size_t GasMeter::costs(Expression const& _expression) const
+size_t GasMeter::costs(Expression const& _expression, size_t _evaluations) const
 {
-	return combineCosts(GasMeterVisitor::costs(_expression, m_dialect, m_isCreation));
+	auto [runGas, dataGas] = GasMeterVisitor::costs(_expression, m_dialect, m_isCreation);
+	return combineCosts({runGas * _evaluations, dataGas});
 }
 
-size_t GasMeter::instructionCosts(evmasm::Instruction _instruction) const
+size_t GasMeter::instructionCosts(evmasm::Instruction _instruction, size_t _evaluations) const
 {
-	return combineCosts(GasMeterVisitor::instructionCosts(_instruction, m_dialect, m_isCreation));
+	auto [runGas, dataGas] = GasMeterVisitor::instructionCosts(_instruction, m_dialect, m_isCreation);
+	return combineCosts({runGas * _evaluations, dataGas});
 }
 
 size_t GasMeter::combineCosts(std::pair<size_t, size_t> _costs) const
@@ -46,11 +46,12 @@ public:
 		m_runs(_runs)
 	{}
 
-	/// @returns the full combined costs of deploying and evaluating the expression.
-	size_t costs(Expression const& _expression) const;
-	/// @returns the combined costs of deploying and running the instruction, not including
-	/// the costs for its arguments.
-	size_t instructionCosts(evmasm::Instruction _instruction) const;
+	/// @returns the full combined costs of deploying the expression and evaluating it
+	/// @a _evaluations times per run.
+	size_t costs(Expression const& _expression, size_t _evaluations = 1) const;
+	/// @returns the combined costs of deploying the instruction and running it @a _evaluations
+	/// times per run, not including the costs for its arguments.
+	size_t instructionCosts(evmasm::Instruction _instruction, size_t _evaluations = 1) const;
 
 private:
 	size_t combineCosts(std::pair<size_t, size_t> _costs) const;
@@ -0,0 +1,45 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Cache of the assemblies compiled from Yul objects.
+ */
+
+#include <libyul/backends/evm/EVMObjectCache.h>
+
+#include <libsolutil/Keccak256.h>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::util;
+using namespace solidity::yul;
+
+optional<EVMObjectCache::Entry> EVMObjectCache::load(string const& _input)
+{
+	h256 const key = keccak256(_input);
+	lock_guard<mutex> lock(m_mutex);
+	if (auto it = m_entries.find(key); it != m_entries.end())
+		return it->second;
+	return nullopt;
+}
+
+void EVMObjectCache::store(string const& _input, Entry _entry)
+{
+	h256 const key = keccak256(_input);
+	lock_guard<mutex> lock(m_mutex);
+	m_entries.emplace(key, move(_entry));
+}
@@ -0,0 +1,73 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Cache of the assemblies compiled from Yul objects.
+ */
+
+#pragma once
+
+#include <libsolutil/FixedHash.h>
+
+#include <boost/noncopyable.hpp>
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace solidity::yul
+{
+
+class AbstractAssembly;
+
+/**
+ * Maps the code of a Yul object, including its sub-objects, to the assembly compiled from it,
+ * so that an object that is a sub-object of several objects is compiled only once. This is
+ * common for the object of a contract that is created by several contracts.
+ *
+ * Only finished assemblies, which have been optimised and assembled, are stored and they are
+ * only read afterwards, so they can be shared between compilations running concurrently.
+ * All compilations sharing a cache have to use the same settings for the optimiser of the
+ * assemblies.
+ */
+class EVMObjectCache: boost::noncopyable
+{
+public:
+	struct Entry
+	{
+		std::shared_ptr<AbstractAssembly> assembly;
+		/// IDs of the sub-assemblies of all sub-objects of the object in the order in which
+		/// the sub-objects are printed.
+		std::vector<size_t> subIDs;
+	};
+
+	/// @returns the entry stored for @a _input, which has to contain the code of the object
+	/// and everything else the compiled assembly depends on, or nullopt if there is none.
+	std::optional<Entry> load(std::string const& _input);
+
+	/// Stores @a _entry for @a _input unless there already is an entry.
+	void store(std::string const& _input, Entry _entry);
+
+private:
+	std::mutex m_mutex;
+	std::map<util::h256, Entry> m_entries;
+};
+
+}
@@ -28,28 +28,91 @@
 #include <libyul/Exceptions.h>
 #include <libevmasm/Assembly.h>
 
+#include <libsolutil/CompilationStatistics.h>
+#include <libsolutil/ThreadPool.h>
+
 using namespace solidity::yul;
 using namespace std;
 
-void EVMObjectCompiler::compile(Object& _object, AbstractAssembly& _assembly, EVMDialect const& _dialect, bool _evm15, bool _optimize)
+namespace
+{
+
+/// Appends the IDs of the sub-assemblies of all sub-objects of @a _object to @a _subIDs.
+void collectSubIDs(Object const& _object, vector<size_t>& _subIDs)
+{
+	for (auto const& subNode: _object.subObjects)
+		if (auto const* subObject = dynamic_cast<Object const*>(subNode.get()))
+		{
+			_subIDs.push_back(subObject->subId);
+			collectSubIDs(*subObject, _subIDs);
+		}
+}
+
+/// Sets the IDs of the sub-assemblies of all sub-objects of @a _object, starting at @a _index
+/// in @a _subIDs, in the order of collectSubIDs.
+void assignSubIDs(Object& _object, vector<size_t> const& _subIDs, size_t& _index)
+{
+	for (auto const& subNode: _object.subObjects)
+		if (auto* subObject = dynamic_cast<Object*>(subNode.get()))
+		{
+			subObject->subId = _subIDs.at(_index++);
+			assignSubIDs(*subObject, _subIDs, _index);
+		}
+}
+
+}
+
+EVMObjectCompiler::NewCacheEntries EVMObjectCompiler::compile(
+	Object& _object,
+	AbstractAssembly& _assembly,
+	EVMDialect const& _dialect,
+	bool _evm15,
+	bool _optimize,
+	size_t _parallelism,
+	EVMObjectCache* _cache
+)
 {
-	EVMObjectCompiler compiler(_assembly, _dialect, _evm15);
-	compiler.run(_object, _optimize);
+	EVMObjectCompiler compiler(_assembly, _dialect, _evm15, _parallelism, _cache);
+	return compiler.run(_object, _optimize);
 }
 
-void EVMObjectCompiler::run(Object& _object, bool _optimize)
+EVMObjectCompiler::NewCacheEntries EVMObjectCompiler::run(Object& _object, bool _optimize)
 {
 	BuiltinContext context;
 	context.currentObject = &_object;
 
+	struct SubAssembly
+	{
+		Object* object = nullptr;
+		shared_ptr<AbstractAssembly> assembly;
+		string cacheInput;
+	};
 
+	// The sub-assemblies are created in order, so that their IDs do not depend on the scheduling.
+	// The code of this object only refers to them by ID, which means that they can be compiled
+	// independently of each other before the code of this object is generated.
+	vector<SubAssembly> subAssemblies;
 	for (auto const& subNode: _object.subObjects)
 		if (auto* subObject = dynamic_cast<Object*>(subNode.get()))
 		{
+			string cacheInput;
+			if (m_cache)
+			{
+				cacheInput = this->cacheInput(*subObject, _optimize);
+				if (optional<EVMObjectCache::Entry> entry = m_cache->load(cacheInput))
+				{
+					AbstractAssembly::SubID subID = m_assembly.appendSubAssembly(entry->assembly);
+					context.subIDs[subObject->name] = subID;
+					subObject->subId = subID;
+					size_t index = 0;
+					assignSubIDs(*subObject, entry->subIDs, index);
+					continue;
+				}
+			}
 			auto subAssemblyAndID = m_assembly.createSubAssembly(subObject->name.str());
 			context.subIDs[subObject->name] = subAssemblyAndID.second;
 			subObject->subId = subAssemblyAndID.second;
-			compile(*subObject, *subAssemblyAndID.first, m_dialect, m_evm15, _optimize);
+			subAssemblies.push_back({subObject, move(subAssemblyAndID.first), move(cacheInput)});
 		}
 		else
 		{
@@ -57,6 +120,43 @@ void EVMObjectCompiler::run(Object& _object, bool _optimize)
 			context.subIDs[data.name] = m_assembly.appendData(data.data);
 		}
 
+	vector<NewCacheEntries> subCacheEntries(subAssemblies.size());
+	size_t const threads = min(util::ThreadPool::effectiveThreads(m_parallelism), subAssemblies.size());
+	if (threads > 1)
+	{
+		// The threads are only used at this level to avoid oversubscription.
+		util::CompilationStatistics* statistics = util::CompilationStatistics::current();
+		// Statistics are collected per thread, so each sub-object records into its own object.
+		vector<util::CompilationStatistics> subStatistics(statistics ? subAssemblies.size() : 0);
+		util::ThreadPool pool(threads);
+		for (size_t i = 0; i < subAssemblies.size(); ++i)
+			pool.submit([&, i]() {
+				util::CompilationStatistics::Scope scope(statistics ? &subStatistics[i] : nullptr);
+				SubAssembly const& sub = subAssemblies[i];
+				subCacheEntries[i] = compile(*sub.object, *sub.assembly, m_dialect, m_evm15, _optimize, 1, m_cache);
+			});
+		pool.wait();
+		for (util::CompilationStatistics const& subStatistic: subStatistics)
+			statistics->merge(subStatistic);
+	}
+	else
+		for (size_t i = 0; i < subAssemblies.size(); ++i)
+		{
+			SubAssembly const& sub = subAssemblies[i];
+			subCacheEntries[i] = compile(*sub.object, *sub.assembly, m_dialect, m_evm15, _optimize, m_parallelism, m_cache);
+		}
+
+	NewCacheEntries newCacheEntries;
+	if (m_cache)
+		for (size_t i = 0; i < subAssemblies.size(); ++i)
+		{
+			SubAssembly& sub = subAssemblies[i];
+			move(subCacheEntries[i].begin(), subCacheEntries[i].end(), back_inserter(newCacheEntries));
+			EVMObjectCache::Entry entry{sub.assembly, {}};
+			collectSubIDs(*sub.object, entry.subIDs);
+			newCacheEntries.emplace_back(move(sub.cacheInput), move(entry));
+		}
+
 	yulAssert(_object.analysisInfo, "No analysis info.");
 	yulAssert(_object.code, "No code.");
 	// We do not catch and re-throw the stack too deep exception here because it is a YulException,
@@ -65,4 +165,16 @@ void EVMObjectCompiler::run(Object& _object, bool _optimize)
 	transform(*_object.code);
 	if (!transform.stackErrors().empty())
 		BOOST_THROW_EXCEPTION(transform.stackErrors().front());
+
+	return newCacheEntries;
+}
+
+string EVMObjectCompiler::cacheInput(Object const& _object, bool _optimize) const
+{
+	string input =
+		m_dialect.evmVersion().name() + " " +
+		(m_evm15 ? "evm15 " : "") +
+		(_optimize ? "optimize" : "") + "\n";
+	_object.print(input, &m_dialect, 0);
+	return input;
 }
@@ -21,6 +21,13 @@
 
 #pragma once
 
+#include <libyul/backends/evm/EVMObjectCache.h>
+
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <vector>
+
 namespace solidity::yul
 {
 struct Object;
@@ -30,17 +37,45 @@ struct EVMDialect;
 class EVMObjectCompiler
 {
 public:
-	static void compile(Object& _object, AbstractAssembly& _assembly, EVMDialect const& _dialect, bool _evm15, bool _optimize);
+	/// Assemblies compiled for a cache, together with their input for the cache.
+	using NewCacheEntries = std::vector<std::pair<std::string, EVMObjectCache::Entry>>;
+
+	/// Compiles @a _object and its sub-objects into @a _assembly. Sub-objects are compiled
+	/// concurrently on up to @a _parallelism threads (zero meaning one per hardware thread),
+	/// the result does not depend on that number.
+	/// Sub-objects whose assembly is found in @a _cache are not compiled again, the assembly
+	/// from the cache is added instead.
+	/// @returns the assemblies compiled for the sub-objects if @a _cache is given. They can be
+	/// stored in the cache once they have been optimised and assembled as part of @a _assembly.
+	static NewCacheEntries compile(
+		Object& _object,
+		AbstractAssembly& _assembly,
+		EVMDialect const& _dialect,
+		bool _evm15,
+		bool _optimize,
+		size_t _parallelism = 1,
+		EVMObjectCache* _cache = nullptr
+	);
 private:
-	EVMObjectCompiler(AbstractAssembly& _assembly, EVMDialect const& _dialect, bool _evm15):
-		m_assembly(_assembly), m_dialect(_dialect), m_evm15(_evm15)
+	EVMObjectCompiler(
+		AbstractAssembly& _assembly,
+		EVMDialect const& _dialect,
+		bool _evm15,
+		size_t _parallelism,
+		EVMObjectCache* _cache
+	):
+		m_assembly(_assembly), m_dialect(_dialect), m_evm15(_evm15), m_parallelism(_parallelism), m_cache(_cache)
 	{}
 
-	void run(Object& _object, bool _optimize);
+	NewCacheEntries run(Object& _object, bool _optimize);
+	/// @returns everything the assembly compiled from @a _object depends on.
+	std::string cacheInput(Object const& _object, bool _optimize) const;
 
 	AbstractAssembly& m_assembly;
 	EVMDialect const& m_dialect;
 	bool m_evm15 = false;
+	size_t m_parallelism = 1;
+	EVMObjectCache* m_cache = nullptr;
 };
 
 }
@@ -133,6 +133,12 @@ pair<shared_ptr<AbstractAssembly>, AbstractAssembly::SubID> NoOutputAssembly::cr
 	return {};
 }
 
+AbstractAssembly::SubID NoOutputAssembly::appendSubAssembly(shared_ptr<AbstractAssembly> const&)
+{
+	yulAssert(false, "Sub assemblies not implemented.");
+	return {};
+}
+
 void NoOutputAssembly::appendDataOffset(std::vector<AbstractAssembly::SubID> const&)
 {
 	appendInstruction(evmasm::Instruction::PUSH1);
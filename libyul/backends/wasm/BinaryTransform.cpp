@@ -68,11 +68,6 @@ enum class Section: uint8_t
 	CODE = 0x0a
 };
 
-bytes toBytes(Section _s)
-{
-	return toBytes(uint8_t(_s));
-}
-
 enum class ValueType: uint8_t
 {
 	Void = 0x40,
@@ -237,15 +232,17 @@ static map<string, uint8_t> const builtins = {
 	{"i64.extend_i32_u", 0xad},
 };
 
-bytes prefixSize(bytes _data)
+/// @returns the size of a section with contents of size @a _size, including its header.
+size_t sectionSize(size_t _size)
 {
-	size_t size = _data.size();
-	return lebEncode(size) + move(_data);
+	return 1 + lebEncodedSize(_size) + _size;
 }
 
-bytes makeSection(Section _section, bytes _data)
+/// Appends the header of a section with contents of size @a _size to @a _output.
+void appendSectionHeader(bytes& _output, Section _section, size_t _size)
 {
-	return toBytes(_section) + prefixSize(move(_data));
+	_output.push_back(uint8_t(_section));
+	lebEncodeTo(_output, _size);
 }
 
 /// This is a kind of run-length-encoding of local types.
@@ -291,35 +288,38 @@ bytes BinaryTransform::run(Module const& _module)
 	yulAssert(functionTypes.size() == functionIDs.size(), "");
 	yulAssert(functionTypes.size() >= types.size(), "");
 
-	bytes ret{0, 'a', 's', 'm'};
-	// version
-	ret += bytes{1, 0, 0, 0};
-	ret += typeSection(types);
-	ret += importSection(_module.imports, functionTypes);
-	ret += functionSection(_module.functions, functionTypes);
-	ret += memorySection();
-	ret += globalSection(_module.globals);
-	ret += exportSection(functionIDs);
-
+	// The contents of all sections are encoded first, so that the module can be written
+	// into a buffer of the final size at once.
+	vector<pair<Section, bytes>> sections;
+	sections.emplace_back(Section::TYPE, typeSection(types));
+	sections.emplace_back(Section::IMPORT, importSection(_module.imports, functionTypes));
+	sections.emplace_back(Section::FUNCTION, functionSection(_module.functions, functionTypes));
+	sections.emplace_back(Section::MEMORY, memorySection());
+	sections.emplace_back(Section::GLOBAL, globalSection(_module.globals));
+	sections.emplace_back(Section::EXPORT, exportSection(functionIDs));
+
+	// Magic and version.
+	size_t size = 8;
+	for (auto const& section: sections)
+		size += sectionSize(section.second.size());
+
+	// The custom sections consist of the encoded name and the data.
+	vector<bytes> subModules;
+	vector<pair<bytes, bytes const*>> customSections;
 	map<string, pair<size_t, size_t>> subModulePosAndSize;
+	auto addCustomSection = [&](string const& _name, bytes const& _data) {
+		bytes name = encodeName(_name);
+		size += sectionSize(name.size() + _data.size());
+		// Skip all the previous sections and the header and name of this custom section.
+		subModulePosAndSize[_name] = {size - _data.size(), _data.size()};
+		customSections.emplace_back(move(name), &_data);
+	};
+	subModules.reserve(_module.subModules.size());
 	for (auto const& [name, module]: _module.subModules)
-	{
 		// TODO should we prefix and / or shorten the name?
-		bytes data = BinaryTransform::run(module);
-		size_t const length = data.size();
-		ret += customSection(name, move(data));
-		// Skip all the previous sections and the size field of this current custom section.
-		size_t const offset = ret.size() - length;
-		subModulePosAndSize[name] = {offset, length};
-	}
+		addCustomSection(name, subModules.emplace_back(BinaryTransform::run(module)));
 	for (auto const& [name, data]: _module.customSections)
-	{
-		size_t const length = data.size();
-		ret += customSection(name, data);
-		// Skip all the previous sections and the size field of this current custom section.
-		size_t const offset = ret.size() - length;
-		subModulePosAndSize[name] = {offset, length};
-	}
+		addCustomSection(name, data);
 
 	BinaryTransform bt(
 		move(globalIDs),
@@ -327,37 +327,72 @@ bytes BinaryTransform::run(Module const& _module)
 		move(functionTypes),
 		move(subModulePosAndSize)
 	);
+	vector<bytes> const functionBodies = bt.codeSection(_module.functions);
+	size_t codeSize = lebEncodedSize(functionBodies.size());
+	for (bytes const& body: functionBodies)
+		codeSize += lebEncodedSize(body.size()) + body.size();
+	size += sectionSize(codeSize);
 
-	ret += bt.codeSection(_module.functions);
+	bytes ret{0, 'a', 's', 'm'};
+	ret.reserve(size);
+	// version
+	ret += bytes{1, 0, 0, 0};
+	for (auto const& [section, contents]: sections)
+	{
+		appendSectionHeader(ret, section, contents.size());
+		ret += contents;
+	}
+	for (auto const& [name, data]: customSections)
+	{
+		appendSectionHeader(ret, Section::CUSTOM, name.size() + data->size());
+		ret += name;
+		ret += *data;
+	}
+	appendSectionHeader(ret, Section::CODE, codeSize);
+	lebEncodeTo(ret, functionBodies.size());
+	for (bytes const& body: functionBodies)
+	{
+		lebEncodeTo(ret, body.size());
+		ret += body;
+	}
+	yulAssert(ret.size() == size, "");
 	return ret;
 }
 
-bytes BinaryTransform::operator()(Literal const& _literal)
+void BinaryTransform::operator()(Literal const& _literal)
 {
-	return std::visit(GenericVisitor{
-		[&](uint32_t _value) -> bytes { return toBytes(Opcode::I32Const) + lebEncodeSigned(static_cast<int32_t>(_value)); },
-		[&](uint64_t _value) -> bytes { return toBytes(Opcode::I64Const) + lebEncodeSigned(static_cast<int64_t>(_value)); },
+	std::visit(GenericVisitor{
+		[&](uint32_t _value) {
+			m_code.push_back(uint8_t(Opcode::I32Const));
+			lebEncodeSignedTo(m_code, static_cast<int32_t>(_value));
+		},
+		[&](uint64_t _value) {
+			m_code.push_back(uint8_t(Opcode::I64Const));
+			lebEncodeSignedTo(m_code, static_cast<int64_t>(_value));
+		},
 	}, _literal.value);
 }
 
-bytes BinaryTransform::operator()(StringLiteral const&)
+void BinaryTransform::operator()(StringLiteral const&)
 {
 	// StringLiteral is a special AST element used for certain builtins.
 	// It is not mapped to actual WebAssembly, and should be processed in visit(BuiltinCall).
 	yulAssert(false, "");
 }
 
-bytes BinaryTransform::operator()(LocalVariable const& _variable)
+void BinaryTransform::operator()(LocalVariable const& _variable)
 {
-	return toBytes(Opcode::LocalGet) + lebEncode(m_locals.at(_variable.name));
+	m_code.push_back(uint8_t(Opcode::LocalGet));
+	lebEncodeTo(m_code, m_locals.at(_variable.name));
 }
 
-bytes BinaryTransform::operator()(GlobalVariable const& _variable)
+void BinaryTransform::operator()(GlobalVariable const& _variable)
 {
-	return toBytes(Opcode::GlobalGet) + lebEncode(m_globalIDs.at(_variable.name));
+	m_code.push_back(uint8_t(Opcode::GlobalGet));
+	lebEncodeTo(m_code, m_globalIDs.at(_variable.name));
 }
 
-bytes BinaryTransform::operator()(BuiltinCall const& _call)
+void BinaryTransform::operator()(BuiltinCall const& _call)
 {
 	// We need to avoid visiting the arguments of `dataoffset` and `datasize` because
 	// they are references to object names that should not end up in the code.
@@ -366,20 +401,24 @@ bytes BinaryTransform::operator()(BuiltinCall const& _call)
 		string name = get<StringLiteral>(_call.arguments.at(0)).value;
 		// TODO: support the case where name refers to the current object
 		yulAssert(m_subModulePosAndSize.count(name), "");
-		return toBytes(Opcode::I64Const) + lebEncodeSigned(static_cast<int64_t>(m_subModulePosAndSize.at(name).first));
+		m_code.push_back(uint8_t(Opcode::I64Const));
+		lebEncodeSignedTo(m_code, static_cast<int64_t>(m_subModulePosAndSize.at(name).first));
+		return;
 	}
 	else if (_call.functionName == "datasize")
 	{
 		string name = get<StringLiteral>(_call.arguments.at(0)).value;
 		// TODO: support the case where name refers to the current object
 		yulAssert(m_subModulePosAndSize.count(name), "");
-		return toBytes(Opcode::I64Const) + lebEncodeSigned(static_cast<int64_t>(m_subModulePosAndSize.at(name).second));
+		m_code.push_back(uint8_t(Opcode::I64Const));
+		lebEncodeSignedTo(m_code, static_cast<int64_t>(m_subModulePosAndSize.at(name).second));
+		return;
 	}
 
 	yulAssert(builtins.count(_call.functionName), "Builtin " + _call.functionName + " not found");
 	// NOTE: the dialect ensures we have the right amount of arguments
-	bytes args = visit(_call.arguments);
-	bytes ret = move(args) + toBytes(builtins.at(_call.functionName));
+	visit(_call.arguments);
+	m_code.push_back(builtins.at(_call.functionName));
 	if (
 		_call.functionName.find(".load") != string::npos ||
 		_call.functionName.find(".store") != string::npos
@@ -388,103 +427,99 @@ bytes BinaryTransform::operator()(BuiltinCall const& _call)
 		// into account to generate more efficient code but if the hint is invalid it could
 		// actually be more expensive. It's best to hint at 1-byte alignment if we don't plan
 		// to control the memory layout accordingly.
-		ret += bytes{{0, 0}}; // 2^0 == 1-byte alignment
-
-	return ret;
+		m_code += bytes{{0, 0}}; // 2^0 == 1-byte alignment
 }
 
-bytes BinaryTransform::operator()(FunctionCall const& _call)
+void BinaryTransform::operator()(FunctionCall const& _call)
 {
-	return visit(_call.arguments) + toBytes(Opcode::Call) + lebEncode(m_functionIDs.at(_call.functionName));
+	visit(_call.arguments);
+	m_code.push_back(uint8_t(Opcode::Call));
+	lebEncodeTo(m_code, m_functionIDs.at(_call.functionName));
 }
 
-bytes BinaryTransform::operator()(LocalAssignment const& _assignment)
+void BinaryTransform::operator()(LocalAssignment const& _assignment)
 {
-	return
-		std::visit(*this, *_assignment.value) +
-		toBytes(Opcode::LocalSet) +
-		lebEncode(m_locals.at(_assignment.variableName));
+	std::visit(*this, *_assignment.value);
+	m_code.push_back(uint8_t(Opcode::LocalSet));
+	lebEncodeTo(m_code, m_locals.at(_assignment.variableName));
 }
 
-bytes BinaryTransform::operator()(GlobalAssignment const& _assignment)
+void BinaryTransform::operator()(GlobalAssignment const& _assignment)
 {
-	return
-		std::visit(*this, *_assignment.value) +
-		toBytes(Opcode::GlobalSet) +
-		lebEncode(m_globalIDs.at(_assignment.variableName));
+	std::visit(*this, *_assignment.value);
+	m_code.push_back(uint8_t(Opcode::GlobalSet));
+	lebEncodeTo(m_code, m_globalIDs.at(_assignment.variableName));
 }
 
-bytes BinaryTransform::operator()(If const& _if)
+void BinaryTransform::operator()(If const& _if)
 {
-	bytes result =
-		std::visit(*this, *_if.condition) +
-		toBytes(Opcode::If) +
-		toBytes(ValueType::Void);
+	std::visit(*this, *_if.condition);
+	m_code.push_back(uint8_t(Opcode::If));
+	m_code.push_back(uint8_t(ValueType::Void));
 
 	m_labels.emplace_back();
 
-	result += visit(_if.statements);
+	visit(_if.statements);
 	if (_if.elseStatements)
-		result += toBytes(Opcode::Else) + visit(*_if.elseStatements);
+	{
+		m_code.push_back(uint8_t(Opcode::Else));
+		visit(*_if.elseStatements);
+	}
 
 	m_labels.pop_back();
 
-	result += toBytes(Opcode::End);
-	return result;
+	m_code.push_back(uint8_t(Opcode::End));
 }
 
-bytes BinaryTransform::operator()(Loop const& _loop)
+void BinaryTransform::operator()(Loop const& _loop)
 {
-	bytes result = toBytes(Opcode::Loop) + toBytes(ValueType::Void);
+	m_code.push_back(uint8_t(Opcode::Loop));
+	m_code.push_back(uint8_t(ValueType::Void));
 
 	m_labels.emplace_back(_loop.labelName);
-	result += visit(_loop.statements);
+	visit(_loop.statements);
 	m_labels.pop_back();
 
-	result += toBytes(Opcode::End);
-	return result;
+	m_code.push_back(uint8_t(Opcode::End));
 }
 
-bytes BinaryTransform::operator()(Branch const& _branch)
+void BinaryTransform::operator()(Branch const& _branch)
 {
-	return toBytes(Opcode::Br) + encodeLabelIdx(_branch.label.name);
+	m_code.push_back(uint8_t(Opcode::Br));
+	lebEncodeTo(m_code, labelDepth(_branch.label.name));
 }
 
-bytes BinaryTransform::operator()(BranchIf const& _branchIf)
+void BinaryTransform::operator()(BranchIf const& _branchIf)
 {
-	bytes result = std::visit(*this, *_branchIf.condition);
-	result += toBytes(Opcode::BrIf) + encodeLabelIdx(_branchIf.label.name);
-	return result;
+	std::visit(*this, *_branchIf.condition);
+	m_code.push_back(uint8_t(Opcode::BrIf));
+	lebEncodeTo(m_code, labelDepth(_branchIf.label.name));
 }
 
-bytes BinaryTransform::operator()(Return const&)
+void BinaryTransform::operator()(Return const&)
 {
 	// Note that this does not work if the function returns a value.
-	return toBytes(Opcode::Return);
+	m_code.push_back(uint8_t(Opcode::Return));
 }
 
-bytes BinaryTransform::operator()(Block const& _block)
+void BinaryTransform::operator()(Block const& _block)
 {
 	m_labels.emplace_back(_block.labelName);
-	bytes result =
-		toBytes(Opcode::Block) +
-		toBytes(ValueType::Void) +
-		visit(_block.statements) +
-		toBytes(Opcode::End);
+	m_code.push_back(uint8_t(Opcode::Block));
+	m_code.push_back(uint8_t(ValueType::Void));
+	visit(_block.statements);
+	m_code.push_back(uint8_t(Opcode::End));
 	m_labels.pop_back();
-	return result;
 }
 
-bytes BinaryTransform::operator()(FunctionDefinition const& _function)
+void BinaryTransform::operator()(FunctionDefinition const& _function)
 {
-	bytes ret;
-
 	vector<pair<size_t, ValueType>> localEntries = groupLocalVariables(_function.locals);
-	ret += lebEncode(localEntries.size());
+	lebEncodeTo(m_code, localEntries.size());
 	for (pair<size_t, ValueType> const& entry: localEntries)
 	{
-		ret += lebEncode(entry.first);
-		ret += toBytes(entry.second);
+		lebEncodeTo(m_code, entry.first);
+		m_code.push_back(uint8_t(entry.second));
 	}
 
 	m_locals.clear();
@@ -496,12 +531,10 @@ bytes BinaryTransform::operator()(FunctionDefinition const& _function)
 
 	yulAssert(m_labels.empty(), "Stray labels.");
 
-	ret += visit(_function.body);
-	ret += toBytes(Opcode::End);
+	visit(_function.body);
+	m_code.push_back(uint8_t(Opcode::End));
 
 	yulAssert(m_labels.empty(), "Stray labels.");
-
-	return prefixSize(move(ret));
 }
 
 BinaryTransform::Type BinaryTransform::typeOf(FunctionImport const& _import)
@@ -603,7 +636,7 @@ bytes BinaryTransform::typeSection(map<BinaryTransform::Type, vector<string>> co
 		index++;
 	}
 
-	return makeSection(Section::TYPE, lebEncode(index) + move(result));
+	return lebEncode(index) + move(result);
 }
 
 bytes BinaryTransform::importSection(
@@ -621,7 +654,7 @@ bytes BinaryTransform::importSection(
 			toBytes(importKind) +
 			lebEncode(_functionTypes.at(import.internalName));
 	}
-	return makeSection(Section::IMPORT, move(result));
+	return result;
 }
 
 bytes BinaryTransform::functionSection(
@@ -632,7 +665,7 @@ bytes BinaryTransform::functionSection(
 	bytes result = lebEncode(_functions.size());
 	for (auto const& fun: _functions)
 		result += lebEncode(_functionTypes.at(fun.name));
-	return makeSection(Section::FUNCTION, move(result));
+	return result;
 }
 
 bytes BinaryTransform::memorySection()
@@ -640,7 +673,7 @@ bytes BinaryTransform::memorySection()
 	bytes result = lebEncode(1);
 	result.push_back(static_cast<uint8_t>(LimitsKind::Min));
 	result.push_back(1); // initial length
-	return makeSection(Section::MEMORY, move(result));
+	return result;
 }
 
 bytes BinaryTransform::globalSection(vector<wasm::GlobalVariableDeclaration> const& _globals)
@@ -657,7 +690,7 @@ bytes BinaryTransform::globalSection(vector<wasm::GlobalVariableDeclaration> con
 			toBytes(Opcode::End);
 	}
 
-	return makeSection(Section::GLOBAL, move(result));
+	return result;
 }
 
 bytes BinaryTransform::exportSection(map<string, size_t> const& _functionIDs)
@@ -667,46 +700,42 @@ bytes BinaryTransform::exportSection(map<string, size_t> const& _functionIDs)
 	result += encodeName("memory") + toBytes(Export::Memory) + lebEncode(0);
 	if (hasMain)
 		result += encodeName("main") + toBytes(Export::Function) + lebEncode(_functionIDs.at("main"));
-	return makeSection(Section::EXPORT, move(result));
-}
-
-bytes BinaryTransform::customSection(string const& _name, bytes _data)
-{
-	bytes result = encodeName(_name) + move(_data);
-	return makeSection(Section::CUSTOM, move(result));
+	return result;
 }
 
-bytes BinaryTransform::codeSection(vector<wasm::FunctionDefinition> const& _functions)
+vector<bytes> BinaryTransform::codeSection(vector<wasm::FunctionDefinition> const& _functions)
 {
-	bytes result = lebEncode(_functions.size());
+	vector<bytes> bodies;
+	bodies.reserve(_functions.size());
 	for (FunctionDefinition const& fun: _functions)
-		result += (*this)(fun);
-	return makeSection(Section::CODE, move(result));
+	{
+		m_code.clear();
+		(*this)(fun);
+		bodies.emplace_back(move(m_code));
+	}
+	m_code.clear();
+	return bodies;
 }
 
-bytes BinaryTransform::visit(vector<Expression> const& _expressions)
+void BinaryTransform::visit(vector<Expression> const& _expressions)
 {
-	bytes result;
 	for (auto const& expr: _expressions)
-		result += std::visit(*this, expr);
-	return result;
+		std::visit(*this, expr);
 }
 
-bytes BinaryTransform::visitReversed(vector<Expression> const& _expressions)
+void BinaryTransform::visitReversed(vector<Expression> const& _expressions)
 {
-	bytes result;
 	for (auto const& expr: _expressions | boost::adaptors::reversed)
-		result += std::visit(*this, expr);
-	return result;
+		std::visit(*this, expr);
 }
 
-bytes BinaryTransform::encodeLabelIdx(string const& _label) const
+size_t BinaryTransform::labelDepth(string const& _label) const
 {
 	yulAssert(!_label.empty(), "Empty label.");
 	size_t depth = 0;
 	for (string const& label: m_labels | boost::adaptors::reversed)
 		if (label == _label)
-			return lebEncode(depth);
+			return depth;
 		else
 			++depth;
 	yulAssert(false, "Label not found.");
@@ -23,6 +23,7 @@
 
 #include <libyul/backends/wasm/WordSizeTransform.h>
 #include <libyul/backends/wasm/WasmDialect.h>
+#include <libyul/optimiser/CallGraphGenerator.h>
 #include <libyul/optimiser/ExpressionSplitter.h>
 #include <libyul/optimiser/FunctionGrouper.h>
 #include <libyul/optimiser/MainFunction.h>
@@ -54,21 +55,30 @@
 #include <ewasmPolyfills/Logical.h>
 #include <ewasmPolyfills/Memory.h>
 
+#include <mutex>
+
 using namespace std;
 using namespace solidity;
 using namespace solidity::yul;
 using namespace solidity::util;
 using namespace solidity::langutil;
 
+struct EVMToEwasmTranslator::Polyfill
+{
+	shared_ptr<Block const> code;
+	set<YulString> functions;
+	CallGraph callGraph;
+};
+
 Object EVMToEwasmTranslator::run(Object const& _object)
 {
 	if (!m_polyfill)
-		parsePolyfill();
+		m_polyfill = polyfill();
 
 	Block ast = std::get<Block>(Disambiguator(m_dialect, *_object.analysisInfo)(*_object.code));
 	set<YulString> reservedIdentifiers;
 	NameDispenser nameDispenser{m_dialect, ast, reservedIdentifiers};
-	OptimiserStepContext context{m_dialect, nameDispenser, reservedIdentifiers};
+	OptimiserStepContext context{m_dialect, nameDispenser, reservedIdentifiers, nullptr};
 
 	FunctionHoister::run(context, ast);
 	FunctionGrouper::run(context, ast);
@@ -77,9 +87,28 @@ Object EVMToEwasmTranslator::run(Object const& _object)
 	ExpressionSplitter::run(context, ast);
 	WordSizeTransform::run(m_dialect, WasmDialect::instance(), ast, nameDispenser);
 
-	NameDisplacer{nameDispenser, m_polyfillFunctions}(ast);
-	for (auto const& st: m_polyfill->statements)
-		ast.statements.emplace_back(ASTCopier{}.translate(st));
+	NameDisplacer{nameDispenser, m_polyfill->functions}(ast);
+
+	// Only the polyfill functions that are called by the translated code, directly or
+	// through other polyfill functions, are added.
+	set<YulString> usedFunctions;
+	vector<YulString> toVisit;
+	for (auto const& calls: CallGraphGenerator::callGraph(ast).functionCalls)
+		for (YulString callee: calls.second)
+			if (m_polyfill->functions.count(callee) && usedFunctions.insert(callee).second)
+				toVisit.push_back(callee);
+	while (!toVisit.empty())
+	{
+		YulString function = toVisit.back();
+		toVisit.pop_back();
+		if (auto calls = m_polyfill->callGraph.functionCalls.find(function); calls != m_polyfill->callGraph.functionCalls.end())
+			for (YulString callee: calls->second)
+				if (m_polyfill->functions.count(callee) && usedFunctions.insert(callee).second)
+					toVisit.push_back(callee);
+	}
+	for (auto const& statement: m_polyfill->code->statements)
+		if (usedFunctions.count(std::get<FunctionDefinition>(statement).name))
+			ast.statements.emplace_back(ASTCopier{}.translate(statement));
 
 	Object ret;
 	ret.name = _object.name;
@@ -98,7 +127,7 @@ Object EVMToEwasmTranslator::run(Object const& _object)
 		message += ret.toString(&WasmDialect::instance());
 		message += "----------------------------------\n";
 		for (auto const& err: errors)
-			message += langutil::SourceReferenceFormatter::formatErrorInformation(*err);
+			message += langutil::SourceReferenceFormatter::formatErrorInformation(*err, langutil::EmptyCharStreamProvider{});
 		yulAssert(false, message);
 	}
 
@@ -112,7 +141,18 @@ Object EVMToEwasmTranslator::run(Object const& _object)
 	return ret;
 }
 
-void EVMToEwasmTranslator::parsePolyfill()
+shared_ptr<EVMToEwasmTranslator::Polyfill const> EVMToEwasmTranslator::polyfill()
+{
+	static shared_ptr<Polyfill const> polyfill;
+	static YulStringRepository::ResetCallback callback{[&] { polyfill.reset(); }};
+	static mutex polyfillMutex;
+	lock_guard<mutex> lock(polyfillMutex);
+	if (!polyfill)
+		polyfill = parsePolyfill();
+	return polyfill;
+}
+
+shared_ptr<EVMToEwasmTranslator::Polyfill const> EVMToEwasmTranslator::parsePolyfill()
 {
 	ErrorList errors;
 	ErrorReporter errorReporter(errors);
@@ -127,16 +167,19 @@ void EVMToEwasmTranslator::parsePolyfill()
 			string(solidity::yul::wasm::polyfill::Logical) +
 			string(solidity::yul::wasm::polyfill::Memory) +
 		"}", ""))};
-	m_polyfill = Parser(errorReporter, WasmDialect::instance()).parse(scanner, false);
+	shared_ptr<Block> code = Parser(errorReporter, WasmDialect::instance()).parse(scanner, false);
 	if (!errors.empty())
 	{
 		string message;
 		for (auto const& err: errors)
-			message += langutil::SourceReferenceFormatter::formatErrorInformation(*err);
+			message += langutil::SourceReferenceFormatter::formatErrorInformation(*err, *scanner->charStream());
 		yulAssert(false, message);
 	}
 
-	m_polyfillFunctions.clear();
-	for (auto const& statement: m_polyfill->statements)
-		m_polyfillFunctions.insert(std::get<FunctionDefinition>(statement).name);
+	auto polyfill = make_shared<Polyfill>();
+	for (auto const& statement: code->statements)
+		polyfill->functions.insert(std::get<FunctionDefinition>(statement).name);
+	polyfill->callGraph = CallGraphGenerator::callGraph(*code);
+	polyfill->code = move(code);
+	return polyfill;
 }
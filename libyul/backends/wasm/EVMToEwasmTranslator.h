@@ -25,6 +25,9 @@
 #include <libyul/optimiser/ASTWalker.h>
 #include <libyul/Dialect.h>
 
+#include <memory>
+#include <set>
+
 namespace solidity::yul
 {
 struct Object;
@@ -36,12 +39,16 @@ public:
 	Object run(Object const& _object);
 
 private:
-	void parsePolyfill();
+	/// The parsed polyfill functions and their calls.
+	struct Polyfill;
+
+	/// @returns the polyfill, which is parsed once and shared by all translators.
+	static std::shared_ptr<Polyfill const> polyfill();
+	static std::shared_ptr<Polyfill const> parsePolyfill();
 
 	Dialect const& m_dialect;
 
-	std::shared_ptr<Block> m_polyfill;
-	std::set<YulString> m_polyfillFunctions;
+	std::shared_ptr<Polyfill const> m_polyfill;
 };
 
 }
@@ -20,12 +20,14 @@
 #include <libyul/backends/wasm/WordSizeTransform.h>
 #include <libyul/Utilities.h>
 #include <libyul/Dialect.h>
+#include <libyul/optimiser/ASTWalker.h>
 #include <libyul/optimiser/NameDisplacer.h>
 
 #include <libsolutil/CommonData.h>
 
 #include <array>
 #include <map>
+#include <set>
 #include <variant>
 
 using namespace std;
@@ -33,6 +35,119 @@ using namespace solidity;
 using namespace solidity::yul;
 using namespace solidity::util;
 
+namespace
+{
+
+/**
+ * Finds the variables whose values always fit into 64 bits, because all values assigned
+ * to them are such literals, results of builtins like comparisons or masks, or other such
+ * variables. Parameters and return variables of functions are never included.
+ */
+class NarrowVariableFinder: public ASTWalker
+{
+public:
+	static set<YulString> run(Dialect const& _dialect, Block const& _ast)
+	{
+		NarrowVariableFinder finder{_dialect};
+		finder(_ast);
+
+		set<YulString> narrow;
+		for (auto const& [name, values]: finder.m_values)
+			if (!finder.m_wide.count(name))
+				narrow.insert(name);
+		// Removes the variables that are assigned values which are not known to be narrow
+		// until all values of the remaining ones are narrow given that they are.
+		for (bool changed = true; changed;)
+		{
+			changed = false;
+			for (auto it = narrow.begin(); it != narrow.end();)
+				if (all_of(
+					finder.m_values.at(*it).begin(),
+					finder.m_values.at(*it).end(),
+					[&](Expression const* _value) { return !_value || finder.isNarrow(*_value, narrow); }
+				))
+					++it;
+				else
+				{
+					it = narrow.erase(it);
+					changed = true;
+				}
+		}
+		return narrow;
+	}
+
+	using ASTWalker::operator();
+	void operator()(FunctionDefinition const& _function) override
+	{
+		for (auto const& parameter: _function.parameters)
+			m_wide.insert(parameter.name);
+		for (auto const& returnVariable: _function.returnVariables)
+			m_wide.insert(returnVariable.name);
+		ASTWalker::operator()(_function);
+	}
+	void operator()(VariableDeclaration const& _varDecl) override
+	{
+		for (auto const& variable: _varDecl.variables)
+			addValue(variable.name, _varDecl.variables.size(), _varDecl.value.get());
+		ASTWalker::operator()(_varDecl);
+	}
+	void operator()(Assignment const& _assignment) override
+	{
+		for (auto const& variable: _assignment.variableNames)
+			addValue(variable.name, _assignment.variableNames.size(), _assignment.value.get());
+		ASTWalker::operator()(_assignment);
+	}
+
+private:
+	explicit NarrowVariableFinder(Dialect const& _dialect): m_dialect(_dialect) {}
+
+	void addValue(YulString _variable, size_t _variableCount, Expression const* _value)
+	{
+		// Only user defined functions return multiple values.
+		if (_variableCount > 1)
+			m_wide.insert(_variable);
+		else
+			m_values[_variable].push_back(_value);
+	}
+
+	bool isNarrow(Expression const& _expression, set<YulString> const& _narrowVariables) const
+	{
+		if (auto const* literal = get_if<Literal>(&_expression))
+			return valueOfLiteral(*literal) <= numeric_limits<uint64_t>::max();
+		else if (auto const* identifier = get_if<Identifier>(&_expression))
+			return _narrowVariables.count(identifier->name);
+		else if (auto const* call = get_if<FunctionCall>(&_expression))
+		{
+			if (!m_dialect.builtin(call->functionName.name))
+				return false;
+			string const& name = call->functionName.name.str();
+			auto argumentNarrow = [&](size_t _index) {
+				return isNarrow(call->arguments.at(_index), _narrowVariables);
+			};
+			if (set<string>{"lt", "gt", "slt", "sgt", "eq", "iszero", "byte", "datasize", "dataoffset"}.count(name))
+				return true;
+			else if (name == "and")
+				return argumentNarrow(0) || argumentNarrow(1);
+			else if (name == "or" || name == "xor")
+				return argumentNarrow(0) && argumentNarrow(1);
+			else if (name == "mod")
+				return argumentNarrow(1);
+			else if (name == "div")
+				return argumentNarrow(0);
+			else if (name == "shr")
+				if (auto const* shift = get_if<Literal>(&call->arguments.at(0)))
+					return valueOfLiteral(*shift) >= 192;
+		}
+		return false;
+	}
+
+	Dialect const& m_dialect;
+	map<YulString, vector<Expression const*>> m_values;
+	set<YulString> m_wide;
+};
+
+}
+
 void WordSizeTransform::operator()(FunctionDefinition& _fd)
 {
 	rewriteVarDeclList(_fd.parameters);
@@ -206,7 +321,8 @@ void WordSizeTransform::operator()(Block& _block)
 					auto newRhs = expandValue(*assignment.value);
 					YulString lhsName = assignment.variableNames[0].name;
 					vector<Statement> ret;
-					for (size_t i = 0; i < 4; i++)
+					// The upper parts of narrow variables stay zero.
+					for (size_t i = m_narrowVariables.count(lhsName) ? 3 : 0; i < 4; i++)
 						ret.emplace_back(Assignment{
 								assignment.location,
 								{Identifier{assignment.location, m_variableMapping.at(lhsName)[i]}},
@@ -236,7 +352,9 @@ void WordSizeTransform::run(
 {
 	// Free the name `or_bool`.
 	NameDisplacer{_nameDispenser, {"or_bool"_yulstring}}(_ast);
-	WordSizeTransform{_inputDialect, _targetDialect, _nameDispenser}(_ast);
+	WordSizeTransform transform{_inputDialect, _targetDialect, _nameDispenser};
+	transform.m_narrowVariables = NarrowVariableFinder::run(_inputDialect, _ast);
+	transform(_ast);
 }
 
 WordSizeTransform::WordSizeTransform(
@@ -362,7 +480,7 @@ std::vector<Statement> WordSizeTransform::handleSwitch(Switch& _switch)
 		});
 	}
 	vector<YulString> splitExpressions;
-	for (auto const& expr: expandValue(*_switch.expression))
+	for (auto const& expr: expandValue(*_switch.expression, false))
 		splitExpressions.emplace_back(std::get<Identifier>(*expr).name);
 
 	ret += handleSwitchInternal(
@@ -390,14 +508,18 @@ array<YulString, 4> WordSizeTransform::generateU64IdentifierNames(YulString cons
 	return m_variableMapping[_s];
 }
 
-array<unique_ptr<Expression>, 4> WordSizeTransform::expandValue(Expression const& _e)
+array<unique_ptr<Expression>, 4> WordSizeTransform::expandValue(Expression const& _e, bool _narrow)
 {
 	array<unique_ptr<Expression>, 4> ret;
 	if (holds_alternative<Identifier>(_e))
 	{
 		auto const& id = std::get<Identifier>(_e);
+		bool const narrow = _narrow && m_narrowVariables.count(id.name);
 		for (size_t i = 0; i < 4; i++)
-			ret[i] = make_unique<Expression>(Identifier{id.location, m_variableMapping.at(id.name)[i]});
+			if (narrow && i < 3)
+				ret[i] = make_unique<Expression>(Literal{id.location, LiteralKind::Number, "0"_yulstring, m_targetDialect.defaultType});
+			else
+				ret[i] = make_unique<Expression>(Identifier{id.location, m_variableMapping.at(id.name)[i]});
 	}
 	else if (holds_alternative<Literal>(_e))
 	{
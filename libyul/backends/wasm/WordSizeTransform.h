@@ -27,6 +27,7 @@
 #include <liblangutil/SourceLocation.h>
 
 #include <array>
+#include <set>
 #include <vector>
 
 namespace solidity::yul
@@ -56,6 +57,11 @@ namespace solidity::yul
  * takes four u64 parameters and is supposed to return the logical disjunction
  * of them as a i32 value. If this name is already used somewhere, it is renamed.
  *
+ * Local variables whose values always fit into 64 bits, e.g. because they are only assigned
+ * small literals or the results of comparisons, still get four u64 variables, but the upper
+ * three are never assigned after their declaration and are replaced by zero wherever the
+ * variable is used. This allows the optimiser to simplify the calls of the polyfill functions.
+ *
  * Prerequisite: Disambiguator, ForLoopConditionIntoBody, ExpressionSplitter
  */
 class WordSizeTransform: public ASTModifier
@@ -95,7 +101,9 @@ private:
 	);
 
 	std::array<YulString, 4> generateU64IdentifierNames(YulString const& _s);
-	std::array<std::unique_ptr<Expression>, 4> expandValue(Expression const& _e);
+	/// @returns the four u64 parts of @a _e. If @a _narrow is true, the upper parts of
+	/// narrow variables are replaced by zero.
+	std::array<std::unique_ptr<Expression>, 4> expandValue(Expression const& _e, bool _narrow = true);
 	std::vector<Expression> expandValueToVector(Expression const& _e);
 
 	Dialect const& m_inputDialect;
@@ -103,6 +111,8 @@ private:
 	NameDispenser& m_nameDispenser;
 	/// maps original u256 variable's name to corresponding u64 variables' names
 	std::map<YulString, std::array<YulString, 4>> m_variableMapping;
+	/// The variables whose upper parts are always zero.
+	std::set<YulString> m_narrowVariables;
 };
 
 }
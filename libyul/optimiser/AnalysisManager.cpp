@@ -0,0 +1,174 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Cache for the analyses of the complete AST that are shared by optimiser steps.
+ */
+
+#include <libyul/optimiser/AnalysisManager.h>
+
+#include <libyul/optimiser/BlockHasher.h>
+#include <libyul/optimiser/Semantics.h>
+#include <libyul/AST.h>
+#include <libyul/Dialect.h>
+#include <libyul/Exceptions.h>
+
+#include <libsolutil/CommonData.h>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::yul;
+using namespace solidity::util;
+
+FunctionFingerprints AnalysisManager::functionFingerprints(Block const& _ast)
+{
+	map<Block const*, uint64_t> blockHashes = BlockHasher::run(_ast);
+	// BlockHasher does not provide hashes for empty blocks.
+	auto blockHash = [&](Block const& _block) {
+		auto it = blockHashes.find(&_block);
+		return it == blockHashes.end() ? ASTHasherBase::fnvEmptyHash : it->second;
+	};
+
+	FunctionFingerprints fingerprints;
+	// The code outside of function definitions consists of blocks after the FunctionGrouper.
+	// Otherwise, the hash of the complete AST is used, which changes whenever anything changes.
+	uint64_t codeFingerprint = ASTHasherBase::fnvEmptyHash;
+	for (Statement const& statement: _ast.statements)
+		if (auto const* function = get_if<FunctionDefinition>(&statement))
+		{
+			uint64_t fingerprint = blockHash(function->body);
+			// The hash of the body does not distinguish parameters from return variables.
+			for (TypedNameList const* variables: {&function->parameters, &function->returnVariables})
+			{
+				fingerprint = (fingerprint * ASTHasherBase::fnvPrime) ^ variables->size();
+				for (auto const& variable: *variables)
+					fingerprint = (fingerprint * ASTHasherBase::fnvPrime) ^ variable.name.hash();
+			}
+			fingerprints[function->name] = fingerprint;
+		}
+		else if (auto const* block = get_if<Block>(&statement))
+			codeFingerprint = (codeFingerprint * ASTHasherBase::fnvPrime) ^ blockHash(*block);
+		else
+		{
+			codeFingerprint = blockHash(_ast);
+			break;
+		}
+	fingerprints[YulString{}] = codeFingerprint;
+	return fingerprints;
+}
+
+void AnalysisManager::track(Block const* _ast)
+{
+	m_ast = _ast;
+	m_fingerprints.reset();
+	m_parts.clear();
+	m_callGraph.reset();
+	m_functionSideEffects.reset();
+	m_containsMSize.reset();
+	m_controlFlowGraphs.clear();
+}
+
+void AnalysisManager::modified(FunctionFingerprints const* _fingerprints)
+{
+	if (!m_ast)
+		return;
+	m_controlFlowGraphs.clear();
+	if (m_parts.empty())
+	{
+		// Nothing to update, the fingerprints are computed once they are needed.
+		m_fingerprints.reset();
+		return;
+	}
+
+	m_fingerprints = _fingerprints ? *_fingerprints : functionFingerprints(*m_ast);
+	bool changed = m_parts.size() != m_fingerprints->size();
+	for (auto it = m_parts.begin(); it != m_parts.end();)
+	{
+		auto fingerprint = m_fingerprints->find(it->first);
+		if (fingerprint == m_fingerprints->end() || fingerprint->second != it->second.fingerprint)
+		{
+			it = m_parts.erase(it);
+			changed = true;
+		}
+		else
+			++it;
+	}
+	if (changed)
+	{
+		m_callGraph.reset();
+		m_functionSideEffects.reset();
+		m_containsMSize.reset();
+	}
+}
+
+CallGraph const& AnalysisManager::callGraph()
+{
+	yulAssert(m_ast, "No AST tracked.");
+	if (m_callGraph)
+		return *m_callGraph;
+
+	if (!m_fingerprints)
+		m_fingerprints = functionFingerprints(*m_ast);
+	CallGraph codeCallGraph;
+	bool const analyseCode = !m_parts.count(YulString{});
+	for (Statement const& statement: m_ast->statements)
+		if (auto const* function = get_if<FunctionDefinition>(&statement))
+		{
+			if (!m_parts.count(function->name))
+				m_parts[function->name] = {m_fingerprints->at(function->name), CallGraphGenerator::callGraph(statement)};
+		}
+		else if (analyseCode)
+			codeCallGraph.merge(CallGraphGenerator::callGraph(statement));
+	if (analyseCode)
+		m_parts[YulString{}] = {m_fingerprints->at(YulString{}), move(codeCallGraph)};
+
+	m_callGraph = CallGraph{};
+	for (auto const& part: m_parts)
+		m_callGraph->merge(part.second.callGraph);
+	return *m_callGraph;
+}
+
+map<YulString, SideEffects> const& AnalysisManager::functionSideEffects()
+{
+	if (!m_functionSideEffects)
+		m_functionSideEffects = SideEffectsPropagator::sideEffects(m_dialect, callGraph());
+	return *m_functionSideEffects;
+}
+
+bool AnalysisManager::containsMSize()
+{
+	if (!m_containsMSize)
+	{
+		// Equivalent to MSizeFinder, since the call graph contains all calls to builtins.
+		m_containsMSize = false;
+		for (auto const& calls: callGraph().functionCalls)
+			for (YulString callee: calls.second)
+				if (BuiltinFunction const* builtin = m_dialect.builtin(callee))
+					if (builtin->isMSize)
+						m_containsMSize = true;
+	}
+	return *m_containsMSize;
+}
+
+ControlFlowGraph const& AnalysisManager::controlFlowGraph(FunctionDefinition const& _function)
+{
+	yulAssert(m_ast, "No AST tracked.");
+	unique_ptr<ControlFlowGraph>& graph = m_controlFlowGraphs[&_function];
+	if (!graph)
+		graph = make_unique<ControlFlowGraph>(m_dialect, _function);
+	return *graph;
+}
@@ -0,0 +1,97 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Cache for the analyses of the complete AST that are shared by optimiser steps.
+ */
+
+#pragma once
+
+#include <libyul/optimiser/CallGraphGenerator.h>
+#include <libyul/optimiser/ControlFlowGraph.h>
+#include <libyul/ASTForward.h>
+#include <libyul/SideEffects.h>
+#include <libyul/YulString.h>
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <optional>
+
+namespace solidity::yul
+{
+struct Dialect;
+
+/// Fingerprints of the functions defined in the outermost block, by name. The code outside of
+/// function definitions is denoted by the empty name, as in the call graph.
+using FunctionFingerprints = std::map<YulString, uint64_t>;
+
+/**
+ * Caches the call graph, the side-effects of the functions and whether msize is used for the
+ * AST that is being optimised, so that the steps using them do not compute them from scratch.
+ *
+ * The call graph is stored separately for each function of the outermost block and for the
+ * code outside of function definitions. After the AST was modified, only the parts whose
+ * fingerprints changed are analysed again. The results derived from the call graph are only
+ * recomputed if a part changed.
+ *
+ * The control flow graphs of functions are built on first use and dropped whenever the AST
+ * is modified, since they refer to the statements of the AST.
+ *
+ * Only used by the thread that runs the optimiser suite.
+ */
+class AnalysisManager
+{
+public:
+	explicit AnalysisManager(Dialect const& _dialect): m_dialect(_dialect) {}
+
+	/// @returns the fingerprints of the parts of @a _ast.
+	static FunctionFingerprints functionFingerprints(Block const& _ast);
+
+	/// Starts tracking @a _ast or stops tracking if it is null. Drops all results.
+	void track(Block const* _ast);
+	bool tracks(Block const& _ast) const { return m_ast == &_ast; }
+	/// Has to be called after every modification of the tracked AST. Drops the results for the
+	/// parts that changed. If known, @a _fingerprints are the current fingerprints of the AST.
+	void modified(FunctionFingerprints const* _fingerprints = nullptr);
+
+	/// The results for the tracked AST.
+	CallGraph const& callGraph();
+	std::map<YulString, SideEffects> const& functionSideEffects();
+	bool containsMSize();
+	/// @returns the control flow graph of @a _function, which has to be part of the tracked AST.
+	ControlFlowGraph const& controlFlowGraph(FunctionDefinition const& _function);
+
+private:
+	struct Part
+	{
+		uint64_t fingerprint;
+		CallGraph callGraph;
+	};
+
+	Dialect const& m_dialect;
+	Block const* m_ast = nullptr;
+	/// Fingerprints of the tracked AST, if known.
+	std::optional<FunctionFingerprints> m_fingerprints;
+	std::map<YulString, Part> m_parts;
+	std::optional<CallGraph> m_callGraph;
+	std::optional<std::map<YulString, SideEffects>> m_functionSideEffects;
+	std::optional<bool> m_containsMSize;
+	std::map<FunctionDefinition const*, std::unique_ptr<ControlFlowGraph>> m_controlFlowGraphs;
+};
+
+}
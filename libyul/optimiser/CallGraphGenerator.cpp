@@ -22,6 +22,8 @@
 #include <libyul/AST.h>
 #include <libyul/optimiser/CallGraphGenerator.h>
 
+#include <libsolutil/CommonData.h>
+
 #include <stack>
 
 using namespace std;
@@ -70,6 +72,13 @@ set<YulString> CallGraph::recursiveFunctions() const
 	return cycleFinder.containedInCycle;
 }
 
+void CallGraph::merge(CallGraph const& _other)
+{
+	for (auto const& [function, callees]: _other.functionCalls)
+		functionCalls[function] += callees;
+	functionsWithLoops += _other.functionsWithLoops;
+}
+
 CallGraph CallGraphGenerator::callGraph(Block const& _ast)
 {
 	CallGraphGenerator gen;
@@ -77,6 +86,13 @@ CallGraph CallGraphGenerator::callGraph(Block const& _ast)
 	return std::move(gen.m_callGraph);
 }
 
+CallGraph CallGraphGenerator::callGraph(Statement const& _statement)
+{
+	CallGraphGenerator gen;
+	gen.visit(_statement);
+	return std::move(gen.m_callGraph);
+}
+
 void CallGraphGenerator::operator()(FunctionCall const& _functionCall)
 {
 	m_callGraph.functionCalls[m_currentFunction].insert(_functionCall.functionName.name);
@@ -38,6 +38,9 @@ struct CallGraph
 	/// functions that are part of a (mutual) recursion.
 	/// Note that this does not include functions that merely call recursive functions.
 	std::set<YulString> recursiveFunctions() const;
+	/// Adds the calls and loops of @a _other, which has to be the call graph of other functions,
+	/// apart from the outermost context.
+	void merge(CallGraph const& _other);
 };
 
 /**
@@ -51,6 +54,8 @@ class CallGraphGenerator: public ASTWalker
 {
 public:
 	static CallGraph callGraph(Block const& _ast);
+	/// @returns the call graph of a single statement of the outermost block.
+	static CallGraph callGraph(Statement const& _statement);
 
 	using ASTWalker::operator();
 	void operator()(FunctionCall const& _functionCall) override;
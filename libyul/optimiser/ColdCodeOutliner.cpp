@@ -0,0 +1,189 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libyul/optimiser/ColdCodeOutliner.h>
+
+#include <libyul/optimiser/ASTCopier.h>
+#include <libyul/optimiser/FullInliner.h>
+#include <libyul/optimiser/Metrics.h>
+#include <libyul/optimiser/NameDispenser.h>
+#include <libyul/optimiser/SyntacticalEquality.h>
+#include <libyul/backends/evm/EVMDialect.h>
+
+#include <libsolutil/CommonData.h>
+
+#include <set>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::util;
+using namespace solidity::yul;
+
+namespace
+{
+
+/**
+ * Collects the variables a block references that are not declared inside of it
+ * and checks whether it can be moved into a function.
+ */
+class BranchAnalyzer: public ASTWalker
+{
+public:
+	using ASTWalker::operator();
+	void operator()(Identifier const& _identifier) override
+	{
+		if (!m_declaredVariables.count(_identifier.name) && m_seenVariables.insert(_identifier.name).second)
+			m_freeVariables.emplace_back(_identifier.name);
+	}
+	void operator()(VariableDeclaration const& _varDecl) override
+	{
+		ASTWalker::operator()(_varDecl);
+		for (auto const& variable: _varDecl.variables)
+			m_declaredVariables.insert(variable.name);
+	}
+	void operator()(ForLoop const& _loop) override
+	{
+		++m_loopDepth;
+		ASTWalker::operator()(_loop);
+		--m_loopDepth;
+	}
+	void operator()(Break const&) override { m_movable = m_movable && m_loopDepth > 0; }
+	void operator()(Continue const&) override { m_movable = m_movable && m_loopDepth > 0; }
+	void operator()(Leave const&) override { m_movable = false; }
+	void operator()(FunctionDefinition const&) override { m_movable = false; }
+
+	bool movable() const { return m_movable; }
+	vector<YulString> const& freeVariables() const { return m_freeVariables; }
+
+private:
+	set<YulString> m_declaredVariables;
+	set<YulString> m_seenVariables;
+	vector<YulString> m_freeVariables;
+	size_t m_loopDepth = 0;
+	bool m_movable = true;
+};
+
+}
+
+void ColdCodeOutliner::run(OptimiserStepContext& _context, Block& _ast)
+{
+	auto const* dialect = dynamic_cast<EVMDialect const*>(&_context.dialect);
+	if (!dialect || _context.dialect.types.size() > 1)
+		return;
+
+	ColdCodeOutliner outliner{*dialect};
+	outliner(_ast);
+
+	// The functions are only added in the end, since the candidates point into the AST.
+	vector<Statement> functions;
+	for (auto& [comparisonFunction, candidates]: outliner.m_candidates)
+	{
+		if (candidates.size() < 2)
+			continue;
+
+		Candidate const& first = candidates.front();
+		YulString functionName = _context.dispenser.newName("revert_path"_yulstring);
+		TypedNameList parameters;
+		map<YulString, YulString> parameterNames;
+		for (YulString variable: first.freeVariables)
+		{
+			YulString parameter = _context.dispenser.newName(variable);
+			parameters.emplace_back(TypedName{first.body->location, parameter, {}});
+			parameterNames[variable] = parameter;
+		}
+		Block body = std::get<Block>(BodyCopier{_context.dispenser, move(parameterNames)}(*first.body));
+
+		for (Candidate const& candidate: candidates)
+		{
+			langutil::SourceLocation location = candidate.body->location;
+			vector<Expression> arguments;
+			for (YulString variable: candidate.freeVariables)
+				arguments.emplace_back(Identifier{location, variable});
+			*candidate.body = Block{location, make_vector<Statement>(
+				ExpressionStatement{location, FunctionCall{location, Identifier{location, functionName}, move(arguments)}}
+			)};
+		}
+
+		functions.emplace_back(FunctionDefinition{
+			comparisonFunction.location,
+			functionName,
+			move(parameters),
+			{},
+			move(body)
+		});
+	}
+	_ast.statements += move(functions);
+}
+
+void ColdCodeOutliner::operator()(If& _if)
+{
+	visit(*_if.condition);
+	if (!addCandidate(_if.body))
+		(*this)(_if.body);
+}
+
+void ColdCodeOutliner::operator()(Switch& _switch)
+{
+	visit(*_switch.expression);
+	for (auto& switchCase: _switch.cases)
+		if (!addCandidate(switchCase.body))
+			(*this)(switchCase.body);
+}
+
+bool ColdCodeOutliner::addCandidate(Block& _body)
+{
+	if (_body.statements.empty())
+		return false;
+	auto const* lastStatement = get_if<ExpressionStatement>(&_body.statements.back());
+	auto const* call = lastStatement ? get_if<FunctionCall>(&lastStatement->expression) : nullptr;
+	BuiltinFunctionForEVM const* builtin = call ? m_dialect.builtin(call->functionName.name) : nullptr;
+	if (
+		!builtin ||
+		(builtin->instruction != evmasm::Instruction::REVERT && builtin->instruction != evmasm::Instruction::INVALID)
+	)
+		return false;
+
+	if (CodeSize::codeSize(_body) < MinOutlinedSize)
+		return false;
+
+	BranchAnalyzer analyzer;
+	analyzer(_body);
+	if (!analyzer.movable())
+		return false;
+
+	TypedNameList parameters;
+	for (YulString variable: analyzer.freeVariables())
+		parameters.emplace_back(TypedName{_body.location, variable, {}});
+	FunctionDefinition function{
+		_body.location,
+		{},
+		move(parameters),
+		{},
+		std::get<Block>(ASTCopier{}(_body))
+	};
+
+	Candidate candidate{&_body, analyzer.freeVariables()};
+	for (auto& [comparisonFunction, candidates]: m_candidates)
+		if (SyntacticallyEqual{}.statementEqual(comparisonFunction, function))
+		{
+			candidates.emplace_back(move(candidate));
+			return true;
+		}
+	m_candidates.emplace_back(move(function), vector<Candidate>{move(candidate)});
+	return true;
+}
@@ -0,0 +1,101 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#pragma once
+
+#include <libyul/optimiser/ASTWalker.h>
+#include <libyul/optimiser/OptimiserStep.h>
+#include <libyul/AST.h>
+#include <libyul/YulString.h>
+
+#include <vector>
+
+namespace solidity::yul
+{
+
+struct EVMDialect;
+
+/**
+ * ColdCodeOutliner: Optimiser step that moves identical branches that end in ``revert`` or
+ * ``invalid`` into a shared function.
+ *
+ * Branches of ``if`` and ``switch`` statements that always revert are only executed in error
+ * cases, but are often copied into many places, for example by inlining the functions that
+ * check for overflows or decode arguments. If the body of such a branch is equal to the body of
+ * another one, apart from the names of the variables, both are replaced by a call to a new
+ * function, which takes the variables the body references from the outside as parameters:
+ *
+ * ```
+ * if lt(a, b) { mstore(0, a) mstore(32, b) revert(0, 64) }
+ * ...
+ * if gt(c, d) { mstore(0, c) mstore(32, d) revert(0, 64) }
+ * ```
+ *
+ * becomes
+ *
+ * ```
+ * if lt(a, b) { revert_path(a, b) }
+ * ...
+ * if gt(c, d) { revert_path(c, d) }
+ * function revert_path(a_1, b_2) { mstore(0, a_1) mstore(32, b_2) revert(0, 64) }
+ * ```
+ *
+ * This reduces the size of the code at the cost of a function call in the error case.
+ * Only branches that are at least @a MinOutlinedSize large are outlined and branches nested
+ * inside another candidate are not considered. Branches containing ``leave`` or a ``break`` or
+ * ``continue`` that does not belong to a loop inside the branch stay in place.
+ *
+ * Does nothing for typed dialects and dialects other than EVM.
+ *
+ * Prerequisites: Disambiguator, FunctionHoister
+ */
+class ColdCodeOutliner: public ASTModifier
+{
+public:
+	/// Minimum size of a branch, measured with @a CodeSize, to be outlined. Smaller branches
+	/// would be inlined again by the FullInliner.
+	static constexpr size_t MinOutlinedSize = 6;
+
+	static constexpr char const* name{"ColdCodeOutliner"};
+	static void run(OptimiserStepContext& _context, Block& _ast);
+
+	using ASTModifier::operator();
+	void operator()(If& _if) override;
+	void operator()(Switch& _switch) override;
+
+private:
+	/// A branch to be outlined and the variables defined outside of it that it references,
+	/// in the order of their first occurrence.
+	struct Candidate
+	{
+		Block* body;
+		std::vector<YulString> freeVariables;
+	};
+
+	explicit ColdCodeOutliner(EVMDialect const& _dialect): m_dialect(_dialect) {}
+
+	/// Adds @a _body to the candidate with the same structure, if it can be outlined.
+	/// @returns false if it cannot be outlined.
+	bool addCandidate(Block& _body);
+
+	EVMDialect const& m_dialect;
+	/// Groups of equal candidates, with a function definition each that is used for the comparison.
+	std::vector<std::pair<FunctionDefinition, std::vector<Candidate>>> m_candidates;
+};
+
+}
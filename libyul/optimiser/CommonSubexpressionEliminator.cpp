@@ -21,9 +21,9 @@
 
 #include <libyul/optimiser/CommonSubexpressionEliminator.h>
 
+#include <libyul/optimiser/BlockHasher.h>
 #include <libyul/optimiser/Metrics.h>
 #include <libyul/optimiser/SyntacticalEquality.h>
-#include <libyul/optimiser/CallGraphGenerator.h>
 #include <libyul/optimiser/Semantics.h>
 #include <libyul/SideEffects.h>
 #include <libyul/Exceptions.h>
@@ -37,11 +37,18 @@ using namespace solidity::util;
 
 void CommonSubexpressionEliminator::run(OptimiserStepContext& _context, Block& _ast)
 {
-	CommonSubexpressionEliminator cse{
-		_context.dialect,
-		SideEffectsPropagator::sideEffects(_context.dialect, CallGraphGenerator::callGraph(_ast))
+	prepare(_context, _ast)(_ast);
+}
+
+function<void(Block&)> CommonSubexpressionEliminator::prepare(OptimiserStepContext& _context, Block const& _ast)
+{
+	return [
+		&dialect = _context.dialect,
+		functionSideEffects = SideEffectsPropagator::sideEffects(_context, _ast)
+	](Block& _part) {
+		CommonSubexpressionEliminator cse{dialect, functionSideEffects};
+		cse(_part);
 	};
-	cse(_ast);
 }
 
 CommonSubexpressionEliminator::CommonSubexpressionEliminator(
@@ -96,15 +103,41 @@ void CommonSubexpressionEliminator::visit(Expression& _e)
 	}
 	else
 	{
-		// TODO this search is rather inefficient.
-		for (auto const& [variable, value]: m_value)
+		auto candidates = m_replacementCandidates.find(ExpressionHasher::run(_e));
+		if (candidates == m_replacementCandidates.end())
+			return;
+		for (auto it = candidates->second.begin(); it != candidates->second.end();)
 		{
-			assertThrow(value.value, OptimizerException, "");
-			if (SyntacticallyEqual{}(_e, *value.value) && inScope(variable))
+			YulString variable = *it;
+			auto value = m_value.find(variable);
+			if (value == m_value.end())
+			{
+				it = candidates->second.erase(it);
+				continue;
+			}
+			assertThrow(value->second.value, OptimizerException, "");
+			if (SyntacticallyEqual{}(_e, *value->second.value) && inScope(variable))
 			{
 				_e = Identifier{locationOf(_e), variable};
 				break;
 			}
+			++it;
 		}
 	}
 }
+
+void CommonSubexpressionEliminator::operator()(FunctionDefinition& _function)
+{
+	// The data flow analyzer starts with empty knowledge inside functions.
+	unordered_map<uint64_t, set<YulString>> replacementCandidates;
+	swap(m_replacementCandidates, replacementCandidates);
+	DataFlowAnalyzer::operator()(_function);
+	swap(m_replacementCandidates, replacementCandidates);
+}
+
+void CommonSubexpressionEliminator::assignValue(YulString _variable, Expression const* _value)
+{
+	if (_value)
+		m_replacementCandidates[ExpressionHasher::run(*_value)].insert(_variable);
+	DataFlowAnalyzer::assignValue(_variable, _value);
+}
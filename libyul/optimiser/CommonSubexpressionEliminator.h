@@ -25,6 +25,10 @@
 #include <libyul/optimiser/DataFlowAnalyzer.h>
 #include <libyul/optimiser/OptimiserStep.h>
 
+#include <map>
+#include <set>
+#include <unordered_map>
+
 namespace solidity::yul
 {
 
@@ -41,7 +45,11 @@ class CommonSubexpressionEliminator: public DataFlowAnalyzer
 {
 public:
 	static constexpr char const* name{"CommonSubexpressionEliminator"};
+	static constexpr bool functionLocal = true;
 	static void run(OptimiserStepContext&, Block& _ast);
+	static std::function<void(Block&)> prepare(OptimiserStepContext& _context, Block const& _ast);
+
+	using DataFlowAnalyzer::operator();
 
 private:
 	CommonSubexpressionEliminator(
@@ -52,6 +60,16 @@ private:
 protected:
 	using ASTModifier::visit;
 	void visit(Expression& _e) override;
+
+	void operator()(FunctionDefinition& _function) override;
+
+	void assignValue(YulString _variable, Expression const* _value) override;
+
+private:
+	/// Variables whose current value might be equal to an expression, indexed by the
+	/// hash of the expression. Entries are only removed when they are found to be outdated,
+	/// so candidates still have to be compared to the current value of the variable.
+	std::unordered_map<uint64_t, std::set<YulString>> m_replacementCandidates;
 };
 
 }
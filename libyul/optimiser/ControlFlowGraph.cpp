@@ -0,0 +1,405 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Control flow graph of a function with dominators, liveness and reaching definitions.
+ */
+
+#include <libyul/optimiser/ControlFlowGraph.h>
+
+#include <libyul/optimiser/NameCollector.h>
+#include <libyul/optimiser/Semantics.h>
+#include <libyul/AST.h>
+#include <libyul/Exceptions.h>
+
+#include <libsolutil/CommonData.h>
+#include <libsolutil/Visitor.h>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::yul;
+using namespace solidity::util;
+
+class ControlFlowGraph::Builder
+{
+public:
+	Builder(Dialect const& _dialect, ControlFlowGraph& _graph):
+		m_terminationFinder(_dialect),
+		m_graph(_graph)
+	{
+		newBlock();
+		newBlock();
+	}
+
+	void build(Block const& _body)
+	{
+		visitBlock(_body);
+		addEdge(m_current, exit);
+	}
+
+private:
+	size_t newBlock()
+	{
+		m_graph.m_blocks.emplace_back();
+		return m_graph.m_blocks.size() - 1;
+	}
+
+	void addEdge(size_t _from, size_t _to)
+	{
+		m_graph.m_blocks[_from].successors.emplace_back(_to);
+		m_graph.m_blocks[_to].predecessors.emplace_back(_from);
+	}
+
+	/// Ends the current block with a jump to @a _target and continues with unreachable code.
+	void jump(size_t _target)
+	{
+		addEdge(m_current, _target);
+		m_current = newBlock();
+	}
+
+	void visitBlock(Block const& _block)
+	{
+		for (Statement const& statement: _block.statements)
+			visitStatement(statement);
+	}
+
+	void visitStatement(Statement const& _statement)
+	{
+		auto simpleStatement = [&]() {
+			m_graph.m_blocks[m_current].statements.emplace_back(&_statement);
+			m_graph.m_blockOf[&_statement] = m_current;
+		};
+		std::visit(GenericVisitor{
+			[&](ExpressionStatement const&) {
+				simpleStatement();
+				if (m_terminationFinder.controlFlowKind(_statement) == TerminationFinder::ControlFlow::Terminate)
+					m_current = newBlock();
+			},
+			[&](VariableDeclaration const&) { simpleStatement(); },
+			[&](Assignment const&) { simpleStatement(); },
+			[&](If const& _if) {
+				size_t condition = m_current;
+				m_graph.m_blocks[condition].condition = _if.condition.get();
+				size_t body = newBlock();
+				size_t after = newBlock();
+				addEdge(condition, body);
+				addEdge(condition, after);
+				m_current = body;
+				visitBlock(_if.body);
+				addEdge(m_current, after);
+				m_current = after;
+			},
+			[&](Switch const& _switch) {
+				size_t condition = m_current;
+				m_graph.m_blocks[condition].condition = _switch.expression.get();
+				size_t after = newBlock();
+				bool hasDefault = false;
+				for (Case const& switchCase: _switch.cases)
+				{
+					hasDefault = hasDefault || !switchCase.value;
+					size_t body = newBlock();
+					addEdge(condition, body);
+					m_current = body;
+					visitBlock(switchCase.body);
+					addEdge(m_current, after);
+				}
+				if (!hasDefault)
+					addEdge(condition, after);
+				m_current = after;
+			},
+			[&](ForLoop const& _loop) {
+				visitBlock(_loop.pre);
+				size_t condition = newBlock();
+				addEdge(m_current, condition);
+				m_graph.m_blocks[condition].condition = _loop.condition.get();
+				size_t body = newBlock();
+				size_t post = newBlock();
+				size_t after = newBlock();
+				addEdge(condition, body);
+				addEdge(condition, after);
+
+				m_loops.emplace_back(post, after);
+				m_current = body;
+				visitBlock(_loop.body);
+				addEdge(m_current, post);
+				m_loops.pop_back();
+
+				m_current = post;
+				visitBlock(_loop.post);
+				addEdge(m_current, condition);
+				m_current = after;
+			},
+			[&](Break const&) {
+				yulAssert(!m_loops.empty(), "");
+				jump(m_loops.back().second);
+			},
+			[&](Continue const&) {
+				yulAssert(!m_loops.empty(), "");
+				jump(m_loops.back().first);
+			},
+			[&](Leave const&) { jump(exit); },
+			[&](FunctionDefinition const&) {},
+			[&](Block const& _block) { visitBlock(_block); }
+		}, _statement);
+	}
+
+	TerminationFinder m_terminationFinder;
+	ControlFlowGraph& m_graph;
+	size_t m_current = entry;
+	/// Targets of ``continue`` and ``break`` of the enclosing loops.
+	vector<pair<size_t, size_t>> m_loops;
+};
+
+namespace
+{
+
+vector<YulString> names(TypedNameList const& _variables)
+{
+	return applyMap(_variables, [](TypedName const& _variable) { return _variable.name; });
+}
+
+/// @returns the variables that are used by the expressions of @a _statement.
+set<YulString> uses(Statement const& _statement)
+{
+	set<YulString> result;
+	auto addUses = [&](Expression const* _expression) {
+		if (_expression)
+			for (auto const& reference: ReferencesCounter::countReferences(*_expression, ReferencesCounter::OnlyVariables))
+				result.insert(reference.first);
+	};
+	std::visit(GenericVisitor{
+		[&](ExpressionStatement const& _statement) { addUses(&_statement.expression); },
+		[&](VariableDeclaration const& _declaration) { addUses(_declaration.value.get()); },
+		[&](Assignment const& _assignment) { addUses(_assignment.value.get()); },
+		[&](auto const&) { yulAssert(false, ""); }
+	}, _statement);
+	return result;
+}
+
+/// @returns the variables that are assigned by @a _statement.
+vector<YulString> definitions(Statement const& _statement)
+{
+	if (auto const* declaration = get_if<VariableDeclaration>(&_statement))
+		return names(declaration->variables);
+	else if (auto const* assignment = get_if<Assignment>(&_statement))
+		return applyMap(assignment->variableNames, [](Identifier const& _variable) { return _variable.name; });
+	return {};
+}
+
+}
+
+ControlFlowGraph::ControlFlowGraph(Dialect const& _dialect, FunctionDefinition const& _function):
+	ControlFlowGraph(_dialect, _function.body, names(_function.parameters), names(_function.returnVariables))
+{
+}
+
+ControlFlowGraph::ControlFlowGraph(Dialect const& _dialect, Block const& _block):
+	ControlFlowGraph(_dialect, _block, {}, {})
+{
+}
+
+ControlFlowGraph::ControlFlowGraph(
+	Dialect const& _dialect,
+	Block const& _body,
+	vector<YulString> const& _parameters,
+	vector<YulString> const& _returnVariables
+)
+{
+	Builder{_dialect, *this}.build(_body);
+	computeDominators();
+	computeLiveness(_returnVariables);
+	computeReachingDefinitions(_parameters + _returnVariables);
+}
+
+size_t ControlFlowGraph::blockOf(Statement const& _statement) const
+{
+	auto it = m_blockOf.find(&_statement);
+	yulAssert(it != m_blockOf.end(), "Statement is not part of the control flow graph.");
+	return it->second;
+}
+
+size_t ControlFlowGraph::immediateDominator(size_t _block) const
+{
+	yulAssert(reachable(_block), "");
+	return m_immediateDominators[_block];
+}
+
+bool ControlFlowGraph::dominates(size_t _dominator, size_t _block) const
+{
+	if (!reachable(_block))
+		return false;
+	while (_block != _dominator && _block != entry)
+		_block = m_immediateDominators[_block];
+	return _block == _dominator;
+}
+
+void ControlFlowGraph::computeDominators()
+{
+	// Reverse postorder of the reachable blocks.
+	vector<size_t> postorder;
+	vector<bool> visited(m_blocks.size(), false);
+	// Blocks on the path from the entry with the index of the next successor to visit.
+	vector<pair<size_t, size_t>> path{{entry, 0}};
+	visited[entry] = true;
+	while (!path.empty())
+	{
+		auto& [block, successor] = path.back();
+		if (successor < m_blocks[block].successors.size())
+		{
+			size_t next = m_blocks[block].successors[successor++];
+			if (!visited[next])
+			{
+				visited[next] = true;
+				path.emplace_back(next, 0);
+			}
+		}
+		else
+		{
+			postorder.emplace_back(block);
+			path.pop_back();
+		}
+	}
+	m_order.assign(m_blocks.size(), unreachable);
+	for (size_t i = 0; i < postorder.size(); ++i)
+		m_order[postorder[i]] = postorder.size() - 1 - i;
+
+	// "A Simple, Fast Dominance Algorithm" by Cooper, Harvey and Kennedy.
+	m_immediateDominators.assign(m_blocks.size(), unreachable);
+	m_immediateDominators[entry] = entry;
+	auto intersect = [&](size_t _a, size_t _b) {
+		while (_a != _b)
+		{
+			while (m_order[_a] > m_order[_b])
+				_a = m_immediateDominators[_a];
+			while (m_order[_b] > m_order[_a])
+				_b = m_immediateDominators[_b];
+		}
+		return _a;
+	};
+	for (bool changed = true; changed;)
+	{
+		changed = false;
+		for (auto it = postorder.rbegin(); it != postorder.rend(); ++it)
+		{
+			size_t block = *it;
+			if (block == entry)
+				continue;
+			size_t dominator = unreachable;
+			for (size_t predecessor: m_blocks[block].predecessors)
+				if (m_immediateDominators[predecessor] != unreachable)
+					dominator = dominator == unreachable ? predecessor : intersect(predecessor, dominator);
+			if (m_immediateDominators[block] != dominator)
+			{
+				m_immediateDominators[block] = dominator;
+				changed = true;
+			}
+		}
+	}
+}
+
+void ControlFlowGraph::computeLiveness(vector<YulString> const& _returnVariables)
+{
+	m_liveIn.assign(m_blocks.size(), {});
+	m_liveOut.assign(m_blocks.size(), {});
+	m_liveIn[exit] = m_liveOut[exit] = {_returnVariables.begin(), _returnVariables.end()};
+
+	// Variables used in a block before they are assigned and variables assigned in it.
+	vector<set<YulString>> used(m_blocks.size());
+	vector<set<YulString>> assigned(m_blocks.size());
+	for (size_t block = 0; block < m_blocks.size(); ++block)
+	{
+		if (m_blocks[block].condition)
+			for (auto const& reference: ReferencesCounter::countReferences(
+				*m_blocks[block].condition,
+				ReferencesCounter::OnlyVariables
+			))
+				used[block].insert(reference.first);
+		for (auto it = m_blocks[block].statements.rbegin(); it != m_blocks[block].statements.rend(); ++it)
+		{
+			Statement const& statement = **it;
+			for (YulString variable: definitions(statement))
+			{
+				used[block].erase(variable);
+				assigned[block].insert(variable);
+			}
+			used[block] += uses(statement);
+		}
+	}
+
+	for (bool changed = true; changed;)
+	{
+		changed = false;
+		for (size_t block = m_blocks.size(); block-- > 0;)
+		{
+			if (block == exit)
+				continue;
+			set<YulString> liveOut;
+			for (size_t successor: m_blocks[block].successors)
+				liveOut += m_liveIn[successor];
+			set<YulString> liveIn = used[block];
+			for (YulString variable: liveOut)
+				if (!assigned[block].count(variable))
+					liveIn.insert(variable);
+			if (liveIn != m_liveIn[block] || liveOut != m_liveOut[block])
+			{
+				m_liveIn[block] = move(liveIn);
+				m_liveOut[block] = move(liveOut);
+				changed = true;
+			}
+		}
+	}
+}
+
+void ControlFlowGraph::computeReachingDefinitions(vector<YulString> const& _initialVariables)
+{
+	m_reachingDefinitions.assign(m_blocks.size(), {});
+	for (YulString variable: _initialVariables)
+		m_reachingDefinitions[entry][variable] = {nullptr};
+
+	vector<size_t> order;
+	for (size_t block = 0; block < m_blocks.size(); ++block)
+		if (reachable(block))
+			order.emplace_back(block);
+	sort(order.begin(), order.end(), [&](size_t _a, size_t _b) { return m_order[_a] < m_order[_b]; });
+
+	auto definitionsAtEnd = [&](size_t _block) {
+		map<YulString, set<Definition>> result = m_reachingDefinitions[_block];
+		for (Statement const* statement: m_blocks[_block].statements)
+			for (YulString variable: definitions(*statement))
+				result[variable] = {statement};
+		return result;
+	};
+	for (bool changed = true; changed;)
+	{
+		changed = false;
+		for (size_t block: order)
+		{
+			if (block == entry)
+				continue;
+			map<YulString, set<Definition>> reaching;
+			for (size_t predecessor: m_blocks[block].predecessors)
+				if (reachable(predecessor))
+					for (auto&& [variable, variableDefinitions]: definitionsAtEnd(predecessor))
+						reaching[variable] += variableDefinitions;
+			if (reaching != m_reachingDefinitions[block])
+			{
+				m_reachingDefinitions[block] = move(reaching);
+				changed = true;
+			}
+		}
+	}
+}
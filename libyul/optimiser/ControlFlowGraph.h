@@ -0,0 +1,124 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Control flow graph of a function with dominators, liveness and reaching definitions.
+ */
+
+#pragma once
+
+#include <libyul/ASTForward.h>
+#include <libyul/YulString.h>
+
+#include <map>
+#include <set>
+#include <vector>
+
+namespace solidity::yul
+{
+struct Dialect;
+
+/**
+ * Control flow graph of the body of a function or of a block outside of functions, together
+ * with the dominator tree, the live variables and the reaching definitions of each basic block.
+ *
+ * A basic block consists of the variable declarations, assignments and expression statements
+ * that are executed in sequence, followed by an optional condition: the condition of an
+ * if statement or for loop or the expression of a switch. The successors of a block with a
+ * condition are the bodies in the order of the cases or the body followed by the block after
+ * the statement. Blocks are identified by their index. Control flow enters at the entry block
+ * and leaves the function at the exit block, which is empty. Blocks ending in a call to a
+ * terminating builtin have no successors. The code after ``break``, ``continue``, ``leave``
+ * or terminating calls is placed in blocks without predecessors.
+ *
+ * Function definitions nested in the code are skipped, they have their own graphs.
+ *
+ * The graph refers to the AST, which must not be modified while the graph is used.
+ *
+ * Prerequisite: Disambiguator
+ */
+class ControlFlowGraph
+{
+public:
+	struct BasicBlock
+	{
+		/// Variable declarations, assignments and expression statements in the order of execution.
+		std::vector<Statement const*> statements;
+		/// Expression evaluated at the end of the block that selects the successor, if any.
+		Expression const* condition = nullptr;
+		std::vector<size_t> successors;
+		std::vector<size_t> predecessors;
+	};
+	/// Variable declaration or assignment that defines a variable. Null for the value of a
+	/// parameter or the initial value of a return variable.
+	using Definition = Statement const*;
+
+	ControlFlowGraph(Dialect const& _dialect, FunctionDefinition const& _function);
+	ControlFlowGraph(Dialect const& _dialect, Block const& _block);
+
+	static size_t constexpr entry = 0;
+	static size_t constexpr exit = 1;
+
+	std::vector<BasicBlock> const& blocks() const { return m_blocks; }
+	/// @returns the block that contains @a _statement. The statement has to be a variable
+	/// declaration, assignment or expression statement of the graph.
+	size_t blockOf(Statement const& _statement) const;
+
+	bool reachable(size_t _block) const { return m_immediateDominators[_block] != unreachable; }
+	/// @returns the immediate dominator of a reachable block, the entry block for itself.
+	size_t immediateDominator(size_t _block) const;
+	/// @returns true if every path from the entry to @a _block passes through @a _dominator.
+	bool dominates(size_t _dominator, size_t _block) const;
+
+	/// The variables whose current values are used later on, at the beginning and at the end
+	/// of a block. The return variables are live at the end of the function.
+	std::set<YulString> const& liveIn(size_t _block) const { return m_liveIn[_block]; }
+	std::set<YulString> const& liveOut(size_t _block) const { return m_liveOut[_block]; }
+
+	/// The definitions of each variable that can reach the beginning of a block.
+	std::map<YulString, std::set<Definition>> const& reachingDefinitions(size_t _block) const
+	{
+		return m_reachingDefinitions[_block];
+	}
+
+private:
+	static size_t constexpr unreachable = size_t(-1);
+
+	class Builder;
+
+	ControlFlowGraph(
+		Dialect const& _dialect,
+		Block const& _body,
+		std::vector<YulString> const& _parameters,
+		std::vector<YulString> const& _returnVariables
+	);
+
+	void computeDominators();
+	void computeLiveness(std::vector<YulString> const& _returnVariables);
+	void computeReachingDefinitions(std::vector<YulString> const& _initialVariables);
+
+	std::vector<BasicBlock> m_blocks;
+	std::map<Statement const*, size_t> m_blockOf;
+	std::vector<size_t> m_immediateDominators;
+	/// Position of each reachable block in reverse postorder.
+	std::vector<size_t> m_order;
+	std::vector<std::set<YulString>> m_liveIn;
+	std::vector<std::set<YulString>> m_liveOut;
+	std::vector<std::map<YulString, std::set<Definition>>> m_reachingDefinitions;
+};
+
+}
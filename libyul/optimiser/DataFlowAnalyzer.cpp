@@ -29,7 +29,6 @@
 #include <libyul/Exceptions.h>
 
 #include <libsolutil/CommonData.h>
-#include <libsolutil/cxx20.h>
 
 #include <boost/range/adaptor/reversed.hpp>
 #include <boost/range/algorithm_ext/erase.hpp>
@@ -63,20 +62,20 @@ void DataFlowAnalyzer::operator()(ExpressionStatement& _statement)
 	if (auto vars = isSimpleStore(StoreLoadLocation::Storage, _statement))
 	{
 		ASTModifier::operator()(_statement);
-		cxx20::erase_if(m_storage, mapTuple([&](auto&& key, auto&& value) {
+		eraseKnowledgeIf(StoreLoadLocation::Storage, [&](YulString _key, YulString _value) {
 			return
-				!m_knowledgeBase.knownToBeDifferent(vars->first, key) &&
-				!m_knowledgeBase.knownToBeEqual(vars->second, value);
-		}));
-		m_storage[vars->first] = vars->second;
+				!m_knowledgeBase.knownToBeDifferent(vars->first, _key) &&
+				!m_knowledgeBase.knownToBeEqual(vars->second, _value);
+		});
+		setKnowledge(StoreLoadLocation::Storage, vars->first, vars->second);
 	}
 	else if (auto vars = isSimpleStore(StoreLoadLocation::Memory, _statement))
 	{
 		ASTModifier::operator()(_statement);
-		cxx20::erase_if(m_memory, mapTuple([&](auto&& key, auto&& /* value */) {
-			return !m_knowledgeBase.knownToBeDifferentByAtLeast32(vars->first, key);
-		}));
-		m_memory[vars->first] = vars->second;
+		eraseKnowledgeIf(StoreLoadLocation::Memory, [&](YulString _key, YulString) {
+			return !m_knowledgeBase.knownToBeDifferentByAtLeast32(vars->first, _key);
+		});
+		setKnowledge(StoreLoadLocation::Memory, vars->first, vars->second);
 	}
 	else
 	{
@@ -115,12 +114,11 @@ void DataFlowAnalyzer::operator()(VariableDeclaration& _varDecl)
 void DataFlowAnalyzer::operator()(If& _if)
 {
 	clearKnowledgeIfInvalidated(*_if.condition);
-	unordered_map<YulString, YulString> storage = m_storage;
-	unordered_map<YulString, YulString> memory = m_memory;
+	startBranch();
 
 	ASTModifier::operator()(_if);
 
-	joinKnowledge(storage, memory);
+	joinKnowledge();
 
 	Assignments assignments;
 	assignments(_if.body);
@@ -134,10 +132,9 @@ void DataFlowAnalyzer::operator()(Switch& _switch)
 	set<YulString> assignedVariables;
 	for (auto& _case: _switch.cases)
 	{
-		unordered_map<YulString, YulString> storage = m_storage;
-		unordered_map<YulString, YulString> memory = m_memory;
+		startBranch();
 		(*this)(_case.body);
-		joinKnowledge(storage, memory);
+		joinKnowledge();
 
 		Assignments assignments;
 		assignments(_case.body);
@@ -160,11 +157,13 @@ void DataFlowAnalyzer::operator()(FunctionDefinition& _fun)
 	unordered_map<YulString, set<YulString>> references;
 	unordered_map<YulString, YulString> storage;
 	unordered_map<YulString, YulString> memory;
+	vector<BranchStart> branches;
 	swap(m_value, value);
 	swap(m_loopDepth, loopDepth);
 	swap(m_references, references);
 	swap(m_storage, storage);
 	swap(m_memory, memory);
+	swap(m_branches, branches);
 	pushScope(true);
 
 	for (auto const& parameter: _fun.parameters)
@@ -186,6 +185,7 @@ void DataFlowAnalyzer::operator()(FunctionDefinition& _fun)
 	swap(m_references, references);
 	swap(m_storage, storage);
 	swap(m_memory, memory);
+	swap(m_branches, branches);
 }
 
 void DataFlowAnalyzer::operator()(ForLoop& _for)
@@ -258,14 +258,11 @@ void DataFlowAnalyzer::handleAssignment(set<YulString> const& _variables, Expres
 		m_references[name] = referencedVariables;
 		if (!_isDeclaration)
 		{
-			// assignment to slot denoted by "name"
-			m_storage.erase(name);
-			// assignment to slot contents denoted by "name"
-			cxx20::erase_if(m_storage, mapTuple([&name](auto&& /* key */, auto&& value) { return value == name; }));
-			// assignment to slot denoted by "name"
-			m_memory.erase(name);
-			// assignment to slot contents denoted by "name"
-			cxx20::erase_if(m_memory, mapTuple([&name](auto&& /* key */, auto&& value) { return value == name; }));
+			for (StoreLoadLocation location: {StoreLoadLocation::Storage, StoreLoadLocation::Memory})
+				// assignment to slot denoted by "name" or to slot contents denoted by "name"
+				eraseKnowledgeIf(location, [&name](YulString _key, YulString _value) {
+					return _key == name || _value == name;
+				});
 		}
 	}
 
@@ -278,9 +275,9 @@ void DataFlowAnalyzer::handleAssignment(set<YulString> const& _variables, Expres
 			// On the other hand, if we knew the value in the slot
 			// already, then the sload() / mload() would have been replaced by a variable anyway.
 			if (auto key = isSimpleLoad(StoreLoadLocation::Memory, *_value))
-				m_memory[*key] = variable;
+				setKnowledge(StoreLoadLocation::Memory, *key, variable);
 			else if (auto key = isSimpleLoad(StoreLoadLocation::Storage, *_value))
-				m_storage[*key] = variable;
+				setKnowledge(StoreLoadLocation::Storage, *key, variable);
 		}
 	}
 }
@@ -318,11 +315,11 @@ void DataFlowAnalyzer::clearValues(set<YulString> _variables)
 	// First clear storage knowledge, because we do not have to clear
 	// storage knowledge of variables whose expression has changed,
 	// since the value is still unchanged.
-	auto eraseCondition = mapTuple([&_variables](auto&& key, auto&& value) {
-		return _variables.count(key) || _variables.count(value);
-	});
-	cxx20::erase_if(m_storage, eraseCondition);
-	cxx20::erase_if(m_memory, eraseCondition);
+	auto eraseCondition = [&_variables](YulString _key, YulString _value) {
+		return _variables.count(_key) || _variables.count(_value);
+	};
+	eraseKnowledgeIf(StoreLoadLocation::Storage, eraseCondition);
+	eraseKnowledgeIf(StoreLoadLocation::Memory, eraseCondition);
 
 	// Also clear variables that reference variables to be cleared.
 	for (auto const& variableToClear: _variables)
@@ -346,43 +343,81 @@ void DataFlowAnalyzer::assignValue(YulString _variable, Expression const* _value
 void DataFlowAnalyzer::clearKnowledgeIfInvalidated(Block const& _block)
 {
 	SideEffectsCollector sideEffects(m_dialect, _block, &m_functionSideEffects);
+	auto all = [](YulString, YulString) { return true; };
 	if (sideEffects.invalidatesStorage())
-		m_storage.clear();
+		eraseKnowledgeIf(StoreLoadLocation::Storage, all);
 	if (sideEffects.invalidatesMemory())
-		m_memory.clear();
+		eraseKnowledgeIf(StoreLoadLocation::Memory, all);
 }
 
 void DataFlowAnalyzer::clearKnowledgeIfInvalidated(Expression const& _expr)
 {
 	SideEffectsCollector sideEffects(m_dialect, _expr, &m_functionSideEffects);
+	auto all = [](YulString, YulString) { return true; };
 	if (sideEffects.invalidatesStorage())
-		m_storage.clear();
+		eraseKnowledgeIf(StoreLoadLocation::Storage, all);
 	if (sideEffects.invalidatesMemory())
-		m_memory.clear();
+		eraseKnowledgeIf(StoreLoadLocation::Memory, all);
 }
 
-void DataFlowAnalyzer::joinKnowledge(
-	unordered_map<YulString, YulString> const& _olderStorage,
-	unordered_map<YulString, YulString> const& _olderMemory
-)
+void DataFlowAnalyzer::startBranch()
 {
-	joinKnowledgeHelper(m_storage, _olderStorage);
-	joinKnowledgeHelper(m_memory, _olderMemory);
+	m_branches.emplace_back();
 }
 
-void DataFlowAnalyzer::joinKnowledgeHelper(
-	std::unordered_map<YulString, YulString>& _this,
-	std::unordered_map<YulString, YulString> const& _older
-)
+void DataFlowAnalyzer::joinKnowledge()
 {
-	// We clear if the key does not exist in the older map or if the value is different.
-	// This also works for memory because _older is an "older version"
-	// of m_memory and thus any overlapping write would have cleared the keys
-	// that are not known to be different inside m_memory already.
-	cxx20::erase_if(_this, mapTuple([&_older](auto&& key, auto&& currentValue){
-		YulString const* oldValue = valueOrNullptr(_older, key);
-		return !oldValue || *oldValue != currentValue;
-	}));
+	assertThrow(!m_branches.empty(), OptimizerException, "");
+	BranchStart branchStart = move(m_branches.back());
+	m_branches.pop_back();
+
+	for (StoreLoadLocation location: {StoreLoadLocation::Storage, StoreLoadLocation::Memory})
+	{
+		auto& data = knowledge(location);
+		auto& previousValues = location == StoreLoadLocation::Storage ? branchStart.storage : branchStart.memory;
+		// Only the modified keys can differ from the start of the branch. We clear if the key
+		// did not exist at that point or if the value is different. This also works for memory
+		// because the start of the branch is an "older version" of the current knowledge and thus
+		// any overlapping write would have cleared the keys that are not known to be different already.
+		for (auto const& [key, previousValue]: previousValues)
+			if (auto it = data.find(key); it != data.end() && previousValue != it->second)
+				data.erase(it);
+
+		// The changes, including the ones above, are also changes of the enclosing branch.
+		// Its record of a key takes precedence because it is older.
+		if (!m_branches.empty())
+		{
+			auto& outerPreviousValues =
+				location == StoreLoadLocation::Storage ?
+				m_branches.back().storage :
+				m_branches.back().memory;
+			for (auto& [key, previousValue]: previousValues)
+				outerPreviousValues.emplace(key, move(previousValue));
+		}
+	}
+}
+
+void DataFlowAnalyzer::setKnowledge(StoreLoadLocation _location, YulString _key, YulString _value)
+{
+	recordChange(_location, _key);
+	knowledge(_location)[_key] = _value;
+}
+
+void DataFlowAnalyzer::recordChange(StoreLoadLocation _location, YulString _key)
+{
+	if (m_branches.empty())
+		return;
+	auto& previousValues =
+		_location == StoreLoadLocation::Storage ?
+		m_branches.back().storage :
+		m_branches.back().memory;
+	if (previousValues.count(_key))
+		return;
+	auto const& data = knowledge(_location);
+	if (auto it = data.find(_key); it != data.end())
+		previousValues.emplace(_key, it->second);
+	else
+		previousValues.emplace(_key, nullopt);
 }
 
 bool DataFlowAnalyzer::inScope(YulString _variableName) const
@@ -30,7 +30,10 @@
 #include <libyul/SideEffects.h>
 
 #include <map>
+#include <optional>
 #include <set>
+#include <unordered_map>
+#include <vector>
 
 namespace solidity::yul
 {
@@ -66,7 +69,9 @@ struct AssignedValue
  * If the keys or values are different or non-existent in one branch, the key is deleted.
  * This works also for memory (where addresses overlap) because one branch is always an
  * older version of the other and thus overlapping contents would have been deleted already
- * at the point of assignment.
+ * at the point of assignment. Instead of copying the storage/memory information at the start
+ * of a branch, only the previous values of the keys modified inside the branch are recorded,
+ * so that the cost of a branch does not depend on the amount of information.
  *
  * The DataFlowAnalyzer currently does not deal with the ``leave`` statement. This is because
  * it only matters at the end of a function body, which is a point in the code a derived class
@@ -110,7 +115,7 @@ protected:
 	/// for example at points where control flow is merged.
 	void clearValues(std::set<YulString> _names);
 
-	void assignValue(YulString _variable, Expression const* _value);
+	virtual void assignValue(YulString _variable, Expression const* _value);
 
 	/// Clears knowledge about storage or memory if they may be modified inside the block.
 	void clearKnowledgeIfInvalidated(Block const& _block);
@@ -118,18 +123,13 @@ protected:
 	/// Clears knowledge about storage or memory if they may be modified inside the expression.
 	void clearKnowledgeIfInvalidated(Expression const& _expression);
 
-	/// Joins knowledge about storage and memory with an older point in the control-flow.
-	/// This only works if the current state is a direct successor of the older point,
-	/// i.e. `_otherStorage` and `_otherMemory` cannot have additional changes.
-	void joinKnowledge(
-		std::unordered_map<YulString, YulString> const& _olderStorage,
-		std::unordered_map<YulString, YulString> const& _olderMemory
-	);
+	/// Marks the start of a branch of the control-flow, whose knowledge about storage and memory
+	/// will be joined with the current knowledge by joinKnowledge().
+	void startBranch();
 
-	static void joinKnowledgeHelper(
-		std::unordered_map<YulString, YulString>& _thisData,
-		std::unordered_map<YulString, YulString> const& _olderData
-	);
+	/// Joins knowledge about storage and memory with the point in the control-flow
+	/// at the matching call to startBranch().
+	void joinKnowledge();
 
 	/// Returns true iff the variable is in scope.
 	bool inScope(YulString _variableName) const;
@@ -154,6 +154,34 @@ protected:
 		Expression const& _expression
 	) const;
 
+	/// @returns the knowledge about storage or memory.
+	std::unordered_map<YulString, YulString>& knowledge(StoreLoadLocation _location)
+	{
+		return _location == StoreLoadLocation::Storage ? m_storage : m_memory;
+	}
+
+	/// Sets the knowledge about the contents of @a _key in storage or memory.
+	void setKnowledge(StoreLoadLocation _location, YulString _key, YulString _value);
+
+	/// Removes the knowledge about all keys and values for which @a _predicate is true.
+	template <class Predicate>
+	void eraseKnowledgeIf(StoreLoadLocation _location, Predicate const& _predicate)
+	{
+		auto& data = knowledge(_location);
+		for (auto it = data.begin(); it != data.end();)
+			if (_predicate(it->first, it->second))
+			{
+				recordChange(_location, it->first);
+				it = data.erase(it);
+			}
+			else
+				++it;
+	}
+
+	/// Records the current knowledge about @a _key for the innermost branch,
+	/// before the knowledge is modified.
+	void recordChange(StoreLoadLocation _location, YulString _key);
+
 	Dialect const& m_dialect;
 	/// Side-effects of user-defined functions. Worst-case side-effects are assumed
 	/// if this is not provided or the function is not found.
@@ -167,6 +195,16 @@ protected:
 	std::unordered_map<YulString, YulString> m_storage;
 	std::unordered_map<YulString, YulString> m_memory;
 
+	/// Knowledge about storage and memory at the start of a branch of the control flow,
+	/// for the keys that were modified since then.
+	struct BranchStart
+	{
+		std::unordered_map<YulString, std::optional<YulString>> storage;
+		std::unordered_map<YulString, std::optional<YulString>> memory;
+	};
+	/// Branches of the control-flow that are currently visited, innermost last.
+	std::vector<BranchStart> m_branches;
+
 	KnowledgeBase m_knowledgeBase;
 
 	YulString m_storeFunctionName[static_cast<unsigned>(StoreLoadLocation::Last) + 1];
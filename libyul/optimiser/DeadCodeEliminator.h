@@ -50,6 +50,7 @@ class DeadCodeEliminator: public ASTModifier
 {
 public:
 	static constexpr char const* name{"DeadCodeEliminator"};
+	static constexpr bool functionLocal = true;
 	static void run(OptimiserStepContext&, Block& _ast);
 
 	using ASTModifier::operator();
@@ -27,9 +27,16 @@ using namespace std;
 using namespace solidity;
 using namespace solidity::yul;
 
-void EquivalentFunctionCombiner::run(OptimiserStepContext&, Block& _ast)
+void EquivalentFunctionCombiner::run(OptimiserStepContext& _context, Block& _ast)
 {
-	EquivalentFunctionCombiner{EquivalentFunctionDetector::run(_ast)}(_ast);
+	map<YulString, FunctionDefinition const*> duplicates = EquivalentFunctionDetector::run(_ast);
+	// Calls are not redirected between functions that can and functions that cannot be inlined.
+	for (auto it = duplicates.begin(); it != duplicates.end();)
+		if (_context.noInlineFunctions.count(it->first) != _context.noInlineFunctions.count(it->second->name))
+			it = duplicates.erase(it);
+		else
+			++it;
+	EquivalentFunctionCombiner{move(duplicates)}(_ast);
 }
 
 void EquivalentFunctionCombiner::operator()(FunctionCall& _funCall)
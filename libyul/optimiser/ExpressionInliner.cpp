@@ -38,7 +38,10 @@ void ExpressionInliner::run(OptimiserStepContext& _context, Block& _ast)
 {
 	InlinableExpressionFunctionFinder funFinder;
 	funFinder(_ast);
-	ExpressionInliner inliner{_context.dialect, funFinder.inlinableFunctions()};
+	map<YulString, FunctionDefinition const*> inlinableFunctions = funFinder.inlinableFunctions();
+	for (YulString name: _context.noInlineFunctions)
+		inlinableFunctions.erase(name);
+	ExpressionInliner inliner{_context.dialect, inlinableFunctions};
 	inliner(_ast);
 }
 
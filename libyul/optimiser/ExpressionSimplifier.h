@@ -45,6 +45,7 @@ class ExpressionSimplifier: public DataFlowAnalyzer
 {
 public:
 	static constexpr char const* name{"ExpressionSimplifier"};
+	static constexpr bool functionLocal = true;
 	static void run(OptimiserStepContext&, Block& _ast);
 
 	using ASTModifier::operator();
@@ -42,13 +42,21 @@ using namespace solidity::yul;
 
 void FullInliner::run(OptimiserStepContext& _context, Block& _ast)
 {
-	FullInliner inliner{_ast, _context.dispenser, _context.dialect};
+	FullInliner inliner{_ast, _context.dispenser, _context.dialect, _context.noInlineFunctions};
 	inliner.run(Pass::InlineTiny);
 	inliner.run(Pass::InlineRest);
 }
 
-FullInliner::FullInliner(Block& _ast, NameDispenser& _dispenser, Dialect const& _dialect):
-	m_ast(_ast), m_nameDispenser(_dispenser), m_dialect(_dialect)
+FullInliner::FullInliner(
+	Block& _ast,
+	NameDispenser& _dispenser,
+	Dialect const& _dialect,
+	set<YulString> const& _noInlineFunctions
+):
+	m_ast(_ast),
+	m_noInlineFunctions(_noInlineFunctions),
+	m_nameDispenser(_dispenser),
+	m_dialect(_dialect)
 {
 	// Determine constants
 	SSAValueTracker tracker;
@@ -71,7 +79,7 @@ FullInliner::FullInliner(Block& _ast, NameDispenser& _dispenser, Dialect const&
 		// Always inline functions that are only called once.
 		if (references[fun.name] == 1)
 			m_singleUse.emplace(fun.name);
-		updateCodeSize(fun);
+		updateFunctionProperties(fun);
 	}
 }
 
@@ -101,7 +109,9 @@ void FullInliner::run(Pass _pass)
 	for (FunctionDefinition* fun: functions)
 	{
 		handleBlock(fun->name, fun->body);
-		updateCodeSize(*fun);
+		// The bodies of the other functions did not change, so their properties are still valid.
+		if (m_modifiedFunctions.erase(fun->name))
+			updateFunctionProperties(*fun);
 	}
 
 	for (auto& statement: m_ast.statements)
@@ -167,7 +177,7 @@ bool FullInliner::shallInline(FunctionCall const& _funCall, YulString _callSite)
 	if (!calledFunction)
 		return false;
 
-	if (m_noInlineFunctions.count(_funCall.functionName.name) || recursive(*calledFunction))
+	if (m_noInlineFunctions.count(_funCall.functionName.name) || m_recursiveFunctions.count(calledFunction->name))
 		return false;
 
 	// Inline really, really tiny functions
@@ -204,11 +214,16 @@ bool FullInliner::shallInline(FunctionCall const& _funCall, YulString _callSite)
 void FullInliner::tentativelyUpdateCodeSize(YulString _function, YulString _callSite)
 {
 	m_functionSizes.at(_callSite) += m_functionSizes.at(_function);
+	m_modifiedFunctions.insert(_callSite);
 }
 
-void FullInliner::updateCodeSize(FunctionDefinition const& _fun)
+void FullInliner::updateFunctionProperties(FunctionDefinition const& _fun)
 {
 	m_functionSizes[_fun.name] = CodeSize::codeSize(_fun.body);
+	if (ReferencesCounter::countReferences(_fun).count(_fun.name))
+		m_recursiveFunctions.insert(_fun.name);
+	else
+		m_recursiveFunctions.erase(_fun.name);
 }
 
 void FullInliner::handleBlock(YulString _currentFunctionName, Block& _block)
@@ -216,12 +231,6 @@ void FullInliner::handleBlock(YulString _currentFunctionName, Block& _block)
 	InlineModifier{*this, m_nameDispenser, _currentFunctionName, m_dialect}(_block);
 }
 
-bool FullInliner::recursive(FunctionDefinition const& _fun) const
-{
-	map<YulString, size_t> references = ReferencesCounter::countReferences(_fun);
-	return references[_fun.name] > 0;
-}
-
 void InlineModifier::operator()(Block& _block)
 {
 	function<std::optional<vector<Statement>>(Statement&)> f = [&](Statement& _statement) -> std::optional<vector<Statement>> {
@@ -87,35 +87,45 @@ public:
 
 	/// Adds the size of _funCall to the size of _callSite. This is just
 	/// a rough estimate that is done during inlining. The proper size
-	/// should be determined after inlining is completed.
+	/// is determined after inlining into _callSite is completed.
 	void tentativelyUpdateCodeSize(YulString _function, YulString _callSite);
 
 private:
 	enum Pass { InlineTiny, InlineRest };
 
-	FullInliner(Block& _ast, NameDispenser& _dispenser, Dialect const& _dialect);
+	FullInliner(
+		Block& _ast,
+		NameDispenser& _dispenser,
+		Dialect const& _dialect,
+		std::set<YulString> const& _noInlineFunctions = {}
+	);
 	void run(Pass _pass);
 
 	/// @returns a map containing the maximum depths of a call chain starting at each
 	/// function. For recursive functions, the value is one larger than for all others.
 	std::map<YulString, size_t> callDepths() const;
 
-	void updateCodeSize(FunctionDefinition const& _fun);
+	/// Measures the size of @a _fun and determines whether it calls itself.
+	void updateFunctionProperties(FunctionDefinition const& _fun);
 	void handleBlock(YulString _currentFunctionName, Block& _block);
-	bool recursive(FunctionDefinition const& _fun) const;
 
 	Pass m_pass;
 	/// The AST to be modified. The root block itself will not be modified, because
 	/// we store pointers to functions.
 	Block& m_ast;
 	std::map<YulString, FunctionDefinition*> m_functions;
-	/// Functions not to be inlined (because they contain the ``leave`` statement).
+	/// Functions not to be inlined (because they contain the ``leave`` statement or were
+	/// excluded from inlining by the caller).
 	std::set<YulString> m_noInlineFunctions;
 	/// Names of functions to always inline.
 	std::set<YulString> m_singleUse;
 	/// Variables that are constants (used for inlining heuristic)
 	std::set<YulString> m_constants;
 	std::map<YulString, size_t> m_functionSizes;
+	/// Functions that call themselves.
+	std::set<YulString> m_recursiveFunctions;
+	/// Functions that were inlined into since their properties were last determined.
+	std::set<YulString> m_modifiedFunctions;
 	NameDispenser& m_nameDispenser;
 	Dialect const& m_dialect;
 };
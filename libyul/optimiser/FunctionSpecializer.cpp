@@ -0,0 +1,176 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libyul/optimiser/FunctionSpecializer.h>
+
+#include <libyul/optimiser/CallGraphGenerator.h>
+#include <libyul/optimiser/FullInliner.h>
+#include <libyul/optimiser/Metrics.h>
+#include <libyul/optimiser/NameDispenser.h>
+#include <libyul/Dialect.h>
+#include <libyul/Exceptions.h>
+
+#include <libsolutil/CommonData.h>
+
+#include <algorithm>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::util;
+using namespace solidity::yul;
+
+namespace
+{
+
+bool sameLiteral(optional<Literal> const& _a, optional<Literal> const& _b)
+{
+	if (!_a || !_b)
+		return !_a && !_b;
+	return _a->kind == _b->kind && _a->value == _b->value && _a->type == _b->type;
+}
+
+bool sameArguments(vector<optional<Literal>> const& _a, vector<optional<Literal>> const& _b)
+{
+	return equal(_a.begin(), _a.end(), _b.begin(), _b.end(), sameLiteral);
+}
+
+}
+
+void FunctionSpecializer::run(OptimiserStepContext& _context, Block& _ast)
+{
+	map<YulString, FunctionDefinition const*> functions;
+	for (Statement const& statement: _ast.statements)
+		if (auto const* function = get_if<FunctionDefinition>(&statement))
+			functions[function->name] = function;
+
+	FunctionSpecializer specializer{
+		CallGraphGenerator::callGraph(_ast).recursiveFunctions(),
+		move(functions),
+		_context.dispenser,
+		_context.dialect
+	};
+	specializer(_ast);
+
+	for (auto const& [name, specializedFunctions]: specializer.m_specializedFunctions)
+		if (_context.noInlineFunctions.count(name))
+			for (FunctionDefinition const& specializedFunction: specializedFunctions)
+				_context.noInlineFunctions.insert(specializedFunction.name);
+
+	iterateReplacing(_ast.statements, [&](Statement& _statement) -> optional<vector<Statement>> {
+		if (auto* function = get_if<FunctionDefinition>(&_statement))
+			if (specializer.m_specializedFunctions.count(function->name))
+			{
+				vector<Statement> statements;
+				statements.emplace_back(move(*function));
+				for (FunctionDefinition& specializedFunction: specializer.m_specializedFunctions.at(get<FunctionDefinition>(statements.front()).name))
+					statements.emplace_back(move(specializedFunction));
+				return statements;
+			}
+		return nullopt;
+	});
+}
+
+void FunctionSpecializer::operator()(FunctionCall& _functionCall)
+{
+	ASTModifier::operator()(_functionCall);
+
+	YulString functionName = _functionCall.functionName.name;
+	if (m_dialect.builtin(functionName) || m_recursiveFunctions.count(functionName))
+		return;
+	auto function = m_functions.find(functionName);
+	yulAssert(function != m_functions.end(), "Function definition not found: " + functionName.str());
+
+	LiteralArguments arguments = applyMap(_functionCall.arguments, [](Expression const& _argument) {
+		return holds_alternative<Literal>(_argument) ? make_optional(get<Literal>(_argument)) : nullopt;
+	});
+	if (none_of(arguments.begin(), arguments.end(), [](auto const& _argument) { return _argument.has_value(); }))
+		return;
+
+	if (optional<YulString> specializedName = specialization(*function->second, arguments))
+	{
+		_functionCall.functionName.name = *specializedName;
+		_functionCall.arguments = filter(
+			_functionCall.arguments,
+			applyMap(arguments, [](auto const& _argument) { return !_argument.has_value(); })
+		);
+	}
+}
+
+optional<YulString> FunctionSpecializer::specialization(
+	FunctionDefinition const& _function,
+	LiteralArguments const& _arguments
+)
+{
+	vector<pair<LiteralArguments, YulString>>& specializations = m_specializations[_function.name];
+	for (auto const& [arguments, name]: specializations)
+		if (sameArguments(arguments, _arguments))
+			return name;
+
+	if (
+		specializations.size() >= MaxSpecializationsPerFunction ||
+		CodeSize::codeSize(_function.body) > MaxFunctionSize
+	)
+		return nullopt;
+
+	YulString name = m_nameDispenser.newName(_function.name);
+	specializations.emplace_back(_arguments, name);
+	m_specializedFunctions[_function.name].emplace_back(specialize(_function, name, _arguments));
+	return name;
+}
+
+FunctionDefinition FunctionSpecializer::specialize(
+	FunctionDefinition const& _function,
+	YulString _newName,
+	LiteralArguments const& _arguments
+)
+{
+	yulAssert(_arguments.size() == _function.parameters.size(), "");
+
+	map<YulString, YulString> translatedNames;
+	for (TypedName const& variable: _function.parameters + _function.returnVariables)
+		translatedNames[variable.name] = m_nameDispenser.newName(variable.name);
+
+	auto rename = [&](TypedName const& _variable) {
+		return TypedName{_variable.location, translatedNames.at(_variable.name), _variable.type};
+	};
+
+	TypedNameList parameters;
+	vector<Statement> initializations;
+	for (size_t i = 0; i < _arguments.size(); ++i)
+		if (_arguments[i])
+			initializations.emplace_back(VariableDeclaration{
+				_function.location,
+				{rename(_function.parameters[i])},
+				make_unique<Expression>(*_arguments[i])
+			});
+		else
+			parameters.emplace_back(rename(_function.parameters[i]));
+
+	Block body = get<Block>(BodyCopier(m_nameDispenser, translatedNames)(_function.body));
+	for (Statement& statement: body.statements)
+		initializations.emplace_back(move(statement));
+	body.statements = move(initializations);
+
+	return FunctionDefinition{
+		_function.location,
+		_newName,
+		move(parameters),
+		applyMap(_function.returnVariables, rename),
+		move(body)
+	};
+}
@@ -0,0 +1,120 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#pragma once
+
+#include <libyul/optimiser/ASTWalker.h>
+#include <libyul/optimiser/OptimiserStep.h>
+#include <libyul/AST.h>
+#include <libyul/YulString.h>
+
+#include <map>
+#include <optional>
+#include <set>
+#include <vector>
+
+namespace solidity::yul
+{
+
+struct Dialect;
+class NameDispenser;
+
+/**
+ * FunctionSpecializer: Optimiser step that specializes functions for their literal arguments.
+ *
+ * If a function, say `function f(a, b) { sstore (a, b) }`, is called with literal arguments, for
+ * example, `f(x, 5)`, where `x` is an identifier, it is specialized by creating a new function
+ * `f_1` that takes only one argument, i.e.,
+ *
+ * ```
+ * function f_1(a_1) {
+ *     let b_1 := 5
+ *     sstore(a_1, b_1)
+ * }
+ * ```
+ *
+ * and the call is replaced by `f_1(x)`. Other steps, like the ExpressionSimplifier and the
+ * steps that propagate constants, can then simplify the body of `f_1`, which the FullInliner
+ * may not be allowed to inline because of its size.
+ *
+ * Calls of the same function with the same literal arguments share one specialized function.
+ * Recursive functions are not specialized. To limit the growth of the code, only functions whose
+ * body is at most @a MaxFunctionSize large are specialized, with at most
+ * @a MaxSpecializationsPerFunction specialized versions per function and run. The original
+ * functions are kept and are removed by the UnusedPruner if they are not called anymore.
+ *
+ * Prerequisites: Disambiguator, FunctionHoister
+ *
+ * The step LiteralRematerialiser is not required for correctness. It turns arguments that are
+ * variables with literal values into literals and thus allows more specializations.
+ */
+class FunctionSpecializer: public ASTModifier
+{
+public:
+	/// Maximum size of the body of a function, measured with @a CodeSize, to be specialized.
+	static constexpr size_t MaxFunctionSize = 50;
+	/// Maximum number of specialized versions created for one function in one run.
+	static constexpr size_t MaxSpecializationsPerFunction = 8;
+
+	static constexpr char const* name{"FunctionSpecializer"};
+	static void run(OptimiserStepContext& _context, Block& _ast);
+
+	using ASTModifier::operator();
+	void operator()(FunctionCall& _functionCall) override;
+
+private:
+	/// The literal arguments of a call, with nullopt for arguments that are not literals.
+	using LiteralArguments = std::vector<std::optional<Literal>>;
+
+	FunctionSpecializer(
+		std::set<YulString> _recursiveFunctions,
+		std::map<YulString, FunctionDefinition const*> _functions,
+		NameDispenser& _nameDispenser,
+		Dialect const& _dialect
+	):
+		m_recursiveFunctions(std::move(_recursiveFunctions)),
+		m_functions(std::move(_functions)),
+		m_nameDispenser(_nameDispenser),
+		m_dialect(_dialect)
+	{}
+
+	/// @returns the name of the specialized version of @a _function for @a _arguments,
+	/// creating it if needed, or nullopt if the function is not specialized.
+	std::optional<YulString> specialization(FunctionDefinition const& _function, LiteralArguments const& _arguments);
+
+	/// @returns a copy of @a _function named @a _newName, in which the parameters with a literal
+	/// argument are replaced by variables initialized with these literals. All variables
+	/// are renamed, so that the names stay unique.
+	FunctionDefinition specialize(
+		FunctionDefinition const& _function,
+		YulString _newName,
+		LiteralArguments const& _arguments
+	);
+
+	std::set<YulString> const m_recursiveFunctions;
+	/// The functions of the code, which are all defined in the outermost block.
+	std::map<YulString, FunctionDefinition const*> const m_functions;
+	/// The literal arguments and names of the specialized versions of each function.
+	std::map<YulString, std::vector<std::pair<LiteralArguments, YulString>>> m_specializations;
+	/// The specialized versions of each function, to be inserted after it.
+	std::map<YulString, std::vector<FunctionDefinition>> m_specializedFunctions;
+	NameDispenser& m_nameDispenser;
+	Dialect const& m_dialect;
+};
+
+}
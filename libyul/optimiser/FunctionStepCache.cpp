@@ -0,0 +1,154 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Results of optimiser steps on single functions, reused between objects.
+ */
+
+#include <libyul/optimiser/FunctionStepCache.h>
+
+#include <libyul/optimiser/ASTCopier.h>
+#include <libyul/optimiser/ASTWalker.h>
+#include <libyul/optimiser/BlockHasher.h>
+
+#include <set>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::yul;
+
+namespace
+{
+
+/**
+ * Numbers the variables of a function in order of their first occurrence and hashes the
+ * sequence of the numbers of all occurrences.
+ */
+class VariableNumbering: public ASTWalker
+{
+public:
+	using ASTWalker::operator();
+	void operator()(FunctionDefinition const& _function) override
+	{
+		for (auto const* variables: {&_function.parameters, &_function.returnVariables})
+			for (TypedName const& variable: *variables)
+				occurrence(variable.name);
+		ASTWalker::operator()(_function);
+	}
+	void operator()(VariableDeclaration const& _varDecl) override
+	{
+		for (TypedName const& variable: _varDecl.variables)
+			occurrence(variable.name);
+		ASTWalker::operator()(_varDecl);
+	}
+	void operator()(Identifier const& _identifier) override { occurrence(_identifier.name); }
+
+	uint64_t hash = ASTHasherBase::fnvEmptyHash;
+	vector<YulString> variables;
+
+private:
+	void occurrence(YulString _name)
+	{
+		auto [it, inserted] = m_numbers.emplace(_name, variables.size());
+		if (inserted)
+			variables.emplace_back(_name);
+		hash = (hash * ASTHasherBase::fnvPrime) ^ it->second;
+	}
+
+	map<YulString, size_t> m_numbers;
+};
+
+/**
+ * Copies a function and renames its variables.
+ */
+class VariableRenamer: public ASTCopier
+{
+public:
+	explicit VariableRenamer(map<YulString, YulString> _translations): m_translations(move(_translations)) {}
+
+protected:
+	YulString translateIdentifier(YulString _name) override
+	{
+		auto it = m_translations.find(_name);
+		return it == m_translations.end() ? _name : it->second;
+	}
+
+private:
+	map<YulString, YulString> m_translations;
+};
+
+}
+
+FunctionStepCache::Shape FunctionStepCache::shape(FunctionDefinition const& _function)
+{
+	VariableNumbering numbering;
+	numbering(_function);
+
+	map<Block const*, uint64_t> blockHashes = BlockHasher::run(_function.body);
+	auto body = blockHashes.find(&_function.body);
+	uint64_t hash = body == blockHashes.end() ? ASTHasherBase::fnvEmptyHash : body->second;
+	for (uint64_t value: {numbering.hash, uint64_t(_function.parameters.size()), uint64_t(_function.returnVariables.size())})
+		hash = (hash * ASTHasherBase::fnvPrime) ^ value;
+	return Shape{hash, move(numbering.variables)};
+}
+
+FunctionStepCache::Lookup FunctionStepCache::find(
+	string const& _step,
+	FunctionDefinition const& _function,
+	Shape const& _shape,
+	FunctionDefinition& _result
+) const
+{
+	auto it = m_results.find({_step, _shape.hash});
+	if (it == m_results.end() || it->second.variables.size() != _shape.variables.size())
+		return Lookup::Unknown;
+	Result const& result = it->second;
+	if (!result.output)
+		return Lookup::Unchanged;
+
+	map<YulString, YulString> translations;
+	for (size_t i = 0; i < result.variables.size(); ++i)
+		translations[result.variables[i]] = _shape.variables[i];
+	_result = std::get<FunctionDefinition>(VariableRenamer{move(translations)}(*result.output));
+	_result.name = _function.name;
+	_result.location = _function.location;
+	return Lookup::Changed;
+}
+
+void FunctionStepCache::record(string const& _step, Shape const& _input, FunctionDefinition const& _output)
+{
+	Shape output = shape(_output);
+	Result result{_input.variables, nullopt};
+	if (output.hash != _input.hash || output.variables != _input.variables)
+	{
+		// Results that use variables the input does not have cannot be renamed.
+		set<YulString> inputVariables(_input.variables.begin(), _input.variables.end());
+		for (YulString variable: output.variables)
+			if (!inputVariables.count(variable))
+				return;
+		result.output = std::get<FunctionDefinition>(ASTCopier{}(_output));
+	}
+	m_results.emplace(make_pair(_step, _input.hash), move(result));
+}
+
+void FunctionStepCache::merge(FunctionStepCache&& _other)
+{
+	if (m_results.empty())
+		swap(m_results, _other.m_results);
+	else
+		m_results.merge(_other.m_results);
+}
@@ -0,0 +1,92 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Results of optimiser steps on single functions, reused between objects.
+ */
+
+#pragma once
+
+#include <libyul/AST.h>
+#include <libyul/YulString.h>
+
+#include <cstdint>
+#include <map>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace solidity::yul
+{
+
+/**
+ * Records how optimiser steps that are independent of other functions (see
+ * OptimiserStep::independentOfOtherFunctions) transform single functions, so that
+ * the results can be reused for functions that are equal up to the names of their
+ * variables. An object usually shares many functions with its sub-objects, for example
+ * the helper functions of the creation and the runtime code of a contract.
+ *
+ * The steps do not introduce new names, so a reused result only has to be renamed to
+ * the variables of the function it is used for. Since steps can break ties depending on
+ * the names of variables, it can still differ from the result the step would produce for
+ * that function, but it is an equally valid transformation of it.
+ */
+class FunctionStepCache
+{
+public:
+	/// Structure of a function with the names of its variables replaced by their position in
+	/// @a variables, the list of the variables in order of their first occurrence.
+	struct Shape
+	{
+		uint64_t hash = 0;
+		std::vector<YulString> variables;
+	};
+	static Shape shape(FunctionDefinition const& _function);
+
+	enum class Lookup { Unknown, Unchanged, Changed };
+
+	/// Looks up the result of applying the step @a _step to @a _function, whose shape is @a _shape.
+	/// If the step changes the function, @a _result is set to the result, renamed to the variables
+	/// of @a _function.
+	Lookup find(
+		std::string const& _step,
+		FunctionDefinition const& _function,
+		Shape const& _shape,
+		FunctionDefinition& _result
+	) const;
+
+	/// Records that the step @a _step transformed a function of shape @a _input into @a _output.
+	void record(std::string const& _step, Shape const& _input, FunctionDefinition const& _output);
+
+	/// Adds the results of @a _other for the functions that have no results yet.
+	void merge(FunctionStepCache&& _other);
+
+	bool empty() const { return m_results.empty(); }
+
+private:
+	struct Result
+	{
+		std::vector<YulString> variables;
+		/// The transformed function, unless the step did not change it.
+		std::optional<FunctionDefinition> output;
+	};
+
+	std::map<std::pair<std::string, uint64_t>, Result> m_results;
+};
+
+}
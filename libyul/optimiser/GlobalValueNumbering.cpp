@@ -0,0 +1,318 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Optimisation stage that replaces expressions by variables with the same value number.
+ */
+
+#include <libyul/optimiser/GlobalValueNumbering.h>
+
+#include <libyul/optimiser/AnalysisManager.h>
+#include <libyul/optimiser/ASTWalker.h>
+#include <libyul/optimiser/Semantics.h>
+#include <libyul/optimiser/SimplificationRules.h>
+#include <libyul/AST.h>
+#include <libyul/Dialect.h>
+
+#include <libevmasm/AssemblyItem.h>
+#include <libevmasm/SemanticInformation.h>
+
+#include <libsolutil/CommonData.h>
+#include <libsolutil/Visitor.h>
+
+#include <algorithm>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::evmasm;
+using namespace solidity::util;
+using namespace solidity::yul;
+
+/// Numbers the blocks and statements of the AST in preorder, so that a variable is in scope at
+/// a statement if the position of the statement is in the range of the block that declares it.
+class GlobalValueNumbering::ScopeCollector: public ASTWalker
+{
+public:
+	using ASTWalker::operator();
+
+	void operator()(Block const& _block) override
+	{
+		Block const* outerBlock = m_currentBlock;
+		m_currentBlock = &_block;
+		size_t begin = m_position++;
+		for (Statement const& statement: _block.statements)
+		{
+			size_t position = m_position++;
+			statementPositions[&statement] = position;
+			if (auto const* ifStatement = get_if<If>(&statement))
+				conditionPositions[ifStatement->condition.get()] = position;
+			else if (auto const* switchStatement = get_if<Switch>(&statement))
+				conditionPositions[switchStatement->expression.get()] = position;
+			else if (auto const* forLoop = get_if<ForLoop>(&statement))
+				conditionPositions[forLoop->condition.get()] = position;
+			visit(statement);
+		}
+		blockRanges[&_block] = {begin, m_position};
+		m_currentBlock = outerBlock;
+	}
+	void operator()(VariableDeclaration const& _varDecl) override
+	{
+		for (TypedName const& variable: _varDecl.variables)
+			declaringBlocks[variable.name] = m_currentBlock;
+		ASTWalker::operator()(_varDecl);
+	}
+	void operator()(Assignment const& _assignment) override
+	{
+		for (Identifier const& variable: _assignment.variableNames)
+			assigned.insert(variable.name);
+		ASTWalker::operator()(_assignment);
+	}
+	void operator()(FunctionDefinition const& _function) override
+	{
+		functions.push_back(&_function);
+		ASTWalker::operator()(_function);
+	}
+
+	map<Statement const*, size_t> statementPositions;
+	/// Positions of the conditions of if statements and loops and of the expressions of switch
+	/// statements, which are the positions of the statements.
+	map<Expression const*, size_t> conditionPositions;
+	/// Positions of the first and after the last statement of each block.
+	map<Block const*, pair<size_t, size_t>> blockRanges;
+	map<YulString, Block const*> declaringBlocks;
+	set<YulString> assigned;
+	vector<FunctionDefinition const*> functions;
+
+private:
+	Block const* m_currentBlock = nullptr;
+	size_t m_position = 0;
+};
+
+/// Replaces the expressions by the variables that hold their values.
+class GlobalValueNumbering::Replacer: public ASTModifier
+{
+public:
+	explicit Replacer(map<Expression const*, YulString> const& _replacements): m_replacements(_replacements) {}
+
+	using ASTModifier::operator();
+	void visit(Expression& _expression) override
+	{
+		if (YulString const* variable = valueOrNullptr(m_replacements, &_expression))
+			_expression = Identifier{locationOf(_expression), *variable};
+		else
+			ASTModifier::visit(_expression);
+	}
+
+private:
+	map<Expression const*, YulString> const& m_replacements;
+};
+
+void GlobalValueNumbering::run(OptimiserStepContext& _context, Block& _ast)
+{
+	ScopeCollector scopes;
+	scopes(_ast);
+
+	GlobalValueNumbering numbering{_context.dialect, SideEffectsPropagator::sideEffects(_context, _ast), scopes};
+	numbering.number(ControlFlowGraph{_context.dialect, _ast});
+	bool useAnalyses = _context.analyses && _context.analyses->tracks(_ast);
+	for (FunctionDefinition const* function: scopes.functions)
+		if (useAnalyses)
+			numbering.number(_context.analyses->controlFlowGraph(*function));
+		else
+			numbering.number(ControlFlowGraph{_context.dialect, *function});
+
+	// The graphs refer to the AST, so it is only modified after all of them were numbered.
+	Replacer{numbering.m_replacements}(_ast);
+}
+
+GlobalValueNumbering::GlobalValueNumbering(
+	Dialect const& _dialect,
+	map<YulString, SideEffects> _functionSideEffects,
+	ScopeCollector const& _scopes
+):
+	m_dialect(_dialect),
+	m_functionSideEffects(std::move(_functionSideEffects)),
+	m_scopes(_scopes)
+{
+}
+
+void GlobalValueNumbering::number(ControlFlowGraph const& _graph)
+{
+	m_graph = &_graph;
+	m_definitionNumbers.clear();
+	m_representatives.clear();
+
+	vector<vector<size_t>> children(_graph.blocks().size());
+	for (size_t block = 0; block < _graph.blocks().size(); ++block)
+		if (block != ControlFlowGraph::entry && _graph.reachable(block))
+			children[_graph.immediateDominator(block)].emplace_back(block);
+
+	// Visiting the dominator tree in preorder numbers every definition that is the only one
+	// reaching a block before the block, since it dominates the block.
+	vector<size_t> stack{ControlFlowGraph::entry};
+	while (!stack.empty())
+	{
+		size_t block = stack.back();
+		stack.pop_back();
+		numberBlock(block);
+		stack += children[block];
+	}
+
+	m_graph = nullptr;
+}
+
+void GlobalValueNumbering::numberBlock(size_t _block)
+{
+	m_variableNumbers.clear();
+	for (auto const& [variable, definitions]: m_graph->reachingDefinitions(_block))
+		m_variableNumbers[variable] =
+			definitions.size() == 1 ?
+			definitionNumber(*definitions.begin(), variable) :
+			newNumber();
+
+	ControlFlowGraph::BasicBlock const& block = m_graph->blocks()[_block];
+	for (size_t index = 0; index < block.statements.size(); ++index)
+	{
+		Statement const& statement = *block.statements[index];
+		size_t position = m_scopes.statementPositions.at(&statement);
+		auto define = [&](YulString _variable, optional<size_t> _value) {
+			size_t valueNumber = _value ? *_value : newNumber();
+			m_definitionNumbers[{&statement, _variable}] = valueNumber;
+			m_variableNumbers[_variable] = valueNumber;
+		};
+		std::visit(GenericVisitor{
+			[&](ExpressionStatement const& _statement) {
+				numberExpression(_statement.expression, _block, index, position);
+			},
+			[&](VariableDeclaration const& _varDecl) {
+				optional<size_t> value;
+				if (_varDecl.value)
+					value = numberExpression(*_varDecl.value, _block, index, position);
+				if (_varDecl.variables.size() != 1)
+					value = nullopt;
+				for (TypedName const& variable: _varDecl.variables)
+					define(variable.name, value);
+				if (value && !m_scopes.assigned.count(_varDecl.variables.front().name))
+					m_representatives[*value].emplace_back(
+						Representative{_varDecl.variables.front().name, _block, index}
+					);
+			},
+			[&](Assignment const& _assignment) {
+				optional<size_t> value = numberExpression(*_assignment.value, _block, index, position);
+				if (_assignment.variableNames.size() != 1)
+					value = nullopt;
+				for (Identifier const& variable: _assignment.variableNames)
+					define(variable.name, value);
+			},
+			[&](auto const&) { yulAssert(false, ""); }
+		}, statement);
+	}
+
+	if (block.condition)
+		numberExpression(
+			*block.condition,
+			_block,
+			block.statements.size(),
+			m_scopes.conditionPositions.at(block.condition)
+		);
+}
+
+optional<size_t> GlobalValueNumbering::numberExpression(
+	Expression const& _expression,
+	size_t _block,
+	size_t _index,
+	size_t _position
+)
+{
+	if (auto const* literal = get_if<Literal>(&_expression))
+	{
+		if (!m_literalNumbers.count(*literal))
+			m_literalNumbers[*literal] = newNumber();
+		return m_literalNumbers.at(*literal);
+	}
+	else if (auto const* identifier = get_if<Identifier>(&_expression))
+	{
+		if (!m_variableNumbers.count(identifier->name))
+			m_variableNumbers[identifier->name] = newNumber();
+		return m_variableNumbers.at(identifier->name);
+	}
+
+	FunctionCall const& call = std::get<FunctionCall>(_expression);
+	bool movable = false;
+	if (BuiltinFunction const* builtin = m_dialect.builtin(call.functionName.name))
+		movable = builtin->sideEffects.movable;
+	else if (SideEffects const* sideEffects = valueOrNullptr(m_functionSideEffects, call.functionName.name))
+		movable = sideEffects->movable;
+
+	vector<size_t> arguments;
+	for (Expression const& argument: call.arguments)
+		if (optional<size_t> argumentNumber = numberExpression(argument, _block, _index, _position))
+			arguments.emplace_back(*argumentNumber);
+		else
+			movable = false;
+	if (!movable)
+		return nullopt;
+
+	if (auto instruction = SimplificationRules::instructionAndArguments(m_dialect, _expression))
+		if (SemanticInformation::isCommutativeOperation(AssemblyItem{instruction->first}))
+			sort(arguments.begin(), arguments.end());
+
+	pair<YulString, vector<size_t>> key{call.functionName.name, move(arguments)};
+	if (!m_callNumbers.count(key))
+		m_callNumbers[key] = newNumber();
+	size_t valueNumber = m_callNumbers.at(key);
+
+	if (vector<Representative> const* representatives = valueOrNullptr(m_representatives, valueNumber))
+		for (Representative const& representative: *representatives)
+			if (available(representative, _block, _index, _position))
+			{
+				m_replacements[&_expression] = representative.variable;
+				break;
+			}
+
+	return valueNumber;
+}
+
+size_t GlobalValueNumbering::definitionNumber(ControlFlowGraph::Definition _definition, YulString _variable)
+{
+	// Parameters, return variables and definitions that do not dominate the block yet get
+	// a number of their own.
+	pair<ControlFlowGraph::Definition, YulString> key{_definition, _variable};
+	if (!m_definitionNumbers.count(key))
+		m_definitionNumbers[key] = newNumber();
+	return m_definitionNumbers.at(key);
+}
+
+bool GlobalValueNumbering::available(
+	Representative const& _representative,
+	size_t _block,
+	size_t _index,
+	size_t _position
+) const
+{
+	if (_representative.block == _block)
+	{
+		if (_representative.index >= _index)
+			return false;
+	}
+	else if (!m_graph->dominates(_representative.block, _block))
+		return false;
+
+	// Dominance does not imply scope, e.g. the body of a loop dominates its post block.
+	auto const& [begin, end] = m_scopes.blockRanges.at(m_scopes.declaringBlocks.at(_representative.variable));
+	return begin < _position && _position < end;
+}
@@ -0,0 +1,134 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Optimisation stage that replaces expressions by variables with the same value number.
+ */
+
+#pragma once
+
+#include <libyul/optimiser/ControlFlowGraph.h>
+#include <libyul/optimiser/OptimiserStep.h>
+#include <libyul/AST.h>
+#include <libyul/SideEffects.h>
+#include <libyul/Utilities.h>
+#include <libyul/YulString.h>
+
+#include <map>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace solidity::yul
+{
+
+struct Dialect;
+
+/**
+ * Global value numbering.
+ *
+ * Assigns a value number to each expression of a function, such that expressions with the
+ * same number have the same value, and replaces movable function calls by a variable that
+ * holds a value with the same number, if the declaration of the variable dominates the
+ * expression and the variable is in scope there. Other than the CommonSubexpressionEliminator,
+ * it compares values instead of expressions, so it sees through copies of variables and
+ * normalises the order of the arguments of commutative builtins, e.g.
+ *
+ *   let a := add(x, y)
+ *   let b := x
+ *   if c { sstore(0, mul(add(y, b), 2)) }
+ *
+ * is turned into
+ *
+ *   let a := add(x, y)
+ *   let b := x
+ *   if c { sstore(0, mul(a, 2)) }
+ *
+ * The blocks of the control flow graph of each function and of the code outside of functions
+ * are visited in the order of the dominator tree. Literals get a number by value, movable calls
+ * by the function and the numbers of the arguments. A variable that is read has the number
+ * of the value assigned by its definition, if exactly one definition reaches the read, and a
+ * new number otherwise. Only variables that are never reassigned are used as replacements,
+ * so the step works best on code in SSA form.
+ *
+ * Prerequisite: Disambiguator, ForLoopInitRewriter.
+ */
+class GlobalValueNumbering
+{
+public:
+	static constexpr char const* name{"GlobalValueNumbering"};
+	static void run(OptimiserStepContext& _context, Block& _ast);
+
+private:
+	/// Variable that holds a value with some number from its declaration on.
+	struct Representative
+	{
+		YulString variable;
+		/// Block of the control flow graph and index of the declaration in it.
+		size_t block;
+		size_t index;
+	};
+
+	class ScopeCollector;
+	class Replacer;
+
+	GlobalValueNumbering(
+		Dialect const& _dialect,
+		std::map<YulString, SideEffects> _functionSideEffects,
+		ScopeCollector const& _scopes
+	);
+
+	/// Numbers the expressions of the code in @a _graph and records their replacements.
+	void number(ControlFlowGraph const& _graph);
+	void numberBlock(size_t _block);
+
+	/// @returns the value number of @a _expression, which is evaluated before the statement with
+	/// index @a _index of block @a _block of the current graph and at position @a _position of
+	/// the AST, and records its replacement. Returns nullopt if the expression is not movable.
+	std::optional<size_t> numberExpression(
+		Expression const& _expression,
+		size_t _block,
+		size_t _index,
+		size_t _position
+	);
+	/// @returns the number of the value @a _definition assigns to @a _variable.
+	size_t definitionNumber(ControlFlowGraph::Definition _definition, YulString _variable);
+	size_t newNumber() { return m_nextNumber++; }
+
+	/// @returns true if @a _representative is available at the statement at @a _position,
+	/// which has index @a _index in block @a _block.
+	bool available(Representative const& _representative, size_t _block, size_t _index, size_t _position) const;
+
+	Dialect const& m_dialect;
+	std::map<YulString, SideEffects> const m_functionSideEffects;
+	ScopeCollector const& m_scopes;
+
+	size_t m_nextNumber = 0;
+	std::map<Literal, size_t, Less<Literal>> m_literalNumbers;
+	std::map<std::pair<YulString, std::vector<size_t>>, size_t> m_callNumbers;
+
+	/// State of the graph that is numbered.
+	ControlFlowGraph const* m_graph = nullptr;
+	std::map<std::pair<ControlFlowGraph::Definition, YulString>, size_t> m_definitionNumbers;
+	std::map<size_t, std::vector<Representative>> m_representatives;
+	/// Numbers of the current values of the variables in the block that is numbered.
+	std::map<YulString, size_t> m_variableNumbers;
+
+	std::map<Expression const*, YulString> m_replacements;
+};
+
+}
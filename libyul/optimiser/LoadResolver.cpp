@@ -23,10 +23,11 @@
 #include <libyul/optimiser/LoadResolver.h>
 
 #include <libyul/backends/evm/EVMDialect.h>
+#include <libyul/optimiser/NameCollector.h>
 #include <libyul/optimiser/Semantics.h>
-#include <libyul/optimiser/CallGraphGenerator.h>
 #include <libyul/SideEffects.h>
 #include <libyul/AST.h>
+#include <libyul/Utilities.h>
 
 using namespace std;
 using namespace solidity;
@@ -34,12 +35,37 @@ using namespace solidity::yul;
 
 void LoadResolver::run(OptimiserStepContext& _context, Block& _ast)
 {
-	bool containsMSize = MSizeFinder::containsMSize(_context.dialect, _ast);
-	LoadResolver{
-		_context.dialect,
-		SideEffectsPropagator::sideEffects(_context.dialect, CallGraphGenerator::callGraph(_ast)),
-		!containsMSize
-	}(_ast);
+	prepare(_context, _ast)(_ast);
+}
+
+function<void(Block&)> LoadResolver::prepare(OptimiserStepContext& _context, Block const& _ast)
+{
+	Assignments assignments;
+	assignments(_ast);
+	return [
+		&dialect = _context.dialect,
+		functionSideEffects = SideEffectsPropagator::sideEffects(_context, _ast),
+		containsMSize = MSizeFinder::containsMSize(_context, _ast),
+		assignedVariables = assignments.names()
+	](Block& _part) {
+		LoadResolver{dialect, functionSideEffects, !containsMSize, assignedVariables}(_part);
+	};
+}
+
+LoadResolver::LoadResolver(
+	Dialect const& _dialect,
+	map<YulString, SideEffects> _functionSideEffects,
+	bool _optimizeMLoad,
+	set<YulString> _assignedVariables
+):
+	DataFlowAnalyzer(_dialect, std::move(_functionSideEffects)),
+	m_optimizeMLoad(_optimizeMLoad),
+	m_assignedVariables(std::move(_assignedVariables))
+{
+	if (auto const* evmDialect = dynamic_cast<EVMDialect const*>(&_dialect))
+		if (auto const* builtin = evmDialect->builtin("keccak256"_yulstring))
+			if (builtin->instruction == evmasm::Instruction::KECCAK256)
+				m_keccakFunctionName = builtin->name;
 }
 
 void LoadResolver::visit(Expression& _e)
@@ -47,12 +73,37 @@ void LoadResolver::visit(Expression& _e)
 	DataFlowAnalyzer::visit(_e);
 
 	if (FunctionCall const* funCall = std::get_if<FunctionCall>(&_e))
+	{
 		for (auto location: { StoreLoadLocation::Memory, StoreLoadLocation::Storage })
 			if (funCall->functionName.name == m_loadFunctionName[static_cast<unsigned>(location)])
 			{
 				tryResolve(_e, location, funCall->arguments);
-				break;
+				return;
 			}
+
+		// Removing the call to keccak256 could change the size of memory.
+		if (m_optimizeMLoad && !m_keccakFunctionName.empty() && funCall->functionName.name == m_keccakFunctionName)
+			if (auto contents = keccakContents(*funCall))
+				if (auto value = util::valueOrNullptr(m_keccakResults, *contents))
+					if (inScope(*value))
+						_e = Identifier{locationOf(_e), *value};
+	}
+}
+
+void LoadResolver::operator()(VariableDeclaration& _varDecl)
+{
+	DataFlowAnalyzer::operator()(_varDecl);
+
+	if (
+		m_optimizeMLoad &&
+		!m_keccakFunctionName.empty() &&
+		_varDecl.variables.size() == 1 &&
+		!m_assignedVariables.count(_varDecl.variables.front().name)
+	)
+		if (FunctionCall const* funCall = get_if<FunctionCall>(_varDecl.value.get()))
+			if (funCall->functionName.name == m_keccakFunctionName)
+				if (auto contents = keccakContents(*funCall))
+					m_keccakResults[move(*contents)] = _varDecl.variables.front().name;
 }
 
 void LoadResolver::tryResolve(
@@ -76,3 +127,41 @@ void LoadResolver::tryResolve(
 			if (inScope(*value))
 				_e = Identifier{locationOf(_e), *value};
 }
+
+optional<vector<YulString>> LoadResolver::keccakContents(FunctionCall const& _funCall) const
+{
+	yulAssert(_funCall.arguments.size() == 2, "");
+	optional<u256> offset = knownConstant(_funCall.arguments.at(0));
+	optional<u256> length = knownConstant(_funCall.arguments.at(1));
+	if (!offset || !length || *length == 0 || *length % 32 != 0 || *length / 32 > m_memory.size())
+		return nullopt;
+	if (*offset + *length < *offset)
+		return nullopt;
+
+	vector<YulString> contents(static_cast<size_t>(*length / 32));
+	for (auto const& [key, value]: m_memory)
+		if (optional<u256> address = knownConstant(Identifier{{}, key}))
+			if (*address >= *offset && *address < *offset + *length && (*address - *offset) % 32 == 0)
+				contents[static_cast<size_t>((*address - *offset) / 32)] = value;
+	for (YulString content: contents)
+		if (content.empty() || m_assignedVariables.count(content))
+			return nullopt;
+	return contents;
+}
+
+optional<u256> LoadResolver::knownConstant(Expression const& _expression) const
+{
+	Expression const* expression = &_expression;
+	// The values of variables do not form cycles, see DataFlowAnalyzer::handleAssignment.
+	while (Identifier const* identifier = get_if<Identifier>(expression))
+	{
+		auto it = m_value.find(identifier->name);
+		if (it == m_value.end() || !it->second.value)
+			return nullopt;
+		expression = it->second.value;
+	}
+	if (Literal const* literal = get_if<Literal>(expression))
+		if (literal->kind == LiteralKind::Number)
+			return valueOfNumberLiteral(*literal);
+	return nullopt;
+}
@@ -25,6 +25,8 @@
 #include <libyul/optimiser/DataFlowAnalyzer.h>
 #include <libyul/optimiser/OptimiserStep.h>
 
+#include <libsolutil/Common.h>
+
 namespace solidity::yul
 {
 
@@ -32,6 +34,11 @@ namespace solidity::yul
  * Optimisation stage that replaces expressions of type ``sload(x)`` and ``mload(x)`` by the value
  * currently stored in storage resp. memory, if known.
  *
+ * It also replaces ``keccak256(p, l)`` by a variable assigned the hash of the same memory contents
+ * before, if the constant region from ``p`` to ``p + l`` consists of words whose contents are known
+ * to be the same variables as back then and all these variables are never re-assigned.
+ * This is the case for repeated accesses to the same slot of a mapping.
+ *
  * Works best if the code is in SSA form.
  *
  * Prerequisite: Disambiguator, ForLoopInitRewriter.
@@ -40,22 +47,24 @@ class LoadResolver: public DataFlowAnalyzer
 {
 public:
 	static constexpr char const* name{"LoadResolver"};
+	static constexpr bool functionLocal = true;
 	/// Run the load resolver on the given complete AST.
 	static void run(OptimiserStepContext&, Block& _ast);
+	static std::function<void(Block&)> prepare(OptimiserStepContext& _context, Block const& _ast);
 
 private:
 	LoadResolver(
 		Dialect const& _dialect,
 		std::map<YulString, SideEffects> _functionSideEffects,
-		bool _optimizeMLoad
-	):
-		DataFlowAnalyzer(_dialect, std::move(_functionSideEffects)),
-		m_optimizeMLoad(_optimizeMLoad)
-	{}
+		bool _optimizeMLoad,
+		std::set<YulString> _assignedVariables
+	);
 
 protected:
 	using ASTModifier::visit;
+	using DataFlowAnalyzer::operator();
 	void visit(Expression& _e) override;
+	void operator()(VariableDeclaration& _varDecl) override;
 
 	void tryResolve(
 		Expression& _e,
@@ -63,7 +72,18 @@ protected:
 		std::vector<Expression> const& _arguments
 	);
 
+	/// @returns the variables whose values are stored in the memory region hashed by the
+	/// call to ``keccak256`` @a _funCall, if the region is constant and all its words are known.
+	std::optional<std::vector<YulString>> keccakContents(FunctionCall const& _funCall) const;
+	/// @returns the value of @a _expression if it is a literal or a variable whose value is known to be a literal.
+	std::optional<u256> knownConstant(Expression const& _expression) const;
+
 	bool m_optimizeMLoad = false;
+	/// Variables that are re-assigned somewhere, i.e. whose values can change after their declaration.
+	std::set<YulString> m_assignedVariables;
+	YulString m_keccakFunctionName;
+	/// Variables holding the hash of the memory words that contained the given variables.
+	std::map<std::vector<YulString>, YulString> m_keccakResults;
 };
 
 }
@@ -18,11 +18,12 @@
 
 #include <libyul/optimiser/LoopInvariantCodeMotion.h>
 
-#include <libyul/optimiser/CallGraphGenerator.h>
 #include <libyul/optimiser/NameCollector.h>
 #include <libyul/optimiser/Semantics.h>
 #include <libyul/optimiser/SSAValueTracker.h>
 #include <libyul/AST.h>
+#include <libyul/Dialect.h>
+#include <libyul/Utilities.h>
 #include <libsolutil/CommonData.h>
 
 #include <utility>
@@ -31,13 +32,112 @@ using namespace std;
 using namespace solidity;
 using namespace solidity::yul;
 
+namespace
+{
+
+/**
+ * Collects the storage slots read and written via the storage load and store builtins.
+ * A set becomes unknown (std::nullopt) as soon as a slot that is not a known constant
+ * is accessed or storage is accessed in any other way.
+ */
+class StorageSlotCollector: public ASTWalker
+{
+public:
+	StorageSlotCollector(
+		Dialect const& _dialect,
+		map<YulString, SideEffects> const& _functionSideEffects,
+		map<YulString, u256> const& _constantVariables
+	):
+		m_dialect(_dialect),
+		m_functionSideEffects(_functionSideEffects),
+		m_constantVariables(_constantVariables),
+		m_storeFunction(_dialect.storageStoreFunction({})),
+		m_loadFunction(_dialect.storageLoadFunction({}))
+	{}
+
+	using ASTWalker::operator();
+	void operator()(FunctionCall const& _functionCall) override
+	{
+		ASTWalker::operator()(_functionCall);
+
+		YulString functionName = _functionCall.functionName.name;
+		if (m_storeFunction && functionName == m_storeFunction->name)
+			addSlot(m_slotsWritten, _functionCall.arguments.front());
+		else if (m_loadFunction && functionName == m_loadFunction->name)
+			addSlot(m_slotsRead, _functionCall.arguments.front());
+		else
+		{
+			SideEffects sideEffects = SideEffects::worst();
+			if (BuiltinFunction const* f = m_dialect.builtin(functionName))
+				sideEffects = f->sideEffects;
+			else if (m_functionSideEffects.count(functionName))
+				sideEffects = m_functionSideEffects.at(functionName);
+
+			if (sideEffects.storage != SideEffects::None)
+				m_slotsRead.reset();
+			if (sideEffects.storage == SideEffects::Write)
+				m_slotsWritten.reset();
+		}
+	}
+
+	optional<set<u256>> const& slotsRead() const { return m_slotsRead; }
+	optional<set<u256>> const& slotsWritten() const { return m_slotsWritten; }
+
+private:
+	void addSlot(optional<set<u256>>& _slots, Expression const& _slot)
+	{
+		if (!_slots)
+			return;
+		if (Literal const* literal = get_if<Literal>(&_slot))
+			_slots->insert(valueOfLiteral(*literal));
+		else if (
+			Identifier const* identifier = get_if<Identifier>(&_slot);
+			identifier && m_constantVariables.count(identifier->name)
+		)
+			_slots->insert(m_constantVariables.at(identifier->name));
+		else
+			_slots.reset();
+	}
+
+	Dialect const& m_dialect;
+	map<YulString, SideEffects> const& m_functionSideEffects;
+	map<YulString, u256> const& m_constantVariables;
+	BuiltinFunction const* m_storeFunction = nullptr;
+	BuiltinFunction const* m_loadFunction = nullptr;
+	optional<set<u256>> m_slotsRead = set<u256>{};
+	optional<set<u256>> m_slotsWritten = set<u256>{};
+};
+
+map<YulString, u256> constantVariables(Block const& _ast)
+{
+	SSAValueTracker tracker;
+	tracker(_ast);
+
+	map<YulString, u256> constants;
+	for (auto const& [name, value]: tracker.values())
+		if (Literal const* literal = get_if<Literal>(value))
+			constants[name] = valueOfLiteral(*literal);
+	return constants;
+}
+
+}
+
 void LoopInvariantCodeMotion::run(OptimiserStepContext& _context, Block& _ast)
 {
-	map<YulString, SideEffects> functionSideEffects =
-		SideEffectsPropagator::sideEffects(_context.dialect, CallGraphGenerator::callGraph(_ast));
-	bool containsMSize = MSizeFinder::containsMSize(_context.dialect, _ast);
-	set<YulString> ssaVars = SSAValueTracker::ssaVariables(_ast);
-	LoopInvariantCodeMotion{_context.dialect, ssaVars, functionSideEffects, containsMSize}(_ast);
+	prepare(_context, _ast)(_ast);
+}
+
+function<void(Block&)> LoopInvariantCodeMotion::prepare(OptimiserStepContext& _context, Block const& _ast)
+{
+	return [
+		&dialect = _context.dialect,
+		functionSideEffects = SideEffectsPropagator::sideEffects(_context, _ast),
+		containsMSize = MSizeFinder::containsMSize(_context, _ast),
+		ssaVars = SSAValueTracker::ssaVariables(_ast),
+		constants = constantVariables(_ast)
+	](Block& _part) {
+		LoopInvariantCodeMotion{dialect, ssaVars, functionSideEffects, constants, containsMSize}(_part);
+	};
 }
 
 void LoopInvariantCodeMotion::operator()(Block& _block)
@@ -58,7 +158,8 @@ void LoopInvariantCodeMotion::operator()(Block& _block)
 bool LoopInvariantCodeMotion::canBePromoted(
 	VariableDeclaration const& _varDecl,
 	set<YulString> const& _varsDefinedInCurrentScope,
-	SideEffects const& _forLoopSideEffects
+	SideEffects const& _forLoopSideEffects,
+	optional<set<u256>> const& _storageSlotsWrittenInLoop
 ) const
 {
 	// A declaration can be promoted iff
@@ -74,8 +175,21 @@ bool LoopInvariantCodeMotion::canBePromoted(
 		for (auto const& ref: ReferencesCounter::countReferences(*_varDecl.value, ReferencesCounter::OnlyVariables))
 			if (_varsDefinedInCurrentScope.count(ref.first) || !m_ssaVariables.count(ref.first))
 				return false;
+		SideEffects forLoopSideEffects = _forLoopSideEffects;
+		if (forLoopSideEffects.storage == SideEffects::Write && _storageSlotsWrittenInLoop)
+		{
+			// Writes to other slots than the ones read by the value do not prevent moving it.
+			StorageSlotCollector slots{m_dialect, m_functionSideEffects, m_constantVariables};
+			slots.visit(*_varDecl.value);
+			if (slots.slotsRead() && !util::contains_if(
+				*slots.slotsRead(),
+				[&](u256 const& _slot) { return _storageSlotsWrittenInLoop->count(_slot); }
+			))
+				forLoopSideEffects.storage = SideEffects::Read;
+		}
+
 		SideEffectsCollector sideEffects{m_dialect, *_varDecl.value, &m_functionSideEffects};
-		if (!sideEffects.movableRelativeTo(_forLoopSideEffects, m_containsMSize))
+		if (!sideEffects.movableRelativeTo(forLoopSideEffects, m_containsMSize))
 			return false;
 	}
 	return true;
@@ -87,6 +201,13 @@ optional<vector<Statement>> LoopInvariantCodeMotion::rewriteLoop(ForLoop& _for)
 
 	auto forLoopSideEffects =
 		SideEffectsCollector{m_dialect, _for, &m_functionSideEffects}.sideEffects();
+	optional<set<u256>> storageSlotsWritten;
+	if (forLoopSideEffects.storage == SideEffects::Write)
+	{
+		StorageSlotCollector slots{m_dialect, m_functionSideEffects, m_constantVariables};
+		slots(_for);
+		storageSlotsWritten = slots.slotsWritten();
+	}
 
 	vector<Statement> replacement;
 	for (Block* block: {&_for.post, &_for.body})
@@ -99,7 +220,7 @@ optional<vector<Statement>> LoopInvariantCodeMotion::rewriteLoop(ForLoop& _for)
 				if (holds_alternative<VariableDeclaration>(_s))
 				{
 					VariableDeclaration const& varDecl = std::get<VariableDeclaration>(_s);
-					if (canBePromoted(varDecl, varsDefinedInScope, forLoopSideEffects))
+					if (canBePromoted(varDecl, varsDefinedInScope, forLoopSideEffects, storageSlotsWritten))
 					{
 						replacement.emplace_back(std::move(_s));
 						// Do not add the variables declared here to varsDefinedInScope because we are moving them.
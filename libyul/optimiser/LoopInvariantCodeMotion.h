@@ -21,6 +21,8 @@
 #include <libyul/optimiser/Semantics.h>
 #include <libyul/optimiser/OptimiserStep.h>
 
+#include <libsolutil/Common.h>
+
 namespace solidity::yul
 {
 
@@ -32,6 +34,10 @@ namespace solidity::yul
  * Only statements at the top level in a loop's body or post block are considered, i.e variable
  * declarations inside conditional branches will not be moved out of the loop.
  *
+ * Reads from storage are moved even if the loop writes to storage, as long as all slots written
+ * inside the loop and all slots read by the moved expression are known constants and differ.
+ * A slot is a known constant if it is given by a literal or by an SSA variable with a literal value.
+ *
  * Requirements:
  * - The Disambiguator, ForLoopInitRewriter and FunctionHoister must be run upfront.
  * - Expression splitter and SSA transform should be run upfront to obtain better result.
@@ -41,7 +47,9 @@ class LoopInvariantCodeMotion: public ASTModifier
 {
 public:
 	static constexpr char const* name{"LoopInvariantCodeMotion"};
+	static constexpr bool functionLocal = true;
 	static void run(OptimiserStepContext& _context, Block& _ast);
+	static std::function<void(Block&)> prepare(OptimiserStepContext& _context, Block const& _ast);
 
 	void operator()(Block& _block) override;
 
@@ -50,19 +58,22 @@ private:
 		Dialect const& _dialect,
 		std::set<YulString> const& _ssaVariables,
 		std::map<YulString, SideEffects> const& _functionSideEffects,
+		std::map<YulString, u256> const& _constantVariables,
 		bool _containsMSize
 	):
 		m_containsMSize(_containsMSize),
 		m_dialect(_dialect),
 		m_ssaVariables(_ssaVariables),
-		m_functionSideEffects(_functionSideEffects)
+		m_functionSideEffects(_functionSideEffects),
+		m_constantVariables(_constantVariables)
 	{ }
 
 	/// @returns true if the given variable declaration can be moved to in front of the loop.
 	bool canBePromoted(
 		VariableDeclaration const& _varDecl,
 		std::set<YulString> const& _varsDefinedInCurrentScope,
-		SideEffects const& _forLoopSideEffects
+		SideEffects const& _forLoopSideEffects,
+		std::optional<std::set<u256>> const& _storageSlotsWrittenInLoop
 	) const;
 	std::optional<std::vector<Statement>> rewriteLoop(ForLoop& _for);
 
@@ -70,6 +81,8 @@ private:
 	Dialect const& m_dialect;
 	std::set<YulString> const& m_ssaVariables;
 	std::map<YulString, SideEffects> const& m_functionSideEffects;
+	/// Values of the SSA variables that are initialized with a literal.
+	std::map<YulString, u256> const& m_constantVariables;
 };
 
 }
@@ -0,0 +1,231 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libyul/optimiser/LoopUnroller.h>
+
+#include <libyul/optimiser/FullInliner.h>
+#include <libyul/optimiser/Metrics.h>
+#include <libyul/optimiser/NameCollector.h>
+#include <libyul/optimiser/NameDispenser.h>
+#include <libyul/backends/evm/EVMDialect.h>
+#include <libyul/backends/evm/EVMMetrics.h>
+#include <libyul/Utilities.h>
+
+#include <libsolutil/CommonData.h>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::util;
+using namespace solidity::yul;
+
+namespace
+{
+
+/**
+ * Finds `break` and `continue` statements that belong to the loop whose body is visited
+ * and function definitions, which prevent copying the body.
+ */
+class UnrollingBlocker: public ASTWalker
+{
+public:
+	static bool blocksUnrolling(Block const& _body)
+	{
+		UnrollingBlocker blocker;
+		blocker(_body);
+		return blocker.m_found;
+	}
+
+	using ASTWalker::operator();
+	void operator()(ForLoop const& _loop) override
+	{
+		++m_loopDepth;
+		ASTWalker::operator()(_loop);
+		--m_loopDepth;
+	}
+	void operator()(Break const&) override { m_found = m_found || m_loopDepth == 0; }
+	void operator()(Continue const&) override { m_found = m_found || m_loopDepth == 0; }
+	void operator()(FunctionDefinition const&) override { m_found = true; }
+
+private:
+	size_t m_loopDepth = 0;
+	bool m_found = false;
+};
+
+optional<evmasm::Instruction> instruction(EVMDialect const& _dialect, FunctionCall const& _call)
+{
+	if (BuiltinFunctionForEVM const* builtin = _dialect.builtin(_call.functionName.name))
+		return builtin->instruction;
+	return nullopt;
+}
+
+bool isIdentifier(Expression const& _expression, YulString _name)
+{
+	Identifier const* identifier = get_if<Identifier>(&_expression);
+	return identifier && identifier->name == _name;
+}
+
+optional<u256> numberLiteralValue(Expression const& _expression)
+{
+	Literal const* literal = get_if<Literal>(&_expression);
+	if (!literal || literal->kind != LiteralKind::Number)
+		return nullopt;
+	return valueOfLiteral(*literal);
+}
+
+}
+
+void LoopUnroller::run(OptimiserStepContext& _context, Block& _ast)
+{
+	if (auto const* dialect = dynamic_cast<EVMDialect const*>(&_context.dialect))
+		LoopUnroller{*dialect, _context.dispenser, _context.meter}(_ast);
+}
+
+void LoopUnroller::operator()(Block& _block)
+{
+	// Unroll inner loops first, so that their size is known.
+	ASTModifier::operator()(_block);
+
+	vector<Statement> statements;
+	for (Statement& statement: _block.statements)
+	{
+		if (ForLoop* loop = get_if<ForLoop>(&statement))
+		{
+			// The counter is declared in the initialization part or, after the ForLoopInitRewriter
+			// moved it out of the loop, by the preceding statement.
+			VariableDeclaration const* counter = nullptr;
+			if (loop->pre.statements.size() == 1)
+				counter = get_if<VariableDeclaration>(&loop->pre.statements.front());
+			else if (loop->pre.statements.empty() && !statements.empty())
+				counter = get_if<VariableDeclaration>(&statements.back());
+
+			optional<size_t> iterations = counter ? iterationCount(*loop, *counter) : nullopt;
+			if (iterations && worthUnrolling(*loop, *iterations))
+			{
+				vector<Statement> unrolled = unroll(*loop, *iterations);
+				if (loop->pre.statements.empty())
+					statements += move(unrolled);
+				else
+				{
+					Block replacement{loop->location, move(loop->pre.statements)};
+					replacement.statements += move(unrolled);
+					statements.emplace_back(move(replacement));
+				}
+				continue;
+			}
+		}
+		statements.emplace_back(move(statement));
+	}
+	_block.statements = move(statements);
+}
+
+optional<size_t> LoopUnroller::iterationCount(ForLoop const& _loop, VariableDeclaration const& _counter) const
+{
+	if (_counter.variables.size() != 1 || !_counter.value)
+		return nullopt;
+	YulString counter = _counter.variables.front().name;
+	optional<u256> start = numberLiteralValue(*_counter.value);
+	if (!start)
+		return nullopt;
+
+	optional<u256> end;
+	if (FunctionCall const* condition = get_if<FunctionCall>(_loop.condition.get()))
+	{
+		optional<evmasm::Instruction> conditionInstruction = instruction(m_dialect, *condition);
+		if (conditionInstruction == evmasm::Instruction::LT && isIdentifier(condition->arguments.at(0), counter))
+			end = numberLiteralValue(condition->arguments.at(1));
+		else if (conditionInstruction == evmasm::Instruction::GT && isIdentifier(condition->arguments.at(1), counter))
+			end = numberLiteralValue(condition->arguments.at(0));
+	}
+	if (!end)
+		return nullopt;
+
+	if (_loop.post.statements.size() != 1)
+		return nullopt;
+	Assignment const* increment = get_if<Assignment>(&_loop.post.statements.front());
+	if (!increment || increment->variableNames.size() != 1 || increment->variableNames.front().name != counter)
+		return nullopt;
+	FunctionCall const* sum = get_if<FunctionCall>(increment->value.get());
+	if (!sum || instruction(m_dialect, *sum) != evmasm::Instruction::ADD)
+		return nullopt;
+	optional<u256> step;
+	if (isIdentifier(sum->arguments.at(0), counter))
+		step = numberLiteralValue(sum->arguments.at(1));
+	else if (isIdentifier(sum->arguments.at(1), counter))
+		step = numberLiteralValue(sum->arguments.at(0));
+	if (!step || *step == 0)
+		return nullopt;
+
+	Assignments assignments;
+	assignments(_loop.body);
+	if (assignments.names().count(counter) || UnrollingBlocker::blocksUnrolling(_loop.body))
+		return nullopt;
+
+	size_t iterations = 0;
+	bigint value = *start;
+	for (; value < *end; value += *step)
+		if (++iterations > MaxIterations)
+			return nullopt;
+	// The loop would continue with a wrapped around counter.
+	if (value > numeric_limits<u256>::max())
+		return nullopt;
+	return iterations;
+}
+
+bool LoopUnroller::worthUnrolling(ForLoop const& _loop, size_t _iterations) const
+{
+	if (_iterations == 0)
+		return true;
+
+	size_t iterationSize = CodeSize::codeSize(_loop.body) + CodeSize::codeSize(_loop.post);
+	if (iterationSize * _iterations > MaxUnrolledSize)
+		return false;
+	if (!m_meter)
+		return true;
+
+	// The condition is evaluated once more than the body, each time followed by a conditional jump
+	// to the end of the loop, and the end of every iteration jumps back to the condition.
+	size_t savedCosts =
+		m_meter->costs(*_loop.condition, _iterations + 1) +
+		m_meter->instructionCosts(evmasm::Instruction::JUMPI, _iterations + 1) +
+		m_meter->instructionCosts(evmasm::Instruction::JUMP, _iterations) +
+		m_meter->instructionCosts(evmasm::Instruction::JUMPDEST, _iterations + 1);
+	// Each unit of code size of the additional copies is estimated as one byte of code.
+	size_t additionalCosts =
+		(_iterations - 1) * iterationSize * m_meter->instructionCosts(evmasm::Instruction::JUMPDEST, 0);
+	return savedCosts > additionalCosts;
+}
+
+vector<Statement> LoopUnroller::unroll(ForLoop& _loop, size_t _iterations)
+{
+	vector<Statement> statements;
+	for (size_t i = 0; i < _iterations; ++i)
+	{
+		if (i + 1 < _iterations)
+		{
+			statements.emplace_back(BodyCopier{m_nameDispenser, {}}(_loop.body));
+			statements.emplace_back(std::visit(BodyCopier{m_nameDispenser, {}}, _loop.post.statements.front()));
+		}
+		else
+		{
+			// The last iteration reuses the original statements.
+			statements.emplace_back(move(_loop.body));
+			statements.emplace_back(move(_loop.post.statements.front()));
+		}
+	}
+	return statements;
+}
@@ -0,0 +1,98 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#pragma once
+
+#include <libyul/optimiser/ASTWalker.h>
+#include <libyul/optimiser/OptimiserStep.h>
+#include <libyul/AST.h>
+
+#include <optional>
+#include <vector>
+
+namespace solidity::yul
+{
+
+struct EVMDialect;
+class GasMeter;
+class NameDispenser;
+
+/**
+ * LoopUnroller: Optimiser step that fully unrolls for-loops with a small number of iterations
+ * that is known at compile time.
+ *
+ * A loop is unrolled if it has the form
+ *
+ * ```
+ * let i := <start>
+ * for { } lt(i, <end>) { i := add(i, <step>) } { body }
+ * ```
+ *
+ * where `<start>`, `<end>` and `<step>` are number literals, `<step>` is not zero and
+ * incrementing `i` does not overflow. The declaration of `i` can also be the only statement of
+ * the initialization part of the loop and the condition can also be `gt(<end>, i)`. The body
+ * must not assign to `i` and must not contain a `break` or `continue` belonging to the loop.
+ *
+ * The loop is replaced by a copy of its body in a block of its own, followed by the assignment to
+ * `i`, for every iteration. The variables declared in the copies are renamed, so that the names
+ * stay unique. Other steps can then propagate the values of `i` into the copies.
+ *
+ * Only loops with at most @a MaxIterations iterations whose unrolled code is at most
+ * @a MaxUnrolledSize large are unrolled. If a gas meter is available, the loop is only unrolled
+ * if the gas saved by not evaluating the condition and not jumping in every iteration outweighs
+ * the costs of deploying the additional code, given the number of expected runs of the code.
+ *
+ * Does nothing for dialects other than EVM.
+ *
+ * Prerequisites: Disambiguator, FunctionHoister
+ */
+class LoopUnroller: public ASTModifier
+{
+public:
+	/// Maximum number of iterations of a loop that is unrolled.
+	static constexpr size_t MaxIterations = 16;
+	/// Maximum size of the code replacing a loop, measured with @a CodeSize.
+	static constexpr size_t MaxUnrolledSize = 200;
+
+	static constexpr char const* name{"LoopUnroller"};
+	static void run(OptimiserStepContext& _context, Block& _ast);
+
+	using ASTModifier::operator();
+	void operator()(Block& _block) override;
+
+private:
+	LoopUnroller(EVMDialect const& _dialect, NameDispenser& _nameDispenser, GasMeter const* _meter):
+		m_dialect(_dialect),
+		m_nameDispenser(_nameDispenser),
+		m_meter(_meter)
+	{}
+
+	/// @returns the number of iterations of @a _loop, whose counter is declared by @a _counter,
+	/// or nullopt if the loop does not have the required form or too many iterations.
+	std::optional<size_t> iterationCount(ForLoop const& _loop, VariableDeclaration const& _counter) const;
+	/// @returns true if replacing @a _loop by @a _iterations copies of its body is cheaper.
+	bool worthUnrolling(ForLoop const& _loop, size_t _iterations) const;
+	/// @returns the statements replacing @a _loop, apart from its initialization part.
+	std::vector<Statement> unroll(ForLoop& _loop, size_t _iterations);
+
+	EVMDialect const& m_dialect;
+	NameDispenser& m_nameDispenser;
+	GasMeter const* m_meter = nullptr;
+};
+
+}
@@ -105,6 +105,13 @@ size_t CodeSize::codeSizeIncludingFunctions(Block const& _block, CodeWeights con
 	return cs.m_size;
 }
 
+size_t CodeSize::codeSizeIncludingFunctions(Statement const& _statement, CodeWeights const& _weights)
+{
+	CodeSize cs(false, _weights);
+	cs.visit(_statement);
+	return cs.m_size;
+}
+
 void CodeSize::visit(Statement const& _statement)
 {
 	if (holds_alternative<FunctionDefinition>(_statement) && m_ignoreFunctions)
@@ -187,6 +194,69 @@ void CodeCost::addInstructionCost(evmasm::Instruction _instruction)
 		m_cost += 49;
 }
 
+size_t ASTMemoryUsage::memoryUsage(Block const& _block)
+{
+	ASTMemoryUsage usage;
+	usage.m_bytes = sizeof(Block);
+	usage(_block);
+	return usage.m_bytes;
+}
+
+void ASTMemoryUsage::operator()(FunctionCall const& _funCall)
+{
+	m_bytes += _funCall.arguments.capacity() * sizeof(Expression);
+	ASTWalker::operator()(_funCall);
+}
+
+void ASTMemoryUsage::operator()(Assignment const& _assignment)
+{
+	m_bytes += _assignment.variableNames.capacity() * sizeof(Identifier) + sizeof(Expression);
+	ASTWalker::operator()(_assignment);
+}
+
+void ASTMemoryUsage::operator()(VariableDeclaration const& _varDecl)
+{
+	m_bytes += _varDecl.variables.capacity() * sizeof(TypedName);
+	if (_varDecl.value)
+		m_bytes += sizeof(Expression);
+	ASTWalker::operator()(_varDecl);
+}
+
+void ASTMemoryUsage::operator()(If const& _if)
+{
+	m_bytes += sizeof(Expression);
+	ASTWalker::operator()(_if);
+}
+
+void ASTMemoryUsage::operator()(Switch const& _switch)
+{
+	m_bytes += sizeof(Expression) + _switch.cases.capacity() * sizeof(Case);
+	for (auto const& _case: _switch.cases)
+		if (_case.value)
+			m_bytes += sizeof(Literal);
+	ASTWalker::operator()(_switch);
+}
+
+void ASTMemoryUsage::operator()(FunctionDefinition const& _functionDefinition)
+{
+	m_bytes +=
+		(_functionDefinition.parameters.capacity() + _functionDefinition.returnVariables.capacity()) *
+		sizeof(TypedName);
+	ASTWalker::operator()(_functionDefinition);
+}
+
+void ASTMemoryUsage::operator()(ForLoop const& _forLoop)
+{
+	m_bytes += sizeof(Expression);
+	ASTWalker::operator()(_forLoop);
+}
+
+void ASTMemoryUsage::operator()(Block const& _block)
+{
+	m_bytes += _block.statements.capacity() * sizeof(Statement);
+	ASTWalker::operator()(_block);
+}
+
 void AssignmentCounter::operator()(Assignment const& _assignment)
 {
 	for (auto const& variable: _assignment.variableNames)
@@ -87,6 +87,7 @@ public:
 	static size_t codeSize(Expression const& _expression, CodeWeights const& _weights = {});
 	static size_t codeSize(Block const& _block, CodeWeights const& _weights = {});
 	static size_t codeSizeIncludingFunctions(Block const& _block, CodeWeights const& _weights = {});
+	static size_t codeSizeIncludingFunctions(Statement const& _statement, CodeWeights const& _weights = {});
 
 private:
 	CodeSize(bool _ignoreFunctions = true, CodeWeights const& _weights = {}):
@@ -128,6 +129,30 @@ private:
 	size_t m_cost = 0;
 };
 
+/**
+ * Estimate of the memory held by an AST in bytes, i.e. the memory of its vectors and of the
+ * expressions stored separately. The names and values are in the YulString repository
+ * and not included.
+ */
+class ASTMemoryUsage: public ASTWalker
+{
+public:
+	static size_t memoryUsage(Block const& _block);
+
+private:
+	using ASTWalker::operator();
+	void operator()(FunctionCall const& _funCall) override;
+	void operator()(Assignment const& _assignment) override;
+	void operator()(VariableDeclaration const& _varDecl) override;
+	void operator()(If const& _if) override;
+	void operator()(Switch const& _switch) override;
+	void operator()(FunctionDefinition const& _functionDefinition) override;
+	void operator()(ForLoop const& _forLoop) override;
+	void operator()(Block const& _block) override;
+
+	size_t m_bytes = 0;
+};
+
 /**
  * Counts the number of assignments to every variable.
  * Only works after running the Disambiguator.
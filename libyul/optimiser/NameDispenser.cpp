@@ -29,6 +29,10 @@
 
 #include <libsolutil/CommonData.h>
 
+#include <liblangutil/Token.h>
+
+#include <charconv>
+
 using namespace std;
 using namespace solidity;
 using namespace solidity::yul;
@@ -42,18 +46,40 @@ NameDispenser::NameDispenser(Dialect const& _dialect, Block const& _ast, set<Yul
 
 NameDispenser::NameDispenser(Dialect const& _dialect, set<YulString> _usedNames):
 	m_dialect(_dialect),
-	m_usedNames(std::move(_usedNames))
+	m_usedNames(_usedNames.begin(), _usedNames.end())
 {
 }
 
 YulString NameDispenser::newName(YulString _nameHint)
 {
-	YulString name = _nameHint;
-	while (illegalName(name))
+	if (!illegalName(_nameHint))
+	{
+		m_usedNames.emplace(_nameHint);
+		return _nameHint;
+	}
+
+	m_candidate = _nameHint.str();
+	m_candidate += '_';
+	size_t const prefixLength = m_candidate.size();
+	while (true)
 	{
 		m_counter++;
-		name = YulString(_nameHint.str() + "_" + to_string(m_counter));
+		char digits[24];
+		char* digitsEnd = to_chars(begin(digits), end(digits), m_counter).ptr;
+		m_candidate.resize(prefixLength);
+		m_candidate.append(digits, digitsEnd);
+
+		// All used and reserved names are in the repository, so a candidate that is not
+		// found there is free unless it is a keyword. Only the chosen name is added.
+		if (optional<YulString> existing = YulString::find(m_candidate))
+		{
+			if (!illegalName(*existing))
+				break;
+		}
+		else if (!langutil::TokenTraits::isYulKeyword(m_candidate))
+			break;
 	}
+	YulString name{m_candidate};
 	m_usedNames.emplace(name);
 	return name;
 }
@@ -65,6 +91,7 @@ bool NameDispenser::illegalName(YulString _name)
 
 void NameDispenser::reset(Block const& _ast)
 {
-	m_usedNames = NameCollector(_ast).names() + m_reservedNames;
+	set<YulString> names = NameCollector(_ast).names() + m_reservedNames;
+	m_usedNames = unordered_set<YulString>(names.begin(), names.end());
 	m_counter = 0;
 }
@@ -25,6 +25,8 @@
 #include <libyul/YulString.h>
 
 #include <set>
+#include <string>
+#include <unordered_set>
 
 namespace solidity::yul
 {
@@ -35,6 +37,7 @@ struct Dialect;
  * do not conflict with existing names.
  *
  * Tries to keep names short and appends decimals to disambiguate.
+ * Rejected candidates are not added to the YulString repository.
  */
 class NameDispenser
 {
@@ -51,7 +54,7 @@ public:
 	/// return it.
 	void markUsed(YulString _name) { m_usedNames.insert(_name); }
 
-	std::set<YulString> const& usedNames() { return m_usedNames; }
+	std::unordered_set<YulString> const& usedNames() { return m_usedNames; }
 
 	/// Returns true if `_name` is either used or is a restricted identifier.
 	bool illegalName(YulString _name);
@@ -62,9 +65,11 @@ public:
 
 private:
 	Dialect const& m_dialect;
-	std::set<YulString> m_usedNames;
+	std::unordered_set<YulString> m_usedNames;
 	std::set<YulString> m_reservedNames;
 	size_t m_counter = 0;
+	/// Buffer for the candidate names, reused across calls to newName.
+	std::string m_candidate;
 };
 
 }
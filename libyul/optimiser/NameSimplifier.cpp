@@ -38,6 +38,14 @@ NameSimplifier::NameSimplifier(OptimiserStepContext& _context, Block const& _ast
 
 	for (YulString const& name: NameCollector(_ast).names())
 		findSimplification(name);
+
+	set<YulString> noInlineFunctions;
+	for (YulString name: _context.noInlineFunctions)
+	{
+		auto it = m_translations.find(name);
+		noInlineFunctions.insert(it == m_translations.end() ? name : it->second);
+	}
+	_context.noInlineFunctions = move(noInlineFunctions);
 }
 
 void NameSimplifier::operator()(FunctionDefinition& _funDef)
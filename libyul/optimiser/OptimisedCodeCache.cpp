@@ -0,0 +1,104 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Cache of the results of the optimiser suite.
+ */
+
+#include <libyul/optimiser/OptimisedCodeCache.h>
+
+#include <libyul/optimiser/ASTCopier.h>
+#include <libyul/AST.h>
+#include <libyul/AsmParser.h>
+#include <libyul/AsmPrinter.h>
+
+#include <liblangutil/ErrorReporter.h>
+#include <liblangutil/Scanner.h>
+
+#include <libsolutil/CommonIO.h>
+#include <libsolutil/Keccak256.h>
+
+#include <boost/filesystem.hpp>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::langutil;
+using namespace solidity::util;
+using namespace solidity::yul;
+
+shared_ptr<Block> OptimisedCodeCache::load(string const& _input, Dialect const& _dialect)
+{
+	h256 const key = this->key(_input);
+	shared_ptr<Block const> code;
+	{
+		lock_guard<mutex> lock(m_mutex);
+		if (auto it = m_code.find(key); it != m_code.end())
+			code = it->second;
+	}
+
+	if (!code && m_directory)
+		try
+		{
+			boost::filesystem::path const path = entryPath(key);
+			if (!boost::filesystem::is_regular_file(path))
+				return nullptr;
+
+			ErrorList errors;
+			ErrorReporter errorReporter(errors);
+			auto scanner = make_shared<Scanner>(CharStream(readFileAsString(path.string()), ""));
+			code = Parser(errorReporter, _dialect).parse(scanner, false);
+			if (!code || !errors.empty())
+				return nullptr;
+
+			lock_guard<mutex> lock(m_mutex);
+			m_code.emplace(key, code);
+		}
+		catch (...)
+		{
+			// Treat corrupted entries as missing, they are replaced after optimising.
+			return nullptr;
+		}
+
+	if (!code)
+		return nullptr;
+	return make_shared<Block>(std::get<Block>(ASTCopier{}(*code)));
+}
+
+void OptimisedCodeCache::store(string const& _input, Dialect const& _dialect, Block const& _code)
+{
+	h256 const key = this->key(_input);
+	{
+		lock_guard<mutex> lock(m_mutex);
+		m_code[key] = make_shared<Block>(std::get<Block>(ASTCopier{}(_code)));
+	}
+
+	if (!m_directory)
+		return;
+
+	// The cache is only an optimization, failing to fill it is not an error.
+	writeFileAtomically(entryPath(key).string(), AsmPrinter(_dialect)(_code));
+}
+
+h256 OptimisedCodeCache::key(string const& _input) const
+{
+	return keccak256(m_salt + "\n" + _input);
+}
+
+boost::filesystem::path OptimisedCodeCache::entryPath(h256 const& _key) const
+{
+	return *m_directory / (_key.hex() + ".yul");
+}
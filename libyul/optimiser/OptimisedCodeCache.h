@@ -0,0 +1,87 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Cache of the results of the optimiser suite.
+ */
+
+#pragma once
+
+#include <libyul/ASTForward.h>
+
+#include <libsolutil/FixedHash.h>
+
+#include <boost/filesystem/path.hpp>
+#include <boost/noncopyable.hpp>
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+
+namespace solidity::yul
+{
+
+struct Dialect;
+
+/**
+ * Maps the unoptimised code of an object, together with the optimiser settings, to the
+ * code the optimiser suite produced for it.
+ *
+ * Since the optimiser inlines and specializes functions across the whole object, results are
+ * cached per object and not per function. Identical objects are common: the deployed object of
+ * a contract is part of every contract that creates it, and the optimised IR is optimised again
+ * during code generation.
+ *
+ * Entries are kept in memory and, if a directory is given, also stored there as Yul source,
+ * so that they are reused between compiler runs. Unreadable entries are treated as missing
+ * and failures to write entries are ignored. The cache can be used concurrently.
+ */
+class OptimisedCodeCache: boost::noncopyable
+{
+public:
+	/// @param _salt is part of all keys. It has to identify the compiler if entries are stored
+	/// in @a _directory.
+	explicit OptimisedCodeCache(
+		std::string _salt = {},
+		std::optional<boost::filesystem::path> _directory = std::nullopt
+	):
+		m_salt(std::move(_salt)),
+		m_directory(std::move(_directory))
+	{}
+
+	/// @returns a copy of the optimised code stored for @a _input, which has to contain the
+	/// unoptimised code and everything else the result of the optimiser depends on,
+	/// or nullptr if there is no such entry.
+	/// Entries on disk are parsed in dialect @a _dialect.
+	std::shared_ptr<Block> load(std::string const& _input, Dialect const& _dialect);
+
+	/// Stores the optimised code @a _code for @a _input, replacing an existing entry.
+	void store(std::string const& _input, Dialect const& _dialect, Block const& _code);
+
+private:
+	util::h256 key(std::string const& _input) const;
+	boost::filesystem::path entryPath(util::h256 const& _key) const;
+
+	std::string const m_salt;
+	std::optional<boost::filesystem::path> const m_directory;
+	std::mutex m_mutex;
+	std::map<util::h256, std::shared_ptr<Block const>> m_code;
+};
+
+}
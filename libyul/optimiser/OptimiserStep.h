@@ -19,30 +19,51 @@
 #pragma once
 
 #include <libyul/Exceptions.h>
+#include <libyul/YulString.h>
 
+#include <functional>
 #include <optional>
 #include <string>
 #include <set>
+#include <utility>
 
 namespace solidity::yul
 {
 
 struct Dialect;
 struct Block;
-class YulString;
 class NameDispenser;
+class AnalysisManager;
+class GasMeter;
 
 struct OptimiserStepContext
 {
 	Dialect const& dialect;
 	NameDispenser& dispenser;
 	std::set<YulString> const& reservedIdentifiers;
+	/// Caches the analyses of the AST that is optimised, can be null.
+	AnalysisManager* analyses;
+	/// Estimates the costs of EVM code for steps that trade code size for gas, can be null.
+	GasMeter const* meter = nullptr;
+	/// Functions that are not inlined into their callers. Steps that rename or copy functions
+	/// keep it up to date.
+	std::set<YulString> noInlineFunctions = {};
 };
 
 
 /**
  * Construction to create dynamically callable objects out of the
  * statically callable optimiser steps.
+ *
+ * Steps are global by default. A step can declare itself function-local via
+ * ``static constexpr bool functionLocal = true;``, which means that applying it to every
+ * statement of the outermost block separately, i.e. to the outermost code block and each function
+ * definition, each wrapped in a block of its own, has the same effect as applying it to the complete
+ * AST. This allows applying it to the parts concurrently, so function-local steps must not use the
+ * name dispenser. If a function-local step needs information about the complete AST, for example
+ * the side-effects of all functions, it provides
+ * ``static std::function<void(Block&)> prepare(OptimiserStepContext&, Block const& _ast)``,
+ * which collects the information and returns a function that applies the step to a part.
  */
 struct OptimiserStep
 {
@@ -54,6 +75,14 @@ struct OptimiserStep
 	/// an SMT solver to be loaded, but none is available. In that case, the string
 	/// contains a human-readable reason.
 	virtual std::optional<std::string> invalidInCurrentEnvironment() const = 0;
+	/// @returns true if the step is function-local.
+	virtual bool functionLocal() const = 0;
+	/// @returns true if the step is function-local and its effect on a part does not depend on
+	/// the remaining AST.
+	virtual bool independentOfOtherFunctions() const = 0;
+	/// Only for function-local steps: @returns a function that applies the step to a part of @a _ast.
+	/// The function can be called concurrently for different parts.
+	virtual std::function<void(Block&)> prepare(OptimiserStepContext& _context, Block const& _ast) const = 0;
 	std::string name;
 };
 
@@ -72,6 +101,31 @@ private:
 		static constexpr bool value = decltype(test<T>(0))::value;
 	};
 
+	template<typename T>
+	struct HasFunctionLocalMember
+	{
+	private:
+		template<typename U> static auto test(int) -> decltype(U::functionLocal, std::true_type());
+		template<typename> static std::false_type test(...);
+
+	public:
+		static constexpr bool value = decltype(test<T>(0))::value;
+	};
+
+	template<typename T>
+	struct HasPrepareMethod
+	{
+	private:
+		template<typename U> static auto test(int) -> decltype(
+			U::prepare(std::declval<OptimiserStepContext&>(), std::declval<Block const&>()),
+			std::true_type()
+		);
+		template<typename> static std::false_type test(...);
+
+	public:
+		static constexpr bool value = decltype(test<T>(0))::value;
+	};
+
 public:
 	OptimiserStepInstance(): OptimiserStep{Step::name} {}
 	void run(OptimiserStepContext& _context, Block& _ast) const override
@@ -85,6 +139,25 @@ public:
 		else
 			return std::nullopt;
 	}
+	bool functionLocal() const override
+	{
+		if constexpr (HasFunctionLocalMember<Step>::value)
+			return Step::functionLocal;
+		else
+			return false;
+	}
+	bool independentOfOtherFunctions() const override
+	{
+		return functionLocal() && !HasPrepareMethod<Step>::value;
+	}
+	std::function<void(Block&)> prepare(OptimiserStepContext& _context, Block const& _ast) const override
+	{
+		yulAssert(functionLocal(), "");
+		if constexpr (HasPrepareMethod<Step>::value)
+			return Step::prepare(_context, _ast);
+		else
+			return [&_context](Block& _part) { Step::run(_context, _part); };
+	}
 };
 
 
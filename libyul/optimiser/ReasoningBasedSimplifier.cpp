@@ -17,8 +17,11 @@
 
 #include <libyul/optimiser/ReasoningBasedSimplifier.h>
 
+#include <libyul/optimiser/ASTCopier.h>
+#include <libyul/optimiser/BlockHasher.h>
 #include <libyul/optimiser/SSAValueTracker.h>
 #include <libyul/optimiser/Semantics.h>
+#include <libyul/optimiser/SyntacticalEquality.h>
 #include <libyul/AST.h>
 #include <libyul/Utilities.h>
 #include <libyul/Dialect.h>
@@ -62,9 +65,9 @@ void ReasoningBasedSimplifier::operator()(VariableDeclaration& _varDecl)
 	YulString varName = _varDecl.variables.front().name;
 	if (!m_ssaVariables.count(varName))
 		return;
-	bool const inserted = m_variables.insert({varName, m_solver->newVariable("yul_" + varName.str(), defaultSort())}).second;
+	bool const inserted = m_state.variables.insert({varName, m_state.solver->newVariable("yul_" + varName.str(), defaultSort())}).second;
 	yulAssert(inserted, "");
-	m_solver->addAssertion(m_variables.at(varName) == encodeExpression(*_varDecl.value));
+	m_state.solver->addAssertion(m_state.variables.at(varName) == encodeExpression(*_varDecl.value));
 }
 
 void ReasoningBasedSimplifier::operator()(If& _if)
@@ -72,40 +75,101 @@ void ReasoningBasedSimplifier::operator()(If& _if)
 	if (!SideEffectsCollector{m_dialect, *_if.condition}.movable())
 		return;
 
-	smtutil::Expression condition = encodeExpression(*_if.condition);
-	m_solver->push();
-	m_solver->addAssertion(condition == constantValue(0));
-	CheckResult result = m_solver->check({}).first;
-	m_solver->pop();
-	if (result == CheckResult::UNSATISFIABLE)
+	ConditionValue value = checkCondition(*_if.condition);
+	if (value == ConditionValue::AlwaysTrue)
 	{
 		Literal trueCondition = m_dialect.trueLiteral();
 		trueCondition.location = locationOf(*_if.condition);
 		_if.condition = make_unique<yul::Expression>(move(trueCondition));
 	}
-	else
+	else if (value == ConditionValue::AlwaysFalse)
 	{
-		m_solver->push();
-		m_solver->addAssertion(condition != constantValue(0));
-		CheckResult result2 = m_solver->check({}).first;
-		m_solver->pop();
-		if (result2 == CheckResult::UNSATISFIABLE)
-		{
-			Literal falseCondition = m_dialect.zeroLiteralForType(m_dialect.boolType);
-			falseCondition.location = locationOf(*_if.condition);
-			_if.condition = make_unique<yul::Expression>(move(falseCondition));
-			_if.body = yul::Block{};
-			// Nothing left to be done.
-			return;
-		}
+		Literal falseCondition = m_dialect.zeroLiteralForType(m_dialect.boolType);
+		falseCondition.location = locationOf(*_if.condition);
+		_if.condition = make_unique<yul::Expression>(move(falseCondition));
+		_if.body = yul::Block{};
+		// Nothing left to be done.
+		return;
 	}
 
-	m_solver->push();
-	m_solver->addAssertion(condition != constantValue(0));
+	m_state.solver->push();
+	m_state.solver->addAssertion(encodeExpression(*_if.condition) != constantValue(0));
+	m_state.branches.push_back(m_branchCounter++);
 
 	ASTModifier::operator()(_if.body);
 
-	m_solver->pop();
+	m_state.branches.pop_back();
+	m_state.solver->pop();
+}
+
+void ReasoningBasedSimplifier::operator()(FunctionDefinition& _function)
+{
+	FunctionState outerState = std::move(m_state);
+	m_state = FunctionState{};
+	if (m_spareSolver)
+	{
+		m_state.solver = std::move(m_spareSolver);
+		m_state.solver->reset();
+	}
+	else
+		m_state.solver = make_unique<smtutil::SMTPortfolio>();
+
+	ASTModifier::operator()(_function);
+
+	m_spareSolver = std::move(m_state.solver);
+	m_state = std::move(outerState);
+}
+
+ReasoningBasedSimplifier::ConditionValue ReasoningBasedSimplifier::checkCondition(yul::Expression const& _condition)
+{
+	// SSA variables have the same value everywhere in the function and other identifiers
+	// are encoded as unconstrained values, so equal conditions have the same value.
+	uint64_t hash = ExpressionHasher::run(_condition);
+	vector<CheckedCondition>& checked = m_state.checkedConditions[hash];
+	for (CheckedCondition const& entry: checked)
+	{
+		size_t const depth = m_state.branches.size();
+		bool const sameBranch = entry.branchDepth == depth && (depth == 0 || m_state.branches.back() == entry.branch);
+		bool const enclosingBranch =
+			entry.branchDepth <= depth &&
+			(entry.branchDepth == 0 || m_state.branches[entry.branchDepth - 1] == entry.branch);
+		if (
+			(sameBranch || (enclosingBranch && entry.value != ConditionValue::Unknown)) &&
+			SyntacticallyEqual{}(*entry.condition, _condition)
+		)
+			return entry.value;
+	}
+
+	ConditionValue value = ConditionValue::Unknown;
+	if (m_state.queries + 2 <= MaxQueriesPerFunction)
+	{
+		smtutil::Expression condition = encodeExpression(_condition);
+		m_state.solver->push();
+		m_state.solver->addAssertion(condition == constantValue(0));
+		CheckResult result = m_state.solver->check({}).first;
+		m_state.solver->pop();
+		++m_state.queries;
+		if (result == CheckResult::UNSATISFIABLE)
+			value = ConditionValue::AlwaysTrue;
+		else
+		{
+			m_state.solver->push();
+			m_state.solver->addAssertion(condition != constantValue(0));
+			CheckResult result2 = m_state.solver->check({}).first;
+			m_state.solver->pop();
+			++m_state.queries;
+			if (result2 == CheckResult::UNSATISFIABLE)
+				value = ConditionValue::AlwaysFalse;
+		}
+	}
+
+	checked.push_back(CheckedCondition{
+		make_shared<yul::Expression>(ASTCopier{}.translate(_condition)),
+		m_state.branches.size(),
+		m_state.branches.empty() ? 0 : m_state.branches.back(),
+		value
+	});
+	return value;
 }
 
 ReasoningBasedSimplifier::ReasoningBasedSimplifier(
@@ -113,9 +177,9 @@ ReasoningBasedSimplifier::ReasoningBasedSimplifier(
 	set<YulString> const& _ssaVariables
 ):
 	m_dialect(_dialect),
-	m_ssaVariables(_ssaVariables),
-	m_solver(make_unique<smtutil::SMTPortfolio>())
+	m_ssaVariables(_ssaVariables)
 {
+	m_state.solver = make_unique<smtutil::SMTPortfolio>();
 }
 
 smtutil::Expression ReasoningBasedSimplifier::encodeExpression(yul::Expression const& _expression)
@@ -133,9 +197,9 @@ smtutil::Expression ReasoningBasedSimplifier::encodeExpression(yul::Expression c
 		{
 			if (
 				m_ssaVariables.count(_identifier.name) &&
-				m_variables.count(_identifier.name)
+				m_state.variables.count(_identifier.name)
 			)
-				return m_variables.at(_identifier.name);
+				return m_state.variables.at(_identifier.name);
 			else
 				return newRestrictedVariable();
 		},
@@ -275,13 +339,13 @@ smtutil::Expression ReasoningBasedSimplifier::bv2int(smtutil::Expression _arg) c
 
 smtutil::Expression ReasoningBasedSimplifier::newVariable()
 {
-	return m_solver->newVariable(uniqueName(), defaultSort());
+	return m_state.solver->newVariable(uniqueName(), defaultSort());
 }
 
 smtutil::Expression ReasoningBasedSimplifier::newRestrictedVariable()
 {
 	smtutil::Expression var = newVariable();
-	m_solver->addAssertion(0 <= var && var < smtutil::Expression(bigint(1) << 256));
+	m_state.solver->addAssertion(0 <= var && var < smtutil::Expression(bigint(1) << 256));
 	return var;
 }
 
@@ -332,6 +396,6 @@ smtutil::Expression ReasoningBasedSimplifier::wrap(smtutil::Expression _value)
 {
 	smtutil::Expression rest = newRestrictedVariable();
 	smtutil::Expression multiplier = newVariable();
-	m_solver->addAssertion(_value == multiplier * smtutil::Expression(bigint(1) << 256) + rest);
+	m_state.solver->addAssertion(_value == multiplier * smtutil::Expression(bigint(1) << 256) + rest);
 	return rest;
 }
@@ -23,7 +23,10 @@
 // because of instruction
 #include <libyul/backends/evm/EVMDialect.h>
 
+#include <cstdint>
 #include <map>
+#include <memory>
+#include <vector>
 
 namespace solidity::smtutil
 {
@@ -42,6 +45,10 @@ namespace solidity::yul
  * - If `constraints AND NOT condition` is UNSAT, the condition is always true and can be replaced by `1`.
  * The simplifications above can only be applied if the condition is movable.
  *
+ * Every function is handled with its own solver, so that the queries only contain the
+ * constraints of the function. The results are reused for syntactically equal conditions
+ * in the same or a nested branch, and at most MaxQueriesPerFunction queries are made in a function.
+ *
  * It is only effective on the EVM dialect, but safe to use on other dialects.
  *
  * Prerequisite: Disambiguator, SSATransform.
@@ -56,13 +63,43 @@ public:
 	using ASTModifier::operator();
 	void operator()(VariableDeclaration& _varDecl) override;
 	void operator()(If& _if) override;
+	void operator()(FunctionDefinition& _function) override;
+
+	/// Limit on the number of queries in a function, which keeps the step fast on large functions.
+	static constexpr size_t MaxQueriesPerFunction = 256;
 
 private:
+	enum class ConditionValue { AlwaysTrue, AlwaysFalse, Unknown };
+	/// Result for a condition checked inside the given branch. AlwaysTrue and AlwaysFalse stay
+	/// valid in nested branches, Unknown only in the same branch.
+	struct CheckedCondition
+	{
+		std::shared_ptr<Expression> condition;
+		/// Number of enclosing `if` bodies and the ID of the innermost one.
+		size_t branchDepth;
+		size_t branch;
+		ConditionValue value;
+	};
+	/// The state that is specific to the function that is being visited.
+	struct FunctionState
+	{
+		std::unique_ptr<smtutil::SolverInterface> solver;
+		std::map<YulString, smtutil::Expression> variables;
+		/// Checked conditions by hash.
+		std::map<uint64_t, std::vector<CheckedCondition>> checkedConditions;
+		/// IDs of the enclosing `if` bodies.
+		std::vector<size_t> branches;
+		size_t queries = 0;
+	};
+
 	explicit ReasoningBasedSimplifier(
 		Dialect const& _dialect,
 		std::set<YulString> const& _ssaVariables
 	);
 
+	/// @returns the value of the movable condition @a _condition in the current branch.
+	ConditionValue checkCondition(Expression const& _condition);
+
 	smtutil::Expression encodeExpression(
 		Expression const& _expression
 	);
@@ -89,10 +126,12 @@ private:
 
 	Dialect const& m_dialect;
 	std::set<YulString> const& m_ssaVariables;
-	std::unique_ptr<smtutil::SolverInterface> m_solver;
-	std::map<YulString, smtutil::Expression> m_variables;
+	FunctionState m_state;
+	/// Solver of a function that was visited before, to be reused after a reset.
+	std::unique_ptr<smtutil::SolverInterface> m_spareSolver;
 
 	size_t m_varCounter = 0;
+	size_t m_branchCounter = 0;
 };
 
 }
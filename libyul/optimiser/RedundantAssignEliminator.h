@@ -110,6 +110,7 @@ class RedundantAssignEliminator: public ASTWalker
 {
 public:
 	static constexpr char const* name{"RedundantAssignEliminator"};
+	static constexpr bool functionLocal = true;
 	static void run(OptimiserStepContext&, Block& _ast);
 
 	explicit RedundantAssignEliminator(Dialect const& _dialect): m_dialect(&_dialect) {}
@@ -92,6 +92,7 @@ class LiteralRematerialiser: public DataFlowAnalyzer
 {
 public:
 	static constexpr char const* name{"LiteralRematerialiser"};
+	static constexpr bool functionLocal = true;
 	static void run(
 		OptimiserStepContext& _context,
 		Block& _ast
@@ -21,6 +21,8 @@
 
 #include <libyul/optimiser/Semantics.h>
 
+#include <libyul/optimiser/AnalysisManager.h>
+#include <libyul/optimiser/OptimiserStep.h>
 #include <libyul/Exceptions.h>
 #include <libyul/AST.h>
 #include <libyul/Dialect.h>
@@ -92,6 +94,13 @@ bool MSizeFinder::containsMSize(Dialect const& _dialect, Block const& _ast)
 	return finder.m_msizeFound;
 }
 
+bool MSizeFinder::containsMSize(OptimiserStepContext const& _context, Block const& _ast)
+{
+	if (_context.analyses && _context.analyses->tracks(_ast))
+		return _context.analyses->containsMSize();
+	return containsMSize(_context.dialect, _ast);
+}
+
 void MSizeFinder::operator()(FunctionCall const& _functionCall)
 {
 	ASTWalker::operator()(_functionCall);
@@ -101,6 +110,16 @@ void MSizeFinder::operator()(FunctionCall const& _functionCall)
 			m_msizeFound = true;
 }
 
+map<YulString, SideEffects> SideEffectsPropagator::sideEffects(
+	OptimiserStepContext const& _context,
+	Block const& _ast
+)
+{
+	if (_context.analyses && _context.analyses->tracks(_ast))
+		return _context.analyses->functionSideEffects();
+	return sideEffects(_context.dialect, CallGraphGenerator::callGraph(_ast));
+}
+
 map<YulString, SideEffects> SideEffectsPropagator::sideEffects(
 	Dialect const& _dialect,
 	CallGraph const& _directCallGraph
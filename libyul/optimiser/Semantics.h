@@ -31,6 +31,7 @@
 namespace solidity::yul
 {
 struct Dialect;
+struct OptimiserStepContext;
 
 /**
  * Specific AST walker that determines side-effect free-ness and movability of code.
@@ -128,6 +129,9 @@ public:
 		Dialect const& _dialect,
 		CallGraph const& _directCallGraph
 	);
+	/// @returns the side-effects of the functions defined in the complete AST @a _ast,
+	/// taken from the analysis manager of @a _context if it tracks @a _ast.
+	static std::map<YulString, SideEffects> sideEffects(OptimiserStepContext const& _context, Block const& _ast);
 };
 
 /**
@@ -142,6 +146,8 @@ class MSizeFinder: public ASTWalker
 {
 public:
 	static bool containsMSize(Dialect const& _dialect, Block const& _ast);
+	/// Same as above, using the analysis manager of @a _context if it tracks @a _ast.
+	static bool containsMSize(OptimiserStepContext const& _context, Block const& _ast);
 
 	using ASTWalker::operator();
 	void operator()(FunctionCall const& _funCall) override;
@@ -47,7 +47,8 @@ SimplificationRules::Rule const* SimplificationRules::findFirstMatch(
 	if (!instruction)
 		return nullptr;
 
-	static std::map<std::optional<EVMVersion>, std::unique_ptr<SimplificationRules>> evmRules;
+	// The rules store the state of the current match, so every thread needs its own copy.
+	static thread_local std::map<std::optional<EVMVersion>, std::unique_ptr<SimplificationRules>> evmRules;
 
 	std::optional<EVMVersion> version;
 	if (yul::EVMDialect const* evmDialect = dynamic_cast<yul::EVMDialect const*>(&_dialect))
@@ -59,19 +60,33 @@ SimplificationRules::Rule const* SimplificationRules::findFirstMatch(
 	SimplificationRules& rules = *evmRules[version];
 	assertThrow(rules.isInitialized(), OptimizerException, "Rule list not properly initialized.");
 
-	for (auto const& rule: rules.m_rules[uint8_t(instruction->first)])
+	rules.m_argumentShapes.clear();
+	for (Expression const& argument: *instruction->second)
 	{
-		rules.resetMatchGroups();
-		if (rule.pattern.matches(_expr, _dialect, _ssaValues))
-			if (!rule.feasible || rule.feasible())
-				return &rule;
+		// Direct function calls are never matched, see Pattern::matches.
+		if (holds_alternative<FunctionCall>(argument))
+			return nullptr;
+		Expression const* value = &argument;
+		if (Identifier const* identifier = get_if<Identifier>(&argument))
+			if (auto it = _ssaValues.find(identifier->name); it != _ssaValues.end() && it->second.value)
+				value = it->second.value;
+		if (Literal const* literal = get_if<Literal>(value))
+			rules.m_argumentShapes.push_back(literal->kind == LiteralKind::Number ? ConstantShape : AnyShape);
+		else if (auto valueInstruction = instructionAndArguments(_dialect, *value))
+			rules.m_argumentShapes.push_back(operationShape(valueInstruction->first));
+		else
+			rules.m_argumentShapes.push_back(AnyShape);
 	}
-	return nullptr;
+
+	return rules.m_rules.findFirst(instruction->first, rules.m_argumentShapes, [&](Rule const& _rule) {
+		rules.resetMatchGroups();
+		return _rule.pattern.matches(_expr, _dialect, _ssaValues) && (!_rule.feasible || _rule.feasible());
+	});
 }
 
 bool SimplificationRules::isInitialized() const
 {
-	return !m_rules[uint8_t(evmasm::Instruction::ADD)].empty();
+	return !m_rules.empty(evmasm::Instruction::ADD);
 }
 
 std::optional<std::pair<evmasm::Instruction, vector<Expression> const*>>
@@ -94,7 +109,7 @@ void SimplificationRules::addRules(std::vector<Rule> const& _rules)
 
 void SimplificationRules::addRule(Rule const& _rule)
 {
-	m_rules[uint8_t(_rule.pattern.instruction())].push_back(_rule);
+	m_rules.add(_rule);
 }
 
 SimplificationRules::SimplificationRules(std::optional<langutil::EVMVersion> _evmVersion)
@@ -234,6 +249,16 @@ evmasm::Instruction Pattern::instruction() const
 	return m_instruction;
 }
 
+ExpressionShape Pattern::shape() const
+{
+	if (m_kind == PatternKind::Operation)
+		return operationShape(m_instruction);
+	else if (m_kind == PatternKind::Constant)
+		return ConstantShape;
+	else
+		return AnyShape;
+}
+
 Expression Pattern::toExpression(SourceLocation const& _location) const
 {
 	if (matchGroup())
@@ -76,7 +76,9 @@ private:
 	void resetMatchGroups() { m_matchGroups.clear(); }
 
 	std::map<unsigned, Expression const*> m_matchGroups;
-	std::vector<evmasm::SimplificationRule<Pattern>> m_rules[256];
+	evmasm::SimplificationRuleIndex<Pattern> m_rules;
+	/// Shapes of the arguments of the expression that is currently matched.
+	std::vector<evmasm::ExpressionShape> m_argumentShapes;
 };
 
 enum class PatternKind
@@ -126,6 +128,9 @@ public:
 
 	evmasm::Instruction instruction() const;
 
+	/// @returns the shape of the expressions matched by this pattern.
+	evmasm::ExpressionShape shape() const;
+
 	/// Turns this pattern into an actual expression. Should only be called
 	/// for patterns resulting from an action, i.e. with match groups assigned.
 	Expression toExpression(langutil::SourceLocation const& _location) const;
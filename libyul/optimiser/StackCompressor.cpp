@@ -166,11 +166,19 @@ bool StackCompressor::run(
 		"Need to run the function grouper before the stack compressor."
 	);
 	bool allowMSizeOptimzation = !MSizeFinder::containsMSize(_dialect, *_object.code);
+	// Eliminating variables only changes the function they are eliminated from, so after the
+	// first iteration, only the functions that were not compilable have to be checked again.
+	optional<set<YulString>> functionsToCheck;
 	for (size_t iterations = 0; iterations < _maxIterations; iterations++)
 	{
-		map<YulString, int> stackSurplus = CompilabilityChecker(_dialect, _object, _optimizeStackAllocation).stackDeficit;
+		map<YulString, int> stackSurplus = functionsToCheck ?
+			CompilabilityChecker(_dialect, _object, _optimizeStackAllocation, *functionsToCheck).stackDeficit :
+			CompilabilityChecker(_dialect, _object, _optimizeStackAllocation).stackDeficit;
 		if (stackSurplus.empty())
 			return true;
+		functionsToCheck = set<YulString>{};
+		for (auto const& surplus: stackSurplus)
+			functionsToCheck->insert(surplus.first);
 
 		if (stackSurplus.count(YulString{}))
 		{
@@ -16,6 +16,7 @@
 */
 
 #include <libyul/optimiser/StackLimitEvader.h>
+#include <libyul/optimiser/ASTWalker.h>
 #include <libyul/optimiser/CallGraphGenerator.h>
 #include <libyul/optimiser/FunctionCallFinder.h>
 #include <libyul/optimiser/NameDispenser.h>
@@ -35,6 +36,80 @@ using namespace solidity::yul;
 
 namespace
 {
+/**
+ * Determines the scope of each variable as the range of positions of the statements in which
+ * it is accessible, numbering the statements in the order in which they appear in the code.
+ * If the scopes of two variables of the same function do not overlap, they are never alive at
+ * the same time, since a variable is initialized whenever control flow enters its scope.
+ * Parameters and return variables are accessible in the whole function and variables declared
+ * in the initialization part of a for-loop in the whole loop.
+ *
+ * Prerequisite: Disambiguator
+ */
+class VariableScopes: public ASTWalker
+{
+public:
+	using ASTWalker::operator();
+	void operator()(Block const& _block) override
+	{
+		m_openScopes.emplace_back();
+		visitStatements(_block.statements);
+		closeScope();
+	}
+	void operator()(VariableDeclaration const& _varDecl) override
+	{
+		ASTWalker::operator()(_varDecl);
+		for (TypedName const& variable: _varDecl.variables)
+			openVariableScope(variable.name);
+	}
+	void operator()(ForLoop const& _loop) override
+	{
+		m_openScopes.emplace_back();
+		visitStatements(_loop.pre.statements);
+		visit(*_loop.condition);
+		(*this)(_loop.body);
+		(*this)(_loop.post);
+		closeScope();
+	}
+	void operator()(FunctionDefinition const& _function) override
+	{
+		m_openScopes.emplace_back();
+		for (TypedName const& parameter: _function.parameters)
+			openVariableScope(parameter.name);
+		for (TypedName const& returnVariable: _function.returnVariables)
+			openVariableScope(returnVariable.name);
+		(*this)(_function.body);
+		closeScope();
+	}
+
+	map<YulString, pair<size_t, size_t>> const& scopes() const { return m_scopes; }
+
+private:
+	void visitStatements(vector<Statement> const& _statements)
+	{
+		for (Statement const& statement: _statements)
+		{
+			++m_position;
+			visit(statement);
+		}
+	}
+	void openVariableScope(YulString _variable)
+	{
+		m_scopes[_variable].first = m_position;
+		m_openScopes.back().emplace_back(_variable);
+	}
+	void closeScope()
+	{
+		for (YulString variable: m_openScopes.back())
+			m_scopes[variable].second = m_position;
+		m_openScopes.pop_back();
+	}
+
+	size_t m_position = 0;
+	vector<vector<YulString>> m_openScopes;
+	map<YulString, pair<size_t, size_t>> m_scopes;
+};
+
 /**
  * Walks the call graph using a Depth-First-Search assigning memory slots to variables.
  * - The leaves of the call graph will get the lowest slot, increasing towards the root.
@@ -45,7 +120,8 @@ namespace
  * - Determine the maximum value ``n`` of the values of ``slotsRequiredForFunction`` among the children.
  * - If the function itself contains variables that need memory slots, but is contained in a cycle,
  *   abort the process as failure.
- * - If not, assign each variable its slot starting from ``n`` (incrementing it).
+ * - If not, assign each variable its slot starting from ``n`` (incrementing it). Variables whose
+ *   scopes do not overlap share a slot.
  * - Assign ``n`` to ``slotsRequiredForFunction`` of the function.
  */
 struct MemoryOffsetAllocator
@@ -66,20 +142,65 @@ struct MemoryOffsetAllocator
 		if (unreachableVariables.count(_function))
 		{
 			yulAssert(!slotAllocations.count(_function), "");
-			for (YulString variable: unreachableVariables.at(_function))
-				if (variable.empty())
-				{
-					// TODO: Too many function arguments or return parameters.
-				}
-				else
-					slotAllocations[variable] = requiredSlots++;
+			requiredSlots += assignSlots(unreachableVariables.at(_function), requiredSlots);
 		}
 
 		return slotsRequiredForFunction[_function] = requiredSlots;
 	}
 
+	/// Assigns slots starting from @a _firstSlot to @a _variables, such that variables whose
+	/// scopes do not overlap share a slot. @returns the number of slots used.
+	uint64_t assignSlots(set<YulString> const& _variables, uint64_t _firstSlot)
+	{
+		vector<YulString> variables;
+		for (YulString variable: _variables)
+			if (variable.empty())
+			{
+				// TODO: Too many function arguments or return parameters.
+			}
+			else
+				variables.emplace_back(variable);
+
+		auto scope = [&](YulString _variable) {
+			yulAssert(variableScopes.count(_variable), "");
+			return variableScopes.at(_variable);
+		};
+
+		// Assigning the first free slot in the order of the beginnings of the scopes
+		// uses the smallest possible number of slots.
+		vector<YulString> variablesByScope = variables;
+		stable_sort(variablesByScope.begin(), variablesByScope.end(), [&](YulString _a, YulString _b) {
+			return scope(_a).first < scope(_b).first;
+		});
+		vector<size_t> slotScopeEnds;
+		map<YulString, size_t> slots;
+		for (YulString variable: variablesByScope)
+		{
+			auto [begin, end] = scope(variable);
+			size_t slot = 0;
+			while (slot < slotScopeEnds.size() && slotScopeEnds[slot] >= begin)
+				++slot;
+			if (slot == slotScopeEnds.size())
+				slotScopeEnds.emplace_back(end);
+			else
+				slotScopeEnds[slot] = end;
+			slots[variable] = slot;
+		}
+
+		// Number the slots in the order of the variables, which results in the same allocation
+		// as giving every variable its own slot if all scopes overlap.
+		map<size_t, uint64_t> slotNumbers;
+		for (YulString variable: variables)
+		{
+			uint64_t slotNumber = slotNumbers.emplace(slots.at(variable), slotNumbers.size()).first->second;
+			slotAllocations[variable] = _firstSlot + slotNumber;
+		}
+		return slotNumbers.size();
+	}
+
 	map<YulString, set<YulString>> const& unreachableVariables;
 	map<YulString, set<YulString>> const& callGraph;
+	map<YulString, pair<size_t, size_t>> const& variableScopes;
 
 	map<YulString, uint64_t> slotAllocations{};
 	map<YulString, uint64_t> slotsRequiredForFunction{};
@@ -128,7 +249,10 @@ void StackLimitEvader::run(
 		if (_unreachableVariables.count(function))
 			return;
 
-	MemoryOffsetAllocator memoryOffsetAllocator{_unreachableVariables, callGraph.functionCalls};
+	VariableScopes variableScopes;
+	variableScopes(*_object.code);
+
+	MemoryOffsetAllocator memoryOffsetAllocator{_unreachableVariables, callGraph.functionCalls, variableScopes.scopes()};
 	uint64_t requiredSlots = memoryOffsetAllocator.run();
 
 	StackToMemoryMover::run(_context, reservedMemory, memoryOffsetAllocator.slotAllocations, requiredSlots, *_object.code);
@@ -26,12 +26,15 @@
 #include <libyul/optimiser/BlockFlattener.h>
 #include <libyul/optimiser/CallGraphGenerator.h>
 #include <libyul/optimiser/CircularReferencesPruner.h>
+#include <libyul/optimiser/ColdCodeOutliner.h>
 #include <libyul/optimiser/ControlFlowSimplifier.h>
 #include <libyul/optimiser/ConditionalSimplifier.h>
 #include <libyul/optimiser/ConditionalUnsimplifier.h>
 #include <libyul/optimiser/DeadCodeEliminator.h>
 #include <libyul/optimiser/FunctionGrouper.h>
 #include <libyul/optimiser/FunctionHoister.h>
+#include <libyul/optimiser/FunctionSpecializer.h>
+#include <libyul/optimiser/GlobalValueNumbering.h>
 #include <libyul/optimiser/EquivalentFunctionCombiner.h>
 #include <libyul/optimiser/ExpressionSplitter.h>
 #include <libyul/optimiser/ExpressionJoiner.h>
@@ -41,10 +44,12 @@
 #include <libyul/optimiser/ForLoopConditionOutOfBody.h>
 #include <libyul/optimiser/ForLoopInitRewriter.h>
 #include <libyul/optimiser/ForLoopConditionIntoBody.h>
+#include <libyul/optimiser/BlockHasher.h>
 #include <libyul/optimiser/ReasoningBasedSimplifier.h>
 #include <libyul/optimiser/Rematerialiser.h>
 #include <libyul/optimiser/UnusedFunctionParameterPruner.h>
 #include <libyul/optimiser/UnusedPruner.h>
+#include <libyul/optimiser/ValueRangeSimplifier.h>
 #include <libyul/optimiser/ExpressionSimplifier.h>
 #include <libyul/optimiser/CommonSubexpressionEliminator.h>
 #include <libyul/optimiser/Semantics.h>
@@ -58,6 +63,7 @@
 #include <libyul/optimiser/VarNameCleaner.h>
 #include <libyul/optimiser/LoadResolver.h>
 #include <libyul/optimiser/LoopInvariantCodeMotion.h>
+#include <libyul/optimiser/LoopUnroller.h>
 #include <libyul/optimiser/Metrics.h>
 #include <libyul/optimiser/NameSimplifier.h>
 #include <libyul/backends/evm/ConstantOptimiser.h>
@@ -71,6 +77,8 @@
 #include <libyul/backends/evm/NoOutputAssembly.h>
 
 #include <libsolutil/CommonData.h>
+#include <libsolutil/CompilationStatistics.h>
+#include <libsolutil/Tracer.h>
 
 #include <boost/range/adaptor/map.hpp>
 #include <boost/range/algorithm_ext/erase.hpp>
@@ -86,9 +94,17 @@ void OptimiserSuite::run(
 	Object& _object,
 	bool _optimizeStackAllocation,
 	string const& _optimisationSequence,
-	set<YulString> const& _externallyUsedIdentifiers
+	set<YulString> const& _externallyUsedIdentifiers,
+	size_t _parallelism,
+	optional<chrono::milliseconds> _timeBudget,
+	FunctionStepCache const* _reusedResults,
+	FunctionStepCache* _recordedResults,
+	set<YulString> const& _noInlineFunctions
 )
 {
+	util::CompilationStatistics::PhaseTimer timer("yulOptimiser");
+	auto const start = chrono::steady_clock::now();
+
 	set<YulString> reservedIdentifiers = _externallyUsedIdentifiers;
 	reservedIdentifiers += _dialect.fixedFunctionNames();
 
@@ -99,15 +115,23 @@ void OptimiserSuite::run(
 	)(*_object.code));
 	Block& ast = *_object.code;
 
-	OptimiserSuite suite(_dialect, reservedIdentifiers, Debug::None, ast);
+	OptimiserSuite suite(_dialect, reservedIdentifiers, Debug::None, ast, _parallelism);
+	suite.m_reusedResults = _reusedResults;
+	suite.m_recordedResults = _recordedResults;
+	suite.m_context.meter = _meter;
+	suite.m_context.noInlineFunctions = _noInlineFunctions;
 
 	// Some steps depend on properties ensured by FunctionHoister, BlockFlattener, FunctionGrouper and
 	// ForLoopInitRewriter. Run them first to be able to run arbitrary sequences safely.
 	suite.runSequence("hfgo", ast);
 
 	NameSimplifier::run(suite.m_context, ast);
-	// Now the user-supplied part
+	// Now the user-supplied part, which is cut short if the time budget is exhausted.
+	// The steps after it are always run, since the code may not be compilable otherwise.
+	if (_timeBudget)
+		suite.m_deadline = start + *_timeBudget;
 	suite.runSequence(_optimisationSequence, ast);
+	suite.m_deadline.reset();
 
 	// This is a tuning parameter, but actually just prevents infinite loops.
 	size_t stackCompressorMaxIterations = 16;
@@ -152,6 +176,27 @@ void OptimiserSuite::run(
 namespace
 {
 
+/// @returns a hash of @a _ast, which does not depend on the names of variables.
+uint64_t astHash(Block const& _ast)
+{
+	map<Block const*, uint64_t> blockHashes = BlockHasher::run(_ast);
+	// BlockHasher does not provide hashes for empty blocks.
+	auto it = blockHashes.find(&_ast);
+	return it == blockHashes.end() ? ASTHasherBase::fnvEmptyHash : it->second;
+}
+
+/// @returns a hash of the order of the function definitions and other statements in @a _ast,
+/// which is not reflected in the fingerprints of the functions.
+uint64_t statementOrder(Block const& _ast)
+{
+	uint64_t order = ASTHasherBase::fnvEmptyHash;
+	for (Statement const& statement: _ast.statements)
+	{
+		auto const* function = get_if<FunctionDefinition>(&statement);
+		order = (order * ASTHasherBase::fnvPrime) ^ (function ? function->name.hash() : 0);
+	}
+	return order;
+}
 
 template <class... Step>
 map<string, unique_ptr<OptimiserStep>> optimiserStepCollection()
@@ -171,40 +216,43 @@ map<string, unique_ptr<OptimiserStep>> optimiserStepCollection()
 
 map<string, unique_ptr<OptimiserStep>> const& OptimiserSuite::allSteps()
 {
-	static map<string, unique_ptr<OptimiserStep>> instance;
-	if (instance.empty())
-		instance = optimiserStepCollection<
-			BlockFlattener,
-			CircularReferencesPruner,
-			CommonSubexpressionEliminator,
-			ConditionalSimplifier,
-			ConditionalUnsimplifier,
-			ControlFlowSimplifier,
-			DeadCodeEliminator,
-			EquivalentFunctionCombiner,
-			ExpressionInliner,
-			ExpressionJoiner,
-			ExpressionSimplifier,
-			ExpressionSplitter,
-			ForLoopConditionIntoBody,
-			ForLoopConditionOutOfBody,
-			ForLoopInitRewriter,
-			FullInliner,
-			FunctionGrouper,
-			FunctionHoister,
-			LiteralRematerialiser,
-			LoadResolver,
-			LoopInvariantCodeMotion,
-			RedundantAssignEliminator,
-			ReasoningBasedSimplifier,
-			Rematerialiser,
-			SSAReverser,
-			SSATransform,
-			StructuralSimplifier,
-			UnusedFunctionParameterPruner,
-			UnusedPruner,
-			VarDeclInitializer
-		>();
+	static map<string, unique_ptr<OptimiserStep>> const instance = optimiserStepCollection<
+		BlockFlattener,
+		CircularReferencesPruner,
+		ColdCodeOutliner,
+		CommonSubexpressionEliminator,
+		ConditionalSimplifier,
+		ConditionalUnsimplifier,
+		ControlFlowSimplifier,
+		DeadCodeEliminator,
+		EquivalentFunctionCombiner,
+		ExpressionInliner,
+		ExpressionJoiner,
+		ExpressionSimplifier,
+		ExpressionSplitter,
+		ForLoopConditionIntoBody,
+		ForLoopConditionOutOfBody,
+		ForLoopInitRewriter,
+		FullInliner,
+		FunctionGrouper,
+		FunctionHoister,
+		FunctionSpecializer,
+		GlobalValueNumbering,
+		LiteralRematerialiser,
+		LoadResolver,
+		LoopInvariantCodeMotion,
+		LoopUnroller,
+		RedundantAssignEliminator,
+		ReasoningBasedSimplifier,
+		Rematerialiser,
+		SSAReverser,
+		SSATransform,
+		StructuralSimplifier,
+		UnusedFunctionParameterPruner,
+		UnusedPruner,
+		ValueRangeSimplifier,
+		VarDeclInitializer
+	>();
 	// Does not include VarNameCleaner because it destroys the property of unique names.
 	// Does not include NameSimplifier.
 	return instance;
@@ -215,6 +263,7 @@ map<string, char> const& OptimiserSuite::stepNameToAbbreviationMap()
 	static map<string, char> lookupTable{
 		{BlockFlattener::name,                'f'},
 		{CircularReferencesPruner::name,      'l'},
+		{ColdCodeOutliner::name,              'K'},
 		{CommonSubexpressionEliminator::name, 'c'},
 		{ConditionalSimplifier::name,         'C'},
 		{ConditionalUnsimplifier::name,       'U'},
@@ -231,9 +280,12 @@ map<string, char> const& OptimiserSuite::stepNameToAbbreviationMap()
 		{FullInliner::name,                   'i'},
 		{FunctionGrouper::name,               'g'},
 		{FunctionHoister::name,               'h'},
+		{FunctionSpecializer::name,           'F'},
+		{GlobalValueNumbering::name,          'G'},
 		{LiteralRematerialiser::name,         'T'},
 		{LoadResolver::name,                  'L'},
 		{LoopInvariantCodeMotion::name,       'M'},
+		{LoopUnroller::name,                  'N'},
 		{ReasoningBasedSimplifier::name,      'R'},
 		{RedundantAssignEliminator::name,     'r'},
 		{Rematerialiser::name,                'm'},
@@ -242,6 +294,7 @@ map<string, char> const& OptimiserSuite::stepNameToAbbreviationMap()
 		{StructuralSimplifier::name,          't'},
 		{UnusedFunctionParameterPruner::name, 'p'},
 		{UnusedPruner::name,                  'u'},
+		{ValueRangeSimplifier::name,          'B'},
 		{VarDeclInitializer::name,            'd'},
 	};
 	yulAssert(lookupTable.size() == allSteps().size(), "");
@@ -338,27 +391,16 @@ void OptimiserSuite::runSequence(string const& _stepAbbreviations, Block& _ast)
 
 void OptimiserSuite::runSequence(std::vector<string> const& _steps, Block& _ast)
 {
-	unique_ptr<Block> copy;
-	if (m_debug == Debug::PrintChanges)
-		copy = make_unique<Block>(std::get<Block>(ASTCopier{}(_ast)));
+	ChangeDetection changes = startChangeDetection(_ast);
+	m_analyses.track(&_ast);
 	for (string const& step: _steps)
 	{
-		if (m_debug == Debug::PrintStep)
-			cout << "Running " << step << endl;
-		allSteps().at(step)->run(m_context, _ast);
-		if (m_debug == Debug::PrintChanges)
-		{
-			// TODO should add switch to also compare variable names!
-			if (SyntacticallyEqual{}.statementEqual(_ast, *copy))
-				cout << "== Running " << step << " did not cause changes." << endl;
-			else
-			{
-				cout << "== Running " << step << " changed the AST." << endl;
-				cout << AsmPrinter{}(_ast) << endl;
-				copy = make_unique<Block>(std::get<Block>(ASTCopier{}(_ast)));
-			}
-		}
+		if (budgetExhausted())
+			break;
+		runStep(step, _ast, {}, changes);
+		m_analyses.modified();
 	}
+	m_analyses.track(nullptr);
 }
 
 void OptimiserSuite::runSequenceUntilStable(
@@ -370,14 +412,309 @@ void OptimiserSuite::runSequenceUntilStable(
 	if (_steps.empty())
 		return;
 
+	m_analyses.track(&_ast);
+	FunctionFingerprints fingerprints = AnalysisManager::functionFingerprints(_ast);
+	// Code sizes of the functions, together with the fingerprint they were computed for.
+	map<YulString, pair<uint64_t, size_t>> functionSizes;
+	vector<StepFingerprints> previousRound;
 	size_t codeSize = 0;
 	for (size_t rounds = 0; rounds < maxRounds; ++rounds)
 	{
-		size_t newSize = CodeSize::codeSizeIncludingFunctions(_ast);
-		if (newSize == codeSize)
+		// Equivalent to CodeSize::codeSizeIncludingFunctions(_ast), but only visits changed functions.
+		size_t newSize = 0;
+		for (Statement const& statement: _ast.statements)
+		{
+			auto const* function = get_if<FunctionDefinition>(&statement);
+			if (!function)
+			{
+				newSize += CodeSize::codeSizeIncludingFunctions(statement);
+				continue;
+			}
+			uint64_t fingerprint = fingerprints.at(function->name);
+			auto it = functionSizes.find(function->name);
+			if (it == functionSizes.end() || it->second.first != fingerprint)
+				it = functionSizes.insert_or_assign(
+					function->name,
+					make_pair(fingerprint, CodeSize::codeSizeIncludingFunctions(statement))
+				).first;
+			newSize += it->second.second;
+		}
+		if (newSize == codeSize || budgetExhausted())
 			break;
 		codeSize = newSize;
 
-		runSequence(_steps, _ast);
+		vector<StepFingerprints> currentRound;
+		runSequenceRound(_steps, _ast, previousRound, currentRound);
+		fingerprints = currentRound.back().after;
+		previousRound = move(currentRound);
+	}
+	m_analyses.track(nullptr);
+}
+
+void OptimiserSuite::runStep(
+	string const& _step,
+	Block& _ast,
+	set<YulString> const& _skippedFunctions,
+	ChangeDetection& _changes
+)
+{
+	util::CompilationStatistics* statistics = util::CompilationStatistics::current();
+	if (m_debug == Debug::PrintStep)
+		cout << "Running " << _step << endl;
+
+	OptimiserStep const& step = *allSteps().at(_step);
+	util::Tracer::Span span("yulOptimiserStep", _step);
+	auto const start = chrono::steady_clock::now();
+
+	set<YulString> const* skippedFunctions = &_skippedFunctions;
+	set<YulString> skippedFunctionsWithResults;
+	map<YulString, FunctionDefinition> reusedResults;
+	map<YulString, FunctionStepCache::Shape> recordedInputs;
+	if ((m_reusedResults || m_recordedResults) && step.independentOfOtherFunctions())
+	{
+		skippedFunctionsWithResults = _skippedFunctions;
+		findFunctionResults(_step, _ast, skippedFunctionsWithResults, reusedResults, recordedInputs);
+		skippedFunctions = &skippedFunctionsWithResults;
+	}
+
+	if (
+		!step.functionLocal() ||
+		m_threadPool.threads() == 1 ||
+		!runFunctionLocalStepConcurrently(step, _ast, *skippedFunctions)
+	)
+	{
+		// Function-local steps do not modify empty function bodies.
+		vector<pair<FunctionDefinition*, Block>> skippedBodies;
+		if (!skippedFunctions->empty())
+			for (Statement& statement: _ast.statements)
+				if (auto* function = get_if<FunctionDefinition>(&statement))
+					if (skippedFunctions->count(function->name))
+					{
+						skippedBodies.emplace_back(function, Block{function->body.location, {}});
+						swap(function->body, skippedBodies.back().second);
+					}
+
+		step.run(m_context, _ast);
+
+		for (auto& [function, body]: skippedBodies)
+		{
+			yulAssert(function->body.statements.empty(), "");
+			swap(function->body, body);
+		}
+	}
+
+	// The concurrent application does not leave out every skipped function, so the reused
+	// results replace whatever the step did to the function.
+	if (!reusedResults.empty() || !recordedInputs.empty())
+		for (Statement& statement: _ast.statements)
+			if (auto* function = get_if<FunctionDefinition>(&statement))
+			{
+				if (auto result = reusedResults.find(function->name); result != reusedResults.end())
+					*function = move(result->second);
+				else if (auto input = recordedInputs.find(function->name); input != recordedInputs.end())
+					m_recordedResults->record(_step, input->second, *function);
+			}
+	if (statistics && skippedFunctions->size() > _skippedFunctions.size())
+		statistics->recordCount("yulOptimiser/reusedFunctionResults", skippedFunctions->size() - _skippedFunctions.size());
+	auto const time = chrono::steady_clock::now() - start;
+
+	if (util::MemoryAccounting::enabled())
+	{
+		size_t const astBytes = ASTMemoryUsage::memoryUsage(_ast);
+		m_astMemory.set(astBytes);
+		util::MemoryAccounting::recordMeasurement("yulAST/" + _step, astBytes);
+	}
+
+	if (_changes.copy)
+	{
+		// TODO should add switch to also compare variable names!
+		bool const changed = !SyntacticallyEqual{}.statementEqual(_ast, *_changes.copy);
+		if (statistics)
+			statistics->recordOptimiserStep(_step, changed, time);
+		if (!changed)
+			cout << "== Running " << _step << " did not cause changes." << endl;
+		else
+		{
+			cout << "== Running " << _step << " changed the AST." << endl;
+			cout << AsmPrinter{}(_ast) << endl;
+			_changes.copy = make_unique<Block>(std::get<Block>(ASTCopier{}(_ast)));
+		}
+	}
+	else if (_changes.hash)
+	{
+		// Like SyntacticallyEqual, the hash does not take the names of variables into account.
+		uint64_t hash = astHash(_ast);
+		yulAssert(statistics, "");
+		statistics->recordOptimiserStep(_step, hash != *_changes.hash, time);
+		_changes.hash = hash;
+	}
+}
+
+OptimiserSuite::ChangeDetection OptimiserSuite::startChangeDetection(Block const& _ast) const
+{
+	ChangeDetection changes;
+	if (m_debug == Debug::PrintChanges)
+		changes.copy = make_unique<Block>(std::get<Block>(ASTCopier{}(_ast)));
+	else if (util::CompilationStatistics::current())
+		changes.hash = astHash(_ast);
+	return changes;
+}
+
+void OptimiserSuite::findFunctionResults(
+	string const& _step,
+	Block const& _ast,
+	set<YulString>& _skippedFunctions,
+	map<YulString, FunctionDefinition>& _reusedResults,
+	map<YulString, FunctionStepCache::Shape>& _recordedInputs
+) const
+{
+	for (Statement const& statement: _ast.statements)
+		if (auto const* function = get_if<FunctionDefinition>(&statement))
+		{
+			if (_skippedFunctions.count(function->name))
+				continue;
+			FunctionStepCache::Shape shape = FunctionStepCache::shape(*function);
+			if (m_reusedResults)
+			{
+				FunctionDefinition result;
+				FunctionStepCache::Lookup lookup = m_reusedResults->find(_step, *function, shape, result);
+				if (lookup != FunctionStepCache::Lookup::Unknown)
+				{
+					_skippedFunctions.insert(function->name);
+					if (lookup == FunctionStepCache::Lookup::Changed)
+						_reusedResults.emplace(function->name, move(result));
+					continue;
+				}
+			}
+			if (m_recordedResults)
+				_recordedInputs.emplace(function->name, move(shape));
+		}
+}
+
+bool OptimiserSuite::runFunctionLocalStepConcurrently(
+	OptimiserStep const& _step,
+	Block& _ast,
+	set<YulString> const& _skippedFunctions
+)
+{
+	// The statements before the first function definition form one part, the function
+	// definitions are split into groups of consecutive functions.
+	auto firstFunction = find_if(_ast.statements.begin(), _ast.statements.end(), [](Statement const& _statement) {
+		return holds_alternative<FunctionDefinition>(_statement);
+	});
+	if (!all_of(firstFunction, _ast.statements.end(), [](Statement const& _statement) {
+		return holds_alternative<FunctionDefinition>(_statement);
+	}))
+		return false;
+	size_t const codeStatements = static_cast<size_t>(firstFunction - _ast.statements.begin());
+	size_t const functions = _ast.statements.size() - codeStatements;
+	if (functions == 0)
+		return false;
+
+	// The information about the complete AST has to be collected before any part is modified.
+	function<void(Block&)> applyStep = _step.prepare(m_context, _ast);
+
+	size_t const groupCount = min(functions, 4 * m_threadPool.threads());
+	vector<Block> parts;
+	for (size_t part = 0; part < 1 + groupCount; ++part)
+		parts.emplace_back(Block{_ast.location, {}});
+	vector<bool> skipped(parts.size(), true);
+	for (size_t i = 0; i < _ast.statements.size(); ++i)
+	{
+		size_t part = i < codeStatements ? 0 : 1 + (i - codeStatements) * groupCount / functions;
+		Statement& statement = _ast.statements[i];
+		if (auto const* function = get_if<FunctionDefinition>(&statement))
+		{
+			if (!_skippedFunctions.count(function->name))
+				skipped[part] = false;
+		}
+		else
+			skipped[part] = false;
+		parts[part].statements.emplace_back(move(statement));
+	}
+	// Skipped functions are only left out if their whole group can be left out, which keeps
+	// the groups independent of the functions that are skipped.
+
+	for (size_t part = 0; part < parts.size(); ++part)
+		if (!skipped[part] && !parts[part].statements.empty())
+			m_threadPool.submit([&applyStep, &parts, part]() { applyStep(parts[part]); });
+
+	auto reassemble = [&]() {
+		_ast.statements.clear();
+		for (Block& part: parts)
+			for (Statement& statement: part.statements)
+				_ast.statements.emplace_back(move(statement));
+	};
+	try
+	{
+		m_threadPool.wait();
+	}
+	catch (...)
+	{
+		reassemble();
+		throw;
+	}
+	reassemble();
+	return true;
+}
+
+void OptimiserSuite::runSequenceRound(
+	vector<string> const& _steps,
+	Block& _ast,
+	vector<StepFingerprints> const& _previousRound,
+	vector<StepFingerprints>& _currentRound
+)
+{
+	yulAssert(_previousRound.empty() || _previousRound.size() == _steps.size(), "");
+
+	ChangeDetection changes = startChangeDetection(_ast);
+
+	FunctionFingerprints fingerprints = AnalysisManager::functionFingerprints(_ast);
+	uint64_t order = statementOrder(_ast);
+	for (size_t i = 0; i < _steps.size(); ++i)
+	{
+		// The step would not change anything now, since it did not change anything in the
+		// previous round and all other steps since then did not change anything either.
+		if (
+			!_previousRound.empty() &&
+			_previousRound[i].orderBefore == _previousRound[i].orderAfter &&
+			_previousRound[i].orderAfter == order &&
+			_previousRound[i].before == _previousRound[i].after &&
+			_previousRound[i].after == fingerprints
+		)
+		{
+			if (m_debug == Debug::PrintStep)
+				cout << "Skipping " << _steps[i] << endl;
+			_currentRound.push_back({fingerprints, fingerprints, order, order});
+			continue;
+		}
+
+		// The step would not change the function again, since it is function-local and
+		// has the same input as in the previous round, on which it did not change anything.
+		set<YulString> skippedFunctions;
+		if (!_previousRound.empty() && allSteps().at(_steps[i])->independentOfOtherFunctions())
+			for (auto const& [name, fingerprint]: fingerprints)
+			{
+				if (name.empty())
+					continue;
+				auto before = _previousRound[i].before.find(name);
+				auto after = _previousRound[i].after.find(name);
+				if (
+					before != _previousRound[i].before.end() &&
+					after != _previousRound[i].after.end() &&
+					before->second == fingerprint &&
+					after->second == fingerprint
+				)
+					skippedFunctions.insert(name);
+			}
+
+		runStep(_steps[i], _ast, skippedFunctions, changes);
+
+		FunctionFingerprints newFingerprints = AnalysisManager::functionFingerprints(_ast);
+		uint64_t newOrder = statementOrder(_ast);
+		m_analyses.modified(&newFingerprints);
+		_currentRound.push_back({move(fingerprints), newFingerprints, order, newOrder});
+		fingerprints = move(newFingerprints);
+		order = newOrder;
 	}
 }
@@ -23,13 +23,22 @@
 
 #include <libyul/ASTForward.h>
 #include <libyul/YulString.h>
+#include <libyul/optimiser/AnalysisManager.h>
+#include <libyul/optimiser/FunctionStepCache.h>
 #include <libyul/optimiser/OptimiserStep.h>
 #include <libyul/optimiser/NameDispenser.h>
 #include <liblangutil/EVMVersion.h>
 
+#include <libsolutil/MemoryAccounting.h>
+#include <libsolutil/ThreadPool.h>
+
+#include <chrono>
+#include <map>
 #include <set>
 #include <string>
 #include <memory>
+#include <optional>
+#include <vector>
 
 namespace solidity::yul
 {
@@ -58,13 +67,20 @@ public:
 		PrintStep,
 		PrintChanges
 	};
+	/// Optimises the code of @a _object. The functions in @a _noInlineFunctions are not inlined
+	/// into their callers.
 	static void run(
 		Dialect const& _dialect,
 		GasMeter const* _meter,
 		Object& _object,
 		bool _optimizeStackAllocation,
 		std::string const& _optimisationSequence,
-		std::set<YulString> const& _externallyUsedIdentifiers = {}
+		std::set<YulString> const& _externallyUsedIdentifiers = {},
+		size_t _parallelism = 1,
+		std::optional<std::chrono::milliseconds> _timeBudget = std::nullopt,
+		FunctionStepCache const* _reusedResults = nullptr,
+		FunctionStepCache* _recordedResults = nullptr,
+		std::set<YulString> const& _noInlineFunctions = {}
 	);
 
 	/// Ensures that specified sequence of step abbreviations is well-formed and can be executed.
@@ -84,20 +100,106 @@ public:
 	static std::map<char, std::string> const& stepAbbreviationToNameMap();
 
 private:
+	/// @returns true if the time budget for the user-supplied sequence is exhausted,
+	/// in which case no further steps of the sequence are run.
+	bool budgetExhausted() const { return m_deadline && std::chrono::steady_clock::now() >= *m_deadline; }
+
+	/// Fingerprints of the function bodies and of the order of the top-level statements
+	/// before and after a step.
+	struct StepFingerprints
+	{
+		FunctionFingerprints before;
+		FunctionFingerprints after;
+		uint64_t orderBefore = 0;
+		uint64_t orderAfter = 0;
+	};
+
+	/// State of the AST before a step, used to detect whether the step changed it.
+	struct ChangeDetection
+	{
+		/// Copy of the AST, only kept if changes are printed.
+		std::unique_ptr<Block> copy;
+		/// Hash of the AST, if changes are only recorded in the compilation statistics.
+		std::optional<uint64_t> hash;
+	};
+
+	/// @returns the state of @a _ast needed to detect the changes of the following steps,
+	/// which is empty unless changes are printed or recorded.
+	ChangeDetection startChangeDetection(Block const& _ast) const;
+
+	/// Runs the step on @a _ast except for the bodies of the functions in @a _skippedFunctions.
+	/// Function-local steps are applied to groups of functions concurrently if the suite uses
+	/// more than one thread.
+	/// @a _changes is used to detect and report changes and updated accordingly.
+	void runStep(
+		std::string const& _step,
+		Block& _ast,
+		std::set<YulString> const& _skippedFunctions,
+		ChangeDetection& _changes
+	);
+
+	/// Runs the sequence like runSequence() and records the fingerprints of the function bodies
+	/// in @a _currentRound. Steps that did not change anything in @a _previousRound are skipped
+	/// if nothing changed since then. Function-local steps that are independent of other functions
+	/// are not applied to functions that they did not change in @a _previousRound, if the function
+	/// did not change since then.
+	void runSequenceRound(
+		std::vector<std::string> const& _steps,
+		Block& _ast,
+		std::vector<StepFingerprints> const& _previousRound,
+		std::vector<StepFingerprints>& _currentRound
+	);
+
 	OptimiserSuite(
 		Dialect const& _dialect,
 		std::set<YulString> const& _externallyUsedIdentifiers,
 		Debug _debug,
-		Block& _ast
+		Block& _ast,
+		size_t _parallelism = 1
 	):
 		m_dispenser{_dialect, _ast, _externallyUsedIdentifiers},
-		m_context{_dialect, m_dispenser, _externallyUsedIdentifiers},
-		m_debug(_debug)
+		m_analyses{_dialect},
+		m_context{_dialect, m_dispenser, _externallyUsedIdentifiers, &m_analyses},
+		m_debug(_debug),
+		m_threadPool(_parallelism)
 	{}
 
+	/// Looks up the results of the step @a _step for the functions of @a _ast in m_reusedResults.
+	/// The functions found are added to @a _skippedFunctions and, if the step changes them, their
+	/// results to @a _reusedResults. If results are recorded, @a _recordedInputs is filled with
+	/// the shapes of the remaining functions.
+	void findFunctionResults(
+		std::string const& _step,
+		Block const& _ast,
+		std::set<YulString>& _skippedFunctions,
+		std::map<YulString, FunctionDefinition>& _reusedResults,
+		std::map<YulString, FunctionStepCache::Shape>& _recordedInputs
+	) const;
+
+	/// Applies the function-local step @a _step to the parts of @a _ast concurrently, except
+	/// for the functions in @a _skippedFunctions.
+	/// @returns false without modifying @a _ast if it cannot be split into independent parts,
+	/// i.e. if function definitions and other statements are interleaved.
+	bool runFunctionLocalStepConcurrently(
+		OptimiserStep const& _step,
+		Block& _ast,
+		std::set<YulString> const& _skippedFunctions
+	);
+
 	NameDispenser m_dispenser;
+	/// Only tracks the AST while a sequence is run, since the AST is also modified in between.
+	AnalysisManager m_analyses;
 	OptimiserStepContext m_context;
 	Debug m_debug;
+	util::ThreadPool m_threadPool;
+	/// Point in time after which no further steps of the current sequence are run, if any.
+	std::optional<std::chrono::steady_clock::time_point> m_deadline;
+	/// Results of steps on functions of other objects that can be reused, if any.
+	FunctionStepCache const* m_reusedResults = nullptr;
+	/// Records the results of steps on functions for other objects, if not null.
+	FunctionStepCache* m_recordedResults = nullptr;
+	/// Estimated memory of the AST after the last step, while memory accounting is enabled.
+	util::MemoryAccount m_astMemory{util::MemorySubsystem::YulAST};
 };
 
 }
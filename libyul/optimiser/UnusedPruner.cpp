@@ -29,10 +29,62 @@
 #include <libyul/Dialect.h>
 #include <libyul/SideEffects.h>
 
+#include <libsolutil/CommonData.h>
+
+#include <boost/range/algorithm_ext/erase.hpp>
+
+#include <functional>
+
 using namespace std;
 using namespace solidity;
 using namespace solidity::yul;
 
+namespace
+{
+
+/// Removes the empty blocks from all blocks, before visiting the remaining statements.
+class EmptyBlockRemover: public ASTModifier
+{
+public:
+	using ASTModifier::operator();
+	void operator()(Block& _block) override
+	{
+		removeEmptyBlocks(_block);
+		ASTModifier::operator()(_block);
+	}
+};
+
+/// Calls a function for every statement in a block, including the nested ones.
+class StatementCollector: public ASTWalker
+{
+public:
+	explicit StatementCollector(function<void(Statement const&)> _callback): m_callback(move(_callback)) {}
+	using ASTWalker::operator();
+	void visit(Statement const& _statement) override
+	{
+		m_callback(_statement);
+		ASTWalker::visit(_statement);
+	}
+
+private:
+	function<void(Statement const&)> m_callback;
+};
+
+}
+
+void UnusedPruner::run(OptimiserStepContext& _context, Block& _ast)
+{
+	map<YulString, SideEffects> functionSideEffects = SideEffectsPropagator::sideEffects(_context, _ast);
+	bool allowMSizeOptimization = !MSizeFinder::containsMSize(_context, _ast);
+	runUntilStabilised(
+		_context.dialect,
+		_ast,
+		allowMSizeOptimization,
+		&functionSideEffects,
+		_context.reservedIdentifiers
+	);
+}
+
 UnusedPruner::UnusedPruner(
 	Dialect const& _dialect,
 	Block& _ast,
@@ -65,62 +117,15 @@ UnusedPruner::UnusedPruner(
 
 void UnusedPruner::operator()(Block& _block)
 {
-	for (auto&& statement: _block.statements)
+	for (auto& statement: _block.statements)
+	{
+		prune(statement);
 		if (holds_alternative<FunctionDefinition>(statement))
-		{
-			FunctionDefinition& funDef = std::get<FunctionDefinition>(statement);
-			if (!used(funDef.name))
-			{
-				subtractReferences(ReferencesCounter::countReferences(funDef.body));
-				statement = Block{std::move(funDef.location), {}};
-			}
-		}
+			m_declarations[std::get<FunctionDefinition>(statement).name].push_back(&statement);
 		else if (holds_alternative<VariableDeclaration>(statement))
-		{
-			VariableDeclaration& varDecl = std::get<VariableDeclaration>(statement);
-			// Multi-variable declarations are special. We can only remove it
-			// if all variables are unused and the right-hand-side is either
-			// movable or it returns a single value. In the latter case, we
-			// replace `let a := f()` by `pop(f())` (in pure Yul, this will be
-			// `drop(f())`).
-			if (std::none_of(
-				varDecl.variables.begin(),
-				varDecl.variables.end(),
-				[&](TypedName const& _typedName) { return used(_typedName.name); }
-			))
-			{
-				if (!varDecl.value)
-					statement = Block{std::move(varDecl.location), {}};
-				else if (
-					SideEffectsCollector(m_dialect, *varDecl.value, m_functionSideEffects).
-					canBeRemoved(m_allowMSizeOptimization)
-				)
-				{
-					subtractReferences(ReferencesCounter::countReferences(*varDecl.value));
-					statement = Block{std::move(varDecl.location), {}};
-				}
-				else if (varDecl.variables.size() == 1 && m_dialect.discardFunction(varDecl.variables.front().type))
-					statement = ExpressionStatement{varDecl.location, FunctionCall{
-						varDecl.location,
-						{varDecl.location, m_dialect.discardFunction(varDecl.variables.front().type)->name},
-						{*std::move(varDecl.value)}
-					}};
-			}
-		}
-		else if (holds_alternative<ExpressionStatement>(statement))
-		{
-			ExpressionStatement& exprStmt = std::get<ExpressionStatement>(statement);
-			if (
-				SideEffectsCollector(m_dialect, exprStmt.expression, m_functionSideEffects).
-				canBeRemoved(m_allowMSizeOptimization)
-			)
-			{
-				subtractReferences(ReferencesCounter::countReferences(exprStmt.expression));
-				statement = Block{std::move(exprStmt.location), {}};
-			}
-		}
-
-	removeEmptyBlocks(_block);
+			for (TypedName const& variable: std::get<VariableDeclaration>(statement).variables)
+				m_declarations[variable.name].push_back(&statement);
+	}
 
 	ASTModifier::operator()(_block);
 }
@@ -133,15 +138,10 @@ void UnusedPruner::runUntilStabilised(
 	set<YulString> const& _externallyUsedFunctions
 )
 {
-	while (true)
-	{
-		UnusedPruner pruner(
-			_dialect, _ast, _allowMSizeOptimization, _functionSideEffects,
-							_externallyUsedFunctions);
-		pruner(_ast);
-		if (!pruner.shouldRunAgain())
-			return;
-	}
+	UnusedPruner pruner(_dialect, _ast, _allowMSizeOptimization, _functionSideEffects, _externallyUsedFunctions);
+	pruner(_ast);
+	pruner.pruneUnusedDeclarations();
+	EmptyBlockRemover{}(_ast);
 }
 
 void UnusedPruner::runUntilStabilisedOnFullAST(
@@ -163,13 +163,101 @@ void UnusedPruner::runUntilStabilised(
 	set<YulString> const& _externallyUsedFunctions
 )
 {
-	while (true)
+	UnusedPruner pruner(_dialect, _function, _allowMSizeOptimization, _externallyUsedFunctions);
+	pruner(_function);
+	pruner.pruneUnusedDeclarations();
+	EmptyBlockRemover{}(_function.body);
+}
+
+void UnusedPruner::prune(Statement& _statement)
+{
+	if (holds_alternative<FunctionDefinition>(_statement))
 	{
-		UnusedPruner pruner(_dialect, _function, _allowMSizeOptimization, _externallyUsedFunctions);
-		pruner(_function);
-		if (!pruner.shouldRunAgain())
-			return;
+		FunctionDefinition& funDef = std::get<FunctionDefinition>(_statement);
+		if (!used(funDef.name))
+		{
+			forgetDeclarations(funDef.body);
+			subtractReferences(ReferencesCounter::countReferences(funDef.body));
+			_statement = Block{std::move(funDef.location), {}};
+		}
 	}
+	else if (holds_alternative<VariableDeclaration>(_statement))
+	{
+		VariableDeclaration& varDecl = std::get<VariableDeclaration>(_statement);
+		// Multi-variable declarations are special. We can only remove it
+		// if all variables are unused and the right-hand-side is either
+		// movable or it returns a single value. In the latter case, we
+		// replace `let a := f()` by `pop(f())` (in pure Yul, this will be
+		// `drop(f())`).
+		if (std::none_of(
+			varDecl.variables.begin(),
+			varDecl.variables.end(),
+			[&](TypedName const& _typedName) { return used(_typedName.name); }
+		))
+		{
+			if (!varDecl.value)
+				_statement = Block{std::move(varDecl.location), {}};
+			else if (
+				SideEffectsCollector(m_dialect, *varDecl.value, m_functionSideEffects).
+				canBeRemoved(m_allowMSizeOptimization)
+			)
+			{
+				subtractReferences(ReferencesCounter::countReferences(*varDecl.value));
+				_statement = Block{std::move(varDecl.location), {}};
+			}
+			else if (varDecl.variables.size() == 1 && m_dialect.discardFunction(varDecl.variables.front().type))
+				_statement = ExpressionStatement{varDecl.location, FunctionCall{
+					varDecl.location,
+					{varDecl.location, m_dialect.discardFunction(varDecl.variables.front().type)->name},
+					{*std::move(varDecl.value)}
+				}};
+		}
+	}
+	else if (holds_alternative<ExpressionStatement>(_statement))
+	{
+		ExpressionStatement& exprStmt = std::get<ExpressionStatement>(_statement);
+		if (
+			SideEffectsCollector(m_dialect, exprStmt.expression, m_functionSideEffects).
+			canBeRemoved(m_allowMSizeOptimization)
+		)
+		{
+			subtractReferences(ReferencesCounter::countReferences(exprStmt.expression));
+			_statement = Block{std::move(exprStmt.location), {}};
+		}
+	}
+}
+
+void UnusedPruner::pruneUnusedDeclarations()
+{
+	while (!m_unusedNames.empty())
+	{
+		YulString name = m_unusedNames.back();
+		m_unusedNames.pop_back();
+		auto declarations = m_declarations.find(name);
+		if (declarations == m_declarations.end())
+			continue;
+		// Pruning one of the statements can remove the others, so they are re-checked each time.
+		vector<Statement*> statements = declarations->second;
+		for (Statement* statement: statements)
+			if (util::contains(declarations->second, statement))
+				prune(*statement);
+	}
+}
+
+void UnusedPruner::forgetDeclarations(Block const& _block)
+{
+	auto forget = [&](YulString _name, Statement const& _statement) {
+		auto declarations = m_declarations.find(_name);
+		if (declarations != m_declarations.end())
+			boost::range::remove_erase_if(declarations->second, [&](Statement const* _other) { return _other == &_statement; });
+	};
+	StatementCollector{[&](Statement const& _statement) {
+		if (holds_alternative<FunctionDefinition>(_statement))
+			forget(std::get<FunctionDefinition>(_statement).name, _statement);
+		else if (holds_alternative<VariableDeclaration>(_statement))
+			for (TypedName const& variable: std::get<VariableDeclaration>(_statement).variables)
+				forget(variable.name, _statement);
+	}}(_block);
 }
 
 bool UnusedPruner::used(YulString _name) const
@@ -184,6 +272,7 @@ void UnusedPruner::subtractReferences(map<YulString, size_t> const& _subtrahend)
 		assertThrow(m_references.count(ref.first), OptimizerException, "");
 		assertThrow(m_references.at(ref.first) >= ref.second, OptimizerException, "");
 		m_references[ref.first] -= ref.second;
-		m_shouldRunAgain = true;
+		if (m_references.at(ref.first) == 0)
+			m_unusedNames.push_back(ref.first);
 	}
 }
@@ -27,6 +27,7 @@
 
 #include <map>
 #include <set>
+#include <vector>
 
 namespace solidity::yul
 {
@@ -44,23 +45,22 @@ struct SideEffects;
  *
  * Note that this does not remove circular references.
  *
+ * The references are counted once. When code is removed, the references in it are
+ * subtracted and the declarations whose names are no longer referenced are revisited,
+ * so the whole AST is only traversed once.
+ *
  * Prerequisite: Disambiguator
  */
 class UnusedPruner: public ASTModifier
 {
 public:
 	static constexpr char const* name{"UnusedPruner"};
-	static void run(OptimiserStepContext& _context, Block& _ast) {
-		UnusedPruner::runUntilStabilisedOnFullAST(_context.dialect, _ast, _context.reservedIdentifiers);
-	}
+	static void run(OptimiserStepContext& _context, Block& _ast);
 
 
 	using ASTModifier::operator();
 	void operator()(Block& _block) override;
 
-	// @returns true iff the code changed in the previous run.
-	bool shouldRunAgain() const { return m_shouldRunAgain; }
-
 	// Run the pruner until the code does not change anymore.
 	static void runUntilStabilised(
 		Dialect const& _dialect,
@@ -116,14 +116,25 @@ private:
 		std::set<YulString> const& _externallyUsedFunctions = {}
 	);
 
+	/// Removes @a _statement or replaces it by a simpler statement if it is not needed.
+	void prune(Statement& _statement);
+	/// Revisits the declarations of the names that became unused until none are left.
+	void pruneUnusedDeclarations();
+	/// Removes the declarations inside the code of @a _block, which is about to be removed.
+	void forgetDeclarations(Block const& _block);
+
 	bool used(YulString _name) const;
 	void subtractReferences(std::map<YulString, size_t> const& _subtrahend);
 
 	Dialect const& m_dialect;
 	bool m_allowMSizeOptimization = false;
 	std::map<YulString, SideEffects> const* m_functionSideEffects = nullptr;
-	bool m_shouldRunAgain = false;
 	std::map<YulString, size_t> m_references;
+	/// Statements that declare a name, i.e. function definitions and variable declarations.
+	/// Empty blocks are only removed at the end, so the statements do not move.
+	std::map<YulString, std::vector<Statement*>> m_declarations;
+	/// Names whose reference count dropped to zero.
+	std::vector<YulString> m_unusedNames;
 };
 
 }
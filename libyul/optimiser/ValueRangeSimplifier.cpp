@@ -0,0 +1,517 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Optimiser component that removes comparisons that are decided by the ranges of values.
+ */
+
+#include <libyul/optimiser/ValueRangeSimplifier.h>
+
+#include <libyul/optimiser/NameCollector.h>
+#include <libyul/optimiser/Semantics.h>
+#include <libyul/backends/evm/EVMDialect.h>
+#include <libyul/AST.h>
+#include <libyul/Utilities.h>
+
+#include <libsolutil/CommonData.h>
+#include <libsolutil/Visitor.h>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::evmasm;
+using namespace solidity::util;
+using namespace solidity::yul;
+
+namespace
+{
+
+/// Collects all function definitions.
+class FunctionCollector: public ASTWalker
+{
+public:
+	using ASTWalker::operator();
+	void operator()(FunctionDefinition const& _function) override
+	{
+		functions.push_back(&_function);
+		ASTWalker::operator()(_function);
+	}
+
+	vector<FunctionDefinition const*> functions;
+};
+
+/// Checks whether a function body contains ``leave``, ignoring nested functions.
+class LeaveFinder: public ASTWalker
+{
+public:
+	using ASTWalker::operator();
+	void operator()(Leave const&) override { found = true; }
+	void operator()(FunctionDefinition const&) override {}
+
+	bool found = false;
+};
+
+/// @returns the names of the functions that do not contain ``leave`` and unconditionally
+/// call a terminating builtin or another such function.
+set<YulString> nonReturningFunctions(Dialect const& _dialect, Block const& _ast)
+{
+	FunctionCollector collector;
+	collector(_ast);
+
+	set<YulString> nonReturning;
+	bool changed = true;
+	while (changed)
+	{
+		changed = false;
+		for (FunctionDefinition const* function: collector.functions)
+		{
+			if (nonReturning.count(function->name))
+				continue;
+			LeaveFinder leaveFinder;
+			leaveFinder(function->body);
+			if (leaveFinder.found)
+				continue;
+			for (Statement const& statement: function->body.statements)
+				if (auto const* expressionStatement = get_if<ExpressionStatement>(&statement))
+					if (auto const* call = get_if<FunctionCall>(&expressionStatement->expression))
+						if (
+							TerminationFinder{_dialect}.isTerminatingBuiltin(*expressionStatement) ||
+							nonReturning.count(call->functionName.name)
+						)
+						{
+							nonReturning.insert(function->name);
+							changed = true;
+							break;
+						}
+		}
+	}
+	return nonReturning;
+}
+
+bool isComparison(Instruction _instruction)
+{
+	switch (_instruction)
+	{
+	case Instruction::LT:
+	case Instruction::GT:
+	case Instruction::SLT:
+	case Instruction::SGT:
+	case Instruction::EQ:
+	case Instruction::ISZERO:
+		return true;
+	default:
+		return false;
+	}
+}
+
+/// @returns the smallest value of the form ``2**n - 1`` that is at least @a _value.
+u256 allBitsUpTo(u256 const& _value)
+{
+	u256 result = 0;
+	while (result < _value)
+		result = (result << 1) | 1;
+	return result;
+}
+
+}
+
+void ValueRangeSimplifier::run(OptimiserStepContext& _context, Block& _ast)
+{
+	ValueRangeSimplifier{_context.dialect, nonReturningFunctions(_context.dialect, _ast)}(_ast);
+}
+
+void ValueRangeSimplifier::operator()(ExpressionStatement& _statement)
+{
+	ASTModifier::operator()(_statement);
+	if (auto const* call = get_if<FunctionCall>(&_statement.expression))
+		if (
+			TerminationFinder{m_dialect}.isTerminatingBuiltin(_statement) ||
+			m_nonReturningFunctions.count(call->functionName.name)
+		)
+			m_knowledge.reachable = false;
+}
+
+void ValueRangeSimplifier::operator()(Assignment& _assignment)
+{
+	ASTModifier::operator()(_assignment);
+	if (_assignment.variableNames.size() == 1)
+		m_knowledge.ranges[_assignment.variableNames.front().name] = rangeOf(*_assignment.value);
+	else
+		for (auto const& variable: _assignment.variableNames)
+			m_knowledge.ranges.erase(variable.name);
+}
+
+void ValueRangeSimplifier::operator()(VariableDeclaration& _varDecl)
+{
+	ASTModifier::operator()(_varDecl);
+	if (!_varDecl.value)
+		for (auto const& variable: _varDecl.variables)
+			m_knowledge.ranges[variable.name] = Range{0, 0};
+	else if (_varDecl.variables.size() == 1)
+		m_knowledge.ranges[_varDecl.variables.front().name] = rangeOf(*_varDecl.value);
+	else
+		for (auto const& variable: _varDecl.variables)
+			m_knowledge.ranges.erase(variable.name);
+}
+
+void ValueRangeSimplifier::operator()(If& _if)
+{
+	visit(*_if.condition);
+
+	Knowledge before = m_knowledge;
+	constrain(*_if.condition, true);
+	(*this)(_if.body);
+	Knowledge afterBody = move(m_knowledge);
+
+	m_knowledge = move(before);
+	constrain(*_if.condition, false);
+	m_knowledge = join(move(m_knowledge), afterBody);
+}
+
+void ValueRangeSimplifier::operator()(Switch& _switch)
+{
+	visit(*_switch.expression);
+
+	Knowledge before = m_knowledge;
+	Knowledge after{false, {}};
+	bool hasDefault = false;
+	for (auto& switchCase: _switch.cases)
+	{
+		m_knowledge = before;
+		if (switchCase.value)
+		{
+			u256 value = valueOfLiteral(*switchCase.value);
+			restrict(*_switch.expression, Range{value, value});
+		}
+		else
+			hasDefault = true;
+		(*this)(switchCase.body);
+		after = join(move(after), m_knowledge);
+	}
+	if (!hasDefault)
+		after = join(move(after), before);
+	m_knowledge = move(after);
+}
+
+void ValueRangeSimplifier::operator()(FunctionDefinition& _function)
+{
+	Knowledge outerKnowledge = move(m_knowledge);
+	vector<LoopExits> outerLoops = move(m_loops);
+
+	m_knowledge = {};
+	m_loops.clear();
+	for (auto const& variable: _function.returnVariables)
+		m_knowledge.ranges[variable.name] = Range{0, 0};
+	(*this)(_function.body);
+
+	m_knowledge = move(outerKnowledge);
+	m_loops = move(outerLoops);
+}
+
+void ValueRangeSimplifier::operator()(ForLoop& _for)
+{
+	(*this)(_for.pre);
+
+	// The knowledge at the start of each iteration only includes the variables that
+	// are not assigned inside the loop.
+	Assignments assignments;
+	assignments.visit(*_for.condition);
+	assignments(_for.body);
+	assignments(_for.post);
+	for (auto const& name: assignments.names())
+		m_knowledge.ranges.erase(name);
+
+	visit(*_for.condition);
+	Knowledge head = m_knowledge;
+
+	m_loops.emplace_back();
+	constrain(*_for.condition, true);
+	(*this)(_for.body);
+	m_knowledge = join(move(m_knowledge), m_loops.back().continues);
+	(*this)(_for.post);
+	Knowledge breaks = move(m_loops.back().breaks);
+	m_loops.pop_back();
+
+	m_knowledge = move(head);
+	constrain(*_for.condition, false);
+	m_knowledge = join(move(m_knowledge), breaks);
+}
+
+void ValueRangeSimplifier::operator()(Break&)
+{
+	yulAssert(!m_loops.empty(), "");
+	m_loops.back().breaks = join(move(m_loops.back().breaks), m_knowledge);
+	m_knowledge.reachable = false;
+}
+
+void ValueRangeSimplifier::operator()(Continue&)
+{
+	yulAssert(!m_loops.empty(), "");
+	m_loops.back().continues = join(move(m_loops.back().continues), m_knowledge);
+	m_knowledge.reachable = false;
+}
+
+void ValueRangeSimplifier::operator()(Leave&)
+{
+	m_knowledge.reachable = false;
+}
+
+void ValueRangeSimplifier::visit(Expression& _expression)
+{
+	ASTModifier::visit(_expression);
+
+	// Typed dialects need boolean literals, no need to support them.
+	if (!m_knowledge.reachable || !m_dialect.boolType.empty())
+		return;
+	auto const* call = get_if<FunctionCall>(&_expression);
+	auto const* dialect = dynamic_cast<EVMDialect const*>(&m_dialect);
+	if (!call || !dialect)
+		return;
+	BuiltinFunctionForEVM const* builtin = dialect->builtin(call->functionName.name);
+	if (!builtin || !builtin->instruction || !isComparison(*builtin->instruction))
+		return;
+
+	Range range = rangeOf(*call);
+	if (range.lower == range.upper && SideEffectsCollector{m_dialect, _expression}.movable())
+		_expression = Literal{call->location, LiteralKind::Number, YulString{formatNumber(range.lower)}, {}};
+}
+
+ValueRangeSimplifier::Knowledge ValueRangeSimplifier::join(Knowledge _a, Knowledge const& _b)
+{
+	if (!_b.reachable)
+		return _a;
+	if (!_a.reachable)
+		return _b;
+
+	Knowledge result;
+	for (auto const& [name, range]: _a.ranges)
+		if (auto it = _b.ranges.find(name); it != _b.ranges.end())
+			result.ranges[name] = Range{
+				std::min(range.lower, it->second.lower),
+				std::max(range.upper, it->second.upper)
+			};
+	return result;
+}
+
+ValueRangeSimplifier::Range ValueRangeSimplifier::rangeOf(Expression const& _expression) const
+{
+	return std::visit(GenericVisitor{
+		[&](Literal const& _literal)
+		{
+			u256 value = valueOfLiteral(_literal);
+			return Range{value, value};
+		},
+		[&](Identifier const& _identifier)
+		{
+			if (auto it = m_knowledge.ranges.find(_identifier.name); it != m_knowledge.ranges.end())
+				return it->second;
+			return Range{};
+		},
+		[&](FunctionCall const& _call)
+		{
+			return rangeOf(_call);
+		}
+	}, _expression);
+}
+
+ValueRangeSimplifier::Range ValueRangeSimplifier::rangeOf(FunctionCall const& _call) const
+{
+	auto const* dialect = dynamic_cast<EVMDialect const*>(&m_dialect);
+	if (!dialect || !m_dialect.boolType.empty())
+		return Range{};
+	BuiltinFunctionForEVM const* builtin = dialect->builtin(_call.functionName.name);
+	if (!builtin || !builtin->instruction)
+		return Range{};
+
+	vector<Range> arguments = applyMap(_call.arguments, [&](Expression const& _argument) { return rangeOf(_argument); });
+	u256 const maxValue = ~u256(0);
+	u256 const maxSigned = (u256(1) << 255) - 1;
+	auto lessThan = [](Range const& _a, Range const& _b) {
+		if (_a.upper < _b.lower)
+			return Range{1, 1};
+		else if (_a.lower >= _b.upper)
+			return Range{0, 0};
+		else
+			return Range{0, 1};
+	};
+
+	switch (*builtin->instruction)
+	{
+	case Instruction::ADD:
+		if (bigint(arguments[0].upper) + arguments[1].upper <= maxValue)
+			return Range{arguments[0].lower + arguments[1].lower, arguments[0].upper + arguments[1].upper};
+		break;
+	case Instruction::SUB:
+		if (arguments[0].lower >= arguments[1].upper)
+			return Range{arguments[0].lower - arguments[1].upper, arguments[0].upper - arguments[1].lower};
+		break;
+	case Instruction::MUL:
+		if (bigint(arguments[0].upper) * arguments[1].upper <= maxValue)
+			return Range{arguments[0].lower * arguments[1].lower, arguments[0].upper * arguments[1].upper};
+		break;
+	case Instruction::DIV:
+		// Division by zero results in zero.
+		if (arguments[1].lower > 0)
+			return Range{arguments[0].lower / arguments[1].upper, arguments[0].upper / arguments[1].lower};
+		return Range{0, arguments[0].upper};
+	case Instruction::MOD:
+		if (arguments[0].upper < arguments[1].lower)
+			return arguments[0];
+		return Range{0, arguments[1].upper == 0 ? 0 : std::min(arguments[0].upper, u256(arguments[1].upper - 1))};
+	case Instruction::AND:
+		return Range{0, std::min(arguments[0].upper, arguments[1].upper)};
+	case Instruction::OR:
+		return Range{
+			std::max(arguments[0].lower, arguments[1].lower),
+			allBitsUpTo(std::max(arguments[0].upper, arguments[1].upper))
+		};
+	case Instruction::XOR:
+		return Range{0, allBitsUpTo(std::max(arguments[0].upper, arguments[1].upper))};
+	case Instruction::NOT:
+		return Range{maxValue - arguments[0].upper, maxValue - arguments[0].lower};
+	case Instruction::SHR:
+		if (arguments[0].lower >= 256)
+			return Range{0, 0};
+		else if (arguments[0].lower == arguments[0].upper)
+		{
+			unsigned shift = static_cast<unsigned>(arguments[0].lower);
+			return Range{arguments[1].lower >> shift, arguments[1].upper >> shift};
+		}
+		return Range{0, arguments[1].upper >> static_cast<unsigned>(arguments[0].lower)};
+	case Instruction::SHL:
+		if (arguments[0].lower == arguments[0].upper && arguments[0].lower < 256)
+		{
+			unsigned shift = static_cast<unsigned>(arguments[0].lower);
+			if ((bigint(arguments[1].upper) << shift) <= maxValue)
+				return Range{arguments[1].lower << shift, arguments[1].upper << shift};
+		}
+		break;
+	case Instruction::BYTE:
+		return Range{0, 0xff};
+	case Instruction::ADDRESS:
+	case Instruction::CALLER:
+	case Instruction::ORIGIN:
+	case Instruction::COINBASE:
+		return Range{0, (u256(1) << 160) - 1};
+	case Instruction::LT:
+		return lessThan(arguments[0], arguments[1]);
+	case Instruction::GT:
+		return lessThan(arguments[1], arguments[0]);
+	case Instruction::SLT:
+		// Signed and unsigned comparison agree on non-negative values.
+		if (arguments[0].upper <= maxSigned && arguments[1].upper <= maxSigned)
+			return lessThan(arguments[0], arguments[1]);
+		return Range{0, 1};
+	case Instruction::SGT:
+		if (arguments[0].upper <= maxSigned && arguments[1].upper <= maxSigned)
+			return lessThan(arguments[1], arguments[0]);
+		return Range{0, 1};
+	case Instruction::EQ:
+		if (
+			arguments[0].lower == arguments[0].upper &&
+			arguments[1].lower == arguments[1].upper &&
+			arguments[0].lower == arguments[1].lower
+		)
+			return Range{1, 1};
+		else if (arguments[0].upper < arguments[1].lower || arguments[1].upper < arguments[0].lower)
+			return Range{0, 0};
+		return Range{0, 1};
+	case Instruction::ISZERO:
+		if (arguments[0].lower > 0)
+			return Range{0, 0};
+		else if (arguments[0].upper == 0)
+			return Range{1, 1};
+		return Range{0, 1};
+	default:
+		break;
+	}
+	return Range{};
+}
+
+void ValueRangeSimplifier::constrain(Expression const& _condition, bool _value)
+{
+	if (holds_alternative<Identifier>(_condition))
+	{
+		restrict(_condition, _value ? Range{1, ~u256(0)} : Range{0, 0});
+		return;
+	}
+
+	auto const* call = get_if<FunctionCall>(&_condition);
+	auto const* dialect = dynamic_cast<EVMDialect const*>(&m_dialect);
+	if (!call || !dialect)
+		return;
+	BuiltinFunctionForEVM const* builtin = dialect->builtin(call->functionName.name);
+	if (!builtin || !builtin->instruction)
+		return;
+
+	switch (*builtin->instruction)
+	{
+	case Instruction::ISZERO:
+		constrain(call->arguments[0], !_value);
+		break;
+	case Instruction::LT:
+		constrainLessThan(call->arguments[0], call->arguments[1], _value);
+		break;
+	case Instruction::GT:
+		constrainLessThan(call->arguments[1], call->arguments[0], _value);
+		break;
+	case Instruction::EQ:
+		if (_value)
+		{
+			Range first = rangeOf(call->arguments[0]);
+			restrict(call->arguments[0], rangeOf(call->arguments[1]));
+			restrict(call->arguments[1], first);
+		}
+		break;
+	default:
+		break;
+	}
+}
+
+void ValueRangeSimplifier::constrainLessThan(Expression const& _a, Expression const& _b, bool _value)
+{
+	Range a = rangeOf(_a);
+	Range b = rangeOf(_b);
+	if (_value)
+	{
+		if (b.upper == 0 || a.lower == ~u256(0))
+		{
+			m_knowledge.reachable = false;
+			return;
+		}
+		restrict(_a, Range{0, b.upper - 1});
+		restrict(_b, Range{a.lower + 1, ~u256(0)});
+	}
+	else
+	{
+		restrict(_a, Range{b.lower, ~u256(0)});
+		restrict(_b, Range{0, a.upper});
+	}
+}
+
+void ValueRangeSimplifier::restrict(Expression const& _expression, Range const& _range)
+{
+	auto const* identifier = get_if<Identifier>(&_expression);
+	if (!identifier || !m_knowledge.reachable)
+		return;
+
+	Range current = rangeOf(_expression);
+	Range restricted{std::max(current.lower, _range.lower), std::min(current.upper, _range.upper)};
+	if (restricted.lower > restricted.upper)
+		m_knowledge.reachable = false;
+	else
+		m_knowledge.ranges[identifier->name] = restricted;
+}
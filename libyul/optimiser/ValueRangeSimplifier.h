@@ -0,0 +1,131 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Optimiser component that removes comparisons that are decided by the ranges of values.
+ */
+
+#pragma once
+
+#include <libyul/optimiser/ASTWalker.h>
+#include <libyul/optimiser/OptimiserStep.h>
+#include <libyul/YulString.h>
+
+#include <libsolutil/Common.h>
+
+#include <map>
+#include <set>
+#include <vector>
+
+namespace solidity::yul
+{
+
+struct Dialect;
+
+/**
+ * Value range simplifier.
+ * Tracks an interval that contains the value of each variable along the control flow and
+ * replaces comparisons whose result is the same for all values in the intervals of their
+ * arguments by ``0`` or ``1``, if the comparison is movable.
+ *
+ * The intervals are derived from the values assigned to the variables, e.g. ``and(x, 0xff)`` is at
+ * most ``0xff``, and from conditions: inside ``if lt(x, y) { ... }``, in the body and the post
+ * block of a loop with such a condition and after ``if iszero(lt(x, y)) { revert(0, 0) }``,
+ * ``x`` is less than the largest value ``y`` can have. This removes the overflow checks of
+ * loop counters and of arithmetic on small values, e.g.
+ *
+ *   for { let i := 0 } lt(i, n) { if eq(i, not(0)) { panic() } i := add(i, 1) } { ... }
+ *
+ * is turned into
+ *
+ *   for { let i := 0 } lt(i, n) { if 0 { panic() } i := add(i, 1) } { ... }
+ *
+ * Functions that do not contain ``leave`` and unconditionally call a terminating builtin or
+ * another such function are assumed to never return.
+ *
+ * It is only effective on the untyped EVM dialect, but safe to use on other dialects.
+ *
+ * Prerequisite: Disambiguator, ForLoopInitRewriter.
+ */
+class ValueRangeSimplifier: public ASTModifier
+{
+public:
+	static constexpr char const* name{"ValueRangeSimplifier"};
+	static void run(OptimiserStepContext& _context, Block& _ast);
+
+	using ASTModifier::operator();
+	void operator()(ExpressionStatement& _statement) override;
+	void operator()(Assignment& _assignment) override;
+	void operator()(VariableDeclaration& _varDecl) override;
+	void operator()(If& _if) override;
+	void operator()(Switch& _switch) override;
+	void operator()(FunctionDefinition& _function) override;
+	void operator()(ForLoop& _for) override;
+	void operator()(Break&) override;
+	void operator()(Continue&) override;
+	void operator()(Leave&) override;
+
+	void visit(Expression& _expression) override;
+
+private:
+	/// Interval of unsigned values.
+	struct Range
+	{
+		u256 lower;
+		u256 upper = ~u256(0);
+	};
+	/// Intervals of the variables at some point of the control flow. Variables without
+	/// an entry can have any value.
+	struct Knowledge
+	{
+		bool reachable = true;
+		std::map<YulString, Range> ranges;
+	};
+	/// Knowledge at the ``break`` and ``continue`` statements of a loop.
+	struct LoopExits
+	{
+		Knowledge breaks{false, {}};
+		Knowledge continues{false, {}};
+	};
+
+	ValueRangeSimplifier(Dialect const& _dialect, std::set<YulString> _nonReturningFunctions):
+		m_dialect(_dialect),
+		m_nonReturningFunctions(std::move(_nonReturningFunctions))
+	{}
+
+	/// @returns knowledge that holds if @a _a or @a _b holds.
+	static Knowledge join(Knowledge _a, Knowledge const& _b);
+
+	Range rangeOf(Expression const& _expression) const;
+	Range rangeOf(FunctionCall const& _call) const;
+
+	/// Restricts the knowledge to the case that @a _condition is non-zero if @a _value is true
+	/// and zero otherwise.
+	void constrain(Expression const& _condition, bool _value);
+	/// Restricts the knowledge to the case that ``lt(_a, _b)`` is @a _value.
+	void constrainLessThan(Expression const& _a, Expression const& _b, bool _value);
+	/// Restricts the knowledge to the case that @a _expression is in @a _range, but only
+	/// if @a _expression is a variable.
+	void restrict(Expression const& _expression, Range const& _range);
+
+	Dialect const& m_dialect;
+	std::set<YulString> const m_nonReturningFunctions;
+	Knowledge m_knowledge;
+	std::vector<LoopExits> m_loops;
+};
+
+}
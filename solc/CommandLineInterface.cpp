@@ -22,18 +22,24 @@
  * Solidity command line interface.
  */
 #include <solc/CommandLineInterface.h>
+#include <solc/FileWatcher.h>
 
 #include "solidity/BuildInfo.h"
 #include "license.h"
 
 #include <libsolidity/interface/Version.h>
 #include <libsolidity/parsing/Parser.h>
+#include <libsolidity/ast/ASTBinary.h>
 #include <libsolidity/ast/ASTJsonConverter.h>
 #include <libsolidity/ast/ASTJsonImporter.h>
+#include <libsolidity/ast/TypeProvider.h>
 #include <libsolidity/analysis/NameAndTypeResolver.h>
+#include <libsolidity/interface/ArtifactBinary.h>
+#include <libsolidity/interface/CompilationCache.h>
 #include <libsolidity/interface/CompilerStack.h>
 #include <libsolidity/interface/StandardCompiler.h>
 #include <libsolidity/interface/GasEstimator.h>
+#include <libsolidity/interface/LanguageServer.h>
 #include <libsolidity/interface/DebugSettings.h>
 #include <libsolidity/interface/StorageLayout.h>
 
@@ -53,9 +59,17 @@
 #include <libsolutil/CommonData.h>
 #include <libsolutil/CommonIO.h>
 #include <libsolutil/JSON.h>
+#include <libsolutil/MemoryAccounting.h>
+#include <libsolutil/ThreadPool.h>
+#include <libsolutil/Tracer.h>
 
 #include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iomanip>
 #include <memory>
+#include <mutex>
+#include <sstream>
 
 #include <boost/filesystem.hpp>
 #include <boost/filesystem/operations.hpp>
@@ -74,6 +88,7 @@
 #include <string>
 #include <iostream>
 #include <fstream>
+#include <sstream>
 
 #if !defined(STDERR_FILENO)
 	#define STDERR_FILENO 2
@@ -89,15 +104,19 @@ namespace po = boost::program_options;
 namespace solidity::frontend
 {
 
-bool g_hasOutput = false;
+atomic<bool> g_hasOutput{false};
 
 namespace
 {
 
+/// Buffer the output of the contract rendered by the current thread is collected in, if any.
+/// The buffers are printed in the order of the contracts once all of them are rendered.
+thread_local ostream* t_contractOutput = nullptr;
+
 std::ostream& sout()
 {
 	g_hasOutput = true;
-	return cout;
+	return t_contractOutput ? *t_contractOutput : cout;
 }
 
 std::ostream& serr(bool _used = true)
@@ -122,8 +141,11 @@ static string const g_strAssemble = "assemble";
 static string const g_strAst = "ast";
 static string const g_strAstJson = "ast-json";
 static string const g_strAstCompactJson = "ast-compact-json";
+static string const g_strAstBinary = "ast-binary";
 static string const g_strBinary = "bin";
 static string const g_strBinaryRuntime = "bin-runtime";
+static string const g_strCacheDir = "cache-dir";
+static string const g_strCombinedBinary = "combined-binary";
 static string const g_strCombinedJson = "combined-json";
 static string const g_strCompactJSON = "compact-format";
 static string const g_strContracts = "contracts";
@@ -140,6 +162,7 @@ static string const g_strHelp = "help";
 static string const g_strImportAst = "import-ast";
 static string const g_strInputFile = "input-file";
 static string const g_strInterface = "interface";
+static string const g_strJobs = "jobs";
 static string const g_strYul = "yul";
 static string const g_strYulDialect = "yul-dialect";
 static string const g_strIR = "ir";
@@ -149,12 +172,19 @@ static string const g_strLicense = "license";
 static string const g_strLibraries = "libraries";
 static string const g_strLink = "link";
 static string const g_strMachine = "machine";
+static string const g_strMemoryReport = "memory-report";
 static string const g_strMetadata = "metadata";
 static string const g_strMetadataHash = "metadata-hash";
 static string const g_strMetadataLiteral = "metadata-literal";
+static string const g_strModelCheckerCache = "model-checker-cache";
 static string const g_strModelCheckerEngine = "model-checker-engine";
+static string const g_strModelCheckerIncremental = "model-checker-incremental";
+static string const g_strModelCheckerNoCounterexamples = "model-checker-no-counterexamples";
+static string const g_strModelCheckerPrintStats = "model-checker-print-stats";
 static string const g_strModelCheckerTargets = "model-checker-targets";
+static string const g_strModelCheckerTimeBudget = "model-checker-time-budget";
 static string const g_strModelCheckerTimeout = "model-checker-timeout";
+static string const g_strModelCheckerRaceSolvers = "model-checker-race-solvers";
 static string const g_strNatspecDev = "devdoc";
 static string const g_strNatspecUser = "userdoc";
 static string const g_strNone = "none";
@@ -164,11 +194,16 @@ static string const g_strOptimize = "optimize";
 static string const g_strOptimizeRuns = "optimize-runs";
 static string const g_strOptimizeYul = "optimize-yul";
 static string const g_strYulOptimizations = "yul-optimizations";
+static string const g_strYulOptimizerBudget = "yul-optimizer-budget-ms";
+static string const g_strYulStackLayout = "yul-stack-layout";
+static string const g_strYulReuseAcrossObjects = "yul-reuse-across-objects";
 static string const g_strOutputDir = "output-dir";
 static string const g_strOverwrite = "overwrite";
 static string const g_strRevertStrings = "revert-strings";
 static string const g_strStorageLayout = "storage-layout";
 static string const g_strStopAfter = "stop-after";
+static string const g_strTimePasses = "time-passes";
+static string const g_strTraceFile = "trace-file";
 static string const g_strParsing = "parsing";
 
 /// Possible arguments to for --revert-strings
@@ -180,6 +215,8 @@ static set<string> const g_revertStringsArgs
 	revertStringsToString(RevertStrings::VerboseDebug)
 };
 
+static string const g_strLSP = "lsp";
+static string const g_strServer = "server";
 static string const g_strSignatureHashes = "hashes";
 static string const g_strSources = "sources";
 static string const g_strSourceList = "sourceList";
@@ -190,6 +227,7 @@ static string const g_strStrictAssembly = "strict-assembly";
 static string const g_strSwarm = "swarm";
 static string const g_strPrettyJson = "pretty-json";
 static string const g_strVersion = "version";
+static string const g_strWatch = "watch";
 static string const g_strIgnoreMissingFiles = "ignore-missing";
 static string const g_strColor = "color";
 static string const g_strNoColor = "no-color";
@@ -204,8 +242,11 @@ static string const g_argAsmJson = g_strAsmJson;
 static string const g_argAssemble = g_strAssemble;
 static string const g_argAstCompactJson = g_strAstCompactJson;
 static string const g_argAstJson = g_strAstJson;
+static string const g_argAstBinary = g_strAstBinary;
 static string const g_argBinary = g_strBinary;
 static string const g_argBinaryRuntime = g_strBinaryRuntime;
+static string const g_argCacheDir = g_strCacheDir;
+static string const g_argCombinedBinary = g_strCombinedBinary;
 static string const g_argCombinedJson = g_strCombinedJson;
 static string const g_argCompactJSON = g_strCompactJSON;
 static string const g_argErrorRecovery = g_strErrorRecovery;
@@ -213,6 +254,7 @@ static string const g_argGas = g_strGas;
 static string const g_argHelp = g_strHelp;
 static string const g_argImportAst = g_strImportAst;
 static string const g_argInputFile = g_strInputFile;
+static string const g_argJobs = g_strJobs;
 static string const g_argYul = g_strYul;
 static string const g_argIR = g_strIR;
 static string const g_argIROptimized = g_strIROptimized;
@@ -221,23 +263,35 @@ static string const g_argExperimentalViaIR = g_strExperimentalViaIR;
 static string const g_argLibraries = g_strLibraries;
 static string const g_argLink = g_strLink;
 static string const g_argMachine = g_strMachine;
+static string const g_argMemoryReport = g_strMemoryReport;
 static string const g_argMetadata = g_strMetadata;
 static string const g_argMetadataHash = g_strMetadataHash;
 static string const g_argMetadataLiteral = g_strMetadataLiteral;
+static string const g_argModelCheckerCache = g_strModelCheckerCache;
 static string const g_argModelCheckerEngine = g_strModelCheckerEngine;
+static string const g_argModelCheckerIncremental = g_strModelCheckerIncremental;
+static string const g_argModelCheckerNoCounterexamples = g_strModelCheckerNoCounterexamples;
+static string const g_argModelCheckerPrintStats = g_strModelCheckerPrintStats;
 static string const g_argModelCheckerTargets = g_strModelCheckerTargets;
+static string const g_argModelCheckerTimeBudget = g_strModelCheckerTimeBudget;
 static string const g_argModelCheckerTimeout = g_strModelCheckerTimeout;
+static string const g_argModelCheckerRaceSolvers = g_strModelCheckerRaceSolvers;
 static string const g_argNatspecDev = g_strNatspecDev;
 static string const g_argNatspecUser = g_strNatspecUser;
 static string const g_argOpcodes = g_strOpcodes;
 static string const g_argOptimize = g_strOptimize;
 static string const g_argOptimizeRuns = g_strOptimizeRuns;
 static string const g_argOutputDir = g_strOutputDir;
+static string const g_argLSP = g_strLSP;
+static string const g_argServer = g_strServer;
 static string const g_argSignatureHashes = g_strSignatureHashes;
 static string const g_argStandardJSON = g_strStandardJSON;
 static string const g_argStorageLayout = g_strStorageLayout;
 static string const g_argStrictAssembly = g_strStrictAssembly;
+static string const g_argTimePasses = g_strTimePasses;
+static string const g_argTraceFile = g_strTraceFile;
 static string const g_argVersion = g_strVersion;
+static string const g_argWatch = g_strWatch;
 static string const g_stdinFileName = g_stdinFileNameStr;
 static string const g_argIgnoreMissingFiles = g_strIgnoreMissingFiles;
 static string const g_argColor = g_strColor;
@@ -347,6 +401,31 @@ bool checkMutuallyExclusive(boost::program_options::variables_map const& args, s
 	return true;
 }
 
+/// Reads a message from @a _input that is preceded by a line containing its length in bytes.
+/// @returns nullopt at the end of the input or if the input is malformed, in which case
+/// @a _error is set.
+optional<string> readLengthPrefixedMessage(istream& _input, string& _error)
+{
+	string lengthLine;
+	if (!getline(_input, lengthLine))
+		return nullopt;
+	boost::trim(lengthLine);
+	// Limit the length to what fits into size_t on all platforms.
+	if (lengthLine.empty() || lengthLine.size() > 9 || !boost::all(lengthLine, boost::is_digit()))
+	{
+		_error = "Invalid message length: \"" + lengthLine + "\"";
+		return nullopt;
+	}
+
+	string message(stoul(lengthLine), '\0');
+	if (!_input.read(message.data(), static_cast<streamsize>(message.size())))
+	{
+		_error = "Unexpected end of input inside a message.";
+		return nullopt;
+	}
+	return message;
+}
+
 }
 
 void CommandLineInterface::handleBinary(string const& _contract)
@@ -358,7 +437,8 @@ void CommandLineInterface::handleBinary(string const& _contract)
 		else
 		{
 			sout() << "Binary:" << endl;
-			sout() << objectWithLinkRefsHex(m_compiler->object(_contract)) << endl;
+			printObjectWithLinkRefsHex(sout(), m_compiler->object(_contract));
+			sout() << endl;
 		}
 	}
 	if (m_args.count(g_argBinaryRuntime))
@@ -368,19 +448,23 @@ void CommandLineInterface::handleBinary(string const& _contract)
 		else
 		{
 			sout() << "Binary of the runtime part:" << endl;
-			sout() << objectWithLinkRefsHex(m_compiler->runtimeObject(_contract)) << endl;
+			printObjectWithLinkRefsHex(sout(), m_compiler->runtimeObject(_contract));
+			sout() << endl;
 		}
 	}
 }
 
 void CommandLineInterface::handleOpcode(string const& _contract)
 {
+	bytes const& bytecode = m_compiler->object(_contract).bytecode;
 	if (m_args.count(g_argOutputDir))
-		createFile(m_compiler->filesystemFriendlyName(_contract) + ".opcode", evmasm::disassemble(m_compiler->object(_contract).bytecode));
+		createFile(m_compiler->filesystemFriendlyName(_contract) + ".opcode", [&](ostream& _out) {
+			evmasm::disassemble(bytecode, _out);
+		});
 	else
 	{
 		sout() << "Opcodes:" << endl;
-		sout() << std::uppercase << evmasm::disassemble(m_compiler->object(_contract).bytecode);
+		evmasm::disassemble(bytecode, sout());
 		sout() << endl;
 	}
 }
@@ -536,12 +620,12 @@ void CommandLineInterface::handleNatspec(bool _natspecDev, string const& _contra
 
 void CommandLineInterface::handleGasEstimation(string const& _contract)
 {
-	Json::Value estimates = m_compiler->gasEstimates(_contract);
+	Json::Value const& estimates = m_compiler->gasEstimates(_contract);
 	sout() << "Gas estimation:" << endl;
 
 	if (estimates["creation"].isObject())
 	{
-		Json::Value creation = estimates["creation"];
+		Json::Value const& creation = estimates["creation"];
 		sout() << "construction:" << endl;
 		sout() << "   " << creation["executionCost"].asString();
 		sout() << " + " << creation["codeDepositCost"].asString();
@@ -550,7 +634,7 @@ void CommandLineInterface::handleGasEstimation(string const& _contract)
 
 	if (estimates["external"].isObject())
 	{
-		Json::Value externalFunctions = estimates["external"];
+		Json::Value const& externalFunctions = estimates["external"];
 		sout() << "external:" << endl;
 		for (auto const& name: externalFunctions.getMemberNames())
 		{
@@ -564,7 +648,7 @@ void CommandLineInterface::handleGasEstimation(string const& _contract)
 
 	if (estimates["internal"].isObject())
 	{
-		Json::Value internalFunctions = estimates["internal"];
+		Json::Value const& internalFunctions = estimates["internal"];
 		sout() << "internal:" << endl;
 		for (auto const& name: internalFunctions.getMemberNames())
 		{
@@ -574,6 +658,148 @@ void CommandLineInterface::handleGasEstimation(string const& _contract)
 	}
 }
 
+namespace
+{
+
+void printCompilationStatistics(ostream& _out, util::CompilationStatistics const& _statistics)
+{
+	auto milliseconds = [](chrono::nanoseconds _time) {
+		return chrono::duration<double, milli>(_time).count();
+	};
+
+	_out << fixed << setprecision(3);
+	_out << left << setw(40) << "Phase" << right << setw(8) << "Runs" << setw(14) << "Time (ms)" << setw(20) << "Peak memory (MiB)" << endl;
+	for (auto const& [name, phase]: _statistics.phases())
+		_out <<
+			left << setw(40) << name << right <<
+			setw(8) << phase.runs <<
+			setw(14) << milliseconds(phase.time) <<
+			setw(20) << static_cast<double>(phase.peakMemory) / (1024 * 1024) <<
+			endl;
+
+	if (!_statistics.optimiserSteps().empty())
+	{
+		_out << endl;
+		_out << left << setw(40) << "Yul optimizer step" << right << setw(8) << "Runs" << setw(14) << "Time (ms)" << setw(20) << "Changes" << endl;
+		for (auto const& [name, step]: _statistics.optimiserSteps())
+			_out <<
+				left << setw(40) << name << right <<
+				setw(8) << step.runs <<
+				setw(14) << milliseconds(step.time) <<
+				setw(20) << step.changes <<
+				endl;
+	}
+
+	if (!_statistics.caches().empty())
+	{
+		_out << endl;
+		_out << left << setw(40) << "Cache" << right << setw(8) << "Hits" << setw(14) << "Misses" << endl;
+		for (auto const& [name, cache]: _statistics.caches())
+			_out <<
+				left << setw(40) << name << right <<
+				setw(8) << cache.hits <<
+				setw(14) << cache.misses <<
+				endl;
+	}
+
+	if (!_statistics.counters().empty())
+	{
+		_out << endl;
+		_out << left << setw(40) << "Counter" << right << setw(8) << "Count" << endl;
+		for (auto const& [name, count]: _statistics.counters())
+			_out << left << setw(40) << name << right << setw(8) << count << endl;
+	}
+	_out << defaultfloat << setprecision(6);
+}
+
+void printMemoryReport(ostream& _out)
+{
+	auto mebibytes = [](size_t _bytes) { return static_cast<double>(_bytes) / (1024 * 1024); };
+
+	_out << fixed << setprecision(3);
+	_out << left << setw(40) << "Subsystem" << right << setw(14) << "Allocations" << setw(14) << "Current (MiB)" << setw(14) << "Peak (MiB)" << endl;
+	for (size_t i = 0; i < util::MemoryAccounting::SubsystemCount; ++i)
+	{
+		auto const subsystem = static_cast<util::MemorySubsystem>(i);
+		util::MemoryAccounting::Usage const usage = util::MemoryAccounting::usage(subsystem);
+		_out <<
+			left << setw(40) << util::MemoryAccounting::name(subsystem) << right <<
+			setw(14) << usage.allocations <<
+			setw(14) << mebibytes(usage.bytes) <<
+			setw(14) << mebibytes(usage.peakBytes) <<
+			endl;
+	}
+
+	map<string, size_t> const measurements = util::MemoryAccounting::measurements();
+	if (!measurements.empty())
+	{
+		_out << endl;
+		_out << left << setw(40) << "Measurement" << right << setw(14) << "Peak (MiB)" << endl;
+		for (auto const& [name, bytes]: measurements)
+			_out << left << setw(40) << name << right << setw(14) << mebibytes(bytes) << endl;
+	}
+	_out << defaultfloat << setprecision(6);
+}
+
+}
+
+void CommandLineInterface::handleCompilationStatistics()
+{
+	serr() << endl << "======= Compilation statistics =======" << endl;
+	printCompilationStatistics(serr(), m_compiler->compilationStatistics());
+
+	if (m_compiler->state() < CompilerStack::State::AnalysisPerformed)
+		return;
+	for (string const& contract: m_compiler->contractNames())
+	{
+		util::CompilationStatistics const& statistics = m_compiler->compilationStatistics(contract);
+		if (statistics.empty())
+			continue;
+		serr() << endl << "======= " << contract << " (compilation statistics) =======" << endl;
+		printCompilationStatistics(serr(), statistics);
+	}
+
+	if (!m_compiler->modelCheckerStatistics().empty())
+		handleModelCheckerStatistics();
+}
+
+void CommandLineInterface::handleModelCheckerStatistics()
+{
+	auto milliseconds = [](chrono::nanoseconds _time) {
+		return chrono::duration<double, milli>(_time).count();
+	};
+
+	serr() << endl << "======= Model checker statistics =======" << endl;
+	serr() << fixed << setprecision(3);
+	serr() <<
+		left << setw(40) << "Target" << setw(8) << "Engine" << setw(14) << "Result" << setw(12) << "Solvers" <<
+		right << setw(16) << "Encoding (ms)" << setw(14) << "Solving (ms)" << setw(14) << "Query size" <<
+		endl;
+	for (ModelCheckerTargetStatistics const& target: m_compiler->modelCheckerStatistics())
+	{
+		string location;
+		if (target.location.sourceName)
+		{
+			location = *target.location.sourceName;
+			if (CharStream const* charStream = m_compiler->charStream(*target.location.sourceName))
+			{
+				auto [line, column] = charStream->translatePositionToLineColumn(target.location.start);
+				location += ":" + to_string(line + 1) + ":" + to_string(column + 1);
+			}
+		}
+		serr() <<
+			left << setw(40) << location + " " + targetTypeName(target.type) <<
+			setw(8) << target.engine <<
+			setw(14) << checkResultName(target.result) <<
+			setw(12) << target.solvers <<
+			right << setw(16) << milliseconds(target.encodingTime) <<
+			setw(14) << milliseconds(target.solvingTime) <<
+			setw(14) << target.querySize <<
+			endl;
+	}
+	serr() << defaultfloat << setprecision(6);
+}
+
 bool CommandLineInterface::readInputFilesAndConfigureRemappings()
 {
 	bool ignoreMissing = m_args.count(g_argIgnoreMissingFiles);
@@ -627,13 +853,13 @@ bool CommandLineInterface::readInputFilesAndConfigureRemappings()
 				}
 
 				// NOTE: we ignore the FileNotFound exception as we manually check above
-				m_sourceCodes[infile.generic_string()] = readFileAsString(infile.string());
+				m_sourceCodes[infile.generic_string()] = SourceBuffer::fromFile(infile.string());
 				path = boost::filesystem::canonical(infile).string();
 			}
 			m_allowedDirectories.push_back(boost::filesystem::path(path).remove_filename());
 		}
 	if (addStdin)
-		m_sourceCodes[g_stdinFileName] = readStandardInput();
+		m_sourceCodes[g_stdinFileName] = SourceBuffer(readStandardInput());
 	if (m_sourceCodes.size() == 0)
 	{
 		serr() << "No input files given. If you wish to use the standard input please specify \"-\" explicitly." << endl;
@@ -741,12 +967,25 @@ bool CommandLineInterface::parseLibraryOption(string const& _input)
 map<string, Json::Value> CommandLineInterface::parseAstFromInput()
 {
 	map<string, Json::Value> sourceJsons;
-	map<string, string> tmpSources;
+	map<string, SourceBuffer> tmpSources;
 
 	for (auto const& srcPair: m_sourceCodes)
 	{
+		if (ASTBinary::isBinary(srcPair.second.view()))
+		{
+			ASTBinary binary(srcPair.second.view());
+			for (string const& src: binary.sourceNames())
+			{
+				astAssert(sourceJsons.count(src) == 0, "All sources must have unique names");
+				Json::Value ast = binary.source(src);
+				tmpSources[src] = SourceBuffer(util::jsonCompactPrint(ast));
+				sourceJsons.emplace(src, move(ast));
+			}
+			continue;
+		}
+
 		Json::Value ast;
-		astAssert(jsonParseStrict(srcPair.second, ast), "Input file could not be parsed to JSON");
+		astAssert(jsonParseStrict(srcPair.second.str(), ast), "Input file could not be parsed to JSON");
 		astAssert(ast.isMember("sources"), "Invalid Format for import-JSON: Must have 'sources'-object");
 
 		for (auto& src: ast["sources"].getMemberNames())
@@ -757,7 +996,7 @@ map<string, Json::Value> CommandLineInterface::parseAstFromInput()
 			astAssert(ast["sources"][src][astKey]["nodeType"].asString() == "SourceUnit",  "Top-level node should be a 'SourceUnit'");
 			astAssert(sourceJsons.count(src) == 0, "All sources must have unique names");
 			sourceJsons.emplace(src, move(ast["sources"][src][astKey]));
-			tmpSources[src] = util::jsonCompactPrint(ast);
+			tmpSources[src] = SourceBuffer(util::jsonCompactPrint(ast));
 		}
 	}
 
@@ -766,27 +1005,39 @@ map<string, Json::Value> CommandLineInterface::parseAstFromInput()
 }
 
 void CommandLineInterface::createFile(string const& _fileName, string const& _data)
+{
+	createFile(_fileName, [&](ostream& _out) { _out << _data; });
+}
+
+void CommandLineInterface::createFile(string const& _fileName, function<void(ostream&)> const& _write)
 {
 	namespace fs = boost::filesystem;
 
 	fs::path outputDir(m_args.at(g_argOutputDir).as<string>());
-
-	// NOTE: create_directories() raises an exception if the path consists solely of '.' or '..'
-	// (or equivalent such as './././.'). Paths like 'a/b/.' and 'a/b/..' are fine though.
-	// The simplest workaround is to use an absolute path.
-	fs::create_directories(fs::absolute(outputDir));
-
 	string pathName = (outputDir / _fileName).string();
-	if (fs::exists(pathName) && !m_args.count(g_strOverwrite))
+
 	{
-		serr() << "Refusing to overwrite existing file \"" << pathName << "\" (use --" << g_strOverwrite << " to force)." << endl;
-		m_error = true;
-		return;
+		lock_guard<mutex> lock(m_outputMutex);
+		// NOTE: create_directories() raises an exception if the path consists solely of '.' or '..'
+		// (or equivalent such as './././.'). Paths like 'a/b/.' and 'a/b/..' are fine though.
+		// The simplest workaround is to use an absolute path.
+		fs::create_directories(fs::absolute(outputDir));
+
+		if (fs::exists(pathName) && !m_args.count(g_strOverwrite) && !m_writtenFiles.count(pathName))
+		{
+			serr() << "Refusing to overwrite existing file \"" << pathName << "\" (use --" << g_strOverwrite << " to force)." << endl;
+			m_error = true;
+			return;
+		}
+		m_writtenFiles.insert(pathName);
 	}
+
+	// Every file is written by a single thread, so the files can be written concurrently.
 	ofstream outFile(pathName);
-	outFile << _data;
+	_write(outFile);
 	if (!outFile)
 	{
+		lock_guard<mutex> lock(m_outputMutex);
 		serr() << "Could not write to file \"" << pathName << "\"." << endl;
 		m_error = true;
 		return;
@@ -872,6 +1123,29 @@ General Information)").c_str(),
 			g_strExperimentalViaIR.c_str(),
 			"Turn on experimental compilation mode via the IR (EXPERIMENTAL)."
 		)
+		(
+			g_argJobs.c_str(),
+			po::value<unsigned>()->value_name("n")->default_value(1),
+			("Number of threads used to parse sources and to generate code for different contracts concurrently. "
+			"Code generation is only done concurrently for code generated from the IR (--" + g_strExperimentalViaIR + " and --" + g_argEwasm + "), "
+			"where the Yul optimizer also applies function-local steps to groups of functions concurrently. "
+			"0 means one thread per hardware thread. All concurrent work, including work nested in other "
+			"concurrent work, shares these threads. The output does not depend on this setting.").c_str()
+		)
+		(
+			g_argCacheDir.c_str(),
+			po::value<string>()->value_name("path"),
+			"Directory to cache the bytecode, source mappings and IR of the compiled contracts in. "
+			"Contracts whose sources, settings and compiler version did not change are not compiled again. "
+			"Cannot be used together with outputs that need the EVM assembly."
+		)
+		(
+			g_argWatch.c_str(),
+			("Compile again and print the requested outputs again whenever one of the input files "
+			"or one of the files they import changes. Runs until interrupted. Sources whose content "
+			"did not change are not parsed again. Together with --" + g_argCacheDir + ", contracts whose "
+			"sources did not change are not compiled again either.").c_str()
+		)
 		(
 			g_strRevertStrings.c_str(),
 			po::value<string>()->value_name(boost::join(g_revertStringsArgs, ",")),
@@ -892,6 +1166,21 @@ General Information)").c_str(),
 			"Switch to Standard JSON input / output mode, ignoring all options. "
 			"It reads from standard input, if no input file was given, otherwise it reads from the provided input file. The result will be written to standard output."
 		)
+		(
+			g_argServer.c_str(),
+			("Switch to server mode, ignoring all options. Like --" + g_argStandardJSON + ", but reads any number of "
+			"requests from standard input and writes each response to standard output. Every request and "
+			"every response is preceded by a line containing its length in bytes. The server stops at the end "
+			"of the input. Parsed sources are kept between requests and reused if their content did not change.").c_str()
+		)
+		(
+			g_argLSP.c_str(),
+			("Switch to language server mode, ignoring all options except --" + g_argBasePath + " and "
+			"--" + g_argAllowPaths + ". Speaks the language server protocol over standard input and output, "
+			"reporting the errors and warnings of the documents open in the editor while they are edited "
+			"and answering requests for the definition of a name. Files imported by the documents are "
+			"read from the file system.").c_str()
+		)
 		(
 			g_argLink.c_str(),
 			("Switch to linker mode, ignoring all options apart from --" + g_argLibraries + " "
@@ -919,7 +1208,7 @@ General Information)").c_str(),
 			g_argImportAst.c_str(),
 			("Import ASTs to be compiled, assumes input holds the AST in compact JSON format. "
 			"Supported Inputs is the output of the --" + g_argStandardJSON + " or the one produced by "
-			"--" + g_argCombinedJson + " " + g_strAst + "," + g_strCompactJSON).c_str()
+			"--" + g_argCombinedJson + " " + g_strAst + "," + g_strCompactJSON + " or --" + g_argAstBinary).c_str()
 		)
 	;
 	desc.add(alternativeInputModes);
@@ -976,6 +1265,11 @@ General Information)").c_str(),
 	outputComponents.add_options()
 		(g_argAstJson.c_str(), "AST of all source files in JSON format.")
 		(g_argAstCompactJson.c_str(), "AST of all source files in a compact JSON format.")
+		(
+			g_argAstBinary.c_str(),
+			("ASTs of all source files in a compact binary format that can be read by --" + g_argImportAst + ". "
+			"Written to combined_ast.bin in the directory given by --" + g_argOutputDir + ".").c_str()
+		)
 		(g_argAsm.c_str(), "EVM assembly of the contracts.")
 		(g_argAsmJson.c_str(), "EVM assembly of the contracts in JSON format.")
 		(g_argOpcodes.c_str(), "Opcodes of the contracts.")
@@ -999,11 +1293,36 @@ General Information)").c_str(),
 			g_argGas.c_str(),
 			"Print an estimate of the maximal gas usage for each function."
 		)
+		(
+			g_argTimePasses.c_str(),
+			"Print the wall time and the peak memory usage of the compilation phases and the time "
+			"and number of changes of the Yul optimizer steps to stderr, in total and per contract."
+		)
+		(
+			g_argMemoryReport.c_str(),
+			"Print the number of allocations and the current and peak memory held by the subsystems "
+			"of the compiler (AST, annotations, types, Yul strings, Yul AST, EVM assembly, SMT "
+			"encoding and JSON output) and the largest Yul AST after each optimizer step to stderr. "
+			"The numbers are estimates of the memory the subsystems allocated themselves."
+		)
+		(
+			g_argTraceFile.c_str(),
+			po::value<string>()->value_name("path"),
+			"Write the spans of the compilation phases, of each optimizer step, of the model checker "
+			"queries and of the calls to the read callback on all threads to the given file as "
+			"Chrome trace events, which can be viewed in Perfetto or chrome://tracing."
+		)
 		(
 			g_argCombinedJson.c_str(),
 			po::value<string>()->value_name(boost::join(g_combinedJsonArgs, ",")),
 			"Output a single json document containing the specified information."
 		)
+		(
+			g_argCombinedBinary.c_str(),
+			("Output the bytecode, deployed bytecode, source maps, link references and immutable references "
+			"of all contracts in a compact binary format with raw bytecode and fixed-size source map entries. "
+			"Written to combined.bin in the directory given by --" + g_argOutputDir + ".").c_str()
+		)
 	;
 	desc.add(extraOutput);
 
@@ -1046,6 +1365,24 @@ General Information)").c_str(),
 			po::value<string>()->value_name("steps"),
 			"Forces yul optimizer to use the specified sequence of optimization steps instead of the built-in one."
 		)
+		(
+			g_strYulOptimizerBudget.c_str(),
+			po::value<unsigned>()->value_name("ms"),
+			"Stop running the sequence of Yul optimization steps after the given number of milliseconds "
+			"and only run the final steps that are required for code generation. "
+			"The output then depends on the speed of the machine and is not reproducible from the metadata, "
+			"so this is only meant for development builds."
+		)
+		(
+			g_strYulStackLayout.c_str(),
+			"Re-generate the stack operations of each basic block of the EVM code generated from Yul "
+			"from the data flow of the block."
+		)
+		(
+			g_strYulReuseAcrossObjects.c_str(),
+			"Reuse the results of function-local Yul optimizer steps on the functions of sub-objects "
+			"for functions of the containing object that only differ in the names of their variables."
+		)
 	;
 	desc.add(optimizerOptions);
 
@@ -1070,6 +1407,40 @@ General Information)").c_str(),
 			"The default is a deterministic resource limit. "
 			"A timeout of 0 means no resource/time restrictions for any query."
 		)
+		(
+			g_strModelCheckerTimeBudget.c_str(),
+			po::value<unsigned>()->value_name("ms"),
+			"Check the verification targets of the CHC engine within the given total time in milliseconds. "
+			"Every target is first checked with a short timeout, and the targets that timed out "
+			"are retried with doubled timeouts as long as there is time left. "
+			"Not combined with --model-checker-race-solvers."
+		)
+		(
+			g_strModelCheckerRaceSolvers.c_str(),
+			"Query the SMT solvers concurrently and use the first answer instead of "
+			"waiting for all solvers and checking that they agree. "
+			"The CHC engine checks the verification targets on as many threads as given by --jobs."
+		)
+		(
+			g_strModelCheckerCache.c_str(),
+			po::value<string>()->value_name("path"),
+			"Store the answers of the SMT solvers in the given directory and reuse them "
+			"in later runs that ask the same queries."
+		)
+		(
+			g_strModelCheckerIncremental.c_str(),
+			"Do not check the verification targets again that were proven by earlier runs, "
+			"unless the code they depend on changed. Requires --model-checker-cache."
+		)
+		(
+			g_strModelCheckerNoCounterexamples.c_str(),
+			"Report violated verification targets without computing a counterexample."
+		)
+		(
+			g_strModelCheckerPrintStats.c_str(),
+			"Print the encoding and solving time, the solvers, the result and the query size "
+			"of every checked verification target to stderr. Also part of --time-passes."
+		)
 	;
 	desc.add(smtCheckerOptions);
 
@@ -1112,6 +1483,29 @@ General Information)").c_str(),
 		if (!checkMutuallyExclusive(m_args, g_strStopAfter, option))
 			return false;
 
+	// Contracts loaded from the cache have no EVM assembly.
+	static vector<string> const conflictingWithCacheDir{
+		g_argGas,
+		g_argAsm,
+		g_argAsmJson,
+		g_argEwasm
+	};
+
+	for (auto& option: conflictingWithCacheDir)
+		if (!checkMutuallyExclusive(m_args, g_argCacheDir, option))
+			return false;
+
+	// The trace is written when the compiler is done, which never happens in watch mode.
+	if (!checkMutuallyExclusive(m_args, g_argTraceFile, g_argWatch))
+		return false;
+
+	for (string const& option: {g_argAstBinary, g_argCombinedBinary})
+		if (m_args.count(option) && !m_args.count(g_argOutputDir))
+		{
+			serr() << "Option --" << option << " requires --" << g_argOutputDir << "." << endl;
+			return false;
+		}
+
 	m_coloredOutput = !m_args.count(g_argNoColor) && (isatty(STDERR_FILENO) || m_args.count(g_argColor));
 
 	m_withErrorIds = m_args.count(g_argErrorIds);
@@ -1160,6 +1554,14 @@ General Information)").c_str(),
 				serr() << "Invalid option to --" << g_argCombinedJson << ": " << item << endl;
 				return false;
 			}
+			else if (
+				m_args.count(g_argCacheDir) &&
+				(item == g_strAsm || item == g_strGeneratedSources || item == g_strGeneratedSourcesRuntime)
+			)
+			{
+				serr() << "Option " << item << " of --" << g_argCombinedJson << " cannot be used together with --" << g_argCacheDir << "." << endl;
+				return false;
+			}
 	}
 	po::notify(m_args);
 
@@ -1168,6 +1570,12 @@ General Information)").c_str(),
 
 bool CommandLineInterface::processInput()
 {
+	if (m_args.count(g_argTraceFile))
+	{
+		m_tracer = make_unique<util::Tracer>();
+		m_tracerScope = make_unique<util::Tracer::Scope>(*m_tracer);
+	}
+
 	ReadCallback::Callback fileReader = [this](string const& _kind, string const& _path)
 	{
 		try
@@ -1206,9 +1614,9 @@ bool CommandLineInterface::processInput()
 				return ReadCallback::Result{false, "Not a valid file."};
 
 			// NOTE: we ignore the FileNotFound exception as we manually check above
-			auto contents = readFileAsString(canonicalPath.string());
+			SourceBuffer contents = SourceBuffer::fromFile(canonicalPath.string());
 			m_sourceCodes[path.generic_string()] = contents;
-			return ReadCallback::Result{true, contents};
+			return ReadCallback::Result{true, contents.str()};
 		}
 		catch (Exception const& _exception)
 		{
@@ -1262,6 +1670,8 @@ bool CommandLineInterface::processInput()
 
 	vector<string> const exclusiveModes = {
 		g_argStandardJSON,
+		g_argServer,
+		g_argLSP,
 		g_argLink,
 		g_argAssemble,
 		g_argStrictAssembly,
@@ -1274,6 +1684,11 @@ bool CommandLineInterface::processInput()
 		serr() << "Select at most one." << endl;
 		return false;
 	}
+	if (m_args.count(g_argWatch) && countEnabledOptions(exclusiveModes) > 0)
+	{
+		serr() << "Option --" << g_argWatch << " cannot be used together with " << joinOptionNames(exclusiveModes) << "." << endl;
+		return false;
+	}
 
 	if (m_args.count(g_argStandardJSON))
 	{
@@ -1308,8 +1723,43 @@ bool CommandLineInterface::processInput()
 		return true;
 	}
 
+	if (m_args.count(g_argServer))
+	{
+		StandardCompiler compiler(fileReader, true);
+		string error;
+		while (optional<string> request = readLengthPrefixedMessage(cin, error))
+		{
+			string const response = compiler.compile(std::move(*request));
+			sout() << response.size() << "\n" << response << flush;
+		}
+		if (!error.empty())
+		{
+			serr() << error << endl;
+			return false;
+		}
+		return true;
+	}
+
+	if (m_args.count(g_argLSP))
+	{
+		// Imports are resolved relative to the working directory, like for the input files.
+		m_allowedDirectories.push_back(boost::filesystem::current_path());
+		LSPStreamTransport transport(cin, sout());
+		return LanguageServer(transport, fileReader).run();
+	}
+
 	if (!readInputFilesAndConfigureRemappings())
 		return false;
+	if (m_args.count(g_argWatch))
+	{
+		if (m_sourceCodes.count(g_stdinFileName))
+		{
+			serr() << "Option --" << g_argWatch << " cannot be used with the standard input." << endl;
+			return false;
+		}
+		for (auto const& sourceCode: m_sourceCodes)
+			m_inputFiles.insert(sourceCode.first);
+	}
 
 	if (m_args.count(g_argLibraries))
 		for (string const& library: m_args[g_argLibraries].as<vector<string>>())
@@ -1335,6 +1785,7 @@ bool CommandLineInterface::processInput()
 			g_argOutputDir,
 			g_argGas,
 			g_argCombinedJson,
+			g_argCombinedBinary,
 			g_strOptimizeYul,
 			g_strNoOptimizeYul,
 		};
@@ -1380,6 +1831,21 @@ bool CommandLineInterface::processInput()
 
 			yulOptimiserSteps = m_args[g_strYulOptimizations].as<string>();
 		}
+		if (m_args.count(g_strYulOptimizerBudget) && !optimize)
+		{
+			serr() << "--" << g_strYulOptimizerBudget << " is invalid if Yul optimizer is disabled" << endl;
+			return false;
+		}
+		if (m_args.count(g_strYulStackLayout) && !optimize)
+		{
+			serr() << "--" << g_strYulStackLayout << " is invalid if Yul optimizer is disabled" << endl;
+			return false;
+		}
+		if (m_args.count(g_strYulReuseAcrossObjects) && !optimize)
+		{
+			serr() << "--" << g_strYulReuseAcrossObjects << " is invalid if Yul optimizer is disabled" << endl;
+			return false;
+		}
 
 		if (m_args.count(g_argMachine))
 		{
@@ -1497,9 +1963,30 @@ bool CommandLineInterface::processInput()
 	if (m_args.count(g_argModelCheckerTimeout))
 		m_modelCheckerSettings.timeout = m_args[g_argModelCheckerTimeout].as<unsigned>();
 
+	if (m_args.count(g_argModelCheckerTimeBudget))
+		m_modelCheckerSettings.timeBudget = m_args[g_argModelCheckerTimeBudget].as<unsigned>();
+
+	m_modelCheckerSettings.raceSolvers = m_args.count(g_argModelCheckerRaceSolvers) > 0;
+	m_modelCheckerSettings.counterexamples = m_args.count(g_argModelCheckerNoCounterexamples) == 0;
+
+	if (m_args.count(g_argModelCheckerCache))
+		m_modelCheckerSettings.cacheDirectory = m_args[g_argModelCheckerCache].as<string>();
+
+	if (m_args.count(g_argModelCheckerIncremental))
+	{
+		if (!m_args.count(g_argModelCheckerCache))
+		{
+			serr() << "--" << g_argModelCheckerIncremental << " requires --" << g_argModelCheckerCache << "." << endl;
+			return false;
+		}
+		m_modelCheckerSettings.incremental = true;
+	}
+
 	m_compiler = make_unique<CompilerStack>(fileReader);
+	if (m_args.count(g_argWatch))
+		m_compiler->enableIncrementalParsing();
 
-	SourceReferenceFormatter formatter(serr(false), m_coloredOutput, m_withErrorIds);
+	SourceReferenceFormatter formatter(serr(false), *m_compiler, m_coloredOutput, m_withErrorIds);
 
 	try
 	{
@@ -1507,7 +1994,14 @@ bool CommandLineInterface::processInput()
 			m_compiler->useMetadataLiteralSources(true);
 		if (m_args.count(g_argMetadataHash))
 			m_compiler->setMetadataHash(m_metadataHash);
-		if (m_args.count(g_argModelCheckerEngine) || m_args.count(g_argModelCheckerTimeout))
+		if (
+			m_args.count(g_argModelCheckerEngine) ||
+			m_args.count(g_argModelCheckerTimeout) ||
+			m_args.count(g_argModelCheckerTimeBudget) ||
+			m_args.count(g_argModelCheckerRaceSolvers) ||
+			m_args.count(g_argModelCheckerCache) ||
+			m_args.count(g_argModelCheckerNoCounterexamples)
+		)
 			m_compiler->setModelCheckerSettings(m_modelCheckerSettings);
 		if (m_args.count(g_argInputFile))
 			m_compiler->setRemappings(m_remappings);
@@ -1516,12 +2010,18 @@ bool CommandLineInterface::processInput()
 			m_compiler->setLibraries(m_libraries);
 		if (m_args.count(g_argExperimentalViaIR))
 			m_compiler->setViaIR(true);
+		m_compiler->setParallelism(m_args[g_argJobs].as<unsigned>());
+		if (m_args.count(g_argCacheDir))
+			m_compiler->setCompilationCache(make_shared<CompilationCache>(m_args[g_argCacheDir].as<string>()));
 		m_compiler->setEVMVersion(m_evmVersion);
 		m_compiler->setRevertStringBehaviour(m_revertStrings);
 		// TODO: Perhaps we should not compile unless requested
 
 		m_compiler->enableIRGeneration(m_args.count(g_argIR) || m_args.count(g_argIROptimized));
 		m_compiler->enableEwasmGeneration(m_args.count(g_argEwasm));
+		m_compiler->enableCompilationStatistics(m_args.count(g_argTimePasses) || m_args.count(g_argModelCheckerPrintStats));
+		if (m_args.count(g_argMemoryReport))
+			util::MemoryAccounting::enable();
 
 		OptimiserSettings settings = m_args.count(g_argOptimize) ? OptimiserSettings::standard() : OptimiserSettings::minimal();
 		settings.expectedExecutionsPerDeployment = m_args[g_argOptimizeRuns].as<unsigned>();
@@ -1547,6 +2047,33 @@ bool CommandLineInterface::processInput()
 
 			settings.yulOptimiserSteps = m_args[g_strYulOptimizations].as<string>();
 		}
+		if (m_args.count(g_strYulOptimizerBudget))
+		{
+			if (!settings.runYulOptimiser)
+			{
+				serr() << "--" << g_strYulOptimizerBudget << " is invalid if Yul optimizer is disabled" << endl;
+				return false;
+			}
+			settings.yulOptimiserTimeBudget = chrono::milliseconds(m_args[g_strYulOptimizerBudget].as<unsigned>());
+		}
+		if (m_args.count(g_strYulStackLayout))
+		{
+			if (!settings.runYulOptimiser)
+			{
+				serr() << "--" << g_strYulStackLayout << " is invalid if Yul optimizer is disabled" << endl;
+				return false;
+			}
+			settings.optimizeStackLayout = true;
+		}
+		if (m_args.count(g_strYulReuseAcrossObjects))
+		{
+			if (!settings.runYulOptimiser)
+			{
+				serr() << "--" << g_strYulReuseAcrossObjects << " is invalid if Yul optimizer is disabled" << endl;
+				return false;
+			}
+			settings.yulReuseAcrossObjects = true;
+		}
 		settings.optimizeStackAllocation = settings.runYulOptimiser;
 		m_compiler->setOptimiserSettings(settings);
 
@@ -1571,7 +2098,7 @@ bool CommandLineInterface::processInput()
 		}
 		else
 		{
-			m_compiler->setSources(m_sourceCodes);
+			m_compiler->setSourceBuffers(m_sourceCodes);
 			if (m_args.count(g_argErrorRecovery))
 				m_compiler->setParserErrorRecovery(true);
 		}
@@ -1586,7 +2113,8 @@ bool CommandLineInterface::processInput()
 
 		if (!successful)
 		{
-			if (m_args.count(g_argErrorRecovery))
+			// In watch mode, the sources are compiled again once they change.
+			if (m_args.count(g_argErrorRecovery) || m_args.count(g_argWatch))
 				return true;
 			else
 				return false;
@@ -1667,46 +2195,56 @@ void CommandLineInterface::handleCombinedJSON()
 	boost::split(requests, m_args[g_argCombinedJson].as<string>(), boost::is_any_of(","));
 	vector<string> contracts = m_compiler->contractNames();
 
+	// The data of the contracts is collected concurrently and inserted in the order of the contracts.
+	vector<Json::Value> contractsData(contracts.size(), Json::Value(Json::objectValue));
+	{
+		ThreadPool pool(min(ThreadPool::effectiveThreads(m_args[g_argJobs].as<unsigned>()), max<size_t>(contracts.size(), 1)));
+		for (size_t i = 0; i < contracts.size(); ++i)
+			pool.submit([&, i]() {
+				string const& contractName = contracts[i];
+				Json::Value& contractData = contractsData[i];
+				if (requests.count(g_strAbi))
+					contractData[g_strAbi] = m_compiler->contractABI(contractName);
+				if (requests.count("metadata"))
+					contractData["metadata"] = m_compiler->metadata(contractName);
+				if (requests.count(g_strBinary) && m_compiler->compilationSuccessful())
+					contractData[g_strBinary] = m_compiler->object(contractName).toHex();
+				if (requests.count(g_strBinaryRuntime) && m_compiler->compilationSuccessful())
+					contractData[g_strBinaryRuntime] = m_compiler->runtimeObject(contractName).toHex();
+				if (requests.count(g_strOpcodes) && m_compiler->compilationSuccessful())
+					contractData[g_strOpcodes] = evmasm::disassemble(m_compiler->object(contractName).bytecode);
+				if (requests.count(g_strAsm) && m_compiler->compilationSuccessful())
+					contractData[g_strAsm] = m_compiler->assemblyJSON(contractName);
+				if (requests.count(g_strStorageLayout) && m_compiler->compilationSuccessful())
+					contractData[g_strStorageLayout] = m_compiler->storageLayout(contractName);
+				if (requests.count(g_strGeneratedSources) && m_compiler->compilationSuccessful())
+					contractData[g_strGeneratedSources] = m_compiler->generatedSources(contractName, false);
+				if (requests.count(g_strGeneratedSourcesRuntime) && m_compiler->compilationSuccessful())
+					contractData[g_strGeneratedSourcesRuntime] = m_compiler->generatedSources(contractName, true);
+				if (requests.count(g_strSrcMap) && m_compiler->compilationSuccessful())
+				{
+					auto map = m_compiler->sourceMapping(contractName);
+					contractData[g_strSrcMap] = map ? *map : "";
+				}
+				if (requests.count(g_strSrcMapRuntime) && m_compiler->compilationSuccessful())
+				{
+					auto map = m_compiler->runtimeSourceMapping(contractName);
+					contractData[g_strSrcMapRuntime] = map ? *map : "";
+				}
+				if (requests.count(g_strSignatureHashes))
+					contractData[g_strSignatureHashes] = m_compiler->methodIdentifiers(contractName);
+				if (requests.count(g_strNatspecDev))
+					contractData[g_strNatspecDev] = m_compiler->natspecDev(contractName);
+				if (requests.count(g_strNatspecUser))
+					contractData[g_strNatspecUser] = m_compiler->natspecUser(contractName);
+			});
+		pool.wait();
+	}
+
 	if (!contracts.empty())
 		output[g_strContracts] = Json::Value(Json::objectValue);
-	for (string const& contractName: contracts)
-	{
-		Json::Value& contractData = output[g_strContracts][contractName] = Json::objectValue;
-		if (requests.count(g_strAbi))
-			contractData[g_strAbi] = m_compiler->contractABI(contractName);
-		if (requests.count("metadata"))
-			contractData["metadata"] = m_compiler->metadata(contractName);
-		if (requests.count(g_strBinary) && m_compiler->compilationSuccessful())
-			contractData[g_strBinary] = m_compiler->object(contractName).toHex();
-		if (requests.count(g_strBinaryRuntime) && m_compiler->compilationSuccessful())
-			contractData[g_strBinaryRuntime] = m_compiler->runtimeObject(contractName).toHex();
-		if (requests.count(g_strOpcodes) && m_compiler->compilationSuccessful())
-			contractData[g_strOpcodes] = evmasm::disassemble(m_compiler->object(contractName).bytecode);
-		if (requests.count(g_strAsm) && m_compiler->compilationSuccessful())
-			contractData[g_strAsm] = m_compiler->assemblyJSON(contractName);
-		if (requests.count(g_strStorageLayout) && m_compiler->compilationSuccessful())
-			contractData[g_strStorageLayout] = m_compiler->storageLayout(contractName);
-		if (requests.count(g_strGeneratedSources) && m_compiler->compilationSuccessful())
-			contractData[g_strGeneratedSources] = m_compiler->generatedSources(contractName, false);
-		if (requests.count(g_strGeneratedSourcesRuntime) && m_compiler->compilationSuccessful())
-			contractData[g_strGeneratedSourcesRuntime] = m_compiler->generatedSources(contractName, true);
-		if (requests.count(g_strSrcMap) && m_compiler->compilationSuccessful())
-		{
-			auto map = m_compiler->sourceMapping(contractName);
-			contractData[g_strSrcMap] = map ? *map : "";
-		}
-		if (requests.count(g_strSrcMapRuntime) && m_compiler->compilationSuccessful())
-		{
-			auto map = m_compiler->runtimeSourceMapping(contractName);
-			contractData[g_strSrcMapRuntime] = map ? *map : "";
-		}
-		if (requests.count(g_strSignatureHashes))
-			contractData[g_strSignatureHashes] = m_compiler->methodIdentifiers(contractName);
-		if (requests.count(g_strNatspecDev))
-			contractData[g_strNatspecDev] = m_compiler->natspecDev(contractName);
-		if (requests.count(g_strNatspecUser))
-			contractData[g_strNatspecUser] = m_compiler->natspecUser(contractName);
-	}
+	for (size_t i = 0; i < contracts.size(); ++i)
+		output[g_strContracts][contracts[i]] = move(contractsData[i]);
 
 	bool needsSourceList = requests.count(g_strAst) || requests.count(g_strSrcMap) || requests.count(g_strSrcMapRuntime);
 	if (needsSourceList)
@@ -1729,6 +2267,10 @@ void CommandLineInterface::handleCombinedJSON()
 		}
 	}
 
+	util::MemoryAccount outputMemory(util::MemorySubsystem::JSONOutput);
+	if (util::MemoryAccounting::enabled())
+		outputMemory.set(util::jsonMemoryUsage(output));
+
 	string json = m_args.count(g_argPrettyJson) ? jsonPrettyPrint(removeNullMembers(std::move(output))) :
 		jsonCompactPrint(removeNullMembers(std::move(output)));
 
@@ -1738,8 +2280,24 @@ void CommandLineInterface::handleCombinedJSON()
 		sout() << json << endl;
 }
 
+void CommandLineInterface::handleCombinedBinary()
+{
+	if (m_args.count(g_argCombinedBinary) && m_compiler->compilationSuccessful())
+		createFile("combined.bin", ArtifactBinary::encode(*m_compiler));
+}
+
 void CommandLineInterface::handleAst()
 {
+	if (m_args.count(g_argAstBinary))
+	{
+		map<string, Json::Value> sourceJsons;
+		for (auto const& sourceCode: m_sourceCodes)
+			sourceJsons[sourceCode.first] = ASTJsonConverter(m_compiler->state(), m_compiler->sourceIndices()).toJson(
+				m_compiler->ast(sourceCode.first)
+			);
+		createFile("combined_ast.bin", ASTBinary::encode(sourceJsons));
+	}
+
 	if (!m_args.count(g_argAstCompactJson))
 		return;
 
@@ -1772,20 +2330,122 @@ void CommandLineInterface::handleAst()
 
 bool CommandLineInterface::actOnInput()
 {
-	if (m_args.count(g_argStandardJSON) || m_onlyAssemble)
+	if (m_args.count(g_argStandardJSON) || m_args.count(g_argServer) || m_args.count(g_argLSP) || m_onlyAssemble)
 		// Already done in "processInput" phase.
-		return true;
+		return writeTrace();
 	else if (m_onlyLink)
 		writeLinkedFiles();
+	else if (m_args.count(g_argWatch))
+		watch();
 	else
 		outputCompilationResults();
-	return !m_error;
+	return writeTrace() && !m_error;
+}
+
+bool CommandLineInterface::writeTrace()
+{
+	if (!m_tracer)
+		return true;
+
+	m_tracerScope.reset();
+	string const path = m_args.at(g_argTraceFile).as<string>();
+	ofstream traceFile(path);
+	traceFile << jsonCompactPrint(m_tracer->toJson());
+	if (!traceFile)
+	{
+		serr() << "Could not write to file \"" << path << "\"." << endl;
+		return false;
+	}
+	return true;
+}
+
+void CommandLineInterface::watch()
+{
+	if (Error::containsOnlyWarnings(m_compiler->errors()))
+		outputCompilationResults();
+
+	FileWatcher watcher;
+	auto watchSources = [&]() {
+		set<boost::filesystem::path> paths;
+		for (auto const& sourceCode: m_sourceCodes)
+			paths.insert(sourceCode.first);
+		watcher.watch(paths);
+	};
+	watchSources();
+
+	while (true)
+	{
+		sout() << flush;
+		serr() << endl << "Watching " << m_sourceCodes.size() << " files for changes..." << endl;
+		set<boost::filesystem::path> const changes = watcher.wait();
+		for (boost::filesystem::path const& change: changes)
+			serr() << "Changed: " << change.string() << endl;
+
+		m_error = false;
+		if (!recompile())
+			m_error = true;
+		else if (Error::containsOnlyWarnings(m_compiler->errors()) || m_args.count(g_argErrorRecovery))
+			outputCompilationResults();
+		// The compilation may have imported files that were not watched yet.
+		watchSources();
+	}
+}
+
+bool CommandLineInterface::recompile()
+{
+	// Imported files are added by the read callback of the compiler.
+	m_sourceCodes.clear();
+	for (string const& inputFile: m_inputFiles)
+		try
+		{
+			m_sourceCodes[inputFile] = SourceBuffer::fromFile(inputFile);
+		}
+		catch (FileNotFound const&)
+		{
+			if (!m_args.count(g_argIgnoreMissingFiles))
+			{
+				serr() << "\"" << inputFile << "\" is not found." << endl;
+				return false;
+			}
+		}
+
+	SourceReferenceFormatter formatter(serr(false), *m_compiler, m_coloredOutput, m_withErrorIds);
+	try
+	{
+		m_compiler->reset(true);
+		m_compiler->setSourceBuffers(m_sourceCodes);
+		m_compiler->compile(m_stopAfter);
+		for (auto const& error: m_compiler->errors())
+		{
+			g_hasOutput = true;
+			formatter.printErrorInformation(*error);
+		}
+	}
+	catch (CompilerError const& _exception)
+	{
+		g_hasOutput = true;
+		formatter.printExceptionInformation(_exception, "Compiler error");
+		return false;
+	}
+	catch (Error const& _error)
+	{
+		g_hasOutput = true;
+		formatter.printExceptionInformation(_error, _error.typeName());
+		return false;
+	}
+	catch (...)
+	{
+		serr() << "Exception during compilation: " << boost::current_exception_diagnostic_information() << endl;
+		return false;
+	}
+	return true;
 }
 
 bool CommandLineInterface::link()
 {
-	// Map from how the libraries will be named inside the bytecode to their addresses.
-	map<string, h160> librariesReplacements;
+	// Map from how the libraries will be named inside the bytecode to the hex representation
+	// of their addresses.
+	map<string, string> librariesReplacements;
 	int const placeholderSize = 40; // 20 bytes or 40 hex characters
 	for (auto const& library: m_libraries)
 	{
@@ -1795,18 +2455,20 @@ bool CommandLineInterface::link()
 		// be just the cropped or '_'-padded library name, but this changed to
 		// the cropped hex representation of the hash of the library name.
 		// We support both ways of linking here.
-		librariesReplacements["__" + evmasm::LinkerObject::libraryPlaceholder(name) + "__"] = library.second;
+		string address = toHex(library.second.asBytes());
+		librariesReplacements["__" + evmasm::LinkerObject::libraryPlaceholder(name) + "__"] = address;
 
 		string replacement = "__";
 		for (size_t i = 0; i < placeholderSize - 4; ++i)
 			replacement.push_back(i < name.size() ? name[i] : '_');
 		replacement += "__";
-		librariesReplacements[replacement] = library.second;
+		librariesReplacements[replacement] = move(address);
 	}
 	for (auto& src: m_sourceCodes)
 	{
-		auto end = src.second.end();
-		for (auto it = src.second.begin(); it != end;)
+		string code = src.second.str();
+		auto end = code.end();
+		for (auto it = code.begin(); it != end;)
 		{
 			while (it != end && *it != '_') ++it;
 			if (it == end) break;
@@ -1817,26 +2479,24 @@ bool CommandLineInterface::link()
 				*(it + placeholderSize - 1) != '_'
 			)
 			{
-				serr() << "Error in binary object file " << src.first << " at position " << (it - src.second.begin()) << endl;
+				serr() << "Error in binary object file " << src.first << " at position " << (it - code.begin()) << endl;
 				serr() << '"' << string(it, it + min(placeholderSize, static_cast<int>(end - it))) << "\" is not a valid link reference." << endl;
 				return false;
 			}
 
 			string foundPlaceholder(it, it + placeholderSize);
-			if (librariesReplacements.count(foundPlaceholder))
-			{
-				string hexStr(toHex(librariesReplacements.at(foundPlaceholder).asBytes()));
-				copy(hexStr.begin(), hexStr.end(), it);
-			}
+			if (auto replacement = librariesReplacements.find(foundPlaceholder); replacement != librariesReplacements.end())
+				copy(replacement->second.begin(), replacement->second.end(), it);
 			else
 				serr() << "Reference \"" << foundPlaceholder << "\" in file \"" << src.first << "\" still unresolved." << endl;
 			it += placeholderSize;
 		}
 		// Remove hints for resolved libraries.
 		for (auto const& library: m_libraries)
-			boost::algorithm::erase_all(src.second, "\n" + libraryPlaceholderHint(library.first));
-		while (!src.second.empty() && *prev(src.second.end()) == '\n')
-			src.second.resize(src.second.size() - 1);
+			boost::algorithm::erase_all(code, "\n" + libraryPlaceholderHint(library.first));
+		while (!code.empty() && *prev(code.end()) == '\n')
+			code.resize(code.size() - 1);
+		src.second = SourceBuffer(move(code));
 	}
 	return true;
 }
@@ -1845,11 +2505,11 @@ void CommandLineInterface::writeLinkedFiles()
 {
 	for (auto const& src: m_sourceCodes)
 		if (src.first == g_stdinFileName)
-			sout() << src.second << endl;
+			sout() << src.second.view() << endl;
 		else
 		{
 			ofstream outFile(src.first);
-			outFile << src.second;
+			outFile << src.second.view();
 			if (!outFile)
 			{
 				serr() << "Could not write to file " << src.first << ". Aborting." << endl;
@@ -1866,14 +2526,20 @@ string CommandLineInterface::libraryPlaceholderHint(string const& _libraryName)
 
 string CommandLineInterface::objectWithLinkRefsHex(evmasm::LinkerObject const& _obj)
 {
-	string out = _obj.toHex();
+	ostringstream out;
+	printObjectWithLinkRefsHex(out, _obj);
+	return out.str();
+}
+
+void CommandLineInterface::printObjectWithLinkRefsHex(ostream& _out, evmasm::LinkerObject const& _obj)
+{
+	_obj.toHex(_out);
 	if (!_obj.linkReferences.empty())
 	{
-		out += "\n";
+		_out << "\n";
 		for (auto const& linkRef: _obj.linkReferences)
-			out += "\n" + libraryPlaceholderHint(linkRef.second);
+			_out << "\n" << libraryPlaceholderHint(linkRef.second);
 	}
-	return out;
 }
 
 bool CommandLineInterface::assemble(
@@ -1892,11 +2558,15 @@ bool CommandLineInterface::assemble(
 		OptimiserSettings settings = _optimize ? OptimiserSettings::full() : OptimiserSettings::minimal();
 		if (_yulOptimiserSteps.has_value())
 			settings.yulOptimiserSteps = _yulOptimiserSteps.value();
+		if (m_args.count(g_strYulOptimizerBudget))
+			settings.yulOptimiserTimeBudget = chrono::milliseconds(m_args[g_strYulOptimizerBudget].as<unsigned>());
+		settings.optimizeStackLayout = m_args.count(g_strYulStackLayout) > 0;
+		settings.yulReuseAcrossObjects = m_args.count(g_strYulReuseAcrossObjects) > 0;
 
 		auto& stack = assemblyStacks[src.first] = yul::AssemblyStack(m_evmVersion, _language, settings);
 		try
 		{
-			if (!stack.parseAndAnalyze(src.first, src.second))
+			if (!stack.parseAndAnalyze(src.first, src.second.str()))
 				successful = false;
 			else
 				stack.optimize();
@@ -1924,7 +2594,7 @@ bool CommandLineInterface::assemble(
 	for (auto const& sourceAndStack: assemblyStacks)
 	{
 		auto const& stack = sourceAndStack.second;
-		SourceReferenceFormatter formatter(serr(false), m_coloredOutput, m_withErrorIds);
+		SourceReferenceFormatter formatter(serr(false), stack, m_coloredOutput, m_withErrorIds);
 
 		for (auto const& error: stack.errors())
 		{
@@ -2008,7 +2678,10 @@ bool CommandLineInterface::assemble(
 
 		sout() << endl << "Binary representation:" << endl;
 		if (object.bytecode)
-			sout() << object.bytecode->toHex() << endl;
+		{
+			object.bytecode->toHex(sout());
+			sout() << endl;
+		}
 		else
 			serr() << "No binary representation found." << endl;
 
@@ -2022,9 +2695,55 @@ bool CommandLineInterface::assemble(
 	return true;
 }
 
+void CommandLineInterface::outputContractResults(string const& _contract, StringMap const& _sourceCodes)
+{
+	if (needsHumanTargetedStdout(m_args))
+		sout() << endl << "======= " << _contract << " =======" << endl;
+
+	// do we need EVM assembly?
+	// The text representation is printed while it is created.
+	if (m_args.count(g_argAsm) || m_args.count(g_argAsmJson))
+	{
+		function<void(ostream&)> printAssembly = [&](ostream& _out) {
+			if (m_args.count(g_argAsmJson))
+				_out << jsonPrettyPrint(removeNullMembers(m_compiler->assemblyJSON(_contract)));
+			else
+				m_compiler->assemblyStream(_out, _contract, _sourceCodes);
+		};
+
+		if (m_args.count(g_argOutputDir))
+		{
+			createFile(m_compiler->filesystemFriendlyName(_contract) + (m_args.count(g_argAsmJson) ? "_evm.json" : ".evm"), printAssembly);
+		}
+		else
+		{
+			sout() << "EVM assembly:" << endl;
+			printAssembly(sout());
+			sout() << endl;
+		}
+	}
+
+	if (m_args.count(g_argGas))
+		handleGasEstimation(_contract);
+
+	handleBytecode(_contract);
+	handleIR(_contract);
+	handleIROptimized(_contract);
+	handleEwasm(_contract);
+	handleSignatureHashes(_contract);
+	handleMetadata(_contract);
+	handleABI(_contract);
+	handleStorageLayout(_contract);
+	handleNatspec(true, _contract);
+	handleNatspec(false, _contract);
+}
+
 void CommandLineInterface::outputCompilationResults()
 {
+	// The AST export can request types of the compilation.
+	TypeProvider::Scope typeScope(m_compiler->typeProvider());
 	handleCombinedJSON();
+	handleCombinedBinary();
 
 	// do we need AST output?
 	handleAst();
@@ -2038,45 +2757,51 @@ void CommandLineInterface::outputCompilationResults()
 		return;
 	}
 
-	vector<string> contracts = m_compiler->contractNames();
-	for (string const& contract: contracts)
-	{
-		if (needsHumanTargetedStdout(m_args))
-			sout() << endl << "======= " << contract << " =======" << endl;
+	// The assembly output quotes the sources, which it only accepts as strings.
+	StringMap sourceCodes;
+	if (m_args.count(g_argAsm) && !m_args.count(g_argAsmJson))
+		for (auto const& sourceCode: m_sourceCodes)
+			sourceCodes[sourceCode.first] = sourceCode.second.str();
 
-		// do we need EVM assembly?
-		if (m_args.count(g_argAsm) || m_args.count(g_argAsmJson))
-		{
-			string ret;
-			if (m_args.count(g_argAsmJson))
-				ret = jsonPrettyPrint(removeNullMembers(m_compiler->assemblyJSON(contract)));
-			else
-				ret = m_compiler->assemblyString(contract, m_sourceCodes);
+	// The outputs of the contracts are rendered and written concurrently. Anything printed is
+	// collected per contract and printed in the order of the contracts afterwards.
+	vector<string> contracts = m_compiler->contractNames();
+	vector<ostringstream> contractOutputs(contracts.size());
+	// The functions of all contracts are estimated together, which balances the load better
+	// than estimating the functions of each contract on its own.
+	if (m_args.count(g_argGas) && m_compiler->compilationSuccessful())
+		m_compiler->computeGasEstimates(contracts);
+	{
+		ThreadPool pool(min(ThreadPool::effectiveThreads(m_args[g_argJobs].as<unsigned>()), max<size_t>(contracts.size(), 1)));
+		for (size_t i = 0; i < contracts.size(); ++i)
+			pool.submit([&, i]() {
+				t_contractOutput = &contractOutputs[i];
+				ScopeGuard resetOutput([]() { t_contractOutput = nullptr; });
+				outputContractResults(contracts[i], sourceCodes);
+			});
+		pool.wait();
+	}
+	for (ostringstream const& contractOutput: contractOutputs)
+		if (!contractOutput.str().empty())
+			sout() << contractOutput.str();
 
-			if (m_args.count(g_argOutputDir))
-			{
-				createFile(m_compiler->filesystemFriendlyName(contract) + (m_args.count(g_argAsmJson) ? "_evm.json" : ".evm"), ret);
-			}
-			else
-			{
-				sout() << "EVM assembly:" << endl << ret << endl;
-			}
-		}
+	if (m_args.count(g_argTimePasses))
+	{
+		g_hasOutput = true;
+		handleCompilationStatistics();
+	}
+	else if (m_args.count(g_argModelCheckerPrintStats))
+	{
+		g_hasOutput = true;
+		handleModelCheckerStatistics();
+	}
 
-		if (m_args.count(g_argGas))
-			handleGasEstimation(contract);
-
-		handleBytecode(contract);
-		handleIR(contract);
-		handleIROptimized(contract);
-		handleEwasm(contract);
-		handleSignatureHashes(contract);
-		handleMetadata(contract);
-		handleABI(contract);
-		handleStorageLayout(contract);
-		handleNatspec(true, contract);
-		handleNatspec(false, contract);
-	} // end of contracts iteration
+	if (m_args.count(g_argMemoryReport))
+	{
+		g_hasOutput = true;
+		serr() << endl << "======= Memory report =======" << endl;
+		printMemoryReport(serr());
+	}
 
 	if (!g_hasOutput)
 	{
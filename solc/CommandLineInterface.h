@@ -26,11 +26,16 @@
 #include <libsolidity/interface/DebugSettings.h>
 #include <libyul/AssemblyStack.h>
 #include <liblangutil/EVMVersion.h>
+#include <libsolutil/SourceBuffer.h>
+#include <libsolutil/Tracer.h>
 
 #include <boost/program_options.hpp>
 #include <boost/filesystem/path.hpp>
 
+#include <functional>
 #include <memory>
+#include <mutex>
+#include <set>
 
 namespace solidity::frontend
 {
@@ -56,6 +61,8 @@ private:
 	static std::string libraryPlaceholderHint(std::string const& _libraryName);
 	/// @returns the full object with library placeholder hints in hex.
 	static std::string objectWithLinkRefsHex(evmasm::LinkerObject const& _obj);
+	/// Prints the full object with library placeholder hints in hex to @a _out.
+	static void printObjectWithLinkRefsHex(std::ostream& _out, evmasm::LinkerObject const& _obj);
 
 	bool assemble(
 		yul::AssemblyStack::Language _language,
@@ -65,8 +72,19 @@ private:
 	);
 
 	void outputCompilationResults();
+	/// Prints or writes the requested outputs of @a _contract. Can be called for different
+	/// contracts concurrently.
+	void outputContractResults(std::string const& _contract, StringMap const& _sourceCodes);
+
+	/// Prints the outputs of the initial compilation and then compiles again and prints the
+	/// outputs whenever one of the sources changed. Does not return.
+	void watch();
+	/// Reads the input files again and compiles them, reusing the unchanged sources.
+	/// Prints the errors and @returns false if the compilation could not be performed at all.
+	bool recompile();
 
 	void handleCombinedJSON();
+	void handleCombinedBinary();
 	void handleAst();
 	void handleBinary(std::string const& _contract);
 	void handleOpcode(std::string const& _contract);
@@ -80,6 +98,11 @@ private:
 	void handleNatspec(bool _natspecDev, std::string const& _contract);
 	void handleGasEstimation(std::string const& _contract);
 	void handleStorageLayout(std::string const& _contract);
+	void handleCompilationStatistics();
+	void handleModelCheckerStatistics();
+	/// Stops tracing and writes the trace to the file given via --trace-file, if any.
+	/// @returns false if the file could not be written.
+	bool writeTrace();
 
 	/// Fills @a m_sourceCodes initially and @a m_redirects.
 	bool readInputFilesAndConfigureRemappings();
@@ -93,10 +116,12 @@ private:
 	/// or standard-json output
 	std::map<std::string, Json::Value> parseAstFromInput();
 
-	/// Create a file in the given directory
+	/// Create a file in the given directory. Can be called concurrently.
 	/// @arg _fileName the name of the file
 	/// @arg _data to be written
 	void createFile(std::string const& _fileName, std::string const& _data);
+	/// Create a file in the given directory, whose contents are printed by @a _write.
+	void createFile(std::string const& _fileName, std::function<void(std::ostream&)> const& _write);
 
 	/// Create a json file in the given directory
 	/// @arg _fileName the name of the file (the extension will be replaced with .json)
@@ -107,6 +132,8 @@ private:
 	static std::string joinOptionNames(std::vector<std::string> const& _optionNames, std::string _separator = ", ");
 
 	bool m_error = false; ///< If true, some error occurred.
+	/// Guards @a m_error and @a m_writtenFiles while the outputs of the contracts are written concurrently.
+	std::mutex m_outputMutex;
 
 	bool m_onlyAssemble = false;
 
@@ -114,8 +141,12 @@ private:
 
 	/// Compiler arguments variable map
 	boost::program_options::variables_map m_args;
-	/// map of input files to source code strings
-	std::map<std::string, std::string> m_sourceCodes;
+	/// map of input files to source code buffers
+	std::map<std::string, util::SourceBuffer> m_sourceCodes;
+	/// The input files given on the commandline, which are read again in watch mode.
+	std::set<std::string> m_inputFiles;
+	/// Files written to the output directory, which may be written again in watch mode.
+	std::set<std::string> m_writtenFiles;
 	/// list of remappings
 	std::vector<frontend::CompilerStack::Remapping> m_remappings;
 	/// list of allowed directories to read files from
@@ -139,6 +170,9 @@ private:
 	bool m_coloredOutput = true;
 	/// Whether or not to output error IDs.
 	bool m_withErrorIds = false;
+	/// Records the spans of the compilation if --trace-file is given.
+	std::unique_ptr<util::Tracer> m_tracer;
+	std::unique_ptr<util::Tracer::Scope> m_tracerScope;
 };
 
 }
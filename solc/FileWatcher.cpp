@@ -0,0 +1,203 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Notification about changes of files for the watch mode of the commandline interface.
+ */
+
+#include <solc/FileWatcher.h>
+
+#include <boost/filesystem/operations.hpp>
+
+#include <chrono>
+#include <thread>
+
+#if defined(__linux__)
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/stat.h>
+#endif
+
+using namespace std;
+using namespace solidity::frontend;
+
+namespace fs = boost::filesystem;
+
+namespace
+{
+
+/// Time to wait for further changes after the first one, e.g. while an editor writes several files.
+constexpr int settleMilliseconds = 100;
+/// Interval in which the files are checked if inotify is not available.
+constexpr int pollMilliseconds = 250;
+
+}
+
+FileWatcher::FileWatcher()
+{
+#if defined(__linux__)
+	m_inotify = inotify_init1(IN_CLOEXEC | IN_NONBLOCK);
+#endif
+}
+
+FileWatcher::~FileWatcher()
+{
+#if defined(__linux__)
+	if (m_inotify != -1)
+		close(m_inotify);
+#endif
+}
+
+void FileWatcher::watch(set<fs::path> const& _paths)
+{
+	for (fs::path const& path: _paths)
+	{
+		fs::path const file = normalized(path);
+		if (m_files.count(file))
+			continue;
+		m_files[file] = state(file);
+
+#if defined(__linux__)
+		if (m_inotify == -1)
+			continue;
+		fs::path const directory = file.parent_path();
+		bool watched = false;
+		for (auto const& entry: m_directories)
+			watched = watched || entry.second == directory;
+		if (watched)
+			continue;
+		int const descriptor = inotify_add_watch(
+			m_inotify,
+			directory.c_str(),
+			IN_CLOSE_WRITE | IN_MODIFY | IN_ATTRIB | IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO
+		);
+		if (descriptor != -1)
+			m_directories[descriptor] = directory;
+		else
+		{
+			// The directory does not exist (yet) or the watch limit is reached.
+			close(m_inotify);
+			m_inotify = -1;
+			m_directories.clear();
+		}
+#endif
+	}
+}
+
+set<fs::path> FileWatcher::wait()
+{
+	set<fs::path> changes;
+	if (m_inotify != -1)
+	{
+		while (changes.empty())
+			readEvents(-1, changes);
+		readEvents(settleMilliseconds, changes);
+		// Record the new states, so that polling can take over if inotify fails later.
+		for (fs::path const& file: changes)
+			m_files[file] = state(file);
+		return changes;
+	}
+
+	while ((changes = pollChanges()).empty())
+		this_thread::sleep_for(chrono::milliseconds(pollMilliseconds));
+	this_thread::sleep_for(chrono::milliseconds(settleMilliseconds));
+	for (fs::path const& file: pollChanges())
+		changes.insert(file);
+	return changes;
+}
+
+fs::path FileWatcher::normalized(fs::path const& _path)
+{
+	return fs::absolute(_path).lexically_normal();
+}
+
+FileWatcher::FileState FileWatcher::state(fs::path const& _path)
+{
+	FileState fileState;
+#if defined(__unix__) || defined(__APPLE__)
+	// The modification times reported by boost only have a resolution of seconds.
+	struct stat status;
+	if (stat(_path.c_str(), &status) != 0)
+		return fileState;
+#if defined(__APPLE__)
+	timespec const& modificationTime = status.st_mtimespec;
+#else
+	timespec const& modificationTime = status.st_mtim;
+#endif
+	fileState.modificationTime = int64_t(modificationTime.tv_sec) * 1000000000 + modificationTime.tv_nsec;
+	fileState.size = uintmax_t(status.st_size);
+#else
+	boost::system::error_code error;
+	time_t const modificationTime = fs::last_write_time(_path, error);
+	if (error)
+		return fileState;
+	fileState.modificationTime = modificationTime;
+	uintmax_t const size = fs::file_size(_path, error);
+	if (!error)
+		fileState.size = size;
+#endif
+	return fileState;
+}
+
+set<fs::path> FileWatcher::pollChanges()
+{
+	set<fs::path> changes;
+	for (auto& [file, fileState]: m_files)
+	{
+		FileState currentState = state(file);
+		if (!(currentState == fileState))
+		{
+			changes.insert(file);
+			fileState = currentState;
+		}
+	}
+	return changes;
+}
+
+void FileWatcher::readEvents(int _timeoutMilliseconds, set<fs::path>& _changes)
+{
+#if defined(__linux__)
+	pollfd descriptor{m_inotify, POLLIN, 0};
+	while (poll(&descriptor, 1, _timeoutMilliseconds) > 0)
+	{
+		alignas(inotify_event) char buffer[4096];
+		ssize_t length = read(m_inotify, buffer, sizeof(buffer));
+		if (length <= 0)
+			break;
+		for (char const* position = buffer; position < buffer + length;)
+		{
+			auto const* event = reinterpret_cast<inotify_event const*>(position);
+			position += sizeof(inotify_event) + event->len;
+			auto directory = m_directories.find(event->wd);
+			if (directory == m_directories.end() || event->len == 0)
+				continue;
+			fs::path const file = directory->second / event->name;
+			if (m_files.count(file))
+				_changes.insert(file);
+		}
+		// Without a timeout, return as soon as one of the watched files changed.
+		if (_timeoutMilliseconds < 0 && !_changes.empty())
+			break;
+	}
+#else
+	(void)_timeoutMilliseconds;
+	(void)_changes;
+#endif
+}
@@ -0,0 +1,85 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Notification about changes of files for the watch mode of the commandline interface.
+ */
+#pragma once
+
+#include <boost/filesystem/path.hpp>
+
+#include <cstdint>
+#include <map>
+#include <optional>
+#include <set>
+
+namespace solidity::frontend
+{
+
+/**
+ * Waits for changes of a set of files. Uses inotify on Linux and falls back to polling the
+ * modification times and sizes of the files on other platforms or if inotify is not available.
+ *
+ * Changes made after a file has been added via @a watch are reported by the next call to
+ * @a wait, even if they happen before @a wait is called.
+ */
+class FileWatcher
+{
+public:
+	FileWatcher();
+	~FileWatcher();
+	FileWatcher(FileWatcher const&) = delete;
+	FileWatcher& operator=(FileWatcher const&) = delete;
+
+	/// Adds @a _paths to the watched files. The files do not have to exist.
+	void watch(std::set<boost::filesystem::path> const& _paths);
+
+	/// Blocks until at least one of the watched files was modified, created, removed or replaced,
+	/// waits for further changes that follow shortly after and @returns the changed files.
+	std::set<boost::filesystem::path> wait();
+
+private:
+	struct FileState
+	{
+		/// Time of the last modification in nanoseconds where available, otherwise in seconds.
+		std::optional<std::int64_t> modificationTime;
+		std::uintmax_t size = 0;
+		bool operator==(FileState const& _other) const
+		{
+			return modificationTime == _other.modificationTime && size == _other.size;
+		}
+	};
+
+	static boost::filesystem::path normalized(boost::filesystem::path const& _path);
+	static FileState state(boost::filesystem::path const& _path);
+
+	/// @returns the watched files whose state differs from the recorded one and records their new state.
+	std::set<boost::filesystem::path> pollChanges();
+	/// Reads the pending inotify events, waiting at most @a _timeoutMilliseconds for the first one,
+	/// and adds the watched files they refer to to @a _changes.
+	void readEvents(int _timeoutMilliseconds, std::set<boost::filesystem::path>& _changes);
+
+	/// Watched files with their state when they were last checked (only used for polling).
+	std::map<boost::filesystem::path, FileState> m_files;
+	/// The inotify file descriptor, or -1 if changes are detected by polling.
+	int m_inotify = -1;
+	/// The watched directories by their inotify watch descriptors. The directories are watched
+	/// instead of the files, because many editors save files by replacing them.
+	std::map<int, boost::filesystem::path> m_directories;
+};
+
+}
@@ -18,9 +18,11 @@
 
 #include <stdexcept>
 #include <iostream>
+#include <regex>
 #include <test/Common.h>
 
 #include <libsolutil/Assertions.h>
+#include <libsolutil/Keccak256.h>
 #include <boost/filesystem.hpp>
 #include <boost/program_options.hpp>
 
@@ -105,7 +107,9 @@ CommonOptions::CommonOptions(std::string _caption):
 		("enforce-via-yul", po::bool_switch(&enforceViaYul), "Enforce compiling all tests via yul to see if additional tests can be activated.")
 		("abiencoderv1", po::bool_switch(&useABIEncoderV1), "enables abi encoder v1")
 		("show-messages", po::bool_switch(&showMessages), "enables message output")
-		("show-metadata", po::bool_switch(&showMetadata), "enables metadata output");
+		("show-metadata", po::bool_switch(&showMetadata), "enables metadata output")
+		("compilation-cache", po::value<fs::path>(&compilationCache), "directory to keep the compiled contracts in between runs. Every build of the test binary uses its own entries.")
+		("shard", po::value(&shardString), "index/count: only runs the tests of the given shard (counted from zero) of count shards. The tests are assigned to the shards by the hash of their path.");
 }
 
 void CommonOptions::validate() const
@@ -120,6 +124,11 @@ void CommonOptions::validate() const
 		ConfigException,
 		"Invalid test path specified."
 	);
+	assertThrow(
+		shardIndex < shardCount,
+		ConfigException,
+		"Invalid shard specified. The shard index has to be less than the number of shards."
+	);
 
 }
 
@@ -148,6 +157,32 @@ bool CommonOptions::parse(int argc, char const* const* argv)
 			BOOST_THROW_EXCEPTION(std::runtime_error(errorMessage.str()));
 		}
 
+	if (!shardString.empty())
+	{
+		std::smatch match;
+		if (!std::regex_match(shardString, match, std::regex{"([0-9]+)/([1-9][0-9]*)"}))
+			BOOST_THROW_EXCEPTION(std::runtime_error("Invalid shard: " + shardString + ". Expected index/count."));
+		shardIndex = std::stoul(match[1].str());
+		shardCount = std::stoul(match[2].str());
+	}
+
+	if (!compilationCache.empty())
+	{
+		// The compiler version does not change with local modifications, so the cache entries are
+		// kept per build of the executable, which is identified by its size and modification time.
+		fs::path const executable = fs::system_complete(argv[0]);
+		boost::system::error_code sizeError;
+		boost::system::error_code timeError;
+		uintmax_t const size = fs::file_size(executable, sizeError);
+		time_t const modificationTime = fs::last_write_time(executable, timeError);
+		if (sizeError || timeError)
+			BOOST_THROW_EXCEPTION(std::runtime_error(
+				"Could not identify the build of " + executable.string() + " for the compilation cache."
+			));
+		std::string const build = std::to_string(size) + ":" + std::to_string(modificationTime);
+		compilationCache /= util::keccak256(build).hex().substr(0, 16);
+	}
+
 	if (vmPaths.empty())
 	{
 		std::string evmone = envOrDefaultPath("ETH_EVMONE", evmoneFilename);
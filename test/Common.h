@@ -60,6 +60,12 @@ struct CommonOptions: boost::noncopyable
 	bool useABIEncoderV1 = false;
 	bool showMessages = false;
 	bool showMetadata = false;
+	/// Index of the shard of the tests to run and number of shards, selected via "--shard index/count".
+	size_t shardIndex = 0;
+	size_t shardCount = 1;
+	/// Directory of the cache of the code generation outputs shared by runs of the same test binary,
+	/// empty if the contracts are always compiled.
+	boost::filesystem::path compilationCache;
 
 	langutil::EVMVersion evmVersion() const;
 
@@ -78,6 +84,7 @@ protected:
 
 private:
 	std::string evmVersionString;
+	std::string shardString;
 	static std::unique_ptr<CommonOptions const> m_singleton;
 };
 
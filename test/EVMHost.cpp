@@ -22,6 +22,7 @@
 
 #include <test/EVMHost.h>
 
+#include <test/EVMProfiler.h>
 #include <test/evmc/loader.h>
 
 #include <libevmasm/GasMeter.h>
@@ -39,8 +40,9 @@ using namespace evmc::literals;
 
 evmc::VM& EVMHost::getVM(string const& _path)
 {
-	static evmc::VM NullVM{nullptr};
-	static map<string, unique_ptr<evmc::VM>> vms;
+	// Every thread uses its own instances of the VMs, so that tests can run concurrently.
+	thread_local evmc::VM NullVM{nullptr};
+	thread_local map<string, unique_ptr<evmc::VM>> vms;
 	if (vms.count(_path) == 0)
 	{
 		evmc_loader_error_code errorCode = {};
@@ -183,6 +185,17 @@ evmc::result EVMHost::call(evmc_message const& _message) noexcept
 	else if (_message.destination == 0x0000000000000000000000000000000000000008_address && m_evmVersion >= langutil::EVMVersion::byzantium())
 		return precompileALTBN128PairingProduct(_message);
 
+	if (m_profiler && !m_profiling && _message.depth == 0)
+	{
+		// The state changes of the profiled execution are reverted, so that differences
+		// between the profiler and the VM do not affect the actual execution.
+		Snapshot const state = snapshot();
+		m_profiling = true;
+		call(_message);
+		m_profiling = false;
+		restore(state);
+	}
+
 	auto const stateBackup = accounts;
 
 	u256 value{convertFromEVMC(_message.value)};
@@ -261,7 +274,10 @@ evmc::result EVMHost::call(evmc_message const& _message) noexcept
 
 	evmc::address currentAddress = m_currentAddress;
 	m_currentAddress = message.destination;
-	evmc::result result = m_vm.execute(*this, m_evmRevision, message, code.data(), code.size());
+	evmc::result result =
+		m_profiling ?
+		m_profiler->execute(*this, message, code.data(), code.size()) :
+		m_vm.execute(*this, m_evmRevision, message, code.data(), code.size());
 	m_currentAddress = currentAddress;
 
 	if (message.kind == EVMC_CREATE || message.kind == EVMC_CREATE2)
@@ -350,7 +366,7 @@ evmc::result EVMHost::precompileECRecover(evmc_message const& _message) noexcept
 evmc::result EVMHost::precompileSha256(evmc_message const& _message) noexcept
 {
 	// static data so that we do not need a release routine...
-	bytes static hash;
+	bytes thread_local hash;
 	hash = picosha2::hash256(bytes(
 		_message.input_data,
 		_message.input_data + _message.input_size
@@ -432,7 +448,7 @@ evmc::result EVMHost::precompileRipeMD160(evmc_message const& _message) noexcept
 evmc::result EVMHost::precompileIdentity(evmc_message const& _message) noexcept
 {
 	// static data so that we do not need a release routine...
-	bytes static data;
+	bytes thread_local data;
 	data = bytes(_message.input_data, _message.input_data + _message.input_size);
 	evmc::result result({});
 	result.gas_left = _message.gas;
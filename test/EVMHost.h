@@ -36,6 +36,8 @@ namespace solidity::test
 {
 using Address = util::h160;
 
+class EVMProfiler;
+
 class EVMHost: public evmc::MockedHost
 {
 public:
@@ -43,6 +45,7 @@ public:
 	using MockedHost::get_balance;
 
 	/// Tries to dynamically load an evmc vm supporting evm1 or ewasm and caches the loaded VM.
+	/// The VMs are loaded and cached per thread.
 	/// @returns vmc::VM(nullptr) on failure.
 	static evmc::VM& getVM(std::string const& _path = {});
 
@@ -52,9 +55,30 @@ public:
 	/// @returns true, if an evmc vm was supporting evm1 loaded properly.
 	static bool checkVmPaths(std::vector<boost::filesystem::path> const& _vmPaths);
 
+	/// The state of the accounts and of the chain, which calls can be made on repeatedly by
+	/// restoring it, e.g. instead of deploying the same contracts again.
+	struct Snapshot
+	{
+		std::unordered_map<evmc::address, evmc::MockedAccount> accounts;
+		evmc_tx_context txContext;
+		std::vector<log_record> logs;
+		evmc::address currentAddress;
+	};
+
 	explicit EVMHost(langutil::EVMVersion _evmVersion, evmc::VM& _vm);
 
 	void reset();
+	/// @returns a copy of the current state. The copy is cheap compared to a deployment,
+	/// because tests only create a few accounts.
+	Snapshot snapshot() const { return {accounts, tx_context, recorded_logs, m_currentAddress}; }
+	/// Replaces the current state by @a _snapshot. The calls recorded since are kept.
+	void restore(Snapshot const& _snapshot)
+	{
+		accounts = _snapshot.accounts;
+		tx_context = _snapshot.txContext;
+		recorded_logs = _snapshot.logs;
+		m_currentAddress = _snapshot.currentAddress;
+	}
 	void newBlock()
 	{
 		tx_context.block_number++;
@@ -78,6 +102,10 @@ public:
 	static util::h256 convertFromEVMC(evmc::bytes32 const& _data);
 	static evmc::bytes32 convertToEVMC(util::h256 const& _data);
 
+	/// Makes every transaction execute in @a _profiler on a copy of the state before its actual
+	/// execution. Profiling is disabled if @a _profiler is nullptr.
+	void setProfiler(EVMProfiler* _profiler) { m_profiler = _profiler; }
+
 	/// @returns true, if the evmc VM has the given capability.
 	bool hasCapability(evmc_capabilities capability) const noexcept
 	{
@@ -101,6 +129,9 @@ private:
 	static evmc::result resultWithGas(evmc_message const& _message, bytes const& _data) noexcept;
 
 	evmc::VM& m_vm;
+	EVMProfiler* m_profiler = nullptr;
+	/// Whether messages are currently executed by the profiler.
+	bool m_profiling = false;
 	// EVM version requested by the testing tool
 	langutil::EVMVersion m_evmVersion;
 	// EVM version requested from EVMC (matches the above)
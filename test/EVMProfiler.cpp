@@ -0,0 +1,1007 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Gas profiler that executes EVM code instruction by instruction and attributes the executed
+ * instructions and their gas to source locations.
+ */
+
+#include <test/EVMProfiler.h>
+
+#include <libevmasm/GasMeter.h>
+#include <libevmasm/Instruction.h>
+
+#include <libsolutil/Assertions.h>
+#include <libsolutil/CommonData.h>
+#include <libsolutil/Keccak256.h>
+
+#include <boost/algorithm/string/split.hpp>
+
+#include <array>
+#include <optional>
+#include <ostream>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::evmasm;
+using namespace solidity::test;
+using namespace solidity::util;
+
+namespace
+{
+
+struct OpcodeInfo
+{
+	bool valid = false;
+	unsigned args = 0;
+	unsigned ret = 0;
+	Tier tier = Tier::Invalid;
+};
+
+array<OpcodeInfo, 256> const& opcodeInfos()
+{
+	static array<OpcodeInfo, 256> const infos = []() {
+		array<OpcodeInfo, 256> result;
+		for (size_t i = 0; i < result.size(); ++i)
+			if (isValidInstruction(Instruction(i)))
+			{
+				InstructionInfo info = instructionInfo(Instruction(i));
+				result[i] = {true, static_cast<unsigned>(info.args), static_cast<unsigned>(info.ret), info.gasPriceTier};
+			}
+		return result;
+	}();
+	return infos;
+}
+
+u256 toU256(evmc::bytes32 const& _value)
+{
+	return fromBigEndian<u256>(bytesConstRef(_value.bytes, sizeof(_value.bytes)));
+}
+
+u256 toU256(evmc::address const& _address)
+{
+	return fromBigEndian<u256>(bytesConstRef(_address.bytes, sizeof(_address.bytes)));
+}
+
+evmc::bytes32 toBytes32(u256 const& _value)
+{
+	evmc::bytes32 result;
+	bytesRef data(result.bytes, sizeof(result.bytes));
+	toBigEndian(_value, data);
+	return result;
+}
+
+evmc::address toAddress(u256 const& _value)
+{
+	evmc::address result;
+	bytesRef data(result.bytes, sizeof(result.bytes));
+	toBigEndian(u160(_value & ((u256(1) << 160) - 1)), data);
+	return result;
+}
+
+/// @returns the gas costs of @a _words words of memory.
+int64_t memoryCost(uint64_t _words)
+{
+	return static_cast<int64_t>(GasCosts::memoryGas * _words + _words * _words / GasCosts::quadCoeffDiv);
+}
+
+/// State of the execution of a single message.
+class Execution
+{
+public:
+	Execution(
+		langutil::EVMVersion _evmVersion,
+		evmc::HostInterface& _host,
+		evmc_message const& _message,
+		uint8_t const* _code,
+		size_t _codeSize,
+		function<evmc::result(evmc_message const&)> _call
+	):
+		gas(_message.gas),
+		m_evmVersion(_evmVersion),
+		m_host(_host),
+		m_message(_message),
+		m_code(_code),
+		m_codeSize(_codeSize),
+		m_call(move(_call)),
+		m_jumpDests(_codeSize, false)
+	{
+		for (size_t offset = 0; offset < m_codeSize; ++offset)
+			if (Instruction(m_code[offset]) == Instruction::JUMPDEST)
+				m_jumpDests[offset] = true;
+			else if (isPushInstruction(Instruction(m_code[offset])))
+				offset += getPushNumber(Instruction(m_code[offset]));
+	}
+
+	/// Executes the instruction at the current offset.
+	/// @returns the status if the execution ended.
+	optional<evmc_status_code> step();
+
+	size_t offset = 0;
+	int64_t gas = 0;
+	/// Gas used by the messages sent by the last instruction.
+	int64_t callGas = 0;
+	bytes output;
+
+private:
+	optional<evmc_status_code> fail(evmc_status_code _status)
+	{
+		gas = 0;
+		output.clear();
+		return _status;
+	}
+	bool charge(u256 const& _amount)
+	{
+		if (_amount > u256(gas))
+		{
+			gas = -1;
+			return false;
+		}
+		gas -= static_cast<int64_t>(_amount);
+		return true;
+	}
+	/// Charges for and expands the memory to include @a _size bytes from @a _offset.
+	bool expandMemory(u256 const& _offset, u256 const& _size)
+	{
+		if (_size == 0)
+			return true;
+		if (_offset > 0xffffffff || _size > 0xffffffff)
+			return charge(u256(gas) + 1);
+		uint64_t const words = (static_cast<uint64_t>(_offset + _size) + 31) / 32;
+		if (words * 32 <= m_memory.size())
+			return true;
+		if (!charge(u256(memoryCost(words) - memoryCost(m_memory.size() / 32))))
+			return false;
+		m_memory.resize(words * 32);
+		return true;
+	}
+	/// @returns the cost of copying @a _size bytes.
+	static u256 copyCost(u256 const& _size)
+	{
+		return GasCosts::copyGas * ((_size + 31) / 32);
+	}
+	/// Copies @a _size bytes of @a _data from @a _dataOffset to the memory at @a _offset,
+	/// padded with zeros.
+	void copyToMemory(u256 const& _offset, bytesConstRef _data, u256 const& _dataOffset, u256 const& _size)
+	{
+		size_t const size = static_cast<size_t>(_size);
+		size_t const offset = static_cast<size_t>(_offset);
+		for (size_t i = 0; i < size; ++i)
+			m_memory[offset + i] = _dataOffset + i < _data.size() ? _data[static_cast<size_t>(_dataOffset) + i] : 0;
+	}
+	u256 pop()
+	{
+		u256 value = move(m_stack.back());
+		m_stack.pop_back();
+		return value;
+	}
+	void push(u256 _value) { m_stack.emplace_back(move(_value)); }
+	bool isStatic() const { return m_message.flags & EVMC_STATIC; }
+	optional<evmc_status_code> create(Instruction _instruction);
+	optional<evmc_status_code> call(Instruction _instruction);
+
+	langutil::EVMVersion m_evmVersion;
+	evmc::HostInterface& m_host;
+	evmc_message const& m_message;
+	uint8_t const* m_code;
+	size_t m_codeSize;
+	function<evmc::result(evmc_message const&)> m_call;
+	vector<bool> m_jumpDests;
+	vector<u256> m_stack;
+	bytes m_memory;
+	bytes m_returnData;
+};
+
+optional<evmc_status_code> Execution::step()
+{
+	callGas = 0;
+	if (offset >= m_codeSize)
+		return EVMC_SUCCESS;
+
+	Instruction const instruction = Instruction(m_code[offset]);
+	OpcodeInfo const& info = opcodeInfos()[m_code[offset]];
+	if (!info.valid || !m_evmVersion.hasOpcode(instruction))
+		return fail(instruction == Instruction::INVALID ? EVMC_INVALID_INSTRUCTION : EVMC_UNDEFINED_INSTRUCTION);
+	if (m_stack.size() < info.args)
+		return fail(EVMC_STACK_UNDERFLOW);
+	if (m_stack.size() - info.args + info.ret > GasCosts::stackLimit)
+		return fail(EVMC_STACK_OVERFLOW);
+
+	switch (info.tier)
+	{
+	case Tier::Zero: break;
+	case Tier::Base: charge(GasCosts::tier1Gas); break;
+	case Tier::VeryLow: charge(GasCosts::tier2Gas); break;
+	case Tier::Low: charge(GasCosts::tier3Gas); break;
+	case Tier::Mid: charge(GasCosts::tier4Gas); break;
+	case Tier::High: charge(GasCosts::tier5Gas); break;
+	case Tier::Ext: charge(GasCosts::tier6Gas); break;
+	case Tier::ExtCode: charge(GasCosts::extCodeGas(m_evmVersion)); break;
+	case Tier::Balance: charge(GasCosts::balanceGas(m_evmVersion)); break;
+	case Tier::Special:
+	case Tier::Invalid:
+		break;
+	}
+	if (gas < 0)
+		return fail(EVMC_OUT_OF_GAS);
+
+	size_t next = offset + 1;
+	if (isPushInstruction(instruction))
+	{
+		unsigned const size = getPushNumber(instruction);
+		u256 value;
+		for (size_t i = 0; i < size; ++i)
+			value = (value << 8) | (offset + 1 + i < m_codeSize ? m_code[offset + 1 + i] : 0);
+		push(move(value));
+		offset += 1 + size;
+		return nullopt;
+	}
+	else if (isDupInstruction(instruction))
+	{
+		push(m_stack[m_stack.size() - getDupNumber(instruction)]);
+		offset = next;
+		return nullopt;
+	}
+	else if (isSwapInstruction(instruction))
+	{
+		swap(m_stack.back(), m_stack[m_stack.size() - 1 - getSwapNumber(instruction)]);
+		offset = next;
+		return nullopt;
+	}
+	else if (isLogInstruction(instruction))
+	{
+		if (isStatic())
+			return fail(EVMC_STATIC_MODE_VIOLATION);
+		u256 const memoryOffset = pop();
+		u256 const size = pop();
+		vector<evmc::bytes32> topics;
+		for (unsigned i = 0; i < getLogNumber(instruction); ++i)
+			topics.emplace_back(toBytes32(pop()));
+		if (
+			!charge(GasCosts::logGas + GasCosts::logTopicGas * topics.size()) ||
+			!expandMemory(memoryOffset, size) ||
+			!charge(GasCosts::logDataGas * size)
+		)
+			return fail(EVMC_OUT_OF_GAS);
+		m_host.emit_log(
+			m_message.destination,
+			size == 0 ? nullptr : m_memory.data() + static_cast<size_t>(memoryOffset),
+			static_cast<size_t>(size),
+			topics.data(),
+			topics.size()
+		);
+		offset = next;
+		return nullopt;
+	}
+
+	switch (instruction)
+	{
+	case Instruction::STOP:
+		return EVMC_SUCCESS;
+	case Instruction::ADD:
+	{
+		u256 a = pop();
+		push(a + pop());
+		break;
+	}
+	case Instruction::MUL:
+	{
+		u256 a = pop();
+		push(a * pop());
+		break;
+	}
+	case Instruction::SUB:
+	{
+		u256 a = pop();
+		push(a - pop());
+		break;
+	}
+	case Instruction::DIV:
+	{
+		u256 a = pop();
+		u256 b = pop();
+		push(b == 0 ? 0 : a / b);
+		break;
+	}
+	case Instruction::SDIV:
+	{
+		u256 a = pop();
+		u256 b = pop();
+		push(b == 0 ? 0 : s2u(u2s(a) / u2s(b)));
+		break;
+	}
+	case Instruction::MOD:
+	{
+		u256 a = pop();
+		u256 b = pop();
+		push(b == 0 ? 0 : a % b);
+		break;
+	}
+	case Instruction::SMOD:
+	{
+		u256 a = pop();
+		u256 b = pop();
+		push(b == 0 ? 0 : s2u(u2s(a) % u2s(b)));
+		break;
+	}
+	case Instruction::ADDMOD:
+	case Instruction::MULMOD:
+	{
+		bigint a(pop());
+		bigint b(pop());
+		bigint n(pop());
+		bigint const result = instruction == Instruction::ADDMOD ? bigint(a + b) : bigint(a * b);
+		push(n == 0 ? 0 : u256(result % n));
+		break;
+	}
+	case Instruction::EXP:
+	{
+		u256 base = pop();
+		u256 exponent = pop();
+		unsigned const exponentBytes = exponent == 0 ? 0 : (boost::multiprecision::msb(exponent) / 8 + 1);
+		if (!charge(GasCosts::expGas + GasCosts::expByteGas(m_evmVersion) * exponentBytes))
+			return fail(EVMC_OUT_OF_GAS);
+		push(exp256(base, exponent));
+		break;
+	}
+	case Instruction::SIGNEXTEND:
+	{
+		u256 position = pop();
+		u256 value = pop();
+		if (position < 31)
+		{
+			unsigned const bit = static_cast<unsigned>(position) * 8 + 7;
+			u256 const mask = (u256(1) << bit) - 1;
+			value = boost::multiprecision::bit_test(value, bit) ? (value | ~mask) : (value & mask);
+		}
+		push(value);
+		break;
+	}
+	case Instruction::LT:
+	{
+		u256 a = pop();
+		push(a < pop() ? 1 : 0);
+		break;
+	}
+	case Instruction::GT:
+	{
+		u256 a = pop();
+		push(a > pop() ? 1 : 0);
+		break;
+	}
+	case Instruction::SLT:
+	{
+		u256 a = pop();
+		push(u2s(a) < u2s(pop()) ? 1 : 0);
+		break;
+	}
+	case Instruction::SGT:
+	{
+		u256 a = pop();
+		push(u2s(a) > u2s(pop()) ? 1 : 0);
+		break;
+	}
+	case Instruction::EQ:
+	{
+		u256 a = pop();
+		push(a == pop() ? 1 : 0);
+		break;
+	}
+	case Instruction::ISZERO:
+		push(pop() == 0 ? 1 : 0);
+		break;
+	case Instruction::AND:
+	{
+		u256 a = pop();
+		push(a & pop());
+		break;
+	}
+	case Instruction::OR:
+	{
+		u256 a = pop();
+		push(a | pop());
+		break;
+	}
+	case Instruction::XOR:
+	{
+		u256 a = pop();
+		push(a ^ pop());
+		break;
+	}
+	case Instruction::NOT:
+		push(~pop());
+		break;
+	case Instruction::BYTE:
+	{
+		u256 position = pop();
+		u256 value = pop();
+		push(position < 32 ? (value >> (8 * (31 - static_cast<unsigned>(position)))) & 0xff : 0);
+		break;
+	}
+	case Instruction::SHL:
+	case Instruction::SHR:
+	case Instruction::SAR:
+	{
+		u256 shift = pop();
+		u256 value = pop();
+		bool const negative = instruction == Instruction::SAR && boost::multiprecision::bit_test(value, 255);
+		if (shift >= 256)
+			push(negative ? ~u256(0) : 0);
+		else if (instruction == Instruction::SHL)
+			push(value << static_cast<unsigned>(shift));
+		else if (negative)
+			push(~(~value >> static_cast<unsigned>(shift)));
+		else
+			push(value >> static_cast<unsigned>(shift));
+		break;
+	}
+	case Instruction::KECCAK256:
+	{
+		u256 memoryOffset = pop();
+		u256 size = pop();
+		if (
+			!charge(GasCosts::keccak256Gas + GasCosts::keccak256WordGas * ((size + 31) / 32)) ||
+			!expandMemory(memoryOffset, size)
+		)
+			return fail(EVMC_OUT_OF_GAS);
+		h256 hash = keccak256(
+			size == 0 ?
+			bytesConstRef() :
+			bytesConstRef(m_memory.data() + static_cast<size_t>(memoryOffset), static_cast<size_t>(size))
+		);
+		push(fromBigEndian<u256>(hash.ref()));
+		break;
+	}
+	case Instruction::ADDRESS:
+		push(toU256(m_message.destination));
+		break;
+	case Instruction::BALANCE:
+		push(toU256(m_host.get_balance(toAddress(pop()))));
+		break;
+	case Instruction::ORIGIN:
+		push(toU256(m_host.get_tx_context().tx_origin));
+		break;
+	case Instruction::CALLER:
+		push(toU256(m_message.sender));
+		break;
+	case Instruction::CALLVALUE:
+		push(toU256(m_message.value));
+		break;
+	case Instruction::CALLDATALOAD:
+	{
+		u256 dataOffset = pop();
+		u256 value;
+		for (size_t i = 0; i < 32; ++i)
+			value = (value << 8) | (dataOffset + i < m_message.input_size ? m_message.input_data[static_cast<size_t>(dataOffset) + i] : 0);
+		push(value);
+		break;
+	}
+	case Instruction::CALLDATASIZE:
+		push(m_message.input_size);
+		break;
+	case Instruction::CODESIZE:
+		push(m_codeSize);
+		break;
+	case Instruction::CALLDATACOPY:
+	case Instruction::CODECOPY:
+	case Instruction::RETURNDATACOPY:
+	{
+		u256 memoryOffset = pop();
+		u256 dataOffset = pop();
+		u256 size = pop();
+		bytesConstRef data =
+			instruction == Instruction::CALLDATACOPY ? bytesConstRef(m_message.input_data, m_message.input_size) :
+			instruction == Instruction::CODECOPY ? bytesConstRef(m_code, m_codeSize) :
+			bytesConstRef(&m_returnData);
+		if (instruction == Instruction::RETURNDATACOPY && dataOffset + size > data.size())
+			return fail(EVMC_INVALID_MEMORY_ACCESS);
+		if (!charge(copyCost(size)) || !expandMemory(memoryOffset, size))
+			return fail(EVMC_OUT_OF_GAS);
+		copyToMemory(memoryOffset, data, dataOffset, size);
+		break;
+	}
+	case Instruction::GASPRICE:
+		push(toU256(m_host.get_tx_context().tx_gas_price));
+		break;
+	case Instruction::EXTCODESIZE:
+		push(m_host.get_code_size(toAddress(pop())));
+		break;
+	case Instruction::EXTCODECOPY:
+	{
+		evmc::address address = toAddress(pop());
+		u256 memoryOffset = pop();
+		u256 dataOffset = pop();
+		u256 size = pop();
+		if (!charge(copyCost(size)) || !expandMemory(memoryOffset, size))
+			return fail(EVMC_OUT_OF_GAS);
+		bytes code(m_host.get_code_size(address));
+		m_host.copy_code(address, 0, code.data(), code.size());
+		copyToMemory(memoryOffset, bytesConstRef(&code), dataOffset, size);
+		break;
+	}
+	case Instruction::RETURNDATASIZE:
+		push(m_returnData.size());
+		break;
+	case Instruction::EXTCODEHASH:
+		push(toU256(m_host.get_code_hash(toAddress(pop()))));
+		break;
+	case Instruction::BLOCKHASH:
+	{
+		u256 number = pop();
+		int64_t const currentNumber = m_host.get_tx_context().block_number;
+		if (number < u256(currentNumber) && u256(currentNumber) - number <= 256)
+			push(toU256(m_host.get_block_hash(static_cast<int64_t>(number))));
+		else
+			push(0);
+		break;
+	}
+	case Instruction::COINBASE:
+		push(toU256(m_host.get_tx_context().block_coinbase));
+		break;
+	case Instruction::TIMESTAMP:
+		push(m_host.get_tx_context().block_timestamp);
+		break;
+	case Instruction::NUMBER:
+		push(m_host.get_tx_context().block_number);
+		break;
+	case Instruction::DIFFICULTY:
+		push(toU256(m_host.get_tx_context().block_difficulty));
+		break;
+	case Instruction::GASLIMIT:
+		push(m_host.get_tx_context().block_gas_limit);
+		break;
+	case Instruction::CHAINID:
+		push(toU256(m_host.get_tx_context().chain_id));
+		break;
+	case Instruction::SELFBALANCE:
+		push(toU256(m_host.get_balance(m_message.destination)));
+		break;
+	case Instruction::POP:
+		pop();
+		break;
+	case Instruction::MLOAD:
+	{
+		u256 memoryOffset = pop();
+		if (!expandMemory(memoryOffset, 32))
+			return fail(EVMC_OUT_OF_GAS);
+		push(fromBigEndian<u256>(bytesConstRef(m_memory.data() + static_cast<size_t>(memoryOffset), 32)));
+		break;
+	}
+	case Instruction::MSTORE:
+	case Instruction::MSTORE8:
+	{
+		u256 memoryOffset = pop();
+		u256 value = pop();
+		if (!expandMemory(memoryOffset, instruction == Instruction::MSTORE ? 32 : 1))
+			return fail(EVMC_OUT_OF_GAS);
+		if (instruction == Instruction::MSTORE)
+		{
+			bytesRef word(m_memory.data() + static_cast<size_t>(memoryOffset), 32);
+			toBigEndian(value, word);
+		}
+		else
+			m_memory[static_cast<size_t>(memoryOffset)] = static_cast<uint8_t>(value & 0xff);
+		break;
+	}
+	case Instruction::SLOAD:
+		if (!charge(GasCosts::sloadGas(m_evmVersion)))
+			return fail(EVMC_OUT_OF_GAS);
+		push(toU256(m_host.get_storage(m_message.destination, toBytes32(pop()))));
+		break;
+	case Instruction::SSTORE:
+	{
+		if (isStatic())
+			return fail(EVMC_STATIC_MODE_VIOLATION);
+		if (m_evmVersion >= langutil::EVMVersion::istanbul() && gas <= GasCosts::callStipend)
+			return fail(EVMC_OUT_OF_GAS);
+		evmc::bytes32 key = toBytes32(pop());
+		evmc::bytes32 value = toBytes32(pop());
+		evmc_storage_status status = m_host.set_storage(m_message.destination, key, value);
+		unsigned cost = GasCosts::sstoreResetGas;
+		if (status == EVMC_STORAGE_ADDED)
+			cost = GasCosts::sstoreSetGas;
+		else if (
+			m_evmVersion >= langutil::EVMVersion::istanbul() &&
+			(status == EVMC_STORAGE_UNCHANGED || status == EVMC_STORAGE_MODIFIED_AGAIN)
+		)
+			cost = GasCosts::sloadGas(m_evmVersion);
+		if (!charge(cost))
+			return fail(EVMC_OUT_OF_GAS);
+		break;
+	}
+	case Instruction::JUMP:
+	case Instruction::JUMPI:
+	{
+		u256 target = pop();
+		if (instruction == Instruction::JUMPI && pop() == 0)
+			break;
+		if (target >= m_codeSize || !m_jumpDests[static_cast<size_t>(target)])
+			return fail(EVMC_BAD_JUMP_DESTINATION);
+		next = static_cast<size_t>(target);
+		break;
+	}
+	case Instruction::PC:
+		push(offset);
+		break;
+	case Instruction::MSIZE:
+		push(m_memory.size());
+		break;
+	case Instruction::GAS:
+		push(gas);
+		break;
+	case Instruction::JUMPDEST:
+		charge(GasCosts::jumpdestGas);
+		break;
+	case Instruction::CREATE:
+	case Instruction::CREATE2:
+		if (auto status = create(instruction))
+			return status;
+		break;
+	case Instruction::CALL:
+	case Instruction::CALLCODE:
+	case Instruction::DELEGATECALL:
+	case Instruction::STATICCALL:
+		if (auto status = call(instruction))
+			return status;
+		break;
+	case Instruction::RETURN:
+	case Instruction::REVERT:
+	{
+		u256 memoryOffset = pop();
+		u256 size = pop();
+		if (!expandMemory(memoryOffset, size))
+			return fail(EVMC_OUT_OF_GAS);
+		if (size != 0)
+			output = bytes(
+				m_memory.begin() + static_cast<ptrdiff_t>(memoryOffset),
+				m_memory.begin() + static_cast<ptrdiff_t>(memoryOffset + size)
+			);
+		return instruction == Instruction::RETURN ? EVMC_SUCCESS : EVMC_REVERT;
+	}
+	case Instruction::INVALID:
+		return fail(EVMC_INVALID_INSTRUCTION);
+	case Instruction::SELFDESTRUCT:
+	{
+		if (isStatic())
+			return fail(EVMC_STATIC_MODE_VIOLATION);
+		evmc::address beneficiary = toAddress(pop());
+		unsigned cost = GasCosts::selfdestructGas(m_evmVersion);
+		if (m_evmVersion >= langutil::EVMVersion::tangerineWhistle() && !m_host.account_exists(beneficiary))
+			if (
+				m_evmVersion < langutil::EVMVersion::spuriousDragon() ||
+				toU256(m_host.get_balance(m_message.destination)) != 0
+			)
+				cost += GasCosts::callNewAccountGas;
+		if (!charge(cost))
+			return fail(EVMC_OUT_OF_GAS);
+		m_host.selfdestruct(m_message.destination, beneficiary);
+		return EVMC_SUCCESS;
+	}
+	default:
+		return fail(EVMC_UNDEFINED_INSTRUCTION);
+	}
+
+	if (gas < 0)
+		return fail(EVMC_OUT_OF_GAS);
+	offset = next;
+	return nullopt;
+}
+
+optional<evmc_status_code> Execution::create(Instruction _instruction)
+{
+	if (isStatic())
+		return fail(EVMC_STATIC_MODE_VIOLATION);
+	u256 value = pop();
+	u256 memoryOffset = pop();
+	u256 size = pop();
+	evmc::bytes32 salt{};
+	if (_instruction == Instruction::CREATE2)
+		salt = toBytes32(pop());
+	if (
+		!charge(GasCosts::createGas) ||
+		!expandMemory(memoryOffset, size) ||
+		(_instruction == Instruction::CREATE2 && !charge(GasCosts::keccak256WordGas * ((size + 31) / 32)))
+	)
+		return fail(EVMC_OUT_OF_GAS);
+
+	m_returnData.clear();
+	if (m_message.depth >= 1024 || value > toU256(m_host.get_balance(m_message.destination)))
+	{
+		push(0);
+		return nullopt;
+	}
+
+	evmc_message message{};
+	message.kind = _instruction == Instruction::CREATE ? EVMC_CREATE : EVMC_CREATE2;
+	message.depth = m_message.depth + 1;
+	message.gas = m_evmVersion >= langutil::EVMVersion::tangerineWhistle() ? gas - gas / 64 : gas;
+	message.sender = m_message.destination;
+	message.input_data = size == 0 ? nullptr : m_memory.data() + static_cast<size_t>(memoryOffset);
+	message.input_size = static_cast<size_t>(size);
+	message.value = toBytes32(value);
+	message.create2_salt = salt;
+
+	evmc::result result = m_call(message);
+	callGas = message.gas - result.gas_left;
+	gas -= callGas;
+	if (result.status_code == EVMC_REVERT)
+		m_returnData = bytes(result.output_data, result.output_data + result.output_size);
+	push(result.status_code == EVMC_SUCCESS ? toU256(result.create_address) : 0);
+	return nullopt;
+}
+
+optional<evmc_status_code> Execution::call(Instruction _instruction)
+{
+	u256 requestedGas = pop();
+	evmc::address address = toAddress(pop());
+	u256 value = 0;
+	if (_instruction == Instruction::CALL || _instruction == Instruction::CALLCODE)
+		value = pop();
+	u256 inputOffset = pop();
+	u256 inputSize = pop();
+	u256 outputOffset = pop();
+	u256 outputSize = pop();
+
+	if (_instruction == Instruction::CALL && value != 0 && isStatic())
+		return fail(EVMC_STATIC_MODE_VIOLATION);
+
+	u256 cost = GasCosts::callGas(m_evmVersion);
+	if (value != 0)
+		cost += GasCosts::callValueTransferGas;
+	if (
+		_instruction == Instruction::CALL &&
+		(value != 0 || m_evmVersion < langutil::EVMVersion::spuriousDragon()) &&
+		!m_host.account_exists(address)
+	)
+		cost += GasCosts::callNewAccountGas;
+	if (!charge(cost) || !expandMemory(inputOffset, inputSize) || !expandMemory(outputOffset, outputSize))
+		return fail(EVMC_OUT_OF_GAS);
+
+	int64_t forwardedGas = 0;
+	if (m_evmVersion >= langutil::EVMVersion::tangerineWhistle())
+		forwardedGas = static_cast<int64_t>(min(requestedGas, u256(gas - gas / 64)));
+	else if (requestedGas > u256(gas))
+		return fail(EVMC_OUT_OF_GAS);
+	else
+		forwardedGas = static_cast<int64_t>(requestedGas);
+	gas -= forwardedGas;
+
+	m_returnData.clear();
+	if (value != 0)
+		forwardedGas += GasCosts::callStipend;
+	if (m_message.depth >= 1024 || (value != 0 && value > toU256(m_host.get_balance(m_message.destination))))
+	{
+		gas += forwardedGas;
+		push(0);
+		return nullopt;
+	}
+
+	evmc_message message{};
+	message.kind =
+		_instruction == Instruction::CALLCODE ? EVMC_CALLCODE :
+		_instruction == Instruction::DELEGATECALL ? EVMC_DELEGATECALL :
+		EVMC_CALL;
+	message.flags = _instruction == Instruction::STATICCALL ? uint32_t(EVMC_STATIC) : m_message.flags;
+	message.depth = m_message.depth + 1;
+	message.gas = forwardedGas;
+	message.destination = address;
+	message.sender = _instruction == Instruction::DELEGATECALL ? m_message.sender : m_message.destination;
+	message.value = _instruction == Instruction::DELEGATECALL ? m_message.value : toBytes32(value);
+	message.input_data = inputSize == 0 ? nullptr : m_memory.data() + static_cast<size_t>(inputOffset);
+	message.input_size = static_cast<size_t>(inputSize);
+
+	evmc::result result = m_call(message);
+	callGas = forwardedGas - result.gas_left;
+	gas += result.gas_left;
+	m_returnData = bytes(result.output_data, result.output_data + result.output_size);
+	copyToMemory(outputOffset, bytesConstRef(&m_returnData), 0, min(outputSize, u256(m_returnData.size())));
+	push(result.status_code == EVMC_SUCCESS ? 1 : 0);
+	return nullopt;
+}
+
+}
+
+EVMProfiler::EVMProfiler(langutil::EVMVersion _evmVersion):
+	m_evmVersion(_evmVersion)
+{
+}
+
+void EVMProfiler::addCode(
+	string _name,
+	bytes _code,
+	string const& _sourceMap,
+	Labeler const& _line,
+	Labeler const& _function,
+	bool _prefix,
+	vector<size_t> const& _ignoredBytes
+)
+{
+	Code code;
+	code.name = move(_name);
+	code.prefix = _prefix;
+	code.ignored.resize(_code.size(), false);
+	for (size_t offset: _ignoredBytes)
+		if (offset < _code.size())
+			code.ignored[offset] = true;
+	code.lines.resize(_code.size());
+	code.functions.resize(_code.size());
+	code.jumpTypes.resize(_code.size(), '-');
+
+	// Fields of the items of the source map that are empty repeat those of the previous item.
+	vector<string> items;
+	boost::split(items, _sourceMap, [](char _c) { return _c == ';'; });
+	array<string, 4> fields{"-1", "-1", "-1", "-"};
+	size_t offset = 0;
+	map<array<string, 4>, pair<string, string>> names;
+	for (string const& item: items)
+	{
+		if (offset >= _code.size())
+			break;
+		vector<string> itemFields;
+		boost::split(itemFields, item, [](char _c) { return _c == ':'; });
+		for (size_t i = 0; i < fields.size() && i < itemFields.size(); ++i)
+			if (!itemFields[i].empty())
+				fields[i] = itemFields[i];
+
+		array<string, 4> location = fields;
+		location[3].clear();
+		if (!names.count(location))
+		{
+			int const start = stoi(fields[0]);
+			int const end = start + stoi(fields[1]);
+			int const sourceIndex = stoi(fields[2]);
+			names[location] = sourceIndex < 0 ?
+				pair<string, string>{} :
+				pair<string, string>{_line(sourceIndex, start, end), _function(sourceIndex, start, end)};
+		}
+		tie(code.lines[offset], code.functions[offset]) = names[location];
+		code.jumpTypes[offset] = fields[3].empty() ? '-' : fields[3][0];
+
+		Instruction const instruction = Instruction(_code[offset]);
+		offset += 1 + (isPushInstruction(instruction) ? getPushNumber(instruction) : 0);
+	}
+	code.code = move(_code);
+	m_codes.emplace_back(move(code));
+	m_codeIndices.clear();
+}
+
+evmc::result EVMProfiler::execute(
+	evmc::HostInterface& _host,
+	evmc_message const& _message,
+	uint8_t const* _code,
+	size_t _codeSize
+)
+{
+	size_t const code = codeIndex(_code, _codeSize);
+	size_t const outerFramesSize = m_frames.size();
+	m_frames += (m_frames.empty() ? "" : ";") + m_codes[code].name;
+	/// Sizes of the frames when entering the functions that were not left yet.
+	vector<size_t> functionFrames;
+
+	Stack* stack = &currentStack(code);
+	Execution execution(m_evmVersion, _host, _message, _code, _codeSize, [&](evmc_message const& _callMessage) {
+		// Calls are attributed to the line they are made from.
+		size_t const framesSize = m_frames.size();
+		m_frames += ";" + lineName(code, execution.offset);
+		evmc::result result = _host.call(_callMessage);
+		m_frames.resize(framesSize);
+		return result;
+	});
+
+	optional<evmc_status_code> status;
+	while (!status)
+	{
+		size_t const offset = execution.offset;
+		int64_t const gas = execution.gas;
+		status = execution.step();
+
+		if (offset < stack->samples.size())
+		{
+			Sample& sample = stack->samples[offset];
+			sample.count++;
+			sample.gas += static_cast<uint64_t>(gas - max<int64_t>(execution.gas, 0) - execution.callGas);
+		}
+
+		char const jumpType = offset < m_codes[code].jumpTypes.size() ? m_codes[code].jumpTypes[offset] : '-';
+		if (!status && jumpType == 'i' && execution.offset != offset + 1)
+		{
+			functionFrames.push_back(m_frames.size());
+			vector<string> const& functions = m_codes[code].functions;
+			string const function = execution.offset < functions.size() ? functions[execution.offset] : string{};
+			m_frames += ";" + (function.empty() ? lineName(code, execution.offset) : function);
+			stack = &currentStack(code);
+		}
+		else if (!status && jumpType == 'o' && !functionFrames.empty())
+		{
+			m_frames.resize(functionFrames.back());
+			functionFrames.pop_back();
+			stack = &currentStack(code);
+		}
+	}
+
+	m_frames.resize(outerFramesSize);
+	bool const keepsGas = *status == EVMC_SUCCESS || *status == EVMC_REVERT;
+	return evmc::result(
+		*status,
+		keepsGas ? execution.gas : 0,
+		execution.output.data(),
+		execution.output.size()
+	);
+}
+
+map<string, EVMProfiler::Sample> EVMProfiler::samples() const
+{
+	map<string, Sample> result;
+	for (Stack const& stack: m_stacks)
+		for (size_t offset = 0; offset < stack.samples.size(); ++offset)
+			if (stack.samples[offset].count > 0)
+			{
+				Sample& sample = result[stack.frames + ";" + lineName(stack.code, offset)];
+				sample.count += stack.samples[offset].count;
+				sample.gas += stack.samples[offset].gas;
+			}
+	return result;
+}
+
+void EVMProfiler::writeFolded(ostream& _out, map<string, Sample> const& _samples, bool _counts)
+{
+	for (auto const& [frames, sample]: _samples)
+		_out << frames << " " << (_counts ? sample.count : sample.gas) << "\n";
+}
+
+size_t EVMProfiler::codeIndex(uint8_t const* _code, size_t _codeSize)
+{
+	h256 const hash = keccak256(bytesConstRef(_code, _codeSize));
+	if (m_codeIndices.count(hash))
+		return m_codeIndices.at(hash);
+
+	auto matches = [&](Code const& _registered) {
+		if (_registered.prefix ? _registered.code.size() > _codeSize : _registered.code.size() != _codeSize)
+			return false;
+		for (size_t i = 0; i < _registered.code.size(); ++i)
+			if (_registered.code[i] != _code[i] && !_registered.ignored[i])
+				return false;
+		return true;
+	};
+	size_t index = 0;
+	while (index < m_codes.size() && !matches(m_codes[index]))
+		++index;
+	if (index == m_codes.size())
+	{
+		Code code;
+		code.name = "code " + hash.hex().substr(0, 8);
+		code.code = bytes(_code, _code + _codeSize);
+		m_codes.emplace_back(move(code));
+	}
+	return m_codeIndices[hash] = index;
+}
+
+EVMProfiler::Stack& EVMProfiler::currentStack(size_t _code)
+{
+	auto [it, inserted] = m_stackIndices.emplace(m_frames, m_stacks.size());
+	if (inserted)
+		m_stacks.push_back({m_frames, _code, vector<Sample>(m_codes[_code].code.size())});
+	return m_stacks[it->second];
+}
+
+string EVMProfiler::lineName(size_t _code, size_t _offset) const
+{
+	Code const& code = m_codes[_code];
+	if (_offset < code.lines.size() && !code.lines[_offset].empty())
+		return code.lines[_offset];
+	return "offset " + to_string(_offset);
+}
@@ -0,0 +1,138 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Gas profiler that executes EVM code instruction by instruction and attributes the executed
+ * instructions and their gas to source locations.
+ */
+
+#pragma once
+
+#include <test/evmc/evmc.hpp>
+
+#include <liblangutil/EVMVersion.h>
+
+#include <libsolutil/Common.h>
+#include <libsolutil/FixedHash.h>
+
+#include <deque>
+#include <functional>
+#include <iosfwd>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace solidity::test
+{
+
+/**
+ * Profiler that records how often each instruction is executed and how much gas it uses,
+ * by call stack. Frames of the call stacks are the names of the executed code, the functions
+ * entered and left by jumps as marked in the source maps, and the source lines of calls to
+ * other contracts. The source lines of the instructions are the innermost frames.
+ *
+ * The EVMC virtual machines do not report the instructions they execute, so the profiler is
+ * a simple interpreter of its own, which the EVMHost runs on a copy of the state before the
+ * actual execution of each transaction. Gas costs follow the rules of the EVM version, but
+ * refunds are not taken into account, so the costs can differ slightly from the actual ones.
+ */
+class EVMProfiler
+{
+public:
+	struct Sample
+	{
+		uint64_t count = 0;
+		uint64_t gas = 0;
+	};
+
+	/// @returns the name of a source location of a source map, i.e. of the source with index
+	/// @a _sourceIndex from @a _start to @a _end, or an empty string if it has no name.
+	using Labeler = std::function<std::string(int _sourceIndex, int _start, int _end)>;
+
+	explicit EVMProfiler(langutil::EVMVersion _evmVersion);
+
+	/// Registers code, so that its samples are attributed to the locations in @a _sourceMap,
+	/// which is in the compressed format of the compiler output. Instructions are named by
+	/// @a _line and the functions they jump into by @a _function.
+	/// @param _prefix if true, the code also matches code that starts with it, e.g. creation
+	/// code followed by constructor arguments.
+	/// @param _ignoredBytes offsets of bytes that are ignored when matching, e.g. immutables.
+	void addCode(
+		std::string _name,
+		bytes _code,
+		std::string const& _sourceMap,
+		Labeler const& _line,
+		Labeler const& _function,
+		bool _prefix = false,
+		std::vector<size_t> const& _ignoredBytes = {}
+	);
+
+	/// Executes @a _message on @a _code and records the samples. Calls to other contracts go
+	/// through @a _host.
+	evmc::result execute(
+		evmc::HostInterface& _host,
+		evmc_message const& _message,
+		uint8_t const* _code,
+		size_t _codeSize
+	);
+
+	/// @returns the samples by call stack, with frames separated by ';'.
+	std::map<std::string, Sample> samples() const;
+
+	/// Writes @a _samples in the folded format of flamegraph.pl, i.e. one call stack per line
+	/// followed by its gas or, if @a _counts is true, by the number of executed instructions.
+	static void writeFolded(std::ostream& _out, std::map<std::string, Sample> const& _samples, bool _counts = false);
+
+private:
+	struct Code
+	{
+		std::string name;
+		bytes code;
+		bool prefix = false;
+		std::vector<bool> ignored;
+		/// Names of the source lines, of the functions and jump types ('i', 'o' or '-') by offset.
+		std::vector<std::string> lines;
+		std::vector<std::string> functions;
+		std::vector<char> jumpTypes;
+	};
+
+	/// Samples of the instructions of a code at a call stack, by offset.
+	struct Stack
+	{
+		std::string frames;
+		size_t code = 0;
+		std::vector<Sample> samples;
+	};
+
+	/// @returns the index of the registered code that matches @a _code, or of a new unnamed code.
+	size_t codeIndex(uint8_t const* _code, size_t _codeSize);
+	/// @returns the samples of the current frames executing the code with index @a _code.
+	Stack& currentStack(size_t _code);
+	/// @returns the name of the instruction at @a _offset of the code with index @a _code.
+	std::string lineName(size_t _code, size_t _offset) const;
+
+	langutil::EVMVersion m_evmVersion;
+	std::deque<Code> m_codes;
+	/// Indices of the codes by hash of the executed code.
+	std::map<util::h256, size_t> m_codeIndices;
+	std::deque<Stack> m_stacks;
+	std::map<std::string, size_t> m_stackIndices;
+	/// Frames of the current call stack, separated by ';'.
+	std::string m_frames;
+};
+
+}
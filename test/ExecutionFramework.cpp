@@ -76,9 +76,18 @@ void ExecutionFramework::selectVM(evmc_capabilities _cap)
 		}
 	}
 	solAssert(m_evmcHost != nullptr, "");
+	if (m_profiler && _cap == evmc_capabilities::EVMC_CAPABILITY_EVM1)
+		m_evmcHost->setProfiler(m_profiler.get());
 	reset();
 }
 
+void ExecutionFramework::enableProfiling()
+{
+	m_profiler = make_unique<EVMProfiler>(m_evmVersion);
+	if (m_evmcHost->hasCapability(evmc_capabilities::EVMC_CAPABILITY_EVM1))
+		m_evmcHost->setProfiler(m_profiler.get());
+}
+
 void ExecutionFramework::reset()
 {
 	m_evmcHost->reset();
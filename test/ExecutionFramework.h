@@ -25,6 +25,7 @@
 
 #include <test/Common.h>
 #include <test/EVMHost.h>
+#include <test/EVMProfiler.h>
 
 #include <libsolidity/interface/OptimiserSettings.h>
 #include <libsolidity/interface/DebugSettings.h>
@@ -258,6 +259,9 @@ private:
 protected:
 	void selectVM(evmc_capabilities _cap = evmc_capabilities::EVMC_CAPABILITY_EVM1);
 	void reset();
+	/// Makes the EVM execute all further transactions in a profiler, too, which records
+	/// the gas used by the code registered in m_profiler.
+	void enableProfiling();
 
 	void sendMessage(bytes const& _data, bool _isCreation, u256 const& _value = 0);
 	void sendEther(util::h160 const& _to, u256 const& _value);
@@ -283,6 +287,8 @@ protected:
 	bool m_showMessages = false;
 	bool m_supportsEwasm = false;
 	std::unique_ptr<EVMHost> m_evmcHost;
+	/// Profiler of the transactions if profiling is enabled, nullptr otherwise.
+	std::unique_ptr<EVMProfiler> m_profiler;
 
 	std::vector<boost::filesystem::path> m_vmPaths;
 
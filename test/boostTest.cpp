@@ -30,6 +30,8 @@
 #pragma warning(disable:4535) // calling _set_se_translator requires /EHa
 #endif
 #include <boost/test/unit_test.hpp>
+#include <boost/test/tree/traverse.hpp>
+#include <boost/test/tree/visitor.hpp>
 #if defined(_MSC_VER)
 #pragma warning(pop)
 #endif
@@ -40,6 +42,8 @@
 #include <test/Common.h>
 #include <test/EVMHost.h>
 
+#include <libsolutil/Keccak256.h>
+
 #include <boost/algorithm/string.hpp>
 #include <boost/algorithm/string/predicate.hpp>
 #include <boost/filesystem.hpp>
@@ -136,6 +140,32 @@ int registerTests(
 	return numTestsAdded;
 }
 
+/// Removes the test cases that do not belong to the shard @a _index of @a _count shards. The test
+/// cases are assigned to the shards by the hash of their full name, i.e. of their path in the
+/// tree of test suites, so that every shard (on any machine) runs the same tests.
+void selectShard(size_t _index, size_t _count)
+{
+	struct ShardFilter: test_tree_visitor
+	{
+		ShardFilter(size_t _index, size_t _count): index(_index), count(_count) {}
+		void visit(test_case const& _testCase) override
+		{
+			solidity::u256 hash{solidity::util::keccak256(_testCase.full_name())};
+			if (hash % count != index)
+				removed.push_back(&_testCase);
+		}
+
+		size_t index;
+		size_t count;
+		vector<test_case const*> removed;
+	};
+
+	ShardFilter filter{_index, _count};
+	traverse_test_tree(framework::master_test_suite(), filter, true);
+	for (test_case const* testCase: filter.removed)
+		framework::get<test_suite>(testCase->p_parent_id).remove(testCase->p_id);
+}
+
 void initializeOptions()
 {
 	auto const& suite = boost::unit_test::framework::master_test_suite();
@@ -209,6 +239,9 @@ test_suite* init_unit_test_suite( int /*argc*/, char* /*argv*/[] )
 			removeTestSuite(suite);
 	}
 
+	if (solidity::test::CommonOptions::get().shardCount > 1)
+		selectShard(solidity::test::CommonOptions::get().shardIndex, solidity::test::CommonOptions::get().shardCount);
+
 	return nullptr;
 }
 
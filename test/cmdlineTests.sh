@@ -475,6 +475,35 @@ SOLTMPDIR=$(mktemp -d)
     fi
 )
 
+printTask "Testing server mode..."
+(
+    set -e
+    request='{"language": "Solidity", "sources": {"A.sol": {"content": "pragma solidity >=0.0; contract C {}"}}, "settings": {"outputSelection": {"*": {"*": ["evm.bytecode.object"]}}}}'
+    output=$(printf '%d\n%s%d\n%s' "${#request}" "$request" "${#request}" "$request" | "$SOLC" --server)
+    if [[ $(echo "$output" | grep -c '"contracts"') != 2 ]]
+    then
+        printError "Incorrect response of the server: $output"
+        exit 1
+    fi
+
+    # A malformed length is an error.
+    ! echo 'x' | "$SOLC" --server &>/dev/null
+)
+
+printTask "Testing --time-passes..."
+(
+    set -e
+    report=$(echo 'pragma solidity >=0.0; contract C { function f() public {} }' | "$SOLC" - --bin --optimize --time-passes 2>&1 >/dev/null)
+    for phase in parsing analysis/typeChecker evmCodeGeneration "<stdin>:C (compilation statistics)"
+    do
+        if ! echo "$report" | grep -qF "$phase"
+        then
+            printError "Missing $phase in the report of --time-passes: $report"
+            exit 1
+        fi
+    done
+)
+
 printTask "Testing AST import..."
 SOLTMPDIR=$(mktemp -d)
 (
@@ -0,0 +1,136 @@
+#!/usr/bin/env bash
+
+# ------------------------------------------------------------------------------
+# This file is part of solidity.
+#
+# solidity is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# solidity is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with solidity.  If not, see <http://www.gnu.org/licenses/>
+#
+# (c) 2021 solidity contributors.
+#------------------------------------------------------------------------------
+# Compiles the projects of the external tests with solc-bench, which uses the standard JSON
+# interface of the compiler instead of the toolchains of the projects, and merges the results
+# into one report in the format of solc-bench.
+#
+# Environment variables:
+#   BENCHMARK_CACHE: directory the projects are checked out to and reused from
+#                    (default: ~/.cache/solidity-external-benchmarks)
+#   BENCHMARK_JOBS:  number of projects compiled at the same time (default: number of CPUs).
+#                    The times are more stable with 1.
+#   BENCHMARK_RUNS:  number of runs per project and configuration, of which the fastest is reported
+#------------------------------------------------------------------------------
+set -e
+
+if [ ! -x "$1" ]
+then
+    echo "Usage: $0 <path to solc-bench> [<report file>]"
+    exit 1
+fi
+
+SOLC_BENCH="$(realpath "$1")"
+REPORT="${2:-external-benchmarks.json}"
+CACHE="${BENCHMARK_CACHE:-$HOME/.cache/solidity-external-benchmarks}"
+JOBS="${BENCHMARK_JOBS:-$(nproc)}"
+RUNS="${BENCHMARK_RUNS:-1}"
+
+source scripts/common.sh
+
+# Name, repository and branch of the projects, the same as used by the external tests.
+PROJECTS=(
+    "zeppelin https://github.com/solidity-external-tests/openzeppelin-contracts.git master_080"
+    "gnosis https://github.com/solidity-external-tests/safe-contracts.git development_080"
+    "gnosis-v2 https://github.com/solidity-external-tests/safe-contracts.git v2_080"
+    "colony https://github.com/solidity-external-tests/colonyNetwork.git develop_080"
+    "ens https://github.com/solidity-external-tests/ens.git master_080"
+)
+
+# Checks out the project or updates an existing checkout and installs its dependencies,
+# which are needed to resolve the imports.
+function prepare_project
+{
+    local name="$1"
+    local repo="$2"
+    local branch="$3"
+    local dir="$CACHE/$name"
+
+    if [ -d "$dir/.git" ]
+    then
+        printLog "Updating $name..."
+        git -C "$dir" fetch --depth 1 origin "$branch"
+        git -C "$dir" checkout --quiet FETCH_HEAD
+    else
+        printLog "Cloning $branch of $repo..."
+        git clone --quiet --depth 1 "$repo" -b "$branch" "$dir"
+    fi
+    echo "$name: $(git -C "$dir" rev-parse HEAD)"
+
+    # Only reinstall the dependencies if the package definition changed.
+    if [ -f "$dir/package.json" ] && command -v npm > /dev/null
+    then
+        local hash
+        hash="$(cat "$dir/package.json" "$dir/package-lock.json" 2> /dev/null | sha256sum | cut -d ' ' -f 1)"
+        if [ ! -d "$dir/node_modules" ] || [ "$(cat "$dir/.benchmark-dependencies" 2> /dev/null)" != "$hash" ]
+        then
+            (cd "$dir" && npm install --ignore-scripts --no-audit --no-fund > /dev/null)
+            echo "$hash" > "$dir/.benchmark-dependencies"
+        fi
+    fi
+}
+
+function run_project
+{
+    local name="$1"
+    "$SOLC_BENCH" --filter "project/$name" --project "$name=$CACHE/$name" --runs "$RUNS" --output "$CACHE/$name.json" \
+        2> "$CACHE/$name.log" || printError "Benchmark of $name failed, see $CACHE/$name.log."
+}
+
+mkdir -p "$CACHE"
+printTask "Preparing the projects..."
+for project in "${PROJECTS[@]}"
+do
+    # shellcheck disable=SC2086
+    prepare_project $project
+done
+
+printTask "Compiling the projects with $JOBS job(s)..."
+names=()
+for project in "${PROJECTS[@]}"
+do
+    name="${project%% *}"
+    names+=("$name")
+    rm -f "$CACHE/$name.json"
+    while [ "$(jobs -rp | wc -l)" -ge "$JOBS" ]
+    do
+        wait -n
+    done
+    run_project "$name" &
+done
+wait
+
+python3 - "$REPORT" "${names[@]/#/$CACHE/}" <<'EOF'
+import json
+import os
+import sys
+
+report = {"results": []}
+for name in sys.argv[2:]:
+    if not os.path.exists(name + ".json"):
+        continue
+    with open(name + ".json", encoding="utf8") as file:
+        results = json.load(file)
+    report["version"] = results["version"]
+    report["results"] += results["results"]
+with open(sys.argv[1], "w", encoding="utf8") as file:
+    json.dump(report, file, indent=4)
+EOF
+printTask "Wrote the results to $REPORT."
@@ -22,10 +22,12 @@
  */
 
 #include <libsolutil/JSON.h>
+#include <libsolutil/JsonWriter.h>
 #include <libevmasm/Assembly.h>
 
 #include <boost/test/unit_test.hpp>
 
+#include <sstream>
 #include <string>
 #include <tuple>
 #include <memory>
@@ -57,11 +59,11 @@ BOOST_AUTO_TEST_CASE(all_assembly_items)
 		{ "sub.asm", 1 }
 	};
 	Assembly _assembly;
-	auto root_asm = make_shared<CharStream>("lorem ipsum", "root.asm");
+	string const* root_asm = internSourceName("root.asm");
 	_assembly.setSourceLocation({1, 3, root_asm});
 
 	Assembly _subAsm;
-	auto sub_asm = make_shared<CharStream>("lorem ipsum", "sub.asm");
+	string const* sub_asm = internSourceName("sub.asm");
 	_subAsm.setSourceLocation({6, 8, sub_asm});
 	// PushImmutable
 	_subAsm.appendImmutable("someImmutable");
@@ -163,6 +165,12 @@ BOOST_AUTO_TEST_CASE(all_assembly_items)
 		"{\"begin\":6,\"end\":8,\"name\":\"INVALID\",\"source\":1}"
 		"]},\"A6885B3731702DA62E8E4A8F584AC46A7F6822F4E2BA50FBA902F67B1588D23B\":\"01020304\"}}"
 	);
+
+	ostringstream streamedJSON;
+	util::JsonStreamWriter writer(streamedJSON);
+	_assembly.assemblyJSON(writer, indices);
+	writer.finish();
+	BOOST_CHECK_EQUAL(streamedJSON.str(), util::jsonCompactPrint(_assembly.assemblyJSON(indices)));
 }
 
 BOOST_AUTO_TEST_CASE(immutable)
@@ -172,11 +180,11 @@ BOOST_AUTO_TEST_CASE(immutable)
 		{ "sub.asm", 1 }
 	};
 	Assembly _assembly;
-	auto root_asm = make_shared<CharStream>("lorem ipsum", "root.asm");
+	string const* root_asm = internSourceName("root.asm");
 	_assembly.setSourceLocation({1, 3, root_asm});
 
 	Assembly _subAsm;
-	auto sub_asm = make_shared<CharStream>("lorem ipsum", "sub.asm");
+	string const* sub_asm = internSourceName("sub.asm");
 	_subAsm.setSourceLocation({6, 8, sub_asm});
 	_subAsm.appendImmutable("someImmutable");
 	_subAsm.appendImmutable("someOtherImmutable");
@@ -260,6 +268,12 @@ BOOST_AUTO_TEST_CASE(immutable)
 		"{\"begin\":6,\"end\":8,\"name\":\"PUSHIMMUTABLE\",\"source\":1,\"value\":\"someImmutable\"}"
 		"]}}}"
 	);
+
+	ostringstream streamedJSON;
+	util::JsonStreamWriter writer(streamedJSON);
+	_assembly.assemblyJSON(writer, indices);
+	writer.finish();
+	BOOST_CHECK_EQUAL(streamedJSON.str(), util::jsonCompactPrint(_assembly.assemblyJSON(indices)));
 }
 
 BOOST_AUTO_TEST_CASE(subobject_encode_decode)
@@ -280,6 +294,53 @@ BOOST_AUTO_TEST_CASE(subobject_encode_decode)
 	BOOST_CHECK(assembly.decodeSubPath(assembly.encodeSubPath(subPath)) == subPath);
 }
 
+BOOST_AUTO_TEST_CASE(assembly_item_data)
+{
+	u256 small = 0x1234;
+	u256 boundary = u256(numeric_limits<uint64_t>::max());
+	u256 large = u256(1) << 200;
+
+	for (u256 const& value: {small, boundary, boundary + 1, large})
+	{
+		AssemblyItem item(Push, value);
+		BOOST_CHECK_EQUAL(item.data(), value);
+		BOOST_CHECK(item == AssemblyItem(value));
+
+		item.setData(value + 1);
+		BOOST_CHECK_EQUAL(item.data(), value + 1);
+		BOOST_CHECK(item != AssemblyItem(value));
+	}
+
+	BOOST_CHECK(AssemblyItem(small) < AssemblyItem(boundary));
+	BOOST_CHECK(AssemblyItem(boundary) < AssemblyItem(boundary + 1));
+	BOOST_CHECK(AssemblyItem(boundary + 1) < AssemblyItem(large));
+	BOOST_CHECK(!(AssemblyItem(large) < AssemblyItem(boundary + 1)));
+	BOOST_CHECK(!(AssemblyItem(large) < AssemblyItem(large)));
+
+	AssemblyItem tag = AssemblyItem(PushTag, 7).toSubAssemblyTag(2);
+	BOOST_CHECK(tag.splitForeignPushTag() == make_pair(size_t(2), size_t(7)));
+	BOOST_CHECK(!AssemblyItem(PushSubSize, 0).pushedValue().has_value());
+}
+
+BOOST_AUTO_TEST_CASE(link_multiple_objects)
+{
+	Assembly assembly;
+	assembly.appendLibraryAddress("file.sol:L");
+	assembly.appendLibraryAddress("M");
+	LinkerObject first = assembly.assemble();
+	LinkerObject second = first;
+	BOOST_REQUIRE_EQUAL(first.linkReferences.size(), 2);
+
+	util::h160 address("0x1122334455667788990011223344556677889900");
+	LinkerObject::link({&first, &second}, {{"L", address}});
+	for (LinkerObject const* object: {&first, &second})
+	{
+		BOOST_REQUIRE_EQUAL(object->linkReferences.size(), 1);
+		BOOST_CHECK_EQUAL(object->linkReferences.begin()->second, "M");
+		BOOST_CHECK(bytes(object->bytecode.begin() + 1, object->bytecode.begin() + 21) == address.asBytes());
+	}
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // end namespaces
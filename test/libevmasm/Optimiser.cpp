@@ -30,6 +30,7 @@
 #include <libevmasm/ControlFlowGraph.h>
 #include <libevmasm/BlockDeduplicator.h>
 #include <libevmasm/Assembly.h>
+#include <libevmasm/ConstantOptimiser.h>
 
 #include <boost/test/unit_test.hpp>
 
@@ -1266,6 +1267,31 @@ BOOST_AUTO_TEST_CASE(jumpdest_removal_subassemblies)
 	);
 }
 
+BOOST_AUTO_TEST_CASE(constant_optimiser_cache)
+{
+	u256 const value = (u256(1) << 255) + 1;
+	auto optimiseWith = [&](shared_ptr<ConstantOptimisationCache> _cache)
+	{
+		Assembly assembly;
+		assembly.append(value);
+		assembly.append(u256(0));
+		assembly.append(Instruction::SSTORE);
+		Assembly::OptimiserSettings settings;
+		settings.runConstantOptimiser = true;
+		settings.evmVersion = solidity::test::CommonOptions::get().evmVersion();
+		settings.constantCache = move(_cache);
+		assembly.optimise(settings);
+		return assembly.items();
+	};
+
+	AssemblyItems uncached = optimiseWith(nullptr);
+	auto cache = make_shared<ConstantOptimisationCache>();
+	// The second run reuses the representation found by the first one.
+	BOOST_CHECK(optimiseWith(cache) == uncached);
+	BOOST_CHECK(optimiseWith(cache) == uncached);
+	BOOST_CHECK(cache->find({value, 1, false, 200, solidity::test::CommonOptions::get().evmVersion()}).has_value());
+}
+
 BOOST_AUTO_TEST_CASE(cse_sub_zero)
 {
 	checkCSE({
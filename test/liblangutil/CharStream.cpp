@@ -48,6 +48,49 @@ BOOST_AUTO_TEST_CASE(test_fail)
 	);
 }
 
+BOOST_AUTO_TEST_CASE(line_column)
+{
+	CharStream const source("first\nsecond\r\n\nlast", "source");
+	using LineColumn = std::tuple<int, int>;
+
+	BOOST_CHECK(source.translatePositionToLineColumn(0) == LineColumn(0, 0));
+	BOOST_CHECK(source.translatePositionToLineColumn(5) == LineColumn(0, 5));
+	BOOST_CHECK(source.translatePositionToLineColumn(6) == LineColumn(1, 0));
+	BOOST_CHECK(source.translatePositionToLineColumn(13) == LineColumn(1, 7));
+	BOOST_CHECK(source.translatePositionToLineColumn(14) == LineColumn(2, 0));
+	BOOST_CHECK(source.translatePositionToLineColumn(15) == LineColumn(3, 0));
+	BOOST_CHECK(source.translatePositionToLineColumn(19) == LineColumn(3, 4));
+	BOOST_CHECK(source.translatePositionToLineColumn(100) == LineColumn(3, 4));
+	BOOST_CHECK(source.translatePositionToLineColumn(-1) == LineColumn(3, 4));
+	BOOST_CHECK((
+		source.translatePositionsToLineColumns({7, 0, 15}) ==
+		std::vector<LineColumn>{LineColumn(1, 1), LineColumn(0, 0), LineColumn(3, 0)}
+	));
+
+	BOOST_CHECK_EQUAL(source.lineAtPosition(0), "first");
+	BOOST_CHECK_EQUAL(source.lineAtPosition(5), "first");
+	BOOST_CHECK_EQUAL(source.lineAtPosition(6), "second");
+	BOOST_CHECK_EQUAL(source.lineAtPosition(14), "");
+	BOOST_CHECK_EQUAL(source.lineAtPosition(17), "last");
+	BOOST_CHECK_EQUAL(source.lineAtPosition(100), "last");
+
+	CharStream const copy = source;
+	BOOST_CHECK(copy.translatePositionToLineColumn(17) == LineColumn(3, 2));
+	BOOST_CHECK(CharStream().translatePositionToLineColumn(3) == LineColumn(0, 0));
+	BOOST_CHECK_EQUAL(CharStream().lineAtPosition(3), "");
+}
+
+BOOST_AUTO_TEST_CASE(location_text)
+{
+	CharStream const source("now is the time for testing", "source");
+
+	BOOST_CHECK_EQUAL(source.text(SourceLocation{4, 6, source.internedName()}), "is");
+	BOOST_CHECK_EQUAL(source.text(SourceLocation{0, 0, source.internedName()}), "");
+	BOOST_CHECK_THROW(source.text(SourceLocation{4, 6, internSourceName("other")}), SourceLocationError);
+	BOOST_CHECK_THROW(source.text(SourceLocation{4, 200, source.internedName()}), SourceLocationError);
+	BOOST_CHECK_THROW(source.text(SourceLocation{}), SourceLocationError);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // end namespaces
@@ -788,6 +788,30 @@ BOOST_AUTO_TEST_CASE(irregular_line_breaks_in_single_line_comment)
 	}
 }
 
+BOOST_AUTO_TEST_CASE(long_comments_and_literals)
+{
+	string const text = "a long text\twith \"tabs\" that spans more than a few words";
+	Scanner scanner(CharStream(
+		"// " + text + "\n"
+		"/// " + text + "\n"
+		"/* " + text + " */ "
+		"/** " + text + "*/ "
+		"longIdentifierName_$123 '" + text.substr(12, 4) + " quoted' "
+		"unicode\"" + text.substr(0, 11) + "\xE2\x80\xAE\xE2\x80\xAC\" "
+		"// unbalanced \xE2\x80\xAE direction override",
+		""
+	));
+	BOOST_CHECK_EQUAL(scanner.currentCommentLiteral(), text);
+	BOOST_CHECK_EQUAL(scanner.currentToken(), Token::Identifier);
+	BOOST_CHECK_EQUAL(scanner.currentLiteral(), "longIdentifierName_$123");
+	BOOST_CHECK_EQUAL(scanner.next(), Token::StringLiteral);
+	BOOST_CHECK_EQUAL(scanner.currentLiteral(), "with quoted");
+	BOOST_CHECK_EQUAL(scanner.next(), Token::UnicodeStringLiteral);
+	BOOST_CHECK_EQUAL(scanner.currentLiteral(), "a long text\xE2\x80\xAE\xE2\x80\xAC");
+	BOOST_CHECK_EQUAL(scanner.next(), Token::Illegal);
+	BOOST_CHECK_EQUAL(scanner.currentError(), ScannerError::DirectionalOverrideMismatch);
+}
+
 BOOST_AUTO_TEST_CASE(regular_line_breaks_in_single_line_doc_comment)
 {
 	for (auto const& nl: {"\r", "\n", "\r\n"})
@@ -990,6 +1014,38 @@ BOOST_AUTO_TEST_CASE(yul_function_with_whitespace)
 	BOOST_CHECK_EQUAL(scanner.next(), Token::EOS);
 }
 
+BOOST_AUTO_TEST_CASE(keywords_and_elementary_types)
+{
+#define KEYWORD(name, string, precedence) BOOST_CHECK(get<0>(TokenTraits::fromIdentifierOrKeyword(string)) == Token::name);
+#define TOKEN(name, string, precedence)
+	TOKEN_LIST(TOKEN, KEYWORD)
+#undef KEYWORD
+#undef TOKEN
+
+	using Result = tuple<Token, unsigned, unsigned>;
+	BOOST_CHECK(TokenTraits::fromIdentifierOrKeyword("contracts") == Result(Token::Identifier, 0, 0));
+	BOOST_CHECK(TokenTraits::fromIdentifierOrKeyword("") == Result(Token::Identifier, 0, 0));
+	BOOST_CHECK(TokenTraits::fromIdentifierOrKeyword("bytes1") == Result(Token::BytesM, 1, 0));
+	BOOST_CHECK(TokenTraits::fromIdentifierOrKeyword("bytes32") == Result(Token::BytesM, 32, 0));
+	BOOST_CHECK(TokenTraits::fromIdentifierOrKeyword("bytes33") == Result(Token::Identifier, 0, 0));
+	BOOST_CHECK(TokenTraits::fromIdentifierOrKeyword("bytes0") == Result(Token::Identifier, 0, 0));
+	BOOST_CHECK(TokenTraits::fromIdentifierOrKeyword("uint8") == Result(Token::UIntM, 8, 0));
+	BOOST_CHECK(TokenTraits::fromIdentifierOrKeyword("int256") == Result(Token::IntM, 256, 0));
+	BOOST_CHECK(TokenTraits::fromIdentifierOrKeyword("uint7") == Result(Token::Identifier, 0, 0));
+	BOOST_CHECK(TokenTraits::fromIdentifierOrKeyword("uint264") == Result(Token::Identifier, 0, 0));
+	BOOST_CHECK(TokenTraits::fromIdentifierOrKeyword("uint08") == Result(Token::Identifier, 0, 0));
+	BOOST_CHECK(TokenTraits::fromIdentifierOrKeyword("uint8a") == Result(Token::Identifier, 0, 0));
+	BOOST_CHECK(TokenTraits::fromIdentifierOrKeyword("fixed128x18") == Result(Token::FixedMxN, 128, 18));
+	BOOST_CHECK(TokenTraits::fromIdentifierOrKeyword("ufixed8x0") == Result(Token::UFixedMxN, 8, 0));
+	BOOST_CHECK(TokenTraits::fromIdentifierOrKeyword("ufixed8x81") == Result(Token::Identifier, 0, 0));
+	BOOST_CHECK(TokenTraits::fromIdentifierOrKeyword("ufixed8x") == Result(Token::Identifier, 0, 0));
+	BOOST_CHECK(TokenTraits::fromIdentifierOrKeyword("fixed8x01") == Result(Token::Identifier, 0, 0));
+	BOOST_CHECK(TokenTraits::fromIdentifierOrKeyword("fixedx8") == Result(Token::Identifier, 0, 0));
+	BOOST_CHECK(TokenTraits::isYulKeyword("leave"));
+	BOOST_CHECK(TokenTraits::isYulKeyword("switch"));
+	BOOST_CHECK(!TokenTraits::isYulKeyword("contract"));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // end namespaces
@@ -34,9 +34,9 @@ BOOST_AUTO_TEST_SUITE(SourceLocationTest)
 
 BOOST_AUTO_TEST_CASE(test_fail)
 {
-	auto const source = std::make_shared<CharStream>("lorem ipsum", "source");
-	auto const sourceA = std::make_shared<CharStream>("lorem ipsum", "sourceA");
-	auto const sourceB = std::make_shared<CharStream>("lorem ipsum", "sourceB");
+	std::string const* source = internSourceName("source");
+	std::string const* sourceA = internSourceName("sourceA");
+	std::string const* sourceB = internSourceName("sourceB");
 
 	BOOST_CHECK(SourceLocation{} == SourceLocation{});
 	BOOST_CHECK((SourceLocation{0, 3, sourceA} != SourceLocation{0, 3, sourceB}));
@@ -46,6 +46,15 @@ BOOST_AUTO_TEST_CASE(test_fail)
 	BOOST_CHECK((SourceLocation{3, 7, sourceA} < SourceLocation{4, 6, sourceB}));
 }
 
+BOOST_AUTO_TEST_CASE(interned_names)
+{
+	std::string name = "source";
+	BOOST_CHECK(internSourceName(name) == internSourceName("source"));
+	BOOST_CHECK(internSourceName("source") != internSourceName("sourceA"));
+	BOOST_CHECK_EQUAL(*internSourceName(name), "source");
+	BOOST_CHECK((SourceLocation{0, 3, internSourceName(name)} == SourceLocation{0, 3, internSourceName("source")}));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // end namespaces
@@ -0,0 +1,103 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for interned symbols.
+ */
+
+#include <liblangutil/Symbol.h>
+
+#include <test/Common.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+namespace solidity::langutil::test
+{
+
+BOOST_AUTO_TEST_SUITE(SymbolTest)
+
+BOOST_AUTO_TEST_CASE(interning)
+{
+	Symbol amount("amount");
+	BOOST_CHECK(amount == Symbol(string("amount")));
+	BOOST_CHECK(amount != Symbol("amounts"));
+	BOOST_CHECK(&amount.str() == &Symbol("amount").str());
+	BOOST_CHECK_EQUAL(amount.str(), "amount");
+	BOOST_CHECK(!amount.empty());
+
+	BOOST_CHECK(Symbol().empty());
+	BOOST_CHECK(Symbol("") == Symbol());
+	BOOST_CHECK(Symbol(shared_ptr<string>{}) == Symbol());
+}
+
+BOOST_AUTO_TEST_CASE(order)
+{
+	BOOST_CHECK(Symbol("a") < Symbol("b"));
+	BOOST_CHECK(!(Symbol("b") < Symbol("a")));
+	BOOST_CHECK(!(Symbol("a") < Symbol("a")));
+	BOOST_CHECK(Symbol() < Symbol("a"));
+}
+
+BOOST_AUTO_TEST_CASE(shared_text)
+{
+	Symbol to("_to");
+	shared_ptr<string const> text = to.shared();
+	BOOST_CHECK(text.get() == &to.str());
+	BOOST_CHECK(Symbol(text) == to);
+	BOOST_CHECK(Symbol(make_shared<string>("_to")) == to);
+}
+
+BOOST_AUTO_TEST_CASE(reset)
+{
+	Symbol before("_reset");
+	size_t generation = Symbol::generation();
+	BOOST_CHECK(Symbol::size() > 0);
+
+	Symbol::reset();
+	BOOST_CHECK_EQUAL(Symbol::size(), 0);
+	BOOST_CHECK_EQUAL(Symbol::generation(), generation + 1);
+	BOOST_CHECK(Symbol().empty());
+	Symbol after("_reset");
+	BOOST_CHECK_EQUAL(after.str(), "_reset");
+	BOOST_CHECK(Symbol(after.shared()) == after);
+	BOOST_CHECK(Symbol(make_shared<string>("_reset")) == after);
+}
+
+BOOST_AUTO_TEST_CASE(concurrent)
+{
+	vector<vector<Symbol>> symbols(4);
+	vector<thread> threads;
+	for (auto& threadSymbols: symbols)
+		threads.emplace_back([&threadSymbols]() {
+			for (size_t i = 0; i < 1000; ++i)
+				threadSymbols.emplace_back("name" + to_string(i));
+		});
+	for (auto& thread: threads)
+		thread.join();
+	for (size_t i = 0; i < 1000; ++i)
+		for (auto const& threadSymbols: symbols)
+			BOOST_CHECK(threadSymbols[i] == symbols.front()[i]);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
@@ -41,9 +41,12 @@ ABIJsonTest::ABIJsonTest(string const& _filename):
 	m_expectation = m_reader.simpleExpectations();
 }
 
+ABIJsonTest::~ABIJsonTest() = default;
+
 TestCase::TestResult ABIJsonTest::run(ostream& _stream, string const& _linePrefix, bool _formatted)
 {
-	CompilerStack compiler;
+	m_compiler = make_unique<CompilerStack>();
+	CompilerStack& compiler = *m_compiler;
 
 	compiler.setSources({{
 		"",
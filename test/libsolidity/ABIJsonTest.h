@@ -23,8 +23,14 @@
 
 #include <test/TestCase.h>
 
+#include <memory>
 #include <string>
 
+namespace solidity::frontend
+{
+class CompilerStack;
+}
+
 namespace solidity::frontend::test
 {
 
@@ -35,8 +41,13 @@ public:
 	static std::unique_ptr<TestCase> create(Config const& _config)
 	{ return std::make_unique<ABIJsonTest>(_config.filename); }
 	ABIJsonTest(std::string const& _filename);
+	~ABIJsonTest() override;
 
 	TestResult run(std::ostream& _stream, std::string const& _linePrefix = "", bool const _formatted = false) override;
+
+private:
+	/// Owned by the test case, so that it is destroyed together with it rather than during the run.
+	std::unique_ptr<CompilerStack> m_compiler;
 };
 
 }
@@ -0,0 +1,93 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for the storage of AST annotations.
+ */
+
+#include <libsolidity/ast/ASTAnnotationTable.h>
+
+#include <test/Common.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <thread>
+
+using namespace std;
+
+namespace solidity::frontend::test
+{
+
+BOOST_AUTO_TEST_SUITE(ASTAnnotationTableTest)
+
+BOOST_AUTO_TEST_CASE(annotations_per_slot)
+{
+	util::Arena arena;
+	ASTAnnotationTable& table = arena.create<ASTAnnotationTable>(arena);
+	uint32_t first = table.addNode();
+	uint32_t second = table.addNode();
+	uint32_t third = table.addNode();
+	BOOST_CHECK_EQUAL(first, 0);
+	BOOST_CHECK_EQUAL(third, 2);
+
+	IdentifierAnnotation& identifier = table.annotation<IdentifierAnnotation>(first);
+	identifier.isPure = true;
+	BOOST_CHECK(&table.annotation<IdentifierAnnotation>(first) == &identifier);
+	BOOST_CHECK(&table.annotation<ExpressionAnnotation>(first) == &identifier);
+	BOOST_CHECK(table.annotation<ExpressionAnnotation>(first).isPure.set());
+
+	ContractDefinitionAnnotation& contract = table.annotation<ContractDefinitionAnnotation>(second);
+	contract.unimplementedDeclarations = vector<Declaration const*>{};
+	BOOST_CHECK(&table.annotation<ContractDefinitionAnnotation>(second) == &contract);
+
+	// The memory of the cleared annotation is reused for the next one of the same type.
+	table.clear(second);
+	ContractDefinitionAnnotation& next = table.annotation<ContractDefinitionAnnotation>(third);
+	BOOST_CHECK(&next == &contract);
+	BOOST_CHECK(!next.unimplementedDeclarations.has_value());
+	ContractDefinitionAnnotation& again = table.annotation<ContractDefinitionAnnotation>(second);
+	BOOST_CHECK(&again != &next);
+	BOOST_CHECK(!again.unimplementedDeclarations.has_value());
+}
+
+BOOST_AUTO_TEST_CASE(concurrent_creation)
+{
+	util::Arena arena;
+	ASTAnnotationTable& table = arena.create<ASTAnnotationTable>(arena);
+	size_t const slots = 1000;
+	for (size_t i = 0; i < slots; ++i)
+		table.addNode();
+
+	// Every thread has to see the same annotation in each slot.
+	vector<vector<ExpressionAnnotation*>> seen(4, vector<ExpressionAnnotation*>(slots));
+	vector<thread> threads;
+	for (size_t t = 0; t < seen.size(); ++t)
+		threads.emplace_back([&, t]() {
+			for (size_t i = 0; i < slots; ++i)
+				seen[t][i] = &table.annotation<ExpressionAnnotation>(static_cast<uint32_t>(i));
+		});
+	for (thread& t: threads)
+		t.join();
+	for (size_t t = 1; t < seen.size(); ++t)
+		BOOST_CHECK(seen[t] == seen.front());
+	for (ExpressionAnnotation* annotation: seen.front())
+		BOOST_CHECK(!annotation->isLValue.set());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
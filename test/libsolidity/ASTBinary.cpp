@@ -0,0 +1,123 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for the binary AST format.
+ */
+
+#include <test/Common.h>
+
+#include <libsolidity/ast/ASTBinary.h>
+#include <libsolidity/ast/ASTJsonConverter.h>
+#include <libsolidity/ast/TypeProvider.h>
+#include <libsolidity/interface/CompilerStack.h>
+
+#include <liblangutil/Exceptions.h>
+
+#include <libsolutil/JSON.h>
+
+#include <boost/test/unit_test.hpp>
+
+using namespace std;
+using namespace solidity::langutil;
+
+namespace solidity::frontend::test
+{
+
+BOOST_AUTO_TEST_SUITE(ASTBinaryTest)
+
+BOOST_AUTO_TEST_CASE(value_types)
+{
+	Json::Value ast;
+	BOOST_REQUIRE(util::jsonParseStrict(
+		R"({"a": null, "b": [true, false, -7, 7, 18446744073709551615, 1.5], "c": {"": "", "a": "b"}, "d": []})",
+		ast
+	));
+	ast["e"] = Json::Int64(-9223372036854775807 - 1);
+
+	string binary = ASTBinary::encode({{"A.sol", ast}, {"B.sol", Json::Value(Json::objectValue)}});
+	BOOST_CHECK(ASTBinary::isBinary(binary));
+	ASTBinary reader(binary);
+	BOOST_CHECK(reader.sourceNames() == (vector<string>{"A.sol", "B.sol"}));
+	BOOST_CHECK_EQUAL(util::jsonCompactPrint(reader.source("A.sol")), util::jsonCompactPrint(ast));
+	BOOST_CHECK(reader.source("B.sol") == Json::Value(Json::objectValue));
+	BOOST_CHECK_THROW(reader.source("C.sol"), InvalidAstError);
+}
+
+BOOST_AUTO_TEST_CASE(invalid_data)
+{
+	BOOST_CHECK(!ASTBinary::isBinary("{\"sources\": {}}"));
+	BOOST_CHECK_THROW(ASTBinary("{\"sources\": {}}"), InvalidAstError);
+
+	Json::Value ast;
+	ast["nodeType"] = "SourceUnit";
+	string binary = ASTBinary::encode({{"A.sol", ast}});
+	for (size_t length = 0; length < binary.size(); ++length)
+		BOOST_CHECK_THROW(ASTBinary(string_view(binary).substr(0, length)).sources(), InvalidAstError);
+
+	string otherVersion = binary;
+	otherVersion[8] = static_cast<char>(ASTBinary::formatVersion + 1);
+	BOOST_CHECK_THROW(ASTBinary{otherVersion}, InvalidAstError);
+}
+
+BOOST_AUTO_TEST_CASE(nesting_limit)
+{
+	auto nested = [](size_t _depth) {
+		Json::Value ast{Json::arrayValue};
+		Json::Value* innermost = &ast;
+		for (size_t i = 0; i < _depth; ++i)
+			innermost = &innermost->append(Json::arrayValue);
+		return ASTBinary::encode({{"A.sol", ast}});
+	};
+	BOOST_CHECK_NO_THROW(ASTBinary(nested(1000)).source("A.sol"));
+	BOOST_CHECK_THROW(ASTBinary(nested(1001)).source("A.sol"), InvalidAstError);
+}
+
+BOOST_AUTO_TEST_CASE(import)
+{
+	char const* sourceCode = R"(
+		pragma solidity >=0.0;
+		contract C {
+			function f(uint x) public pure returns (uint) { return x * 2; }
+		}
+	)";
+	CompilerStack compiler;
+	compiler.setSources({{"A.sol", sourceCode}});
+	compiler.setEVMVersion(solidity::test::CommonOptions::get().evmVersion());
+	BOOST_REQUIRE(compiler.compile());
+	Json::Value ast;
+	{
+		TypeProvider::Scope typeScope(compiler.typeProvider());
+		ast = ASTJsonConverter(compiler.state(), compiler.sourceIndices()).toJson(compiler.ast("A.sol"));
+	}
+
+	CompilerStack importer;
+	importer.setEVMVersion(solidity::test::CommonOptions::get().evmVersion());
+	importer.importASTs(ASTBinary::encode({{"A.sol", ast}}));
+	BOOST_REQUIRE(importer.analyze());
+	BOOST_REQUIRE(importer.compile());
+	BOOST_CHECK(!importer.runtimeObject("C").bytecode.empty());
+	TypeProvider::Scope typeScope(importer.typeProvider());
+	BOOST_CHECK_EQUAL(
+		util::jsonCompactPrint(ASTJsonConverter(importer.state(), importer.sourceIndices()).toJson(importer.ast("A.sol"))),
+		util::jsonCompactPrint(ast)
+	);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
@@ -20,8 +20,11 @@
 #include <test/libsolidity/ASTJSONTest.h>
 #include <test/Common.h>
 #include <libsolutil/AnsiColorized.h>
+#include <libsolutil/JSON.h>
 #include <liblangutil/SourceReferenceFormatter.h>
+#include <libsolidity/ast/ASTBinary.h>
 #include <libsolidity/ast/ASTJsonConverter.h>
+#include <libsolidity/ast/TypeProvider.h>
 #include <libsolidity/interface/CompilerStack.h>
 #include <boost/algorithm/string.hpp>
 #include <boost/algorithm/string/predicate.hpp>
@@ -124,9 +127,12 @@ ASTJSONTest::ASTJSONTest(string const& _filename)
 	file.close();
 }
 
+ASTJSONTest::~ASTJSONTest() = default;
+
 TestCase::TestResult ASTJSONTest::run(ostream& _stream, string const& _linePrefix, bool const _formatted)
 {
-	CompilerStack c;
+	m_compiler = make_unique<CompilerStack>();
+	CompilerStack& c = *m_compiler;
 
 	StringMap sources;
 	map<string, unsigned> sourceIndices;
@@ -141,7 +147,7 @@ TestCase::TestResult ASTJSONTest::run(ostream& _stream, string const& _linePrefi
 
 	if (!c.compile(CompilerStack::State::Parsed))
 	{
-		SourceReferenceFormatter formatter(_stream, _formatted, false);
+		SourceReferenceFormatter formatter(_stream, c, _formatted, false);
 		for (auto const& error: c.errors())
 			formatter.printErrorInformation(*error);
 		return TestResult::FatalError;
@@ -167,7 +173,7 @@ TestCase::TestResult ASTJSONTest::run(ostream& _stream, string const& _linePrefi
 		if (m_expectation.empty())
 			return resultsMatch ? TestResult::Success : TestResult::Failure;
 
-		SourceReferenceFormatter formatter(_stream, _formatted, false);
+		SourceReferenceFormatter formatter(_stream, c, _formatted, false);
 		for (auto const& error: c.errors())
 			formatter.printErrorInformation(*error);
 		return TestResult::FatalError;
@@ -200,6 +206,7 @@ bool ASTJSONTest::runTest(
 	bool const _formatted
 )
 {
+	TypeProvider::Scope typeScope(_compiler.typeProvider());
 	if (m_sources.size() > 1)
 		_result += "[\n";
 
@@ -208,6 +215,29 @@ bool ASTJSONTest::runTest(
 		ostringstream result;
 		ASTJsonConverter(_compiler.state(), _sourceIndices).print(result, _compiler.ast(m_sources[i].first));
 		_result += result.str();
+
+		ostringstream compactResult;
+		ASTJsonConverter converter(_compiler.state(), _sourceIndices);
+		converter.print(compactResult, _compiler.ast(m_sources[i].first), true);
+		Json::Value tree = converter.toJson(_compiler.ast(m_sources[i].first));
+		if (compactResult.str() != jsonCompactPrint(tree))
+		{
+			AnsiColorized(_stream, _formatted, {BOLD, RED}) <<
+				_linePrefix <<
+				"Printed compact JSON of " << m_sources[i].first << " differs from the JSON tree" <<
+				(!_variation.empty() ? " (" + _variation + ")." : ".") <<
+				endl;
+			return false;
+		}
+		if (ASTBinary(ASTBinary::encode({{m_sources[i].first, tree}})).source(m_sources[i].first) != tree)
+		{
+			AnsiColorized(_stream, _formatted, {BOLD, RED}) <<
+				_linePrefix <<
+				"Binary AST of " << m_sources[i].first << " does not decode to the JSON tree" <<
+				(!_variation.empty() ? " (" + _variation + ")." : ".") <<
+				endl;
+			return false;
+		}
 		if (i != m_sources.size() - 1)
 			_result += ",";
 		_result += "\n";
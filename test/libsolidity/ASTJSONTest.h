@@ -22,6 +22,7 @@
 #include <test/TestCase.h>
 
 #include <iosfwd>
+#include <memory>
 #include <string>
 #include <vector>
 #include <utility>
@@ -42,6 +43,7 @@ public:
 		return std::make_unique<ASTJSONTest>(_config.filename);
 	}
 	ASTJSONTest(std::string const& _filename);
+	~ASTJSONTest() override;
 
 	TestResult run(std::ostream& _stream, std::string const& _linePrefix = "", bool const _formatted = false) override;
 
@@ -70,6 +72,8 @@ private:
 	std::string m_astParseOnlyFilename;
 	std::string m_result;
 	std::string m_resultParseOnly;
+	/// Owned by the test case, so that it is destroyed together with it rather than during the run.
+	std::unique_ptr<CompilerStack> m_compiler;
 };
 
 }
@@ -0,0 +1,87 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for the lookup of AST nodes by ID.
+ */
+
+#include <test/Common.h>
+
+#include <libsolidity/ast/AST.h>
+#include <libsolidity/ast/ASTNodeIndex.h>
+#include <libsolidity/ast/ASTVisitor.h>
+#include <libsolidity/interface/CompilerStack.h>
+
+#include <boost/test/unit_test.hpp>
+
+using namespace std;
+
+namespace solidity::frontend::test
+{
+
+BOOST_AUTO_TEST_SUITE(ASTNodeIndexTest)
+
+BOOST_AUTO_TEST_CASE(all_nodes)
+{
+	CompilerStack compiler;
+	compiler.setSources({
+		{"A.sol", "pragma solidity >=0.0; contract A { function f() public pure returns (uint) { return 1; } }"},
+		{"B.sol", "pragma solidity >=0.0; import \"A.sol\"; contract B is A {}"}
+	});
+	compiler.setEVMVersion(solidity::test::CommonOptions::get().evmVersion());
+	BOOST_REQUIRE(compiler.parseAndAnalyze());
+
+	ASTNodeIndex const& index = compiler.astNodeIndex();
+	size_t nodeCount = 0;
+	int64_t maxID = 0;
+	SimpleASTVisitor visitor(
+		[&](ASTNode const& _node) {
+			BOOST_CHECK(index.node(_node.id()) == &_node);
+			maxID = max(maxID, _node.id());
+			++nodeCount;
+			return true;
+		},
+		[](ASTNode const&) {}
+	);
+	compiler.ast("A.sol").accept(visitor);
+	compiler.ast("B.sol").accept(visitor);
+
+	BOOST_CHECK(nodeCount > 10);
+	BOOST_CHECK(!index.node(-1));
+	BOOST_CHECK(!index.node(maxID + 1));
+	ContractDefinition const& contract = compiler.contractDefinition("B");
+	BOOST_CHECK(index.node<ContractDefinition>(contract.id()) == &contract);
+	BOOST_CHECK(!index.node<FunctionDefinition>(contract.id()));
+}
+
+BOOST_AUTO_TEST_CASE(sparse_ids)
+{
+	SourceUnit first{1, {}, nullopt, {}};
+	SourceUnit second{1000000, {}, nullopt, {}};
+	ASTNodeIndex index({&first, &second});
+	BOOST_CHECK(index.node(1) == &first);
+	BOOST_CHECK(index.node(1000000) == &second);
+	BOOST_CHECK(!index.node(2));
+
+	index.remove(second);
+	BOOST_CHECK(!index.node(1000000));
+	BOOST_CHECK(index.node(1) == &first);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
@@ -50,7 +50,9 @@ AnalysisFramework::parseAnalyseAndReturnError(
 	bool _allowRecoveryErrors
 )
 {
+	m_typeScope.reset();
 	compiler().reset();
+	m_typeScope.emplace(compiler().typeProvider());
 	// Do not insert license if it is already present.
 	bool insertLicense = _insertLicenseAndVersionPragma && _source.find("// SPDX-License-Identifier:") == string::npos;
 	compiler().setSources({{"",
@@ -151,7 +153,7 @@ string AnalysisFramework::formatErrors() const
 
 string AnalysisFramework::formatError(Error const& _error) const
 {
-	return SourceReferenceFormatter::formatErrorInformation(_error);
+	return SourceReferenceFormatter::formatErrorInformation(_error, compiler());
 }
 
 ContractDefinition const* AnalysisFramework::retrieveContractByName(SourceUnit const& _source, string const& _name)
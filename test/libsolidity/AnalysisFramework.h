@@ -24,10 +24,12 @@
 #include <test/libsolidity/ErrorCheck.h>
 
 #include <libsolidity/interface/CompilerStack.h>
+#include <libsolidity/ast/TypeProvider.h>
 
 #include <functional>
-#include <string>
 #include <memory>
+#include <optional>
+#include <string>
 
 namespace solidity::frontend
 {
@@ -91,6 +93,9 @@ protected:
 
 private:
 	mutable std::unique_ptr<solidity::frontend::CompilerStack> m_compiler;
+	/// Makes the types the tests request from the analysed ASTs, e.g. through interfaceFunctions(),
+	/// come from the provider of the compiler stack.
+	std::optional<TypeProvider::Scope> m_typeScope;
 };
 
 // Asserts that the compilation down to typechecking
@@ -0,0 +1,143 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for the binary artifact format.
+ */
+
+#include <test/Common.h>
+
+#include <libsolidity/interface/ArtifactBinary.h>
+#include <libsolidity/interface/CompilerStack.h>
+
+#include <boost/test/unit_test.hpp>
+
+using namespace std;
+
+namespace solidity::frontend::test
+{
+
+using Entry = ArtifactBinary::SourceMapEntry;
+
+BOOST_AUTO_TEST_SUITE(ArtifactBinaryTest)
+
+BOOST_AUTO_TEST_CASE(source_map)
+{
+	BOOST_CHECK(ArtifactBinary::expandSourceMap("").empty());
+	BOOST_CHECK(
+		ArtifactBinary::expandSourceMap("1:2:0:-:0;;3::1:i;:-1:-1:o:1;") ==
+		(vector<Entry>{
+			{1, 2, 0, '-', 0},
+			{1, 2, 0, '-', 0},
+			{3, 2, 1, 'i', 0},
+			{3, -1, -1, 'o', 1},
+			{3, -1, -1, 'o', 1}
+		})
+	);
+	for (char const* invalid: {"1:2:0:x", "a", "1:2:0:-:-1", "1:2:0:-:0:0", "99999999999"})
+		BOOST_CHECK_THROW(ArtifactBinary::expandSourceMap(invalid), InvalidArtifactError);
+}
+
+BOOST_AUTO_TEST_CASE(round_trip)
+{
+	ArtifactBinary::Contract contract;
+	contract.bytecode = bytes{0x60, 0x80, 0x00, 0x0a};
+	contract.deployedBytecode = bytes{0x00, 0x01};
+	contract.sourceMap = {{0, 10, 0, '-', 0}, {-1, -1, -1, 'i', 2}};
+	contract.deployedSourceMap = {{4, 5, 1, 'o', 0}};
+	contract.linkReferences = {{1, "A.sol:L"}, {3, "B.sol:M"}};
+	contract.deployedLinkReferences = {{0, "A.sol:L"}};
+	contract.immutableReferences = {{"7", {0, 64}}, {"9", {}}};
+
+	string binary = ArtifactBinary::encode({"A.sol", "B.sol"}, {{"A.sol:C", contract}, {"A.sol:D", {}}});
+	BOOST_CHECK(ArtifactBinary::isBinary(binary));
+	ArtifactBinary reader(binary);
+	BOOST_CHECK(reader.sourceNames() == (vector<string>{"A.sol", "B.sol"}));
+	BOOST_CHECK(reader.contractNames() == (vector<string>{"A.sol:C", "A.sol:D"}));
+	BOOST_CHECK(reader.bytecode("A.sol:C") == string_view("\x60\x80\x00\x0a", 4));
+
+	ArtifactBinary::Contract decoded = reader.contract("A.sol:C");
+	BOOST_CHECK(decoded.bytecode == contract.bytecode);
+	BOOST_CHECK(decoded.deployedBytecode == contract.deployedBytecode);
+	BOOST_CHECK(decoded.sourceMap == contract.sourceMap);
+	BOOST_CHECK(decoded.deployedSourceMap == contract.deployedSourceMap);
+	BOOST_CHECK(decoded.linkReferences == contract.linkReferences);
+	BOOST_CHECK(decoded.deployedLinkReferences == contract.deployedLinkReferences);
+	BOOST_CHECK(decoded.immutableReferences == contract.immutableReferences);
+	BOOST_CHECK(reader.contract("A.sol:D").bytecode.empty());
+	BOOST_CHECK_THROW(reader.contract("A.sol:E"), InvalidArtifactError);
+}
+
+BOOST_AUTO_TEST_CASE(invalid_data)
+{
+	BOOST_CHECK(!ArtifactBinary::isBinary("6080"));
+	BOOST_CHECK_THROW(ArtifactBinary("6080"), InvalidArtifactError);
+
+	ArtifactBinary::Contract contract;
+	contract.bytecode = bytes{0x60, 0x80};
+	contract.sourceMap = {{0, 10, 0, '-', 0}};
+	string binary = ArtifactBinary::encode({"A.sol"}, {{"A.sol:C", contract}});
+	for (size_t length = 0; length < binary.size(); ++length)
+		BOOST_CHECK_THROW(ArtifactBinary(string_view(binary).substr(0, length)).contract("A.sol:C"), InvalidArtifactError);
+
+	string otherVersion = binary;
+	otherVersion[8] = static_cast<char>(ArtifactBinary::formatVersion + 1);
+	BOOST_CHECK_THROW(ArtifactBinary{otherVersion}, InvalidArtifactError);
+}
+
+BOOST_AUTO_TEST_CASE(compiler_output)
+{
+	char const* sourceCode = R"(
+		pragma solidity >=0.0;
+		library L {
+			function f(uint x) public pure returns (uint) { return x * 2; }
+		}
+		contract C {
+			uint immutable y = 3;
+			function g(uint x) public view returns (uint) { return L.f(x) + y; }
+		}
+	)";
+	CompilerStack compiler;
+	compiler.setSources({{"A.sol", sourceCode}});
+	compiler.setEVMVersion(solidity::test::CommonOptions::get().evmVersion());
+	BOOST_REQUIRE(compiler.compile());
+
+	ArtifactBinary reader(ArtifactBinary::encode(compiler));
+	BOOST_CHECK(reader.sourceNames().front() == "A.sol");
+	BOOST_CHECK(reader.contractNames() == compiler.contractNames());
+	for (string const& name: compiler.contractNames())
+	{
+		ArtifactBinary::Contract contract = reader.contract(name);
+		BOOST_CHECK(contract.bytecode == compiler.object(name).bytecode);
+		BOOST_CHECK(contract.deployedBytecode == compiler.runtimeObject(name).bytecode);
+		BOOST_CHECK(contract.linkReferences == compiler.object(name).linkReferences);
+		BOOST_CHECK(contract.deployedSourceMap == ArtifactBinary::expandSourceMap(*compiler.runtimeSourceMapping(name)));
+	}
+	ArtifactBinary::Contract contract = reader.contract("A.sol:C");
+	BOOST_CHECK_EQUAL(contract.deployedLinkReferences.size(), 1);
+	BOOST_CHECK_EQUAL(contract.deployedLinkReferences.begin()->second, "A.sol:L");
+	BOOST_REQUIRE_EQUAL(contract.immutableReferences.size(), 1);
+	BOOST_CHECK(!contract.immutableReferences.begin()->second.empty());
+	BOOST_CHECK_EQUAL(
+		contract.deployedSourceMap.size(),
+		size_t(count(compiler.runtimeSourceMapping("A.sol:C")->begin(), compiler.runtimeSourceMapping("A.sol:C")->end(), ';')) + 1
+	);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
@@ -108,9 +108,7 @@ void printAssemblyLocations(AssemblyItems const& _items)
 			_loc.start <<
 			", " <<
 			_loc.end <<
-			", make_shared<string>(\"" <<
-			_loc.source->name() <<
-			"\")}) +" << endl;
+			", sourceName}) +" << endl;
 	};
 
 	vector<SourceLocation> locations;
@@ -168,23 +166,23 @@ BOOST_AUTO_TEST_CASE(location_test)
 	AssemblyItems items = compileContract(sourceCode);
 	bool hasShifts = solidity::test::CommonOptions::get().evmVersion().hasBitwiseShifting();
 
-	auto codegenCharStream = make_shared<CharStream>("", "--CODEGEN--");
+	string const* sourceName = sourceCode->internedName();
 
 	vector<SourceLocation> locations;
 	if (solidity::test::CommonOptions::get().optimize)
 		locations =
-			vector<SourceLocation>(31, SourceLocation{23, 103, sourceCode}) +
-			vector<SourceLocation>(1, SourceLocation{41, 100, sourceCode}) +
-			vector<SourceLocation>(1, SourceLocation{93, 95, sourceCode}) +
-			vector<SourceLocation>(15, SourceLocation{41, 100, sourceCode});
+			vector<SourceLocation>(31, SourceLocation{23, 103, sourceName}) +
+			vector<SourceLocation>(1, SourceLocation{41, 100, sourceName}) +
+			vector<SourceLocation>(1, SourceLocation{93, 95, sourceName}) +
+			vector<SourceLocation>(15, SourceLocation{41, 100, sourceName});
 	else
 		locations =
-			vector<SourceLocation>(hasShifts ? 31 : 32, SourceLocation{23, 103, sourceCode}) +
-			vector<SourceLocation>(24, SourceLocation{41, 100, sourceCode}) +
-			vector<SourceLocation>(1, SourceLocation{70, 79, sourceCode}) +
-			vector<SourceLocation>(1, SourceLocation{93, 95, sourceCode}) +
-			vector<SourceLocation>(2, SourceLocation{86, 95, sourceCode}) +
-			vector<SourceLocation>(2, SourceLocation{41, 100, sourceCode});
+			vector<SourceLocation>(hasShifts ? 31 : 32, SourceLocation{23, 103, sourceName}) +
+			vector<SourceLocation>(24, SourceLocation{41, 100, sourceName}) +
+			vector<SourceLocation>(1, SourceLocation{70, 79, sourceName}) +
+			vector<SourceLocation>(1, SourceLocation{93, 95, sourceName}) +
+			vector<SourceLocation>(2, SourceLocation{86, 95, sourceName}) +
+			vector<SourceLocation>(2, SourceLocation{41, 100, sourceName});
 	checkAssemblyLocations(items, locations);
 }
 
@@ -0,0 +1,79 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for restricting the Horn systems of CHC queries to the rules they depend on.
+ */
+
+#include <libsmtutil/CHCSmtLib2Interface.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace solidity::util;
+using namespace solidity::smtutil;
+
+namespace solidity::frontend::test
+{
+
+BOOST_AUTO_TEST_SUITE(CHCQuerySlicing)
+
+BOOST_AUTO_TEST_CASE(query_contains_only_rules_of_its_cone)
+{
+	map<h256, string> responses;
+	CHCSmtLib2Interface interface(responses);
+	auto relation = [&](string const& _name) {
+		Expression result(_name, {}, make_shared<FunctionSort>(vector<SortPointer>{SortProvider::uintSort}, SortProvider::boolSort));
+		interface.registerRelation(result);
+		return result;
+	};
+	Expression init = relation("init");
+	Expression loop = relation("loop");
+	Expression other = relation("other");
+	Expression loopError = relation("loop_error");
+	Expression otherError = relation("other_error");
+
+	interface.declareVariable("x", SortProvider::uintSort);
+	Expression x("x", {}, SortProvider::uintSort);
+	Expression zero(size_t(0));
+	Expression ten(size_t(10));
+	interface.addRule(Expression::implies(x == zero, init({x})), "init_rule");
+	interface.addRule(Expression::implies(init({x}), loop({x})), "loop_entry");
+	interface.addRule(Expression::implies(loop({x}) && x < ten, loop({x + Expression(size_t(1))})), "loop_step");
+	interface.addRule(Expression::implies(loop({x}) && x > ten, loopError({x})), "loop_error_rule");
+	interface.addRule(Expression::implies(init({x}), other({x})), "other_rule");
+	interface.addRule(Expression::implies(other({x}) && x > zero, otherError({x})), "other_error_rule");
+
+	string loopQuery = interface.dumpQuery(loopError({x}));
+	for (string rule: {"init_rule", "loop_entry", "loop_step", "loop_error_rule", "|loop|"})
+		BOOST_CHECK(loopQuery.find(rule) != string::npos);
+	for (string rule: {"other_rule", "other_error_rule", "|other|", "|other_error|"})
+		BOOST_CHECK(loopQuery.find(rule) == string::npos);
+
+	string otherQuery = interface.dumpQuery(otherError({x}));
+	for (string rule: {"init_rule", "other_rule", "other_error_rule"})
+		BOOST_CHECK(otherQuery.find(rule) != string::npos);
+	for (string rule: {"loop_entry", "loop_step", "loop_error_rule", "|loop|"})
+		BOOST_CHECK(otherQuery.find(rule) == string::npos);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
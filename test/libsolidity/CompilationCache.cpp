@@ -0,0 +1,165 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for the compilation cache.
+ */
+
+#include <test/Common.h>
+
+#include <libsolidity/interface/CompilationCache.h>
+#include <libsolidity/interface/CompilerStack.h>
+
+#include <boost/filesystem.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <fstream>
+
+using namespace std;
+
+namespace solidity::frontend::test
+{
+
+namespace
+{
+
+char const* sourceCode = R"(
+	pragma solidity >=0.0;
+	library L {
+		function f(uint x) external pure returns (uint) { return x + 1; }
+	}
+	contract C {
+		function g(uint x) public pure returns (uint) { return L.f(x); }
+	}
+)";
+
+class CacheDirectory
+{
+public:
+	CacheDirectory():
+		m_path(boost::filesystem::temp_directory_path() / boost::filesystem::unique_path("solc-cache-test-%%%%-%%%%"))
+	{}
+	~CacheDirectory() { boost::filesystem::remove_all(m_path); }
+
+	boost::filesystem::path const& path() const { return m_path; }
+
+private:
+	boost::filesystem::path m_path;
+};
+
+struct CompilationResult
+{
+	bool fromCache = false;
+	evmasm::LinkerObject object;
+	evmasm::LinkerObject runtimeObject;
+	string sourceMapping;
+};
+
+CompilationResult compile(string const& _source, boost::filesystem::path const& _cacheDirectory)
+{
+	CompilerStack compilerStack;
+	compilerStack.setSources({{"A.sol", _source}});
+	compilerStack.setEVMVersion(solidity::test::CommonOptions::get().evmVersion());
+	compilerStack.setOptimiserSettings(solidity::test::CommonOptions::get().optimize);
+	compilerStack.setCompilationCache(make_shared<CompilationCache>(_cacheDirectory));
+	BOOST_REQUIRE_MESSAGE(compilerStack.compile(), "Compiling contract failed");
+
+	CompilationResult result;
+	result.fromCache = !compilerStack.assemblyItems("C");
+	result.object = compilerStack.object("C");
+	result.runtimeObject = compilerStack.runtimeObject("C");
+	BOOST_REQUIRE(compilerStack.sourceMapping("C"));
+	result.sourceMapping = *compilerStack.sourceMapping("C");
+	return result;
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(CompilationCacheTest)
+
+BOOST_AUTO_TEST_CASE(unchanged_contract_is_loaded)
+{
+	CacheDirectory cache;
+	CompilationResult first = compile(sourceCode, cache.path());
+	CompilationResult second = compile(sourceCode, cache.path());
+
+	BOOST_CHECK(!first.fromCache);
+	BOOST_CHECK(second.fromCache);
+	BOOST_CHECK(first.object.bytecode == second.object.bytecode);
+	BOOST_CHECK(first.runtimeObject.bytecode == second.runtimeObject.bytecode);
+	BOOST_CHECK(!second.runtimeObject.linkReferences.empty());
+	BOOST_CHECK(first.runtimeObject.linkReferences == second.runtimeObject.linkReferences);
+	BOOST_CHECK_EQUAL(first.sourceMapping, second.sourceMapping);
+}
+
+BOOST_AUTO_TEST_CASE(changed_source_is_compiled)
+{
+	CacheDirectory cache;
+	compile(sourceCode, cache.path());
+	CompilationResult changed = compile(string(sourceCode) + "\ncontract D {}\n", cache.path());
+
+	BOOST_CHECK(!changed.fromCache);
+}
+
+BOOST_AUTO_TEST_CASE(corrupted_entry_is_ignored)
+{
+	CacheDirectory cache;
+	CompilationResult first = compile(sourceCode, cache.path());
+	for (auto const& entry: boost::filesystem::directory_iterator(cache.path()))
+		ofstream(entry.path().string(), ios::trunc) << "{\"bytecode\": 1}";
+
+	CompilationResult second = compile(sourceCode, cache.path());
+	BOOST_CHECK(!second.fromCache);
+	BOOST_CHECK(first.runtimeObject.bytecode == second.runtimeObject.bytecode);
+
+	BOOST_CHECK(compile(sourceCode, cache.path()).fromCache);
+}
+
+BOOST_AUTO_TEST_CASE(created_contract_is_compiled_once)
+{
+	CacheDirectory cache;
+	string const source = R"(
+		pragma solidity >=0.0;
+		contract D {}
+		contract C {
+			function f() public returns (D) { return new D(); }
+		}
+	)";
+	auto compileWithCache = [&](bytes& _creatorBytecode) {
+		CompilerStack compilerStack;
+		compilerStack.setSources({{"A.sol", source}});
+		compilerStack.setEVMVersion(solidity::test::CommonOptions::get().evmVersion());
+		compilerStack.setOptimiserSettings(solidity::test::CommonOptions::get().optimize);
+		compilerStack.setCompilationCache(make_shared<CompilationCache>(cache.path()));
+		BOOST_REQUIRE_MESSAGE(compilerStack.compile(), "Compiling contract failed");
+		// The legacy code generator needs the compiler of D to compile C, so D is never
+		// loaded from the cache.
+		BOOST_CHECK(compilerStack.assemblyItems("D"));
+		_creatorBytecode = compilerStack.object("C").bytecode;
+		return !compilerStack.assemblyItems("C");
+	};
+
+	bytes first;
+	bytes second;
+	BOOST_CHECK(!compileWithCache(first));
+	BOOST_CHECK(compileWithCache(second));
+	BOOST_CHECK(first == second);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
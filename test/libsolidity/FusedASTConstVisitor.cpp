@@ -0,0 +1,130 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for running several AST visitors in a single traversal.
+ */
+
+#include <test/Common.h>
+
+#include <libsolidity/ast/AST.h>
+#include <libsolidity/ast/FusedASTConstVisitor.h>
+#include <libsolidity/interface/CompilerStack.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <stdexcept>
+
+using namespace std;
+
+namespace solidity::frontend::test
+{
+
+namespace
+{
+
+/// Records the calls to visit and endVisit, does not visit the children of
+/// function definitions and throws when visiting a node of ID @a _throwAt.
+class Recorder: public ASTConstVisitor
+{
+public:
+	explicit Recorder(bool _skipFunctions, int64_t _throwAt = -1):
+		m_skipFunctions(_skipFunctions), m_throwAt(_throwAt)
+	{}
+
+	vector<pair<bool, int64_t>> calls;
+
+private:
+	bool visitNode(ASTNode const& _node) override
+	{
+		if (_node.id() == m_throwAt)
+			throw runtime_error("Stop.");
+		calls.emplace_back(true, _node.id());
+		return !(m_skipFunctions && dynamic_cast<FunctionDefinition const*>(&_node));
+	}
+	void endVisitNode(ASTNode const& _node) override
+	{
+		calls.emplace_back(false, _node.id());
+	}
+
+	bool m_skipFunctions = false;
+	int64_t m_throwAt = -1;
+};
+
+}
+
+BOOST_AUTO_TEST_SUITE(FusedASTConstVisitorTest)
+
+BOOST_AUTO_TEST_CASE(same_calls_as_separate_traversals)
+{
+	CompilerStack compiler;
+	compiler.setSources({{"A.sol", "contract A { uint x; function f() public { x = 1; } function g() public {} }"}});
+	compiler.setEVMVersion(solidity::test::CommonOptions::get().evmVersion());
+	BOOST_REQUIRE(compiler.parse());
+	SourceUnit const& ast = compiler.ast("A.sol");
+
+	Recorder all{false};
+	Recorder skipping{true};
+	ast.accept(all);
+	ast.accept(skipping);
+	BOOST_CHECK(skipping.calls.size() < all.calls.size());
+
+	Recorder fusedAll{false};
+	Recorder fusedSkipping{true};
+	FusedASTConstVisitor fused({&fusedSkipping, &fusedAll});
+	fused.run(ast);
+	BOOST_CHECK(fusedAll.calls == all.calls);
+	BOOST_CHECK(fusedSkipping.calls == skipping.calls);
+	BOOST_CHECK(!fused.exception(0));
+	BOOST_CHECK(!fused.exception(1));
+
+	// Only the children of nodes no visitor wants to visit are skipped.
+	Recorder skippingOnly{true};
+	FusedASTConstVisitor{{&skippingOnly}}.run(ast);
+	BOOST_CHECK(skippingOnly.calls == skipping.calls);
+}
+
+BOOST_AUTO_TEST_CASE(throwing_visitor)
+{
+	CompilerStack compiler;
+	compiler.setSources({{"A.sol", "contract A { function f() public { uint x = 1; x; } }"}});
+	compiler.setEVMVersion(solidity::test::CommonOptions::get().evmVersion());
+	BOOST_REQUIRE(compiler.parse());
+	SourceUnit const& ast = compiler.ast("A.sol");
+
+	Recorder all{false};
+	ast.accept(all);
+	int64_t const throwAt = all.calls.at(all.calls.size() / 4).second;
+
+	Recorder throwing{false, throwAt};
+	Recorder other{false};
+	FusedASTConstVisitor fused({&throwing, &other});
+	fused.run(ast);
+	BOOST_CHECK(other.calls == all.calls);
+	BOOST_REQUIRE(fused.exception(0));
+	BOOST_CHECK_THROW(rethrow_exception(fused.exception(0)), runtime_error);
+	BOOST_CHECK(!fused.exception(1));
+	// The throwing visitor is not called anymore after the exception.
+	BOOST_REQUIRE(throwing.calls.size() < all.calls.size());
+	BOOST_CHECK(equal(throwing.calls.begin(), throwing.calls.end(), all.calls.begin()));
+	BOOST_CHECK(all.calls.at(throwing.calls.size()) == make_pair(true, throwAt));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
@@ -0,0 +1,86 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Tests for the gas profiler of the test framework.
+ */
+
+#include <test/libsolidity/SolidityExecutionFramework.h>
+#include <test/EVMProfiler.h>
+
+#include <boost/algorithm/string/predicate.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <sstream>
+
+using namespace std;
+using namespace solidity::test;
+
+namespace solidity::frontend::test
+{
+
+BOOST_FIXTURE_TEST_SUITE(GasProfilerTest, SolidityExecutionFramework)
+
+BOOST_AUTO_TEST_CASE(frames)
+{
+	char const* sourceCode = R"(
+		contract C {
+			function f(uint n) public pure returns (uint) {
+				return g(n);
+			}
+			function g(uint n) internal pure returns (uint r) {
+				for (uint i = 0; i < n; i++)
+					r += i;
+			}
+		}
+	)";
+	enableProfiling();
+	BOOST_REQUIRE(m_profiler);
+	compileAndRun(sourceCode);
+	ABI_CHECK(callContractFunction("f(uint256)", 10), encodeArgs(45));
+
+	bool creation = false;
+	bool internalCall = false;
+	for (auto const& [frames, sample]: m_profiler->samples())
+	{
+		BOOST_CHECK(sample.count > 0);
+		if (boost::starts_with(frames, "new C;"))
+			creation = true;
+		if (boost::starts_with(frames, "C;C.f;") && frames.find(";C.g;") != string::npos)
+			internalCall = internalCall || sample.gas > 0;
+	}
+	BOOST_CHECK(creation);
+	BOOST_CHECK(internalCall);
+}
+
+BOOST_AUTO_TEST_CASE(write_folded)
+{
+	map<string, EVMProfiler::Sample> samples{
+		{"C;C.f;line 3", {2, 6}},
+		{"C;line 1", {1, 0}}
+	};
+	ostringstream gas;
+	EVMProfiler::writeFolded(gas, samples);
+	BOOST_CHECK_EQUAL(gas.str(), "C;C.f;line 3 6\nC;line 1 0\n");
+	ostringstream counts;
+	EVMProfiler::writeFolded(counts, samples, true);
+	BOOST_CHECK_EQUAL(counts.str(), "C;C.f;line 3 2\nC;line 1 1\n");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
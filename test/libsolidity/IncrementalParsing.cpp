@@ -0,0 +1,142 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for keeping ASTs across resets of the compiler stack.
+ */
+
+#include <test/Common.h>
+
+#include <libsolidity/ast/AST.h>
+#include <libsolidity/interface/CompilerStack.h>
+
+#include <boost/test/unit_test.hpp>
+
+using namespace std;
+
+namespace solidity::frontend::test
+{
+
+BOOST_AUTO_TEST_SUITE(IncrementalParsing)
+
+BOOST_AUTO_TEST_CASE(unchanged_sources_are_reused)
+{
+	string const library = R"(
+		pragma solidity >=0.0;
+		library L { function f(uint x) internal pure returns (uint) { return x + 1; } }
+	)";
+	CompilerStack compilerStack;
+	compilerStack.enableIncrementalParsing();
+	compilerStack.setEVMVersion(solidity::test::CommonOptions::get().evmVersion());
+	compilerStack.setSources({
+		{"A.sol", library},
+		{"B.sol", "pragma solidity >=0.0; import \"A.sol\"; contract C { function g() public pure returns (uint) { return L.f(1); } }"}
+	});
+	BOOST_REQUIRE(compilerStack.compile());
+	SourceUnit const* libraryAST = &compilerStack.ast("A.sol");
+	SourceUnit const* contractAST = &compilerStack.ast("B.sol");
+
+	compilerStack.reset(true);
+	compilerStack.setSources({
+		{"A.sol", library},
+		{"B.sol", "pragma solidity >=0.0; import \"A.sol\"; contract C { function h() public pure returns (uint) { return L.f(2); } }"}
+	});
+	BOOST_REQUIRE(compilerStack.compile());
+	BOOST_CHECK(&compilerStack.ast("A.sol") == libraryAST);
+	BOOST_CHECK(&compilerStack.ast("B.sol") != contractAST);
+	// The nodes of the parsed source must not reuse the IDs of the kept source.
+	BOOST_CHECK(compilerStack.ast("B.sol").id() > compilerStack.ast("A.sol").id());
+	BOOST_CHECK(!compilerStack.object("C").bytecode.empty());
+}
+
+BOOST_AUTO_TEST_CASE(reused_sources_are_analysed_again)
+{
+	StringMap const sources{
+		{"A.sol", "pragma solidity >=0.0; contract A { function f() public pure { uint x = \"a\"; x; } }"}
+	};
+	CompilerStack compilerStack;
+	compilerStack.enableIncrementalParsing();
+	compilerStack.setSources(sources);
+	BOOST_CHECK(!compilerStack.compile());
+	size_t const errorCount = compilerStack.errors().size();
+	SourceUnit const* ast = &compilerStack.ast("A.sol");
+
+	compilerStack.reset(true);
+	compilerStack.setSources(sources);
+	BOOST_CHECK(!compilerStack.compile());
+	BOOST_CHECK(&compilerStack.ast("A.sol") == ast);
+	BOOST_CHECK_EQUAL(compilerStack.errors().size(), errorCount);
+}
+
+BOOST_AUTO_TEST_CASE(edits_inside_a_body_only_parse_the_body)
+{
+	string const before =
+		"pragma solidity >=0.0; contract C {"
+		" function f() public pure returns (uint) { return 1; }"
+		" function g() public pure returns (uint) { return f(); }"
+		" }";
+	string const after =
+		"pragma solidity >=0.0; contract C {"
+		" function f() public pure returns (uint) { uint x = 2; return x + 1; }"
+		" function g() public pure returns (uint) { return f(); }"
+		" }";
+	CompilerStack compilerStack;
+	compilerStack.enableIncrementalParsing();
+	compilerStack.setEVMVersion(solidity::test::CommonOptions::get().evmVersion());
+	compilerStack.setSources({{"A.sol", before}});
+	BOOST_REQUIRE(compilerStack.compile());
+	SourceUnit const* ast = &compilerStack.ast("A.sol");
+	vector<FunctionDefinition const*> functions = compilerStack.contractDefinition("C").definedFunctions();
+	BOOST_REQUIRE_EQUAL(functions.size(), 2);
+	int64_t const bodyID = functions[0]->body().id();
+	int64_t const otherFunctionID = functions[1]->id();
+
+	compilerStack.reset(true);
+	compilerStack.setSources({{"A.sol", after}});
+	BOOST_REQUIRE(compilerStack.compile());
+	BOOST_CHECK(&compilerStack.ast("A.sol") == ast);
+	BOOST_CHECK(compilerStack.contractDefinition("C").definedFunctions() == functions);
+	BOOST_CHECK(functions[0]->body().id() > bodyID);
+	BOOST_CHECK_EQUAL(functions[1]->id(), otherFunctionID);
+	BOOST_CHECK(compilerStack.astNodeIndex().node(otherFunctionID) == functions[1]);
+	BOOST_CHECK_EQUAL(functions[0]->body().location().start, after.find("{ uint x"));
+	BOOST_CHECK_EQUAL(functions[1]->location().start, after.find("function g"));
+	BOOST_CHECK_EQUAL(functions[1]->nameLocation().start, after.find("g()"));
+	BOOST_CHECK(!compilerStack.object("C").bytecode.empty());
+}
+
+BOOST_AUTO_TEST_CASE(edits_breaking_the_braces_parse_the_source)
+{
+	string const before = "pragma solidity >=0.0; contract C { function f() public pure { } }";
+	string const after = "pragma solidity >=0.0; contract C { function f() public pure { } function g() public pure { } }";
+	CompilerStack compilerStack;
+	compilerStack.enableIncrementalParsing();
+	compilerStack.setEVMVersion(solidity::test::CommonOptions::get().evmVersion());
+	compilerStack.setSources({{"A.sol", before}});
+	BOOST_REQUIRE(compilerStack.compile());
+	SourceUnit const* ast = &compilerStack.ast("A.sol");
+
+	compilerStack.reset(true);
+	compilerStack.setSources({{"A.sol", after}});
+	BOOST_REQUIRE(compilerStack.compile());
+	BOOST_CHECK(&compilerStack.ast("A.sol") != ast);
+	BOOST_CHECK_EQUAL(compilerStack.contractDefinition("C").definedFunctions().size(), 2);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
@@ -0,0 +1,220 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for the language server.
+ */
+
+#include <libsolidity/interface/LanguageServer.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <deque>
+#include <sstream>
+
+using namespace std;
+
+namespace solidity::frontend::test
+{
+
+namespace
+{
+
+class MockTransport: public LSPTransport
+{
+public:
+	explicit MockTransport(vector<Json::Value> _input): m_input(_input.begin(), _input.end()) {}
+
+	optional<Json::Value> receive() override
+	{
+		if (m_input.empty())
+			return nullopt;
+		Json::Value message = move(m_input.front());
+		m_input.pop_front();
+		return message;
+	}
+	void send(Json::Value const& _message) override { output.push_back(_message); }
+
+	vector<Json::Value> output;
+
+private:
+	deque<Json::Value> m_input;
+};
+
+Json::Value message(string const& _method, Json::Value _params = Json::objectValue, optional<int> _id = nullopt)
+{
+	Json::Value result;
+	result["jsonrpc"] = "2.0";
+	result["method"] = _method;
+	result["params"] = move(_params);
+	if (_id)
+		result["id"] = *_id;
+	return result;
+}
+
+Json::Value didOpen(string const& _uri, string const& _text)
+{
+	Json::Value params;
+	params["textDocument"]["uri"] = _uri;
+	params["textDocument"]["languageId"] = "solidity";
+	params["textDocument"]["version"] = 1;
+	params["textDocument"]["text"] = _text;
+	return message("textDocument/didOpen", params);
+}
+
+Json::Value position(int _line, int _character)
+{
+	Json::Value result;
+	result["line"] = _line;
+	result["character"] = _character;
+	return result;
+}
+
+/// @returns the response to the request with ID @a _id.
+Json::Value response(vector<Json::Value> const& _output, int _id)
+{
+	for (Json::Value const& message: _output)
+		if (message["id"] == _id)
+			return message;
+	BOOST_FAIL("No response to request " + to_string(_id));
+	return {};
+}
+
+/// @returns the last diagnostics published for @a _uri.
+Json::Value lastDiagnostics(vector<Json::Value> const& _output, string const& _uri)
+{
+	optional<Json::Value> diagnostics;
+	for (Json::Value const& message: _output)
+		if (message["method"] == "textDocument/publishDiagnostics" && message["params"]["uri"] == _uri)
+			diagnostics = message["params"]["diagnostics"];
+	BOOST_REQUIRE(diagnostics);
+	return *diagnostics;
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(LanguageServerTest)
+
+BOOST_AUTO_TEST_CASE(stream_transport)
+{
+	istringstream input(
+		"Content-Length: 18\r\n"
+		"Content-Type: application/vscode-jsonrpc; charset=utf-8\r\n"
+		"\r\n"
+		"{\"method\": \"exit\"}"
+	);
+	ostringstream output;
+	LSPStreamTransport transport(input, output);
+	optional<Json::Value> received = transport.receive();
+	BOOST_REQUIRE(received);
+	BOOST_CHECK_EQUAL((*received)["method"].asString(), "exit");
+	BOOST_CHECK(!transport.receive());
+
+	transport.send(*received);
+	BOOST_CHECK_EQUAL(output.str(), "Content-Length: 17\r\n\r\n{\"method\":\"exit\"}");
+}
+
+BOOST_AUTO_TEST_CASE(lifecycle)
+{
+	MockTransport transport({
+		message("shutdown", Json::nullValue, 1),
+		message("initialize", Json::objectValue, 2),
+		message("initialized"),
+		message("shutdown", Json::nullValue, 3),
+		message("exit")
+	});
+	BOOST_CHECK(LanguageServer(transport).run());
+	BOOST_CHECK_EQUAL(response(transport.output, 1)["error"]["code"].asInt(), -32002);
+	Json::Value const capabilities = response(transport.output, 2)["result"]["capabilities"];
+	BOOST_CHECK(capabilities["definitionProvider"].asBool());
+	BOOST_CHECK_EQUAL(capabilities["textDocumentSync"]["change"].asInt(), 2);
+	BOOST_CHECK(response(transport.output, 3)["result"].isNull());
+
+	MockTransport exitOnly({message("initialize", Json::objectValue, 1), message("exit")});
+	BOOST_CHECK(!LanguageServer(exitOnly).run());
+}
+
+BOOST_AUTO_TEST_CASE(diagnostics)
+{
+	string const uri = "file:///project/A.sol";
+	MockTransport transport({
+		message("initialize", Json::objectValue, 1),
+		didOpen(uri, "// SPDX-License-Identifier: GPL-3.0\npragma solidity >=0.0;\ncontract C {\n\tfunction f() public { x = 1; }\n}\n"),
+		message("shutdown", Json::nullValue, 2),
+		message("exit")
+	});
+	BOOST_CHECK(LanguageServer(transport).run());
+
+	Json::Value const diagnostics = lastDiagnostics(transport.output, uri);
+	BOOST_REQUIRE_EQUAL(diagnostics.size(), 1);
+	BOOST_CHECK_EQUAL(diagnostics[0]["severity"].asInt(), 1);
+	BOOST_CHECK_EQUAL(diagnostics[0]["range"]["start"]["line"].asInt(), 3);
+	BOOST_CHECK_EQUAL(diagnostics[0]["range"]["start"]["character"].asInt(), 23);
+	BOOST_CHECK_EQUAL(diagnostics[0]["message"].asString(), "DeclarationError: Undeclared identifier.");
+}
+
+BOOST_AUTO_TEST_CASE(incremental_change)
+{
+	string const uri = "file:///project/A.sol";
+	Json::Value change;
+	change["textDocument"]["uri"] = uri;
+	change["textDocument"]["version"] = 2;
+	change["contentChanges"][0]["range"]["start"] = position(3, 23);
+	change["contentChanges"][0]["range"]["end"] = position(3, 24);
+	change["contentChanges"][0]["text"] = "y";
+	MockTransport transport({
+		message("initialize", Json::objectValue, 1),
+		didOpen(uri, "// SPDX-License-Identifier: GPL-3.0\npragma solidity >=0.0;\ncontract C {\n\tfunction f() public { x = 1; }\n\tuint y;\n}\n"),
+		message("textDocument/didChange", change),
+		message("shutdown", Json::nullValue, 2),
+		message("exit")
+	});
+	BOOST_CHECK(LanguageServer(transport).run());
+	BOOST_CHECK_EQUAL(lastDiagnostics(transport.output, uri).size(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(definition)
+{
+	string const uri = "file:///project/A.sol";
+	string const text = "// SPDX-License-Identifier: GPL-3.0\npragma solidity >=0.0;\ncontract C {\n\tuint x;\n\tfunction f() public view returns (uint) { return x; }\n}\n";
+	Json::Value params;
+	params["textDocument"]["uri"] = uri;
+	params["position"] = position(4, 50);
+	Json::Value keyword = params;
+	keyword["position"] = position(4, 45);
+	MockTransport transport({
+		message("initialize", Json::objectValue, 1),
+		didOpen(uri, text),
+		message("textDocument/definition", params, 2),
+		message("textDocument/definition", keyword, 3),
+		message("shutdown", Json::nullValue, 4),
+		message("exit")
+	});
+	BOOST_CHECK(LanguageServer(transport).run());
+
+	Json::Value const location = response(transport.output, 2)["result"];
+	BOOST_CHECK_EQUAL(location["uri"].asString(), uri);
+	BOOST_CHECK_EQUAL(location["range"]["start"]["line"].asInt(), 3);
+	BOOST_CHECK_EQUAL(location["range"]["start"]["character"].asInt(), 6);
+	BOOST_CHECK_EQUAL(location["range"]["end"]["character"].asInt(), 7);
+	// The return statement is not a name.
+	BOOST_CHECK(response(transport.output, 3)["result"].isNull());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
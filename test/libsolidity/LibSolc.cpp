@@ -21,6 +21,7 @@
  */
 
 #include <string>
+#include <thread>
 #include <boost/test/unit_test.hpp>
 #include <libsolutil/JSON.h>
 #include <libsolidity/interface/ReadFile.h>
@@ -179,6 +180,55 @@ BOOST_AUTO_TEST_CASE(with_callback)
 	BOOST_CHECK(containsError(result, "ParserError", "Source \"notfound.sol\" not found: Callback not supported."));
 }
 
+BOOST_AUTO_TEST_CASE(compiler_handle)
+{
+	char const* input = R"(
+	{
+		"language": "Solidity",
+		"sources": {
+			"fileA": {
+				"content": "contract A { function f() public pure returns (uint r) { assembly { r := add(1, 2) } } }"
+			}
+		},
+		"settings": {
+			"outputSelection": { "fileA": { "A": [ "evm.bytecode.object" ] } }
+		}
+	}
+	)";
+	auto compileWith = [&](SolidityCompiler* _compiler) {
+		char* outputPtr = solidity_compiler_compile(_compiler, input);
+		string output(outputPtr);
+		solidity_free(outputPtr);
+		return output;
+	};
+
+	SolidityCompiler* compiler = solidity_compiler_create(nullptr, nullptr);
+	BOOST_REQUIRE(compiler != nullptr);
+	string first = compileWith(compiler);
+	Json::Value result;
+	BOOST_REQUIRE(util::jsonParseStrict(first, result));
+	BOOST_CHECK(!result["contracts"]["fileA"]["A"]["evm"]["bytecode"]["object"].asString().empty());
+	// The second compilation reuses the parsed source.
+	BOOST_CHECK_EQUAL(compileWith(compiler), first);
+	// Compiling without the handle resets the shared state, after which the source is parsed again.
+	compile(input);
+	BOOST_CHECK_EQUAL(compileWith(compiler), first);
+
+	SolidityCompiler* other = solidity_compiler_create(nullptr, nullptr);
+	BOOST_REQUIRE(other != nullptr);
+	string fromThread;
+	thread worker([&]() { fromThread = compileWith(other); });
+	string fromMainThread = compileWith(compiler);
+	worker.join();
+	BOOST_CHECK_EQUAL(fromMainThread, first);
+	BOOST_CHECK_EQUAL(fromThread, first);
+
+	solidity_compiler_destroy(other);
+	BOOST_CHECK_EQUAL(compileWith(compiler), first);
+	solidity_compiler_destroy(compiler);
+	solidity_compiler_destroy(nullptr);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // end namespaces
@@ -0,0 +1,109 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for the collection of multi-use Yul functions.
+ */
+
+#include <libsolidity/codegen/MultiUseYulFunctionCollector.h>
+
+#include <boost/test/unit_test.hpp>
+
+using namespace std;
+
+namespace solidity::frontend::test
+{
+
+BOOST_AUTO_TEST_SUITE(MultiUseYulFunctionCollectorTest)
+
+BOOST_AUTO_TEST_CASE(shared_functions_with_dependencies)
+{
+	auto cache = make_shared<SharedYulFunctionCache>();
+	size_t created = 0;
+	auto createB = [&](MultiUseYulFunctionCollector& _collector) {
+		return _collector.createSharedFunction("b", "s/", [&]() {
+			++created;
+			return string("function b() {}\n");
+		});
+	};
+	auto createA = [&](MultiUseYulFunctionCollector& _collector) {
+		return _collector.createSharedFunction("a", "s/", [&]() {
+			++created;
+			return "function a() { " + createB(_collector) + "() }\n";
+		});
+	};
+
+	MultiUseYulFunctionCollector first(cache);
+	BOOST_CHECK_EQUAL(createA(first), "a");
+	BOOST_CHECK_EQUAL(created, 2);
+	string const code = first.requestedFunctions();
+
+	MultiUseYulFunctionCollector second(cache);
+	BOOST_CHECK_EQUAL(createA(second), "a");
+	BOOST_CHECK_EQUAL(created, 2);
+	BOOST_CHECK(second.contains("b"));
+	BOOST_CHECK_EQUAL(second.requestedFunctions(), code);
+
+	// Other settings do not share the functions.
+	MultiUseYulFunctionCollector third(cache);
+	third.createSharedFunction("a", "t/", [&]() {
+		++created;
+		return string("function a() {}\n");
+	});
+	BOOST_CHECK_EQUAL(created, 3);
+}
+
+BOOST_AUTO_TEST_CASE(unshared_dependencies)
+{
+	auto cache = make_shared<SharedYulFunctionCache>();
+	size_t created = 0;
+	auto createA = [&](MultiUseYulFunctionCollector& _collector) {
+		return _collector.createSharedFunction("a", "s/", [&]() {
+			++created;
+			string b = _collector.createFunction("b", []() { return string("function b() {}\n"); });
+			return "function a() { " + b + "() }\n";
+		});
+	};
+
+	MultiUseYulFunctionCollector first(cache);
+	createA(first);
+	MultiUseYulFunctionCollector second(cache);
+	createA(second);
+	// The unshared dependency has to be generated again, so the function is as well.
+	BOOST_CHECK_EQUAL(created, 2);
+	BOOST_CHECK(second.contains("b"));
+	BOOST_CHECK_EQUAL(second.requestedFunctions(), first.requestedFunctions());
+}
+
+BOOST_AUTO_TEST_CASE(without_cache)
+{
+	size_t created = 0;
+	auto create = [&]() {
+		++created;
+		return string("function a() {}\n");
+	};
+	MultiUseYulFunctionCollector first;
+	first.createSharedFunction("a", "s/", create);
+	first.createSharedFunction("a", "s/", create);
+	MultiUseYulFunctionCollector second;
+	second.createSharedFunction("a", "s/", create);
+	BOOST_CHECK_EQUAL(created, 2);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
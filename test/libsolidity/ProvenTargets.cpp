@@ -0,0 +1,126 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for the reuse of verification targets proven by earlier runs of the model checker.
+ */
+
+#include <test/Common.h>
+
+#include <libsolidity/formal/ProvenTargets.h>
+#include <libsolidity/interface/CompilerStack.h>
+
+#include <boost/filesystem.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <memory>
+#include <string>
+
+using namespace std;
+using namespace solidity::smtutil;
+
+namespace solidity::frontend::test
+{
+
+namespace
+{
+
+char const* sourceCode = R"(
+	pragma solidity >=0.0;
+	contract C {
+		uint x;
+		function f(uint a) public { x = g(a); }
+		function g(uint a) internal pure returns (uint) { assert(a >= 0); return a; }
+		function h() public { x = 2; }
+	}
+)";
+
+/// Marks the assertion in `g` of @a _before as proven and @returns whether it is still
+/// proven in @a _after.
+bool stillProven(string const& _before, string const& _after, ProvenTargets::Engine _engine)
+{
+	boost::filesystem::path const directory =
+		boost::filesystem::temp_directory_path() / boost::filesystem::unique_path("solc-proven-targets-test-%%%%-%%%%");
+	auto check = [&](string const& _source, bool _mark) {
+		CompilerStack compilerStack;
+		compilerStack.setSources({{"A.sol", _source}});
+		compilerStack.setEVMVersion(solidity::test::CommonOptions::get().evmVersion());
+		BOOST_REQUIRE(compilerStack.parseAndAnalyze());
+		ContractDefinition const& contract = compilerStack.contractDefinition("C");
+		FunctionDefinition const* g = nullptr;
+		for (auto const* function: contract.definedFunctions())
+			if (function->name() == "g")
+				g = function;
+		BOOST_REQUIRE(g);
+		ASTNode const& assertion = *g->body().statements().front();
+
+		ProvenTargets provenTargets(compilerStack, make_shared<SMTQueryCache>("salt", directory));
+		if (_mark)
+			provenTargets.markProven(_engine, {&contract}, assertion, VerificationTargetType::Assert);
+		return provenTargets.proven(_engine, {&contract}, assertion, VerificationTargetType::Assert);
+	};
+	BOOST_REQUIRE(check(_before, true));
+	bool proven = check(_after, false);
+	boost::filesystem::remove_all(directory);
+	return proven;
+}
+
+string replace(string _source, string const& _from, string const& _to)
+{
+	size_t position = _source.find(_from);
+	BOOST_REQUIRE(position != string::npos);
+	return _source.replace(position, _from.size(), _to);
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(ProvenTargetsTest)
+
+BOOST_AUTO_TEST_CASE(unchanged)
+{
+	BOOST_CHECK(stillProven(sourceCode, sourceCode, ProvenTargets::Engine::BMC));
+	BOOST_CHECK(stillProven(sourceCode, sourceCode, ProvenTargets::Engine::CHC));
+	// Moving the function does not change its fingerprint.
+	string const moved = replace(sourceCode, "uint x;", "uint x;\n\t\tfunction k() public pure {}");
+	BOOST_CHECK(stillProven(sourceCode, moved, ProvenTargets::Engine::BMC));
+}
+
+BOOST_AUTO_TEST_CASE(changed_function)
+{
+	string const changed = replace(sourceCode, "return a;", "return a + 1;");
+	BOOST_CHECK(!stillProven(sourceCode, changed, ProvenTargets::Engine::BMC));
+	BOOST_CHECK(!stillProven(sourceCode, changed, ProvenTargets::Engine::CHC));
+}
+
+BOOST_AUTO_TEST_CASE(changed_caller)
+{
+	string const changed = replace(sourceCode, "x = g(a);", "x = g(a + 1);");
+	BOOST_CHECK(!stillProven(sourceCode, changed, ProvenTargets::Engine::BMC));
+	BOOST_CHECK(!stillProven(sourceCode, changed, ProvenTargets::Engine::CHC));
+}
+
+BOOST_AUTO_TEST_CASE(changed_state_access)
+{
+	// Only the CHC engine reasons about other transactions that change the state.
+	string const changed = replace(sourceCode, "x = 2;", "x = 3;");
+	BOOST_CHECK(stillProven(sourceCode, changed, ProvenTargets::Engine::BMC));
+	BOOST_CHECK(!stillProven(sourceCode, changed, ProvenTargets::Engine::CHC));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
@@ -0,0 +1,99 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for freeing the compilation results of contracts and ASTs early.
+ */
+
+#include <test/Common.h>
+
+#include <libsolidity/interface/CompilerStack.h>
+#include <libsolidity/interface/StandardCompiler.h>
+#include <libsolutil/JSON.h>
+
+#include <boost/test/unit_test.hpp>
+
+using namespace std;
+
+namespace solidity::frontend::test
+{
+
+namespace
+{
+
+StringMap const sources{
+	{"A.sol", "pragma solidity >=0.0; library L { function f() internal pure returns (uint) { return 1; } }"},
+	{"B.sol", "pragma solidity >=0.0; import \"A.sol\"; contract B { function g() public pure returns (uint) { return L.f(); } }"},
+	{"C.sol", "pragma solidity >=0.0; import \"B.sol\"; contract C is B { function h() public returns (address) { return address(new B()); } }"},
+	{"D.sol", "pragma solidity >=0.0; struct S { uint x; }"}
+};
+
+}
+
+BOOST_AUTO_TEST_SUITE(ReleasingContracts)
+
+BOOST_AUTO_TEST_CASE(asts_are_released_with_their_last_user)
+{
+	CompilerStack compilerStack;
+	compilerStack.setSources(sources);
+	compilerStack.setEVMVersion(solidity::test::CommonOptions::get().evmVersion());
+	BOOST_REQUIRE(compilerStack.compile());
+	compilerStack.keepAST("B.sol");
+
+	compilerStack.releaseContract("C.sol:C");
+	BOOST_CHECK_THROW(compilerStack.object("C.sol:C"), langutil::CompilerError);
+	BOOST_CHECK_THROW(compilerStack.ast("C.sol"), langutil::CompilerError);
+	// No contract can refer to D.sol.
+	BOOST_CHECK_THROW(compilerStack.ast("D.sol"), langutil::CompilerError);
+	// B and L can still refer to A.sol and B.sol.
+	BOOST_CHECK(!compilerStack.object("B.sol:B").bytecode.empty());
+	BOOST_CHECK_NO_THROW(compilerStack.ast("A.sol"));
+	BOOST_CHECK(!compilerStack.metadata("B.sol:B").empty());
+
+	compilerStack.releaseContract("B.sol:B");
+	BOOST_CHECK_NO_THROW(compilerStack.ast("A.sol"));
+	compilerStack.releaseContract("A.sol:L");
+	BOOST_CHECK_THROW(compilerStack.ast("A.sol"), langutil::CompilerError);
+	BOOST_CHECK_THROW(compilerStack.contractABI("A.sol:L"), langutil::CompilerError);
+	BOOST_CHECK_NO_THROW(compilerStack.ast("B.sol"));
+	BOOST_CHECK_EQUAL(compilerStack.contractNames().size(), 3);
+}
+
+BOOST_AUTO_TEST_CASE(low_memory_does_not_change_output)
+{
+	auto compile = [](bool _lowMemory) {
+		Json::Value input;
+		input["language"] = "Solidity";
+		for (auto const& [name, content]: sources)
+			input["sources"][name]["content"] = content;
+		input["settings"]["lowMemory"] = _lowMemory;
+		input["settings"]["outputSelection"]["*"]["*"] = Json::arrayValue;
+		for (char const* output: {"abi", "metadata", "evm.bytecode", "evm.gasEstimates", "evm.assembly", "devdoc"})
+			input["settings"]["outputSelection"]["*"]["*"].append(output);
+		input["settings"]["outputSelection"]["B.sol"][""].append("ast");
+		return StandardCompiler().compile(input);
+	};
+
+	Json::Value result = compile(false);
+	BOOST_REQUIRE(!result.isMember("errors"));
+	BOOST_REQUIRE(result["sources"]["B.sol"].isMember("ast"));
+	BOOST_CHECK_EQUAL(util::jsonCompactPrint(compile(true)), util::jsonCompactPrint(result));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
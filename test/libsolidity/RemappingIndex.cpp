@@ -0,0 +1,60 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for the index of the import remappings.
+ */
+
+#include <libsolidity/interface/RemappingIndex.h>
+
+#include <boost/test/unit_test.hpp>
+
+using namespace std;
+
+namespace solidity::frontend::test
+{
+
+BOOST_AUTO_TEST_SUITE(RemappingIndexTest)
+
+BOOST_AUTO_TEST_CASE(precedence)
+{
+	RemappingIndex index;
+	index.add("", "x", "short");
+	index.add("", "x/y", "long");
+	index.add("a", "x", "context");
+	index.add("a/b", "z", "other");
+	index.add("", "w", "first");
+	index.add("", "w", "last");
+
+	BOOST_CHECK_EQUAL(index.apply("q/q.sol", ""), "q/q.sol");
+	BOOST_CHECK_EQUAL(index.apply("x/x.sol", ""), "short/x.sol");
+	BOOST_CHECK_EQUAL(index.apply("x/y/y.sol", "main.sol"), "long/y.sol");
+	// A longer context takes precedence over a longer prefix.
+	BOOST_CHECK_EQUAL(index.apply("x/y/y.sol", "a/main.sol"), "context/y/y.sol");
+	// Contexts without a matching prefix are skipped.
+	BOOST_CHECK_EQUAL(index.apply("x/y/y.sol", "a/b/main.sol"), "context/y/y.sol");
+	BOOST_CHECK_EQUAL(index.apply("z/z.sol", "a/b/main.sol"), "other/z.sol");
+	BOOST_CHECK_EQUAL(index.apply("z/z.sol", "a/main.sol"), "z/z.sol");
+	BOOST_CHECK_EQUAL(index.apply("w.sol", ""), "last.sol");
+
+	index.clear();
+	BOOST_CHECK_EQUAL(index.apply("x/x.sol", ""), "x/x.sol");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
@@ -0,0 +1,130 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for sending batches of SMT queries to the SMT callback.
+ */
+
+#include <libsmtutil/SMTLib2Interface.h>
+
+#include <libsolutil/JSON.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace solidity::util;
+using namespace solidity::smtutil;
+
+namespace solidity::frontend::test
+{
+
+namespace
+{
+
+/// Records the requests of an SMT interface and answers every query with "sat"
+/// if @a _acceptBatches is true, and every single query with "unsat".
+struct RecordingCallback
+{
+	ReadCallback::Callback callback(bool _acceptBatches)
+	{
+		return [this, _acceptBatches](string const& _kind, string const& _data) -> ReadCallback::Result {
+			requests.emplace_back(_kind, _data);
+			if (_kind == ReadCallback::kindString(ReadCallback::Kind::SMTQuery))
+				return {true, "unsat\n"};
+			if (!_acceptBatches)
+				return {false, "Batches are not supported."};
+			Json::Value queries;
+			BOOST_REQUIRE(jsonParseStrict(_data, queries));
+			Json::Value responses(Json::arrayValue);
+			for (Json::ArrayIndex i = 0; i < queries.size(); ++i)
+				responses.append(i == 0 ? Json::Value("sat\n") : Json::Value());
+			return {true, jsonCompactPrint(responses)};
+		};
+	}
+
+	vector<pair<string, string>> requests;
+};
+
+/// @returns the results of checking the assertions @a _values one after another.
+vector<CheckResult> checkAll(SMTLib2Interface& _interface, vector<bool> const& _values, bool _batch)
+{
+	vector<string> queries;
+	if (_batch)
+		for (bool value: _values)
+		{
+			_interface.push();
+			_interface.addAssertion(Expression(value));
+			queries.push_back(_interface.dumpQuery({}));
+			_interface.pop();
+		}
+	_interface.queryBatch(queries);
+
+	vector<CheckResult> results;
+	for (bool value: _values)
+	{
+		_interface.push();
+		_interface.addAssertion(Expression(value));
+		results.push_back(_interface.check({}).first);
+		_interface.pop();
+	}
+	return results;
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(SMTQueryBatch)
+
+BOOST_AUTO_TEST_CASE(unanswered_queries_are_sent_alone)
+{
+	RecordingCallback recorder;
+	SMTLib2Interface interface({}, recorder.callback(true));
+	vector<CheckResult> results = checkAll(interface, {true, false}, true);
+	BOOST_CHECK(results == (vector<CheckResult>{CheckResult::SATISFIABLE, CheckResult::UNSATISFIABLE}));
+
+	BOOST_REQUIRE_EQUAL(recorder.requests.size(), 2);
+	BOOST_CHECK_EQUAL(recorder.requests[0].first, "smt-query-batch");
+	BOOST_CHECK_EQUAL(recorder.requests[1].first, "smt-query");
+}
+
+BOOST_AUTO_TEST_CASE(callback_without_batches)
+{
+	RecordingCallback recorder;
+	SMTLib2Interface interface({}, recorder.callback(false));
+	vector<CheckResult> results = checkAll(interface, {true, false}, true);
+	BOOST_CHECK(results == (vector<CheckResult>{CheckResult::UNSATISFIABLE, CheckResult::UNSATISFIABLE}));
+
+	BOOST_REQUIRE_EQUAL(recorder.requests.size(), 3);
+	BOOST_CHECK_EQUAL(recorder.requests[0].first, "smt-query-batch");
+	BOOST_CHECK_EQUAL(recorder.requests[1].first, "smt-query");
+	BOOST_CHECK_EQUAL(recorder.requests[2].first, "smt-query");
+}
+
+BOOST_AUTO_TEST_CASE(single_query_is_not_batched)
+{
+	RecordingCallback recorder;
+	SMTLib2Interface interface({}, recorder.callback(true));
+	checkAll(interface, {true}, true);
+	BOOST_REQUIRE_EQUAL(recorder.requests.size(), 1);
+	BOOST_CHECK_EQUAL(recorder.requests[0].first, "smt-query");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
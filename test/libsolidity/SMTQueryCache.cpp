@@ -0,0 +1,92 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for the cache of the answers of SMT solvers.
+ */
+
+#include <libsmtutil/SMTQueryCache.h>
+
+#include <boost/filesystem.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace solidity::smtutil;
+
+namespace solidity::frontend::test
+{
+
+namespace
+{
+
+size_t countEntries(boost::filesystem::path const& _directory)
+{
+	size_t entries = 0;
+	for (auto const& entry: boost::filesystem::directory_iterator(_directory))
+		if (entry.path().extension() == ".json")
+			++entries;
+	return entries;
+}
+
+void overwriteEntries(boost::filesystem::path const& _directory, string const& _content)
+{
+	for (auto const& entry: boost::filesystem::directory_iterator(_directory))
+		ofstream(entry.path().string(), ios::trunc) << _content;
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(SMTQueryCacheTest)
+
+BOOST_AUTO_TEST_CASE(entries_on_disk)
+{
+	boost::filesystem::path const directory =
+		boost::filesystem::temp_directory_path() / boost::filesystem::unique_path("solc-smt-cache-test-%%%%-%%%%");
+	string const query = "(declare-fun |x| () Int)\n(assert (> |x| 0))\n(check-sat)\n";
+	vector<string> const values{"1", "(- 2)"};
+
+	SMTQueryCache cache("salt", directory);
+	BOOST_CHECK(!cache.load("z3", query));
+	cache.store("z3", query, {CheckResult::SATISFIABLE, values});
+	cache.store("z3", query + "(assert false)\n", {CheckResult::UNKNOWN, {}});
+	cache.store("z3", query + "(assert true)\n", {CheckResult::ERROR, {}});
+	BOOST_CHECK_EQUAL(countEntries(directory), 1);
+
+	// A new cache on the same directory reads the entry.
+	auto answer = SMTQueryCache("salt", directory).load("z3", query);
+	BOOST_REQUIRE(answer);
+	BOOST_CHECK(answer->first == CheckResult::SATISFIABLE);
+	BOOST_CHECK(answer->second == values);
+	BOOST_CHECK(!SMTQueryCache("other salt", directory).load("z3", query));
+	BOOST_CHECK(!SMTQueryCache("salt", directory).load("cvc4", query));
+
+	// Invalid entries are treated as missing.
+	overwriteEntries(directory, "{\"result\": \"unknown\", \"values\": []}");
+	BOOST_CHECK(!SMTQueryCache("salt", directory).load("z3", query));
+	overwriteEntries(directory, "{\"result\": \"unsat\"");
+	BOOST_CHECK(!SMTQueryCache("salt", directory).load("z3", query));
+
+	boost::filesystem::remove_all(directory);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
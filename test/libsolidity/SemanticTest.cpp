@@ -43,6 +43,7 @@ namespace fs = boost::filesystem;
 SemanticTest::SemanticTest(string const& _filename, langutil::EVMVersion _evmVersion, vector<boost::filesystem::path> const& _vmPaths, bool enforceViaYul):
 	SolidityExecutionFramework(_evmVersion, _vmPaths),
 	EVMVersionRestrictedTestCase(_filename),
+	m_filename(_filename),
 	m_sources(m_reader.sources()),
 	m_lineOffset(m_reader.lineNumber()),
 	m_enforceViaYul(enforceViaYul)
@@ -123,11 +124,16 @@ TestCase::TestResult SemanticTest::runTest(ostream& _stream, string const& _line
 {
 	bool success = true;
 
+	// Every configuration is profiled separately.
+	m_profiler.reset();
 	if (_compileViaYul && _compileToEwasm)
 		selectVM(evmc_capabilities::EVMC_CAPABILITY_EWASM);
 	else
 		selectVM(evmc_capabilities::EVMC_CAPABILITY_EVM1);
 
+	if (GasProfile::instance().enabled() && !_compileToEwasm)
+		enableProfiling();
+
 	reset();
 
 	m_compileViaYul = _compileViaYul;
@@ -148,6 +154,7 @@ TestCase::TestResult SemanticTest::runTest(ostream& _stream, string const& _line
 	map<string, solidity::test::Address> libraries;
 
 	bool constructed = false;
+	GasReport::Measurement gasMeasurement;
 
 	for (auto& test: m_tests)
 	{
@@ -173,6 +180,8 @@ TestCase::TestResult SemanticTest::runTest(ostream& _stream, string const& _line
 			else
 				soltestAssert(deploy("", 0, bytes(), libraries), "Failed to deploy contract.");
 			constructed = true;
+			gasMeasurement.deployGas = static_cast<uint64_t>(m_gasUsed);
+			gasMeasurement.codeSize = deployedCodeSize();
 		}
 
 		if (test.call().kind == FunctionCall::Kind::Storage)
@@ -223,6 +232,10 @@ TestCase::TestResult SemanticTest::runTest(ostream& _stream, string const& _line
 			test.setFailure(!m_transactionSuccessful);
 			test.setRawBytes(std::move(output));
 			test.setContractABI(m_compiler.contractABI(m_compiler.lastContractName()));
+			gasMeasurement.calls.push_back({
+				test.call().kind == FunctionCall::Kind::LowLevel ? "<low-level>" : test.call().signature,
+				static_cast<uint64_t>(m_gasUsed)
+			});
 		}
 	}
 
@@ -271,9 +284,22 @@ TestCase::TestResult SemanticTest::runTest(ostream& _stream, string const& _line
 		return TestResult::Failure;
 	}
 
+	string const configuration =
+		string(_compileToEwasm ? "ewasm" : _compileViaYul ? "ir" : "legacy") +
+		(solidity::test::CommonOptions::get().optimize ? "/optimized" : "/unoptimized");
+	if (GasReport::instance().enabled())
+		GasReport::instance().record(m_filename, configuration, std::move(gasMeasurement));
+	if (m_profiler)
+		GasProfile::instance().record(m_filename, configuration, m_profiler->samples());
+
 	return TestResult::Success;
 }
 
+uint64_t SemanticTest::deployedCodeSize()
+{
+	return m_evmcHost->get_code_size(solidity::test::EVMHost::convertToEVMC(m_contractAddress));
+}
+
 void SemanticTest::printSource(ostream& _stream, string const& _linePrefix, bool _formatted) const
 {
 	if (m_sources.sources.empty())
@@ -14,6 +14,8 @@
 
 #pragma once
 
+#include <test/libsolidity/util/GasProfile.h>
+#include <test/libsolidity/util/GasReport.h>
 #include <test/libsolidity/util/TestFileParser.h>
 #include <test/libsolidity/util/TestFunctionCall.h>
 #include <test/libsolidity/SolidityExecutionFramework.h>
@@ -60,6 +62,9 @@ public:
 	bool deploy(std::string const& _contractName, u256 const& _value, bytes const& _arguments, std::map<std::string, solidity::test::Address> const& _libraries = {});
 private:
 	TestResult runTest(std::ostream& _stream, std::string const& _linePrefix, bool _formatted, bool _compileViaYul, bool _compileToEwasm);
+	/// @returns the size of the code deployed at the address of the current contract.
+	uint64_t deployedCodeSize();
+	std::string m_filename;
 	SourceMap m_sources;
 	std::size_t m_lineOffset;
 	std::vector<TestFunctionCall> m_tests;
@@ -51,6 +51,61 @@ BOOST_AUTO_TEST_CASE(does_not_include_creation_time_only_internal_functions)
 	BOOST_CHECK(runtimeBytecode.size() <= 30);
 }
 
+BOOST_AUTO_TEST_CASE(structs_with_same_layout_share_abi_coders)
+{
+	char const* sourceCode = R"(
+		contract C {
+			struct S { uint a; bytes b; }
+			struct T { uint x; bytes y; }
+			struct U { bytes a; uint b; }
+			function f(S memory s, T memory t, U memory u) public pure returns (S memory, T memory, U memory) {
+				return (s, t, u);
+			}
+		}
+	)";
+	compiler().setViaIR(true);
+	BOOST_REQUIRE(success(sourceCode));
+	BOOST_REQUIRE_MESSAGE(compiler().compile(), "Compiling contract failed");
+	string const& ir = compiler().yulIR("C");
+	auto count = [&](string const& _needle) {
+		size_t occurrences = 0;
+		for (size_t pos = ir.find(_needle); pos != string::npos; pos = ir.find(_needle, pos + 1))
+			++occurrences;
+		return occurrences;
+	};
+	// S and T share their coders.
+	BOOST_CHECK_EQUAL(count("function abi_decode_t_struct_layout"), 2);
+	BOOST_CHECK_EQUAL(count("function abi_encode_t_struct_layout"), 2);
+}
+
+BOOST_AUTO_TEST_CASE(shared_library_functions_do_not_change_ir)
+{
+	char const* sourceCode = R"(
+		library L {
+			function f(uint a, uint b) internal pure returns (uint) { return a * b + g(a); }
+			function g(uint a) internal pure returns (uint) { unchecked { return a / 3 - 1; } }
+		}
+		function h(uint x) pure returns (uint) { return L.f(x, x + 1); }
+		contract B {
+			function b(uint x) public pure returns (uint) { return h(x) - L.g(x); }
+		}
+		contract A {
+			function a(uint x) public pure returns (uint) { return L.f(x, 2) + h(x); }
+		}
+	)";
+	// When compiling both contracts, A takes the library and free functions from B.
+	auto irOfA = [&](set<string> const& _contracts) {
+		CompilerStack compiler;
+		compiler.setSources({{"a.sol", "pragma solidity >=0.0;\n" + string(sourceCode)}});
+		compiler.setEVMVersion(solidity::test::CommonOptions::get().evmVersion());
+		compiler.setViaIR(true);
+		compiler.setRequestedContractNames({{"a.sol", _contracts}});
+		BOOST_REQUIRE(compiler.compile());
+		return compiler.yulIR("A");
+	};
+	BOOST_CHECK_EQUAL(irOfA({"A", "B"}), irOfA({"A"}));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }
@@ -25,6 +25,13 @@
 #include <iostream>
 #include <boost/test/framework.hpp>
 #include <test/libsolidity/SolidityExecutionFramework.h>
+#include <libsolidity/interface/CompilationCache.h>
+#include <libsolidity/ast/ASTVisitor.h>
+#include <libsolidity/codegen/ir/Common.h>
+#include <libyul/AST.h>
+#include <libyul/Object.h>
+#include <libyul/optimiser/ASTWalker.h>
+#include <liblangutil/CharStream.h>
 #include <liblangutil/Exceptions.h>
 #include <liblangutil/SourceReferenceFormatter.h>
 
@@ -34,6 +41,115 @@ using namespace solidity::frontend;
 using namespace solidity::frontend::test;
 using namespace std;
 
+namespace
+{
+
+/// @returns the cache of the code generation outputs selected via --compilation-cache, which
+/// all test cases share, or nullptr if none is selected.
+shared_ptr<CompilationCache const> compilationCache()
+{
+	static shared_ptr<CompilationCache const> const cache =
+		solidity::test::CommonOptions::get().compilationCache.empty() ?
+		nullptr :
+		make_shared<CompilationCache const>(solidity::test::CommonOptions::get().compilationCache);
+	return cache;
+}
+
+struct FunctionLocation
+{
+	int start;
+	int end;
+	string name;
+};
+
+/// @returns the name of the innermost of @a _functions that contains the range from @a _start
+/// to @a _end, or an empty string if there is none.
+string innermostFunction(vector<FunctionLocation> const& _functions, int _start, int _end)
+{
+	FunctionLocation const* innermost = nullptr;
+	for (FunctionLocation const& function: _functions)
+		if (
+			function.start <= _start &&
+			_end <= function.end &&
+			(!innermost || function.end - function.start < innermost->end - innermost->start)
+		)
+			innermost = &function;
+	return innermost ? innermost->name : "";
+}
+
+/// @returns the name of the line of the position @a _position in @a _charStream.
+string lineName(langutil::CharStream const& _charStream, int _position)
+{
+	int const line = get<0>(_charStream.translatePositionToLineColumn(_position)) + 1;
+	return (_charStream.name().empty() ? "line " : _charStream.name() + ":") + to_string(line);
+}
+
+/// Collects the functions and modifiers of a Solidity source, qualified by their contract.
+class SolidityFunctions: public ASTConstVisitor
+{
+public:
+	bool visit(ContractDefinition const& _contract) override
+	{
+		m_contract = _contract.name() + ".";
+		return true;
+	}
+	void endVisit(ContractDefinition const&) override { m_contract.clear(); }
+	bool visit(FunctionDefinition const& _function) override
+	{
+		string name =
+			_function.isConstructor() ? "constructor" :
+			_function.isFallback() ? "fallback" :
+			_function.isReceive() ? "receive" :
+			_function.name();
+		functions.push_back({_function.location().start, _function.location().end, m_contract + name});
+		return false;
+	}
+	bool visit(ModifierDefinition const& _modifier) override
+	{
+		functions.push_back({_modifier.location().start, _modifier.location().end, m_contract + _modifier.name()});
+		return false;
+	}
+
+	vector<FunctionLocation> functions;
+
+private:
+	string m_contract;
+};
+
+/// Collects the functions of a Yul object and its sub-objects.
+class YulFunctions: public yul::ASTWalker
+{
+public:
+	using yul::ASTWalker::operator();
+	void operator()(yul::FunctionDefinition const& _function) override
+	{
+		functions.push_back({_function.location.start, _function.location.end, _function.name.str()});
+		yul::ASTWalker::operator()(_function);
+	}
+	void collect(yul::Object const& _object)
+	{
+		(*this)(*_object.code);
+		for (auto const& subObject: _object.subObjects)
+			if (auto const* object = dynamic_cast<yul::Object const*>(subObject.get()))
+				collect(*object);
+	}
+
+	vector<FunctionLocation> functions;
+};
+
+/// @returns the offsets of the bytes of the immutables in @a _object.
+vector<size_t> immutableBytes(evmasm::LinkerObject const& _object)
+{
+	vector<size_t> offsets;
+	for (auto const& reference: _object.immutableReferences)
+		for (size_t offset: reference.second.second)
+			for (size_t i = 0; i < 32; ++i)
+				offsets.push_back(offset + i);
+	return offsets;
+}
+
+}
+
 bytes SolidityExecutionFramework::multiSourceCompileContract(
 	map<string, string> const& _sourceCode,
 	string const& _contractName,
@@ -54,6 +170,7 @@ bytes SolidityExecutionFramework::multiSourceCompileContract(
 	m_compiler.enableEvmBytecodeGeneration(!m_compileViaYul);
 	m_compiler.enableIRGeneration(m_compileViaYul);
 	m_compiler.setRevertStringBehaviour(m_revertStrings);
+	m_compiler.setCompilationCache(compilationCache());
 	if (!m_compiler.compile())
 	{
 		// The testing framework expects an exception for
@@ -62,7 +179,7 @@ bytes SolidityExecutionFramework::multiSourceCompileContract(
 			for (auto const& error: m_compiler.errors())
 				if (error->type() == langutil::Error::Type::CodeGenerationError)
 					BOOST_THROW_EXCEPTION(*error);
-		langutil::SourceReferenceFormatter formatter(std::cerr, true, false);
+		langutil::SourceReferenceFormatter formatter(std::cerr, m_compiler, true, false);
 
 		for (auto const& error: m_compiler.errors())
 			formatter.printErrorInformation(*error);
@@ -100,6 +217,8 @@ bytes SolidityExecutionFramework::multiSourceCompileContract(
 					asmStack.optimize();
 					obj = std::move(*asmStack.assemble(yul::AssemblyStack::Machine::EVM).bytecode);
 					obj.link(_libraryAddresses);
+					if (m_profiler)
+						addProfiledCode(contractName, asmStack);
 					break;
 				}
 				catch (...)
@@ -111,7 +230,11 @@ bytes SolidityExecutionFramework::multiSourceCompileContract(
 		}
 	}
 	else
+	{
 		obj = m_compiler.object(contractName);
+		if (m_profiler)
+			addProfiledCode();
+	}
 	BOOST_REQUIRE(obj.linkReferences.empty());
 	if (m_showMetadata)
 		cout << "metadata: " << m_compiler.metadata(contractName) << endl;
@@ -131,6 +254,72 @@ bytes SolidityExecutionFramework::compileContract(
 	);
 }
 
+void SolidityExecutionFramework::addProfiledCode()
+{
+	map<unsigned, string> sourceNames;
+	map<string, vector<FunctionLocation>> functions;
+	for (auto const& [sourceName, index]: m_compiler.sourceIndices())
+	{
+		sourceNames[index] = sourceName;
+		SolidityFunctions collector;
+		m_compiler.ast(sourceName).accept(collector);
+		functions[sourceName] = move(collector.functions);
+	}
+	auto line = [&](int _sourceIndex, int _start, int) {
+		if (!sourceNames.count(static_cast<unsigned>(_sourceIndex)))
+			return string{};
+		return lineName(*m_compiler.charStream(sourceNames.at(static_cast<unsigned>(_sourceIndex))), _start);
+	};
+	auto function = [&](int _sourceIndex, int _start, int _end) {
+		if (!sourceNames.count(static_cast<unsigned>(_sourceIndex)))
+			return string{};
+		return innermostFunction(functions.at(sourceNames.at(static_cast<unsigned>(_sourceIndex))), _start, _end);
+	};
+
+	for (string const& contractName: m_compiler.contractNames())
+	{
+		string const name = contractName.substr(contractName.rfind(':') + 1);
+		evmasm::LinkerObject const& creationObject = m_compiler.object(contractName);
+		if (creationObject.bytecode.empty())
+			continue;
+		evmasm::LinkerObject const& runtimeObject = m_compiler.runtimeObject(contractName);
+		m_profiler->addCode("new " + name, creationObject.bytecode, *m_compiler.sourceMapping(contractName), line, function, true);
+		m_profiler->addCode(
+			name,
+			runtimeObject.bytecode,
+			*m_compiler.runtimeSourceMapping(contractName),
+			line,
+			function,
+			false,
+			immutableBytes(runtimeObject)
+		);
+	}
+}
+
+void SolidityExecutionFramework::addProfiledCode(string const& _contractName, yul::AssemblyStack const& _stack)
+{
+	langutil::CharStream const ir(m_compiler.yulIROptimized(_contractName), "");
+	YulFunctions collector;
+	collector.collect(*_stack.parserResult());
+	auto line = [&](int, int _start, int) { return lineName(ir, _start); };
+	auto function = [&](int, int _start, int _end) { return innermostFunction(collector.functions, _start, _end); };
+
+	string const name = _contractName.substr(_contractName.rfind(':') + 1);
+	auto [creationObject, deployedObject] =
+		_stack.assembleWithDeployed(IRNames::deployedObject(m_compiler.contractDefinition(_contractName)));
+	m_profiler->addCode("new " + name, creationObject.bytecode->bytecode, *creationObject.sourceMappings, line, function, true);
+	if (deployedObject.bytecode)
+		m_profiler->addCode(
+			name,
+			deployedObject.bytecode->bytecode,
+			*deployedObject.sourceMappings,
+			line,
+			function,
+			false,
+			immutableBytes(*deployedObject.bytecode)
+		);
+}
+
 string SolidityExecutionFramework::addPreamble(string const& _sourceCode)
 {
 	// Silence compiler version warning
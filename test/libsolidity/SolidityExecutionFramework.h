@@ -73,6 +73,10 @@ public:
 	/// the latter only if it is forced.
 	static std::string addPreamble(std::string const& _sourceCode);
 protected:
+	/// Registers the code of all contracts compiled by m_compiler in the profiler.
+	void addProfiledCode();
+	/// Registers the code of the contract @a _contractName compiled via @a _stack in the profiler.
+	void addProfiledCode(std::string const& _contractName, yul::AssemblyStack const& _stack);
 
 	solidity::frontend::CompilerStack m_compiler;
 	bool m_compileViaYul = false;
@@ -21,9 +21,11 @@
  * Unit tests for the type system of Solidity.
  */
 
+#include <libsolidity/analysis/ConstantEvaluator.h>
 #include <libsolidity/ast/Types.h>
 #include <libsolidity/ast/TypeProvider.h>
 #include <libsolidity/ast/AST.h>
+#include <libsolutil/CompilationStatistics.h>
 #include <libsolutil/Keccak256.h>
 #include <boost/test/unit_test.hpp>
 
@@ -242,6 +244,93 @@ BOOST_AUTO_TEST_CASE(encoded_sizes)
 	BOOST_CHECK_EQUAL(twoDimArray.calldataEncodedSize(false), 9 * 3 * 32);
 }
 
+BOOST_AUTO_TEST_CASE(types_are_unique)
+{
+	TypeProvider provider;
+	TypeProvider::Scope scope(provider);
+
+	Type const* uint256 = TypeProvider::uint256();
+	ArrayType const* storageArray = TypeProvider::array(DataLocation::Storage, uint256);
+	BOOST_CHECK(TypeProvider::array(DataLocation::Storage, uint256) == storageArray);
+	BOOST_CHECK(TypeProvider::array(DataLocation::Storage, uint256, 3) != storageArray);
+
+	// Equal array types are the same object, independent of how they were created.
+	ReferenceType const* memoryArray = TypeProvider::withLocation(storageArray, DataLocation::Memory, false);
+	BOOST_CHECK(memoryArray == TypeProvider::array(DataLocation::Memory, uint256));
+	BOOST_CHECK(TypeProvider::withLocation(TypeProvider::bytesStorage(), DataLocation::Memory, true) == TypeProvider::bytesMemory());
+	BOOST_CHECK(TypeProvider::array(DataLocation::CallData, false) == TypeProvider::bytesCalldata());
+
+	BOOST_CHECK(TypeProvider::mapping(uint256, storageArray) == TypeProvider::mapping(uint256, storageArray));
+	BOOST_CHECK(TypeProvider::tuple({uint256, memoryArray}) == TypeProvider::tuple({uint256, memoryArray}));
+	BOOST_CHECK(TypeProvider::rationalNumber(rational(7, 3)) == TypeProvider::rationalNumber(rational(7, 3)));
+	BOOST_CHECK(TypeProvider::rationalNumber(rational(7, 3)) != TypeProvider::rationalNumber(rational(7, 2)));
+	BOOST_CHECK(TypeProvider::stringLiteral("abc") == TypeProvider::stringLiteral("abc"));
+}
+
+BOOST_AUTO_TEST_CASE(provider_per_scope)
+{
+	Type const* globalType = TypeProvider::array(DataLocation::Memory, TypeProvider::uint256());
+	TypeProvider provider;
+	{
+		TypeProvider::Scope scope(provider);
+		ArrayType const* type = TypeProvider::array(DataLocation::Memory, TypeProvider::uint256());
+		BOOST_CHECK(type != globalType);
+		BOOST_CHECK(*type == *globalType);
+		BOOST_CHECK(type->baseType() == TypeProvider::uint256());
+	}
+	BOOST_CHECK(TypeProvider::array(DataLocation::Memory, TypeProvider::uint256()) == globalType);
+}
+
+BOOST_AUTO_TEST_CASE(memoized_queries)
+{
+	TypeProvider provider;
+	TypeProvider::Scope scope(provider);
+
+	Type const* uint8 = TypeProvider::uint(8);
+	Type const* uint256 = TypeProvider::uint256();
+	for (size_t i = 0; i < 3; ++i)
+	{
+		BOOST_CHECK(uint8->isImplicitlyConvertibleTo(*uint256));
+		BoolResult narrowing = uint256->isImplicitlyConvertibleTo(*uint8);
+		BOOST_CHECK(!narrowing);
+		BOOST_CHECK(Type::commonType(uint8, uint256) == uint256);
+		BOOST_CHECK(uint8->binaryOperatorResult(Token::Add, uint256) == uint256);
+	}
+	// Types that do not belong to the provider are not memoized.
+	IntegerType uint16(16);
+	BOOST_CHECK(uint16.isImplicitlyConvertibleTo(*uint256));
+
+	util::CompilationStatistics statistics;
+	provider.recordStatistics(statistics);
+	util::CompilationStatistics::Cache const& implicitConversions = statistics.caches().at("types/implicitConversion");
+	BOOST_CHECK_EQUAL(implicitConversions.misses, 2);
+	BOOST_CHECK(implicitConversions.hits >= 4);
+	BOOST_CHECK_EQUAL(statistics.caches().at("types/commonType").misses, 1);
+	BOOST_CHECK_EQUAL(statistics.caches().at("types/binaryOperator").hits, 2);
+}
+
+BOOST_AUTO_TEST_CASE(literal_arithmetic)
+{
+	auto evaluate = [](Token _operator, rational const& _left, rational const& _right) {
+		optional<rational> result = ConstantEvaluator::evaluateBinaryOperator(_operator, _left, _right);
+		BOOST_REQUIRE(result);
+		return *result;
+	};
+	bigint const large = bigint(1) << 62;
+	BOOST_CHECK(evaluate(Token::Add, 1, 32) == 33);
+	BOOST_CHECK(evaluate(Token::Add, large - 1, large - 1) == 2 * large - 2);
+	BOOST_CHECK(evaluate(Token::Sub, -large + 1, large - 1) == -2 * large + 2);
+	BOOST_CHECK(evaluate(Token::Mul, bigint(1) << 40, bigint(1) << 40) == rational(bigint(1) << 80));
+	BOOST_CHECK(evaluate(Token::Mul, -3, 0xff) == -765);
+	BOOST_CHECK(evaluate(Token::Div, 7, 2) == rational(7, 2));
+	BOOST_CHECK(evaluate(Token::Div, -8, 2) == -4);
+	BOOST_CHECK(evaluate(Token::Mod, -7, 2) == -1);
+	BOOST_CHECK(evaluate(Token::BitAnd, 0xff, 0x3c) == 0x3c);
+	BOOST_CHECK(evaluate(Token::BitOr, -1, 6) == -1);
+	BOOST_CHECK(!ConstantEvaluator::evaluateBinaryOperator(Token::Div, 1, 0));
+	BOOST_CHECK(!ConstantEvaluator::evaluateBinaryOperator(Token::Mod, 1, 0));
+}
+
 BOOST_AUTO_TEST_CASE(helper_bool_result)
 {
 	BoolResult r1{true};
@@ -27,9 +27,12 @@
 #include <libsolidity/interface/Version.h>
 #include <libsolutil/JSON.h>
 #include <libsolutil/CommonData.h>
+#include <libsolutil/Keccak256.h>
+#include <libyul/YulString.h>
 #include <test/Metadata.h>
 
 #include <algorithm>
+#include <functional>
 #include <set>
 
 using namespace std;
@@ -269,6 +272,32 @@ BOOST_AUTO_TEST_CASE(smoke_test)
 	BOOST_CHECK(containsAtMostWarnings(result));
 }
 
+BOOST_AUTO_TEST_CASE(escaped_source_content)
+{
+	// The contents of the sources are decoded before the rest of the input is parsed.
+	string const content = "contract C {}\n// \xc3\xa9 \"x\"\t\\";
+	string const input = R"(
+	{
+		"language": "Solidity",
+		"sources": {
+			"A": {
+				"keccak256": ")" + util::toHex(util::keccak256(content).asBytes(), util::HexPrefix::Add) + R"(",
+				"content": "contract C {}\n// \u00e9 \"x\"\t\\"
+			},
+			"B": {
+				"keccak256": ")" + util::toHex(util::keccak256(content).asBytes(), util::HexPrefix::Add) + R"(",
+				"content": "contract D {}"
+			}
+		},
+		"settings": { "outputSelection": { "A": { "": ["ast"] } } }
+	}
+	)";
+	Json::Value result = compile(input);
+	BOOST_CHECK(containsError(result, "IOError", "Mismatch between content and supplied hash for \"B\""));
+	BOOST_CHECK(!containsError(result, "IOError", "Mismatch between content and supplied hash for \"A\""));
+	BOOST_CHECK(result["sources"]["A"]["ast"].isObject());
+}
+
 BOOST_AUTO_TEST_CASE(error_recovery_field)
 {
 	auto input = R"(
@@ -1234,6 +1263,157 @@ BOOST_AUTO_TEST_CASE(optimizer_settings_details_different)
 	BOOST_CHECK(optimizer["runs"].asUInt() == 600);
 }
 
+BOOST_AUTO_TEST_CASE(optimizer_settings_function_weights)
+{
+	string const frequent = util::FixedHash<4>(util::keccak256("f5()")).hex();
+	string const input = R"(
+	{
+		"language": "Solidity",
+		"settings": {
+			"outputSelection": {
+				"fileA": { "A": [ "metadata", "evm.deployedBytecode.object" ] }
+			},
+			"optimizer": { "runs": 100000, "functionWeights": { "0x)" + frequent + R"(": 1000, "0xABCDEF01": 1 } }
+		},
+		"sources": {
+			"fileA": {
+				"content": "contract A { function f0() public {} function f1() public {} function f2() public {} function f3() public {} function f4() public {} function f5() public {} }"
+			}
+		}
+	}
+	)";
+	Json::Value result = compile(input);
+	BOOST_CHECK(containsAtMostWarnings(result));
+	Json::Value contract = getContractResult(result, "fileA", "A");
+	BOOST_CHECK(contract.isObject());
+	Json::Value metadata;
+	BOOST_CHECK(util::jsonParseStrict(contract["metadata"].asString(), metadata));
+
+	Json::Value const& optimizer = metadata["settings"]["optimizer"];
+	BOOST_CHECK(optimizer["enabled"].asBool() == false);
+	BOOST_CHECK_EQUAL(optimizer["functionWeights"].getMemberNames().size(), 2);
+	BOOST_CHECK_EQUAL(optimizer["functionWeights"]["0x" + frequent].asUInt64(), 1000);
+	BOOST_CHECK_EQUAL(optimizer["functionWeights"]["0xabcdef01"].asUInt64(), 1);
+
+	// The frequently called function is checked for before splitting the other functions.
+	string const code = contract["evm"]["deployedBytecode"]["object"].asString();
+	size_t frequentCheck = code.find("63" + frequent + "14");
+	BOOST_REQUIRE(frequentCheck != string::npos);
+	for (string function: {"f0()", "f1()", "f2()", "f3()", "f4()"})
+	{
+		size_t check = code.find("63" + util::FixedHash<4>(util::keccak256(function)).hex());
+		BOOST_CHECK(check != string::npos && check > frequentCheck);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(optimizer_function_weights_invalid_selector)
+{
+	char const* input = R"(
+	{
+		"language": "Solidity",
+		"settings": {
+			"optimizer": { "functionWeights": { "transfer": 1 } }
+		},
+		"sources": {
+			"empty": {
+				"content": ""
+			}
+		}
+	}
+	)";
+	Json::Value result = compile(input);
+	BOOST_CHECK(containsError(result, "JSONError", "Function weights must be keyed by function selectors of the form \"0x12345678\"."));
+}
+
+BOOST_AUTO_TEST_CASE(optimizer_settings_yul_time_budget)
+{
+	char const* input = R"(
+	{
+		"language": "Solidity",
+		"settings": {
+			"viaIR": true,
+			"outputSelection": {
+				"fileA": { "A": [ "metadata", "evm.bytecode.object" ] }
+			},
+			"optimizer": { "enabled": true, "details": { "yul": true, "yulDetails": { "timeBudget": 0 } } }
+		},
+		"sources": {
+			"fileA": {
+				"content": "contract A { function f(uint x) public pure returns (uint) { return x * 2 + 1; } }"
+			}
+		}
+	}
+	)";
+	Json::Value result = compile(input);
+	BOOST_CHECK(containsAtMostWarnings(result));
+	Json::Value contract = getContractResult(result, "fileA", "A");
+	BOOST_REQUIRE(contract.isObject());
+	// The optimizer stops right away, but the code is still compiled.
+	BOOST_CHECK(contract["evm"]["bytecode"]["object"].asString().length() > 20);
+	Json::Value metadata;
+	BOOST_CHECK(util::jsonParseStrict(contract["metadata"].asString(), metadata));
+	// The output cannot be reproduced from the budget, so it is not recorded.
+	BOOST_CHECK(!metadata["settings"]["optimizer"]["details"]["yulDetails"].isMember("timeBudget"));
+}
+
+BOOST_AUTO_TEST_CASE(optimizer_settings_yul_stack_layout)
+{
+	auto compileWith = [&](bool _stackLayout)
+	{
+		string input = R"(
+		{
+			"language": "Solidity",
+			"settings": {
+				"viaIR": true,
+				"outputSelection": {
+					"fileA": { "A": [ "metadata", "evm.bytecode.object" ] }
+				},
+				"optimizer": { "enabled": true, "details": { "yul": true, "yulDetails": { "stackLayout": )" +
+					string(_stackLayout ? "true" : "false") + R"( } } }
+			},
+			"sources": {
+				"fileA": {
+					"content": "contract A { function f(uint x, uint y) public pure returns (uint) { return (x + y) * (x - y) + x; } }"
+				}
+			}
+		}
+		)";
+		Json::Value result = compile(input);
+		BOOST_CHECK(containsAtMostWarnings(result));
+		Json::Value contract = getContractResult(result, "fileA", "A");
+		BOOST_REQUIRE(contract.isObject());
+		return contract;
+	};
+
+	Json::Value withoutLayout = compileWith(false);
+	Json::Value withLayout = compileWith(true);
+	BOOST_CHECK(withLayout["evm"]["bytecode"]["object"].asString().length() > 20);
+	Json::Value metadata;
+	BOOST_CHECK(util::jsonParseStrict(withLayout["metadata"].asString(), metadata));
+	BOOST_CHECK(metadata["settings"]["optimizer"]["details"]["yulDetails"]["stackLayout"].asBool());
+	BOOST_CHECK(util::jsonParseStrict(withoutLayout["metadata"].asString(), metadata));
+	BOOST_CHECK(!metadata["settings"]["optimizer"]["details"]["yulDetails"].isMember("stackLayout"));
+}
+
+BOOST_AUTO_TEST_CASE(optimizer_settings_yul_time_budget_invalid)
+{
+	char const* input = R"(
+	{
+		"language": "Solidity",
+		"settings": {
+			"optimizer": { "details": { "yul": true, "yulDetails": { "timeBudget": "fast" } } }
+		},
+		"sources": {
+			"empty": {
+				"content": ""
+			}
+		}
+	}
+	)";
+	Json::Value result = compile(input);
+	BOOST_CHECK(containsError(result, "JSONError", "The \"timeBudget\" setting must be an unsigned number of milliseconds."));
+}
+
 BOOST_AUTO_TEST_CASE(metadata_without_compilation)
 {
 	// NOTE: the contract code here should fail to compile due to "out of stack"
@@ -1755,6 +1935,646 @@ BOOST_AUTO_TEST_CASE(dependency_tracking_of_abstract_contract_yul)
 	BOOST_REQUIRE(result["sources"].size() == 1);
 }
 
+BOOST_AUTO_TEST_CASE(parallelism_invalid_type)
+{
+	char const* input = R"(
+	{
+		"language": "Solidity",
+		"sources":
+		{ "": { "content": "pragma solidity >=0.0; contract C { function f() public pure {} }" } },
+		"settings":
+		{
+			"parallelism": "4",
+			"outputSelection":
+			{
+				"*": { "C": ["evm.bytecode"] }
+			}
+		}
+	}
+	)";
+	Json::Value result = compile(input);
+	BOOST_CHECK(containsError(result, "JSONError", "\"settings.parallelism\" must be an unsigned integer."));
+}
+
+BOOST_AUTO_TEST_CASE(parallelism_does_not_change_output)
+{
+	auto compileWithParallelism = [](unsigned _threads) {
+		string input = R"(
+		{
+			"language": "Solidity",
+			"sources": {
+				"A.sol": {
+					"content": "contract A { function f() public pure returns (uint) { return 1; } } contract B { function g() public returns (address) { return address(new A()); } } contract C { uint[] x; function h() public { x.push(2); new B(); } }"
+				}
+			},
+			"settings": {
+				"viaIR": true,
+				"optimizer": { "enabled": true },
+				"parallelism": )" + to_string(_threads) + R"(,
+				"outputSelection": { "*": { "*": ["evm.bytecode", "evm.deployedBytecode", "irOptimized"] } }
+			}
+		}
+		)";
+		Json::Value parsedInput;
+		BOOST_REQUIRE(util::jsonParseStrict(input, parsedInput));
+		solidity::frontend::StandardCompiler compiler;
+		return compiler.compile(parsedInput);
+	};
+
+	Json::Value serialResult = compileWithParallelism(1);
+	BOOST_REQUIRE(containsAtMostWarnings(serialResult));
+	for (char const* contract: {"A", "B", "C"})
+		BOOST_REQUIRE(!serialResult["contracts"]["A.sol"][contract]["evm"]["bytecode"]["object"].asString().empty());
+	BOOST_CHECK(compileWithParallelism(4) == serialResult);
+	BOOST_CHECK(compileWithParallelism(0) == serialResult);
+}
+
+BOOST_AUTO_TEST_CASE(parallel_parsing_does_not_change_output)
+{
+	auto compileWithParallelism = [](unsigned _threads) {
+		string input = R"(
+		{
+			"language": "Solidity",
+			"sources": {
+				"A.sol": { "content": "import \"B.sol\"; import \"C.sol\"; contract A is B, C { function f() public pure returns (uint) { return g() + h(); } }" },
+				"B.sol": { "content": "import \"D.sol\"; contract B { function g() internal pure returns (uint) { return D.d(); } }" },
+				"C.sol": { "content": "import \"D.sol\"; contract C { function h() internal pure returns (uint) { uint x; assembly { x := 7 } return x; } }" },
+				"D.sol": { "content": "library D { function d() internal pure returns (uint) { return 1; } } contract E { function e() public {} }" }
+			},
+			"settings": {
+				"parallelism": )" + to_string(_threads) + R"(,
+				"outputSelection": { "*": { "*": ["evm.bytecode", "abi"], "": ["ast"] } }
+			}
+		}
+		)";
+		Json::Value parsedInput;
+		BOOST_REQUIRE(util::jsonParseStrict(input, parsedInput));
+		solidity::frontend::StandardCompiler compiler;
+		return compiler.compile(parsedInput);
+	};
+
+	Json::Value serialResult = compileWithParallelism(1);
+	BOOST_REQUIRE(containsAtMostWarnings(serialResult));
+	BOOST_REQUIRE(serialResult["sources"].size() == 4);
+	BOOST_CHECK(compileWithParallelism(4) == serialResult);
+	BOOST_CHECK(compileWithParallelism(0) == serialResult);
+}
+
+BOOST_AUTO_TEST_CASE(parallel_ir_generation_does_not_change_output)
+{
+	auto compileWithParallelism = [](unsigned _threads) {
+		string input = R"(
+		{
+			"language": "Solidity",
+			"sources": {
+				"A.sol": {
+					"content": "uint constant K = 7 + 8; abstract contract B { uint public y; modifier m(uint a) { y += a; _; } function b(uint a) internal virtual returns (uint) { return a + K; } } contract A is B { uint[] x; function() internal returns (uint) p; function f(uint a) public m(a) returns (uint) { p = g; return h(a) + b(a); } function g() internal returns (uint) { x.push(1); return k(2); } function h(uint a) internal returns (uint r) { assembly { r := add(a, 1) } r += g(); } function k(uint a) internal pure returns (uint) { return a * K; } function b(uint a) internal override returns (uint) { return super.b(a) + p(); } function q() public returns (uint) { return k(3) + g(); } }"
+				}
+			},
+			"settings": {
+				"viaIR": true,
+				"parallelism": )" + to_string(_threads) + R"(,
+				"outputSelection": { "*": { "*": ["ir", "evm.bytecode"] } }
+			}
+		}
+		)";
+		Json::Value parsedInput;
+		BOOST_REQUIRE(util::jsonParseStrict(input, parsedInput));
+		solidity::frontend::StandardCompiler compiler;
+		return compiler.compile(parsedInput);
+	};
+
+	Json::Value serialResult = compileWithParallelism(1);
+	BOOST_REQUIRE(containsAtMostWarnings(serialResult));
+	BOOST_REQUIRE(!serialResult["contracts"]["A.sol"]["A"]["ir"].asString().empty());
+	BOOST_CHECK(compileWithParallelism(4) == serialResult);
+	BOOST_CHECK(compileWithParallelism(0) == serialResult);
+}
+
+BOOST_AUTO_TEST_CASE(parallel_parsing_unique_ast_ids_with_import_aliases)
+{
+	// The aliased symbols of an import are not visited by the AST walk, but are nodes with
+	// IDs of their own. They have to be shifted together with the other nodes of their source.
+	char const* input = R"(
+	{
+		"language": "Solidity",
+		"sources": {
+			"A.sol": { "content": "contract A { function f() public {} } contract D {}" },
+			"B.sol": { "content": "import {A as X, D} from \"A.sol\"; contract B is X { D d; }" }
+		},
+		"settings": {
+			"parallelism": 2,
+			"outputSelection": { "*": { "": ["ast"] } }
+		}
+	}
+	)";
+	Json::Value result = compile(input);
+	BOOST_REQUIRE(containsAtMostWarnings(result));
+
+	set<Json::Int64> ids;
+	size_t nodeCount = 0;
+	function<void(Json::Value const&)> collectIDs = [&](Json::Value const& _node) {
+		if (_node.isObject() && _node.isMember("nodeType"))
+		{
+			++nodeCount;
+			ids.insert(_node["id"].asInt64());
+		}
+		if (_node.isObject() || _node.isArray())
+			for (auto const& child: _node)
+				collectIDs(child);
+	};
+	for (string source: {"A.sol", "B.sol"})
+		collectIDs(result["sources"][source]["ast"]);
+
+	Json::Value const& import = result["sources"]["B.sol"]["ast"]["nodes"][0];
+	BOOST_REQUIRE_EQUAL(import["nodeType"].asString(), "ImportDirective");
+	BOOST_REQUIRE_EQUAL(import["symbolAliases"].size(), 2);
+	BOOST_CHECK_EQUAL(ids.size(), nodeCount);
+	// The IDs of a source follow those of the sources before it.
+	Json::Int64 const lastIDOfA = result["sources"]["A.sol"]["ast"]["id"].asInt64();
+	for (auto const& alias: import["symbolAliases"])
+		BOOST_CHECK(alias["foreign"]["id"].asInt64() > lastIDOfA);
+}
+
+BOOST_AUTO_TEST_CASE(kept_state_does_not_change_output)
+{
+	auto makeInput = [](string const& _contract) {
+		string input = R"(
+		{
+			"language": "Solidity",
+			"sources": {
+				"A.sol": {
+					"content": "library L { function f() internal pure returns (uint) { return 1; } }"
+				},
+				"B.sol": {
+					"content": "import \"A.sol\"; )" + _contract + R"("
+				}
+			},
+			"settings": {
+				"outputSelection": { "*": { "*": ["evm.bytecode", "abi"], "": ["ast"] } }
+			}
+		}
+		)";
+		Json::Value parsedInput;
+		BOOST_REQUIRE(util::jsonParseStrict(input, parsedInput));
+		return parsedInput;
+	};
+	Json::Value const input = makeInput("contract C { function g() public pure returns (uint) { return L.f(); } }");
+
+	Json::Value freshResult = solidity::frontend::StandardCompiler{}.compile(input);
+	BOOST_REQUIRE(containsAtMostWarnings(freshResult));
+
+	solidity::frontend::StandardCompiler compiler({}, true);
+	BOOST_CHECK(compiler.compile(input) == freshResult);
+	BOOST_CHECK(compiler.compile(input) == freshResult);
+	Json::Value changedResult = compiler.compile(makeInput("contract D { function h() public pure returns (uint) { return L.f() + 1; } }"));
+	BOOST_CHECK(containsAtMostWarnings(changedResult));
+	BOOST_CHECK(changedResult["contracts"]["B.sol"].isMember("D"));
+	BOOST_CHECK(!changedResult["contracts"]["B.sol"].isMember("C"));
+}
+
+BOOST_AUTO_TEST_CASE(kept_state_bounds_yul_strings)
+{
+	size_t const maxYulStrings = 2000;
+	solidity::frontend::StandardCompiler compiler({}, true);
+	compiler.setKeptStringLimits(maxYulStrings, 1 << 20);
+	size_t const initialGeneration = yul::YulStringRepository::generation();
+	for (size_t i = 0; i < 100; ++i)
+	{
+		// Every compilation adds distinct names in inline assembly.
+		string body;
+		for (size_t j = 0; j < 50; ++j)
+			body += "let v" + to_string(i) + "_" + to_string(j) + " := " + to_string(j) + " ";
+		string const input = R"({
+			"language": "Solidity",
+			"sources": { "A.sol": { "content": "contract C { function f() public pure { assembly { )" + body + R"(} } }" } },
+			"settings": { "outputSelection": { "*": { "*": ["evm.bytecode.object"] } } }
+		})";
+		Json::Value result;
+		BOOST_REQUIRE(util::jsonParseStrict(compiler.compile(input), result));
+		BOOST_REQUIRE(containsAtMostWarnings(result));
+		BOOST_CHECK(!result["contracts"]["A.sol"]["C"]["evm"]["bytecode"]["object"].asString().empty());
+		// The repository is reset before a compilation, which can then add its own strings.
+		BOOST_CHECK_LT(yul::YulStringRepository::instance().size(), 2 * maxYulStrings);
+	}
+	BOOST_CHECK_GT(yul::YulStringRepository::generation(), initialGeneration);
+}
+
+BOOST_AUTO_TEST_CASE(unrequested_dependency_via_ir)
+{
+	auto makeInput = [](string const& _outputSelection) {
+		return R"(
+		{
+			"language": "Solidity",
+			"sources": {
+				"A.sol": {
+					"content": "contract Child { uint public x = 7; } contract Factory { function f() public returns (address) { return address(new Child()); } }"
+				}
+			},
+			"settings": {
+				"viaIR": true,
+				"optimizer": { "enabled": true },
+				"outputSelection": )" + _outputSelection + R"(
+			}
+		}
+		)";
+	};
+	Json::Value all = compile(makeInput(R"({ "A.sol": { "*": ["evm.bytecode.object", "irOptimized"] } })"));
+	BOOST_REQUIRE(containsAtMostWarnings(all));
+	Json::Value onlyFactory = compile(makeInput(R"({ "A.sol": { "Factory": ["evm.bytecode.object", "irOptimized"] } })"));
+	BOOST_REQUIRE(containsAtMostWarnings(onlyFactory));
+
+	BOOST_CHECK(getContractResult(onlyFactory, "A.sol", "Child").isNull());
+	BOOST_CHECK_EQUAL(
+		getContractResult(onlyFactory, "A.sol", "Factory")["evm"]["bytecode"]["object"].asString(),
+		getContractResult(all, "A.sol", "Factory")["evm"]["bytecode"]["object"].asString()
+	);
+	BOOST_CHECK_EQUAL(
+		getContractResult(onlyFactory, "A.sol", "Factory")["irOptimized"].asString(),
+		getContractResult(all, "A.sol", "Factory")["irOptimized"].asString()
+	);
+}
+
+BOOST_AUTO_TEST_CASE(compilation_statistics)
+{
+	char const* input = R"(
+	{
+		"language": "Solidity",
+		"sources": {
+			"A.sol": {
+				"content": "contract A { function f(uint x) public pure returns (uint) { return x * 2; } } contract B { function g() public returns (address) { return address(new A()); } }"
+			}
+		},
+		"settings": {
+			"optimizer": { "enabled": true, "details": { "yul": true } },
+			"outputSelection": { "A.sol": { "B": ["evm.bytecode.object", "compilationStats"] } }
+		}
+	}
+	)";
+	Json::Value result = compile(input);
+	BOOST_REQUIRE(containsAtMostWarnings(result));
+
+	Json::Value const& statistics = result["compilationStats"];
+	BOOST_REQUIRE(statistics.isObject());
+	for (string phase: {"parsing", "analysis", "analysis/typeChecker", "compilation", "evmCodeGeneration", "assembly"})
+	{
+		BOOST_REQUIRE_MESSAGE(statistics["phases"].isMember(phase), phase);
+		BOOST_CHECK(statistics["phases"][phase]["runs"].asUInt64() >= 1);
+		BOOST_CHECK(statistics["phases"][phase]["time"].isUInt64());
+		BOOST_CHECK(statistics["phases"][phase]["peakMemory"].isUInt64());
+	}
+	BOOST_CHECK_EQUAL(statistics["phases"]["parsing"]["runs"].asUInt64(), 1u);
+
+	Json::Value const& contractStatistics = getContractResult(result, "A.sol", "B")["compilationStats"];
+	BOOST_REQUIRE(contractStatistics.isObject());
+	BOOST_CHECK(contractStatistics["phases"].isMember("evmCodeGeneration"));
+	BOOST_CHECK(!contractStatistics["phases"].isMember("parsing"));
+	// A is compiled as a dependency of B, but did not request the statistics.
+	BOOST_CHECK(getContractResult(result, "A.sol", "A").isNull());
+	BOOST_CHECK(statistics["phases"]["evmCodeGeneration"]["runs"].asUInt64() > contractStatistics["phases"]["evmCodeGeneration"]["runs"].asUInt64());
+
+	// Only the runs of a step that changed the code are counted as changes.
+	for (string const& step: statistics["optimiserSteps"].getMemberNames())
+	{
+		Json::Value const& stepStatistics = statistics["optimiserSteps"][step];
+		BOOST_CHECK(stepStatistics["changes"].asUInt64() <= stepStatistics["runs"].asUInt64());
+	}
+	BOOST_CHECK(statistics["caches"]["types/implicitConversion"]["misses"].asUInt64() > 0);
+	BOOST_CHECK(statistics["caches"]["types/implicitConversion"]["hits"].isUInt64());
+	BOOST_REQUIRE(statistics["counters"].isObject());
+	for (string const& counter: statistics["counters"].getMemberNames())
+		BOOST_CHECK(statistics["counters"][counter].asUInt64() > 0);
+
+	Json::Value const& memory = statistics["memory"];
+	for (string subsystem: {"ast", "annotations", "types", "yulStrings", "yulAST", "evmAssembly", "smtEncoding", "jsonOutput"})
+	{
+		BOOST_REQUIRE_MESSAGE(memory["subsystems"].isMember(subsystem), subsystem);
+		BOOST_CHECK(memory["subsystems"][subsystem]["bytes"].asUInt64() <= memory["subsystems"][subsystem]["peakBytes"].asUInt64());
+	}
+	for (string subsystem: {"ast", "annotations", "types", "evmAssembly"})
+		BOOST_CHECK_MESSAGE(memory["subsystems"][subsystem]["peakBytes"].asUInt64() > 0, subsystem);
+	BOOST_REQUIRE(memory["measurements"].isObject());
+	BOOST_CHECK(!memory["measurements"].empty());
+}
+
+BOOST_AUTO_TEST_CASE(compilation_statistics_not_selected_by_wildcard)
+{
+	char const* input = R"(
+	{
+		"language": "Solidity",
+		"sources": {
+			"A.sol": {
+				"content": "contract A { }"
+			}
+		},
+		"settings": {
+			"outputSelection": { "*": { "*": ["*"], "": ["*"] } }
+		}
+	}
+	)";
+	Json::Value result = compile(input);
+	BOOST_REQUIRE(containsAtMostWarnings(result));
+	BOOST_CHECK(!result.isMember("compilationStats"));
+	BOOST_CHECK(!getContractResult(result, "A.sol", "A").isMember("compilationStats"));
+}
+
+BOOST_AUTO_TEST_CASE(compilation_statistics_model_checker)
+{
+	char const* input = R"(
+	{
+		"language": "Solidity",
+		"sources": {
+			"A.sol": {
+				"content": "pragma experimental SMTChecker; contract A { function f(uint x) public pure { assert(x > 0); } }"
+			}
+		},
+		"settings": {
+			"modelChecker": { "engine": "bmc" },
+			"outputSelection": { "*": { "": ["compilationStats"] } }
+		}
+	}
+	)";
+	Json::Value result = compile(input);
+	BOOST_REQUIRE(result.isMember("compilationStats"));
+	Json::Value const& statistics = result["compilationStats"]["modelChecker"];
+	BOOST_REQUIRE(statistics.isArray());
+	for (Json::Value const& target: statistics)
+	{
+		BOOST_CHECK_EQUAL(target["engine"].asString(), "bmc");
+		BOOST_CHECK(target["target"].isString());
+		BOOST_CHECK(target["result"].isString());
+		BOOST_CHECK(target["encodingTime"].isUInt64());
+		BOOST_CHECK(target["solvingTime"].isUInt64());
+		BOOST_CHECK(target["querySize"].isUInt64());
+		BOOST_CHECK_EQUAL(target["sourceLocation"]["file"].asString(), "A.sol");
+	}
+}
+
+BOOST_AUTO_TEST_CASE(deduplicate_output_metadata_sources)
+{
+	auto compileWithDeduplication = [](bool _deduplicate) {
+		string input = R"(
+		{
+			"language": "Solidity",
+			"sources": {
+				"A.sol": { "content": "// SPDX-License-Identifier: GPL-3.0\nimport \"C.sol\"; contract A is C {}" },
+				"B.sol": { "content": "import \"C.sol\"; contract B is C {}" },
+				"C.sol": { "content": "contract C { function c() public pure {} }" }
+			},
+			"settings": {
+				"deduplicateOutput": )" + string(_deduplicate ? "true" : "false") + R"(,
+				"outputSelection": { "*": { "*": ["metadata"] } }
+			}
+		}
+		)";
+		Json::Value parsedInput;
+		BOOST_REQUIRE(util::jsonParseStrict(input, parsedInput));
+		solidity::frontend::StandardCompiler compiler;
+		return compiler.compile(parsedInput);
+	};
+
+	Json::Value result = compileWithDeduplication(false);
+	BOOST_REQUIRE(containsAtMostWarnings(result));
+	BOOST_CHECK(!result.isMember("metadataSources"));
+	Json::Value deduplicatedResult = compileWithDeduplication(true);
+	BOOST_REQUIRE(containsAtMostWarnings(deduplicatedResult));
+
+	Json::Value const& metadataSources = deduplicatedResult["metadataSources"];
+	BOOST_CHECK(metadataSources.getMemberNames() == (vector<string>{"A.sol", "B.sol", "C.sol"}));
+	for (auto const& [file, contract]: vector<pair<string, string>>{{"A.sol", "A"}, {"B.sol", "B"}, {"C.sol", "C"}})
+	{
+		Json::Value metadata;
+		BOOST_REQUIRE(util::jsonParseStrict(deduplicatedResult["contracts"][file][contract]["metadata"].asString(), metadata));
+		BOOST_REQUIRE(metadata["sources"].isArray());
+		Json::Value sources(Json::objectValue);
+		for (Json::Value const& sourceName: metadata["sources"])
+			sources[sourceName.asString()] = metadataSources[sourceName.asString()];
+		metadata["sources"] = sources;
+		BOOST_CHECK_EQUAL(util::jsonCompactPrint(metadata), result["contracts"][file][contract]["metadata"].asString());
+	}
+}
+
+BOOST_AUTO_TEST_CASE(skip_unrequested_sources)
+{
+	auto compile = [](bool _skip) {
+		string input = R"(
+		{
+			"language": "Solidity",
+			"sources": {
+				"A.sol": { "content": "import \"B.sol\"; contract A is B {}" },
+				"B.sol": { "content": "import \"C.sol\"; contract B { C c; }" },
+				"C.sol": { "content": "contract C {}" },
+				"D.sol": { "content": "contract D { syntax error }" }
+			},
+			"settings": {
+				"skipUnrequestedSources": )" + string(_skip ? "true" : "false") + R"(,
+				"outputSelection": { "A.sol": { "A": ["abi"], "": ["ast"] } }
+			}
+		}
+		)";
+		Json::Value parsedInput;
+		BOOST_REQUIRE(util::jsonParseStrict(input, parsedInput));
+		solidity::frontend::StandardCompiler compiler;
+		return compiler.compile(parsedInput);
+	};
+
+	BOOST_CHECK(!containsAtMostWarnings(compile(false)));
+
+	// D.sol is not imported by the requested source and therefore not parsed.
+	Json::Value result = compile(true);
+	BOOST_REQUIRE(containsAtMostWarnings(result));
+	BOOST_CHECK(result["contracts"]["A.sol"]["A"]["abi"].isArray());
+	BOOST_CHECK(result["sources"]["A.sol"]["ast"].isObject());
+	for (string source: {"A.sol", "B.sol", "C.sol", "D.sol"})
+		BOOST_CHECK(result["sources"][source]["id"].isUInt());
+}
+
+BOOST_AUTO_TEST_CASE(jobs_match_separate_compilations)
+{
+	string const sources = R"(
+		"sources": {
+			"A.sol": { "content": "import \"B.sol\"; contract A is B { function f() public pure returns (uint) { return g() + 1; } }" },
+			"B.sol": { "content": "/// @title B\ncontract B { function g() internal pure returns (uint) { return 7; } function h() public { uint x; } }" }
+		}
+	)";
+	vector<string> const settings{
+		R"({ "outputSelection": { "*": { "*": ["evm.bytecode", "metadata", "devdoc"], "": ["ast"] } } })",
+		R"({ "viaIR": true, "optimizer": { "enabled": true, "runs": 1000 }, "outputSelection": { "*": { "*": ["evm.bytecode", "irOptimized", "devdoc"] } } })",
+		R"({ "evmVersion": "istanbul", "outputSelection": { "*": { "*": ["evm.deployedBytecode", "metadata"] } } })",
+		R"({ "optimizer": { "enabled": true }, "outputSelection": { "*": { "*": ["evm.bytecode", "metadata"], "": ["ast"] } } })"
+	};
+
+	string jobs;
+	for (string const& jobSettings: settings)
+		jobs += (jobs.empty() ? "" : ",") + string(R"({ "settings": )") + jobSettings + "}";
+	Json::Value result = compile(R"({ "language": "Solidity", )" + sources + R"(, "jobs": [)" + jobs + "] }");
+	BOOST_REQUIRE(result["jobs"].isArray());
+	BOOST_REQUIRE_EQUAL(result["jobs"].size(), settings.size());
+	for (size_t i = 0; i < settings.size(); ++i)
+	{
+		Json::Value separateResult = compile(R"({ "language": "Solidity", )" + sources + R"(, "settings": )" + settings[i] + "}");
+		// The unused variable is reported by every job.
+		BOOST_REQUIRE(containsAtMostWarnings(separateResult));
+		BOOST_REQUIRE(!separateResult["errors"].empty());
+		BOOST_CHECK(result["jobs"][Json::ArrayIndex(i)] == separateResult);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(jobs_via_ir_share_analysis)
+{
+	// The jobs share one analysis and generate code concurrently, which must not build the call
+	// graphs in the shared annotations more than once.
+	string const sources = R"(
+		"sources": {
+			"A.sol": { "content": "import \"B.sol\"; contract A { function f() public returns (uint) { return new B().g() + 1; } }" },
+			"B.sol": { "content": "contract B { function g() public pure returns (uint) { return 7; } }" }
+		}
+	)";
+	vector<string> settings;
+	for (string runs: {"1", "200", "1000", "10000"})
+		settings.emplace_back(
+			R"({ "viaIR": true, "parallelism": 0, "optimizer": { "enabled": true, "runs": )" + runs +
+			R"( }, "outputSelection": { "*": { "*": ["evm.bytecode", "irOptimized"] } } })"
+		);
+
+	string jobs;
+	for (string const& jobSettings: settings)
+		jobs += (jobs.empty() ? "" : ",") + string(R"({ "settings": )") + jobSettings + "}";
+	Json::Value result = compile(R"({ "language": "Solidity", )" + sources + R"(, "jobs": [)" + jobs + "] }");
+	BOOST_REQUIRE(result["jobs"].isArray());
+	BOOST_REQUIRE_EQUAL(result["jobs"].size(), settings.size());
+	for (size_t i = 0; i < settings.size(); ++i)
+	{
+		Json::Value separateResult = compile(R"({ "language": "Solidity", )" + sources + R"(, "settings": )" + settings[i] + "}");
+		BOOST_REQUIRE(containsAtMostWarnings(separateResult));
+		BOOST_CHECK(!separateResult["contracts"]["A.sol"]["A"]["evm"]["bytecode"]["object"].asString().empty());
+		BOOST_CHECK(result["jobs"][Json::ArrayIndex(i)] == separateResult);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(parallel_code_generation_reports_first_failure)
+{
+	// The code of every contract is too deep to be generated, but compiling serially stops
+	// at the first one, so only its error is reported with any parallelism.
+	string contracts;
+	for (size_t i = 0; i < 4; ++i)
+	{
+		string variables;
+		string sum;
+		for (size_t j = 0; j < 20; ++j)
+		{
+			string name = "c" + to_string(i) + "_" + to_string(j);
+			variables += "let " + name + " := calldataload(" + to_string(32 * j) + ") ";
+			sum = sum.empty() ? name : "add(" + sum + ", " + name + ")";
+		}
+		contracts += "contract C" + to_string(i) + " { fallback() external { assembly { " + variables + "sstore(0, " + sum + ") } } } ";
+	}
+	auto compileWithParallelism = [&](string const& _parallelism) {
+		return compile(R"({
+			"language": "Solidity",
+			"sources": { "A.sol": { "content": ")" + contracts + R"(" } },
+			"settings": {
+				"viaIR": true,
+				"parallelism": )" + _parallelism + R"(,
+				"outputSelection": { "*": { "*": ["evm.bytecode.object"] } }
+			}
+		})");
+	};
+	Json::Value serial = compileWithParallelism("1");
+	BOOST_REQUIRE(!containsAtMostWarnings(serial));
+	BOOST_CHECK(serial["errors"].size() == 1);
+	BOOST_CHECK(serial["errors"][0]["message"].asString().find("c0_") != string::npos);
+	for (size_t run = 0; run < 5; ++run)
+		BOOST_CHECK(compileWithParallelism("0") == serial);
+}
+
+BOOST_AUTO_TEST_CASE(jobs_invalid)
+{
+	string const sources = R"("sources": { "A.sol": { "content": "contract A {}" } })";
+	Json::Value result = compile(R"({ "language": "Solidity", )" + sources + R"(, "settings": {}, "jobs": [{}] })");
+	BOOST_CHECK(containsError(result, "JSONError", "\"settings\" cannot be used together with \"jobs\", every job has its own settings."));
+	result = compile(R"({ "language": "Solidity", )" + sources + R"(, "jobs": [] })");
+	BOOST_CHECK(containsError(result, "JSONError", "\"jobs\" must be a non-empty array."));
+	result = compile(R"({ "language": "Solidity", )" + sources + R"(, "jobs": [{ "optimizer": {} }] })");
+	BOOST_CHECK(containsError(result, "JSONError", "Unknown key \"optimizer\""));
+	result = compile(R"({ "language": "Solidity", )" + sources + R"(, "jobs": [{ "settings": { "evmVersion": "unknown" } }] })");
+	BOOST_CHECK(containsError(result, "JSONError", "Invalid EVM version requested."));
+}
+
+BOOST_AUTO_TEST_CASE(optimization_profiles)
+{
+	string const input = R"({
+		"language": "Solidity",
+		"sources": {
+			"A.sol": { "content": "contract A { function f() public pure returns (uint) { return 1; } } contract B { function f() public pure returns (uint) { return 2; } }" }
+		},
+		"settings": {
+			"optimizer": { "enabled": true },
+			"optimizationProfiles": {
+				"A.sol:B": { "optimizer": { "enabled": true, "runs": 1 }, "viaIR": true },
+				"A.sol:X": { "viaIR": true }
+			},
+			"outputSelection": { "*": { "*": ["metadata", "evm.bytecode.object"] } }
+		}
+	})";
+	Json::Value result = compile(input);
+	BOOST_REQUIRE(containsAtMostWarnings(result));
+	BOOST_CHECK(containsError(result, "Warning", "Optimisation profile of unknown contract \"A.sol:X\" is ignored."));
+	string const metadataA = result["contracts"]["A.sol"]["A"]["metadata"].asString();
+	string const metadataB = result["contracts"]["A.sol"]["B"]["metadata"].asString();
+	BOOST_CHECK(metadataA.find("\"optimizer\":{\"enabled\":true,\"runs\":200}") != string::npos);
+	BOOST_CHECK(metadataA.find("\"viaIR\"") == string::npos);
+	BOOST_CHECK(metadataB.find("\"optimizer\":{\"enabled\":true,\"runs\":1}") != string::npos);
+	BOOST_CHECK(metadataB.find("\"viaIR\":true") != string::npos);
+
+	result = compile(R"({
+		"language": "Solidity",
+		"sources": { "A.sol": { "content": "contract A { function f() public { new B(); } } contract B {}" } },
+		"settings": {
+			"optimizationProfiles": { "A.sol:B": { "viaIR": true } },
+			"outputSelection": { "*": { "*": ["evm.bytecode.object"] } }
+		}
+	})");
+	BOOST_CHECK(containsError(
+		result,
+		"CodeGenerationError",
+		"Contract \"A.sol:A\" creates contract \"A.sol:B\", which has a different optimisation profile."
+	));
+
+	result = compile(R"({ "language": "Solidity", "sources": { "A.sol": { "content": "" } }, "settings": { "optimizationProfiles": { "A.sol:A": { "runs": 1 } } } })");
+	BOOST_CHECK(containsError(result, "JSONError", "Unknown key \"runs\""));
+}
+
+BOOST_AUTO_TEST_CASE(optimizer_noinline)
+{
+	auto optimizedIR = [](bool _noInline) {
+		string const source =
+			"contract C {\n" +
+			string(_noInline ? "/// @optimizer noinline\n" : "") +
+			"function f(uint x) internal pure returns (uint r) { r = x * 3; }\n"
+			"function g(uint x) internal pure returns (uint r) { r = x * 5; }\n"
+			"function h(uint x) public pure returns (uint r) { r = f(x) + g(x); }\n"
+			"}";
+		Json::Value input;
+		input["language"] = "Solidity";
+		input["sources"]["A.sol"]["content"] = source;
+		input["settings"]["viaIR"] = true;
+		input["settings"]["optimizer"]["enabled"] = true;
+		input["settings"]["outputSelection"]["*"]["*"][0] = "irOptimized";
+		Json::Value result = compile(util::jsonCompactPrint(input));
+		BOOST_REQUIRE(containsAtMostWarnings(result));
+		return result["contracts"]["A.sol"]["C"]["irOptimized"].asString();
+	};
+
+	// Both functions are only called once and therefore inlined, unless marked otherwise.
+	string const ir = optimizedIR(false);
+	BOOST_CHECK(ir.find("fun_f") == string::npos);
+	BOOST_CHECK(ir.find("fun_g") == string::npos);
+	string const noInlineIR = optimizedIR(true);
+	BOOST_CHECK(noInlineIR.find("fun_f") != string::npos);
+	BOOST_CHECK(noInlineIR.find("fun_g") == string::npos);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // end namespaces
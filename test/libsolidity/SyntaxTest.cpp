@@ -119,11 +119,13 @@ void SyntaxTest::filterObtainedErrors()
 		string sourceName;
 		if (auto location = boost::get_error_info<errinfo_sourceLocation>(*currentError))
 		{
-			solAssert(location->source, "");
-			sourceName = location->source->name();
+			solAssert(location->sourceName, "");
+			sourceName = *location->sourceName;
+			CharStream const* charStream = compiler().charStream(sourceName);
+			solAssert(charStream, "");
 
 			solAssert(m_sources.count(sourceName) == 1, "");
-			int preambleSize = static_cast<int>(location->source->source().size()) - static_cast<int>(m_sources[sourceName].size());
+			int preambleSize = static_cast<int>(charStream->source().size()) - static_cast<int>(m_sources[sourceName].size());
 			solAssert(preambleSize >= 0, "");
 
 			// ignore the version & license pragma inserted by the testing tool when calculating locations.
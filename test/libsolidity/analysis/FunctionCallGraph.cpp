@@ -116,8 +116,8 @@ tuple<CallGraphMap, CallGraphMap> collectGraphs(CompilerStack const& _compilerSt
 		soltestAssert(fullyQualifiedContractName.size() > 0 && fullyQualifiedContractName[0] == ':', "");
 		string contractName = fullyQualifiedContractName.substr(1);
 
-		get<0>(graphs).emplace(contractName, _compilerStack.contractDefinition(fullyQualifiedContractName).annotation().creationCallGraph->get());
-		get<1>(graphs).emplace(contractName, _compilerStack.contractDefinition(fullyQualifiedContractName).annotation().deployedCallGraph->get());
+		get<0>(graphs).emplace(contractName, &_compilerStack.creationCallGraph(fullyQualifiedContractName));
+		get<1>(graphs).emplace(contractName, &_compilerStack.deployedCallGraph(fullyQualifiedContractName));
 	}
 
 	return graphs;
@@ -2000,6 +2000,24 @@ BOOST_AUTO_TEST_CASE(conversions_and_struct_array_constructors)
 	checkCallGraphExpectations(get<1>(graphs), expectedDeployedEdges);
 }
 
+BOOST_AUTO_TEST_CASE(graphs_built_on_first_use)
+{
+	unique_ptr<CompilerStack> compilerStack = parseAndAnalyzeContracts(R"(
+		contract C {
+			function f() public { g(); }
+			function g() internal {}
+		}
+	)"s);
+	ContractDefinitionAnnotation const& annotation = compilerStack->contractDefinition(":C").annotation();
+	BOOST_CHECK(!annotation.creationCallGraph.set());
+	BOOST_CHECK(!annotation.deployedCallGraph.set());
+
+	CallGraph const& deployedGraph = compilerStack->deployedCallGraph(":C");
+	BOOST_CHECK(annotation.creationCallGraph.set());
+	BOOST_CHECK(&compilerStack->deployedCallGraph(":C") == &deployedGraph);
+	BOOST_CHECK(&compilerStack->creationCallGraph(":C") == annotation.creationCallGraph->get());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace solidity::frontend::test
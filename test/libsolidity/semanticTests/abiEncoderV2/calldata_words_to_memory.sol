@@ -0,0 +1,22 @@
+pragma abicoder v2;
+
+contract C {
+    struct S { uint a; bytes32 b; int c; }
+    function f(uint[] memory _a) public pure returns (uint, uint, uint) {
+        return (_a.length, _a[0], _a[_a.length - 1]);
+    }
+    function g(bytes32[3] memory _a, uint[2][] memory _b) public pure returns (bytes32, uint, uint) {
+        return (_a[2], _b[1][0], _b[1][1]);
+    }
+    function h(S memory _s, uint _x) public pure returns (uint, bytes32, int, uint) {
+        return (_s.a, _s.b, _s.c, _x);
+    }
+}
+// ====
+// compileViaYul: also
+// ----
+// f(uint256[]): 0x20, 3, 1, 2, 3 -> 3, 1, 3
+// f(uint256[]): 0x20, 3, 1, 2 -> FAILURE
+// g(bytes32[3],uint256[2][]): 1, 2, 3, 0x80, 2, 4, 5, 6, 7 -> 3, 6, 7
+// g(bytes32[3],uint256[2][]): 1, 2, 3, 0x80, 2, 4, 5, 6 -> FAILURE
+// h((uint256,bytes32,int256),uint256): 1, 2, -3, 4 -> 1, 2, -3, 4
@@ -0,0 +1,24 @@
+pragma abicoder v2;
+
+contract C {
+    struct S { uint a; uint8 b; }
+    struct T { uint x; uint8 y; }
+    struct N { S s; uint8 c; }
+    struct M { T t; uint8 z; }
+    S s;
+    T t;
+    function f(S memory _s, T calldata _t) public returns (T memory, S memory) {
+        s = _s;
+        t = _t;
+        return (T(s.a + 1, s.b), S(t.x + 1, t.y));
+    }
+    function g(N memory _n, M memory _m) public pure returns (M memory, N memory) {
+        return (M(T(_n.s.a, _n.s.b), _n.c), N(S(_m.t.x, _m.t.y), _m.z));
+    }
+}
+// ====
+// compileViaYul: also
+// ----
+// f((uint256,uint8),(uint256,uint8)): 1, 2, 3, 4 -> 2, 2, 4, 4
+// f((uint256,uint8),(uint256,uint8)): 1, 0x0102, 3, 4 -> FAILURE
+// g(((uint256,uint8),uint8),((uint256,uint8),uint8)): 1, 2, 3, 4, 5, 6 -> 1, 2, 3, 4, 5, 6
@@ -0,0 +1,22 @@
+contract C {
+    function f(uint n) public pure returns (uint, bool) {
+        bytes memory b = new bytes(n);
+        for (uint i = 0; i < n; i++)
+            b[i] = bytes1(uint8(i + 1));
+        bytes memory packed = abi.encodePacked(b, uint8(0xff));
+        bytes memory padded = abi.encode(b);
+        bool equal = packed[n] == 0xff;
+        for (uint i = 0; i < n; i++)
+            equal = equal && packed[i] == b[i] && padded[64 + i] == b[i];
+        for (uint i = 64 + n; i < padded.length; i++)
+            equal = equal && padded[i] == 0;
+        return (packed.length, equal);
+    }
+}
+// ====
+// compileViaYul: also
+// ----
+// f(uint256): 31 -> 32, true
+// f(uint256): 640 -> 641, true
+// f(uint256): 700 -> 701, true
+// f(uint256): 1025 -> 1026, true
@@ -0,0 +1,21 @@
+contract C {
+    function f(uint offset, uint n) public pure returns (bool) {
+        // Moves the free memory pointer, so that the copy is written to a large offset.
+        bytes memory padding = new bytes(offset);
+        bytes memory b = new bytes(n);
+        for (uint i = 0; i < n; i++)
+            b[i] = bytes1(uint8(i + 1));
+        bytes memory packed = abi.encodePacked(b, uint8(0xff));
+        bool equal = padding.length == offset && packed.length == n + 1 && packed[n] == 0xff;
+        for (uint i = 0; i < n; i++)
+            equal = equal && packed[i] == b[i];
+        return equal;
+    }
+}
+// ====
+// compileViaYul: also
+// ----
+// f(uint256,uint256): 0x10000, 31 -> true
+// f(uint256,uint256): 0x10000, 672 -> true
+// f(uint256,uint256): 0x10000, 673 -> true
+// f(uint256,uint256): 0x10000, 2000 -> true
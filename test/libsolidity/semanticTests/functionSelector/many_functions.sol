@@ -0,0 +1,30 @@
+contract C {
+    function f0() external pure returns (uint) { return 0; }
+    function f1() external pure returns (uint) { return 1; }
+    function f2() external pure returns (uint) { return 2; }
+    function f3() external pure returns (uint) { return 3; }
+    function f4() external pure returns (uint) { return 4; }
+    function f5() external pure returns (uint) { return 5; }
+    function f6() external pure returns (uint) { return 6; }
+    function f7() external pure returns (uint) { return 7; }
+    function f8() external pure returns (uint) { return 8; }
+    function f9() external pure returns (uint) { return 9; }
+    function f10() external pure returns (uint) { return 10; }
+    function f11() external pure returns (uint) { return 11; }
+}
+// ====
+// compileViaYul: also
+// ----
+// f0() -> 0
+// f1() -> 1
+// f2() -> 2
+// f3() -> 3
+// f4() -> 4
+// f5() -> 5
+// f6() -> 6
+// f7() -> 7
+// f8() -> 8
+// f9() -> 9
+// f10() -> 10
+// f11() -> 11
+// g() -> FAILURE
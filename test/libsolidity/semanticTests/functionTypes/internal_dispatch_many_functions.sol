@@ -0,0 +1,31 @@
+contract C {
+    function f0(uint x) internal pure returns (uint) { return x; }
+    function f1(uint x) internal pure returns (uint) { return x + 1; }
+    function f2(uint x) internal pure returns (uint) { return x + 2; }
+    function f3(uint x) internal pure returns (uint) { return x + 3; }
+    function f4(uint x) internal pure returns (uint) { return x + 4; }
+    function f5(uint x) internal pure returns (uint) { return x + 5; }
+    function f6(uint x) internal pure returns (uint) { return x + 6; }
+    function f7(uint x) internal pure returns (uint) { return x + 7; }
+    function f8(uint x) internal pure returns (uint) { return x + 8; }
+    function f9(uint x) internal pure returns (uint) { return x + 9; }
+    function f10(uint x) internal pure returns (uint) { return x + 10; }
+
+    function g(uint i, uint x) public pure returns (uint) {
+        function(uint) internal pure returns (uint)[11] memory functions = [
+            f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10
+        ];
+        return functions[i](x);
+    }
+}
+// ====
+// compileViaYul: also
+// ----
+// g(uint256,uint256): 0, 100 -> 100
+// g(uint256,uint256): 1, 100 -> 101
+// g(uint256,uint256): 4, 100 -> 104
+// g(uint256,uint256): 5, 100 -> 105
+// g(uint256,uint256): 6, 100 -> 106
+// g(uint256,uint256): 9, 100 -> 109
+// g(uint256,uint256): 10, 100 -> 110
+// g(uint256,uint256): 11, 100 -> FAILURE, hex"4e487b71", 0x32
@@ -0,0 +1,32 @@
+contract C {
+    function memoryGrowth(uint n) public pure returns (uint growth) {
+        uint start;
+        assembly { start := mload(0x40) }
+        bytes32 h;
+        for (uint i = 0; i < n; ++i)
+        {
+            h = keccak256(abi.encodePacked(h, i));
+            h = sha256(abi.encode(h, i));
+        }
+        uint end;
+        assembly { end := mload(0x40) }
+        growth = end - start;
+    }
+    function sameHash(uint n) public pure returns (bool) {
+        bytes32 a;
+        bytes32 b;
+        for (uint i = 0; i < n; ++i)
+        {
+            a = keccak256(abi.encodePacked(a, i));
+            bytes memory data = abi.encode(b, i);
+            b = keccak256(data);
+            assert(data.length == 64);
+        }
+        return a == b;
+    }
+}
+// ====
+// compileViaYul: true
+// ----
+// memoryGrowth(uint256): 10 -> 0
+// sameHash(uint256): 5 -> true
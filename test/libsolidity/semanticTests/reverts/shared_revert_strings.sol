@@ -0,0 +1,29 @@
+contract C {
+    uint public x;
+
+    function f(uint a) public returns (uint) {
+        require(a > 1, "too small");
+        x = a;
+        require(a < 10, "too large");
+        return a;
+    }
+
+    function g(uint a) public returns (uint) {
+        x = a;
+        require(a > 1, "too small");
+        if (a == 5)
+            revert("too large");
+        return a;
+    }
+}
+// ====
+// compileViaYul: also
+// EVMVersion: >=byzantium
+// ----
+// f(uint256): 1 -> FAILURE, hex"08c379a0", 0x20, 9, "too small"
+// f(uint256): 10 -> FAILURE, hex"08c379a0", 0x20, 9, "too large"
+// f(uint256): 5 -> 5
+// g(uint256): 0 -> FAILURE, hex"08c379a0", 0x20, 9, "too small"
+// g(uint256): 5 -> FAILURE, hex"08c379a0", 0x20, 9, "too large"
+// g(uint256): 7 -> 7
+// x() -> 7
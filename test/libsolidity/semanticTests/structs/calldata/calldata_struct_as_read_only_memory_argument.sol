@@ -0,0 +1,43 @@
+pragma abicoder v2;
+
+contract C {
+    struct Item {
+        uint128 price;
+        uint64 amount;
+    }
+    struct Order {
+        uint32 id;
+        Item[] items;
+        bytes tag;
+    }
+
+    function total(Order memory o, uint256[] memory factors) internal pure returns (uint256 sum) {
+        for (uint256 i = 0; i < o.items.length; i++)
+            sum += o.items[i].price * o.items[i].amount * factors[i % factors.length];
+        sum += o.id;
+    }
+
+    function tagByte(Order memory o, uint256 i) internal pure returns (bytes1) {
+        return o.tag[i];
+    }
+
+    function idMinus(Order memory o, uint32 x) internal pure returns (uint32) {
+        return o.id - x;
+    }
+
+    function f(Order calldata o, uint256[] calldata factors) external pure returns (uint256, bytes1) {
+        return (total(o, factors), tagByte(o, 1));
+    }
+
+    function g(Order calldata o, uint32 x) external pure returns (uint32 r) {
+        unchecked {
+            r = idMinus(o, x);
+        }
+    }
+}
+// ====
+// compileViaYul: also
+// ----
+// f((uint32,(uint128,uint64)[],bytes),uint256[]): 0x40, 0x0180, 7, 0x60, 0x0100, 2, 3, 4, 5, 6, 2, "ab", 2, 1, 10 -> 319, "b"
+// g((uint32,(uint128,uint64)[],bytes),uint32): 0x40, 1, 7, 0x60, 0x0100, 2, 3, 4, 5, 6, 2, "ab" -> 6
+// g((uint32,(uint128,uint64)[],bytes),uint32): 0x40, 8, 7, 0x60, 0x0100, 2, 3, 4, 5, 6, 2, "ab" -> FAILURE, hex"4e487b71", 0x11
@@ -0,0 +1,50 @@
+pragma abicoder v2;
+
+contract C {
+    struct S {
+        uint8 a;
+        uint16 b;
+        address c;
+        uint d;
+        uint128 e;
+        uint128 f;
+        bool g;
+    }
+
+    S s;
+    S t;
+
+    function slots() internal view returns (uint r0, uint r1, uint r2, uint r3, uint r4) {
+        assembly {
+            r0 := sload(s.slot)
+            r1 := sload(add(s.slot, 1))
+            r2 := sload(add(s.slot, 2))
+            r3 := sload(add(s.slot, 3))
+            r4 := sload(add(t.slot, 2))
+        }
+    }
+
+    function fromMemory() external returns (uint, uint, uint, uint, uint) {
+        s = S(1, 2, address(0x1234), 4, 5, 6, true);
+        t = s;
+        return slots();
+    }
+
+    function fromCalldata(S calldata _s) external returns (uint, uint, uint, uint, uint) {
+        s = _s;
+        t = s;
+        return slots();
+    }
+
+    function members() external view returns (uint8, uint16, address, uint, uint128, uint128, bool) {
+        return (t.a, t.b, t.c, t.d, t.e, t.f, t.g);
+    }
+}
+// ====
+// compileViaYul: also
+// ----
+// fromMemory() -> 0x1234000201, 4, 0x0600000000000000000000000000000005, 1, 0x0600000000000000000000000000000005
+// members() -> 1, 2, 0x1234, 4, 5, 6, true
+// fromCalldata((uint8,uint16,address,uint256,uint128,uint128,bool)): 7, 8, 9, 10, 11, 12, false -> 0x09000807, 10, 0x0c0000000000000000000000000000000b, 0, 0x0c0000000000000000000000000000000b
+// members() -> 7, 8, 9, 10, 11, 12, false
+// fromCalldata((uint8,uint16,address,uint256,uint128,uint128,bool)): 0x0100, 8, 9, 10, 11, 12, false -> FAILURE
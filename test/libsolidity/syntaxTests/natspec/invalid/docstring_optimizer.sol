@@ -0,0 +1,11 @@
+contract C {
+    /// @optimizer inline
+    function f() public {}
+    /// @optimizer noinline
+    function g() public {}
+    /// @optimizer noinline
+    event E();
+}
+// ----
+// DocstringParsingError 7183: (17-38): Documentation tag "@optimizer inline" is invalid. The only valid setting is "noinline".
+// DocstringParsingError 6546: (125-148): Documentation tag @optimizer not valid for events.
@@ -0,0 +1,54 @@
+/*
+	This file is part of solidity.
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <test/libsolidity/util/GasProfile.h>
+
+#include <boost/filesystem/path.hpp>
+
+using namespace solidity;
+using namespace solidity::frontend::test;
+using namespace std;
+
+GasProfile& GasProfile::instance()
+{
+	static GasProfile profile;
+	return profile;
+}
+
+void GasProfile::record(
+	string const& _testFile,
+	string const& _configuration,
+	map<string, solidity::test::EVMProfiler::Sample> const& _samples
+)
+{
+	string name = boost::filesystem::path(_testFile).generic_string();
+	string const directory = "semanticTests/";
+	if (size_t const position = name.rfind(directory); position != string::npos)
+		name = name.substr(position + directory.size());
+	string const prefix = name + " (" + _configuration + ");";
+
+	lock_guard<mutex> lock(m_mutex);
+	for (auto const& [frames, sample]: _samples)
+	{
+		auto& recorded = m_samples[prefix + frames];
+		recorded.count += sample.count;
+		recorded.gas += sample.gas;
+	}
+}
+
+void GasProfile::writeFolded(ostream& _out, bool _counts) const
+{
+	lock_guard<mutex> lock(m_mutex);
+	solidity::test::EVMProfiler::writeFolded(_out, m_samples, _counts);
+}
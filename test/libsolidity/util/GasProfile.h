@@ -0,0 +1,60 @@
+/*
+	This file is part of solidity.
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <test/EVMProfiler.h>
+
+#include <iosfwd>
+#include <map>
+#include <mutex>
+#include <string>
+
+namespace solidity::frontend::test
+{
+
+/**
+ * Gas profile of the semantic tests, which is recorded by executing every transaction in
+ * an EVMProfiler if the profile is enabled. The call stacks of all tests are merged, below
+ * a frame per test and configuration, e.g. "abiEncoderV2/struct.sol (legacy/optimized)".
+ */
+class GasProfile
+{
+public:
+	/// @returns the profile the semantic tests record to.
+	static GasProfile& instance();
+
+	/// Makes the semantic tests record their profiles. Has to be called before any test runs.
+	void enable() { m_enabled = true; }
+	bool enabled() const { return m_enabled; }
+
+	/// Records the samples of the test in the file @a _testFile compiled in @a _configuration.
+	/// Can be called concurrently.
+	void record(
+		std::string const& _testFile,
+		std::string const& _configuration,
+		std::map<std::string, solidity::test::EVMProfiler::Sample> const& _samples
+	);
+
+	/// Writes the recorded profile in the folded format of flamegraph.pl, weighted by gas or,
+	/// if @a _counts is true, by the number of executed instructions.
+	void writeFolded(std::ostream& _out, bool _counts = false) const;
+
+private:
+	bool m_enabled = false;
+	mutable std::mutex m_mutex;
+	std::map<std::string, solidity::test::EVMProfiler::Sample> m_samples;
+};
+
+}
@@ -0,0 +1,156 @@
+/*
+	This file is part of solidity.
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <test/libsolidity/util/GasReport.h>
+
+#include <boost/filesystem/path.hpp>
+
+#include <iomanip>
+#include <sstream>
+
+using namespace solidity;
+using namespace solidity::frontend::test;
+using namespace std;
+
+namespace
+{
+
+/// @returns the path of @a _testFile relative to the directory of the semantic tests.
+string testName(string const& _testFile)
+{
+	string const name = boost::filesystem::path(_testFile).generic_string();
+	string const directory = "semanticTests/";
+	size_t const position = name.rfind(directory);
+	return position == string::npos ? name : name.substr(position + directory.size());
+}
+
+/// Adds a change to @a _changes if @a _current differs from @a _baseline by more than the threshold.
+void compareValue(
+	vector<GasReport::Change>& _changes,
+	string const& _description,
+	uint64_t _baseline,
+	uint64_t _current,
+	double _thresholdPercent,
+	bool _always = false
+)
+{
+	if (_baseline == _current && !_always)
+		return;
+	double const percent = _baseline == 0 ?
+		(_current == 0 ? 0.0 : 100.0) :
+		(static_cast<double>(_current) - static_cast<double>(_baseline)) * 100.0 / static_cast<double>(_baseline);
+	if (!_always && (percent <= _thresholdPercent && -percent <= _thresholdPercent))
+		return;
+
+	ostringstream description;
+	description << _description << ": " << _baseline << " -> " << _current << " (" <<
+		showpos << fixed << setprecision(2) << percent << "%)";
+	_changes.push_back({description.str(), !_always && percent > _thresholdPercent});
+}
+
+}
+
+GasReport& GasReport::instance()
+{
+	static GasReport report;
+	return report;
+}
+
+void GasReport::record(string const& _testFile, string const& _configuration, Measurement _measurement)
+{
+	lock_guard<mutex> lock(m_mutex);
+	m_measurements[testName(_testFile)][_configuration] = move(_measurement);
+	m_configurations.insert(_configuration);
+}
+
+Json::Value GasReport::toJson(Json::Value const& _previous) const
+{
+	lock_guard<mutex> lock(m_mutex);
+	Json::Value report(Json::objectValue);
+	for (auto const& test: _previous.getMemberNames())
+		for (auto const& configuration: _previous[test].getMemberNames())
+			if (!m_configurations.count(configuration))
+				report[test][configuration] = _previous[test][configuration];
+
+	for (auto const& [test, configurations]: m_measurements)
+		for (auto const& [configuration, measurement]: configurations)
+		{
+			Json::Value entry(Json::objectValue);
+			entry["deployGas"] = Json::UInt64(measurement.deployGas);
+			entry["codeSize"] = Json::UInt64(measurement.codeSize);
+			entry["calls"] = Json::arrayValue;
+			for (Call const& call: measurement.calls)
+			{
+				Json::Value callEntry(Json::objectValue);
+				callEntry["signature"] = call.signature;
+				callEntry["gas"] = Json::UInt64(call.gas);
+				entry["calls"].append(move(callEntry));
+			}
+			report[test][configuration] = move(entry);
+		}
+	return report;
+}
+
+vector<GasReport::Change> GasReport::compare(Json::Value const& _baseline, Json::Value const& _report, double _thresholdPercent)
+{
+	struct Totals
+	{
+		uint64_t baseline = 0;
+		uint64_t current = 0;
+	};
+	map<string, Totals> totalGas;
+	map<string, Totals> totalCodeSize;
+
+	vector<Change> changes;
+	for (auto const& test: _report.getMemberNames())
+		for (auto const& configuration: _report[test].getMemberNames())
+		{
+			if (!_baseline.isMember(test) || !_baseline[test].isMember(configuration))
+				continue;
+			Json::Value const& baseline = _baseline[test][configuration];
+			Json::Value const& current = _report[test][configuration];
+			string const prefix = test + " (" + configuration + ") ";
+
+			compareValue(changes, prefix + "deploy gas", baseline["deployGas"].asUInt64(), current["deployGas"].asUInt64(), _thresholdPercent);
+			compareValue(changes, prefix + "code size", baseline["codeSize"].asUInt64(), current["codeSize"].asUInt64(), _thresholdPercent);
+			totalGas[configuration].baseline += baseline["deployGas"].asUInt64();
+			totalGas[configuration].current += current["deployGas"].asUInt64();
+			totalCodeSize[configuration].baseline += baseline["codeSize"].asUInt64();
+			totalCodeSize[configuration].current += current["codeSize"].asUInt64();
+
+			// Only the calls up to the first one that differs are comparable.
+			for (Json::ArrayIndex i = 0; i < min(baseline["calls"].size(), current["calls"].size()); ++i)
+			{
+				Json::Value const& baselineCall = baseline["calls"][i];
+				Json::Value const& currentCall = current["calls"][i];
+				if (baselineCall["signature"] != currentCall["signature"])
+					break;
+				compareValue(
+					changes,
+					prefix + "call " + to_string(i) + " " + currentCall["signature"].asString(),
+					baselineCall["gas"].asUInt64(),
+					currentCall["gas"].asUInt64(),
+					_thresholdPercent
+				);
+				totalGas[configuration].baseline += baselineCall["gas"].asUInt64();
+				totalGas[configuration].current += currentCall["gas"].asUInt64();
+			}
+		}
+
+	for (auto const& [configuration, totals]: totalGas)
+		compareValue(changes, "Total gas (" + configuration + ")", totals.baseline, totals.current, _thresholdPercent, true);
+	for (auto const& [configuration, totals]: totalCodeSize)
+		compareValue(changes, "Total code size (" + configuration + ")", totals.baseline, totals.current, _thresholdPercent, true);
+	return changes;
+}
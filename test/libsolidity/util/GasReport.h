@@ -0,0 +1,86 @@
+/*
+	This file is part of solidity.
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <json/json.h>
+
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace solidity::frontend::test
+{
+
+/**
+ * Gas costs and code sizes of the semantic tests, which are recorded while the tests run if
+ * the report is enabled. Reports are stored as JSON keyed by test and configuration, e.g.
+ * "legacy/optimized", and can be compared against a baseline.
+ */
+class GasReport
+{
+public:
+	struct Call
+	{
+		std::string signature;
+		uint64_t gas = 0;
+	};
+
+	struct Measurement
+	{
+		uint64_t deployGas = 0;
+		/// Size of the deployed code.
+		uint64_t codeSize = 0;
+		std::vector<Call> calls;
+	};
+
+	/// Value that differs between a baseline and a report.
+	struct Change
+	{
+		std::string description;
+		/// True if the value grew by more than the threshold.
+		bool regression = false;
+	};
+
+	/// @returns the report the semantic tests record to.
+	static GasReport& instance();
+
+	/// Makes the semantic tests record their measurements. Has to be called before any test runs.
+	void enable() { m_enabled = true; }
+	bool enabled() const { return m_enabled; }
+
+	/// Records the measurement of the test in the file @a _testFile compiled in @a _configuration.
+	/// Can be called concurrently.
+	void record(std::string const& _testFile, std::string const& _configuration, Measurement _measurement);
+
+	/// @returns the recorded measurements as JSON, in addition to the entries of @a _previous
+	/// whose configurations were not recorded.
+	Json::Value toJson(Json::Value const& _previous = Json::objectValue) const;
+
+	/// @returns the values of @a _report that differ from @a _baseline by more than
+	/// @a _thresholdPercent percent, followed by the changes of the totals per configuration.
+	static std::vector<Change> compare(Json::Value const& _baseline, Json::Value const& _report, double _thresholdPercent);
+
+private:
+	bool m_enabled = false;
+	mutable std::mutex m_mutex;
+	/// Measurements by test and configuration.
+	std::map<std::string, std::map<std::string, Measurement>> m_measurements;
+	std::set<std::string> m_configurations;
+};
+
+}
@@ -0,0 +1,90 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for Arena.h.
+ */
+
+#include <libsolutil/Arena.h>
+
+#include <test/Common.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <cstdint>
+#include <string>
+
+using namespace std;
+
+namespace solidity::util::test
+{
+
+BOOST_AUTO_TEST_SUITE(ArenaTest, *boost::unit_test::label("nooptions"))
+
+BOOST_AUTO_TEST_CASE(alignment_and_blocks)
+{
+	Arena arena(64);
+	BOOST_CHECK_EQUAL(arena.reservedBytes(), 0);
+	char* first = static_cast<char*>(arena.allocate(1, 1));
+	auto* second = static_cast<uint64_t*>(arena.allocate(sizeof(uint64_t), alignof(uint64_t)));
+	BOOST_CHECK_EQUAL(reinterpret_cast<uintptr_t>(second) % alignof(uint64_t), 0);
+	BOOST_CHECK(reinterpret_cast<char*>(second) > first);
+	BOOST_CHECK_EQUAL(arena.reservedBytes(), 64);
+
+	// Large objects get a block of their own.
+	arena.allocate(1000, 1);
+	BOOST_CHECK_EQUAL(arena.reservedBytes(), 64 + 1000);
+	// The first block is still used.
+	arena.allocate(32, 1);
+	BOOST_CHECK_EQUAL(arena.reservedBytes(), 64 + 1000);
+	// The next block is twice as large.
+	arena.allocate(17, 1);
+	BOOST_CHECK_EQUAL(arena.reservedBytes(), 64 + 1000 + 128);
+}
+
+BOOST_AUTO_TEST_CASE(shared_objects_keep_arena_alive)
+{
+	weak_ptr<Arena> weakArena;
+	shared_ptr<string> text;
+	{
+		auto arena = make_shared<Arena>();
+		weakArena = arena;
+		text = allocate_shared<string>(ArenaAllocator<string>(arena), "arena");
+		auto other = allocate_shared<int>(ArenaAllocator<int>(arena), 7);
+		BOOST_CHECK_EQUAL(*other, 7);
+	}
+	BOOST_CHECK(!weakArena.expired());
+	BOOST_CHECK_EQUAL(*text, "arena");
+	text.reset();
+	BOOST_CHECK(weakArena.expired());
+}
+
+BOOST_AUTO_TEST_CASE(created_objects_are_destroyed_with_arena)
+{
+	auto value = make_shared<int>(7);
+	{
+		Arena arena;
+		shared_ptr<int>& copy = arena.create<shared_ptr<int>>(value);
+		BOOST_CHECK(copy == value);
+		BOOST_CHECK_EQUAL(value.use_count(), 2);
+	}
+	BOOST_CHECK_EQUAL(value.use_count(), 1);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
@@ -28,6 +28,8 @@
 
 #include <boost/test/unit_test.hpp>
 
+#include <sstream>
+
 using namespace std;
 using namespace solidity::frontend;
 
@@ -97,6 +99,23 @@ BOOST_AUTO_TEST_CASE(tohex_bytes)
 	BOOST_CHECK_EQUAL(toHex(fromHex("00112233445566778899aAbBcCdDeEfF"), HexPrefix::Add, static_cast<HexCase>(42)), "0x00112233445566778899aabbccddeeff");
 }
 
+BOOST_AUTO_TEST_CASE(tohex_stream)
+{
+	bytes data;
+	for (size_t i = 0; i < 5000; ++i)
+		data.push_back(static_cast<uint8_t>(i * 7));
+	for (HexCase hexCase: {HexCase::Lower, HexCase::Upper, HexCase::Mixed})
+	{
+		ostringstream out;
+		toHex(out, bytesConstRef(&data), hexCase);
+		BOOST_CHECK_EQUAL(out.str(), toHex(data, HexPrefix::DontAdd, hexCase));
+		BOOST_CHECK(fromHex(out.str()) == data);
+	}
+	ostringstream empty;
+	toHex(empty, bytesConstRef());
+	BOOST_CHECK_EQUAL(empty.str(), "");
+}
+
 BOOST_AUTO_TEST_CASE(test_format_number)
 {
 	BOOST_CHECK_EQUAL(formatNumber(u256(0x8000000)), "0x08000000");
@@ -138,6 +157,19 @@ BOOST_AUTO_TEST_CASE(test_format_number)
 	);
 }
 
+BOOST_AUTO_TEST_CASE(twos_complement)
+{
+	u256 const minSigned = u256(1) << 255;
+	BOOST_CHECK_EQUAL(u2s(0), s256(0));
+	BOOST_CHECK_EQUAL(u2s(minSigned - 1), s256(minSigned - 1));
+	BOOST_CHECK_EQUAL(u2s(minSigned), -s256(minSigned));
+	BOOST_CHECK_EQUAL(u2s(~u256(0)), s256(-1));
+	for (u256 value: {u256(0), u256(1), u256(7), minSigned - 1, minSigned, minSigned + 1, ~u256(1), ~u256(0)})
+		BOOST_CHECK_EQUAL(s2u(u2s(value)), value);
+	BOOST_CHECK_EQUAL(s2u(s256(-1)), ~u256(0));
+	BOOST_CHECK_EQUAL(s2u(-s256(minSigned)), minSigned);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }
@@ -0,0 +1,134 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for JsonWriter.h.
+ */
+
+#include <libsolutil/JsonWriter.h>
+#include <libsolutil/JSON.h>
+
+#include <test/Common.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <sstream>
+
+using namespace std;
+
+namespace solidity::util::test
+{
+
+namespace
+{
+
+void writeExample(JsonWriter& _writer)
+{
+	_writer.addMember("a", 1);
+	_writer.beginObject("b", true);
+	_writer.beginObject("x", true);
+	_writer.endObject();
+	_writer.beginObject("y");
+	_writer.addMember("1", "one");
+	_writer.addMember("2", Json::Value(Json::arrayValue));
+	_writer.endObject();
+	_writer.endObject();
+	_writer.beginObject("c", true);
+	_writer.endObject();
+	_writer.beginObject("d");
+	_writer.endObject();
+	Json::Value members;
+	members["f"] = "\"quoted\"";
+	members["e"] = true;
+	_writer.addMembers(members);
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(JsonWriterTest, *boost::unit_test::label("nooptions"))
+
+BOOST_AUTO_TEST_CASE(stream_matches_tree)
+{
+	ostringstream stream;
+	JsonStreamWriter streamWriter(stream);
+	writeExample(streamWriter);
+	streamWriter.finish();
+
+	JsonTreeWriter treeWriter;
+	writeExample(treeWriter);
+
+	BOOST_CHECK_EQUAL(stream.str(), jsonCompactPrint(treeWriter.result()));
+	BOOST_CHECK_EQUAL(stream.str(), "{\"a\":1,\"b\":{\"y\":{\"1\":\"one\",\"2\":[]}},\"d\":{},\"e\":true,\"f\":\"\\\"quoted\\\"\"}");
+}
+
+BOOST_AUTO_TEST_CASE(printed_members)
+{
+	auto print = [](ostream& _stream) { _stream << "[1,2]"; };
+	auto build = []() {
+		Json::Value value(Json::arrayValue);
+		value.append(1);
+		value.append(2);
+		return value;
+	};
+
+	ostringstream stream;
+	JsonStreamWriter streamWriter(stream);
+	streamWriter.beginObject("a");
+	streamWriter.addMember("b", print, build);
+	streamWriter.endObject();
+	streamWriter.finish();
+
+	JsonTreeWriter treeWriter;
+	treeWriter.beginObject("a");
+	treeWriter.addMember("b", print, build);
+	treeWriter.endObject();
+
+	BOOST_CHECK_EQUAL(stream.str(), "{\"a\":{\"b\":[1,2]}}");
+	BOOST_CHECK_EQUAL(stream.str(), jsonCompactPrint(treeWriter.result()));
+}
+
+BOOST_AUTO_TEST_CASE(stream_empty)
+{
+	ostringstream stream;
+	JsonStreamWriter writer(stream);
+	writer.beginObject("a", true);
+	writer.endObject();
+	writer.finish();
+	BOOST_CHECK_EQUAL(stream.str(), "{}");
+}
+
+BOOST_AUTO_TEST_CASE(stream_requires_ordered_keys)
+{
+	ostringstream stream;
+	JsonStreamWriter writer(stream);
+	writer.addMember("b", 1);
+	BOOST_CHECK_THROW(writer.addMember("a", 2), JsonWriterError);
+	BOOST_CHECK_THROW(writer.addMember("b", 2), JsonWriterError);
+}
+
+BOOST_AUTO_TEST_CASE(stream_requires_balanced_objects)
+{
+	ostringstream stream;
+	JsonStreamWriter writer(stream);
+	BOOST_CHECK_THROW(writer.endObject(), JsonWriterError);
+	writer.beginObject("a");
+	BOOST_CHECK_THROW(writer.finish(), JsonWriterError);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
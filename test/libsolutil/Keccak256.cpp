@@ -69,6 +69,23 @@ BOOST_AUTO_TEST_CASE(strings)
 	);
 }
 
+BOOST_AUTO_TEST_CASE(batch)
+{
+	vector<bytes> inputs;
+	// Several inputs of each length, so that some are hashed together and some alone.
+	for (size_t length: vector<size_t>{0, 1, 7, 8, 31, 135, 136, 137, 200, 272, 300})
+		for (size_t i = 0; i < 5; ++i)
+			inputs.emplace_back(length + i % 2, static_cast<uint8_t>(length + i));
+	vector<bytesConstRef> inputRefs;
+	for (bytes const& input: inputs)
+		inputRefs.emplace_back(&input);
+	vector<h256> hashes = keccak256Batch(inputRefs);
+	BOOST_REQUIRE_EQUAL(hashes.size(), inputs.size());
+	for (size_t i = 0; i < inputs.size(); ++i)
+		BOOST_CHECK_EQUAL(hashes[i], keccak256(inputs[i]));
+	BOOST_CHECK(keccak256Batch({}).empty());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }
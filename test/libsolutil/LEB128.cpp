@@ -96,6 +96,17 @@ BOOST_AUTO_TEST_CASE(encode_signed)
 	BOOST_REQUIRE(negative_larger[5] == 0x7C);
 }
 
+BOOST_AUTO_TEST_CASE(encoded_size)
+{
+	for (uint64_t value: {uint64_t(0), uint64_t(1), uint64_t(0x7f), uint64_t(0x80), uint64_t(624485), uint64_t(-1)})
+		BOOST_CHECK_EQUAL(solidity::util::lebEncodedSize(value), solidity::util::lebEncode(value).size());
+
+	bytes appended{0x01};
+	solidity::util::lebEncodeTo(appended, 624485);
+	solidity::util::lebEncodeSignedTo(appended, -2);
+	BOOST_REQUIRE(appended == (bytes{0x01, 0xE5, 0x8E, 0x26, 0x7e}));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }
@@ -0,0 +1,101 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for MemoryAccounting.h.
+ */
+
+#include <libsolutil/MemoryAccounting.h>
+
+#include <libsolutil/Arena.h>
+
+#include <test/Common.h>
+
+#include <boost/test/unit_test.hpp>
+
+using namespace std;
+
+namespace solidity::util::test
+{
+
+BOOST_AUTO_TEST_SUITE(MemoryAccountingTest, *boost::unit_test::label("nooptions"))
+
+BOOST_AUTO_TEST_CASE(accounts_and_peaks)
+{
+	MemoryAccounting::enable();
+	MemoryAccounting::reset();
+	MemoryAccounting::Usage const before = MemoryAccounting::usage(MemorySubsystem::JSONOutput);
+	{
+		MemoryAccount account(MemorySubsystem::JSONOutput);
+		account.add(100);
+		account.set(300);
+		account.set(50);
+		MemoryAccounting::Usage const usage = MemoryAccounting::usage(MemorySubsystem::JSONOutput);
+		BOOST_CHECK_EQUAL(usage.allocations, before.allocations + 2);
+		BOOST_CHECK_EQUAL(usage.bytes, before.bytes + 50);
+		BOOST_CHECK_EQUAL(usage.peakBytes, max(before.peakBytes, before.bytes + 300));
+
+		// Copies do not take over the bytes of the original.
+		MemoryAccount copy(account);
+		BOOST_CHECK_EQUAL(copy.bytes(), 0);
+	}
+	MemoryAccounting::Usage const after = MemoryAccounting::usage(MemorySubsystem::JSONOutput);
+	BOOST_CHECK_EQUAL(after.bytes, before.bytes);
+	BOOST_CHECK_EQUAL(after.peakBytes, max(before.peakBytes, before.bytes + 300));
+}
+
+BOOST_AUTO_TEST_CASE(transfer)
+{
+	MemoryAccounting::enable();
+	size_t const astBefore = MemoryAccounting::usage(MemorySubsystem::AST).bytes;
+	size_t const annotationsBefore = MemoryAccounting::usage(MemorySubsystem::Annotations).bytes;
+	{
+		Arena arena(64);
+		arena.allocate(16, 8);
+		BOOST_CHECK_EQUAL(arena.memoryAccount().bytes(), arena.reservedBytes());
+		BOOST_CHECK_EQUAL(MemoryAccounting::usage(MemorySubsystem::AST).bytes, astBefore + arena.reservedBytes());
+
+		MemoryAccount annotations(MemorySubsystem::Annotations);
+		MemoryAccount::transfer(arena.memoryAccount(), annotations, 16);
+		BOOST_CHECK_EQUAL(annotations.bytes(), 16);
+		BOOST_CHECK_EQUAL(MemoryAccounting::usage(MemorySubsystem::Annotations).bytes, annotationsBefore + 16);
+		BOOST_CHECK_EQUAL(MemoryAccounting::usage(MemorySubsystem::AST).bytes, astBefore + arena.reservedBytes() - 16);
+
+		// No more than the bytes held are transferred.
+		MemoryAccount::transfer(annotations, arena.memoryAccount(), 1000);
+		BOOST_CHECK_EQUAL(annotations.bytes(), 0);
+		BOOST_CHECK_EQUAL(arena.memoryAccount().bytes(), arena.reservedBytes());
+	}
+	BOOST_CHECK_EQUAL(MemoryAccounting::usage(MemorySubsystem::AST).bytes, astBefore);
+	BOOST_CHECK_EQUAL(MemoryAccounting::usage(MemorySubsystem::Annotations).bytes, annotationsBefore);
+}
+
+BOOST_AUTO_TEST_CASE(measurements)
+{
+	MemoryAccounting::enable();
+	MemoryAccounting::reset();
+	MemoryAccounting::recordMeasurement("test", 10);
+	MemoryAccounting::recordMeasurement("test", 30);
+	MemoryAccounting::recordMeasurement("test", 20);
+	BOOST_CHECK_EQUAL(MemoryAccounting::measurements().at("test"), 30);
+	MemoryAccounting::reset();
+	BOOST_CHECK(MemoryAccounting::measurements().empty());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
@@ -0,0 +1,105 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for SourceBuffer.h.
+ */
+
+#include <libsolutil/SourceBuffer.h>
+#include <libsolutil/Exceptions.h>
+
+#include <test/Common.h>
+
+#include <boost/filesystem.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <fstream>
+
+using namespace std;
+
+namespace solidity::util::test
+{
+
+namespace
+{
+
+class TemporaryFile
+{
+public:
+	explicit TemporaryFile(string const& _content):
+		m_path(boost::filesystem::temp_directory_path() / boost::filesystem::unique_path("solc-source-buffer-test-%%%%-%%%%"))
+	{
+		ofstream file(m_path.string(), ios::binary);
+		file << _content;
+	}
+	~TemporaryFile() { boost::filesystem::remove(m_path); }
+
+	string path() const { return m_path.string(); }
+
+private:
+	boost::filesystem::path m_path;
+};
+
+}
+
+BOOST_AUTO_TEST_SUITE(SourceBufferTest, *boost::unit_test::label("nooptions"))
+
+BOOST_AUTO_TEST_CASE(copies_share_contents)
+{
+	string content(1000, 'x');
+	char const* data = content.data();
+	SourceBuffer buffer(move(content));
+	SourceBuffer copy = buffer;
+	BOOST_CHECK(buffer.data() == data);
+	BOOST_CHECK(copy.data() == data);
+	BOOST_CHECK_EQUAL(copy.size(), 1000);
+	BOOST_CHECK(copy == SourceBuffer(string(1000, 'x')));
+	BOOST_CHECK(copy != SourceBuffer(string(1000, 'y')));
+}
+
+BOOST_AUTO_TEST_CASE(empty)
+{
+	BOOST_CHECK(SourceBuffer().empty());
+	BOOST_CHECK(SourceBuffer(string()).empty());
+	BOOST_CHECK_EQUAL(SourceBuffer().str(), "");
+	TemporaryFile file("");
+	BOOST_CHECK(SourceBuffer::fromFile(file.path()).empty());
+}
+
+BOOST_AUTO_TEST_CASE(from_file)
+{
+	// Small files are read, large files are mapped.
+	for (size_t size: {size_t(10), size_t(64 * 1024), size_t(4096 * 64 + 1)})
+	{
+		string content;
+		for (size_t i = 0; i < size; ++i)
+			content.push_back(static_cast<char>('a' + i % 26));
+		TemporaryFile file(content);
+		SourceBuffer buffer = SourceBuffer::fromFile(file.path());
+		BOOST_CHECK_EQUAL(buffer.size(), size);
+		BOOST_CHECK(buffer.str() == content);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(missing_file)
+{
+	BOOST_CHECK_THROW(SourceBuffer::fromFile("/this/file/does/not/exist.sol"), FileNotFound);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
@@ -73,6 +73,32 @@ BOOST_AUTO_TEST_CASE(test_dldistance)
 
 }
 
+BOOST_AUTO_TEST_CASE(test_similar_strings)
+{
+	vector<string> strings{"hello", "hellw", "helol", "helo", "hllllo", "a", "ab", "ba", "abc", "x", string(100, 'Y')};
+	for (size_t i = 0; i < 200; ++i)
+		strings.emplace_back("name" + to_string(i * 7));
+	SimilarStrings similarStrings;
+	for (string const& str: strings)
+		similarStrings.insert(str);
+	similarStrings.insert("hello");
+
+	// The index finds the same strings as comparing the query with all of them.
+	vector<string> queries = strings;
+	queries += vector<string>{"", "hlelo", "hellllo", "nmae14", "name1", "yes", string(99, 'Y') + "Z"};
+	for (string const& query: queries)
+		for (size_t maxDistance = 0; maxDistance <= 2; ++maxDistance)
+		{
+			vector<string> expected;
+			for (string const& str: strings)
+				if (stringWithinDistance(query, str, maxDistance, 80 * 80))
+					expected.push_back(str);
+			sort(expected.begin(), expected.end());
+			BOOST_CHECK(similarStrings.similar(query, maxDistance, 80 * 80) == expected);
+		}
+	BOOST_CHECK(similarStrings.similar("hello", 1) == (vector<string>{"hello", "hellw", "helo", "helol"}));
+}
+
 BOOST_AUTO_TEST_CASE(test_alternatives_list)
 {
 	vector<string> strings;
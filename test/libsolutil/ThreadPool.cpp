@@ -0,0 +1,159 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for the thread pool.
+ */
+
+#include <libsolutil/ThreadPool.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+namespace solidity::util::test
+{
+
+BOOST_AUTO_TEST_SUITE(ThreadPoolTest)
+
+BOOST_AUTO_TEST_CASE(single_thread_runs_in_order)
+{
+	ThreadPool pool(1);
+	BOOST_CHECK_EQUAL(pool.threads(), 1);
+	vector<int> order;
+	for (int i = 0; i < 10; ++i)
+		pool.submit([&order, i]() { order.push_back(i); });
+	pool.wait();
+	BOOST_CHECK(order == (vector<int>{0, 1, 2, 3, 4, 5, 6, 7, 8, 9}));
+}
+
+BOOST_AUTO_TEST_CASE(runs_all_tasks)
+{
+	ThreadPool pool(4);
+	vector<int> results(1000, 0);
+	atomic<size_t> count{0};
+	for (size_t i = 0; i < results.size(); ++i)
+		pool.submit([&, i]() { results[i] = static_cast<int>(i) * 2; ++count; });
+	pool.wait();
+	BOOST_CHECK_EQUAL(count, results.size());
+	for (size_t i = 0; i < results.size(); ++i)
+		BOOST_CHECK_EQUAL(results[i], static_cast<int>(i) * 2);
+
+	// The pool can be reused after waiting.
+	pool.submit([&]() { ++count; });
+	pool.wait();
+	BOOST_CHECK_EQUAL(count, results.size() + 1);
+}
+
+BOOST_AUTO_TEST_CASE(rethrows_first_submitted_exception)
+{
+	for (size_t threads: {1, 4})
+	{
+		ThreadPool pool(threads);
+		atomic<size_t> count{0};
+		for (size_t i = 0; i < 100; ++i)
+			pool.submit([&, i]() {
+				++count;
+				if (i % 10 == 3)
+					throw runtime_error(to_string(i));
+			});
+		try
+		{
+			pool.wait();
+			BOOST_FAIL("Expected exception.");
+		}
+		catch (runtime_error const& _error)
+		{
+			BOOST_CHECK_EQUAL(_error.what(), string("3"));
+		}
+		BOOST_CHECK_EQUAL(count, 100);
+
+		// The exception is only reported once.
+		pool.wait();
+	}
+}
+
+BOOST_AUTO_TEST_CASE(nested_pools_share_workers)
+{
+	size_t const workersBefore = ThreadPool::workerThreads();
+	atomic<size_t> running{0};
+	atomic<size_t> maxRunning{0};
+	atomic<size_t> count{0};
+	{
+		ThreadPool outer(4);
+		for (size_t i = 0; i < 8; ++i)
+			outer.submit([&]() {
+				ThreadPool inner(4);
+				for (size_t j = 0; j < 8; ++j)
+					inner.submit([&]() {
+						size_t now = ++running;
+						size_t previous = maxRunning;
+						while (now > previous && !maxRunning.compare_exchange_weak(previous, now)) {}
+						this_thread::sleep_for(chrono::microseconds(100));
+						--running;
+						++count;
+					});
+				inner.wait();
+			});
+		outer.wait();
+	}
+	BOOST_CHECK_EQUAL(count, 64);
+	// The inner pools do not start threads of their own: Apart from the workers, only
+	// the waiting thread executes tasks.
+	BOOST_CHECK_EQUAL(ThreadPool::workerThreads(), max<size_t>(workersBefore, 4));
+	BOOST_CHECK(maxRunning <= ThreadPool::workerThreads() + 1);
+}
+
+BOOST_AUTO_TEST_CASE(cancel_drops_queued_tasks)
+{
+	ThreadPool pool(2);
+	atomic<bool> submitted{false};
+	atomic<bool> cancelled{false};
+	atomic<size_t> count{0};
+	pool.submit([&]() {
+		while (!submitted)
+			this_thread::yield();
+		pool.cancel();
+		cancelled = true;
+	});
+	// At most one of these is started before the first task cancels the others.
+	for (size_t i = 0; i < 100; ++i)
+		pool.submit([&]() {
+			while (!cancelled)
+				this_thread::yield();
+			++count;
+		});
+	submitted = true;
+	pool.wait();
+	BOOST_CHECK(count <= 1);
+
+	// The pool can be used again after cancelling.
+	pool.submit([&]() { ++count; });
+	pool.wait();
+	BOOST_CHECK(count >= 1);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
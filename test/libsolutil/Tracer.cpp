@@ -0,0 +1,114 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for the recording of Chrome trace events.
+ */
+
+#include <libsolutil/Tracer.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <thread>
+
+using namespace std;
+
+namespace solidity::util::test
+{
+
+BOOST_AUTO_TEST_SUITE(TracerTest)
+
+BOOST_AUTO_TEST_CASE(no_active_tracer)
+{
+	Tracer tracer;
+	{
+		Tracer::Span span("phase", "parsing");
+	}
+	BOOST_CHECK(Tracer::active() == nullptr);
+	BOOST_CHECK(tracer.events().empty());
+}
+
+BOOST_AUTO_TEST_CASE(nested_spans)
+{
+	Tracer tracer;
+	{
+		Tracer::Scope scope(tracer);
+		BOOST_CHECK(Tracer::active() == &tracer);
+		Tracer::Span outer("contract", "compileContract", "A.sol:C");
+		{
+			Tracer::Span inner("yulOptimiserStep", "UnusedPruner");
+		}
+		{
+			Tracer::Span inner("yulOptimiserStep", "ExpressionSplitter");
+		}
+	}
+	BOOST_CHECK(Tracer::active() == nullptr);
+
+	vector<Tracer::Event> events = tracer.events();
+	BOOST_REQUIRE_EQUAL(events.size(), 3);
+	BOOST_CHECK_EQUAL(events[0].name, "compileContract");
+	BOOST_CHECK_EQUAL(events[0].detail, "A.sol:C");
+	BOOST_CHECK_EQUAL(events[1].name, "UnusedPruner");
+	BOOST_CHECK_EQUAL(events[2].name, "ExpressionSplitter");
+	for (size_t i: {1, 2})
+	{
+		BOOST_CHECK_EQUAL(events[i].thread, events[0].thread);
+		BOOST_CHECK(events[i].start >= events[0].start);
+		BOOST_CHECK(events[i].start + events[i].duration <= events[0].start + events[0].duration);
+	}
+	BOOST_CHECK(events[1].start + events[1].duration <= events[2].start);
+}
+
+BOOST_AUTO_TEST_CASE(threads)
+{
+	Tracer tracer;
+	{
+		Tracer::Scope scope(tracer);
+		Tracer::Span span("phase", "compilation");
+		thread worker([]() { Tracer::Span span("parsing", "parse", "A.sol"); });
+		worker.join();
+	}
+
+	vector<Tracer::Event> events = tracer.events();
+	BOOST_REQUIRE_EQUAL(events.size(), 2);
+	BOOST_CHECK(events[0].thread != events[1].thread);
+}
+
+BOOST_AUTO_TEST_CASE(json)
+{
+	Tracer tracer;
+	{
+		Tracer::Scope scope(tracer);
+		Tracer::Span span("parsing", "parse", "A.sol");
+	}
+
+	Json::Value trace = tracer.toJson();
+	BOOST_REQUIRE(trace["traceEvents"].isArray());
+	BOOST_REQUIRE_EQUAL(trace["traceEvents"].size(), 1);
+	Json::Value const& event = trace["traceEvents"][0];
+	BOOST_CHECK_EQUAL(event["name"].asString(), "parse");
+	BOOST_CHECK_EQUAL(event["cat"].asString(), "parsing");
+	BOOST_CHECK_EQUAL(event["ph"].asString(), "X");
+	BOOST_CHECK_EQUAL(event["args"]["detail"].asString(), "A.sol");
+	BOOST_CHECK(event["ts"].isDouble());
+	BOOST_CHECK(event["dur"].asDouble() >= 0);
+	BOOST_CHECK(event["tid"].isUInt64());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
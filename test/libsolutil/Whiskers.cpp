@@ -208,6 +208,31 @@ BOOST_AUTO_TEST_CASE(invalid_param_rendered)
 	BOOST_CHECK_EQUAL(m.render(), templ);
 }
 
+BOOST_AUTO_TEST_CASE(unclosed_elements_rendered)
+{
+	string templ = "<#l>x<?c>y<!c>z</l> <?c></c>";
+	Whiskers m(templ);
+	m("l", vector<map<string, string>>{{}, {}})("c", true);
+	BOOST_CHECK_EQUAL(m.render(), "x<?c>y<!c>zx<?c>y<!c>z ");
+}
+
+BOOST_AUTO_TEST_CASE(first_closing_tag)
+{
+	string templ = "<?c>a</c>b<!c>c</c>";
+	BOOST_CHECK_EQUAL(Whiskers(templ)("c", false).render(), "b<!c>c</c>");
+	BOOST_CHECK_EQUAL(Whiskers(templ)("c", true).render(), "ab<!c>c</c>");
+}
+
+BOOST_AUTO_TEST_CASE(same_template_rendered_repeatedly)
+{
+	string templ = "<?+a><a><!+a>empty</+a>";
+	for (size_t i = 0; i < 3; ++i)
+	{
+		BOOST_CHECK_EQUAL(Whiskers(templ)("a", to_string(i)).render(), to_string(i));
+		BOOST_CHECK_EQUAL(Whiskers(templ)("a", "").render(), "empty");
+	}
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }
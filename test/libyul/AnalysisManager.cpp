@@ -0,0 +1,101 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for the cache of analyses shared by optimiser steps.
+ */
+
+#include <test/Common.h>
+#include <test/libyul/Common.h>
+
+#include <libyul/optimiser/AnalysisManager.h>
+#include <libyul/optimiser/CallGraphGenerator.h>
+#include <libyul/optimiser/Semantics.h>
+#include <libyul/backends/evm/EVMDialect.h>
+#include <libyul/AST.h>
+
+#include <boost/test/unit_test.hpp>
+
+using namespace std;
+
+namespace solidity::yul::test
+{
+
+namespace
+{
+
+Dialect const& evmDialect()
+{
+	return EVMDialect::strictAssemblyForEVM(solidity::test::CommonOptions::get().evmVersion());
+}
+
+void checkResults(AnalysisManager& _analyses, Block const& _ast)
+{
+	BOOST_CHECK(_analyses.functionSideEffects() == SideEffectsPropagator::sideEffects(
+		evmDialect(),
+		CallGraphGenerator::callGraph(_ast)
+	));
+	BOOST_CHECK_EQUAL(_analyses.containsMSize(), MSizeFinder::containsMSize(evmDialect(), _ast));
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(YulAnalysisManager)
+
+BOOST_AUTO_TEST_CASE(updates_changed_functions)
+{
+	Block ast = disambiguate(R"({
+		{ sstore(0, f(1)) }
+		function f(x) -> y { y := g(x) }
+		function g(x) -> y { y := add(x, 1) }
+		function h() { for {} 1 {} { sstore(0, 1) } }
+	})", false);
+	Block changed = disambiguate(R"({
+		function g(x) -> y { y := add(x, msize()) }
+	})", false);
+
+	AnalysisManager analyses{evmDialect()};
+	analyses.track(&ast);
+	BOOST_CHECK(analyses.tracks(ast));
+	checkResults(analyses, ast);
+	BOOST_CHECK(!analyses.containsMSize());
+	BOOST_CHECK(analyses.functionSideEffects().at("f"_yulstring).movable);
+
+	// Unchanged AST.
+	analyses.modified();
+	checkResults(analyses, ast);
+
+	swap(ast.statements.at(2), changed.statements.at(0));
+	analyses.modified();
+	checkResults(analyses, ast);
+	BOOST_CHECK(analyses.containsMSize());
+	BOOST_CHECK(!analyses.functionSideEffects().at("f"_yulstring).movable);
+
+	// Removed function and changed code outside of functions.
+	ast.statements.pop_back();
+	std::get<Block>(ast.statements.at(0)).statements.clear();
+	analyses.modified();
+	checkResults(analyses, ast);
+	BOOST_CHECK(!analyses.functionSideEffects().count("h"_yulstring));
+
+	analyses.track(nullptr);
+	BOOST_CHECK(!analyses.tracks(ast));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
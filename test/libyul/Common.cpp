@@ -54,9 +54,9 @@ Dialect const& defaultDialect(bool _yul)
 }
 }
 
-void yul::test::printErrors(ErrorList const& _errors)
+void yul::test::printErrors(ErrorList const& _errors, CharStreamProvider const& _charStreamProvider)
 {
-	SourceReferenceFormatter formatter(cout, true, false);
+	SourceReferenceFormatter formatter(cout, _charStreamProvider, true, false);
 
 	for (auto const& error: _errors)
 		formatter.printErrorInformation(*error);
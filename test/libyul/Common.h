@@ -29,6 +29,7 @@
 
 namespace solidity::langutil
 {
+class CharStreamProvider;
 class Error;
 using ErrorList = std::vector<std::shared_ptr<Error const>>;
 }
@@ -44,7 +45,7 @@ struct Dialect;
 namespace solidity::yul::test
 {
 
-void printErrors(langutil::ErrorList const& _errors);
+void printErrors(langutil::ErrorList const& _errors, langutil::CharStreamProvider const& _charStreamProvider);
 
 std::pair<std::shared_ptr<Block>, std::shared_ptr<AsmAnalysisInfo>>
 parse(std::string const& _source, bool _yul = true);
@@ -0,0 +1,119 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for the control flow graph of Yul functions.
+ */
+
+#include <test/Common.h>
+#include <test/libyul/Common.h>
+
+#include <libyul/optimiser/ControlFlowGraph.h>
+#include <libyul/backends/evm/EVMDialect.h>
+#include <libyul/AST.h>
+
+#include <boost/test/unit_test.hpp>
+
+using namespace std;
+
+namespace solidity::yul::test
+{
+
+namespace
+{
+
+Dialect const& evmDialect()
+{
+	return EVMDialect::strictAssemblyForEVM(solidity::test::CommonOptions::get().evmVersion());
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(YulControlFlowGraph)
+
+BOOST_AUTO_TEST_CASE(branches_and_loops)
+{
+	Block ast = disambiguate(R"({
+		function f(a) -> r {
+			let x := 1
+			if a { x := 2 }
+			r := x
+			for { let i := 0 } lt(i, a) { i := add(i, 1) } {
+				if eq(i, 3) { break }
+				sstore(i, x)
+			}
+		}
+	})", false);
+	FunctionDefinition const& function = std::get<FunctionDefinition>(ast.statements.at(0));
+	vector<Statement> const& body = function.body.statements;
+	Statement const& declaration = body.at(0);
+	Statement const& assignment = std::get<If>(body.at(1)).body.statements.at(0);
+	Statement const& returnAssignment = body.at(2);
+	ForLoop const& loop = std::get<ForLoop>(body.at(3));
+	Statement const& store = loop.body.statements.at(1);
+
+	ControlFlowGraph graph{evmDialect(), function};
+	size_t ifBody = graph.blockOf(assignment);
+	size_t afterIf = graph.blockOf(returnAssignment);
+	size_t loopBody = graph.blockOf(store);
+	BOOST_CHECK_EQUAL(graph.blockOf(declaration), ControlFlowGraph::entry);
+	BOOST_CHECK(graph.blocks()[ControlFlowGraph::entry].condition == std::get<If>(body.at(1)).condition.get());
+	BOOST_CHECK_EQUAL(graph.blockOf(loop.pre.statements.at(0)), afterIf);
+
+	BOOST_CHECK_EQUAL(graph.immediateDominator(ifBody), ControlFlowGraph::entry);
+	BOOST_CHECK_EQUAL(graph.immediateDominator(afterIf), ControlFlowGraph::entry);
+	BOOST_CHECK(graph.dominates(afterIf, loopBody));
+	BOOST_CHECK(!graph.dominates(ifBody, afterIf));
+	BOOST_CHECK(graph.reachable(ControlFlowGraph::exit));
+
+	BOOST_CHECK(graph.liveIn(ControlFlowGraph::entry) == set<YulString>{"a"_yulstring});
+	BOOST_CHECK(graph.liveIn(ControlFlowGraph::exit) == set<YulString>{"r"_yulstring});
+	BOOST_CHECK((graph.liveIn(afterIf) == set<YulString>{"a"_yulstring, "x"_yulstring}));
+	BOOST_CHECK((graph.liveIn(loopBody) == set<YulString>{"a"_yulstring, "i"_yulstring, "r"_yulstring, "x"_yulstring}));
+
+	BOOST_CHECK((graph.reachingDefinitions(afterIf).at("x"_yulstring) == set<ControlFlowGraph::Definition>{&declaration, &assignment}));
+	BOOST_CHECK((graph.reachingDefinitions(afterIf).at("r"_yulstring) == set<ControlFlowGraph::Definition>{nullptr}));
+	BOOST_CHECK((graph.reachingDefinitions(ControlFlowGraph::exit).at("r"_yulstring) == set<ControlFlowGraph::Definition>{&returnAssignment}));
+	BOOST_CHECK_EQUAL(graph.reachingDefinitions(loopBody).at("i"_yulstring).size(), 2u);
+}
+
+BOOST_AUTO_TEST_CASE(terminating_statements)
+{
+	Block ast = disambiguate(R"({
+		function f(a) -> r {
+			if a { revert(0, 0) }
+			r := 1
+			leave
+			r := 2
+		}
+	})", false);
+	FunctionDefinition const& function = std::get<FunctionDefinition>(ast.statements.at(0));
+	vector<Statement> const& body = function.body.statements;
+
+	ControlFlowGraph graph{evmDialect(), function};
+	size_t revertBlock = graph.blockOf(std::get<If>(body.at(0)).body.statements.at(0));
+	BOOST_CHECK(graph.blocks()[revertBlock].successors.empty());
+	BOOST_CHECK(graph.dominates(graph.blockOf(body.at(1)), ControlFlowGraph::exit));
+	size_t deadBlock = graph.blockOf(body.at(3));
+	BOOST_CHECK(!graph.reachable(deadBlock));
+	BOOST_CHECK(!graph.dominates(ControlFlowGraph::entry, deadBlock));
+	BOOST_CHECK(graph.liveIn(ControlFlowGraph::entry) == set<YulString>{"a"_yulstring});
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
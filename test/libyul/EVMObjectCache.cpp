@@ -0,0 +1,101 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for the cache of the assemblies compiled from Yul objects.
+ */
+
+#include <test/Common.h>
+
+#include <libyul/AssemblyStack.h>
+#include <libyul/backends/evm/EVMObjectCache.h>
+
+#include <libsolidity/interface/OptimiserSettings.h>
+
+#include <libsolutil/CommonData.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <memory>
+#include <string>
+
+using namespace std;
+using namespace solidity::frontend;
+
+namespace solidity::yul::test
+{
+
+namespace
+{
+
+/// @returns an object that creates the object "B", which is the same for all @a _value.
+string sourceCode(string const& _value)
+{
+	return R"(
+		object "A" {
+			code {
+				sstore(0, )" + _value + R"()
+				sstore(1, datasize("B.D"))
+				datacopy(0, dataoffset("B"), datasize("B"))
+				return(0, datasize("B"))
+			}
+			object "B" {
+				code {
+					datacopy(0, dataoffset("D"), datasize("D"))
+					return(0, datasize("D"))
+				}
+				object "D" {
+					code { sstore(1, 2) }
+				}
+				data "x" hex"1234"
+			}
+		}
+	)";
+}
+
+string bytecode(string const& _source, shared_ptr<EVMObjectCache> _cache)
+{
+	AssemblyStack stack(
+		solidity::test::CommonOptions::get().evmVersion(),
+		AssemblyStack::Language::StrictAssembly,
+		OptimiserSettings::full()
+	);
+	BOOST_REQUIRE(stack.parseAndAnalyze("", _source));
+	stack.setEVMObjectCache(move(_cache));
+	stack.optimize();
+	return util::toHex(stack.assemble(AssemblyStack::Machine::EVM).bytecode->bytecode);
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(EVMObjectCacheTest)
+
+BOOST_AUTO_TEST_CASE(shared_sub_objects_are_identical)
+{
+	string const first = bytecode(sourceCode("1"), nullptr);
+	string const second = bytecode(sourceCode("2"), nullptr);
+	BOOST_CHECK(first != second);
+
+	auto cache = make_shared<EVMObjectCache>();
+	BOOST_CHECK_EQUAL(bytecode(sourceCode("1"), cache), first);
+	BOOST_CHECK_EQUAL(bytecode(sourceCode("2"), cache), second);
+	BOOST_CHECK_EQUAL(bytecode(sourceCode("1"), cache), first);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
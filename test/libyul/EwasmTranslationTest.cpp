@@ -92,7 +92,7 @@ bool EwasmTranslationTest::parse(ostream& _stream, string const& _linePrefix, bo
 	else
 	{
 		AnsiColorized(_stream, _formatted, {formatting::BOLD, formatting::RED}) << _linePrefix << "Error parsing source." << endl;
-		printErrors(_stream, stack.errors());
+		printErrors(_stream, stack.errors(), stack);
 		return false;
 	}
 }
@@ -116,9 +116,13 @@ string EwasmTranslationTest::interpret()
 	return result.str();
 }
 
-void EwasmTranslationTest::printErrors(ostream& _stream, ErrorList const& _errors)
+void EwasmTranslationTest::printErrors(
+	ostream& _stream,
+	ErrorList const& _errors,
+	CharStreamProvider const& _charStreamProvider
+)
 {
-	SourceReferenceFormatter formatter(_stream, true, false);
+	SourceReferenceFormatter formatter(_stream, _charStreamProvider, true, false);
 
 	for (auto const& error: _errors)
 		formatter.printErrorInformation(*error);
@@ -23,6 +23,7 @@
 namespace solidity::langutil
 {
 class Scanner;
+class CharStreamProvider;
 class Error;
 using ErrorList = std::vector<std::shared_ptr<Error const>>;
 }
@@ -51,7 +52,11 @@ private:
 	bool parse(std::ostream& _stream, std::string const& _linePrefix, bool const _formatted);
 	std::string interpret();
 
-	static void printErrors(std::ostream& _stream, langutil::ErrorList const& _errors);
+	static void printErrors(
+		std::ostream& _stream,
+		langutil::ErrorList const& _errors,
+		langutil::CharStreamProvider const& _charStreamProvider
+	);
 
 	std::shared_ptr<Object> m_object;
 };
@@ -0,0 +1,131 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for the reuse of the results of optimiser steps on single functions.
+ */
+
+#include <test/Common.h>
+#include <test/libyul/Common.h>
+
+#include <libyul/AssemblyStack.h>
+#include <libyul/AsmPrinter.h>
+#include <libyul/AST.h>
+#include <libyul/optimiser/FunctionStepCache.h>
+
+#include <libsolidity/interface/OptimiserSettings.h>
+
+#include <libsolutil/CompilationStatistics.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <string>
+
+using namespace std;
+using namespace solidity::frontend;
+
+namespace solidity::yul::test
+{
+
+namespace
+{
+
+FunctionDefinition const& function(Block const& _block)
+{
+	return std::get<FunctionDefinition>(_block.statements.front());
+}
+
+char const* sourceCode = R"(
+	object "A" {
+		code {
+			function helper(x, y) -> z { let t := add(x, y) z := mul(t, calldataload(t)) if gt(z, 7) { z := sub(z, 1) } }
+			sstore(0, helper(calldataload(0), 2))
+			return(0, datasize("B"))
+		}
+		object "B" {
+			code {
+				function helper(x, y) -> z { let t := add(x, y) z := mul(t, calldataload(t)) if gt(z, 7) { z := sub(z, 1) } }
+				sstore(1, helper(calldataload(32), 3))
+				sstore(2, helper(calldataload(64), 5))
+			}
+		}
+	}
+)";
+
+string optimize(size_t _parallelism, util::CompilationStatistics* _statistics = nullptr)
+{
+	OptimiserSettings settings = OptimiserSettings::full();
+	settings.yulReuseAcrossObjects = true;
+	AssemblyStack stack(
+		solidity::test::CommonOptions::get().evmVersion(),
+		AssemblyStack::Language::StrictAssembly,
+		settings
+	);
+	BOOST_REQUIRE(stack.parseAndAnalyze("", sourceCode));
+	stack.setParallelism(_parallelism);
+	util::CompilationStatistics::Scope scope(_statistics);
+	stack.optimize();
+	return stack.print();
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(YulFunctionStepCache)
+
+BOOST_AUTO_TEST_CASE(renamed_result)
+{
+	auto input = parse("{ function f(a, b) -> c { let t := add(a, b) c := mul(t, t) } }", false).first;
+	auto output = parse("{ function f(a, b) -> c { c := mul(add(a, b), add(a, b)) } }", false).first;
+	auto other = parse("{ function g(p, q) -> r { let s := add(p, q) r := mul(s, s) } }", false).first;
+	auto different = parse("{ function h(a, b) -> c { let t := add(b, a) c := mul(t, t) } }", false).first;
+
+	FunctionStepCache cache;
+	cache.record("step", FunctionStepCache::shape(function(*input)), function(*output));
+
+	FunctionDefinition result;
+	BOOST_CHECK(
+		cache.find("step", function(*other), FunctionStepCache::shape(function(*other)), result) ==
+		FunctionStepCache::Lookup::Changed
+	);
+	BOOST_CHECK_EQUAL(AsmPrinter{}(result), "function g(p, q) -> r\n{\n    r := mul(add(p, q), add(p, q))\n}");
+	BOOST_CHECK(
+		cache.find("otherStep", function(*other), FunctionStepCache::shape(function(*other)), result) ==
+		FunctionStepCache::Lookup::Unknown
+	);
+	BOOST_CHECK(
+		cache.find("step", function(*different), FunctionStepCache::shape(function(*different)), result) ==
+		FunctionStepCache::Lookup::Unknown
+	);
+
+	cache.record("unchanged", FunctionStepCache::shape(function(*input)), function(*input));
+	BOOST_CHECK(
+		cache.find("unchanged", function(*other), FunctionStepCache::shape(function(*other)), result) ==
+		FunctionStepCache::Lookup::Unchanged
+	);
+}
+
+BOOST_AUTO_TEST_CASE(reuse_across_objects)
+{
+	util::CompilationStatistics statistics;
+	string serial = optimize(1, &statistics);
+	BOOST_CHECK(statistics.counters().count("yulOptimiser/reusedFunctionResults"));
+	BOOST_CHECK_EQUAL(optimize(8), serial);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
@@ -23,6 +23,7 @@
 namespace solidity::langutil
 {
 class Scanner;
+class CharStreamProvider;
 class Error;
 using ErrorList = std::vector<std::shared_ptr<Error const>>;
 }
@@ -52,7 +53,11 @@ private:
 	bool parse(std::ostream& _stream, std::string const& _linePrefix, bool const _formatted);
 	void disambiguate();
 
-	static void printErrors(std::ostream& _stream, langutil::ErrorList const& _errors);
+	static void printErrors(
+		std::ostream& _stream,
+		langutil::ErrorList const& _errors,
+		langutil::CharStreamProvider const& _charStreamProvider
+	);
 
 	bool m_optimize = false;
 	bool m_wasm = false;
@@ -0,0 +1,120 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for the cache of the results of the Yul optimizer.
+ */
+
+#include <test/Common.h>
+
+#include <libyul/AssemblyStack.h>
+#include <libyul/optimiser/OptimisedCodeCache.h>
+
+#include <libsolidity/interface/OptimiserSettings.h>
+
+#include <boost/filesystem.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <fstream>
+#include <memory>
+#include <string>
+
+using namespace std;
+using namespace solidity::frontend;
+
+namespace solidity::yul::test
+{
+
+namespace
+{
+
+char const* sourceCode = R"(
+	object "A" {
+		code {
+			function f(x) -> y { y := add(x, 1) }
+			sstore(0, f(calldataload(0)))
+			return(0, datasize("B"))
+		}
+		object "B" {
+			code {
+				function f(x) -> y { y := mul(x, 2) }
+				sstore(1, f(calldataload(0)))
+			}
+		}
+	}
+)";
+
+string optimize(shared_ptr<OptimisedCodeCache> _cache)
+{
+	AssemblyStack stack(
+		solidity::test::CommonOptions::get().evmVersion(),
+		AssemblyStack::Language::StrictAssembly,
+		OptimiserSettings::full()
+	);
+	BOOST_REQUIRE(stack.parseAndAnalyze("", sourceCode));
+	stack.setOptimisedCodeCache(move(_cache));
+	stack.optimize();
+	return stack.print();
+}
+
+void overwriteEntries(boost::filesystem::path const& _directory, string const& _content)
+{
+	for (auto const& entry: boost::filesystem::directory_iterator(_directory))
+		ofstream(entry.path().string(), ios::trunc) << _content;
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(OptimisedCodeCacheTest)
+
+BOOST_AUTO_TEST_CASE(cached_results_are_identical)
+{
+	string const expectation = optimize(nullptr);
+	auto cache = make_shared<OptimisedCodeCache>();
+	BOOST_CHECK_EQUAL(optimize(cache), expectation);
+	BOOST_CHECK_EQUAL(optimize(cache), expectation);
+}
+
+BOOST_AUTO_TEST_CASE(entries_on_disk)
+{
+	boost::filesystem::path const directory =
+		boost::filesystem::temp_directory_path() / boost::filesystem::unique_path("solc-yul-cache-test-%%%%-%%%%");
+	string const expectation = optimize(make_shared<OptimisedCodeCache>("salt", directory));
+
+	size_t entries = 0;
+	for (auto const& entry: boost::filesystem::directory_iterator(directory))
+		if (entry.path().extension() == ".yul")
+			++entries;
+	BOOST_CHECK_EQUAL(entries, 2);
+
+	// A new cache on the same directory reads the entries.
+	overwriteEntries(directory, "{ sstore(7, 7) }");
+	BOOST_CHECK(optimize(make_shared<OptimisedCodeCache>("salt", directory)).find("sstore(7, 7)") != string::npos);
+	BOOST_CHECK_EQUAL(optimize(make_shared<OptimisedCodeCache>("other salt", directory)), expectation);
+
+	// Invalid entries are optimized again.
+	overwriteEntries(directory, "{ sstore(");
+	BOOST_CHECK_EQUAL(optimize(make_shared<OptimisedCodeCache>("salt", directory)), expectation);
+	overwriteEntries(directory, "{ sstore(0, undefined) }");
+	BOOST_CHECK_EQUAL(optimize(make_shared<OptimisedCodeCache>("salt", directory)), expectation);
+
+	boost::filesystem::remove_all(directory);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
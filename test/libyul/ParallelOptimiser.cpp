@@ -0,0 +1,135 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for the concurrent optimisation and compilation of Yul code.
+ */
+
+#include <test/Common.h>
+
+#include <libyul/AssemblyStack.h>
+
+#include <libevmasm/LinkerObject.h>
+
+#include <libsolidity/interface/OptimiserSettings.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <string>
+
+using namespace std;
+using namespace solidity::frontend;
+
+namespace solidity::yul::test
+{
+
+namespace
+{
+
+char const* sourceCode = R"(
+	object "A" {
+		code {
+			sstore(0, f(calldataload(0)))
+			sstore(1, g(calldataload(32)))
+			sstore(2, h(calldataload(64), calldataload(96)))
+			sstore(3, k(calldataload(128)))
+			function f(x) -> y { y := add(x, 1) let z := mload(0) if gt(z, 2) { y := add(y, z) } }
+			function g(x) -> y { for { let i := 0 } lt(i, x) { i := add(i, 1) } { y := add(y, sload(i)) } }
+			function h(a, b) -> c { mstore(0, a) mstore(32, b) c := keccak256(0, 64) c := add(c, mload(0)) }
+			function k(x) -> y { switch x case 0 { y := f(x) } default { y := g(sub(x, 1)) } }
+		}
+	}
+)";
+
+char const* objectsSourceCode = R"(
+	object "A" {
+		code {
+			datacopy(0, dataoffset("B"), datasize("B"))
+			datacopy(0, dataoffset("C"), datasize("C"))
+			return(0, add(datasize("B"), datasize("C")))
+		}
+		object "B" {
+			code {
+				datacopy(0, dataoffset("D"), datasize("D"))
+				sstore(0, add(calldataload(0), 7))
+				return(0, datasize("D"))
+			}
+			object "D" {
+				code { sstore(1, mload(0)) }
+			}
+		}
+		object "C" {
+			code {
+				function f(x) -> y { for { let i := 0 } lt(i, x) { i := add(i, 1) } { y := add(y, sload(i)) } }
+				sstore(2, f(calldataload(0)))
+			}
+		}
+		data "E" hex"c0ffee"
+	}
+)";
+
+string optimize(size_t _parallelism, char const* _source = sourceCode)
+{
+	AssemblyStack stack(
+		solidity::test::CommonOptions::get().evmVersion(),
+		AssemblyStack::Language::StrictAssembly,
+		OptimiserSettings::full()
+	);
+	BOOST_REQUIRE(stack.parseAndAnalyze("", _source));
+	stack.setParallelism(_parallelism);
+	stack.optimize();
+	return stack.print();
+}
+
+bytes assemble(size_t _parallelism)
+{
+	AssemblyStack stack(
+		solidity::test::CommonOptions::get().evmVersion(),
+		AssemblyStack::Language::StrictAssembly,
+		OptimiserSettings::full()
+	);
+	BOOST_REQUIRE(stack.parseAndAnalyze("", objectsSourceCode));
+	stack.setParallelism(_parallelism);
+	stack.optimize();
+	return stack.assemble(AssemblyStack::Machine::EVM).bytecode->bytecode;
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(YulParallelOptimiser)
+
+BOOST_AUTO_TEST_CASE(same_result_as_serial)
+{
+	string serial = optimize(1);
+	BOOST_CHECK_EQUAL(optimize(2), serial);
+	BOOST_CHECK_EQUAL(optimize(8), serial);
+}
+
+BOOST_AUTO_TEST_CASE(sub_objects)
+{
+	string serial = optimize(1, objectsSourceCode);
+	BOOST_CHECK_EQUAL(optimize(2, objectsSourceCode), serial);
+	BOOST_CHECK_EQUAL(optimize(8, objectsSourceCode), serial);
+
+	bytes serialBytecode = assemble(1);
+	BOOST_CHECK(assemble(2) == serialBytecode);
+	BOOST_CHECK(assemble(8) == serialBytecode);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
@@ -19,6 +19,7 @@
 #include <test/libyul/YulInterpreterTest.h>
 
 #include <test/tools/yulInterpreter/Interpreter.h>
+#include <test/tools/yulInterpreter/LoweredInterpreter.h>
 
 #include <test/Common.h>
 
@@ -58,7 +59,13 @@ TestCase::TestResult YulInterpreterTest::run(ostream& _stream, string const& _li
 	if (!parse(_stream, _linePrefix, _formatted))
 		return TestResult::FatalError;
 
-	m_obtainedResult = interpret();
+	m_obtainedResult = interpret(false);
+	if (interpret(true) != m_obtainedResult)
+	{
+		AnsiColorized(_stream, _formatted, {formatting::BOLD, formatting::RED}) << _linePrefix
+			<< "Lowered interpreter produced a different result." << endl;
+		return TestResult::Failure;
+	}
 
 	return checkResult(_stream, _linePrefix, _formatted);
 }
@@ -79,12 +86,12 @@ bool YulInterpreterTest::parse(ostream& _stream, string const& _linePrefix, bool
 	else
 	{
 		AnsiColorized(_stream, _formatted, {formatting::BOLD, formatting::RED}) << _linePrefix << "Error parsing source." << endl;
-		printErrors(_stream, stack.errors());
+		printErrors(_stream, stack.errors(), stack);
 		return false;
 	}
 }
 
-string YulInterpreterTest::interpret()
+string YulInterpreterTest::interpret(bool _lowered)
 {
 	InterpreterState state;
 	state.maxTraceSize = 32;
@@ -92,7 +99,11 @@ string YulInterpreterTest::interpret()
 	state.maxExprNesting = 64;
 	try
 	{
-		Interpreter::run(state, EVMDialect::strictAssemblyForEVMObjects(langutil::EVMVersion{}), *m_ast);
+		Dialect const& dialect = EVMDialect::strictAssemblyForEVMObjects(langutil::EVMVersion{});
+		if (_lowered)
+			LoweredInterpreter::run(state, dialect, *m_ast);
+		else
+			Interpreter::run(state, dialect, *m_ast);
 	}
 	catch (InterpreterTerminatedGeneric const&)
 	{
@@ -103,9 +114,13 @@ string YulInterpreterTest::interpret()
 	return result.str();
 }
 
-void YulInterpreterTest::printErrors(ostream& _stream, ErrorList const& _errors)
+void YulInterpreterTest::printErrors(
+	ostream& _stream,
+	ErrorList const& _errors,
+	CharStreamProvider const& _charStreamProvider
+)
 {
-	SourceReferenceFormatter formatter(_stream, true, false);
+	SourceReferenceFormatter formatter(_stream, _charStreamProvider, true, false);
 
 	for (auto const& error: _errors)
 		formatter.printErrorInformation(*error);
@@ -23,6 +23,7 @@
 namespace solidity::langutil
 {
 class Scanner;
+class CharStreamProvider;
 class Error;
 using ErrorList = std::vector<std::shared_ptr<Error const>>;
 }
@@ -50,9 +51,15 @@ public:
 
 private:
 	bool parse(std::ostream& _stream, std::string const& _linePrefix, bool const _formatted);
-	std::string interpret();
+	/// Runs the code with Interpreter or, if @a _lowered is set, LoweredInterpreter
+	/// and @returns the trace and the final state.
+	std::string interpret(bool _lowered);
 
-	static void printErrors(std::ostream& _stream, langutil::ErrorList const& _errors);
+	static void printErrors(
+		std::ostream& _stream,
+		langutil::ErrorList const& _errors,
+		langutil::CharStreamProvider const& _charStreamProvider
+	);
 
 	std::shared_ptr<Block> m_ast;
 	std::shared_ptr<AsmAnalysisInfo> m_analysisInfo;
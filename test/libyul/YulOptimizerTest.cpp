@@ -115,15 +115,20 @@ std::pair<std::shared_ptr<Object>, std::shared_ptr<AsmAnalysisInfo>> YulOptimize
 	if (!object || !analysisInfo || !Error::containsOnlyWarnings(errors))
 	{
 		AnsiColorized(_stream, _formatted, {formatting::BOLD, formatting::RED}) << _linePrefix << "Error parsing source." << endl;
-		printErrors(_stream, errors);
+		CharStream charStream(_source, "");
+		printErrors(_stream, errors, SingletonCharStreamProvider(charStream));
 		return {};
 	}
 	return {std::move(object), std::move(analysisInfo)};
 }
 
-void YulOptimizerTest::printErrors(ostream& _stream, ErrorList const& _errors)
+void YulOptimizerTest::printErrors(
+	ostream& _stream,
+	ErrorList const& _errors,
+	CharStreamProvider const& _charStreamProvider
+)
 {
-	SourceReferenceFormatter formatter(_stream, true, false);
+	SourceReferenceFormatter formatter(_stream, _charStreamProvider, true, false);
 
 	for (auto const& error: _errors)
 		formatter.printErrorInformation(*error);
@@ -22,6 +22,7 @@
 
 namespace solidity::langutil
 {
+class CharStreamProvider;
 class Error;
 using ErrorList = std::vector<std::shared_ptr<Error const>>;
 }
@@ -51,7 +52,11 @@ private:
 	std::pair<std::shared_ptr<Object>, std::shared_ptr<AsmAnalysisInfo>> parse(
 		std::ostream& _stream, std::string const& _linePrefix, bool const _formatted, std::string const& _source
 	);
-	static void printErrors(std::ostream& _stream, langutil::ErrorList const& _errors);
+	static void printErrors(
+		std::ostream& _stream,
+		langutil::ErrorList const& _errors,
+		langutil::CharStreamProvider const& _charStreamProvider
+	);
 
 	std::string m_optimizerStep;
 
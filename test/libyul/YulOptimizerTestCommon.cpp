@@ -25,6 +25,7 @@
 #include <libyul/optimiser/DeadCodeEliminator.h>
 #include <libyul/optimiser/Disambiguator.h>
 #include <libyul/optimiser/CircularReferencesPruner.h>
+#include <libyul/optimiser/ColdCodeOutliner.h>
 #include <libyul/optimiser/ConditionalUnsimplifier.h>
 #include <libyul/optimiser/ConditionalSimplifier.h>
 #include <libyul/optimiser/CommonSubexpressionEliminator.h>
@@ -32,12 +33,15 @@
 #include <libyul/optimiser/ExpressionSplitter.h>
 #include <libyul/optimiser/FunctionGrouper.h>
 #include <libyul/optimiser/FunctionHoister.h>
+#include <libyul/optimiser/FunctionSpecializer.h>
+#include <libyul/optimiser/GlobalValueNumbering.h>
 #include <libyul/optimiser/ExpressionInliner.h>
 #include <libyul/optimiser/FullInliner.h>
 #include <libyul/optimiser/ForLoopConditionIntoBody.h>
 #include <libyul/optimiser/ForLoopInitRewriter.h>
 #include <libyul/optimiser/LoadResolver.h>
 #include <libyul/optimiser/LoopInvariantCodeMotion.h>
+#include <libyul/optimiser/LoopUnroller.h>
 #include <libyul/optimiser/MainFunction.h>
 #include <libyul/optimiser/StackLimitEvader.h>
 #include <libyul/optimiser/NameDisplacer.h>
@@ -45,6 +49,7 @@
 #include <libyul/optimiser/ExpressionSimplifier.h>
 #include <libyul/optimiser/UnusedFunctionParameterPruner.h>
 #include <libyul/optimiser/UnusedPruner.h>
+#include <libyul/optimiser/ValueRangeSimplifier.h>
 #include <libyul/optimiser/ExpressionJoiner.h>
 #include <libyul/optimiser/OptimiserStep.h>
 #include <libyul/optimiser/ReasoningBasedSimplifier.h>
@@ -207,6 +212,11 @@ YulOptimizerTestCommon::YulOptimizerTestCommon(
 			LiteralRematerialiser::run(*m_context, *m_object->code);
 			UnusedFunctionParameterPruner::run(*m_context, *m_object->code);
 		}},
+		{"functionSpecializer", [&]() {
+			disambiguate();
+			FunctionHoister::run(*m_context, *m_ast);
+			FunctionSpecializer::run(*m_context, *m_ast);
+		}},
 		{"unusedPruner", [&]() {
 			disambiguate();
 			UnusedPruner::run(*m_context, *m_ast);
@@ -257,6 +267,19 @@ YulOptimizerTestCommon::YulOptimizerTestCommon(
 			FunctionHoister::run(*m_context, *m_ast);
 			LoopInvariantCodeMotion::run(*m_context, *m_ast);
 		}},
+		{"coldCodeOutliner", [&]() {
+			disambiguate();
+			FunctionHoister::run(*m_context, *m_ast);
+			ColdCodeOutliner::run(*m_context, *m_ast);
+		}},
+		{"loopUnroller", [&]() {
+			disambiguate();
+			FunctionHoister::run(*m_context, *m_ast);
+			GasMeter meter(dynamic_cast<EVMDialect const&>(*m_dialect), false, 200);
+			m_context->meter = &meter;
+			LoopUnroller::run(*m_context, *m_ast);
+			m_context->meter = nullptr;
+		}},
 		{"controlFlowSimplifier", [&]() {
 			disambiguate();
 			ForLoopInitRewriter::run(*m_context, *m_ast);
@@ -273,6 +296,16 @@ YulOptimizerTestCommon::YulOptimizerTestCommon(
 			disambiguate();
 			ReasoningBasedSimplifier::run(*m_context, *m_object->code);
 		}},
+		{"valueRangeSimplifier", [&]() {
+			disambiguate();
+			ForLoopInitRewriter::run(*m_context, *m_ast);
+			ValueRangeSimplifier::run(*m_context, *m_ast);
+		}},
+		{"globalValueNumbering", [&]() {
+			disambiguate();
+			ForLoopInitRewriter::run(*m_context, *m_ast);
+			GlobalValueNumbering::run(*m_context, *m_ast);
+		}},
 		{"equivalentFunctionCombiner", [&]() {
 			disambiguate();
 			ForLoopInitRewriter::run(*m_context, *m_ast);
@@ -428,6 +461,7 @@ void YulOptimizerTestCommon::updateContext()
 	m_context = make_unique<OptimiserStepContext>(OptimiserStepContext{
 		*m_dialect,
 		*m_nameDispenser,
-		m_reservedIdentifiers
+		m_reservedIdentifiers,
+		nullptr
 	});
 }
@@ -61,7 +61,27 @@ IsolTestOptions::IsolTestOptions(std::string* _editor):
 {
 	options.add_options()
 		("editor", po::value<std::string>(_editor)->default_value(editorPath()), "Path to editor for opening test files.")
+		(
+			"gas-report",
+			po::value<std::string>(&gasReport),
+			"Write the gas costs and code sizes of the semantic tests to the given file. "
+			"Entries of the configurations that are not run are kept if the file exists."
+		)
+		(
+			"gas-baseline",
+			po::value<std::string>(&gasBaseline),
+			"Compare the gas costs and code sizes of the semantic tests against the given report and fail if one grew by more than the threshold."
+		)
+		("gas-threshold", po::value<double>(&gasThreshold)->default_value(0), "Percentage by which values may change before they are reported.")
+		(
+			"gas-profile",
+			po::value<std::string>(&gasProfile),
+			"Profile the semantic tests instruction by instruction and write the gas used by each call stack "
+			"of Solidity or Yul functions and source lines to the given file, in the input format of flamegraph.pl."
+		)
+		("gas-profile-counts", po::bool_switch(&gasProfileCounts), "Weight the gas profile by the number of executed instructions instead of gas.")
 		("help", po::bool_switch(&showHelp), "Show this help screen.")
+		("jobs,j", po::value<size_t>(&jobs)->default_value(1), "Number of tests to run concurrently (0 for one per hardware thread). Failing tests are not handled interactively if more than one test runs at a time.")
 		("no-color", po::bool_switch(&noColor), "Don't use colors.")
 		("test,t", po::value<std::string>(&testFilter)->default_value("*/*"), "Filters which test units to include.");
 }
@@ -89,6 +109,7 @@ void IsolTestOptions::validate() const
 		ConfigException,
 		"Invalid test unit filter - can only contain '" + filterString + ": " + testFilter
 	);
+	assertThrow(gasThreshold >= 0, ConfigException, "The gas threshold must not be negative.");
 }
 
 }
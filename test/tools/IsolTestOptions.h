@@ -32,6 +32,18 @@ struct IsolTestOptions: CommonOptions
 	bool showHelp = false;
 	bool noColor = false;
 	std::string testFilter = std::string{};
+	/// Number of tests to run concurrently, zero meaning one per hardware thread.
+	size_t jobs = 1;
+	/// File the gas costs and code sizes of the semantic tests are written to.
+	std::string gasReport;
+	/// Gas report to compare the gas costs and code sizes against.
+	std::string gasBaseline;
+	/// Percentage by which the values may differ from the baseline before they are reported.
+	double gasThreshold = 0;
+	/// File the gas profile of the semantic tests is written to in the format of flamegraph.pl.
+	std::string gasProfile;
+	/// Whether the gas profile counts executed instructions instead of gas.
+	bool gasProfileCounts = false;
 
 	IsolTestOptions(std::string* _editor);
 	bool parse(int _argc, char const* const* _argv) override;
@@ -27,9 +27,14 @@
 
 #include <libsolc/libsolc.h>
 
+#include <libyul/YulString.h>
+
 #include <liblangutil/Exceptions.h>
+#include <liblangutil/Symbol.h>
 
+#include <atomic>
 #include <sstream>
+#include <thread>
 
 using namespace std;
 using namespace solidity;
@@ -81,7 +86,36 @@ void FuzzerUtil::forceSMT(StringMap& _input)
 			sourceUnit.second += smtPragma;
 }
 
-void FuzzerUtil::testCompiler(
+namespace
+{
+
+/// Number of Yul strings after which the repository is cleared between inputs in persistent mode.
+constexpr size_t maxPersistentYulStrings = 1 << 20;
+/// Number of interned symbols after which the symbol table is cleared between inputs in persistent mode.
+constexpr size_t maxPersistentSymbols = 1 << 20;
+
+/// Number of threads that compile in persistent mode.
+atomic<size_t> s_persistentThreads{0};
+/// Set while the only thread in persistent mode resets the Yul string repository and the symbol table.
+atomic<bool> s_resettingSharedTables{false};
+
+/// Compiler stack of a thread in persistent mode.
+struct PersistentCompilerStack
+{
+	PersistentCompilerStack()
+	{
+		++s_persistentThreads;
+		// Wait for a reset of the shared tables that started before this thread was counted.
+		while (s_resettingSharedTables)
+			this_thread::yield();
+	}
+	~PersistentCompilerStack() { --s_persistentThreads; }
+
+	frontend::CompilerStack stack;
+};
+
+void compile(
+	frontend::CompilerStack& _compiler,
 	StringMap& _input,
 	bool _optimize,
 	unsigned _rand,
@@ -89,7 +123,6 @@ void FuzzerUtil::testCompiler(
 	bool _compileViaYul
 )
 {
-	frontend::CompilerStack compiler;
 	EVMVersion evmVersion = s_evmVersions[_rand % s_evmVersions.size()];
 	frontend::OptimiserSettings optimiserSettings;
 	if (_optimize)
@@ -98,16 +131,18 @@ void FuzzerUtil::testCompiler(
 		optimiserSettings = frontend::OptimiserSettings::minimal();
 	if (_forceSMT)
 	{
-		forceSMT(_input);
-		compiler.setModelCheckerSettings({frontend::ModelCheckerEngine::All(), frontend::ModelCheckerTargets::All(), /*timeout=*/1});
+		FuzzerUtil::forceSMT(_input);
+		frontend::ModelCheckerSettings modelCheckerSettings;
+		modelCheckerSettings.timeout = 1;
+		_compiler.setModelCheckerSettings(modelCheckerSettings);
 	}
-	compiler.setSources(_input);
-	compiler.setEVMVersion(evmVersion);
-	compiler.setOptimiserSettings(optimiserSettings);
-	compiler.enableIRGeneration(_compileViaYul);
+	_compiler.setSources(_input);
+	_compiler.setEVMVersion(evmVersion);
+	_compiler.setOptimiserSettings(optimiserSettings);
+	_compiler.enableIRGeneration(_compileViaYul);
 	try
 	{
-		compiler.compile();
+		_compiler.compile();
 	}
 	catch (Error const&)
 	{
@@ -123,6 +158,41 @@ void FuzzerUtil::testCompiler(
 	}
 }
 
+}
+
+void FuzzerUtil::testCompiler(
+	StringMap& _input,
+	bool _optimize,
+	unsigned _rand,
+	bool _forceSMT,
+	bool _compileViaYul,
+	bool _persistent
+)
+{
+	if (!_persistent)
+	{
+		frontend::CompilerStack compiler;
+		compile(compiler, _input, _optimize, _rand, _forceSMT, _compileViaYul);
+		return;
+	}
+
+	thread_local PersistentCompilerStack compiler;
+	compiler.stack.reset(false);
+	// The Yul string repository and the symbol table are shared by all threads and must not be
+	// reset while another thread compiles. They are therefore only reset if this is the only
+	// thread in persistent mode.
+	s_resettingSharedTables = true;
+	if (s_persistentThreads == 1)
+	{
+		if (yul::YulStringRepository::instance().size() > maxPersistentYulStrings)
+			yul::YulStringRepository::reset();
+		if (langutil::Symbol::size() > maxPersistentSymbols)
+			langutil::Symbol::reset();
+	}
+	s_resettingSharedTables = false;
+	compile(compiler.stack, _input, _optimize, _rand, _forceSMT, _compileViaYul);
+}
+
 void FuzzerUtil::runCompiler(string const& _input, bool _quiet)
 {
 	if (!_quiet)
@@ -37,12 +37,17 @@ struct FuzzerUtil
 	/// version to be compiled for, and bool @param _forceSMT that, if true,
 	/// adds the experimental SMTChecker pragma to each source file in the
 	/// source map.
+	/// If @param _persistent is true, every thread compiles with one compiler stack that is only
+	/// reset between the inputs, so that the Yul dialects and strings stay alive. This works for
+	/// inputs that are compiled concurrently on several threads, but the Yul strings and interned
+	/// names of all inputs are then kept until the process ends.
 	static void testCompiler(
 		solidity::StringMap& _input,
 		bool _optimize,
 		unsigned _rand,
 		bool _forceSMT,
-		bool _compileViaYul
+		bool _compileViaYul,
+		bool _persistent = false
 	);
 	/// Adds the experimental SMTChecker pragma to each source file in the
 	/// source map.
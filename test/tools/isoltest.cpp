@@ -18,18 +18,25 @@
 
 #include <libsolutil/CommonIO.h>
 #include <libsolutil/AnsiColorized.h>
+#include <libsolutil/JSON.h>
+#include <libsolutil/ThreadPool.h>
 
 #include <memory>
 #include <test/Common.h>
 #include <test/tools/IsolTestOptions.h>
 #include <test/InteractiveTests.h>
 #include <test/EVMHost.h>
+#include <test/libsolidity/util/GasProfile.h>
+#include <test/libsolidity/util/GasReport.h>
 
 #include <boost/algorithm/string/replace.hpp>
 #include <boost/filesystem.hpp>
 
+#include <condition_variable>
 #include <cstdlib>
 #include <iostream>
+#include <mutex>
+#include <optional>
 #include <queue>
 #include <regex>
 #include <utility>
@@ -96,13 +103,15 @@ public:
 		TestCreator _testCaseCreator,
 		TestOptions const& _options,
 		fs::path _path,
-		string _name
+		string _name,
+		ostream& _output
 	):
 		m_testCaseCreator(_testCaseCreator),
 		m_options(_options),
 		m_filter(TestFilter{_options.testFilter}),
 		m_path(std::move(_path)),
-		m_name(std::move(_name))
+		m_name(std::move(_name)),
+		m_output(_output)
 	{}
 
 	enum class Result
@@ -133,11 +142,22 @@ private:
 
 	Request handleResponse(bool _exception);
 
+	/// Runs the tests in @a _path on @a _options.jobs threads and prints their outputs in the
+	/// order in which the tests are found. Failing tests are not handled interactively.
+	static TestStats processPathConcurrently(
+		TestCreator _testCaseCreator,
+		TestOptions const& _options,
+		fs::path const& _basepath,
+		fs::path const& _path
+	);
+
 	TestCreator m_testCaseCreator;
 	TestOptions const& m_options;
 	TestFilter m_filter;
 	fs::path const m_path;
 	string const m_name;
+	/// Stream the results of the test are printed to, which is not the terminal if tests run concurrently.
+	ostream& m_output;
 
 	unique_ptr<TestCase> m_test;
 
@@ -156,7 +176,7 @@ TestTool::Result TestTool::process()
 	{
 		if (m_filter.matches(m_name))
 		{
-			(AnsiColorized(cout, formatted, {BOLD}) << m_name << ": ").flush();
+			(AnsiColorized(m_output, formatted, {BOLD}) << m_name << ": ").flush();
 
 			m_test = m_testCaseCreator(TestCase::Config{
 				m_path.string(),
@@ -168,21 +188,21 @@ TestTool::Result TestTool::process()
 				switch (TestCase::TestResult result = m_test->run(outputMessages, "  ", formatted))
 				{
 					case TestCase::TestResult::Success:
-						AnsiColorized(cout, formatted, {BOLD, GREEN}) << "OK" << endl;
+						AnsiColorized(m_output, formatted, {BOLD, GREEN}) << "OK" << endl;
 						return Result::Success;
 					default:
-						AnsiColorized(cout, formatted, {BOLD, RED}) << "FAIL" << endl;
+						AnsiColorized(m_output, formatted, {BOLD, RED}) << "FAIL" << endl;
 
-						AnsiColorized(cout, formatted, {BOLD, CYAN}) << "  Contract:" << endl;
-						m_test->printSource(cout, "    ", formatted);
-						m_test->printSettings(cout, "    ", formatted);
+						AnsiColorized(m_output, formatted, {BOLD, CYAN}) << "  Contract:" << endl;
+						m_test->printSource(m_output, "    ", formatted);
+						m_test->printSettings(m_output, "    ", formatted);
 
-						cout << endl << outputMessages.str() << endl;
+						m_output << endl << outputMessages.str() << endl;
 						return result == TestCase::TestResult::FatalError ? Result::Exception : Result::Failure;
 				}
 			else
 			{
-				AnsiColorized(cout, formatted, {BOLD, YELLOW}) << "NOT RUN" << endl;
+				AnsiColorized(m_output, formatted, {BOLD, YELLOW}) << "NOT RUN" << endl;
 				return Result::Skipped;
 			}
 		}
@@ -191,13 +211,13 @@ TestTool::Result TestTool::process()
 	}
 	catch (boost::exception const& _e)
 	{
-		AnsiColorized(cout, formatted, {BOLD, RED}) <<
+		AnsiColorized(m_output, formatted, {BOLD, RED}) <<
 			"Exception during test: " << boost::diagnostic_information(_e) << endl;
 		return Result::Exception;
 	}
 	catch (std::exception const& _e)
 	{
-		AnsiColorized(cout, formatted, {BOLD, RED}) <<
+		AnsiColorized(m_output, formatted, {BOLD, RED}) <<
 			"Exception during test" <<
 			(_e.what() ? ": " + string(_e.what()) : ".") <<
 			endl;
@@ -205,7 +225,7 @@ TestTool::Result TestTool::process()
 	}
 	catch (...)
 	{
-		AnsiColorized(cout, formatted, {BOLD, RED}) <<
+		AnsiColorized(m_output, formatted, {BOLD, RED}) <<
 			"Unknown exception during test." << endl;
 		return Result::Exception;
 	}
@@ -260,6 +280,9 @@ TestStats TestTool::processPath(
 	fs::path const& _path
 )
 {
+	if (_options.jobs != 1)
+		return processPathConcurrently(_testCaseCreator, _options, _basepath, _path);
+
 	std::queue<fs::path> paths;
 	paths.push(_path);
 	int successCount = 0;
@@ -293,7 +316,8 @@ TestStats TestTool::processPath(
 				_testCaseCreator,
 				_options,
 				fullpath,
-				currentPath.generic_path().string()
+				currentPath.generic_path().string(),
+				cout
 			);
 			auto result = testTool.process();
 
@@ -333,6 +357,81 @@ TestStats TestTool::processPath(
 
 }
 
+TestStats TestTool::processPathConcurrently(
+	TestCreator _testCaseCreator,
+	TestOptions const& _options,
+	fs::path const& _basepath,
+	fs::path const& _path
+)
+{
+	// The tests are collected in the order the sequential run would process them in.
+	vector<fs::path> tests;
+	std::queue<fs::path> paths;
+	paths.push(_path);
+	while (!paths.empty())
+	{
+		fs::path currentPath = paths.front();
+		paths.pop();
+
+		fs::path fullpath = _basepath / currentPath;
+		if (fs::is_directory(fullpath))
+		{
+			for (auto const& entry: boost::iterator_range<fs::directory_iterator>(
+				fs::directory_iterator(fullpath),
+				fs::directory_iterator()
+			))
+				if (fs::is_directory(entry.path()) || TestCase::isTestFilename(entry.path().filename()))
+					paths.push(currentPath / entry.path().filename());
+		}
+		else
+			tests.push_back(currentPath);
+	}
+
+	// Every test creates its own compiler stack, with its own type provider, and EVM host, and
+	// the threads load their own instances of the VMs. The results are collected per test and printed as soon as those
+	// of all tests before are printed.
+	vector<Result> results(tests.size());
+	vector<ostringstream> outputs(tests.size());
+	vector<bool> finished(tests.size(), false);
+	mutex finishedMutex;
+	condition_variable testFinished;
+
+	ThreadPool threadPool(min(ThreadPool::effectiveThreads(_options.jobs), max<size_t>(tests.size(), 1)));
+	for (size_t i = 0; i < tests.size(); ++i)
+		threadPool.submit([&, i]() {
+			results[i] = TestTool(
+				_testCaseCreator,
+				_options,
+				_basepath / tests[i],
+				tests[i].generic_path().string(),
+				outputs[i]
+			).process();
+			lock_guard<mutex> lock(finishedMutex);
+			finished[i] = true;
+			testFinished.notify_one();
+		});
+
+	TestStats stats;
+	for (size_t i = 0; i < tests.size(); ++i)
+	{
+		{
+			unique_lock<mutex> lock(finishedMutex);
+			testFinished.wait(lock, [&]() { return finished[i]; });
+		}
+		cout << outputs[i].str();
+		cout.flush();
+
+		++stats.testCount;
+		if (results[i] == Result::Success)
+			++stats.successCount;
+		else if (results[i] == Result::Skipped)
+			++stats.skippedCount;
+	}
+	threadPool.wait();
+
+	return stats;
+}
+
 namespace
 {
 
@@ -401,6 +500,67 @@ std::optional<TestStats> runTestSuite(
 
 }
 
+/// Writes the gas report and compares it against the baseline, as requested by the options.
+/// @returns false if the files cannot be read or written or if a value regressed.
+bool processGasReport(solidity::test::IsolTestOptions const& _options)
+{
+	using solidity::frontend::test::GasReport;
+
+	auto readReport = [](fs::path const& _path, Json::Value& _report) {
+		string errors;
+		if (!jsonParseStrict(readFileAsString(_path.string()), _report, &errors))
+		{
+			cerr << "Invalid gas report " << _path.string() << ": " << errors << endl;
+			return false;
+		}
+		return true;
+	};
+
+	if (!_options.gasReport.empty())
+	{
+		Json::Value previous = Json::objectValue;
+		if (fs::exists(_options.gasReport) && !readReport(_options.gasReport, previous))
+			return false;
+		ofstream file(_options.gasReport);
+		file << jsonPrettyPrint(GasReport::instance().toJson(previous)) << endl;
+		if (!file)
+		{
+			cerr << "Could not write " << _options.gasReport << endl;
+			return false;
+		}
+	}
+
+	if (_options.gasBaseline.empty())
+		return true;
+	Json::Value baseline;
+	if (!readReport(_options.gasBaseline, baseline))
+		return false;
+	bool regressed = false;
+	cout << endl << "Gas changes against " << _options.gasBaseline << ":" << endl;
+	for (auto const& change: GasReport::compare(baseline, GasReport::instance().toJson(), _options.gasThreshold))
+	{
+		AnsiColorized(cout, !_options.noColor, {change.regression ? RED : RESET}) << "  " << change.description << endl;
+		regressed = regressed || change.regression;
+	}
+	return !regressed;
+}
+
+/// Writes the gas profile if requested by the options.
+/// @returns false if the file cannot be written.
+bool writeGasProfile(solidity::test::IsolTestOptions const& _options)
+{
+	if (_options.gasProfile.empty())
+		return true;
+	ofstream file(_options.gasProfile);
+	solidity::frontend::test::GasProfile::instance().writeFolded(file, _options.gasProfileCounts);
+	if (!file)
+	{
+		cerr << "Could not write " << _options.gasProfile << endl;
+		return false;
+	}
+	return true;
+}
+
 int main(int argc, char const *argv[])
 {
 	setupTerminal();
@@ -439,6 +599,11 @@ int main(int argc, char const *argv[])
 	if (disableSemantics)
 		cout << endl << "--- SKIPPING ALL SEMANTICS TESTS ---" << endl << endl;
 
+	if (!options.gasReport.empty() || !options.gasBaseline.empty())
+		solidity::frontend::test::GasReport::instance().enable();
+	if (!options.gasProfile.empty())
+		solidity::frontend::test::GasProfile::instance().enable();
+
 	TestStats global_stats{0, 0};
 	cout << "Running tests..." << endl << endl;
 
@@ -480,5 +645,8 @@ int main(int argc, char const *argv[])
 	if (disableSemantics)
 		cout << "\nNOTE: Skipped semantics tests because no evmc vm could be found.\n" << endl;
 
-	return global_stats ? 0 : 1;
+	bool const gasReportProcessed = processGasReport(options);
+	bool const gasProfileWritten = writeGasProfile(options);
+
+	return global_stats && gasReportProcessed && gasProfileWritten ? 0 : 1;
 }
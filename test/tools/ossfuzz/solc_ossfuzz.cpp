@@ -48,7 +48,8 @@ extern "C" int LLVMFuzzerTestOneInput(uint8_t const* _data, size_t _size)
 				optimize,
 				/*_rand=*/static_cast<unsigned>(_size),
 				/*forceSMT=*/true,
-				compileViaYul
+				compileViaYul,
+				/*persistent=*/true
 			);
 		}
 		catch (runtime_error const&)
@@ -0,0 +1,152 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Fuzzer that looks for inputs on which the Yul optimiser is slow or scales superlinearly.
+ * Inputs that exceed one of the budgets abort the fuzzer, which saves them as regression inputs.
+ */
+
+#include <libyul/AssemblyStack.h>
+#include <libyul/AST.h>
+#include <libyul/optimiser/Metrics.h>
+#include <liblangutil/EVMVersion.h>
+#include <libsolutil/CompilationStatistics.h>
+
+#include <chrono>
+#include <iostream>
+#include <optional>
+
+using namespace solidity;
+using namespace solidity::util;
+using namespace solidity::yul;
+using namespace std;
+
+// Prototype as we can't use the FuzzerInterface.h header.
+extern "C" int LLVMFuzzerTestOneInput(uint8_t const* _data, size_t _size);
+
+namespace
+{
+
+/// Number of copies of the input the scaled input consists of.
+size_t constexpr scale = 4;
+/// Factor by which a step may take longer on the scaled input than on the input. Steps that
+/// are linear in the size of the code take about `scale` times longer and quadratic ones
+/// `scale * scale` times longer.
+size_t constexpr superlinearFactor = 10;
+/// Steps that take less time on the scaled input are not compared, as their times are
+/// dominated by noise.
+chrono::milliseconds constexpr minimumTime{20};
+/// Budget of a single step and of the whole optimiser on the input.
+chrono::milliseconds constexpr stepBudget{500};
+chrono::milliseconds constexpr optimiserBudget{2000};
+
+struct Measurement
+{
+	CompilationStatistics statistics;
+	chrono::nanoseconds time{0};
+	/// Size of the optimised code, which approximates the memory used by the optimiser.
+	size_t codeSize = 0;
+};
+
+/// Optimises @a _source and @returns the measurement, or nullopt if the source is invalid.
+optional<Measurement> optimise(string const& _source)
+{
+	AssemblyStack stack(
+		langutil::EVMVersion(),
+		AssemblyStack::Language::StrictAssembly,
+		solidity::frontend::OptimiserSettings::full()
+	);
+	if (!stack.parseAndAnalyze("source", _source))
+		return nullopt;
+
+	Measurement measurement;
+	{
+		CompilationStatistics::Scope scope(&measurement.statistics);
+		auto start = chrono::steady_clock::now();
+		stack.optimize();
+		measurement.time = chrono::steady_clock::now() - start;
+	}
+	measurement.codeSize = CodeSize::codeSizeIncludingFunctions(*stack.parserResult()->code);
+	return measurement;
+}
+
+string milliseconds(chrono::nanoseconds _time)
+{
+	return to_string(chrono::duration_cast<chrono::milliseconds>(_time).count()) + " ms";
+}
+
+[[noreturn]] void fail(string const& _message)
+{
+	cerr << _message << endl;
+	abort();
+}
+
+}
+
+extern "C" int LLVMFuzzerTestOneInput(uint8_t const* _data, size_t _size)
+{
+	if (_size > 600)
+		return 0;
+
+	YulStringRepository::reset();
+
+	string input(reinterpret_cast<char const*>(_data), _size);
+	optional<Measurement> measurement = optimise(input);
+	if (!measurement)
+		return 0;
+
+	if (measurement->time > optimiserBudget)
+		fail("The optimiser took " + milliseconds(measurement->time) + ".");
+	for (auto const& [step, statistics]: measurement->statistics.optimiserSteps())
+		if (statistics.time > stepBudget)
+			fail("Step " + step + " took " + milliseconds(statistics.time) + ".");
+
+	// Only code blocks can be repeated, the copies are put into sibling blocks, so that
+	// their names do not clash.
+	size_t start = input.find_first_not_of(" \t\r\n");
+	if (start == string::npos || input[start] != '{')
+		return 0;
+	string scaledInput = "{\n";
+	for (size_t i = 0; i < scale; ++i)
+		scaledInput += input + "\n";
+	scaledInput += "}\n";
+
+	YulStringRepository::reset();
+	optional<Measurement> scaledMeasurement = optimise(scaledInput);
+	if (!scaledMeasurement)
+		return 0;
+
+	for (auto const& [step, scaledStatistics]: scaledMeasurement->statistics.optimiserSteps())
+	{
+		if (scaledStatistics.time < minimumTime)
+			continue;
+		auto it = measurement->statistics.optimiserSteps().find(step);
+		chrono::nanoseconds time = it == measurement->statistics.optimiserSteps().end() ? chrono::nanoseconds{0} : it->second.time;
+		if (scaledStatistics.time > time * superlinearFactor)
+			fail(
+				"Step " + step + " took " + milliseconds(scaledStatistics.time) + " on " + to_string(scale) +
+				" copies of the input, but only " + milliseconds(time) + " on the input."
+			);
+	}
+	if (scaledMeasurement->codeSize > measurement->codeSize * superlinearFactor)
+		fail(
+			"The optimised code of " + to_string(scale) + " copies of the input has size " +
+			to_string(scaledMeasurement->codeSize) + ", but only " + to_string(measurement->codeSize) +
+			" for the input."
+		);
+	return 0;
+}
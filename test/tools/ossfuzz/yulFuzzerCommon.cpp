@@ -51,7 +51,7 @@ yulFuzzerUtil::TerminationReason yulFuzzerUtil::interpret(
 	TerminationReason reason = TerminationReason::None;
 	try
 	{
-		Interpreter::run(state, _dialect, *_ast);
+		LoweredInterpreter::run(state, _dialect, *_ast);
 	}
 	catch (StepLimitReached const&)
 	{
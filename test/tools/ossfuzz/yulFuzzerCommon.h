@@ -16,6 +16,7 @@
 */
 // SPDX-License-Identifier: GPL-3.0
 #include <test/tools/yulInterpreter/Interpreter.h>
+#include <test/tools/yulInterpreter/LoweredInterpreter.h>
 #include <libyul/backends/evm/EVMDialect.h>
 
 namespace solidity::yul::test::yul_fuzzer
@@ -0,0 +1,488 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Measures the performance of the compiler on a fixed corpus and prints the results as JSON.
+ */
+
+#include <libsolidity/interface/StandardCompiler.h>
+#include <libsolidity/interface/Version.h>
+
+#include <liblangutil/CharStream.h>
+#include <liblangutil/Scanner.h>
+
+#include <libsolutil/CommonIO.h>
+#include <libsolutil/CompilationStatistics.h>
+#include <libsolutil/JSON.h>
+
+#include <boost/algorithm/string/predicate.hpp>
+#include <boost/exception/diagnostic_information.hpp>
+#include <boost/filesystem.hpp>
+#include <boost/program_options.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <optional>
+#include <string>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::frontend;
+using namespace solidity::util;
+
+namespace po = boost::program_options;
+namespace fs = boost::filesystem;
+
+namespace
+{
+
+struct BenchmarkCase
+{
+	string name;
+	string language = "Solidity";
+	map<string, string> sources;
+	/// Directories missing imports are loaded from.
+	vector<fs::path> includePaths;
+};
+
+struct Configuration
+{
+	bool viaIR = false;
+	bool optimize = false;
+	/// Only tokenizes the sources instead of compiling them.
+	bool scanOnly = false;
+	/// Compiles the sources twice in a fresh process and reports how much slower the first
+	/// compilation is, i.e. the time spent on building tables and caches on first use.
+	bool startup = false;
+};
+
+/// @returns the test directory: the value of ETH_TEST_PATH or the first directory called
+/// "test" containing "compilationTests" in the current directory or up to three levels up.
+fs::path defaultTestPath()
+{
+	if (char const* path = getenv("ETH_TEST_PATH"))
+		return path;
+	fs::path directory = fs::current_path();
+	for (size_t level = 0; level <= 3; ++level, directory /= "..")
+		if (fs::is_directory(directory / "test" / "compilationTests"))
+			return directory / "test";
+	return {};
+}
+
+/// @returns all Solidity files below @a _directory, keyed by their path relative to it.
+/// Dependencies installed into "node_modules" are only loaded if they are imported.
+map<string, string> loadSolidityFiles(fs::path const& _directory)
+{
+	map<string, string> sources;
+	for (fs::recursive_directory_iterator it(_directory), end; it != end; ++it)
+	{
+		if (!fs::is_regular_file(it->path()) || it->path().extension() != ".sol")
+			continue;
+		fs::path const relativePath = fs::relative(it->path(), _directory);
+		if (none_of(relativePath.begin(), relativePath.end(), [](fs::path const& _component) {
+			return _component == "node_modules" || _component == ".git";
+		}))
+			sources[relativePath.generic_string()] = readFileAsString(it->path().string());
+	}
+	return sources;
+}
+
+BenchmarkCase deepInheritance(size_t _depth)
+{
+	string source = "pragma solidity >=0.0;\ncontract C0 { uint v0; function f0() public view returns (uint) { return v0; } }\n";
+	for (size_t i = 1; i < _depth; ++i)
+	{
+		string const n = to_string(i);
+		string const previous = to_string(i - 1);
+		source +=
+			"contract C" + n + " is C" + previous + " { uint v" + n + "; " +
+			"function f" + n + "() public view returns (uint) { return v" + n + " + f" + previous + "(); } }\n";
+	}
+	return {"synthetic/deepInheritance", "Solidity", {{"DeepInheritance.sol", source}}, {}};
+}
+
+BenchmarkCase manyFunctions(size_t _functions)
+{
+	string source = "pragma solidity >=0.0;\ncontract ManyFunctions {\n";
+	for (size_t i = 0; i < _functions; ++i)
+		source +=
+			"\tfunction f" + to_string(i) + "(uint a) public pure returns (uint) { return a * " +
+			to_string(i + 1) + " + " + to_string(i) + "; }\n";
+	source += "}\n";
+	return {"synthetic/manyFunctions", "Solidity", {{"ManyFunctions.sol", source}}, {}};
+}
+
+BenchmarkCase hugeYulObject(size_t _functions)
+{
+	string functions;
+	string calls;
+	for (size_t i = 0; i < _functions; ++i)
+	{
+		string const n = to_string(i);
+		functions += "\t\tfunction f_" + n + "(a) -> r { r := add(mul(a, " + n + "), sload(" + n + ")) }\n";
+		calls += "\t\tsstore(" + n + ", f_" + n + "(calldataload(" + to_string(i * 32) + ")))\n";
+	}
+	string source = "object \"Huge\" {\n\tcode {\n" + functions + calls + "\t}\n}\n";
+	return {"synthetic/hugeYulObject", "Yul", {{"Huge.yul", source}}, {}};
+}
+
+BenchmarkCase startup()
+{
+	string source =
+		"pragma solidity >=0.0;\n"
+		"contract Startup { function f(uint a) public pure returns (uint r) { assembly { r := add(a, 1) } } }\n";
+	return {"synthetic/startup", "Solidity", {{"Startup.sol", source}}, {}};
+}
+
+Json::Value standardJsonInput(BenchmarkCase const& _case, Configuration const& _configuration)
+{
+	Json::Value input;
+	input["language"] = _case.language;
+	for (auto const& [name, content]: _case.sources)
+		input["sources"][name]["content"] = content;
+	input["settings"]["optimizer"]["enabled"] = _configuration.optimize;
+	if (_configuration.viaIR)
+		input["settings"]["viaIR"] = true;
+	Json::Value& outputs = input["settings"]["outputSelection"]["*"]["*"];
+	outputs.append("evm.bytecode.object");
+	outputs.append("compilationStats");
+	return input;
+}
+
+/// Tokenizes all sources of the case and @returns the measurements of the run.
+Json::Value measureScanner(BenchmarkCase const& _case)
+{
+	auto const kind = _case.language == "Yul" ? langutil::ScannerKind::Yul : langutil::ScannerKind::Solidity;
+	size_t tokens = 0;
+
+	auto start = chrono::steady_clock::now();
+	for (auto const& [name, content]: _case.sources)
+	{
+		langutil::Scanner scanner(langutil::CharStream(content, name));
+		scanner.setScannerMode(kind);
+		for (; scanner.currentToken() != langutil::Token::EOS; scanner.next())
+			++tokens;
+	}
+	auto time = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start);
+
+	Json::Value result(Json::objectValue);
+	result["time"] = Json::UInt64(time.count());
+	result["peakMemory"] = Json::UInt64(CompilationStatistics::peakMemoryUsage());
+	result["tokens"] = Json::UInt64(tokens);
+	result["phases"] = Json::objectValue;
+	return result;
+}
+
+/// Compiles the case twice and @returns the measurements of both compilations.
+/// Has to run in a process that did not compile anything before.
+Json::Value measureStartup(BenchmarkCase const& _case, Configuration const& _configuration)
+{
+	Json::Value input = standardJsonInput(_case, _configuration);
+	auto timeCompilation = [&]() {
+		auto start = chrono::steady_clock::now();
+		StandardCompiler().compile(input);
+		return chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start).count();
+	};
+	auto const first = timeCompilation();
+	auto const second = timeCompilation();
+
+	Json::Value result(Json::objectValue);
+	result["time"] = Json::UInt64(first);
+	result["warmTime"] = Json::UInt64(second);
+	result["startupTime"] = Json::UInt64(first > second ? first - second : 0);
+	result["peakMemory"] = Json::UInt64(CompilationStatistics::peakMemoryUsage());
+	result["phases"] = Json::objectValue;
+	return result;
+}
+
+/// Compiles the case and @returns the measurements of the run.
+Json::Value measure(BenchmarkCase const& _case, Configuration const& _configuration)
+{
+	if (_configuration.scanOnly)
+		return measureScanner(_case);
+	if (_configuration.startup)
+		return measureStartup(_case, _configuration);
+
+	vector<fs::path> const includePaths = _case.includePaths;
+	ReadCallback::Callback readFile = [includePaths](string const& _kind, string const& _path) {
+		if (_kind == ReadCallback::kindString(ReadCallback::Kind::ReadFile))
+			for (fs::path const& directory: includePaths)
+				if (fs::is_regular_file(directory / _path))
+					return ReadCallback::Result{true, readFileAsString((directory / _path).string())};
+		return ReadCallback::Result{false, "File not found: " + _path};
+	};
+	Json::Value input = standardJsonInput(_case, _configuration);
+
+	auto start = chrono::steady_clock::now();
+	Json::Value output = StandardCompiler(readFile).compile(input);
+	auto time = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start);
+
+	Json::Value result(Json::objectValue);
+	result["time"] = Json::UInt64(time.count());
+	result["peakMemory"] = Json::UInt64(CompilationStatistics::peakMemoryUsage());
+	result["phases"] = output.isMember("compilationStats") ?
+		output["compilationStats"]["phases"] :
+		Json::Value(Json::objectValue);
+	uint64_t bytecodeSize = 0;
+	for (auto const& sourceName: output["contracts"].getMemberNames())
+		for (auto const& contractName: output["contracts"][sourceName].getMemberNames())
+			bytecodeSize += output["contracts"][sourceName][contractName]["evm"]["bytecode"]["object"].asString().size() / 2;
+	result["bytecodeSize"] = Json::UInt64(bytecodeSize);
+	for (Json::Value const& error: output["errors"])
+		if (error["severity"] == "error")
+		{
+			result["error"] = error["formattedMessage"].isString() ? error["formattedMessage"] : error["message"];
+			break;
+		}
+	return result;
+}
+
+/// Runs @a _run in a child process where possible, so that the peak memory usage
+/// of every run is measured separately.
+Json::Value isolated(function<Json::Value()> const& _run)
+{
+#if defined(__unix__) || defined(__APPLE__)
+	int fds[2];
+	if (pipe(fds) == 0)
+	{
+		pid_t pid = fork();
+		if (pid == 0)
+		{
+			close(fds[0]);
+			Json::Value result;
+			try
+			{
+				result = _run();
+			}
+			catch (...)
+			{
+				result["error"] = "Exception: " + boost::current_exception_diagnostic_information();
+			}
+			string const output = jsonCompactPrint(result);
+			for (size_t written = 0; written < output.size();)
+			{
+				ssize_t count = write(fds[1], output.data() + written, output.size() - written);
+				if (count <= 0)
+					_exit(1);
+				written += static_cast<size_t>(count);
+			}
+			_exit(0);
+		}
+		close(fds[1]);
+		string output;
+		if (pid > 0)
+		{
+			char buffer[4096];
+			for (ssize_t count; (count = read(fds[0], buffer, sizeof(buffer))) > 0;)
+				output.append(buffer, static_cast<size_t>(count));
+			waitpid(pid, nullptr, 0);
+		}
+		close(fds[0]);
+		Json::Value result;
+		if (pid > 0 && jsonParseStrict(output, result))
+			return result;
+		if (pid > 0)
+		{
+			result["error"] = "Benchmark process failed.";
+			return result;
+		}
+	}
+#endif
+	return _run();
+}
+
+}
+
+int main(int argc, char** argv)
+{
+	po::options_description options(
+		R"(solc-bench, the compiler benchmark.
+Usage: solc-bench [Options]
+Compiles the contracts in test/compilationTests, the given projects and some synthetic
+stress tests with the legacy and the IR pipeline, with and without optimizer, and prints
+the time, throughput and peak memory usage of each compilation as JSON. The time it takes
+to only tokenize the sources is reported as the "scanner" pipeline. The "startup" pipelines
+report how much slower the first compilation of a process is than the second one.
+
+Allowed options)",
+		po::options_description::m_default_line_length,
+		po::options_description::m_default_line_length - 23);
+	fs::path testPath;
+	vector<string> projects;
+	vector<string> filters;
+	size_t runs = 1;
+	string outputFile;
+	options.add_options()
+		("help", "Show this help screen.")
+		("testpath", po::value<fs::path>(&testPath)->default_value(defaultTestPath()), "Path to the test directory.")
+		(
+			"project",
+			po::value<vector<string>>(&projects)->composing(),
+			"Directory of a project to compile as a whole, e.g. a checkout of one of the external tests, "
+			"optionally preceded by the name of the project and \"=\". "
+			"Imports are also looked up in its \"node_modules\" directory. Can be given multiple times."
+		)
+		("filter", po::value<vector<string>>(&filters)->composing(), "Only run cases whose name contains the given text.")
+		("runs", po::value<size_t>(&runs)->default_value(1), "Number of runs per case and configuration. The fastest run is reported.")
+		("output", po::value<string>(&outputFile), "Write the results to the given file instead of stdout.");
+
+	po::variables_map arguments;
+	try
+	{
+		po::store(po::parse_command_line(argc, argv, options), arguments);
+		po::notify(arguments);
+	}
+	catch (po::error const& _exception)
+	{
+		cerr << _exception.what() << endl;
+		return 1;
+	}
+
+	if (arguments.count("help"))
+	{
+		cout << options;
+		return 0;
+	}
+	if (runs == 0)
+	{
+		cerr << "The number of runs must be positive." << endl;
+		return 1;
+	}
+
+	vector<BenchmarkCase> cases;
+	try
+	{
+		fs::path const compilationTests = testPath / "compilationTests";
+		if (testPath.empty() || !fs::is_directory(compilationTests))
+		{
+			cerr << "Test directory not found. Use --testpath or set ETH_TEST_PATH." << endl;
+			return 1;
+		}
+		vector<fs::path> directories;
+		for (fs::directory_entry const& entry: fs::directory_iterator(compilationTests))
+			if (fs::is_directory(entry.path()))
+				directories.push_back(entry.path());
+		sort(directories.begin(), directories.end());
+		for (fs::path const& directory: directories)
+			cases.push_back({"compilationTests/" + directory.filename().string(), "Solidity", loadSolidityFiles(directory), {}});
+
+		for (string const& project: projects)
+		{
+			size_t const separator = project.find('=');
+			fs::path const directory = fs::canonical(separator == string::npos ? project : project.substr(separator + 1));
+			string const name = separator == string::npos ? directory.filename().string() : project.substr(0, separator);
+			cases.push_back({"project/" + name, "Solidity", loadSolidityFiles(directory), {directory, directory / "node_modules"}});
+		}
+	}
+	catch (fs::filesystem_error const& _exception)
+	{
+		cerr << _exception.what() << endl;
+		return 1;
+	}
+	cases.push_back(deepInheritance(64));
+	cases.push_back(manyFunctions(1000));
+	cases.push_back(hugeYulObject(2000));
+	cases.push_back(startup());
+
+	if (!filters.empty())
+		cases.erase(remove_if(cases.begin(), cases.end(), [&](BenchmarkCase const& _case) {
+			return none_of(filters.begin(), filters.end(), [&](string const& _filter) {
+				return boost::algorithm::contains(_case.name, _filter);
+			});
+		}), cases.end());
+
+	bool failed = false;
+	Json::Value report(Json::objectValue);
+	report["version"] = VersionString;
+	report["results"] = Json::arrayValue;
+	for (BenchmarkCase const& benchmarkCase: cases)
+	{
+		size_t sourceBytes = 0;
+		for (auto const& source: benchmarkCase.sources)
+			sourceBytes += source.second.size();
+
+		// Yul is not compiled via the IR pipeline of Solidity, so only the optimizer is varied.
+		vector<Configuration> configurations{{false, false, true}, {false, false}, {false, true}};
+		if (benchmarkCase.name == "synthetic/startup")
+			configurations = {{false, true, false, true}, {true, true, false, true}};
+		else if (benchmarkCase.language == "Solidity")
+		{
+			configurations.push_back({true, false});
+			configurations.push_back({true, true});
+		}
+
+		for (Configuration const& configuration: configurations)
+		{
+			string const pipeline =
+				configuration.scanOnly ? "scanner" :
+				configuration.startup ? (configuration.viaIR ? "startup-via-ir" : "startup") :
+				benchmarkCase.language == "Yul" ? "yul" :
+				configuration.viaIR ? "via-ir" :
+				"legacy";
+			cerr << benchmarkCase.name << " (" << pipeline << (configuration.optimize ? ", optimized" : "") << ")" << endl;
+
+			optional<Json::Value> fastest;
+			for (size_t run = 0; run < runs; ++run)
+			{
+				Json::Value measurement = isolated([&]() { return measure(benchmarkCase, configuration); });
+				if (!fastest || (!measurement.isMember("error") && measurement["time"].asUInt64() < (*fastest)["time"].asUInt64()))
+					fastest = move(measurement);
+				if (fastest->isMember("error"))
+					break;
+			}
+
+			Json::Value result = move(*fastest);
+			result["case"] = benchmarkCase.name;
+			result["pipeline"] = pipeline;
+			result["optimize"] = configuration.optimize;
+			result["sourceBytes"] = Json::UInt64(sourceBytes);
+			uint64_t const time = result["time"].asUInt64();
+			result["bytesPerSecond"] = time > 0 ? Json::UInt64(sourceBytes * 1000000 / time) : Json::UInt64(0);
+			if (result.isMember("error"))
+			{
+				cerr << result["error"].asString() << endl;
+				failed = true;
+			}
+			report["results"].append(move(result));
+		}
+	}
+
+	if (outputFile.empty())
+		cout << jsonPrettyPrint(report) << endl;
+	else
+	{
+		ofstream output(outputFile);
+		output << jsonPrettyPrint(report) << endl;
+		if (!output)
+		{
+			cerr << "Could not write " << outputFile << endl;
+			return 1;
+		}
+	}
+	return failed ? 1 : 0;
+}
@@ -0,0 +1,190 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Replays the calls of semantic tests in a gas profiler and writes the gas used by each call
+ * stack of functions and source lines in the input format of flamegraph.pl.
+ */
+
+#include <test/Common.h>
+#include <test/EVMHost.h>
+#include <test/libsolidity/SemanticTest.h>
+#include <test/libsolidity/util/GasProfile.h>
+
+#include <boost/exception/diagnostic_information.hpp>
+#include <boost/filesystem.hpp>
+#include <boost/program_options.hpp>
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::frontend::test;
+
+namespace po = boost::program_options;
+namespace fs = boost::filesystem;
+
+namespace
+{
+
+auto const description = R"(sol-gas-profile, gas profiler of semantic tests.
+Usage: sol-gas-profile [Options] --test <file or directory>...
+Runs the calls of the given semantic tests instruction by instruction and writes the gas
+used by each call stack in the input format of flamegraph.pl, e.g.
+
+    sol-gas-profile --optimize -t abiEncoderV2 | flamegraph.pl > profile.svg
+
+Frames are the test, the contract, the Solidity or, via IR, Yul functions and the source
+lines, which are lines of the optimized IR when compiling via IR.
+
+Allowed options)";
+
+struct GasProfileOptions: solidity::test::CommonOptions
+{
+	bool showHelp = false;
+	/// Semantic test files or directories, relative to the directory of the semantic tests
+	/// unless they exist relative to the working directory.
+	vector<string> tests;
+	string output;
+	bool counts = false;
+
+	GasProfileOptions(): CommonOptions(description)
+	{
+		options.add_options()
+			("test,t", po::value<vector<string>>(&tests)->multitoken(), "Semantic test files or directories to profile.")
+			("output,o", po::value<string>(&output), "File to write the profile to instead of standard output.")
+			("counts", po::bool_switch(&counts), "Count the executed instructions instead of gas.")
+			("help", po::bool_switch(&showHelp), "Show this help screen.");
+	}
+
+	bool parse(int _argc, char const* const* _argv) override
+	{
+		bool const result = CommonOptions::parse(_argc, _argv);
+		if (showHelp || !result || tests.empty())
+		{
+			cout << options << endl;
+			return false;
+		}
+		return result;
+	}
+};
+
+/// @returns the semantic test files at @a _path.
+vector<fs::path> testFiles(fs::path const& _path)
+{
+	if (!fs::is_directory(_path))
+		return {_path};
+	vector<fs::path> files;
+	for (fs::recursive_directory_iterator it(_path), end; it != end; ++it)
+		if (fs::is_regular_file(it->path()) && TestCase::isTestFilename(it->path().filename()))
+			files.push_back(it->path());
+	sort(files.begin(), files.end());
+	return files;
+}
+
+/// Runs the semantic test in @a _file, which records its profile.
+/// @returns false if the test failed.
+bool profile(fs::path const& _file, GasProfileOptions const& _options)
+{
+	try
+	{
+		SemanticTest test(_file.string(), _options.evmVersion(), _options.vmPaths, _options.enforceViaYul);
+		if (!test.shouldRun())
+			return true;
+		ostringstream output;
+		if (test.run(output) == TestCase::TestResult::Success)
+			return true;
+		cerr << _file.string() << " failed:" << endl << output.str() << endl;
+	}
+	catch (...)
+	{
+		cerr << _file.string() << " failed: " << boost::current_exception_diagnostic_information() << endl;
+	}
+	return false;
+}
+
+}
+
+int main(int argc, char const* argv[])
+{
+	{
+		auto options = make_unique<GasProfileOptions>();
+		try
+		{
+			if (!options->parse(argc, argv))
+				return 1;
+			options->validate();
+		}
+		catch (std::exception const& _exception)
+		{
+			cerr << _exception.what() << endl;
+			return 1;
+		}
+		solidity::test::CommonOptions::setSingleton(move(options));
+	}
+	auto const& options = dynamic_cast<GasProfileOptions const&>(solidity::test::CommonOptions::get());
+
+	try
+	{
+		if (!solidity::test::EVMHost::checkVmPaths(options.vmPaths))
+		{
+			cerr << "No EVM found. Please provide the path of evmone using --vm <path>." << endl;
+			return 1;
+		}
+	}
+	catch (std::runtime_error const& _exception)
+	{
+		cerr << "Error: " << _exception.what() << endl;
+		return 1;
+	}
+
+	GasProfile::instance().enable();
+	bool success = true;
+	for (string const& test: options.tests)
+	{
+		fs::path path = test;
+		if (!fs::exists(path))
+			path = options.testPath / "libsolidity" / "semanticTests" / test;
+		if (!fs::exists(path))
+		{
+			cerr << "Test not found: " << test << endl;
+			return 1;
+		}
+		for (fs::path const& file: testFiles(path))
+			success = profile(file, options) && success;
+	}
+
+	if (options.output.empty())
+		GasProfile::instance().writeFolded(cout, options.counts);
+	else
+	{
+		ofstream file(options.output);
+		GasProfile::instance().writeFolded(file, options.counts);
+		if (!file)
+		{
+			cerr << "Could not write " << options.output << endl;
+			return 1;
+		}
+	}
+	return success ? 0 : 1;
+}
@@ -45,12 +45,15 @@ namespace
 /// @a _target at offset @a _targetOffset. Behaves as if @a _source would
 /// continue with an infinite sequence of zero bytes beyond its end.
 void copyZeroExtended(
-	map<u256, uint8_t>& _target, bytes const& _source,
+	InterpreterMemory& _target, bytes const& _source,
 	size_t _targetOffset, size_t _sourceOffset, size_t _size
 )
 {
+	bytes data(_size, 0);
 	for (size_t i = 0; i < _size; ++i)
-		_target[_targetOffset + i] = _sourceOffset + i < _source.size() ? _source[_sourceOffset + i] : 0;
+		if (_sourceOffset + i < _source.size())
+			data[i] = _source[_sourceOffset + i];
+	_target.write(_targetOffset, data.data(), data.size());
 }
 
 /// Count leading zeros for uint64. Following WebAssembly rules, it returns 64 for @a _v being zero.
@@ -523,66 +526,76 @@ bytes EwasmBuiltinInterpreter::readMemory(uint64_t _offset, uint64_t _size)
 {
 	yulAssert(_size <= 0xffff, "Too large read.");
 	bytes data(size_t(_size), uint8_t(0));
-	for (size_t i = 0; i < data.size(); ++i)
-		data[i] = m_state.memory[_offset + i];
+	m_state.memory.read(_offset, data.data(), data.size());
 	return data;
 }
 
 uint64_t EwasmBuiltinInterpreter::readMemoryWord(uint64_t _offset)
 {
+	uint8_t data[8];
+	m_state.memory.read(_offset, data, sizeof(data));
 	uint64_t r = 0;
 	for (size_t i = 0; i < 8; i++)
-		r |= uint64_t(m_state.memory[_offset + i]) << (i * 8);
+		r |= uint64_t(data[i]) << (i * 8);
 	return r;
 }
 
 uint32_t EwasmBuiltinInterpreter::readMemoryHalfWord(uint64_t _offset)
 {
+	uint8_t data[4];
+	m_state.memory.read(_offset, data, sizeof(data));
 	uint32_t r = 0;
 	for (size_t i = 0; i < 4; i++)
-		r |= uint32_t(m_state.memory[_offset + i]) << (i * 8);
+		r |= uint32_t(data[i]) << (i * 8);
 	return r;
 }
 
 void EwasmBuiltinInterpreter::writeMemory(uint64_t _offset, bytes const& _value)
 {
-	for (size_t i = 0; i < _value.size(); i++)
-		m_state.memory[_offset + i] = _value[i];
+	m_state.memory.write(_offset, _value.data(), _value.size());
 }
 
 void EwasmBuiltinInterpreter::writeMemoryWord(uint64_t _offset, uint64_t _value)
 {
+	uint8_t data[8];
 	for (size_t i = 0; i < 8; i++)
-		m_state.memory[_offset + i] = uint8_t((_value >> (i * 8)) & 0xff);
+		data[i] = uint8_t((_value >> (i * 8)) & 0xff);
+	m_state.memory.write(_offset, data, sizeof(data));
 }
 
 void EwasmBuiltinInterpreter::writeMemoryHalfWord(uint64_t _offset, uint32_t _value)
 {
+	uint8_t data[4];
 	for (size_t i = 0; i < 4; i++)
-		m_state.memory[_offset + i] = uint8_t((_value >> (i * 8)) & 0xff);
+		data[i] = uint8_t((_value >> (i * 8)) & 0xff);
+	m_state.memory.write(_offset, data, sizeof(data));
 }
 
 void EwasmBuiltinInterpreter::writeMemoryByte(uint64_t _offset, uint8_t _value)
 {
-	m_state.memory[_offset] = _value;
+	m_state.memory.store(_offset, _value);
 }
 
 void EwasmBuiltinInterpreter::writeU256(uint64_t _offset, u256 _value, size_t _croppedTo)
 {
 	accessMemory(_offset, _croppedTo);
+	bytes data(_croppedTo, 0);
 	for (size_t i = 0; i < _croppedTo; i++)
 	{
-		m_state.memory[_offset + i] = uint8_t(_value & 0xff);
+		data[i] = uint8_t(_value & 0xff);
 		_value >>= 8;
 	}
+	m_state.memory.write(_offset, data.data(), data.size());
 }
 
 u256 EwasmBuiltinInterpreter::readU256(uint64_t _offset, size_t _croppedTo)
 {
 	accessMemory(_offset, _croppedTo);
+	bytes data(_croppedTo, 0);
+	m_state.memory.read(_offset, data.data(), data.size());
 	u256 value{0};
 	for (size_t i = 0; i < _croppedTo; i++)
-		value = (value << 8) | m_state.memory[_offset + _croppedTo - 1 - i];
+		value = (value << 8) | data[_croppedTo - 1 - i];
 
 	return value;
 }
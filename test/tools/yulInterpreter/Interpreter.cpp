@@ -34,6 +34,7 @@
 
 #include <libsolutil/FixedHash.h>
 
+#include <boost/functional/hash.hpp>
 #include <boost/range/adaptor/reversed.hpp>
 #include <boost/algorithm/cxx11/all_of.hpp>
 
@@ -47,20 +48,72 @@ using namespace solidity::yul::test;
 
 using solidity::util::h256;
 
+uint8_t InterpreterMemory::load(u256 const& _offset) const
+{
+	auto page = m_pages.find(_offset & ~u256(pageSize - 1));
+	if (page == m_pages.end())
+		return 0;
+	return page->second[static_cast<size_t>(_offset & (pageSize - 1))];
+}
+
+void InterpreterMemory::store(u256 const& _offset, uint8_t _value)
+{
+	m_pages[_offset & ~u256(pageSize - 1)][static_cast<size_t>(_offset & (pageSize - 1))] = _value;
+}
+
+void InterpreterMemory::read(u256 const& _offset, uint8_t* _target, size_t _size) const
+{
+	u256 offset = _offset;
+	while (_size > 0)
+	{
+		size_t const offsetInPage = static_cast<size_t>(offset & (pageSize - 1));
+		size_t const chunkSize = min(_size, pageSize - offsetInPage);
+		auto page = m_pages.find(offset - offsetInPage);
+		if (page == m_pages.end())
+			fill_n(_target, chunkSize, uint8_t(0));
+		else
+			copy_n(page->second.data() + offsetInPage, chunkSize, _target);
+		_target += chunkSize;
+		_size -= chunkSize;
+		offset += chunkSize;
+	}
+}
+
+void InterpreterMemory::write(u256 const& _offset, uint8_t const* _source, size_t _size)
+{
+	u256 offset = _offset;
+	while (_size > 0)
+	{
+		size_t const offsetInPage = static_cast<size_t>(offset & (pageSize - 1));
+		size_t const chunkSize = min(_size, pageSize - offsetInPage);
+		copy_n(_source, chunkSize, m_pages[offset - offsetInPage].data() + offsetInPage);
+		_source += chunkSize;
+		_size -= chunkSize;
+		offset += chunkSize;
+	}
+}
+
+size_t H256Hash::operator()(h256 const& _value) const
+{
+	return boost::hash_range(_value.data(), _value.data() + h256::size);
+}
+
 void InterpreterState::dumpTraceAndState(ostream& _out) const
 {
 	_out << "Trace:" << endl;
 	for (auto const& line: trace)
 		_out << "  " << line << endl;
 	_out << "Memory dump:\n";
-	map<u256, u256> words;
-	for (auto const& [offset, value]: memory)
-		words[(offset / 0x20) * 0x20] |= u256(uint32_t(value)) << (256 - 8 - 8 * static_cast<size_t>(offset % 0x20));
-	for (auto const& [offset, value]: words)
-		if (value != 0)
-			_out << "  " << std::uppercase << std::hex << std::setw(4) << offset << ": " << h256(value).hex() << endl;
+	for (auto const& [pageOffset, page]: memory.pages())
+		for (size_t wordOffset = 0; wordOffset < InterpreterMemory::pageSize; wordOffset += 0x20)
+		{
+			h256 word;
+			copy_n(page.data() + wordOffset, 0x20, word.data());
+			if (word != h256{})
+				_out << "  " << std::uppercase << std::hex << std::setw(4) << u256(pageOffset + wordOffset) << ": " << word.hex() << endl;
+		}
 	_out << "Storage dump:" << endl;
-	for (auto const& slot: storage)
+	for (auto const& slot: map<h256, h256>(storage.begin(), storage.end()))
 		if (slot.second != h256{})
 			_out << "  " << slot.first.hex() << ": " << slot.second.hex() << endl;
 }
@@ -248,9 +301,6 @@ void Interpreter::incrementStep()
 void ExpressionEvaluator::operator()(Literal const& _literal)
 {
 	incrementStep();
-	static YulString const trueString("true");
-	static YulString const falseString("false");
-
 	setValue(valueOfLiteral(_literal));
 }
 
@@ -29,7 +29,9 @@
 
 #include <libsolutil/Exceptions.h>
 
+#include <array>
 #include <map>
+#include <unordered_map>
 
 namespace solidity::yul
 {
@@ -67,14 +69,45 @@ enum class ControlFlowState
 	Leave
 };
 
+/**
+ * Byte-addressed memory of the interpreter. The bytes are stored in pages that are allocated
+ * when they are first written to, so that accessing a word needs one lookup (two if it crosses
+ * a page boundary) instead of one per byte. Bytes that were never written are zero.
+ * Offsets wrap around at 2**256.
+ */
+class InterpreterMemory
+{
+public:
+	static constexpr size_t pageSize = 0x1000;
+	using Page = std::array<uint8_t, pageSize>;
+
+	uint8_t load(u256 const& _offset) const;
+	void store(u256 const& _offset, uint8_t _value);
+	/// Copies the @a _size bytes starting at @a _offset to @a _target.
+	void read(u256 const& _offset, uint8_t* _target, size_t _size) const;
+	/// Copies the @a _size bytes at @a _source to the memory starting at @a _offset.
+	void write(u256 const& _offset, uint8_t const* _source, size_t _size);
+
+	/// @returns the allocated pages by the offset of their first byte.
+	std::map<u256, Page> const& pages() const { return m_pages; }
+
+private:
+	std::map<u256, Page> m_pages;
+};
+
+struct H256Hash
+{
+	size_t operator()(util::h256 const& _value) const;
+};
+
 struct InterpreterState
 {
 	bytes calldata;
 	bytes returndata;
-	std::map<u256, uint8_t> memory;
-	/// This is different than memory.size() because we ignore gas.
+	InterpreterMemory memory;
+	/// This is different than the size of the allocated memory because we ignore gas.
 	u256 msize;
-	std::map<util::h256, util::h256> storage;
+	std::unordered_map<util::h256, util::h256, H256Hash> storage;
 	u160 address = 0x11111111;
 	u256 balance = 0x22222222;
 	u256 selfbalance = 0x22223333;
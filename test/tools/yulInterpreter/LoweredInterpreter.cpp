@@ -0,0 +1,405 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Yul interpreter that executes a lowered form of the AST.
+ */
+
+#include <test/tools/yulInterpreter/LoweredInterpreter.h>
+
+#include <test/tools/yulInterpreter/EVMInstructionInterpreter.h>
+#include <test/tools/yulInterpreter/EwasmBuiltinInterpreter.h>
+
+#include <libyul/Dialect.h>
+#include <libyul/Utilities.h>
+#include <libyul/backends/evm/EVMDialect.h>
+#include <libyul/backends/wasm/WasmDialect.h>
+
+#include <liblangutil/Exceptions.h>
+
+#include <algorithm>
+#include <variant>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::yul;
+using namespace solidity::yul::test;
+
+void LoweredInterpreter::run(InterpreterState& _state, Dialect const& _dialect, Block const& _ast)
+{
+	LoweredInterpreter interpreter(_state, _dialect);
+	interpreter.m_slots.emplace_back();
+	StatementCode code = interpreter.lower(_ast);
+	Frame frame(interpreter.m_slots.back().size());
+	code(frame);
+}
+
+LoweredInterpreter::StatementCode LoweredInterpreter::lower(Statement const& _statement)
+{
+	return std::visit([&](auto const& _concreteStatement) { return lower(_concreteStatement); }, _statement);
+}
+
+LoweredInterpreter::StatementCode LoweredInterpreter::lower(ExpressionStatement const& _statement)
+{
+	ValuesCode expression = lowerValues(_statement.expression);
+	return [expression = move(expression)](Frame& _frame) {
+		size_t nestingLevel = 0;
+		expression(_frame, nestingLevel);
+	};
+}
+
+LoweredInterpreter::StatementCode LoweredInterpreter::lower(Assignment const& _assignment)
+{
+	solAssert(_assignment.value, "");
+	vector<size_t> slots;
+	for (auto const& variable: _assignment.variableNames)
+		slots.push_back(m_slots.back().at(variable.name));
+
+	if (slots.size() == 1)
+		return [value = lowerValue(*_assignment.value), slot = slots.front()](Frame& _frame) {
+			size_t nestingLevel = 0;
+			_frame[slot] = value(_frame, nestingLevel);
+		};
+
+	return [values = lowerValues(*_assignment.value), slots = move(slots)](Frame& _frame) {
+		size_t nestingLevel = 0;
+		vector<u256> result = values(_frame, nestingLevel);
+		solAssert(result.size() == slots.size(), "");
+		for (size_t i = 0; i < result.size(); ++i)
+			_frame[slots[i]] = result[i];
+	};
+}
+
+LoweredInterpreter::StatementCode LoweredInterpreter::lower(VariableDeclaration const& _declaration)
+{
+	optional<ValuesCode> values;
+	if (_declaration.value)
+		values = lowerValues(*_declaration.value);
+	vector<size_t> slots;
+	for (auto const& variable: _declaration.variables)
+		slots.push_back(slot(variable.name));
+
+	if (!values)
+		return [slots = move(slots)](Frame& _frame) {
+			for (size_t slot: slots)
+				_frame[slot] = 0;
+		};
+
+	return [values = move(*values), slots = move(slots)](Frame& _frame) {
+		size_t nestingLevel = 0;
+		vector<u256> result = values(_frame, nestingLevel);
+		solAssert(result.size() == slots.size(), "");
+		for (size_t i = 0; i < result.size(); ++i)
+			_frame[slots[i]] = result[i];
+	};
+}
+
+LoweredInterpreter::StatementCode LoweredInterpreter::lower(If const& _if)
+{
+	solAssert(_if.condition, "");
+	return [condition = lowerValue(*_if.condition), body = lower(_if.body)](Frame& _frame) {
+		size_t nestingLevel = 0;
+		if (condition(_frame, nestingLevel) != 0)
+			body(_frame);
+	};
+}
+
+LoweredInterpreter::StatementCode LoweredInterpreter::lower(Switch const& _switch)
+{
+	solAssert(_switch.expression, "");
+	solAssert(!_switch.cases.empty(), "");
+	vector<pair<optional<u256>, StatementCode>> cases;
+	for (auto const& switchCase: _switch.cases)
+		cases.emplace_back(
+			switchCase.value ? optional<u256>(valueOfLiteral(*switchCase.value)) : nullopt,
+			lower(switchCase.body)
+		);
+
+	return [this, expression = lowerValue(*_switch.expression), cases = move(cases)](Frame& _frame) {
+		size_t nestingLevel = 0;
+		u256 value = expression(_frame, nestingLevel);
+		for (auto const& [caseValue, body]: cases)
+		{
+			// Every case value is evaluated as an expression of its own.
+			size_t caseNestingLevel = 0;
+			if (caseValue)
+				incrementNestingLevel(caseNestingLevel);
+			// Default case has to be last.
+			if (!caseValue || *caseValue == value)
+			{
+				body(_frame);
+				break;
+			}
+		}
+	};
+}
+
+LoweredInterpreter::StatementCode LoweredInterpreter::lower(FunctionDefinition const& _function)
+{
+	Function& function = *m_functionsByDefinition.at(&_function);
+	m_slots.emplace_back();
+	for (auto const& parameter: _function.parameters)
+		slot(parameter.name);
+	function.parameterCount = _function.parameters.size();
+	for (auto const& returnVariable: _function.returnVariables)
+		function.returnSlots.push_back(slot(returnVariable.name));
+	function.body = lower(_function.body);
+	function.slotCount = m_slots.back().size();
+	m_slots.pop_back();
+
+	return [](Frame&) {};
+}
+
+LoweredInterpreter::StatementCode LoweredInterpreter::lower(ForLoop const& _forLoop)
+{
+	solAssert(_forLoop.condition, "");
+
+	// Functions defined in the pre block are not visible, as in Interpreter.
+	m_functionScopes.emplace_back();
+	vector<StatementCode> pre;
+	for (auto const& statement: _forLoop.pre.statements)
+		pre.emplace_back(lower(statement));
+	ValueCode condition = lowerValue(*_forLoop.condition);
+	StatementCode body = lower(_forLoop.body);
+	StatementCode post = lower(_forLoop.post);
+	m_functionScopes.pop_back();
+
+	// Increment step for each loop iteration for loops with
+	// an empty body and post blocks to prevent a deadlock.
+	bool const countIterations = _forLoop.body.statements.empty() && _forLoop.post.statements.empty();
+
+	return [
+		this,
+		pre = move(pre),
+		condition = move(condition),
+		body = move(body),
+		post = move(post),
+		countIterations
+	](Frame& _frame) {
+		for (auto const& statement: pre)
+		{
+			statement(_frame);
+			if (m_state.controlFlowState == ControlFlowState::Leave)
+				return;
+		}
+		while (true)
+		{
+			size_t nestingLevel = 0;
+			if (condition(_frame, nestingLevel) == 0)
+				break;
+
+			if (countIterations)
+				incrementStep();
+
+			m_state.controlFlowState = ControlFlowState::Default;
+			body(_frame);
+			if (m_state.controlFlowState == ControlFlowState::Break || m_state.controlFlowState == ControlFlowState::Leave)
+				break;
+
+			m_state.controlFlowState = ControlFlowState::Default;
+			post(_frame);
+			if (m_state.controlFlowState == ControlFlowState::Leave)
+				break;
+		}
+		if (m_state.controlFlowState != ControlFlowState::Leave)
+			m_state.controlFlowState = ControlFlowState::Default;
+	};
+}
+
+LoweredInterpreter::StatementCode LoweredInterpreter::lower(Break const&)
+{
+	return [this](Frame&) { m_state.controlFlowState = ControlFlowState::Break; };
+}
+
+LoweredInterpreter::StatementCode LoweredInterpreter::lower(Continue const&)
+{
+	return [this](Frame&) { m_state.controlFlowState = ControlFlowState::Continue; };
+}
+
+LoweredInterpreter::StatementCode LoweredInterpreter::lower(Leave const&)
+{
+	return [this](Frame&) { m_state.controlFlowState = ControlFlowState::Leave; };
+}
+
+LoweredInterpreter::StatementCode LoweredInterpreter::lower(Block const& _block)
+{
+	// Functions are visible in the whole block, so they are registered before the statements
+	// are lowered and their bodies are lowered with their definitions.
+	m_functionScopes.emplace_back();
+	for (auto const& statement: _block.statements)
+		if (holds_alternative<FunctionDefinition>(statement))
+		{
+			FunctionDefinition const& definition = std::get<FunctionDefinition>(statement);
+			Function* function = m_functions.emplace_back(make_unique<Function>()).get();
+			m_functionsByDefinition[&definition] = function;
+			m_functionScopes.back().emplace(definition.name, function);
+		}
+
+	vector<StatementCode> statements;
+	for (auto const& statement: _block.statements)
+		statements.emplace_back(lower(statement));
+	m_functionScopes.pop_back();
+
+	return [this, statements = move(statements)](Frame& _frame) {
+		for (auto const& statement: statements)
+		{
+			incrementStep();
+			statement(_frame);
+			if (m_state.controlFlowState != ControlFlowState::Default)
+				break;
+		}
+	};
+}
+
+LoweredInterpreter::ValueCode LoweredInterpreter::lowerValue(Expression const& _expression)
+{
+	if (Literal const* literal = get_if<Literal>(&_expression))
+		return [this, value = valueOfLiteral(*literal)](Frame&, size_t& _nestingLevel) {
+			incrementNestingLevel(_nestingLevel);
+			return value;
+		};
+	else if (Identifier const* identifier = get_if<Identifier>(&_expression))
+		return [this, slot = m_slots.back().at(identifier->name)](Frame& _frame, size_t& _nestingLevel) {
+			incrementNestingLevel(_nestingLevel);
+			return _frame[slot];
+		};
+
+	FunctionCall const& functionCall = std::get<FunctionCall>(_expression);
+	BuiltinFunction const* builtin = m_dialect.builtin(functionCall.functionName.name);
+	if (!builtin)
+		return [values = lowerValues(_expression)](Frame& _frame, size_t& _nestingLevel) {
+			vector<u256> result = values(_frame, _nestingLevel);
+			solAssert(result.size() == 1, "");
+			return result.front();
+		};
+
+	ArgumentsCode arguments = lowerArguments(
+		functionCall.arguments,
+		builtin->literalArguments.empty() ? nullptr : &builtin->literalArguments
+	);
+	if (EVMDialect const* dialect = dynamic_cast<EVMDialect const*>(&m_dialect))
+		return [
+			this,
+			function = dialect->builtin(functionCall.functionName.name),
+			&functionCall,
+			arguments = move(arguments)
+		](Frame& _frame, size_t& _nestingLevel) {
+			vector<u256> values = evaluateArguments(arguments, _frame, _nestingLevel);
+			return EVMInstructionInterpreter(m_state).evalBuiltin(*function, functionCall.arguments, values);
+		};
+	else if (dynamic_cast<WasmDialect const*>(&m_dialect))
+		return [this, &functionCall, arguments = move(arguments)](Frame& _frame, size_t& _nestingLevel) {
+			vector<u256> values = evaluateArguments(arguments, _frame, _nestingLevel);
+			return EwasmBuiltinInterpreter(m_state).evalBuiltin(functionCall.functionName.name, functionCall.arguments, values);
+		};
+
+	yulAssert(false, "Builtins of this dialect cannot be interpreted.");
+	return {};
+}
+
+LoweredInterpreter::ValuesCode LoweredInterpreter::lowerValues(Expression const& _expression)
+{
+	if (FunctionCall const* functionCall = get_if<FunctionCall>(&_expression))
+		if (!m_dialect.builtin(functionCall->functionName.name))
+			return [
+				this,
+				&function = function(functionCall->functionName.name),
+				arguments = lowerArguments(functionCall->arguments, nullptr)
+			](Frame& _frame, size_t& _nestingLevel) {
+				return call(function, evaluateArguments(arguments, _frame, _nestingLevel));
+			};
+
+	return [value = lowerValue(_expression)](Frame& _frame, size_t& _nestingLevel) {
+		return vector<u256>{value(_frame, _nestingLevel)};
+	};
+}
+
+LoweredInterpreter::ArgumentsCode LoweredInterpreter::lowerArguments(
+	vector<Expression> const& _arguments,
+	vector<optional<LiteralKind>> const* _literalArguments
+)
+{
+	ArgumentsCode arguments;
+	for (size_t i = 0; i < _arguments.size(); ++i)
+		if (!_literalArguments || !_literalArguments->at(i))
+			arguments.emplace_back(lowerValue(_arguments[i]));
+		else
+			arguments.emplace_back(nullopt);
+	return arguments;
+}
+
+size_t LoweredInterpreter::slot(YulString _name)
+{
+	map<YulString, size_t>& slots = m_slots.back();
+	return slots.emplace(_name, slots.size()).first->second;
+}
+
+LoweredInterpreter::Function const& LoweredInterpreter::function(YulString _name) const
+{
+	for (auto scope = m_functionScopes.rbegin(); scope != m_functionScopes.rend(); ++scope)
+		if (auto function = scope->find(_name); function != scope->end())
+			return *function->second;
+	yulAssert(false, "Function not found.");
+	return *m_functions.front();
+}
+
+vector<u256> LoweredInterpreter::evaluateArguments(ArgumentsCode const& _arguments, Frame& _frame, size_t& _nestingLevel)
+{
+	incrementNestingLevel(_nestingLevel);
+	vector<u256> values(_arguments.size(), 0);
+	/// Function arguments are evaluated in reverse.
+	for (size_t i = _arguments.size(); i > 0; --i)
+		if (_arguments[i - 1])
+			values[i - 1] = (*_arguments[i - 1])(_frame, _nestingLevel);
+	return values;
+}
+
+vector<u256> LoweredInterpreter::call(Function const& _function, vector<u256> const& _arguments)
+{
+	yulAssert(_arguments.size() == _function.parameterCount, "");
+	Frame frame(_function.slotCount);
+	copy(_arguments.begin(), _arguments.end(), frame.begin());
+
+	m_state.controlFlowState = ControlFlowState::Default;
+	_function.body(frame);
+	m_state.controlFlowState = ControlFlowState::Default;
+
+	vector<u256> values;
+	for (size_t slot: _function.returnSlots)
+		values.emplace_back(frame[slot]);
+	return values;
+}
+
+void LoweredInterpreter::incrementStep()
+{
+	m_state.numSteps++;
+	if (m_state.maxSteps > 0 && m_state.numSteps >= m_state.maxSteps)
+	{
+		m_state.trace.emplace_back("Interpreter execution step limit reached.");
+		BOOST_THROW_EXCEPTION(StepLimitReached());
+	}
+}
+
+void LoweredInterpreter::incrementNestingLevel(size_t& _nestingLevel)
+{
+	_nestingLevel++;
+	if (m_state.maxExprNesting > 0 && _nestingLevel > m_state.maxExprNesting)
+	{
+		m_state.trace.emplace_back("Maximum expression nesting level reached.");
+		BOOST_THROW_EXCEPTION(ExpressionNestingLimitReached());
+	}
+}
@@ -0,0 +1,129 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Yul interpreter that executes a lowered form of the AST.
+ */
+
+#pragma once
+
+#include <test/tools/yulInterpreter/Interpreter.h>
+
+#include <libyul/AST.h>
+#include <libyul/YulString.h>
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <optional>
+#include <vector>
+
+namespace solidity::yul
+{
+struct Dialect;
+}
+
+namespace solidity::yul::test
+{
+
+/**
+ * Yul interpreter that lowers the AST into closures before executing it. The variables are
+ * resolved to slots in the frame of their function and the builtins and functions are
+ * resolved at the call sites, so that no names are looked up during the execution.
+ *
+ * Produces the same traces, states and step counts as Interpreter, which it is checked
+ * against by the Yul interpreter tests. The AST has to be analyzed.
+ */
+class LoweredInterpreter
+{
+public:
+	static void run(InterpreterState& _state, Dialect const& _dialect, Block const& _ast);
+
+private:
+	/// Values of the variables of a function call by their slots.
+	using Frame = std::vector<u256>;
+	using StatementCode = std::function<void(Frame&)>;
+	/// Evaluates an expression with a single value. The second argument is the nesting
+	/// level of the expression evaluated by the enclosing statement.
+	using ValueCode = std::function<u256(Frame&, size_t&)>;
+	/// Evaluates an expression with any number of values.
+	using ValuesCode = std::function<std::vector<u256>(Frame&, size_t&)>;
+	/// Code of the arguments of a call, empty for literal arguments, which are not evaluated.
+	using ArgumentsCode = std::vector<std::optional<ValueCode>>;
+
+	struct Function
+	{
+		/// The parameters occupy the first slots of the frame.
+		size_t parameterCount = 0;
+		std::vector<size_t> returnSlots;
+		size_t slotCount = 0;
+		StatementCode body;
+	};
+
+	LoweredInterpreter(InterpreterState& _state, Dialect const& _dialect):
+		m_state(_state),
+		m_dialect(_dialect)
+	{}
+
+	StatementCode lower(Statement const& _statement);
+	StatementCode lower(ExpressionStatement const& _statement);
+	StatementCode lower(Assignment const& _assignment);
+	StatementCode lower(VariableDeclaration const& _declaration);
+	StatementCode lower(If const& _if);
+	StatementCode lower(Switch const& _switch);
+	StatementCode lower(FunctionDefinition const& _function);
+	StatementCode lower(ForLoop const& _forLoop);
+	StatementCode lower(Break const&);
+	StatementCode lower(Continue const&);
+	StatementCode lower(Leave const&);
+	StatementCode lower(Block const& _block);
+
+	ValueCode lowerValue(Expression const& _expression);
+	ValuesCode lowerValues(Expression const& _expression);
+	ArgumentsCode lowerArguments(
+		std::vector<Expression> const& _arguments,
+		std::vector<std::optional<LiteralKind>> const* _literalArguments
+	);
+
+	/// @returns the slot of the variable @a _name in the function being lowered, which is
+	/// allocated if it does not have one. Variables of the same name in disjoint blocks share
+	/// a slot, as they are never alive at the same time.
+	size_t slot(YulString _name);
+	/// @returns the innermost function named @a _name that is visible in the block being lowered.
+	Function const& function(YulString _name) const;
+
+	/// Evaluates the arguments from right to left.
+	std::vector<u256> evaluateArguments(ArgumentsCode const& _arguments, Frame& _frame, size_t& _nestingLevel);
+	/// Executes @a _function and @returns the values of its return variables.
+	std::vector<u256> call(Function const& _function, std::vector<u256> const& _arguments);
+
+	/// Increments the interpreter step count, throwing if the step limit is reached.
+	void incrementStep();
+	/// Increments the nesting level, throwing if it is beyond the limit.
+	void incrementNestingLevel(size_t& _nestingLevel);
+
+	InterpreterState& m_state;
+	Dialect const& m_dialect;
+	/// Functions defined in the blocks that are lowered, innermost last.
+	std::vector<std::map<YulString, Function const*>> m_functionScopes;
+	/// Slots of the variables of the functions that are lowered, innermost last.
+	std::vector<std::map<YulString, size_t>> m_slots;
+	std::vector<std::unique_ptr<Function>> m_functions;
+	std::map<FunctionDefinition const*, Function*> m_functionsByDefinition;
+};
+
+}
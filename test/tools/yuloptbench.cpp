@@ -0,0 +1,480 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Measures the performance of the Yul parser and of the individual optimiser steps and prints
+ * the results as JSON.
+ */
+
+#include <libsolidity/interface/CompilerStack.h>
+#include <libsolidity/interface/OptimiserSettings.h>
+#include <libsolidity/interface/Version.h>
+
+#include <libyul/AsmAnalysisInfo.h>
+#include <libyul/AssemblyStack.h>
+#include <libyul/AST.h>
+#include <libyul/Object.h>
+#include <libyul/ObjectParser.h>
+#include <libyul/backends/evm/EVMDialect.h>
+#include <libyul/optimiser/Disambiguator.h>
+#include <libyul/optimiser/NameDispenser.h>
+#include <libyul/optimiser/OptimiserStep.h>
+#include <libyul/optimiser/Suite.h>
+
+#include <libevmasm/Assembly.h>
+
+#include <liblangutil/CharStream.h>
+#include <liblangutil/ErrorReporter.h>
+#include <liblangutil/EVMVersion.h>
+#include <liblangutil/Scanner.h>
+
+#include <libsolutil/CommonIO.h>
+#include <libsolutil/JSON.h>
+
+#include <boost/algorithm/string/predicate.hpp>
+#include <boost/exception/diagnostic_information.hpp>
+#include <boost/filesystem.hpp>
+#include <boost/program_options.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::frontend;
+using namespace solidity::util;
+
+namespace po = boost::program_options;
+namespace fs = boost::filesystem;
+
+namespace
+{
+
+struct YulCase
+{
+	string name;
+	string source;
+};
+
+struct SolidityCase
+{
+	string name;
+	map<string, string> sources;
+};
+
+/// Component of the libevmasm optimiser, enabled by setting one flag of the settings.
+struct EvmasmComponent
+{
+	string name;
+	bool evmasm::Assembly::OptimiserSettings::* flag;
+};
+
+vector<EvmasmComponent> const evmasmComponents{
+	{"Inliner", &evmasm::Assembly::OptimiserSettings::runInliner},
+	{"JumpdestRemover", &evmasm::Assembly::OptimiserSettings::runJumpdestRemover},
+	{"PeepholeOptimiser", &evmasm::Assembly::OptimiserSettings::runPeephole},
+	{"BlockDeduplicator", &evmasm::Assembly::OptimiserSettings::runDeduplicate},
+	{"CommonSubexpressionEliminator", &evmasm::Assembly::OptimiserSettings::runCSE},
+	{"ConstantOptimiser", &evmasm::Assembly::OptimiserSettings::runConstantOptimiser}
+};
+
+yul::Dialect const& dialect()
+{
+	return yul::EVMDialect::strictAssemblyForEVMObjects(langutil::EVMVersion{});
+}
+
+/// @returns the test directory: the value of ETH_TEST_PATH or the first directory called
+/// "test" containing "libyul" in the current directory or up to three levels up.
+fs::path defaultTestPath()
+{
+	if (char const* path = getenv("ETH_TEST_PATH"))
+		return path;
+	fs::path directory = fs::current_path();
+	for (size_t level = 0; level <= 3; ++level, directory /= "..")
+		if (fs::is_directory(directory / "test" / "libyul"))
+			return directory / "test";
+	return {};
+}
+
+/// @returns the paths of all files with the extension @a _extension below @a _directory, sorted.
+vector<fs::path> findFiles(fs::path const& _directory, string const& _extension)
+{
+	vector<fs::path> files;
+	for (fs::recursive_directory_iterator it(_directory), end; it != end; ++it)
+		if (fs::is_regular_file(it->path()) && it->path().extension() == _extension)
+			files.push_back(it->path());
+	sort(files.begin(), files.end());
+	return files;
+}
+
+/// @returns the inputs of the Yul optimiser tests, without their expectations.
+vector<YulCase> loadOptimiserTests(fs::path const& _directory)
+{
+	vector<YulCase> cases;
+	for (fs::path const& file: findFiles(_directory, ".yul"))
+	{
+		string source = readFileAsString(file.string());
+		source = source.substr(0, source.find("\n// ----"));
+		cases.push_back({"yulOptimizerTests/" + fs::relative(file, _directory).generic_string(), move(source)});
+	}
+	return cases;
+}
+
+/// @returns the projects in test/compilationTests.
+vector<SolidityCase> loadCompilationTests(fs::path const& _directory)
+{
+	vector<SolidityCase> cases;
+	vector<fs::path> directories;
+	for (fs::directory_entry const& entry: fs::directory_iterator(_directory))
+		if (fs::is_directory(entry.path()))
+			directories.push_back(entry.path());
+	sort(directories.begin(), directories.end());
+	for (fs::path const& directory: directories)
+	{
+		SolidityCase solidityCase{"compilationTests/" + directory.filename().string(), {}};
+		for (fs::path const& file: findFiles(directory, ".sol"))
+			solidityCase.sources[fs::relative(file, directory).generic_string()] = readFileAsString(file.string());
+		cases.push_back(move(solidityCase));
+	}
+	return cases;
+}
+
+/// @returns the compiler stack after compiling @a _case without optimiser or null if it failed.
+unique_ptr<CompilerStack> compile(SolidityCase const& _case, bool _generateIR)
+{
+	auto compiler = make_unique<CompilerStack>();
+	compiler->setSources(_case.sources);
+	compiler->setOptimiserSettings(OptimiserSettings::minimal());
+	compiler->enableIRGeneration(_generateIR);
+	try
+	{
+		if (compiler->compile())
+			return compiler;
+	}
+	catch (...)
+	{
+	}
+	return nullptr;
+}
+
+/// @returns the unoptimised IR of the contracts of @a _case.
+vector<YulCase> generateIR(SolidityCase const& _case)
+{
+	vector<YulCase> cases;
+	if (unique_ptr<CompilerStack> compiler = compile(_case, true))
+		for (string const& contract: compiler->contractNames())
+			if (!compiler->yulIR(contract).empty())
+				cases.push_back({"ir/" + _case.name + "/" + contract, compiler->yulIR(contract)});
+	return cases;
+}
+
+/// Parses and analyzes @a _source and @returns the object or null on errors.
+shared_ptr<yul::Object> parse(string const& _source)
+{
+	yul::AssemblyStack stack(
+		langutil::EVMVersion{},
+		yul::AssemblyStack::Language::StrictAssembly,
+		OptimiserSettings::none()
+	);
+	try
+	{
+		if (stack.parseAndAnalyze("", _source))
+			return stack.parserResult();
+	}
+	catch (...)
+	{
+	}
+	return nullptr;
+}
+
+/// @returns the time in microseconds it takes to scan and parse @a _source, without analysis.
+int64_t measureParse(string const& _source)
+{
+	langutil::ErrorList errors;
+	langutil::ErrorReporter errorReporter(errors);
+	auto scanner = make_shared<langutil::Scanner>(langutil::CharStream(_source, ""));
+	auto start = chrono::steady_clock::now();
+	shared_ptr<yul::Object> object = yul::ObjectParser(errorReporter, dialect()).parse(scanner, false);
+	auto time = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start);
+	if (!object || !errors.empty())
+		BOOST_THROW_EXCEPTION(runtime_error("Parsing failed."));
+	return time.count();
+}
+
+void collectObjects(yul::Object& _object, vector<yul::Object*>& _objects)
+{
+	_objects.push_back(&_object);
+	for (auto const& subNode: _object.subObjects)
+		if (auto subObject = dynamic_pointer_cast<yul::Object>(subNode))
+			collectObjects(*subObject, _objects);
+}
+
+/// @returns the time in microseconds it takes to run @a _step on the code of every object of
+/// @a _object, after the steps that the optimiser suite runs before any user-supplied sequence.
+int64_t measureStep(yul::Object& _object, yul::OptimiserStep const& _step)
+{
+	vector<yul::Object*> objects;
+	collectObjects(_object, objects);
+
+	chrono::microseconds time{0};
+	for (yul::Object* object: objects)
+	{
+		set<yul::YulString> reservedIdentifiers = dialect().fixedFunctionNames();
+		*object->code = get<yul::Block>(
+			yul::Disambiguator(dialect(), *object->analysisInfo, reservedIdentifiers)(*object->code)
+		);
+		yul::NameDispenser dispenser(dialect(), *object->code, reservedIdentifiers);
+		yul::OptimiserStepContext context{dialect(), dispenser, reservedIdentifiers, nullptr};
+		for (char abbreviation: string("hfgo"))
+			yul::OptimiserSuite::allSteps().at(
+				yul::OptimiserSuite::stepAbbreviationToNameMap().at(abbreviation)
+			)->run(context, *object->code);
+
+		auto start = chrono::steady_clock::now();
+		_step.run(context, *object->code);
+		time += chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start);
+	}
+	return time.count();
+}
+
+/// @returns the time in microseconds it takes to optimise @a _source with the default sequence,
+/// including the sub-objects and the steps run before and after the sequence.
+int64_t measureSequence(string const& _source)
+{
+	yul::AssemblyStack stack(
+		langutil::EVMVersion{},
+		yul::AssemblyStack::Language::StrictAssembly,
+		OptimiserSettings::full()
+	);
+	if (!stack.parseAndAnalyze("", _source))
+		BOOST_THROW_EXCEPTION(runtime_error("Parsing failed."));
+	auto start = chrono::steady_clock::now();
+	stack.optimize();
+	return chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start).count();
+}
+
+/// @returns the time in microseconds it takes to run @a _component on the assemblies of all
+/// contracts of @a _case, or nullopt if the case does not compile.
+optional<int64_t> measureEvmasmComponent(SolidityCase const& _case, EvmasmComponent const& _component)
+{
+	// The copies of the assemblies share their sub-assemblies with the compiler stack,
+	// so every measurement needs a fresh compilation.
+	unique_ptr<CompilerStack> compiler = compile(_case, false);
+	if (!compiler)
+		return nullopt;
+
+	chrono::microseconds time{0};
+	for (string const& contract: compiler->contractNames())
+		if (shared_ptr<evmasm::Assembly const> assembly = compiler->evmAssembly(contract))
+		{
+			evmasm::Assembly copy = *assembly;
+			evmasm::Assembly::OptimiserSettings settings;
+			settings.isCreation = true;
+			settings.*_component.flag = true;
+			auto start = chrono::steady_clock::now();
+			copy.optimise(settings);
+			time += chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start);
+		}
+	return time.count();
+}
+
+/// Runs @a _measure @a _runs times and @returns the result entry with the fastest time.
+Json::Value fastest(size_t _runs, string const& _case, string const& _pipeline, function<optional<int64_t>()> const& _measure)
+{
+	Json::Value result(Json::objectValue);
+	result["case"] = _case;
+	result["pipeline"] = _pipeline;
+	optional<int64_t> best;
+	try
+	{
+		for (size_t run = 0; run < _runs; ++run)
+		{
+			optional<int64_t> time = _measure();
+			if (!time)
+			{
+				result["error"] = "Compilation failed.";
+				return result;
+			}
+			if (!best || *time < *best)
+				best = time;
+		}
+		result["time"] = Json::Int64(*best);
+	}
+	catch (...)
+	{
+		result["error"] = "Exception: " + boost::current_exception_diagnostic_information();
+	}
+	return result;
+}
+
+}
+
+int main(int argc, char** argv)
+{
+	po::options_description options(
+		R"(yul-opt-bench, the optimiser benchmark.
+Usage: yul-opt-bench [Options]
+Runs the Yul parser, every Yul optimiser step and the default optimiser sequence on the inputs
+of the Yul optimiser tests and on the unoptimised IR of the contracts in test/compilationTests, and runs
+every component of the libevmasm optimiser on the unoptimised assemblies of these contracts.
+Prints the time of each run in microseconds as JSON in the format of solc-bench.
+
+Allowed options)",
+		po::options_description::m_default_line_length,
+		po::options_description::m_default_line_length - 23);
+	fs::path testPath;
+	vector<string> filters;
+	vector<string> steps;
+	size_t runs = 1;
+	string outputFile;
+	options.add_options()
+		("help", "Show this help screen.")
+		("testpath", po::value<fs::path>(&testPath)->default_value(defaultTestPath()), "Path to the test directory.")
+		("filter", po::value<vector<string>>(&filters)->composing(), "Only run cases whose name contains the given text.")
+		(
+			"step",
+			po::value<vector<string>>(&steps)->composing(),
+			"Only measure the Yul optimiser step or libevmasm component of the given name. "
+			"\"sequence\" selects the default sequence and \"parse\" the Yul parser. Can be given multiple times."
+		)
+		("runs", po::value<size_t>(&runs)->default_value(1), "Number of runs per case and step. The fastest run is reported.")
+		("output", po::value<string>(&outputFile), "Write the results to the given file instead of stdout.");
+
+	po::variables_map arguments;
+	try
+	{
+		po::store(po::parse_command_line(argc, argv, options), arguments);
+		po::notify(arguments);
+	}
+	catch (po::error const& _exception)
+	{
+		cerr << _exception.what() << endl;
+		return 1;
+	}
+
+	if (arguments.count("help"))
+	{
+		cout << options;
+		return 0;
+	}
+	if (runs == 0)
+	{
+		cerr << "The number of runs must be positive." << endl;
+		return 1;
+	}
+	if (testPath.empty() || !fs::is_directory(testPath / "libyul" / "yulOptimizerTests"))
+	{
+		cerr << "Test directory not found. Use --testpath or set ETH_TEST_PATH." << endl;
+		return 1;
+	}
+
+	auto selected = [&](string const& _name, vector<string> const& _selection, bool _exact) {
+		return _selection.empty() || any_of(_selection.begin(), _selection.end(), [&](string const& _selected) {
+			return _exact ? _name == _selected : boost::algorithm::contains(_name, _selected);
+		});
+	};
+
+	vector<YulCase> yulCases;
+	vector<SolidityCase> solidityCases;
+	try
+	{
+		yulCases = loadOptimiserTests(testPath / "libyul" / "yulOptimizerTests");
+		if (fs::is_directory(testPath / "compilationTests"))
+			solidityCases = loadCompilationTests(testPath / "compilationTests");
+	}
+	catch (fs::filesystem_error const& _exception)
+	{
+		cerr << _exception.what() << endl;
+		return 1;
+	}
+	for (SolidityCase const& solidityCase: solidityCases)
+		if (selected("ir/" + solidityCase.name, filters, false))
+			for (YulCase& irCase: generateIR(solidityCase))
+				yulCases.push_back(move(irCase));
+
+	bool failed = false;
+	Json::Value report(Json::objectValue);
+	report["version"] = VersionString;
+	report["results"] = Json::arrayValue;
+	auto addResult = [&](Json::Value _result) {
+		if (_result.isMember("error"))
+		{
+			cerr << _result["case"].asString() << " (" << _result["pipeline"].asString() << "): " << _result["error"].asString() << endl;
+			failed = true;
+		}
+		report["results"].append(move(_result));
+	};
+
+	for (YulCase const& yulCase: yulCases)
+	{
+		// Tests of other dialects or of invalid code are skipped.
+		if (!selected(yulCase.name, filters, false) || !parse(yulCase.source))
+			continue;
+		cerr << yulCase.name << endl;
+
+		for (auto const& [name, step]: yul::OptimiserSuite::allSteps())
+			if (selected(name, steps, true) && !step->invalidInCurrentEnvironment())
+				addResult(fastest(runs, yulCase.name, "yul-step/" + name, [&, &step = step]() -> optional<int64_t> {
+					shared_ptr<yul::Object> object = parse(yulCase.source);
+					return measureStep(*object, *step);
+				}));
+		if (selected("sequence", steps, true))
+			addResult(fastest(runs, yulCase.name, "yul-sequence", [&]() -> optional<int64_t> {
+				return measureSequence(yulCase.source);
+			}));
+		if (selected("parse", steps, true))
+			addResult(fastest(runs, yulCase.name, "yul-parse", [&]() -> optional<int64_t> {
+				return measureParse(yulCase.source);
+			}));
+	}
+
+	for (SolidityCase const& solidityCase: solidityCases)
+	{
+		if (!selected(solidityCase.name, filters, false))
+			continue;
+		cerr << solidityCase.name << endl;
+
+		for (EvmasmComponent const& component: evmasmComponents)
+			if (selected(component.name, steps, true))
+				addResult(fastest(runs, solidityCase.name, "evmasm/" + component.name, [&]() {
+					return measureEvmasmComponent(solidityCase, component);
+				}));
+	}
+
+	if (outputFile.empty())
+		cout << jsonPrettyPrint(report) << endl;
+	else
+	{
+		ofstream output(outputFile);
+		output << jsonPrettyPrint(report) << endl;
+		if (!output)
+		{
+			cerr << "Could not write " << outputFile << endl;
+			return 1;
+		}
+	}
+	return failed ? 1 : 0;
+}
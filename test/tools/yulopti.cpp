@@ -29,10 +29,16 @@
 #include <libyul/AST.h>
 #include <libyul/AsmParser.h>
 #include <libyul/AsmPrinter.h>
+#include <libyul/AssemblyStack.h>
+#include <libyul/Exceptions.h>
 #include <libyul/Object.h>
+#include <liblangutil/CharStreamProvider.h>
 #include <liblangutil/SourceReferenceFormatter.h>
 
+#include <libyul/optimiser/ASTWalker.h>
 #include <libyul/optimiser/Disambiguator.h>
+#include <libyul/optimiser/Metrics.h>
+#include <libyul/optimiser/NameDispenser.h>
 #include <libyul/optimiser/OptimiserStep.h>
 #include <libyul/optimiser/StackCompressor.h>
 #include <libyul/optimiser/VarNameCleaner.h>
@@ -40,11 +46,13 @@
 #include <libyul/optimiser/ReasoningBasedSimplifier.h>
 
 #include <libyul/backends/evm/EVMDialect.h>
+#include <libyul/backends/evm/EVMMetrics.h>
 
 #include <libsolutil/JSON.h>
 
 #include <boost/algorithm/string/predicate.hpp>
 #include <boost/algorithm/string/join.hpp>
+#include <boost/filesystem.hpp>
 #include <boost/program_options.hpp>
 
 #include <range/v3/action/sort.hpp>
@@ -57,6 +65,9 @@
 #include <range/v3/view/transform.hpp>
 
 #include <cctype>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
 #include <string>
 #include <sstream>
 #include <iostream>
@@ -71,13 +82,15 @@ using namespace solidity::frontend;
 using namespace solidity::yul;
 
 namespace po = boost::program_options;
+namespace fs = boost::filesystem;
 
 class YulOpti
 {
 public:
-	void printErrors()
+	void printErrors(CharStream const& _charStream)
 	{
-		SourceReferenceFormatter formatter(cerr, true, false);
+		SingletonCharStreamProvider charStreamProvider(_charStream);
+		SourceReferenceFormatter formatter(cerr, charStreamProvider, true, false);
 
 		for (auto const& error: m_errors)
 			formatter.printErrorInformation(*error);
@@ -91,7 +104,7 @@ public:
 		if (!m_ast || !errorReporter.errors().empty())
 		{
 			cerr << "Error parsing source." << endl;
-			printErrors();
+			printErrors(*scanner->charStream());
 			return false;
 		}
 		m_analysisInfo = make_shared<yul::AsmAnalysisInfo>();
@@ -103,7 +116,7 @@ public:
 		if (!analyzer.analyze(*m_ast) || !errorReporter.errors().empty())
 		{
 			cerr << "Error analyzing source." << endl;
-			printErrors();
+			printErrors(*scanner->charStream());
 			return false;
 		}
 		return true;
@@ -191,7 +204,7 @@ public:
 			char option = static_cast<char>(readStandardInputChar());
 			cout << ' ' << option << endl;
 
-			OptimiserStepContext context{m_dialect, *m_nameDispenser, reservedIdentifiers};
+			OptimiserStepContext context{m_dialect, *m_nameDispenser, reservedIdentifiers, nullptr};
 
 			auto abbreviationAndName = abbreviationMap.find(option);
 			if (abbreviationAndName != abbreviationMap.end())
@@ -230,6 +243,271 @@ private:
 	shared_ptr<NameDispenser> m_nameDispenser;
 };
 
+/**
+ * Sum of the costs of all expressions according to GasMeter.
+ */
+class EVMCost: public ASTWalker
+{
+public:
+	static size_t cost(EVMDialect const& _dialect, yul::Block const& _ast)
+	{
+		EVMCost evmCost{GasMeter{_dialect, false, 200}};
+		evmCost(_ast);
+		return evmCost.m_cost;
+	}
+
+	using ASTWalker::operator();
+	/// The costs of an expression include the costs of its arguments.
+	void visit(yul::Expression const& _expression) override { m_cost += m_meter.costs(_expression); }
+
+private:
+	explicit EVMCost(GasMeter _meter): m_meter(move(_meter)) {}
+
+	GasMeter m_meter;
+	size_t m_cost = 0;
+};
+
+/**
+ * Applies an optimiser sequence to files without interaction and measures every step.
+ */
+class YulOptiBatch
+{
+public:
+	YulOptiBatch(string const& _sequence, bool _trace):
+		m_sequence(parseSequence(_sequence)),
+		m_trace(_trace)
+	{}
+
+	/// Applies the sequence to the code of every object in @a _source, printing the measurements
+	/// of every step. @returns false if the source is invalid.
+	bool run(string const& _name, string const& _source)
+	{
+		AssemblyStack stack(EVMVersion{}, AssemblyStack::Language::StrictAssembly, OptimiserSettings::none());
+		if (!stack.parseAndAnalyze(_name, _source))
+		{
+			cerr << "Error parsing " << _name << "." << endl;
+			SourceReferenceFormatter formatter(cerr, stack, true, false);
+			for (auto const& error: stack.errors())
+				formatter.printErrorInformation(*error);
+			return false;
+		}
+		if (m_trace)
+			m_traceEvents.append(threadName(m_files, _name));
+		run(_name, *stack.parserResult());
+		++m_files;
+		return true;
+	}
+
+	/// Prints the total time, code size and cost changes of every step over all files.
+	void printSummary() const
+	{
+		vector<pair<string, Totals>> totals(m_totals.begin(), m_totals.end());
+		sort(totals.begin(), totals.end(), [](auto const& _a, auto const& _b) { return _a.second.time > _b.second.time; });
+		cout << "Total over " << m_files << " file(s):" << endl;
+		printHeader();
+		for (auto const& [step, stepTotals]: totals)
+			printRow(step + " (" + to_string(stepTotals.runs) + "x)", stepTotals.time, stepTotals.codeSizeDelta, stepTotals.costDelta);
+	}
+
+	/// @returns the measurements of all steps in the Chrome trace event format.
+	Json::Value trace() const
+	{
+		Json::Value trace(Json::objectValue);
+		trace["traceEvents"] = m_traceEvents;
+		trace["displayTimeUnit"] = "ms";
+		return trace;
+	}
+
+private:
+	struct Totals
+	{
+		size_t runs = 0;
+		chrono::microseconds time{0};
+		long codeSizeDelta = 0;
+		long costDelta = 0;
+	};
+
+	/// Part of the sequence outside of brackets, which is run once, or inside of brackets,
+	/// which is repeated until the code size does not change any more.
+	struct Segment
+	{
+		vector<string> steps;
+		bool untilStable = false;
+	};
+
+	static vector<Segment> parseSequence(string const& _sequence)
+	{
+		OptimiserSuite::validateSequence(_sequence);
+		vector<Segment> segments(1);
+		for (char abbreviation: _sequence)
+			if (abbreviation == '[' || abbreviation == ']')
+				segments.push_back({{}, abbreviation == '['});
+			else if (!isspace(abbreviation))
+				segments.back().steps.push_back(OptimiserSuite::stepAbbreviationToNameMap().at(abbreviation));
+		return segments;
+	}
+
+	void run(string const& _name, Object& _object)
+	{
+		string const name = _name + ":" + _object.name.str();
+		cout << name << endl;
+		printHeader();
+
+		// Prepare the code like the optimiser suite does before running any sequence.
+		set<YulString> reservedIdentifiers = m_dialect.fixedFunctionNames();
+		*_object.code = std::get<yul::Block>(Disambiguator(m_dialect, *_object.analysisInfo, reservedIdentifiers)(*_object.code));
+		NameDispenser dispenser(m_dialect, *_object.code, reservedIdentifiers);
+		OptimiserStepContext context{m_dialect, dispenser, reservedIdentifiers, nullptr};
+		for (char const* step: {"FunctionHoister", "BlockFlattener", "FunctionGrouper", "ForLoopInitRewriter"})
+			OptimiserSuite::allSteps().at(step)->run(context, *_object.code);
+
+		size_t const initialCodeSize = CodeSize::codeSizeIncludingFunctions(*_object.code);
+		size_t const initialCost = EVMCost::cost(m_dialect, *_object.code);
+		for (Segment const& segment: m_sequence)
+		{
+			size_t codeSize = segment.untilStable ? 0 : CodeSize::codeSizeIncludingFunctions(*_object.code);
+			for (size_t round = 0; round < (segment.untilStable ? OptimiserSuite::MaxRounds : 1); ++round)
+			{
+				if (segment.untilStable)
+				{
+					size_t const newCodeSize = CodeSize::codeSizeIncludingFunctions(*_object.code);
+					if (newCodeSize == codeSize)
+						break;
+					codeSize = newCodeSize;
+				}
+				for (string const& step: segment.steps)
+					runStep(step, context, *_object.code);
+			}
+		}
+		printRow(
+			"Total",
+			{},
+			static_cast<long>(CodeSize::codeSizeIncludingFunctions(*_object.code)) - static_cast<long>(initialCodeSize),
+			static_cast<long>(EVMCost::cost(m_dialect, *_object.code)) - static_cast<long>(initialCost)
+		);
+
+		for (auto const& subNode: _object.subObjects)
+			if (auto subObject = dynamic_pointer_cast<Object>(subNode))
+				run(_name, *subObject);
+	}
+
+	void runStep(string const& _step, OptimiserStepContext& _context, yul::Block& _ast)
+	{
+		size_t const codeSize = CodeSize::codeSizeIncludingFunctions(_ast);
+		size_t const cost = EVMCost::cost(m_dialect, _ast);
+		auto const start = chrono::steady_clock::now();
+		OptimiserSuite::allSteps().at(_step)->run(_context, _ast);
+		auto const end = chrono::steady_clock::now();
+		auto const time = chrono::duration_cast<chrono::microseconds>(end - start);
+		long const codeSizeDelta = static_cast<long>(CodeSize::codeSizeIncludingFunctions(_ast)) - static_cast<long>(codeSize);
+		long const costDelta = static_cast<long>(EVMCost::cost(m_dialect, _ast)) - static_cast<long>(cost);
+
+		printRow(_step, time, codeSizeDelta, costDelta);
+		Totals& totals = m_totals[_step];
+		++totals.runs;
+		totals.time += time;
+		totals.codeSizeDelta += codeSizeDelta;
+		totals.costDelta += costDelta;
+
+		if (m_trace)
+		{
+			Json::Value event(Json::objectValue);
+			event["name"] = _step;
+			event["cat"] = "yulOptimiser";
+			event["ph"] = "X";
+			event["ts"] = Json::Int64(chrono::duration_cast<chrono::microseconds>(start - m_start).count());
+			event["dur"] = Json::Int64(time.count());
+			event["pid"] = 1;
+			event["tid"] = Json::UInt64(m_files);
+			event["args"]["codeSizeDelta"] = Json::Int64(codeSizeDelta);
+			event["args"]["costDelta"] = Json::Int64(costDelta);
+			m_traceEvents.append(move(event));
+		}
+	}
+
+	/// @returns the trace event that shows the name of the file as the name of its track.
+	static Json::Value threadName(size_t _thread, string const& _name)
+	{
+		Json::Value event(Json::objectValue);
+		event["name"] = "thread_name";
+		event["ph"] = "M";
+		event["pid"] = 1;
+		event["tid"] = Json::UInt64(_thread);
+		event["args"]["name"] = _name;
+		return event;
+	}
+
+	static void printHeader()
+	{
+		cout << "  " << setw(48) << left << "Step" << right << setw(12) << "Time (us)" << setw(12) << "Size delta" << setw(12) << "Cost delta" << endl;
+	}
+
+	static void printRow(string const& _name, optional<chrono::microseconds> _time, long _codeSizeDelta, long _costDelta)
+	{
+		cout << "  " << setw(48) << left << _name << right << setw(12) << (_time ? to_string(_time->count()) : "") <<
+			setw(12) << _codeSizeDelta << setw(12) << _costDelta << endl;
+	}
+
+	EVMDialect const& m_dialect{EVMDialect::strictAssemblyForEVMObjects(EVMVersion{})};
+	vector<Segment> m_sequence;
+	bool m_trace = false;
+	chrono::steady_clock::time_point const m_start = chrono::steady_clock::now();
+	size_t m_files = 0;
+	map<string, Totals> m_totals;
+	Json::Value m_traceEvents{Json::arrayValue};
+};
+
+/// @returns the paths of the Yul files @a _path refers to: the file itself or, for a directory,
+/// all files with the extension ".yul" below it.
+vector<fs::path> yulFiles(fs::path const& _path)
+{
+	if (!fs::is_directory(_path))
+		return {_path};
+	vector<fs::path> files;
+	for (fs::recursive_directory_iterator it(_path), end; it != end; ++it)
+		if (fs::is_regular_file(it->path()) && it->path().extension() == ".yul")
+			files.push_back(it->path());
+	sort(files.begin(), files.end());
+	return files;
+}
+
+/// Optimises the files given by @a _input with @a _sequence. @returns the exit code.
+int runBatch(string const& _input, string const& _sequence, optional<string> const& _traceFile)
+{
+	optional<YulOptiBatch> batch;
+	try
+	{
+		batch.emplace(_sequence, _traceFile.has_value());
+	}
+	catch (OptimizerException const& _exception)
+	{
+		cerr << "Invalid optimiser sequence: " << _exception.comment() << endl;
+		return 1;
+	}
+
+	bool success = true;
+	for (fs::path const& file: yulFiles(_input))
+	{
+		string source = readFileAsString(file.string());
+		// Ignore the expectations of test files.
+		source = source.substr(0, source.find("\n// ----"));
+		success = batch->run(file.generic_string(), source) && success;
+	}
+	batch->printSummary();
+
+	if (_traceFile)
+	{
+		ofstream trace(*_traceFile);
+		trace << jsonCompactPrint(batch->trace()) << endl;
+		if (!trace)
+		{
+			cerr << "Could not write " << *_traceFile << endl;
+			return 1;
+		}
+	}
+	return success ? 0 : 1;
+}
+
 int main(int argc, char** argv)
 {
 	po::options_description options(
@@ -237,6 +515,9 @@ int main(int argc, char** argv)
 Usage: yulopti [Options] <file>
 Reads <file> as yul code and applies optimizer steps to it,
 interactively read from stdin.
+With --steps, applies the given sequence to <file> or to all .yul files
+in the directory <file> instead and prints the time and the changes of
+the code size and of the EVM cost of each step.
 
 Allowed options)",
 		po::options_description::m_default_line_length,
@@ -247,6 +528,16 @@ Allowed options)",
 			po::value<string>(),
 			"input file"
 		)
+		(
+			"steps",
+			po::value<string>(),
+			"Optimiser sequence in the step abbreviations, e.g. \"dhfoDgvulfnTUtnIf\", to apply without interaction."
+		)
+		(
+			"trace",
+			po::value<string>(),
+			"Write the time of each step of the sequence to the given file in the Chrome trace event format."
+		)
 		("help", "Show this help screen.");
 
 	// All positional options should be interpreted as input files
@@ -266,6 +557,22 @@ Allowed options)",
 		return 1;
 	}
 
+	if (arguments.count("input-file") && arguments.count("steps"))
+	{
+		optional<string> traceFile;
+		if (arguments.count("trace"))
+			traceFile = arguments["trace"].as<string>();
+		try
+		{
+			return runBatch(arguments["input-file"].as<string>(), arguments["steps"].as<string>(), traceFile);
+		}
+		catch (FileNotFound const& _exception)
+		{
+			cerr << "File not found:" << _exception.comment() << endl;
+			return 1;
+		}
+	}
+
 	string input;
 	try
 	{
@@ -55,10 +55,10 @@ namespace po = boost::program_options;
 namespace
 {
 
-void printErrors(ErrorList const& _errors)
+void printErrors(ErrorList const& _errors, CharStreamProvider const& _charStreamProvider)
 {
 	for (auto const& error: _errors)
-		SourceReferenceFormatter(cout, true, false).printErrorInformation(*error);
+		SourceReferenceFormatter(cout, _charStreamProvider, true, false).printErrorInformation(*error);
 }
 
 pair<shared_ptr<Block>, shared_ptr<AsmAnalysisInfo>> parse(string const& _source)
@@ -75,7 +75,7 @@ pair<shared_ptr<Block>, shared_ptr<AsmAnalysisInfo>> parse(string const& _source
 	}
 	else
 	{
-		printErrors(stack.errors());
+		printErrors(stack.errors(), stack);
 		return {};
 	}
 }
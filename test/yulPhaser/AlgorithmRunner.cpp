@@ -445,6 +445,69 @@ BOOST_FIXTURE_TEST_CASE(run_should_not_save_population_to_file_if_autosave_file_
 	BOOST_TEST(!fs::exists(m_autosavePath));
 }
 
+BOOST_FIXTURE_TEST_CASE(run_should_save_best_chromosomes_to_island_file_if_migration_directory_specified, AlgorithmRunnerAutosaveFixture)
+{
+	m_options.maxRounds = 1;
+	m_options.migrationDirectory = m_tempDir.path();
+	m_options.islandName = "island-a";
+	m_options.migrantCount = 2;
+	AlgorithmRunner runner(m_population, {}, m_options, m_output);
+
+	runner.run(m_algorithm);
+
+	vector<string> bestChromosomes = chromosomeStrings(runner.population());
+	bestChromosomes.resize(2);
+	BOOST_TEST(fs::is_regular_file(m_tempDir.memberPath("island-a.txt")));
+	BOOST_TEST(readLinesFromFile(m_tempDir.memberPath("island-a.txt")) == bestChromosomes);
+}
+
+BOOST_FIXTURE_TEST_CASE(run_should_replace_worst_individuals_with_fitter_immigrants, AlgorithmRunnerAutosaveFixture)
+{
+	Population population(m_fitnessMetric, vector<Chromosome>{Chromosome("aaaaaaa"), Chromosome("aaaaaa"), Chromosome("aaaaa")});
+	{
+		ofstream otherIsland(m_tempDir.memberPath("island-b.txt"));
+		otherIsland << "ffffffff" << endl << "aaaaa" << endl << "f" << endl;
+	}
+
+	m_options.maxRounds = 1;
+	m_options.migrationDirectory = m_tempDir.path();
+	m_options.islandName = "island-a";
+	CountingAlgorithm algorithm;
+	AlgorithmRunner runner(population, {}, m_options, m_output);
+
+	runner.run(algorithm);
+
+	BOOST_TEST(runner.population() == Population(m_fitnessMetric, vector<Chromosome>{Chromosome("f"), Chromosome("aaaaa"), Chromosome("aaaaaa")}));
+}
+
+BOOST_FIXTURE_TEST_CASE(run_should_migrate_only_every_migration_interval_rounds, AlgorithmRunnerAutosaveFixture)
+{
+	Population population(m_fitnessMetric, vector<Chromosome>{Chromosome("aaaaaaa"), Chromosome("aaaaaa")});
+	{
+		ofstream otherIsland(m_tempDir.memberPath("island-b.txt"));
+		otherIsland << "f" << endl;
+	}
+
+	m_options.migrationDirectory = m_tempDir.path();
+	m_options.islandName = "island-a";
+	m_options.migrationInterval = 3;
+	CountingAlgorithm algorithm;
+
+	m_options.maxRounds = 2;
+	AlgorithmRunner runner1(population, {}, m_options, m_output);
+	runner1.run(algorithm);
+
+	BOOST_TEST(runner1.population() == population);
+	BOOST_TEST(!fs::exists(m_tempDir.memberPath("island-a.txt")));
+
+	m_options.maxRounds = 3;
+	AlgorithmRunner runner2(population, {}, m_options, m_output);
+	runner2.run(algorithm);
+
+	BOOST_TEST(runner2.population() == Population(m_fitnessMetric, vector<Chromosome>{Chromosome("f"), Chromosome("aaaaaa")}));
+	BOOST_TEST(fs::is_regular_file(m_tempDir.memberPath("island-a.txt")));
+}
+
 BOOST_FIXTURE_TEST_CASE(run_should_randomise_duplicate_chromosomes_if_requested, AlgorithmRunnerFixture)
 {
 	Chromosome duplicate("afc");
@@ -16,6 +16,8 @@
 */
 // SPDX-License-Identifier: GPL-3.0
 
+#include <test/yulPhaser/TestHelpers.h>
+
 #include <tools/yulPhaser/FitnessMetrics.h>
 
 #include <libyul/optimiser/EquivalentFunctionCombiner.h>
@@ -23,6 +25,7 @@
 
 #include <liblangutil/CharStream.h>
 
+#include <libsolutil/CommonData.h>
 #include <libsolutil/CommonIO.h>
 
 #include <boost/test/unit_test.hpp>
@@ -277,6 +280,82 @@ BOOST_FIXTURE_TEST_CASE(FitnessMetricMinimum_evaluate_should_compute_minimum_of_
 	BOOST_TEST(metric.metrics() == m_simpleMetrics);
 }
 
+BOOST_FIXTURE_TEST_CASE(evaluateAll_should_return_the_same_values_on_multiple_threads, FitnessMetricCombinationFixture)
+{
+	vector<shared_ptr<FitnessMetric>> cachedMetrics = {
+		make_shared<ProgramSize>(nullopt, m_programCache, m_weights, 1),
+		make_shared<RelativeProgramSize>(nullopt, m_programCache, 3, m_weights, 2),
+	};
+	vector<Chromosome> chromosomes = {m_chromosome, Chromosome("fcCUnDve"), Chromosome(""), m_chromosome};
+
+	FitnessMetricSum sequentialMetric(m_simpleMetrics + cachedMetrics);
+	FitnessMetricSum parallelMetric(m_simpleMetrics + cachedMetrics, 4);
+
+	vector<size_t> values = parallelMetric.evaluateAll(chromosomes);
+	BOOST_TEST(values.size() == chromosomes.size());
+	for (size_t i = 0; i < chromosomes.size(); ++i)
+		BOOST_TEST(values[i] == sequentialMetric.evaluate(chromosomes[i]));
+	BOOST_TEST(parallelMetric.evaluate(m_chromosome) == values[0]);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+BOOST_AUTO_TEST_SUITE(MultiFidelityMetricTest)
+
+/// Metric that returns ten times the length of the chromosome and counts its evaluations.
+class CountingMetric: public FitnessMetric
+{
+public:
+	size_t evaluate(Chromosome const& _chromosome) override
+	{
+		++evaluationCount;
+		return 10 * _chromosome.length();
+	}
+
+	size_t evaluationCount = 0;
+};
+
+BOOST_AUTO_TEST_CASE(evaluateAll_should_evaluate_only_the_best_screened_chromosomes_with_the_full_metric)
+{
+	auto fullMetric = make_shared<CountingMetric>();
+	MultiFidelityMetric metric(make_shared<ChromosomeLengthMetric>(), fullMetric, 0.5);
+	vector<Chromosome> chromosomes = {Chromosome("fcCU"), Chromosome("f"), Chromosome("fc"), Chromosome("fcC")};
+
+	// The values of the chromosomes that are not fully evaluated are scaled by 30 / 3 but are
+	// not better than the worst of the fully evaluated ones.
+	BOOST_TEST(metric.evaluateAll(chromosomes) == (vector<size_t>{40, 10, 20, 30}));
+	BOOST_TEST(fullMetric->evaluationCount == 2);
+}
+
+BOOST_AUTO_TEST_CASE(evaluateAll_should_adapt_the_fraction_of_fully_evaluated_chromosomes)
+{
+	auto fullMetric = make_shared<CountingMetric>();
+	MultiFidelityMetric metric(make_shared<ChromosomeLengthMetric>(), fullMetric, 0.5, 0.25);
+	vector<Chromosome> chromosomes = {Chromosome("fcCU"), Chromosome("f"), Chromosome("fc"), Chromosome("fcC")};
+
+	// The screening agrees with the full metric, so the fraction shrinks, but not below the minimum.
+	metric.evaluateAll(chromosomes);
+	BOOST_TEST(metric.fraction() < 0.5);
+	for (size_t i = 0; i < 10; ++i)
+	{
+		metric.evaluateAll(chromosomes);
+		BOOST_TEST(metric.fraction() >= 0.25);
+		BOOST_TEST(metric.fraction() < 0.5);
+	}
+
+	// A single fully evaluated chromosome does not show that the screening is good, so the fraction grows.
+	MultiFidelityMetric otherMetric(make_shared<ChromosomeLengthMetric>(), make_shared<CountingMetric>(), 0.5, 0.25);
+	otherMetric.evaluateAll({Chromosome("f"), Chromosome("fc")});
+	BOOST_TEST(otherMetric.fraction() > 0.5);
+}
+
+BOOST_AUTO_TEST_CASE(evaluate_should_use_the_full_metric)
+{
+	auto fullMetric = make_shared<CountingMetric>();
+	MultiFidelityMetric metric(make_shared<ChromosomeLengthMetric>(), fullMetric, 0.5);
+	BOOST_TEST(metric.evaluate(Chromosome("fcC")) == 30);
+	BOOST_TEST(fullMetric->evaluationCount == 1);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 BOOST_AUTO_TEST_SUITE_END()
 BOOST_AUTO_TEST_SUITE_END()
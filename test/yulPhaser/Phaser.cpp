@@ -87,6 +87,9 @@ protected:
 		/* metricAggregator = */ MetricAggregatorChoice::Average,
 		/* relativeMetricScale = */ 5,
 		/* chromosomeRepetitions = */ 1,
+		/* parallelism = */ 1,
+		/* screeningProgramCount = */ 0,
+		/* screeningFraction = */ 0.5,
 	};
 	CodeWeights const m_weights{};
 };
@@ -275,6 +278,31 @@ BOOST_FIXTURE_TEST_CASE(build_should_pass_program_caches_to_metrics, FitnessMetr
 	}
 }
 
+BOOST_FIXTURE_TEST_CASE(build_should_screen_chromosomes_with_the_metrics_of_the_first_programs, FitnessMetricFactoryFixture)
+{
+	m_options.screeningProgramCount = 1;
+	m_options.screeningFraction = 0.3;
+	unique_ptr<FitnessMetric> metric = FitnessMetricFactory::build(
+		m_options,
+		m_programs,
+		vector<shared_ptr<ProgramCache>>(m_programs.size(), nullptr),
+		m_weights
+	);
+	BOOST_REQUIRE(metric != nullptr);
+
+	auto multiFidelityMetric = dynamic_cast<MultiFidelityMetric*>(metric.get());
+	BOOST_REQUIRE(multiFidelityMetric != nullptr);
+	BOOST_TEST(multiFidelityMetric->fraction() == 0.3);
+
+	auto screeningMetric = dynamic_cast<FitnessMetricAverage*>(multiFidelityMetric->screeningMetric().get());
+	auto fullMetric = dynamic_cast<FitnessMetricAverage*>(multiFidelityMetric->fullMetric().get());
+	BOOST_REQUIRE(screeningMetric != nullptr);
+	BOOST_REQUIRE(fullMetric != nullptr);
+	BOOST_REQUIRE(screeningMetric->metrics().size() == 1);
+	BOOST_REQUIRE(fullMetric->metrics().size() == m_programs.size());
+	BOOST_TEST(screeningMetric->metrics()[0] == fullMetric->metrics()[0]);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 BOOST_AUTO_TEST_SUITE(PopulationFactoryTest)
 
@@ -385,7 +413,7 @@ BOOST_AUTO_TEST_SUITE(ProgramCacheFactoryTest)
 
 BOOST_FIXTURE_TEST_CASE(build_should_create_cache_for_each_input_program_if_cache_enabled, FixtureWithPrograms)
 {
-	ProgramCacheFactory::Options options{/* programCacheEnabled = */ true};
+	ProgramCacheFactory::Options options{/* programCacheEnabled = */ true, /* programCacheSizeLimit = */ 0};
 	vector<shared_ptr<ProgramCache>> caches = ProgramCacheFactory::build(options, m_programs);
 	assert(m_programs.size() >= 2 && "There must be at least 2 programs for this test to be meaningful");
 
@@ -399,7 +427,7 @@ BOOST_FIXTURE_TEST_CASE(build_should_create_cache_for_each_input_program_if_cach
 
 BOOST_FIXTURE_TEST_CASE(build_should_return_nullptr_for_each_input_program_if_cache_disabled, FixtureWithPrograms)
 {
-	ProgramCacheFactory::Options options{/* programCacheEnabled = */ false};
+	ProgramCacheFactory::Options options{/* programCacheEnabled = */ false, /* programCacheSizeLimit = */ 0};
 	vector<shared_ptr<ProgramCache>> caches = ProgramCacheFactory::build(options, m_programs);
 	assert(m_programs.size() >= 2 && "There must be at least 2 programs for this test to be meaningful");
 
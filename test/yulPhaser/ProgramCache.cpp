@@ -213,6 +213,30 @@ BOOST_FIXTURE_TEST_CASE(startRound_should_remove_entries_older_than_two_rounds,
 	BOOST_TEST(m_programCache.size() == 0);
 }
 
+BOOST_FIXTURE_TEST_CASE(optimiseProgram_should_remove_least_recently_used_entries_when_over_size_limit, ProgramCacheFixture)
+{
+	size_t sizeI = optimisedProgram(m_program, "I").codeSize(CacheStats::StorageWeights);
+	size_t sizeIu = optimisedProgram(m_program, "Iu").codeSize(CacheStats::StorageWeights);
+	size_t sizeIuO = optimisedProgram(m_program, "IuO").codeSize(CacheStats::StorageWeights);
+	ProgramCache programCache(m_program, sizeI + sizeIu + sizeIuO);
+	BOOST_TEST(programCache.codeSizeLimit() == sizeI + sizeIu + sizeIuO);
+
+	programCache.optimiseProgram("IuO");
+	BOOST_REQUIRE((cachedKeys(programCache) == set<string>{"I", "Iu", "IuO"}));
+	BOOST_TEST(programCache.gatherStats().totalCodeSize == sizeI + sizeIu + sizeIuO);
+
+	Program cachedProgram = programCache.optimiseProgram("L");
+
+	BOOST_TEST(toString(cachedProgram) == toString(optimisedProgram(m_program, "L")));
+	set<string> keys = cachedKeys(programCache);
+	BOOST_TEST(keys.count("L") == 1);
+	BOOST_TEST(keys.count("IuO") == 0);
+	for (string const& key: keys)
+		if (key.size() > 1)
+			BOOST_TEST(keys.count(key.substr(0, key.size() - 1)) == 1);
+	BOOST_TEST(programCache.gatherStats().totalCodeSize <= programCache.codeSizeLimit());
+}
+
 BOOST_FIXTURE_TEST_CASE(gatherStats_should_return_cache_statistics, ProgramCacheFixture)
 {
 	size_t sizeI = optimisedProgram(m_program, "I").codeSize(CacheStats::StorageWeights);
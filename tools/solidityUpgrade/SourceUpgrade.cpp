@@ -322,12 +322,10 @@ void SourceUpgrade::runUpgrade()
 
 	while (recompile && !m_compiler->errors().empty())
 	{
-		for (auto& sourceCode: m_sourceCodes)
-		{
-			recompile = analyzeAndUpgrade(sourceCode);
-			if (recompile)
-				break;
-		}
+		recompile = false;
+		for (auto const& sourceCode: m_sourceCodes)
+			if (analyzeAndUpgrade(sourceCode))
+				recompile = true;
 
 		if (recompile)
 		{
@@ -346,37 +344,49 @@ bool SourceUpgrade::analyzeAndUpgrade(pair<string, string> const& _sourceCode)
 	if (verbose)
 		log() << "Analyzing and upgrading " << _sourceCode.first << "." << endl;
 
+	size_t firstChange = m_suite.changes().size();
 	if (m_compiler->state() >= CompilerStack::State::AnalysisPerformed)
-		m_suite.analyze(m_compiler->ast(_sourceCode.first));
+		m_suite.analyze(*m_compiler, m_compiler->ast(_sourceCode.first));
 
-	if (!m_suite.changes().empty())
+	vector<UpgradeChange const*> applicableChanges;
+	for (size_t i = firstChange; i < m_suite.changes().size(); ++i)
 	{
-		auto& change = m_suite.changes().front();
+		auto const& change = m_suite.changes()[i];
 
 		if (verbose)
-			change.log(true);
+			change.log(*m_compiler, true);
 
-		if (change.level() == UpgradeChange::Level::Safe)
-		{
-			applyChange(_sourceCode, change);
-			return true;
-		}
-		else if (change.level() == UpgradeChange::Level::Unsafe)
-		{
-			if (applyUnsafe)
-			{
-				applyChange(_sourceCode, change);
-				return true;
-			}
-		}
+		if (change.level() == UpgradeChange::Level::Safe || applyUnsafe)
+			applicableChanges.emplace_back(&change);
 	}
 
-	return false;
+	// Changes that overlap with an earlier one are left for the next
+	// analysis, which is run on the upgraded source.
+	stable_sort(
+		applicableChanges.begin(),
+		applicableChanges.end(),
+		[](UpgradeChange const* _a, UpgradeChange const* _b) { return _a->location().start < _b->location().start; }
+	);
+	vector<UpgradeChange const*> changes;
+	for (UpgradeChange const* change: applicableChanges)
+		if (
+			changes.empty() || (
+				change->location().start >= changes.back()->location().end &&
+				change->location().start > changes.back()->location().start
+			)
+		)
+			changes.emplace_back(change);
+
+	if (changes.empty())
+		return false;
+
+	applyChanges(_sourceCode, changes);
+	return true;
 }
 
-void SourceUpgrade::applyChange(
+void SourceUpgrade::applyChanges(
 	pair<string, string> const& _sourceCode,
-	UpgradeChange& _change
+	vector<UpgradeChange const*> const& _changes
 )
 {
 	bool dryRun = m_args.count(g_argDryRun);
@@ -384,20 +394,25 @@ void SourceUpgrade::applyChange(
 
 	if (verbose)
 	{
-		log() << "Applying change to " << _sourceCode.first << endl << endl;
-		log() << _change.patch();
+		log() << "Applying " << _changes.size() << " changes to " << _sourceCode.first << endl << endl;
+		for (UpgradeChange const* change: _changes)
+			log() << change->patch();
 	}
 
-	_change.apply();
-	m_sourceCodes[_sourceCode.first] = _change.source();
+	// Changes are applied back to front, so that the locations of the
+	// remaining ones stay valid.
+	string upgradedSource = _sourceCode.second;
+	for (auto change = _changes.rbegin(); change != _changes.rend(); ++change)
+		upgradedSource = (*change)->apply(move(upgradedSource));
+	m_sourceCodes[_sourceCode.first] = upgradedSource;
 
 	if (!dryRun)
-		writeInputFile(_sourceCode.first, _change.source());
+		writeInputFile(_sourceCode.first, upgradedSource);
 }
 
 void SourceUpgrade::printErrors() const
 {
-	auto formatter = make_unique<langutil::SourceReferenceFormatter>(cout, true, false);
+	auto formatter = make_unique<langutil::SourceReferenceFormatter>(cout, *m_compiler, true, false);
 
 	for (auto const& error: m_compiler->errors())
 		if (error->type() != langutil::Error::Type::Warning)
@@ -35,6 +35,7 @@ namespace
 {
 
 inline string appendOverride(
+	langutil::CharStreamProvider const& _charStreamProvider,
 	FunctionDefinition const& _function,
 	Contracts const& _expectedContracts
 )
@@ -43,26 +44,26 @@ inline string appendOverride(
 	string upgradedCode;
 	string overrideExpression = SourceGeneration::functionOverride(_expectedContracts);
 
-	if (SourceAnalysis::hasVirtualKeyword(location))
-		upgradedCode = SourceTransform::insertAfterKeyword(
+	if (SourceAnalysis{_charStreamProvider}.hasVirtualKeyword(location))
+		upgradedCode = SourceTransform{_charStreamProvider}.insertAfterKeyword(
 			location,
 			"virtual",
 			overrideExpression
 		);
-	else if (SourceAnalysis::hasMutabilityKeyword(location))
-		upgradedCode = SourceTransform::insertAfterKeyword(
+	else if (SourceAnalysis{_charStreamProvider}.hasMutabilityKeyword(location))
+		upgradedCode = SourceTransform{_charStreamProvider}.insertAfterKeyword(
 			location,
 			stateMutabilityToString(_function.stateMutability()),
 			overrideExpression
 		);
-	else if (SourceAnalysis::hasVisibilityKeyword(location))
-		upgradedCode = SourceTransform::insertAfterKeyword(
+	else if (SourceAnalysis{_charStreamProvider}.hasVisibilityKeyword(location))
+		upgradedCode = SourceTransform{_charStreamProvider}.insertAfterKeyword(
 			location,
 			Declaration::visibilityToString(_function.visibility()),
 			overrideExpression
 		);
 	else
-		upgradedCode = SourceTransform::insertAfterRightParenthesis(
+		upgradedCode = SourceTransform{_charStreamProvider}.insertAfterRightParenthesis(
 			location,
 			overrideExpression
 		);
@@ -70,25 +71,28 @@ inline string appendOverride(
 	return upgradedCode;
 }
 
-inline string appendVirtual(FunctionDefinition const& _function)
+inline string appendVirtual(
+	langutil::CharStreamProvider const& _charStreamProvider,
+	FunctionDefinition const& _function
+)
 {
 	auto location = _function.location();
 	string upgradedCode;
 
-	if (SourceAnalysis::hasMutabilityKeyword(location))
-		upgradedCode = SourceTransform::insertAfterKeyword(
+	if (SourceAnalysis{_charStreamProvider}.hasMutabilityKeyword(location))
+		upgradedCode = SourceTransform{_charStreamProvider}.insertAfterKeyword(
 			location,
 			stateMutabilityToString(_function.stateMutability()),
 			"virtual"
 		);
-	else if (SourceAnalysis::hasVisibilityKeyword(location))
-		upgradedCode = SourceTransform::insertAfterKeyword(
+	else if (SourceAnalysis{_charStreamProvider}.hasVisibilityKeyword(location))
+		upgradedCode = SourceTransform{_charStreamProvider}.insertAfterKeyword(
 			location,
 			Declaration::visibilityToString(_function.visibility()),
 			"virtual"
 		);
 	else
-		upgradedCode = SourceTransform::insertAfterRightParenthesis(
+		upgradedCode = SourceTransform{_charStreamProvider}.insertAfterRightParenthesis(
 			_function.location(),
 			"virtual"
 		);
@@ -110,7 +114,7 @@ void AbstractContract::endVisit(ContractDefinition const& _contract)
 		m_changes.emplace_back(
 				UpgradeChange::Level::Safe,
 				_contract.location(),
-				SourceTransform::insertBeforeKeyword(_contract.location(), "contract", "abstract")
+				SourceTransform{m_charStreamProvider}.insertBeforeKeyword(_contract.location(), "contract", "abstract")
 		);
 }
 
@@ -134,7 +138,7 @@ void OverridingFunction::endVisit(ContractDefinition const& _contract)
 				m_changes.emplace_back(
 						UpgradeChange::Level::Safe,
 						function->location(),
-						appendOverride(*function, expectedContracts)
+						appendOverride(m_charStreamProvider, *function, expectedContracts)
 				);
 
 			for (auto [begin, end] = inheritedFunctions.equal_range(proxy); begin != end; begin++)
@@ -151,7 +155,7 @@ void OverridingFunction::endVisit(ContractDefinition const& _contract)
 						m_changes.emplace_back(
 								UpgradeChange::Level::Safe,
 								function->location(),
-								appendOverride(*function, expectedContracts)
+								appendOverride(m_charStreamProvider, *function, expectedContracts)
 						);
 				}
 			}
@@ -179,7 +183,7 @@ void VirtualFunction::endVisit(ContractDefinition const& _contract)
 				m_changes.emplace_back(
 						UpgradeChange::Level::Safe,
 						function->location(),
-						appendVirtual(*function)
+						appendVirtual(m_charStreamProvider, *function)
 				);
 			}
 
@@ -194,7 +198,7 @@ void VirtualFunction::endVisit(ContractDefinition const& _contract)
 					m_changes.emplace_back(
 							UpgradeChange::Level::Safe,
 							function->location(),
-							appendVirtual(*function)
+							appendVirtual(m_charStreamProvider, *function)
 					);
 				}
 			}
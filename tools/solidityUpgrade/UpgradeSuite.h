@@ -19,6 +19,7 @@
 
 #include <tools/solidityUpgrade/UpgradeChange.h>
 
+#include <liblangutil/CharStreamProvider.h>
 #include <liblangutil/ErrorReporter.h>
 
 #include <libsolidity/ast/ASTVisitor.h>
@@ -53,8 +54,9 @@ protected:
 class AnalysisUpgrade: public Upgrade, public frontend::ASTConstVisitor
 {
 public:
-	AnalysisUpgrade(std::vector<UpgradeChange>& _changes):
+	AnalysisUpgrade(langutil::CharStreamProvider const& _charStreamProvider, std::vector<UpgradeChange>& _changes):
 		Upgrade(_changes),
+		m_charStreamProvider(_charStreamProvider),
 		m_errorReporter(m_errors),
 		m_overrideChecker(m_errorReporter)
 	{}
@@ -62,6 +64,8 @@ public:
 	/// be run after the analysis phase of the compiler.
 	void analyze(frontend::SourceUnit const&) {}
 protected:
+	/// Sources the locations of the analysed AST refer to.
+	langutil::CharStreamProvider const& m_charStreamProvider;
 	langutil::ErrorList m_errors;
 	langutil::ErrorReporter m_errorReporter;
 	frontend::OverrideChecker m_overrideChecker;
@@ -77,7 +81,7 @@ public:
 	/// The base interface function that needs to be implemented for each
 	/// suite. It should create suite-specific upgrade modules and trigger
 	/// their analysis.
-	void analyze(frontend::SourceUnit const& _sourceUnit);
+	void analyze(langutil::CharStreamProvider const& _charStreamProvider, frontend::SourceUnit const& _sourceUnit);
 	/// Resets all changes collected so far.
 	void reset() { m_changes.clear(); }
 
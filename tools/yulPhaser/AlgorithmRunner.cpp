@@ -18,17 +18,23 @@
 
 #include <tools/yulPhaser/AlgorithmRunner.h>
 
+#include <tools/yulPhaser/Common.h>
 #include <tools/yulPhaser/Exceptions.h>
 
 #include <libsolutil/Assertions.h>
 
+#include <boost/filesystem.hpp>
+
 #include <cerrno>
 #include <cstring>
 #include <fstream>
+#include <set>
 
 using namespace std;
 using namespace solidity::phaser;
 
+namespace fs = boost::filesystem;
+
 void AlgorithmRunner::run(GeneticAlgorithm& _algorithm)
 {
 	populationAutosave();
@@ -42,6 +48,7 @@ void AlgorithmRunner::run(GeneticAlgorithm& _algorithm)
 		cacheStartRound(round + 1);
 
 		m_population = _algorithm.runNextRound(m_population);
+		migrate(round + 1);
 		randomiseDuplicates();
 
 		printRoundSummary(round, roundTimeStart, totalTimeStart);
@@ -133,20 +140,83 @@ void AlgorithmRunner::populationAutosave() const
 	if (!m_options.populationAutosaveFile.has_value())
 		return;
 
-	ofstream outputStream(m_options.populationAutosaveFile.value(), ios::out | ios::trunc);
-	assertThrow(
-		outputStream.is_open(),
-		FileOpenError,
-		"Could not open file '" + m_options.populationAutosaveFile.value() + "': " + strerror(errno)
-	);
+	saveChromosomes(m_population.individuals(), m_options.populationAutosaveFile.value());
+}
 
-	for (auto& individual: m_population.individuals())
-		outputStream << individual.chromosome << endl;
+void AlgorithmRunner::migrate(size_t _roundNumber)
+{
+	if (!m_options.migrationDirectory.has_value())
+		return;
 
+	assert(m_options.migrationInterval > 0);
+	if (_roundNumber % m_options.migrationInterval != 0)
+		return;
+
+	emigrate();
+	immigrate();
+}
+
+void AlgorithmRunner::emigrate() const
+{
+	assert(m_options.migrationDirectory.has_value());
+	assert(!m_options.islandName.empty());
+
+	fs::path directory(m_options.migrationDirectory.value());
+	fs::path filePath = directory / (m_options.islandName + ".txt");
+	fs::path temporaryFilePath = directory / ("." + m_options.islandName + ".txt.tmp");
+
+	size_t migrantCount = min(m_options.migrantCount, m_population.individuals().size());
+	saveChromosomes(
+		vector<Individual>(m_population.individuals().begin(), m_population.individuals().begin() + static_cast<ptrdiff_t>(migrantCount)),
+		temporaryFilePath.string()
+	);
+
+	// Other islands may be reading the file at the same time. Renaming replaces it atomically
+	// so that they never see it only partially written.
+	boost::system::error_code errorCode;
+	fs::rename(temporaryFilePath, filePath, errorCode);
 	assertThrow(
-		!outputStream.bad(),
+		!errorCode,
 		FileWriteError,
-		"Error while writing to file '" + m_options.populationAutosaveFile.value() + "': " + strerror(errno)
+		"Could not replace file '" + filePath.string() + "': " + errorCode.message()
+	);
+}
+
+void AlgorithmRunner::immigrate()
+{
+	assert(m_options.migrationDirectory.has_value());
+
+	set<string> knownGenes;
+	for (auto const& individual: m_population.individuals())
+		knownGenes.insert(individual.chromosome.genes());
+
+	// Sort the files to make the order of immigrants independent of the file system.
+	set<fs::path> islandFiles;
+	for (auto const& entry: fs::directory_iterator(m_options.migrationDirectory.value()))
+		if (
+			fs::is_regular_file(entry.path()) &&
+			entry.path().extension() == ".txt" &&
+			entry.path().stem() != m_options.islandName
+		)
+			islandFiles.insert(entry.path());
+
+	vector<Chromosome> immigrants;
+	for (fs::path const& islandFile: islandFiles)
+		for (string const& genes: readLinesFromFile(islandFile.string()))
+			if (knownGenes.insert(genes).second)
+				immigrants.emplace_back(genes);
+
+	if (immigrants.empty())
+		return;
+
+	size_t populationSize = m_population.individuals().size();
+	Population combinedPopulation = m_population + Population(m_population.fitnessMetric(), move(immigrants));
+	m_population = Population(
+		m_population.fitnessMetric(),
+		vector<Individual>(
+			combinedPopulation.individuals().begin(),
+			combinedPopulation.individuals().begin() + static_cast<ptrdiff_t>(populationSize)
+		)
 	);
 }
 
@@ -179,6 +249,25 @@ void AlgorithmRunner::randomiseDuplicates()
 	}
 }
 
+void AlgorithmRunner::saveChromosomes(vector<Individual> const& _individuals, string const& _filePath)
+{
+	ofstream outputStream(_filePath, ios::out | ios::trunc);
+	assertThrow(
+		outputStream.is_open(),
+		FileOpenError,
+		"Could not open file '" + _filePath + "': " + strerror(errno)
+	);
+
+	for (auto& individual: _individuals)
+		outputStream << individual.chromosome << endl;
+
+	assertThrow(
+		!outputStream.bad(),
+		FileWriteError,
+		"Error while writing to file '" + _filePath + "': " + strerror(errno)
+	);
+}
+
 Population AlgorithmRunner::randomiseDuplicates(
 	Population _population,
 	size_t _minChromosomeLength,
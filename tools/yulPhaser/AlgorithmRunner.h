@@ -38,6 +38,13 @@ namespace solidity::phaser
  *
  * The class is also responsible for providing text feedback on the execution of the algorithm
  * to the associated output stream.
+ *
+ * If @a Options::migrationDirectory is set, the population is treated as one island of an island
+ * model shared by multiple processes, possibly running on different machines. Every
+ * @a Options::migrationInterval rounds the runner saves its best @a Options::migrantCount
+ * chromosomes to a file named after the island in that directory and reads the files of all
+ * the other islands. The chromosomes read are evaluated and replace the worst individuals of
+ * the population if they are fitter. Chromosomes already present in the population are ignored.
  */
 class AlgorithmRunner
 {
@@ -53,6 +60,10 @@ public:
 		bool showOnlyTopChromosome = false;
 		bool showRoundInfo = true;
 		bool showCacheStats = false;
+		std::optional<std::string> migrationDirectory = std::nullopt;
+		std::string islandName = "";
+		size_t migrationInterval = 1;
+		size_t migrantCount = 1;
 	};
 
 	AlgorithmRunner(
@@ -80,10 +91,15 @@ private:
 	void printInitialPopulation() const;
 	void printCacheStats() const;
 	void populationAutosave() const;
+	void migrate(size_t _roundNumber);
+	void emigrate() const;
+	void immigrate();
 	void randomiseDuplicates();
 	void cacheClear();
 	void cacheStartRound(size_t _roundNumber);
 
+	static void saveChromosomes(std::vector<Individual> const& _individuals, std::string const& _filePath);
+
 	static Population randomiseDuplicates(
 		Population _population,
 		size_t _minChromosomeLength,
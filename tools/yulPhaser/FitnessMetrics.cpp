@@ -19,8 +19,11 @@
 #include <tools/yulPhaser/FitnessMetrics.h>
 
 #include <libsolutil/CommonIO.h>
+#include <libsolutil/ThreadPool.h>
 
+#include <algorithm>
 #include <cmath>
+#include <numeric>
 
 using namespace std;
 using namespace solidity::util;
@@ -75,46 +78,114 @@ size_t RelativeProgramSize::evaluate(Chromosome const& _chromosome)
 	));
 }
 
-size_t FitnessMetricAverage::evaluate(Chromosome const& _chromosome)
+vector<size_t> FitnessMetric::evaluateAll(vector<Chromosome> const& _chromosomes)
 {
-	assert(m_metrics.size() > 0);
-
-	size_t total = m_metrics[0]->evaluate(_chromosome);
-	for (size_t i = 1; i < m_metrics.size(); ++i)
-		total += m_metrics[i]->evaluate(_chromosome);
+	vector<size_t> values;
+	for (Chromosome const& chromosome: _chromosomes)
+		values.push_back(evaluate(chromosome));
 
-	return total / m_metrics.size();
+	return values;
 }
 
-size_t FitnessMetricSum::evaluate(Chromosome const& _chromosome)
+vector<size_t> MultiFidelityMetric::evaluateAll(vector<Chromosome> const& _chromosomes)
 {
-	assert(m_metrics.size() > 0);
+	if (_chromosomes.empty())
+		return {};
+
+	vector<size_t> screeningValues = m_screeningMetric->evaluateAll(_chromosomes);
+	vector<size_t> order(_chromosomes.size());
+	iota(order.begin(), order.end(), 0);
+	stable_sort(order.begin(), order.end(), [&](size_t _a, size_t _b) {
+		return screeningValues[_a] < screeningValues[_b];
+	});
+
+	size_t evaluatedCount = min(
+		_chromosomes.size(),
+		max<size_t>(1, static_cast<size_t>(ceil(m_fraction * double(_chromosomes.size()))))
+	);
+	vector<Chromosome> evaluatedChromosomes;
+	for (size_t i = 0; i < evaluatedCount; ++i)
+		evaluatedChromosomes.push_back(_chromosomes[order[i]]);
+	vector<size_t> fullValues = m_fullMetric->evaluateAll(evaluatedChromosomes);
+
+	vector<size_t> values(_chromosomes.size());
+	double fullTotal = 0;
+	double screeningTotal = 0;
+	size_t worstValue = 0;
+	for (size_t i = 0; i < evaluatedCount; ++i)
+	{
+		values[order[i]] = fullValues[i];
+		fullTotal += double(fullValues[i]);
+		screeningTotal += double(screeningValues[order[i]]);
+		worstValue = max(worstValue, fullValues[i]);
+	}
+	double const ratio = screeningTotal > 0 ? fullTotal / screeningTotal : 1;
+	for (size_t i = evaluatedCount; i < _chromosomes.size(); ++i)
+		values[order[i]] = max(worstValue, static_cast<size_t>(round(double(screeningValues[order[i]]) * ratio)));
+
+	size_t best = static_cast<size_t>(min_element(fullValues.begin(), fullValues.end()) - fullValues.begin());
+	if (best < evaluatedCount / 2)
+		m_fraction = max(m_minFraction, m_fraction * 0.8);
+	else
+		m_fraction = min(1.0, m_fraction * 1.25);
 
-	size_t total = m_metrics[0]->evaluate(_chromosome);
-	for (size_t i = 1; i < m_metrics.size(); ++i)
-		total += m_metrics[i]->evaluate(_chromosome);
+	return values;
+}
 
-	return total;
+size_t FitnessMetricCombination::evaluate(Chromosome const& _chromosome)
+{
+	return evaluateAll({_chromosome})[0];
 }
 
-size_t FitnessMetricMaximum::evaluate(Chromosome const& _chromosome)
+vector<size_t> FitnessMetricCombination::evaluateAll(vector<Chromosome> const& _chromosomes)
 {
 	assert(m_metrics.size() > 0);
 
-	size_t maximum = m_metrics[0]->evaluate(_chromosome);
-	for (size_t i = 1; i < m_metrics.size(); ++i)
-		maximum = max(maximum, m_metrics[i]->evaluate(_chromosome));
+	if (_chromosomes.empty())
+		return {};
+
+	// Every task stores its value at its own position, so that the values do not depend
+	// on the order in which the tasks are executed.
+	vector<vector<size_t>> nestedValues(_chromosomes.size(), vector<size_t>(m_metrics.size()));
+	{
+		ThreadPool pool(min(ThreadPool::effectiveThreads(m_parallelism), _chromosomes.size() * m_metrics.size()));
+		for (size_t i = 0; i < _chromosomes.size(); ++i)
+			for (size_t j = 0; j < m_metrics.size(); ++j)
+				pool.submit([&, i, j]() { nestedValues[i][j] = m_metrics[j]->evaluate(_chromosomes[i]); });
+		pool.wait();
+	}
+
+	vector<size_t> values;
+	for (vector<size_t> const& chromosomeValues: nestedValues)
+		values.push_back(combine(chromosomeValues));
+
+	return values;
+}
+
+size_t FitnessMetricAverage::combine(vector<size_t> const& _values) const
+{
+	size_t total = 0;
+	for (size_t value: _values)
+		total += value;
 
-	return maximum;
+	return total / _values.size();
 }
 
-size_t FitnessMetricMinimum::evaluate(Chromosome const& _chromosome)
+size_t FitnessMetricSum::combine(vector<size_t> const& _values) const
 {
-	assert(m_metrics.size() > 0);
+	size_t total = 0;
+	for (size_t value: _values)
+		total += value;
 
-	size_t minimum = m_metrics[0]->evaluate(_chromosome);
-	for (size_t i = 1; i < m_metrics.size(); ++i)
-		minimum = min(minimum, m_metrics[i]->evaluate(_chromosome));
+	return total;
+}
 
-	return minimum;
+size_t FitnessMetricMaximum::combine(vector<size_t> const& _values) const
+{
+	return *max_element(_values.begin(), _values.end());
+}
+
+size_t FitnessMetricMinimum::combine(vector<size_t> const& _values) const
+{
+	return *min_element(_values.begin(), _values.end());
 }
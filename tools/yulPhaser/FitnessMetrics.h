@@ -28,7 +28,9 @@
 #include <libyul/optimiser/Metrics.h>
 
 #include <cstddef>
+#include <memory>
 #include <optional>
+#include <vector>
 
 namespace solidity::phaser
 {
@@ -39,6 +41,10 @@ namespace solidity::phaser
  * The main feature is the @a evaluate() method that can tell how good a given chromosome is.
  * The lower the value, the better the fitness is. The result should be deterministic and depend
  * only on the chromosome and metric's state (which is constant).
+ *
+ * @a evaluateAll() evaluates many chromosomes at once and can be overridden to do it in parallel.
+ * Metrics nested in a @a FitnessMetricCombination that uses more than one thread must support
+ * concurrent calls to @a evaluate().
  */
 class FitnessMetric
 {
@@ -49,6 +55,10 @@ public:
 	virtual ~FitnessMetric() = default;
 
 	virtual size_t evaluate(Chromosome const& _chromosome) = 0;
+
+	/// Evaluates @a _chromosomes and @returns their values in the same order.
+	/// The default implementation evaluates them one after another.
+	virtual std::vector<size_t> evaluateAll(std::vector<Chromosome> const& _chromosomes);
 };
 
 /**
@@ -132,20 +142,79 @@ private:
 	size_t m_fixedPointPrecision;
 };
 
+/**
+ * Fitness metric that evaluates chromosomes inserted together in two stages. All of them are
+ * first screened with a cheap metric, e.g. the same metric on a subset of the programs, and only
+ * the best fraction of them is evaluated with the full metric. The values of the other chromosomes
+ * are estimated from their screening values, scaled by the ratio between the full and the
+ * screening values of the fully evaluated chromosomes, but are never better than the worst of
+ * these.
+ *
+ * The fraction adapts to how well the screening predicts the full metric. It shrinks if the best
+ * chromosome according to the full metric was in the better half of the fully evaluated ones and
+ * grows otherwise, staying between @a _minFraction and 1.
+ *
+ * @a evaluate() always uses the full metric.
+ */
+class MultiFidelityMetric: public FitnessMetric
+{
+public:
+	explicit MultiFidelityMetric(
+		std::shared_ptr<FitnessMetric> _screeningMetric,
+		std::shared_ptr<FitnessMetric> _fullMetric,
+		double _fraction,
+		double _minFraction = 0.1
+	):
+		m_screeningMetric(std::move(_screeningMetric)),
+		m_fullMetric(std::move(_fullMetric)),
+		m_fraction(_fraction),
+		m_minFraction(_minFraction)
+	{
+		assert(0 < m_minFraction && m_minFraction <= m_fraction && m_fraction <= 1);
+	}
+
+	std::shared_ptr<FitnessMetric> const& screeningMetric() const { return m_screeningMetric; }
+	std::shared_ptr<FitnessMetric> const& fullMetric() const { return m_fullMetric; }
+	double fraction() const { return m_fraction; }
+
+	size_t evaluate(Chromosome const& _chromosome) override { return m_fullMetric->evaluate(_chromosome); }
+	std::vector<size_t> evaluateAll(std::vector<Chromosome> const& _chromosomes) override;
+
+private:
+	std::shared_ptr<FitnessMetric> m_screeningMetric;
+	std::shared_ptr<FitnessMetric> m_fullMetric;
+	double m_fraction;
+	double m_minFraction;
+};
+
 /**
  * Abstract base class for fitness metrics that compute their value based on values of multiple
  * other, nested metrics.
+ *
+ * The nested metrics are evaluated on @a _parallelism threads (zero meaning one per hardware
+ * thread). @a evaluateAll() evaluates every chromosome with every nested metric as a separate
+ * task. The values do not depend on the number of threads.
  */
 class FitnessMetricCombination: public FitnessMetric
 {
 public:
-	explicit FitnessMetricCombination(std::vector<std::shared_ptr<FitnessMetric>> _metrics):
-		m_metrics(std::move(_metrics)) {}
+	explicit FitnessMetricCombination(std::vector<std::shared_ptr<FitnessMetric>> _metrics, size_t _parallelism = 1):
+		m_metrics(std::move(_metrics)),
+		m_parallelism(_parallelism) {}
 
 	std::vector<std::shared_ptr<FitnessMetric>> const& metrics() const { return m_metrics; }
+	size_t parallelism() const { return m_parallelism; }
+
+	size_t evaluate(Chromosome const& _chromosome) override;
+	std::vector<size_t> evaluateAll(std::vector<Chromosome> const& _chromosomes) override;
 
 protected:
+	/// @returns the value of a chromosome based on the values of the nested metrics, in the
+	/// order of @a m_metrics.
+	virtual size_t combine(std::vector<size_t> const& _values) const = 0;
+
 	std::vector<std::shared_ptr<FitnessMetric>> m_metrics;
+	size_t m_parallelism;
 };
 
 /**
@@ -155,7 +224,9 @@ class FitnessMetricAverage: public FitnessMetricCombination
 {
 public:
 	using FitnessMetricCombination::FitnessMetricCombination;
-	size_t evaluate(Chromosome const& _chromosome) override;
+
+protected:
+	size_t combine(std::vector<size_t> const& _values) const override;
 };
 
 /**
@@ -165,7 +236,9 @@ class FitnessMetricSum: public FitnessMetricCombination
 {
 public:
 	using FitnessMetricCombination::FitnessMetricCombination;
-	size_t evaluate(Chromosome const& _chromosome) override;
+
+protected:
+	size_t combine(std::vector<size_t> const& _values) const override;
 };
 
 /**
@@ -175,7 +248,9 @@ class FitnessMetricMaximum: public FitnessMetricCombination
 {
 public:
 	using FitnessMetricCombination::FitnessMetricCombination;
-	size_t evaluate(Chromosome const& _chromosome) override;
+
+protected:
+	size_t combine(std::vector<size_t> const& _values) const override;
 };
 
 /**
@@ -185,7 +260,9 @@ class FitnessMetricMinimum: public FitnessMetricCombination
 {
 public:
 	using FitnessMetricCombination::FitnessMetricCombination;
-	size_t evaluate(Chromosome const& _chromosome) override;
+
+protected:
+	size_t combine(std::vector<size_t> const& _values) const override;
 };
 
 }
@@ -27,6 +27,8 @@
 #include <tools/yulPhaser/SimulationRNG.h>
 
 #include <liblangutil/CharStream.h>
+#include <liblangutil/CharStreamProvider.h>
+#include <liblangutil/SourceReferenceFormatter.h>
 
 #include <libsolutil/Assertions.h>
 #include <libsolutil/CommonData.h>
@@ -218,6 +220,9 @@ FitnessMetricFactory::Options FitnessMetricFactory::Options::fromCommandLine(po:
 		_arguments["metric-aggregator"].as<MetricAggregatorChoice>(),
 		_arguments["relative-metric-scale"].as<size_t>(),
 		_arguments["chromosome-repetitions"].as<size_t>(),
+		_arguments["jobs"].as<size_t>(),
+		_arguments["screening-programs"].as<size_t>(),
+		_arguments["screening-fraction"].as<double>(),
 	};
 }
 
@@ -262,19 +267,38 @@ unique_ptr<FitnessMetric> FitnessMetricFactory::build(
 			assertThrow(false, solidity::util::Exception, "Invalid MetricChoice value.");
 	}
 
-	switch (_options.metricAggregator)
+	auto aggregate = [&](vector<shared_ptr<FitnessMetric>> _metrics) -> unique_ptr<FitnessMetric>
 	{
-		case MetricAggregatorChoice::Average:
-			return make_unique<FitnessMetricAverage>(move(metrics));
-		case MetricAggregatorChoice::Sum:
-			return make_unique<FitnessMetricSum>(move(metrics));
-		case MetricAggregatorChoice::Maximum:
-			return make_unique<FitnessMetricMaximum>(move(metrics));
-		case MetricAggregatorChoice::Minimum:
-			return make_unique<FitnessMetricMinimum>(move(metrics));
-		default:
-			assertThrow(false, solidity::util::Exception, "Invalid MetricAggregatorChoice value.");
-	}
+		switch (_options.metricAggregator)
+		{
+			case MetricAggregatorChoice::Average:
+				return make_unique<FitnessMetricAverage>(move(_metrics), _options.parallelism);
+			case MetricAggregatorChoice::Sum:
+				return make_unique<FitnessMetricSum>(move(_metrics), _options.parallelism);
+			case MetricAggregatorChoice::Maximum:
+				return make_unique<FitnessMetricMaximum>(move(_metrics), _options.parallelism);
+			case MetricAggregatorChoice::Minimum:
+				return make_unique<FitnessMetricMinimum>(move(_metrics), _options.parallelism);
+			default:
+				assertThrow(false, solidity::util::Exception, "Invalid MetricAggregatorChoice value.");
+		}
+	};
+
+	if (_options.screeningProgramCount == 0 || _options.screeningProgramCount >= metrics.size())
+		return aggregate(move(metrics));
+
+	// The screening metric shares the metrics of the first programs, including their caches,
+	// so that the chromosomes evaluated on all programs reuse the results of the screening.
+	vector<shared_ptr<FitnessMetric>> screeningMetrics(
+		metrics.begin(),
+		metrics.begin() + static_cast<ptrdiff_t>(_options.screeningProgramCount)
+	);
+	return make_unique<MultiFidelityMetric>(
+		aggregate(move(screeningMetrics)),
+		aggregate(move(metrics)),
+		_options.screeningFraction,
+		min(0.1, _options.screeningFraction)
+	);
 }
 
 PopulationFactory::Options PopulationFactory::Options::fromCommandLine(po::variables_map const& _arguments)
@@ -357,6 +381,7 @@ ProgramCacheFactory::Options ProgramCacheFactory::Options::fromCommandLine(po::v
 {
 	return {
 		_arguments["program-cache"].as<bool>(),
+		_arguments["program-cache-size-limit"].as<size_t>(),
 	};
 }
 
@@ -367,7 +392,7 @@ vector<shared_ptr<ProgramCache>> ProgramCacheFactory::build(
 {
 	vector<shared_ptr<ProgramCache>> programCaches;
 	for (Program& program: _programs)
-		programCaches.push_back(_options.programCacheEnabled ? make_shared<ProgramCache>(move(program)) : nullptr);
+		programCaches.push_back(_options.programCacheEnabled ? make_shared<ProgramCache>(move(program), _options.programCacheSizeLimit) : nullptr);
 
 	return programCaches;
 }
@@ -389,7 +414,11 @@ vector<Program> ProgramFactory::build(Options const& _options)
 		variant<Program, ErrorList> programOrErrors = Program::load(sourceCode);
 		if (holds_alternative<ErrorList>(programOrErrors))
 		{
-			cerr << get<ErrorList>(programOrErrors) << endl;
+			SingletonCharStreamProvider charStreamProvider(sourceCode);
+			SourceReferenceFormatter formatter(cerr, charStreamProvider, true, false);
+			for (auto const& error: get<ErrorList>(programOrErrors))
+				formatter.printErrorInformation(*error);
+			cerr << endl;
 			assertThrow(false, InvalidProgram, "Failed to load program " + path);
 		}
 
@@ -632,6 +661,37 @@ Phaser::CommandLineDescription Phaser::buildCommandLineDescription()
 	;
 	keywordDescription.add(populationDescription);
 
+	po::options_description migrationDescription("MIGRATION", lineLength, minDescriptionLength);
+	migrationDescription.add_options()
+		(
+			"migration-dir",
+			po::value<string>()->value_name("<DIR>"),
+			"Directory shared by multiple yul-phaser processes, each evolving its own population (an island). "
+			"The islands periodically save their best chromosomes there and take in the ones saved by "
+			"the other islands. The directory can be on a network file system to run the islands "
+			"on different machines. (default=migration disabled)"
+		)
+		(
+			"island-name",
+			po::value<string>()->value_name("<NAME>"),
+			"Name of the file in the migration directory that this process saves its chromosomes to. "
+			"Must be different for every island. Required if --migration-dir is specified."
+		)
+		(
+			"migration-interval",
+			po::value<size_t>()->value_name("<ROUNDS>")->default_value(10),
+			"Number of rounds between migrations."
+		)
+		(
+			"migrant-count",
+			po::value<size_t>()->value_name("<COUNT>")->default_value(5),
+			"Number of the best chromosomes of the population that migrate to other islands. "
+			"The chromosomes coming from other islands replace the worst ones in the population "
+			"if they are fitter."
+		)
+	;
+	keywordDescription.add(migrationDescription);
+
 	po::options_description metricsDescription("METRICS", lineLength, minDescriptionLength);
 	metricsDescription.add_options()
 		(
@@ -676,6 +736,26 @@ Phaser::CommandLineDescription Phaser::buildCommandLineDescription()
 			po::value<size_t>()->value_name("<COUNT>")->default_value(1),
 			"Number of times to repeat the sequence optimisation steps represented by a chromosome."
 		)
+		(
+			"jobs",
+			po::value<size_t>()->value_name("<COUNT>")->default_value(1),
+			"Number of threads used to evaluate the fitness of the chromosomes. "
+			"Every chromosome is evaluated separately for each input program. "
+			"0 means one thread per hardware thread. The results do not depend on the number of threads."
+		)
+		(
+			"screening-programs",
+			po::value<size_t>()->value_name("<COUNT>")->default_value(0),
+			"Number of input programs used to screen new chromosomes before evaluating them. "
+			"Only the best chromosomes according to the metric on these programs are evaluated on all "
+			"programs, the values of the others are estimated. 0 disables the screening."
+		)
+		(
+			"screening-fraction",
+			po::value<double>()->value_name("<FRACTION>")->default_value(0.5),
+			"Initial fraction of the screened chromosomes that are evaluated on all programs. "
+			"The fraction adapts to how well the screening predicts the values on all programs."
+		)
 	;
 	keywordDescription.add(metricsDescription);
 
@@ -708,8 +788,15 @@ Phaser::CommandLineDescription Phaser::buildCommandLineDescription()
 			po::bool_switch(),
 			"Enables caching of intermediate programs corresponding to chromosome prefixes.\n"
 			"This speeds up fitness evaluation by a lot but eats tons of memory if the chromosomes are long. "
-			"Disabled by default since there's currently no way to set an upper limit on memory usage but "
-			"highly recommended if your computer has enough RAM."
+			"Disabled by default but highly recommended if your computer has enough RAM or together with "
+			"--program-cache-size-limit."
+		)
+		(
+			"program-cache-size-limit",
+			po::value<size_t>()->value_name("<SIZE>")->default_value(0),
+			"Upper limit on the size of the cached code of each input program, in the units used by "
+			"--show-cache-stats. The least recently used programs are removed from the cache when it is "
+			"exceeded. 0 means no limit."
 		)
 	;
 	keywordDescription.add(cacheDescription);
@@ -770,6 +857,16 @@ optional<po::variables_map> Phaser::parseCommandLine(int _argc, char** _argv)
 	if (arguments.count("input-files") == 0)
 		assertThrow(false, NoInputFiles, "Missing argument: input-files.");
 
+	if (arguments.count("migration-dir") > 0 && arguments.count("island-name") == 0)
+		assertThrow(false, BadInput, "Missing argument: island-name (required with --migration-dir).");
+
+	if (arguments["migration-interval"].as<size_t>() == 0)
+		assertThrow(false, BadInput, "Invalid value of --migration-interval: must be at least 1.");
+
+	double screeningFraction = arguments["screening-fraction"].as<double>();
+	if (!(screeningFraction > 0 && screeningFraction <= 1))
+		assertThrow(false, BadInput, "Invalid value of --screening-fraction: must be greater than 0 and at most 1.");
+
 	return arguments;
 }
 
@@ -798,6 +895,10 @@ AlgorithmRunner::Options Phaser::buildAlgorithmRunnerOptions(po::variables_map c
 		_arguments["show-only-top-chromosome"].as<bool>(),
 		!_arguments["hide-round"].as<bool>(),
 		_arguments["show-cache-stats"].as<bool>(),
+		_arguments.count("migration-dir") > 0 ? static_cast<optional<string>>(_arguments["migration-dir"].as<string>()) : nullopt,
+		_arguments.count("island-name") > 0 ? _arguments["island-name"].as<string>() : "",
+		_arguments["migration-interval"].as<size_t>(),
+		_arguments["migrant-count"].as<size_t>(),
 	};
 }
 
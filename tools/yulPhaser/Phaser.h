@@ -156,6 +156,12 @@ public:
 		MetricAggregatorChoice metricAggregator;
 		size_t relativeMetricScale;
 		size_t chromosomeRepetitions;
+		size_t parallelism;
+		/// Number of programs used to screen the chromosomes before evaluating them on all
+		/// programs. Zero disables the screening.
+		size_t screeningProgramCount = 0;
+		/// Initial fraction of the screened chromosomes that are evaluated on all programs.
+		double screeningFraction = 0.5;
 
 		static Options fromCommandLine(boost::program_options::variables_map const& _arguments);
 	};
@@ -214,6 +220,7 @@ public:
 	struct Options
 	{
 		bool programCacheEnabled;
+		size_t programCacheSizeLimit;
 
 		static Options fromCommandLine(boost::program_options::variables_map const& _arguments);
 	};
@@ -46,13 +46,6 @@ struct CodeWeights;
 
 }
 
-namespace std
-{
-
-std::ostream& operator<<(std::ostream& _outputStream, solidity::langutil::ErrorList const& _errors);
-
-}
-
 namespace solidity::phaser
 {
 
@@ -59,33 +59,54 @@ Program ProgramCache::optimiseProgram(
 	for (size_t i = 1; i < _repetitionCount; ++i)
 		targetOptimisations += _abbreviatedOptimisationSteps;
 
+	size_t use = 0;
 	size_t prefixSize = 0;
-	for (size_t i = 1; i <= targetOptimisations.size(); ++i)
-	{
-		auto const& pair = m_entries.find(targetOptimisations.substr(0, i));
-		if (pair != m_entries.end())
+	Program intermediateProgram = [&]() {
+		lock_guard<mutex> lock(m_mutex);
+		use = ++m_useCounter;
+		for (size_t i = 1; i <= targetOptimisations.size(); ++i)
 		{
-			pair->second.roundNumber = m_currentRound;
-			++prefixSize;
-			++m_hits;
+			auto pair = m_entries.find(targetOptimisations.substr(0, i));
+			if (pair != m_entries.end())
+			{
+				pair->second.roundNumber = m_currentRound;
+				markUsed(pair, use);
+				++prefixSize;
+				++m_hits;
+			}
+			else
+				break;
 		}
-		else
-			break;
-	}
 
-	Program intermediateProgram = (
-		prefixSize == 0 ?
-		m_program :
-		m_entries.at(targetOptimisations.substr(0, prefixSize)).program
-	);
+		return
+			prefixSize == 0 ?
+			m_program :
+			m_entries.at(targetOptimisations.substr(0, prefixSize)).program;
+	}();
 
 	for (size_t i = prefixSize + 1; i <= targetOptimisations.size(); ++i)
 	{
 		string stepName = OptimiserSuite::stepAbbreviationToNameMap().at(targetOptimisations[i - 1]);
 		intermediateProgram.optimise({stepName});
 
-		m_entries.insert({targetOptimisations.substr(0, i), {intermediateProgram, m_currentRound}});
+		lock_guard<mutex> lock(m_mutex);
 		++m_misses;
+
+		// An entry whose prefix has been evicted could never be found.
+		if (i > 1 && m_entries.count(targetOptimisations.substr(0, i - 1)) == 0)
+			continue;
+
+		auto [entry, inserted] = m_entries.insert({targetOptimisations.substr(0, i), {intermediateProgram, m_currentRound}});
+		if (inserted)
+		{
+			entry->second.codeSize = intermediateProgram.codeSize(CacheStats::StorageWeights);
+			m_totalCodeSize += entry->second.codeSize;
+			entry->second.lastUse = use;
+			m_evictionQueue.insert(&entry->first);
+			evict();
+		}
+		else
+			markUsed(entry, use);
 	}
 
 	return intermediateProgram;
@@ -101,7 +122,7 @@ void ProgramCache::startRound(size_t _roundNumber)
 		assert(pair->second.roundNumber < m_currentRound);
 
 		if (pair->second.roundNumber < m_currentRound - 1)
-			m_entries.erase(pair++);
+			erase(pair++);
 		else
 			++pair;
 	}
@@ -109,7 +130,9 @@ void ProgramCache::startRound(size_t _roundNumber)
 
 void ProgramCache::clear()
 {
+	m_evictionQueue.clear();
 	m_entries.clear();
+	m_totalCodeSize = 0;
 	m_currentRound = 0;
 }
 
@@ -127,18 +150,46 @@ CacheStats ProgramCache::gatherStats() const
 	return {
 		/* hits = */ m_hits,
 		/* misses = */ m_misses,
-		/* totalCodeSize = */ calculateTotalCachedCodeSize(),
+		/* totalCodeSize = */ m_totalCodeSize,
 		/* roundEntryCounts = */ countRoundEntries(),
 	};
 }
 
-size_t ProgramCache::calculateTotalCachedCodeSize() const
+bool ProgramCache::EvictionOrder::operator()(string const* _a, string const* _b) const
 {
-	size_t size = 0;
-	for (auto const& pair: m_entries)
-		size += pair.second.program.codeSize(CacheStats::StorageWeights);
+	size_t lastUseA = entries.at(*_a).lastUse;
+	size_t lastUseB = entries.at(*_b).lastUse;
+	if (lastUseA != lastUseB)
+		return lastUseA < lastUseB;
+	if (_a->size() != _b->size())
+		return _a->size() > _b->size();
+	return *_a < *_b;
+}
 
-	return size;
+void ProgramCache::markUsed(map<string, CacheEntry>::iterator _entry, size_t _use)
+{
+	if (_entry->second.lastUse >= _use)
+		return;
+
+	m_evictionQueue.erase(&_entry->first);
+	_entry->second.lastUse = _use;
+	m_evictionQueue.insert(&_entry->first);
+}
+
+void ProgramCache::erase(map<string, CacheEntry>::iterator _entry)
+{
+	m_evictionQueue.erase(&_entry->first);
+	m_totalCodeSize -= _entry->second.codeSize;
+	m_entries.erase(_entry);
+}
+
+void ProgramCache::evict()
+{
+	while (m_codeSizeLimit > 0 && m_totalCodeSize > m_codeSizeLimit)
+	{
+		assert(!m_evictionQueue.empty());
+		erase(m_entries.find(**m_evictionQueue.begin()));
+	}
 }
 
 map<size_t, size_t> ProgramCache::countRoundEntries() const
@@ -23,6 +23,8 @@
 #include <libyul/optimiser/Metrics.h>
 
 #include <map>
+#include <mutex>
+#include <set>
 #include <string>
 
 namespace solidity::phaser
@@ -36,6 +38,10 @@ struct CacheEntry
 {
 	Program program;
 	size_t roundNumber;
+	/// Size of the program according to @a CacheStats::StorageWeights.
+	size_t codeSize = 0;
+	/// Value of the use counter of the cache when the entry was last inserted or found.
+	size_t lastUse = 0;
 
 	CacheEntry(Program _program, size_t _roundNumber):
 		program(std::move(_program)),
@@ -98,15 +104,23 @@ struct CacheStats
  * experiments) but there's room for improvement. We could fit more useful programs in
  * the cache by being more picky about which ones we choose.
  *
- * There is currently no way to purge entries without starting a new round. Since the programs
- * take a lot of memory, this may lead to the cache eating up all the available RAM if sequences are
- * long and programs large. A limiter based on entry count or total program size would be useful.
+ * Since the programs take a lot of memory, the total size of the cached programs (as computed with
+ * @a CacheStats::StorageWeights) can be limited with @a _codeSizeLimit. When an insertion exceeds
+ * the limit, the least recently used entries are removed until the cache fits again. An entry is
+ * always used together with all its prefixes and, among entries used at the same time, the longest
+ * ones are removed first, so that no entry outlives its prefixes and every cached program stays
+ * reachable. A limit of zero disables it.
+ *
+ * @a optimiseProgram() can be called from multiple threads at the same time. The steps are applied
+ * outside of the lock, so the same prefix may occasionally be computed twice, which only affects
+ * the statistics. The other member functions must not be called concurrently with it.
  */
 class ProgramCache
 {
 public:
-	explicit ProgramCache(Program _program):
-		m_program(std::move(_program)) {}
+	explicit ProgramCache(Program _program, size_t _codeSizeLimit = 0):
+		m_program(std::move(_program)),
+		m_codeSizeLimit(_codeSizeLimit) {}
 
 	Program optimiseProgram(
 		std::string const& _abbreviatedOptimisationSteps,
@@ -124,9 +138,23 @@ public:
 	std::map<std::string, CacheEntry> const& entries() const { return m_entries; }
 	Program const& program() const { return m_program; }
 	size_t currentRound() const { return m_currentRound; }
+	size_t codeSizeLimit() const { return m_codeSizeLimit; }
 
 private:
-	size_t calculateTotalCachedCodeSize() const;
+	/// Order in which the entries are evicted when the code size limit is exceeded.
+	struct EvictionOrder
+	{
+		bool operator()(std::string const* _a, std::string const* _b) const;
+
+		std::map<std::string, CacheEntry> const& entries;
+	};
+
+	/// Sets the last use of @a _entry to @a _use unless it has been used later.
+	void markUsed(std::map<std::string, CacheEntry>::iterator _entry, size_t _use);
+	void erase(std::map<std::string, CacheEntry>::iterator _entry);
+	/// Removes the least recently used entries until the total code size is within the limit.
+	void evict();
+
 	std::map<size_t, size_t> countRoundEntries() const;
 
 	// The best matching data structure here would be a trie of chromosome prefixes but since
@@ -134,10 +162,18 @@ private:
 	// A map should be good enough.
 	std::map<std::string, CacheEntry> m_entries;
 
+	/// Keys of @a m_entries in the order of eviction.
+	std::set<std::string const*, EvictionOrder> m_evictionQueue{EvictionOrder{m_entries}};
+
 	Program m_program;
+	size_t m_codeSizeLimit = 0;
+	size_t m_totalCodeSize = 0;
+	size_t m_useCounter = 0;
 	size_t m_currentRound = 0;
 	size_t m_hits = 0;
 	size_t m_misses = 0;
+	/// Protects the entries and the statistics in @a optimiseProgram().
+	std::mutex m_mutex;
 };
 
 }